@@ -0,0 +1,506 @@
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <zlib.h>
+#include <common.h>
+#include <dmg/dmg.h>
+#include "dmgreader.h"
+
+// Decompressed chunks kept around. UDZO chunks are usually 256K each.
+#define DMG_CACHE_CHUNKS 64
+
+// How many chunks past the one being read to decompress in the background for
+// each worker, once the reads look sequential.
+#define DMG_READ_AHEAD_PER_THREAD 2
+
+#define BLOCK_ZERO 0x00000000
+
+typedef struct DmgRun {
+	uint32_t type;
+	uint64_t start;		// in bytes, from the start of the image
+	uint64_t length;
+	uint64_t compOffset;	// in bytes, from the start of the dmg
+	uint64_t compLength;
+} DmgRun;
+
+enum {
+	ChunkEmpty,
+	ChunkPending,		// being decompressed; waited for on changed
+	ChunkReady
+};
+
+typedef struct DmgChunk {
+	int run;
+	int state;
+	int users;		// readers copying out of data, which may not be evicted
+	uint64_t lastUse;
+	unsigned char* data;
+} DmgChunk;
+
+typedef struct ParallelDmg {
+	AbstractFile* dmg;
+	ResourceKey* resources;
+	DmgRun* runs;
+	int numRuns;
+	uint64_t offset;	// of the partition
+	size_t maxChunk;
+
+	// the AbstractFile has a single position, so reading it is one at a time;
+	// only the decompressing happens in parallel
+	pthread_mutex_t fileLock;
+
+	pthread_mutex_t lock;
+	pthread_cond_t changed;
+	DmgChunk chunks[DMG_CACHE_CHUNKS];
+	uint64_t useCounter;
+	int lastRun;
+
+	int queue[DMG_CACHE_CHUNKS];	// pending chunks for the workers
+	int queueHead;
+	int queueCount;
+
+	pthread_t* threads;
+	int numThreads;
+	int quit;
+} ParallelDmg;
+
+static int compareRuns(const void* a, const void* b) {
+	const DmgRun* left = (const DmgRun*) a;
+	const DmgRun* right = (const DmgRun*) b;
+
+	if(left->start != right->start)
+		return (left->start < right->start) ? -1 : 1;
+
+	return 0;
+}
+
+static int findRun(ParallelDmg* dmg, uint64_t location) {
+	int low = 0;
+	int high = dmg->numRuns - 1;
+
+	while(low <= high) {
+		int mid = (low + high) / 2;
+		DmgRun* run = &dmg->runs[mid];
+
+		if(location < run->start)
+			high = mid - 1;
+		else if(location >= (run->start + run->length))
+			low = mid + 1;
+		else
+			return mid;
+	}
+
+	return -1;
+}
+
+static int readCompressed(ParallelDmg* dmg, uint64_t offset, size_t length, void* buffer) {
+	int ok;
+
+	pthread_mutex_lock(&dmg->fileLock);
+	ok = dmg->dmg->seek(dmg->dmg, offset) == 0 && dmg->dmg->read(dmg->dmg, buffer, length) == length;
+	pthread_mutex_unlock(&dmg->fileLock);
+
+	return ok;
+}
+
+static int decompressRun(ParallelDmg* dmg, int index, unsigned char* buffer) {
+	DmgRun* run = &dmg->runs[index];
+	unsigned char* input;
+	uLongf length;
+	int ok;
+
+	input = (unsigned char*) malloc(run->compLength);
+	if(input == NULL)
+		return FALSE;
+
+	length = run->length;
+	ok = readCompressed(dmg, run->compOffset, run->compLength, input)
+		&& uncompress(buffer, &length, input, run->compLength) == Z_OK
+		&& length == run->length;
+
+	free(input);
+
+	if(!ok)
+		fprintf(stderr, "error: cannot decompress dmg chunk at 0x%llx\n", (unsigned long long) run->compOffset);
+
+	return ok;
+}
+
+// With the lock held
+static DmgChunk* lookupChunk(ParallelDmg* dmg, int run) {
+	int i;
+
+	for(i = 0; i < DMG_CACHE_CHUNKS; i++) {
+		if(dmg->chunks[i].run == run)
+			return &dmg->chunks[i];
+	}
+
+	return NULL;
+}
+
+// With the lock held. The least recently used chunk nobody is using, made
+// pending for run; NULL if every chunk is busy.
+static DmgChunk* claimChunk(ParallelDmg* dmg, int run) {
+	DmgChunk* victim = NULL;
+	int i;
+
+	for(i = 0; i < DMG_CACHE_CHUNKS; i++) {
+		DmgChunk* chunk = &dmg->chunks[i];
+		if(chunk->state == ChunkPending || chunk->users > 0)
+			continue;
+
+		if(victim == NULL || chunk->state == ChunkEmpty || (victim->state != ChunkEmpty && chunk->lastUse < victim->lastUse))
+			victim = chunk;
+	}
+
+	if(victim == NULL)
+		return NULL;
+
+	if(victim->data == NULL) {
+		victim->data = (unsigned char*) malloc(dmg->maxChunk);
+		if(victim->data == NULL)
+			return NULL;
+	}
+
+	victim->run = run;
+	victim->state = ChunkPending;
+	return victim;
+}
+
+// With the lock held, after reading run. Only sequential reads are read ahead;
+// the catalog being searched would just push useful chunks out.
+static void readAhead(ParallelDmg* dmg, int run) {
+	int sequential = (run == dmg->lastRun + 1);
+	int window = dmg->numThreads * DMG_READ_AHEAD_PER_THREAD;
+	int i;
+
+	dmg->lastRun = run;
+	if(!sequential || dmg->numThreads == 0)
+		return;
+
+	// leave at least half the cache to what has been read already
+	if(window > (DMG_CACHE_CHUNKS / 2))
+		window = DMG_CACHE_CHUNKS / 2;
+
+	for(i = run + 1; i < dmg->numRuns && i <= (run + window); i++) {
+		DmgChunk* chunk;
+
+		if(dmg->runs[i].type != BLOCK_ZLIB || lookupChunk(dmg, i) != NULL)
+			continue;
+
+		chunk = claimChunk(dmg, i);
+		if(chunk == NULL)
+			break;
+
+		dmg->queue[(dmg->queueHead + dmg->queueCount) % DMG_CACHE_CHUNKS] = chunk - dmg->chunks;
+		dmg->queueCount++;
+	}
+
+	pthread_cond_broadcast(&dmg->changed);
+}
+
+static void* dmgWorker(void* arg) {
+	ParallelDmg* dmg = (ParallelDmg*) arg;
+
+	pthread_mutex_lock(&dmg->lock);
+	while(TRUE) {
+		DmgChunk* chunk;
+		int ok;
+
+		while(!dmg->quit && dmg->queueCount == 0)
+			pthread_cond_wait(&dmg->changed, &dmg->lock);
+
+		if(dmg->quit)
+			break;
+
+		chunk = &dmg->chunks[dmg->queue[dmg->queueHead]];
+		dmg->queueHead = (dmg->queueHead + 1) % DMG_CACHE_CHUNKS;
+		dmg->queueCount--;
+
+		pthread_mutex_unlock(&dmg->lock);
+		ok = decompressRun(dmg, chunk->run, chunk->data);
+		pthread_mutex_lock(&dmg->lock);
+
+		// a failed chunk is left for the reader to try again, and report
+		if(ok) {
+			chunk->state = ChunkReady;
+			chunk->lastUse = ++dmg->useCounter;
+		} else {
+			chunk->run = -1;
+			chunk->state = ChunkEmpty;
+		}
+		pthread_cond_broadcast(&dmg->changed);
+	}
+	pthread_mutex_unlock(&dmg->lock);
+
+	return NULL;
+}
+
+// The chunk holding run, decompressed, in use until releaseChunk
+static DmgChunk* getChunk(ParallelDmg* dmg, int run) {
+	DmgChunk* chunk;
+
+	pthread_mutex_lock(&dmg->lock);
+	while(TRUE) {
+		chunk = lookupChunk(dmg, run);
+		if(chunk != NULL && chunk->state == ChunkReady)
+			break;
+
+		if(chunk != NULL) {
+			pthread_cond_wait(&dmg->changed, &dmg->lock);
+			continue;
+		}
+
+		chunk = claimChunk(dmg, run);
+		if(chunk == NULL) {
+			pthread_cond_wait(&dmg->changed, &dmg->lock);
+			continue;
+		}
+
+		// not worth a trip through the queue, this one is needed right now
+		chunk->users++;
+		pthread_mutex_unlock(&dmg->lock);
+		int ok = decompressRun(dmg, run, chunk->data);
+		pthread_mutex_lock(&dmg->lock);
+		chunk->users--;
+
+		if(!ok) {
+			chunk->run = -1;
+			chunk->state = ChunkEmpty;
+			pthread_cond_broadcast(&dmg->changed);
+			pthread_mutex_unlock(&dmg->lock);
+			return NULL;
+		}
+
+		chunk->state = ChunkReady;
+		pthread_cond_broadcast(&dmg->changed);
+		break;
+	}
+
+	chunk->users++;
+	chunk->lastUse = ++dmg->useCounter;
+	readAhead(dmg, run);
+	pthread_mutex_unlock(&dmg->lock);
+
+	return chunk;
+}
+
+static void releaseChunk(ParallelDmg* dmg, DmgChunk* chunk) {
+	pthread_mutex_lock(&dmg->lock);
+	chunk->users--;
+	pthread_cond_broadcast(&dmg->changed);
+	pthread_mutex_unlock(&dmg->lock);
+}
+
+static int parallelDmgRead(io_func* io, off_t location, size_t size, void* buffer) {
+	ParallelDmg* dmg = (ParallelDmg*) io->data;
+	unsigned char* out = (unsigned char*) buffer;
+	uint64_t position = dmg->offset + location;
+
+	while(size > 0) {
+		int index = findRun(dmg, position);
+		DmgRun* run;
+		uint64_t within;
+		size_t length;
+
+		if(index < 0) {
+			fprintf(stderr, "error: 0x%llx is past the end of the dmg\n", (unsigned long long) position);
+			return FALSE;
+		}
+
+		run = &dmg->runs[index];
+		within = position - run->start;
+		length = size;
+		if(length > (run->length - within))
+			length = run->length - within;
+
+		switch(run->type) {
+			case BLOCK_ZLIB: {
+				DmgChunk* chunk = getChunk(dmg, index);
+				if(chunk == NULL)
+					return FALSE;
+				memcpy(out, chunk->data + within, length);
+				releaseChunk(dmg, chunk);
+				break;
+			}
+
+			case BLOCK_RAW:
+				if(!readCompressed(dmg, run->compOffset + within, length, out))
+					return FALSE;
+				break;
+
+			case BLOCK_IGNORE:
+			case BLOCK_ZERO:
+				memset(out, 0, length);
+				break;
+
+			default:
+				fprintf(stderr, "error: unsupported dmg block type 0x%x\n", run->type);
+				return FALSE;
+		}
+
+		out += length;
+		position += length;
+		size -= length;
+	}
+
+	return TRUE;
+}
+
+static int parallelDmgWrite(io_func* io, off_t location, size_t size, void* buffer) {
+	return FALSE;
+}
+
+static void parallelDmgClose(io_func* io) {
+	ParallelDmg* dmg = (ParallelDmg*) io->data;
+	int i;
+
+	pthread_mutex_lock(&dmg->lock);
+	dmg->quit = TRUE;
+	pthread_cond_broadcast(&dmg->changed);
+	pthread_mutex_unlock(&dmg->lock);
+
+	for(i = 0; i < dmg->numThreads; i++)
+		pthread_join(dmg->threads[i], NULL);
+
+	for(i = 0; i < DMG_CACHE_CHUNKS; i++)
+		free(dmg->chunks[i].data);
+
+	pthread_cond_destroy(&dmg->changed);
+	pthread_mutex_destroy(&dmg->lock);
+	pthread_mutex_destroy(&dmg->fileLock);
+
+	if(dmg->resources)
+		releaseResources(dmg->resources);
+
+	dmg->dmg->close(dmg->dmg);
+	free(dmg->threads);
+	free(dmg->runs);
+	free(dmg);
+	free(io);
+}
+
+// Every run of every BLKX table, in one list sorted by where it is in the image
+static int readRuns(ParallelDmg* dmg) {
+	UDIFResourceFile resourceFile;
+	ResourceKey* blkxKey;
+	ResourceData* blkx;
+	int allocated = 0;
+
+	dmg->dmg->seek(dmg->dmg, dmg->dmg->getLength(dmg->dmg) - sizeof(UDIFResourceFile));
+	readUDIFResourceFile(dmg->dmg, &resourceFile);
+	if(resourceFile.fUDIFSignature != KOLY_SIGNATURE)
+		return FALSE;
+
+	dmg->resources = readResources(dmg->dmg, &resourceFile);
+	blkxKey = getResourceByKey(dmg->resources, "blkx");
+	if(blkxKey == NULL)
+		return FALSE;
+
+	for(blkx = blkxKey->data; blkx != NULL; blkx = blkx->next) {
+		BLKXTable* table = (BLKXTable*) blkx->data;
+		uint32_t i;
+
+		for(i = 0; i < table->blocksRunCount; i++) {
+			BLKXRun* run = &table->runs[i];
+			DmgRun* entry;
+
+			if(run->type == BLOCK_COMMENT || run->type == BLOCK_TERMINATOR || run->sectorCount == 0)
+				continue;
+
+			if(dmg->numRuns == allocated) {
+				allocated = allocated ? (allocated * 2) : 256;
+				dmg->runs = (DmgRun*) realloc(dmg->runs, allocated * sizeof(DmgRun));
+			}
+
+			entry = &dmg->runs[dmg->numRuns++];
+			entry->type = run->type;
+			entry->start = (table->firstSectorNumber + run->sectorStart) * SECTOR_SIZE;
+			entry->length = run->sectorCount * SECTOR_SIZE;
+			entry->compOffset = table->dataStart + run->compOffset;
+			entry->compLength = run->compLength;
+
+			if(entry->type == BLOCK_ZLIB && entry->length > dmg->maxChunk)
+				dmg->maxChunk = entry->length;
+		}
+	}
+
+	qsort(dmg->runs, dmg->numRuns, sizeof(DmgRun), compareRuns);
+	return dmg->numRuns > 0;
+}
+
+// Same choice as libdmg: the given entry of the partition map, or the HFS one
+static int findPartition(io_func* io, int partition) {
+	ParallelDmg* dmg = (ParallelDmg*) io->data;
+	Partition entry;
+	uint32_t numPartitions;
+	uint32_t i;
+
+	if(!parallelDmgRead(io, SECTOR_SIZE, sizeof(entry), &entry))
+		return FALSE;
+
+	FLIPENDIAN(entry.pmSig);
+	if(entry.pmSig != APPLE_PARTITION_MAP_SIGNATURE)
+		return partition < 0;
+
+	FLIPENDIAN(entry.pmMapBlkCnt);
+	numPartitions = entry.pmMapBlkCnt;
+
+	for(i = 0; i < numPartitions; i++) {
+		if(!parallelDmgRead(io, SECTOR_SIZE * (i + 1), sizeof(entry), &entry))
+			return FALSE;
+
+		if(partition < 0 ? (strcmp((char*) entry.pmParType, "Apple_HFSX") == 0 || strcmp((char*) entry.pmParType, "Apple_HFS") == 0)
+				: (i == (uint32_t) partition)) {
+			FLIPENDIAN(entry.pmPyPartStart);
+			dmg->offset = (uint64_t) entry.pmPyPartStart * SECTOR_SIZE;
+			return TRUE;
+		}
+	}
+
+	return FALSE;
+}
+
+io_func* openParallelDmgPartition(AbstractFile* abstractIn, int partition, int threads) {
+	ParallelDmg* dmg;
+	io_func* io;
+	int i;
+
+	dmg = (ParallelDmg*) calloc(1, sizeof(ParallelDmg));
+	dmg->dmg = abstractIn;
+	dmg->lastRun = -2;
+
+	for(i = 0; i < DMG_CACHE_CHUNKS; i++)
+		dmg->chunks[i].run = -1;
+
+	pthread_mutex_init(&dmg->fileLock, NULL);
+	pthread_mutex_init(&dmg->lock, NULL);
+	pthread_cond_init(&dmg->changed, NULL);
+
+	io = (io_func*) malloc(sizeof(io_func));
+	io->data = dmg;
+	io->read = parallelDmgRead;
+	io->write = parallelDmgWrite;
+	io->close = parallelDmgClose;
+
+	if(!readRuns(dmg) || !findPartition(io, partition)) {
+		parallelDmgClose(io);
+		return NULL;
+	}
+
+	if(threads <= 0)
+		threads = sysconf(_SC_NPROCESSORS_ONLN);
+
+	// the reader decompresses what it needs itself, so one core gets no workers
+	if(threads > 1) {
+		dmg->threads = (pthread_t*) calloc(threads, sizeof(pthread_t));
+		for(i = 0; i < threads; i++) {
+			if(pthread_create(&dmg->threads[i], NULL, dmgWorker, dmg) != 0)
+				break;
+			dmg->numThreads++;
+		}
+	}
+
+	return io;
+}
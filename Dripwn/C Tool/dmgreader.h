@@ -0,0 +1,13 @@
+#ifndef DMGREADER_H
+#define DMGREADER_H
+
+#include <common.h>
+#include <abstractfile.h>
+
+// Like libdmg's openDmgFilePartition, but the zlib chunks are decompressed on
+// a pool of threads: the next few are read ahead while the HFS layer reads
+// sequentially, and recently used ones are kept for when it jumps around the
+// catalog. threads is how many to decompress on, 0 for one per core.
+io_func* openParallelDmgPartition(AbstractFile* dmg, int partition, int threads);
+
+#endif
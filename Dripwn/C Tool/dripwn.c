@@ -3,65 +3,121 @@
 #include <unzip.h>
 #include <common.h>
 #include <string.h>
+#include <unistd.h>
+#include <pthread.h>
 #include <dmg/dmgfile.h>
 #include <dmg/filevault.h>
+#include "dmgreader.h"
+#include "mappedio.h"
 
 #define DEFAULT_BUFFER_SIZE (1 * 1024 * 1024)
 char endianness;
 
-char *createTempFile() {
-	char tmpFileBuffer[512];
-#ifdef WIN32
-	char tmpFilePath[512];
-	GetTempPath(512, tmpFilePath);
-	GetTempFileName(tmpFilePath, "pwn", 0, tmpFileBuffer);
-	CloseHandle(CreateFile(tmpFilePath, GENERIC_READ | GENERIC_WRITE, FILE_SHARE_DELETE, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_TEMPORARY, NULL));
-#else
-	strcpy(tmpFileBuffer, "/tmp/pwnXXXXXX");
-	close(mkstemp(tmpFileBuffer));
-	FILE* tFile = fopen(tmpFileBuffer, "wb");
-	fclose(tFile);
-#endif
-	return strdup(tmpFileBuffer);
+// Reads a file inside the IPSW in place. Stored entries (how the root
+// filesystem usually is) are mapped straight out of the zip, so only the
+// parts the HFS catalog asks for are ever read and decrypted. Deflated
+// entries are inflated into memory, only as far as has been asked for so far.
+typedef struct ZipEntryInfo {
+	unzFile zip;
+	unsigned char* buffer;
+	size_t inflated;
+	size_t allocated;
+	off_t length;
+	off_t offset;
+} ZipEntryInfo;
+
+static size_t zipEntryRead(AbstractFile* file, void* data, size_t len) {
+	ZipEntryInfo* info = (ZipEntryInfo*) file->data;
+
+	if(info->offset >= info->length)
+		return 0;
+
+	if(len > (info->length - info->offset))
+		len = info->length - info->offset;
+
+	size_t needed = info->offset + len;
+	if(needed > info->allocated) {
+		info->allocated = needed + DEFAULT_BUFFER_SIZE;
+		if(info->allocated > info->length)
+			info->allocated = info->length;
+		info->buffer = realloc(info->buffer, info->allocated);
+	}
+
+	while(info->inflated < needed) {
+		size_t toRead = info->allocated - info->inflated;
+		if(toRead > DEFAULT_BUFFER_SIZE)
+			toRead = DEFAULT_BUFFER_SIZE;
+		ASSERT(unzReadCurrentFile(info->zip, info->buffer + info->inflated, toRead) == toRead, "cannot read file from ipsw");
+		info->inflated += toRead;
+	}
+
+	memcpy(data, info->buffer + info->offset, len);
+
+	info->offset += len;
+	return len;
+}
+
+static size_t zipEntryWrite(AbstractFile* file, const void* data, size_t len) {
+	return 0;
+}
+
+static int zipEntrySeek(AbstractFile* file, off_t offset) {
+	((ZipEntryInfo*) file->data)->offset = offset;
+	return 0;
 }
 
-char *loadZip(const char* ipsw, const char* toExtract) {
-	char *fileName;
-	void* buffer;
+static off_t zipEntryTell(AbstractFile* file) {
+	return ((ZipEntryInfo*) file->data)->offset;
+}
+
+static off_t zipEntryGetLength(AbstractFile* file) {
+	return ((ZipEntryInfo*) file->data)->length;
+}
+
+static void zipEntryClose(AbstractFile* file) {
+	ZipEntryInfo* info = (ZipEntryInfo*) file->data;
+
+	unzCloseCurrentFile(info->zip);
+	unzClose(info->zip);
+	free(info->buffer);
+	free(info);
+	free(file);
+}
+
+AbstractFile* openZipEntry(const char* ipsw, const char* toExtract) {
 	unzFile zip;
 	unz_file_info pfile_info;
-	
-	char *tmpFileName = createTempFile();
+
 	ASSERT(zip = unzOpen(ipsw), "error opening ipsw");
-	ASSERT(unzGoToFirstFile(zip) == UNZ_OK, "cannot seek to first file in ipsw");
-	
-	do {
-		ASSERT(unzGetCurrentFileInfo(zip, &pfile_info, NULL, 0, NULL, 0, NULL, 0) == UNZ_OK, "cannot get current file info from ipsw");
-		fileName = (char*) malloc(pfile_info.size_filename + 1);
-		ASSERT(unzGetCurrentFileInfo(zip, NULL, fileName, pfile_info.size_filename + 1, NULL, 0, NULL, 0) == UNZ_OK, "cannot get current file name from ipsw");
-		if(strcmp(toExtract, fileName) == 0) {
-			ASSERT(unzOpenCurrentFile(zip) == UNZ_OK, "cannot open compressed file in IPSW");
-			uLong fileSize = pfile_info.uncompressed_size;
-			
-			FILE *tmpFile = fopen(tmpFileName, "wb");
-			buffer = malloc(DEFAULT_BUFFER_SIZE);
-			size_t left = pfile_info.uncompressed_size;
-			while(left > 0) {
-				size_t toRead;
-				if(left > DEFAULT_BUFFER_SIZE)
-					toRead = DEFAULT_BUFFER_SIZE;
-				else
-					toRead = left;
-				ASSERT(unzReadCurrentFile(zip, buffer, toRead) == toRead, "cannot read file from ipsw");
-				fwrite(buffer, toRead, 1, tmpFile);
-				left -= toRead;
-			}
-			fclose(tmpFile);
-			free(buffer);
-			break;
-		}
-	} while(unzGoToNextFile(zip) == UNZ_OK);
-	return tmpFileName;
+	ASSERT(unzLocateFile(zip, toExtract, 1) == UNZ_OK, "cannot find root filesystem in ipsw");
+	ASSERT(unzGetCurrentFileInfo(zip, &pfile_info, NULL, 0, NULL, 0, NULL, 0) == UNZ_OK, "cannot get current file info from ipsw");
+	ASSERT(unzOpenCurrentFile(zip) == UNZ_OK, "cannot open compressed file in IPSW");
+
+	if(pfile_info.compression_method == 0) {
+		off_t dataOffset = unzGetCurrentFileZStreamPos64(zip);
+		unzCloseCurrentFile(zip);
+		unzClose(zip);
+
+		AbstractFile* mapped = createAbstractFileFromMapping(ipsw, dataOffset, pfile_info.uncompressed_size);
+		ASSERT(mapped, "cannot map root filesystem from ipsw");
+		return mapped;
+	}
+
+	ZipEntryInfo* info = (ZipEntryInfo*) calloc(1, sizeof(ZipEntryInfo));
+	info->zip = zip;
+	info->length = pfile_info.uncompressed_size;
+
+	AbstractFile* file = (AbstractFile*) malloc(sizeof(AbstractFile));
+	file->data = info;
+	file->read = zipEntryRead;
+	file->write = zipEntryWrite;
+	file->seek = zipEntrySeek;
+	file->tell = zipEntryTell;
+	file->getLength = zipEntryGetLength;
+	file->close = zipEntryClose;
+	file->type = AbstractFileTypeFile;
+
+	return file;
 }
 
 void TestByteOrder()
@@ -71,223 +127,361 @@ void TestByteOrder()
 	endianness = byte[0] ? IS_LITTLE_ENDIAN : IS_BIG_ENDIAN;
 }
 
+// Returns the plist NUL terminated in memory, or NULL.
 char *extractPlist(Volume* volume) {
 	HFSPlusCatalogRecord* record;
 	AbstractFile *outFile;
-	char* outFileName = createTempFile();
-	
-	outFile = createAbstractFileFromFile(fopen(outFileName, "wb"));
-	
-	if(outFile == NULL) {
-		printf("cannot create file");
-	}
-	
+	void* buffer = NULL;
+	size_t size = 0;
+
 	record = getRecordFromPath("/usr/share/firmware/multitouch/iPhone.mtprops", volume, NULL, NULL);
-	
-	if(record != NULL) {
-		if(record->recordType == kHFSPlusFileRecord)
-			writeToFile((HFSPlusCatalogFile*)record, outFile, volume);
-		else
-			printf("Not a file\n");
-	} else {
+
+	if(record == NULL) {
 		printf("No such file or directory\n");
+		return NULL;
+	}
+
+	if(record->recordType != kHFSPlusFileRecord) {
+		printf("Not a file\n");
+		free(record);
+		return NULL;
 	}
-	
+
+	buffer = malloc(1);
+	outFile = createAbstractFileFromMemoryFile(&buffer, &size);
+	writeToFile((HFSPlusCatalogFile*)record, outFile, volume);
 	outFile->close(outFile);
 	free(record);
-	
-	return outFileName;
+
+	buffer = realloc(buffer, size + 1);
+	((char*) buffer)[size] = '\0';
+
+	return (char*) buffer;
 }
 
-int is_base64(const char c) {
-	if ( (c >= 'A' && c <= 'Z') || 
-		(c >= 'a' && c <= 'z') || 
-          (c >= '0' && c <= '9') ||
-	      c == '+' || 
-	      c == '/' || 
-	      c == '=') return 1;
-	return 0;
+// One <key> of the plist and the element that follows it. Nothing is
+// copied: both point into the plist text.
+typedef struct PlistEntry {
+	const char* key;
+	size_t keyLen;
+	const char* type;	// element name of the value, e.g. "data"
+	size_t typeLen;
+	const char* value;	// contents of the value element, empty if it has none
+	size_t valueLen;
+} PlistEntry;
+
+typedef struct PlistIndex {
+	PlistEntry* entries;
+	int count;
+} PlistIndex;
+
+// Finds the element starting at or after p: sets name to its name and
+// returns the character after its '>', or NULL at the end.
+static const char* plistNextElement(const char* p, const char* end, const char** name, size_t* nameLen, int* empty) {
+	while(p < end) {
+		const char* open = memchr(p, '<', end - p);
+		if(open == NULL)
+			return NULL;
+
+		const char* close = memchr(open, '>', end - open);
+		if(close == NULL)
+			return NULL;
+
+		// Skip <?xml ...?>, <!DOCTYPE ...> and closing tags
+		if(open[1] != '?' && open[1] != '!' && open[1] != '/') {
+			const char* n = open + 1;
+			while(n < close && *n != ' ' && *n != '/' && *n != '>')
+				n++;
+			*name = open + 1;
+			*nameLen = n - (open + 1);
+			*empty = (close[-1] == '/');
+			return close + 1;
+		}
+
+		p = close + 1;
+	}
+
+	return NULL;
 }
 
-void cleanup_base64(char *inp, const unsigned int size) {
-	unsigned int i;
-    char *tinp1,*tinp2;
-	tinp1 = inp;
-     tinp2 = inp;
-     for (i = 0; i < size; i++) {
-     	if (is_base64(*tinp2)) {
-          	*tinp1++ = *tinp2++;
-          }
-          else {
-          	*tinp1 = *tinp2++;
-          }
-     }
-     *(tinp1) = 0;
+// One pass over the plist, recording every key with its value.
+void plistIndex(const char* plist, size_t len, PlistIndex* index) {
+	const char* end = plist + len;
+	const char* p = plist;
+	const char* name;
+	size_t nameLen;
+	int empty;
+	int allocated = 0;
+
+	index->entries = NULL;
+	index->count = 0;
+
+	while((p = plistNextElement(p, end, &name, &nameLen, &empty)) != NULL) {
+		if(nameLen != 3 || memcmp(name, "key", 3) != 0 || empty)
+			continue;
+
+		const char* keyEnd = memchr(p, '<', end - p);
+		if(keyEnd == NULL)
+			break;
+
+		PlistEntry entry;
+		entry.key = p;
+		entry.keyLen = keyEnd - p;
+
+		p = plistNextElement(keyEnd, end, &entry.type, &entry.typeLen, &empty);
+		if(p == NULL)
+			break;
+
+		entry.value = p;
+		entry.valueLen = 0;
+		if(!empty) {
+			// Containers are left to the loop, so their keys get indexed too
+			if(!(entry.typeLen == 4 && (memcmp(entry.type, "dict", 4) == 0))
+					&& !(entry.typeLen == 5 && memcmp(entry.type, "array", 5) == 0)) {
+				const char* valueEnd = memchr(p, '<', end - p);
+				if(valueEnd == NULL)
+					break;
+				entry.valueLen = valueEnd - p;
+				p = valueEnd;
+			}
+		}
+
+		if(index->count == allocated) {
+			allocated = allocated ? (allocated * 2) : 64;
+			index->entries = realloc(index->entries, allocated * sizeof(PlistEntry));
+		}
+		index->entries[index->count++] = entry;
+	}
 }
 
-unsigned char decode_base64_char(const char c) {
-	if (c >= 'A' && c <= 'Z') return c - 'A';
-	if (c >= 'a' && c <= 'z') return c - 'a' + 26;
-	if (c >= '0' && c <= '9') return c - '0' + 52;
-	if (c == '+') return 62;
-     if (c == '=') return 0;
-	return 63;   
+const PlistEntry* plistFind(const PlistIndex* index, const char* key) {
+	size_t len = strlen(key);
+	int i;
+
+	for(i = 0; i < index->count; i++) {
+		if(index->entries[i].keyLen == len && memcmp(index->entries[i].key, key, len) == 0)
+			return &index->entries[i];
+	}
+
+	return NULL;
 }
 
-void decode_base64(const char *inp, unsigned int isize, 
-			char *out, unsigned int *osize) {
-    unsigned int i;
-     char *tinp = (char*)inp; 
-     char *tout;
-     *osize = isize / 4 * 3;
-    tout = tinp;
-     for(i = 0; i < isize >> 2; i++) {
-		*tout++ = (decode_base64_char(*tinp++) << 2) | (decode_base64_char(*tinp) >> 4);
-          *tout++ = (decode_base64_char(*tinp++) << 4) | (decode_base64_char(*tinp) >> 2);
-          *tout++ = (decode_base64_char(*tinp++) << 6) | decode_base64_char(*tinp++);
+#define B64_SKIP 0x40
+#define B64_PAD 0x41
+
+static unsigned char base64Table[256];
+
+static void base64Init() {
+	int i;
+
+	memset(base64Table, B64_SKIP, sizeof(base64Table));
+	for(i = 0; i < 26; i++) {
+		base64Table['A' + i] = i;
+		base64Table['a' + i] = 26 + i;
 	}
-     if (*(tinp-1) == '=') (*osize)--;
-     if (*(tinp-2) == '=') (*osize)--;
+	for(i = 0; i < 10; i++)
+		base64Table['0' + i] = 52 + i;
+	base64Table['+'] = 62;
+	base64Table['/'] = 63;
+	base64Table['='] = B64_PAD;
 }
 
+// Decodes into out, which needs len / 4 * 3 bytes. Whitespace (and anything
+// else that isn't base64) is skipped on the fly. Returns the decoded length.
+size_t decode_base64(const char* in, size_t len, unsigned char* out) {
+	const unsigned char* p = (const unsigned char*) in;
+	const unsigned char* end = p + len;
+	unsigned char* o = out;
+	uint32_t bits = 0;
+	int have = 0;
 
-char * find_string(char * string, char * sub_string)
-{
-    size_t sub_s_len;
+	while(p < end) {
+		// Fast path: four characters that are all plain base64
+		if(have == 0 && (end - p) >= 4) {
+			unsigned char a = base64Table[p[0]], b = base64Table[p[1]], c = base64Table[p[2]], d = base64Table[p[3]];
+			if(((a | b | c | d) & 0xC0) == 0) {
+				uint32_t v = (a << 18) | (b << 12) | (c << 6) | d;
+				o[0] = v >> 16;
+				o[1] = v >> 8;
+				o[2] = v;
+				o += 3;
+				p += 4;
+				continue;
+			}
+		}
+
+		unsigned char v = base64Table[*p++];
+		if(v == B64_PAD)
+			break;
+		if(v == B64_SKIP)
+			continue;
 
-    sub_s_len = strlen(sub_string);
+		bits = (bits << 6) | v;
+		if(++have == 4) {
+			o[0] = bits >> 16;
+			o[1] = bits >> 8;
+			o[2] = bits;
+			o += 3;
+			have = 0;
+			bits = 0;
+		}
+	}
 
-    while (*string)
-    {
-        if (strncmp(string, sub_string, sub_s_len) == 0)
-        {
-            return string;
-        }
-        string++;
-    }
+	// Whatever is left before the padding
+	if(have == 2) {
+		*o++ = bits >> 4;
+	} else if(have == 3) {
+		*o++ = bits >> 10;
+		*o++ = bits >> 2;
+	}
 
-    return NULL;
+	return o - out;
 }
 
-int main(int argc, const char *argv[]) {
+// Decodes the base64 <data> of key and appends it to outName
+int extractFirmware(const PlistIndex* index, const char* key, const char* outName) {
+	const PlistEntry* entry = plistFind(index, key);
+	unsigned char* firmware;
+	size_t fw_len;
+	FILE * output;
+
+	if(entry == NULL || entry->typeLen != 4 || memcmp(entry->type, "data", 4) != 0)
+		return FALSE;
+
+	firmware = malloc(entry->valueLen / 4 * 3 + 3);
+	fw_len = decode_base64(entry->value, entry->valueLen, firmware);
+
+	output = fopen(outName, "a+");
+	if(output == NULL) {
+		free(firmware);
+		return FALSE;
+	}
+	fwrite(firmware, fw_len, 1, output);
+	fclose(output);
+	free(firmware);
+
+	return TRUE;
+}
+
+typedef struct DripwnJob {
+	const char* ipsw;
+	const char* key;
+	const char* rootFS;
+	const char* prefix;
+	int threads;		// to decompress the root filesystem on
+	int result;
+} DripwnJob;
+
+void* runJob(void* arg) {
+	DripwnJob* job = (DripwnJob*) arg;
 	io_func* io;
 	Volume* volume;
 	AbstractFile* image;
-	FILE * iphone_mtprops;
-    size_t file_len;
-    char * buffer;
-    char * p;
-    char * a_speed_firmware;
-    size_t a_speed_fw_len;
-    size_t final_a_speed_fw_len;
-    char * firmware;
-    size_t fw_len;
-    size_t final_fw_len;
-    FILE * output;
-	
-	if(argc < 4) {
-		printf("usage: %s <ipsw> <key> <root-fs-name>\n", argv[0]);
-		return 0;
-	}
-	char *filename = loadZip(argv[1], argv[3]);	
-	
-	TestByteOrder();
-	image = createAbstractFileFromFile(fopen(filename, "rb"));
-	image = createAbstractFileFromFileVault(image, argv[2]);
-	io = openDmgFilePartition(image, -1);
-	
+	char outName[512];
+
+	job->result = 1;
+
+	image = openZipEntry(job->ipsw, job->rootFS);
+	image = createAbstractFileFromMappedFileVault(image, job->key);
+	io = openParallelDmgPartition(image, -1, job->threads);
+
 	if(io == NULL) {
-		fprintf(stderr, "error: cannot open dmg image\n");
-		return 1;
+		fprintf(stderr, "error: %s: cannot open dmg image\n", job->ipsw);
+		return NULL;
 	}
-	
+
 	volume = openVolume(io);
 	if(volume == NULL) {
-		fprintf(stderr, "error: cannot open volume\n");
+		fprintf(stderr, "error: %s: cannot open volume\n", job->ipsw);
 		CLOSE(io);
-		return 1;
+		return NULL;
 	}
-	char *plistName = extractPlist(volume);
+
+	char *plist = extractPlist(volume);
+	closeVolume(volume);
 	CLOSE(io);
-	ASSERT(remove(filename) == 0, "Error deleting root filesystem.");
-
-    iphone_mtprops = fopen(plistName, "r");
-    assert(iphone_mtprops != NULL);
-    fseek(iphone_mtprops, 0, SEEK_END);
-    file_len = ftell(iphone_mtprops);
-
-    buffer = (char *)malloc(sizeof(char) * file_len);
-    fseek(iphone_mtprops, 0, SEEK_SET);
-    fread(buffer, file_len, 1, iphone_mtprops);
-
-    fclose(iphone_mtprops);
-
-    p = find_string(buffer, "<key>A-Speed Firmware</key>");
-    assert(p != NULL);
-
-    while (*p)
-    {
-        if (*p == '\n')
-            break;
-        p++;
-    }
-    while (*p)
-    {
-        if (*p == '>')
-            break;
-        p++;
-    }
-
-    p++;
-
-    a_speed_firmware = p;
-
-    while (*p)
-    {
-        if (*p == '<')
-            break;
-        p++;
-    }
-    a_speed_fw_len = p - a_speed_firmware;
-
-    p = find_string(p, "<key>Firmware</key>");
-    assert(p != NULL);
-
-    while (*p)
-    {
-        if (*p == '\n')
-            break;
-        p++;
-    }
-    while (*p)
-    {
-        if (*p == '>')
-            break;
-        p++;
-    }
-    p++;
-	firmware = p;
-    while (*p)
-    {
-        if (*p == '<')
-            break;
-        p++;
-    }
-    fw_len = p - firmware;
-    cleanup_base64(firmware, fw_len);
-    decode_base64(firmware, fw_len, firmware, (unsigned int *)&final_fw_len);
-    output = fopen("zephyr_main.bin", "a+");
-    fwrite(firmware, final_fw_len, 1, output);
-    fclose(output);
-    cleanup_base64(a_speed_firmware, a_speed_fw_len);
-    decode_base64(a_speed_firmware, a_speed_fw_len, a_speed_firmware, (unsigned int *)&final_a_speed_fw_len);
-    output = fopen("zephyr_aspeed.bin", "a+");
-    fwrite(a_speed_firmware, final_a_speed_fw_len, 1, output);
-    fclose(output);
-    free(buffer);
-
-
-	ASSERT(remove(plistName) == 0, "Error deleting iPhone.mtprops");
+
+	if(plist == NULL)
+		return NULL;
+
+	PlistIndex index;
+	plistIndex(plist, strlen(plist), &index);
+
+	snprintf(outName, sizeof(outName), "%szephyr_main.bin", job->prefix);
+	int mainFirmware = extractFirmware(&index, "Firmware", outName);
+	snprintf(outName, sizeof(outName), "%szephyr_aspeed.bin", job->prefix);
+	int aspeedFirmware = extractFirmware(&index, "A-Speed Firmware", outName);
+	free(index.entries);
+	free(plist);
+
+	if(!mainFirmware || !aspeedFirmware) {
+		fprintf(stderr, "error: %s: no firmware in iPhone.mtprops\n", job->ipsw);
+		return NULL;
+	}
+
+	job->result = 0;
+	return NULL;
+}
+
+int main(int argc, const char *argv[]) {
+	int jobCount = (argc - 1) / 3;
+	int cores = sysconf(_SC_NPROCESSORS_ONLN);
+	int failed = 0;
+	int i;
+
+	if(argc < 4 || ((argc - 1) % 3) != 0) {
+		printf("usage: %s <ipsw> <key> <root-fs-name> [<ipsw> <key> <root-fs-name> ...]\n", argv[0]);
+		printf("With more than one IPSW they are done in parallel and the output files are prefixed with the root-fs-name.\n");
+		return 0;
+	}
+
+	TestByteOrder();
+	base64Init();
+
+	DripwnJob* jobs = (DripwnJob*) calloc(jobCount, sizeof(DripwnJob));
+	pthread_t* threads = (pthread_t*) calloc(jobCount, sizeof(pthread_t));
+	char** prefixes = (char**) calloc(jobCount, sizeof(char*));
+
+	for(i = 0; i < jobCount; i++) {
+		jobs[i].ipsw = argv[1 + i * 3];
+		jobs[i].key = argv[2 + i * 3];
+		jobs[i].rootFS = argv[3 + i * 3];
+
+		// jobs running side by side share the cores between them
+		jobs[i].threads = (cores > jobCount) ? (cores / jobCount) : 1;
+
+		if(jobCount > 1) {
+			prefixes[i] = (char*) malloc(strlen(jobs[i].rootFS) + 2);
+			sprintf(prefixes[i], "%s_", jobs[i].rootFS);
+			jobs[i].prefix = prefixes[i];
+		} else {
+			jobs[i].prefix = "";
+		}
+	}
+
+	if(jobCount == 1) {
+		runJob(&jobs[0]);
+	} else {
+		for(i = 0; i < jobCount; i++)
+			ASSERT(pthread_create(&threads[i], NULL, runJob, &jobs[i]) == 0, "cannot start thread");
+
+		for(i = 0; i < jobCount; i++)
+			pthread_join(threads[i], NULL);
+	}
+
+	for(i = 0; i < jobCount; i++) {
+		if(jobs[i].result != 0)
+			failed++;
+		free(prefixes[i]);
+	}
+
+	free(prefixes);
+	free(threads);
+	free(jobs);
+
+	if(failed)
+		return 1;
+
 	printf("Zephyr files extracted succesfully.\n");
 	return 0;
-}
\ No newline at end of file
+}
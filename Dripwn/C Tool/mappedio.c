@@ -0,0 +1,322 @@
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+// written against the 1.0 API, SHA1_* is all the HMAC needed here
+#define OPENSSL_API_COMPAT 0x10000000L
+#include <openssl/evp.h>
+#include <openssl/sha.h>
+#include <common.h>
+#include "mappedio.h"
+
+typedef struct MappedFileInfo {
+	void* mapping;
+	size_t mappingLength;
+	const unsigned char* data;	// offset into the mapping, which is page aligned
+	off_t length;
+	off_t offset;
+} MappedFileInfo;
+
+static size_t mappedRead(AbstractFile* file, void* data, size_t len) {
+	MappedFileInfo* info = (MappedFileInfo*) file->data;
+
+	if(info->offset >= info->length)
+		return 0;
+
+	if(len > (info->length - info->offset))
+		len = info->length - info->offset;
+
+	memcpy(data, info->data + info->offset, len);
+	info->offset += len;
+	return len;
+}
+
+static size_t mappedWrite(AbstractFile* file, const void* data, size_t len) {
+	return 0;
+}
+
+static int mappedSeek(AbstractFile* file, off_t offset) {
+	((MappedFileInfo*) file->data)->offset = offset;
+	return 0;
+}
+
+static off_t mappedTell(AbstractFile* file) {
+	return ((MappedFileInfo*) file->data)->offset;
+}
+
+static off_t mappedGetLength(AbstractFile* file) {
+	return ((MappedFileInfo*) file->data)->length;
+}
+
+static void mappedClose(AbstractFile* file) {
+	MappedFileInfo* info = (MappedFileInfo*) file->data;
+
+	munmap(info->mapping, info->mappingLength);
+	free(info);
+	free(file);
+}
+
+AbstractFile* createAbstractFileFromMapping(const char* path, off_t offset, off_t length) {
+	off_t start = offset & ~((off_t) sysconf(_SC_PAGESIZE) - 1);
+	MappedFileInfo* info;
+	AbstractFile* file;
+	void* mapping;
+	int fd;
+
+	fd = open(path, O_RDONLY);
+	if(fd < 0)
+		return NULL;
+
+	mapping = mmap(NULL, (offset - start) + length, PROT_READ, MAP_PRIVATE, fd, start);
+	close(fd);
+
+	if(mapping == MAP_FAILED)
+		return NULL;
+
+	info = (MappedFileInfo*) malloc(sizeof(MappedFileInfo));
+	info->mapping = mapping;
+	info->mappingLength = (offset - start) + length;
+	info->data = (const unsigned char*) mapping + (offset - start);
+	info->length = length;
+	info->offset = 0;
+
+	file = (AbstractFile*) malloc(sizeof(AbstractFile));
+	file->data = info;
+	file->read = mappedRead;
+	file->write = mappedWrite;
+	file->seek = mappedSeek;
+	file->tell = mappedTell;
+	file->getLength = mappedGetLength;
+	file->close = mappedClose;
+	file->type = AbstractFileTypeFile;
+
+	return file;
+}
+
+const unsigned char* getAbstractFileMapping(AbstractFile* file, off_t* length) {
+	if(file->close != mappedClose)
+		return NULL;
+
+	*length = ((MappedFileInfo*) file->data)->length;
+	return ((MappedFileInfo*) file->data)->data;
+}
+
+// Only FileVault v2, with the AES and HMAC keys given in hex, like libdmg.
+// filevault.h only has the header with HAVE_CRYPT, and that needs the
+// OpenSSL it was written against, so the few fields used are here.
+#define VAULT_SIGNATURE 0x656e637263647361ULL
+#define VAULT_CHUNK_SIZE 4096
+#define VAULT_AES_KEY_LENGTH 16
+#define VAULT_HMAC_KEY_LENGTH 20
+
+typedef struct VaultHeader {
+	uint64_t signature;
+	uint32_t version;
+	uint32_t encIVSize;
+	uint32_t unk[5];
+	uint32_t uuid[4];
+	uint32_t blockSize;
+	uint64_t dataSize;
+	uint64_t dataOffset;
+} __attribute__((__packed__)) VaultHeader;
+
+typedef struct VaultInfo {
+	AbstractFile* file;
+	const unsigned char* mapping;
+	off_t mappingLength;
+
+	uint64_t dataOffset;
+	uint64_t dataSize;
+	off_t offset;
+
+	EVP_CIPHER_CTX* cipher;
+
+	// HMAC-SHA1 with the key already hashed in, for the IV of each chunk
+	SHA_CTX inner;
+	SHA_CTX outer;
+
+	uint64_t cachedChunk;
+	unsigned char cache[VAULT_CHUNK_SIZE];
+} VaultInfo;
+
+static void chunkIV(VaultInfo* info, uint32_t chunk, unsigned char* iv) {
+	unsigned char number[4] = { chunk >> 24, chunk >> 16, chunk >> 8, chunk };
+	unsigned char digest[SHA_DIGEST_LENGTH];
+	SHA_CTX ctx;
+
+	ctx = info->inner;
+	SHA1_Update(&ctx, number, sizeof(number));
+	SHA1_Final(digest, &ctx);
+
+	ctx = info->outer;
+	SHA1_Update(&ctx, digest, sizeof(digest));
+	SHA1_Final(digest, &ctx);
+
+	memcpy(iv, digest, 16);
+}
+
+static int decryptChunk(VaultInfo* info, uint64_t chunk, unsigned char* out) {
+	uint64_t where = info->dataOffset + (chunk * VAULT_CHUNK_SIZE);
+	unsigned char buffer[VAULT_CHUNK_SIZE];
+	const unsigned char* in;
+	unsigned char iv[16];
+	int outLen;
+
+	if(info->mapping) {
+		if((where + VAULT_CHUNK_SIZE) > info->mappingLength)
+			return FALSE;
+		in = info->mapping + where;
+	} else {
+		info->file->seek(info->file, where);
+		if(info->file->read(info->file, buffer, VAULT_CHUNK_SIZE) != VAULT_CHUNK_SIZE)
+			return FALSE;
+		in = buffer;
+	}
+
+	chunkIV(info, chunk, iv);
+	return EVP_DecryptInit_ex(info->cipher, NULL, NULL, NULL, iv)
+		&& EVP_DecryptUpdate(info->cipher, out, &outLen, in, VAULT_CHUNK_SIZE)
+		&& outLen == VAULT_CHUNK_SIZE;
+}
+
+static size_t vaultRead(AbstractFile* file, void* data, size_t len) {
+	VaultInfo* info = (VaultInfo*) file->data;
+	unsigned char* out = (unsigned char*) data;
+	size_t done = 0;
+
+	if(info->offset >= info->dataSize)
+		return 0;
+
+	if(len > (info->dataSize - info->offset))
+		len = info->dataSize - info->offset;
+
+	while(done < len) {
+		uint64_t chunk = info->offset / VAULT_CHUNK_SIZE;
+		size_t within = info->offset % VAULT_CHUNK_SIZE;
+		size_t n = VAULT_CHUNK_SIZE - within;
+
+		if(n > (len - done))
+			n = len - done;
+
+		if(n == VAULT_CHUNK_SIZE) {
+			// whole chunks skip the cache
+			if(!decryptChunk(info, chunk, out + done))
+				break;
+		} else {
+			if(chunk != info->cachedChunk) {
+				if(!decryptChunk(info, chunk, info->cache))
+					break;
+				info->cachedChunk = chunk;
+			}
+			memcpy(out + done, info->cache + within, n);
+		}
+
+		done += n;
+		info->offset += n;
+	}
+
+	return done;
+}
+
+static size_t vaultWrite(AbstractFile* file, const void* data, size_t len) {
+	return 0;
+}
+
+static int vaultSeek(AbstractFile* file, off_t offset) {
+	((VaultInfo*) file->data)->offset = offset;
+	return 0;
+}
+
+static off_t vaultTell(AbstractFile* file) {
+	return ((VaultInfo*) file->data)->offset;
+}
+
+static off_t vaultGetLength(AbstractFile* file) {
+	return ((VaultInfo*) file->data)->dataSize;
+}
+
+static void vaultClose(AbstractFile* file) {
+	VaultInfo* info = (VaultInfo*) file->data;
+
+	EVP_CIPHER_CTX_free(info->cipher);
+	info->file->close(info->file);
+	free(info);
+	free(file);
+}
+
+static void hmacKeyContexts(VaultInfo* info, const uint8_t* key) {
+	unsigned char pad[64];
+	int i;
+
+	memset(pad, 0x36, sizeof(pad));
+	for(i = 0; i < VAULT_HMAC_KEY_LENGTH; i++)
+		pad[i] ^= key[i];
+	SHA1_Init(&info->inner);
+	SHA1_Update(&info->inner, pad, sizeof(pad));
+
+	memset(pad, 0x5C, sizeof(pad));
+	for(i = 0; i < VAULT_HMAC_KEY_LENGTH; i++)
+		pad[i] ^= key[i];
+	SHA1_Init(&info->outer);
+	SHA1_Update(&info->outer, pad, sizeof(pad));
+}
+
+AbstractFile* createAbstractFileFromMappedFileVault(AbstractFile* file, const char* key) {
+	VaultHeader header;
+	VaultInfo* info;
+	AbstractFile* vault;
+	uint8_t* keyBytes;
+	size_t keyLength;
+
+	if(file == NULL)
+		return NULL;
+
+	file->seek(file, 0);
+	if(file->read(file, &header, sizeof(header)) != sizeof(header))
+		return NULL;
+
+	FLIPENDIAN(header.signature);
+	FLIPENDIAN(header.dataSize);
+	FLIPENDIAN(header.dataOffset);
+
+	// not encrypted after all
+	if(header.signature != VAULT_SIGNATURE)
+		return file;
+
+	hexToBytes(key, &keyBytes, &keyLength);
+	if(keyLength < (VAULT_AES_KEY_LENGTH + VAULT_HMAC_KEY_LENGTH)) {
+		fprintf(stderr, "error: a FileVault key is %d hex digits\n", (VAULT_AES_KEY_LENGTH + VAULT_HMAC_KEY_LENGTH) * 2);
+		free(keyBytes);
+		return NULL;
+	}
+
+	info = (VaultInfo*) malloc(sizeof(VaultInfo));
+	info->file = file;
+	info->mapping = getAbstractFileMapping(file, &info->mappingLength);
+	info->dataOffset = header.dataOffset;
+	info->dataSize = header.dataSize;
+	info->offset = 0;
+	info->cachedChunk = (uint64_t) -1;
+
+	// EVP picks AES-NI and the like by itself. No padding: chunks are whole
+	// cipher blocks and each is decrypted by itself.
+	info->cipher = EVP_CIPHER_CTX_new();
+	EVP_DecryptInit_ex(info->cipher, EVP_aes_128_cbc(), NULL, keyBytes, NULL);
+	EVP_CIPHER_CTX_set_padding(info->cipher, 0);
+
+	hmacKeyContexts(info, keyBytes + VAULT_AES_KEY_LENGTH);
+	free(keyBytes);
+
+	vault = (AbstractFile*) malloc(sizeof(AbstractFile));
+	vault->data = info;
+	vault->read = vaultRead;
+	vault->write = vaultWrite;
+	vault->seek = vaultSeek;
+	vault->tell = vaultTell;
+	vault->getLength = vaultGetLength;
+	vault->close = vaultClose;
+	vault->type = AbstractFileTypeFile;
+
+	return vault;
+}
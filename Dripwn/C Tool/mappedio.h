@@ -0,0 +1,19 @@
+#ifndef MAPPEDIO_H
+#define MAPPEDIO_H
+
+#include <common.h>
+#include <abstractfile.h>
+
+// length bytes of path from offset on, mapped read only. Reads are a memcpy.
+AbstractFile* createAbstractFileFromMapping(const char* path, off_t offset, off_t length);
+
+// The mapped bytes of a file from createAbstractFileFromMapping, or NULL for
+// any other kind of AbstractFile.
+const unsigned char* getAbstractFileMapping(AbstractFile* file, off_t* length);
+
+// A drop-in for libdmg's createAbstractFileFromFileVault, read only. Whole
+// chunks are decrypted straight into the caller's buffer, from the mapping
+// when file is mapped, with the cipher's hardware support where there is any.
+AbstractFile* createAbstractFileFromMappedFileVault(AbstractFile* file, const char* key);
+
+#endif
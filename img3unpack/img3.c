@@ -1,141 +1,225 @@
 /*
- * cmw
- *
- * greets to dre/wizdaz/pumpkin/saurik/
- *  
- *
+ * Img3 parsing, without copying: the file is mmapped and tags are walked
+ * in place.
  */
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <dirent.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include "img3.h"
 
-const char *str_magic(unsigned int magic)
+int img3_parse(Img3File* file, const void* buffer, size_t size)
 {
-	static char str[5] = { 0, 0, 0, 0, 0 };
-  magic = ntohl(magic);
-  memcpy(str, (void *)&magic, 4);
+	const Img3Root* root = (const Img3Root*) buffer;
 
-	return str;
+	file->base = (const uint8_t*) buffer;
+	file->size = size;
+	file->root = NULL;
+	file->mapped = 0;
+
+	if(size < sizeof(Img3Root) || root->magic != IMG3_MAGIC)
+		return -1;
+
+	if(root->size > size || root->dataSize > (root->size - sizeof(Img3Root)))
+		return -1;
+
+	file->root = root;
+	return 0;
+}
+
+int img3_open(Img3File* file, const char* path)
+{
+	struct stat st;
+	void* map;
+	int fd;
+
+	memset(file, 0, sizeof(*file));
+
+	if((fd = open(path, O_RDONLY)) < 0)
+		return -1;
+
+	if(fstat(fd, &st) < 0 || st.st_size < (off_t) sizeof(Img3Root)) {
+		close(fd);
+		return -1;
+	}
+
+	map = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if(map == MAP_FAILED)
+		return -1;
+
+	// The tags get read front to back exactly once
+	madvise(map, st.st_size, MADV_SEQUENTIAL);
+
+	if(img3_parse(file, map, st.st_size) < 0) {
+		munmap(map, st.st_size);
+		return -1;
+	}
+
+	file->mapped = 1;
+	return 0;
 }
 
-void dumpImg3Header(const Img3* header)
+void img3_close(Img3File* file)
 {
-	printf("=======================================\n");
-	printf("Header size: %d\n", sizeof(*header));
-
-	printf("Magic:       0x%x (%s)\n", header->magic, str_magic(header->magic));
-	printf("Length:      %ld\n", header->dataLenPad);
-	printf("Unknown:     %ld\n", header->u1);
-	printf("Cert Offset: %ld\n", header->certOffset);
-	printf("Name:        0x%x (%s)\n", header->name, str_magic(header->name));
-	printf("Type:        0x%x (%s)\n", header->type, str_magic(header->type));
-	printf("nameOffset:  %ld\n", header->nameOffset);
-	printf("dataLen:     %ld\n", header->dataLen);
+	if(file->mapped)
+		munmap((void*) file->base, file->size);
+
+	memset(file, 0, sizeof(*file));
 }
-void dumpImg3Footer(const Img3_footer2* footer)
+
+const Img3Tag* img3_next_tag(const Img3File* file, const Img3Tag* tag)
 {
-	printf("=======================================\n");
-	printf("Footer size: %d\n", sizeof(*footer));
+	const uint8_t* start = file->base + sizeof(Img3Root);
+	const uint8_t* end = start + file->root->dataSize;
+	const uint8_t* next;
 
-	printf("Block Size: %ld bytes\n", footer->blockSize);
-	printf("Signature:  %ld bytes\n", footer->sigLen);
-	printf("Cert Head:  0x%x (%s)\n", footer->cert_magic, str_magic(footer->cert_magic));
-	printf("Cert Size:  %ld\n", footer->cert_size);
-	printf("Certficate: %ld bytes\n", sizeof(footer->cert));
+	if(tag == NULL)
+		next = start;
+	else
+		next = (const uint8_t*) tag + tag->size;
 
-}
-int main(int argc, char *argv[]) {
+	if((size_t)(end - next) < sizeof(Img3Tag))
+		return NULL;
+
+	tag = (const Img3Tag*) next;
+	if(tag->size < sizeof(Img3Tag) || tag->size > (size_t)(end - next)
+			|| tag->dataSize > (tag->size - sizeof(Img3Tag)))
+		return NULL;
 
-	Img3 *pHeaderImg3 = NULL;
-	Img3_footer1 *pFooterImg3_1 = NULL;
-	Img3_footer2 *pFooterImg3_2 = NULL;
-	dataFlag *dF = NULL;
+	return tag;
+}
 
-	FILE *fw = NULL, *unpack = NULL;
-	unsigned long dataSize = 0;
-	char *fBuf = NULL, *name = NULL;
-	int skip_header =0, dataLen = 0, offSet=0, footerSize = 0;
+const Img3Tag* img3_find_tag(const Img3File* file, uint32_t magic)
+{
+	const Img3Tag* tag = NULL;
 
-	if(argc != 3) {
-			printf("Syntax: img3 file.img3 outfile.img3\n");
-			return 0;
+	while((tag = img3_next_tag(file, tag)) != NULL) {
+		if(tag->magic == magic)
+			return tag;
 	}
-	pHeaderImg3 = (Img3 *)malloc(sizeof(Img3));
-	pFooterImg3_1 = (Img3_footer1 *)malloc(sizeof(Img3_footer1));
-	pFooterImg3_2 = (Img3_footer2 *)malloc(sizeof(Img3_footer2));
 
-	dF = (dataFlag *)malloc(sizeof(dataFlag));
+	return NULL;
+}
 
-	if(!(fw = fopen(argv[1], "rb")))
-		return -1;
+const char* img3_magic_name(uint32_t magic)
+{
+	static __thread char str[5];
 
-	fseek(fw, 0, SEEK_END);
-	dataSize = ftell(fw);
-	fseek(fw, 0, SEEK_SET);
+	str[0] = magic >> 24;
+	str[1] = magic >> 16;
+	str[2] = magic >> 8;
+	str[3] = magic;
+	str[4] = '\0';
 
-	fBuf = malloc(dataSize);
-	if(fread(fBuf, 1, dataSize, fw) != dataSize)
-		return -1;
-	fclose(fw);
+	return str;
+}
 
-	memcpy(pHeaderImg3, fBuf, sizeof(*pHeaderImg3)); 
-	if(pHeaderImg3->magic == IMG3_MAGIC_UC || pHeaderImg3->magic == IMG3_MAGIC_LC) {
-		dumpImg3Header(pHeaderImg3);
-	} else {
-		printf("Invalid Img3 file\n");
-		return -1;
-	}
+typedef struct BatchState {
+	char** paths;
+	int count;
+	int next;
+	int failed;
+	Img3BatchFn fn;
+	void* ctx;
+	pthread_mutex_t lock;
+} BatchState;
+
+static void* batch_worker(void* arg)
+{
+	BatchState* state = (BatchState*) arg;
+	Img3File file;
+
+	while(1) {
+		int i;
+		int ret;
+
+		pthread_mutex_lock(&state->lock);
+		i = state->next++;
+		pthread_mutex_unlock(&state->lock);
+
+		if(i >= state->count)
+			break;
 
-	dataLen = (((pHeaderImg3->dataLen >> 2) + !!(pHeaderImg3->dataLen & 3)) << 2);
-  memcpy(pFooterImg3_1, fBuf + sizeof(Img3) + dataLen, sizeof(*pFooterImg3_1));
-
-  if (pFooterImg3_1->magic == IMG3_FOOTER_MAGIC)
-		printf("Header:      %s\n", str_magic(pFooterImg3_1->magic));
-  else
-		skip_header=1;
-
-	if(!skip_header) {
-		name = calloc(1,pFooterImg3_1->name_len+1);
-		memcpy(name, fBuf + sizeof(Img3) + pHeaderImg3->nameOffset + 4 , pFooterImg3_1->name_len);
-		printf("Name:        %s\n", name);
-		dataLen = (((pFooterImg3_1->name_len >> 2) + !!(pFooterImg3_1->name_len & 3)) << 2);
-		memcpy(dF, fBuf + sizeof(Img3) + pHeaderImg3->nameOffset + dataLen + sizeof(pFooterImg3_1->name_len), sizeof(*dF));
-		offSet = sizeof(*dF);
-		while(offSet < pHeaderImg3->dataLenPad) {
-			printf("Flag:        0x%x (%s)\n", dF->name, str_magic(dF->name));
-      if(dF->name == END_FLAG_HSHS) {
-				offSet += - 16;
-				memcpy(pFooterImg3_2, fBuf + sizeof(Img3) + pHeaderImg3->nameOffset + dataLen + sizeof(pFooterImg3_1->name_len) + offSet, sizeof(*pFooterImg3_2));
-				break;
-			}
-			memcpy(dF, fBuf + sizeof(Img3) + pHeaderImg3->nameOffset + dataLen + sizeof(pFooterImg3_1->name_len) + offSet, sizeof(*dF));
-		  offSet += sizeof(*dF);
+		if(img3_open(&file, state->paths[i]) < 0) {
+			ret = state->fn(state->paths[i], NULL, state->ctx);
+		} else {
+			ret = state->fn(state->paths[i], &file, state->ctx);
+			img3_close(&file);
 		}
-	} else {
-    memcpy(dF, (fBuf + sizeof(Img3) + pHeaderImg3->nameOffset) - 12 , sizeof(*dF));
-		offSet = sizeof(*dF);
-    while(offSet < pHeaderImg3->dataLenPad) {
-    	printf("Flag:        0x%x (%s)\n", dF->name, str_magic(dF->name));
-			printf("Offset:      %ld\n", offSet);
-      if(dF->name == END_FLAG_HSHS) {
-				offSet += - 16;
-				memcpy(pFooterImg3_2, (fBuf + sizeof(Img3) + pHeaderImg3->nameOffset) - 12 + offSet, sizeof(*pFooterImg3_2));
-				break;
-			}
-			memcpy(dF, (fBuf + sizeof(Img3) + pHeaderImg3->nameOffset) - 12 + offSet , sizeof(*dF));
-			offSet += sizeof(*dF);
+
+		if(ret != 0) {
+			pthread_mutex_lock(&state->lock);
+			state->failed++;
+			pthread_mutex_unlock(&state->lock);
 		}
 	}
-	
-	dumpImg3Footer(pFooterImg3_2);
 
-  if(!(unpack = fopen(argv[2], "wb")))
-			return -1;
+	return NULL;
+}
 
-	if(fwrite(fBuf + sizeof(Img3), 1, pHeaderImg3->dataLen, unpack) != pHeaderImg3->dataLen)
+int img3_batch(const char* dir, int threads, Img3BatchFn fn, void* ctx)
+{
+	BatchState state;
+	pthread_t* workers;
+	struct dirent* entry;
+	DIR* d;
+	int started;
+	int i;
+
+	if((d = opendir(dir)) == NULL)
 		return -1;
-	fclose(unpack);
 
-	return 0;
+	memset(&state, 0, sizeof(state));
+	state.fn = fn;
+	state.ctx = ctx;
+	pthread_mutex_init(&state.lock, NULL);
+
+	while((entry = readdir(d)) != NULL) {
+		struct stat st;
+		char* path = malloc(strlen(dir) + strlen(entry->d_name) + 2);
+		sprintf(path, "%s/%s", dir, entry->d_name);
+
+		if(stat(path, &st) < 0 || !S_ISREG(st.st_mode)) {
+			free(path);
+			continue;
+		}
+
+		state.paths = realloc(state.paths, (state.count + 1) * sizeof(char*));
+		state.paths[state.count++] = path;
+	}
+	closedir(d);
+
+	if(threads <= 0)
+		threads = sysconf(_SC_NPROCESSORS_ONLN);
+	if(threads > state.count)
+		threads = state.count;
+	if(threads < 1)
+		threads = 1;
+
+	workers = malloc(threads * sizeof(pthread_t));
+	for(started = 0; started < threads; started++) {
+		if(pthread_create(&workers[started], NULL, batch_worker, &state) != 0)
+			break;
+	}
+
+	// Nothing could be started, so do the work here
+	if(started == 0)
+		batch_worker(&state);
+
+	for(i = 0; i < started; i++)
+		pthread_join(workers[i], NULL);
+
+	for(i = 0; i < state.count; i++)
+		free(state.paths[i]);
+	free(state.paths);
+	free(workers);
+	pthread_mutex_destroy(&state.lock);
+
+	return state.failed;
 }
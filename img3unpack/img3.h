@@ -1,44 +1,73 @@
-#include <arpa/inet.h>
-
-struct Img3 {
-  unsigned int magic;
-  unsigned int dataLenPad;
-  unsigned int u1; // offSet to 20 byte footer
-  unsigned int certOffset;
-  unsigned int name;
-  unsigned int type;
-  unsigned int nameOffset;
-  unsigned int dataLen;
-} typedef Img3;
-
-#define IMG3_MAGIC_UC   0x496d6733
-#define IMG3_MAGIC_LC   0x696D6733
-
-struct Img3_footer1 {
-	unsigned int magic;
-	unsigned int u1;
-	unsigned int u2;
-  unsigned int name_len;
-} typedef Img3_footer1;
-
-struct dataFlag {
-  unsigned int name;
-  unsigned int u5;
-  unsigned int u6;
-  unsigned int u7;
-} typedef dataFlag;
-
-struct Img3_footer2 {
-	unsigned int name;
-	unsigned int blockSize;
-	unsigned int sigLen;
-	unsigned char sig[0x80];
-	unsigned int cert_magic;
-	unsigned int cert_size;
-	unsigned char cert[0xc18];
-} typedef Img3_footer2;
-
-#define IMG3_FOOTER_MAGIC		0x56455253
-#define START_FLAG_SEPO		  0x5345504f
-#define OPTION_BORD					0x424f5244
-#define END_FLAG_HSHS			  0x53485348
+#ifndef IMG3_H
+#define IMG3_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Same values as openiboot/includes/images.h. Every field is little endian,
+// so the magics read as their names backwards in a hex dump.
+#define IMG3_MAGIC 0x496d6733
+#define IMG3_DATA_MAGIC 0x44415441
+#define IMG3_VERS_MAGIC 0x56455253
+#define IMG3_SEPO_MAGIC 0x5345504f
+#define IMG3_SCEP_MAGIC 0x53434550
+#define IMG3_BORD_MAGIC 0x424f5244
+#define IMG3_BDID_MAGIC 0x42444944
+#define IMG3_SHSH_MAGIC 0x53485348
+#define IMG3_CERT_MAGIC 0x43455254
+#define IMG3_KBAG_MAGIC 0x4B424147
+
+typedef struct Img3Tag {
+	uint32_t magic;
+	uint32_t size;		// the whole tag, header and padding included
+	uint32_t dataSize;
+	uint8_t data[];
+} __attribute__((__packed__)) Img3Tag;
+
+typedef struct Img3Root {
+	uint32_t magic;
+	uint32_t size;		// the whole file
+	uint32_t dataSize;	// all of the tags
+	uint32_t shshOffset;	// from the first tag to the SHSH tag
+	uint32_t name;
+} __attribute__((__packed__)) Img3Root;
+
+typedef struct Img3KBAG {
+	uint32_t key_modifier;
+	uint32_t key_bits;
+	uint8_t iv[16];
+	uint8_t key[];
+} __attribute__((__packed__)) Img3KBAG;
+
+// An image either mapped from a file or wrapped around a caller's buffer.
+// Tags are never copied: everything handed out points into the image.
+typedef struct Img3File {
+	const uint8_t* base;
+	size_t size;
+	const Img3Root* root;
+	int mapped;
+} Img3File;
+
+// Both return 0 on success and -1 if the file can't be read or isn't a
+// well formed Img3.
+int img3_open(Img3File* file, const char* path);
+int img3_parse(Img3File* file, const void* buffer, size_t size);
+void img3_close(Img3File* file);
+
+// NULL starts from the first tag; NULL comes back after the last one.
+const Img3Tag* img3_next_tag(const Img3File* file, const Img3Tag* tag);
+const Img3Tag* img3_find_tag(const Img3File* file, uint32_t magic);
+
+// The four character name of a magic, in a static buffer.
+const char* img3_magic_name(uint32_t magic);
+
+// Called once per image, possibly from several threads at once. file is
+// NULL if path could not be parsed.
+typedef int (*Img3BatchFn)(const char* path, const Img3File* file, void* ctx);
+
+// Runs fn on every regular file in dir using up to threads workers (0
+// means one per CPU). Returns the number of calls that returned non-zero,
+// or -1 if dir can't be read.
+int img3_batch(const char* dir, int threads, Img3BatchFn fn, void* ctx);
+
+#endif
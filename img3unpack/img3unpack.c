@@ -0,0 +1,257 @@
+/*
+ * cmw
+ *
+ * greets to dre/wizdaz/pumpkin/saurik/
+ *  
+ *
+ * Build with: gcc -O2 -o img3unpack img3unpack.c img3.c oibrpc.c -lpthread -lusb-1.0
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <sys/stat.h>
+#include "img3.h"
+#include "oibrpc.h"
+
+static void dumpImg3(const Img3File* file)
+{
+	const Img3Tag* tag = NULL;
+
+	printf("=======================================\n");
+	printf("Magic:       0x%x (%s)\n", file->root->magic, img3_magic_name(file->root->magic));
+	printf("Length:      %u\n", file->root->size);
+	printf("Tags:        %u bytes\n", file->root->dataSize);
+	printf("SHSH Offset: %u\n", file->root->shshOffset);
+	printf("Name:        0x%x (%s)\n", file->root->name, img3_magic_name(file->root->name));
+
+	while((tag = img3_next_tag(file, tag)) != NULL) {
+		printf("Tag:         0x%x (%s), %u bytes at %u\n", tag->magic, img3_magic_name(tag->magic),
+				tag->dataSize, (unsigned int)(tag->data - file->base));
+
+		if(tag->magic == IMG3_VERS_MAGIC && tag->dataSize > 4)
+			printf("Version:     %.*s\n", (int)(tag->dataSize - 4), (const char*)(tag->data + 4));
+
+		if(tag->magic == IMG3_KBAG_MAGIC && tag->dataSize >= sizeof(Img3KBAG))
+			printf("KBAG:        type %u, %u bits\n", ((const Img3KBAG*) tag->data)->key_modifier,
+					((const Img3KBAG*) tag->data)->key_bits);
+	}
+}
+
+static int writeData(const Img3File* file, const char* out)
+{
+	const Img3Tag* data = img3_find_tag(file, IMG3_DATA_MAGIC);
+	FILE* unpack;
+
+	if(data == NULL) {
+		fprintf(stderr, "%s: no DATA tag\n", out);
+		return -1;
+	}
+
+	if(!(unpack = fopen(out, "wb")))
+		return -1;
+
+	if(fwrite(data->data, 1, data->dataSize, unpack) != data->dataSize) {
+		fclose(unpack);
+		return -1;
+	}
+
+	fclose(unpack);
+	return 0;
+}
+
+static int unpackOne(const char* path, const Img3File* file, void* ctx)
+{
+	const char* outDir = (const char*) ctx;
+	const char* base = strrchr(path, '/');
+	char* out;
+	int ret;
+
+	if(file == NULL) {
+		fprintf(stderr, "%s: invalid Img3 file\n", path);
+		return -1;
+	}
+
+	base = base ? (base + 1) : path;
+	out = malloc(strlen(outDir) + strlen(base) + 2);
+	sprintf(out, "%s/%s", outDir, base);
+	ret = writeData(file, out);
+	free(out);
+
+	return ret;
+}
+
+typedef struct KeyEntry {
+	char* path;
+	uint32_t type;
+	uint32_t bits;
+	OIBRPCKBAG kbag;
+} KeyEntry;
+
+typedef struct KeyList {
+	KeyEntry* entries;
+	int count;
+	pthread_mutex_t lock;
+} KeyList;
+
+static int collectKBAGs(const char* path, const Img3File* file, void* ctx)
+{
+	KeyList* list = (KeyList*) ctx;
+	const Img3Tag* tag = NULL;
+
+	if(file == NULL) {
+		fprintf(stderr, "%s: invalid Img3 file\n", path);
+		return -1;
+	}
+
+	while((tag = img3_next_tag(file, tag)) != NULL) {
+		const Img3KBAG* kbag = (const Img3KBAG*) tag->data;
+		size_t keyLen;
+		KeyEntry* entry;
+
+		if(tag->magic != IMG3_KBAG_MAGIC || tag->dataSize < sizeof(Img3KBAG))
+			continue;
+
+		keyLen = tag->dataSize - sizeof(Img3KBAG);
+		if(keyLen > sizeof(entry->kbag.key))
+			keyLen = sizeof(entry->kbag.key);
+
+		pthread_mutex_lock(&list->lock);
+		list->entries = realloc(list->entries, (list->count + 1) * sizeof(KeyEntry));
+		entry = &list->entries[list->count++];
+		entry->path = strdup(path);
+		entry->type = kbag->key_modifier;
+		entry->bits = kbag->key_bits;
+		memset(&entry->kbag, 0, sizeof(entry->kbag));
+		memcpy(entry->kbag.iv, kbag->iv, sizeof(entry->kbag.iv));
+		memcpy(entry->kbag.key, kbag->key, keyLen);
+		pthread_mutex_unlock(&list->lock);
+	}
+
+	return 0;
+}
+
+static int compareKeys(const void* a, const void* b)
+{
+	const KeyEntry* x = (const KeyEntry*) a;
+	const KeyEntry* y = (const KeyEntry*) b;
+	int ret = strcmp(x->path, y->path);
+
+	return ret ? ret : ((x->type > y->type) - (x->type < y->type));
+}
+
+static void printHex(const uint8_t* data, size_t len)
+{
+	size_t i;
+
+	for(i = 0; i < len; i++)
+		printf("%02x", data[i]);
+}
+
+// Every KBAG of a file, or of every file in a directory, goes to the device
+// in as few requests as they fit in.
+static int decryptKeys(const char* path, int threads)
+{
+	KeyList list;
+	struct stat st;
+	OIBRPCKBAG* kbags;
+	int failed;
+	int i;
+
+	memset(&list, 0, sizeof(list));
+	pthread_mutex_init(&list.lock, NULL);
+
+	if(stat(path, &st) == 0 && S_ISDIR(st.st_mode)) {
+		failed = img3_batch(path, threads, collectKBAGs, &list);
+		if(failed < 0) {
+			fprintf(stderr, "Can't read %s\n", path);
+			pthread_mutex_destroy(&list.lock);
+			return -1;
+		}
+	} else {
+		Img3File file;
+		if(img3_open(&file, path) < 0) {
+			failed = collectKBAGs(path, NULL, &list) ? 1 : 0;
+		} else {
+			failed = collectKBAGs(path, &file, &list) ? 1 : 0;
+			img3_close(&file);
+		}
+	}
+	pthread_mutex_destroy(&list.lock);
+
+	if(list.count == 0) {
+		fprintf(stderr, "%s: no KBAGs\n", path);
+		return -1;
+	}
+
+	qsort(list.entries, list.count, sizeof(KeyEntry), compareKeys);
+
+	kbags = malloc(list.count * sizeof(OIBRPCKBAG));
+	for(i = 0; i < list.count; i++)
+		kbags[i] = list.entries[i].kbag;
+
+	if(oibrpc_open() != 0) {
+		failed = -1;
+	} else if(oibrpc_decrypt_kbags(kbags, list.count) != 0) {
+		oibrpc_close();
+		failed = -1;
+	} else {
+		oibrpc_close();
+
+		for(i = 0; i < list.count; i++) {
+			size_t keyLen = list.entries[i].bits / 8;
+			if(keyLen > sizeof(kbags[i].key))
+				keyLen = sizeof(kbags[i].key);
+
+			printf("%s: type %u, IV ", list.entries[i].path, list.entries[i].type);
+			printHex(kbags[i].iv, sizeof(kbags[i].iv));
+			printf(", key ");
+			printHex(kbags[i].key, keyLen);
+			printf("\n");
+		}
+	}
+
+	for(i = 0; i < list.count; i++)
+		free(list.entries[i].path);
+	free(list.entries);
+	free(kbags);
+
+	return failed ? -1 : 0;
+}
+
+int main(int argc, char *argv[])
+{
+	Img3File file;
+	int ret;
+
+	if(argc >= 4 && strcmp(argv[1], "-d") == 0) {
+		int failed = img3_batch(argv[2], (argc > 4) ? atoi(argv[4]) : 0, unpackOne, argv[3]);
+		if(failed < 0) {
+			fprintf(stderr, "Can't read %s\n", argv[2]);
+			return -1;
+		}
+
+		return failed ? -1 : 0;
+	}
+
+	if(argc >= 3 && strcmp(argv[1], "-k") == 0)
+		return decryptKeys(argv[2], (argc > 3) ? atoi(argv[3]) : 0);
+
+	if(argc != 3) {
+		printf("Syntax: img3unpack file.img3 outfile\n");
+		printf("        img3unpack -d indir outdir [threads]\n");
+		printf("        img3unpack -k file.img3|indir [threads]   (decrypts the KBAGs on an openiboot device)\n");
+		return 0;
+	}
+
+	if(img3_open(&file, argv[1]) < 0) {
+		printf("Invalid Img3 file\n");
+		return -1;
+	}
+
+	dumpImg3(&file);
+	ret = writeData(&file, argv[2]);
+	img3_close(&file);
+
+	return ret;
+}
@@ -0,0 +1,230 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <libusb-1.0/libusb.h>
+#include "oibrpc.h"
+
+#define OPENIBOOTCMD_DUMPBUFFER_GOAHEAD 2
+#define OPENIBOOTCMD_RPC 8
+#define OPENIBOOTCMD_RPC_GOAHEAD 9
+#define OPENIBOOTCMD_RPC_REPLY 10
+
+typedef struct OpenIBootCmd {
+	uint32_t command;
+	uint32_t dataLen;
+} __attribute__((__packed__)) OpenIBootCmd;
+
+typedef struct RPCRequest {
+	uint32_t operation;
+	uint32_t tag;
+	uint32_t args[4];
+	uint32_t dataLen;
+} __attribute__((__packed__)) RPCRequest;
+
+typedef struct RPCResponse {
+	uint32_t operation;
+	uint32_t tag;
+	int32_t status;
+	uint32_t dataLen;
+} __attribute__((__packed__)) RPCResponse;
+
+static libusb_device_handle* device;
+static int deviceInterface;
+static uint32_t nextTag;
+
+static int sendCommand(uint32_t command, uint32_t dataLen)
+{
+	OpenIBootCmd cmd;
+	int transferred;
+
+	cmd.command = command;
+	cmd.dataLen = dataLen;
+	return libusb_interrupt_transfer(device, 4, (unsigned char*) &cmd, sizeof(cmd), &transferred, 1000);
+}
+
+// skips the console notifications that may be queued in front of it
+static int readReply(uint32_t command, OpenIBootCmd* cmd, int timeout)
+{
+	int transferred;
+
+	while(1) {
+		if(libusb_interrupt_transfer(device, 0x83, (unsigned char*) cmd, sizeof(OpenIBootCmd), &transferred, timeout) != 0)
+			return -1;
+
+		if(transferred == sizeof(OpenIBootCmd) && cmd->command == command)
+			return 0;
+	}
+}
+
+static libusb_device* findDevice(libusb_device** devices, ssize_t count, int* interface)
+{
+	ssize_t d;
+	int i;
+	int a;
+
+	for(d = 0; d < count; d++) {
+		struct libusb_device_descriptor descriptor;
+		struct libusb_config_descriptor* config;
+
+		if(libusb_get_device_descriptor(devices[d], &descriptor) != 0)
+			continue;
+
+		if(descriptor.idVendor != 0x0525 || descriptor.idProduct != 0x1280)
+			continue;
+
+		if(libusb_get_config_descriptor(devices[d], 0, &config) != 0)
+			continue;
+
+		for(i = 0; i < config->bNumInterfaces; i++) {
+			for(a = 0; a < config->interface[i].num_altsetting; a++) {
+				if(config->interface[i].altsetting[a].bInterfaceClass == 0xFF
+					&& config->interface[i].altsetting[a].bInterfaceSubClass == 0xFF
+					&& config->interface[i].altsetting[a].bInterfaceProtocol == 0x51) {
+					libusb_free_config_descriptor(config);
+					*interface = i;
+					return devices[d];
+				}
+			}
+		}
+
+		libusb_free_config_descriptor(config);
+	}
+
+	return NULL;
+}
+
+int oibrpc_open()
+{
+	libusb_device** devices;
+	libusb_device* dev;
+	ssize_t count;
+
+	if(libusb_init(NULL) != 0) {
+		fprintf(stderr, "could not start libusb\n");
+		return -1;
+	}
+
+	count = libusb_get_device_list(NULL, &devices);
+	dev = findDevice(devices, count, &deviceInterface);
+
+	if(!dev || libusb_open(dev, &device) != 0) {
+		fprintf(stderr, "no openiboot device found\n");
+		libusb_free_device_list(devices, 1);
+		libusb_exit(NULL);
+		return -1;
+	}
+
+	libusb_free_device_list(devices, 1);
+
+	if(libusb_claim_interface(device, deviceInterface) != 0) {
+		fprintf(stderr, "could not claim the interface, is oibc running?\n");
+		libusb_close(device);
+		libusb_exit(NULL);
+		return -1;
+	}
+
+	return 0;
+}
+
+void oibrpc_close()
+{
+	libusb_release_interface(device, deviceInterface);
+	libusb_close(device);
+	libusb_exit(NULL);
+}
+
+int oibrpc_call(uint32_t operation, const uint32_t args[4], const void* data, uint32_t dataLen,
+		int32_t* status, void** reply, uint32_t* replyLen)
+{
+	uint32_t requestLen = sizeof(RPCRequest) + dataLen;
+	RPCRequest* request;
+	RPCResponse* response;
+	OpenIBootCmd cmd;
+	int transferred;
+	int ret;
+
+	if(dataLen > OIBRPC_MAX_DATA)
+		return -1;
+
+	request = malloc(requestLen);
+	request->operation = operation;
+	request->tag = ++nextTag;
+	memcpy(request->args, args, sizeof(request->args));
+	request->dataLen = dataLen;
+	memcpy(request + 1, data, dataLen);
+
+	if(sendCommand(OPENIBOOTCMD_RPC, requestLen) != 0 || readReply(OPENIBOOTCMD_RPC_GOAHEAD, &cmd, 1000) != 0) {
+		fprintf(stderr, "no answer from the device\n");
+		free(request);
+		return -1;
+	}
+
+	if(cmd.dataLen != requestLen) {
+		fprintf(stderr, "the device is busy\n");
+		free(request);
+		return -1;
+	}
+
+	ret = libusb_bulk_transfer(device, 2, (unsigned char*) request, requestLen, &transferred, 5000);
+	free(request);
+	if(ret != 0 || transferred != requestLen) {
+		fprintf(stderr, "sending the request failed (%d)\n", ret);
+		return -1;
+	}
+
+	if(readReply(OPENIBOOTCMD_RPC_REPLY, &cmd, 10000) != 0 || cmd.dataLen < sizeof(RPCResponse)) {
+		fprintf(stderr, "the device never answered\n");
+		return -1;
+	}
+
+	response = malloc(cmd.dataLen);
+	if(sendCommand(OPENIBOOTCMD_DUMPBUFFER_GOAHEAD, cmd.dataLen) != 0
+			|| libusb_bulk_transfer(device, 0x81, (unsigned char*) response, cmd.dataLen, &transferred, 5000) != 0
+			|| transferred != cmd.dataLen) {
+		fprintf(stderr, "reading the reply failed\n");
+		free(response);
+		return -1;
+	}
+
+	if(response->tag != nextTag || response->dataLen > (cmd.dataLen - sizeof(RPCResponse))) {
+		fprintf(stderr, "the reply is not for this request\n");
+		free(response);
+		return -1;
+	}
+
+	*status = response->status;
+	*replyLen = response->dataLen;
+	*reply = malloc(response->dataLen ? response->dataLen : 1);
+	memcpy(*reply, response + 1, response->dataLen);
+	free(response);
+
+	return 0;
+}
+
+int oibrpc_decrypt_kbags(OIBRPCKBAG* kbags, int count)
+{
+	static const uint32_t noArgs[4] = { 0, 0, 0, 0 };
+	const int perRequest = OIBRPC_MAX_DATA / sizeof(OIBRPCKBAG);
+	int done;
+
+	for(done = 0; done < count; done += perRequest) {
+		int n = ((count - done) > perRequest) ? perRequest : (count - done);
+		uint32_t replyLen;
+		int32_t status;
+		void* reply;
+
+		if(oibrpc_call(OIBRPC_AES_KBAGS, noArgs, kbags + done, n * sizeof(OIBRPCKBAG), &status, &reply, &replyLen) != 0)
+			return -1;
+
+		if(status != 0 || replyLen != (n * sizeof(OIBRPCKBAG))) {
+			fprintf(stderr, "the device could not decrypt the KBAGs (%d)\n", status);
+			free(reply);
+			return -1;
+		}
+
+		memcpy(kbags + done, reply, replyLen);
+		free(reply);
+	}
+
+	return 0;
+}
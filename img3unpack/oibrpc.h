@@ -0,0 +1,30 @@
+#ifndef OIBRPC_H
+#define OIBRPC_H
+
+#include <stdint.h>
+
+// A client for the binary RPC requests of openiboot over USB, see rpc.h
+// and OPENIBOOTCMD_RPC in usb.h on the device. oibc must not be running.
+
+#define OIBRPC_AES_KBAGS 15
+#define OIBRPC_MAX_DATA 0x20000
+
+typedef struct OIBRPCKBAG {
+	uint8_t iv[16];
+	uint8_t key[32];
+} __attribute__((__packed__)) OIBRPCKBAG;
+
+// Both return 0 on success and -1 with a message on stderr.
+int oibrpc_open();
+void oibrpc_close();
+
+// Sends one request and waits for the answer. reply is malloc'd, replyLen
+// bytes long, and freed by the caller. Returns -1 if the transfer failed,
+// otherwise 0 with the device's status in *status.
+int oibrpc_call(uint32_t operation, const uint32_t args[4], const void* data, uint32_t dataLen,
+		int32_t* status, void** reply, uint32_t* replyLen);
+
+// GID decrypts count KBAGs in place, as many at a time as a request fits.
+int oibrpc_decrypt_kbags(OIBRPCKBAG* kbags, int count);
+
+#endif
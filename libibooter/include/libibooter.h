@@ -1,5 +1,7 @@
 #include <usb.h>
+#include <pthread.h>
 #include <string>
+#include <vector>
 
 namespace ibooter
 {
@@ -16,7 +18,7 @@ typedef enum {
 	IB_DUMPING_BUFFER,
 } ERR_CODE;
 
-const char *errcode_to_str(ERR_CODE code)
+inline const char *errcode_to_str(ERR_CODE code)
 {
 	switch (code)
 	{
@@ -49,14 +51,40 @@ class CIBootConn
 {
 	public:
 
+		static int const USB_VENDOR_ID = 0x05ac;
+		static int const USB_PRODUCT_ID = 0x1280;
+		static int const STREAM_CHUNK = 0x10000;
+
+		// Streaming callbacks. A source fills up to nLength bytes and returns
+		// how many it gave (0 at the end, negative on error); a sink takes
+		// nLength bytes and returns how many it took.
+		typedef int (*SourceFn)(void *pCtx, char *pBuffer, int nLength);
+		typedef int (*SinkFn)(void *pCtx, const char *pBuffer, int nLength);
+		typedef void (*ProgressFn)(void *pCtx, unsigned long long nDone, unsigned long long nTotal, double dBytesPerSec);
+
+		// Prints a one line progress meter with the throughput to stderr
+		static void PrintProgress(void *pCtx, unsigned long long nDone, unsigned long long nTotal, double dBytesPerSec);
+
 	public:
 		CIBootConn(int nVendor = USB_VENDOR_ID, int nProduct = USB_PRODUCT_ID);
+		CIBootConn(struct usb_device *pDevice);
 		~CIBootConn();
 
+		// Every device on the bus with these ids, for connecting to all of them
+		static std::vector<struct usb_device *> FindDevices(int nVendor = USB_VENDOR_ID, int nProduct = USB_PRODUCT_ID);
+
 		ERR_CODE Connect();
 		ERR_CODE Disconnect();
-		ERR_CODE GetFile(const char *szFile, unsigned long lLoadAddr, int nLen);
-		ERR_CODE SendFile(const char *szFile, unsigned long lLoadAddr);
+		ERR_CODE GetFile(const char *szFile, unsigned long lLoadAddr, int nLen, ProgressFn pProgress = NULL);
+		ERR_CODE SendFile(const char *szFile, unsigned long lLoadAddr, ProgressFn pProgress = NULL);
+
+		// Memory stays at two STREAM_CHUNK buffers whatever the length; the
+		// callback or descriptor is serviced on a second thread so that it
+		// overlaps with the USB transfers.
+		ERR_CODE SendStream(SourceFn pSource, void *pCtx, int nLen, unsigned long lLoadAddr, ProgressFn pProgress = NULL, void *pProgressCtx = NULL);
+		ERR_CODE GetStream(SinkFn pSink, void *pCtx, unsigned long lLoadAddr, int nLen, ProgressFn pProgress = NULL, void *pProgressCtx = NULL);
+		ERR_CODE SendFd(int fd, int nLen, unsigned long lLoadAddr, ProgressFn pProgress = NULL, void *pProgressCtx = NULL);
+		ERR_CODE GetFd(int fd, unsigned long lLoadAddr, int nLen, ProgressFn pProgress = NULL, void *pProgressCtx = NULL);
 		ERR_CODE SendCommand(const char *szCmd);
 		ERR_CODE GetResponse(const char *&ppBuffer);
 
@@ -101,9 +129,6 @@ class CIBootConn
 
 		struct usb_device *FindDevice(int nVendor, int nProduct) const;
 
-		static int const USB_VENDOR_ID = 0x05ac;
-		static int const USB_PRODUCT_ID = 0x1280;
-
 		static int const USB_WFILE_EP = 0x05; // Write file EP
 		static int const USB_RFILE_EP = 0x85; // Read file EP
 		static int const USB_WCONTROL_EP = 0x04; // Write control EP
@@ -116,11 +141,127 @@ class CIBootConn
 	private:
 		int 									m_nVendorId;
 		int										m_nProductId;
+		struct usb_device			*m_pUsbDevice;
 		struct usb_dev_handle *m_pDevice;
 		SMessage			 				*m_pSend, *m_pRecv;	
 		std::string		 				m_sResponse;
 
 }; // end class CIBootConn
 
+// One step of a provisioning run
+typedef struct SPoolStep
+{
+	enum { SEND_FILE, SEND_COMMAND } type;
+	std::string		sArg;					// file name or command
+	unsigned long	lLoadAddr;		// SEND_FILE only
+} SPoolStep;
+
+// Runs the same steps on every connected device at once, one thread each,
+// so that a slow device never holds up the others.
+class CIBootPool
+{
+	public:
+		CIBootPool(int nVendor = CIBootConn::USB_VENDOR_ID, int nProduct = CIBootConn::USB_PRODUCT_ID);
+		~CIBootPool();
+
+		// Connects to every matching device and returns how many answered
+		int Connect();
+		void Disconnect();
+
+		// IB_SUCCESS once every device has run every step
+		ERR_CODE Run(const std::vector<SPoolStep> &steps);
+
+		int GetDeviceCount() const;
+		const char *GetDeviceName(int i) const;
+		ERR_CODE GetResult(int i) const;
+		unsigned long long GetBytesSent(int i) const;
+		double GetSeconds(int i) const;
+
+		// Total file bytes sent over the wall clock time of the last Run
+		unsigned long long GetTotalBytes() const;
+		double GetTotalSeconds() const;
+
+	private:
+
+		typedef struct SWorker
+		{
+			CIBootConn					*pConn;
+			std::string					sName;
+			const std::vector<SPoolStep> *pSteps;
+			ERR_CODE						result;
+			unsigned long long	nBytes;
+			double							dSeconds;
+			pthread_t						thread;
+		} SWorker;
+
+		static void RunAll(std::vector<SWorker *> &workers, void *(*pMain)(void *));
+		static void *ConnectMain(void *pArg);
+		static void *WorkerMain(void *pArg);
+
+		int										m_nVendorId;
+		int										m_nProductId;
+		std::vector<SWorker *> m_workers;
+		double								m_dSeconds;
+
+}; // end class CIBootPool
+
+// Keeps a connection open to every attached device and serves requests for
+// them on a local socket, so that a short-lived client does not pay for a bus
+// scan and a claim each time. One request per line, answered by "OK <n>"
+// and n bytes of data, or "ERR <message>":
+//
+//   list                              index, name and state of each device
+//   rescan                            connect to anything attached since
+//   <device> command <text>           run a command
+//   <device> response                 collect what the device printed
+//   <device> sendfile <path> <addr>   send a file on the broker's host
+//   <device> getfile <path> <addr> <len>
+//
+// where <device> is an index from list or a bus/device name. Requests for
+// different devices run at the same time; those for one device in turn.
+class CIBootBroker
+{
+	public:
+		static const char *DEFAULT_SOCKET;
+
+		CIBootBroker(int nVendor = CIBootConn::USB_VENDOR_ID, int nProduct = CIBootConn::USB_PRODUCT_ID);
+		~CIBootBroker();
+
+		// Connects to whatever is attached that is not connected yet and
+		// returns how many devices are connected in all
+		int Rescan();
+
+		// Listens on szPath and serves clients until the socket fails
+		ERR_CODE Serve(const char *szPath = DEFAULT_SOCKET);
+
+	private:
+
+		typedef struct SDevice
+		{
+			CIBootConn					*pConn;
+			std::string					sName;
+			bool								bConnected;
+			pthread_mutex_t			mutex;
+		} SDevice;
+
+		typedef struct SClient
+		{
+			CIBootBroker				*pBroker;
+			int									fd;
+		} SClient;
+
+		static void *ClientMain(void *pArg);
+		void HandleRequest(int fd, const std::string &sLine);
+		std::string List();
+		SDevice *Lookup(const std::string &sDevice);
+		ERR_CODE RunOnDevice(SDevice *pDevice, const std::vector<std::string> &args, std::string &sReply);
+
+		int										m_nVendorId;
+		int										m_nProductId;
+		std::vector<SDevice *> m_devices;
+		pthread_mutex_t				m_mutex;	// guards m_devices
+
+}; // end class CIBootBroker
+
 }; // end namespace
 
@@ -0,0 +1,38 @@
+#include "libibooter.h"
+#include <iostream>
+#include <cstring>
+
+using namespace ibooter;
+using namespace std;
+
+static void usage(const char *szName)
+{
+	cout << "Usage: " << szName << " [-s <socket>]" << endl;
+	cout << "Holds every attached device open and serves requests for them on the socket" << endl;
+	cout << "(default " << CIBootBroker::DEFAULT_SOCKET << "); see ibctl." << endl;
+}
+
+int main(int argc, char **argv)
+{
+	const char *szSocket = CIBootBroker::DEFAULT_SOCKET;
+	for(int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "-s") == 0 && i + 1 < argc)
+		{
+			szSocket = argv[i + 1];
+			i++;
+		}
+		else
+		{
+			usage(argv[0]);
+			return 1;
+		}
+	}
+
+	CIBootBroker broker;
+	cout << "Connected to " << broker.Rescan() << " device(s), serving on " << szSocket << endl;
+
+	ERR_CODE code = broker.Serve(szSocket);
+	cout << errcode_to_str(code) << endl;
+	return 1;
+}
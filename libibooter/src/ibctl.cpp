@@ -0,0 +1,102 @@
+#include "libibooter.h"
+#include <iostream>
+#include <string>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+using namespace ibooter;
+using namespace std;
+
+// Sends one request to ibbroker and prints what comes back. Kept to a
+// socket connect and a round trip, with no USB work of its own.
+
+static void usage(const char *szName)
+{
+	cout << "Usage: " << szName << " [-s <socket>] <request...>" << endl;
+	cout << "e.g.   " << szName << " list" << endl;
+	cout << "       " << szName << " 0 command printenv" << endl;
+	cout << "       " << szName << " 0 sendfile /path/to/file 0x09000000" << endl;
+}
+
+static bool ReadLine(int fd, string &sLine)
+{
+	char c;
+	sLine.clear();
+	while(read(fd, &c, 1) == 1)
+	{
+		if (c == '\n')
+			return true;
+
+		sLine += c;
+	}
+
+	return false;
+}
+
+int main(int argc, char **argv)
+{
+	const char *szSocket = CIBootBroker::DEFAULT_SOCKET;
+	int first = 1;
+	if (argc > 2 && strcmp(argv[1], "-s") == 0)
+	{
+		szSocket = argv[2];
+		first = 3;
+	}
+
+	if (first >= argc)
+	{
+		usage(argv[0]);
+		return 1;
+	}
+
+	string sRequest = argv[first];
+	for(int i = first + 1; i < argc; i++)
+		sRequest += string(" ") + argv[i];
+	sRequest += "\n";
+
+	struct sockaddr_un addr;
+	memset(&addr, 0, sizeof(addr));
+	addr.sun_family = AF_UNIX;
+	strncpy(addr.sun_path, szSocket, sizeof(addr.sun_path) - 1);
+
+	int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (fd < 0 || connect(fd, (struct sockaddr *)&addr, sizeof(addr)) < 0)
+	{
+		cerr << "ibbroker is not running on " << szSocket << endl;
+		return 1;
+	}
+
+	if (write(fd, sRequest.c_str(), sRequest.size()) != (ssize_t)sRequest.size())
+	{
+		close(fd);
+		return 1;
+	}
+
+	string sHeader;
+	if (!ReadLine(fd, sHeader) || sHeader.compare(0, 3, "OK ") != 0)
+	{
+		cerr << (sHeader.empty() ? "no reply" : sHeader) << endl;
+		close(fd);
+		return 1;
+	}
+
+	// the header gives the length of the data after it
+	size_t nLeft = strtoul(sHeader.c_str() + 3, NULL, 10);
+	char buffer[4096];
+	while(nLeft > 0)
+	{
+		ssize_t n = read(fd, buffer, (nLeft < sizeof(buffer)) ? nLeft : sizeof(buffer));
+		if (n <= 0)
+			break;
+
+		fwrite(buffer, 1, n, stdout);
+		nLeft -= n;
+	}
+
+	close(fd);
+	return (nLeft == 0) ? 0 : 1;
+}
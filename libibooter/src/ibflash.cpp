@@ -0,0 +1,78 @@
+#include "libibooter.h"
+#include <iostream>
+#include <cstdlib>
+#include <cstring>
+
+using namespace ibooter;
+using namespace std;
+
+static void usage(const char *szName)
+{
+	cout << "Usage: " << szName << " [-f <file> <address>] [-c <command>] ..." << endl;
+	cout << "Runs the steps, in order, on every attached device at once." << endl;
+}
+
+int main(int argc, char **argv)
+{
+	vector<SPoolStep> steps;
+	for(int i = 1; i < argc; i++)
+	{
+		SPoolStep step;
+		if (strcmp(argv[i], "-f") == 0 && i + 2 < argc)
+		{
+			step.type = SPoolStep::SEND_FILE;
+			step.sArg = argv[i + 1];
+			step.lLoadAddr = strtoul(argv[i + 2], NULL, 0);
+			i += 2;
+		}
+		else if (strcmp(argv[i], "-c") == 0 && i + 1 < argc)
+		{
+			step.type = SPoolStep::SEND_COMMAND;
+			step.sArg = string(argv[i + 1]) + "\n";
+			step.lLoadAddr = 0;
+			i++;
+		}
+		else
+		{
+			usage(argv[0]);
+			return 1;
+		}
+
+		steps.push_back(step);
+	}
+
+	if (steps.empty())
+	{
+		usage(argv[0]);
+		return 1;
+	}
+
+	CIBootPool pool;
+	cout << "Connecting..." << endl;
+	if (pool.Connect() == 0)
+	{
+		cout << errcode_to_str(IB_DEVICE_NOT_FOUND) << endl;
+		return 1;
+	}
+
+	cout << "Running on " << pool.GetDeviceCount() << " device(s)..." << endl;
+	ERR_CODE code = pool.Run(steps);
+
+	for(int i = 0; i < pool.GetDeviceCount(); i++)
+	{
+		double dSeconds = pool.GetSeconds(i);
+		cout << pool.GetDeviceName(i) << ": " << errcode_to_str(pool.GetResult(i))
+			<< ", " << pool.GetBytesSent(i) << " bytes in " << dSeconds << " s";
+		if (dSeconds > 0)
+			cout << " (" << (pool.GetBytesSent(i) / 1024.0 / dSeconds) << " KB/s)";
+		cout << endl;
+	}
+
+	double dTotal = pool.GetTotalSeconds();
+	cout << "Total: " << pool.GetTotalBytes() << " bytes in " << dTotal << " s";
+	if (dTotal > 0)
+		cout << " (" << (pool.GetTotalBytes() / 1024.0 / dTotal) << " KB/s)";
+	cout << endl;
+
+	return (code == IB_SUCCESS) ? 0 : 1;
+}
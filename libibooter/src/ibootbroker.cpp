@@ -0,0 +1,339 @@
+/*
+
+	Serves requests for every attached device over a Unix socket, keeping
+	the connections open between them. Each client gets a thread; each
+	device has a lock, so one device runs one request at a time while the
+	others carry on.
+
+*/
+#include "libibooter.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cerrno>
+#include <unistd.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+namespace ibooter
+{
+
+const char *CIBootBroker::DEFAULT_SOCKET = "/tmp/ibooter.sock";
+
+static bool WriteAll(int fd, const char *pBuffer, size_t nLength)
+{
+	while(nLength > 0)
+	{
+		ssize_t n = write(fd, pBuffer, nLength);
+		if (n <= 0)
+			return false;
+
+		pBuffer += n;
+		nLength -= n;
+	}
+
+	return true;
+}
+
+static bool Reply(int fd, ERR_CODE code, const std::string &sData)
+{
+	char header[64];
+	if (code != IB_SUCCESS)
+	{
+		std::string sError = std::string("ERR ") + errcode_to_str(code) + "\n";
+		return WriteAll(fd, sError.c_str(), sError.size());
+	}
+
+	sprintf(header, "OK %u\n", (unsigned int)sData.size());
+	return WriteAll(fd, header, strlen(header)) && WriteAll(fd, sData.data(), sData.size());
+}
+
+static std::vector<std::string> Split(const std::string &sLine)
+{
+	std::vector<std::string> words;
+	size_t pos = 0;
+	while(pos < sLine.size())
+	{
+		size_t start = sLine.find_first_not_of(' ', pos);
+		if (start == std::string::npos)
+			break;
+
+		size_t end = sLine.find(' ', start);
+		if (end == std::string::npos)
+			end = sLine.size();
+
+		words.push_back(sLine.substr(start, end - start));
+		pos = end;
+	}
+
+	return words;
+}
+
+CIBootBroker::CIBootBroker(int nVendor, int nProduct)
+: m_nVendorId(nVendor), m_nProductId(nProduct)
+{
+	pthread_mutex_init(&m_mutex, NULL);
+}
+
+CIBootBroker::~CIBootBroker()
+{
+	for(size_t i = 0; i < m_devices.size(); i++)
+	{
+		delete m_devices[i]->pConn;
+		pthread_mutex_destroy(&m_devices[i]->mutex);
+		delete m_devices[i];
+	}
+
+	pthread_mutex_destroy(&m_mutex);
+}
+
+int CIBootBroker::Rescan()
+{
+	pthread_mutex_lock(&m_mutex);
+
+	std::vector<struct usb_device *> found = CIBootConn::FindDevices(m_nVendorId, m_nProductId);
+	for(size_t i = 0; i < found.size(); i++)
+	{
+		std::string sName = std::string(found[i]->bus->dirname) + "/" + found[i]->filename;
+
+		// Entries are never removed, so clients may hold on to them unlocked
+		SDevice *pDevice = NULL;
+		for(size_t j = 0; j < m_devices.size(); j++)
+		{
+			if (m_devices[j]->sName == sName)
+				pDevice = m_devices[j];
+		}
+
+		if (!pDevice)
+		{
+			pDevice = new SDevice;
+			pDevice->pConn = NULL;
+			pDevice->sName = sName;
+			pDevice->bConnected = false;
+			pthread_mutex_init(&pDevice->mutex, NULL);
+			m_devices.push_back(pDevice);
+		}
+
+		pthread_mutex_lock(&pDevice->mutex);
+		if (!pDevice->bConnected)
+		{
+			delete pDevice->pConn;
+			pDevice->pConn = new CIBootConn(found[i]);
+			ERR_CODE code = pDevice->pConn->Connect();
+			pDevice->bConnected = (code == IB_SUCCESS);
+			fprintf(stderr, "%s: %s\n", sName.c_str(), errcode_to_str(code));
+		}
+		pthread_mutex_unlock(&pDevice->mutex);
+	}
+
+	int nConnected = 0;
+	for(size_t j = 0; j < m_devices.size(); j++)
+	{
+		if (m_devices[j]->bConnected)
+			nConnected++;
+	}
+
+	pthread_mutex_unlock(&m_mutex);
+	return nConnected;
+}
+
+std::string CIBootBroker::List()
+{
+	std::string sList;
+	char line[256];
+
+	pthread_mutex_lock(&m_mutex);
+	for(size_t i = 0; i < m_devices.size(); i++)
+	{
+		snprintf(line, sizeof(line), "%u %s %s\n", (unsigned int)i, m_devices[i]->sName.c_str(),
+				m_devices[i]->bConnected ? "connected" : "lost");
+		sList += line;
+	}
+	pthread_mutex_unlock(&m_mutex);
+
+	return sList;
+}
+
+CIBootBroker::SDevice *CIBootBroker::Lookup(const std::string &sDevice)
+{
+	SDevice *pDevice = NULL;
+	char *end;
+	unsigned long index = strtoul(sDevice.c_str(), &end, 0);
+
+	pthread_mutex_lock(&m_mutex);
+	if (*end == '\0' && index < m_devices.size())
+		pDevice = m_devices[index];
+
+	for(size_t i = 0; !pDevice && i < m_devices.size(); i++)
+	{
+		if (m_devices[i]->sName == sDevice)
+			pDevice = m_devices[i];
+	}
+	pthread_mutex_unlock(&m_mutex);
+
+	return pDevice;
+}
+
+ERR_CODE CIBootBroker::RunOnDevice(SDevice *pDevice, const std::vector<std::string> &args, std::string &sReply)
+{
+	const std::string &sVerb = args[1];
+	ERR_CODE code = IB_FAIL;
+
+	if (!pDevice->bConnected)
+		return IB_CONNECTION_LOST;
+
+	if (sVerb == "command" && args.size() >= 3)
+	{
+		std::string sCommand = args[2];
+		for(size_t i = 3; i < args.size(); i++)
+			sCommand += " " + args[i];
+
+		code = pDevice->pConn->SendCommand((sCommand + "\n").c_str());
+	}
+	else if (sVerb == "response" && args.size() == 2)
+	{
+		const char *pResponse = NULL;
+		code = pDevice->pConn->GetResponse(pResponse);
+		if (code == IB_SUCCESS)
+			sReply = pResponse;
+	}
+	else if (sVerb == "sendfile" && args.size() == 4)
+	{
+		code = pDevice->pConn->SendFile(args[2].c_str(), strtoul(args[3].c_str(), NULL, 0));
+	}
+	else if (sVerb == "getfile" && args.size() == 5)
+	{
+		code = pDevice->pConn->GetFile(args[2].c_str(), strtoul(args[3].c_str(), NULL, 0), strtol(args[4].c_str(), NULL, 0));
+	}
+
+	// Picked up again by the next rescan
+	if (code == IB_CONNECTION_LOST)
+	{
+		pDevice->pConn->Disconnect();
+		pDevice->bConnected = false;
+	}
+
+	return code;
+}
+
+void CIBootBroker::HandleRequest(int fd, const std::string &sLine)
+{
+	std::vector<std::string> args = Split(sLine);
+	std::string sReply;
+
+	if (args.size() == 1 && args[0] == "list")
+	{
+		Reply(fd, IB_SUCCESS, List());
+		return;
+	}
+
+	if (args.size() == 1 && args[0] == "rescan")
+	{
+		Rescan();
+		Reply(fd, IB_SUCCESS, List());
+		return;
+	}
+
+	SDevice *pDevice = (args.size() >= 2) ? Lookup(args[0]) : NULL;
+	if (!pDevice)
+	{
+		Reply(fd, (args.size() >= 2) ? IB_DEVICE_NOT_FOUND : IB_FAIL, sReply);
+		return;
+	}
+
+	pthread_mutex_lock(&pDevice->mutex);
+	ERR_CODE code = RunOnDevice(pDevice, args, sReply);
+	pthread_mutex_unlock(&pDevice->mutex);
+
+	Reply(fd, code, sReply);
+}
+
+void *CIBootBroker::ClientMain(void *pArg)
+{
+	SClient *pClient = (SClient *)pArg;
+	std::string sPending;
+	char buffer[1024];
+
+	while(true)
+	{
+		ssize_t n = read(pClient->fd, buffer, sizeof(buffer));
+		if (n <= 0)
+			break;
+
+		sPending.append(buffer, n);
+
+		size_t eol;
+		while((eol = sPending.find('\n')) != std::string::npos)
+		{
+			std::string sLine = sPending.substr(0, eol);
+			sPending.erase(0, eol + 1);
+
+			if (!sLine.empty() && sLine[sLine.size() - 1] == '\r')
+				sLine.erase(sLine.size() - 1);
+
+			if (!sLine.empty())
+				pClient->pBroker->HandleRequest(pClient->fd, sLine);
+		}
+	}
+
+	close(pClient->fd);
+	delete pClient;
+	return NULL;
+}
+
+ERR_CODE CIBootBroker::Serve(const char *szPath)
+{
+	struct sockaddr_un addr;
+	if (strlen(szPath) >= sizeof(addr.sun_path))
+		return IB_FAIL;
+
+	int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (listener < 0)
+		return IB_FAIL;
+
+	memset(&addr, 0, sizeof(addr));
+	addr.sun_family = AF_UNIX;
+	strcpy(addr.sun_path, szPath);
+
+	// Left behind by a broker that did not shut down cleanly
+	unlink(szPath);
+	if (bind(listener, (struct sockaddr *)&addr, sizeof(addr)) < 0 || listen(listener, 16) < 0)
+	{
+		close(listener);
+		return IB_FAIL;
+	}
+
+	// A client going away mid reply must not take the broker with it
+	signal(SIGPIPE, SIG_IGN);
+
+	while(true)
+	{
+		int fd = accept(listener, NULL, NULL);
+		if (fd < 0 && errno == EINTR)
+			continue;
+
+		if (fd < 0)
+			break;
+
+		SClient *pClient = new SClient;
+		pClient->pBroker = this;
+		pClient->fd = fd;
+
+		pthread_t thread;
+		if (pthread_create(&thread, NULL, ClientMain, pClient) != 0)
+		{
+			close(fd);
+			delete pClient;
+			continue;
+		}
+
+		pthread_detach(thread);
+	}
+
+	close(listener);
+	unlink(szPath);
+	return IB_FAIL;
+}
+
+};
@@ -0,0 +1,196 @@
+/*
+
+	Runs the same SendFile/SendCommand steps on every attached device in
+	parallel. Each device gets its own connection and thread; libusb-0.1
+	is fine with that as long as no two threads share a handle.
+
+*/
+#include "libibooter.h"
+#include <cstdio>
+#include <sys/stat.h>
+#include <sys/time.h>
+
+namespace ibooter
+{
+
+static double now()
+{
+	struct timeval tv;
+	gettimeofday(&tv, NULL);
+	return tv.tv_sec + tv.tv_usec / 1000000.0;
+}
+
+CIBootPool::CIBootPool(int nVendor, int nProduct)
+: m_nVendorId(nVendor), m_nProductId(nProduct), m_dSeconds(0)
+{
+}
+
+CIBootPool::~CIBootPool()
+{
+	Disconnect();
+}
+
+int CIBootPool::Connect()
+{
+	Disconnect();
+
+	std::vector<struct usb_device *> devices = CIBootConn::FindDevices(m_nVendorId, m_nProductId);
+	std::vector<SWorker *> workers;
+	for(size_t i = 0; i < devices.size(); i++)
+	{
+		SWorker *pWorker = new SWorker;
+		pWorker->pConn = new CIBootConn(devices[i]);
+		pWorker->sName = std::string(devices[i]->bus->dirname) + "/" + devices[i]->filename;
+		pWorker->pSteps = NULL;
+		pWorker->result = IB_SUCCESS;
+		pWorker->nBytes = 0;
+		pWorker->dSeconds = 0;
+		workers.push_back(pWorker);
+	}
+
+	// Connecting waits on each device's first response, so do them all at once
+	RunAll(workers, ConnectMain);
+
+	for(size_t i = 0; i < workers.size(); i++)
+	{
+		if (workers[i]->result == IB_SUCCESS)
+			m_workers.push_back(workers[i]);
+		else
+		{
+			delete workers[i]->pConn;
+			delete workers[i];
+		}
+	}
+
+	return m_workers.size();
+}
+
+void CIBootPool::Disconnect()
+{
+	for(size_t i = 0; i < m_workers.size(); i++)
+	{
+		delete m_workers[i]->pConn;
+		delete m_workers[i];
+	}
+
+	m_workers.clear();
+}
+
+void CIBootPool::RunAll(std::vector<SWorker *> &workers, void *(*pMain)(void *))
+{
+	size_t started = 0;
+	for(; started < workers.size(); started++)
+	{
+		if (pthread_create(&workers[started]->thread, NULL, pMain, workers[started]) != 0)
+			break;
+	}
+
+	// Whatever could not get a thread runs here, after the others are going
+	for(size_t i = started; i < workers.size(); i++)
+		pMain(workers[i]);
+
+	for(size_t i = 0; i < started; i++)
+		pthread_join(workers[i]->thread, NULL);
+}
+
+void *CIBootPool::ConnectMain(void *pArg)
+{
+	SWorker *pWorker = (SWorker *)pArg;
+	pWorker->result = pWorker->pConn->Connect();
+	return NULL;
+}
+
+void *CIBootPool::WorkerMain(void *pArg)
+{
+	SWorker *pWorker = (SWorker *)pArg;
+	const std::vector<SPoolStep> &steps = *pWorker->pSteps;
+	double dStart = now();
+
+	for(size_t i = 0; i < steps.size(); i++)
+	{
+		const SPoolStep &step = steps[i];
+		if (step.type == SPoolStep::SEND_FILE)
+		{
+			struct stat st;
+			pWorker->result = pWorker->pConn->SendFile(step.sArg.c_str(), step.lLoadAddr);
+			if (pWorker->result == IB_SUCCESS && stat(step.sArg.c_str(), &st) == 0)
+				pWorker->nBytes += st.st_size;
+		}
+		else
+			pWorker->result = pWorker->pConn->SendCommand(step.sArg.c_str());
+
+		if (pWorker->result != IB_SUCCESS)
+			break;
+	}
+
+	pWorker->dSeconds = now() - dStart;
+	return NULL;
+}
+
+ERR_CODE CIBootPool::Run(const std::vector<SPoolStep> &steps)
+{
+	if (m_workers.empty())
+		return IB_DEVICE_NOT_FOUND;
+
+	for(size_t i = 0; i < m_workers.size(); i++)
+	{
+		m_workers[i]->pSteps = &steps;
+		m_workers[i]->result = IB_SUCCESS;
+		m_workers[i]->nBytes = 0;
+		m_workers[i]->dSeconds = 0;
+	}
+
+	double dStart = now();
+	RunAll(m_workers, WorkerMain);
+	m_dSeconds = now() - dStart;
+
+	ERR_CODE code = IB_SUCCESS;
+	for(size_t i = 0; i < m_workers.size(); i++)
+	{
+		if (m_workers[i]->result != IB_SUCCESS)
+			code = m_workers[i]->result;
+	}
+
+	return code;
+}
+
+int CIBootPool::GetDeviceCount() const
+{
+	return m_workers.size();
+}
+
+const char *CIBootPool::GetDeviceName(int i) const
+{
+	return m_workers[i]->sName.c_str();
+}
+
+ERR_CODE CIBootPool::GetResult(int i) const
+{
+	return m_workers[i]->result;
+}
+
+unsigned long long CIBootPool::GetBytesSent(int i) const
+{
+	return m_workers[i]->nBytes;
+}
+
+double CIBootPool::GetSeconds(int i) const
+{
+	return m_workers[i]->dSeconds;
+}
+
+unsigned long long CIBootPool::GetTotalBytes() const
+{
+	unsigned long long nTotal = 0;
+	for(size_t i = 0; i < m_workers.size(); i++)
+		nTotal += m_workers[i]->nBytes;
+
+	return nTotal;
+}
+
+double CIBootPool::GetTotalSeconds() const
+{
+	return m_dSeconds;
+}
+
+};
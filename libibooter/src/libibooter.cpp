@@ -6,12 +6,16 @@
 #include "libibooter.h"
 #include <cstring>
 #include <cstdio>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/time.h>
 
 namespace ibooter
 {
 
 CIBootConn::CIBootConn(int nVendor, int nProduct)
-: m_nVendorId(nVendor), m_nProductId(nProduct), m_pDevice(NULL)
+: m_nVendorId(nVendor), m_nProductId(nProduct), m_pUsbDevice(NULL), m_pDevice(NULL)
 {
 	m_pSend = new SMessage;
 	m_pRecv = new SMessage;
@@ -21,6 +25,33 @@ CIBootConn::CIBootConn(int nVendor, int nProduct)
 	usb_find_devices();
 }
 
+CIBootConn::CIBootConn(struct usb_device *pDevice)
+: m_nVendorId(pDevice->descriptor.idVendor), m_nProductId(pDevice->descriptor.idProduct), m_pUsbDevice(pDevice), m_pDevice(NULL)
+{
+	m_pSend = new SMessage;
+	m_pRecv = new SMessage;
+}
+
+std::vector<struct usb_device *> CIBootConn::FindDevices(int nVendor, int nProduct)
+{
+	std::vector<struct usb_device *> devices;
+
+	usb_init();
+	usb_find_busses();
+	usb_find_devices();
+
+	for(struct usb_bus *bus = usb_get_busses(); bus; bus = bus->next)
+	{
+		for(struct usb_device *dev = bus->devices; dev; dev = dev->next)
+		{
+			if(dev->descriptor.idVendor == nVendor && dev->descriptor.idProduct == nProduct)
+				devices.push_back(dev);
+		}
+	}
+
+	return devices;
+}
+
 CIBootConn::~CIBootConn()
 {
 	Disconnect();
@@ -47,7 +78,7 @@ struct usb_device *CIBootConn::FindDevice(int nVendor, int nProduct) const
 
 ERR_CODE CIBootConn::Connect()
 {
-	struct usb_device *pDevice = FindDevice(m_nVendorId, m_nProductId);
+	struct usb_device *pDevice = m_pUsbDevice ? m_pUsbDevice : FindDevice(m_nVendorId, m_nProductId);
 	if (!pDevice)
 		return IB_DEVICE_NOT_FOUND;
 
@@ -136,63 +167,333 @@ ERR_CODE CIBootConn::GetResponse(const char *&ppBuffer)
 	return code;
 }
 
-ERR_CODE CIBootConn::SendFile(const char *szFile, unsigned long lLoadAddr)
+// Two buffers handed back and forth between the USB side and the file side
+typedef struct SStreamPipe
 {
-	FILE *sf = fopen(szFile, "r");
-	if(sf == NULL)
-		return IB_FILE_NOT_FOUND;
+	char						*pBuffer[2];
+	int							nLength[2];
+	bool						bFull[2];
+	bool						bDone;		// producer has given everything it will
+	bool						bFailed;	// either side gave up
+	pthread_mutex_t	mutex;
+	pthread_cond_t	cond;
+	CIBootConn::SourceFn pSource;
+	CIBootConn::SinkFn pSink;
+	void						*pCtx;
+	int							nTotal;
+} SStreamPipe;
+
+static void PipeInit(SStreamPipe *pPipe, int nChunk)
+{
+	for(int i = 0; i < 2; i++)
+	{
+		pPipe->pBuffer[i] = new char[nChunk];
+		pPipe->nLength[i] = 0;
+		pPipe->bFull[i] = false;
+	}
 
-	fseek(sf, 0, SEEK_END);
-	int filelen = filelen = ftell(sf);
-	fseek(sf, 0, SEEK_SET);
+	pPipe->bDone = false;
+	pPipe->bFailed = false;
+	pthread_mutex_init(&pPipe->mutex, NULL);
+	pthread_cond_init(&pPipe->cond, NULL);
+}
 
-	RequestSendFile(m_pSend, m_pRecv, filelen, lLoadAddr);
-	if(m_pRecv->cmdcode != MSG_ACK)
+static void PipeDestroy(SStreamPipe *pPipe)
+{
+	pthread_cond_destroy(&pPipe->cond);
+	pthread_mutex_destroy(&pPipe->mutex);
+	delete [] pPipe->pBuffer[0];
+	delete [] pPipe->pBuffer[1];
+}
+
+// Waits for buffer i to be empty (bFull false) or full (true); false if the
+// other side failed, or finished without filling it
+static bool PipeWait(SStreamPipe *pPipe, int i, bool bFull)
+{
+	pthread_mutex_lock(&pPipe->mutex);
+	while(pPipe->bFull[i] != bFull && !pPipe->bFailed && !(bFull && pPipe->bDone))
+		pthread_cond_wait(&pPipe->cond, &pPipe->mutex);
+
+	bool bOk = (pPipe->bFull[i] == bFull) && !pPipe->bFailed;
+	pthread_mutex_unlock(&pPipe->mutex);
+	return bOk;
+}
+
+static void PipeSet(SStreamPipe *pPipe, int i, bool bFull)
+{
+	pthread_mutex_lock(&pPipe->mutex);
+	pPipe->bFull[i] = bFull;
+	pthread_cond_broadcast(&pPipe->cond);
+	pthread_mutex_unlock(&pPipe->mutex);
+}
+
+static void PipeFinish(SStreamPipe *pPipe, bool bFailed)
+{
+	pthread_mutex_lock(&pPipe->mutex);
+	pPipe->bDone = true;
+	if (bFailed)
+		pPipe->bFailed = true;
+	pthread_cond_broadcast(&pPipe->cond);
+	pthread_mutex_unlock(&pPipe->mutex);
+}
+
+static void *PipeSourceMain(void *pArg)
+{
+	SStreamPipe *pPipe = (SStreamPipe *)pArg;
+	int nLeft = pPipe->nTotal;
+	int i = 0;
+
+	while(nLeft > 0)
 	{
-		fclose(sf);
-		return IB_COMMAND_NOT_ACK;
+		if (!PipeWait(pPipe, i, false))
+			return NULL;
+
+		int nWant = (nLeft < CIBootConn::STREAM_CHUNK) ? nLeft : CIBootConn::STREAM_CHUNK;
+		int nGot = 0;
+		while(nGot < nWant)
+		{
+			int n = pPipe->pSource(pPipe->pCtx, pPipe->pBuffer[i] + nGot, nWant - nGot);
+			if (n <= 0)
+			{
+				PipeFinish(pPipe, true);
+				return NULL;
+			}
+
+			nGot += n;
+		}
+
+		pPipe->nLength[i] = nGot;
+		nLeft -= nGot;
+		PipeSet(pPipe, i, true);
+		i ^= 1;
 	}
 
-	int sent;
-	char buffer[0x4000];
-	do 
+	PipeFinish(pPipe, false);
+	return NULL;
+}
+
+static void *PipeSinkMain(void *pArg)
+{
+	SStreamPipe *pPipe = (SStreamPipe *)pArg;
+	int i = 0;
+
+	while(PipeWait(pPipe, i, true))
 	{
-		sent = fread(buffer, 1, sizeof(buffer), sf);
-		WriteFile(buffer, sent);
-	} while(sent == sizeof(buffer));
-	fclose(sf);
+		int nPut = 0;
+		while(nPut < pPipe->nLength[i])
+		{
+			int n = pPipe->pSink(pPipe->pCtx, pPipe->pBuffer[i] + nPut, pPipe->nLength[i] - nPut);
+			if (n <= 0)
+			{
+				PipeFinish(pPipe, true);
+				return NULL;
+			}
 
-	sprintf(buffer, "setenv filesize 0x%x\n", filelen);
-	return SendCommand(buffer);
+			nPut += n;
+		}
+
+		PipeSet(pPipe, i, false);
+		i ^= 1;
+	}
+
+	return NULL;
 }
 
-ERR_CODE CIBootConn::GetFile(const char *szFile, unsigned long lLoadAddr, int nLen)
+static double StreamNow()
 {
-	FILE *sf = fopen(szFile, "w");
-	if (sf == NULL)
-		return IB_FILE_NOT_FOUND;
+	struct timeval tv;
+	gettimeofday(&tv, NULL);
+	return tv.tv_sec + tv.tv_usec / 1000000.0;
+}
+
+static void StreamProgress(CIBootConn::ProgressFn pProgress, void *pCtx, double dStart, unsigned long long nDone, unsigned long long nTotal)
+{
+	if (!pProgress)
+		return;
+
+	double dElapsed = StreamNow() - dStart;
+	pProgress(pCtx, nDone, nTotal, (dElapsed > 0) ? (nDone / dElapsed) : 0);
+}
+
+static int FdSource(void *pCtx, char *pBuffer, int nLength)
+{
+	return read(*(int *)pCtx, pBuffer, nLength);
+}
+
+static int FdSink(void *pCtx, const char *pBuffer, int nLength)
+{
+	return write(*(int *)pCtx, pBuffer, nLength);
+}
 
+void CIBootConn::PrintProgress(void *pCtx, unsigned long long nDone, unsigned long long nTotal, double dBytesPerSec)
+{
+	fprintf(stderr, "\r%llu/%llu KB (%.1f KB/s)", nDone / 1024, nTotal / 1024, dBytesPerSec / 1024);
+	if (nDone == nTotal)
+		fprintf(stderr, "\n");
+}
+
+ERR_CODE CIBootConn::SendStream(SourceFn pSource, void *pCtx, int nLen, unsigned long lLoadAddr, ProgressFn pProgress, void *pProgressCtx)
+{
 	RequestSendFile(m_pSend, m_pRecv, nLen, lLoadAddr);
-	if (m_pRecv->cmdcode != MSG_ACK)
-	{
-		fclose(sf);
+	if(m_pRecv->cmdcode != MSG_ACK)
 		return IB_COMMAND_NOT_ACK;
+
+	SStreamPipe pipe;
+	PipeInit(&pipe, STREAM_CHUNK);
+	pipe.pSource = pSource;
+	pipe.pSink = NULL;
+	pipe.pCtx = pCtx;
+	pipe.nTotal = nLen;
+
+	pthread_t thread;
+	if (pthread_create(&thread, NULL, PipeSourceMain, &pipe) != 0)
+	{
+		PipeDestroy(&pipe);
+		return IB_FAIL;
+	}
+
+	ERR_CODE code = IB_SUCCESS;
+	double dStart = StreamNow();
+	int nSent = 0;
+	int i = 0;
+	while(nSent < nLen)
+	{
+		if (!PipeWait(&pipe, i, true))
+		{
+			code = IB_FAIL;
+			break;
+		}
+
+		int nWritten = pipe.nLength[i];
+		if ((code = WriteFile(pipe.pBuffer[i], nWritten)) != IB_SUCCESS)
+		{
+			PipeFinish(&pipe, true);
+			break;
+		}
+
+		nSent += pipe.nLength[i];
+		PipeSet(&pipe, i, false);
+		i ^= 1;
+
+		StreamProgress(pProgress, pProgressCtx, dStart, nSent, nLen);
 	}
 
-	int read = nLen;
-	char *buf = new char[read];
+	pthread_join(thread, NULL);
+	PipeDestroy(&pipe);
+
+	return code;
+}
+
+ERR_CODE CIBootConn::GetStream(SinkFn pSink, void *pCtx, unsigned long lLoadAddr, int nLen, ProgressFn pProgress, void *pProgressCtx)
+{
+	RequestReadFile(m_pSend, m_pRecv, nLen, lLoadAddr);
+	if (m_pRecv->cmdcode != MSG_ACK)
+		return IB_COMMAND_NOT_ACK;
+
+	SStreamPipe pipe;
+	PipeInit(&pipe, STREAM_CHUNK);
+	pipe.pSource = NULL;
+	pipe.pSink = pSink;
+	pipe.pCtx = pCtx;
+	pipe.nTotal = nLen;
+
+	pthread_t thread;
+	if (pthread_create(&thread, NULL, PipeSinkMain, &pipe) != 0)
+	{
+		PipeDestroy(&pipe);
+		return IB_FAIL;
+	}
 
 	ERR_CODE code = IB_SUCCESS;
-	if ((code = ReadFile(buf, read)) != IB_SUCCESS)
+	double dStart = StreamNow();
+	int nRead = 0;
+	int i = 0;
+	while(nRead < nLen)
 	{
-		delete [] buf;
-		fclose(sf);
-		return code;
+		if (!PipeWait(&pipe, i, false))
+		{
+			code = IB_FAIL;
+			break;
+		}
+
+		int nChunk = nLen - nRead;
+		if (nChunk > STREAM_CHUNK)
+			nChunk = STREAM_CHUNK;
+
+		if ((code = ReadFile(pipe.pBuffer[i], nChunk)) != IB_SUCCESS || nChunk == 0)
+		{
+			if (code == IB_SUCCESS)
+				code = IB_CONNECTION_LOST;
+			PipeFinish(&pipe, true);
+			break;
+		}
+
+		pipe.nLength[i] = nChunk;
+		nRead += nChunk;
+		PipeSet(&pipe, i, true);
+		i ^= 1;
+
+		StreamProgress(pProgress, pProgressCtx, dStart, nRead, nLen);
+	}
+
+	if (code == IB_SUCCESS)
+		PipeFinish(&pipe, false);
+
+	pthread_join(thread, NULL);
+
+	// The sink may have failed on the last buffers after the USB side was done
+	if (code == IB_SUCCESS && pipe.bFailed)
+		code = IB_FAIL;
+
+	PipeDestroy(&pipe);
+
+	return code;
+}
+
+ERR_CODE CIBootConn::SendFd(int fd, int nLen, unsigned long lLoadAddr, ProgressFn pProgress, void *pProgressCtx)
+{
+	return SendStream(FdSource, &fd, nLen, lLoadAddr, pProgress, pProgressCtx);
+}
+
+ERR_CODE CIBootConn::GetFd(int fd, unsigned long lLoadAddr, int nLen, ProgressFn pProgress, void *pProgressCtx)
+{
+	return GetStream(FdSink, &fd, lLoadAddr, nLen, pProgress, pProgressCtx);
+}
+
+ERR_CODE CIBootConn::SendFile(const char *szFile, unsigned long lLoadAddr, ProgressFn pProgress)
+{
+	int fd = open(szFile, O_RDONLY);
+	if (fd < 0)
+		return IB_FILE_NOT_FOUND;
+
+	struct stat st;
+	if (fstat(fd, &st) < 0)
+	{
+		close(fd);
+		return IB_FILE_NOT_FOUND;
 	}
 
-	fwrite(buf, 1, read, sf);
-	delete [] buf;
-	fclose(sf);
+	int filelen = st.st_size;
+	ERR_CODE code = SendFd(fd, filelen, lLoadAddr, pProgress);
+	close(fd);
+	if (code != IB_SUCCESS)
+		return code;
+
+	char buffer[64];
+	sprintf(buffer, "setenv filesize 0x%x\n", filelen);
+	return SendCommand(buffer);
+}
+
+ERR_CODE CIBootConn::GetFile(const char *szFile, unsigned long lLoadAddr, int nLen, ProgressFn pProgress)
+{
+	int fd = open(szFile, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	if (fd < 0)
+		return IB_FILE_NOT_FOUND;
+
+	ERR_CODE code = GetFd(fd, lLoadAddr, nLen, pProgress);
+	close(fd);
+	if (code != IB_SUCCESS)
+		return code;
 
 	char buffer[64];
 	sprintf(buffer, "setenv filesize 0x%x\n", nLen);
@@ -2,14 +2,22 @@
 #include "openiboot-asmhelpers.h"
 #include "arm.h"
 #include "lcd.h"
+#include "framebuffer.h"
+#include "uart.h"
 #include "mmu.h"
 #include "util.h"
 #include "hfs/fs.h"
 #include "nand.h"
+#include "ftl.h"
 #include "wdt.h"
 #include "dma.h"
 #include "radio.h"
 #include "syscfg.h"
+#include "nvram.h"
+#include "lzss.h"
+#include "bootprof.h"
+#include "timer.h"
+#include "pmu.h"
 
 #define MACH_APPLE_IPHONE 1506
 
@@ -30,6 +38,8 @@
 #define ATAG_IPHONE_WIFI       0x54411002
 #define ATAG_IPHONE_PROX_CAL   0x54411004
 #define ATAG_IPHONE_MT_CAL     0x54411005
+#define ATAG_IPHONE_BOOTPROF   0x54411006
+#define ATAG_IPHONE_FTL        0x54411007
 
 /* structures for each atag */
 struct atag_header {
@@ -123,6 +133,15 @@ struct atag_iphone_cal_data {
 	uint8_t		data[];
 };
 
+struct atag_iphone_bootprof {
+	uint32_t		dropped;	/* older records that did not fit */
+	BootProfileEntry	entries[];
+};
+
+struct atag_iphone_ftl {
+	FTLExport	ftl;
+};
+
 struct atag {
 	struct atag_header hdr;
 	union {
@@ -138,10 +157,86 @@ struct atag {
 		struct atag_iphone_nand      nand;
 		struct atag_iphone_wifi      wifi;
 		struct atag_iphone_cal_data  mt_cal;
+		struct atag_iphone_bootprof  bootprof;
+		struct atag_iphone_ftl       ftl;
 	} u;
 };
 
+static Handoff TakenHandoff;
+static int HaveHandoff = FALSE;
+
+void chainload_warm(uint32_t address) {
+	Handoff* handoff = (Handoff*) HANDOFF_ADDRESS;
+
+	handoff->magic = HANDOFF_MAGIC;
+	handoff->version = HANDOFF_VERSION;
+	handoff->flags = HandoffConsole;
+	if(lcd_running())
+		handoff->flags |= HandoffLCD;
+	handoff->panelID = LCDPanelID;
+	handoff->timestamp = (uint32_t) timer_get_system_microtime();
+	handoff->crc = 0;
+	crc32(&handoff->crc, handoff, (uint8_t*)&handoff->crc - (uint8_t*)handoff);
+
+	chainload(address);
+}
+
+void handoff_take() {
+	Handoff* handoff = (Handoff*) HANDOFF_ADDRESS;
+	uint32_t crc = 0;
+
+	if(handoff->magic != HANDOFF_MAGIC || handoff->version != HANDOFF_VERSION)
+		return;
+
+	crc32(&crc, handoff, (uint8_t*)&handoff->crc - (uint8_t*)handoff);
+	if(crc == handoff->crc) {
+		memcpy(&TakenHandoff, handoff, sizeof(Handoff));
+		HaveHandoff = TRUE;
+		bootprof_mark("warm start", handoff->timestamp);
+	}
+
+	handoff->magic = 0;
+}
+
+const Handoff* handoff_get() {
+	return HaveHandoff ? &TakenHandoff : NULL;
+}
+
+int handoff_has(HandoffFlags flag) {
+	return HaveHandoff && (TakenHandoff.flags & flag) != 0;
+}
+
+void resume_check() {
+	ResumeRecord* record = (ResumeRecord*) RESUME_ADDRESS;
+	uint8_t flag;
+	uint32_t crc = 0;
+
+	if(pmu_get_gpmem_reg(PMU_RESUMEFLAG, &flag) != 0 || flag != PMU_RESUME_MAGIC)
+		return;
+
+	// cleared first, so a resume that goes wrong is a cold boot the next time
+	pmu_set_gpmem_reg(PMU_RESUMEFLAG, 0);
+
+	if(record->magic != RESUME_MAGIC || record->version != RESUME_VERSION) {
+		bufferPrintf("resume: no resume record\r\n");
+		return;
+	}
+
+	crc32(&crc, record, (uint8_t*)&record->crc - (uint8_t*)record);
+	record->magic = 0;
+	if(crc != record->crc) {
+		bufferPrintf("resume: bad resume record\r\n");
+		return;
+	}
+
+	bootprof_mark("resume", record->vector);
+	chainload(record->vector);
+}
+
 void chainload(uint32_t address) {
+	bootprof_mark("chainload", address);
+	framebuffer_reset_scroll();
+	uart_flush(0);
 	EnterCriticalSection();
 	wdt_disable();
 	arm_disable_caches();
@@ -153,6 +248,11 @@ void chainload(uint32_t address) {
 #define tag_size(type)  ((sizeof(struct atag_header) + sizeof(struct type)) >> 2)
 static struct atag *params; /* used to point at the current tag */
 
+// The tags are put together here, then boot_linux moves just the bytes in use
+// to 0x100 at the very end. Linux is only ever given the first TAGS_SIZE.
+#define TAGS_SIZE 0x1000
+static uint32_t TagBuffer[TAGS_SIZE / sizeof(uint32_t)];
+
 static void setup_core_tag(void * address, long pagesize)
 {
 	params = (struct atag *)address;         /* Initialise parameters to start at given address */
@@ -216,20 +316,21 @@ static void setup_cmdline_tag(const char * line)
 	params = tag_next(params);              /* move pointer to next tag */
 }
 
-static void setup_wifi_tags()
+// FALSE if the baseband could not be asked for the data
+static int setup_wifi_tags()
 {
 	uint8_t* mac;
-	uint32_t calSize;
+	int calSize;
 	uint8_t* cal;
 
 #ifdef CONFIG_IPOD
-	return;
+	return TRUE;
 #else
 	if(radio_nvram_get(2, &mac) < 0)
-		return;
+		return FALSE;
 
 	if((calSize = radio_nvram_get(1, &cal)) < 0)
-		return;
+		return FALSE;
 #endif
 
 	memcpy(&params->u.wifi.mac, mac, 6);
@@ -239,6 +340,7 @@ static void setup_wifi_tags()
 	params->hdr.tag = ATAG_IPHONE_WIFI;         /* iPhone NAND tag */
 	params->hdr.size = (sizeof(struct atag_header) + sizeof(struct atag_iphone_wifi) + calSize + 4) >> 2;
 	params = tag_next(params);              /* move pointer to next tag */
+	return TRUE;
 }
 
 static void setup_prox_tag()
@@ -287,6 +389,99 @@ static void setup_mt_tag()
 #endif
 }
 
+#ifndef NO_HFS
+// The proximity, multitouch and wifi tags depend only on the device, and the
+// wifi one needs the baseband's NVRAM, which takes a while to read. Once all
+// of them could be probed they are kept in HWPARAMS_FILE, as the tags
+// themselves, and later boots copy them in from there. Bump HWPARAMS_VERSION
+// whenever what goes into those tags changes. Setting opib-hwparams to false
+// probes every time and leaves the file alone.
+#define HWPARAMS_FILE "/openiboot-hwparams"
+#define HWPARAMS_MAGIC 0x48575052	// 'HWPR'
+#define HWPARAMS_VERSION 1
+
+typedef struct HWParamsHeader {
+	uint32_t magic;
+	uint32_t version;
+	uint32_t size;		// bytes of tags following
+	uint32_t crc;		// crc32 of those
+} HWParamsHeader;
+
+static int hwparams_enabled()
+{
+	const char* var = nvram_getvar("opib-hwparams");
+	return !var || !(strcmp(var, "false") == 0 || strcmp(var, "0") == 0);
+}
+
+static int hwparams_load(struct atag* parameters)
+{
+	uint32_t space = TAGS_SIZE - ((uint8_t*)params - (uint8_t*)parameters);
+	HWParamsHeader* header = (HWParamsHeader*) malloc(sizeof(HWParamsHeader) + TAGS_SIZE);
+	int ok = FALSE;
+
+	if(header == NULL)
+		return FALSE;
+
+	int size = fs_extract_max(1, HWPARAMS_FILE, header, sizeof(HWParamsHeader) + TAGS_SIZE);
+	if(size >= (int)sizeof(HWParamsHeader) && header->magic == HWPARAMS_MAGIC && header->version == HWPARAMS_VERSION
+			&& header->size == (size - sizeof(HWParamsHeader)) && header->size < space && (header->size & 3) == 0) {
+		uint32_t crc = 0;
+		crc32(&crc, header + 1, header->size);
+		if(crc == header->crc) {
+			memcpy(params, header + 1, header->size);
+			params = (struct atag*)((uint8_t*)params + header->size);
+			ok = TRUE;
+		}
+	}
+
+	free(header);
+	return ok;
+}
+
+static void hwparams_store(struct atag* start)
+{
+	uint32_t size = (uint8_t*)params - (uint8_t*)start;
+	HWParamsHeader* header = (HWParamsHeader*) malloc(sizeof(HWParamsHeader) + size);
+
+	if(header == NULL)
+		return;
+
+	header->magic = HWPARAMS_MAGIC;
+	header->version = HWPARAMS_VERSION;
+	header->size = size;
+	header->crc = 0;
+	crc32(&header->crc, start, size);
+	memcpy(header + 1, start, size);
+
+	if(fs_store(1, HWPARAMS_FILE, header, sizeof(HWParamsHeader) + size))
+		bufferPrintf("Hardware parameters cached in %s.\r\n", HWPARAMS_FILE);
+
+	free(header);
+}
+#endif
+
+static void setup_hw_tags(struct atag* parameters)
+{
+#ifdef NO_HFS
+	setup_prox_tag();
+	setup_mt_tag();
+	setup_wifi_tags();
+#else
+	struct atag* start = params;
+	int cache = hwparams_enabled();
+
+	if(cache && hwparams_load(parameters)) {
+		bufferPrintf("Hardware parameters loaded from %s.\r\n", HWPARAMS_FILE);
+		return;
+	}
+
+	setup_prox_tag();
+	setup_mt_tag();
+	if(setup_wifi_tags() && cache)
+		hwparams_store(start);
+#endif
+}
+
 static int rootfs_partition = 0;
 static char* rootfs_filename = NULL;
 
@@ -316,8 +511,39 @@ static void setup_iphone_nand_tag()
 	params->hdr.size = tag_size(atag_iphone_nand);
 	params = tag_next(params);              /* move pointer to next tag */
 }
+
+// Returns how many bytes from FTL_HANDOFF_ADDRESS the FTL tables were left in,
+// or 0 if they were not. Nothing may touch the FTL after this.
+static uint32_t setup_iphone_ftl_tag()
+{
+	if(!ftl_export((void*) FTL_HANDOFF_ADDRESS, FTL_HANDOFF_SIZE, &params->u.ftl.ftl))
+		return 0;
+
+	uint32_t size = params->u.ftl.ftl.size;
+
+	params->hdr.tag = ATAG_IPHONE_FTL;
+	params->hdr.size = tag_size(atag_iphone_ftl);
+	params = tag_next(params);              /* move pointer to next tag */
+	return size;
+}
 #endif
 
+// the profile gets whatever is left of TAGS_SIZE, newest records first
+static void setup_bootprof_tag(struct atag* parameters)
+{
+	int used = (uint8_t*)params - (uint8_t*)parameters;
+	int space = TAGS_SIZE - used - sizeof(struct atag_header) * 2 - sizeof(struct atag_iphone_bootprof);
+	if(space < (int)sizeof(BootProfileEntry))
+		return;
+
+	int count = bootprof_read(params->u.bootprof.entries, space / sizeof(BootProfileEntry));
+	params->u.bootprof.dropped = bootprof_dropped() + (bootprof_count() - count);
+
+	params->hdr.tag = ATAG_IPHONE_BOOTPROF;
+	params->hdr.size = (sizeof(struct atag_header) + sizeof(struct atag_iphone_bootprof) + count * sizeof(BootProfileEntry)) >> 2;
+	params = tag_next(params);              /* move pointer to next tag */
+}
+
 static void setup_end_tag()
 {
 	params->hdr.tag = ATAG_NONE;            /* Empty tag ends list */
@@ -326,29 +552,55 @@ static void setup_end_tag()
 
 static void* kernel = NULL;
 static uint32_t kernelSize;
+static int kernelInPlace = FALSE;
 static void* ramdisk = NULL;
 static uint32_t ramdiskSize;
 static uint32_t ramdiskRealSize;
 
+// The ramdisk goes to INITRD_LOAD straight away, with the caches and the DMA
+// controllers still up, so boot_linux has nothing left to move.
 void set_ramdisk(void* location, int size) {
-	if(ramdisk)
-		free(ramdisk);
-
 	// the gzip file format places the uncompressed length in the last four bytes of the file. Read it and calculate the size in KB.
 	ramdiskRealSize = ((*((uint32_t*)((uint8_t*)location + size - sizeof(uint32_t)))) + 1023) / 1024;
 
+	uint8_t* src = (uint8_t*) location;
+	uint8_t* dest = (uint8_t*) INITRD_LOAD;
+	if(src != dest) {
+		if((src < dest + size) && (dest < src + size))
+			memmove(dest, src, size);
+		else
+			dma_memcpy(dest, src, size);
+	}
+
+	ramdiskSize = size;
+	ramdisk = (void*) INITRD_LOAD;
+}
+
+// The ramdisk has already been loaded at INITRD_LOAD.
+void set_ramdisk_in_place(int size) {
+	ramdiskRealSize = ((*((uint32_t*)(INITRD_LOAD + size - sizeof(uint32_t)))) + 1023) / 1024;
 	ramdiskSize = size;
-	ramdisk = malloc(size);
-	memcpy(ramdisk, location, size);
+	ramdisk = (void*) INITRD_LOAD;
 }
 
 void set_kernel(void* location, int size) {
-	if(kernel)
+	if(kernel && !kernelInPlace)
 		free(kernel);
 
 	kernelSize = size;
 	kernel = malloc(size);
-	memcpy(kernel, location, size);
+	kernelInPlace = FALSE;
+	dma_memcpy(kernel, location, size);
+}
+
+// For a kernel loaded where nothing will touch it before boot_linux.
+void set_kernel_in_place(void* location, int size) {
+	if(kernel && !kernelInPlace)
+		free(kernel);
+
+	kernelSize = size;
+	kernel = location;
+	kernelInPlace = TRUE;
 }
 
 void set_rootfs(int partition, const char* fileName) {
@@ -358,33 +610,46 @@ void set_rootfs(int partition, const char* fileName) {
 	rootfs_filename = strdup(fileName);
 }
 
-#define INITRD_LOAD 0x06000000
-
 static void setup_tags(struct atag* parameters, const char* commandLine)
 {
+	uint32_t ftlKept = 0;
+
 	setup_core_tag(parameters, 4096);       /* standard core tag 4k pagesize */
-	setup_mem_tag(MemoryStart, 0x08000000);    /* 128Mb at 0x00000000 */
 	if(ramdisk != NULL && ramdiskSize > 0) {
 		setup_ramdisk_tag(ramdiskRealSize);
 		setup_initrd2_tag(INITRD_LOAD, ramdiskSize);
 	}
 	setup_cmdline_tag(commandLine);
-	setup_prox_tag();
-	setup_mt_tag();
-	setup_wifi_tags();
+	setup_hw_tags(parameters);
 #ifndef NO_HFS
 	setup_iphone_nand_tag();
+	// last of anything that might still write to the FTL
+	ftlKept = setup_iphone_ftl_tag();
 #endif
+	if(ftlKept) {
+		setup_mem_tag(MemoryStart, FTL_HANDOFF_ADDRESS - MemoryStart);
+		setup_mem_tag(FTL_HANDOFF_ADDRESS + ftlKept, 0x08000000 - (FTL_HANDOFF_ADDRESS + ftlKept));
+	} else {
+		setup_mem_tag(MemoryStart, 0x08000000);    /* 128Mb at 0x00000000 */
+	}
+	setup_bootprof_tag(parameters);
 	setup_end_tag();                    /* end of tags */
 }
 
 void boot_linux(const char* args) {
 	uint32_t exec_at = (uint32_t) kernel;
-	uint32_t param_at = exec_at - 0x2000;
-	setup_tags((struct atag*) param_at, args);
+	bootprof_mark("handoff", exec_at);
+	setup_tags((struct atag*) TagBuffer, args);
+
+	// everything up to and including the end tag
+	uint32_t tagWords = ((uint32_t*)params - TagBuffer) + (sizeof(struct atag_header) / sizeof(uint32_t));
 
 	uint32_t mach_type = MACH_APPLE_IPHONE;
 
+	// the kernel expects the console at the start of the framebuffer
+	framebuffer_reset_scroll();
+	uart_flush(0);
+
 	EnterCriticalSection();
 	dma_shutdown();
 	wdt_disable();
@@ -392,16 +657,13 @@ void boot_linux(const char* args) {
 	mmu_disable();
 
 	/* FIXME: This overwrites openiboot! We make the semi-reasonable assumption
-	 * that this function's own code doesn't reside in 0x0100-0x1100 */
+	 * that this function's own code doesn't reside in 0x0100-0x1100. That is
+	 * also why this stays an inline loop rather than a call into memcpy. */
 
 	int i;
 
-	for(i = 0; i < ((ramdiskSize + sizeof(uint32_t) - 1)/sizeof(uint32_t)); i++) {
-		((uint32_t*)INITRD_LOAD)[i] = ((uint32_t*)ramdisk)[i];
-	}
-
-	for(i = 0; i < (0x1000/sizeof(uint32_t)); i++) {
-		((uint32_t*)0x100)[i] = ((uint32_t*)param_at)[i];
+	for(i = 0; i < tagWords; i++) {
+		((uint32_t*)0x100)[i] = TagBuffer[i];
 	}
 
 	asm (	"MOV	R4, %0\n"
@@ -415,31 +677,234 @@ void boot_linux(const char* args) {
 }
 
 #ifndef NO_HFS
-void boot_linux_from_files()
+// With opib-direct-boot set, the kernel and initrd are read straight out of
+// the FTL using extent maps kept in NVRAM, formatted as
+// "size crc32 start+count start+count ...", all in hex. A map that does not
+// parse or whose data does not match the crc is rebuilt from HFS+.
+
+static uint32_t parseHex(const char** str) {
+	uint32_t value = 0;
+	const char* pos = *str;
+
+	while(*pos == ' ' || *pos == '+')
+		pos++;
+
+	while(TRUE) {
+		char c = *pos;
+		if(c >= '0' && c <= '9')
+			value = (value << 4) | (c - '0');
+		else if(c >= 'a' && c <= 'f')
+			value = (value << 4) | (c - 'a' + 10);
+		else
+			break;
+		pos++;
+	}
+
+	*str = pos;
+	return value;
+}
+
+static int boot_map_load(const char* var, void* location) {
+	const char* map = nvram_getvar(var);
+	ExtentList list;
+	uint32_t size;
+	uint32_t crc;
+	uint32_t check = 0;
+
+	if(!map)
+		return -1;
+
+	size = parseHex(&map);
+	crc = parseHex(&map);
+	list.numExtents = 0;
+	while(*map != '\0' && list.numExtents < (sizeof(list.extents) / sizeof(ExtentListItem))) {
+		list.extents[list.numExtents].startBlock = parseHex(&map);
+		if(*map != '+')
+			return -1;
+		list.extents[list.numExtents].blockCount = parseHex(&map);
+		list.numExtents++;
+	}
+
+	if(size == 0 || *map != '\0' || fs_read_extents(&list, size, location) != 0)
+		return -1;
+
+	crc32(&check, location, size);
+	if(check != crc)
+		return -1;
+
+	return size;
+}
+
+static int boot_map_store(const char* var, const char* file, void* location, int size) {
+	ExtentList* list = fs_get_extents(1, file);
+	uint32_t crc = 0;
+	char* map;
+	char* pos;
+	int i;
+
+	if(!list)
+		return FALSE;
+
+	map = pos = (char*) malloc(20 + list->numExtents * 20);
+	crc32(&crc, location, size);
+	sprintf(pos, "%x %x", size, crc);
+	pos += strlen(pos);
+	for(i = 0; i < list->numExtents; i++) {
+		sprintf(pos, " %x+%x", list->extents[i].startBlock, list->extents[i].blockCount);
+		pos += strlen(pos);
+	}
+
+	nvram_setvar(var, map);
+	free(map);
+	free(list);
+	return TRUE;
+}
+
+// Files may come wrapped in an LZSS comp container. They are decompressed
+// into place chunk by chunk as they are read; plain files are read straight
+// into place.
+typedef struct BootLoad {
+	uint8_t* location;
+	uint8_t* chunk;
+	int compressed;
+	uint32_t remaining;
+	uint32_t length;
+	uint32_t checksum;
+	LZSSStream lzss;
+} BootLoad;
+
+static int boot_load_consume(FSStream* stream, uint32_t offset, uint32_t len) {
+	BootLoad* load = (BootLoad*) stream->opaque;
+	uint8_t* data = stream->buffer;
+
+	if(offset == 0 && len >= sizeof(LZSSCompHeader)) {
+		int length = lzss_comp_check((LZSSCompHeader*) data, &load->remaining, &load->checksum);
+		if(length >= 0) {
+			load->compressed = TRUE;
+			load->length = length;
+			load->chunk = malloc(FS_STREAM_CHUNK);
+
+			// the output starts right where this chunk was read to
+			memcpy(load->chunk, data, len);
+			data = load->chunk + sizeof(LZSSCompHeader);
+			len -= sizeof(LZSSCompHeader);
+			stream->buffer = load->chunk;
+			lzss_stream_init(&load->lzss, load->location, length);
+		}
+	}
+
+	if(!load->compressed) {
+		stream->buffer += len;
+		return 0;
+	}
+
+	// anything past the compressed data is padding
+	if(len > load->remaining)
+		len = load->remaining;
+	load->remaining -= len;
+
+	return lzss_stream_feed(&load->lzss, data, len);
+}
+
+static int boot_load_stream(const char* file, void* location, int* compressed) {
+	BootLoad load;
+	FSStream stream;
+	int size;
+
+	memset(&load, 0, sizeof(load));
+	load.location = (uint8_t*) location;
+	stream.buffer = (uint8_t*) location;
+	stream.consume = boot_load_consume;
+	stream.opaque = &load;
+
+	bootprof_begin("fs_extract");
+	size = fs_extract_stream(1, file, &stream);
+	bootprof_end("fs_extract", size);
+
+	if(load.chunk)
+		free(load.chunk);
+
+	*compressed = load.compressed;
+	if(size < 0 || !load.compressed)
+		return size;
+
+	// decoding went along with the reads, so this only times the check
+	bootprof_begin("lzss check");
+	int corrupt = load.remaining != 0 || lzss_stream_length(&load.lzss) != load.length
+			|| adler32(load.location, load.length) != load.checksum;
+	bootprof_end("lzss check", load.length);
+
+	if(corrupt) {
+		bufferPrintf("%s: corrupt compressed file\r\n", file);
+		return -1;
+	}
+
+	bufferPrintf("%s: %d bytes decompressed to %d\r\n", file, size, load.length);
+	return load.length;
+}
+
+static int boot_load_file(const char* var, const char* file, void* location, int direct, int* mapsChanged) {
+	int size;
+	int compressed;
+
+	if(direct) {
+		bootprof_begin("direct load");
+		size = boot_map_load(var, location);
+		bootprof_end("direct load", size);
+		if(size >= 0)
+			return size;
+	}
+
+	size = boot_load_stream(file, location, &compressed);
+
+	// maps describe the data as it sits in NAND, so only for plain files
+	if(size > 0 && direct && !compressed && boot_map_store(var, file, location, size))
+		*mapsChanged = TRUE;
+
+	return size;
+}
+
+int load_linux_from_files()
 {
 	int size;
+	int mapsChanged = FALSE;
+	const char* directBoot = nvram_getvar("opib-direct-boot");
+	int direct = directBoot && (strcmp(directBoot, "true") == 0 || strcmp(directBoot, "1") == 0);
 
 	bufferPrintf("Loading kernel...\r\n");
+	bootprof_mark("kernel", 0);
 
-	size = fs_extract(1, "/zImage", (void*) 0x09000000);
+	size = boot_load_file("opib-kernel-map", "/zImage", (void*) 0x09000000, direct, &mapsChanged);
 	if(size < 0)
 	{
 		bufferPrintf("Cannot find kernel.\r\n");
-		return;
+		return -1;
 	}
 
-	set_kernel((void*) 0x09000000, size);
+	// the initrd goes to INITRD_LOAD, so the kernel can stay where it was read
+	set_kernel_in_place((void*) 0x09000000, size);
 
 	bufferPrintf("Loading initrd...\r\n");
+	bootprof_mark("initrd", 0);
 
-	size = fs_extract(1, "/android.img.gz", (void*) 0x09000000);
+	size = boot_load_file("opib-initrd-map", "/android.img.gz", (void*) INITRD_LOAD, direct, &mapsChanged);
 	if(size < 0)
 	{
 		bufferPrintf("Cannot find ramdisk.\r\n");
-		return;
+		return -1;
 	}
 
-	set_ramdisk((void*) 0x09000000, size);
+	if(mapsChanged)
+		nvram_save();
+
+	set_ramdisk_in_place(size);
+	return 0;
+}
+
+void boot_linux_from_files(int loaded)
+{
+	if(!loaded && load_linux_from_files() != 0)
+		return;
 
 	bufferPrintf("Booting Linux...\r\n");
 
@@ -10,10 +10,24 @@ static int unknown2;
 
 static uint8_t destinationBuffer[AES_128_CBC_BLOCK_SIZE];
 
+static volatile int AESPending = FALSE;
+
+// The session whose key is still loaded from its last job, if any. Any other
+// use of the engine reprograms it from scratch.
+static AESSession* EngineSession = NULL;
+
+// An encrypting session learns its next IV once the pending job is done
+static AESSession* PendingSession = NULL;
+static const uint8_t* PendingTail = NULL;
+
 static void initVector(const void* iv);
 
 static void loadKey(const void *key);
 
+static void setupAES(int operation, AESKeyType keyType, const void *key, int option0, int option1);
+
+static void startAES(void *buffer0, void *buffer1, void *buffer2, int size0, int size1, int size2, int size3);
+
 static void doAES(int operation, void *buffer0, void *buffer1, void *buffer2, int size0, AESKeyType keyType, const void *key, int option0, int option1, int size1, int size2, int size3);
 
 static const uint8_t Gen836[] = {0x00, 0xE5, 0xA0, 0xE6, 0x52, 0x6F, 0xAE, 0x66, 0xC5, 0xC1, 0xC6, 0xD4, 0xF1, 0x6D, 0x61, 0x80};
@@ -64,8 +78,20 @@ void aes_838_decrypt(void* data, int size, const void* iv) {
 	aes_decrypt(data, size, AESCustom, Key838, iv);
 }
 
+void aes_838_decrypt_async(void* data, int size, const void* iv) {
+	aes_decrypt_async(data, size, AESCustom, Key838, iv);
+}
+
+const void* aes_838_key() {
+	return Key838;
+}
+
+
+static void aes_start(int operation, void* data, int size, AESKeyType keyType, const void* key, const void* iv) {
+	// only one operation can be programmed into the engine at a time
+	aes_wait();
+	EngineSession = NULL;
 
-void aes_encrypt(void* data, int size, AESKeyType keyType, const void* key, const void* iv) {
 	clock_gate_switch(AES_CLOCKGATE, ON);
 	SET_REG(AES + CONTROL, 1);
 	unknown1 = 0;
@@ -76,51 +102,146 @@ void aes_encrypt(void* data, int size, AESKeyType keyType, const void* key, cons
 
 	initVector(iv);
 
+	CleanAndInvalidateCPUDataCache();
+
+	AESPending = TRUE;
+
+	// call AES internal function
+	doAES(operation, data, data, data, size, keyType, key, 0, 1, size, size, size);
+}
+
+int aes_busy() {
+	return AESPending && ((GET_REG(AES + STATUS) & 0xF) == 0);
+}
+
+void aes_wait() {
+	if(!AESPending)
+		return;
+
+	while((GET_REG(AES + STATUS) & 0xF) == 0);
+
+	if(PendingSession) {
+		memcpy(PendingSession->iv, PendingTail, AES_128_CBC_IV_SIZE);
+		PendingSession = NULL;
+	}
+
+	// a session's key stays in the engine until it is closed
+	if(EngineSession == NULL) {
+		memset((void*)(AES + KEY), 0, KEYSIZE);
+		memset((void*)(AES + IV), 0, IVSIZE);
+	}
+
+	AESPending = FALSE;
+}
+
+void aes_encrypt(void* data, int size, AESKeyType keyType, const void* key, const void* iv) {
 	void* destination;
 
 	if(size < AES_128_CBC_BLOCK_SIZE) {
 		// AES will always write in block size chunks, but we don't want to overflow the buffer provided
+		aes_wait();
 		memcpy(destinationBuffer, data, size);
 		destination = destinationBuffer;
 	} else {
 		destination = data;
 	}
 
-	CleanAndInvalidateCPUDataCache();
-
-	// call AES internal function
-	doAES(AES_ENCRYPT, destination, destination, destination, size, keyType, key, 0, 1, size, size, size);
-
-	while((GET_REG(AES + STATUS) & 0xF) == 0);
-
-	memset((void*)(AES + KEY), 0, KEYSIZE);
-	memset((void*)(AES + IV), 0, IVSIZE);
+	aes_start(AES_ENCRYPT, destination, size, keyType, key, iv);
+	aes_wait();
 
 	if(size < AES_128_CBC_BLOCK_SIZE)
 		memcpy(data, destinationBuffer, size);
 
 }
 
+void aes_decrypt_async(void* data, int size, AESKeyType keyType, const void* key, const void* iv) {
+	aes_start(AES_DECRYPT, data, size, keyType, key, iv);
+}
+
 void aes_decrypt(void* data, int size, AESKeyType keyType, const void* key, const void* iv) {
-	clock_gate_switch(AES_CLOCKGATE, ON);
-	SET_REG(AES + CONTROL, 1);
-	unknown1 = 0;
-	SET_REG(AES + UNKREG1, 0);
-	unknown2 = 1;
+	aes_start(AES_DECRYPT, data, size, keyType, key, iv);
+	aes_wait();
+}
 
-	CleanAndInvalidateCPUDataCache();
+void aes_session_open(AESSession* session, int encrypt, AESKeyType keyType, const void* key, const void* iv) {
+	session->encrypt = encrypt;
+	session->keyType = keyType;
+	session->key = key;
 
-	initVector(iv);
+	if(iv == NULL)
+		memset(session->iv, 0, AES_128_CBC_IV_SIZE);
+	else
+		memcpy(session->iv, iv, AES_128_CBC_IV_SIZE);
+}
+
+void aes_session_process_async(AESSession* session, void* data, int size) {
+	uint8_t* destination = data;
+
+	aes_wait();
+
+	if(size < AES_128_CBC_BLOCK_SIZE) {
+		// the engine writes whole blocks, so this one goes through the bounce buffer and waits
+		memcpy(destinationBuffer, data, size);
+		destination = destinationBuffer;
+	}
+
+	if(EngineSession != session) {
+		clock_gate_switch(AES_CLOCKGATE, ON);
+		SET_REG(AES + CONTROL, 1);
+		unknown1 = 0;
+		SET_REG(AES + UNKREG1, 0);
+		unknown2 = 1;
+
+		setupAES(session->encrypt ? AES_ENCRYPT : AES_DECRYPT, session->keyType, session->key, 0, 1);
+		EngineSession = session;
+	}
 
 	CleanAndInvalidateCPUDataCache();
 
-	// call AES internal function
-	doAES(AES_DECRYPT, data, data, data, size, keyType, key, 0, 1, size, size, size);
+	initVector(session->iv);
 
-	while((GET_REG(AES + STATUS) & 0xF) == 0);
+	// CBC carries the last ciphertext block over to the next buffer
+	if(size < AES_128_CBC_IV_SIZE) {
+		// nothing sensible to chain from
+	} else if(session->encrypt) {
+		PendingSession = session;
+		PendingTail = destination + size - AES_128_CBC_IV_SIZE;
+	} else {
+		memcpy(session->iv, destination + size - AES_128_CBC_IV_SIZE, AES_128_CBC_IV_SIZE);
+	}
+
+	AESPending = TRUE;
+	startAES(destination, destination, destination, size, size, size, size);
+
+	if(destination == destinationBuffer) {
+		aes_wait();
+		memcpy(data, destinationBuffer, size);
+	}
+}
+
+void aes_session_set_iv(AESSession* session, const void* iv) {
+	// a pending encryption would still write its last block over it
+	aes_wait();
 
-	memset((void*)(AES + KEY), 0, KEYSIZE);
-	memset((void*)(AES + IV), 0, IVSIZE);
+	if(iv == NULL)
+		memset(session->iv, 0, AES_128_CBC_IV_SIZE);
+	else
+		memcpy(session->iv, iv, AES_128_CBC_IV_SIZE);
+}
+
+void aes_session_process(AESSession* session, void* data, int size) {
+	aes_session_process_async(session, data, size);
+	aes_wait();
+}
+
+void aes_session_close(AESSession* session) {
+	aes_wait();
+
+	if(EngineSession == session) {
+		EngineSession = NULL;
+		memset((void*)(AES + KEY), 0, KEYSIZE);
+		memset((void*)(AES + IV), 0, IVSIZE);
+	}
 }
 
 
@@ -181,8 +302,7 @@ static void loadKey(const void *key) {
 
 }
 
-static void doAES(int operation, void *buffer0, void *buffer1, void *buffer2, int size0, AESKeyType keyType, const void *key, int option0, int option1, int size1, int size2, int size3) {
-	
+static void setupAES(int operation, AESKeyType keyType, const void *key, int option0, int option1) {
 	unknown1 = 0;
 	SET_REG(AES + UNKREG0, 1);
 	SET_REG(AES + UNKREG0, 0);
@@ -195,6 +315,9 @@ static void doAES(int operation, void *buffer0, void *buffer1, void *buffer2, in
 	SET_REG(AES + KEYLEN, (GET_REG(AES + KEYLEN) & ~1) | operation);		// 1 bit field starting at bit 0
 	SET_REG(AES + KEYLEN, (GET_REG(AES + KEYLEN) & ~0x30) | (option0 << 4)); // 2 bit field starting at bit 4
 	SET_REG(AES + KEYLEN, (GET_REG(AES + KEYLEN) & ~0x8) | (option1 << 3)); // 1 bit field starting at bit 3
+}
+
+static void startAES(void *buffer0, void *buffer1, void *buffer2, int size0, int size1, int size2, int size3) {
 	SET_REG(AES + INSIZE, size0);
 	SET_REG(AES + INADDR, (uint32_t) buffer0);
 	SET_REG(AES + OUTSIZE, size2);
@@ -208,3 +331,8 @@ static void doAES(int operation, void *buffer0, void *buffer1, void *buffer2, in
 	SET_REG(AES + GO, 1);
 }
 
+static void doAES(int operation, void *buffer0, void *buffer1, void *buffer2, int size0, AESKeyType keyType, const void *key, int option0, int option1, int size1, int size2, int size3) {
+	setupAES(operation, keyType, key, option0, option1);
+	startAES(buffer0, buffer1, buffer2, size0, size1, size2, size3);
+}
+
@@ -6,6 +6,7 @@
 #include "multitouch.h"
 #include "util.h"
 #include "gpio.h"
+#include "workqueue.h"
 
 #define CONTROL 0x0
 #define TIMING 0x1
@@ -27,11 +28,16 @@ static uint8_t als_readb(uint8_t addr);
 static uint16_t als_readw(uint8_t addr);
 static void als_clearint();
 static void als_int(uint32_t token);
+static void als_work(void* opaque);
 static uint16_t als_data0();
 static uint16_t als_data1();
 
 static int use_channel;
 
+// the readings go over I2C, so they are taken outside the interrupt
+static Work ALSWork;
+static volatile int ALSEnabled = FALSE;
+
 int als_setup()
 {
 	multitouch_on();
@@ -48,6 +54,7 @@ int als_setup()
 
 	als_setchannel(0);
 
+	work_init(&ALSWork, als_work, NULL);
 	gpio_register_interrupt(ALS_INT, 1, 0, 0, als_int, 0);
 
 	bufferPrintf("als: initialized\r\n");
@@ -78,17 +85,19 @@ void als_enable_interrupt()
 	als_writeb(INTERRUPT, (1 << 4) | 1);
 	als_clearint();
 
+	ALSEnabled = TRUE;
 	gpio_interrupt_enable(ALS_INT);
 }
 
 void als_disable_interrupt()
 {
+	ALSEnabled = FALSE;
 	gpio_interrupt_disable(ALS_INT);
 	als_writeb(INTERRUPT, 0);
 	als_clearint();
 }
 
-static void als_int(uint32_t token)
+static void als_work(void* opaque)
 {
 	// this is needed because there's no way to avoid repeated interrupts at the boundaries (0 and 0xFFFF)
 	static uint16_t lastData0 = 0xFFFF;
@@ -111,6 +120,16 @@ static void als_int(uint32_t token)
 	lastData0 = data0;
 
 	als_clearint();
+
+	if(ALSEnabled)
+		gpio_interrupt_enable(ALS_INT);
+}
+
+// The line stays low until the work clears it, so it is masked till then.
+static void als_int(uint32_t token)
+{
+	gpio_interrupt_disable(ALS_INT);
+	work_post(&ALSWork);
 }
 
 void als_setlowthreshold(uint16_t value)
@@ -138,6 +157,11 @@ uint16_t als_data()
 	return use_channel == 0 ? als_data0() : als_data1();
 }
 
+uint8_t als_data_register()
+{
+	return 0x80 | 0x10 | (use_channel == 0 ? DATA0LOW : DATA1LOW);
+}
+
 static void als_writeb(uint8_t addr, uint8_t b)
 {
 	uint8_t buf[2];
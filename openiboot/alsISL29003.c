@@ -6,6 +6,7 @@
 #include "multitouch.h"
 #include "util.h"
 #include "gpio.h"
+#include "workqueue.h"
 
 #define COMMAND 0x0
 #define CONTROL 0x1
@@ -21,9 +22,14 @@ static uint8_t als_readb(uint8_t addr);
 static uint16_t als_readw(uint8_t addr);
 static void als_clearint();
 static void als_int(uint32_t token);
+static void als_work(void* opaque);
 
 static int use_channel;
 
+// the readings go over I2C, so they are taken outside the interrupt
+static Work ALSWork;
+static volatile int ALSEnabled = FALSE;
+
 int als_setup()
 {
 	multitouch_on();
@@ -45,6 +51,7 @@ int als_setup()
 		return -1;
 	}
 
+	work_init(&ALSWork, als_work, NULL);
 	gpio_register_interrupt(ALS_INT, 1, 0, 0, als_int, 0);
 
 	bufferPrintf("als: initialized\r\n");
@@ -70,16 +77,18 @@ void als_enable_interrupt()
 	als_writeb(CONTROL, (3 << 2) | 0);
 	als_clearint();
 
+	ALSEnabled = TRUE;
 	gpio_interrupt_enable(ALS_INT);
 }
 
 void als_disable_interrupt()
 {
+	ALSEnabled = FALSE;
 	gpio_interrupt_disable(ALS_INT);
 	als_clearint();
 }
 
-static void als_int(uint32_t token)
+static void als_work(void* opaque)
 {
 	// this is needed because there's no way to avoid repeated interrupts at the boundaries (0 and 0xFFFF)
 	static uint16_t lastData0 = 0xFFFF;
@@ -95,6 +104,16 @@ static void als_int(uint32_t token)
 	lastData0 = sensordata;
 
 	als_clearint();
+
+	if(ALSEnabled)
+		gpio_interrupt_enable(ALS_INT);
+}
+
+// The line stays low until the work clears it, so it is masked till then.
+static void als_int(uint32_t token)
+{
+	gpio_interrupt_disable(ALS_INT);
+	work_post(&ALSWork);
 }
 
 void als_setlowthreshold(uint16_t value)
@@ -112,6 +131,11 @@ uint16_t als_data()
 	return als_readw(SENSORLOW);
 }
 
+uint8_t als_data_register()
+{
+	return SENSORLOW | (1 << 6);
+}
+
 static void als_writeb(uint8_t addr, uint8_t b)
 {
 	uint8_t buf[2];
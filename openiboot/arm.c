@@ -1,6 +1,32 @@
 #include "hardware/arm.h"
 #include "arm.h"
 #include "openiboot-asmhelpers.h"
+#include "util.h"
+
+static const struct {
+	const char* name;
+	ARMPerfEvent event;
+} PerfEventNames[] = {
+	{"icache_miss", ARMPerfICacheMiss},
+	{"istall", ARMPerfInstructionStall},
+	{"dstall", ARMPerfDataStall},
+	{"itlb_miss", ARMPerfITLBMiss},
+	{"dtlb_miss", ARMPerfDTLBMiss},
+	{"branch", ARMPerfBranch},
+	{"mispredict", ARMPerfBranchMispredict},
+	{"insn", ARMPerfInstruction},
+	{"dcache_access", ARMPerfDCacheAccess},
+	{"dcache_miss", ARMPerfDCacheMiss},
+	{"writeback", ARMPerfDCacheWriteBack},
+	{"tlb_miss", ARMPerfMainTLBMiss},
+	{"external", ARMPerfExternalAccess},
+	{"lsu_stall", ARMPerfLSUStall},
+	{"wb_drain", ARMPerfWriteBufferDrain},
+	{"cycles", ARMPerfCycle}
+};
+
+static ARMPerfEvent PerfEvents[2] = {ARMPerfDCacheMiss, ARMPerfICacheMiss};
+static int PerfScopesOpen = 0;
 
 int arm_setup() {
 
@@ -43,3 +69,82 @@ void arm_disable_caches() {
 	WriteControlRegisterConfigData(ReadControlRegisterConfigData() & ~ARM11_Control_INSTRUCTIONCACHE);	// Disable instruction cache
 	WriteControlRegisterConfigData(ReadControlRegisterConfigData() & ~ARM11_Control_DATACACHE);		// Disable data cache
 }
+
+static uint32_t perf_control() {
+	return ARM11_PMNC_ENABLE
+		| ((PerfEvents[0] & ARM11_PMNC_EVENT_MASK) << ARM11_PMNC_EVENT0_SHIFT)
+		| ((PerfEvents[1] & ARM11_PMNC_EVENT_MASK) << ARM11_PMNC_EVENT1_SHIFT);
+}
+
+void arm_perf_select(ARMPerfEvent event0, ARMPerfEvent event1) {
+	PerfEvents[0] = event0;
+	PerfEvents[1] = event1;
+	WritePerformanceMonitorControl(perf_control() | ARM11_PMNC_RESETCOUNTS | ARM11_PMNC_RESETCYCLES | ARM11_PMNC_OVERFLOWS);
+}
+
+ARMPerfEvent arm_perf_event(int counter) {
+	return PerfEvents[counter];
+}
+
+const char* arm_perf_event_name(ARMPerfEvent event) {
+	int i;
+	for(i = 0; i < (sizeof(PerfEventNames) / sizeof(PerfEventNames[0])); i++) {
+		if(PerfEventNames[i].event == event)
+			return PerfEventNames[i].name;
+	}
+
+	return "unknown";
+}
+
+int arm_perf_event_find(const char* name) {
+	int i;
+	for(i = 0; i < (sizeof(PerfEventNames) / sizeof(PerfEventNames[0])); i++) {
+		if(strcmp(PerfEventNames[i].name, name) == 0)
+			return PerfEventNames[i].event;
+	}
+
+	return -1;
+}
+
+// Scopes nest: each one takes a snapshot of the free-running counters and
+// only the outermost clears the overflow flags.
+void arm_perf_begin(ARMPerfScope* scope) {
+	uint32_t control = ReadPerformanceMonitorControl();
+
+	if(!(control & ARM11_PMNC_ENABLE))
+		arm_perf_select(PerfEvents[0], PerfEvents[1]);
+	else if(PerfScopesOpen == 0)
+		WritePerformanceMonitorControl(perf_control() | ARM11_PMNC_OVERFLOWS);
+
+	PerfScopesOpen++;
+	scope->open = TRUE;
+	ReadPerformanceCounters(scope->start);
+}
+
+void arm_perf_end(ARMPerfScope* scope) {
+	uint32_t now[3];
+
+	ReadPerformanceCounters(now);
+	scope->cycles = now[0] - scope->start[0];
+	scope->events[0] = now[1] - scope->start[1];
+	scope->events[1] = now[2] - scope->start[2];
+	scope->overflowed = (ReadPerformanceMonitorControl() & ARM11_PMNC_OVERFLOWS) != 0;
+	scope->open = FALSE;
+
+	if(PerfScopesOpen > 0)
+		PerfScopesOpen--;
+}
+
+void arm_perf_add(ARMPerfScope* total, const ARMPerfScope* scope) {
+	total->cycles += scope->cycles;
+	total->events[0] += scope->events[0];
+	total->events[1] += scope->events[1];
+	total->overflowed |= scope->overflowed;
+}
+
+void arm_perf_print(const char* what, const ARMPerfScope* scope) {
+	bufferPrintf("%s: %u cycles, %u %s, %u %s%s\r\n", what, scope->cycles,
+			scope->events[0], arm_perf_event_name(PerfEvents[0]),
+			scope->events[1], arm_perf_event_name(PerfEvents[1]),
+			scope->overflowed ? " (a counter overflowed)" : "");
+}
@@ -0,0 +1,476 @@
+#include "openiboot.h"
+#include "bench.h"
+#include "util.h"
+#include "timer.h"
+#include "nand.h"
+#include "ftl.h"
+#include "arm.h"
+#include "dma.h"
+#include "openiboot-asmhelpers.h"
+#include "hardware/s5l8900.h"
+#ifndef NO_HFS
+#include "hfs/bdev.h"
+#endif
+
+// Per-operation latencies are kept for the percentiles, so this bounds the
+// number of operations in one run.
+#ifndef BENCH_MAX_OPS
+#define BENCH_MAX_OPS 2048
+#endif
+
+#define BENCH_DEPTH_MAX 8
+
+#ifndef MEMBENCH_MAX_SIZE
+#define MEMBENCH_MAX_SIZE 0x800000
+#endif
+
+// Every size moves at least this much, so the small ones are not all timer
+// resolution.
+#define MEMBENCH_TOTAL 0x1000000
+
+typedef enum BenchTarget {
+	BenchNAND,
+	BenchVFL,
+	BenchFTL,
+	BenchBDev
+} BenchTarget;
+
+typedef struct BenchRun {
+	BenchTarget target;
+	int write;
+	int random;
+	int ops;
+	int pages;
+	int depth;
+	uint32_t span;		// in pages
+	uint8_t* buffer;
+	uint8_t* spare;
+	uint16_t* banks;
+	uint32_t* bankPages;
+#ifndef NO_HFS
+	io_func* io;
+#endif
+	uint32_t* latencies;
+	int errors;
+} BenchRun;
+
+static uint32_t BenchSeed;
+
+static uint32_t bench_random() {
+	BenchSeed = BenchSeed * 1103515245 + 12345;
+	return BenchSeed >> 8;
+}
+
+// nand page index i lives on bank i % banksTotal, so consecutive indices
+// interleave across the banks the same way the VFL stripes them.
+static void bench_nand_address(uint32_t index, uint16_t* bank, uint32_t* page) {
+	NANDData* geometry = nand_get_geometry();
+	*bank = index % geometry->banksTotal;
+	*page = index / geometry->banksTotal;
+}
+
+static int bench_op(BenchRun* run, uint32_t position) {
+	NANDData* geometry = nand_get_geometry();
+	int i;
+
+	switch(run->target) {
+		case BenchNAND:
+			if(run->pages == 1) {
+				uint16_t bank;
+				uint32_t page;
+				bench_nand_address(position, &bank, &page);
+				return nand_read(bank, page, run->buffer, run->spare, TRUE, FALSE) > 1;
+			}
+
+			for(i = 0; i < run->pages; i++)
+				bench_nand_address(position + i, &run->banks[i], &run->bankPages[i]);
+
+			return nand_read_multiple(run->banks, run->bankPages, run->buffer, (SpareData*) run->spare, run->pages) > 1;
+
+		case BenchVFL:
+			for(i = 0; i < run->pages; i++) {
+				if(VFL_Read(position + i, run->buffer + (i * geometry->bytesPerPage), run->spare, TRUE, NULL) > 1)
+					return TRUE;
+			}
+			return FALSE;
+
+		case BenchFTL:
+			if(run->write)
+				return FTL_Write(position, run->pages, run->buffer) != 0;
+			else
+				return FTL_Read(position, run->pages, run->buffer) != 0;
+
+		case BenchBDev:
+#ifndef NO_HFS
+			if(run->write)
+				return !run->io->write(run->io, (off_t) position * geometry->bytesPerPage, run->pages * geometry->bytesPerPage, run->buffer);
+			else
+				return !run->io->read(run->io, (off_t) position * geometry->bytesPerPage, run->pages * geometry->bytesPerPage, run->buffer);
+#else
+			return TRUE;
+#endif
+	}
+
+	return TRUE;
+}
+
+static uint32_t bench_position(BenchRun* run, int op) {
+	uint32_t last = run->span - run->pages;
+	if(run->random)
+		return bench_random() % (last + 1);
+	else
+		return ((uint32_t) op * run->pages) % (last + 1);
+}
+
+// Single page nand reads kept depth deep through the request queue.
+static void bench_nand_queued(BenchRun* run) {
+	NANDData* geometry = nand_get_geometry();
+	NANDRequest requests[BENCH_DEPTH_MAX];
+	uint64_t started[BENCH_DEPTH_MAX];
+	int submitted = 0;
+	int completed = 0;
+
+	memset(requests, 0, sizeof(requests));
+
+	while(completed < run->ops) {
+		if(submitted < run->ops && (submitted - completed) < run->depth) {
+			NANDRequest* request = &requests[submitted % run->depth];
+			uint16_t bank;
+			uint32_t page;
+			bench_nand_address(bench_position(run, submitted), &bank, &page);
+			request->operation = NANDOperationRead;
+			request->bank = bank;
+			request->page = page;
+			request->buffer = run->buffer + ((submitted % run->depth) * geometry->bytesPerPage);
+			request->spare = run->spare + ((submitted % run->depth) * geometry->bytesPerSpare);
+			request->doECC = TRUE;
+			started[submitted % run->depth] = timer_get_system_microtime();
+			nand_submit(request);
+			submitted++;
+			continue;
+		}
+
+		int slot = completed % run->depth;
+		if(nand_wait(&requests[slot]) > 1)
+			run->errors++;
+
+		run->latencies[completed] = timer_get_system_microtime() - started[slot];
+		completed++;
+	}
+}
+
+static void bench_sort(uint32_t* values, int count) {
+	int i;
+	for(i = 1; i < count; i++) {
+		uint32_t value = values[i];
+		int j = i - 1;
+		while(j >= 0 && values[j] > value) {
+			values[j + 1] = values[j];
+			j--;
+		}
+		values[j + 1] = value;
+	}
+}
+
+static void bench_report(BenchRun* run, uint64_t elapsed) {
+	NANDData* geometry = nand_get_geometry();
+	uint64_t bytes = (uint64_t) run->ops * run->pages * geometry->bytesPerPage;
+
+	if(elapsed == 0)
+		elapsed = 1;
+
+	uint32_t kbps = (uint32_t)((bytes * 1000000 / elapsed) / 1024);
+	uint32_t iops = (uint32_t)((uint64_t) run->ops * 1000000 / elapsed);
+
+	bench_sort(run->latencies, run->ops);
+
+	bufferPrintf("bench: %d ops, %d bytes each, in %d ms, %d errors\r\n", run->ops, run->pages * geometry->bytesPerPage, (uint32_t)(elapsed / 1000), run->errors);
+	bufferPrintf("bench: %d.%02d MB/s, %d IOPS\r\n", kbps / 1024, ((kbps % 1024) * 100) / 1024, iops);
+	bufferPrintf("bench: latency (us) min %d, p50 %d, p90 %d, p99 %d, max %d\r\n",
+			run->latencies[0],
+			run->latencies[(run->ops * 50) / 100],
+			run->latencies[(run->ops * 90) / 100],
+			run->latencies[(run->ops * 99) / 100],
+			run->latencies[run->ops - 1]);
+}
+
+static void bench_usage(const char* name) {
+	bufferPrintf("Usage: %s <nand|vfl|ftl|bdev[partition]> <seqread|randread|seqwrite|randwrite> [ops] [pages per op] [queue depth]\r\n", name);
+	bufferPrintf("\tWrites are only done on ftl and bdev, by writing back what was just read.\r\n");
+	bufferPrintf("\tQueue depth applies to single page nand reads, up to %d.\r\n", BENCH_DEPTH_MAX);
+}
+
+void cmd_bench(int argc, char** argv) {
+	BenchRun run;
+	int i;
+
+	if(argc < 3) {
+		bench_usage(argv[0]);
+		return;
+	}
+
+	if(!HasNANDInit) {
+		bufferPrintf("bench: NAND is not available.\r\n");
+		return;
+	}
+
+	memset(&run, 0, sizeof(run));
+	NANDData* geometry = nand_get_geometry();
+
+	if(strcmp(argv[1], "nand") == 0) {
+		run.target = BenchNAND;
+		run.span = geometry->pagesTotal;
+	} else if(strcmp(argv[1], "vfl") == 0) {
+		run.target = BenchVFL;
+		run.span = geometry->userPagesTotal;
+	} else if(strcmp(argv[1], "ftl") == 0) {
+		run.target = BenchFTL;
+		// FTL_Read rejects a range that reaches the last page
+		run.span = geometry->userPagesTotal - 1;
+	} else if(strlen(argv[1]) >= 4 && memcmp(argv[1], "bdev", 4) == 0) {
+#ifndef NO_HFS
+		int partition = (argv[1][4] != '\0') ? parseNumber(argv[1] + 4) : 0;
+		if(!HasBDevInit || partition < 0 || partition > 3 || (run.io = bdev_open(partition)) == NULL) {
+			bufferPrintf("bench: no such partition.\r\n");
+			return;
+		}
+		run.target = BenchBDev;
+		run.span = ((uint64_t) ((MBRPartitionRecord*) run.io->data)->numSectors * 512) / geometry->bytesPerPage;
+#else
+		bufferPrintf("bench: no block device support in this build.\r\n");
+		return;
+#endif
+	} else {
+		bench_usage(argv[0]);
+		return;
+	}
+
+	if(strcmp(argv[2], "seqread") == 0) {
+	} else if(strcmp(argv[2], "randread") == 0) {
+		run.random = TRUE;
+	} else if(strcmp(argv[2], "seqwrite") == 0) {
+		run.write = TRUE;
+	} else if(strcmp(argv[2], "randwrite") == 0) {
+		run.random = TRUE;
+		run.write = TRUE;
+	} else {
+		bench_usage(argv[0]);
+		goto out;
+	}
+
+	run.ops = (argc >= 4) ? parseNumber(argv[3]) : 256;
+	run.pages = (argc >= 5) ? parseNumber(argv[4]) : 1;
+	run.depth = (argc >= 6) ? parseNumber(argv[5]) : 1;
+
+	if(run.write && (run.target == BenchNAND || run.target == BenchVFL)) {
+		bufferPrintf("bench: writes are only supported on ftl and bdev.\r\n");
+		goto out;
+	}
+
+	if(run.ops <= 0 || run.ops > BENCH_MAX_OPS || run.pages <= 0 || run.pages > geometry->pagesPerSuBlk || run.pages > run.span
+			|| run.depth <= 0 || run.depth > BENCH_DEPTH_MAX || (run.depth > 1 && (run.target != BenchNAND || run.pages != 1 || run.write))) {
+		bufferPrintf("bench: bad parameters, at most %d ops of up to %d pages.\r\n", BENCH_MAX_OPS, geometry->pagesPerSuBlk);
+		goto out;
+	}
+
+	int bufferPages = (run.pages > run.depth) ? run.pages : run.depth;
+	run.buffer = memalign(DMA_ALIGN, bufferPages * geometry->bytesPerPage);
+	run.spare = malloc(bufferPages * ((geometry->bytesPerSpare > sizeof(SpareData)) ? geometry->bytesPerSpare : sizeof(SpareData)));
+	run.banks = malloc(run.pages * sizeof(uint16_t));
+	run.bankPages = malloc(run.pages * sizeof(uint32_t));
+	run.latencies = malloc(run.ops * sizeof(uint32_t));
+	if(!run.buffer || !run.spare || !run.banks || !run.bankPages || !run.latencies) {
+		bufferPrintf("bench: out of memory.\r\n");
+		goto out;
+	}
+
+	BenchSeed = (uint32_t) timer_get_system_microtime();
+
+	bufferPrintf("bench: %s %s, %d ops of %d pages at queue depth %d\r\n", argv[1], argv[2], run.ops, run.pages, run.depth);
+
+	// only what is timed is counted
+	ARMPerfScope perf;
+	ARMPerfScope total;
+	memset(&total, 0, sizeof(total));
+
+	uint64_t elapsed = 0;
+	if(run.depth > 1) {
+		uint64_t start = timer_get_system_microtime();
+		ARM_PERF_MEASURE(&total) {
+			bench_nand_queued(&run);
+		}
+		elapsed = timer_get_system_microtime() - start;
+	} else {
+		for(i = 0; i < run.ops; i++) {
+			if(command_cancelled()) {
+				run.ops = i;
+				break;
+			}
+
+			uint32_t position = bench_position(&run, i);
+
+			// writes put back what is already there, so they fetch it first, untimed
+			if(run.write) {
+				run.write = FALSE;
+				int failed = bench_op(&run, position);
+				run.write = TRUE;
+				if(failed) {
+					run.errors++;
+					run.latencies[i] = 0;
+					continue;
+				}
+			}
+
+			uint64_t start = timer_get_system_microtime();
+			arm_perf_begin(&perf);
+			if(bench_op(&run, position))
+				run.errors++;
+			arm_perf_end(&perf);
+			run.latencies[i] = timer_get_system_microtime() - start;
+			elapsed += run.latencies[i];
+			arm_perf_add(&total, &perf);
+		}
+	}
+
+	// cancelled before anything was timed
+	if(run.ops == 0)
+		goto out;
+
+	bench_report(&run, elapsed);
+	arm_perf_print("bench", &total);
+
+out:
+#ifndef NO_HFS
+	if(run.io)
+		run.io->close(run.io);
+#endif
+	free(run.buffer);
+	free(run.spare);
+	free(run.banks);
+	free(run.bankPages);
+	free(run.latencies);
+}
+
+typedef enum MemBenchOp {
+	MemBenchCopy,
+	MemBenchFill,
+	MemBenchRead,
+	MemBenchDMA
+} MemBenchOp;
+
+static uint32_t membench_read(const uint32_t* data, uint32_t size) {
+	register const uint32_t* p = data;
+	register const uint32_t* end = data + (size / sizeof(uint32_t));
+	register uint32_t sum = 0;
+
+	while(p < end) {
+		sum += p[0] + p[1] + p[2] + p[3];
+		p += 4;
+	}
+
+	return sum;
+}
+
+// MB/s with one decimal place, times ten, or 0 if it could not be done
+static uint32_t membench_run(MemBenchOp op, uint8_t* dst, uint8_t* src, uint32_t size) {
+	uint32_t iterations = (MEMBENCH_TOTAL / size) ? (MEMBENCH_TOTAL / size) : 1;
+	volatile uint32_t sum = 0;
+	int controller;
+	int channel;
+	uint32_t i;
+
+	uint64_t start = timer_get_system_microtime();
+	for(i = 0; i < iterations; i++) {
+		switch(op) {
+			case MemBenchCopy:
+				memcpy(dst, src, size);
+				break;
+			case MemBenchFill:
+				memset(dst, i, size);
+				break;
+			case MemBenchRead:
+				sum += membench_read((uint32_t*) src, size);
+				break;
+			case MemBenchDMA:
+				if(dma_memcpy_async(dst, src, size, NULL, &controller, &channel) != 0
+						|| dma_finish(controller, channel, 500 + (size >> 11)) != 0)
+					return 0;
+				break;
+		}
+	}
+	uint64_t elapsed = timer_get_system_microtime() - start;
+
+	if(elapsed == 0)
+		elapsed = 1;
+
+	return (uint32_t)(((uint64_t)size * iterations * 10) / elapsed);
+}
+
+static void membench_print_rate(uint32_t rate) {
+	if(rate == 0)
+		bufferPrintf("       -");
+	else
+		bufferPrintf(" %5d.%d", rate / 10, rate % 10);
+}
+
+// The uncached runs go through the alias of the same RAM that mmu.c maps at
+// MemoryHigher. The DMA controller only sees the real addresses, so DMA runs
+// in the cached region only, and includes the cache maintenance it needs.
+void cmd_membench(int argc, char** argv) {
+	uint32_t maxSize = (argc >= 2) ? parseNumber(argv[1]) : MEMBENCH_MAX_SIZE;
+	uint32_t minSize = (argc >= 3) ? parseNumber(argv[2]) : 1024;
+	uint8_t* src = NULL;
+	uint8_t* dst = NULL;
+	uint32_t size;
+	int uncached;
+
+	if(minSize < 64 || maxSize < minSize) {
+		bufferPrintf("Usage: %s [max size] [min size]\r\n", argv[0]);
+		return;
+	}
+
+	// take what the heap can give
+	while(maxSize >= minSize) {
+		src = memalign(DMA_ALIGN, maxSize);
+		dst = memalign(DMA_ALIGN, maxSize);
+		if(src && dst)
+			break;
+
+		free(src);
+		free(dst);
+		src = dst = NULL;
+		maxSize /= 2;
+	}
+
+	if(!src) {
+		bufferPrintf("membench: out of memory\r\n");
+		return;
+	}
+
+	memset(src, 0x5A, maxSize);
+	memset(dst, 0xA5, maxSize);
+
+	for(uncached = 0; uncached < 2; uncached++) {
+		uint8_t* s = uncached ? (src + MemoryHigher) : src;
+		uint8_t* d = uncached ? (dst + MemoryHigher) : dst;
+
+		// what is left in the cache is RAM's business now
+		if(uncached)
+			CleanAndInvalidateCPUDataCache();
+
+		bufferPrintf("membench: %s, MB/s\r\n", uncached ? "uncached" : "cached");
+		bufferPrintf("     size   memcpy   memset     read      dma\r\n");
+
+		for(size = minSize; size <= maxSize && size != 0; size *= 2) {
+			bufferPrintf(" %8d", size);
+			membench_print_rate(membench_run(MemBenchCopy, d, s, size));
+			membench_print_rate(membench_run(MemBenchFill, d, s, size));
+			membench_print_rate(membench_run(MemBenchRead, d, s, size));
+			membench_print_rate(uncached ? 0 : membench_run(MemBenchDMA, d, s, size));
+			bufferPrintf("\r\n");
+		}
+	}
+
+	free(src);
+	free(dst);
+}
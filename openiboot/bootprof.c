@@ -0,0 +1,72 @@
+#include "openiboot.h"
+#include "bootprof.h"
+#include "timer.h"
+#include "util.h"
+
+static BootProfileEntry Profile[BOOTPROF_ENTRIES];
+static uint32_t ProfileNext = 0;
+static uint32_t ProfileTotal = 0;
+
+static const char* KindNames[] = {"", "begin ", "end "};
+
+void bootprof_record(BootProfileKind kind, const char* name, uint32_t arg) {
+	BootProfileEntry* entry = &Profile[ProfileNext];
+	int i;
+
+	entry->timestamp = (uint32_t) timer_get_system_microtime();
+	entry->arg = arg;
+	entry->kind = kind;
+	for(i = 0; i < BOOTPROF_NAME_LEN && name[i] != '\0'; i++)
+		entry->name[i] = name[i];
+	for(; i < BOOTPROF_NAME_LEN; i++)
+		entry->name[i] = '\0';
+
+	ProfileNext = (ProfileNext + 1) % BOOTPROF_ENTRIES;
+	ProfileTotal++;
+}
+
+int bootprof_count() {
+	return (ProfileTotal > BOOTPROF_ENTRIES) ? BOOTPROF_ENTRIES : ProfileTotal;
+}
+
+uint32_t bootprof_dropped() {
+	return (ProfileTotal > BOOTPROF_ENTRIES) ? (ProfileTotal - BOOTPROF_ENTRIES) : 0;
+}
+
+int bootprof_read(BootProfileEntry* entries, int maxEntries) {
+	int held = bootprof_count();
+	uint32_t first;
+	int i;
+
+	if(maxEntries > held)
+		maxEntries = held;
+
+	// the newest ones are the ones worth keeping
+	first = (ProfileNext + BOOTPROF_ENTRIES - maxEntries) % BOOTPROF_ENTRIES;
+	for(i = 0; i < maxEntries; i++)
+		memcpy(&entries[i], &Profile[(first + i) % BOOTPROF_ENTRIES], sizeof(BootProfileEntry));
+
+	return maxEntries;
+}
+
+void bootprof_print() {
+	int held = bootprof_count();
+	uint32_t first = (ProfileNext + BOOTPROF_ENTRIES - held) % BOOTPROF_ENTRIES;
+	uint32_t last = 0;
+	char name[BOOTPROF_NAME_LEN + 1];
+	int i;
+
+	if(bootprof_dropped() > 0)
+		bufferPrintf("(%d older records dropped)\r\n", bootprof_dropped());
+
+	for(i = 0; i < held; i++) {
+		BootProfileEntry* entry = &Profile[(first + i) % BOOTPROF_ENTRIES];
+
+		memcpy(name, entry->name, BOOTPROF_NAME_LEN);
+		name[BOOTPROF_NAME_LEN] = '\0';
+
+		bufferPrintf("%d.%03d ms (+%d us): %s%s %d\r\n", entry->timestamp / 1000, entry->timestamp % 1000,
+				(i == 0) ? 0 : (entry->timestamp - last), KindNames[entry->kind], name, entry->arg);
+		last = entry->timestamp;
+	}
+}
@@ -1,8 +1,47 @@
 #include "openiboot.h"
+#include "openiboot-asmhelpers.h"
 #include "buttons.h"
 #include "hardware/buttons.h"
 #include "pmu.h"
 #include "gpio.h"
+#include "event.h"
+#include "tasks.h"
+#include "timer.h"
+
+// Each button interrupts on both edges: its GPIO interrupt is level
+// triggered and flips to the other level every time it fires. A pin is only
+// sampled once it has been quiet for BUTTONS_DEBOUNCE, and each change of
+// the settled state goes into a queue for buttons_wait_event.
+
+typedef struct Button {
+	int pin;
+	uint32_t irq;
+	int type;
+	int activeLevel;
+	int autoflip;
+	int pushed;
+	uint64_t edgeTime;
+	Event settle;
+} Button;
+
+#define BUTTON(name) {BUTTONS_##name, BUTTONS_##name##_IRQ, BUTTONS_##name##_IRQTYPE, BUTTONS_##name##_IRQLEVEL, BUTTONS_##name##_IRQAUTOFLIP}
+
+static Button Buttons[] = {
+	BUTTON(HOME),
+	BUTTON(HOLD),
+#ifndef CONFIG_IPOD
+	BUTTON(VOLUP),
+	BUTTON(VOLDOWN),
+#endif
+};
+
+#define BUTTONS_COUNT (sizeof(Buttons) / sizeof(Button))
+
+static ButtonEvent ButtonsQueue[BUTTONS_QUEUE];
+static volatile uint32_t ButtonsHead = 0;
+static volatile uint32_t ButtonsTail = 0;
+static Completion ButtonsWake;
+static int ButtonsHasInit = FALSE;
 
 int buttons_is_pushed(int which) {
 	if(gpio_pin_state(which) && pmu_get_reg(BUTTONS_IIC_STATE))
@@ -10,3 +49,84 @@ int buttons_is_pushed(int which) {
 	else
 		return FALSE;
 }
+
+static void buttons_settle(Event* event, void* opaque) {
+	Button* button = (Button*) opaque;
+	int pushed = (gpio_pin_state(button->pin) == button->activeLevel);
+
+	if(pushed == button->pushed)
+		return;
+
+	button->pushed = pushed;
+
+	// when full, the newest events are the ones dropped
+	if((ButtonsTail - ButtonsHead) >= BUTTONS_QUEUE)
+		return;
+
+	ButtonEvent* queued = &ButtonsQueue[ButtonsTail % BUTTONS_QUEUE];
+	queued->button = button->pin;
+	queued->pushed = pushed;
+	queued->time = button->edgeTime;
+	ButtonsTail++;
+
+	completion_signal(&ButtonsWake);
+}
+
+static void buttons_irq(uint32_t token) {
+	Button* button = &Buttons[token];
+
+	// only the first edge of a bounce counts for the time
+	if(button->settle.heapIndex == 0)
+		button->edgeTime = timer_get_system_microtime();
+
+	event_add(&button->settle, BUTTONS_DEBOUNCE, buttons_settle, button);
+}
+
+int buttons_setup() {
+	int i;
+
+	if(ButtonsHasInit)
+		return 0;
+
+	completion_init(&ButtonsWake);
+
+	for(i = 0; i < BUTTONS_COUNT; i++) {
+		Button* button = &Buttons[i];
+		int level = gpio_pin_state(button->pin);
+
+		button->pushed = (level == button->activeLevel);
+
+		// the first interrupt comes with the first change from how it is now
+		gpio_register_interrupt(button->irq, button->type, !level, button->autoflip, buttons_irq, i);
+		gpio_interrupt_enable(button->irq);
+	}
+
+	ButtonsHasInit = TRUE;
+
+	return 0;
+}
+
+int buttons_wait_event(ButtonEvent* event, uint32_t timeout) {
+	EnterCriticalSection();
+	while(ButtonsHead == ButtonsTail) {
+		completion_init(&ButtonsWake);
+		LeaveCriticalSection();
+
+		if(completion_wait(&ButtonsWake, timeout) != 0)
+			return FALSE;
+
+		EnterCriticalSection();
+	}
+
+	*event = ButtonsQueue[ButtonsHead % BUTTONS_QUEUE];
+	ButtonsHead++;
+	LeaveCriticalSection();
+
+	return TRUE;
+}
+
+void buttons_flush() {
+	EnterCriticalSection();
+	ButtonsHead = ButtonsTail;
+	LeaveCriticalSection();
+}
@@ -6,8 +6,6 @@
 #include <i2c.h>
 #include <util.h>
 
-static uint16_t camera_readw(uint16_t addr);
-
 int camera_setup() {
 	gpio_custom_io(CAMERA_GPIO_CLOCK_ENABLE, 0x02);
 	gpio_pin_output(CAMERA_GPIO_POWER_ON, 1);
@@ -22,7 +20,7 @@ int camera_setup() {
 	
 	udelay(1000);
 
-	uint16_t modelID = camera_readw(0x3000);
+	uint16_t modelID = camera_readw(CAMERA_MODEL_ID);
 
 
 	if(modelID != 0x1580)
@@ -36,7 +34,7 @@ int camera_setup() {
 	return 0;
 }
 
-static uint16_t camera_readw(uint16_t addr)
+uint16_t camera_readw(uint16_t addr)
 {
 	uint8_t registers[2];
 	uint8_t buffer[2];
@@ -46,7 +44,40 @@ static uint16_t camera_readw(uint16_t addr)
 	buffer[0] = 0xDE;
 	buffer[1] = 0xAD;
 
-	i2c_rx(1, CAMERA_ADDR, registers, 2, buffer, 2);
+	i2c_rx(CAMERA_I2C, CAMERA_ADDR, registers, 2, buffer, 2);
 
 	return (buffer[0] << 8) | buffer[1];
 }
+
+// queued, like the codec's writes, so a long table goes out back to back
+void camera_writew(uint16_t addr, uint16_t value)
+{
+	uint8_t buffer[4];
+
+	buffer[0] = (addr >> 8) & 0xFF;
+	buffer[1] = addr & 0xFF;
+	buffer[2] = (value >> 8) & 0xFF;
+	buffer[3] = value & 0xFF;
+
+	i2c_tx_queued(CAMERA_I2C, CAMERA_ADDR, buffer, sizeof(buffer));
+}
+
+void camera_write_regs(const CameraRegister* regs, int count)
+{
+	int i;
+
+	for(i = 0; i < count; i++)
+	{
+		if(regs[i].addr == CAMERA_DELAY)
+		{
+			// the sensor has to have seen everything before it, first
+			i2c_flush(CAMERA_I2C);
+			udelay(regs[i].value * 1000);
+			continue;
+		}
+
+		camera_writew(regs[i].addr, regs[i].value);
+	}
+
+	i2c_flush(CAMERA_I2C);
+}
@@ -0,0 +1,705 @@
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <math.h>
+#include <libusb-1.0/libusb.h>
+#include <sys/time.h>
+
+// Boot performance of an openiboot build, and how it compares to another.
+//
+//	bootbench run <openiboot.img3> <runs> <results> [commands]
+//
+// uploads the build with loadibec each run, waits for it to come up, then
+// runs linux_load, bootprof, latency and a few benches on it, and the
+// USB benches usbbench has. The numbers go to results, one "name value" per
+// line, and "reboot" takes the device back to recovery mode for the next
+// run, so iBoot must not be set to auto-boot. A commands file, one device
+// command per line, replaces the default list; its output is parsed the same
+// way. LOADIBEC picks the loadibec to run.
+//
+//	bootbench compare <old results> <new results> [threshold %]
+//
+// prints the median of each number for both, and flags those that moved the
+// wrong way by more than the threshold (5% unless given) and by more than the
+// spread between runs. oibc must not be running.
+
+#define USB_APPLE_ID 0x05AC
+#define USB_RECOVERY 0x1281
+
+#define OPENIBOOTCMD_DUMPBUFFER 0
+#define OPENIBOOTCMD_DUMPBUFFER_LEN 1
+#define OPENIBOOTCMD_DUMPBUFFER_GOAHEAD 2
+#define OPENIBOOTCMD_NOTIFY 7
+#define OPENIBOOTCMD_BENCH_COUNT 12
+#define OPENIBOOTCMD_BENCH_SINK 13
+#define OPENIBOOTCMD_BENCH_SOURCE 14
+#define OPENIBOOTCMD_BENCH_GOAHEAD 16
+#define OPENIBOOTCMD_BENCH_DONE 17
+#define OPENIBOOTCMD_SENDBATCH 18
+#define OPENIBOOTCMD_SENDBATCH_GOAHEAD 19
+
+#define USBBENCH_MAX_TRANSFER 0x10000
+
+// how long a build gets to show up, and each command to finish, in seconds
+#define BOOT_TIMEOUT 60
+#define COMMAND_TIMEOUT 300
+
+#define MAX_COMMANDS 64
+#define MAX_METRICS 512
+#define MAX_RUNS 64
+
+typedef struct OpenIBootCmd {
+	uint32_t command;
+	uint32_t dataLen;
+}  __attribute__ ((__packed__)) OpenIBootCmd;
+
+typedef struct Metric {
+	char name[64];
+	double values[MAX_RUNS];
+	int count;
+} Metric;
+
+static const char* DefaultCommands[] = {
+	"linux_load",
+	"bootprof",
+	"latency",
+	"bench nand seqread 256 1",
+	"bench nand randread 256 1",
+	"bench nand randread 256 1 8",
+	"bench ftl seqread 64 8",
+	"bench ftl randread 256 1",
+	NULL
+};
+
+libusb_device_handle* device;
+
+long long now() {
+	struct timeval tv;
+	gettimeofday(&tv, NULL);
+	return tv.tv_sec * 1000000LL + tv.tv_usec;
+}
+
+int sendCommand(uint32_t command, uint32_t dataLen) {
+	OpenIBootCmd cmd;
+	int transferred;
+
+	cmd.command = command;
+	cmd.dataLen = dataLen;
+	return libusb_interrupt_transfer(device, 4, (unsigned char*) &cmd, sizeof(cmd), &transferred, 1000);
+}
+
+// skips the console notifications that may be queued in front of it
+int readReply(uint32_t command, OpenIBootCmd* cmd, int timeout) {
+	int transferred;
+
+	while(1) {
+		if(libusb_interrupt_transfer(device, 0x83, (unsigned char*) cmd, sizeof(OpenIBootCmd), &transferred, timeout) != 0)
+			return -1;
+
+		if(transferred == sizeof(OpenIBootCmd) && cmd->command == command)
+			return 0;
+	}
+}
+
+int openOpenIBoot() {
+	libusb_device** devices;
+	libusb_device* dev = NULL;
+	ssize_t count = libusb_get_device_list(NULL, &devices);
+	int interface = 0;
+	ssize_t d;
+	int i;
+	int a;
+
+	for(d = 0; d < count && !dev; d++) {
+		struct libusb_device_descriptor descriptor;
+		struct libusb_config_descriptor* config;
+
+		if(libusb_get_device_descriptor(devices[d], &descriptor) != 0)
+			continue;
+
+		if (descriptor.idVendor != 0x0525 || descriptor.idProduct != 0x1280)
+			continue;
+
+		if(libusb_get_config_descriptor(devices[d], 0, &config) != 0)
+			continue;
+
+		for (i = 0; i < config->bNumInterfaces && !dev; i++) {
+			for (a = 0; a < config->interface[i].num_altsetting; a++) {
+				if(config->interface[i].altsetting[a].bInterfaceClass == 0xFF
+					&& config->interface[i].altsetting[a].bInterfaceSubClass == 0xFF
+					&& config->interface[i].altsetting[a].bInterfaceProtocol == 0x51) {
+					dev = devices[d];
+					interface = i;
+					break;
+				}
+			}
+		}
+
+		libusb_free_config_descriptor(config);
+	}
+
+	if(dev && libusb_open(dev, &device) != 0)
+		dev = NULL;
+
+	libusb_free_device_list(devices, 1);
+
+	if(!dev)
+		return -1;
+
+	if(libusb_claim_interface(device, interface) != 0) {
+		libusb_close(device);
+		return -1;
+	}
+
+	return 0;
+}
+
+int recoveryPresent() {
+	libusb_device_handle* handle = libusb_open_device_with_vid_pid(NULL, USB_APPLE_ID, USB_RECOVERY);
+	if(handle == NULL)
+		return 0;
+
+	libusb_close(handle);
+	return 1;
+}
+
+// Appends whatever the console has to output, and returns how much that was.
+int drainConsole(char** output, size_t* outputLen) {
+	OpenIBootCmd cmd;
+	int total = 0;
+	int transferred;
+
+	while(1) {
+		if(sendCommand(OPENIBOOTCMD_DUMPBUFFER, 0) != 0 || readReply(OPENIBOOTCMD_DUMPBUFFER_LEN, &cmd, 1000) != 0)
+			return -1;
+
+		if(cmd.dataLen == 0)
+			return total;
+
+		*output = realloc(*output, *outputLen + cmd.dataLen + 1);
+
+		int len = cmd.dataLen;
+		if(sendCommand(OPENIBOOTCMD_DUMPBUFFER_GOAHEAD, len) != 0)
+			return -1;
+
+		int read = 0;
+		while(read < len) {
+			if(libusb_bulk_transfer(device, 0x81, (unsigned char*) *output + *outputLen + read, len - read, &transferred, 5000) != 0)
+				return -1;
+			read += transferred;
+		}
+
+		*outputLen += len;
+		(*output)[*outputLen] = '\0';
+		total += len;
+	}
+}
+
+// Queues text as a batch and returns the number of its first command, or 0.
+uint32_t sendBatch(const char* text, size_t len) {
+	OpenIBootCmd cmd;
+	int transferred;
+
+	if(sendCommand(OPENIBOOTCMD_SENDBATCH, len) != 0 || readReply(OPENIBOOTCMD_SENDBATCH_GOAHEAD, &cmd, 1000) != 0 || cmd.dataLen == 0)
+		return 0;
+
+	if(libusb_bulk_transfer(device, 2, (unsigned char*) text, len, &transferred, 5000) != 0 || transferred != len)
+		return 0;
+
+	return cmd.dataLen;
+}
+
+// Runs a command as a batch of one and collects its output, up to the line
+// saying the batch is done. Returns NULL if the device did not answer.
+char* runCommand(const char* command) {
+	char* output = NULL;
+	size_t outputLen = 0;
+	char done[32];
+	uint32_t number;
+	size_t len = strlen(command);
+	char* line = malloc(len + 1);
+
+	memcpy(line, command, len);
+	line[len] = '\n';
+
+	// what the console had before is not part of it
+	if(drainConsole(&output, &outputLen) < 0)
+		goto fail;
+
+	outputLen = 0;
+	if(output)
+		output[0] = '\0';
+
+	number = sendBatch(line, len + 1);
+	if(number == 0)
+		goto fail;
+
+	sprintf(done, "batch: %u done", number);
+
+	long long deadline = now() + COMMAND_TIMEOUT * 1000000LL;
+	while(output == NULL || strstr(output, done) == NULL) {
+		int got = drainConsole(&output, &outputLen);
+		if(got < 0 || now() > deadline)
+			goto fail;
+
+		if(got == 0)
+			usleep(10000);
+	}
+
+	free(line);
+	return output;
+
+fail:
+	free(line);
+	free(output);
+	return NULL;
+}
+
+// Like usbbench, as megabytes a second.
+double usbBench(uint32_t mode) {
+	int size = USBBENCH_MAX_TRANSFER;
+	int count = 256;
+	unsigned char* buffer = malloc(size);
+	OpenIBootCmd reply;
+	int transferred;
+	int i;
+
+	memset(buffer, 0x5A, size);
+
+	if(sendCommand(OPENIBOOTCMD_BENCH_COUNT, count) != 0 || sendCommand(mode, size) != 0
+			|| readReply(OPENIBOOTCMD_BENCH_GOAHEAD, &reply, 1000) != 0 || reply.dataLen != size) {
+		free(buffer);
+		return -1;
+	}
+
+	long long start = now();
+	for(i = 0; i < count; i++) {
+		int ret = libusb_bulk_transfer(device, (mode == OPENIBOOTCMD_BENCH_SINK) ? 2 : 0x81, buffer, size, &transferred, 5000);
+		if(ret != 0 || transferred != size) {
+			free(buffer);
+			return -1;
+		}
+	}
+	long long elapsed = now() - start;
+
+	free(buffer);
+
+	if(readReply(OPENIBOOTCMD_BENCH_DONE, &reply, 5000) != 0)
+		return -1;
+
+	if(elapsed <= 0)
+		elapsed = 1;
+
+	return (double) size * count / elapsed;
+}
+
+void putMetric(FILE* results, const char* name, double value) {
+	char clean[64];
+	int i;
+
+	for(i = 0; name[i] != '\0' && i < (sizeof(clean) - 1); i++)
+		clean[i] = (name[i] == ' ') ? '_' : name[i];
+	clean[i] = '\0';
+
+	fprintf(results, "%s %.3f\n", clean, value);
+}
+
+// The upper end of the histogram bucket the 90th percentile falls in.
+void putLatencyP90(FILE* results, const char* operation, uint32_t* bounds, uint32_t* counts, int buckets) {
+	char name[64];
+	uint32_t total = 0;
+	uint32_t seen = 0;
+	int i;
+
+	for(i = 0; i < buckets; i++)
+		total += counts[i];
+
+	for(i = 0; i < buckets; i++) {
+		seen += counts[i];
+		if(seen * 10 >= total * 9)
+			break;
+	}
+
+	if(i < buckets) {
+		snprintf(name, sizeof(name), "latency.%s.p90_us", operation);
+		putMetric(results, name, bounds[i]);
+	}
+}
+
+// Picks the numbers out of console output. The formats are those of
+// bootprof_print, latency_print and bench_report on the device.
+void parseOutput(FILE* results, char* output) {
+	char* line = output;
+	char name[64];
+	char bench[64] = "";
+	char operation[32] = "";
+	uint32_t bounds[32];
+	uint32_t counts[32];
+	int buckets = 0;
+	double console = -1;
+	double loadBegin = -1;
+	double loadEnd = -1;
+
+	while(line && *line) {
+		char* eol = strchr(line, '\n');
+		if(eol)
+			*eol = '\0';
+
+		int ms, us, skip, a, b, c, d, e;
+		unsigned int bound, count;
+		char text[32];
+		char word[32];
+
+		if(sscanf(line, "%d.%d ms (+%d us): %n", &ms, &us, &skip, &a) == 3) {
+			double at = ms + us / 1000.0;
+			char* record = line + a;
+			char* last = strrchr(record, ' ');
+			int kind = 0;
+
+			if(last)
+				*last = '\0';
+
+			if(strncmp(record, "begin ", 6) == 0) {
+				kind = 1;
+				record += 6;
+			} else if(strncmp(record, "end ", 4) == 0) {
+				kind = 2;
+				record += 4;
+			}
+
+			if(kind == 0) {
+				snprintf(name, sizeof(name), "boot.%s_ms", record);
+				putMetric(results, name, at);
+			} else if(kind == 2) {
+				snprintf(name, sizeof(name), "boot.%s.end_ms", record);
+				putMetric(results, name, at);
+			}
+
+			if(kind == 0 && strcmp(record, "console") == 0)
+				console = at;
+			else if(kind == 1 && strcmp(record, "load linux") == 0)
+				loadBegin = at;
+			else if(kind == 2 && strcmp(record, "load linux") == 0)
+				loadEnd = at;
+		} else if(sscanf(line, "%31[^:]: %d calls, average %d us, max %d us", text, &a, &b, &c) == 4) {
+			if(operation[0] != '\0')
+				putLatencyP90(results, operation, bounds, counts, buckets);
+
+			strcpy(operation, text);
+			buckets = 0;
+
+			snprintf(name, sizeof(name), "latency.%s.avg_us", operation);
+			putMetric(results, name, b);
+			snprintf(name, sizeof(name), "latency.%s.max_us", operation);
+			putMetric(results, name, c);
+		} else if(buckets < 32 && (sscanf(line, "\t< %u us: %u", &bound, &count) == 2 || sscanf(line, "\t>= %u us: %u", &bound, &count) == 2)) {
+			bounds[buckets] = bound;
+			counts[buckets] = count;
+			buckets++;
+		} else if(sscanf(line, "bench: %31s %31[^,], %d ops of %d pages at queue depth %d", text, word, &a, &b, &c) == 5) {
+			snprintf(bench, sizeof(bench), "bench.%s.%s.%dp_q%d", text, word, b, c);
+		} else if(bench[0] != '\0' && sscanf(line, "bench: %d.%d MB/s, %d IOPS", &a, &b, &c) == 3) {
+			snprintf(name, sizeof(name), "%s.mbps", bench);
+			putMetric(results, name, a + b / 100.0);
+			snprintf(name, sizeof(name), "%s.iops", bench);
+			putMetric(results, name, c);
+		} else if(bench[0] != '\0' && sscanf(line, "bench: latency (us) min %d, p50 %d, p90 %d, p99 %d, max %d", &a, &b, &c, &d, &e) == 5) {
+			snprintf(name, sizeof(name), "%s.p50_us", bench);
+			putMetric(results, name, b);
+			snprintf(name, sizeof(name), "%s.p99_us", bench);
+			putMetric(results, name, d);
+		}
+
+		line = eol ? (eol + 1) : NULL;
+	}
+
+	if(operation[0] != '\0')
+		putLatencyP90(results, operation, bounds, counts, buckets);
+
+	// the console comes up, then the kernel and initrd are read
+	if(console >= 0 && loadBegin >= 0 && loadEnd >= loadBegin) {
+		putMetric(results, "boot.load_linux_ms", loadEnd - loadBegin);
+		putMetric(results, "boot.to_kernel_ms", console + (loadEnd - loadBegin));
+	}
+}
+
+int loadCommands(const char* path, char** commands) {
+	char line[512];
+	int count = 0;
+	FILE* file = fopen(path, "r");
+
+	if(!file) {
+		fprintf(stderr, "cannot open %s\n", path);
+		return -1;
+	}
+
+	while(count < (MAX_COMMANDS - 1) && fgets(line, sizeof(line), file)) {
+		line[strcspn(line, "\r\n")] = '\0';
+		if(line[0] == '\0' || line[0] == '#')
+			continue;
+		commands[count++] = strdup(line);
+	}
+
+	commands[count] = NULL;
+	fclose(file);
+	return count;
+}
+
+int waitFor(int (*present)(), int seconds) {
+	long long deadline = now() + seconds * 1000000LL;
+
+	while(now() < deadline) {
+		if(present())
+			return 0;
+		usleep(100000);
+	}
+
+	return -1;
+}
+
+int runOnce(const char* image, char** commands, FILE* results, int run) {
+	const char* loadibec = getenv("LOADIBEC") ? getenv("LOADIBEC") : "./loadibec";
+	char command[1024];
+	int i;
+
+	if(waitFor(recoveryPresent, BOOT_TIMEOUT) != 0) {
+		fprintf(stderr, "run %d: no device in recovery mode\n", run);
+		return -1;
+	}
+
+	snprintf(command, sizeof(command), "%s '%s' > /dev/null", loadibec, image);
+
+	long long start = now();
+	if(system(command) != 0) {
+		fprintf(stderr, "run %d: %s failed\n", run, loadibec);
+		return -1;
+	}
+	long long uploaded = now();
+
+	if(waitFor(openOpenIBoot, BOOT_TIMEOUT) != 0) {
+		fprintf(stderr, "run %d: openiboot never came up\n", run);
+		return -1;
+	}
+	long long enumerated = now();
+
+	fprintf(results, "run %d\n", run);
+	putMetric(results, "host.upload_ms", (uploaded - start) / 1000.0);
+	putMetric(results, "host.enumerate_ms", (enumerated - uploaded) / 1000.0);
+
+	for(i = 0; commands[i] != NULL; i++) {
+		char* output = runCommand(commands[i]);
+		if(output == NULL) {
+			fprintf(stderr, "run %d: no answer to %s\n", run, commands[i]);
+			break;
+		}
+
+		parseOutput(results, output);
+		free(output);
+	}
+
+	double rate = usbBench(OPENIBOOTCMD_BENCH_SOURCE);
+	if(rate >= 0)
+		putMetric(results, "usb.source.mbps", rate);
+
+	rate = usbBench(OPENIBOOTCMD_BENCH_SINK);
+	if(rate >= 0)
+		putMetric(results, "usb.sink.mbps", rate);
+	fflush(results);
+
+	// nothing comes back from this one
+	sendBatch("reboot\n", 7);
+
+	libusb_close(device);
+	return 0;
+}
+
+int cmdRun(int argc, char* argv[]) {
+	char* commands[MAX_COMMANDS];
+	int runs;
+	int i;
+
+	if(argc < 5) {
+		fprintf(stderr, "Usage: %s run <openiboot.img3> <runs> <results> [commands]\n", argv[0]);
+		return 1;
+	}
+
+	runs = strtol(argv[3], NULL, 0);
+	if(runs <= 0 || runs > MAX_RUNS) {
+		fprintf(stderr, "between 1 and %d runs\n", MAX_RUNS);
+		return 1;
+	}
+
+	if(argc > 5) {
+		if(loadCommands(argv[5], commands) < 0)
+			return 1;
+	} else {
+		for(i = 0; DefaultCommands[i] != NULL; i++)
+			commands[i] = (char*) DefaultCommands[i];
+		commands[i] = NULL;
+	}
+
+	FILE* results = fopen(argv[4], "w");
+	if(!results) {
+		fprintf(stderr, "cannot open %s\n", argv[4]);
+		return 1;
+	}
+
+	libusb_init(NULL);
+
+	int done = 0;
+	for(i = 0; i < runs; i++) {
+		fprintf(stderr, "run %d of %d\n", i + 1, runs);
+		if(runOnce(argv[2], commands, results, i + 1) == 0)
+			done++;
+	}
+
+	libusb_exit(NULL);
+	fclose(results);
+
+	fprintf(stderr, "%d of %d runs done\n", done, runs);
+	return (done == runs) ? 0 : 1;
+}
+
+int loadResults(const char* path, Metric* metrics, int* runs) {
+	char line[256];
+	char name[64];
+	double value;
+	int count = 0;
+	int i;
+	FILE* file = fopen(path, "r");
+
+	if(!file) {
+		fprintf(stderr, "cannot open %s\n", path);
+		return -1;
+	}
+
+	*runs = 0;
+	while(fgets(line, sizeof(line), file)) {
+		if(strncmp(line, "run ", 4) == 0) {
+			(*runs)++;
+			continue;
+		}
+
+		if(sscanf(line, "%63s %lf", name, &value) != 2 || value < 0)
+			continue;
+
+		for(i = 0; i < count; i++) {
+			if(strcmp(metrics[i].name, name) == 0)
+				break;
+		}
+
+		if(i == count) {
+			if(count == MAX_METRICS)
+				continue;
+			strcpy(metrics[count].name, name);
+			metrics[count].count = 0;
+			count++;
+		}
+
+		if(metrics[i].count < MAX_RUNS)
+			metrics[i].values[metrics[i].count++] = value;
+	}
+
+	fclose(file);
+	return count;
+}
+
+int compareDoubles(const void* a, const void* b) {
+	double x = *(const double*) a;
+	double y = *(const double*) b;
+	return (x > y) - (x < y);
+}
+
+double median(Metric* metric) {
+	qsort(metric->values, metric->count, sizeof(double), compareDoubles);
+	if((metric->count % 2) == 0)
+		return (metric->values[metric->count / 2 - 1] + metric->values[metric->count / 2]) / 2;
+	return metric->values[metric->count / 2];
+}
+
+// half the distance between the quartiles, after median has sorted it
+double spread(Metric* metric) {
+	return (metric->values[(metric->count * 3) / 4] - metric->values[metric->count / 4]) / 2;
+}
+
+// rates are better higher, times lower
+int higherIsBetter(const char* name) {
+	size_t len = strlen(name);
+	return (len > 5 && strcmp(name + len - 5, ".mbps") == 0) || (len > 5 && strcmp(name + len - 5, ".iops") == 0);
+}
+
+int cmdCompare(int argc, char* argv[]) {
+	static Metric old[MAX_METRICS];
+	static Metric new[MAX_METRICS];
+	int oldRuns;
+	int newRuns;
+	int regressions = 0;
+	int i;
+	int j;
+
+	if(argc < 4) {
+		fprintf(stderr, "Usage: %s compare <old results> <new results> [threshold %%]\n", argv[0]);
+		return 1;
+	}
+
+	double threshold = (argc > 4) ? strtod(argv[4], NULL) : 5.0;
+
+	int oldCount = loadResults(argv[2], old, &oldRuns);
+	int newCount = loadResults(argv[3], new, &newRuns);
+	if(oldCount < 0 || newCount < 0)
+		return 1;
+
+	printf("%d runs of %s against %d runs of %s\n\n", oldRuns, argv[2], newRuns, argv[3]);
+	printf("%-40s %12s %12s %9s\n", "", "old", "new", "change");
+
+	for(i = 0; i < newCount; i++) {
+		for(j = 0; j < oldCount; j++) {
+			if(strcmp(old[j].name, new[i].name) == 0)
+				break;
+		}
+
+		if(j == oldCount) {
+			printf("%-40s %12s %12.3f\n", new[i].name, "-", median(&new[i]));
+			continue;
+		}
+
+		double before = median(&old[j]);
+		double after = median(&new[i]);
+		double change = (before != 0) ? ((after - before) * 100.0 / before) : 0;
+		double noise = spread(&old[j]) + spread(&new[i]);
+		int worse = higherIsBetter(new[i].name) ? (change < -threshold) : (change > threshold);
+
+		if(fabs(after - before) <= noise)
+			worse = 0;
+
+		printf("%-40s %12.3f %12.3f %+8.1f%%%s\n", new[i].name, before, after, change, worse ? "  WORSE" : "");
+		regressions += worse;
+	}
+
+	for(j = 0; j < oldCount; j++) {
+		for(i = 0; i < newCount; i++) {
+			if(strcmp(old[j].name, new[i].name) == 0)
+				break;
+		}
+
+		if(i == newCount)
+			printf("%-40s %12.3f %12s\n", old[j].name, median(&old[j]), "-");
+	}
+
+	printf("\n%d regressions over %.1f%%\n", regressions, threshold);
+	return (regressions > 0) ? 2 : 0;
+}
+
+int main(int argc, char* argv[]) {
+	if(argc >= 2 && strcmp(argv[1], "run") == 0)
+		return cmdRun(argc, argv);
+
+	if(argc >= 2 && strcmp(argv[1], "compare") == 0)
+		return cmdCompare(argc, argv);
+
+	fprintf(stderr, "Usage: %s run <openiboot.img3> <runs> <results> [commands]\n", argv[0]);
+	fprintf(stderr, "       %s compare <old results> <new results> [threshold %%]\n", argv[0]);
+	return 1;
+}
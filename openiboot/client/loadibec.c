@@ -4,6 +4,10 @@
 #include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 #include <libusb-1.0/libusb.h>
 #include <readline/readline.h>
@@ -12,6 +16,21 @@
 #define USB_RECOVERY		0x1281
 #define USB_DFU_MODE		0x1227
 
+// Pipelined uploads go to the bulk endpoint of the recovery interface, with
+// this many transfers in flight. Status is only read once it is all sent.
+#define PIPELINE_ENDPOINT	0x04
+#define PIPELINE_CHUNK		0x8000
+#define PIPELINE_DEPTH		4
+
+struct pipeline {
+	struct libusb_device_handle* handle;
+	const char* data;
+	long len;
+	long next;
+	int inFlight;
+	int failed;
+};
+
 struct libusb_device_handle* open_device(int devid) {
 	int configuration = 0;
 	struct libusb_device_handle* handle = NULL;
@@ -66,32 +85,98 @@ int send_command(struct libusb_device_handle* handle, char* command) {
 	return 0;
 }
 
-int send_file(struct libusb_device_handle *handle, const char* filename) {
-	if(handle == NULL) {
-		printf("send_file: device has not been initialized yet.\n");
+static const char* map_file(const char* filename, long* len) {
+	int fd = open(filename, O_RDONLY);
+	if(fd < 0) {
+		printf("send_file: unable to find file.\n");
+		return NULL;
+	}
+
+	struct stat st;
+	if(fstat(fd, &st) < 0 || st.st_size == 0) {
+		printf("send_file: unable to read file.\n");
+		close(fd);
+		return NULL;
+	}
+
+	void* data = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if(data == MAP_FAILED) {
+		printf("send_file: unable to map file.\n");
+		return NULL;
+	}
+
+	*len = st.st_size;
+	return data;
+}
+
+static void LIBUSB_CALL pipeline_callback(struct libusb_transfer* transfer);
+
+// Puts the next chunk on transfer, or frees it once everything is queued.
+static void pipeline_submit(struct pipeline* p, struct libusb_transfer* transfer) {
+	if(p->failed || p->next >= p->len) {
+		libusb_free_transfer(transfer);
+		return;
+	}
+
+	int size = (p->len - p->next) > PIPELINE_CHUNK ? PIPELINE_CHUNK : (p->len - p->next);
+	libusb_fill_bulk_transfer(transfer, p->handle, PIPELINE_ENDPOINT, (unsigned char*) &p->data[p->next], size, pipeline_callback, p, 5000);
+	if(libusb_submit_transfer(transfer) < 0) {
+		p->failed = 1;
+		libusb_free_transfer(transfer);
+		return;
+	}
+
+	p->next += size;
+	p->inFlight++;
+}
+
+static void LIBUSB_CALL pipeline_callback(struct libusb_transfer* transfer) {
+	struct pipeline* p = transfer->user_data;
+
+	p->inFlight--;
+	if(transfer->status != LIBUSB_TRANSFER_COMPLETED || transfer->actual_length != transfer->length)
+		p->failed = 1;
+
+	pipeline_submit(p, transfer);
+}
+
+static int send_pipelined(struct libusb_device_handle* handle, const char* data, long len) {
+	struct pipeline p = { handle, data, len, 0, 0, 0 };
+	int i;
+
+	if(libusb_claim_interface(handle, 1) < 0 || libusb_set_interface_alt_setting(handle, 1, 1) < 0) {
+		printf("send_file: unable to select the bulk interface.\n");
 		return -1;
 	}
-	
-	FILE* file = fopen(filename, "rb");
-	if(file == NULL) {
-		printf("send_file: unable to find file.\n");
-		return 1;
+
+	// tells iBoot an upload is coming on the bulk endpoint
+	if(libusb_control_transfer(handle, 0x41, 0, 0, 0, NULL, 0, 1000) < 0) {
+		printf("send_file: unable to start upload.\n");
+		return -1;
 	}
 
-	fseek(file, 0, SEEK_END);
-	long len = ftell(file);
-	fseek(file, 0, SEEK_SET);
+	for(i = 0; i < PIPELINE_DEPTH; i++) {
+		struct libusb_transfer* transfer = libusb_alloc_transfer(0);
+		if(transfer == NULL) {
+			p.failed = 1;
+			break;
+		}
+		pipeline_submit(&p, transfer);
+	}
 
-	char* buffer = malloc(len);
-	if (buffer == NULL) {
-		printf("send_file: error allocating memory.\n");
-		fclose(file);
-		return 1;
+	while(p.inFlight > 0)
+		libusb_handle_events(NULL);
+
+	if(p.failed) {
+		printf("send_file: error sending data.\n");
+		return -1;
 	}
 
-	fread(buffer, 1, len, file);
-	fclose(file);
+	return 0;
+}
 
+static int send_control(struct libusb_device_handle* handle, const char* data, long len) {
 	int packets = len / 0x800;
 	if(len % 0x800) {
 		packets++;
@@ -103,11 +188,11 @@ int send_file(struct libusb_device_handle *handle, const char* filename) {
 	}
 
 	int i = 0;
-	char response[6];
+	unsigned char response[6];
 	for(i = 0; i < packets; i++) {
 		int size = i + 1 < packets ? 0x800 : last;
 
-		if(!libusb_control_transfer(handle, 0x21, 1, i, 0, &buffer[i * 0x800], size, 1000)) {
+		if(!libusb_control_transfer(handle, 0x21, 1, i, 0, (unsigned char*) &data[i * 0x800], size, 1000)) {
 			printf("send_file: error sending packet.\n");
 			return -1;
 		}
@@ -125,7 +210,7 @@ int send_file(struct libusb_device_handle *handle, const char* filename) {
 
 	}
 
-	libusb_control_transfer(handle, 0x21, 1, i, 0, buffer, 0, 1000);
+	libusb_control_transfer(handle, 0x21, 1, i, 0, (unsigned char*) data, 0, 1000);
 	for(i = 6; i <= 8; i++) {
 		if(libusb_control_transfer(handle, 0xA1, 3, 0, 0, response, 6, 1000) != 6) {
 			printf("send_file: error receiving status.\n");
@@ -139,14 +224,38 @@ int send_file(struct libusb_device_handle *handle, const char* filename) {
 		}
 	}
 
-	free(buffer);
 	return 0;
 }
 
+int send_file(struct libusb_device_handle *handle, const char* filename, int pipelined) {
+	if(handle == NULL) {
+		printf("send_file: device has not been initialized yet.\n");
+		return -1;
+	}
+
+	long len;
+	const char* data = map_file(filename, &len);
+	if(data == NULL)
+		return 1;
+
+	int ret = pipelined ? send_pipelined(handle, data, len) : send_control(handle, data, len);
+
+	munmap((void*) data, len);
+	return ret;
+}
+
 int main(int argc, char* argv[]) {
 	struct libusb_device_handle* handle = NULL;
+	int pipelined = 0;
+	if (argc == 3 && strcmp(argv[1], "-p") == 0) {
+		pipelined = 1;
+		argv++;
+		argc--;
+	}
+
 	if (argc != 2) {
-		printf("usage: loadibec <img3>\n");
+		printf("usage: loadibec [-p] <img3>\n");
+		printf("\t-p: upload over the bulk endpoint with several transfers in flight\n");
 		return -1;
 	}
 
@@ -157,7 +266,7 @@ int main(int argc, char* argv[]) {
 	}
 	
 	// TODO: add interactive mode
-	if(send_file(handle, argv[1]) >= 0) {
+	if(send_file(handle, argv[1], pipelined) >= 0) {
 	    send_command(handle, "go");
 	}
 
@@ -1,29 +1,373 @@
 #include <stdint.h>
 #include <stdio.h>
 #include <string.h>
-#include <usb.h>
+#include <unistd.h>
+#include <stdlib.h>
+#include <time.h>
+#include <libusb-1.0/libusb.h>
 #include <pthread.h>
 #include <readline/readline.h>
+#include <sys/time.h>
 
 #define OPENIBOOTCMD_DUMPBUFFER 0
 #define OPENIBOOTCMD_DUMPBUFFER_LEN 1
 #define OPENIBOOTCMD_DUMPBUFFER_GOAHEAD 2
 #define OPENIBOOTCMD_SENDCOMMAND 3
 #define OPENIBOOTCMD_SENDCOMMAND_GOAHEAD 4
+#define OPENIBOOTCMD_SENDFILE 5
+#define OPENIBOOTCMD_SENDFILE_GOAHEAD 6
+#define OPENIBOOTCMD_NOTIFY 7
+#define OPENIBOOTCMD_SENDFILE_DONE 11
+#define OPENIBOOTCMD_SENDBATCH 18
+#define OPENIBOOTCMD_SENDBATCH_GOAHEAD 19
+
+// see usb.h on the device
+#define OPENIBOOTCMD_BATCH_MAX 0x4000
 
 typedef struct OpenIBootCmd {
 	uint32_t command;
 	uint32_t dataLen;
 }  __attribute__ ((__packed__)) OpenIBootCmd;
 
-usb_dev_handle* device;
+// "getfile ... z" streams, see usb.h on the device
+#define GETFILEZ_MAGIC 0x5A42494F
+#define GETFILEZ_FILL 0x100
+
+// "nanddump" streams, see nanddump.h on the device
+#define NANDDUMP_MAGIC 0x4E444D50
+
+typedef struct NANDDumpHeader {
+	uint32_t magic;
+	uint32_t banks;
+	uint32_t bytesPerPage;
+	uint32_t bytesPerSpare;
+	uint32_t firstPage;
+	uint32_t pages;
+	uint32_t pagesPerBatch;
+	uint32_t reserved;
+}  __attribute__ ((__packed__)) NANDDumpHeader;
+
+libusb_device_handle* device;
 pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
 FILE* outputFile = NULL;
 volatile size_t readIntoOutput = 0;
 
-volatile int InterestWrite = 0;
+// Everything the device sends on its interrupt endpoint is picked up by an async
+// transfer. Replies are handed to whoever holds lock, notifications wake doOutput.
+pthread_mutex_t replyLock = PTHREAD_MUTEX_INITIALIZER;
+pthread_cond_t replyCond = PTHREAD_COND_INITIALIZER;
+pthread_cond_t outputCond = PTHREAD_COND_INITIALIZER;
+OpenIBootCmd reply;
+int replyReady = 0;
+int outputPending = 1;
+unsigned char interruptBuffer[sizeof(OpenIBootCmd)];
 
 #define USB_BYTES_AT_A_TIME 512
+#define USB_STREAM_CHUNK 0x10000
+
+// Plain file transfers go in pieces this big, each checked with a CRC32 and
+// sent again up to TRANSFER_TRIES times if it does not match.
+#define TRANSFER_CHUNK 0x400000
+#define TRANSFER_TRIES 4
+
+uint32_t outputCRC = 0;
+size_t outputLen = 0;
+struct timeval transferStart;
+
+// Set while readIntoOutput is coming in run-length coded. zRecord collects
+// the header in front of each run, which may be split between reads.
+volatile int compressedOutput = 0;
+unsigned char zRecord[8];
+size_t zRecordHave = 0;
+int zStarted = 0;
+uint32_t zRunLeft = 0;
+uint32_t zRunFill = 0;
+size_t zReceived = 0;
+
+// Set while a piece of a checked getfile is coming in; after readIntoOutput
+// bytes of it, the device sends their CRC32 into chunkTrailer.
+volatile int chunkedOutput = 0;
+volatile size_t chunkTrailerLeft = 0;
+unsigned char chunkTrailer[4];
+int chunkDone = 0;
+pthread_cond_t chunkCond = PTHREAD_COND_INITIALIZER;
+
+// A NAND dump being received. The main areas go to dumpMainFile and the
+// spares, each with the read status after it, to dumpSpareFile.
+volatile int dumpActive = 0;
+FILE* dumpMainFile = NULL;
+FILE* dumpSpareFile = NULL;
+NANDDumpHeader dumpHeader;
+size_t dumpHeaderHave = 0;
+unsigned long long dumpLeft = 0;
+unsigned long long dumpTotal = 0;
+uint32_t dumpBatch = 0;
+size_t dumpBatchOffset = 0;
+
+uint32_t crc32(uint32_t crc, const void* buffer, size_t len) {
+	const uint8_t* buf = buffer;
+	int i;
+
+	crc = ~crc;
+	while(len--) {
+		crc ^= *buf++;
+		for(i = 0; i < 8; i++)
+			crc = (crc >> 1) ^ (0xEDB88320 & -(crc & 1));
+	}
+
+	return ~crc;
+}
+
+int transferRate(size_t bytes) {
+	struct timeval now;
+	gettimeofday(&now, NULL);
+
+	long long elapsed = (now.tv_sec - transferStart.tv_sec) * 1000000LL + (now.tv_usec - transferStart.tv_usec);
+	if(elapsed <= 0)
+		elapsed = 1;
+
+	return (int)((bytes * 1000000LL) / (elapsed * 1024));
+}
+
+void LIBUSB_CALL interruptReceived(struct libusb_transfer* transfer) {
+	if(transfer->status == LIBUSB_TRANSFER_NO_DEVICE) {
+		fprintf(stderr, "device disconnected\n");
+		exit(0);
+	}
+
+	if(transfer->status == LIBUSB_TRANSFER_COMPLETED && transfer->actual_length == sizeof(OpenIBootCmd)) {
+		OpenIBootCmd* cmd = (OpenIBootCmd*) transfer->buffer;
+
+		pthread_mutex_lock(&replyLock);
+		if(cmd->command == OPENIBOOTCMD_NOTIFY) {
+			outputPending = 1;
+			pthread_cond_signal(&outputCond);
+		} else {
+			reply = *cmd;
+			replyReady = 1;
+			pthread_cond_signal(&replyCond);
+		}
+		pthread_mutex_unlock(&replyLock);
+	}
+
+	libusb_submit_transfer(transfer);
+}
+
+void* doEvents(void* threadid) {
+	struct libusb_transfer* transfer = libusb_alloc_transfer(0);
+	libusb_fill_interrupt_transfer(transfer, device, 0x83, interruptBuffer, sizeof(interruptBuffer), interruptReceived, NULL, 0);
+	libusb_submit_transfer(transfer);
+
+	while(1)
+		libusb_handle_events(NULL);
+
+	pthread_exit(NULL);
+}
+
+void deadlineAfter(struct timespec* deadline, int ms) {
+	clock_gettime(CLOCK_REALTIME, deadline);
+	deadline->tv_sec += ms / 1000;
+	deadline->tv_nsec += (ms % 1000) * 1000000;
+	if(deadline->tv_nsec >= 1000000000) {
+		deadline->tv_sec++;
+		deadline->tv_nsec -= 1000000000;
+	}
+}
+
+void sendCommand(OpenIBootCmd* cmd) {
+	int transferred;
+
+	pthread_mutex_lock(&replyLock);
+	replyReady = 0;
+	pthread_mutex_unlock(&replyLock);
+
+	libusb_interrupt_transfer(device, 4, (unsigned char*) cmd, sizeof(OpenIBootCmd), &transferred, 1000);
+}
+
+int readReply(OpenIBootCmd* cmd, int timeout) {
+	struct timespec deadline;
+	int ret = 0;
+
+	deadlineAfter(&deadline, timeout);
+
+	pthread_mutex_lock(&replyLock);
+	while(!replyReady && ret == 0)
+		ret = pthread_cond_timedwait(&replyCond, &replyLock, &deadline);
+
+	if(replyReady) {
+		*cmd = reply;
+		replyReady = 0;
+		ret = 0;
+	} else {
+		ret = -1;
+	}
+	pthread_mutex_unlock(&replyLock);
+
+	return ret;
+}
+
+int bulkRead(char* buffer, int size, int timeout) {
+	int transferred = 0;
+	int ret = libusb_bulk_transfer(device, 0x81, (unsigned char*) buffer, size, &transferred, timeout);
+	if(ret != 0 && ret != LIBUSB_ERROR_TIMEOUT)
+		return -1;
+
+	return transferred;
+}
+
+int bulkWrite(char* buffer, int size, int timeout) {
+	int transferred = 0;
+	int ret = libusb_bulk_transfer(device, 2, (unsigned char*) buffer, size, &transferred, timeout);
+	if(ret != 0 && transferred == 0)
+		return -1;
+
+	return transferred;
+}
+
+void wakeOutput() {
+	pthread_mutex_lock(&replyLock);
+	outputPending = 1;
+	pthread_cond_signal(&outputCond);
+	pthread_mutex_unlock(&replyLock);
+}
+
+void writeOutput(const char* data, size_t len) {
+	fwrite(data, 1, len, outputFile);
+	outputCRC = crc32(outputCRC, data, len);
+	readIntoOutput -= len;
+}
+
+// Expands what came in for a compressed getfile into outputFile. Returns how
+// much of it belonged to the file.
+size_t writeCompressed(char* buffer, size_t len) {
+	static char fillBuffer[USB_STREAM_CHUNK];
+	size_t consumed = 0;
+
+	while(consumed < len && readIntoOutput > 0) {
+		if(zRunLeft == 0) {
+			size_t take = sizeof(zRecord) - zRecordHave;
+			if(take > (len - consumed))
+				take = len - consumed;
+
+			memcpy(zRecord + zRecordHave, buffer + consumed, take);
+			zRecordHave += take;
+			consumed += take;
+			if(zRecordHave < sizeof(zRecord))
+				break;
+
+			uint32_t words[2];
+			memcpy(words, zRecord, sizeof(words));
+			zRecordHave = 0;
+
+			if(!zStarted) {
+				if(words[0] != GETFILEZ_MAGIC || words[1] != readIntoOutput) {
+					fprintf(stderr, "device did not send the file compressed\n");
+					fclose(outputFile);
+					readIntoOutput = 0;
+					compressedOutput = 0;
+					return 0;
+				}
+
+				zStarted = 1;
+				continue;
+			}
+
+			zRunLeft = (words[0] > readIntoOutput) ? readIntoOutput : words[0];
+			zRunFill = words[1];
+			continue;
+		}
+
+		if(zRunFill & GETFILEZ_FILL) {
+			memset(fillBuffer, zRunFill & 0xFF, sizeof(fillBuffer));
+			while(zRunLeft > 0) {
+				size_t toWrite = (zRunLeft > sizeof(fillBuffer)) ? sizeof(fillBuffer) : zRunLeft;
+				writeOutput(fillBuffer, toWrite);
+				zRunLeft -= toWrite;
+			}
+		} else {
+			size_t toWrite = (zRunLeft > (len - consumed)) ? (len - consumed) : zRunLeft;
+			writeOutput(buffer + consumed, toWrite);
+			consumed += toWrite;
+			zRunLeft -= toWrite;
+		}
+	}
+
+	zReceived += consumed;
+
+	if(readIntoOutput == 0) {
+		fclose(outputFile);
+		compressedOutput = 0;
+		fprintf(stderr, "received %d bytes as %d, crc32 %08x, %d KB/s\n", (int) outputLen, (int) zReceived, outputCRC, transferRate(outputLen));
+	}
+
+	return consumed;
+}
+
+void finishDump() {
+	fclose(dumpMainFile);
+	fclose(dumpSpareFile);
+	dumpActive = 0;
+}
+
+// Takes in what came from the device while a dump is active. Returns how much
+// of it was dump data; anything else is console output, e.g. an error.
+size_t writeDump(char* buffer, size_t len) {
+	size_t consumed = 0;
+
+	if(dumpHeaderHave == 0) {
+		if(len < sizeof(NANDDumpHeader) || ((NANDDumpHeader*) buffer)->magic != NANDDUMP_MAGIC) {
+			fprintf(stderr, "device did not start the nand dump\n");
+			finishDump();
+			return 0;
+		}
+
+		memcpy(&dumpHeader, buffer, sizeof(NANDDumpHeader));
+		dumpHeaderHave = sizeof(NANDDumpHeader);
+		dumpTotal = dumpLeft = (unsigned long long) dumpHeader.pages * dumpHeader.banks
+			* (dumpHeader.bytesPerPage + dumpHeader.bytesPerSpare);
+		dumpBatch = 0;
+		dumpBatchOffset = 0;
+		consumed = sizeof(NANDDumpHeader);
+
+		fprintf(stderr, "dumping pages 0x%x - 0x%x of %d banks, %d + %d bytes each\n", dumpHeader.firstPage,
+				dumpHeader.firstPage + dumpHeader.pages - 1, dumpHeader.banks, dumpHeader.bytesPerPage, dumpHeader.bytesPerSpare);
+	}
+
+	while(consumed < len && dumpLeft > 0) {
+		uint32_t pages = dumpHeader.pages - (dumpBatch * dumpHeader.pagesPerBatch);
+		if(pages > dumpHeader.pagesPerBatch)
+			pages = dumpHeader.pagesPerBatch;
+
+		size_t mainLen = (size_t) pages * dumpHeader.banks * dumpHeader.bytesPerPage;
+		size_t batchLen = mainLen + ((size_t) pages * dumpHeader.banks * dumpHeader.bytesPerSpare);
+		size_t toWrite = batchLen - dumpBatchOffset;
+		if(toWrite > (len - consumed))
+			toWrite = len - consumed;
+
+		// the main areas of a batch come before its spares
+		size_t toMain = 0;
+		if(dumpBatchOffset < mainLen)
+			toMain = ((mainLen - dumpBatchOffset) < toWrite) ? (mainLen - dumpBatchOffset) : toWrite;
+
+		fwrite(buffer + consumed, 1, toMain, dumpMainFile);
+		fwrite(buffer + consumed + toMain, 1, toWrite - toMain, dumpSpareFile);
+
+		consumed += toWrite;
+		dumpLeft -= toWrite;
+		dumpBatchOffset += toWrite;
+		if(dumpBatchOffset == batchLen) {
+			dumpBatch++;
+			dumpBatchOffset = 0;
+		}
+	}
+
+	if(dumpLeft == 0) {
+		fprintf(stderr, "received %llu KB of nand, %d KB/s\n", dumpTotal / 1024, transferRate(dumpTotal));
+		finishDump();
+	}
+
+	return consumed;
+}
 
 void* doOutput(void* threadid) {
 	OpenIBootCmd cmd;
@@ -31,17 +375,21 @@ void* doOutput(void* threadid) {
 	int totalLen = 0;
 
 	while(1) {
-		if(InterestWrite)
-		{
-			sched_yield();
-			continue;
-		}
+		// sleep until the device says it has output, polling once a second just in case
+		struct timespec deadline;
+		deadlineAfter(&deadline, 1000);
+
+		pthread_mutex_lock(&replyLock);
+		if(!outputPending)
+			pthread_cond_timedwait(&outputCond, &replyLock, &deadline);
+		outputPending = 0;
+		pthread_mutex_unlock(&replyLock);
 
 		pthread_mutex_lock(&lock);
 		cmd.command = OPENIBOOTCMD_DUMPBUFFER;
 		cmd.dataLen = 0;
-		usb_interrupt_write(device, 4, (char*) (&cmd), sizeof(OpenIBootCmd), 1000);
-		while(usb_interrupt_read(device, 3, (char*) (&cmd), sizeof(OpenIBootCmd), 1000) < 0) {
+		sendCommand(&cmd);
+		while(readReply(&cmd, 1000) < 0 || cmd.command != OPENIBOOTCMD_DUMPBUFFER_LEN) {
 			//rl_deprep_terminal();
 			//exit(0);
 		}
@@ -52,28 +400,50 @@ void* doOutput(void* threadid) {
 
 			cmd.command = OPENIBOOTCMD_DUMPBUFFER_GOAHEAD;
 			cmd.dataLen = totalLen;
-			usb_interrupt_write(device, 4, (char*) (&cmd), sizeof(OpenIBootCmd), 1000);
+			sendCommand(&cmd);
 
 			int read = 0;
 			while(read < totalLen) {
 				int left = (totalLen - read);
-				size_t toRead = (left > USB_BYTES_AT_A_TIME) ? USB_BYTES_AT_A_TIME : left;
+				int chunk = (readIntoOutput > 0 || chunkTrailerLeft > 0 || dumpActive) ? USB_STREAM_CHUNK : USB_BYTES_AT_A_TIME;
+				size_t toRead = (left > chunk) ? chunk : left;
 				int hasRead;
-				hasRead = usb_bulk_read(device, 1, buffer + read, toRead, 1000);
+				hasRead = bulkRead(buffer + read, toRead, 5000);
+				if(hasRead < 0)
+					continue;
+
 				read += hasRead;
 			}
 
 			int discarded = 0;
-			if(readIntoOutput > 0) {
-				if(readIntoOutput <= read) {
-					fwrite(buffer, 1, readIntoOutput, outputFile);
-					discarded += readIntoOutput;
-					readIntoOutput = 0;
-					fclose(outputFile);
-				} else {
-					fwrite(buffer, 1, read, outputFile);
-					discarded += read;
-					readIntoOutput -= read;
+			if(dumpActive) {
+				discarded = writeDump(buffer, read);
+			} else if(compressedOutput) {
+				discarded = writeCompressed(buffer, read);
+			} else if(readIntoOutput > 0 || chunkTrailerLeft > 0) {
+				size_t toWrite = (readIntoOutput <= read) ? readIntoOutput : read;
+				fwrite(buffer, 1, toWrite, outputFile);
+				outputCRC = crc32(outputCRC, buffer, toWrite);
+				discarded += toWrite;
+				readIntoOutput -= toWrite;
+
+				while(discarded < read && readIntoOutput == 0 && chunkTrailerLeft > 0) {
+					chunkTrailer[sizeof(chunkTrailer) - chunkTrailerLeft] = buffer[discarded++];
+					chunkTrailerLeft--;
+				}
+
+				if(readIntoOutput == 0 && chunkTrailerLeft == 0) {
+					if(chunkedOutput) {
+						// receiveFile checks it and moves on to the next piece
+						chunkedOutput = 0;
+						pthread_mutex_lock(&replyLock);
+						chunkDone = 1;
+						pthread_cond_signal(&chunkCond);
+						pthread_mutex_unlock(&replyLock);
+					} else {
+						fclose(outputFile);
+						fprintf(stderr, "received %d bytes, crc32 %08x, %d KB/s\n", (int) outputLen, outputCRC, transferRate(outputLen));
+					}
 				}
 			}
 
@@ -84,14 +454,13 @@ void* doOutput(void* threadid) {
 
 			cmd.command = OPENIBOOTCMD_DUMPBUFFER;
 			cmd.dataLen = 0;
-			usb_interrupt_write(device, 4, (char*) (&cmd), sizeof(OpenIBootCmd), 1000);
-			usb_interrupt_read(device, 3, (char*) (&cmd), sizeof(OpenIBootCmd), 1000);
+			sendCommand(&cmd);
+			if(readReply(&cmd, 1000) < 0 || cmd.command != OPENIBOOTCMD_DUMPBUFFER_LEN)
+				break;
 			totalLen = cmd.dataLen;
 		}
 
 		pthread_mutex_unlock(&lock);
-
-		sched_yield();
 	}
 	pthread_exit(NULL);
 }
@@ -104,11 +473,10 @@ void sendBuffer(char* buffer, size_t size) {
 	cmd.command = OPENIBOOTCMD_SENDCOMMAND;
 	cmd.dataLen = size;
 
-	usb_interrupt_write(device, 4, (char*) (&cmd), sizeof(OpenIBootCmd), 1000);
+	sendCommand(&cmd);
 
 	while(1) {
-		usb_interrupt_read(device, 3, (char*) (&cmd), sizeof(OpenIBootCmd), 1000);
-		if(cmd.command == OPENIBOOTCMD_SENDCOMMAND_GOAHEAD)
+		if(readReply(&cmd, 1000) == 0 && cmd.command == OPENIBOOTCMD_SENDCOMMAND_GOAHEAD)
 			break;
 	}
 
@@ -119,12 +487,283 @@ void sendBuffer(char* buffer, size_t size) {
 		else
 			toSend = MAX_TO_SEND;
 
-		usb_bulk_write(device, 2, buffer, toSend, 1000);
+		bulkWrite(buffer, toSend, 1000);
 		buffer += toSend;
 		size -= toSend;
 	}
 }
 
+// Stream a file to the buffer set up by "sendfile" in one go, with a CRC32 at the
+// end. Falls back to the old command channel if the device does not support it.
+// Returns 1 if the device checked the CRC32, 0 if it could not, or -1 if it
+// never said either way.
+int sendFile(char* buffer, size_t size) {
+	OpenIBootCmd cmd;
+	int tries;
+
+	gettimeofday(&transferStart, NULL);
+
+	// the device may not have processed "sendfile" yet
+	for(tries = 0; tries < 10; tries++) {
+		cmd.command = OPENIBOOTCMD_SENDFILE;
+		cmd.dataLen = size;
+		sendCommand(&cmd);
+
+		cmd.command = 0;
+		while(cmd.command != OPENIBOOTCMD_SENDFILE_GOAHEAD) {
+			if(readReply(&cmd, 1000) < 0)
+				break;
+		}
+
+		if(cmd.command == OPENIBOOTCMD_SENDFILE_GOAHEAD && cmd.dataLen == size)
+			break;
+
+		usleep(10000);
+	}
+
+	if(tries == 10) {
+		sendBuffer(buffer, size);
+		return -1;
+	}
+
+	size_t sent = 0;
+	while(sent < size) {
+		size_t toSend = ((size - sent) > USB_STREAM_CHUNK) ? USB_STREAM_CHUNK : (size - sent);
+		int ret = bulkWrite(buffer + sent, toSend, 5000);
+		if(ret < 0) {
+			fprintf(stderr, "file transfer failed after %d bytes\n", (int) sent);
+			return 0;
+		}
+		sent += ret;
+	}
+
+	uint32_t crc = crc32(0, buffer, size);
+	bulkWrite((char*) &crc, sizeof(crc), 1000);
+
+	fprintf(stderr, "sent %d bytes, crc32 %08x, %d KB/s\n", (int) size, crc, transferRate(size));
+
+	// older devices only print the result to the console
+	cmd.command = 0;
+	while(cmd.command != OPENIBOOTCMD_SENDFILE_DONE) {
+		if(readReply(&cmd, 2000) < 0)
+			return -1;
+	}
+
+	fprintf(stderr, "device %s the file\n", cmd.dataLen ? "verified" : "could not verify");
+	return cmd.dataLen ? 1 : 0;
+}
+
+// Sends a file in TRANSFER_CHUNK pieces starting at offset, each checked by
+// the device and sent again if it did not match.
+int sendFileChunked(char* buffer, size_t size, uint32_t address, size_t offset) {
+	char command[USB_BYTES_AT_A_TIME];
+
+	while(offset < size) {
+		size_t len = ((size - offset) > TRANSFER_CHUNK) ? TRANSFER_CHUNK : (size - offset);
+		int tries;
+		int ret = 0;
+
+		for(tries = 0; tries < TRANSFER_TRIES; tries++) {
+			sprintf(command, "sendfile 0x%08x %d 0x%08x", address + (uint32_t) offset, (int) len, crc32(0, buffer + offset, len));
+
+			pthread_mutex_lock(&lock);
+			sendBuffer(command, strlen(command));
+			ret = sendFile(buffer + offset, len);
+			pthread_mutex_unlock(&lock);
+
+			// -1 is an old device, which takes it unchecked
+			if(ret != 0)
+				break;
+
+			fprintf(stderr, "sending bytes 0x%x - 0x%x again\n", (int) offset, (int) (offset + len - 1));
+		}
+
+		if(ret == 0) {
+			fprintf(stderr, "giving up at 0x%x; carry on with :0x%x after the address\n", (int) offset, (int) offset);
+			return -1;
+		}
+
+		offset += len;
+	}
+
+	return 0;
+}
+
+// Fetches size bytes at address into file in TRANSFER_CHUNK pieces starting
+// at offset. Each piece comes with a CRC32 and is fetched again if it does
+// not match, so what is in the file up to a piece boundary is known good.
+int receiveFile(FILE* file, uint32_t address, size_t size, size_t offset) {
+	char command[USB_BYTES_AT_A_TIME];
+	size_t total = size - offset;
+
+	gettimeofday(&transferStart, NULL);
+
+	while(offset < size) {
+		size_t len = ((size - offset) > TRANSFER_CHUNK) ? TRANSFER_CHUNK : (size - offset);
+		uint32_t crc = 0;
+		int tries;
+
+		for(tries = 0; tries < TRANSFER_TRIES; tries++) {
+			fseek(file, offset, SEEK_SET);
+			sprintf(command, "getfile 0x%08x %d c", address + (uint32_t) offset, (int) len);
+
+			pthread_mutex_lock(&lock);
+			sendBuffer(command, strlen(command));
+			outputFile = file;
+			outputCRC = 0;
+			outputLen = len;
+			chunkTrailerLeft = sizeof(chunkTrailer);
+			chunkedOutput = 1;
+			chunkDone = 0;
+			readIntoOutput = len;
+			pthread_mutex_unlock(&lock);
+
+			wakeOutput();
+
+			pthread_mutex_lock(&replyLock);
+			while(!chunkDone)
+				pthread_cond_wait(&chunkCond, &replyLock);
+			pthread_mutex_unlock(&replyLock);
+
+			memcpy(&crc, chunkTrailer, sizeof(crc));
+			if(crc == outputCRC)
+				break;
+
+			fprintf(stderr, "bytes 0x%x - 0x%x came in with crc32 %08x instead of %08x, fetching them again\n",
+					(int) offset, (int) (offset + len - 1), outputCRC, crc);
+		}
+
+		if(crc != outputCRC) {
+			fprintf(stderr, "giving up at 0x%x; add r to the length to carry on from there\n", (int) offset);
+			fclose(file);
+			return -1;
+		}
+
+		offset += len;
+	}
+
+	fclose(file);
+	fprintf(stderr, "received %d bytes, %d KB/s\n", (int) total, transferRate(total));
+	return 0;
+}
+
+// Asks for a batch of up to OPENIBOOTCMD_BATCH_MAX bytes of commands to be
+// taken. Returns the number of its first command, 0 if the device is busy,
+// or -1 if it does not know about batches.
+int startBatch(size_t size) {
+	OpenIBootCmd cmd;
+
+	cmd.command = OPENIBOOTCMD_SENDBATCH;
+	cmd.dataLen = size;
+	sendCommand(&cmd);
+
+	cmd.command = 0;
+	while(cmd.command != OPENIBOOTCMD_SENDBATCH_GOAHEAD) {
+		if(readReply(&cmd, 1000) < 0)
+			return -1;
+	}
+
+	return cmd.dataLen;
+}
+
+// Sends a script in as few batches as will hold it. Each command is queued
+// on the device as it comes in, so this does not wait for any of them to
+// run; "batch: <number> done" shows up in the output as each one finishes.
+void sendBatch(char* script, size_t size) {
+	char* batch = malloc(OPENIBOOTCMD_BATCH_MAX);
+	size_t offset = 0;
+	int commands = 0;
+	int batches = 0;
+	int first = 0;
+
+	while(offset < size) {
+		size_t batchLen = 0;
+		int batchCommands = 0;
+
+		// whole lines only, leaving out empty ones and comments
+		while(offset < size) {
+			char* line = script + offset;
+			char* eol = memchr(line, '\n', size - offset);
+			size_t lineLen = eol ? (size_t)(eol - line) : (size - offset);
+
+			if(lineLen > 0 && line[lineLen - 1] == '\r')
+				lineLen--;
+
+			if(lineLen == 0 || line[0] == '#') {
+				offset += (eol ? (eol - line) + 1 : (size - offset));
+				continue;
+			}
+
+			if(lineLen + 1 > OPENIBOOTCMD_BATCH_MAX) {
+				fprintf(stderr, "line too long for a batch, stopping after %d commands\n", commands);
+				free(batch);
+				return;
+			}
+
+			if(batchLen + lineLen + 1 > OPENIBOOTCMD_BATCH_MAX)
+				break;
+
+			memcpy(batch + batchLen, line, lineLen);
+			batch[batchLen + lineLen] = '\n';
+			batchLen += lineLen + 1;
+			batchCommands++;
+			offset += (eol ? (eol - line) + 1 : (size - offset));
+		}
+
+		if(batchLen == 0)
+			break;
+
+		int number;
+		int tries;
+		for(tries = 0; tries < 100; tries++) {
+			number = startBatch(batchLen);
+			if(number != 0)
+				break;
+
+			// still taking the last one, or in the middle of a file
+			usleep(10000);
+		}
+
+		if(number < 0) {
+			// one command at a time, the old way
+			char* line = batch;
+			while(line < batch + batchLen) {
+				char* eol = memchr(line, '\n', (batch + batchLen) - line);
+				sendBuffer(line, (eol - line) + 1);
+				line = eol + 1;
+			}
+		} else if(number == 0) {
+			fprintf(stderr, "device is busy, stopping after %d commands\n", commands);
+			free(batch);
+			return;
+		} else {
+			size_t sent = 0;
+			while(sent < batchLen) {
+				int ret = bulkWrite(batch + sent, batchLen - sent, 5000);
+				if(ret < 0) {
+					fprintf(stderr, "batch transfer failed, stopping after %d commands\n", commands);
+					free(batch);
+					return;
+				}
+				sent += ret;
+			}
+
+			if(batches == 0)
+				first = number;
+		}
+
+		commands += batchCommands;
+		batches++;
+	}
+
+	if(first > 0)
+		fprintf(stderr, "queued %d commands (%d - %d) in %d batches\n", commands, first, first + commands - 1, batches);
+	else
+		fprintf(stderr, "sent %d commands\n", commands);
+
+	free(batch);
+}
+
 void* doInput(void* threadid) {
 	char* commandBuffer = NULL;
 	char toSendBuffer[USB_BYTES_AT_A_TIME];
@@ -146,6 +785,15 @@ void* doInput(void* threadid) {
 		int len = strlen(commandBuffer);
 
 		if(commandBuffer[0] == '!') {
+			// !<file>@<address>:<offset> carries on with a send that gave up
+			char* offsetLoc = strchr(&commandBuffer[1], ':');
+			size_t offset = 0;
+
+			if(offsetLoc != NULL) {
+				*offsetLoc = '\0';
+				offset = strtoul(offsetLoc + 1, NULL, 0);
+			}
+
 			char* atLoc = strchr(&commandBuffer[1], '@');
 
 			if(atLoc != NULL)
@@ -163,18 +811,22 @@ void* doInput(void* threadid) {
 			fread(fileBuffer, 1, len, file);
 			fclose(file);
 
-			if(atLoc != NULL) {
-				sprintf(toSendBuffer, "sendfile %s", atLoc + 1);
-			} else {
-				sprintf(toSendBuffer, "sendfile 0x09000000");
-			}
+			uint32_t address = (atLoc != NULL) ? strtoul(atLoc + 1, NULL, 0) : 0x09000000;
 
-			InterestWrite = 1;
-			pthread_mutex_lock(&lock);
-			sendBuffer(toSendBuffer, strlen(toSendBuffer));
-			sendBuffer(fileBuffer, len);
-			pthread_mutex_unlock(&lock);
-			InterestWrite = 0;
+			if(len <= TRANSFER_CHUNK && offset == 0) {
+				// the device checks the size and CRC32 as the data comes in
+				uint32_t crc = crc32(0, fileBuffer, len);
+				sprintf(toSendBuffer, "sendfile 0x%08x %d 0x%08x", address, len, crc);
+
+				pthread_mutex_lock(&lock);
+				sendBuffer(toSendBuffer, strlen(toSendBuffer));
+				sendFile(fileBuffer, len);
+				pthread_mutex_unlock(&lock);
+			} else if(offset < len) {
+				gettimeofday(&transferStart, NULL);
+				if(sendFileChunked(fileBuffer, len, address, offset) == 0)
+					fprintf(stderr, "sent %d bytes, %d KB/s\n", (int) (len - offset), transferRate(len - offset));
+			}
 			free(fileBuffer);
 		} else if(commandBuffer[0] == '~') {
 			char* sizeLoc = strchr(&commandBuffer[1], ':');
@@ -190,40 +842,132 @@ void* doInput(void* threadid) {
 			int toRead;
 			sscanf(sizeLoc, "%i", &toRead);
 
+			// a z after the length asks for it run-length coded, an r carries
+			// on from the last piece already in the file
+			int compressed = (strchr(sizeLoc, 'z') != NULL);
+			int resume = !compressed && (strchr(sizeLoc, 'r') != NULL);
+
 			char* atLoc = strchr(&commandBuffer[1], '@');
 
 			if(atLoc != NULL)
 				*atLoc = '\0';
 
-			FILE* file = fopen(&commandBuffer[1], "wb");
+			size_t offset = 0;
+			FILE* file = resume ? fopen(&commandBuffer[1], "r+b") : NULL;
+			if(file) {
+				fseek(file, 0, SEEK_END);
+				offset = ftell(file);
+				offset -= offset % TRANSFER_CHUNK;
+				if(offset > toRead)
+					offset = toRead;
+
+				fprintf(stderr, "carrying on from 0x%x\n", (int) offset);
+			} else {
+				file = fopen(&commandBuffer[1], "wb");
+			}
+
 			if(!file) {
 				fprintf(stderr, "cannot open file: %s\n", &commandBuffer[1]);
 				continue;
 			}
 
+			if(!compressed) {
+				uint32_t address = (atLoc != NULL) ? strtoul(atLoc + 1, NULL, 0) : 0x09000000;
+				receiveFile(file, address, toRead, offset);
+				continue;
+			}
+
 			if(atLoc != NULL) {
-				sprintf(toSendBuffer, "getfile %s %d", atLoc + 1, toRead);
+				sprintf(toSendBuffer, "getfile %s %d%s", atLoc + 1, toRead, compressed ? " z" : "");
 			} else {
-				sprintf(toSendBuffer, "getfile 0x09000000 %d", toRead);
+				sprintf(toSendBuffer, "getfile 0x09000000 %d%s", toRead, compressed ? " z" : "");
 			}
 
-			InterestWrite = 1;
 			pthread_mutex_lock(&lock);
 			sendBuffer(toSendBuffer, strlen(toSendBuffer));
 			outputFile = file;
+			outputCRC = 0;
+			outputLen = toRead;
+			zRecordHave = 0;
+			zStarted = 0;
+			zRunLeft = 0;
+			zReceived = 0;
+			compressedOutput = compressed;
+			gettimeofday(&transferStart, NULL);
 			readIntoOutput = toRead;
 			pthread_mutex_unlock(&lock);
-			InterestWrite = 0;
+
+			// the file is fetched through the output channel
+			wakeOutput();
+		} else if(commandBuffer[0] == '%') {
+			char* sizeLoc = strchr(&commandBuffer[1], ':');
+
+			if(sizeLoc == NULL) {
+				fprintf(stderr, "must specify the number of pages to dump\n");
+				continue;
+			}
+
+			*sizeLoc = '\0';
+			sizeLoc++;
+
+			unsigned int pages;
+			unsigned int firstPage = 0;
+			sscanf(sizeLoc, "%i", &pages);
+
+			char* atLoc = strchr(&commandBuffer[1], '@');
+
+			if(atLoc != NULL) {
+				*atLoc = '\0';
+				sscanf(atLoc + 1, "%i", &firstPage);
+			}
+
+			char spareName[1024];
+			snprintf(spareName, sizeof(spareName), "%s.spare", &commandBuffer[1]);
+
+			FILE* mainFile = fopen(&commandBuffer[1], "wb");
+			FILE* spareFile = mainFile ? fopen(spareName, "wb") : NULL;
+			if(!spareFile) {
+				fprintf(stderr, "cannot open file: %s\n", mainFile ? spareName : &commandBuffer[1]);
+				if(mainFile)
+					fclose(mainFile);
+				continue;
+			}
+
+			sprintf(toSendBuffer, "nanddump %u %u", firstPage, pages);
+
+			pthread_mutex_lock(&lock);
+			sendBuffer(toSendBuffer, strlen(toSendBuffer));
+			dumpMainFile = mainFile;
+			dumpSpareFile = spareFile;
+			dumpHeaderHave = 0;
+			gettimeofday(&transferStart, NULL);
+			dumpActive = 1;
+			pthread_mutex_unlock(&lock);
+
+			wakeOutput();
+		} else if(commandBuffer[0] == '<') {
+			FILE* file = fopen(&commandBuffer[1], "rb");
+			if(!file) {
+				fprintf(stderr, "file not found: %s\n", &commandBuffer[1]);
+				continue;
+			}
+			fseek(file, 0, SEEK_END);
+			len = ftell(file);
+			fseek(file, 0, SEEK_SET);
+			fileBuffer = malloc(len);
+			fread(fileBuffer, 1, len, file);
+			fclose(file);
+
+			pthread_mutex_lock(&lock);
+			sendBatch(fileBuffer, len);
+			pthread_mutex_unlock(&lock);
+			free(fileBuffer);
 		} else {
-			InterestWrite = 1;
 			commandBuffer[len] = '\n';
 			pthread_mutex_lock(&lock);
 			sendBuffer(commandBuffer, len + 1);
 			pthread_mutex_unlock(&lock);
-			InterestWrite = 0;
 		}
-
-		sched_yield();
 	}
 	pthread_exit(NULL);
 }
@@ -232,64 +976,83 @@ int main(int argc, char* argv[]) {
 
 	read_history(".oibc-history");
 
-	usb_init();
-	usb_find_busses();
-	usb_find_devices();
-
-	struct usb_bus *busses;
-	struct usb_bus *bus;
-	struct usb_device *dev;
-
-	busses = usb_get_busses();
-
-	int found = 0;
-	int c, i, a;
-	for(bus = busses; bus; bus = bus->next) {
-    		for (dev = bus->devices; dev; dev = dev->next) {
-    			/* Check if this device is a printer */
-    			//if (dev->descriptor.idVendor != 0x05ac || dev->descriptor.idProduct != 0x1280) {
-    			if (dev->descriptor.idVendor != 0x0525 || dev->descriptor.idProduct != 0x1280) {
-    				continue;
-    			}
-    
-			/* Loop through all of the interfaces */
-			for (i = 0; i < dev->config[0].bNumInterfaces; i++) {
-				for (a = 0; a < dev->config[0].interface[i].num_altsetting; a++) {
-					if(dev->config[0].interface[i].altsetting[a].bInterfaceClass == 0xFF
-						&& dev->config[0].interface[i].altsetting[a].bInterfaceSubClass == 0xFF
-						&& dev->config[0].interface[i].altsetting[a].bInterfaceProtocol == 0x51) {
-						goto done;
-					}
-    				}
-    			}
-    		}
-	}
+	libusb_init(NULL);
+
+	libusb_device** devices;
+	libusb_device* dev = NULL;
+	ssize_t count = libusb_get_device_list(NULL, &devices);
 
-	return 1;
+	int i = 0;
+	int a;
+	ssize_t d;
+	for(d = 0; d < count; d++) {
+		struct libusb_device_descriptor descriptor;
+		struct libusb_config_descriptor* config;
 
-done:
+		if(libusb_get_device_descriptor(devices[d], &descriptor) != 0)
+			continue;
 
-	device = usb_open(dev);
-	if(!device) {
+		//if (descriptor.idVendor != 0x05ac || descriptor.idProduct != 0x1280) {
+		if (descriptor.idVendor != 0x0525 || descriptor.idProduct != 0x1280) {
+			continue;
+		}
+
+		if(libusb_get_config_descriptor(devices[d], 0, &config) != 0)
+			continue;
+
+		/* Loop through all of the interfaces */
+		for (i = 0; i < config->bNumInterfaces; i++) {
+			for (a = 0; a < config->interface[i].num_altsetting; a++) {
+				if(config->interface[i].altsetting[a].bInterfaceClass == 0xFF
+					&& config->interface[i].altsetting[a].bInterfaceSubClass == 0xFF
+					&& config->interface[i].altsetting[a].bInterfaceProtocol == 0x51) {
+					dev = devices[d];
+					break;
+				}
+			}
+
+			if(dev)
+				break;
+		}
+
+		libusb_free_config_descriptor(config);
+
+		if(dev)
+			break;
+	}
+
+	if(!dev) {
+		libusb_free_device_list(devices, 1);
+		return 1;
+	}
+
+	if(libusb_open(dev, &device) != 0) {
+		libusb_free_device_list(devices, 1);
 		return 2;
 	}
 
-	if(usb_claim_interface(device, i) != 0) {
+	libusb_free_device_list(devices, 1);
+
+	if(libusb_claim_interface(device, i) != 0) {
 		return 3;
 	}
 
 	pthread_t inputThread;
 	pthread_t outputThread;
+	pthread_t eventThread;
 
-	printf("Client connected: !<filename>[@<address>] to send a file, ~<filename>[@<address>]:<len> to receive a file\n");
+	printf("Client connected: !<filename>[@<address>][:<offset>] to send a file, ~<filename>[@<address>]:<len> to receive a file\n");
+	printf("                  (:<len>z to compress it, :<len>r to carry on with one that gave up)\n");
+	printf("                  %%<filename>[@<first page>]:<pages> to dump that many pages of every NAND bank\n");
+	printf("                  <<filename> to run the commands in a file, one per line\n");
 	printf("---------------------------------------------------------------------------------------------------------\n");
 
+	pthread_create(&eventThread, NULL, doEvents, NULL);
 	pthread_create(&outputThread, NULL, doOutput, NULL);
 	pthread_create(&inputThread, NULL, doInput, NULL);
 
 	pthread_exit(NULL);
 
-	usb_release_interface(device, i);
-	usb_close(device);
+	libusb_release_interface(device, i);
+	libusb_close(device);
 }
-
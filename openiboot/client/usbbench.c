@@ -0,0 +1,224 @@
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <libusb-1.0/libusb.h>
+#include <sys/time.h>
+
+// Measures the openiboot bulk endpoints with the OPENIBOOTCMD_BENCH_*
+// commands, see usb.h on the device. oibc must not be running.
+
+#define OPENIBOOTCMD_NOTIFY 7
+#define OPENIBOOTCMD_BENCH_COUNT 12
+#define OPENIBOOTCMD_BENCH_SINK 13
+#define OPENIBOOTCMD_BENCH_SOURCE 14
+#define OPENIBOOTCMD_BENCH_ECHO 15
+#define OPENIBOOTCMD_BENCH_GOAHEAD 16
+#define OPENIBOOTCMD_BENCH_DONE 17
+
+#define USBBENCH_MAX_TRANSFER 0x10000
+
+typedef struct OpenIBootCmd {
+	uint32_t command;
+	uint32_t dataLen;
+}  __attribute__ ((__packed__)) OpenIBootCmd;
+
+libusb_device_handle* device;
+
+long long now() {
+	struct timeval tv;
+	gettimeofday(&tv, NULL);
+	return tv.tv_sec * 1000000LL + tv.tv_usec;
+}
+
+int sendCommand(uint32_t command, uint32_t dataLen) {
+	OpenIBootCmd cmd;
+	int transferred;
+
+	cmd.command = command;
+	cmd.dataLen = dataLen;
+	return libusb_interrupt_transfer(device, 4, (unsigned char*) &cmd, sizeof(cmd), &transferred, 1000);
+}
+
+// skips the console notifications that may be queued in front of it
+int readReply(uint32_t command, OpenIBootCmd* cmd, int timeout) {
+	int transferred;
+
+	while(1) {
+		if(libusb_interrupt_transfer(device, 0x83, (unsigned char*) cmd, sizeof(OpenIBootCmd), &transferred, timeout) != 0)
+			return -1;
+
+		if(transferred == sizeof(OpenIBootCmd) && cmd->command == command)
+			return 0;
+	}
+}
+
+int compareTimes(const void* a, const void* b) {
+	long long x = *(const long long*) a;
+	long long y = *(const long long*) b;
+	return (x > y) - (x < y);
+}
+
+libusb_device* findDevice(libusb_device** devices, ssize_t count, int* interface) {
+	ssize_t d;
+	int i;
+	int a;
+
+	for(d = 0; d < count; d++) {
+		struct libusb_device_descriptor descriptor;
+		struct libusb_config_descriptor* config;
+
+		if(libusb_get_device_descriptor(devices[d], &descriptor) != 0)
+			continue;
+
+		if (descriptor.idVendor != 0x0525 || descriptor.idProduct != 0x1280)
+			continue;
+
+		if(libusb_get_config_descriptor(devices[d], 0, &config) != 0)
+			continue;
+
+		for (i = 0; i < config->bNumInterfaces; i++) {
+			for (a = 0; a < config->interface[i].num_altsetting; a++) {
+				if(config->interface[i].altsetting[a].bInterfaceClass == 0xFF
+					&& config->interface[i].altsetting[a].bInterfaceSubClass == 0xFF
+					&& config->interface[i].altsetting[a].bInterfaceProtocol == 0x51) {
+					libusb_free_config_descriptor(config);
+					*interface = i;
+					return devices[d];
+				}
+			}
+		}
+
+		libusb_free_config_descriptor(config);
+	}
+
+	return NULL;
+}
+
+int runBench(uint32_t mode, int size, int count) {
+	unsigned char* buffer = malloc(size);
+	long long* times = malloc(count * sizeof(long long));
+	OpenIBootCmd reply;
+	int transferred;
+	int i;
+
+	if(!buffer || !times) {
+		fprintf(stderr, "out of memory\n");
+		return -1;
+	}
+
+	memset(buffer, 0x5A, size);
+
+	if(sendCommand(OPENIBOOTCMD_BENCH_COUNT, count) != 0 || sendCommand(mode, size) != 0
+			|| readReply(OPENIBOOTCMD_BENCH_GOAHEAD, &reply, 1000) != 0) {
+		fprintf(stderr, "no answer from the device\n");
+		return -1;
+	}
+
+	if(reply.dataLen != size) {
+		fprintf(stderr, "the device is busy, or %d bytes is too much (at most %d)\n", size, USBBENCH_MAX_TRANSFER);
+		return -1;
+	}
+
+	long long start = now();
+	for(i = 0; i < count; i++) {
+		long long transferStart = now();
+		int ret = 0;
+
+		if(mode == OPENIBOOTCMD_BENCH_SINK || mode == OPENIBOOTCMD_BENCH_ECHO)
+			ret = libusb_bulk_transfer(device, 2, buffer, size, &transferred, 5000);
+
+		if(ret == 0 && (mode == OPENIBOOTCMD_BENCH_SOURCE || mode == OPENIBOOTCMD_BENCH_ECHO))
+			ret = libusb_bulk_transfer(device, 0x81, buffer, size, &transferred, 5000);
+
+		if(ret != 0 || transferred != size) {
+			fprintf(stderr, "transfer %d failed (%d)\n", i, ret);
+			return -1;
+		}
+
+		times[i] = now() - transferStart;
+	}
+	long long elapsed = now() - start;
+
+	if(readReply(OPENIBOOTCMD_BENCH_DONE, &reply, 5000) != 0) {
+		fprintf(stderr, "the device never finished\n");
+		return -1;
+	}
+
+	if(elapsed <= 0)
+		elapsed = 1;
+
+	// echo moves every byte twice
+	long long bytes = (long long) size * count * ((mode == OPENIBOOTCMD_BENCH_ECHO) ? 2 : 1);
+	qsort(times, count, sizeof(long long), compareTimes);
+
+	printf("%d x %d bytes in %lld us (device: %u us), %.2f MB/s\n", count, size, elapsed, reply.dataLen,
+			(double) bytes / elapsed);
+	printf("%s per transfer: min %lld us, p50 %lld us, p90 %lld us, p99 %lld us, max %lld us\n",
+			(mode == OPENIBOOTCMD_BENCH_ECHO) ? "round trip" : "time",
+			times[0], times[(count * 50) / 100], times[(count * 90) / 100], times[(count * 99) / 100], times[count - 1]);
+
+	free(buffer);
+	free(times);
+	return 0;
+}
+
+int main(int argc, char* argv[]) {
+	uint32_t mode;
+	int interface = 0;
+
+	if(argc < 2) {
+		fprintf(stderr, "Usage: %s <sink|source|echo> [transfer size] [transfers]\n", argv[0]);
+		return 1;
+	}
+
+	if(strcmp(argv[1], "sink") == 0) {
+		mode = OPENIBOOTCMD_BENCH_SINK;
+	} else if(strcmp(argv[1], "source") == 0) {
+		mode = OPENIBOOTCMD_BENCH_SOURCE;
+	} else if(strcmp(argv[1], "echo") == 0) {
+		mode = OPENIBOOTCMD_BENCH_ECHO;
+	} else {
+		fprintf(stderr, "Usage: %s <sink|source|echo> [transfer size] [transfers]\n", argv[0]);
+		return 1;
+	}
+
+	int size = (argc > 2) ? strtol(argv[2], NULL, 0) : USBBENCH_MAX_TRANSFER;
+	int count = (argc > 3) ? strtol(argv[3], NULL, 0) : 256;
+	if(size <= 0 || count <= 0) {
+		fprintf(stderr, "bad transfer size or count\n");
+		return 1;
+	}
+
+	libusb_init(NULL);
+
+	libusb_device** devices;
+	ssize_t deviceCount = libusb_get_device_list(NULL, &devices);
+	libusb_device* dev = findDevice(devices, deviceCount, &interface);
+
+	if(!dev) {
+		fprintf(stderr, "no openiboot device found\n");
+		libusb_free_device_list(devices, 1);
+		return 1;
+	}
+
+	if(libusb_open(dev, &device) != 0) {
+		libusb_free_device_list(devices, 1);
+		return 2;
+	}
+
+	libusb_free_device_list(devices, 1);
+
+	if(libusb_claim_interface(device, interface) != 0) {
+		fprintf(stderr, "could not claim the interface, is oibc running?\n");
+		return 3;
+	}
+
+	int ret = runBench(mode, size, count);
+
+	libusb_release_interface(device, interface);
+	libusb_close(device);
+	libusb_exit(NULL);
+
+	return (ret == 0) ? 0 : 1;
+}
@@ -1,6 +1,8 @@
 #include "openiboot.h"
 #include "clock.h"
 #include "util.h"
+#include "timer.h"
+#include "openiboot-asmhelpers.h"
 #include "hardware/clock0.h"
 #include "hardware/clock1.h"
 
@@ -20,6 +22,37 @@ uint32_t ClockSDiv;
 
 uint32_t TicksPerSec;
 
+// What each base runs at with ClockSDiv at 0. The ones fed by ClockPLL are
+// divided by 1 << ClockSDiv on top of that; SDivBases has a bit for each.
+static uint32_t FullFrequencies[FrequencyBaseTimebase + 1];
+static uint32_t SDivBases;
+
+typedef struct ClockChangeEntry {
+	ClockChangeHandler handler;
+	void* opaque;
+} ClockChangeEntry;
+
+static ClockChangeEntry ChangeHandlers[CLOCK_CHANGE_HANDLERS];
+static int NumChangeHandlers = 0;
+
+static ClockGovernor Governor = ClockGovernorAuto;
+static ClockPerformance Performance = ClockPerformanceHigh;
+static int BoostCount = 0;
+static uint64_t LastBusy = 0;
+
+static void clock_update_frequencies() {
+	uint32_t* current[] = {&ClockFrequency, &MemoryFrequency, &BusFrequency, &PeripheralFrequency,
+		&UnknownFrequency, &DisplayFrequency, &FixedFrequency, &TimebaseFrequency};
+	int i;
+
+	for(i = 0; i <= FrequencyBaseTimebase; i++) {
+		if(SDivBases & (1 << i))
+			*current[i] = FullFrequencies[i] >> ClockSDiv;
+		else
+			*current[i] = FullFrequencies[i];
+	}
+}
+
 int clock_setup() {
 	uint32_t config;
 
@@ -145,14 +178,26 @@ int clock_setup() {
 		}
 	}
 
-	ClockFrequency = PLLFrequencies[clockPLL] / clockDivisor;
-	MemoryFrequency = PLLFrequencies[memoryPLL] / memoryDivisor;
-	BusFrequency = PLLFrequencies[busPLL] / busDivisor;
-	UnknownFrequency = PLLFrequencies[unknownPLL] / unknownDivisor;
-	PeripheralFrequency = BusFrequency / (1 << peripheralFactor);
-	DisplayFrequency = PLLFrequencies[displayPLL] / displayDivisor;
-	FixedFrequency = FREQUENCY_BASE * 2;
-	TimebaseFrequency = FREQUENCY_BASE / 2;
+	FullFrequencies[FrequencyBaseClock] = PLLFrequencies[clockPLL] / clockDivisor;
+	FullFrequencies[FrequencyBaseMemory] = PLLFrequencies[memoryPLL] / memoryDivisor;
+	FullFrequencies[FrequencyBaseBus] = PLLFrequencies[busPLL] / busDivisor;
+	FullFrequencies[FrequencyBaseUnknown] = PLLFrequencies[unknownPLL] / unknownDivisor;
+	FullFrequencies[FrequencyBasePeripheral] = FullFrequencies[FrequencyBaseBus] / (1 << peripheralFactor);
+	FullFrequencies[FrequencyBaseDisplay] = PLLFrequencies[displayPLL] / displayDivisor;
+	FullFrequencies[FrequencyBaseFixed] = FREQUENCY_BASE * 2;
+	FullFrequencies[FrequencyBaseTimebase] = FREQUENCY_BASE / 2;
+
+	SDivBases = 1 << FrequencyBaseClock;
+	if(memoryPLL == clockPLL)
+		SDivBases |= 1 << FrequencyBaseMemory;
+	if(busPLL == clockPLL)
+		SDivBases |= (1 << FrequencyBaseBus) | (1 << FrequencyBasePeripheral);
+	if(unknownPLL == clockPLL)
+		SDivBases |= 1 << FrequencyBaseUnknown;
+	if(displayPLL == clockPLL)
+		SDivBases |= 1 << FrequencyBaseDisplay;
+
+	clock_update_frequencies();
 
 	TicksPerSec = FREQUENCY_BASE;
 
@@ -232,7 +277,7 @@ uint32_t clock_get_frequency(FrequencyBase freqBase) {
 }
 
 uint32_t clock_calculate_frequency(uint32_t pdiv, uint32_t mdiv, FrequencyBase freqBase) {
-	unsigned int y = clock_get_frequency(freqBase) / (0x1 << ClockSDiv);
+	unsigned int y = ((freqBase <= FrequencyBaseTimebase) ? FullFrequencies[freqBase] : 0) / (0x1 << ClockSDiv);
 	uint64_t z = (((uint64_t) pdiv) * ((uint64_t) 1000000000)) / ((uint64_t) y);
 	uint64_t divResult = ((uint64_t)(1000000 * mdiv)) / z;
 	return divResult - 1;
@@ -281,5 +326,87 @@ void clock_set_sdiv(int sdiv) {
 	if(oldClockSDiv >= ClockSDiv) {
 		clock0_reset_frequency();
 	}
+
+	clock_update_frequencies();
+
+	if(oldClockSDiv != ClockSDiv) {
+		int i;
+		for(i = 0; i < NumChangeHandlers; i++)
+			ChangeHandlers[i].handler(ChangeHandlers[i].opaque);
+	}
+}
+
+int clock_add_change_handler(ClockChangeHandler handler, void* opaque) {
+	if(NumChangeHandlers >= CLOCK_CHANGE_HANDLERS)
+		return -1;
+
+	ChangeHandlers[NumChangeHandlers].handler = handler;
+	ChangeHandlers[NumChangeHandlers].opaque = opaque;
+	NumChangeHandlers++;
+	return 0;
+}
+
+static void clock_set_performance(ClockPerformance level) {
+	if(level == Performance)
+		return;
+
+	// handlers reprogram dividers, nothing may talk to the hardware meanwhile
+	EnterCriticalSection();
+	clock_set_sdiv((level == ClockPerformanceHigh) ? 0 : CLOCK_IDLE_SDIV);
+	Performance = level;
+	LeaveCriticalSection();
+}
+
+static void clock_governor_apply() {
+	if(Governor == ClockGovernorHigh)
+		clock_set_performance(ClockPerformanceHigh);
+	else if(Governor == ClockGovernorLow)
+		clock_set_performance(ClockPerformanceLow);
+}
+
+void clock_set_governor(ClockGovernor governor) {
+	Governor = governor;
+	LastBusy = timer_get_system_microtime();
+
+	if(governor == ClockGovernorAuto)
+		clock_set_performance(ClockPerformanceHigh);
+	else
+		clock_governor_apply();
+}
+
+ClockGovernor clock_get_governor() {
+	return Governor;
+}
+
+ClockPerformance clock_get_performance() {
+	return Performance;
+}
+
+void clock_governor_busy() {
+	LastBusy = timer_get_system_microtime();
+
+	if(Governor == ClockGovernorAuto)
+		clock_set_performance(ClockPerformanceHigh);
+}
+
+void clock_governor_idle() {
+	if(Governor != ClockGovernorAuto || BoostCount > 0)
+		return;
+
+	// short gaps between bursts of work are not worth two switches
+	if(has_elapsed(LastBusy, CLOCK_IDLE_DELAY))
+		clock_set_performance(ClockPerformanceLow);
+}
+
+void clock_boost_begin() {
+	BoostCount++;
+	clock_governor_busy();
+}
+
+void clock_boost_end() {
+	if(BoostCount > 0)
+		BoostCount--;
+
+	LastBusy = timer_get_system_microtime();
 }
 
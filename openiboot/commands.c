@@ -13,12 +13,22 @@
 #include "actions.h"
 #include "nvram.h"
 #include "pmu.h"
+#include "hardware/pmu.h"
 #include "dma.h"
 #include "nand.h"
 #include "ftl.h"
 #include "i2c.h"
+#include "hfs/bdev.h"
 #include "hfs/fs.h"
 #include "aes.h"
+#include "tasks.h"
+#include "latency.h"
+#include "bench.h"
+#include "heapprof.h"
+#include "usbmsc.h"
+#include "usbaudio.h"
+#include "usbacm.h"
+#include "usb.h"
 #include "accel.h"
 #include "sdio.h"
 #include "wdt.h"
@@ -28,6 +38,14 @@
 #include "radio.h"
 #include "als.h"
 #include "piezo.h"
+#include "scripting.h"
+#include "bootprof.h"
+#include "hash.h"
+#include "profiler.h"
+#include "irqoff.h"
+#include "camera.h"
+#include "sensors.h"
+#include "hardware/camera.h"
 
 void cmd_reboot(int argc, char** argv) {
 	Reboot();
@@ -196,11 +214,8 @@ void cmd_images_read(int argc, char** argv) {
 	}
 
 	Image* image = images_get(fourcc(argv[1]));
-	void* imageData;
-	size_t length = images_read(image, &imageData);
 	uint32_t address = parseNumber(argv[2]);
-	memcpy((void*)address, imageData, length);
-	free(imageData);
+	size_t length = images_read_to(image, (void*)address, image ? image->padded : 0);
 	bufferPrintf("Read %d of %s to 0x%x - 0x%x\r\n", length, argv[1], address, address + length);
 }
 
@@ -264,6 +279,21 @@ void cmd_boot(int argc, char** argv) {
 	boot_linux(arguments);
 }
 
+#ifndef NO_HFS
+// Reads the kernel and initrd the way the boot menu does, but stays here, so
+// the time it takes shows up in the boot timeline.
+void cmd_linux_load(int argc, char** argv) {
+	int ret;
+
+	bootprof_begin("load linux");
+	ret = load_linux_from_files();
+	bootprof_end("load linux", ret == 0);
+
+	if(ret == 0)
+		bufferPrintf("Linux loaded, use 'boot' to start it.\r\n");
+}
+#endif
+
 void cmd_go(int argc, char** argv) {
 	uint32_t address;
 
@@ -283,6 +313,23 @@ void cmd_go(int argc, char** argv) {
 	chainload(address);
 }
 
+// For chaining to another openiboot build: the display stays up and the new
+// one goes straight to the console.
+void cmd_go_warm(int argc, char** argv) {
+	uint32_t address;
+
+	if(argc < 2) {
+		address = 0x09000000;
+	} else {
+		address = parseNumber(argv[1]);
+	}
+
+	bufferPrintf("Warm chainloading 0x%x\r\n", address);
+	udelay(100000);
+
+	chainload_warm(address);
+}
+
 void cmd_jump(int argc, char** argv) {
 	if(argc < 2) {
 		bufferPrintf("Usage: %s <address>\r\n", argv[0]);
@@ -293,6 +340,8 @@ void cmd_jump(int argc, char** argv) {
 	bufferPrintf("Jumping to 0x%x\r\n", address);
 	udelay(100000);
 
+	// whatever was copied there may still be sitting in the data cache
+	ClearCPUCaches();
 	CallArm(address);
 }
 
@@ -402,6 +451,19 @@ void cmd_setenv(int argc, char** argv) {
 	bufferPrintf("Set %s = %s\r\n", argv[1], argv[2]);
 }
 
+void cmd_script(int argc, char** argv) {
+	if(argc < 3) {
+		bufferPrintf("Usage: %s <address> <len>\r\n", argv[0]);
+		return;
+	}
+
+	uint32_t address = parseNumber(argv[1]);
+	uint32_t len = parseNumber(argv[2]);
+
+	if(script_run((const char*) address, len) != 0)
+		bufferPrintf("script failed\r\n");
+}
+
 void cmd_saveenv(int argc, char** argv) {
 	bufferPrintf("Saving environment, this may take awhile...\r\n");
 	nvram_save();
@@ -506,15 +568,52 @@ void cmd_dma(int argc, char** argv) {
 void cmd_nand_erase(int argc, char** argv)
 {
 	if(argc < 3) {
-		bufferPrintf("Usage: %s <bank> <block> -- You probably don't want to do this.\r\n", argv[0]);
+		bufferPrintf("Usage: %s <bank> <block> [blocks] -- You probably don't want to do this.\r\n", argv[0]);
 		return;
 	}
 
 	uint32_t bank = parseNumber(argv[1]);
 	uint32_t block = parseNumber(argv[2]);
+	uint32_t blocks = 1;
+	if(argc >= 4) {
+		blocks = parseNumber(argv[3]);
+	}
+
+	if(blocks == 1) {
+		bufferPrintf("Erasing bank %d, block %d...\r\n", bank, block);
+		bufferPrintf("nand_erase: %d\r\n", nand_erase(bank, block));
+		return;
+	}
 
-	bufferPrintf("Erasing bank %d, block %d...\r\n", bank, block);
-	bufferPrintf("nand_erase: %d\r\n", nand_erase(bank, block));
+	NANDRequest* requests = (NANDRequest*) malloc(sizeof(NANDRequest) * blocks);
+	if(!requests) {
+		bufferPrintf("Out of memory.\r\n");
+		return;
+	}
+
+	// queue them all, other tasks keep running while the bank works
+	bufferPrintf("Erasing bank %d, blocks %d - %d...\r\n", bank, block, block + blocks - 1);
+	memset(requests, 0, sizeof(NANDRequest) * blocks);
+
+	uint32_t i;
+	for(i = 0; i < blocks; i++) {
+		requests[i].operation = NANDOperationErase;
+		requests[i].bank = bank;
+		requests[i].page = block + i;
+		nand_submit(&requests[i]);
+	}
+
+	int failed = 0;
+	for(i = 0; i < blocks; i++) {
+		int ret = nand_wait(&requests[i]);
+		if(ret != 0) {
+			bufferPrintf("nand_erase: block %d: %d\r\n", block + i, ret);
+			failed++;
+		}
+	}
+
+	bufferPrintf("nand_erase: %d of %d blocks failed\r\n", failed, blocks);
+	free(requests);
 }
 
 void cmd_nand_read(int argc, char** argv) {
@@ -535,6 +634,9 @@ void cmd_nand_read(int argc, char** argv) {
 	NANDData* Data = nand_get_geometry();
 	
 	while(pages > 0) {	
+		if(command_cancelled())
+			return;
+
 		int ret = nand_read(bank, page, (uint8_t*) address, NULL, TRUE, FALSE);
 		if(ret != 0)
 			bufferPrintf("nand_read: %x\r\n", ret);
@@ -592,7 +694,9 @@ void cmd_nand_read_spare(int argc, char** argv) {
 	NANDData* Data = nand_get_geometry();
 	
 	while(pages > 0) {	
-		int ret = nand_read(bank, page, NULL, (uint8_t*) address, FALSE, FALSE);
+		int ret = nand_read_spare(bank, page, (uint8_t*) address, FALSE);
+		if(ret == ERROR_EMPTYBLOCK)
+			ret = 0;
 		if(ret != 0)
 			bufferPrintf("nand_read: %x\r\n", ret);
 
@@ -675,6 +779,209 @@ void cmd_bdev_read(int argc, char** argv) {
 	bufferPrintf("ftl_read: %x\r\n", ftl_read((uint8_t*) address, offset, bytes));
 }
 
+void cmd_hash(int argc, char** argv) {
+	static const char* algorithms[] = {"crc32", "adler32", "sha1"};
+	static const char* sources[] = {"mem", "nor", "vfl", "ftl"};
+	int algorithm;
+	int source;
+
+	if(argc < 5) {
+		bufferPrintf("Usage: %s <crc32|adler32|sha1> <mem|nor|vfl|ftl> <offset> <len> [block size]\r\n", argv[0]);
+		return;
+	}
+
+	for(algorithm = HashSHA1; algorithm > 0; algorithm--)
+		if(strcmp(argv[1], algorithms[algorithm]) == 0)
+			break;
+
+	for(source = HashFTL; source > 0; source--)
+		if(strcmp(argv[2], sources[source]) == 0)
+			break;
+
+	if(strcmp(argv[1], algorithms[algorithm]) != 0 || strcmp(argv[2], sources[source]) != 0) {
+		bufferPrintf("hash: unknown algorithm or source\r\n");
+		return;
+	}
+
+	uint32_t offset = parseNumber(argv[3]);
+	uint32_t len = parseNumber(argv[4]);
+	uint32_t blockSize = (argc > 5) ? parseNumber(argv[5]) : len;
+	uint32_t blocks = hash_blocks(len, blockSize);
+	int digestSize = hash_digest_size(algorithm);
+
+	uint8_t* digests = malloc(blocks * digestSize);
+	if(blocks == 0 || digests == NULL) {
+		bufferPrintf("hash: nothing to do\r\n");
+		if(digests)
+			free(digests);
+		return;
+	}
+
+	if(hash_range(algorithm, source, offset, len, blockSize, digests) != 0) {
+		bufferPrintf("hash: failed\r\n");
+		free(digests);
+		return;
+	}
+
+	uint32_t i;
+	for(i = 0; i < blocks; i++) {
+		bufferPrintf("0x%08x: ", offset + (i * blockSize));
+		if(algorithm == HashSHA1) {
+			int j;
+			for(j = 0; j < digestSize; j++)
+				bufferPrintf("%02x", digests[(i * digestSize) + j]);
+			bufferPrintf("\r\n");
+		} else {
+			bufferPrintf("%08x\r\n", ((uint32_t*) digests)[i]);
+		}
+	}
+
+	free(digests);
+}
+
+void cmd_latency(int argc, char** argv) {
+	if(argc >= 2 && strcmp(argv[1], "reset") == 0) {
+		latency_reset();
+		bufferPrintf("Latency histograms cleared.\r\n");
+		return;
+	}
+
+	latency_print();
+}
+
+void cmd_iotrace(int argc, char** argv) {
+	if(argc < 2) {
+		bufferPrintf("Usage: %s <on|off|show|clear> [entries]\r\n", argv[0]);
+		return;
+	}
+
+	if(strcmp(argv[1], "on") == 0) {
+		if(iotrace_start() != 0)
+			bufferPrintf("iotrace: out of memory\r\n");
+		else
+			bufferPrintf("I/O tracing on.\r\n");
+	} else if(strcmp(argv[1], "off") == 0) {
+		iotrace_stop();
+		bufferPrintf("I/O tracing off.\r\n");
+	} else if(strcmp(argv[1], "clear") == 0) {
+		iotrace_clear();
+		bufferPrintf("I/O trace cleared.\r\n");
+	} else if(strcmp(argv[1], "show") == 0) {
+		int max = (argc >= 3) ? parseNumber(argv[2]) : 32;
+		if(max <= 0 || max > IOTRACE_ENTRIES)
+			max = IOTRACE_ENTRIES;
+
+		IOTraceEntry* entries = (IOTraceEntry*) malloc(sizeof(IOTraceEntry) * IOTRACE_ENTRIES);
+		if(entries == NULL) {
+			bufferPrintf("iotrace: out of memory\r\n");
+			return;
+		}
+
+		int count = iotrace_read(entries, IOTRACE_ENTRIES);
+		int i;
+		for(i = (count > max) ? (count - max) : 0; i < count; i++) {
+			bufferPrintf("%u: op %d addr 0x%x count %d, %u us\r\n", entries[i].timestamp, entries[i].operation,
+				entries[i].address, entries[i].count, entries[i].latency);
+		}
+
+		bufferPrintf("%d entries (%u dropped), tracing %s\r\n", count, iotrace_dropped(), iotrace_enabled() ? "on" : "off");
+		free(entries);
+	} else {
+		bufferPrintf("Usage: %s <on|off|show|clear> [entries]\r\n", argv[0]);
+	}
+}
+
+void cmd_bootprof(int argc, char** argv) {
+	bootprof_print();
+}
+
+#ifndef NO_HFS
+void cmd_bdev_cache(int argc, char** argv) {
+	bdev_print_cache_stats();
+}
+
+void cmd_bdev_key(int argc, char** argv) {
+	if(argc < 3) {
+		bufferPrintf("Usage: %s <partition> <uid|none|key in hex>\r\n", argv[0]);
+		return;
+	}
+
+	int partition = parseNumber(argv[1]);
+	if(partition < 0 || partition > 3) {
+		bufferPrintf("bdev_key: there are only partitions 0 - 3\r\n");
+		return;
+	}
+
+	if(strcmp(argv[2], "none") == 0) {
+		bdev_clear_key(partition);
+		bufferPrintf("bdev: partition %d is read as it is\r\n", partition);
+	} else if(strcmp(argv[2], "uid") == 0) {
+		bdev_set_key(partition, AESUID, NULL);
+		bufferPrintf("bdev: partition %d is decrypted with the UID key\r\n", partition);
+	} else {
+		uint8_t key[32];
+		uint8_t* bytes;
+		int length;
+
+		hexToBytes(argv[2], &bytes, &length);
+		if(length != 16 && length != 24 && length != 32) {
+			bufferPrintf("bdev_key: the key should be 16, 24 or 32 bytes\r\n");
+			free(bytes);
+			return;
+		}
+
+		memset(key, 0, sizeof(key));
+		memcpy(key, bytes, length);
+		free(bytes);
+
+		bdev_set_key(partition, AESCustom, key);
+		bufferPrintf("bdev: partition %d is decrypted with a %d bit key\r\n", partition, length * 8);
+	}
+
+	// what is mounted was read the old way
+	fs_invalidate();
+}
+
+void cmd_usbmsc(int argc, char** argv) {
+	int readOnly = FALSE;
+	if(argc >= 2) {
+		if(strcmp(argv[1], "ro") != 0) {
+			bufferPrintf("Usage: %s [ro]\r\n", argv[0]);
+			return;
+		}
+		readOnly = TRUE;
+	}
+
+	usbmsc_run(readOnly);
+}
+#endif
+
+void cmd_usbacm(int argc, char** argv) {
+	int enable;
+
+	if(argc < 2) {
+		bufferPrintf("usbacm: the console is %s\r\n", usbacm_enabled() ? "a CDC-ACM serial port" : "on the OpenIBoot interface");
+		bufferPrintf("Usage: %s <on|off>\r\n", argv[0]);
+		return;
+	}
+
+	if(strcmp(argv[1], "on") == 0) {
+		enable = TRUE;
+	} else if(strcmp(argv[1], "off") == 0) {
+		enable = FALSE;
+	} else {
+		bufferPrintf("Usage: %s <on|off>\r\n", argv[0]);
+		return;
+	}
+
+	if(enable == usbacm_enabled())
+		return;
+
+	usbacm_set_enabled(enable);
+	usb_shutdown();
+	startUSB();
+}
+
 void cmd_text(int argc, char** argv) {
 	if(argc < 2) {
 		bufferPrintf("Usage: %s <on|off>\r\n", argv[0]);
@@ -696,7 +1003,382 @@ void cmd_malloc_stats(int argc, char** argv) {
 	malloc_stats();
 }
 
+void cmd_heap(int argc, char** argv) {
+	if(argc < 2) {
+		bufferPrintf("Usage: %s <on|off|show|mark|leaks|reset> [sites]\r\n", argv[0]);
+		return;
+	}
+
+	if(strcmp(argv[1], "on") == 0) {
+		heapprof_start();
+		bufferPrintf("Heap profiling on.\r\n");
+	} else if(strcmp(argv[1], "off") == 0) {
+		heapprof_stop();
+		bufferPrintf("Heap profiling off.\r\n");
+	} else if(strcmp(argv[1], "show") == 0) {
+		heapprof_print((argc >= 3) ? parseNumber(argv[2]) : 16);
+	} else if(strcmp(argv[1], "mark") == 0) {
+		heapprof_mark();
+		bufferPrintf("Leaks are counted from the next command.\r\n");
+	} else if(strcmp(argv[1], "leaks") == 0) {
+		heapprof_print_leaks();
+	} else if(strcmp(argv[1], "reset") == 0) {
+		heapprof_reset();
+		bufferPrintf("Heap profile cleared.\r\n");
+	} else {
+		bufferPrintf("Usage: %s <on|off|show|mark|leaks|reset> [sites]\r\n", argv[0]);
+	}
+}
+
+void cmd_profile(int argc, char** argv) {
+	if(argc < 2) {
+		bufferPrintf("Usage: %s <start|stop|show|dump|reset> [hz|entries|address]\r\n", argv[0]);
+		return;
+	}
+
+	if(strcmp(argv[1], "start") == 0) {
+		uint32_t hz = (argc >= 3) ? parseNumber(argv[2]) : PROFILER_DEFAULT_HZ;
+		if(profiler_start(hz) == 0)
+			bufferPrintf("Sampling at %d Hz.\r\n", hz ? hz : PROFILER_DEFAULT_HZ);
+	} else if(strcmp(argv[1], "stop") == 0) {
+		profiler_stop();
+		bufferPrintf("Sampling stopped.\r\n");
+	} else if(strcmp(argv[1], "show") == 0) {
+		profiler_print((argc >= 3) ? parseNumber(argv[2]) : 16);
+	} else if(strcmp(argv[1], "dump") == 0) {
+		uint32_t address = (argc >= 3) ? parseNumber(argv[2]) : 0x09000000;
+		uint32_t length = profiler_dump((void*) address);
+		if(length > 0)
+			bufferPrintf("profile: %d bytes written to 0x%x\r\n", length, address);
+	} else if(strcmp(argv[1], "reset") == 0) {
+		profiler_reset();
+		bufferPrintf("Profile cleared.\r\n");
+	} else {
+		bufferPrintf("Usage: %s <start|stop|show|dump|reset> [hz|entries|address]\r\n", argv[0]);
+	}
+}
+
+void cmd_irqoff(int argc, char** argv) {
+	if(argc < 2) {
+		bufferPrintf("Usage: %s <on|off|show|reset> [sites]\r\n", argv[0]);
+		return;
+	}
+
+	if(strcmp(argv[1], "on") == 0) {
+		if(irqoff_start() == 0)
+			bufferPrintf("Tracking critical sections and interrupt handlers.\r\n");
+	} else if(strcmp(argv[1], "off") == 0) {
+		irqoff_stop();
+		bufferPrintf("Tracking off.\r\n");
+	} else if(strcmp(argv[1], "show") == 0) {
+		irqoff_print((argc >= 3) ? parseNumber(argv[2]) : 16);
+	} else if(strcmp(argv[1], "reset") == 0) {
+		irqoff_reset();
+		bufferPrintf("Interrupt tracking cleared.\r\n");
+	} else {
+		bufferPrintf("Usage: %s <on|off|show|reset> [sites]\r\n", argv[0]);
+	}
+}
+
+void cmd_scrollback(int argc, char** argv) {
+	bufferPrintf("scrollback: %d bytes pending, %d bytes dropped\r\n", getScrollbackLen(), getScrollbackDropped());
+}
+
+void cmd_log(int argc, char** argv) {
+	int i;
+
+	if(argc < 3) {
+		bufferPrintf("Usage: %s <subsystem|all> <on|off>\r\n", argv[0]);
+		bufferPrintf("debug logging (level %d and up compiled out):", LOG_LEVEL + 1);
+		for(i = 0; i < LogSubsystems; i++)
+			bufferPrintf(" %s=%s", log_subsystem_name(i), (LogMask & (1 << i)) ? "on" : "off");
+		bufferPrintf("\r\n");
+		return;
+	}
+
+	uint32_t bits;
+	if(strcmp(argv[1], "all") == 0) {
+		bits = (1 << LogSubsystems) - 1;
+	} else {
+		int subsystem = log_subsystem_find(argv[1]);
+		if(subsystem < 0) {
+			bufferPrintf("log: unknown subsystem %s\r\n", argv[1]);
+			return;
+		}
+		bits = 1 << subsystem;
+	}
+
+	if(strcmp(argv[2], "on") == 0 || strcmp(argv[2], "1") == 0)
+		LogMask |= bits;
+	else
+		LogMask &= ~bits;
+
+	char value[16];
+	sprintf(value, "0x%x", LogMask);
+	nvram_setvar(LOG_MASK_VAR, value);
+	bufferPrintf("log mask is now %s, saveenv to keep it\r\n", value);
+}
+
+void cmd_memcpy_bench(int argc, char** argv) {
+	if(argc < 2) {
+		bufferPrintf("Usage: %s <bytes> [iterations] [misalignment]\r\n", argv[0]);
+		return;
+	}
+
+	uint32_t bytes = parseNumber(argv[1]);
+	uint32_t iterations = (argc > 2) ? parseNumber(argv[2]) : 16;
+	uint32_t misalign = (argc > 3) ? (parseNumber(argv[3]) & 0x3) : 0;
+
+	uint8_t* src = malloc(bytes + 4);
+	uint8_t* dest = malloc(bytes + 4);
+	if(src == NULL || dest == NULL) {
+		bufferPrintf("memcpy_bench: could not allocate buffers\r\n");
+		free(src);
+		free(dest);
+		return;
+	}
+
+	memset(src, 0x5A, bytes + 4);
+
+	uint32_t i;
+	ARMPerfScope perf;
+	uint64_t startTime = timer_get_system_microtime();
+	ARM_PERF_MEASURE(&perf) {
+		for(i = 0; i < iterations; i++)
+			memcpy(dest, src + misalign, bytes);
+	}
+	uint64_t elapsed = timer_get_system_microtime() - startTime;
+
+	if(elapsed == 0)
+		elapsed = 1;
+
+	// bytes per microsecond is MB/s, keep one decimal place
+	uint32_t rate = (uint32_t)(((uint64_t)bytes * iterations * 10) / elapsed);
+	bufferPrintf("memcpy: %d x %d bytes in %d us, %d.%d MB/s\r\n", iterations, bytes, (uint32_t) elapsed, rate / 10, rate % 10);
+	arm_perf_print("memcpy", &perf);
+
+	free(src);
+	free(dest);
+}
+
+void cmd_checksum_bench(int argc, char** argv) {
+	if(argc < 2) {
+		bufferPrintf("Usage: %s <bytes> [iterations]\r\n", argv[0]);
+		return;
+	}
+
+	uint32_t bytes = parseNumber(argv[1]);
+	uint32_t iterations = (argc > 2) ? parseNumber(argv[2]) : 16;
+
+	uint8_t* buffer = malloc(bytes);
+	if(buffer == NULL) {
+		bufferPrintf("checksum_bench: could not allocate buffer\r\n");
+		return;
+	}
+
+	memset(buffer, 0x5A, bytes);
+
+	uint32_t i;
+	uint32_t sum = 0;
+	ARMPerfScope perf;
+	uint64_t startTime = timer_get_system_microtime();
+	ARM_PERF_MEASURE(&perf) {
+		for(i = 0; i < iterations; i++)
+			sum = crc32(NULL, buffer, bytes);
+	}
+	uint64_t elapsed = timer_get_system_microtime() - startTime;
+
+	if(elapsed == 0)
+		elapsed = 1;
+
+	uint32_t rate = (uint32_t)(((uint64_t)bytes * iterations * 10) / elapsed);
+	bufferPrintf("crc32: %d x %d bytes in %d us, %d.%d MB/s (%08x)\r\n", iterations, bytes, (uint32_t) elapsed, rate / 10, rate % 10, sum);
+	arm_perf_print("crc32", &perf);
+
+	startTime = timer_get_system_microtime();
+	ARM_PERF_MEASURE(&perf) {
+		for(i = 0; i < iterations; i++)
+			sum = adler32(buffer, bytes);
+	}
+	elapsed = timer_get_system_microtime() - startTime;
+
+	if(elapsed == 0)
+		elapsed = 1;
+
+	rate = (uint32_t)(((uint64_t)bytes * iterations * 10) / elapsed);
+	bufferPrintf("adler32: %d x %d bytes in %d us, %d.%d MB/s (%08x)\r\n", iterations, bytes, (uint32_t) elapsed, rate / 10, rate % 10, sum);
+	arm_perf_print("adler32", &perf);
+
+	free(buffer);
+}
+
+void cmd_aes_bench(int argc, char** argv) {
+	if(argc < 2) {
+		bufferPrintf("Usage: %s <bytes> [iterations]\r\n", argv[0]);
+		return;
+	}
+
+	uint32_t bytes = parseNumber(argv[1]) & ~0xF;
+	uint32_t iterations = (argc > 2) ? parseNumber(argv[2]) : 16;
+
+	if(bytes == 0) {
+		bufferPrintf("aes_bench: size must be at least 16 bytes\r\n");
+		return;
+	}
+
+	uint8_t* buffer = malloc(bytes);
+	if(buffer == NULL) {
+		bufferPrintf("aes_bench: could not allocate buffer\r\n");
+		return;
+	}
+
+	static const uint32_t customKey[8] = {0};
+	static const char* keyNames[] = {"custom", "GID", "UID"};
+	AESKeyType keyTypes[] = {AESCustom, AESGID, AESUID};
+
+	memset(buffer, 0x5A, bytes);
+
+	// each key is timed once with a full setup per call, then in one session
+	int k;
+	int session;
+	for(k = 0; k < (sizeof(keyTypes) / sizeof(AESKeyType)); k++) {
+		for(session = FALSE; session <= TRUE; session++) {
+			uint32_t i;
+			AESSession aes;
+			ARMPerfScope perf;
+			uint64_t startTime = timer_get_system_microtime();
+			ARM_PERF_MEASURE(&perf) {
+				if(session) {
+					aes_session_open(&aes, FALSE, keyTypes[k], customKey, NULL);
+					for(i = 0; i < iterations; i++)
+						aes_session_process(&aes, buffer, bytes);
+					aes_session_close(&aes);
+				} else {
+					for(i = 0; i < iterations; i++)
+						aes_decrypt(buffer, bytes, keyTypes[k], customKey, NULL);
+				}
+			}
+			uint64_t elapsed = timer_get_system_microtime() - startTime;
+
+			if(elapsed == 0)
+				elapsed = 1;
+
+			uint32_t rate = (uint32_t)(((uint64_t)bytes * iterations * 10) / elapsed);
+			bufferPrintf("aes %s%s: %d x %d bytes in %d us, %d.%d MB/s\r\n", keyNames[k], session ? " session" : "",
+					iterations, bytes, (uint32_t) elapsed, rate / 10, rate % 10);
+			arm_perf_print(keyNames[k], &perf);
+		}
+	}
+
+	free(buffer);
+}
+
+void cmd_blend_bench(int argc, char** argv) {
+	uint32_t width = (argc > 1) ? parseNumber(argv[1]) : 320;
+	uint32_t height = (argc > 2) ? parseNumber(argv[2]) : 480;
+	uint32_t iterations = (argc > 3) ? parseNumber(argv[3]) : 16;
+	uint32_t pixels = width * height;
+
+	if(pixels == 0) {
+		bufferPrintf("Usage: %s [width] [height] [iterations]\r\n", argv[0]);
+		return;
+	}
+
+	uint32_t* dst = malloc(pixels * sizeof(uint32_t));
+	uint32_t* src = malloc(pixels * sizeof(uint32_t));
+	if(dst == NULL || src == NULL) {
+		bufferPrintf("blend_bench: could not allocate buffers\r\n");
+		free(dst);
+		free(src);
+		return;
+	}
+
+	// a spread of alphas, so that neither the opaque nor the clear shortcut wins
+	uint32_t i;
+	for(i = 0; i < pixels; i++) {
+		src[i] = ((i * 7) << 24) | 0x405060;
+		dst[i] = 0x203040;
+	}
+
+	int premultiplied;
+	for(premultiplied = 0; premultiplied < 2; premultiplied++) {
+		const char* name = premultiplied ? "blend premultiplied" : "blend";
+		ARMPerfScope perf;
+		uint64_t startTime = timer_get_system_microtime();
+		ARM_PERF_MEASURE(&perf) {
+			for(i = 0; i < iterations; i++) {
+				if(premultiplied)
+					framebuffer_blend_image_premultiplied(dst, width, height, src, width, height, 0, 0);
+				else
+					framebuffer_blend_image(dst, width, height, src, width, height, 0, 0);
+			}
+		}
+		uint64_t elapsed = timer_get_system_microtime() - startTime;
+
+		if(elapsed == 0)
+			elapsed = 1;
+
+		// pixels per microsecond is megapixels per second
+		uint32_t rate = (uint32_t)(((uint64_t)pixels * iterations * 10) / elapsed);
+		bufferPrintf("%s: %d x %dx%d in %d us, %d.%d Mpixels/s\r\n", name, iterations, width, height, (uint32_t) elapsed, rate / 10, rate % 10);
+		arm_perf_print(name, &perf);
+	}
+
+	free(dst);
+	free(src);
+}
+
+void cmd_perfcount(int argc, char** argv) {
+	int i;
+
+	if(argc < 3) {
+		bufferPrintf("Usage: %s <event0> <event1>\r\n", argv[0]);
+		bufferPrintf("counting %s and %s, the benchmarks report them beside the cycle count\r\n",
+				arm_perf_event_name(arm_perf_event(0)), arm_perf_event_name(arm_perf_event(1)));
+		bufferPrintf("events:");
+		for(i = 0; i <= ARMPerfCycle; i++) {
+			if(arm_perf_event_find(arm_perf_event_name(i)) == i)
+				bufferPrintf(" %s", arm_perf_event_name(i));
+		}
+		bufferPrintf("\r\n");
+		return;
+	}
+
+	int event0 = arm_perf_event_find(argv[1]);
+	int event1 = arm_perf_event_find(argv[2]);
+	if(event0 < 0 || event1 < 0) {
+		bufferPrintf("perfcount: unknown event %s\r\n", (event0 < 0) ? argv[1] : argv[2]);
+		return;
+	}
+
+	arm_perf_select(event0, event1);
+	bufferPrintf("counting %s and %s\r\n", argv[1], argv[2]);
+}
+
+void cmd_tasks(int argc, char** argv) {
+	tasks_list();
+}
+
 void cmd_frequency(int argc, char** argv) {
+	static const char* governors[] = {"auto", "high", "low"};
+
+	if(argc >= 2) {
+		int i;
+		for(i = 0; i <= ClockGovernorLow; i++) {
+			if(strcmp(argv[1], governors[i]) == 0)
+				break;
+		}
+
+		if(i > ClockGovernorLow) {
+			bufferPrintf("Usage: %s [auto|high|low]\r\n", argv[0]);
+			return;
+		}
+
+		clock_set_governor(i);
+	}
+
+	bufferPrintf("Governor: %s, running at %s speed\r\n", governors[clock_get_governor()],
+			(clock_get_performance() == ClockPerformanceHigh) ? "full" : "idle");
 	bufferPrintf("Clock frequency: %d Hz\r\n", clock_get_frequency(FrequencyBaseClock));
 	bufferPrintf("Memory frequency: %d Hz\r\n", clock_get_frequency(FrequencyBaseMemory));
 	bufferPrintf("Bus frequency: %d Hz\r\n", clock_get_frequency(FrequencyBaseBus));
@@ -711,6 +1393,15 @@ void cmd_ftl_mapping(int argc, char** argv) {
 	ftl_printdata();
 }
 
+void cmd_ftl_pools(int argc, char** argv) {
+	ftl_print_pools();
+}
+
+void cmd_nand_calibrate(int argc, char** argv) {
+	int save = (argc >= 2 && strcmp(argv[1], "save") == 0);
+	bufferPrintf("nand_calibrate: %d\r\n", nand_calibrate(save));
+}
+
 void cmd_nand_status(int agc, char** argv) {
 	bufferPrintf("nand status: %x\r\n", nand_read_status());
 }
@@ -765,11 +1456,20 @@ void cmd_iic_write(int argc, char** argv) {
 	buffer[1] = parseNumber(argv[4]);
 
 	int error = i2c_tx(bus, address, buffer, 2);
+
+	if(bus == PMU_I2C_BUS && address == PMU_SETADDR)
+		pmu_forget_shadows();
 	
 	bufferPrintf("result: %d\r\n", error);
 }
 
 void cmd_accel(int argc, char** argv) {
+	SensorSample sample;
+	if(sensors_running() && sensors_latest(&sample) && (sample.valid & SensorAccelValid)) {
+		bufferPrintf("x: %d, y: %d, z: %d (sampled)\r\n", sample.x, sample.y, sample.z);
+		return;
+	}
+
 	int x = accel_get_x();
 	int y = accel_get_y();
 	int z = accel_get_z();
@@ -777,6 +1477,42 @@ void cmd_accel(int argc, char** argv) {
 	bufferPrintf("x: %d, y: %d, z: %d\r\n", x, y, z);
 }
 
+void cmd_sensors(int argc, char** argv) {
+	if(argc >= 2) {
+		if(strcmp(argv[1], "off") == 0) {
+			sensors_stop();
+			bufferPrintf("sensors: stopped\r\n");
+		} else if(sensors_start(parseNumber(argv[1])) == 0) {
+			bufferPrintf("sensors: sampling every %d us\r\n", parseNumber(argv[1]));
+		} else {
+			bufferPrintf("Usage: %s [interval in us|off]\r\n", argv[0]);
+		}
+		return;
+	}
+
+	// everything still in the ring, oldest first
+	SensorSample samples[8];
+	uint32_t cursor = 0;
+	int printed = 0;
+	int count;
+
+	// at most a ring's worth, should new ones come in as fast as this prints
+	while(printed < SENSORS_RING && (count = sensors_read(&cursor, samples, sizeof(samples) / sizeof(SensorSample))) > 0) {
+		int i;
+		printed += count;
+		for(i = 0; i < count; i++) {
+			bufferPrintf("%d us: ", (uint32_t) samples[i].time);
+			if(samples[i].valid & SensorAccelValid)
+				bufferPrintf("x: %d, y: %d, z: %d ", samples[i].x, samples[i].y, samples[i].z);
+			if(samples[i].valid & SensorLightValid)
+				bufferPrintf("light: %d", samples[i].light);
+			bufferPrintf("\r\n");
+		}
+	}
+
+	bufferPrintf("sensors: %s, %d samples missed\r\n", sensors_running() ? "running" : "stopped", sensors_missed());
+}
+
 #ifndef CONFIG_IPOD
 void cmd_als(int argc, char** argv) {
 	bufferPrintf("data = %d\r\n", als_data());
@@ -803,6 +1539,35 @@ void cmd_als_dis(int argc, char** argv) {
 	bufferPrintf("Disabling ALS interrupt.\r\n");
 	als_disable_interrupt();
 }
+
+void cmd_camera_reg(int argc, char** argv) {
+	if(argc < 2) {
+		bufferPrintf("Usage: %s <register> [value]\r\n", argv[0]);
+		return;
+	}
+
+	uint16_t reg = parseNumber(argv[1]);
+	if(argc >= 3) {
+		camera_writew(reg, parseNumber(argv[2]));
+		i2c_flush(CAMERA_I2C);
+	}
+
+	bufferPrintf("camera: 0x%04x = 0x%04x\r\n", reg, camera_readw(reg));
+}
+
+void cmd_camera_regs(int argc, char** argv) {
+	if(argc < 3) {
+		bufferPrintf("Usage: %s <address> <count>\r\n", argv[0]);
+		bufferPrintf("writes a table of 16 bit register, value pairs, register 0x%x waits value ms\r\n", CAMERA_DELAY);
+		return;
+	}
+
+	uint32_t address = parseNumber(argv[1]);
+	int count = parseNumber(argv[2]);
+
+	camera_write_regs((const CameraRegister*) address, count);
+	bufferPrintf("camera: wrote %d registers\r\n", count);
+}
 #endif
 
 void cmd_sdio_status(int argc, char** argv) {
@@ -866,6 +1631,47 @@ void cmd_audiohw_play_pcm(int argc, char** argv)
 	}
 }
 
+typedef struct MemoryStream {
+	const uint8_t* next;
+	uint32_t left;
+} MemoryStream;
+
+static uint32_t memory_stream_refill(void* buffer, uint32_t size, void* opaque)
+{
+	MemoryStream* stream = (MemoryStream*) opaque;
+	if(size > stream->left)
+		size = stream->left;
+
+	memcpy(buffer, stream->next, size);
+	stream->next += size;
+	stream->left -= size;
+	return size;
+}
+
+void cmd_audiohw_play_stream(int argc, char** argv)
+{
+	static MemoryStream stream;
+
+	if(argc < 3) {
+		bufferPrintf("Usage: %s <address> <len> [use-headphones]\r\n", argv[0]);
+		return;
+	}
+
+	stream.next = (const uint8_t*) parseNumber(argv[1]);
+	stream.left = parseNumber(argv[2]);
+	int useHeadphones = (argc > 3) ? parseNumber(argv[3]) : 0;
+
+	bufferPrintf("streaming PCM 0x%x - 0x%x using %s\r\n", (uint32_t) stream.next, (uint32_t) stream.next + stream.left, useHeadphones ? "headphones" : "speakers");
+	if(audiohw_play_stream(memory_stream_refill, &stream, !useHeadphones) != 0)
+		bufferPrintf("audio: could not start the stream\r\n");
+}
+
+void cmd_usbaudio(int argc, char** argv)
+{
+	uint32_t seconds = (argc > 1) ? parseNumber(argv[1]) : 0;
+	usbaudio_run(seconds);
+}
+
 void cmd_audiohw_headphone_vol(int argc, char** argv)
 {
 	if(argc < 2)
@@ -953,6 +1759,33 @@ void cmd_multitouch_setup(int argc, char** argv)
 }
 #endif
 
+void cmd_multitouch_events(int argc, char** argv)
+{
+	if(argc >= 2 && strcmp(argv[1], "on") == 0)
+	{
+		multitouch_set_verbose(TRUE);
+		return;
+	} else if(argc >= 2 && strcmp(argv[1], "off") == 0)
+	{
+		multitouch_set_verbose(FALSE);
+		return;
+	} else if(argc >= 2)
+	{
+		bufferPrintf("Usage: %s [on|off]\r\n", argv[0]);
+		return;
+	}
+
+	MultitouchEvent event;
+	while(multitouch_read_events(&event, 1) == 1)
+	{
+		bufferPrintf("%u: frame %d finger %d/%d -- id=%d, event=%d, X(%d, vel: %d), Y(%d, vel: %d)\r\n",
+				event.timestamp, event.frameNum, event.finger, event.numFingers,
+				event.data.id, event.data.event, event.data.x, event.data.velX, event.data.y, event.data.velY);
+	}
+
+	bufferPrintf("%u events dropped\r\n", multitouch_dropped());
+}
+
 void cmd_wlan_prog_helper(int argc, char** argv) {
 	if(argc < 3) {
 		bufferPrintf("Usage: %s <address> <len>\r\n", argv[0]);
@@ -1133,6 +1966,7 @@ OPIBCommand CommandList[] =
 		{"nand_write", "write a page of NAND", cmd_nand_write},
 		{"nand_read_spare", "read a page of NAND's spare into RAM", cmd_nand_read_spare},
 		{"nand_status", "read NAND status", cmd_nand_status},
+		{"nand_calibrate", "find the fastest reliable NAND timing, [save] it to nvram", cmd_nand_calibrate},
 		{"nand_ecc", "hardware ECC a page", cmd_nand_ecc},
 		{"nand_erase", "erase a NAND block", cmd_nand_erase},
 		{"vfl_read", "read a page of VFL into RAM", cmd_vfl_read},
@@ -1140,8 +1974,19 @@ OPIBCommand CommandList[] =
 		{"ftl_read", "read a page of FTL into RAM", cmd_ftl_read},
 		{"ftl_mapping", "print FTL mapping information", cmd_ftl_mapping},
 		{"ftl_sync", "commit the current FTL context", cmd_ftl_sync},
+		{"ftl_pools", "display the FTL page and spare buffer pools", cmd_ftl_pools},
 		{"bdev_read", "read bytes from a NAND block device", cmd_bdev_read},
+		{"hash", "checksum memory, NOR, VFL or FTL block by block", cmd_hash},
+		{"latency", "display (or reset) the storage latency histograms", cmd_latency},
+		{"iotrace", "record storage operations into a trace ring", cmd_iotrace},
+		{"bootprof", "display the boot timeline", cmd_bootprof},
+		{"bench", "benchmark reads and writes on the storage layers", cmd_bench},
+		{"membench", "measure memory bandwidth, cached and uncached", cmd_membench},
+		{"usbacm", "switch the USB console between OpenIBoot and a CDC-ACM serial port", cmd_usbacm},
 #ifndef NO_HFS
+		{"bdev_cache", "display the block device page cache stats", cmd_bdev_cache},
+		{"bdev_key", "read and write a partition through the AES engine", cmd_bdev_key},
+		{"usbmsc", "export the NAND to the host as a USB disk until it is ejected", cmd_usbmsc},
 		{"fs_ls", "list files and folders", fs_cmd_ls},
 		{"fs_cat", "display a file", fs_cmd_cat},
 		{"fs_extract", "extract a file into memory", fs_cmd_extract},
@@ -1153,11 +1998,14 @@ OPIBCommand CommandList[] =
 		{"iic_read", "read a IIC register", cmd_iic_read},
 		{"iic_write", "write a IIC register", cmd_iic_write},
 		{"accel", "display accelerometer data", cmd_accel},
+		{"sensors", "sample the accelerometer and light sensor in the background, or show the samples", cmd_sensors},
 #ifndef CONFIG_IPOD
 		{"als", "display ambient light sensor data", cmd_als},
 		{"als_channel", "set channel to get ALS data from", cmd_als_channel},
 		{"als_en", "enable continuous reporting of ALS data", cmd_als_en},
 		{"als_dis", "disable continuous reporting of ALS data", cmd_als_dis},
+		{"camera_reg", "read or write a camera sensor register", cmd_camera_reg},
+		{"camera_regs", "write a table of camera sensor registers", cmd_camera_regs},
 #endif
 		{"sdio_status", "display sdio registers", cmd_sdio_status},
 		{"sdio_setup", "restart SDIO stuff", cmd_sdio_setup},
@@ -1180,23 +2028,41 @@ OPIBCommand CommandList[] =
 		{"pmu_charge", "turn on and off the power charger", cmd_pmu_charge},
 		{"pmu_nvram", "list powernvram registers", cmd_pmu_nvram},
 		{"malloc_stats", "display malloc stats", cmd_malloc_stats},
-		{"frequency", "display clock frequencies", cmd_frequency},
+		{"heap", "profile heap usage by allocation site", cmd_heap},
+		{"profile", "sample where the CPU spends its time", cmd_profile},
+		{"irqoff", "find what keeps interrupts off the longest", cmd_irqoff},
+		{"memcpy_bench", "measure memcpy throughput", cmd_memcpy_bench},
+		{"aes_bench", "measure AES decryption throughput", cmd_aes_bench},
+		{"checksum_bench", "measure crc32 and adler32 throughput", cmd_checksum_bench},
+		{"blend_bench", "measure alpha blending throughput", cmd_blend_bench},
+		{"perfcount", "pick the events the benchmarks count", cmd_perfcount},
+		{"scrollback", "display console scrollback usage", cmd_scrollback},
+		{"log", "turn debug logging on or off per subsystem", cmd_log},
+		{"frequency", "display clock frequencies and pick the governor", cmd_frequency},
+		{"tasks", "list the running tasks", cmd_tasks},
 		{"printenv", "list the environment variables in nvram", cmd_printenv},
 		{"setenv", "sets an environment variable", cmd_setenv},
 		{"saveenv", "saves the environment variables in nvram", cmd_saveenv},
+		{"script", "compile and run a script in memory", cmd_script},
 		{"bgcolor", "fill the framebuffer with a color", cmd_bgcolor},
 		{"backlight", "set the backlight level", cmd_backlight},
 		{"kernel", "load a Linux kernel", cmd_kernel},
 		{"ramdisk", "load a Linux ramdisk", cmd_ramdisk},
 		{"rootfs", "specify a file as the Linux rootfs", cmd_rootfs},
 		{"boot", "boot a Linux kernel", cmd_boot},
+#ifndef NO_HFS
+		{"linux_load", "load the kernel and initrd from the filesystem without booting them", cmd_linux_load},
+#endif
 		{"go", "jump to a specified address (interrupts disabled)", cmd_go},
 		{"jump", "jump to a specified address (interrupts enabled)", cmd_jump},
+		{"go_warm", "chainload another openiboot, keeping the display up", cmd_go_warm},
 		{"version", "display the version string", cmd_version},
 		{"time", "display the current time according to the RTC", cmd_time},
 		{"wdt", "display the current wdt stats", cmd_wdt},
 		{"audiohw_transfers_done", "display how many times the audio buffer has been played", cmd_audiohw_transfers_done},
 		{"audiohw_play_pcm", "queue some PCM data for playback", cmd_audiohw_play_pcm},
+		{"audiohw_play_stream", "play PCM data through the streaming ring", cmd_audiohw_play_stream},
+		{"usbaudio", "stream what the codec captures to the host over USB until it stops it", cmd_usbaudio},
 		{"audiohw_headphone_vol", "set the headphone volume", cmd_audiohw_headphone_vol},
 #ifndef CONFIG_IPOD
 		{"audiohw_speaker_vol", "set the speaker volume", cmd_audiohw_speaker_vol},
@@ -1209,6 +2075,77 @@ OPIBCommand CommandList[] =
 		{"play", "play notes using piezo bytes", cmd_piezo_play},
 #endif
 		{"multitouch_setup", "setup the multitouch chip", cmd_multitouch_setup},
+		{"multitouch_events", "print queued touch events, or every frame as it arrives with on", cmd_multitouch_events},
 		{"help", "list the available commands", cmd_help},
 		{NULL, NULL}
 	};
+
+// Open-addressed hash over CommandList, must be a power of two comfortably
+// larger than the number of commands.
+#define COMMAND_HASH_SIZE 256
+
+static uint16_t CommandHash[COMMAND_HASH_SIZE];
+static int CommandHashReady = FALSE;
+
+static uint32_t command_hash(const char* name) {
+	uint32_t hash = 5381;
+	while(*name != '\0')
+		hash = (hash * 33) ^ (uint8_t)*(name++);
+	return hash;
+}
+
+int commands_setup() {
+	int i;
+	memset(CommandHash, 0, sizeof(CommandHash));
+
+	// slots hold index + 1 so zero means empty
+	for(i = 0; CommandList[i].name != NULL; i++) {
+		uint32_t slot = command_hash(CommandList[i].name) & (COMMAND_HASH_SIZE - 1);
+		while(CommandHash[slot] != 0)
+			slot = (slot + 1) & (COMMAND_HASH_SIZE - 1);
+
+		CommandHash[slot] = i + 1;
+
+		if(i >= (COMMAND_HASH_SIZE / 2)) {
+			bufferPrintf("commands: too many commands for hash table\r\n");
+			return -1;
+		}
+	}
+
+	CommandHashReady = TRUE;
+	return 0;
+}
+
+OPIBCommand* command_find(const char* name) {
+	if(!CommandHashReady) {
+		if(commands_setup() != 0) {
+			OPIBCommand* curCommand = CommandList;
+			while(curCommand->name != NULL) {
+				if(strcmp(name, curCommand->name) == 0)
+					return curCommand;
+				curCommand++;
+			}
+			return NULL;
+		}
+	}
+
+	uint32_t slot = command_hash(name) & (COMMAND_HASH_SIZE - 1);
+	while(CommandHash[slot] != 0) {
+		OPIBCommand* curCommand = &CommandList[CommandHash[slot] - 1];
+		if(strcmp(name, curCommand->name) == 0)
+			return curCommand;
+		slot = (slot + 1) & (COMMAND_HASH_SIZE - 1);
+	}
+
+	return NULL;
+}
+
+int command_run(int argc, char** argv) {
+	OPIBCommand* command = command_find(argv[0]);
+	if(command == NULL)
+		return FALSE;
+
+	heapprof_command();
+	command->routine(argc, argv);
+	return TRUE;
+}
@@ -6,13 +6,22 @@
 #include "timer.h"
 #include "interrupt.h"
 #include "openiboot-asmhelpers.h"
+#include "mmu.h"
+
+// I2S0 can use either controller, but is kept on DMAC1 with I2S1 when that
+// is routed as FIQ, so all the audio completions come in that way.
+#ifndef NO_AUDIO_FIQ
+#define I2S0_CONTROLLERS 2
+#else
+#define I2S0_CONTROLLERS 3
+#endif
 
 static const int ControllerLookupTable[] = {
 	1, 1, 1, 1, 1,
 	1, 1, 1, 1, 1,
 	2, 2, 2, 2, 2,
-	2, 2, 2, 2, 3,
-	3, 3, 3, 3, 3,
+	2, 2, 2, 2, I2S0_CONTROLLERS,
+	I2S0_CONTROLLERS, 3, 3, 3, 3,
 	3
 };
 
@@ -37,28 +46,162 @@ static const uint32_t PeripheralLookupTable[][DMA_NUMCONTROLLERS] = {
 static volatile DMARequest requests[DMA_NUMCONTROLLERS][DMA_NUMCHANNELS];
 static DMALinkedList* DMALists[DMA_NUMCONTROLLERS][DMA_NUMCHANNELS];
 
-static DMALinkedList StaticDMALists[DMA_NUMCONTROLLERS][DMA_NUMCHANNELS];
+static DMALinkedList (*StaticDMALists)[DMA_NUMCHANNELS];
 
 static void dispatchRequest(volatile DMARequest *request, int controller, int channel);
 
 static void dmaIRQHandler(uint32_t controller);
 
-static volatile int Controller0FreeChannels[DMA_NUMCHANNELS] = {0};
-static volatile int Controller1FreeChannels[DMA_NUMCHANNELS] = {0};
+// one bit per channel
+static volatile uint32_t ChannelsInUse[DMA_NUMCONTROLLERS] = {0};
+static volatile uint32_t ChannelsReserved[DMA_NUMCONTROLLERS] = {0};
+
+// Descriptors for scatter-gather transfers, handed out through a free list so
+// that building a chain never has to go to the heap.
+#ifndef DMA_LLI_POOL_SIZE
+#define DMA_LLI_POOL_SIZE 128
+#endif
+
+// largest transfer count of one descriptor, in units of the transfer width
+#define DMA_LLI_MAX_TRANSFERS 0xE00
+
+static DMALinkedList* LLIPool;
+static DMALinkedList* LLIFree = NULL;
+static DMALinkedList* PoolLists[DMA_NUMCONTROLLERS][DMA_NUMCHANNELS];
+
+// One bit per DMA_ALIGN block of the coherent region in CoherentUsed, and in
+// CoherentEnds a bit on the last block of every allocation.
+#define DMA_COHERENT_BLOCKS (DMA_COHERENT_SIZE / DMA_ALIGN)
+
+static uint8_t* CoherentRegion = NULL;
+static uint32_t CoherentUsed[DMA_COHERENT_BLOCKS / 32];
+static uint32_t CoherentEnds[DMA_COHERENT_BLOCKS / 32];
+
+#define COHERENT_BIT(bitmap, i) ((bitmap)[(i) >> 5] & (1 << ((i) & 31)))
 
 int dma_setup() {
 	clock_gate_switch(DMAC0_CLOCKGATE, ON);
 	clock_gate_switch(DMAC1_CLOCKGATE, ON);
 
 	interrupt_install(DMAC0_INTERRUPT, dmaIRQHandler, 1);
+#ifndef NO_AUDIO_FIQ
+	interrupt_install_fiq(DMAC1_INTERRUPT, dmaIRQHandler, 2);
+#else
 	interrupt_install(DMAC1_INTERRUPT, dmaIRQHandler, 2);
+#endif
+
+	// completions preempt every other IRQ, so audio and NAND keep streaming
+	interrupt_set_priority(DMAC0_INTERRUPT, DMA_INTERRUPT_PRIORITY);
+	interrupt_set_priority(DMAC1_INTERRUPT, DMA_INTERRUPT_PRIORITY);
 
 	interrupt_enable(DMAC0_INTERRUPT);
 	interrupt_enable(DMAC1_INTERRUPT);
 
+	if(LLIPool == NULL) {
+		LLIPool = dma_coherent_alloc(sizeof(DMALinkedList) * DMA_LLI_POOL_SIZE);
+		StaticDMALists = dma_coherent_alloc(sizeof(DMALinkedList) * DMA_NUMCONTROLLERS * DMA_NUMCHANNELS);
+		if(LLIPool == NULL || StaticDMALists == NULL) {
+			bufferPrintf("dma: out of coherent memory\r\n");
+			return -1;
+		}
+	}
+
+	int i;
+	LLIFree = NULL;
+	for(i = DMA_LLI_POOL_SIZE - 1; i >= 0; i--) {
+		LLIPool[i].next = LLIFree;
+		LLIFree = &LLIPool[i];
+	}
+
 	return 0;
 }
 
+void dma_coherent_map() {
+	uint32_t section;
+
+	// Before the MMU is up nothing is cached anyway
+	if(CoherentRegion == NULL || CurrentPageTable == NULL)
+		return;
+
+	// Nothing of the region may be left in the cache once it stops covering it
+	CleanAndInvalidateDataCacheRange(CoherentRegion, DMA_COHERENT_SIZE);
+
+	for(section = (uint32_t) CoherentRegion; section < ((uint32_t) CoherentRegion + DMA_COHERENT_SIZE); section += MMU_SECTION_SIZE)
+		mmu_map_section(section, section, FALSE, TRUE);
+}
+
+void* dma_coherent_alloc(uint32_t size) {
+	uint32_t blocks = (size + DMA_ALIGN - 1) / DMA_ALIGN;
+	uint32_t start;
+	uint32_t i;
+
+	if(blocks == 0)
+		blocks = 1;
+
+	EnterCriticalSection();
+
+	if(CoherentRegion == NULL) {
+		CoherentRegion = memalign(MMU_SECTION_SIZE, DMA_COHERENT_SIZE);
+		if(CoherentRegion == NULL) {
+			LeaveCriticalSection();
+			return NULL;
+		}
+		dma_coherent_map();
+	}
+
+	start = 0;
+	while(start + blocks <= DMA_COHERENT_BLOCKS) {
+		for(i = 0; i < blocks; i++) {
+			if(COHERENT_BIT(CoherentUsed, start + i))
+				break;
+		}
+
+		if(i == blocks) {
+			for(i = start; i < (start + blocks); i++)
+				CoherentUsed[i >> 5] |= 1 << (i & 31);
+			CoherentEnds[(start + blocks - 1) >> 5] |= 1 << ((start + blocks - 1) & 31);
+			LeaveCriticalSection();
+
+			memset(CoherentRegion + (start * DMA_ALIGN), 0, blocks * DMA_ALIGN);
+			return CoherentRegion + (start * DMA_ALIGN);
+		}
+
+		start += i + 1;
+	}
+
+	LeaveCriticalSection();
+	return NULL;
+}
+
+void dma_coherent_free(void* ptr) {
+	uint32_t i;
+
+	if(ptr == NULL)
+		return;
+
+	if(!dma_coherent_contains(ptr)) {
+		bufferPrintf("dma: 0x%x is not coherent memory\r\n", (uint32_t) ptr);
+		return;
+	}
+
+	EnterCriticalSection();
+	i = ((uint8_t*) ptr - CoherentRegion) / DMA_ALIGN;
+	while(TRUE) {
+		int last = COHERENT_BIT(CoherentEnds, i) != 0;
+		CoherentUsed[i >> 5] &= ~(1 << (i & 31));
+		CoherentEnds[i >> 5] &= ~(1 << (i & 31));
+		if(last)
+			break;
+		i++;
+	}
+	LeaveCriticalSection();
+}
+
+int dma_coherent_contains(const void* ptr) {
+	return CoherentRegion != NULL && (const uint8_t*) ptr >= CoherentRegion
+		&& (const uint8_t*) ptr < (CoherentRegion + DMA_COHERENT_SIZE);
+}
+
 static void dmaIRQHandler(uint32_t controller) {
 	uint32_t intTCStatusReg;
 	uint32_t intTCClearReg;
@@ -85,28 +228,20 @@ static void dmaIRQHandler(uint32_t controller) {
 }
 
 static int getFreeChannel(int* controller, int* channel) {
+	int c;
 	int i;
 
 	EnterCriticalSection();
 
-	if((*controller & (1 << 0)) != 0) {
-		for(i = 0; i < DMA_NUMCHANNELS; i++) {
-			if(Controller0FreeChannels[i] == 0) {
-				*controller = 1;
-				*channel = i;
-				Controller0FreeChannels[i] = 1;
-				LeaveCriticalSection();
-				return 0;
-			}
-		}
-	}
+	for(c = 0; c < DMA_NUMCONTROLLERS; c++) {
+		if((*controller & (1 << c)) == 0 || ChannelsInUse[c] == ((1 << DMA_NUMCHANNELS) - 1))
+			continue;
 
-	if((*controller & (1 << 1)) != 0) {
 		for(i = 0; i < DMA_NUMCHANNELS; i++) {
-			if(Controller1FreeChannels[i] == 0) {
-				*controller = 2;
+			if((ChannelsInUse[c] & (1 << i)) == 0) {
+				*controller = c + 1;
 				*channel = i;
-				Controller1FreeChannels[i] = 1;
+				ChannelsInUse[c] |= 1 << i;
 				LeaveCriticalSection();
 				return 0;
 			}
@@ -117,6 +252,59 @@ static int getFreeChannel(int* controller, int* channel) {
 	return ERROR_BUSY;
 }
 
+static void resetRequest(int controller, int channel, DMAHandler handler) {
+	requests[controller - 1][channel].started = TRUE;
+	requests[controller - 1][channel].done = FALSE;
+	requests[controller - 1][channel].handler = handler;
+	completion_init((Completion*) &requests[controller - 1][channel].completion);
+}
+
+static void freePoolList(int controller, int channel) {
+	DMALinkedList* item = PoolLists[controller - 1][channel];
+	if(item == NULL)
+		return;
+
+	EnterCriticalSection();
+	// a cyclic list comes back round to the head instead of ending
+	while(item->next != NULL && item->next != PoolLists[controller - 1][channel])
+		item = item->next;
+	item->next = LLIFree;
+	LLIFree = PoolLists[controller - 1][channel];
+	PoolLists[controller - 1][channel] = NULL;
+	LeaveCriticalSection();
+}
+
+// Takes a channel that can move data between Source and Destination and keeps
+// it out of the pool until dma_release, so that frequent users do not have to
+// look for one on every transfer. Pass the returned controller and channel to
+// dma_request as they are.
+int dma_reserve(int Source, int Destination, int* controller, int* channel) {
+	*controller = ControllerLookupTable[Source] & ControllerLookupTable[Destination];
+	if(*controller == 0)
+		return ERROR_DMA;
+
+	if(getFreeChannel(controller, channel) != 0)
+		return ERROR_BUSY;
+
+	EnterCriticalSection();
+	ChannelsReserved[*controller - 1] |= 1 << *channel;
+	LeaveCriticalSection();
+
+	return 0;
+}
+
+void dma_release(int controller, int channel) {
+	dma_pause(controller, channel);
+	freePoolList(controller, channel);
+
+	EnterCriticalSection();
+	requests[controller - 1][channel].started = FALSE;
+	requests[controller - 1][channel].done = FALSE;
+	ChannelsReserved[controller - 1] &= ~(1 << channel);
+	ChannelsInUse[controller - 1] &= ~(1 << channel);
+	LeaveCriticalSection();
+}
+
 int dma_request(int Source, int SourceTransferWidth, int SourceBurstSize, int Destination, int DestinationTransferWidth, int DestinationBurstSize, int* controller, int* channel, DMAHandler handler) {
 	if(*controller == 0) {
 		*controller = ControllerLookupTable[Source] & ControllerLookupTable[Destination];
@@ -126,9 +314,9 @@ int dma_request(int Source, int SourceTransferWidth, int SourceBurstSize, int De
 		}
 
 		while(getFreeChannel(controller, channel) == ERROR_BUSY);
-		requests[*controller - 1][*channel].started = TRUE;
-		requests[*controller - 1][*channel].done = FALSE;
-		requests[*controller - 1][*channel].handler = handler;
+		resetRequest(*controller, *channel, handler);
+	} else if(*controller <= DMA_NUMCONTROLLERS && (ChannelsReserved[*controller - 1] & (1 << *channel)) != 0) {
+		resetRequest(*controller, *channel, handler);
 	}
 
 	uint32_t DMACControl;
@@ -173,6 +361,46 @@ int dma_request(int Source, int SourceTransferWidth, int SourceBurstSize, int De
 	return 0;
 }
 
+typedef struct DMARoute {
+	uint32_t source;
+	uint32_t destination;
+	uint32_t sourcePeripheral;
+	uint32_t destPeripheral;
+	uint32_t flowControl;
+	uint32_t sourceIncrement;
+	uint32_t destinationIncrement;
+} DMARoute;
+
+// Works out addresses, peripheral numbers and flow control for a transfer.
+// Source and Destination are peripheral numbers or memory addresses.
+static void dma_route(uint32_t Source, uint32_t Destination, int controller, DMARoute* route) {
+	route->sourceIncrement = 0;
+	route->destinationIncrement = 0;
+
+	if(Source <= (sizeof(AddressLookupTable)/sizeof(uint32_t))) {
+		route->source = AddressLookupTable[Source];
+		route->sourcePeripheral = PeripheralLookupTable[Source][controller - 1];
+	} else {
+		route->source = Source;
+		route->sourcePeripheral = PeripheralLookupTable[DMA_MEMORY][controller - 1];
+		route->sourceIncrement = 1 << DMAC0Control0_SOURCEINCREMENT;
+	}
+
+	if(Destination <= (sizeof(AddressLookupTable)/sizeof(uint32_t))) {
+		route->destination = AddressLookupTable[Destination];
+		route->destPeripheral = PeripheralLookupTable[Destination][controller - 1];
+	} else {
+		route->destination = Destination;
+		route->destPeripheral = PeripheralLookupTable[DMA_MEMORY][controller - 1];
+		route->destinationIncrement = 1 << DMAC0Control0_DESTINATIONINCREMENT;
+	}
+
+	if(route->sourceIncrement == 0)
+		route->flowControl = (route->destinationIncrement == 0) ? DMAC0Configuration_FLOWCNTRL_P2P : DMAC0Configuration_FLOWCNTRL_P2M;
+	else
+		route->flowControl = (route->destinationIncrement == 0) ? DMAC0Configuration_FLOWCNTRL_M2P : DMAC0Configuration_FLOWCNTRL_M2M;
+}
+
 int dma_perform(uint32_t Source, uint32_t Destination, int size, int continueList, int* controller, int* channel) {
 	uint32_t regSrcAddress;
 	uint32_t regDestAddress;
@@ -198,45 +426,13 @@ int dma_perform(uint32_t Source, uint32_t Destination, int size, int continueLis
 
 	int transfers = size/(1 << DMAC0Control0_DWIDTH(GET_REG(regControl0)));
 
-	uint32_t sourcePeripheral = 0;
-	uint32_t destPeripheral = 0;
-	uint32_t flowControl = 0;
-	uint32_t sourceIncrement = 0;
-	uint32_t destinationIncrement = 0;
+	DMARoute route;
+	dma_route(Source, Destination, *controller, &route);
+	SET_REG(regSrcAddress, route.source);
+	SET_REG(regDestAddress, route.destination);
 
-	if(Source <= (sizeof(AddressLookupTable)/sizeof(uint32_t))) {
-		if(Destination <= (sizeof(AddressLookupTable)/sizeof(uint32_t))) {
-			SET_REG(regSrcAddress, AddressLookupTable[Source]);
-			SET_REG(regDestAddress, AddressLookupTable[Destination]);
-			sourcePeripheral = PeripheralLookupTable[Source][*controller - 1];
-			destPeripheral = PeripheralLookupTable[Destination][*controller - 1];
-			flowControl =  DMAC0Configuration_FLOWCNTRL_P2P;
-		} else {
-			SET_REG(regSrcAddress, AddressLookupTable[Source]);
-			SET_REG(regDestAddress, Destination);
-			sourcePeripheral = PeripheralLookupTable[Source][*controller - 1];
-			destPeripheral = PeripheralLookupTable[DMA_MEMORY][*controller - 1];
-			flowControl =  DMAC0Configuration_FLOWCNTRL_P2M;
-			destinationIncrement = 1 << DMAC0Control0_DESTINATIONINCREMENT;
-		}
-	} else {
-		if(Destination <= (sizeof(AddressLookupTable)/sizeof(uint32_t))) {
-			SET_REG(regSrcAddress, Source);
-			SET_REG(regDestAddress, AddressLookupTable[Destination]);
-			sourcePeripheral = PeripheralLookupTable[DMA_MEMORY][*controller - 1];
-			destPeripheral = PeripheralLookupTable[Destination][*controller - 1];
-			flowControl =  DMAC0Configuration_FLOWCNTRL_M2P;
-			sourceIncrement = 1 << DMAC0Control0_SOURCEINCREMENT;
-		} else {
-			SET_REG(regSrcAddress, Source);
-			SET_REG(regDestAddress, Destination);
-			sourcePeripheral = PeripheralLookupTable[DMA_MEMORY][*controller - 1];
-			destPeripheral = PeripheralLookupTable[DMA_MEMORY][*controller - 1];
-			flowControl =  DMAC0Configuration_FLOWCNTRL_M2M;
-			sourceIncrement = 1 << DMAC0Control0_SOURCEINCREMENT;
-			destinationIncrement = 1 << DMAC0Control0_DESTINATIONINCREMENT;
-		}
-	}
+	uint32_t sourceIncrement = route.sourceIncrement;
+	uint32_t destinationIncrement = route.destinationIncrement;
 
 	if(!continueList) {
 		uint32_t src = GET_REG(regSrcAddress);
@@ -245,9 +441,14 @@ int dma_perform(uint32_t Source, uint32_t Destination, int size, int continueLis
 			SET_REG(regControl0, GET_REG(regControl0) & ~(1 << DMAC0Control0_TERMINALCOUNTINTERRUPTENABLE));
 
 			if(DMALists[*controller - 1][*channel])
-				free(DMALists[*controller - 1][*channel]);
+				dma_coherent_free(DMALists[*controller - 1][*channel]);
+
+			DMALinkedList* item = DMALists[*controller - 1][*channel] = dma_coherent_alloc(((transfers + 0xDFF) / 0xE00) * sizeof(DMALinkedList));
+			if(item == NULL) {
+				bufferPrintf("dma: out of coherent memory\r\n");
+				return ERROR_BUSY;
+			}
 
-			DMALinkedList* item = DMALists[*controller - 1][*channel] = malloc(((transfers + 0xDFF) / 0xE00) * sizeof(DMALinkedList));
 			SET_REG(regLLI, (uint32_t)item);
 			do {
 				transfers -= 0xE00;
@@ -273,7 +474,6 @@ int dma_perform(uint32_t Source, uint32_t Destination, int size, int continueLis
 				}
 			} while(transfers > 0xE00);
 
-			CleanAndInvalidateCPUDataCache();
 			transfers = 0xE00;
 		} else {
 			SET_REG(regLLI, 0);
@@ -285,33 +485,218 @@ int dma_perform(uint32_t Source, uint32_t Destination, int size, int continueLis
 
 	SET_REG(regControl0, (GET_REG(regControl0) & regControl0Mask) | destinationIncrement | sourceIncrement | (transfers & DMAC0Control0_SIZEMASK));
 	SET_REG(regConfiguration, DMAC0Configuration_CHANNELENABLED | DMAC0Configuration_TERMINALCOUNTINTERRUPTMASK
-			| (flowControl << DMAC0Configuration_FLOWCNTRLSHIFT)
-			| (destPeripheral << DMAC0Configuration_DESTPERIPHERALSHIFT)
-			| (sourcePeripheral << DMAC0Configuration_SRCPERIPHERALSHIFT));
+			| (route.flowControl << DMAC0Configuration_FLOWCNTRLSHIFT)
+			| (route.destPeripheral << DMAC0Configuration_DESTPERIPHERALSHIFT)
+			| (route.sourcePeripheral << DMAC0Configuration_SRCPERIPHERALSHIFT));
 
 	return 0;
 }
 
-int dma_finish(int controller, int channel, int timeout) {
-	uint64_t startTime = timer_get_system_microtime();
-	while(!requests[controller - 1][channel].done) {
-		if(has_elapsed(startTime, timeout * 1000)) {
-			return -1;
+static int dma_perform_list(uint32_t Source, uint32_t Destination, const DMASegment* segments, int numSegments, int cyclic, int* controller, int* channel) {
+	int memoryIsDestination;
+
+	if(Destination == DMA_MEMORY && Source != DMA_MEMORY)
+		memoryIsDestination = TRUE;
+	else if(Source == DMA_MEMORY && Destination != DMA_MEMORY)
+		memoryIsDestination = FALSE;
+	else
+		return ERROR_DMA;
+
+	if(numSegments <= 0)
+		return ERROR_DMA;
+
+	uint32_t regOffset = (*channel * DMAChannelRegSize);
+
+	if(*controller == 1) {
+		regOffset += DMAC0;
+	} else if(*controller == 2) {
+		regOffset += DMAC1;
+	} else {
+		return ERROR_DMA;
+	}
+
+	const uint32_t regControl0Mask = ~(DMAC0Control0_SIZEMASK | DMAC0Control0_SOURCEINCREMENT | DMAC0Control0_DESTINATIONINCREMENT
+			| (1 << DMAC0Control0_TERMINALCOUNTINTERRUPTENABLE));
+	uint32_t control = GET_REG(regOffset + DMAC0Control0) & regControl0Mask;
+	uint32_t widthShift = DMAC0Control0_DWIDTH(control);
+	uint32_t widthMask = (1 << widthShift) - 1;
+
+	int i;
+	int needed = 0;
+	for(i = 0; i < numSegments; i++) {
+		if(((segments[i].address | segments[i].size) & (widthMask | 0x3)) != 0 || segments[i].size == 0) {
+			// every segment has to be aligned and a whole number of transfers
+			return ERROR_ALIGN;
 		}
+		uint32_t transfers = segments[i].size >> widthShift;
+		needed += (transfers + DMA_LLI_MAX_TRANSFERS - 1) / DMA_LLI_MAX_TRANSFERS;
 	}
 
+	freePoolList(*controller, *channel);
+
+	// take the descriptors off the free list in one go
+	EnterCriticalSection();
+	DMALinkedList* head = LLIFree;
+	DMALinkedList* item = head;
+	for(i = 1; i < needed && item != NULL; i++)
+		item = item->next;
+
+	if(item == NULL) {
+		LeaveCriticalSection();
+		bufferPrintf("dma: out of descriptors for %d segments\r\n", numSegments);
+		return ERROR_BUSY;
+	}
+
+	LLIFree = item->next;
+	item->next = NULL;
+	PoolLists[*controller - 1][*channel] = head;
+	LeaveCriticalSection();
+
+	DMARoute route;
+	if(memoryIsDestination)
+		dma_route(Source, segments[0].address, *controller, &route);
+	else
+		dma_route(segments[0].address, Destination, *controller, &route);
+
+	item = head;
+	for(i = 0; i < numSegments; i++) {
+		uint32_t address = segments[i].address;
+		uint32_t transfers = segments[i].size >> widthShift;
+
+		while(transfers > 0) {
+			uint32_t count = (transfers > DMA_LLI_MAX_TRANSFERS) ? DMA_LLI_MAX_TRANSFERS : transfers;
+
+			item->source = memoryIsDestination ? route.source : address;
+			item->destination = memoryIsDestination ? address : route.destination;
+			item->control = control | route.sourceIncrement | route.destinationIncrement | count;
+
+			address += count << widthShift;
+			transfers -= count;
+
+			// cyclic lists interrupt at the end of every segment
+			if(item->next == NULL || (cyclic && transfers == 0))
+				item->control |= 1 << DMAC0Control0_TERMINALCOUNTINTERRUPTENABLE;
+
+			if(item->next == NULL && cyclic)
+				item->next = head;
+
+			item = item->next;
+		}
+	}
+
+	SET_REG(regOffset + DMAC0SrcAddress, head->source);
+	SET_REG(regOffset + DMAC0DestAddress, head->destination);
+	SET_REG(regOffset + DMAC0LLI, (uint32_t)head->next);
+	SET_REG(regOffset + DMAC0Control0, head->control);
+	SET_REG(regOffset + DMAC0Configuration, DMAC0Configuration_CHANNELENABLED | DMAC0Configuration_TERMINALCOUNTINTERRUPTMASK
+			| (route.flowControl << DMAC0Configuration_FLOWCNTRLSHIFT)
+			| (route.destPeripheral << DMAC0Configuration_DESTPERIPHERALSHIFT)
+			| (route.sourcePeripheral << DMAC0Configuration_SRCPERIPHERALSHIFT));
+
+	return 0;
+}
+
+// Moves data between a peripheral and a list of memory segments in one
+// transfer. One of Source and Destination is a peripheral and the other is
+// DMA_MEMORY, standing for the segments. The descriptors come from the pool and
+// go back to it in dma_finish.
+int dma_perform_sg(uint32_t Source, uint32_t Destination, const DMASegment* segments, int numSegments, int* controller, int* channel) {
+	return dma_perform_list(Source, Destination, segments, numSegments, FALSE, controller, channel);
+}
+
+// Like dma_perform_sg, but after the last segment the transfer starts over
+// with the first and keeps going until dma_cancel. The handler is called at
+// the end of every segment.
+int dma_perform_cyclic(uint32_t Source, uint32_t Destination, const DMASegment* segments, int numSegments, int* controller, int* channel) {
+	return dma_perform_list(Source, Destination, segments, numSegments, TRUE, controller, channel);
+}
+
+// Blocks the calling task until the transfer's interrupt comes in, letting
+// other tasks run or the core idle meanwhile. Not to be called with a timeout
+// from interrupt context.
+int dma_finish(int controller, int channel, int timeout) {
+	if(!requests[controller - 1][channel].done
+			&& completion_wait((Completion*) &requests[controller - 1][channel].completion, timeout * 1000) != 0) {
+		return -1;
+	}
+
+	freePoolList(controller, channel);
+
 	EnterCriticalSection();
 	requests[controller - 1][channel].started = FALSE;
 	requests[controller - 1][channel].done = FALSE;
-	if(controller == 1)
-		Controller0FreeChannels[channel] = 0;
-	else if(controller == 2)
-		Controller1FreeChannels[channel] = 0;
+	if((ChannelsReserved[controller - 1] & (1 << channel)) == 0)
+		ChannelsInUse[controller - 1] &= ~(1 << channel);
 	LeaveCriticalSection();
 
 	return 0;
 }
 
+// Stops the transfer wherever it has got to and gives the channel back, as
+// dma_finish would once it is done.
+void dma_cancel(int controller, int channel) {
+	uint32_t regOffset = (controller == 1) ? DMAC0 : DMAC1;
+
+	EnterCriticalSection();
+	dma_pause(controller, channel);
+	SET_REG(regOffset + DMACIntTCClear, 1 << channel);
+	requests[controller - 1][channel].done = TRUE;
+	LeaveCriticalSection();
+
+	dma_finish(controller, channel, 0);
+}
+
+// Copies smaller than this are not worth setting up a channel for
+#define DMA_MEMCPY_MIN 0x1000
+
+// Start a RAM-to-RAM copy of the aligned part of the buffers. Any trailing bytes
+// are copied by the CPU. The caller owns the channel until it calls dma_finish.
+int dma_memcpy_async(void* dest, const void* src, uint32_t size, DMAHandler handler, int* controller, int* channel) {
+	uint32_t words = size & ~0x3;
+	int ret;
+
+	if((((uint32_t)dest) & 0x3) != 0 || (((uint32_t)src) & 0x3) != 0) {
+		// the buffers need to be aligned for DMA, last two bits have to be clear
+		return ERROR_ALIGN;
+	}
+
+	if(words == 0)
+		return ERROR_DMA;
+
+	if(words != size)
+		memcpy((uint8_t*)dest + words, (const uint8_t*)src + words, size - words);
+
+	// Write the source out to RAM and drop any lines of the destination so that
+	// nothing stale is written back over the DMA'd data later on.
+	CleanDataCacheRange(src, words);
+	InvalidateDataCacheRange(dest, words);
+
+	*controller = 0;
+	*channel = 0;
+
+	if((ret = dma_request(DMA_MEMORY, 4, 8, DMA_MEMORY, 4, 8, controller, channel, handler)) != 0)
+		return ret;
+
+	return dma_perform((uint32_t)src, (uint32_t)dest, words, FALSE, controller, channel);
+}
+
+void* dma_memcpy(void* dest, const void* src, uint32_t size) {
+	int controller;
+	int channel;
+
+	if(size < DMA_MEMCPY_MIN || dma_memcpy_async(dest, src, size, NULL, &controller, &channel) != 0)
+		return memcpy(dest, src, size);
+
+	// about 500 ms per megabyte is far more than the controller ever needs
+	if(dma_finish(controller, channel, 500 + (size >> 11)) != 0) {
+		bufferPrintf("dma: memcpy of %d bytes timed out, falling back to the CPU\r\n", size);
+		dma_pause(controller, channel);
+		return memcpy(dest, src, size);
+	}
+
+	return dest;
+}
+
 int dma_shutdown()
 {
 	SET_REG(DMAC0 + DMACConfiguration, ~DMACConfiguration_ENABLE);
@@ -371,6 +756,7 @@ void dma_resume(int controller, int channel) {
 static void dispatchRequest(volatile DMARequest *request, int controller, int channel) {
 	// TODO: Implement this
 	request->done = TRUE;
+	completion_signal((Completion*) &request->completion);
 	if(request->handler)
 		request->handler(1, controller, channel);
 }
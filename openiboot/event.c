@@ -2,105 +2,156 @@
 #include "timer.h"
 #include "event.h"
 #include "clock.h"
+#include "util.h"
+#include "irqoff.h"
 #include "hardware/timer.h"
 #include "openiboot-asmhelpers.h"
 
-Event EventList;
+// Pending events live in a binary min-heap ordered by deadline. Slot 0 is
+// unused so an Event's heapIndex of 0 means it is not queued.
+#ifndef EVENT_HEAP_SIZE
+#define EVENT_HEAP_SIZE 64
+#endif
+
+// The event timer is reprogrammed for the earliest deadline, within these
+// bounds (in microseconds). Deadlines themselves are kept in timer ticks.
+#define EVENT_MIN_WAIT 50
+#define EVENT_MAX_WAIT 100000
+
+static Event* EventHeap[EVENT_HEAP_SIZE + 1];
+static uint32_t EventHeapSize = 0;
 
-static void init_event_list();
 static void eventTimerHandler();
+static void event_program_timer(uint64_t curTime);
 
 int event_setup() {
 	// In our implementation, we set TicksPerSec when we setup the clock
 	// so we don't have to do it here
 
-	init_event_list();
+	EventHeapSize = 0;
 
 	Timers[EventTimer].handler2 = eventTimerHandler;
 
-	// Initialize the timer hardware for something that goes off once every 100 Hz.
-	// The handler for the timer will reset it so it's periodic
-	timer_init(EventTimer, TicksPerSec/100, 0, 0, 0, FALSE, FALSE, FALSE, TRUE);
-
-	// Turn the timer on
-	timer_on_off(EventTimer, ON);
+	event_program_timer(timer_get_ticks());
 
 	return 0;
 }
 
-static void init_event_list() {
-	EventList.list.next = &EventList;
-	EventList.list.prev = &EventList;
+static void heap_set(uint32_t index, Event* event) {
+	EventHeap[index] = event;
+	event->heapIndex = index;
+}
+
+static void heap_sift_up(uint32_t index) {
+	Event* event = EventHeap[index];
+	while(index > 1 && EventHeap[index / 2]->deadline > event->deadline) {
+		heap_set(index, EventHeap[index / 2]);
+		index /= 2;
+	}
+	heap_set(index, event);
+}
+
+static void heap_sift_down(uint32_t index) {
+	Event* event = EventHeap[index];
+	while((index * 2) <= EventHeapSize) {
+		uint32_t child = index * 2;
+		if(child < EventHeapSize && EventHeap[child + 1]->deadline < EventHeap[child]->deadline)
+			child++;
+
+		if(EventHeap[child]->deadline >= event->deadline)
+			break;
+
+		heap_set(index, EventHeap[child]);
+		index = child;
+	}
+	heap_set(index, event);
+}
+
+static void heap_remove(Event* event) {
+	uint32_t index = event->heapIndex;
+	Event* last = EventHeap[EventHeapSize--];
+
+	event->heapIndex = 0;
+
+	if(last == event)
+		return;
+
+	heap_set(index, last);
+	if(index > 1 && EventHeap[index / 2]->deadline > last->deadline)
+		heap_sift_up(index);
+	else
+		heap_sift_down(index);
+}
+
+static void event_program_timer(uint64_t curTime) {
+	uint64_t maxWait = timer_us_to_ticks(EVENT_MAX_WAIT);
+	uint64_t minWait = timer_us_to_ticks(EVENT_MIN_WAIT);
+	uint64_t wait = maxWait;
+
+	if(EventHeapSize > 0) {
+		uint64_t deadline = EventHeap[1]->deadline;
+		wait = (deadline > curTime) ? (deadline - curTime) : 0;
+		if(wait < minWait)
+			wait = minWait;
+		else if(wait > maxWait)
+			wait = maxWait;
+	}
+
+	if(IRQOffTracking)
+		irqoff_expect(TIMER_IRQ, timer_get_ticks() + wait);
+
+	timer_init(EventTimer, (uint32_t)wait, 0, 0, 0, FALSE, FALSE, FALSE, TRUE);
+	timer_on_off(EventTimer, ON);
 }
 
 static void eventTimerHandler() {
 	uint64_t curTime;
 	Event* event;
 
-	curTime = timer_get_system_microtime();
+	curTime = timer_get_ticks();
 
-	while(EventList.list.next != &EventList) {	// Just keep checking the first event on the list until the list is empty
-							// This works because we remove events as we dispatch them
+	while(EventHeapSize > 0) {
+		event = EventHeap[1];
 
-		event = EventList.list.next;
-
-		if(event == NULL) {
+		// The heap is ordered, so nothing else is due if the earliest event isn't
+		if(curTime < event->deadline)
 			break;
-		}
 
-		if(curTime >= event->deadline) {
-			// take it off the list and dispatch it
-			((Event*)(event->list.next))->list.prev = event->list.prev;
-			((Event*)(event->list.prev))->list.next = event->list.next;
-			event->list.next = NULL;
-			event->list.prev = NULL;
-			event->handler(event, event->opaque);
-		} else {
-			// The event queue is sorted, so we can just stop looping on the first
-			// event that hasn't been triggered
-			break;
-		}
+		// take it off the heap and dispatch it
+		heap_remove(event);
+		event->handler(event, event->opaque);
 	}
+
+	event_program_timer(timer_get_ticks());
 }
 
 int event_add(Event* newEvent, uint64_t timeout, EventHandler handler, void* opaque) {
 	EnterCriticalSection();
 
-	// If this item is already on a list, take it off
-	if(newEvent->list.prev != NULL || newEvent->list.next != NULL) {
-		if(newEvent->list.next != NULL) {
-			((Event*)(newEvent->list.next))->list.prev = newEvent->list.prev;
-		}
-		if(newEvent->list.prev != NULL) {
-			((Event*)(newEvent->list.prev))->list.next = newEvent->list.next;
-		}
-		newEvent->list.next = NULL;
-		newEvent->list.prev = NULL;
+	// If this item is already queued, take it off
+	if(newEvent->heapIndex != 0)
+		heap_remove(newEvent);
+
+	if(EventHeapSize >= EVENT_HEAP_SIZE) {
+		LeaveCriticalSection();
+		bufferPrintf("event: too many events queued\r\n");
+		return -1;
 	}
 
+	uint64_t curTime = timer_get_ticks();
+
 	newEvent->handler = handler;
+	newEvent->opaque = opaque;
 	newEvent->interval = timeout;
-	newEvent->deadline = timer_get_system_microtime() + timeout;
+	newEvent->deadline = curTime + timer_us_to_ticks(timeout);
 
-	Event* insertAt = &EventList;
+	EventHeapSize++;
+	EventHeap[EventHeapSize] = newEvent;
+	heap_sift_up(EventHeapSize);
 
-	while(insertAt != insertAt->list.next) {
-		// Find the event that this occurs after
-		if(insertAt->deadline > newEvent->deadline) {
-			break;
-		}
-		insertAt = insertAt->list.next;
-		if(insertAt == &EventList) {
-			// We're after the whole list, so just insert after everyone else (after head)
-			break;
-		}
-	}
-
-	// Insert before insertAt
-	newEvent->list.next = insertAt;
-	newEvent->list.prev = insertAt->list.prev;
-	((Event*)insertAt->list.prev)->list.next = newEvent;
-	insertAt->list.prev = newEvent;
+	// a new earliest deadline needs the timer brought forward
+	if(EventHeap[1] == newEvent)
+		event_program_timer(curTime);
 
 	LeaveCriticalSection();
 
@@ -110,17 +161,9 @@ int event_add(Event* newEvent, uint64_t timeout, EventHandler handler, void* opa
 int event_readd(Event* event, uint64_t new_interval) {
 	EnterCriticalSection();
 
-	// If this item is already on a list, take it off
-	if(event->list.prev != NULL || event->list.next != NULL) {
-		if(event->list.next != NULL) {
-			((Event*)(event->list.next))->list.prev = event->list.prev;
-		}
-		if(event->list.prev != NULL) {
-			((Event*)(event->list.prev))->list.next = event->list.next;
-		}
-		event->list.next = NULL;
-		event->list.prev = NULL;
-	}
+	// If this item is already queued, take it off
+	if(event->heapIndex != 0)
+		heap_remove(event);
 
 	uint64_t interval;
 	if(new_interval == 0) {
@@ -134,9 +177,15 @@ int event_readd(Event* event, uint64_t new_interval) {
 		interval = new_interval;
 	}
 
-	event_add(event, interval, event->handler, event->opaque);
+	int ret = event_add(event, interval, event->handler, event->opaque);
 	LeaveCriticalSection();
 
-	return 0;
+	return ret;
 }
 
+void event_cancel(Event* event) {
+	EnterCriticalSection();
+	if(event->heapIndex != 0)
+		heap_remove(event);
+	LeaveCriticalSection();
+}
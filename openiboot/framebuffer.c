@@ -2,6 +2,8 @@
 #include "framebuffer.h"
 #include "lcd.h"
 #include "util.h"
+#include "event.h"
+#include "openiboot-asmhelpers.h"
 #include "pcf/6x10.h"
 
 static int TWidth;
@@ -19,6 +21,33 @@ static int DisplayText = FALSE;
 static uint32_t BackgroundColor;
 static uint32_t ForegroundColor;
 
+// The window's buffer has room for another screen below it (see createWindow
+// in lcd.c). Scrolling moves the window down over that room one text line at
+// a time, and only when it runs out is the screen copied back to the top.
+static uint8_t* ScrollBase;
+static uint32_t ScrollTop;
+
+// framebuffer_print only queues text here. It is drawn from an event at
+// most once a frame, with a single scroll for however many lines came in.
+// Must be a power of two, and holds more than a screenful.
+#ifndef FRAMEBUFFER_PENDING_LEN
+#define FRAMEBUFFER_PENDING_LEN 4096
+#endif
+
+#ifndef FRAMEBUFFER_RENDER_INTERVAL
+#define FRAMEBUFFER_RENDER_INTERVAL 16667
+#endif
+
+#if (FRAMEBUFFER_PENDING_LEN & (FRAMEBUFFER_PENDING_LEN - 1)) != 0
+#error FRAMEBUFFER_PENDING_LEN must be a power of two
+#endif
+
+static char Pending[FRAMEBUFFER_PENDING_LEN];
+static uint32_t PendingHead = 0;
+static uint32_t PendingTail = 0;
+static Event RenderEvent;
+static int RenderQueued = FALSE;
+
 #define BGR16(x) ((((((x) >> 16) & 0xFF) >> 3) << 11) | (((((x) >> 8) & 0xFF) >> 2) << 5) | (((x) & 0xFF) >> 3))
 #define BGR32(x) ((((((x) >> 11) & 0x1F) << 3) << 16) | (((((x) >> 5) & 0x3F) << 2) << 8) | (((x) & 0x1F) << 3))
 
@@ -39,29 +68,162 @@ inline volatile uint16_t* PixelFromCoords565(register uint32_t x, register uint3
 	return ((uint16_t*)CurFramebuffer) + (y * FBWidth) + x;
 }
 
+// Each glyph row is pre-rendered to a bit mask, and every mask to its run of
+// pixels in the current colours, so drawing a glyph row is a copy of Font->width
+// pixels. Fonts wider than eight pixels fall back to getCharPixel.
+#define GLYPHS 256
+
+static uint8_t* GlyphRows = NULL;
+static uint32_t* Spans = NULL;
+static uint32_t SpansFore;
+static uint32_t SpansBack;
+static ColorSpace SpansColorSpace;
+
+static void loadGlyphs() {
+	uint32_t glyphs = ((sizeof(fontData) - sizeof(OpenIBootFont)) * 8) / (Font->width * Font->height);
+	int c;
+	int sx;
+	int sy;
+
+	if(Font->width > 8)
+		return;
+
+	GlyphRows = (uint8_t*) malloc(GLYPHS * Font->height);
+	Spans = (uint32_t*) malloc((1 << Font->width) * Font->width * sizeof(uint32_t));
+	if(GlyphRows == NULL || Spans == NULL) {
+		free(GlyphRows);
+		free(Spans);
+		GlyphRows = NULL;
+		Spans = NULL;
+		return;
+	}
+
+	memset(GlyphRows, 0, GLYPHS * Font->height);
+	for(c = 0; c < GLYPHS && c < glyphs; c++) {
+		for(sy = 0; sy < Font->height; sy++) {
+			for(sx = 0; sx < Font->width; sx++) {
+				if(getCharPixel(Font, c, sx, sy))
+					GlyphRows[(c * Font->height) + sy] |= 1 << sx;
+			}
+		}
+	}
+
+	// force the first draw to render the spans
+	SpansFore = ~ForegroundColor;
+}
+
+static void renderSpans() {
+	ColorSpace colorSpace = currentWindow->framebuffer.colorSpace;
+	uint32_t fore = (colorSpace == RGB888) ? ForegroundColor : BGR16(ForegroundColor);
+	uint32_t back = (colorSpace == RGB888) ? BackgroundColor : BGR16(BackgroundColor);
+	uint32_t mask;
+	int sx;
+
+	for(mask = 0; mask < (1 << Font->width); mask++) {
+		if(colorSpace == RGB888) {
+			uint32_t* span = Spans + (mask * Font->width);
+			for(sx = 0; sx < Font->width; sx++)
+				span[sx] = (mask & (1 << sx)) ? fore : back;
+		} else {
+			uint16_t* span = ((uint16_t*) Spans) + (mask * Font->width);
+			for(sx = 0; sx < Font->width; sx++)
+				span[sx] = (mask & (1 << sx)) ? fore : back;
+		}
+	}
+
+	SpansFore = ForegroundColor;
+	SpansBack = BackgroundColor;
+	SpansColorSpace = colorSpace;
+}
+
+// Draws count glyphs at the cursor, one pixel row at a time across all of
+// them. The caller makes sure they fit on the line.
+static void drawGlyphs(const char* str, int count) {
+	register int width = Font->width;
+	int sy;
+	int i;
+	int sx;
+
+	if(SpansFore != ForegroundColor || SpansBack != BackgroundColor || SpansColorSpace != currentWindow->framebuffer.colorSpace)
+		renderSpans();
+
+	for(sy = 0; sy < Font->height; sy++) {
+		const uint8_t* rows = GlyphRows + sy;
+		if(currentWindow->framebuffer.colorSpace == RGB888) {
+			register volatile uint32_t* pixel = PixelFromCoords(width * X, (Font->height * Y) + sy);
+			for(i = 0; i < count; i++) {
+				register const uint32_t* span = Spans + (rows[((uint8_t) str[i]) * Font->height] * width);
+				for(sx = 0; sx < width; sx++)
+					*(pixel++) = span[sx];
+			}
+		} else {
+			register volatile uint16_t* pixel = PixelFromCoords565(width * X, (Font->height * Y) + sy);
+			for(i = 0; i < count; i++) {
+				register const uint16_t* span = ((uint16_t*) Spans) + (rows[((uint8_t) str[i]) * Font->height] * width);
+				for(sx = 0; sx < width; sx++)
+					*(pixel++) = span[sx];
+			}
+		}
+	}
+}
+
 int framebuffer_setup() {
 	Font = (OpenIBootFont*) fontData;
 	BackgroundColor = COLOR_BLACK;
 	ForegroundColor = COLOR_WHITE;
 	FBWidth = currentWindow->framebuffer.width;
 	FBHeight = currentWindow->framebuffer.height;
+	ScrollBase = (uint8_t*) CurFramebuffer;
+	ScrollTop = 0;
 	TWidth = FBWidth / Font->width;
 	THeight = FBHeight / Font->height;
+	if(GlyphRows == NULL)
+		loadGlyphs();
 	framebuffer_clear();
 	FramebufferHasInit = TRUE;
 	return 0;
 }
 
 void framebuffer_setcolors(uint32_t fore, uint32_t back) {
+	framebuffer_flush();
 	ForegroundColor = fore;
 	BackgroundColor = back;
 }
 
 void framebuffer_setdisplaytext(int onoff) {
+	framebuffer_flush();
 	DisplayText = onoff;
 }
 
+static void setScrollTop(uint32_t top) {
+	ScrollTop = top;
+	CurFramebuffer = (volatile uint32_t*) (ScrollBase + (top * currentWindow->lineBytes));
+	currentWindow->framebuffer.buffer = CurFramebuffer;
+	lcd_window_address(2, (uint32_t) CurFramebuffer);
+}
+
+// FALSE while someone else (the menu) has pointed the window elsewhere.
+static int inScrollRing() {
+	return ScrollBase != NULL && (uint8_t*) CurFramebuffer == (ScrollBase + (ScrollTop * currentWindow->lineBytes));
+}
+
+void framebuffer_reset_scroll() {
+	if(!inScrollRing() || ScrollTop == 0)
+		return;
+
+	memmove(ScrollBase, (void*) CurFramebuffer, FBHeight * currentWindow->lineBytes);
+	setScrollTop(0);
+}
+
 void framebuffer_clear() {
+	// whatever was still queued would only have been wiped
+	EnterCriticalSection();
+	PendingTail = PendingHead;
+	LeaveCriticalSection();
+
+	if(inScrollRing() && ScrollTop != 0)
+		setScrollTop(0);
+
 	lcd_fill(BackgroundColor);
 	X = 0;
 	Y = 0;
@@ -84,31 +246,157 @@ int framebuffer_y() {
 }
 
 void framebuffer_setloc(int x, int y) {
+	framebuffer_flush();
 	X = x;
 	Y = y;
 }
 
-void framebuffer_print(const char* str) {
-	if(!DisplayText)
+static void scrollup(int lines);
+static void drawText(const char* str);
+static void render();
+
+void framebuffer_print_force(const char* str) {
+	EnterCriticalSection();
+	render();
+	drawText(str);
+	LeaveCriticalSection();
+}
+
+// Runs of ordinary characters are drawn a whole line's worth at a time.
+static void drawText(const char* str) {
+	while(*str != '\0') {
+		if(GlyphRows == NULL || *str == '\r' || *str == '\n') {
+			framebuffer_putc(*(str++));
+			continue;
+		}
+
+		int count = 0;
+		while(str[count] != '\0' && str[count] != '\r' && str[count] != '\n' && count < (TWidth - X))
+			count++;
+
+		if(count == 0) {
+			framebuffer_putc(*(str++));
+			continue;
+		}
+
+		drawGlyphs(str, count);
+		str += count;
+		X += count;
+
+		if(X == TWidth) {
+			X = 0;
+			Y++;
+		}
+
+		if(Y == THeight) {
+			scrollup(1);
+		}
+	}
+}
+
+// Where the cursor ends up after str, with as many rows below the screen
+// as it takes.
+static void advance(const char* str, int* x, int* y) {
+	for(; *str != '\0'; str++) {
+		if(*str == '\r') {
+			*x = 0;
+		} else if(*str == '\n') {
+			*x = 0;
+			(*y)++;
+		} else if(++(*x) == TWidth) {
+			*x = 0;
+			(*y)++;
+		}
+	}
+}
+
+static void render() {
+	static char text[FRAMEBUFFER_PENDING_LEN + 1];
+	uint32_t len = PendingHead - PendingTail;
+	uint32_t offset = PendingTail & (FRAMEBUFFER_PENDING_LEN - 1);
+	uint32_t first = FRAMEBUFFER_PENDING_LEN - offset;
+	int x = X;
+	int y = Y;
+
+	if(len == 0)
 		return;
 
-	size_t len = strlen(str);
-	int i;
-	for(i = 0; i < len; i++) {
-		framebuffer_putc(str[i]);
+	if(first > len)
+		first = len;
+
+	memcpy(text, Pending + offset, first);
+	memcpy(text + first, Pending, len - first);
+	text[len] = '\0';
+	PendingTail += len;
+
+	// scroll once for the lot, then only draw what stays on the screen
+	advance(text, &x, &y);
+	int lines = y - (THeight - 1);
+	if(lines <= 0) {
+		drawText(text);
+		return;
+	}
+
+	scrollup(lines);
+
+	const char* str = text;
+	while(Y < 0 && *str != '\0') {
+		char ch[2] = { *(str++), '\0' };
+		advance(ch, &X, &Y);
 	}
+
+	drawText(str);
 }
 
-void framebuffer_print_force(const char* str) {
-	size_t len = strlen(str);
-	int i;
-	for(i = 0; i < len; i++) {
-		framebuffer_putc(str[i]);
+static void renderTick(Event* event, void* opaque) {
+	EnterCriticalSection();
+	RenderQueued = FALSE;
+	if(DisplayText)
+		render();
+	LeaveCriticalSection();
+}
+
+void framebuffer_flush() {
+	EnterCriticalSection();
+	render();
+	LeaveCriticalSection();
+}
+
+void framebuffer_print(const char* str) {
+	if(!DisplayText)
+		return;
+
+	EnterCriticalSection();
+	uint32_t len = strlen(str);
+
+	// only the newest screenful or so matters, the rest would scroll away
+	if(len > FRAMEBUFFER_PENDING_LEN) {
+		str += len - FRAMEBUFFER_PENDING_LEN;
+		len = FRAMEBUFFER_PENDING_LEN;
+	}
+	if((PendingHead - PendingTail + len) > FRAMEBUFFER_PENDING_LEN)
+		PendingTail = PendingHead + len - FRAMEBUFFER_PENDING_LEN;
+
+	uint32_t offset = PendingHead & (FRAMEBUFFER_PENDING_LEN - 1);
+	uint32_t first = FRAMEBUFFER_PENDING_LEN - offset;
+	if(first > len)
+		first = len;
+
+	memcpy(Pending + offset, str, first);
+	memcpy(Pending, str + first, len - first);
+	PendingHead += len;
+
+	if(!RenderQueued) {
+		if(event_add(&RenderEvent, FRAMEBUFFER_RENDER_INTERVAL, renderTick, NULL) == 0)
+			RenderQueued = TRUE;
+		else
+			render();
 	}
+	LeaveCriticalSection();
 }
 
-static void scrollup888() {
-	register volatile uint32_t* newFirstLine = PixelFromCoords(0, Font->height);
+static void scrollup888(int lines) {
+	register volatile uint32_t* newFirstLine = PixelFromCoords(0, Font->height * lines);
 	register volatile uint32_t* oldFirstLine = PixelFromCoords(0, 0);
 	register volatile uint32_t* end = oldFirstLine + (FBWidth * FBHeight);
 	while(newFirstLine < end) {
@@ -117,11 +405,10 @@ static void scrollup888() {
 	while(oldFirstLine < end) {
 		*(oldFirstLine++) = BackgroundColor;
 	}
-	Y--;
 }
 
-static void scrollup565() {
-	register volatile uint16_t* newFirstLine = PixelFromCoords565(0, Font->height);
+static void scrollup565(int lines) {
+	register volatile uint16_t* newFirstLine = PixelFromCoords565(0, Font->height * lines);
 	register volatile uint16_t* oldFirstLine = PixelFromCoords565(0, 0);
 	register volatile uint16_t* end = oldFirstLine + (FBWidth * FBHeight);
 	uint16_t bgcolor = BGR16(BackgroundColor);
@@ -131,7 +418,38 @@ static void scrollup565() {
 	while(oldFirstLine < end) {
 		*(oldFirstLine++) = bgcolor;
 	}
-	Y--;
+}
+
+static void scrollup(int lines) {
+	uint32_t lineBytes = currentWindow->lineBytes;
+	uint32_t rows = Font->height * lines;
+	uint32_t i;
+
+	Y -= lines;
+
+	// nothing on the screen survives
+	if(lines >= THeight) {
+		lcd_fill(BackgroundColor);
+		return;
+	}
+
+	if(!inScrollRing()) {
+		if(currentWindow->framebuffer.colorSpace == RGB888)
+			scrollup888(lines);
+		else
+			scrollup565(lines);
+		return;
+	}
+
+	if((ScrollTop + rows) <= FBHeight) {
+		setScrollTop(ScrollTop + rows);
+	} else {
+		memcpy(ScrollBase, (uint8_t*) CurFramebuffer + (rows * lineBytes), (FBHeight - rows) * lineBytes);
+		setScrollTop(0);
+	}
+
+	for(i = FBHeight - rows; i < FBHeight; i++)
+		currentWindow->framebuffer.hline(&currentWindow->framebuffer, 0, i, FBWidth, BackgroundColor);
 }
 
 void framebuffer_putc888(int c) {
@@ -140,6 +458,10 @@ void framebuffer_putc888(int c) {
 	} else if(c == '\n') {
 		X = 0;
 		Y++;
+	} else if(GlyphRows != NULL) {
+		char ch = c;
+		drawGlyphs(&ch, 1);
+		X++;
 	} else {
 		register uint32_t sx;
 		register uint32_t sy;
@@ -162,7 +484,7 @@ void framebuffer_putc888(int c) {
 	}
 
 	if(Y == THeight) {
-		scrollup888();
+		scrollup(1);
 	}
 }
 
@@ -175,6 +497,10 @@ void framebuffer_putc565(int c) {
 	} else if(c == '\n') {
 		X = 0;
 		Y++;
+	} else if(GlyphRows != NULL) {
+		char ch = c;
+		drawGlyphs(&ch, 1);
+		X++;
 	} else {
 		register uint32_t sx;
 		register uint32_t sy;
@@ -197,7 +523,7 @@ void framebuffer_putc565(int c) {
 	}
 
 	if(Y == THeight) {
-		scrollup565();
+		scrollup(1);
 	}
 }
 
@@ -265,6 +591,114 @@ void framebuffer_capture_image(uint32_t* image, int x, int y, int width, int hei
 		framebuffer_capture_image565(image, x, y, width, height);
 }
 
+// Raw copies of a rectangle of the framebuffer, in its own pixel format. The
+// buffer has to hold width * height * 4 bytes.
+void framebuffer_save_rect(void* buffer, int x, int y, int width, int height) {
+	int bytes = (currentWindow->framebuffer.colorSpace == RGB888) ? 4 : 2;
+	int sy;
+	for(sy = 0; sy < height; sy++) {
+		void* line = (bytes == 4) ? (void*) PixelFromCoords(x, y + sy) : (void*) PixelFromCoords565(x, y + sy);
+		memcpy((uint8_t*) buffer + (sy * width * bytes), line, width * bytes);
+	}
+}
+
+void framebuffer_restore_rect(const void* buffer, int x, int y, int width, int height) {
+	int bytes = (currentWindow->framebuffer.colorSpace == RGB888) ? 4 : 2;
+	int sy;
+	for(sy = 0; sy < height; sy++) {
+		void* line = (bytes == 4) ? (void*) PixelFromCoords(x, y + sy) : (void*) PixelFromCoords565(x, y + sy);
+		memcpy(line, (const uint8_t*) buffer + (sy * width * bytes), width * bytes);
+	}
+}
+
+// Images made by images/png2rle: runs of premultiplied RGB565 pixels that go
+// straight to the panel. Blended pixels work one channel per field of the
+// spread out 0x07E0F81F layout, so there is no unpacking per channel.
+#define RLE_SKIP 0
+#define RLE_FILL 1
+#define RLE_COPY 2
+#define RLE_BLEND 3
+
+static void framebuffer_draw_rle_image565(const uint16_t* data, int x, int y, int width, int height) {
+	int sy;
+	for(sy = 0; sy < height; sy++) {
+		register volatile uint16_t* pixel = PixelFromCoords565(x, y + sy);
+		register volatile uint16_t* end = pixel + width;
+		while(pixel < end) {
+			register uint32_t count = *data & 0x3FFF;
+			register uint32_t color;
+			switch(*data++ >> 14) {
+				case RLE_SKIP:
+					pixel += count;
+					break;
+				case RLE_FILL:
+					color = *data++;
+					while(count--)
+						*pixel++ = color;
+					break;
+				case RLE_COPY:
+					while(count--)
+						*pixel++ = *data++;
+					break;
+				case RLE_BLEND:
+					while(count--) {
+						register uint32_t dst = *pixel;
+						dst = (dst | (dst << 16)) & 0x07E0F81F;
+						dst = ((dst * data[1]) >> 5) & 0x07E0F81F;
+						*pixel++ = data[0] + (dst | (dst >> 16));
+						data += 2;
+					}
+					break;
+			}
+		}
+	}
+}
+
+static void framebuffer_draw_rle_image888(const uint16_t* data, int x, int y, int width, int height) {
+	int sy;
+	for(sy = 0; sy < height; sy++) {
+		register volatile uint32_t* pixel = PixelFromCoords(x, y + sy);
+		register volatile uint32_t* end = pixel + width;
+		while(pixel < end) {
+			register uint32_t count = *data & 0x3FFF;
+			register uint32_t color;
+			switch(*data++ >> 14) {
+				case RLE_SKIP:
+					pixel += count;
+					break;
+				case RLE_FILL:
+					color = BGR32(*data);
+					data++;
+					while(count--)
+						*pixel++ = color;
+					break;
+				case RLE_COPY:
+					while(count--) {
+						*pixel++ = BGR32(*data);
+						data++;
+					}
+					break;
+				case RLE_BLEND:
+					while(count--) {
+						register uint32_t dst = *pixel;
+						dst = ((((dst & 0xFF00FF) * data[1]) >> 5) & 0xFF00FF) | ((((dst & 0xFF00) * data[1]) >> 5) & 0xFF00);
+						*pixel++ = BGR32(data[0]) + dst;
+						data += 2;
+					}
+					break;
+			}
+		}
+	}
+}
+
+void framebuffer_draw_rle_image(const uint16_t* data, int x, int y, int width, int height)
+{
+	if(currentWindow->framebuffer.colorSpace == RGB888)
+		framebuffer_draw_rle_image888(data, x, y, width, height);
+	else
+		framebuffer_draw_rle_image565(data, x, y, width, height);
+}
+
 void framebuffer_draw_rect(uint32_t color, int x, int y, int width, int height) {
 	currentWindow->framebuffer.hline(&currentWindow->framebuffer, x, y, width, color);
 	currentWindow->framebuffer.hline(&currentWindow->framebuffer, x, y + height, width, color);
@@ -288,20 +722,72 @@ uint32_t* framebuffer_load_image(const char* data, int len, int* width, int* hei
 #endif
 #endif
 
-void framebuffer_blend_image(uint32_t* dst, int dstWidth, int dstHeight, uint32_t* src, int srcWidth, int srcHeight, int x, int y) {
-	register uint32_t sx;
-	register uint32_t sy;
-	for(sy = 0; sy < srcHeight; sy++) {
-		for(sx = 0; sx < srcWidth; sx++) {
-			register uint32_t* dstPixel = &dst[((sy + y) * dstWidth) + (sx + x)];
-			register uint32_t* srcPixel = &src[(sy * srcWidth) + sx];
-			*dstPixel =
-				((((*dstPixel & 0xFF) * (0x100 - (*srcPixel >> 24))) >> 8) + ((((*srcPixel >> 16) & 0xFF) * ((*srcPixel >> 24) + 1)) >> 8)) << 16
-				| (((((*dstPixel >> 8) & 0xFF) * (0x100 - (*srcPixel >> 24))) >> 8) + ((((*srcPixel >> 8) & 0xFF) * ((*srcPixel >> 24) + 1)) >> 8)) << 8
-				| (((((*dstPixel >> 16) & 0xFF) * (0x100 - (*srcPixel >> 24))) >> 8) + (((*srcPixel & 0xFF) * ((*srcPixel >> 24) + 1)) >> 8));
+#ifdef __arm__
+// ARM mode loops in framebuffer-blend.S.
+void BlendPixels(uint32_t* dst, const uint32_t* src, int count);
+void BlendPixelsPremultiplied(uint32_t* dst, const uint32_t* src, int count);
+#else
+// The same arithmetic as framebuffer-blend.S: red and blue share one multiply.
+static void BlendPixels(uint32_t* dst, const uint32_t* src, int count) {
+	while(count-- > 0) {
+		register uint32_t s = *src++;
+		register uint32_t a = s >> 24;
+		register uint32_t rgb = ((s & 0xFF) << 16) | (s & 0xFF00) | ((s >> 16) & 0xFF);
+		if(a == 0) {
+			dst++;
+			continue;
+		}
+
+		if(a == 0xFF) {
+			*dst++ = rgb;
+			continue;
 		}
+
+		register uint32_t rb = (rgb & 0xFF00FF) * (a + 1) + (*dst & 0xFF00FF) * (0x100 - a);
+		register uint32_t g = (rgb & 0xFF00) * (a + 1) + (*dst & 0xFF00) * (0x100 - a);
+		*dst++ = ((rb >> 8) & 0xFF00FF) | ((g >> 8) & 0xFF00);
+	}
+}
+
+static void BlendPixelsPremultiplied(uint32_t* dst, const uint32_t* src, int count) {
+	while(count-- > 0) {
+		register uint32_t s = *src++;
+		register uint32_t a = s >> 24;
+		register uint32_t rgb = ((s & 0xFF) << 16) | (s & 0xFF00) | ((s >> 16) & 0xFF);
+		if(a == 0xFF) {
+			*dst++ = rgb;
+			continue;
+		}
+
+		register uint32_t rb = (((*dst & 0xFF00FF) * (0x100 - a)) >> 8) & 0xFF00FF;
+		register uint32_t g = (((*dst & 0xFF00) * (0x100 - a)) >> 8) & 0xFF00;
+		register uint32_t sum = rb + (rgb & 0xFF00FF);
+		register uint32_t sumG = g + (rgb & 0xFF00);
+		if(sum & 0x100)
+			sum |= 0xFF;
+		if(sum & 0x1000000)
+			sum |= 0xFF0000;
+		if(sumG & 0x10000)
+			sumG |= 0xFF00;
+		*dst++ = (sum & 0xFF00FF) | (sumG & 0xFF00);
 	}
-}	
+}
+#endif
+
+// src is RGBA as framebuffer_load_image gives it, dst is in the layout
+// framebuffer_capture_image uses.
+void framebuffer_blend_image(uint32_t* dst, int dstWidth, int dstHeight, uint32_t* src, int srcWidth, int srcHeight, int x, int y) {
+	register uint32_t sy;
+	for(sy = 0; sy < srcHeight; sy++)
+		BlendPixels(&dst[((sy + y) * dstWidth) + x], &src[sy * srcWidth], srcWidth);
+}
+
+// The same, for images whose colour has already been multiplied by alpha.
+void framebuffer_blend_image_premultiplied(uint32_t* dst, int dstWidth, int dstHeight, uint32_t* src, int srcWidth, int srcHeight, int x, int y) {
+	register uint32_t sy;
+	for(sy = 0; sy < srcHeight; sy++)
+		BlendPixelsPremultiplied(&dst[((sy + y) * dstWidth) + x], &src[sy * srcWidth], srcWidth);
+}
 
 void framebuffer_draw_rect_hgradient(int starting, int ending, int x, int y, int width, int height) {
 	int step = (ending - starting) * 1000 / height;
@@ -2,6 +2,12 @@
 #include "ftl.h"
 #include "nand.h"
 #include "util.h"
+#include "timer.h"
+#include "tasks.h"
+#include "latency.h"
+#ifndef NO_HFS
+#include "hfs/bdev.h"
+#endif
 
 #define FTL_ID_V1 0x43303033
 #define FTL_ID_V2 0x43303034
@@ -12,18 +18,107 @@ int globalFtlHasBeenRestored; /* global variable to tell wether a ftl_restore ha
 int HasFTLInit = FALSE;
 int CleanFreeVb = FALSE;
 
+// Everything below, the VFL included, runs under FTLLock: the FTL and VFL
+// entry points take it, the GC task takes it for each step, and the shared
+// scratch buffers and tables are only touched with it held. It is
+// recursive, so the entry points can call each other.
+static Mutex FTLLock;
+
 static NANDData* Geometry;
 static NANDFTLData* FTLData;
 
+// Every geometry seen so far is sized in powers of two, so the per-page
+// address math uses shifts and masks worked out by ftl_geometry_setup.
+// Anything else falls back to dividing.
+static int GeometryIsPow2 = FALSE;
+static uint8_t BanksShift;
+static uint8_t PagesPerSuBlkShift;
+static uint8_t BytesPerPageShift;
+
+static void virtual_address_div(uint32_t dwVpn, uint16_t* virtualBank, uint16_t* virtualBlock, uint16_t* virtualPage);
+static void (*virtual_page_number_to_virtual_address)(uint32_t dwVpn, uint16_t* virtualBank, uint16_t* virtualBlock, uint16_t* virtualPage) = virtual_address_div;
+
 static int vfl_commit_cxt(int bank);
 static int ftl_set_free_vb(uint16_t block);
 static int ftl_get_free_vb(uint16_t* block);
 static int ftl_merge(FTLCxtLog* pLog);
+static int ftl_do_read(int logicalPageNumber, int totalPagesToRead, uint8_t* pBuf);
+static int ftl_do_sync();
+static int ftl_do_write(int logicalPageNumber, int totalPagesToWrite, uint8_t* pBuf);
 static int ftl_commit_cxt();
+static void ftl_refresh_note(uint16_t lbn, int reported);
+
+// Page and spare buffers for the read, write and merge paths. Buffers are
+// kept on a free list threaded through their first word and never go back
+// to the heap; when the list is empty a new one is allocated, so the pools
+// settle at the deepest nesting actually used. The FTL only runs in task
+// context and never yields between taking and linking a buffer, so no
+// lock is needed.
+
+#ifndef FTL_POOL_PAGES
+#define FTL_POOL_PAGES 4
+#endif
+
+typedef struct FTLBufferPool {
+	void* free;
+	uint32_t size;
+	int allocated;
+	int inUse;
+	int highWater;
+} FTLBufferPool;
+
+static FTLBufferPool PagePool;
+static FTLBufferPool SparePool;
+
+static void* ftl_pool_get(FTLBufferPool* pool) {
+	void* buffer = pool->free;
+
+	if(buffer != NULL) {
+		pool->free = *((void**) buffer);
+	} else {
+		buffer = malloc_dma(pool->size);
+		if(buffer == NULL)
+			return NULL;
+
+		pool->allocated++;
+	}
+
+	if(++pool->inUse > pool->highWater)
+		pool->highWater = pool->inUse;
+
+	return buffer;
+}
+
+static void ftl_pool_put(FTLBufferPool* pool, void* buffer) {
+	if(buffer == NULL)
+		return;
+
+	*((void**) buffer) = pool->free;
+	pool->free = buffer;
+	pool->inUse--;
+}
+
+static void ftl_pool_init(FTLBufferPool* pool, uint32_t size, int count) {
+	void* buffers[FTL_POOL_PAGES];
+	int i;
+
+	pool->size = size;
+	for(i = 0; i < count; i++)
+		buffers[i] = ftl_pool_get(pool);
+	for(i = 0; i < count; i++)
+		ftl_pool_put(pool, buffers[i]);
+
+	pool->highWater = 0;
+}
+
+void ftl_print_pools() {
+	bufferPrintf("ftl: page buffers: %d allocated, %d in use, high water %d\r\n", PagePool.allocated, PagePool.inUse, PagePool.highWater);
+	bufferPrintf("ftl: spare buffers: %d allocated, %d in use, high water %d\r\n", SparePool.allocated, SparePool.inUse, SparePool.highWater);
+}
 static int ftl_open_read_counter_tables();
 
 static int findDeviceInfoBBT(int bank, void* deviceInfoBBT) {
-	uint8_t* buffer = malloc(Geometry->bytesPerPage);
+	uint8_t* buffer = malloc_dma(Geometry->bytesPerPage);
 	int lowestBlock = Geometry->blocksPerBank - (Geometry->blocksPerBank / 10);
 	int block;
 	for(block = Geometry->blocksPerBank - 1; block >= lowestBlock; block--) {
@@ -31,18 +126,18 @@ static int findDeviceInfoBBT(int bank, void* deviceInfoBBT) {
 		int badBlockCount = 0;
 		for(page = 0; page < Geometry->pagesPerBlock; page++) {
 			if(badBlockCount > 2) {
-				DebugPrintf("ftl: findDeviceInfoBBT - too many bad pages, skipping block %d\r\n", block);
+				LogDebug(LogFTL, "ftl: findDeviceInfoBBT - too many bad pages, skipping block %d\r\n", block);
 				break;
 			}
 
 			int ret = nand_read_alternate_ecc(bank, (block * Geometry->pagesPerBlock) + page, buffer);
 			if(ret != 0) {
 				if(ret == 1) {
-					DebugPrintf("ftl: findDeviceInfoBBT - found 'badBlock' on bank %d, page %d\r\n", (block * Geometry->pagesPerBlock) + page);
+					LogDebug(LogFTL, "ftl: findDeviceInfoBBT - found 'badBlock' on bank %d, page %d\r\n", bank, (block * Geometry->pagesPerBlock) + page);
 					badBlockCount++;
 				}
 
-				DebugPrintf("ftl: findDeviceInfoBBT - skipping bank %d, page %d\r\n", (block * Geometry->pagesPerBlock) + page);
+				LogDebug(LogFTL, "ftl: findDeviceInfoBBT - skipping bank %d, page %d\r\n", bank, (block * Geometry->pagesPerBlock) + page);
 				continue;
 			}
 
@@ -54,7 +149,7 @@ static int findDeviceInfoBBT(int bank, void* deviceInfoBBT) {
 				free(buffer);
 				return TRUE;
 			} else {
-				DebugPrintf("ftl: did not find signature on bank %d, page %d\r\n", (block * Geometry->pagesPerBlock) + page);
+				LogDebug(LogFTL, "ftl: did not find signature on bank %d, page %d\r\n", bank, (block * Geometry->pagesPerBlock) + page);
 			}
 		}
 	}
@@ -78,8 +173,14 @@ static int hasDeviceInfoBBT() {
 static VFLData1Type VFLData1;
 static VFLCxt* pstVFLCxt = NULL;
 static uint8_t* pstBBTArea = NULL;
+static uint16_t* RemapIndex = NULL;
 static uint32_t* ScatteredPageNumberBuffer = NULL;
 static uint16_t* ScatteredBankNumberBuffer = NULL;
+static int* ScatteredStatusBuffer = NULL;
+// Virtual blocks whose state is known, and of those the ones with nothing
+// written since they were erased. Only what this VFL wrote or erased counts.
+static uint8_t* VbStateKnown = NULL;
+static uint8_t* VbErased = NULL;
 static int curVFLusnInc = 0;
 static uint8_t VFLData5[0xF8];
 
@@ -97,6 +198,13 @@ static int VFL_Init() {
 			return -1;
 	}
 
+	if(RemapIndex == NULL) {
+		RemapIndex = (uint16_t*) malloc(Geometry->banksTotal * Geometry->blocksPerBank * sizeof(uint16_t));
+		if(RemapIndex == NULL)
+			return -1;
+		memset(RemapIndex, 0xFF, Geometry->banksTotal * Geometry->blocksPerBank * sizeof(uint16_t));
+	}
+
 	if(ScatteredPageNumberBuffer == NULL && ScatteredBankNumberBuffer == NULL) {
 		ScatteredPageNumberBuffer = (uint32_t*) malloc(Geometry->pagesPerSuBlk * 4);
 		ScatteredBankNumberBuffer = (uint16_t*) malloc(Geometry->pagesPerSuBlk * 4);
@@ -104,6 +212,22 @@ static int VFL_Init() {
 			return -1;
 	}
 
+	if(ScatteredStatusBuffer == NULL) {
+		ScatteredStatusBuffer = (int*) malloc(Geometry->pagesPerSuBlk * sizeof(int));
+		if(ScatteredStatusBuffer == NULL)
+			return -1;
+	}
+
+	if(VbStateKnown == NULL && VbErased == NULL) {
+		VbStateKnown = (uint8_t*) malloc((Geometry->blocksPerBank + 7) / 8);
+		VbErased = (uint8_t*) malloc((Geometry->blocksPerBank + 7) / 8);
+		if(VbStateKnown == NULL || VbErased == NULL)
+			return -1;
+	}
+
+	memset(VbStateKnown, 0, (Geometry->blocksPerBank + 7) / 8);
+	memset(VbErased, 0, (Geometry->blocksPerBank + 7) / 8);
+
 	curVFLusnInc = 0;
 
 	return 0;
@@ -174,7 +298,7 @@ static int FTL_Init() {
 		NumPagesToWriteInStoreCxt = Geometry->pagesPerSuBlk / 8;
 	}
 
-	StoreCxt = malloc(Geometry->bytesPerPage * NumPagesToWriteInStoreCxt);
+	StoreCxt = malloc_dma(Geometry->bytesPerPage * NumPagesToWriteInStoreCxt);
 	ScatteredVirtualPageNumberBuffer = (uint32_t*) malloc(Geometry->pagesPerSuBlk * sizeof(uint32_t*));
 
 	if(!pstFTLCxt->pawMapTable || !pstFTLCxt->wPageOffsets || !pstFTLCxt->pawEraseCounterTable || !FTLCxtBuffer->pawReadCounterTable || ! FTLSpareBuffer || !StoreCxt || !ScatteredVirtualPageNumberBuffer)
@@ -193,10 +317,17 @@ static int FTL_Init() {
 }
 
 // pageBuffer and spareBuffer are represented by single BUF struct within Whimory
+// With no pageBuffer only the spares are read, which is all a scan needs.
 static int nand_read_vfl_cxt_page(int bank, int block, int page, uint8_t* pageBuffer, uint8_t* spareBuffer) {
 	int i;
 	for(i = 0; i < 8; i++) {
-		if(nand_read(bank, (block * Geometry->pagesPerBlock) + page + i, pageBuffer, spareBuffer, TRUE, TRUE) == 0) {
+		int ret;
+		if(pageBuffer == NULL)
+			ret = nand_read_spare(bank, (block * Geometry->pagesPerBlock) + page + i, spareBuffer, TRUE);
+		else
+			ret = nand_read(bank, (block * Geometry->pagesPerBlock) + page + i, pageBuffer, spareBuffer, TRUE, TRUE);
+
+		if(ret == 0) {
 			SpareData* spareData = (SpareData*) spareBuffer;
 			if(spareData->type2 == 0 && spareData->type1 == 0x80)
 				return TRUE;
@@ -244,10 +375,17 @@ static int vfl_check_checksum(int bank) {
 }
 
 
+// VFL context changes made during an FTL operation are only marked dirty, and
+// each dirty bank's context is committed once when the outermost operation
+// ends. A crash before then loses only the remap bookkeeping of that
+// operation; the contexts on flash stay consistent.
+static int VFLBatchDepth = 0;
+static uint32_t VFLCxtDirty = 0;
+
 static int vfl_store_cxt(int bank)
 {
-	uint8_t* pageBuffer = malloc(Geometry->bytesPerPage);
-	SpareData* spareData = (SpareData*) malloc(Geometry->bytesPerSpare);
+	uint8_t* pageBuffer = malloc_dma(Geometry->bytesPerPage);
+	SpareData* spareData = (SpareData*) malloc_dma(Geometry->bytesPerSpare);
 
 	--pstVFLCxt[bank].usnDec;
 	pstVFLCxt[bank].usnInc = ++curVFLusnInc;
@@ -297,7 +435,10 @@ static int vfl_commit_cxt(int bank)
 {
 	if((pstVFLCxt[bank].nextcxtpage + 8) <= Geometry->pagesPerBlock)
 		if(vfl_store_cxt(bank) == 0)
+		{
+			VFLCxtDirty &= ~(1 << bank);
 			return 0;
+		}
 
 	uint32_t current = pstVFLCxt[bank].activecxtblock;
 	uint32_t block = current;
@@ -322,13 +463,49 @@ static int vfl_commit_cxt(int bank)
 		pstVFLCxt[bank].activecxtblock = block;
 		pstVFLCxt[bank].nextcxtpage = 0;
 		if(vfl_store_cxt(bank) == 0)
+		{
+			VFLCxtDirty &= ~(1 << bank);
 			return 0;
+		}
 	}
 
 	bufferPrintf("ftl: failed to commit VFL context!\r\n");
 	return -1;
 }
 
+static int vfl_cxt_changed(int bank)
+{
+	if(VFLBatchDepth == 0)
+		return vfl_commit_cxt(bank);
+
+	VFLCxtDirty |= 1 << bank;
+	return 0;
+}
+
+static void vfl_batch_begin()
+{
+	++VFLBatchDepth;
+}
+
+static int vfl_batch_end()
+{
+	int ret = 0;
+	if(--VFLBatchDepth > 0)
+		return 0;
+
+	int bank;
+	for(bank = 0; bank < Geometry->banksTotal; bank++)
+	{
+		if((VFLCxtDirty & (1 << bank)) == 0)
+			continue;
+
+		if(vfl_commit_cxt(bank) != 0)
+			ret = -1;
+	}
+
+	return ret;
+}
+
 static int vfl_store_FTLCtrlBlock()
 {
 	int bank;
@@ -339,33 +516,104 @@ static int vfl_store_FTLCtrlBlock()
 	return vfl_commit_cxt(curVFLusnInc % Geometry->banksTotal);
 }
 
-static void virtual_page_number_to_virtual_address(uint32_t dwVpn, uint16_t* virtualBank, uint16_t* virtualBlock, uint16_t* virtualPage) {
+static void virtual_address_div(uint32_t dwVpn, uint16_t* virtualBank, uint16_t* virtualBlock, uint16_t* virtualPage) {
 	*virtualBank = dwVpn % Geometry->banksTotal;
 	*virtualBlock = dwVpn / Geometry->pagesPerSuBlk;
 	*virtualPage = (dwVpn / Geometry->banksTotal) % Geometry->pagesPerBlock;
 }
 
+static void virtual_address_pow2(uint32_t dwVpn, uint16_t* virtualBank, uint16_t* virtualBlock, uint16_t* virtualPage) {
+	*virtualBank = dwVpn & (Geometry->banksTotal - 1);
+	*virtualBlock = dwVpn >> PagesPerSuBlkShift;
+	*virtualPage = (dwVpn >> BanksShift) & (Geometry->pagesPerBlock - 1);
+}
+
+static int ftl_log2(uint32_t value) {
+	int shift = 0;
+
+	if(value == 0 || (value & (value - 1)) != 0)
+		return -1;
+
+	while((1U << shift) != value)
+		shift++;
+
+	return shift;
+}
+
+static void ftl_geometry_setup() {
+	int banks = ftl_log2(Geometry->banksTotal);
+	int pagesPerBlock = ftl_log2(Geometry->pagesPerBlock);
+	int pagesPerSuBlk = ftl_log2(Geometry->pagesPerSuBlk);
+	int bytesPerPage = ftl_log2(Geometry->bytesPerPage);
+
+	GeometryIsPow2 = banks >= 0 && pagesPerBlock >= 0 && pagesPerSuBlk >= 0 && bytesPerPage >= 0;
+	if(!GeometryIsPow2) {
+		bufferPrintf("ftl: geometry is not a power of two, address math will divide\r\n");
+		virtual_page_number_to_virtual_address = virtual_address_div;
+		return;
+	}
+
+	BanksShift = banks;
+	PagesPerSuBlkShift = pagesPerSuBlk;
+	BytesPerPageShift = bytesPerPage;
+	virtual_page_number_to_virtual_address = virtual_address_pow2;
+}
+
+// virtual block a virtual page number belongs to, and where in it
+static inline uint32_t vpn_to_vbn(uint32_t vpn) {
+	return GeometryIsPow2 ? (vpn >> PagesPerSuBlkShift) : (vpn / Geometry->pagesPerSuBlk);
+}
+
+static inline uint32_t vpn_to_offset(uint32_t vpn) {
+	return GeometryIsPow2 ? (vpn & (Geometry->pagesPerSuBlk - 1)) : (vpn % Geometry->pagesPerSuBlk);
+}
+
+static inline uint32_t bytes_to_pages(uint64_t bytes) {
+	return GeometryIsPow2 ? (uint32_t)(bytes >> BytesPerPageShift) : (uint32_t)(bytes / Geometry->bytesPerPage);
+}
+
 // badBlockTable is a bit array with 8 virtual blocks in one bit entry
 static int isGoodBlock(uint8_t* badBlockTable, uint16_t virtualBlock) {
 	int index = virtualBlock/8;
 	return ((badBlockTable[index / 8] >> (7 - (index % 8))) & 0x1) == 0x1;
 }
 
+// RemapIndex holds, for every block of every bank, the first entry of
+// reservedBlockPoolMap that replaces it, or 0xFFFF. It has to follow
+// every change to the map below numReservedBlocks.
+static inline uint16_t* remap_index(int bank, uint16_t block) {
+	return &RemapIndex[(bank * Geometry->blocksPerBank) + block];
+}
+
+static void vfl_remap_index_build(int bank) {
+	int i;
+
+	for(i = 0; i < Geometry->blocksPerBank; i++)
+		*remap_index(bank, i) = 0xFFFF;
+
+	// backwards, so the first entry for a block is the one left
+	for(i = pstVFLCxt[bank].numReservedBlocks - 1; i >= 0; i--) {
+		uint16_t block = pstVFLCxt[bank].reservedBlockPoolMap[i];
+		if(block < Geometry->blocksPerBank)
+			*remap_index(bank, block) = i;
+	}
+}
+
 static uint16_t virtual_block_to_physical_block(uint16_t virtualBank, uint16_t virtualBlock) {
 	if(isGoodBlock(pstVFLCxt[virtualBank].badBlockTable, virtualBlock))
 		return virtualBlock;
 
-	int pwDesPbn;
-	for(pwDesPbn = 0; pwDesPbn < pstVFLCxt[virtualBank].numReservedBlocks; pwDesPbn++) {
-		if(pstVFLCxt[virtualBank].reservedBlockPoolMap[pwDesPbn] == virtualBlock) {
-			if(pwDesPbn >= Geometry->blocksPerBank) {
-				bufferPrintf("ftl: Destination physical block for remapping is greater than number of blocks per bank!");
-			}
-			return pstVFLCxt[virtualBank].reservedBlockPoolStart + pwDesPbn;
-		}
-	}
+	if(virtualBlock >= Geometry->blocksPerBank)
+		return virtualBlock;
 
-	return virtualBlock;
+	uint16_t pwDesPbn = *remap_index(virtualBank, virtualBlock);
+	if(pwDesPbn == 0xFFFF)
+		return virtualBlock;
+
+	if(pwDesPbn >= Geometry->blocksPerBank) {
+		bufferPrintf("ftl: Destination physical block for remapping is greater than number of blocks per bank!");
+	}
+	return pstVFLCxt[virtualBank].reservedBlockPoolStart + pwDesPbn;
 }
 
 static int vfl_check_remap_scheduled(int bank, uint16_t block)
@@ -401,7 +649,7 @@ static int vfl_schedule_block_for_remap(int bank, uint16_t block)
 	pstVFLCxt[bank].reservedBlockPoolMap[pstVFLCxt[bank].remappingScheduledStart] = block;
 	vfl_gen_checksum(bank);
 
-	return vfl_commit_cxt(bank);
+	return vfl_cxt_changed(bank);
 }
 
 void vfl_set_good_block(int bank, uint16_t block, int isGood)
@@ -457,6 +705,7 @@ uint16_t vfl_remap_block(int bank, uint16_t block)
 
 	pstVFLCxt[bank].reservedBlockPoolMap[newBlockIdx] = block;
 	++pstVFLCxt[bank].numReservedBlocks;
+	*remap_index(bank, block) = newBlockIdx;
 	vfl_set_good_block(bank, block, FALSE);
 
 	return newBlock;
@@ -484,12 +733,27 @@ static void vfl_mark_remap_done(int bank, uint16_t block)
 	}
 }
 
-int VFL_Erase(uint16_t block) {
+static void vfl_note_vb(uint32_t vb, int erased)
+{
+	if(vb >= Geometry->blocksPerBank)
+		return;
+
+	VbStateKnown[vb / 8] |= 1 << (vb % 8);
+	if(erased)
+		VbErased[vb / 8] |= 1 << (vb % 8);
+	else
+		VbErased[vb / 8] &= ~(1 << (vb % 8));
+}
+
+static int vfl_do_erase(uint16_t block) {
 	uint16_t physicalBlock;
 	int ret;
 	int bank;
 	int i;
 
+	// not erased until every bank of it is
+	vfl_note_vb(block, FALSE);
+
 	block = block + FTLData->field_4;
 
 	for(bank = 0; bank < Geometry->banksTotal; ++bank) {
@@ -497,7 +761,7 @@ int VFL_Erase(uint16_t block) {
 		{
 			vfl_remap_block(bank, block);
 			vfl_mark_remap_done(bank, block);
-			vfl_commit_cxt(bank);
+			vfl_cxt_changed(bank);
 		}
 
 		physicalBlock = virtual_block_to_physical_block(bank, block);
@@ -516,10 +780,11 @@ int VFL_Erase(uint16_t block) {
 		}
 	}
 
+	vfl_note_vb(block - FTLData->field_4, TRUE);
 	return 0;
 }
 
-int VFL_Read(uint32_t virtualPageNumber, uint8_t* buffer, uint8_t* spare, int empty_ok, int* refresh_page) {
+static int vfl_do_read(uint32_t virtualPageNumber, uint8_t* buffer, uint8_t* spare, int empty_ok, int* refresh_page) {
 	if(refresh_page) {
 		*refresh_page = FALSE;
 	}
@@ -580,7 +845,7 @@ int VFL_Read(uint32_t virtualPageNumber, uint8_t* buffer, uint8_t* spare, int em
 	return ret;
 }
 
-int VFL_Write(uint32_t virtualPageNumber, uint8_t* buffer, uint8_t* spare)
+static int vfl_do_write(uint32_t virtualPageNumber, uint8_t* buffer, uint8_t* spare)
 {
 	uint32_t dwVpn = virtualPageNumber + (Geometry->pagesPerSuBlk * FTLData->field_4);
 	if(dwVpn >= Geometry->pagesTotal) {
@@ -602,6 +867,8 @@ int VFL_Write(uint32_t virtualPageNumber, uint8_t* buffer, uint8_t* spare)
 
 	int page = physicalBlock * Geometry->pagesPerBlock + virtualPage;
 
+	vfl_note_vb(virtualPageNumber / Geometry->pagesPerSuBlk, FALSE);
+
 	int ret = nand_write(virtualBank, page, buffer, spare, TRUE);
 	if(ret == 0)
 		return 0;
@@ -613,9 +880,63 @@ int VFL_Write(uint32_t virtualPageNumber, uint8_t* buffer, uint8_t* spare)
 	return -1;
 }
 
+int VFL_Read(uint32_t virtualPageNumber, uint8_t* buffer, uint8_t* spare, int empty_ok, int* refresh_page) {
+	mutex_lock(&FTLLock);
+	uint64_t start = latency_start();
+	int ret = vfl_do_read(virtualPageNumber, buffer, spare, empty_ok, refresh_page);
+	latency_record(LatencyVFLRead, virtualPageNumber, 1, start);
+	mutex_unlock(&FTLLock);
+	return ret;
+}
+
+int VFL_Write(uint32_t virtualPageNumber, uint8_t* buffer, uint8_t* spare) {
+	mutex_lock(&FTLLock);
+	uint64_t start = latency_start();
+	int ret = vfl_do_write(virtualPageNumber, buffer, spare);
+	latency_record(LatencyVFLWrite, virtualPageNumber, 1, start);
+	mutex_unlock(&FTLLock);
+	return ret;
+}
+
+int VFL_Erase(uint16_t block) {
+	mutex_lock(&FTLLock);
+	int ret = vfl_do_erase(block);
+	mutex_unlock(&FTLLock);
+	return ret;
+}
+
+// Whether nothing has been written to virtual block vb since it was erased.
+// The FTL fills each block from its first page on, so if that one is empty
+// the rest are too; it is looked at once and the answer kept from then on.
+static int vfl_vb_erased(uint16_t vb)
+{
+	SpareData spare;
+
+	if(vb >= Geometry->blocksPerBank)
+		return FALSE;
+
+	if((VbStateKnown[vb / 8] & (1 << (vb % 8))) == 0)
+		vfl_note_vb(vb, VFL_Read(vb * Geometry->pagesPerSuBlk, NULL, (uint8_t*) &spare, TRUE, NULL) == ERROR_EMPTYBLOCK);
+
+	return (VbErased[vb / 8] & (1 << (vb % 8))) != 0;
+}
+
+static int VFL_ReadScatteredPagesInVb(uint32_t* virtualPageNumber, int count, uint8_t* main, SpareData* spare, int* refresh_page);
+
 static int VFL_ReadMultiplePagesInVb(int logicalBlock, int logicalPage, int count, uint8_t* main, SpareData* spare, int* refresh_page) {
 	int i;
 	int currentPage = logicalPage; 
+
+	// Read them all in one go first, so that the banks work in parallel. Only
+	// if that fails go through VFL_Read page by page, which retries and remaps.
+	if(count > 1 && count <= Geometry->pagesPerSuBlk) {
+		for(i = 0; i < count; i++)
+			ScatteredVirtualPageNumberBuffer[i] = (logicalBlock * Geometry->pagesPerSuBlk) + logicalPage + i;
+
+		if(VFL_ReadScatteredPagesInVb(ScatteredVirtualPageNumberBuffer, count, main, spare, refresh_page))
+			return TRUE;
+	}
+
 	for(i = 0; i < count; i++) {
 		int ret = VFL_Read((logicalBlock * Geometry->pagesPerSuBlk) + currentPage, main + (Geometry->bytesPerPage * i), (uint8_t*) &spare[i], TRUE, refresh_page);
 		currentPage++;
@@ -658,6 +979,82 @@ static int VFL_ReadScatteredPagesInVb(uint32_t* virtualPageNumber, int count, ui
 		return TRUE;
 }
 
+// Pages ftl_copy_block reads and writes at a time. Doing several pages per
+// FTL_Read and VFL_WriteScatteredPagesInVb lets the banks work on them
+// concurrently and use cache reads.
+#ifndef FTL_COPY_BATCH
+#define FTL_COPY_BATCH 16
+#endif
+
+// VFL_Write for count pages at once, which nand_write_multiple spreads over the
+// banks. Every page that fails gets its block scheduled for remapping, as
+// VFL_Write would. Returns 0 if they all wrote.
+static int VFL_WriteScatteredPagesInVb(uint32_t* virtualPageNumber, int count, uint8_t* main, SpareData* spare) {
+	uint64_t start = latency_start();
+	uint16_t virtualBlock[FTL_COPY_BATCH];
+	int ret = 0;
+	int i;
+
+	if(count > FTL_COPY_BATCH)
+		return ERROR_ARG;
+
+	for(i = 0; i < count; i++) {
+		uint32_t dwVpn = virtualPageNumber[i] + (Geometry->pagesPerSuBlk * FTLData->field_4);
+		if(dwVpn >= Geometry->pagesTotal) {
+			bufferPrintf("ftl: dwVpn overflow: %d\r\n", dwVpn);
+			return ERROR_ARG;
+		}
+
+		uint16_t virtualPage;
+		uint16_t physicalBlock;
+
+		virtual_page_number_to_virtual_address(dwVpn, &ScatteredBankNumberBuffer[i], &virtualBlock[i], &virtualPage);
+		physicalBlock = virtual_block_to_physical_block(ScatteredBankNumberBuffer[i], virtualBlock[i]);
+		ScatteredPageNumberBuffer[i] = physicalBlock * Geometry->pagesPerBlock + virtualPage;
+		vfl_note_vb(virtualPageNumber[i] / Geometry->pagesPerSuBlk, FALSE);
+	}
+
+	if(nand_write_multiple(ScatteredBankNumberBuffer, ScatteredPageNumberBuffer, main, spare, ScatteredStatusBuffer, count) != 0) {
+		for(i = 0; i < count; i++) {
+			if(ScatteredStatusBuffer[i] == 0)
+				continue;
+
+			++pstVFLCxt[ScatteredBankNumberBuffer[i]].field_16;
+			vfl_gen_checksum(ScatteredBankNumberBuffer[i]);
+			vfl_schedule_block_for_remap(ScatteredBankNumberBuffer[i], virtualBlock[i]);
+		}
+		ret = -1;
+	}
+
+	latency_record(LatencyVFLWrite, virtualPageNumber[0], count, start);
+	return ret;
+}
+
+// Spare-only reads of count pages of virtual block vb from page on, overlapped
+// across the banks. Pages that fail are retried on their own through VFL_Read.
+static void VFL_ReadSparesInVb(uint16_t vb, int page, int count, SpareData* spare, int* status) {
+	VFLData1.field_8 += count;
+	VFLData1.field_20++;
+
+	int i;
+	for(i = 0; i < count; i++) {
+		uint32_t dwVpn = (vb * Geometry->pagesPerSuBlk) + page + i + (Geometry->pagesPerSuBlk * FTLData->field_4);
+
+		uint16_t virtualBlock;
+		uint16_t virtualPage;
+
+		virtual_page_number_to_virtual_address(dwVpn, &ScatteredBankNumberBuffer[i], &virtualBlock, &virtualPage);
+		ScatteredPageNumberBuffer[i] = virtual_block_to_physical_block(ScatteredBankNumberBuffer[i], virtualBlock) * Geometry->pagesPerBlock + virtualPage;
+	}
+
+	nand_read_spare_multiple(ScatteredBankNumberBuffer, ScatteredPageNumberBuffer, spare, status, count);
+
+	for(i = 0; i < count; i++) {
+		if(status[i] == ERROR_NAND || status[i] == ERROR_ARG)
+			status[i] = VFL_Read((vb * Geometry->pagesPerSuBlk) + page + i, NULL, (uint8_t*) &spare[i], TRUE, NULL);
+	}
+}
+
 // sub_18015A9C
 static uint16_t* VFL_get_FTLCtrlBlock() {
 	int bank = 0;
@@ -688,8 +1085,8 @@ static int VFL_Open() {
 
 
 		VFLCxt* curVFLCxt = &pstVFLCxt[bank];
-		uint8_t* pageBuffer = malloc(Geometry->bytesPerPage);
-		uint8_t* spareBuffer = malloc(Geometry->bytesPerSpare);
+		uint8_t* pageBuffer = malloc_dma(Geometry->bytesPerPage);
+		uint8_t* spareBuffer = malloc_dma(Geometry->bytesPerSpare);
 		if(pageBuffer == NULL || spareBuffer == NULL) {
 			bufferPrintf("ftl: cannot allocate page and spare buffer\r\n");
 			return -1;
@@ -727,7 +1124,7 @@ static int VFL_Open() {
 			if(block == 0xFFFF)
 				continue;
 
-			if(nand_read_vfl_cxt_page(bank, block, 0, pageBuffer, spareBuffer) != TRUE)
+			if(nand_read_vfl_cxt_page(bank, block, 0, NULL, spareBuffer) != TRUE)
 				continue;
 
 			SpareData* spareData = (SpareData*) spareBuffer;
@@ -751,7 +1148,7 @@ static int VFL_Open() {
 		int page = 8;
 		int last = 0;
 		for(page = 8; page < Geometry->pagesPerBlock; page += 8) {
-			if(nand_read_vfl_cxt_page(bank, curVFLCxt->VFLCxtBlock[VFLCxtIdx], page, pageBuffer, spareBuffer) == FALSE) {
+			if(nand_read_vfl_cxt_page(bank, curVFLCxt->VFLCxtBlock[VFLCxtIdx], page, NULL, spareBuffer) == FALSE) {
 				break;
 			}
 			
@@ -781,6 +1178,8 @@ static int VFL_Open() {
 			bufferPrintf("ftl: VFLCxt has bad checksum\n");
 			return -1;
 		}
+
+		vfl_remap_index_build(bank);
 	} 
 
 	// retrieve the FTL control blocks from the latest VFL across all banks.
@@ -806,23 +1205,86 @@ void FTL_64bit_sum(uint64_t* src, uint64_t* dest, int size) {
 	}
 }
 
+// Blocks given back to awFreeVb are erased later instead of by the merge
+// that released them: by the GC task while the FTL is idle, or by
+// ftl_get_free_vb if the block is handed out again first, which prefers
+// blocks that are already erased. The context on flash has no room for this,
+// so ftl_do_sync erases all of them before committing: a clean context's free
+// blocks are erased, as iBoot and iOS expect, and after an unclean one
+// check_for_dirty_free_vb finds the ones that are not.
+static uint8_t* FreeVbDirty = NULL;
+static int FreeVbDirtyCount = 0;
+static uint32_t FreeVbErasedIdle = 0;
+static uint32_t FreeVbErasedInline = 0;
+
+static int ftl_erase_free_vb(uint16_t block)
+{
+	++pstFTLCxt->pawEraseCounterTable[block];
+	pstFTLCxt->pawReadCounterTable[block] = 0;
+
+	if(VFL_Erase(block) != 0)
+	{
+		bufferPrintf("ftl: failed to erase free virtual block %d\r\n", block);
+		return FALSE;
+	}
+
+	if(FreeVbDirty != NULL && FreeVbDirty[block])
+	{
+		FreeVbDirty[block] = FALSE;
+		--FreeVbDirtyCount;
+	}
+
+	return TRUE;
+}
+
+// For a block that just went into awFreeVb. Without the table it is erased
+// right away, as it always used to be.
+static int ftl_free_vb_needs_erase(uint16_t block)
+{
+	if(FreeVbDirty == NULL)
+		return ftl_erase_free_vb(block);
+
+	if(!FreeVbDirty[block])
+	{
+		FreeVbDirty[block] = TRUE;
+		++FreeVbDirtyCount;
+	}
+
+	return TRUE;
+}
+
+// Erases every free block still waiting for it.
+static int ftl_erase_dirty_free_vbs()
+{
+	int i;
+	int curFreeIdx = pstFTLCxt->nextFreeIdx;
+
+	for(i = 0; i < pstFTLCxt->wNumOfFreeVb && FreeVbDirtyCount > 0; ++i)
+	{
+		uint16_t block = pstFTLCxt->awFreeVb[curFreeIdx];
+		if(block != 0xFFFF && FreeVbDirty[block] && !ftl_erase_free_vb(block))
+			return FALSE;
+
+		curFreeIdx = (curFreeIdx + 1) % 20;
+	}
+
+	return TRUE;
+}
+
 static int ftl_set_free_vb(uint16_t block)
 {
 	// get to the end of the ring buffer
 	int nextFreeVb = (pstFTLCxt->nextFreeIdx + pstFTLCxt->wNumOfFreeVb) % 20;
 	++pstFTLCxt->wNumOfFreeVb;
 
-	++pstFTLCxt->pawEraseCounterTable[block];
-	pstFTLCxt->pawReadCounterTable[block] = 0;
+	pstFTLCxt->awFreeVb[nextFreeVb] = block;
 
-	if(VFL_Erase(block) != 0)
+	if(!ftl_free_vb_needs_erase(block))
 	{
 		bufferPrintf("ftl: failed to release a virtual block from the pool\r\n");
 		return FALSE;
 	}
 
-	pstFTLCxt->awFreeVb[nextFreeVb] = block;
-
 	return TRUE;
 }
 
@@ -831,16 +1293,21 @@ static int ftl_get_free_vb(uint16_t* block)
 	int i;
 
 	int chosenVbIdx = 20;
+	int chosenDirty = TRUE;
 	int curFreeIdx = pstFTLCxt->nextFreeIdx;
 	uint16_t smallestEC = 0xFFFF;
 	for(i = 0; i < pstFTLCxt->wNumOfFreeVb; ++i)
 	{
-		if(pstFTLCxt->awFreeVb[curFreeIdx] != 0xFFFF)
+		uint16_t vb = pstFTLCxt->awFreeVb[curFreeIdx];
+		if(vb != 0xFFFF && vb <= (Geometry->userSuBlksTotal + 23))
 		{
-			if(pstFTLCxt->pawEraseCounterTable[pstFTLCxt->awFreeVb[curFreeIdx]] < smallestEC)
+			// an erased block wins over any that would have to be erased first
+			int dirty = (FreeVbDirty != NULL && FreeVbDirty[vb]);
+			if((chosenDirty && !dirty) || (dirty == chosenDirty && pstFTLCxt->pawEraseCounterTable[vb] < smallestEC))
 			{
-				smallestEC = pstFTLCxt->pawEraseCounterTable[pstFTLCxt->awFreeVb[curFreeIdx]];
+				smallestEC = pstFTLCxt->pawEraseCounterTable[vb];
 				chosenVbIdx = curFreeIdx;
+				chosenDirty = dirty;
 			}
 		}
 		curFreeIdx = (curFreeIdx + 1) % 20;
@@ -854,6 +1321,14 @@ static int ftl_get_free_vb(uint16_t* block)
 
 	uint16_t chosenVb = pstFTLCxt->awFreeVb[chosenVbIdx];
 
+	if(chosenDirty && FreeVbDirty != NULL)
+	{
+		if(!ftl_erase_free_vb(chosenVb))
+			return FALSE;
+
+		++FreeVbErasedInline;
+	}
+
 	if(chosenVbIdx != pstFTLCxt->nextFreeIdx)
 	{
 		// swap
@@ -942,7 +1417,8 @@ static int ftl_next_ctrl_page()
 		pstFTLCxt->FTLCtrlBlock[blockIdx] = newBlock;
 		pstFTLCxt->FTLCtrlPage = newBlock * Geometry->pagesPerSuBlk;
 
-		if(!ftl_set_free_vb(oldBlock))
+		// this can happen in the middle of a commit, too late for ftl_do_sync to erase it
+		if(!ftl_set_free_vb(oldBlock) || (FreeVbDirty != NULL && !ftl_erase_free_vb(oldBlock)))
 		{
 			bufferPrintf("ftl: next_ctrl_page failed to set free VB\r\n");
 			return FALSE;
@@ -964,58 +1440,234 @@ static int ftl_next_ctrl_page()
 // Return whether the block is sequential and also the highest USN of pages
 // found in that block. Assumption: for any pages p_i, p_j in a block where
 // i < j, usn(p_i) <= usn(p_j)
+// Restore looks at the same blocks over and over, so it keeps what it learns
+// about each one here.
+static uint32_t* RestoreBlockUSN = NULL;
+static uint8_t* RestoreBlockSeq = NULL;
+static SpareData* RestoreSpares = NULL;
+static int* RestoreStatus = NULL;
+
+static void ftl_restore_free_caches()
+{
+	free(RestoreBlockUSN);
+	free(RestoreBlockSeq);
+	free(RestoreSpares);
+	free(RestoreStatus);
+	RestoreBlockUSN = NULL;
+	RestoreBlockSeq = NULL;
+	RestoreSpares = NULL;
+	RestoreStatus = NULL;
+}
+
 static int determine_block_type(uint16_t block, uint32_t* highest_usn)
 {
-	uint8_t* pageBuffer = (uint8_t*) malloc(Geometry->bytesPerPage);
-	SpareData* spareData = (SpareData*) malloc(Geometry->bytesPerSpare);
-	int isSequential = TRUE;
+	if(RestoreBlockUSN[block] != 0xFFFFFFFF)
+	{
+		*highest_usn = RestoreBlockUSN[block];
+		return RestoreBlockSeq[block];
+	}
 
-	uint32_t max = 0;	
-	int page;
-	for(page = Geometry->pagesPerSuBlk - 1; page >= 0; --page)
+	int isSequential = TRUE;
+	int foundTop = FALSE;
+	uint32_t max = 0;
+
+	// Pages are programmed in order and USNs never go down, so the last written
+	// page has the highest USN. Walk down from the top a wave of banks at a time
+	// and stop as soon as both answers are known.
+	int top = Geometry->pagesPerSuBlk;
+	while(top > 0 && (!foundTop || isSequential))
 	{
-		int ret = VFL_Read(block * Geometry->pagesPerSuBlk + page, pageBuffer, (uint8_t*) spareData, TRUE, NULL);
-		if(ret != 0)
-			continue;
-		
-		if(spareData->user.usn > max)
-			max = spareData->user.usn;
+		int count = (top > Geometry->banksTotal) ? Geometry->banksTotal : top;
+		int first = top - count;
+		VFL_ReadSparesInVb(block, first, count, RestoreSpares, RestoreStatus);
+
+		int i;
+		for(i = count - 1; i >= 0; --i)
+		{
+			if(RestoreStatus[i] != 0)
+				continue;
+
+			if(RestoreSpares[i].user.usn > max)
+				max = RestoreSpares[i].user.usn;
+			foundTop = TRUE;
 
-		if((spareData->user.logicalPageNumber % Geometry->pagesPerSuBlk) != page)
-			isSequential = FALSE;
+			if((RestoreSpares[i].user.logicalPageNumber % Geometry->pagesPerSuBlk) != (first + i))
+				isSequential = FALSE;
+		}
+
+		top = first;
 	}
 
-	free(spareData);
-	free(pageBuffer);
+	RestoreBlockUSN[block] = max;
+	RestoreBlockSeq[block] = isSequential;
 
 	*highest_usn = max;
 
 	return isSequential;
 }
 
-// Assumptions: same conditions that FTL_Open would have been called in.
-static int FTL_Restore() {
-	uint16_t* blockMap = (uint16_t*) malloc((Geometry->userSuBlksTotal + 23) * sizeof(uint16_t));
-	uint8_t* isEmpty = (uint8_t*) malloc((Geometry->userSuBlksTotal + 23) * sizeof(uint8_t));
-	uint8_t* nonSequential = (uint8_t*) malloc((Geometry->userSuBlksTotal + 23) * sizeof(uint8_t));
-	uint32_t* usnA = (uint32_t*) malloc(sizeof(uint32_t) * Geometry->pagesPerSuBlk);
-	uint32_t* usnB = (uint32_t*) malloc(sizeof(uint32_t) * Geometry->pagesPerSuBlk);
-	uint32_t* lpnA = (uint32_t*) malloc(sizeof(uint32_t) * Geometry->pagesPerSuBlk);
-	uint32_t* lpnB = (uint32_t*) malloc(sizeof(uint32_t) * Geometry->pagesPerSuBlk);
-	uint16_t* awFreeVb = &pstFTLCxt->awFreeVb[0];
-	uint16_t* pawMapTable = pstFTLCxt->pawMapTable;
-	uint16_t* pawEraseCounterTable = pstFTLCxt->pawEraseCounterTable;
-	void* pawReadCounterTable = pstFTLCxt->pawReadCounterTable;
-	uint16_t* wPageOffsets = pstFTLCxt->wPageOffsets;
-	FTLCxtLog* pLog = &pstFTLCxt->pLog[0];
-
-	uint8_t* pageBuffer = (uint8_t*) malloc(Geometry->bytesPerPage);
-	SpareData* spareData = (SpareData*) malloc(Geometry->bytesPerSpare);
+// A copy of what each table page the context points to holds on flash, so
+// a commit only has to write the pages that changed since. A page is left
+// where it is only if it is in the ctrl block the new context goes to, as
+// ftl_next_ctrl_page erases the other ctrl blocks when it moves on.
+#define FTL_COMMIT_MAP 0
+#define FTL_COMMIT_OFFSETS 1
+#define FTL_COMMIT_ERASE 2
+#define FTL_COMMIT_READ 3
+#define FTL_COMMIT_TABLES 4
+
+typedef struct FTLCommittedTable {
+	uint8_t* copy;
+	uint64_t known;
+} FTLCommittedTable;
+
+static FTLCommittedTable CommittedTables[FTL_COMMIT_TABLES];
+static uint32_t CommitPagesWritten = 0;
+static uint32_t CommitPagesKept = 0;
+
+static uint8_t* ftl_table_data(int table, uint32_t* size, uint32_t** pages)
+{
+	switch(table)
+	{
+		case FTL_COMMIT_MAP:
+			*size = Geometry->userSuBlksTotal * sizeof(uint16_t);
+			*pages = pstFTLCxt->pages_for_pawMapTable;
+			return (uint8_t*) pstFTLCxt->pawMapTable;
 
-	int i;
-	int block;
+		case FTL_COMMIT_OFFSETS:
+			*size = Geometry->pagesPerSuBlk * (FTL_NUM_LOGS * sizeof(uint16_t));
+			*pages = pstFTLCxt->pages_for_wPageOffsets;
+			return (uint8_t*) pstFTLCxt->wPageOffsets;
 
-	bufferPrintf("ftl: restore searching for latest FTL context...\r\n");
+		case FTL_COMMIT_ERASE:
+			*size = (Geometry->userSuBlksTotal + 23) * sizeof(uint16_t);
+			*pages = pstFTLCxt->pages_for_pawEraseCounterTable;
+			return (uint8_t*) pstFTLCxt->pawEraseCounterTable;
+
+		default:
+			*size = (Geometry->userSuBlksTotal + 23) * sizeof(uint16_t);
+			*pages = pstFTLCxt->pages_for_pawReadCounterTable;
+			return (uint8_t*) pstFTLCxt->pawReadCounterTable;
+	}
+}
+
+// Page i of the table in memory is what its page on flash holds now.
+static void ftl_committed_note(int table, int i)
+{
+	FTLCommittedTable* committed = &CommittedTables[table];
+	uint32_t size;
+	uint32_t* pages;
+	uint8_t* data = ftl_table_data(table, &size, &pages);
+
+	if(committed->copy == NULL)
+	{
+		// without it every commit writes the whole table, as it used to
+		committed->copy = (uint8_t*) malloc(size);
+		if(committed->copy == NULL)
+			return;
+	}
+
+	uint32_t offset = i * Geometry->bytesPerPage;
+	uint32_t length = Geometry->bytesPerPage;
+	if(length > (size - offset))
+		length = size - offset;
+
+	memcpy(committed->copy + offset, data + offset, length);
+	committed->known |= 1ULL << i;
+}
+
+static void ftl_committed_forget()
+{
+	int table;
+	for(table = 0; table < FTL_COMMIT_TABLES; table++)
+		CommittedTables[table].known = 0;
+}
+
+// Reads a block may have had since its count was last written out. Read
+// counts that are up by less than this stay in RAM, so reads alone never
+// make a commit write a table page, and a crash loses at most this many
+// reads of each block.
+#ifndef FTL_READ_COUNT_SLACK
+#define FTL_READ_COUNT_SLACK 1000
+#endif
+
+// Whether page i of the table can stay where it is for a context in block keep.
+static int ftl_committed_current(int table, int i, uint16_t keep)
+{
+	FTLCommittedTable* committed = &CommittedTables[table];
+	uint32_t size;
+	uint32_t* pages;
+	uint8_t* data = ftl_table_data(table, &size, &pages);
+
+	if(committed->copy == NULL || (committed->known & (1ULL << i)) == 0)
+		return FALSE;
+
+	if(vpn_to_vbn(pages[i]) != keep)
+		return FALSE;
+
+	uint32_t offset = i * Geometry->bytesPerPage;
+	uint32_t length = Geometry->bytesPerPage;
+	if(length > (size - offset))
+		length = size - offset;
+
+	if(table == FTL_COMMIT_READ)
+	{
+		// a count that went down was reset by an erase, and that has to stick
+		uint16_t* flash = (uint16_t*) (committed->copy + offset);
+		uint16_t* now = (uint16_t*) (data + offset);
+		uint32_t j;
+		for(j = 0; j < (length / sizeof(uint16_t)); j++)
+		{
+			if(now[j] < flash[j] || (now[j] - flash[j]) >= FTL_READ_COUNT_SLACK)
+				return FALSE;
+		}
+
+		return TRUE;
+	}
+
+	return memcmp(committed->copy + offset, data + offset, length) == 0;
+}
+
+static int FTL_Restore() {
+	uint16_t* blockMap = (uint16_t*) malloc((Geometry->userSuBlksTotal + 23) * sizeof(uint16_t));
+	uint8_t* isEmpty = (uint8_t*) malloc((Geometry->userSuBlksTotal + 23) * sizeof(uint8_t));
+	uint8_t* nonSequential = (uint8_t*) malloc((Geometry->userSuBlksTotal + 23) * sizeof(uint8_t));
+	uint32_t* usnA = (uint32_t*) malloc(sizeof(uint32_t) * Geometry->pagesPerSuBlk);
+	uint32_t* usnB = (uint32_t*) malloc(sizeof(uint32_t) * Geometry->pagesPerSuBlk);
+	uint32_t* lpnA = (uint32_t*) malloc(sizeof(uint32_t) * Geometry->pagesPerSuBlk);
+	uint32_t* lpnB = (uint32_t*) malloc(sizeof(uint32_t) * Geometry->pagesPerSuBlk);
+	uint16_t* awFreeVb = &pstFTLCxt->awFreeVb[0];
+	uint16_t* pawMapTable = pstFTLCxt->pawMapTable;
+	uint16_t* pawEraseCounterTable = pstFTLCxt->pawEraseCounterTable;
+	void* pawReadCounterTable = pstFTLCxt->pawReadCounterTable;
+	uint16_t* wPageOffsets = pstFTLCxt->wPageOffsets;
+	FTLCxtLog* pLog = &pstFTLCxt->pLog[0];
+
+	// the tables are rebuilt from scratch, the next commit writes all of them
+	ftl_committed_forget();
+
+	uint8_t* pageBuffer = (uint8_t*) malloc_dma(Geometry->bytesPerPage);
+	SpareData* spareData = (SpareData*) malloc_dma(Geometry->bytesPerSpare);
+	uint16_t* lbnCandidates = (uint16_t*) malloc(Geometry->userSuBlksTotal * sizeof(uint16_t));
+	uint16_t* nextCandidate = (uint16_t*) malloc((Geometry->userSuBlksTotal + 23) * sizeof(uint16_t));
+
+	RestoreBlockUSN = (uint32_t*) malloc((Geometry->userSuBlksTotal + 23) * sizeof(uint32_t));
+	RestoreBlockSeq = (uint8_t*) malloc((Geometry->userSuBlksTotal + 23) * sizeof(uint8_t));
+	RestoreSpares = (SpareData*) malloc(Geometry->banksTotal * sizeof(SpareData));
+	RestoreStatus = (int*) malloc(Geometry->banksTotal * sizeof(int));
+
+	int i;
+	int block;
+
+	if(!RestoreBlockUSN || !RestoreBlockSeq || !RestoreSpares || !RestoreStatus || !lbnCandidates || !nextCandidate)
+	{
+		bufferPrintf("ftl: restore ran out of memory!\r\n");
+		goto error_release;
+	}
+
+	memset(RestoreBlockUSN, 0xFF, (Geometry->userSuBlksTotal + 23) * sizeof(uint32_t));
+
+	bufferPrintf("ftl: restore searching for latest FTL context...\r\n");
 
 	// Step 0, find and load the last readable FTLCxt, so we can have a base erase counter data and
 	// goodies. It is not really mandatory though; we could just make a new one.
@@ -1035,7 +1687,7 @@ static int FTL_Restore() {
 	for(i = 0; i < sizeof(pstFTLCxt->FTLCtrlBlock)/sizeof(uint16_t); ++i)
 	{
 		// read the first page of the block
-		int ret = VFL_Read(Geometry->pagesPerSuBlk * pstFTLCxt->FTLCtrlBlock[i], pageBuffer, (uint8_t*) spareData, TRUE, NULL);
+		int ret = VFL_Read(Geometry->pagesPerSuBlk * pstFTLCxt->FTLCtrlBlock[i], NULL, (uint8_t*) spareData, TRUE, NULL);
 		if(ret != 0)
 			continue;	// this block errored out!
 
@@ -1054,7 +1706,10 @@ static int FTL_Restore() {
 		int page;
 		for(page = Geometry->pagesPerSuBlk - 1; page > 0; page--)
 		{
-			ret = VFL_Read(Geometry->pagesPerSuBlk * ftlCtrlBlock + page, pageBuffer, (uint8_t*) spareData, TRUE, NULL);
+			ret = VFL_Read(Geometry->pagesPerSuBlk * ftlCtrlBlock + page, NULL, (uint8_t*) spareData, TRUE, NULL);
+			if(ret == 0 && spareData->type1 == 0x43)
+				ret = VFL_Read(Geometry->pagesPerSuBlk * ftlCtrlBlock + page, pageBuffer, (uint8_t*) spareData, TRUE, NULL);
+
 			if(ret == 1) {
 				continue;
 			} else if(ret == 0 && spareData->type1 == 0x43) { // 43 is FTLCxtBlock
@@ -1136,34 +1791,70 @@ static int FTL_Restore() {
 		isEmpty[block] = 1;
 		nonSequential[block] = 0;
 
-		int page;
-		for(page = 0; page < Geometry->pagesPerSuBlk; ++page)
+		// spares only, one page from each bank at a time
+		int page = 0;
+		int found = FALSE;
+		while(!found && page < Geometry->pagesPerSuBlk)
 		{
-			int ret = VFL_Read(block * Geometry->pagesPerSuBlk + page, pageBuffer, (uint8_t*) spareData, TRUE, NULL);
+			int count = ((Geometry->pagesPerSuBlk - page) > Geometry->banksTotal) ? Geometry->banksTotal : (Geometry->pagesPerSuBlk - page);
+			int written = FALSE;
+			int j;
 
-			if(ret == ERROR_EMPTYBLOCK)
-				continue;
-			
-			isEmpty[block] = 0;
-			
-			if(ret != 0)
-				continue;
-			
-			if(spareData->type1 >= 0x43 && spareData->type1 <= 0x4F)
-				break;
+			VFL_ReadSparesInVb(block, page, count, RestoreSpares, RestoreStatus);
 
-			// wtf is this? well, we'll just count it as empty
-			if(spareData->type1 != 0x40 && spareData->type1 != 0x41)
-				continue;
+			for(j = 0; j < count && !found; ++j)
+			{
+				SpareData* spare = &RestoreSpares[j];
+
+				if(RestoreStatus[j] == ERROR_EMPTYBLOCK)
+					continue;
+
+				isEmpty[block] = 0;
+				written = TRUE;
+
+				if(RestoreStatus[j] != 0)
+					continue;
 
-			if((spareData->user.logicalPageNumber % Geometry->pagesPerSuBlk) != page)
-				nonSequential[block] = 1;
+				if(spare->type1 >= 0x43 && spare->type1 <= 0x4F)
+				{
+					found = TRUE;
+					break;
+				}
+
+				// wtf is this? well, we'll just count it as empty
+				if(spare->type1 != 0x40 && spare->type1 != 0x41)
+					continue;
+
+				if((spare->user.logicalPageNumber % Geometry->pagesPerSuBlk) != (page + j))
+					nonSequential[block] = 1;
+
+				blockMap[block] = spare->user.logicalPageNumber / Geometry->pagesPerSuBlk;
+				found = TRUE;
+			}
 
-			blockMap[block] = spareData->user.logicalPageNumber / Geometry->pagesPerSuBlk;
-			break;	
+			// pages are programmed in order, so after a wave of empty ones the rest is empty too
+			if(!written)
+				break;
+
+			page += count;
 		}
 	}
 
+	// chain up the candidate virtual blocks of every logical block, in ascending order
+	for(block = 0; block < Geometry->userSuBlksTotal; ++block)
+		lbnCandidates[block] = 0xFFFF;
+
+	for(block = (Geometry->userSuBlksTotal + 23) - 1; block >= 0; --block)
+	{
+		if(blockMap[block] >= Geometry->userSuBlksTotal)
+			continue;
+
+		nextCandidate[block] = lbnCandidates[blockMap[block]];
+		lbnCandidates[blockMap[block]] = block;
+	}
+
+	uint16_t nextEmpty = 0;
+
 	// Step two, make sure each logical block has a mapping to virtual block. If more than one virtual
 	// block contain pages to a logical block, pick which one is a mapping block and which one is a
 	// log block based on whether the entries are sequential and which ones have the highest USN. If
@@ -1186,7 +1877,7 @@ static int FTL_Restore() {
 					block + (((Geometry->userSuBlksTotal - block) > 1000) ? 999 : (Geometry->userSuBlksTotal - block - 1)));
 		}
 
-		for(candidate = 0; candidate < (Geometry->userSuBlksTotal + 23); ++candidate)
+		for(candidate = lbnCandidates[block]; candidate != 0xFFFF; candidate = nextCandidate[candidate])
 		{
 			uint32_t candidateUSN;
 
@@ -1282,7 +1973,8 @@ static int FTL_Restore() {
 
 		if(mapCandidate == 0xFFFF)
 		{
-			for(candidate = 0; candidate < (Geometry->userSuBlksTotal + 23); ++candidate)
+			// blocks only ever stop being empty, so carry on from where the last search ended
+			for(candidate = nextEmpty; candidate < (Geometry->userSuBlksTotal + 23); ++candidate)
 			{
 				if(isEmpty[candidate])
 				{
@@ -1291,6 +1983,7 @@ static int FTL_Restore() {
 					break;
 				}
 			}
+			nextEmpty = candidate;
 
 			if(mapCandidate == 0xFFFF)
 			{
@@ -1384,7 +2077,7 @@ static int FTL_Restore() {
 
 		for(page = Geometry->pagesPerSuBlk - 1; page >= 0; --page)
 		{
-			int ret = VFL_Read((blockA * Geometry->pagesPerSuBlk) + page, pageBuffer, (uint8_t*) spareData, TRUE, NULL);
+			int ret = VFL_Read((blockA * Geometry->pagesPerSuBlk) + page, NULL, (uint8_t*) spareData, TRUE, NULL);
 			if(ret == ERROR_EMPTYBLOCK)
 				usnA[page] = 0;
 			else
@@ -1402,7 +2095,7 @@ static int FTL_Restore() {
 
 		for(page = Geometry->pagesPerSuBlk - 1; page >= 0; --page)
 		{
-			int ret = VFL_Read((blockB * Geometry->pagesPerSuBlk) + page, pageBuffer, (uint8_t*) spareData, TRUE, NULL);
+			int ret = VFL_Read((blockB * Geometry->pagesPerSuBlk) + page, NULL, (uint8_t*) spareData, TRUE, NULL);
 			if(ret == ERROR_EMPTYBLOCK)
 				usnB[page] = 0;
 			else
@@ -1494,6 +2187,9 @@ static int FTL_Restore() {
 	free(blockMap);
 	free(nonSequential);
 	free(isEmpty);
+	free(lbnCandidates);
+	free(nextCandidate);
+	ftl_restore_free_caches();
 
 	return TRUE;
 
@@ -1507,6 +2203,9 @@ error_release:
 	free(blockMap);
 	free(nonSequential);
 	free(isEmpty);
+	free(lbnCandidates);
+	free(nextCandidate);
+	ftl_restore_free_caches();
 
 	return FALSE;
 }
@@ -1554,8 +2253,8 @@ static int ftl_open_read_counter_tables()
 	int i;
 	int pagesToRead;
 
-	uint8_t* pageBuffer = malloc(Geometry->bytesPerPage);
-	uint8_t* spareBuffer = malloc(Geometry->bytesPerSpare);
+	uint8_t* pageBuffer = malloc_dma(Geometry->bytesPerPage);
+	uint8_t* spareBuffer = malloc_dma(Geometry->bytesPerSpare);
 
 	pagesToRead = ((Geometry->userSuBlksTotal + 23) * sizeof(uint16_t)) / Geometry->bytesPerPage;
 	if((((Geometry->userSuBlksTotal + 23) * sizeof(uint16_t)) % Geometry->bytesPerPage) != 0)
@@ -1576,6 +2275,7 @@ static int ftl_open_read_counter_tables()
 		}
 
 		memcpy(((uint8_t*)pstFTLCxt->pawEraseCounterTable) + (i * Geometry->bytesPerPage), pageBuffer, toRead);	
+		ftl_committed_note(FTL_COMMIT_ERASE, i);
 	}
 
 	bufferPrintf("ftl: Detected version %x %x\r\n", FTLCxtBuffer->versionLower, FTLCxtBuffer->versionUpper);
@@ -1597,6 +2297,7 @@ static int ftl_open_read_counter_tables()
 			}
 
 			memcpy(((uint8_t*)pstFTLCxt->pawReadCounterTable) + (i * Geometry->bytesPerPage), pageBuffer, toRead);	
+			ftl_committed_note(FTL_COMMIT_READ, i);
 		}
 
 		if((pstFTLCxt->hasFTLCountsTable + 1) == 0) {
@@ -1644,8 +2345,15 @@ void check_for_dirty_free_vb()
 	if(CleanFreeVb)
 		return;
 
-	uint8_t* pageBuffer = (uint8_t*) malloc(Geometry->bytesPerPage);
-	SpareData* spareData = (SpareData*) malloc(Geometry->bytesPerSpare);
+	// whatever was known about the free blocks is out of date now
+	if(FreeVbDirty != NULL)
+	{
+		memset(FreeVbDirty, FALSE, Geometry->userSuBlksTotal + 24);
+		FreeVbDirtyCount = 0;
+	}
+
+	uint8_t* pageBuffer = (uint8_t*) malloc_dma(Geometry->bytesPerPage);
+	SpareData* spareData = (SpareData*) malloc_dma(Geometry->bytesPerSpare);
 
 	for(i = 0; i < pstFTLCxt->wNumOfFreeVb; ++i)
 	{
@@ -1661,7 +2369,10 @@ void check_for_dirty_free_vb()
 					continue;
 
 				bufferPrintf("ftl: free block %d has non-empty pages.\r\n", block);
-				VFL_Erase(block);
+				if(FreeVbDirty != NULL)
+					ftl_free_vb_needs_erase(block);
+				else
+					VFL_Erase(block);
 				break;
 			}
 		}
@@ -1673,6 +2384,137 @@ void check_for_dirty_free_vb()
 	free(spareData);
 }
 
+// FTL_Open only reads the FTL context itself. The block map, the log page
+// offsets and the erase counters are read a page at a time, when an FTL_Read
+// first needs one of their pages or when the background task gets to it.
+// Anything that changes or commits the context loads them in full first.
+typedef struct FTLLazyTable {
+	uint8_t* data;
+	uint32_t* pages;
+	uint32_t size;
+	int count;
+	uint64_t present;
+} FTLLazyTable;
+
+#define FTL_LAZY_MAP 0
+#define FTL_LAZY_OFFSETS 1
+#define FTL_LAZY_ERASE 2
+#define FTL_LAZY_TABLES 3
+
+#if FTL_LAZY_MAP != FTL_COMMIT_MAP || FTL_LAZY_OFFSETS != FTL_COMMIT_OFFSETS || FTL_LAZY_ERASE != FTL_COMMIT_ERASE
+#error the lazily loaded tables have to be numbered like the committed ones
+#endif
+
+static FTLLazyTable LazyTables[FTL_LAZY_TABLES];
+static int LazyTablesPending = FALSE;
+
+static void ftl_log_index_rebuild();
+
+static void ftl_lazy_init(int table, void* data, uint32_t* pages, uint32_t size)
+{
+	LazyTables[table].data = (uint8_t*) data;
+	LazyTables[table].pages = pages;
+	LazyTables[table].size = size;
+	LazyTables[table].count = (size + Geometry->bytesPerPage - 1) / Geometry->bytesPerPage;
+	LazyTables[table].present = 0;
+}
+
+// The tables on flash cannot be read, rebuild everything the slow way.
+static void ftl_lazy_failed()
+{
+	bufferPrintf("ftl: cannot load FTL tables, restoring\r\n");
+	LazyTablesPending = FALSE;
+	CleanFreeVb = FALSE;
+	if(FTL_Restore() == FALSE)
+		bufferPrintf("ftl: FTL_Restore failed!\r\n");
+
+	ftl_log_index_rebuild();
+}
+
+static int ftl_lazy_load_page(int table, int i)
+{
+	FTLLazyTable* lazy = &LazyTables[table];
+	int refreshPage;
+
+	uint8_t* pageBuffer = malloc_dma(Geometry->bytesPerPage);
+	uint8_t* spareBuffer = malloc_dma(Geometry->bytesPerSpare);
+	if(!pageBuffer || !spareBuffer) {
+		free(pageBuffer);
+		free(spareBuffer);
+		return FALSE;
+	}
+
+	int ret = VFL_Read(lazy->pages[i], pageBuffer, spareBuffer, TRUE, &refreshPage);
+	if(ret == 0) {
+		uint32_t toRead = Geometry->bytesPerPage;
+		if(toRead > (lazy->size - (i * Geometry->bytesPerPage)))
+			toRead = lazy->size - (i * Geometry->bytesPerPage);
+
+		memcpy(lazy->data + (i * Geometry->bytesPerPage), pageBuffer, toRead);
+		lazy->present |= 1ULL << i;
+		ftl_committed_note(table, i);
+	}
+
+	free(pageBuffer);
+	free(spareBuffer);
+
+	if(ret != 0) {
+		ftl_lazy_failed();
+		return FALSE;
+	}
+
+	for(table = 0; table < FTL_LAZY_TABLES; table++) {
+		if(LazyTables[table].present != ((1ULL << LazyTables[table].count) - 1))
+			return TRUE;
+	}
+
+	LazyTablesPending = FALSE;
+	return TRUE;
+}
+
+// Make sure bytes [offset, offset + size) of a table are in memory.
+static int ftl_lazy_ensure(int table, uint32_t offset, uint32_t size)
+{
+	if(!LazyTablesPending)
+		return TRUE;
+
+	int i;
+	for(i = offset / Geometry->bytesPerPage; LazyTablesPending && i <= ((offset + size - 1) / Geometry->bytesPerPage); i++) {
+		if(LazyTables[table].present & (1ULL << i))
+			continue;
+
+		if(!ftl_lazy_load_page(table, i))
+			return FALSE;
+	}
+
+	return TRUE;
+}
+
+static int ftl_lazy_load_next()
+{
+	int table;
+	int i;
+	for(table = 0; table < FTL_LAZY_TABLES; table++) {
+		for(i = 0; i < LazyTables[table].count; i++) {
+			if((LazyTables[table].present & (1ULL << i)) == 0)
+				return ftl_lazy_load_page(table, i);
+		}
+	}
+
+	LazyTablesPending = FALSE;
+	return TRUE;
+}
+
+static int ftl_lazy_load_all()
+{
+	while(LazyTablesPending) {
+		if(!ftl_lazy_load_next())
+			return FALSE;
+	}
+
+	return TRUE;
+}
+
 static int FTL_Open(int* pagesAvailable, int* bytesPerPage) {
 	int refreshPage;
 	int ret;
@@ -1689,8 +2531,8 @@ static int FTL_Open(int* pagesAvailable, int* bytesPerPage) {
 	
 	memcpy(pstFTLCxt->FTLCtrlBlock, FTLCtrlBlock, sizeof(pstFTLCxt->FTLCtrlBlock));
 
-	uint8_t* pageBuffer = malloc(Geometry->bytesPerPage);
-	uint8_t* spareBuffer = malloc(Geometry->bytesPerSpare);
+	uint8_t* pageBuffer = malloc_dma(Geometry->bytesPerPage);
+	uint8_t* spareBuffer = malloc_dma(Geometry->bytesPerSpare);
 	if(!pageBuffer || !spareBuffer) {
 		bufferPrintf("ftl: FTL_Open ran out of memory!\r\n");
 		return ERROR_ARG;
@@ -1703,7 +2545,7 @@ static int FTL_Open(int* pagesAvailable, int* bytesPerPage) {
 	uint32_t minUsnDec = 0xffffffff;
 	for(i = 0; i < sizeof(pstFTLCxt->FTLCtrlBlock)/sizeof(uint16_t); i++) {
 		// read the first page of the block
-		ret = VFL_Read(Geometry->pagesPerSuBlk * pstFTLCxt->FTLCtrlBlock[i], pageBuffer, spareBuffer, TRUE, &refreshPage);
+		ret = VFL_Read(Geometry->pagesPerSuBlk * pstFTLCxt->FTLCtrlBlock[i], NULL, spareBuffer, TRUE, &refreshPage);
 		if(ret == ERROR_ARG) {
 			free(pageBuffer);
 			free(spareBuffer);
@@ -1737,7 +2579,11 @@ static int FTL_Open(int* pagesAvailable, int* bytesPerPage) {
 	// then the shut down was unclean. FTLCxt ought never be the very first page.
 	int ftlCxtFound = FALSE;
 	for(i = Geometry->pagesPerSuBlk - 1; i > 0; i--) {
-		ret = VFL_Read(Geometry->pagesPerSuBlk * ftlCtrlBlock + i, pageBuffer, spareBuffer, TRUE, &refreshPage);
+		// look at the spare first, only the context page itself has to be read in full
+		ret = VFL_Read(Geometry->pagesPerSuBlk * ftlCtrlBlock + i, NULL, spareBuffer, TRUE, &refreshPage);
+		if(ret == 0 && ((SpareData*)spareBuffer)->type1 == 0x43)
+			ret = VFL_Read(Geometry->pagesPerSuBlk * ftlCtrlBlock + i, pageBuffer, spareBuffer, TRUE, &refreshPage);
+
 		if(ret == 1) {
 			continue;
 		} else if(ret == 0 && ((SpareData*)spareBuffer)->type1 == 0x43) { // 43 is FTLCxtBlock
@@ -1770,60 +2616,15 @@ static int FTL_Open(int* pagesAvailable, int* bytesPerPage) {
 		pstFTLCxt->pLog[i].wPageOffsets = pstFTLCxt->wPageOffsets + (i * Geometry->pagesPerSuBlk);
 	}
 
-	int pagesToRead;
-
-	pagesToRead = (Geometry->userSuBlksTotal * sizeof(uint16_t)) / Geometry->bytesPerPage;
-	if(((Geometry->userSuBlksTotal * sizeof(uint16_t)) % Geometry->bytesPerPage) != 0)
-		pagesToRead++;
-
-	for(i = 0; i < pagesToRead; i++) {
-		if(VFL_Read(pstFTLCxt->pages_for_pawMapTable[i], pageBuffer, spareBuffer, TRUE, &refreshPage) != 0)
-			goto FTL_Open_Error_Release;
-
-		int toRead = Geometry->bytesPerPage;
-		if(toRead > ((Geometry->userSuBlksTotal * sizeof(uint16_t)) - (i * Geometry->bytesPerPage))) {
-			toRead = (Geometry->userSuBlksTotal * sizeof(uint16_t)) - (i * Geometry->bytesPerPage);
-		}
-
-		memcpy(((uint8_t*)pstFTLCxt->pawMapTable) + (i * Geometry->bytesPerPage), pageBuffer, toRead);	
-	}
-
-	pagesToRead = (Geometry->pagesPerSuBlk * (17 * sizeof(uint16_t))) / Geometry->bytesPerPage;
-	if(((Geometry->pagesPerSuBlk * (17 * sizeof(uint16_t))) % Geometry->bytesPerPage) != 0)
-		pagesToRead++;
-
-	for(i = 0; i < pagesToRead; i++) {
-		if(VFL_Read(pstFTLCxt->pages_for_wPageOffsets[i], pageBuffer, spareBuffer, TRUE, &refreshPage) != 0)
-			goto FTL_Open_Error_Release;
-
-		int toRead = Geometry->bytesPerPage;
-		if(toRead > ((Geometry->pagesPerSuBlk * (17 * sizeof(uint16_t))) - (i * Geometry->bytesPerPage))) {
-			toRead = (Geometry->pagesPerSuBlk * (17 * sizeof(uint16_t))) - (i * Geometry->bytesPerPage);
-		}
-
-		memcpy(((uint8_t*)pstFTLCxt->wPageOffsets) + (i * Geometry->bytesPerPage), pageBuffer, toRead);	
-	}
-
-	pagesToRead = ((Geometry->userSuBlksTotal + 23) * sizeof(uint16_t)) / Geometry->bytesPerPage;
-	if((((Geometry->userSuBlksTotal + 23) * sizeof(uint16_t)) % Geometry->bytesPerPage) != 0)
-		pagesToRead++;
-
-	for(i = 0; i < pagesToRead; i++) {
-		if(VFL_Read(pstFTLCxt->pages_for_pawEraseCounterTable[i], pageBuffer, spareBuffer, TRUE, &refreshPage) != 0)
-			goto FTL_Open_Error_Release;
-
-		int toRead = Geometry->bytesPerPage;
-		if(toRead > (((Geometry->userSuBlksTotal + 23) * sizeof(uint16_t)) - (i * Geometry->bytesPerPage))) {
-			toRead = ((Geometry->userSuBlksTotal + 23) * sizeof(uint16_t)) - (i * Geometry->bytesPerPage);
-		}
-
-		memcpy(((uint8_t*)pstFTLCxt->pawEraseCounterTable) + (i * Geometry->bytesPerPage), pageBuffer, toRead);	
-	}
+	ftl_lazy_init(FTL_LAZY_MAP, pstFTLCxt->pawMapTable, pstFTLCxt->pages_for_pawMapTable, Geometry->userSuBlksTotal * sizeof(uint16_t));
+	ftl_lazy_init(FTL_LAZY_OFFSETS, pstFTLCxt->wPageOffsets, pstFTLCxt->pages_for_wPageOffsets, Geometry->pagesPerSuBlk * (FTL_NUM_LOGS * sizeof(uint16_t)));
+	ftl_lazy_init(FTL_LAZY_ERASE, pstFTLCxt->pawEraseCounterTable, pstFTLCxt->pages_for_pawEraseCounterTable, (Geometry->userSuBlksTotal + 23) * sizeof(uint16_t));
 
 	int success = ftl_open_read_counter_tables();
 
 	if(success) {
 		CleanFreeVb = TRUE;
+		LazyTablesPending = TRUE;
 		bufferPrintf("ftl: FTL successfully opened!\r\n");
 		free(pageBuffer);
 		free(spareBuffer);
@@ -1857,10 +2658,40 @@ uint32_t FTL_map_page(FTLCxtLog* pLog, int lbn, int offset) {
 	return (pstFTLCxt->pawMapTable[lbn] * Geometry->pagesPerSuBlk) + offset;
 }
 
+// Direct-mapped lbn -> log lookup. Each bucket is a mask of the logs whose
+// lbn falls into it, so most lbns (which have no log) are rejected without
+// looking at pLog at all. A stale bit only costs a compare; a missing one
+// would hide a log, so every change of a log's wLbn has to go through here.
+#define FTL_LOG_INDEX_SIZE 64
+
+static uint32_t LogIndex[FTL_LOG_INDEX_SIZE];
+
+static void ftl_log_index_rebuild()
+{
+	int i;
+	memset(LogIndex, 0, sizeof(LogIndex));
+	for(i = 0; i < FTL_NUM_LOGS; i++) {
+		if(pstFTLCxt->pLog[i].wVbn != 0xFFFF)
+			LogIndex[pstFTLCxt->pLog[i].wLbn & (FTL_LOG_INDEX_SIZE - 1)] |= 1 << i;
+	}
+}
+
+static void ftl_log_index_set_lbn(FTLCxtLog* pLog, uint16_t lbn)
+{
+	uint32_t bit = 1 << (pLog - pstFTLCxt->pLog);
+	LogIndex[pLog->wLbn & (FTL_LOG_INDEX_SIZE - 1)] &= ~bit;
+	pLog->wLbn = lbn;
+	LogIndex[lbn & (FTL_LOG_INDEX_SIZE - 1)] |= bit;
+}
+
 static inline FTLCxtLog* ftl_get_log(uint16_t lbn)
 {
+	uint32_t mask = LogIndex[lbn & (FTL_LOG_INDEX_SIZE - 1)];
 	int i;
-	for(i = 0; i < 17; i++) {
+	for(i = 0; mask != 0; i++, mask >>= 1) {
+		if((mask & 1) == 0)
+			continue;
+
 		if(pstFTLCxt->pLog[i].wVbn == 0xFFFF)
 			continue;
 
@@ -1871,7 +2702,22 @@ static inline FTLCxtLog* ftl_get_log(uint16_t lbn)
 	return NULL;
 }
 
-int FTL_Read(int logicalPageNumber, int totalPagesToRead, uint8_t* pBuf) {
+// ftl_get_log, plus the parts of the tables an FTL_Read of the lbn looks at.
+static FTLCxtLog* ftl_get_log_loaded(int lbn)
+{
+	FTLCxtLog* pLog = ftl_get_log(lbn);
+	if(!LazyTablesPending)
+		return pLog;
+
+	ftl_lazy_ensure(FTL_LAZY_MAP, lbn * sizeof(uint16_t), sizeof(uint16_t));
+	if(pLog != NULL)
+		ftl_lazy_ensure(FTL_LAZY_OFFSETS, (pLog->wPageOffsets - pstFTLCxt->wPageOffsets) * sizeof(uint16_t), Geometry->pagesPerSuBlk * sizeof(uint16_t));
+
+	// a restore may have picked a different log
+	return ftl_get_log(lbn);
+}
+
+static int ftl_do_read(int logicalPageNumber, int totalPagesToRead, uint8_t* pBuf) {
 	int i;
 	int hasError = FALSE;
 
@@ -1888,17 +2734,19 @@ int FTL_Read(int logicalPageNumber, int totalPagesToRead, uint8_t* pBuf) {
 		return ERROR_INPUT;
 	}
 
-	int lbn = logicalPageNumber / Geometry->pagesPerSuBlk;
-	int offset = logicalPageNumber - (lbn * Geometry->pagesPerSuBlk);
+	int lbn = vpn_to_vbn(logicalPageNumber);
+	int offset = vpn_to_offset(logicalPageNumber);
 
-	uint8_t* pageBuffer = malloc(Geometry->bytesPerPage);
-	uint8_t* spareBuffer = malloc(Geometry->bytesPerSpare);
+	uint8_t* pageBuffer = ftl_pool_get(&PagePool);
+	uint8_t* spareBuffer = ftl_pool_get(&SparePool);
 	if(!pageBuffer || !spareBuffer) {
 		bufferPrintf("ftl: FTL_Read ran out of memory!\r\n");
+		ftl_pool_put(&PagePool, pageBuffer);
+		ftl_pool_put(&SparePool, spareBuffer);
 		return ERROR_ARG;
 	}
 
-	FTLCxtLog* pLog = ftl_get_log(lbn);
+	FTLCxtLog* pLog = ftl_get_log_loaded(lbn);
 
 	int ret = 0;
 	int pagesRead = 0;
@@ -1913,13 +2761,53 @@ int FTL_Read(int logicalPageNumber, int totalPagesToRead, uint8_t* pBuf) {
 			pagesToRead = totalPagesToRead - pagesRead;
 
 		int readSuccessful;
-		if(pLog != NULL) {
+		int inLog = 0;
+		if(pLog != NULL && pLog->isSequential) {
+			// a sequential log holds pages 0 to pagesUsed - 1 at their own offsets, the
+			// rest still lives in the data block, so the whole range maps at once
+			inLog = pLog->pagesUsed - offset;
+			if(inLog < 0)
+				inLog = 0;
+			else if(inLog > pagesToRead)
+				inLog = pagesToRead;
+		}
+
+		if((pLog == NULL || (pLog->isSequential && inLog == 0)) && vfl_vb_erased(pstFTLCxt->pawMapTable[lbn])) {
+			// nothing has been written to the data block yet, so the pages would read
+			// back erased anyway
+			memset(pBuf + (pagesRead * Geometry->bytesPerPage), 0xFF, pagesToRead * Geometry->bytesPerPage);
+			memset(FTLSpareBuffer, 0xFF, pagesToRead * sizeof(SpareData));
+			refreshPage = FALSE;
+			readSuccessful = TRUE;
+		} else if(pLog != NULL && pLog->isSequential && (inLog == 0 || inLog == pagesToRead)) {
+			uint16_t vb = (inLog == 0) ? pstFTLCxt->pawMapTable[lbn] : pLog->wVbn;
+			pstFTLCxt->pawReadCounterTable[vb] += pagesToRead;
+			readSuccessful = VFL_ReadMultiplePagesInVb(vb, offset, pagesToRead, pBuf + (pagesRead * Geometry->bytesPerPage), FTLSpareBuffer, &refreshPage);
+			if(refreshPage) {
+				LogDebug(LogFTL, "ftl: _AddLbnToRefreshList (0x%x, 0x%x)\r\n", lbn, vb);
+			}
+		} else if(pLog != NULL && pLog->isSequential) {
+			uint32_t logBase = pLog->wVbn * Geometry->pagesPerSuBlk + offset;
+			uint32_t dataBase = pstFTLCxt->pawMapTable[lbn] * Geometry->pagesPerSuBlk + offset;
+			for(i = 0; i < inLog; i++)
+				ScatteredVirtualPageNumberBuffer[i] = logBase + i;
+			for(; i < pagesToRead; i++)
+				ScatteredVirtualPageNumberBuffer[i] = dataBase + i;
+
+			pstFTLCxt->pawReadCounterTable[pLog->wVbn] += inLog;
+			pstFTLCxt->pawReadCounterTable[pstFTLCxt->pawMapTable[lbn]] += pagesToRead - inLog;
+
+			readSuccessful = VFL_ReadScatteredPagesInVb(ScatteredVirtualPageNumberBuffer, pagesToRead, pBuf + (pagesRead * Geometry->bytesPerPage), FTLSpareBuffer, &refreshPage);
+			if(refreshPage) {
+				LogDebug(LogFTL, "ftl: _AddLbnToRefreshList (0x%x, 0x%x, 0x%x)\r\n", lbn, pstFTLCxt->pawMapTable[lbn], pLog->wVbn);
+			}
+		} else if(pLog != NULL) {
 			// we have a scatter entry for this logical block, so we use it
 			for(i = 0; i < pagesToRead; i++) {
 				ScatteredVirtualPageNumberBuffer[i] = FTL_map_page(pLog, lbn, offset + i);
-				if((ScatteredVirtualPageNumberBuffer[i] / Geometry->pagesPerSuBlk) == pLog->wVbn) {
+				if(vpn_to_vbn(ScatteredVirtualPageNumberBuffer[i]) == pLog->wVbn) {
 					// This particular page is mapped within one of the log blocks, so we increment for the log block
-					pstFTLCxt->pawReadCounterTable[ScatteredVirtualPageNumberBuffer[i] / Geometry->pagesPerSuBlk]++;
+					pstFTLCxt->pawReadCounterTable[pLog->wVbn]++;
 				} else {
 					// This particular page is mapped to the main block itself, so we increment for that block
 					pstFTLCxt->pawReadCounterTable[pstFTLCxt->pawMapTable[lbn]]++;
@@ -1928,7 +2816,7 @@ int FTL_Read(int logicalPageNumber, int totalPagesToRead, uint8_t* pBuf) {
 
 			readSuccessful = VFL_ReadScatteredPagesInVb(ScatteredVirtualPageNumberBuffer, pagesToRead, pBuf + (pagesRead * Geometry->bytesPerPage), FTLSpareBuffer, &refreshPage);
 			if(refreshPage) {
-				bufferPrintf("ftl: _AddLbnToRefreshList (0x%x, 0x%x, 0x%x)\r\n", lbn, pstFTLCxt->pawMapTable[lbn], pLog->wVbn);
+				LogDebug(LogFTL, "ftl: _AddLbnToRefreshList (0x%x, 0x%x, 0x%x)\r\n", lbn, pstFTLCxt->pawMapTable[lbn], pLog->wVbn);
 			}
 		} else {
 			// VFL_ReadMultiplePagesInVb has a different calling convention and implementation than the equivalent iBoot function.
@@ -1936,10 +2824,12 @@ int FTL_Read(int logicalPageNumber, int totalPagesToRead, uint8_t* pBuf) {
 			pstFTLCxt->pawReadCounterTable[pstFTLCxt->pawMapTable[lbn]] += pagesToRead;
 			readSuccessful = VFL_ReadMultiplePagesInVb(pstFTLCxt->pawMapTable[lbn], offset, pagesToRead, pBuf + (pagesRead * Geometry->bytesPerPage), FTLSpareBuffer, &refreshPage);
 			if(refreshPage) {
-				bufferPrintf("ftl: _AddLbnToRefreshList (0x%x, 0x%x)\r\n", lbn, pstFTLCxt->pawMapTable[lbn]);
+				LogDebug(LogFTL, "ftl: _AddLbnToRefreshList (0x%x, 0x%x)\r\n", lbn, pstFTLCxt->pawMapTable[lbn]);
 			}
 		}
 
+		ftl_refresh_note(lbn, refreshPage);
+
 		int loop = 0;
 		if(readSuccessful) {
 			// check ECC mark for all pages
@@ -1969,10 +2859,12 @@ int FTL_Read(int logicalPageNumber, int totalPagesToRead, uint8_t* pBuf) {
 				// there's some remaining pages we have not read before. handle them individually
 
 				int virtualPage = FTL_map_page(pLog, lbn, offset);
+				refreshPage = FALSE;
 				ret = VFL_Read(virtualPage, pBuf + (Geometry->bytesPerPage * pagesRead), spareBuffer, TRUE, &refreshPage);
 				if(refreshPage) {
-					bufferPrintf("ftl: _AddLbnToRefreshList (0x%x, 0x%x)\r\n", lbn, virtualPage / Geometry->pagesPerSuBlk);
+					LogDebug(LogFTL, "ftl: _AddLbnToRefreshList (0x%x, 0x%x)\r\n", lbn, virtualPage / Geometry->pagesPerSuBlk);
 				}
+				ftl_refresh_note(lbn, refreshPage);
 
 				if(ret == ERROR_ARG)
 					goto FTL_Read_Error_Release;
@@ -2012,7 +2904,7 @@ int FTL_Read(int logicalPageNumber, int totalPagesToRead, uint8_t* pBuf) {
 				if(lbn >= Geometry->userSuBlksTotal)
 					goto FTL_Read_Error_Release;
 
-				pLog = ftl_get_log(lbn);
+				pLog = ftl_get_log_loaded(lbn);
 
 				offset = 0;
 				break;
@@ -2021,8 +2913,8 @@ int FTL_Read(int logicalPageNumber, int totalPagesToRead, uint8_t* pBuf) {
 	}
 
 FTL_Read_Done:
-	free(pageBuffer);
-	free(spareBuffer);
+	ftl_pool_put(&PagePool, pageBuffer);
+	ftl_pool_put(&SparePool, spareBuffer);
 	if(hasError) {
 		bufferPrintf("ftl: USER_DATA_ERROR, failed with (0x%x, 0x%x, 0x%x)\r\n", logicalPageNumber, totalPagesToRead, pBuf);
 		return ERROR_NAND;
@@ -2031,14 +2923,16 @@ FTL_Read_Done:
 	return 0;
 
 FTL_Read_Error_Release:
-	free(pageBuffer);
-	free(spareBuffer);
+	ftl_pool_put(&PagePool, pageBuffer);
+	ftl_pool_put(&SparePool, spareBuffer);
 	bufferPrintf("ftl: _FTLRead error!\r\n");
 	return ret;
 }
 
 static int ftl_commit_cxt()
 {
+	if(!ftl_lazy_load_all())
+		return FALSE;
 
 	// TODO: We should use the StoreCxt for this. Not only would we be able to more easily do
 	// multiplanar writes, but if any of this fails, we can back out without changes to our
@@ -2046,156 +2940,88 @@ static int ftl_commit_cxt()
 
 	int i;
 
-	uint8_t* pageBuffer = malloc(Geometry->bytesPerPage);
-	SpareData* spareData = (SpareData*) malloc(Geometry->bytesPerSpare);
+	uint8_t* pageBuffer = ftl_pool_get(&PagePool);
+	SpareData* spareData = (SpareData*) ftl_pool_get(&SparePool);
 	if(!pageBuffer || !spareData) {
 		bufferPrintf("ftl: ftl_commit_cxt ran out of memory!\r\n");
+		ftl_pool_put(&PagePool, pageBuffer);
+		ftl_pool_put(&SparePool, spareData);
 		return ERROR_ARG;
 	}
 
-	// We need to precalculate how many pages we'd need to write to determine if we should start a new block.
-
-	int eraseCounterPages;
-	int readCounterPages;
-	int mapPages;
-	int offsetsPages;
-
-	eraseCounterPages = ((Geometry->userSuBlksTotal + 23) * sizeof(uint16_t)) / Geometry->bytesPerPage;
-	if((((Geometry->userSuBlksTotal + 23) * sizeof(uint16_t)) % Geometry->bytesPerPage) != 0)
-		eraseCounterPages++;
+	// Work out how many pages have to be written to determine if we should start a new block.
+	// Table pages that did not change since the last commit and are in this block stay where they are.
+	static const int order[FTL_COMMIT_TABLES] = {FTL_COMMIT_ERASE, FTL_COMMIT_READ, FTL_COMMIT_MAP, FTL_COMMIT_OFFSETS};
+	static const uint8_t types[FTL_COMMIT_TABLES] = {0x46, 0x49, 0x44, 0x45};
+	int tablePages[FTL_COMMIT_TABLES];
+	int t;
 
-	readCounterPages = eraseCounterPages;
-	
-	mapPages = (Geometry->userSuBlksTotal * sizeof(uint16_t)) / Geometry->bytesPerPage;
-	if(((Geometry->userSuBlksTotal * sizeof(uint16_t)) % Geometry->bytesPerPage) != 0)
-		mapPages++;
+	uint16_t curBlock = pstFTLCxt->FTLCtrlPage / Geometry->pagesPerSuBlk;
+	int totalPages = 1 /* for the SID */ + 1 /* for FTLCxt */;
 
-	offsetsPages = (Geometry->pagesPerSuBlk * (17 * sizeof(uint16_t))) / Geometry->bytesPerPage;
-	if(((Geometry->pagesPerSuBlk * (17 * sizeof(uint16_t))) % Geometry->bytesPerPage) != 0)
-		offsetsPages++;
+	for(t = 0; t < FTL_COMMIT_TABLES; t++)
+	{
+		uint32_t size;
+		uint32_t* pages;
+		ftl_table_data(order[t], &size, &pages);
+		tablePages[t] = (size + Geometry->bytesPerPage - 1) / Geometry->bytesPerPage;
 
-	int totalPages = eraseCounterPages + readCounterPages + mapPages + offsetsPages + 1 /* for the SID */ + 1 /* for FTLCxt */;
+		for(i = 0; i < tablePages[t]; i++)
+		{
+			if(!ftl_committed_current(order[t], i, curBlock))
+				totalPages++;
+		}
+	}
 
-	uint16_t curBlock = pstFTLCxt->FTLCtrlPage / Geometry->pagesPerSuBlk;
 	if((pstFTLCxt->FTLCtrlPage + totalPages) >= ((curBlock * Geometry->pagesPerSuBlk) + Geometry->pagesPerSuBlk))
 	{
 		// looks like we would be overflowing into the next block, force the next ctrl page to be on a fresh
-		// block in that case
+		// block in that case, and write everything there
 		pstFTLCxt->FTLCtrlPage = (curBlock * Geometry->pagesPerSuBlk) + Geometry->pagesPerSuBlk - 1;
+		curBlock = 0xFFFF;
 	}
 
-	int pagesToWrite;
+	for(t = 0; t < FTL_COMMIT_TABLES; t++)
+	{
+		uint32_t size;
+		uint32_t* pages;
+		uint8_t* data = ftl_table_data(order[t], &size, &pages);
 
-	pagesToWrite = eraseCounterPages;
+		for(i = 0; i < tablePages[t]; i++) {
+			if(ftl_committed_current(order[t], i, curBlock))
+			{
+				CommitPagesKept++;
+				continue;
+			}
 
-	for(i = 0; i < pagesToWrite; i++) {
-		if(!ftl_next_ctrl_page())
-		{
-			bufferPrintf("ftl: cannot allocate next FTL ctrl page\r\n");
-			goto ftl_commit_cxt_error_release;
-		}
+			if(!ftl_next_ctrl_page())
+			{
+				bufferPrintf("ftl: cannot allocate next FTL ctrl page\r\n");
+				goto ftl_commit_cxt_error_release;
+			}
 
-		pstFTLCxt->pages_for_pawEraseCounterTable[i] = pstFTLCxt->FTLCtrlPage;
+			pages[i] = pstFTLCxt->FTLCtrlPage;
+			CommittedTables[order[t]].known &= ~(1ULL << i);
 
-		int toWrite = Geometry->bytesPerPage;
-		if(toWrite > (((Geometry->userSuBlksTotal + 23) * sizeof(uint16_t)) - (i * Geometry->bytesPerPage))) {
-			toWrite = ((Geometry->userSuBlksTotal + 23) * sizeof(uint16_t)) - (i * Geometry->bytesPerPage);
-		}
+			int toWrite = Geometry->bytesPerPage;
+			if(toWrite > (size - (i * Geometry->bytesPerPage))) {
+				toWrite = size - (i * Geometry->bytesPerPage);
+			}
 
-		memcpy(pageBuffer, ((uint8_t*)pstFTLCxt->pawEraseCounterTable) + (i * Geometry->bytesPerPage), toWrite);
-		memset(pageBuffer + toWrite, 0, Geometry->bytesPerPage - toWrite);
+			memcpy(pageBuffer, data + (i * Geometry->bytesPerPage), toWrite);
+			memset(pageBuffer + toWrite, 0, Geometry->bytesPerPage - toWrite);
 
-		memset(spareData, 0xFF, sizeof(SpareData));
-		spareData->meta.usnDec = pstFTLCxt->usnDec;
-		spareData->type1 = 0x46;
-		spareData->meta.idx = i;
+			memset(spareData, 0xFF, sizeof(SpareData));
+			spareData->meta.usnDec = pstFTLCxt->usnDec;
+			spareData->type1 = types[t];
+			spareData->meta.idx = i;
 
-		if(VFL_Write(pstFTLCxt->pages_for_pawEraseCounterTable[i], pageBuffer, (uint8_t*) spareData) != 0)
-			goto ftl_commit_cxt_error_release;
-	}
-
-	pagesToWrite = readCounterPages;
-
-	for(i = 0; i < pagesToWrite; i++) {
-		if(!ftl_next_ctrl_page())
-		{
-			bufferPrintf("ftl: cannot allocate next FTL ctrl page\r\n");
-			goto ftl_commit_cxt_error_release;
-		}
-
-		pstFTLCxt->pages_for_pawReadCounterTable[i] = pstFTLCxt->FTLCtrlPage;
+			if(VFL_Write(pages[i], pageBuffer, (uint8_t*) spareData) != 0)
+				goto ftl_commit_cxt_error_release;
 
-		int toWrite = Geometry->bytesPerPage;
-		if(toWrite > (((Geometry->userSuBlksTotal + 23) * sizeof(uint16_t)) - (i * Geometry->bytesPerPage))) {
-			toWrite = ((Geometry->userSuBlksTotal + 23) * sizeof(uint16_t)) - (i * Geometry->bytesPerPage);
+			ftl_committed_note(order[t], i);
+			CommitPagesWritten++;
 		}
-
-		memcpy(pageBuffer, ((uint8_t*)pstFTLCxt->pawReadCounterTable) + (i * Geometry->bytesPerPage), toWrite);
-		memset(pageBuffer + toWrite, 0, Geometry->bytesPerPage - toWrite);
-
-		memset(spareData, 0xFF, sizeof(SpareData));
-		spareData->meta.usnDec = pstFTLCxt->usnDec;
-		spareData->type1 = 0x49;
-		spareData->meta.idx = i;
-
-		if(VFL_Write(pstFTLCxt->pages_for_pawReadCounterTable[i], pageBuffer, (uint8_t*) spareData) != 0)
-			goto ftl_commit_cxt_error_release;
-	}
-
-	pagesToWrite = mapPages;
-
-	for(i = 0; i < pagesToWrite; i++) {
-		if(!ftl_next_ctrl_page())
-		{
-			bufferPrintf("ftl: cannot allocate next FTL ctrl page\r\n");
-			goto ftl_commit_cxt_error_release;
-		}
-
-		pstFTLCxt->pages_for_pawMapTable[i] = pstFTLCxt->FTLCtrlPage;
-
-		int toWrite = Geometry->bytesPerPage;
-		if(toWrite > ((Geometry->userSuBlksTotal * sizeof(uint16_t)) - (i * Geometry->bytesPerPage))) {
-			toWrite = (Geometry->userSuBlksTotal * sizeof(uint16_t)) - (i * Geometry->bytesPerPage);
-		}
-
-		memcpy(pageBuffer, ((uint8_t*)pstFTLCxt->pawMapTable) + (i * Geometry->bytesPerPage), toWrite);
-		memset(pageBuffer + toWrite, 0, Geometry->bytesPerPage - toWrite);
-
-		memset(spareData, 0xFF, sizeof(SpareData));
-		spareData->meta.usnDec = pstFTLCxt->usnDec;
-		spareData->type1 = 0x44;
-		spareData->meta.idx = i;
-
-		if(VFL_Write(pstFTLCxt->pages_for_pawMapTable[i], pageBuffer, (uint8_t*) spareData) != 0)
-			goto ftl_commit_cxt_error_release;
-	}
-
-	pagesToWrite = offsetsPages;
-
-	for(i = 0; i < pagesToWrite; i++) {
-		if(!ftl_next_ctrl_page())
-		{
-			bufferPrintf("ftl: cannot allocate next FTL ctrl page\r\n");
-			goto ftl_commit_cxt_error_release;
-		}
-
-		pstFTLCxt->pages_for_wPageOffsets[i] = pstFTLCxt->FTLCtrlPage;
-
-		int toWrite = Geometry->bytesPerPage;
-		if(toWrite > ((Geometry->pagesPerSuBlk * (17 * sizeof(uint16_t))) - (i * Geometry->bytesPerPage))) {
-			toWrite = (Geometry->pagesPerSuBlk * (17 * sizeof(uint16_t))) - (i * Geometry->bytesPerPage);
-		}
-
-		memcpy(pageBuffer, ((uint8_t*)pstFTLCxt->wPageOffsets) + (i * Geometry->bytesPerPage), toWrite);
-		memset(pageBuffer + toWrite, 0, Geometry->bytesPerPage - toWrite);
-
-		memset(spareData, 0xFF, sizeof(SpareData));
-		spareData->meta.usnDec = pstFTLCxt->usnDec;
-		spareData->type1 = 0x45;
-		spareData->meta.idx = i;
-
-		if(VFL_Write(pstFTLCxt->pages_for_wPageOffsets[i], pageBuffer, (uint8_t*) spareData) != 0)
-			goto ftl_commit_cxt_error_release;
 	}
 
 	{
@@ -2246,24 +3072,24 @@ static int ftl_commit_cxt()
 	if(VFL_Write(pstFTLCxt->FTLCtrlPage, (uint8_t*) pstFTLCxt, (uint8_t*) spareData) != 0)
 		goto ftl_commit_cxt_error_release;
 
-	free(pageBuffer);
-	free(spareData);
+	ftl_pool_put(&PagePool, pageBuffer);
+	ftl_pool_put(&SparePool, spareData);
 
 	return TRUE;
 
 ftl_commit_cxt_error_release:
 	bufferPrintf("ftl: error committing FTLCxt!\r\n");
 
-	free(pageBuffer);
-	free(spareData);
+	ftl_pool_put(&PagePool, pageBuffer);
+	ftl_pool_put(&SparePool, spareData);
 
 	return FALSE;
 }
 
 static int ftl_mark_unclean()
 {
-	uint8_t* pageBuffer = (uint8_t*) malloc(Geometry->bytesPerPage);
-	uint8_t* spareBuffer = (uint8_t*) malloc(Geometry->bytesPerSpare);
+	uint8_t* pageBuffer = (uint8_t*) malloc_dma(Geometry->bytesPerPage);
+	uint8_t* spareBuffer = (uint8_t*) malloc_dma(Geometry->bytesPerSpare);
 	if(!pageBuffer || !spareBuffer) {
 		bufferPrintf("ftl: ftl_mark_unclean: out of memory\r\n");
 		return FALSE;
@@ -2307,14 +3133,94 @@ error_release:
 	return FALSE;
 }
 
+// Logs are split between a hot stream, for lbns written often lately, and
+// everything else. A new log only pushes out one of its own stream once that
+// stream has its share, so a burst of small metadata writes does not merge
+// away the logs of a large file being written, nor the other way round.
+// Heat is counted per lbn and halved every FTL_HEAT_DECAY new writes.
+#ifndef FTL_HOT_LOGS
+#define FTL_HOT_LOGS 6
+#endif
+
+#ifndef FTL_HOT_THRESHOLD
+#define FTL_HOT_THRESHOLD 4
+#endif
+
+#ifndef FTL_HEAT_DECAY
+#define FTL_HEAT_DECAY 1024
+#endif
+
+static uint8_t* LbnHeat = NULL;
+static uint32_t HeatWrites = 0;
+static int PreparingHot = FALSE;
+
+static int ftl_lbn_hot(uint16_t lbn)
+{
+	return LbnHeat != NULL && LbnHeat[lbn] >= FTL_HOT_THRESHOLD;
+}
+
+static void ftl_heat_write(uint16_t lbn)
+{
+	int i;
+
+	if(LbnHeat == NULL)
+		return;
+
+	if(LbnHeat[lbn] < 0xFF)
+		LbnHeat[lbn]++;
+
+	if(++HeatWrites >= FTL_HEAT_DECAY)
+	{
+		for(i = 0; i < Geometry->userSuBlksTotal; i++)
+			LbnHeat[i] >>= 1;
+		HeatWrites = 0;
+	}
+}
+
+// The oldest log of the stream that has to give one up, for a new log of
+// the hot stream or not. Logs that are still empty are never picked.
+static FTLCxtLog* ftl_pick_victim(int hot)
+{
+	FTLCxtLog* oldest[2] = {NULL, NULL};
+	int inUse[2] = {0, 0};
+	int i;
+
+	for(i = 0; i < FTL_NUM_LOGS; ++i)
+	{
+		FTLCxtLog* cur = &pstFTLCxt->pLog[i];
+		if(cur->wVbn == 0xFFFF || cur->pagesUsed == 0 || cur->pagesCurrent == 0)
+			continue;
+
+		int stream = ftl_lbn_hot(cur->wLbn);
+		inUse[stream]++;
+
+		FTLCxtLog* best = oldest[stream];
+		if(best == NULL || cur->usn < best->usn || (cur->usn == best->usn && cur->pagesCurrent > best->pagesCurrent))
+			oldest[stream] = cur;
+	}
+
+	int stream;
+	if(hot)
+		stream = (inUse[TRUE] >= FTL_HOT_LOGS) ? TRUE : FALSE;
+	else
+		stream = (inUse[FALSE] >= (FTL_NUM_LOGS - FTL_HOT_LOGS)) ? FALSE : TRUE;
+
+	if(oldest[stream] == NULL)
+		stream = !stream;
+
+	return oldest[stream];
+}
+
 static FTLCxtLog* ftl_prepare_log(uint16_t lbn)
 {
 	FTLCxtLog* pLog = ftl_get_log(lbn);
 
+	ftl_heat_write(lbn);
+
 	if(pLog == NULL)
 	{
 		int i;
-		for(i = 0; i < 17; ++i)
+		for(i = 0; i < FTL_NUM_LOGS; ++i)
 		{
 			if((pstFTLCxt->pLog[i].wVbn != 0xFFFF) && (pstFTLCxt->pLog[i].pagesUsed == 0))
 			{
@@ -2331,6 +3237,7 @@ static FTLCxtLog* ftl_prepare_log(uint16_t lbn)
 				return NULL;
 			} else if(pstFTLCxt->wNumOfFreeVb == 3)
 			{
+				PreparingHot = ftl_lbn_hot(lbn);
 				if(!ftl_merge(NULL))
 				{
 					bufferPrintf("ftl: block merged failed!\r\n");
@@ -2338,7 +3245,7 @@ static FTLCxtLog* ftl_prepare_log(uint16_t lbn)
 				}
 			}
 
-			for(i = 0; i < 17; ++i)
+			for(i = 0; i < FTL_NUM_LOGS; ++i)
 			{
 				if(pstFTLCxt->pLog[i].wVbn == 0xFFFF)
 				       break;
@@ -2354,7 +3261,7 @@ static FTLCxtLog* ftl_prepare_log(uint16_t lbn)
 		}
 
 		memset(pLog->wPageOffsets, 0xFF, Geometry->pagesPerSuBlk * sizeof(uint16_t));
-		pLog->wLbn = lbn;
+		ftl_log_index_set_lbn(pLog, lbn);
 		pLog->pagesUsed = 0;
 		pLog->pagesCurrent = 0;
 		pLog->isSequential = 1;
@@ -2362,8 +3269,10 @@ static FTLCxtLog* ftl_prepare_log(uint16_t lbn)
 
 	pLog->usn = pstFTLCxt->nextblockusn - 1;
 
-	if(pstFTLCxt->nextblockusn == 1)
-		memset(pstFTLCxt->pLog, 0, sizeof(FTLCxtLog) * 17);
+	if(pstFTLCxt->nextblockusn == 1) {
+		memset(pstFTLCxt->pLog, 0, sizeof(FTLCxtLog) * FTL_NUM_LOGS);
+		ftl_log_index_rebuild();
+	}
 
 	return pLog;
 }
@@ -2376,8 +3285,8 @@ static inline void ftl_check_still_sequential(FTLCxtLog* pLog, uint32_t page)
 
 static int ftl_copy_page(uint32_t src, uint32_t dest, uint32_t lpn, uint32_t isSequential)
 {
-	uint8_t* pageBuffer = malloc(Geometry->bytesPerPage);
-	SpareData* spareData = (SpareData*) malloc(Geometry->bytesPerSpare);
+	uint8_t* pageBuffer = ftl_pool_get(&PagePool);
+	SpareData* spareData = (SpareData*) ftl_pool_get(&SparePool);
 
 	int ret = VFL_Read(src, pageBuffer, (uint8_t*) spareData, TRUE, NULL);
 
@@ -2394,7 +3303,7 @@ static int ftl_copy_page(uint32_t src, uint32_t dest, uint32_t lpn, uint32_t isS
 	spareData->user.logicalPageNumber = lpn;
 
 	// This isn't always done either
-	if(isSequential == 1 && ((dest % Geometry->pagesPerSuBlk) == (Geometry->pagesPerSuBlk - 1)))
+	if(isSequential == 1 && (vpn_to_offset(dest) == (Geometry->pagesPerSuBlk - 1)))
 		spareData->type1 = 0x41;
 	else
 		spareData->type1 = 0x40;
@@ -2403,13 +3312,13 @@ static int ftl_copy_page(uint32_t src, uint32_t dest, uint32_t lpn, uint32_t isS
 	if(ret != 0)
 		goto error_release;
 
-	free(pageBuffer);
-	free(spareData);
+	ftl_pool_put(&PagePool, pageBuffer);
+	ftl_pool_put(&SparePool, spareData);
 	return TRUE;
 
 error_release:
-	free(pageBuffer);
-	free(spareData);
+	ftl_pool_put(&PagePool, pageBuffer);
+	ftl_pool_put(&SparePool, spareData);
 
 	return FALSE;
 }
@@ -2417,27 +3326,54 @@ error_release:
 static int ftl_copy_block(uint16_t lSrc, uint16_t vDest)
 {
 	int error = FALSE;
-	uint8_t* pageBuffer = malloc(Geometry->bytesPerPage);
-	SpareData* spareData = (SpareData*) malloc(Geometry->bytesPerSpare);
+	int batch = FTL_COPY_BATCH;
+	uint8_t* pageBuffer = malloc_dma(Geometry->bytesPerPage * FTL_COPY_BATCH);
+	uint8_t* readFailed = malloc(FTL_COPY_BATCH);
+	SpareData* spareData = (SpareData*) malloc(sizeof(SpareData) * FTL_COPY_BATCH);
+	uint32_t destPages[FTL_COPY_BATCH];
+
+	if(!pageBuffer) {
+		batch = 1;
+		pageBuffer = malloc_dma(Geometry->bytesPerPage);
+	}
 
 	++pstFTLCxt->nextblockusn;
 
 	int i;
-	for(i = 0; i < Geometry->pagesPerSuBlk; ++i)
+	int count;
+	for(i = 0; i < Geometry->pagesPerSuBlk; i += count)
 	{
-		int ret = FTL_Read(lSrc * Geometry->pagesPerSuBlk + i, 1, pageBuffer);
-		memset(spareData, 0xFF, Geometry->bytesPerSpare);
-		if(ret)
-			spareData->eccMark = 0x55;
+		count = Geometry->pagesPerSuBlk - i;
+		if(count > batch)
+			count = batch;
 
-		spareData->user.logicalPageNumber = lSrc * Geometry->pagesPerSuBlk + i;
-		spareData->user.usn = pstFTLCxt->nextblockusn;
-		if(i == (Geometry->pagesPerSuBlk - 1))
-			spareData->type1 = 0x41;
-		else
-			spareData->type1 = 0x40;
+		memset(readFailed, FALSE, FTL_COPY_BATCH);
+		if(count == 1 || FTL_Read(lSrc * Geometry->pagesPerSuBlk + i, count, pageBuffer) != 0)
+		{
+			// find out which of the pages are actually bad
+			int k;
+			for(k = 0; k < count; k++)
+				readFailed[k] = (FTL_Read(lSrc * Geometry->pagesPerSuBlk + i + k, 1, pageBuffer + (k * Geometry->bytesPerPage)) != 0);
+		}
 
-		if(VFL_Write(vDest * Geometry->pagesPerSuBlk + i, pageBuffer, (uint8_t*) spareData) != 0)
+		int j;
+		for(j = 0; j < count; j++)
+		{
+			memset(&spareData[j], 0xFF, sizeof(SpareData));
+			if(readFailed[j])
+				spareData[j].eccMark = 0x55;
+
+			spareData[j].user.logicalPageNumber = lSrc * Geometry->pagesPerSuBlk + i + j;
+			spareData[j].user.usn = pstFTLCxt->nextblockusn;
+			if((i + j) == (Geometry->pagesPerSuBlk - 1))
+				spareData[j].type1 = 0x41;
+			else
+				spareData[j].type1 = 0x40;
+
+			destPages[j] = vDest * Geometry->pagesPerSuBlk + i + j;
+		}
+
+		if(VFL_WriteScatteredPagesInVb(destPages, count, pageBuffer, spareData) != 0)
 		{
 			error = TRUE;
 			break;
@@ -2460,11 +3396,13 @@ static int ftl_copy_block(uint16_t lSrc, uint16_t vDest)
 	}
 
 	free(pageBuffer);
+	free(readFailed);
 	free(spareData);
 	return TRUE;
 
 error_release:
 	free(pageBuffer);
+	free(readFailed);
 	free(spareData);
 
 	return FALSE;
@@ -2666,6 +3604,38 @@ static int ftl_copy_merge(FTLCxtLog* pLog)
 	return TRUE;
 }
 
+// Fold a log into its data block. Unlike compacting it, this gives back a
+// free vb.
+static int ftl_merge_into_data_block(FTLCxtLog* pLog)
+{
+	uint16_t lbn = pLog->wLbn;
+	uint64_t start = latency_start();
+	if(pLog->isSequential == 1)
+	{
+		int ret = ftl_copy_merge(pLog);
+		latency_record(LatencyMergeCopy, lbn, 0, start);
+		if(!ret)
+		{
+			bufferPrintf("ftl: simple merge failed\r\n");
+			return FALSE;
+		}
+		++pstFTLCxt->swapCounter;
+		return TRUE;
+	}
+	else
+	{
+		int ret = ftl_simple_merge(pLog);
+		latency_record(LatencyMergeSimple, lbn, 0, start);
+		if(!ret)
+		{
+			bufferPrintf("ftl: simple merge failed\r\n");
+			return FALSE;
+		}
+		++pstFTLCxt->swapCounter;
+		return TRUE;
+	}
+}
+
 static int ftl_merge(FTLCxtLog* pLog)
 {
 	if(!ftl_mark_unclean())
@@ -2674,14 +3644,11 @@ static int ftl_merge(FTLCxtLog* pLog)
 		return FALSE;
 	}
 
-	uint32_t oldest = 0xFFFFFFFF;
-	uint32_t mostCurrent = 0;
 	if(pLog == NULL)
 	{
 		int i;
 
-		// find one to swap out
-		for(i = 0; i < 17; ++i)
+		for(i = 0; i < FTL_NUM_LOGS; ++i)
 		{
 			if(pstFTLCxt->pLog[i].wVbn == 0xFFFF)
 				continue;
@@ -2691,15 +3658,12 @@ static int ftl_merge(FTLCxtLog* pLog)
 				bufferPrintf("ft: merge error - we still have logs that can be used instead!\r\n");
 				return FALSE;
 			}
-
-			if(pstFTLCxt->pLog[i].usn < oldest || (pstFTLCxt->pLog[i].usn == oldest && pstFTLCxt->pLog[i].pagesCurrent > mostCurrent))
-			{
-				pLog = &pstFTLCxt->pLog[i];
-				oldest = pstFTLCxt->pLog[i].usn;
-				mostCurrent = pstFTLCxt->pLog[i].pagesCurrent;
-			}
 		}
 
+		// find one to swap out
+		pLog = ftl_pick_victim(PreparingHot);
+		PreparingHot = FALSE;
+
 		if(pLog == NULL)
 			return FALSE;
 	} else if(pLog->pagesCurrent < (Geometry->pagesPerSuBlk / 2))
@@ -2707,29 +3671,14 @@ static int ftl_merge(FTLCxtLog* pLog)
 		// less than half the pages in this log seems to be current, let's get rid of the crap and just reuse this one.
 
 		++pstFTLCxt->swapCounter;
-		return ftl_compact_scattered(pLog);
+		uint16_t lbn = pLog->wLbn;
+		uint64_t start = latency_start();
+		int ret = ftl_compact_scattered(pLog);
+		latency_record(LatencyMergeCompact, lbn, 0, start);
+		return ret;
 	}
 
-	if(pLog->isSequential == 1)
-	{
-		if(!ftl_copy_merge(pLog))
-		{
-			bufferPrintf("ftl: simple merge failed\r\n");
-			return FALSE;
-		}
-		++pstFTLCxt->swapCounter;
-		return TRUE;
-	}
-	else
-	{
-		if(!ftl_simple_merge(pLog))
-		{
-			bufferPrintf("ftl: simple merge failed\r\n");
-			return FALSE;
-		}
-		++pstFTLCxt->swapCounter;
-		return TRUE;
-	}
+	return ftl_merge_into_data_block(pLog);
 }
 
 int ftl_auto_wearlevel()
@@ -2786,10 +3735,8 @@ int ftl_auto_wearlevel()
 	if((largestEraseCount - smallestEraseCount) < 5)
 		return TRUE;
 
-	++pstFTLCxt->pawEraseCounterTable[mostErasedFreeBlock];
-	pstFTLCxt->pawReadCounterTable[mostErasedFreeBlock] = 0;
-
-	if(VFL_Erase(mostErasedFreeBlock) != 0)
+	// a free block that is known to be erased already does not need it again
+	if((FreeVbDirty == NULL || FreeVbDirty[mostErasedFreeBlock]) && !ftl_erase_free_vb(mostErasedFreeBlock))
 	{
 		bufferPrintf("ftl: auto wear-level cannot erase most erased free block\r\n");
 		return FALSE;
@@ -2805,24 +3752,24 @@ int ftl_auto_wearlevel()
 
 	pstFTLCxt->pawMapTable[leastErasedBlockLbn] = mostErasedFreeBlock;
 
-	++pstFTLCxt->pawEraseCounterTable[leastErasedBlock];
-	pstFTLCxt->pawReadCounterTable[leastErasedBlock] = 0;
+	pstFTLCxt->awFreeVb[mostErasedFreeBlockIdx] = leastErasedBlock;
 
-	if(VFL_Erase(leastErasedBlock) != 0)
+	if(!ftl_free_vb_needs_erase(leastErasedBlock))
 	{
 		bufferPrintf("ftl: auto wear-level cannot erase previously least erased block\r\n");
 		return FALSE;
 	}
 
-	pstFTLCxt->awFreeVb[mostErasedFreeBlockIdx] = leastErasedBlock;
-
 	return TRUE;
 }
 
-int FTL_Write(int logicalPageNumber, int totalPagesToWrite, uint8_t* pBuf) 
+static int ftl_do_write(int logicalPageNumber, int totalPagesToWrite, uint8_t* pBuf)
 {
 	int i;
 
+	if(!ftl_lazy_load_all())
+		return ERROR_ARG;
+
 	FTLCountsTable.totalPagesWritten += totalPagesToWrite;
 	++FTLCountsTable.totalWrites;
 
@@ -2841,17 +3788,19 @@ int FTL_Write(int logicalPageNumber, int totalPagesToWrite, uint8_t* pBuf)
 		return ERROR_ARG;
 	}
 
-	uint8_t* pageBuffer = malloc(Geometry->bytesPerPage);
-	SpareData* spareData = (SpareData*) malloc(Geometry->bytesPerSpare);
+	uint8_t* pageBuffer = ftl_pool_get(&PagePool);
+	SpareData* spareData = (SpareData*) ftl_pool_get(&SparePool);
 	if(!pageBuffer || !spareData) {
 		bufferPrintf("ftl: FTL_Write ran out of memory!\r\n");
+		ftl_pool_put(&PagePool, pageBuffer);
+		ftl_pool_put(&SparePool, spareData);
 		return ERROR_ARG;
 	}
 
 	for(i = 0; i < totalPagesToWrite; )
 	{
-		int lbn = (logicalPageNumber + i) / Geometry->pagesPerSuBlk;
-		int offset = (logicalPageNumber + i) - (lbn * Geometry->pagesPerSuBlk);
+		int lbn = vpn_to_vbn(logicalPageNumber + i);
+		int offset = vpn_to_offset(logicalPageNumber + i);
 
 		FTLCxtLog* pLog = ftl_prepare_log(lbn);
 
@@ -3018,19 +3967,612 @@ int FTL_Write(int logicalPageNumber, int totalPagesToWrite, uint8_t* pBuf)
 		}
 	}
 
+	ftl_pool_put(&PagePool, pageBuffer);
+	ftl_pool_put(&SparePool, spareData);
 	return 0;
 
 error_release:
-	free(pageBuffer);
-	free(spareData);
+	ftl_pool_put(&PagePool, pageBuffer);
+	ftl_pool_put(&SparePool, spareData);
 
 	return ERROR_ARG;
 }
 
+// Background garbage collection. Once the FTL has been written to, a task
+// does merges ahead of time while the FTL is idle, so that FTL_Write finds
+// free vbs and room in its log instead of merging in the middle of a write.
+#ifndef FTL_GC_FREE_VB
+#define FTL_GC_FREE_VB 6
+#endif
+
+// logs this full (in percent of the block) are merged ahead of time
+#ifndef FTL_GC_LOG_FULL
+#define FTL_GC_LOG_FULL 75
+#endif
+
+// microseconds without FTL requests before the GC runs, and between its steps
+#ifndef FTL_GC_IDLE
+#define FTL_GC_IDLE 200000
+#endif
+
+#ifndef FTL_GC_INTERVAL
+#define FTL_GC_INTERVAL 50000
+#endif
+
+static uint64_t FTLLastRequest = 0;
+static uint32_t FTLGCSteps = 0;
+
+// One merge or wear-level swap per call, so a request that comes in while
+// the GC runs waits for at most one of them.
+static int ftl_gc_step()
+{
+	FTLCxtLog* pLog = NULL;
+	int i;
+
+	if(!ftl_lazy_load_all())
+		return FALSE;
+
+	if(pstFTLCxt->wNumOfFreeVb <= FTL_GC_FREE_VB)
+	{
+		// the log ftl_merge would pick when the pool runs dry for a cold write
+		pLog = ftl_pick_victim(FALSE);
+
+		if(pLog != NULL)
+		{
+			FTLGCSteps++;
+			if(!ftl_mark_unclean())
+				return FALSE;
+
+			return ftl_merge_into_data_block(pLog);
+		}
+	}
+
+	uint32_t mostUsed = (Geometry->pagesPerSuBlk * FTL_GC_LOG_FULL) / 100;
+	for(i = 0; i < FTL_NUM_LOGS; ++i)
+	{
+		FTLCxtLog* cur = &pstFTLCxt->pLog[i];
+		if(cur->wVbn != 0xFFFF && cur->pagesUsed >= mostUsed && cur->pagesUsed > 0)
+		{
+			pLog = cur;
+			mostUsed = cur->pagesUsed;
+		}
+	}
+
+	if(pLog != NULL)
+	{
+		FTLGCSteps++;
+		return ftl_merge(pLog);
+	}
+
+	if(pstFTLCxt->swapCounter >= 20)
+	{
+		FTLGCSteps++;
+		if(ftl_auto_wearlevel())
+			pstFTLCxt->swapCounter -= 20;
+	}
+
+	return TRUE;
+}
+
+// Blocks read often enough to risk read disturb, or that needed a refresh
+// according to the VFL, are queued by the read path and rewritten to a
+// fresh block by the GC task once the FTL is idle. A block that does not
+// fit in the queue is noted again on its next read. Refresh reports only
+// count on NAND that tells corrected reads apart (field_2F > 0); otherwise
+// the VFL flags every read.
+#ifndef FTL_REFRESH_READS
+#define FTL_REFRESH_READS 40000
+#endif
+
+#ifndef FTL_REFRESH_QUEUE
+#define FTL_REFRESH_QUEUE 8
+#endif
+
+static uint16_t RefreshQueue[FTL_REFRESH_QUEUE];
+static int RefreshQueued = 0;
+static uint32_t FTLRefreshes = 0;
+
+static void ftl_refresh_note(uint16_t lbn, int reported)
+{
+	int i;
+	int due = (reported && Geometry->field_2F > 0);
+
+	if(pstFTLCxt->pawReadCounterTable[pstFTLCxt->pawMapTable[lbn]] >= FTL_REFRESH_READS)
+		due = TRUE;
+
+	FTLCxtLog* pLog = ftl_get_log(lbn);
+	if(pLog != NULL && pstFTLCxt->pawReadCounterTable[pLog->wVbn] >= FTL_REFRESH_READS)
+		due = TRUE;
+
+	if(!due)
+		return;
+
+	for(i = 0; i < RefreshQueued; i++)
+	{
+		if(RefreshQueue[i] == lbn)
+			return;
+	}
+
+	if(RefreshQueued < FTL_REFRESH_QUEUE)
+		RefreshQueue[RefreshQueued++] = lbn;
+}
+
+// Copies the lbn, log and all, into a block of its own, through an empty
+// log if it has none.
+static int ftl_refresh_step()
+{
+	uint16_t lbn = RefreshQueue[0];
+
+	if(!ftl_lazy_load_all())
+		return FALSE;
+
+	RefreshQueued--;
+	memmove(&RefreshQueue[0], &RefreshQueue[1], RefreshQueued * sizeof(uint16_t));
+
+	if(!ftl_mark_unclean())
+		return FALSE;
+
+	FTLCxtLog* pLog = ftl_get_log(lbn);
+	if(pLog == NULL)
+		pLog = ftl_prepare_log(lbn);
+
+	if(pLog == NULL)
+		return FALSE;
+
+	LogDebug(LogFTL, "ftl: refreshing lbn 0x%x\r\n", lbn);
+	FTLRefreshes++;
+	return ftl_merge_into_data_block(pLog);
+}
+
+// Sequential read-ahead. Once FTL_Read has been asked for the pages right
+// after the previous request FTL_READAHEAD_STREAK times in a row, the next
+// FTL_READAHEAD_PAGES pages are submitted to the NAND queue before it
+// returns, so the banks read them while the caller works on what it got.
+// Pages that are asked for next are copied out of the window; anything
+// else, a failed or doubtful prefetch included, goes through ftl_do_read
+// as usual. The window is dropped before anything can write or move a
+// page, and on the first read that is not next in the stream.
+
+#ifndef FTL_READAHEAD_PAGES
+#define FTL_READAHEAD_PAGES 16
+#endif
+
+#ifndef FTL_READAHEAD_STREAK
+#define FTL_READAHEAD_STREAK 2
+#endif
+
+typedef struct FTLReadAhead {
+	NANDRequest request;
+	uint8_t* buffer;
+	uint8_t* spare;
+} FTLReadAhead;
+
+static FTLReadAhead ReadAhead[FTL_READAHEAD_PAGES];
+static int ReadAheadPos = 0;
+static int ReadAheadCount = 0;
+static uint32_t ReadAheadFirst = 0;
+static uint32_t ReadAheadNext = 0xFFFFFFFF;
+static int ReadAheadStreak = 0;
+static uint32_t ReadAheadIssued = 0;
+static uint32_t ReadAheadHits = 0;
+
+static void ftl_readahead_drop()
+{
+	while(ReadAheadCount > 0)
+	{
+		nand_wait(&ReadAhead[ReadAheadPos].request);
+		ReadAheadPos = (ReadAheadPos + 1) % FTL_READAHEAD_PAGES;
+		ReadAheadCount--;
+	}
+}
+
+// The address vfl_do_read would read lpn from, or FALSE if it is not one.
+static int ftl_readahead_map(uint32_t lpn, uint16_t* bank, int* page, uint16_t* vb)
+{
+	int lbn = vpn_to_vbn(lpn);
+	int offset = vpn_to_offset(lpn);
+	FTLCxtLog* pLog = ftl_get_log_loaded(lbn);
+	uint32_t vpn;
+	uint16_t virtualBlock;
+	uint16_t virtualPage;
+
+	if(pLog != NULL && pLog->isSequential)
+		vpn = ((offset < pLog->pagesUsed) ? pLog->wVbn : pstFTLCxt->pawMapTable[lbn]) * Geometry->pagesPerSuBlk + offset;
+	else
+		vpn = FTL_map_page(pLog, lbn, offset);
+
+	*vb = vpn_to_vbn(vpn);
+
+	uint32_t dwVpn = vpn + (Geometry->pagesPerSuBlk * FTLData->field_4);
+	if(dwVpn < Geometry->pagesPerSuBlk || dwVpn >= Geometry->pagesTotal)
+		return FALSE;
+
+	virtual_page_number_to_virtual_address(dwVpn, bank, &virtualBlock, &virtualPage);
+	*page = virtual_block_to_physical_block(*bank, virtualBlock) * Geometry->pagesPerBlock + virtualPage;
+	return TRUE;
+}
+
+static void ftl_readahead_fill()
+{
+	int issued = FALSE;
+
+	if(ReadAheadCount == 0)
+		ReadAheadFirst = ReadAheadNext;
+
+	while(ReadAheadCount < FTL_READAHEAD_PAGES)
+	{
+		uint32_t lpn = ReadAheadFirst + ReadAheadCount;
+		FTLReadAhead* slot = &ReadAhead[(ReadAheadPos + ReadAheadCount) % FTL_READAHEAD_PAGES];
+		uint16_t bank;
+		uint16_t vb;
+		int page;
+
+		// ftl_do_read never reads the last user page either
+		if((lpn + 1) >= Geometry->userPagesTotal)
+			break;
+
+		if(slot->buffer == NULL)
+		{
+			slot->buffer = malloc_dma(Geometry->bytesPerPage);
+			slot->spare = malloc_dma(Geometry->bytesPerSpare);
+			if(slot->buffer == NULL || slot->spare == NULL)
+			{
+				free(slot->buffer);
+				free(slot->spare);
+				slot->buffer = NULL;
+				slot->spare = NULL;
+				break;
+			}
+		}
+
+		// an erased data block is read without going to NAND at all
+		if(!ftl_readahead_map(lpn, &bank, &page, &vb) || vfl_vb_erased(vb))
+			break;
+
+		pstFTLCxt->pawReadCounterTable[vb]++;
+		VFLData1.field_8++;
+		VFLData1.field_20++;
+
+		slot->request.operation = NANDOperationRead;
+		slot->request.bank = bank;
+		slot->request.page = page;
+		slot->request.buffer = slot->buffer;
+		slot->request.spare = slot->spare;
+		slot->request.doECC = TRUE;
+		slot->request.callback = NULL;
+		slot->request.opaque = NULL;
+		nand_submit(&slot->request);
+
+		ReadAheadCount++;
+		ReadAheadIssued++;
+		issued = TRUE;
+	}
+
+	// let the queue task get the reads going before the caller carries on
+	if(issued)
+		task_yield();
+}
+
+static int ftl_readahead_read(int logicalPageNumber, int totalPagesToRead, uint8_t* pBuf)
+{
+	int pagesRead = 0;
+	int ret = 0;
+
+	if(!pBuf || totalPagesToRead <= 0 || logicalPageNumber < 0 || (logicalPageNumber + totalPagesToRead) >= Geometry->userPagesTotal)
+	{
+		ftl_readahead_drop();
+		ReadAheadNext = 0xFFFFFFFF;
+		return ftl_do_read(logicalPageNumber, totalPagesToRead, pBuf);
+	}
+
+	if(logicalPageNumber == ReadAheadNext)
+	{
+		ReadAheadStreak++;
+	} else
+	{
+		ftl_readahead_drop();
+		ReadAheadStreak = 0;
+	}
+
+	while(pagesRead < totalPagesToRead && ReadAheadCount > 0 && ReadAheadFirst == (logicalPageNumber + pagesRead))
+	{
+		FTLReadAhead* slot = &ReadAhead[ReadAheadPos];
+		if(nand_wait(&slot->request) != 0 || ((SpareData*) slot->spare)->eccMark != 0xFF)
+			break;
+
+		memcpy(pBuf + (pagesRead * Geometry->bytesPerPage), slot->buffer, Geometry->bytesPerPage);
+		ftl_refresh_note(vpn_to_vbn(ReadAheadFirst), FALSE);
+
+		ReadAheadPos = (ReadAheadPos + 1) % FTL_READAHEAD_PAGES;
+		ReadAheadCount--;
+		ReadAheadFirst++;
+		ReadAheadHits++;
+		pagesRead++;
+	}
+
+	if(pagesRead > 0)
+	{
+		FTLCountsTable.totalPagesRead += pagesRead;
+		++FTLCountsTable.totalReads;
+		pstFTLCxt->totalReadCount++;
+	}
+
+	if(pagesRead < totalPagesToRead)
+	{
+		// the rest were not prefetched, or the prefetch needs the retries and error handling of a real read
+		ftl_readahead_drop();
+		ret = ftl_do_read(logicalPageNumber + pagesRead, totalPagesToRead - pagesRead, pBuf + (pagesRead * Geometry->bytesPerPage));
+	}
+
+	ReadAheadNext = logicalPageNumber + totalPagesToRead;
+
+	if(ret == 0 && ReadAheadStreak >= FTL_READAHEAD_STREAK)
+		ftl_readahead_fill();
+
+	return ret;
+}
+
+// Erases one of the free blocks waiting for it, so the next writer that
+// needs a block does not have to.
+static int ftl_pre_erase_step()
+{
+	int i;
+	int curFreeIdx = pstFTLCxt->nextFreeIdx;
+
+	if(!ftl_lazy_load_all())
+		return FALSE;
+
+	for(i = 0; i < pstFTLCxt->wNumOfFreeVb; ++i)
+	{
+		uint16_t block = pstFTLCxt->awFreeVb[curFreeIdx];
+		if(block != 0xFFFF && FreeVbDirty[block])
+		{
+			++FreeVbErasedIdle;
+			return ftl_erase_free_vb(block);
+		}
+
+		curFreeIdx = (curFreeIdx + 1) % 20;
+	}
+
+	// none of them is free any more
+	memset(FreeVbDirty, FALSE, Geometry->userSuBlksTotal + 24);
+	FreeVbDirtyCount = 0;
+	return TRUE;
+}
+
+static void ftl_gc_task(void* opaque)
+{
+	while(TRUE)
+	{
+		if(LazyTablesPending)
+		{
+			// finish loading what FTL_Open left out, one page at a time
+			mutex_lock(&FTLLock);
+			ftl_lazy_load_next();
+			mutex_unlock(&FTLLock);
+			task_yield();
+			continue;
+		}
+
+		task_sleep(FTL_GC_INTERVAL);
+
+		if(!HasFTLInit || !has_elapsed(FTLLastRequest, FTL_GC_IDLE))
+			continue;
+
+		// nothing to merge for an FTL that has not been written to since it was committed
+		if(pstFTLCxt->clean && RefreshQueued == 0 && FreeVbDirtyCount == 0)
+			continue;
+
+		mutex_lock(&FTLLock);
+		ftl_readahead_drop();
+		vfl_batch_begin();
+		if(RefreshQueued > 0)
+		{
+			if(!ftl_refresh_step())
+				bufferPrintf("ftl: background refresh failed\r\n");
+		} else if(FreeVbDirtyCount > 0)
+		{
+			if(!ftl_pre_erase_step())
+				bufferPrintf("ftl: background erase failed\r\n");
+		} else if(!ftl_gc_step())
+			bufferPrintf("ftl: background merge failed\r\n");
+		vfl_batch_end();
+		mutex_unlock(&FTLLock);
+	}
+}
+
+int FTL_Read(int logicalPageNumber, int totalPagesToRead, uint8_t* pBuf) {
+	mutex_lock(&FTLLock);
+	vfl_batch_begin();
+	uint64_t start = latency_start();
+	int ret = ftl_readahead_read(logicalPageNumber, totalPagesToRead, pBuf);
+	latency_record(LatencyFTLRead, logicalPageNumber, totalPagesToRead, start);
+	LogDebug(LogFTL, "ftl: read %d pages at 0x%x: %d\r\n", totalPagesToRead, logicalPageNumber, ret);
+	vfl_batch_end();
+	FTLLastRequest = timer_get_system_microtime();
+	mutex_unlock(&FTLLock);
+	return ret;
+}
+
+int FTL_Write(int logicalPageNumber, int totalPagesToWrite, uint8_t* pBuf) {
+	mutex_lock(&FTLLock);
+	ftl_readahead_drop();
+	vfl_batch_begin();
+	uint64_t start = latency_start();
+	int ret = ftl_do_write(logicalPageNumber, totalPagesToWrite, pBuf);
+	latency_record(LatencyFTLWrite, logicalPageNumber, totalPagesToWrite, start);
+	LogDebug(LogFTL, "ftl: wrote %d pages at 0x%x: %d\r\n", totalPagesToWrite, logicalPageNumber, ret);
+	vfl_batch_end();
+	FTLLastRequest = timer_get_system_microtime();
+	mutex_unlock(&FTLLock);
+	return ret;
+}
+
+// Every lbn keeps its data block, but log pages of a discarded range stop
+// being current, so merges and compaction no longer copy them, and a log
+// left with nothing current goes back to the free pool. A sequential log
+// can only go as a whole, as its pages have to stay in order.
+static int ftl_discard_in_log(FTLCxtLog* pLog, int offset, int count)
+{
+	int whole = (offset == 0 && count == Geometry->pagesPerSuBlk);
+	int current = 0;
+	int i;
+
+	if(!whole && pLog->isSequential)
+		return TRUE;
+
+	if(!whole)
+	{
+		for(i = offset; i < (offset + count); i++)
+		{
+			if(pLog->wPageOffsets[i] != 0xFFFF)
+				current++;
+		}
+
+		if(current == 0)
+			return TRUE;
+	}
+
+	if(!ftl_mark_unclean())
+		return FALSE;
+
+	if(!whole)
+	{
+		for(i = offset; i < (offset + count); i++)
+			pLog->wPageOffsets[i] = 0xFFFF;
+
+		pLog->pagesCurrent -= current;
+		if(pLog->pagesCurrent > 0)
+			return TRUE;
+	}
+
+	pLog->pagesCurrent = 0;
+	if(!ftl_set_free_vb(pLog->wVbn))
+	{
+		bufferPrintf("ftl: discard cannot release vb!\r\n");
+		return FALSE;
+	}
+
+	pLog->wVbn = 0xFFFF;
+	return TRUE;
+}
+
+static int ftl_do_discard(uint32_t lpn, int count)
+{
+	if(count <= 0 || (lpn + count) > Geometry->userPagesTotal)
+		return FALSE;
+
+	if(!ftl_lazy_load_all())
+		return FALSE;
+
+	while(count > 0)
+	{
+		uint16_t lbn = vpn_to_vbn(lpn);
+		int offset = vpn_to_offset(lpn);
+		int pages = Geometry->pagesPerSuBlk - offset;
+		if(pages > count)
+			pages = count;
+
+		FTLCxtLog* pLog = ftl_get_log(lbn);
+		if(pLog != NULL && pLog->pagesUsed > 0 && !ftl_discard_in_log(pLog, offset, pages))
+			return FALSE;
+
+		lpn += pages;
+		count -= pages;
+	}
+
+	return TRUE;
+}
+
+int ftl_discard(uint32_t lpn, int count)
+{
+	mutex_lock(&FTLLock);
+	ftl_readahead_drop();
+	vfl_batch_begin();
+	int ret = ftl_do_discard(lpn, count);
+	LogDebug(LogFTL, "ftl: discarded %d pages at 0x%x: %d\r\n", count, lpn, ret);
+	vfl_batch_end();
+	FTLLastRequest = timer_get_system_microtime();
+	mutex_unlock(&FTLLock);
+	return ret;
+}
+
 int ftl_sync()
+{
+	mutex_lock(&FTLLock);
+	ftl_readahead_drop();
+	vfl_batch_begin();
+	int ret = ftl_do_sync();
+	vfl_batch_end();
+	mutex_unlock(&FTLLock);
+	return ret;
+}
+
+static int ftl_export_table(uint8_t* start, uint32_t space, uint32_t* used, const void* data, uint32_t size, FTLExportTable* table)
+{
+	uint32_t offset = (*used + 3) & ~3;
+	if(size > space || offset > (space - size))
+		return FALSE;
+
+	memset(start + *used, 0, offset - *used);
+	memcpy(start + offset, data, size);
+	table->address = (uint32_t) start + offset;
+	table->size = size;
+	*used = offset + size;
+	return TRUE;
+}
+
+int ftl_export(void* start, uint32_t space, FTLExport* export)
+{
+	uint32_t userTable = (Geometry->userSuBlksTotal + 23) * sizeof(uint16_t);
+	uint32_t used = 0;
+
+	if(!HasFTLInit)
+		return FALSE;
+
+	mutex_lock(&FTLLock);
+	ftl_readahead_drop();
+
+	if(!ftl_lazy_load_all()
+			|| !ftl_export_table(start, space, &used, pstVFLCxt, Geometry->banksTotal * sizeof(VFLCxt), &export->vflCxt)
+			|| !ftl_export_table(start, space, &used, pstFTLCxt, sizeof(FTLCxt), &export->ftlCxt)
+			|| !ftl_export_table(start, space, &used, pstFTLCxt->pawMapTable, Geometry->userSuBlksTotal * sizeof(uint16_t), &export->mapTable)
+			|| !ftl_export_table(start, space, &used, pstFTLCxt->wPageOffsets, Geometry->pagesPerSuBlk * (FTL_NUM_LOGS * sizeof(uint16_t)), &export->pageOffsets)
+			|| !ftl_export_table(start, space, &used, pstFTLCxt->pawEraseCounterTable, userTable, &export->eraseCounters)
+			|| !ftl_export_table(start, space, &used, pstFTLCxt->pawReadCounterTable, userTable, &export->readCounters))
+	{
+		mutex_unlock(&FTLLock);
+		return FALSE;
+	}
+
+	export->version = FTL_EXPORT_VERSION;
+	export->start = (uint32_t) start;
+	export->size = (used + FTL_EXPORT_ALIGN - 1) & ~(FTL_EXPORT_ALIGN - 1);
+	if(export->size > space)
+		export->size = used;
+
+	memset((uint8_t*) start + used, 0, export->size - used);
+	export->banks = Geometry->banksTotal;
+	export->crc = 0;
+	crc32(&export->crc, start, export->size);
+
+	// FTLLock stays taken: nothing may change the FTL behind the copy now
+	return TRUE;
+}
+
+static int ftl_do_sync()
 {
 	int tries;
 
+#ifndef NO_HFS
+	// push out anything still sitting in the block device's page cache
+	if(!bdev_flush())
+	{
+		bufferPrintf("ftl: sync could not flush the bdev page cache!\r\n");
+		return FALSE;
+	}
+#endif
+
 	if(pstFTLCxt->clean)
 		return TRUE;
 
@@ -3048,6 +4590,12 @@ int ftl_sync()
 		}
 	}
 
+	if(FreeVbDirtyCount > 0 && !ftl_erase_dirty_free_vbs())
+	{
+		bufferPrintf("ftl: sync could not erase the free blocks!\r\n");
+		return FALSE;
+	}
+
 	for(tries = 0; tries < 4; ++ tries)
 	{
 		if(ftl_commit_cxt())
@@ -3068,10 +4616,13 @@ int ftl_setup() {
 	if(HasFTLInit)
 		return 0;
 
+	mutex_init(&FTLLock);
+
 	nand_setup();
 
 	Geometry = nand_get_geometry();
 	FTLData = nand_get_ftl_data();
+	ftl_geometry_setup();
 
 	if(VFL_Init() != 0) {
 		bufferPrintf("ftl: VFL_Init failed\r\n");
@@ -3083,11 +4634,14 @@ int ftl_setup() {
 		return -1;
 	}
 
+	ftl_pool_init(&PagePool, Geometry->bytesPerPage, FTL_POOL_PAGES);
+	ftl_pool_init(&SparePool, Geometry->bytesPerSpare, FTL_POOL_PAGES);
+
 	int i;
 	int foundSignature = FALSE;
 
-	DebugPrintf("ftl: Attempting to read %d pages from first block of first bank.\r\n", Geometry->pagesPerBlock);
-	uint8_t* buffer = malloc(Geometry->bytesPerPage);
+	LogDebug(LogFTL, "ftl: Attempting to read %d pages from first block of first bank.\r\n", Geometry->pagesPerBlock);
+	uint8_t* buffer = malloc_dma(Geometry->bytesPerPage);
 	for(i = 0; i < Geometry->pagesPerBlock; i++) {
 		int ret;
 		if((ret = nand_read_alternate_ecc(0, i, buffer)) == 0) {
@@ -3097,10 +4651,10 @@ int ftl_setup() {
 				foundSignature = TRUE;
 				break;
 			} else {
-				DebugPrintf("ftl: Found non-matching signature: %x\r\n", ((uint32_t*) buffer));
+				LogDebug(LogFTL, "ftl: Found non-matching signature: %x\r\n", *((uint32_t*) buffer));
 			}
 		} else {
-			DebugPrintf("ftl: page %d of first bank is unreadable: %x!\r\n", i, ret);
+			LogDebug(LogFTL, "ftl: page %d of first bank is unreadable: %x!\r\n", i, ret);
 		}
 	}
 	free(buffer);
@@ -3122,6 +4676,21 @@ int ftl_setup() {
 		return -1;
 	}
 
+	ftl_log_index_rebuild();
+
+	// without it every lbn is cold, and logs go oldest first as before
+	LbnHeat = (uint8_t*) malloc(Geometry->userSuBlksTotal);
+	if(LbnHeat != NULL)
+		memset(LbnHeat, 0, Geometry->userSuBlksTotal);
+
+	// without it freed blocks are erased on the spot
+	FreeVbDirty = (uint8_t*) malloc(Geometry->userSuBlksTotal + 24);
+	if(FreeVbDirty != NULL)
+		memset(FreeVbDirty, FALSE, Geometry->userSuBlksTotal + 24);
+
+	if(task_create("ftl-gc", ftl_gc_task, NULL, 0) == NULL)
+		bufferPrintf("ftl: could not start background merging\r\n");
+
 	HasFTLInit = TRUE;
 
 	return 0;
@@ -3129,13 +4698,31 @@ int ftl_setup() {
 
 int ftl_read(void* buffer, uint64_t offset, int size) {
 	uint8_t* curLoc = (uint8_t*) buffer;
-	int curPage = offset / Geometry->bytesPerPage;
+	int curPage = bytes_to_pages(offset);
 	int toRead = size;
 	int pageOffset = offset - (curPage * Geometry->bytesPerPage);
-	uint8_t* tBuffer = (uint8_t*) malloc(Geometry->bytesPerPage);
+	uint8_t* tBuffer = NULL;
 	while(toRead > 0) {
+		if(pageOffset == 0 && toRead >= Geometry->bytesPerPage && (((uint32_t)curLoc) & 0x3) == 0) {
+			// a run of whole pages, DMA it straight into the caller's buffer
+			int pages = bytes_to_pages(toRead);
+			if(FTL_Read(curPage, pages, curLoc) != 0) {
+				ftl_pool_put(&PagePool, tBuffer);
+				return FALSE;
+			}
+
+			curLoc += pages * Geometry->bytesPerPage;
+			toRead -= pages * Geometry->bytesPerPage;
+			curPage += pages;
+			continue;
+		}
+
+		// unaligned head or tail page, bounce it
+		if(tBuffer == NULL)
+			tBuffer = (uint8_t*) ftl_pool_get(&PagePool);
+
 		if(FTL_Read(curPage, 1, tBuffer) != 0) {
-			free(tBuffer);
+			ftl_pool_put(&PagePool, tBuffer);
 			return FALSE;
 		}
 
@@ -3147,19 +4734,37 @@ int ftl_read(void* buffer, uint64_t offset, int size) {
 		curPage++;
 	}
 
-	free(tBuffer);
+	ftl_pool_put(&PagePool, tBuffer);
 	return TRUE;
 }
 
 int ftl_write(void* buffer, uint64_t offset, int size) {
 	uint8_t* curLoc = (uint8_t*) buffer;
-	int curPage = offset / Geometry->bytesPerPage;
+	int curPage = bytes_to_pages(offset);
 	int toWrite = size;
 	int pageOffset = offset - (curPage * Geometry->bytesPerPage);
-	uint8_t* tBuffer = (uint8_t*) malloc(Geometry->bytesPerPage);
+	uint8_t* tBuffer = NULL;
 	while(toWrite > 0) {
+		if(pageOffset == 0 && toWrite >= Geometry->bytesPerPage && (((uint32_t)curLoc) & 0x3) == 0) {
+			// a run of whole pages, no need to read back what we are about to replace
+			int pages = bytes_to_pages(toWrite);
+			if(FTL_Write(curPage, pages, curLoc) != 0) {
+				ftl_pool_put(&PagePool, tBuffer);
+				return FALSE;
+			}
+
+			curLoc += pages * Geometry->bytesPerPage;
+			toWrite -= pages * Geometry->bytesPerPage;
+			curPage += pages;
+			continue;
+		}
+
+		// unaligned head or tail page, read-modify-write it through the bounce buffer
+		if(tBuffer == NULL)
+			tBuffer = (uint8_t*) ftl_pool_get(&PagePool);
+
 		if(FTL_Read(curPage, 1, tBuffer) != 0) {
-			free(tBuffer);
+			ftl_pool_put(&PagePool, tBuffer);
 			return FALSE;
 		}
 
@@ -3167,7 +4772,7 @@ int ftl_write(void* buffer, uint64_t offset, int size) {
 		memcpy(tBuffer + pageOffset, curLoc, write);
 
 		if(FTL_Write(curPage, 1, tBuffer) != 0) {
-			free(tBuffer);
+			ftl_pool_put(&PagePool, tBuffer);
 			return FALSE;
 		}
 
@@ -3177,13 +4782,16 @@ int ftl_write(void* buffer, uint64_t offset, int size) {
 		curPage++;
 	}
 
-	free(tBuffer);
+	ftl_pool_put(&PagePool, tBuffer);
 	return TRUE;
 }
 
 void ftl_printdata() {
 	int i, j;
 
+	mutex_lock(&FTLLock);
+	ftl_lazy_load_all();
+
 	bufferPrintf("usnDec: %u\r\n", pstFTLCxt->usnDec);
 	bufferPrintf("nextblockusn: %u\r\n", pstFTLCxt->nextblockusn);
 	bufferPrintf("nextFreeIdx: %u\r\n", pstFTLCxt->nextFreeIdx);
@@ -3196,6 +4804,11 @@ void ftl_printdata() {
 	bufferPrintf("page_for_FTLCountsTable: %u\r\n", pstFTLCxt->page_for_FTLCountsTable);
 	bufferPrintf("hasFTLCountsTable: %u\r\n", pstFTLCxt->hasFTLCountsTable);
 	bufferPrintf("Total read count: %u\r\n", pstFTLCxt->totalReadCount);
+	bufferPrintf("Background GC steps: %u\r\n", FTLGCSteps);
+	bufferPrintf("Background refreshes: %u, %d queued\r\n", FTLRefreshes, RefreshQueued);
+	bufferPrintf("Read-ahead: %u pages issued, %u hit\r\n", ReadAheadIssued, ReadAheadHits);
+	bufferPrintf("Context commits: %u table pages written, %u left in place\r\n", CommitPagesWritten, CommitPagesKept);
+	bufferPrintf("Free blocks waiting for an erase: %d (%u erased while idle, %u while allocating)\r\n", FreeVbDirtyCount, FreeVbErasedIdle, FreeVbErasedInline);
 
 	bufferPrintf("Free virtual blocks: %d\r\n", pstFTLCxt->wNumOfFreeVb);
 	for(i = 0; i < pstFTLCxt->wNumOfFreeVb; i++)
@@ -3228,7 +4841,7 @@ void ftl_printdata() {
 	}
 
 	bufferPrintf("Log blocks (page-by-page remapping):\r\n");
-	for(i = 0; i < 17; i++) {
+	for(i = 0; i < FTL_NUM_LOGS; i++) {
 		if(pstFTLCxt->pLog[i].wVbn == 0xFFFF)
 			continue;
 
@@ -3256,4 +4869,5 @@ void ftl_printdata() {
 		bufferPrintf("\tvirtual block %d: %d\r\n", i, pstFTLCxt->pawEraseCounterTable[i]);
 	}
 
+	mutex_unlock(&FTLLock);
 }
@@ -74,7 +74,7 @@ void gpio_register_interrupt(uint32_t interrupt, int type, int level, int autofl
 
 	EnterCriticalSection();
 
-	InterruptGroups[group].flags[index] = (type ? GPIO_INTTYPE_LEVEL : 0) | (level ? GPIO_INTLEVEL_HIGH : 0) | (level ? GPIO_AUTOFLIP_YES : 0);
+	InterruptGroups[group].flags[index] = (type ? GPIO_INTTYPE_LEVEL : 0) | (level ? GPIO_INTLEVEL_HIGH : 0) | (autoflip ? GPIO_AUTOFLIP_YES : 0);
 	InterruptGroups[group].handler[index] = handler;
 	InterruptGroups[group].token[index] = token;
 
@@ -0,0 +1,162 @@
+#include "openiboot.h"
+#include "hash.h"
+#include "util.h"
+#include "sha1.h"
+#include "nor.h"
+#include "nand.h"
+#include "ftl.h"
+
+typedef struct HashState {
+	HashAlgorithm algorithm;
+	uint32_t sum;
+	SHA1_CTX sha1;
+} HashState;
+
+int hash_digest_size(HashAlgorithm algorithm) {
+	switch(algorithm) {
+		case HashCRC32:
+		case HashAdler32:
+			return sizeof(uint32_t);
+		case HashSHA1:
+			return 20;
+		default:
+			return 0;
+	}
+}
+
+uint32_t hash_blocks(uint64_t length, uint32_t blockSize) {
+	if(blockSize == 0)
+		return 0;
+
+	return (uint32_t)((length + blockSize - 1) / blockSize);
+}
+
+static void hash_begin(HashState* state) {
+	if(state->algorithm == HashSHA1)
+		SHA1Init(&state->sha1);
+	else if(state->algorithm == HashAdler32)
+		state->sum = 1;
+	else
+		state->sum = 0;
+}
+
+static void hash_update(HashState* state, const uint8_t* data, uint32_t len) {
+	if(state->algorithm == HashSHA1)
+		SHA1Update(&state->sha1, data, len);
+	else if(state->algorithm == HashAdler32)
+		state->sum = adler32_update(state->sum, data, len);
+	else
+		crc32(&state->sum, data, len);
+}
+
+static void hash_end(HashState* state, uint8_t* digest) {
+	if(state->algorithm == HashSHA1)
+		SHA1Final(digest, &state->sha1);
+	else
+		memcpy(digest, &state->sum, sizeof(uint32_t));
+}
+
+// Virtual pages are read whole, so a chunk that starts or ends inside one
+// takes what it needs out of page.
+static int hash_read_vfl(uint8_t* buffer, uint64_t offset, uint32_t len, uint8_t* page) {
+	uint32_t pageSize = nand_get_geometry()->bytesPerPage;
+
+	while(len > 0) {
+		uint32_t vpn = (uint32_t)(offset / pageSize);
+		uint32_t within = (uint32_t)(offset % pageSize);
+		uint32_t toCopy = pageSize - within;
+		if(toCopy > len)
+			toCopy = len;
+
+		int ret = VFL_Read(vpn, page, NULL, TRUE, NULL);
+		if(ret == ERROR_EMPTYBLOCK)
+			memset(page, 0xFF, pageSize);
+		else if(ret != 0) {
+			bufferPrintf("hash: could not read virtual page %d: %x\r\n", vpn, ret);
+			return FALSE;
+		}
+
+		memcpy(buffer, page + within, toCopy);
+		buffer += toCopy;
+		offset += toCopy;
+		len -= toCopy;
+	}
+
+	return TRUE;
+}
+
+// Returns where the len bytes at offset ended up, or NULL if they could not
+// be read. Memory is hashed where it is.
+static const uint8_t* hash_read(HashSource source, uint64_t offset, uint32_t len, uint8_t* buffer, uint8_t* page) {
+	switch(source) {
+		case HashMemory:
+			return (const uint8_t*)(uint32_t) offset;
+
+		case HashNOR:
+			nor_read(buffer, (int) offset, len);
+			return buffer;
+
+		case HashVFL:
+			return hash_read_vfl(buffer, offset, len, page) ? buffer : NULL;
+
+		case HashFTL:
+			return ftl_read(buffer, offset, len) ? buffer : NULL;
+
+		default:
+			return NULL;
+	}
+}
+
+int hash_range(HashAlgorithm algorithm, HashSource source, uint64_t offset, uint64_t length, uint32_t blockSize, uint8_t* digests) {
+	int digestSize = hash_digest_size(algorithm);
+	uint8_t* buffer = NULL;
+	uint8_t* page = NULL;
+	HashState state;
+	int ret = -1;
+
+	if(digestSize == 0 || blockSize == 0 || source > HashFTL)
+		return -1;
+
+	if(source != HashMemory) {
+		buffer = malloc(HASH_CHUNK);
+		if(buffer == NULL)
+			return -1;
+	}
+
+	if(source == HashVFL) {
+		page = malloc_dma(nand_get_geometry()->bytesPerPage);
+		if(page == NULL)
+			goto out;
+	}
+
+	state.algorithm = algorithm;
+	while(length > 0) {
+		uint32_t left = (length < blockSize) ? (uint32_t) length : blockSize;
+
+		hash_begin(&state);
+		while(left > 0) {
+			uint32_t len = (left < HASH_CHUNK) ? left : HASH_CHUNK;
+			const uint8_t* data = hash_read(source, offset, len, buffer, page);
+			if(data == NULL)
+				goto out;
+
+			hash_update(&state, data, len);
+			offset += len;
+			length -= len;
+			left -= len;
+		}
+
+		hash_end(&state, digests);
+		digests += digestSize;
+	}
+
+	ret = 0;
+
+out:
+	if(page)
+		free(page);
+	if(buffer)
+		free(buffer);
+
+	return ret;
+}
@@ -0,0 +1,309 @@
+#include "openiboot.h"
+#include "heapprof.h"
+#include "util.h"
+#include "openiboot-asmhelpers.h"
+
+extern void* sbrk(intptr_t incr);
+
+typedef struct HeapProfRecord {
+	void* ptr;
+	uint32_t size;
+	uint16_t site;
+	uint16_t generation;
+} HeapProfRecord;
+
+typedef struct HeapProfSite {
+	void* caller;
+	uint32_t allocs;
+	uint32_t liveCount;
+	uint32_t liveBytes;
+	uint32_t peakBytes;
+} HeapProfSite;
+
+int HeapProfiling = FALSE;
+
+static int Recording = FALSE;
+
+// Open addressing on the pointer, with backward shift deletion so that the
+// table never fills up with tombstones. Site 0 takes every caller once the
+// site table is full.
+static HeapProfRecord* Records = NULL;
+static HeapProfSite* Sites = NULL;
+static uint32_t RecordCount;
+static uint32_t SiteCount;
+static uint32_t Untracked;
+static uint32_t LiveBytes;
+static uint32_t PeakBytes;
+static uint32_t Histogram[HEAPPROF_BUCKETS];
+static uint16_t Generation;
+static uint16_t Mark;
+
+static inline uint32_t record_hash(void* ptr) {
+	return (((uint32_t) ptr) >> 3) * 2654435761U;
+}
+
+static inline uint32_t record_slot(void* ptr) {
+	return record_hash(ptr) & (HEAPPROF_RECORDS - 1);
+}
+
+static uint16_t site_find(void* caller) {
+	uint32_t slot = (((uint32_t) caller) * 2654435761U) & (HEAPPROF_SITES - 1);
+	uint32_t i;
+
+	for(i = 0; i < HEAPPROF_SITES; i++) {
+		if(slot != 0) {
+			if(Sites[slot].caller == caller)
+				return slot;
+
+			if(Sites[slot].caller == NULL) {
+				if(SiteCount >= (HEAPPROF_SITES - 1))
+					return 0;
+
+				Sites[slot].caller = caller;
+				SiteCount++;
+				return slot;
+			}
+		}
+		slot = (slot + 1) & (HEAPPROF_SITES - 1);
+	}
+
+	return 0;
+}
+
+static int record_find(void* ptr) {
+	uint32_t slot = record_slot(ptr);
+
+	while(Records[slot].ptr != NULL) {
+		if(Records[slot].ptr == ptr)
+			return slot;
+		slot = (slot + 1) & (HEAPPROF_RECORDS - 1);
+	}
+
+	return -1;
+}
+
+static void record_remove(uint32_t slot) {
+	HeapProfRecord* record = &Records[slot];
+	HeapProfSite* site = &Sites[record->site];
+	uint32_t next = slot;
+
+	site->liveCount--;
+	site->liveBytes -= record->size;
+	LiveBytes -= record->size;
+	RecordCount--;
+
+	// Pull later entries of the probe chain back into the hole, unless
+	// their home slot lies (cyclically) between the hole and themselves.
+	while(TRUE) {
+		next = (next + 1) & (HEAPPROF_RECORDS - 1);
+		if(Records[next].ptr == NULL)
+			break;
+
+		uint32_t home = record_slot(Records[next].ptr);
+		if(((next - home) & (HEAPPROF_RECORDS - 1)) >= ((next - slot) & (HEAPPROF_RECORDS - 1))) {
+			Records[slot] = Records[next];
+			slot = next;
+		}
+	}
+
+	Records[slot].ptr = NULL;
+}
+
+void heapprof_alloc(void* ptr, size_t size, void* caller) {
+	if(ptr == NULL)
+		return;
+
+	EnterCriticalSection();
+
+	// realloc in place hands back the same pointer.
+	int found = record_find(ptr);
+	if(found >= 0)
+		record_remove(found);
+
+	if(Recording) {
+		if(RecordCount >= (HEAPPROF_RECORDS / 4 * 3)) {
+			Untracked++;
+		} else {
+			uint32_t slot = record_slot(ptr);
+			while(Records[slot].ptr != NULL)
+				slot = (slot + 1) & (HEAPPROF_RECORDS - 1);
+
+			uint16_t index = site_find(caller);
+			HeapProfSite* site = &Sites[index];
+
+			Records[slot].ptr = ptr;
+			Records[slot].size = size;
+			Records[slot].site = index;
+			Records[slot].generation = Generation;
+			RecordCount++;
+
+			site->allocs++;
+			site->liveCount++;
+			site->liveBytes += size;
+			if(site->liveBytes > site->peakBytes)
+				site->peakBytes = site->liveBytes;
+
+			LiveBytes += size;
+			if(LiveBytes > PeakBytes)
+				PeakBytes = LiveBytes;
+		}
+
+		int bucket = 0;
+		while(bucket < (HEAPPROF_BUCKETS - 1) && (size >> bucket) != 0)
+			bucket++;
+		Histogram[bucket]++;
+	}
+
+	LeaveCriticalSection();
+}
+
+void heapprof_free(void* ptr) {
+	if(ptr == NULL)
+		return;
+
+	EnterCriticalSection();
+
+	int found = record_find(ptr);
+	if(found >= 0)
+		record_remove(found);
+
+	LeaveCriticalSection();
+}
+
+void heapprof_command() {
+	Generation++;
+}
+
+int heapprof_start() {
+	if(Records == NULL) {
+		Records = (HeapProfRecord*) sbrk(sizeof(HeapProfRecord) * HEAPPROF_RECORDS);
+		Sites = (HeapProfSite*) sbrk(sizeof(HeapProfSite) * HEAPPROF_SITES);
+		heapprof_reset();
+		HeapProfiling = TRUE;
+	}
+
+	Recording = TRUE;
+	return 0;
+}
+
+// Frees are still followed while stopped, so the live counts stay right.
+void heapprof_stop() {
+	Recording = FALSE;
+}
+
+void heapprof_reset() {
+	if(Records == NULL)
+		return;
+
+	EnterCriticalSection();
+	memset(Records, 0, sizeof(HeapProfRecord) * HEAPPROF_RECORDS);
+	memset(Sites, 0, sizeof(HeapProfSite) * HEAPPROF_SITES);
+	memset(Histogram, 0, sizeof(Histogram));
+	RecordCount = 0;
+	SiteCount = 0;
+	Untracked = 0;
+	LiveBytes = 0;
+	PeakBytes = 0;
+	Mark = Generation;
+	LeaveCriticalSection();
+}
+
+void heapprof_mark() {
+	Mark = Generation;
+}
+
+void heapprof_print(int maxSites) {
+	static uint8_t printed[HEAPPROF_SITES];
+	int i;
+	int j;
+
+	if(Records == NULL) {
+		bufferPrintf("heap: profiler not started\r\n");
+		return;
+	}
+
+	bufferPrintf("heap: %d live allocations, %d bytes, peak %d bytes, %d untracked, %s\r\n",
+			RecordCount, LiveBytes, PeakBytes, Untracked, Recording ? "recording" : "stopped");
+
+	memset(printed, 0, sizeof(printed));
+	for(i = 0; i < maxSites; i++) {
+		int best = -1;
+		for(j = 0; j < HEAPPROF_SITES; j++) {
+			if(printed[j] || Sites[j].allocs == 0)
+				continue;
+
+			if(best < 0 || Sites[j].liveBytes > Sites[best].liveBytes
+					|| (Sites[j].liveBytes == Sites[best].liveBytes && Sites[j].peakBytes > Sites[best].peakBytes))
+				best = j;
+		}
+
+		if(best < 0)
+			break;
+
+		printed[best] = TRUE;
+		HeapProfSite* site = &Sites[best];
+		if(best == 0)
+			bufferPrintf("\t(other): ");
+		else
+			bufferPrintf("\t0x%x: ", (uint32_t) site->caller);
+		bufferPrintf("%d allocs, %d live (%d bytes), peak %d bytes\r\n", site->allocs, site->liveCount, site->liveBytes, site->peakBytes);
+	}
+
+	bufferPrintf("sizes:\r\n");
+	for(j = 0; j < HEAPPROF_BUCKETS; j++) {
+		if(Histogram[j] == 0)
+			continue;
+
+		if(j == 0)
+			bufferPrintf("\t0 bytes: %d\r\n", Histogram[j]);
+		else if(j == (HEAPPROF_BUCKETS - 1))
+			bufferPrintf("\t>= %d bytes: %d\r\n", 1 << (j - 1), Histogram[j]);
+		else
+			bufferPrintf("\t< %d bytes: %d\r\n", 1 << j, Histogram[j]);
+	}
+}
+
+// Lists, by site, what the commands run since the mark left allocated. The
+// current command is left out, it has not had a chance to clean up yet.
+void heapprof_print_leaks() {
+	static uint32_t counts[HEAPPROF_SITES];
+	static uint32_t bytes[HEAPPROF_SITES];
+	uint16_t span = (Generation == Mark) ? 0 : (uint16_t)(Generation - Mark - 1);
+	uint32_t total = 0;
+	int i;
+
+	if(Records == NULL) {
+		bufferPrintf("heap: profiler not started\r\n");
+		return;
+	}
+
+	memset(counts, 0, sizeof(counts));
+	memset(bytes, 0, sizeof(bytes));
+
+	EnterCriticalSection();
+	for(i = 0; i < HEAPPROF_RECORDS; i++) {
+		if(Records[i].ptr == NULL)
+			continue;
+
+		if((uint16_t)(Records[i].generation - Mark - 1) >= span)
+			continue;
+
+		counts[Records[i].site]++;
+		bytes[Records[i].site] += Records[i].size;
+	}
+	LeaveCriticalSection();
+
+	for(i = 0; i < HEAPPROF_SITES; i++) {
+		if(counts[i] == 0)
+			continue;
+
+		if(i == 0)
+			bufferPrintf("\t(other): ");
+		else
+			bufferPrintf("\t0x%x: ", (uint32_t) Sites[i].caller);
+		bufferPrintf("%d allocations, %d bytes\r\n", counts[i], bytes[i]);
+		total += bytes[i];
+	}
+
+	bufferPrintf("heap: %d bytes left allocated by %d commands\r\n", total, span);
+}
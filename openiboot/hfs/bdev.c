@@ -1,9 +1,11 @@
 #include "openiboot.h"
 #include "hfs/common.h"
 #include "hfs/bdev.h"
+#include "hfs/hfsplus.h"
 #include "ftl.h"
 #include "util.h"
 #include "nand.h"
+#include "latency.h"
 
 int HasBDevInit = FALSE;
 
@@ -11,6 +13,332 @@ static MBR MBRData;
 
 unsigned int BLOCK_SIZE = 0;
 
+// Page cache between HFS+ and the FTL. Entries are keyed by FTL logical page
+// so they are shared by every partition and every bdev_open handle.
+#ifndef BDEV_CACHE_PAGES
+#define BDEV_CACHE_PAGES 32
+#endif
+
+// Requests covering at least this many whole pages bypass the cache, so that
+// extracting a kernel does not evict all the B-tree nodes.
+#ifndef BDEV_CACHE_BYPASS_PAGES
+#define BDEV_CACHE_BYPASS_PAGES 16
+#endif
+
+typedef struct BDevCacheEntry {
+	uint32_t page;
+	uint32_t lastUsed;
+	int valid;
+	int dirty;
+	uint8_t* data;
+} BDevCacheEntry;
+
+// Pages of an encrypted partition go through the AES engine this many at a
+// time, in one session. The engine still has the last page of each lot to do
+// while the next lot is read from the FTL.
+#ifndef BDEV_CRYPT_CHUNK_PAGES
+#define BDEV_CRYPT_CHUNK_PAGES 16
+#endif
+
+typedef struct BDevCrypt {
+	int enabled;
+	AESKeyType keyType;
+	uint8_t key[32];
+} BDevCrypt;
+
+typedef struct BDevCryptFile {
+	io_func* raw;
+	BDevCrypt* crypt;
+	uint8_t* staging;		// BDEV_CRYPT_CHUNK_PAGES pages
+} BDevCryptFile;
+
+static BDevCrypt BDevCrypts[4];
+
+static BDevCacheEntry* BDevCache = NULL;
+static uint32_t BDevCacheClock = 0;
+
+static uint32_t BDevCacheHits = 0;
+static uint32_t BDevCacheMisses = 0;
+static uint32_t BDevCacheWritebacks = 0;
+static uint32_t BDevCacheWritebackRuns = 0;
+static uint32_t BDevCacheBypasses = 0;
+
+static void bdev_cache_setup() {
+	BDevCache = (BDevCacheEntry*) malloc(sizeof(BDevCacheEntry) * BDEV_CACHE_PAGES);
+	if(BDevCache == NULL)
+		return;
+
+	int i;
+	for(i = 0; i < BDEV_CACHE_PAGES; i++) {
+		BDevCache[i].valid = FALSE;
+		BDevCache[i].dirty = FALSE;
+		BDevCache[i].data = (uint8_t*) malloc_dma(BLOCK_SIZE);
+		if(BDevCache[i].data == NULL) {
+			bufferPrintf("bdev: could not allocate page cache\r\n");
+			while(--i >= 0)
+				free(BDevCache[i].data);
+
+			free(BDevCache);
+			BDevCache = NULL;
+			return;
+		}
+	}
+}
+
+static BDevCacheEntry* bdev_cache_find_dirty(uint32_t page) {
+	int i;
+	for(i = 0; i < BDEV_CACHE_PAGES; i++) {
+		if(BDevCache[i].valid && BDevCache[i].dirty && BDevCache[i].page == page)
+			return &BDevCache[i];
+	}
+
+	return NULL;
+}
+
+// Write back entry together with every dirty page adjacent to it, lowest page
+// first and in one FTL_Write where possible. The FTL keeps a log that is
+// written in page order sequential, which makes for a cheap merge later.
+static int bdev_cache_writeback(BDevCacheEntry* entry) {
+	if(!entry->valid || !entry->dirty)
+		return TRUE;
+
+	uint32_t first = entry->page;
+	uint32_t count;
+
+	while(first > 0 && bdev_cache_find_dirty(first - 1) != NULL)
+		first--;
+
+	count = entry->page - first + 1;
+	while(bdev_cache_find_dirty(first + count) != NULL)
+		count++;
+
+	BDevCacheWritebackRuns++;
+
+	uint8_t* run = NULL;
+	if(count > 1)
+		run = (uint8_t*) malloc_dma(count * BLOCK_SIZE);
+
+	uint32_t i;
+	if(run != NULL) {
+		for(i = 0; i < count; i++)
+			memcpy(run + (i * BLOCK_SIZE), bdev_cache_find_dirty(first + i)->data, BLOCK_SIZE);
+
+		int ret = ftl_write(run, (uint64_t)first * BLOCK_SIZE, count * BLOCK_SIZE);
+		free(run);
+		if(!ret)
+			return FALSE;
+
+		for(i = 0; i < count; i++)
+			bdev_cache_find_dirty(first + i)->dirty = FALSE;
+
+		BDevCacheWritebacks += count;
+		return TRUE;
+	}
+
+	// no room for a staging buffer, so write the run a page at a time
+	for(i = 0; i < count; i++) {
+		BDevCacheEntry* cur = bdev_cache_find_dirty(first + i);
+		if(!ftl_write(cur->data, (uint64_t)cur->page * BLOCK_SIZE, BLOCK_SIZE))
+			return FALSE;
+
+		cur->dirty = FALSE;
+		BDevCacheWritebacks++;
+	}
+
+	return TRUE;
+}
+
+// Look up page in the cache, evicting the least recently used entry on a miss.
+// If load is FALSE the caller is about to overwrite the whole page and it is
+// not read from the FTL.
+static BDevCacheEntry* bdev_cache_get(uint32_t page, int load) {
+	BDevCacheEntry* victim = NULL;
+	int i;
+
+	for(i = 0; i < BDEV_CACHE_PAGES; i++) {
+		BDevCacheEntry* entry = &BDevCache[i];
+		if(entry->valid && entry->page == page) {
+			BDevCacheHits++;
+			entry->lastUsed = ++BDevCacheClock;
+			return entry;
+		}
+
+		if(victim == NULL || !entry->valid || (victim->valid && entry->lastUsed < victim->lastUsed))
+			victim = entry;
+	}
+
+	BDevCacheMisses++;
+
+	if(!bdev_cache_writeback(victim))
+		return NULL;
+
+	victim->valid = FALSE;
+
+	if(load && !ftl_read(victim->data, (uint64_t)page * BLOCK_SIZE, BLOCK_SIZE))
+		return NULL;
+
+	victim->page = page;
+	victim->valid = TRUE;
+	victim->dirty = FALSE;
+	victim->lastUsed = ++BDevCacheClock;
+
+	return victim;
+}
+
+// Write back (and optionally drop) every cached page in [page, page + count)
+static int bdev_cache_sync_range(uint32_t page, uint32_t count, int invalidate) {
+	int i;
+	for(i = 0; i < BDEV_CACHE_PAGES; i++) {
+		BDevCacheEntry* entry = &BDevCache[i];
+		if(!entry->valid || entry->page < page || entry->page >= (page + count))
+			continue;
+
+		if(invalidate)
+			entry->valid = FALSE;
+		else if(!bdev_cache_writeback(entry))
+			return FALSE;
+	}
+
+	return TRUE;
+}
+
+static int bdev_cache_read(uint64_t offset, size_t size, uint8_t* buffer) {
+	uint32_t page = offset / BLOCK_SIZE;
+	uint32_t pageOffset = offset - ((uint64_t)page * BLOCK_SIZE);
+
+	if(BDevCache == NULL)
+		return ftl_read(buffer, offset, size);
+
+	while(size > 0) {
+		if(pageOffset == 0 && size >= (BDEV_CACHE_BYPASS_PAGES * BLOCK_SIZE)) {
+			uint32_t count = size / BLOCK_SIZE;
+			BDevCacheBypasses++;
+
+			// make sure the FTL has our newest copy of anything in this range
+			if(!bdev_cache_sync_range(page, count, FALSE))
+				return FALSE;
+
+			if(!ftl_read(buffer, (uint64_t)page * BLOCK_SIZE, count * BLOCK_SIZE))
+				return FALSE;
+
+			buffer += count * BLOCK_SIZE;
+			size -= count * BLOCK_SIZE;
+			page += count;
+			continue;
+		}
+
+		BDevCacheEntry* entry = bdev_cache_get(page, TRUE);
+		if(entry == NULL)
+			return FALSE;
+
+		size_t toRead = ((BLOCK_SIZE - pageOffset) > size) ? size : (BLOCK_SIZE - pageOffset);
+		memcpy(buffer, entry->data + pageOffset, toRead);
+		buffer += toRead;
+		size -= toRead;
+		pageOffset = 0;
+		page++;
+	}
+
+	return TRUE;
+}
+
+static int bdev_cache_write(uint64_t offset, size_t size, uint8_t* buffer) {
+	uint32_t page = offset / BLOCK_SIZE;
+	uint32_t pageOffset = offset - ((uint64_t)page * BLOCK_SIZE);
+
+	if(BDevCache == NULL)
+		return ftl_write(buffer, offset, size);
+
+	while(size > 0) {
+		if(pageOffset == 0 && size >= (BDEV_CACHE_BYPASS_PAGES * BLOCK_SIZE)) {
+			uint32_t count = size / BLOCK_SIZE;
+			BDevCacheBypasses++;
+
+			// every page in this range is being replaced, so just forget about them
+			bdev_cache_sync_range(page, count, TRUE);
+
+			if(!ftl_write(buffer, (uint64_t)page * BLOCK_SIZE, count * BLOCK_SIZE))
+				return FALSE;
+
+			buffer += count * BLOCK_SIZE;
+			size -= count * BLOCK_SIZE;
+			page += count;
+			continue;
+		}
+
+		size_t toWrite = ((BLOCK_SIZE - pageOffset) > size) ? size : (BLOCK_SIZE - pageOffset);
+
+		BDevCacheEntry* entry = bdev_cache_get(page, toWrite != BLOCK_SIZE);
+		if(entry == NULL)
+			return FALSE;
+
+		memcpy(entry->data + pageOffset, buffer, toWrite);
+		entry->dirty = TRUE;
+		buffer += toWrite;
+		size -= toWrite;
+		pageOffset = 0;
+		page++;
+	}
+
+	return TRUE;
+}
+
+// The whole disk, MBR included, through the same cache as the partitions.
+int bdev_read(uint64_t offset, size_t size, void* buffer) {
+	return bdev_cache_read(offset, size, buffer);
+}
+
+int bdev_write(uint64_t offset, size_t size, void* buffer) {
+	return bdev_cache_write(offset, size, buffer);
+}
+
+int bdev_flush() {
+	int i;
+
+	if(BDevCache == NULL)
+		return TRUE;
+
+	// go through the dirty pages in ascending order so the FTL sees one sweep
+	while(TRUE) {
+		BDevCacheEntry* lowest = NULL;
+		for(i = 0; i < BDEV_CACHE_PAGES; i++) {
+			BDevCacheEntry* entry = &BDevCache[i];
+			if(entry->valid && entry->dirty && (lowest == NULL || entry->page < lowest->page))
+				lowest = entry;
+		}
+
+		if(lowest == NULL)
+			return TRUE;
+
+		if(!bdev_cache_writeback(lowest))
+			return FALSE;
+	}
+}
+
+void bdev_print_cache_stats() {
+	int i;
+	int used = 0;
+	int dirty = 0;
+
+	if(BDevCache == NULL) {
+		bufferPrintf("bdev: page cache is not enabled\r\n");
+		return;
+	}
+
+	for(i = 0; i < BDEV_CACHE_PAGES; i++) {
+		if(!BDevCache[i].valid)
+			continue;
+
+		used++;
+		if(BDevCache[i].dirty)
+			dirty++;
+	}
+
+	bufferPrintf("bdev cache: %d pages of %d bytes, %d in use, %d dirty\r\n", BDEV_CACHE_PAGES, BLOCK_SIZE, used, dirty);
+	bufferPrintf("hits: %u, misses: %u, writebacks: %u in %u runs, bypassed requests: %u\r\n", BDevCacheHits, BDevCacheMisses,
+			BDevCacheWritebacks, BDevCacheWritebackRuns, BDevCacheBypasses);
+}
+
 int bdev_setup() {
 	if(HasBDevInit)
 		return 0;
@@ -21,6 +349,8 @@ int bdev_setup() {
 	BLOCK_SIZE = Data->bytesPerPage;
 
 	ftl_read(&MBRData, 0, sizeof(MBRData));
+	bdev_cache_setup();
+
 	MBRPartitionRecord* record = MBRData.partitions;
 
 	int id = 0;
@@ -38,19 +368,225 @@ int bdev_setup() {
 int bdevRead(io_func* io, off_t location, size_t size, void *buffer) {
 	MBRPartitionRecord* record = (MBRPartitionRecord*) io->data;
 	//bufferPrintf("bdev: attempt to read %d sectors from partition %d, sector %Ld to 0x%x\r\n", size, ((uint32_t)record - (uint32_t)MBRData.partitions)/sizeof(MBRPartitionRecord), location, buffer);
-	return ftl_read(buffer, location + record->beginLBA * BLOCK_SIZE, size);
+	uint64_t offset = location + record->beginLBA * BLOCK_SIZE;
+	uint64_t start = latency_start();
+	int ret = bdev_cache_read(offset, size, buffer);
+	latency_record(LatencyBDevRead, offset / 512, size / 512, start);
+	return ret;
 }
 
 static int bdevWrite(io_func* io, off_t location, size_t size, void *buffer) {
 	MBRPartitionRecord* record = (MBRPartitionRecord*) io->data;
 	//bufferPrintf("bdev: attempt to write %d sectors to partition %d, sector %d!\r\n", size, ((uint32_t)record - (uint32_t)MBRData.partitions)/sizeof(MBRPartitionRecord), location);
-	return ftl_write(buffer, location + record->beginLBA * BLOCK_SIZE, size);
+	uint64_t offset = location + record->beginLBA * BLOCK_SIZE;
+	uint64_t start = latency_start();
+	int ret = bdev_cache_write(offset, size, buffer);
+	latency_record(LatencyBDevWrite, offset / 512, size / 512, start);
+	return ret;
+}
+
+// Only the whole pages inside the range are dropped, the ones at either end
+// may still hold something else.
+static int bdevDiscard(io_func* io, off_t location, size_t size) {
+	MBRPartitionRecord* record = (MBRPartitionRecord*) io->data;
+	uint64_t offset = location + record->beginLBA * BLOCK_SIZE;
+	uint32_t first = (offset + BLOCK_SIZE - 1) / BLOCK_SIZE;
+	uint32_t end = (offset + size) / BLOCK_SIZE;
+
+	if(end <= first)
+		return TRUE;
+
+	if(BDevCache != NULL)
+		bdev_cache_sync_range(first, end - first, TRUE);
+
+	return ftl_discard(first, end - first);
 }
 
 static void bdevClose(io_func* io) {
 	free(io);
 }
 
+static void bdev_crypt_iv(uint32_t page, uint32_t* iv) {
+	iv[0] = page;
+	iv[1] = 0;
+	iv[2] = 0;
+	iv[3] = 0;
+}
+
+// Starts pages [page, page + count) of data through session, each on its own
+// IV. The last one is left running, so aes_wait() before touching data.
+static void bdev_crypt_pages(AESSession* session, uint8_t* data, uint32_t page, uint32_t count) {
+	uint32_t iv[4];
+	uint32_t i;
+
+	for(i = 0; i < count; i++) {
+		bdev_crypt_iv(page + i, iv);
+		aes_session_set_iv(session, iv);
+		aes_session_process_async(session, data + (i * BLOCK_SIZE), BLOCK_SIZE);
+	}
+}
+
+static int bdevCryptRead(io_func* io, off_t location, size_t size, void *buffer) {
+	BDevCryptFile* file = (BDevCryptFile*) io->data;
+	uint8_t* cursor = (uint8_t*) buffer;
+	uint32_t page = location / BLOCK_SIZE;
+	uint32_t pageOffset = location - ((uint64_t)page * BLOCK_SIZE);
+	AESSession session;
+	int ret = TRUE;
+
+	aes_session_open(&session, FALSE, file->crypt->keyType, file->crypt->key, NULL);
+
+	while(size > 0) {
+		if(pageOffset == 0 && size >= BLOCK_SIZE) {
+			// whole pages are decrypted where they land in the caller's buffer
+			uint32_t count = size / BLOCK_SIZE;
+			if(count > BDEV_CRYPT_CHUNK_PAGES)
+				count = BDEV_CRYPT_CHUNK_PAGES;
+
+			if(!READ(file->raw, (off_t)page * BLOCK_SIZE, count * BLOCK_SIZE, cursor)) {
+				ret = FALSE;
+				break;
+			}
+
+			bdev_crypt_pages(&session, cursor, page, count);
+			cursor += count * BLOCK_SIZE;
+			size -= count * BLOCK_SIZE;
+			page += count;
+			continue;
+		}
+
+		size_t toRead = ((BLOCK_SIZE - pageOffset) > size) ? size : (BLOCK_SIZE - pageOffset);
+		if(!READ(file->raw, (off_t)page * BLOCK_SIZE, BLOCK_SIZE, file->staging)) {
+			ret = FALSE;
+			break;
+		}
+
+		bdev_crypt_pages(&session, file->staging, page, 1);
+		aes_wait();
+		memcpy(cursor, file->staging + pageOffset, toRead);
+		cursor += toRead;
+		size -= toRead;
+		pageOffset = 0;
+		page++;
+	}
+
+	aes_session_close(&session);
+	return ret;
+}
+
+static int bdevCryptWrite(io_func* io, off_t location, size_t size, void *buffer) {
+	BDevCryptFile* file = (BDevCryptFile*) io->data;
+	uint8_t* cursor = (uint8_t*) buffer;
+	uint32_t page = location / BLOCK_SIZE;
+	uint32_t pageOffset = location - ((uint64_t)page * BLOCK_SIZE);
+	AESSession session;
+	uint32_t iv[4];
+	int ret = TRUE;
+
+	aes_session_open(&session, TRUE, file->crypt->keyType, file->crypt->key, NULL);
+
+	while(size > 0) {
+		uint32_t count;
+
+		// the caller's buffer is left alone, everything is encrypted in staging
+		if(pageOffset == 0 && size >= BLOCK_SIZE) {
+			count = size / BLOCK_SIZE;
+			if(count > BDEV_CRYPT_CHUNK_PAGES)
+				count = BDEV_CRYPT_CHUNK_PAGES;
+
+			memcpy(file->staging, cursor, count * BLOCK_SIZE);
+			cursor += count * BLOCK_SIZE;
+			size -= count * BLOCK_SIZE;
+		} else {
+			// part of a page, so the rest of it has to be read back first
+			size_t toWrite = ((BLOCK_SIZE - pageOffset) > size) ? size : (BLOCK_SIZE - pageOffset);
+			count = 1;
+
+			if(!READ(file->raw, (off_t)page * BLOCK_SIZE, BLOCK_SIZE, file->staging)) {
+				ret = FALSE;
+				break;
+			}
+
+			bdev_crypt_iv(page, iv);
+			aes_decrypt(file->staging, BLOCK_SIZE, file->crypt->keyType, file->crypt->key, iv);
+			memcpy(file->staging + pageOffset, cursor, toWrite);
+			cursor += toWrite;
+			size -= toWrite;
+			pageOffset = 0;
+		}
+
+		bdev_crypt_pages(&session, file->staging, page, count);
+		aes_wait();
+
+		if(!WRITE(file->raw, (off_t)page * BLOCK_SIZE, count * BLOCK_SIZE, file->staging)) {
+			ret = FALSE;
+			break;
+		}
+
+		page += count;
+	}
+
+	aes_session_close(&session);
+	return ret;
+}
+
+static int bdevCryptDiscard(io_func* io, off_t location, size_t size) {
+	BDevCryptFile* file = (BDevCryptFile*) io->data;
+	return (*file->raw->discard)(file->raw, location, size);
+}
+
+static void bdevCryptClose(io_func* io) {
+	BDevCryptFile* file = (BDevCryptFile*) io->data;
+	CLOSE(file->raw);
+	free(file->staging);
+	free(file);
+	free(io);
+}
+
+static io_func* bdev_crypt_open(io_func* raw, BDevCrypt* crypt) {
+	io_func* io = (io_func*) malloc(sizeof(io_func));
+	BDevCryptFile* file = (BDevCryptFile*) malloc(sizeof(BDevCryptFile));
+	uint8_t* staging = (uint8_t*) malloc_dma(BDEV_CRYPT_CHUNK_PAGES * BLOCK_SIZE);
+
+	if(io == NULL || file == NULL || staging == NULL) {
+		bufferPrintf("bdev: out of memory for an encrypted partition\r\n");
+		if(io)
+			free(io);
+		if(file)
+			free(file);
+		if(staging)
+			free(staging);
+		CLOSE(raw);
+		return NULL;
+	}
+
+	file->raw = raw;
+	file->crypt = crypt;
+	file->staging = staging;
+
+	io->data = file;
+	io->read = &bdevCryptRead;
+	io->write = &bdevCryptWrite;
+	io->close = &bdevCryptClose;
+	io->discard = &bdevCryptDiscard;
+
+	return io;
+}
+
+void bdev_set_key(int partition, AESKeyType keyType, const void* key) {
+	BDevCrypts[partition].keyType = keyType;
+	if(keyType == AESCustom)
+		memcpy(BDevCrypts[partition].key, key, sizeof(BDevCrypts[partition].key));
+	else
+		memset(BDevCrypts[partition].key, 0, sizeof(BDevCrypts[partition].key));
+
+	BDevCrypts[partition].enabled = TRUE;
+}
+
+void bdev_clear_key(int partition) {
+	memset(&BDevCrypts[partition], 0, sizeof(BDevCrypt));
+}
+
 unsigned int bdev_get_start(int partition)
 {
 	return MBRData.partitions[partition].beginLBA;
@@ -67,6 +603,10 @@ io_func* bdev_open(int partition) {
 	io->read = &bdevRead;
 	io->write = &bdevWrite;
 	io->close = &bdevClose;
+	io->discard = &bdevDiscard;
+
+	if(BDevCrypts[partition].enabled)
+		return bdev_crypt_open(io, &BDevCrypts[partition]);
 
 	return io;
 }
@@ -1,11 +1,260 @@
 #include "hfs/hfsplus.h"
 
+// Every record access in here (and the key/data callbacks it hands tree->cache to)
+// turns into a small READ somewhere inside a node, so whole nodes are cached per
+// tree. Writes go straight through to the tree file and patch any cached copy,
+// unless the volume has a transaction open: then they only dirty the cached node,
+// and the dirty nodes go out in node order when the cache is flushed.
+#ifndef BTREE_CACHE_NODES
+#define BTREE_CACHE_NODES 16
+#endif
+
+typedef struct BTNodeCacheEntry {
+	uint32_t node;
+	uint32_t lastUsed;
+	int valid;
+	int dirty;
+	uint8_t* data;
+} BTNodeCacheEntry;
+
+typedef struct BTNodeCache {
+	io_func* backing;
+	uint32_t nodeSize;
+	uint32_t clock;
+	int writeBack;
+	BTNodeCacheEntry entries[BTREE_CACHE_NODES];
+} BTNodeCache;
+
+// Lowest node first, so the tree file is written front to back
+static int flushNodeCache(BTNodeCache* cache) {
+	while(TRUE) {
+		BTNodeCacheEntry* first = NULL;
+		int i;
+
+		for(i = 0; i < BTREE_CACHE_NODES; i++) {
+			BTNodeCacheEntry* entry = &cache->entries[i];
+			if(entry->valid && entry->dirty && (first == NULL || entry->node < first->node))
+				first = entry;
+		}
+
+		if(first == NULL)
+			return TRUE;
+
+		if(!WRITE(cache->backing, (off_t)first->node * cache->nodeSize, cache->nodeSize, first->data))
+			return FALSE;
+
+		first->dirty = FALSE;
+	}
+}
+
+static BTNodeCacheEntry* getCachedNode(BTNodeCache* cache, uint32_t node) {
+	BTNodeCacheEntry* victim = NULL;
+	int i;
+
+	for(i = 0; i < BTREE_CACHE_NODES; i++) {
+		BTNodeCacheEntry* entry = &cache->entries[i];
+		if(entry->valid && entry->node == node) {
+			entry->lastUsed = ++cache->clock;
+			return entry;
+		}
+
+		// clean nodes are given up before dirty ones
+		if(victim == NULL || !entry->valid
+				|| (victim->valid && victim->dirty && !entry->dirty)
+				|| (victim->valid && victim->dirty == entry->dirty && entry->lastUsed < victim->lastUsed))
+			victim = entry;
+	}
+
+	// every node is dirty, so write them all out in one sorted pass
+	if(victim->valid && victim->dirty && !flushNodeCache(cache))
+		return NULL;
+
+	victim->valid = FALSE;
+	if(!READ(cache->backing, (off_t)node * cache->nodeSize, cache->nodeSize, victim->data))
+		return NULL;
+
+	victim->node = node;
+	victim->valid = TRUE;
+	victim->lastUsed = ++cache->clock;
+
+	return victim;
+}
+
+static int cacheRead(io_func* io, off_t location, size_t size, void *buffer) {
+	BTNodeCache* cache = (BTNodeCache*) io->data;
+	uint8_t* curLoc = (uint8_t*) buffer;
+
+	while(size > 0) {
+		uint32_t node = location / cache->nodeSize;
+		uint32_t offset = location - ((off_t)node * cache->nodeSize);
+		size_t toRead = ((cache->nodeSize - offset) > size) ? size : (cache->nodeSize - offset);
+
+		BTNodeCacheEntry* entry = getCachedNode(cache, node);
+		if(entry != NULL) {
+			memcpy(curLoc, entry->data + offset, toRead);
+		} else if(!READ(cache->backing, location, toRead, curLoc)) {
+			return FALSE;
+		}
+
+		curLoc += toRead;
+		location += toRead;
+		size -= toRead;
+	}
+
+	return TRUE;
+}
+
+static int cacheWriteBack(BTNodeCache* cache, off_t location, size_t size, uint8_t* buffer) {
+	while(size > 0) {
+		uint32_t node = location / cache->nodeSize;
+		uint32_t offset = location - ((off_t)node * cache->nodeSize);
+		size_t toWrite = ((cache->nodeSize - offset) > size) ? size : (cache->nodeSize - offset);
+
+		// a node past the end of the tree file cannot be loaded, and writing it
+		// is what grows the file
+		BTNodeCacheEntry* entry = getCachedNode(cache, node);
+		if(entry != NULL) {
+			memcpy(entry->data + offset, buffer, toWrite);
+			entry->dirty = TRUE;
+		} else if(!WRITE(cache->backing, location, toWrite, buffer)) {
+			return FALSE;
+		}
+
+		buffer += toWrite;
+		location += toWrite;
+		size -= toWrite;
+	}
+
+	return TRUE;
+}
+
+static int cacheWrite(io_func* io, off_t location, size_t size, void *buffer) {
+	BTNodeCache* cache = (BTNodeCache*) io->data;
+	int i;
+
+	if(cache->writeBack)
+		return cacheWriteBack(cache, location, size, (uint8_t*) buffer);
+
+	if(!WRITE(cache->backing, location, size, buffer))
+		return FALSE;
+
+	for(i = 0; i < BTREE_CACHE_NODES; i++) {
+		BTNodeCacheEntry* entry = &cache->entries[i];
+		off_t nodeStart = (off_t)entry->node * cache->nodeSize;
+		off_t start;
+		off_t end;
+
+		if(!entry->valid || (location + size) <= nodeStart || location >= (nodeStart + cache->nodeSize))
+			continue;
+
+		start = (location > nodeStart) ? location : nodeStart;
+		end = ((location + size) < (nodeStart + cache->nodeSize)) ? (location + size) : (nodeStart + cache->nodeSize);
+		memcpy(entry->data + (start - nodeStart), (uint8_t*)buffer + (start - location), end - start);
+	}
+
+	return TRUE;
+}
+
+static void cacheClose(io_func* io) {
+	BTNodeCache* cache = (BTNodeCache*) io->data;
+	int i;
+
+	if(!flushNodeCache(cache))
+		bufferPrintf("btree: could not write back the node cache\r\n");
+
+	for(i = 0; i < BTREE_CACHE_NODES; i++)
+		free(cache->entries[i].data);
+
+	CLOSE(cache->backing);
+	free(cache);
+	free(io);
+}
+
+static io_func* openNodeCache(io_func* backing, uint32_t nodeSize) {
+	io_func* io;
+	BTNodeCache* cache;
+	int i;
+
+	io = (io_func*) malloc(sizeof(io_func));
+	cache = (BTNodeCache*) malloc(sizeof(BTNodeCache));
+	if(io == NULL || cache == NULL) {
+		free(io);
+		free(cache);
+		return backing;
+	}
+
+	cache->backing = backing;
+	cache->nodeSize = nodeSize;
+	cache->clock = 0;
+	cache->writeBack = FALSE;
+
+	for(i = 0; i < BTREE_CACHE_NODES; i++) {
+		cache->entries[i].valid = FALSE;
+		cache->entries[i].dirty = FALSE;
+		cache->entries[i].data = (uint8_t*) malloc(nodeSize);
+		if(cache->entries[i].data == NULL) {
+			while(--i >= 0)
+				free(cache->entries[i].data);
+
+			free(cache);
+			free(io);
+			return backing;
+		}
+	}
+
+	io->data = cache;
+	io->read = &cacheRead;
+	io->write = &cacheWrite;
+	io->close = &cacheClose;
+	io->discard = NULL;
+
+	return io;
+}
+
+// Drop every cached node. The writers keep the cache coherent on their own, but a
+// finished insert or delete is a cheap point to start from a clean slate. Dirty
+// nodes are the only copy of what was written, so they stay.
+static void invalidateNodeCache(BTree* tree) {
+	BTNodeCache* cache;
+	int i;
+
+	if(tree->cache == tree->io)
+		return;
+
+	cache = (BTNodeCache*) tree->cache->data;
+	for(i = 0; i < BTREE_CACHE_NODES; i++) {
+		if(!cache->entries[i].dirty)
+			cache->entries[i].valid = FALSE;
+	}
+}
+
+// With writeBack set, writes to the tree stay in the node cache until flushBTree,
+// or until the cache is full of them. Turning it off flushes.
+int setBTreeWriteBack(BTree* tree, int writeBack) {
+	BTNodeCache* cache;
+
+	if(tree->cache == tree->io)
+		return TRUE;
+
+	cache = (BTNodeCache*) tree->cache->data;
+	cache->writeBack = writeBack;
+
+	return writeBack ? TRUE : flushNodeCache(cache);
+}
+
+int flushBTree(BTree* tree) {
+	if(tree->cache == tree->io)
+		return TRUE;
+
+	return flushNodeCache((BTNodeCache*) tree->cache->data);
+}
+
 BTNodeDescriptor* readBTNodeDescriptor(uint32_t num, BTree* tree) {
 	BTNodeDescriptor* descriptor;
 
 	descriptor = (BTNodeDescriptor*) malloc(sizeof(BTNodeDescriptor));
 
-	if(!READ(tree->io, num * tree->headerRec->nodeSize, sizeof(BTNodeDescriptor), descriptor))
+	if(!READ(tree->cache, num * tree->headerRec->nodeSize, sizeof(BTNodeDescriptor), descriptor))
 		return NULL;
 
 	FLIPENDIAN(descriptor->fLink);
@@ -24,7 +273,7 @@ static int writeBTNodeDescriptor(BTNodeDescriptor* descriptor, uint32_t num, BTr
 	FLIPENDIAN(myDescriptor.bLink);
 	FLIPENDIAN(myDescriptor.numRecords);
 
-	if(!WRITE(tree->io, num * tree->headerRec->nodeSize, sizeof(BTNodeDescriptor), &myDescriptor))
+	if(!WRITE(tree->cache, num * tree->headerRec->nodeSize, sizeof(BTNodeDescriptor), &myDescriptor))
 		return FALSE;
 
 	return TRUE;
@@ -84,7 +333,7 @@ static int writeBTHeaderRec(BTree* tree) {
 	FLIPENDIAN(headerRec.clumpSize);
 	FLIPENDIAN(headerRec.attributes);
 
-	if(!WRITE(tree->io, sizeof(BTNodeDescriptor), sizeof(BTHeaderRec), &headerRec))
+	if(!WRITE(tree->cache, sizeof(BTNodeDescriptor), sizeof(BTHeaderRec), &headerRec))
 		return FALSE;
 
 	return TRUE;
@@ -103,6 +352,8 @@ BTree* openBTree(io_func* io, compareFunc compare, dataReadFunc keyRead, keyWrit
 		return NULL;
 	}
 
+	tree->cache = openNodeCache(tree->io, tree->headerRec->nodeSize);
+
 	tree->compare = compare;
 	tree->keyRead = keyRead;
 	tree->keyWrite = keyWrite;
@@ -113,7 +364,7 @@ BTree* openBTree(io_func* io, compareFunc compare, dataReadFunc keyRead, keyWrit
 }
 
 void closeBTree(BTree* tree) {
-	(*tree->io->close)(tree->io);
+	(*tree->cache->close)(tree->cache);
 	free(tree->headerRec);
 	free(tree);
 }
@@ -124,7 +375,7 @@ off_t getRecordOffset(int num, uint32_t nodeNum, BTree* tree) {
 
 	nodeOffset = nodeNum * tree->headerRec->nodeSize;
 
-	if(!READ(tree->io, nodeOffset + tree->headerRec->nodeSize - (sizeof(uint16_t) * (num + 1)), sizeof(uint16_t), &offset)) {
+	if(!READ(tree->cache, nodeOffset + tree->headerRec->nodeSize - (sizeof(uint16_t) * (num + 1)), sizeof(uint16_t), &offset)) {
 		hfs_panic("cannot get record offset!");
 	}
 
@@ -135,6 +386,103 @@ off_t getRecordOffset(int num, uint32_t nodeNum, BTree* tree) {
 	return (nodeOffset + offset);
 }
 
+// Reads within the cursor's leaf come from its copy, anything else from the tree.
+static int leafCursorRead(io_func* io, off_t location, size_t size, void *buffer) {
+	BTLeafCursor* cursor = (BTLeafCursor*) io->data;
+	off_t nodeOffset = (off_t)cursor->nodeNumber * cursor->tree->headerRec->nodeSize;
+
+	if(location >= nodeOffset && (location + size) <= (nodeOffset + cursor->tree->headerRec->nodeSize)) {
+		memcpy(buffer, cursor->node + (location - nodeOffset), size);
+		return TRUE;
+	}
+
+	return READ(cursor->tree->cache, location, size, buffer);
+}
+
+static int leafCursorLoad(BTLeafCursor* cursor, uint32_t nodeNumber) {
+	BTNodeDescriptor descriptor;
+
+	cursor->nodeNumber = 0;
+	if(!READ(cursor->tree->cache, (off_t)nodeNumber * cursor->tree->headerRec->nodeSize, cursor->tree->headerRec->nodeSize, cursor->node))
+		return FALSE;
+
+	memcpy(&descriptor, cursor->node, sizeof(descriptor));
+	FLIPENDIAN(descriptor.numRecords);
+
+	cursor->nodeNumber = nodeNumber;
+	cursor->numRecords = descriptor.numRecords;
+	cursor->recordNumber = 0;
+	return TRUE;
+}
+
+int openLeafCursor(BTree* tree, BTKey* searchKey, BTLeafCursor* cursor) {
+	uint32_t nodeNumber;
+	int recordNumber;
+	void* record;
+
+	cursor->tree = tree;
+	cursor->nodeNumber = 0;
+	cursor->node = (uint8_t*) malloc(tree->headerRec->nodeSize);
+	cursor->nodeIO.data = cursor;
+	cursor->nodeIO.read = &leafCursorRead;
+	cursor->nodeIO.write = NULL;
+	cursor->nodeIO.close = NULL;
+	cursor->nodeIO.discard = NULL;
+
+	if(cursor->node == NULL)
+		return FALSE;
+
+	record = search(tree, searchKey, NULL, &nodeNumber, &recordNumber);
+	if(record == NULL)
+		return FALSE;
+
+	free(record);
+
+	if(!leafCursorLoad(cursor, nodeNumber))
+		return FALSE;
+
+	cursor->recordNumber = recordNumber;
+	return TRUE;
+}
+
+// The next record in key order, or FALSE past the last one. The key and
+// data are the caller's to free.
+int leafCursorNext(BTLeafCursor* cursor, BTKey** key, void** data) {
+	uint32_t nodeSize = cursor->tree->headerRec->nodeSize;
+	BTNodeDescriptor descriptor;
+	uint16_t recordOffset;
+	off_t offset;
+
+	while(cursor->nodeNumber != 0) {
+		if(cursor->recordNumber < cursor->numRecords) {
+			memcpy(&recordOffset, cursor->node + nodeSize - (sizeof(uint16_t) * (cursor->recordNumber + 1)), sizeof(uint16_t));
+			FLIPENDIAN(recordOffset);
+			cursor->recordNumber++;
+
+			offset = ((off_t)cursor->nodeNumber * nodeSize) + recordOffset;
+			*key = READ_KEY(cursor->tree, offset, &cursor->nodeIO);
+			if(*key == NULL)
+				return FALSE;
+
+			*data = READ_DATA(cursor->tree, offset + (*key)->keyLength + sizeof((*key)->keyLength), &cursor->nodeIO);
+			return TRUE;
+		}
+
+		memcpy(&descriptor, cursor->node, sizeof(descriptor));
+		FLIPENDIAN(descriptor.fLink);
+		if(descriptor.fLink == 0 || !leafCursorLoad(cursor, descriptor.fLink))
+			cursor->nodeNumber = 0;
+	}
+
+	return FALSE;
+}
+
+void closeLeafCursor(BTLeafCursor* cursor) {
+	free(cursor->node);
+	cursor->node = NULL;
+	cursor->nodeNumber = 0;
+}
+
 static off_t getFreeSpace(uint32_t nodeNum, BTNodeDescriptor* descriptor, BTree* tree) {
 	uint16_t num;
 	off_t nodeOffset;
@@ -147,7 +495,7 @@ static off_t getFreeSpace(uint32_t nodeNum, BTNodeDescriptor* descriptor, BTree*
 	nodeOffset = nodeNum * tree->headerRec->nodeSize;
 	freespaceOffsetOffset = nodeOffset + tree->headerRec->nodeSize - (sizeof(uint16_t) * (num + 1));
 
-	if(!READ(tree->io, freespaceOffsetOffset, sizeof(uint16_t), &offset)) {
+	if(!READ(tree->cache, freespaceOffsetOffset, sizeof(uint16_t), &offset)) {
 		hfs_panic("cannot get record offset!");
 	}
 
@@ -189,7 +537,7 @@ static void* searchNode(BTree* tree, uint32_t root, BTKey* searchKey, int *exact
 
 	for(i = 0; i < descriptor->numRecords; i++) {
 		recordOffset = getRecordOffset(i, root, tree);
-		key = READ_KEY(tree, recordOffset, tree->io);
+		key = READ_KEY(tree, recordOffset, tree->cache);
 		recordDataOffset = recordOffset + key->keyLength + sizeof(key->keyLength);
 
 		res = COMPARE(tree, key, searchKey);
@@ -207,11 +555,11 @@ static void* searchNode(BTree* tree, uint32_t root, BTKey* searchKey, int *exact
 
 				free(descriptor);
 
-				return READ_DATA(tree, recordDataOffset, tree->io);
+				return READ_DATA(tree, recordDataOffset, tree->cache);
 			} else {
 
 				free(descriptor);
-				return searchNode(tree, getNodeNumberFromPointerRecord(recordDataOffset, tree->io), searchKey, exact, nodeNumber, recordNumber);
+				return searchNode(tree, getNodeNumberFromPointerRecord(recordDataOffset, tree->cache), searchKey, exact, nodeNumber, recordNumber);
 			}
 		} else if(res > 0) {
 			break;
@@ -236,11 +584,11 @@ static void* searchNode(BTree* tree, uint32_t root, BTKey* searchKey, int *exact
 			*exact = FALSE;
 
 		free(descriptor);
-		return READ_DATA(tree, lastRecordDataOffset, tree->io);
+		return READ_DATA(tree, lastRecordDataOffset, tree->cache);
 	} else {
 
 		free(descriptor);
-		return searchNode(tree, getNodeNumberFromPointerRecord(lastRecordDataOffset, tree->io), searchKey, exact, nodeNumber, recordNumber);
+		return searchNode(tree, getNodeNumberFromPointerRecord(lastRecordDataOffset, tree->cache), searchKey, exact, nodeNumber, recordNumber);
 	}      
 }
 
@@ -267,14 +615,14 @@ static uint32_t findFree(BTree* tree) {
 
 	while(TRUE) {
 		while(byteNumber < mapRecordLength) {
-			READ(tree->io, mapRecordStart + byteNumber, 1, &byte);
+			READ(tree->cache, mapRecordStart + byteNumber, 1, &byte);
 			if(byte != 0xFF) {
 				for(i = 0; i < 8; i++) {
 					if((byte & (1 << (7 - i))) == 0) {
 						byte |= (1 << (7 - i));
 						tree->headerRec->freeNodes--;
 						ASSERT(writeBTHeaderRec(tree), "writeBTHeaderRec");
-						ASSERT(WRITE(tree->io, mapRecordStart + byteNumber, 1, &byte), "WRITE");
+						ASSERT(WRITE(tree->cache, mapRecordStart + byteNumber, 1, &byte), "WRITE");
 						return ((byteNumber * 8) + i);
 					}
 				}
@@ -320,9 +668,9 @@ static int markUsed(uint32_t node, BTree* tree) {
 		}
 	}
 
-	ASSERT(READ(tree->io, mapNode * tree->headerRec->nodeSize + 14 + byteNumber, 1, &byte), "READ");
+	ASSERT(READ(tree->cache, mapNode * tree->headerRec->nodeSize + 14 + byteNumber, 1, &byte), "READ");
 	byte |= (1 << (7 - (node % 8)));
-	ASSERT(WRITE(tree->io, mapNode * tree->headerRec->nodeSize + 14 + byteNumber, 1, &byte), "WRITE");
+	ASSERT(WRITE(tree->cache, mapNode * tree->headerRec->nodeSize + 14 + byteNumber, 1, &byte), "WRITE");
 
 	return TRUE;
 }
@@ -381,13 +729,13 @@ static int growBTree(BTree* tree) {
 
 				newNodeOffset = descriptor->fLink * tree->headerRec->nodeSize;
 
-				ASSERT(WRITE(tree->io, newNodeOffset + 14, tree->headerRec->nodeSize - 20, buffer), "WRITE");
+				ASSERT(WRITE(tree->cache, newNodeOffset + 14, tree->headerRec->nodeSize - 20, buffer), "WRITE");
 				offset = 14;
 				FLIPENDIAN(offset);
-				ASSERT(WRITE(tree->io, newNodeOffset + tree->headerRec->nodeSize - 2, sizeof(offset), &offset), "WRITE");
+				ASSERT(WRITE(tree->cache, newNodeOffset + tree->headerRec->nodeSize - 2, sizeof(offset), &offset), "WRITE");
 				offset = 14 + tree->headerRec->nodeSize - 20;
 				FLIPENDIAN(offset);
-				ASSERT(WRITE(tree->io, newNodeOffset + tree->headerRec->nodeSize - 4, sizeof(offset), &offset), "WRITE");
+				ASSERT(WRITE(tree->cache, newNodeOffset + tree->headerRec->nodeSize - 4, sizeof(offset), &offset), "WRITE");
 
 				// mark the map node as being used
 				ASSERT(markUsed(newNodesStart, tree), "markUsed");
@@ -445,7 +793,7 @@ static uint32_t removeNode(BTree* tree, uint32_t node) {
 		node -= mapRecordLength * 8;
 	}
 
-	READ(tree->io, mapRecordStart + (node / 8), 1, &byte);
+	READ(tree->cache, mapRecordStart + (node / 8), 1, &byte);
 
 	byte &= ~(1 << (7 - (node % 8)));
 
@@ -481,7 +829,7 @@ static uint32_t removeNode(BTree* tree, uint32_t node) {
 
 	free(descriptor);
 
-	ASSERT(WRITE(tree->io, mapRecordStart + (node / 8), 1, &byte), "WRITE");
+	ASSERT(WRITE(tree->cache, mapRecordStart + (node / 8), 1, &byte), "WRITE");
 	ASSERT(writeBTHeaderRec(tree), "writeBTHeaderRec");
 
 	return TRUE;
@@ -512,12 +860,12 @@ static uint32_t splitNode(uint32_t node, BTNodeDescriptor* descriptor, BTree* tr
 	toMove = getRecordOffset(descriptor->numRecords/2, node, tree);
 	toMoveLength = getRecordOffset(descriptor->numRecords, node, tree) - toMove;
 	buffer = (unsigned char *)malloc(toMoveLength);
-	ASSERT(READ(tree->io, toMove, toMoveLength, buffer), "READ");
+	ASSERT(READ(tree->cache, toMove, toMoveLength, buffer), "READ");
 
 	offsetsToMove = (node * tree->headerRec->nodeSize) + tree->headerRec->nodeSize - (sizeof(uint16_t) * (descriptor->numRecords + 1));
 	offsetsToMoveLength = sizeof(uint16_t) * (nodesToMove + 1);
 	offsetsBuffer = (uint16_t *)malloc(offsetsToMoveLength);
-	ASSERT(READ(tree->io, offsetsToMove, offsetsToMoveLength, offsetsBuffer), "READ");
+	ASSERT(READ(tree->cache, offsetsToMove, offsetsToMoveLength, offsetsBuffer), "READ");
 
 	for(i = 0; i < (nodesToMove + 1); i++) {
 		FLIPENDIAN(offsetsBuffer[i]);
@@ -552,8 +900,8 @@ static uint32_t splitNode(uint32_t node, BTNodeDescriptor* descriptor, BTree* tr
 	descriptor->numRecords = descriptor->numRecords/2;
 	ASSERT(writeBTNodeDescriptor(descriptor, node, tree), "writeBTNodeDescriptor");
 
-	ASSERT(WRITE(tree->io, newNodeOffset + 14, toMoveLength, buffer), "WRITE");
-	ASSERT(WRITE(tree->io, newNodeOffset + tree->headerRec->nodeSize - (sizeof(uint16_t) * (nodesToMove + 1)), offsetsToMoveLength, offsetsBuffer), "WRITE");
+	ASSERT(WRITE(tree->cache, newNodeOffset + 14, toMoveLength, buffer), "WRITE");
+	ASSERT(WRITE(tree->cache, newNodeOffset + tree->headerRec->nodeSize - (sizeof(uint16_t) * (nodesToMove + 1)), offsetsToMoveLength, offsetsBuffer), "WRITE");
 
 	// The offset for the existing descriptor's new numRecords will happen to be where the old data was, which is now where the free space starts
 	// So we don't have to manually set the free space offset
@@ -585,12 +933,12 @@ static int moveRecordsDown(BTree* tree, BTNodeDescriptor* descriptor, int record
 
 	records = (unsigned char*)malloc(lastRecordEnd - firstRecordStart);
 
-	ASSERT(READ(tree->io, firstRecordStart, lastRecordEnd - firstRecordStart, records), "READ");
+	ASSERT(READ(tree->cache, firstRecordStart, lastRecordEnd - firstRecordStart, records), "READ");
 	firstOffsetStart = (node * tree->headerRec->nodeSize) + tree->headerRec->nodeSize - (sizeof(uint16_t) * (descriptor->numRecords + 1));
 	lastOffsetEnd = (node * tree->headerRec->nodeSize) + tree->headerRec->nodeSize - (sizeof(uint16_t) * record);
 
 	offsets = (uint16_t*)malloc(lastOffsetEnd - firstOffsetStart);
-	ASSERT(READ(tree->io, firstOffsetStart, lastOffsetEnd - firstOffsetStart, offsets), "READ");
+	ASSERT(READ(tree->cache, firstOffsetStart, lastOffsetEnd - firstOffsetStart, offsets), "READ");
 
 	for(i = 0; i < (lastOffsetEnd - firstOffsetStart)/sizeof(uint16_t); i++) {
 		FLIPENDIAN(offsets[i]);
@@ -598,14 +946,14 @@ static int moveRecordsDown(BTree* tree, BTNodeDescriptor* descriptor, int record
 		FLIPENDIAN(offsets[i]);
 	}
 
-	ASSERT(WRITE(tree->io, firstRecordStart + length, lastRecordEnd - firstRecordStart, records), "WRITE");
+	ASSERT(WRITE(tree->cache, firstRecordStart + length, lastRecordEnd - firstRecordStart, records), "WRITE");
 
 	if(moveOffsets > 0) {
-		ASSERT(WRITE(tree->io, firstOffsetStart - sizeof(uint16_t), lastOffsetEnd - firstOffsetStart, offsets), "WRITE");
+		ASSERT(WRITE(tree->cache, firstOffsetStart - sizeof(uint16_t), lastOffsetEnd - firstOffsetStart, offsets), "WRITE");
 	} else if(moveOffsets < 0) {
-		ASSERT(WRITE(tree->io, firstOffsetStart + sizeof(uint16_t), lastOffsetEnd - firstOffsetStart, offsets), "WRITE");
+		ASSERT(WRITE(tree->cache, firstOffsetStart + sizeof(uint16_t), lastOffsetEnd - firstOffsetStart, offsets), "WRITE");
 	} else {
-		ASSERT(WRITE(tree->io, firstOffsetStart, lastOffsetEnd - firstOffsetStart, offsets), "WRITE");
+		ASSERT(WRITE(tree->cache, firstOffsetStart, lastOffsetEnd - firstOffsetStart, offsets), "WRITE");
 	}
 
 	free(records);
@@ -635,7 +983,7 @@ static int doAddRecord(BTree* tree, uint32_t root, BTKey* searchKey, size_t leng
 
 	for(i = 0; i < descriptor->numRecords; i++) {
 		recordOffset = getRecordOffset(i, root, tree);
-		key = READ_KEY(tree, recordOffset, tree->io);
+		key = READ_KEY(tree, recordOffset, tree->cache);
 		recordDataOffset = recordOffset + key->keyLength + sizeof(key->keyLength);
 
 		res = COMPARE(tree, key, searchKey);
@@ -661,23 +1009,23 @@ static int doAddRecord(BTree* tree, uint32_t root, BTKey* searchKey, size_t leng
 		moveRecordsDown(tree, descriptor, i, root, sizeof(searchKey->keyLength) + searchKey->keyLength + length, 1);
 
 		// then insert ourself
-		ASSERT(WRITE_KEY(tree, recordOffset, searchKey, tree->io), "WRITE_KEY");
-		ASSERT(WRITE(tree->io, recordOffset + sizeof(searchKey->keyLength) + searchKey->keyLength, length, content), "WRITE");
+		ASSERT(WRITE_KEY(tree, recordOffset, searchKey, tree->cache), "WRITE_KEY");
+		ASSERT(WRITE(tree->cache, recordOffset + sizeof(searchKey->keyLength) + searchKey->keyLength, length, content), "WRITE");
 
 		offset = recordOffset - (root * tree->headerRec->nodeSize);
 		FLIPENDIAN(offset);
-		ASSERT(WRITE(tree->io, (root * tree->headerRec->nodeSize) + tree->headerRec->nodeSize - (sizeof(uint16_t) * (i + 1)),
+		ASSERT(WRITE(tree->cache, (root * tree->headerRec->nodeSize) + tree->headerRec->nodeSize - (sizeof(uint16_t) * (i + 1)),
 					sizeof(uint16_t), &offset), "WRITE");
 	} else {
 		// just insert ourself at the end
 		recordOffset = getRecordOffset(i, root, tree);
-		ASSERT(WRITE_KEY(tree, recordOffset, searchKey, tree->io), "WRITE_KEY");
-		ASSERT(WRITE(tree->io, recordOffset + sizeof(uint16_t) + searchKey->keyLength, length, content), "WRITE");
+		ASSERT(WRITE_KEY(tree, recordOffset, searchKey, tree->cache), "WRITE_KEY");
+		ASSERT(WRITE(tree->cache, recordOffset + sizeof(uint16_t) + searchKey->keyLength, length, content), "WRITE");
 
 		// write the new free offset
 		offset = (recordOffset + sizeof(searchKey->keyLength) + searchKey->keyLength + length) - (root * tree->headerRec->nodeSize);
 		FLIPENDIAN(offset);
-		ASSERT(WRITE(tree->io, (root * tree->headerRec->nodeSize) + tree->headerRec->nodeSize - (sizeof(uint16_t) * (descriptor->numRecords + 2)),
+		ASSERT(WRITE(tree->cache, (root * tree->headerRec->nodeSize) + tree->headerRec->nodeSize - (sizeof(uint16_t) * (descriptor->numRecords + 2)),
 					sizeof(uint16_t), &offset), "WRITE");
 	}
 
@@ -722,7 +1070,7 @@ static int addRecord(BTree* tree, uint32_t root, BTKey* searchKey, size_t length
 
 	for(i = 0; i < descriptor->numRecords; i++) {
 		recordOffset = getRecordOffset(i, root, tree);
-		key = READ_KEY(tree, recordOffset, tree->io);
+		key = READ_KEY(tree, recordOffset, tree->cache);
 		recordDataOffset = recordOffset + key->keyLength + sizeof(key->keyLength);
 
 		res = COMPARE(tree, key, searchKey);
@@ -766,15 +1114,15 @@ static int addRecord(BTree* tree, uint32_t root, BTKey* searchKey, size_t length
 				return 0;
 			}
 
-			key = READ_KEY(tree, (root * tree->headerRec->nodeSize) + 14, tree->io);
+			key = READ_KEY(tree, (root * tree->headerRec->nodeSize) + 14, tree->cache);
 
 			recordDataOffset = recordOffset + key->keyLength + sizeof(key->keyLength);
-			nodeBigEndian = getNodeNumberFromPointerRecord(recordDataOffset, tree->io);
+			nodeBigEndian = getNodeNumberFromPointerRecord(recordDataOffset, tree->cache);
 
 			FLIPENDIAN(nodeBigEndian);
 
 			free(key);
-			key = READ_KEY(tree, (root * tree->headerRec->nodeSize) + 14, tree->io);
+			key = READ_KEY(tree, (root * tree->headerRec->nodeSize) + 14, tree->cache);
 			recordDataOffset = recordOffset + key->keyLength + sizeof(key->keyLength);
 
 			if(searchKey->keyLength != key->keyLength) {
@@ -789,14 +1137,14 @@ static int addRecord(BTree* tree, uint32_t root, BTKey* searchKey, size_t length
 
 			free(key);
 
-			ASSERT(WRITE_KEY(tree, recordOffset, searchKey, tree->io), "WRITE_KEY");
-			ASSERT(WRITE(tree->io, recordOffset + sizeof(uint16_t) + searchKey->keyLength, sizeof(uint32_t), &nodeBigEndian), "WRITE");
+			ASSERT(WRITE_KEY(tree, recordOffset, searchKey, tree->cache), "WRITE_KEY");
+			ASSERT(WRITE(tree->cache, recordOffset + sizeof(uint16_t) + searchKey->keyLength, sizeof(uint32_t), &nodeBigEndian), "WRITE");
 
 			FLIPENDIAN(nodeBigEndian);
 
 			newNode = addRecord(tree, nodeBigEndian, searchKey, length, content, callAgain);
 		} else {
-			newNode = addRecord(tree, getNodeNumberFromPointerRecord(lastRecordDataOffset, tree->io), searchKey, length, content, callAgain);
+			newNode = addRecord(tree, getNodeNumberFromPointerRecord(lastRecordDataOffset, tree->cache), searchKey, length, content, callAgain);
 		}
 
 		if(newNode == 0) {
@@ -804,7 +1152,7 @@ static int addRecord(BTree* tree, uint32_t root, BTKey* searchKey, size_t length
 			return 0;
 		} else {
 			newNodeBigEndian = newNode;
-			key = READ_KEY(tree, newNode * tree->headerRec->nodeSize + 14, tree->io);
+			key = READ_KEY(tree, newNode * tree->headerRec->nodeSize + 14, tree->cache);
 			FLIPENDIAN(newNodeBigEndian);
 
 			if(freeSpace < (sizeof(key->keyLength) + key->keyLength + sizeof(newNodeBigEndian) + sizeof(uint16_t))) {
@@ -844,8 +1192,8 @@ static int increaseHeight(BTree* tree, uint32_t newNode) {
 
 	oldRoot = tree->headerRec->rootNode;
 
-	oldRootKey = READ_KEY(tree, (oldRoot * tree->headerRec->nodeSize) + 14, tree->io);
-	newNodeKey = READ_KEY(tree, (newNode * tree->headerRec->nodeSize) + 14, tree->io);
+	oldRootKey = READ_KEY(tree, (oldRoot * tree->headerRec->nodeSize) + 14, tree->cache);
+	newNodeKey = READ_KEY(tree, (newNode * tree->headerRec->nodeSize) + 14, tree->cache);
 
 	newRoot = getNewNode(tree);
 
@@ -863,26 +1211,26 @@ static int increaseHeight(BTree* tree, uint32_t newNode) {
 	tree->headerRec->rootNode = newRoot;
 	tree->headerRec->treeDepth = newDescriptor.height;
 
-	ASSERT(WRITE_KEY(tree, newRoot * tree->headerRec->nodeSize + oldRootOffset, oldRootKey, tree->io), "WRITE_KEY");
+	ASSERT(WRITE_KEY(tree, newRoot * tree->headerRec->nodeSize + oldRootOffset, oldRootKey, tree->cache), "WRITE_KEY");
 	FLIPENDIAN(oldRoot);
-	ASSERT(WRITE(tree->io, newRoot * tree->headerRec->nodeSize + oldRootOffset + sizeof(oldRootKey->keyLength) + oldRootKey->keyLength,
+	ASSERT(WRITE(tree->cache, newRoot * tree->headerRec->nodeSize + oldRootOffset + sizeof(oldRootKey->keyLength) + oldRootKey->keyLength,
 				sizeof(uint32_t), &oldRoot), "WRITE");
 
-	ASSERT(WRITE_KEY(tree, newRoot * tree->headerRec->nodeSize + newNodeOffset, newNodeKey, tree->io), "WRITE_KEY");
+	ASSERT(WRITE_KEY(tree, newRoot * tree->headerRec->nodeSize + newNodeOffset, newNodeKey, tree->cache), "WRITE_KEY");
 	FLIPENDIAN(newNode);
-	ASSERT(WRITE(tree->io, newRoot * tree->headerRec->nodeSize + newNodeOffset + sizeof(newNodeKey->keyLength) + newNodeKey->keyLength,
+	ASSERT(WRITE(tree->cache, newRoot * tree->headerRec->nodeSize + newNodeOffset + sizeof(newNodeKey->keyLength) + newNodeKey->keyLength,
 				sizeof(uint32_t), &newNode), "WRITE");
 
 	FLIPENDIAN(oldRootOffset);
-	ASSERT(WRITE(tree->io, (newRoot * tree->headerRec->nodeSize) + tree->headerRec->nodeSize - (sizeof(uint16_t) * 1),
+	ASSERT(WRITE(tree->cache, (newRoot * tree->headerRec->nodeSize) + tree->headerRec->nodeSize - (sizeof(uint16_t) * 1),
 				sizeof(uint16_t), &oldRootOffset), "WRITE");
 
 	FLIPENDIAN(newNodeOffset);
-	ASSERT(WRITE(tree->io, (newRoot * tree->headerRec->nodeSize) + tree->headerRec->nodeSize - (sizeof(uint16_t) * 2),
+	ASSERT(WRITE(tree->cache, (newRoot * tree->headerRec->nodeSize) + tree->headerRec->nodeSize - (sizeof(uint16_t) * 2),
 				sizeof(uint16_t), &newNodeOffset), "WRITE");
 
 	FLIPENDIAN(freeOffset);
-	ASSERT(WRITE(tree->io, (newRoot * tree->headerRec->nodeSize) + tree->headerRec->nodeSize - (sizeof(uint16_t) * 3),
+	ASSERT(WRITE(tree->cache, (newRoot * tree->headerRec->nodeSize) + tree->headerRec->nodeSize - (sizeof(uint16_t) * 3),
 				sizeof(uint16_t), &freeOffset), "WRITE");
 
 	ASSERT(writeBTNodeDescriptor(&newDescriptor, tree->headerRec->rootNode, tree), "writeBTNodeDescriptor");
@@ -924,22 +1272,24 @@ int addToBTree(BTree* tree, BTKey* searchKey, size_t length, unsigned char* cont
 		offset = 14;
 		freeOffset = offset + sizeof(searchKey->keyLength) + searchKey->keyLength + length;
 
-		ASSERT(WRITE_KEY(tree, tree->headerRec->rootNode * tree->headerRec->nodeSize + offset, searchKey, tree->io), "WRITE_KEY");    
-		ASSERT(WRITE(tree->io, tree->headerRec->rootNode * tree->headerRec->nodeSize + offset + sizeof(searchKey->keyLength) + searchKey->keyLength,
+		ASSERT(WRITE_KEY(tree, tree->headerRec->rootNode * tree->headerRec->nodeSize + offset, searchKey, tree->cache), "WRITE_KEY");    
+		ASSERT(WRITE(tree->cache, tree->headerRec->rootNode * tree->headerRec->nodeSize + offset + sizeof(searchKey->keyLength) + searchKey->keyLength,
 					length, content), "WRITE");
 
 		FLIPENDIAN(offset);
-		ASSERT(WRITE(tree->io, (tree->headerRec->rootNode * tree->headerRec->nodeSize) + tree->headerRec->nodeSize - (sizeof(uint16_t) * 1),
+		ASSERT(WRITE(tree->cache, (tree->headerRec->rootNode * tree->headerRec->nodeSize) + tree->headerRec->nodeSize - (sizeof(uint16_t) * 1),
 					sizeof(uint16_t), &offset), "WRITE");
 
 		FLIPENDIAN(freeOffset);
-		ASSERT(WRITE(tree->io, (tree->headerRec->rootNode * tree->headerRec->nodeSize) + tree->headerRec->nodeSize - (sizeof(uint16_t) * 2),
+		ASSERT(WRITE(tree->cache, (tree->headerRec->rootNode * tree->headerRec->nodeSize) + tree->headerRec->nodeSize - (sizeof(uint16_t) * 2),
 					sizeof(uint16_t), &freeOffset), "WRITE");
 
 		ASSERT(writeBTNodeDescriptor(&newDescriptor, tree->headerRec->rootNode, tree), "writeBTNodeDescriptor");
 		ASSERT(writeBTHeaderRec(tree), "writeBTHeaderRec");
 	}
 
+	invalidateNodeCache(tree);
+
 	return TRUE;
 }
 
@@ -976,7 +1326,7 @@ static uint32_t removeRecord(BTree* tree, uint32_t root, BTKey* searchKey, int*
 
 	for(i = 0; i < descriptor->numRecords; i++) {
 		recordOffset = getRecordOffset(i, root, tree);
-		key = READ_KEY(tree, recordOffset, tree->io);
+		key = READ_KEY(tree, recordOffset, tree->cache);
 		recordDataOffset = recordOffset + key->keyLength + sizeof(key->keyLength);
 
 		res = COMPARE(tree, key, searchKey);
@@ -1004,7 +1354,7 @@ static uint32_t removeRecord(BTree* tree, uint32_t root, BTKey* searchKey, int*
 					return 0;
 				}
 			} else {
-				nodeToTraverse = getNodeNumberFromPointerRecord(recordDataOffset, tree->io);
+				nodeToTraverse = getNodeNumberFromPointerRecord(recordDataOffset, tree->cache);
 				checkForChangedKey = TRUE;
 				break;
 			}
@@ -1016,7 +1366,7 @@ static uint32_t removeRecord(BTree* tree, uint32_t root, BTKey* searchKey, int*
 				free(descriptor);
 				return 0;
 			} else {
-				nodeToTraverse = getNodeNumberFromPointerRecord(lastRecordDataOffset, tree->io);
+				nodeToTraverse = getNodeNumberFromPointerRecord(lastRecordDataOffset, tree->cache);
 				break;
 			}
 		}
@@ -1027,7 +1377,7 @@ static uint32_t removeRecord(BTree* tree, uint32_t root, BTKey* searchKey, int*
 	}
 
 	if(nodeToTraverse == 0) {
-		nodeToTraverse = getNodeNumberFromPointerRecord(lastRecordDataOffset, tree->io);
+		nodeToTraverse = getNodeNumberFromPointerRecord(lastRecordDataOffset, tree->cache);
 	}
 
 	if(i == descriptor->numRecords) {
@@ -1048,7 +1398,7 @@ static uint32_t removeRecord(BTree* tree, uint32_t root, BTKey* searchKey, int*
 		if(checkForChangedKey) {
 			// we will remove the first item in the child node, so our index has to change
 
-			key = READ_KEY(tree, getRecordOffset(0, nodeToTraverse, tree), tree->io);
+			key = READ_KEY(tree, getRecordOffset(0, nodeToTraverse, tree), tree->cache);
 
 			if(searchKey->keyLength != key->keyLength) {
 				if(key->keyLength > searchKey->keyLength && freeSpace < (key->keyLength - searchKey->keyLength)) {
@@ -1060,9 +1410,9 @@ static uint32_t removeRecord(BTree* tree, uint32_t root, BTKey* searchKey, int*
 				moveRecordsDown(tree, descriptor, i + 1, root, key->keyLength - searchKey->keyLength, 0);
 			}
 
-			ASSERT(WRITE_KEY(tree, recordOffset, key, tree->io), "WRITE_KEY");
+			ASSERT(WRITE_KEY(tree, recordOffset, key, tree->cache), "WRITE_KEY");
 			FLIPENDIAN(nodeToTraverse);
-			ASSERT(WRITE(tree->io, recordOffset + sizeof(uint16_t) + key->keyLength, sizeof(uint32_t), &nodeToTraverse), "WRITE");
+			ASSERT(WRITE(tree->cache, recordOffset + sizeof(uint16_t) + key->keyLength, sizeof(uint32_t), &nodeToTraverse), "WRITE");
 			FLIPENDIAN(nodeToTraverse);
 
 			free(key);
@@ -1079,7 +1429,7 @@ static uint32_t removeRecord(BTree* tree, uint32_t root, BTKey* searchKey, int*
 		return 0;
 	} else {
 		newNodeBigEndian = newNode;
-		key = READ_KEY(tree, newNode * tree->headerRec->nodeSize + 14, tree->io);
+		key = READ_KEY(tree, newNode * tree->headerRec->nodeSize + 14, tree->cache);
 		FLIPENDIAN(newNodeBigEndian);
 
 		if(freeSpace < (sizeof(key->keyLength) + key->keyLength + sizeof(newNodeBigEndian) + sizeof(uint16_t))) {
@@ -1124,5 +1474,7 @@ int removeFromBTree(BTree* tree, BTKey* searchKey) {
 		}
 	} while(callAgain);
 
+	invalidateNodeCache(tree);
+
 	return TRUE;
 }
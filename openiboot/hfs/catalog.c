@@ -306,6 +306,131 @@ void ASCIIToUnicode(const char* ascii, HFSUniStr255* unistr) {
 	unistr->length = count;
 }
 
+// Path components resolved by getRecordFromPath3, keyed on (parentID, name),
+// including names that were not found. Volumes are opened for every command,
+// so this outlives them and is tagged with the backing store and the header
+// fields the catalog code changes. updateCatalog drops everything.
+
+#ifndef CATALOG_CACHE_ENTRIES
+#define CATALOG_CACHE_ENTRIES 64
+#endif
+
+#define CATALOG_CACHE_NAME 32
+
+typedef struct CatalogCacheEntry {
+	HFSCatalogNodeID parentID;
+	int used;
+	char name[CATALOG_CACHE_NAME];
+	HFSPlusCatalogRecord* record;	// NULL if there is no such name
+} CatalogCacheEntry;
+
+typedef struct CatalogCacheTag {
+	void* image;
+	uint32_t modifyDate;
+	uint32_t writeCount;
+	uint32_t fileCount;
+	uint32_t folderCount;
+	HFSCatalogNodeID nextCatalogID;
+} CatalogCacheTag;
+
+static CatalogCacheEntry CatalogCache[CATALOG_CACHE_ENTRIES];
+static CatalogCacheTag CatalogCacheFor;
+
+void invalidateCatalogCache() {
+	int i;
+	for(i = 0; i < CATALOG_CACHE_ENTRIES; i++) {
+		if(CatalogCache[i].used && CatalogCache[i].record != NULL)
+			free(CatalogCache[i].record);
+
+		CatalogCache[i].used = FALSE;
+		CatalogCache[i].record = NULL;
+	}
+}
+
+static CatalogCacheEntry* catalogCacheSlot(Volume* volume, HFSCatalogNodeID parentID, const char* name) {
+	CatalogCacheTag tag;
+	uint32_t hash = parentID;
+
+	if(strlen(name) >= CATALOG_CACHE_NAME)
+		return NULL;
+
+	memset(&tag, 0, sizeof(tag));
+	tag.image = volume->image->data;
+	tag.modifyDate = volume->volumeHeader->modifyDate;
+	tag.writeCount = volume->volumeHeader->writeCount;
+	tag.fileCount = volume->volumeHeader->fileCount;
+	tag.folderCount = volume->volumeHeader->folderCount;
+	tag.nextCatalogID = volume->volumeHeader->nextCatalogID;
+
+	if(memcmp(&tag, &CatalogCacheFor, sizeof(tag)) != 0) {
+		invalidateCatalogCache();
+		memcpy(&CatalogCacheFor, &tag, sizeof(tag));
+	}
+
+	while(*name != '\0')
+		hash = (hash * 31) + *(name++);
+
+	return &CatalogCache[hash % CATALOG_CACHE_ENTRIES];
+}
+
+static size_t catalogRecordSize(HFSPlusCatalogRecord* record) {
+	if(record->recordType == kHFSPlusFolderRecord)
+		return sizeof(HFSPlusCatalogFolder);
+	else if(record->recordType == kHFSPlusFileRecord)
+		return sizeof(HFSPlusCatalogFile);
+	else
+		return 0;
+}
+
+// Returns TRUE on a hit, with *record set to a copy the caller frees, or to
+// NULL for a name that is known not to exist.
+static int catalogCacheGet(Volume* volume, HFSCatalogNodeID parentID, const char* name, HFSPlusCatalogRecord** record) {
+	CatalogCacheEntry* entry = catalogCacheSlot(volume, parentID, name);
+	if(entry == NULL || !entry->used || entry->parentID != parentID || strcmp(entry->name, name) != 0)
+		return FALSE;
+
+	if(entry->record == NULL) {
+		*record = NULL;
+		return TRUE;
+	}
+
+	size_t size = catalogRecordSize(entry->record);
+	*record = (HFSPlusCatalogRecord*) malloc(size);
+	if(*record == NULL)
+		return FALSE;
+
+	memcpy(*record, entry->record, size);
+	return TRUE;
+}
+
+static void catalogCachePut(Volume* volume, HFSCatalogNodeID parentID, const char* name, HFSPlusCatalogRecord* record) {
+	CatalogCacheEntry* entry = catalogCacheSlot(volume, parentID, name);
+	HFSPlusCatalogRecord* copy = NULL;
+
+	if(entry == NULL)
+		return;
+
+	if(record != NULL) {
+		size_t size = catalogRecordSize(record);
+		if(size == 0)
+			return;
+
+		copy = (HFSPlusCatalogRecord*) malloc(size);
+		if(copy == NULL)
+			return;
+
+		memcpy(copy, record, size);
+	}
+
+	if(entry->used && entry->record != NULL)
+		free(entry->record);
+
+	entry->used = TRUE;
+	entry->parentID = parentID;
+	strcpy(entry->name, name);
+	entry->record = copy;
+}
+
 HFSPlusCatalogRecord* getRecordByCNID(HFSCatalogNodeID CNID, Volume* volume) {
 	HFSPlusCatalogKey key;
 	HFSPlusCatalogThread* thread;
@@ -340,76 +465,84 @@ HFSPlusCatalogRecord* getRecordByCNID(HFSCatalogNodeID CNID, Volume* volume) {
 		return record;
 }
 
-CatalogRecordList* getFolderContents(HFSCatalogNodeID CNID, Volume* volume) {
-	BTree* tree;
-	HFSPlusCatalogThread* record; 
+int openCatalogCursor(HFSCatalogNodeID CNID, Volume* volume, CatalogCursor* cursor) {
 	HFSPlusCatalogKey key;
-	uint32_t nodeNumber;
-	int recordNumber;
-
-	BTNodeDescriptor* descriptor;
-	off_t recordOffset;
-	off_t recordDataOffset;
-	HFSPlusCatalogKey* currentKey;
-
-	CatalogRecordList* list;
-	CatalogRecordList* lastItem = NULL;
-	CatalogRecordList* item;
-
-	tree = volume->catalogTree;
 
 	key.keyLength = sizeof(key.parentID) + sizeof(key.nodeName.length);
 	key.parentID = CNID;
 	key.nodeName.length = 0;
 
-	list = NULL;
+	cursor->parentID = CNID;
+
+	// lands on the folder's thread record, which sorts before its children
+	if(!openLeafCursor(volume->catalogTree, (BTKey*)(&key), &cursor->leaf)) {
+		closeLeafCursor(&cursor->leaf);
+		return FALSE;
+	}
 
-	record = (HFSPlusCatalogThread*) search(tree, (BTKey*)(&key), NULL, &nodeNumber, &recordNumber);
+	cursor->leaf.recordNumber++;
+	return TRUE;
+}
 
-	if(record == NULL)
+// The next child of the folder in name order, or NULL after the last. The
+// record and, if key is not NULL, its key are the caller's to free.
+HFSPlusCatalogRecord* catalogCursorNext(CatalogCursor* cursor, HFSPlusCatalogKey** key) {
+	HFSPlusCatalogKey* currentKey;
+	HFSPlusCatalogRecord* record;
+
+	if(!leafCursorNext(&cursor->leaf, (BTKey**)(&currentKey), (void**)(&record)))
 		return NULL;
 
-	free(record);
+	if(currentKey->parentID != cursor->parentID) {
+		// past the last child
+		free(currentKey);
+		free(record);
+		cursor->leaf.nodeNumber = 0;
+		return NULL;
+	}
+
+	if(key != NULL)
+		*key = currentKey;
+	else
+		free(currentKey);
 
-	++recordNumber;
+	return record;
+}
 
-	while(nodeNumber != 0) {    
-		descriptor = readBTNodeDescriptor(nodeNumber, tree);
+void closeCatalogCursor(CatalogCursor* cursor) {
+	closeLeafCursor(&cursor->leaf);
+}
 
-		while(recordNumber < descriptor->numRecords) {
-			recordOffset = getRecordOffset(recordNumber, nodeNumber, tree);
-			currentKey = (HFSPlusCatalogKey*) READ_KEY(tree, recordOffset, tree->io);
-			recordDataOffset = recordOffset + currentKey->keyLength + sizeof(currentKey->keyLength);
+CatalogRecordList* getFolderContents(HFSCatalogNodeID CNID, Volume* volume) {
+	CatalogCursor cursor;
+	HFSPlusCatalogKey* key;
+	HFSPlusCatalogRecord* record;
 
-			if(currentKey->parentID == CNID) {
-				item = (CatalogRecordList*) malloc(sizeof(CatalogRecordList));
-				item->name = currentKey->nodeName;
-				item->record = (HFSPlusCatalogRecord*) READ_DATA(tree, recordDataOffset, tree->io);
-				item->next = NULL;
+	CatalogRecordList* list = NULL;
+	CatalogRecordList* lastItem = NULL;
+	CatalogRecordList* item;
 
-				if(list == NULL) {
-					list = item;
-				} else {
-					lastItem->next = item;
-				}
+	if(!openCatalogCursor(CNID, volume, &cursor))
+		return NULL;
 
-				lastItem = item;
-				free(currentKey);
-			} else {
-				free(currentKey);
-				free(descriptor);
-				return list;
-			}
+	while((record = catalogCursorNext(&cursor, &key)) != NULL) {
+		item = (CatalogRecordList*) malloc(sizeof(CatalogRecordList));
+		item->name = key->nodeName;
+		item->record = record;
+		item->next = NULL;
+		free(key);
 
-			recordNumber++;
+		if(list == NULL) {
+			list = item;
+		} else {
+			lastItem->next = item;
 		}
 
-		nodeNumber = descriptor->fLink;
-		recordNumber = 0;
-
-		free(descriptor);
+		lastItem = item;
 	}
 
+	closeCatalogCursor(&cursor);
+
 	return list;
 }
 
@@ -523,7 +656,12 @@ HFSPlusCatalogRecord* getRecordFromPath3(const char* path, Volume* volume, char
 		ASCIIToUnicode(word, &key.nodeName);
 
 		key.keyLength = sizeof(key.parentID) + sizeof(key.nodeName.length) + (sizeof(uint16_t) * key.nodeName.length);
-		record = (HFSPlusCatalogRecord*) search(volume->catalogTree, (BTKey*)(&key), &exact, NULL, NULL);
+		if(catalogCacheGet(volume, key.parentID, word, &record)) {
+			exact = TRUE;
+		} else {
+			record = (HFSPlusCatalogRecord*) search(volume->catalogTree, (BTKey*)(&key), &exact, NULL, NULL);
+			catalogCachePut(volume, key.parentID, word, exact ? record : NULL);
+		}
 
 		if(record == NULL || exact == FALSE) {
 			free(origPath);
@@ -582,6 +720,8 @@ int updateCatalog(Volume* volume, HFSPlusCatalogRecord* catalogRecord) {
 	HFSPlusCatalogFolder folder;
 	int exact;
 
+	invalidateCatalogCache();
+
 	key.keyLength = sizeof(key.parentID) + sizeof(key.nodeName.length);
 	if(catalogRecord->recordType == kHFSPlusFolderRecord) {
 		key.parentID = ((HFSPlusCatalogFolder*)catalogRecord)->folderID;
@@ -115,3 +115,128 @@ static BTKey* extentDataRead(off_t offset, io_func* io) {
 BTree* openExtentsTree(io_func* file) {
   return openBTree(file, &extentCompare, &extentKeyRead, &extentKeyWrite, &extentKeyPrint, &extentDataRead);
 }
+
+// Files kept in the overflow extents cache of a volume
+#ifndef EXTENTS_CACHE_FILES
+#define EXTENTS_CACHE_FILES 16
+#endif
+
+// Reads the overflow records of a data fork one after another off the leaf
+// chain, instead of searching the tree again for each, until they cover
+// blocks blocks from startBlock.
+static HFSPlusExtentDescriptor* readOverflowExtents(Volume* volume, HFSCatalogNodeID fileID, uint32_t startBlock, uint32_t blocks, uint32_t* count) {
+  HFSPlusExtentDescriptor* extents = NULL;
+  HFSPlusExtentKey searchKey;
+  HFSPlusExtentKey* key;
+  HFSPlusExtentDescriptor* record;
+  BTLeafCursor cursor;
+  uint32_t currentBlock = startBlock;
+  uint32_t covered = 0;
+  uint32_t allocated = 0;
+  int i;
+
+  *count = 0;
+
+  searchKey.keyLength = sizeof(HFSPlusExtentKey) - sizeof(searchKey.keyLength);
+  searchKey.forkType = 0;
+  searchKey.pad = 0;
+  searchKey.fileID = fileID;
+  searchKey.startBlock = startBlock;
+
+  if(!openLeafCursor(volume->extentsTree, (BTKey*)(&searchKey), &cursor)) {
+    closeLeafCursor(&cursor);
+    return NULL;
+  }
+
+  while(covered < blocks && leafCursorNext(&cursor, (BTKey**)(&key), (void**)(&record))) {
+    if(key->fileID != fileID || key->forkType != 0 || key->startBlock != currentBlock) {
+      free(key);
+      free(record);
+      break;
+    }
+
+    if(*count + 8 > allocated) {
+      allocated = (allocated == 0) ? 8 : (allocated * 2);
+      extents = (HFSPlusExtentDescriptor*) realloc(extents, allocated * sizeof(HFSPlusExtentDescriptor));
+    }
+
+    for(i = 0; i < 8 && covered < blocks && record[i].blockCount != 0; i++) {
+      extents[(*count)++] = record[i];
+      covered += record[i].blockCount;
+      currentBlock += record[i].blockCount;
+    }
+
+    free(key);
+    free(record);
+  }
+
+  closeLeafCursor(&cursor);
+
+  if(covered < blocks) {
+    free(extents);
+    *count = 0;
+    return NULL;
+  }
+
+  return extents;
+}
+
+// The extents past the eight in the fork of fileID, which start at file block
+// startBlock and cover blocks blocks, cached per file. The array stays the
+// volume's; it is good until the extents tree next changes.
+HFSPlusExtentDescriptor* getOverflowExtents(Volume* volume, HFSCatalogNodeID fileID, uint32_t startBlock, uint32_t blocks, uint32_t* count) {
+  ExtentsCacheEntry** link = &volume->extentsCache;
+  ExtentsCacheEntry* entry;
+
+  while(*link != NULL) {
+    entry = *link;
+    if(entry->fileID == fileID && entry->startBlock == startBlock) {
+      *link = entry->next;
+      entry->next = volume->extentsCache;
+      volume->extentsCache = entry;
+      *count = entry->count;
+      return entry->extents;
+    }
+
+    link = &entry->next;
+  }
+
+  entry = (ExtentsCacheEntry*) malloc(sizeof(ExtentsCacheEntry));
+  entry->extents = readOverflowExtents(volume, fileID, startBlock, blocks, &entry->count);
+  if(entry->extents == NULL) {
+    free(entry);
+    return NULL;
+  }
+
+  entry->fileID = fileID;
+  entry->startBlock = startBlock;
+  entry->next = volume->extentsCache;
+  volume->extentsCache = entry;
+
+  if(++volume->extentsCacheCount > EXTENTS_CACHE_FILES) {
+    link = &volume->extentsCache;
+    while((*link)->next != NULL)
+      link = &(*link)->next;
+
+    free((*link)->extents);
+    free(*link);
+    *link = NULL;
+    volume->extentsCacheCount--;
+  }
+
+  *count = entry->count;
+  return entry->extents;
+}
+
+void invalidateExtentsCache(Volume* volume) {
+  ExtentsCacheEntry* entry;
+
+  while(volume->extentsCache != NULL) {
+    entry = volume->extentsCache;
+    volume->extentsCache = entry->next;
+    free(entry->extents);
+    free(entry);
+  }
+
+  volume->extentsCacheCount = 0;
+}
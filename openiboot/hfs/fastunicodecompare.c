@@ -384,6 +384,36 @@ int32_t FastUnicodeCompare ( register uint16_t str1[], register uint16_t length1
 
     lowerCaseTable = gLowerCaseTable;
 
+    /* ASCII fast path: nothing below 0x80 is ignorable (except 0) and only
+       A-Z fold, so the common prefix can be consumed without the tables.
+       Anything else drops through to the full comparison from there on. */
+    while (length1 && length2) {
+        c1 = *str1;
+        c2 = *str2;
+        if (c1 == 0 || c2 == 0 || ((c1 | c2) & 0xFF80) != 0)
+            break;
+
+        if (c1 != c2) {
+            if (c1 >= 'A' && c1 <= 'Z')
+                c1 += 'a' - 'A';
+            else if (c1 == ':')
+                c1 = '/';
+            if (c2 >= 'A' && c2 <= 'Z')
+                c2 += 'a' - 'A';
+            else if (c2 == ':')
+                c2 = '/';
+            if (c1 < c2)
+                return -1;
+            else if (c1 > c2)
+                return 1;
+        }
+
+        str1++;
+        str2++;
+        --length1;
+        --length2;
+    }
+
     while (1) {
         c1 = 0;
         c2 = 0;
@@ -3,12 +3,97 @@
 #include "hfs/bdev.h"
 #include "hfs/fs.h"
 #include "hfs/hfsplus.h"
+#include "hfs/hfscompress.h"
 #include "util.h"
 #include "ftl.h"
 #include "nand.h"
+#include "tasks.h"
 
 int HasFSInit = FALSE;
 
+// Volumes stay mounted between commands, one per MBR partition, so each one
+// does not read the volume header and open the B-trees all over again. One
+// is dropped once NAND has been written by anything but itself (see
+// nand_write_generation), or by fs_invalidate. FSLock keeps tasks off a
+// volume while another is using it.
+#define FS_PARTITIONS 4
+
+typedef struct MountedVolume {
+	io_func* io;
+	Volume* volume;
+	uint32_t generation;
+} MountedVolume;
+
+static MountedVolume Mounted[FS_PARTITIONS];
+static Mutex FSLock;
+
+static void fs_unmount(MountedVolume* mounted) {
+	closeVolume(mounted->volume);
+	CLOSE(mounted->io);
+	mounted->volume = NULL;
+	mounted->io = NULL;
+}
+
+// Returns with FSLock held, to be let go with fs_put, unless it returns NULL.
+static Volume* fs_get(int partition) {
+	MountedVolume* mounted;
+	io_func* io;
+
+	if(partition < 0 || partition >= FS_PARTITIONS) {
+		bufferPrintf("fs: cannot read partition!\r\n");
+		return NULL;
+	}
+
+	mutex_lock(&FSLock);
+	mounted = &Mounted[partition];
+
+	if(mounted->volume != NULL && mounted->generation != nand_write_generation())
+		fs_unmount(mounted);
+
+	if(mounted->volume == NULL) {
+		mounted->generation = nand_write_generation();
+
+		io = bdev_open(partition);
+		if(io == NULL) {
+			bufferPrintf("fs: cannot read partition!\r\n");
+			mutex_unlock(&FSLock);
+			return NULL;
+		}
+
+		mounted->volume = openVolume(io);
+		if(mounted->volume == NULL) {
+			bufferPrintf("fs: cannot openHFS volume!\r\n");
+			CLOSE(io);
+			mutex_unlock(&FSLock);
+			return NULL;
+		}
+
+		mounted->io = io;
+	}
+
+	return mounted->volume;
+}
+
+// wrote is set when the volume was written through, so it is up to date
+// with what that did to NAND.
+static void fs_put(int partition, int wrote) {
+	if(wrote)
+		Mounted[partition].generation = nand_write_generation();
+
+	mutex_unlock(&FSLock);
+}
+
+void fs_invalidate() {
+	int i;
+
+	mutex_lock(&FSLock);
+	for(i = 0; i < FS_PARTITIONS; i++) {
+		if(Mounted[i].volume != NULL)
+			fs_unmount(&Mounted[i]);
+	}
+	mutex_unlock(&FSLock);
+}
+
 void writeToHFSFile(HFSPlusCatalogFile* file, uint8_t* buffer, size_t bytesLeft, Volume* volume) {
 	io_func* io;
 
@@ -17,7 +102,7 @@ void writeToHFSFile(HFSPlusCatalogFile* file, uint8_t* buffer, size_t bytesLeft,
 		hfs_panic("error opening file");
 		return;
 	}
-	allocate((RawFile*)io->data, bytesLeft);
+	allocate2((RawFile*)io->data, bytesLeft, FALSE);
 	
 	if(!WRITE(io, 0, (size_t)bytesLeft, buffer)) {
 		hfs_panic("error writing");
@@ -29,6 +114,8 @@ void writeToHFSFile(HFSPlusCatalogFile* file, uint8_t* buffer, size_t bytesLeft,
 int add_hfs(Volume* volume, uint8_t* buffer, size_t size, const char* outFileName) {
 	HFSPlusCatalogRecord* record;
 	int ret;
+
+	beginVolumeTransaction(volume);
 	
 	record = getRecordFromPath(outFileName, volume, NULL, NULL);
 	
@@ -52,27 +139,33 @@ int add_hfs(Volume* volume, uint8_t* buffer, size_t size, const char* outFileNam
 	if(record != NULL) {
 		free(record);
 	}
+
+	if(!commitVolumeTransaction(volume))
+		ret = FALSE;
 	
 	return ret;
 }
 
+// Printed as the catalog is walked, without building the whole listing first.
 void displayFolder(HFSCatalogNodeID folderID, Volume* volume) {
-	CatalogRecordList* list;
-	CatalogRecordList* theList;
+	CatalogCursor cursor;
+	HFSPlusCatalogKey* key;
+	HFSPlusCatalogRecord* record;
 	HFSPlusCatalogFolder* folder;
 	HFSPlusCatalogFile* file;
 	
-	theList = list = getFolderContents(folderID, volume);
+	if(!openCatalogCursor(folderID, volume, &cursor))
+		return;
 	
-	while(list != NULL) {
-		if(list->record->recordType == kHFSPlusFolderRecord) {
-			folder = (HFSPlusCatalogFolder*)list->record;
+	while((record = catalogCursorNext(&cursor, &key)) != NULL) {
+		if(record->recordType == kHFSPlusFolderRecord) {
+			folder = (HFSPlusCatalogFolder*)record;
 			bufferPrintf("%06o ", folder->permissions.fileMode);
 			bufferPrintf("%3d ", folder->permissions.ownerID);
 			bufferPrintf("%3d ", folder->permissions.groupID);
 			bufferPrintf("%12d ", folder->valence);
-		} else if(list->record->recordType == kHFSPlusFileRecord) {
-			file = (HFSPlusCatalogFile*)list->record;
+		} else if(record->recordType == kHFSPlusFileRecord) {
+			file = (HFSPlusCatalogFile*)record;
 			bufferPrintf("%06o ", file->permissions.fileMode);
 			bufferPrintf("%3d ", file->permissions.ownerID);
 			bufferPrintf("%3d ", file->permissions.groupID);
@@ -81,13 +174,14 @@ void displayFolder(HFSCatalogNodeID folderID, Volume* volume) {
 		
 		bufferPrintf("                 ");
 
-		printUnicode(&list->name);
+		printUnicode(&key->nodeName);
 		bufferPrintf("\r\n");
 		
-		list = list->next;
+		free(key);
+		free(record);
 	}
 	
-	releaseCatalogRecordList(theList);
+	closeCatalogCursor(&cursor);
 }
 
 void displayFileLSLine(HFSPlusCatalogFile* file, const char* name) {
@@ -99,10 +193,63 @@ void displayFileLSLine(HFSPlusCatalogFile* file, const char* name) {
 	bufferPrintf("%s\r\n", name);
 }
 
+// Chunk by chunk, straight into location. Only one compressed chunk is held in
+// memory at a time, and the file never is.
+static int readCompressed(HFSPlusCompressed* data, uint8_t* location) {
+	uint32_t chunk;
+
+	for(chunk = 0; chunk < data->numChunks; chunk++) {
+		if(readHFSPlusCompressedChunk(data, chunk, location + (chunk * data->chunkSize)) < 0)
+			return FALSE;
+	}
+
+	return TRUE;
+}
+
+static int readCompressedInto(HFSPlusCatalogFile* file, uint8_t* location, uint32_t maxSize, Volume* volume) {
+	HFSPlusCompressed* data;
+	int ret = -1;
+
+	data = openHFSPlusCompressed(volume, file);
+	if(data == NULL)
+		return -1;
+
+	if(data->size <= maxSize && readCompressed(data, location))
+		ret = data->size;
+
+	closeHFSPlusCompressed(data);
+	return ret;
+}
+
+static uint32_t readCompressedFile(HFSPlusCatalogFile* file, uint8_t** buffer, Volume* volume) {
+	HFSPlusCompressed* data;
+	uint32_t size = 0;
+
+	*buffer = NULL;
+	data = openHFSPlusCompressed(volume, file);
+	if(data == NULL)
+		return 0;
+
+	*buffer = malloc(data->size);
+	if(!(*buffer)) {
+		hfs_panic("error allocating memory");
+	} else if(!readCompressed(data, *buffer)) {
+		hfs_panic("error reading");
+	} else {
+		size = data->size;
+	}
+
+	closeHFSPlusCompressed(data);
+	return size;
+}
+
 uint32_t readHFSFile(HFSPlusCatalogFile* file, uint8_t** buffer, Volume* volume) {
 	io_func* io;
 	size_t bytesLeft;
 
+	if(isHFSPlusCompressed(file))
+		return readCompressedFile(file, buffer, volume);
+
 	io = openRawFile(file->fileID, &file->dataFork, (HFSPlusCatalogRecord*)file, volume);
 	if(io == NULL) {
 		hfs_panic("error opening file");
@@ -126,6 +273,28 @@ uint32_t readHFSFile(HFSPlusCatalogFile* file, uint8_t** buffer, Volume* volume)
 	return file->dataFork.logicalSize;
 }
 
+// Like readHFSFile, but straight into the caller's buffer. Files of more than
+// maxSize bytes are left alone.
+static int readHFSFileInto(HFSPlusCatalogFile* file, void* location, uint32_t maxSize, Volume* volume) {
+	io_func* io;
+	int ret;
+
+	if(isHFSPlusCompressed(file))
+		return readCompressedInto(file, (uint8_t*) location, maxSize, volume);
+
+	if(file->dataFork.logicalSize > maxSize)
+		return -1;
+
+	io = openRawFile(file->fileID, &file->dataFork, (HFSPlusCatalogRecord*)file, volume);
+	if(io == NULL)
+		return -1;
+
+	ret = READ(io, 0, file->dataFork.logicalSize, location) ? file->dataFork.logicalSize : -1;
+	CLOSE(io);
+
+	return ret;
+}
+
 void hfs_ls(Volume* volume, const char* path) {
 	HFSPlusCatalogRecord* record;
 	char* name;
@@ -149,54 +318,39 @@ void hfs_ls(Volume* volume, const char* path) {
 
 void fs_cmd_ls(int argc, char** argv) {
 	Volume* volume;
-	io_func* io;
+	int partition;
 
 	if(argc < 2) {
 		bufferPrintf("usage: %s <partition> <directory>\r\n", argv[0]);
 		return;
 	}
 
-	io = bdev_open(parseNumber(argv[1]));
-	if(io == NULL) {
-		bufferPrintf("fs: cannot read partition!\r\n");
-		return;
-	}
-
-	volume = openVolume(io);
-	if(volume == NULL) {
-		bufferPrintf("fs: cannot openHFS volume!\r\n");
+	partition = parseNumber(argv[1]);
+	volume = fs_get(partition);
+	if(volume == NULL)
 		return;
-	}
 
 	if(argc > 2)
 		hfs_ls(volume, argv[2]);
 	else
 		hfs_ls(volume, "/");
 
-	closeVolume(volume);
-	CLOSE(io);
+	fs_put(partition, FALSE);
 }
 
 void fs_cmd_cat(int argc, char** argv) {
 	Volume* volume;
-	io_func* io;
+	int partition;
 
 	if(argc < 3) {
 		bufferPrintf("usage: %s <partition> <file>\r\n", argv[0]);
 		return;
 	}
 
-	io = bdev_open(parseNumber(argv[1]));
-	if(io == NULL) {
-		bufferPrintf("fs: cannot read partition!\r\n");
-		return;
-	}
-
-	volume = openVolume(io);
-	if(volume == NULL) {
-		bufferPrintf("fs: cannot openHFS volume!\r\n");
+	partition = parseNumber(argv[1]);
+	volume = fs_get(partition);
+	if(volume == NULL)
 		return;
-	}
 
 	HFSPlusCatalogRecord* record;
 
@@ -219,25 +373,16 @@ void fs_cmd_cat(int argc, char** argv) {
 	
 	free(record);
 
-	closeVolume(volume);
-	CLOSE(io);
+	fs_put(partition, FALSE);
 }
 
 int fs_extract(int partition, const char* file, void* location) {
 	Volume* volume;
-	io_func* io;
 	int ret;
 
-	io = bdev_open(partition);
-	if(io == NULL) {
-		bufferPrintf("fs: cannot read partition!\r\n");
+	volume = fs_get(partition);
+	if(volume == NULL)
 		return -1;
-	}
-
-	volume = openVolume(io);
-	if(volume == NULL) {
-		return -1;
-	}
 
 	HFSPlusCatalogRecord* record;
 
@@ -245,11 +390,7 @@ int fs_extract(int partition, const char* file, void* location) {
 
 	if(record != NULL) {
 		if(record->recordType == kHFSPlusFileRecord) {
-			uint8_t* buffer;
-			uint32_t size = readHFSFile((HFSPlusCatalogFile*)record, &buffer, volume);
-			memcpy(location, buffer, size);
-			free(buffer);
-			ret = size;
+			ret = readHFSFileInto((HFSPlusCatalogFile*)record, location, 0xFFFFFFFF, volume);
 		} else {
 			ret = -1;
 		}
@@ -259,32 +400,142 @@ int fs_extract(int partition, const char* file, void* location) {
 
 	free(record);
 
-	closeVolume(volume);
-	CLOSE(io);
+	fs_put(partition, FALSE);
+
+	return ret;
+}
+
+int fs_extract_max(int partition, const char* file, void* location, uint32_t maxSize) {
+	Volume* volume;
+	int ret = -1;
+
+	volume = fs_get(partition);
+	if(volume == NULL)
+		return -1;
+
+	HFSPlusCatalogRecord* record;
+
+	record = getRecordFromPath(file, volume, NULL, NULL);
+
+	if(record != NULL && record->recordType == kHFSPlusFileRecord) {
+		ret = readHFSFileInto((HFSPlusCatalogFile*)record, location, maxSize, volume);
+	}
+
+	free(record);
+
+	fs_put(partition, FALSE);
+
+	return ret;
+}
+
+int fs_store(int partition, const char* file, void* location, uint32_t size) {
+	Volume* volume;
+	int ret;
+
+	volume = fs_get(partition);
+	if(volume == NULL)
+		return FALSE;
+
+	ret = add_hfs(volume, (uint8_t*) location, size, file);
+
+	// what closeVolume used to write, now that the volume stays open
+	if(!flushAllocationBitmap(volume))
+		ret = FALSE;
+
+	fs_put(partition, TRUE);
+
+	if(!ftl_sync())
+	{
+		bufferPrintf("FTL sync error!\r\n");
+		ret = FALSE;
+	}
+
+	return ret;
+}
+
+// Each chunk is decompressed into the stream's buffer and handed over on its
+// own, so chunks must fit in FS_STREAM_CHUNK.
+static int streamCompressed(HFSPlusCatalogFile* file, FSStream* stream, Volume* volume) {
+	HFSPlusCompressed* data;
+	uint32_t chunk;
+	int ret;
+
+	data = openHFSPlusCompressed(volume, file);
+	if(data == NULL)
+		return -1;
+
+	stream->size = data->size;
+	ret = (data->chunkSize <= FS_STREAM_CHUNK) ? data->size : -1;
+	for(chunk = 0; ret >= 0 && chunk < data->numChunks; chunk++) {
+		int len = readHFSPlusCompressedChunk(data, chunk, stream->buffer);
+		if(len < 0 || stream->consume(stream, chunk * data->chunkSize, len) != 0)
+			ret = -1;
+	}
+
+	closeHFSPlusCompressed(data);
+	return ret;
+}
+
+int fs_extract_stream(int partition, const char* file, FSStream* stream) {
+	Volume* volume;
+	int ret = -1;
+
+	volume = fs_get(partition);
+	if(volume == NULL)
+		return -1;
+
+	HFSPlusCatalogRecord* record;
+
+	record = getRecordFromPath(file, volume, NULL, NULL);
+
+	if(record != NULL && record->recordType == kHFSPlusFileRecord && isHFSPlusCompressed((HFSPlusCatalogFile*) record)) {
+		ret = streamCompressed((HFSPlusCatalogFile*) record, stream, volume);
+	} else if(record != NULL && record->recordType == kHFSPlusFileRecord) {
+		HFSPlusCatalogFile* catalogFile = (HFSPlusCatalogFile*) record;
+		io_func* fileIO = openRawFile(catalogFile->fileID, &catalogFile->dataFork, record, volume);
+		if(fileIO != NULL) {
+			uint32_t size = catalogFile->dataFork.logicalSize;
+			uint32_t offset = 0;
+
+			stream->size = size;
+			ret = size;
+			while(offset < size) {
+				uint32_t len = size - offset;
+				if(len > FS_STREAM_CHUNK)
+					len = FS_STREAM_CHUNK;
+
+				if(!READ(fileIO, offset, len, stream->buffer) || stream->consume(stream, offset, len) != 0) {
+					ret = -1;
+					break;
+				}
+
+				offset += len;
+			}
+
+			CLOSE(fileIO);
+		}
+	}
+
+	free(record);
+
+	fs_put(partition, FALSE);
 
 	return ret;
 }
 
 void fs_cmd_extract(int argc, char** argv) {
 	Volume* volume;
-	io_func* io;
+	int partition;
 
 	if(argc < 4) {
 		bufferPrintf("usage: %s <partition> <file> <location>\r\n", argv[0]);
 		return;
 	}
 
-	io = bdev_open(parseNumber(argv[1]));
-	if(io == NULL) {
-		bufferPrintf("fs: cannot read partition!\r\n");
-		return;
-	}
-
-	volume = openVolume(io);
-	if(volume == NULL) {
-		bufferPrintf("fs: cannot openHFS volume!\r\n");
+	partition = parseNumber(argv[1]);
+	volume = fs_get(partition);
+	if(volume == NULL)
 		return;
-	}
 
 	HFSPlusCatalogRecord* record;
 
@@ -292,12 +543,12 @@ void fs_cmd_extract(int argc, char** argv) {
 
 	if(record != NULL) {
 		if(record->recordType == kHFSPlusFileRecord) {
-			uint8_t* buffer;
-			uint32_t size = readHFSFile((HFSPlusCatalogFile*)record, &buffer, volume);
 			uint32_t address = parseNumber(argv[3]);
-			memcpy((uint8_t*)address, buffer, size);
-			free(buffer);
-			bufferPrintf("%d bytes of %s extracted to 0x%x\r\n", size, argv[2], address);
+			int size = readHFSFileInto((HFSPlusCatalogFile*)record, (void*) address, 0xFFFFFFFF, volume);
+			if(size < 0)
+				bufferPrintf("Error reading %s\r\n", argv[2]);
+			else
+				bufferPrintf("%d bytes of %s extracted to 0x%x\r\n", size, argv[2], address);
 		} else {
 			bufferPrintf("Not a file, record type: %x\r\n", record->recordType);
 		}
@@ -307,35 +558,19 @@ void fs_cmd_extract(int argc, char** argv) {
 	
 	free(record);
 
-	closeVolume(volume);
-	CLOSE(io);
+	fs_put(partition, FALSE);
 }
 
 void fs_cmd_add(int argc, char** argv) {
-	Volume* volume;
-	io_func* io;
-
 	if(argc < 5) {
 		bufferPrintf("usage: %s <partition> <file> <location> <size>\r\n", argv[0]);
 		return;
 	}
 
-	io = bdev_open(parseNumber(argv[1]));
-	if(io == NULL) {
-		bufferPrintf("fs: cannot read partition!\r\n");
-		return;
-	}
-
-	volume = openVolume(io);
-	if(volume == NULL) {
-		bufferPrintf("fs: cannot openHFS volume!\r\n");
-		return;
-	}
-
 	uint32_t address = parseNumber(argv[3]);
 	uint32_t size = parseNumber(argv[4]);
 
-	if(add_hfs(volume, (uint8_t*) address, size, argv[2]))
+	if(fs_store(parseNumber(argv[1]), argv[2], (void*) address, size))
 	{
 		bufferPrintf("%d bytes of 0x%x stored in %s\r\n", size, address, argv[2]);
 	}
@@ -343,36 +578,21 @@ void fs_cmd_add(int argc, char** argv) {
 	{
 		bufferPrintf("add_hfs failed for %s!\r\n", argv[2]);
 	}
-
-	closeVolume(volume);
-	CLOSE(io);
-
-	if(!ftl_sync())
-	{
-		bufferPrintf("FTL sync error!\r\n");
-	}
 }
 
 ExtentList* fs_get_extents(int partition, const char* fileName) {
 	Volume* volume;
-	io_func* io;
 	unsigned int partitionStart;
 	unsigned int physBlockSize;
 	ExtentList* list = NULL;
 
-	io = bdev_open(partition);
-	if(io == NULL) {
+	volume = fs_get(partition);
+	if(volume == NULL)
 		return NULL;
-	}
 
 	physBlockSize = (nand_get_geometry())->bytesPerPage;
 	partitionStart = bdev_get_start(partition);
 
-	volume = openVolume(io);
-	if(volume == NULL) {
-		goto out;
-	}
-
 	HFSPlusCatalogRecord* record;
 
 	record = getRecordFromPath(fileName, volume, NULL, NULL);
@@ -397,6 +617,11 @@ ExtentList* fs_get_extents(int partition, const char* fileName) {
 				extent = extent->next;
 			}
 
+			if(numExtents > (sizeof(list->extents) / sizeof(ExtentListItem))) {
+				CLOSE(fileIO);
+				goto out_free;
+			}
+
 			list = (ExtentList*) malloc(sizeof(ExtentList));
 			list->numExtents = numExtents;
 
@@ -420,19 +645,60 @@ out_free:
 	free(record);
 
 out_close:
-	closeVolume(volume);
-
-out:
-	CLOSE(io);
+	fs_put(partition, FALSE);
 
 	return list;
 }
 
+// Streams the first size bytes of a file laid out as list (see fs_get_extents)
+// straight out of the FTL, without opening the volume.
+int fs_read_extents(ExtentList* list, uint32_t size, void* location) {
+	uint32_t bytesPerPage = (nand_get_geometry())->bytesPerPage;
+	uint8_t* buffer = (uint8_t*) location;
+	uint8_t* lastPage = NULL;
+	int i;
+
+	for(i = 0; i < list->numExtents && size > 0; i++) {
+		uint32_t page = list->extents[i].startBlock;
+		uint32_t pages = list->extents[i].blockCount;
+		uint32_t whole = size / bytesPerPage;
+
+		if(whole > pages)
+			whole = pages;
+
+		if(whole > 0) {
+			if(FTL_Read(page, whole, buffer) != 0)
+				break;
+
+			buffer += whole * bytesPerPage;
+			size -= whole * bytesPerPage;
+			page += whole;
+			pages -= whole;
+		}
+
+		// the tail of the file does not fill its last page
+		if(size > 0 && size < bytesPerPage && pages > 0) {
+			lastPage = (uint8_t*) malloc(bytesPerPage);
+			if(lastPage == NULL || FTL_Read(page, 1, lastPage) != 0)
+				break;
+
+			memcpy(buffer, lastPage, size);
+			size = 0;
+		}
+	}
+
+	if(lastPage)
+		free(lastPage);
+
+	return (size == 0) ? 0 : -1;
+}
+
 int fs_setup() {
 	if(HasFSInit)
 		return 0;
 
 	bdev_setup();
+	mutex_init(&FSLock);
 
 	HasFSInit = TRUE;
 
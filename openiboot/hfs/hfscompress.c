@@ -0,0 +1,168 @@
+#include "hfs/hfsplus.h"
+#include "hfs/hfscompress.h"
+#include "inflate.h"
+
+int isHFSPlusCompressed(HFSPlusCatalogFile* file) {
+	return (file->permissions.ownerFlags & UF_COMPRESSED) != 0;
+}
+
+// A chunk that would not get any smaller is stored as it is, after a byte
+// with the low nibble set where the zlib header would be.
+static int decompressChunk(uint8_t* input, uint32_t inputSize, uint8_t* output, uint32_t outputSize) {
+	if(inputSize == 0)
+		return FALSE;
+
+	if((input[0] & 0x0F) == 0x0F) {
+		if((inputSize - 1) < outputSize)
+			return FALSE;
+
+		memcpy(output, input + 1, outputSize);
+		return TRUE;
+	}
+
+	return inflate_buffer(output, outputSize, input, inputSize, TRUE) == (int) outputSize;
+}
+
+static int openResourceChunks(HFSPlusCompressed* data, Volume* volume, HFSPlusCatalogFile* file) {
+	HFSPlusCmpfRsrcHead head;
+	uint32_t numChunks;
+	uint32_t maxSize;
+	uint32_t i;
+
+	data->rsrc = openRawFile(file->fileID, &file->resourceFork, (HFSPlusCatalogRecord*)file, volume);
+	if(data->rsrc == NULL)
+		return FALSE;
+
+	if(!READ(data->rsrc, 0, sizeof(head), &head))
+		return FALSE;
+
+	FLIPENDIAN(head.headerSize);
+	FLIPENDIAN(head.totalSize);
+	FLIPENDIAN(head.dataSize);
+	FLIPENDIAN(head.flags);
+
+	// the chunk table follows the size of the data, and chunks are placed from there
+	data->chunksStart = head.headerSize + sizeof(uint32_t);
+	if(!READ(data->rsrc, data->chunksStart, sizeof(numChunks), &numChunks))
+		return FALSE;
+
+	FLIPENDIANLE(numChunks);
+	if(numChunks != data->numChunks)
+		return FALSE;
+
+	data->chunks = (HFSPlusCmpfRsrcBlock*) malloc(numChunks * sizeof(HFSPlusCmpfRsrcBlock));
+	if(data->chunks == NULL)
+		return FALSE;
+
+	if(!READ(data->rsrc, data->chunksStart + sizeof(numChunks), numChunks * sizeof(HFSPlusCmpfRsrcBlock), data->chunks))
+		return FALSE;
+
+	maxSize = 0;
+	for(i = 0; i < numChunks; i++) {
+		FLIPENDIANLE(data->chunks[i].offset);
+		FLIPENDIANLE(data->chunks[i].size);
+		if(data->chunks[i].size > maxSize)
+			maxSize = data->chunks[i].size;
+	}
+
+	// a stored chunk is one byte bigger than what it holds, anything else is garbage
+	if(maxSize > (CMPFS_CHUNK_SIZE + 1))
+		return FALSE;
+
+	data->input = (uint8_t*) malloc(maxSize);
+	return data->input != NULL;
+}
+
+HFSPlusCompressed* openHFSPlusCompressed(Volume* volume, HFSPlusCatalogFile* file) {
+	HFSPlusCompressed* data;
+	HFSPlusDecmpfs* header;
+
+	data = (HFSPlusCompressed*) malloc(sizeof(HFSPlusCompressed));
+	if(data == NULL)
+		return NULL;
+
+	memset(data, 0, sizeof(HFSPlusCompressed));
+
+	data->decmpfsSize = getAttribute(volume, file->fileID, CMPFS_ATTRIBUTE, &data->decmpfs);
+	if(data->decmpfsSize < sizeof(HFSPlusDecmpfs)) {
+		bufferPrintf("hfs: compressed file %d has no %s\r\n", file->fileID, CMPFS_ATTRIBUTE);
+		closeHFSPlusCompressed(data);
+		return NULL;
+	}
+
+	header = (HFSPlusDecmpfs*) data->decmpfs;
+	FLIPENDIANLE(header->magic);
+	FLIPENDIANLE(header->flags);
+	FLIPENDIANLE(header->size);
+
+	if(header->magic != CMPFS_MAGIC || header->size > 0xFFFFFFFF) {
+		bufferPrintf("hfs: compressed file %d has a bad %s\r\n", file->fileID, CMPFS_ATTRIBUTE);
+		closeHFSPlusCompressed(data);
+		return NULL;
+	}
+
+	data->type = header->flags;
+	data->size = header->size;
+
+	if(data->type == CMPFS_INLINE_ZLIB) {
+		// one zlib stream, right after the header
+		data->chunkSize = data->size;
+		data->numChunks = (data->size > 0) ? 1 : 0;
+	} else if(data->type == CMPFS_RESOURCE_ZLIB) {
+		data->chunkSize = CMPFS_CHUNK_SIZE;
+		data->numChunks = (data->size + CMPFS_CHUNK_SIZE - 1) / CMPFS_CHUNK_SIZE;
+		if(!openResourceChunks(data, volume, file)) {
+			bufferPrintf("hfs: compressed file %d has a bad resource fork\r\n", file->fileID);
+			closeHFSPlusCompressed(data);
+			return NULL;
+		}
+	} else {
+		bufferPrintf("hfs: compressed file %d is of unsupported type %d\r\n", file->fileID, data->type);
+		closeHFSPlusCompressed(data);
+		return NULL;
+	}
+
+	return data;
+}
+
+// Decompresses chunk into buffer, which has room for chunkSize bytes. Returns
+// how many it holds now, or -1.
+int readHFSPlusCompressedChunk(HFSPlusCompressed* data, uint32_t chunk, uint8_t* buffer) {
+	uint32_t length;
+	uint8_t* input;
+	uint32_t inputSize;
+
+	if(chunk >= data->numChunks)
+		return -1;
+
+	length = data->size - (chunk * data->chunkSize);
+	if(length > data->chunkSize)
+		length = data->chunkSize;
+
+	if(data->type == CMPFS_INLINE_ZLIB) {
+		input = data->decmpfs + sizeof(HFSPlusDecmpfs);
+		inputSize = data->decmpfsSize - sizeof(HFSPlusDecmpfs);
+	} else {
+		input = data->input;
+		inputSize = data->chunks[chunk].size;
+		if(!READ(data->rsrc, data->chunksStart + data->chunks[chunk].offset, inputSize, input))
+			return -1;
+	}
+
+	if(!decompressChunk(input, inputSize, buffer, length)) {
+		bufferPrintf("hfs: chunk %d of a compressed file does not decompress\r\n", chunk);
+		return -1;
+	}
+
+	return length;
+}
+
+void closeHFSPlusCompressed(HFSPlusCompressed* data) {
+	if(data->rsrc)
+		CLOSE(data->rsrc);
+
+	free(data->decmpfs);
+	free(data->chunks);
+	free(data->input);
+	free(data);
+}
@@ -2,30 +2,308 @@
 
 int writeExtents(RawFile* rawFile);
 
+static void invalidateExtentRuns(RawFile* rawFile) {
+	if(rawFile->runs != NULL) {
+		free(rawFile->runs);
+		rawFile->runs = NULL;
+	}
+	rawFile->numRuns = 0;
+}
+
+// Flatten the extent list into a sorted table, merging extents that are
+// adjacent on disk so a sequential read becomes one READ per run.
+static int buildExtentRuns(RawFile* rawFile) {
+	Extent* extent;
+	ExtentRun* run;
+	uint32_t count;
+	uint32_t fileBlock;
+
+	count = 0;
+	for(extent = rawFile->extents; extent != NULL; extent = extent->next)
+		count++;
+
+	if(count == 0)
+		return FALSE;
+
+	rawFile->runs = (ExtentRun*) malloc(sizeof(ExtentRun) * count);
+	if(rawFile->runs == NULL)
+		return FALSE;
+
+	run = NULL;
+	fileBlock = 0;
+	for(extent = rawFile->extents; extent != NULL; extent = extent->next) {
+		if(extent->blockCount == 0)
+			continue;
+
+		if(run != NULL && (run->startBlock + run->blockCount) == extent->startBlock) {
+			run->blockCount += extent->blockCount;
+		} else {
+			run = (run == NULL) ? rawFile->runs : (run + 1);
+			run->fileBlock = fileBlock;
+			run->startBlock = extent->startBlock;
+			run->blockCount = extent->blockCount;
+		}
+
+		fileBlock += extent->blockCount;
+	}
+
+	rawFile->numRuns = (run == NULL) ? 0 : (run - rawFile->runs + 1);
+	return TRUE;
+}
+
+static ExtentRun* findExtentRun(RawFile* rawFile, uint32_t block) {
+	uint32_t lo;
+	uint32_t hi;
+	uint32_t mid;
+	ExtentRun* run;
+
+	lo = 0;
+	hi = rawFile->numRuns;
+	while(lo < hi) {
+		mid = lo + (hi - lo) / 2;
+		run = &rawFile->runs[mid];
+		if(block < run->fileBlock) {
+			hi = mid;
+		} else if(block >= (run->fileBlock + run->blockCount)) {
+			lo = mid + 1;
+		} else {
+			return run;
+		}
+	}
+
+	return NULL;
+}
+
+// The allocation bitmap is read into memory the first time a block is tested
+// and written back in ALLOCATION_CHUNK pieces by flushAllocationBitmap. If
+// it cannot be allocated, every test goes to the allocation file as before.
+
+#ifndef ALLOCATION_CHUNK
+#define ALLOCATION_CHUNK 4096
+#endif
+
+#ifndef ALLOCATE_ZERO_BLOCKS
+#define ALLOCATE_ZERO_BLOCKS 16
+#endif
+
+static int loadAllocationBitmap(Volume* volume) {
+	uint32_t size;
+	uint32_t chunks;
+
+	if(volume->allocationBitmap != NULL)
+		return TRUE;
+
+	size = (volume->volumeHeader->totalBlocks + 7) / 8;
+	chunks = (size + ALLOCATION_CHUNK - 1) / ALLOCATION_CHUNK;
+
+	// padded to a whole word that reads as used, so the scans need no tail case
+	volume->allocationBitmap = (uint8_t*) malloc((size + 3) & ~3);
+	volume->allocationDirty = (uint8_t*) malloc(chunks);
+	if(volume->allocationBitmap == NULL || volume->allocationDirty == NULL) {
+		releaseAllocationBitmap(volume);
+		return FALSE;
+	}
+
+	memset(volume->allocationBitmap + size, 0xFF, ((size + 3) & ~3) - size);
+	memset(volume->allocationDirty, 0, chunks);
+
+	if(!READ(volume->allocationFile, 0, size, volume->allocationBitmap)) {
+		releaseAllocationBitmap(volume);
+		return FALSE;
+	}
+
+	volume->allocationBitmapSize = size;
+	return TRUE;
+}
+
+void releaseAllocationBitmap(Volume* volume) {
+	if(volume->allocationBitmap)
+		free(volume->allocationBitmap);
+	if(volume->allocationDirty)
+		free(volume->allocationDirty);
+
+	volume->allocationBitmap = NULL;
+	volume->allocationDirty = NULL;
+}
+
+int flushAllocationBitmap(Volume* volume) {
+	uint32_t chunks;
+	uint32_t chunk;
+	uint32_t last;
+
+	if(volume->allocationBitmap == NULL)
+		return TRUE;
+
+	chunks = (volume->allocationBitmapSize + ALLOCATION_CHUNK - 1) / ALLOCATION_CHUNK;
+	for(chunk = 0; chunk < chunks; chunk++) {
+		if(!volume->allocationDirty[chunk])
+			continue;
+
+		// neighbouring dirty chunks go out in one write
+		for(last = chunk; (last + 1) < chunks && volume->allocationDirty[last + 1]; last++)
+			volume->allocationDirty[last + 1] = FALSE;
+		volume->allocationDirty[chunk] = FALSE;
+
+		uint32_t offset = chunk * ALLOCATION_CHUNK;
+		uint32_t size = ((last + 1) * ALLOCATION_CHUNK) - offset;
+		if((offset + size) > volume->allocationBitmapSize)
+			size = volume->allocationBitmapSize - offset;
+
+		if(!WRITE(volume->allocationFile, offset, size, volume->allocationBitmap + offset))
+			return FALSE;
+
+		chunk = last;
+	}
+
+	return TRUE;
+}
+
 int isBlockUsed(Volume* volume, uint32_t block)
 {
 	unsigned char byte;
 
-	READ(volume->allocationFile, block / 8, 1, &byte);
+	if(loadAllocationBitmap(volume))
+		byte = volume->allocationBitmap[block / 8];
+	else
+		READ(volume->allocationFile, block / 8, 1, &byte);
+
 	return (byte & (1 << (7 - (block % 8)))) != 0;
 }
 
 int setBlockUsed(Volume* volume, uint32_t block, int used) {
 	unsigned char byte;
+	int cached = loadAllocationBitmap(volume);
+
+	if(cached)
+		byte = volume->allocationBitmap[block / 8];
+	else
+		READ(volume->allocationFile, block / 8, 1, &byte);
 
-	READ(volume->allocationFile, block / 8, 1, &byte);
 	if(used) {
 		byte |= (1 << (7 - (block % 8)));
 	} else {
 		byte &= ~(1 << (7 - (block % 8)));
 	}
-	ASSERT(WRITE(volume->allocationFile, block / 8, 1, &byte), "WRITE");
+
+	if(cached) {
+		volume->allocationBitmap[block / 8] = byte;
+		volume->allocationDirty[(block / 8) / ALLOCATION_CHUNK] = TRUE;
+	} else {
+		ASSERT(WRITE(volume->allocationFile, block / 8, 1, &byte), "WRITE");
+	}
 
 	return TRUE;
 }
 
+// First block in [start, end) that is used (or free), or end if there is none.
+static uint32_t scanBitmap(Volume* volume, uint32_t start, uint32_t end, int used) {
+	uint8_t* bitmap = volume->allocationBitmap;
+	uint32_t skip = used ? 0 : 0xFFFFFFFF;
+	uint32_t block = start;
+
+	if(bitmap == NULL) {
+		while(block < end && isBlockUsed(volume, block) != used)
+			block++;
+		return block;
+	}
+
+	while(block < end) {
+		if((block % 32) == 0) {
+			// whole words with nothing of interest are skipped at once
+			if(*((uint32_t*)(bitmap + (block / 8))) == skip) {
+				block += 32;
+				continue;
+			}
+		}
+
+		uint8_t bits = (used ? bitmap[block / 8] : ~bitmap[block / 8]) & (0xFF >> (block % 8));
+		if(bits == 0) {
+			block = (block + 8) & ~7;
+			continue;
+		}
+
+		block = (block & ~7) + (__builtin_clz(bits) - 24);
+		break;
+	}
+
+	return (block < end) ? block : end;
+}
+
+// Looks for a free run of at least wanted blocks, starting at start and
+// wrapping around the end of the volume. If there is none, the longest run
+// is returned instead. Returns the length of the run, 0 if the volume is full.
+static uint32_t findFreeRun(Volume* volume, uint32_t start, uint32_t wanted, uint32_t* runStart) {
+	uint32_t total = volume->volumeHeader->totalBlocks;
+	uint32_t best = 0;
+	int pass;
+
+	loadAllocationBitmap(volume);
+
+	for(pass = 0; pass < 2; pass++) {
+		uint32_t end = (pass == 0) ? total : start;
+		uint32_t block = scanBitmap(volume, (pass == 0) ? start : 0, end, FALSE);
+
+		while(block < end) {
+			uint32_t limit = ((end - block) > wanted) ? (block + wanted) : end;
+			uint32_t runEnd = scanBitmap(volume, block, limit, TRUE);
+
+			if((runEnd - block) > best) {
+				best = runEnd - block;
+				*runStart = block;
+				if(best >= wanted)
+					return best;
+			}
+
+			block = scanBitmap(volume, runEnd, end, FALSE);
+		}
+	}
+
+	return best;
+}
+
+// Writes zeros over count blocks from start, several blocks per write.
+// Tells the flash underneath that freed blocks hold nothing worth keeping.
+static void discardBlocks(Volume* volume, uint32_t start, uint32_t count) {
+	uint32_t blockSize = volume->volumeHeader->blockSize;
+
+	if(count == 0 || volume->image->discard == NULL)
+		return;
+
+	volume->image->discard(volume->image, ((uint64_t)start) * blockSize, count * blockSize);
+}
+
+static int zeroBlocks(Volume* volume, uint32_t start, uint32_t count) {
+	uint32_t blockSize = volume->volumeHeader->blockSize;
+	uint32_t perWrite = (count > ALLOCATE_ZERO_BLOCKS) ? ALLOCATE_ZERO_BLOCKS : count;
+	unsigned char* zeros = (unsigned char*) malloc(perWrite * blockSize);
+
+	if(zeros == NULL)
+		return FALSE;
+
+	memset(zeros, 0, perWrite * blockSize);
+	while(count > 0) {
+		uint32_t blocks = (count > perWrite) ? perWrite : count;
+		if(!WRITE(volume->image, ((uint64_t)start) * blockSize, blocks * blockSize, zeros)) {
+			free(zeros);
+			return FALSE;
+		}
+
+		start += blocks;
+		count -= blocks;
+	}
+
+	free(zeros);
+	return TRUE;
+}
+
 int allocate(RawFile* rawFile, off_t size) {
-	unsigned char* zeros;
+	return allocate2(rawFile, size, TRUE);
+}
+
+// Grows or shrinks the file to size. New space is taken as whole free runs,
+// one extent each. Unless zero is set, only the slack in the last block is
+// cleared, for callers that are about to write over the rest.
+int allocate2(RawFile* rawFile, off_t size, int zero) {
 	Volume* volume;
 	HFSPlusForkData* forkData;
 	uint32_t blocksNeeded;
@@ -41,9 +319,12 @@ int allocate(RawFile* rawFile, off_t size) {
 
 	blocksNeeded = ((uint64_t)size / (uint64_t)volume->volumeHeader->blockSize) + (((size % volume->volumeHeader->blockSize) == 0) ? 0 : 1);
 
+	if(blocksNeeded != forkData->totalBlocks) {
+		invalidateExtentRuns(rawFile);
+	}
+
 	if(blocksNeeded > forkData->totalBlocks) {
-		zeros = (unsigned char*) malloc(volume->volumeHeader->blockSize);
-		memset(zeros, 0, volume->volumeHeader->blockSize);
+		uint32_t totalBlocks = volume->volumeHeader->totalBlocks;
 
 		blocksToAllocate = blocksNeeded - forkData->totalBlocks;
 
@@ -68,39 +349,53 @@ int allocate(RawFile* rawFile, off_t size) {
 		}
 
 		while(blocksToAllocate > 0) {
-			if(isBlockUsed(volume, curBlock)) {
+			uint32_t runStart = curBlock;
+			uint32_t runLength = 0;
+			uint32_t i;
+
+			// the last extent just grows if the blocks right after it are free
+			if(lastExtent->blockCount > 0 && curBlock < totalBlocks) {
+				uint32_t limit = ((totalBlocks - curBlock) > blocksToAllocate) ? (curBlock + blocksToAllocate) : totalBlocks;
+				runLength = scanBitmap(volume, curBlock, limit, TRUE) - curBlock;
+			}
+
+			if(runLength == 0) {
+				runLength = findFreeRun(volume, volume->volumeHeader->nextAllocation, blocksToAllocate, &runStart);
+				if(runLength == 0)
+					return FALSE;
+
+				if(runLength > blocksToAllocate)
+					runLength = blocksToAllocate;
+
 				if(lastExtent->blockCount > 0) {
 					lastExtent->next = (Extent*) malloc(sizeof(Extent));
 					lastExtent = lastExtent->next;
 					lastExtent->blockCount = 0;
 					lastExtent->next = NULL;
 				}
-				curBlock = volume->volumeHeader->nextAllocation;
-				volume->volumeHeader->nextAllocation++;
-				if(volume->volumeHeader->nextAllocation >= volume->volumeHeader->totalBlocks) {
-					volume->volumeHeader->nextAllocation = 0;
-				}
-			} else {
-				if(lastExtent->blockCount == 0) {
-					lastExtent->startBlock = curBlock;
-				}
 
-				/* zero out allocated block */
-				ASSERT(WRITE(volume->image, ((uint64_t)curBlock) * volume->volumeHeader->blockSize, volume->volumeHeader->blockSize, zeros), "WRITE");
-
-				setBlockUsed(volume, curBlock, TRUE);
-				volume->volumeHeader->freeBlocks--;
-				blocksToAllocate--;
-				curBlock++;
-				lastExtent->blockCount++;
+				lastExtent->startBlock = runStart;
+			}
 
-				if(curBlock >= volume->volumeHeader->totalBlocks) {
-					curBlock = volume->volumeHeader->nextAllocation;
-				}
+			if(zero) {
+				ASSERT(zeroBlocks(volume, runStart, runLength), "zeroBlocks");
 			}
+
+			for(i = 0; i < runLength; i++)
+				setBlockUsed(volume, runStart + i, TRUE);
+
+			volume->volumeHeader->freeBlocks -= runLength;
+			blocksToAllocate -= runLength;
+			lastExtent->blockCount += runLength;
+			curBlock = runStart + runLength;
+
+			volume->volumeHeader->nextAllocation = (curBlock >= totalBlocks) ? 0 : curBlock;
 		}
 
-		free(zeros);
+		// whatever the caller writes, nothing past the end of the file may show old data later
+		if(!zero && (size % volume->volumeHeader->blockSize) != 0) {
+			ASSERT(zeroBlocks(volume, curBlock - 1, 1), "zeroBlocks");
+		}
 	} else if(blocksNeeded < forkData->totalBlocks) {
 		blocksToAllocate = blocksNeeded;
 
@@ -129,6 +424,7 @@ int allocate(RawFile* rawFile, off_t size) {
 				setBlockUsed(volume, curBlock, FALSE);
 				volume->volumeHeader->freeBlocks++;
 			}
+			discardBlocks(volume, extent->startBlock + blocksToAllocate, extent->blockCount - blocksToAllocate);
 			lastExtent = extent;
 			extent = extent->next;
 
@@ -158,112 +454,71 @@ int allocate(RawFile* rawFile, off_t size) {
 	return TRUE;
 }
 
-static int rawFileRead(io_func* io,off_t location, size_t size, void *buffer) {
-	RawFile* rawFile;
+static int rawFileTransfer(RawFile* rawFile, off_t location, size_t size, void* buffer, int write) {
 	Volume* volume;
-	Extent* extent;
+	ExtentRun* run;
+	ExtentRun* lastRun;
 
 	size_t blockSize;
-	off_t fileLoc;
-	off_t locationInBlock;
-	size_t possible;
+	off_t locationInRun;
+	off_t possible;
+	off_t diskLocation;
 
-	rawFile = (RawFile*) io->data;
 	volume = rawFile->volume;
 	blockSize = volume->volumeHeader->blockSize;
 
-	extent = rawFile->extents;
-	fileLoc = 0;
+	if(size == 0)
+		return TRUE;
 
-	locationInBlock = location;
-	while(TRUE) {
-		fileLoc += extent->blockCount * blockSize;
-		if(fileLoc <= location) {
-			locationInBlock -= extent->blockCount * blockSize;
-			extent = extent->next;
-			if(extent == NULL)
-				break;
-		} else {
-			break;
-		}
-	}
+	if(rawFile->runs == NULL && !buildExtentRuns(rawFile))
+		return FALSE;
+
+	run = findExtentRun(rawFile, location / blockSize);
+	if(run == NULL)
+		return FALSE;
+
+	lastRun = rawFile->runs + rawFile->numRuns;
+	locationInRun = location - ((off_t)run->fileBlock) * blockSize;
 
 	while(size > 0) {
-		if(extent == NULL)
+		if(run >= lastRun)
 			return FALSE;
 
-		possible = extent->blockCount * blockSize - locationInBlock;
+		possible = ((off_t)run->blockCount) * blockSize - locationInRun;
+		if(possible > size)
+			possible = size;
 
-		if(size > possible) {
-			ASSERT(READ(volume->image, ((uint64_t)extent->startBlock) * blockSize + locationInBlock, possible, buffer), "READ");
-			size -= possible;
-			buffer = (void*)(((size_t)buffer) + possible);
-			extent = extent->next;
+		diskLocation = ((off_t)run->startBlock) * blockSize + locationInRun;
+		if(write) {
+			ASSERT(WRITE(volume->image, diskLocation, possible, buffer), "WRITE");
 		} else {
-			ASSERT(READ(volume->image, ((uint64_t)extent->startBlock) * blockSize + locationInBlock, size, buffer), "READ");
-			break;
+			ASSERT(READ(volume->image, diskLocation, possible, buffer), "READ");
 		}
 
-		locationInBlock = 0;
+		size -= possible;
+		buffer = (void*)(((size_t)buffer) + (size_t)possible);
+		locationInRun = 0;
+		run++;
 	}
 
 	return TRUE;
 }
 
+static int rawFileRead(io_func* io,off_t location, size_t size, void *buffer) {
+	return rawFileTransfer((RawFile*) io->data, location, size, buffer, FALSE);
+}
+
 static int rawFileWrite(io_func* io,off_t location, size_t size, void *buffer) {
 	RawFile* rawFile;
-	Volume* volume;
-	Extent* extent;
-
-	size_t blockSize;
-	off_t fileLoc;
-	off_t locationInBlock;
-	size_t possible;
 
 	rawFile = (RawFile*) io->data;
-	volume = rawFile->volume;
-	blockSize = volume->volumeHeader->blockSize;
 
 	if(rawFile->forkData->logicalSize < (location + size)) {
-		ASSERT(allocate(rawFile, location + size), "allocate");
+		// the new blocks only need zeros if this write leaves a hole before it
+		ASSERT(allocate2(rawFile, location + size, location > rawFile->forkData->logicalSize), "allocate2");
 	}
 
-	extent = rawFile->extents;
-	fileLoc = 0;
-
-	locationInBlock = location;
-	while(TRUE) {
-		fileLoc += extent->blockCount * blockSize;
-		if(fileLoc <= location) {
-			locationInBlock -= extent->blockCount * blockSize;
-			extent = extent->next;
-			if(extent == NULL)
-				break;
-		} else {
-			break;
-		}
-	}
-
-	while(size > 0) {
-		if(extent == NULL)
-			return FALSE;
-
-		possible = extent->blockCount * blockSize - locationInBlock;
-
-		if(size > possible) {
-			ASSERT(WRITE(volume->image, ((uint64_t)extent->startBlock) * blockSize + locationInBlock, possible, buffer), "WRITE");
-			size -= possible;
-			buffer = (void*)(((size_t)buffer) + possible);
-			extent = extent->next;
-		} else {
-			ASSERT(WRITE(volume->image, ((uint64_t)extent->startBlock) * blockSize + locationInBlock, size, buffer), "WRITE");
-			break;
-		}
-
-		locationInBlock = 0;
-	}
-
-	return TRUE;
+	return rawFileTransfer(rawFile, location, size, buffer, TRUE);
 }
 
 static void closeRawFile(io_func* io) {
@@ -280,6 +535,7 @@ static void closeRawFile(io_func* io) {
 		free(toRemove);
 	}
 
+	invalidateExtentRuns(rawFile);
 	free(rawFile);
 	free(io);
 }
@@ -352,6 +608,7 @@ int writeExtents(RawFile* rawFile) {
 	HFSPlusExtentDescriptor descriptor[8];
 	HFSPlusForkData* forkData;
 
+	invalidateExtentsCache(rawFile->volume);
 	removeExtents(rawFile);
 
 	forkData = rawFile->forkData;
@@ -407,52 +664,48 @@ int readExtents(RawFile* rawFile) {
 	Extent* lastExtent;
 
 	HFSPlusExtentDescriptor* descriptor;
-	int currentExtent;
-	HFSPlusExtentKey extentKey;
-	int exact;
-
-	extentKey.keyLength = sizeof(HFSPlusExtentKey) - sizeof(extentKey.keyLength);
-	extentKey.forkType = 0;
-	extentKey.fileID = rawFile->id;
+	uint32_t descriptors;
+	uint32_t currentExtent;
 
 	forkData = rawFile->forkData;
 	blocksLeft = forkData->totalBlocks;
 	currentExtent = 0;
 	currentBlock = 0;
 	descriptor = (HFSPlusExtentDescriptor*) forkData->extents;
+	descriptors = 8;
 
 	lastExtent = NULL;
 
 	while(blocksLeft > 0) {
-		extent = (Extent*) malloc(sizeof(Extent));
+		if(currentExtent == descriptors) {
+			if(descriptor != ((HFSPlusExtentDescriptor*) forkData->extents)) {
+				hfs_panic("inconsistent extents information!");
+				return FALSE;
+			}
 
-		if(currentExtent == 8) {
 			if(rawFile->volume->extentsTree == NULL) {
 				hfs_panic("no extents overflow file loaded yet!");
 				return FALSE;
 			}
 
-			if(descriptor != ((HFSPlusExtentDescriptor*) forkData->extents)) {
-				free(descriptor);
-			}
-
-			extentKey.startBlock = currentBlock;
-			descriptor = (HFSPlusExtentDescriptor*) search(rawFile->volume->extentsTree, (BTKey*)(&extentKey), &exact, NULL, NULL);
-			if(descriptor == NULL || exact == FALSE) {
+			// the rest all at once, from the cache if this file was opened before
+			descriptor = getOverflowExtents(rawFile->volume, rawFile->id, currentBlock, blocksLeft, &descriptors);
+			if(descriptor == NULL) {
 				hfs_panic("inconsistent extents information!");
 				return FALSE;
-			} else {
-				currentExtent = 0;
-				continue;
 			}
+
+			currentExtent = 0;
+			continue;
 		}
 
+		extent = (Extent*) malloc(sizeof(Extent));
 		extent->startBlock = descriptor[currentExtent].startBlock;
 		extent->blockCount = descriptor[currentExtent].blockCount;
 		extent->next = NULL;
 
 		currentBlock += extent->blockCount;
-		blocksLeft -= extent->blockCount;
+		blocksLeft -= (extent->blockCount > blocksLeft) ? blocksLeft : extent->blockCount;
 		currentExtent++;
 
 		if(lastExtent == NULL) {
@@ -464,10 +717,6 @@ int readExtents(RawFile* rawFile) {
 		lastExtent = extent;
 	}
 
-	if(descriptor != ((HFSPlusExtentDescriptor*) forkData->extents)) {
-		free(descriptor);
-	}
-
 	return TRUE;
 }
 
@@ -483,11 +732,14 @@ io_func* openRawFile(HFSCatalogNodeID id, HFSPlusForkData* forkData, HFSPlusCata
 	rawFile->forkData = forkData;
 	rawFile->catalogRecord = catalogRecord;
 	rawFile->extents = NULL;
+	rawFile->runs = NULL;
+	rawFile->numRuns = 0;
 
 	io->data = rawFile;
 	io->read = &rawFileRead;
 	io->write = &rawFileWrite;
 	io->close = &closeRawFile;
+	io->discard = NULL;
 
 	if(!readExtents(rawFile)) {
 		return NULL;
@@ -92,11 +92,52 @@ static int writeVolumeHeader(io_func* io, HFSPlusVolumeHeader* volumeHeaderToWri
 }
 
 int updateVolume(Volume* volume) {
+	if(volume->transaction > 0) {
+		volume->headerDirty = TRUE;
+		return TRUE;
+	}
+
+	ASSERT(flushAllocationBitmap(volume), "flushAllocationBitmap");
 	ASSERT(writeVolumeHeader(volume->image, volume->volumeHeader,
 				((off_t)volume->volumeHeader->totalBlocks * (off_t)volume->volumeHeader->blockSize) - 1024), "writeVolumeHeader");
 	return writeVolumeHeader(volume->image, volume->volumeHeader, 1024);
 }
 
+// Until the outermost commit, B-tree nodes are only written when their cache
+// fills up, and the allocation bitmap and volume header not at all. Adding a
+// file rewrites the same few nodes many times over, each a read-modify-write
+// of a whole FTL page, so this saves most of those writes.
+void beginVolumeTransaction(Volume* volume) {
+	if(volume->transaction++ > 0)
+		return;
+
+	setBTreeWriteBack(volume->extentsTree, TRUE);
+	setBTreeWriteBack(volume->catalogTree, TRUE);
+}
+
+// The trees go out first and the header last, which is the order they have to
+// be read back in.
+int commitVolumeTransaction(Volume* volume) {
+	int ret = TRUE;
+
+	if(volume->transaction == 0 || --volume->transaction > 0)
+		return TRUE;
+
+	if(!setBTreeWriteBack(volume->extentsTree, FALSE))
+		ret = FALSE;
+
+	if(!setBTreeWriteBack(volume->catalogTree, FALSE))
+		ret = FALSE;
+
+	if(volume->headerDirty) {
+		volume->headerDirty = FALSE;
+		if(!updateVolume(volume))
+			ret = FALSE;
+	}
+
+	return ret;
+}
+
 Volume* openVolume(io_func* io) {
 	Volume* volume;
 	io_func* file;
@@ -104,6 +145,13 @@ Volume* openVolume(io_func* io) {
 	volume = (Volume*) malloc(sizeof(Volume));
 	volume->image = io;
 	volume->extentsTree = NULL;
+	volume->attrTree = NULL;
+	volume->allocationBitmap = NULL;
+	volume->allocationDirty = NULL;
+	volume->transaction = 0;
+	volume->headerDirty = FALSE;
+	volume->extentsCache = NULL;
+	volume->extentsCacheCount = 0;
 
 	volume->volumeHeader = readVolumeHeader(io, 1024);
 	if(volume->volumeHeader == NULL) {
@@ -141,6 +189,13 @@ Volume* openVolume(io_func* io) {
 		return NULL;
 	}
 
+	// only needed for compressed files, so a volume without one still opens
+	if(volume->volumeHeader->attributesFile.logicalSize != 0) {
+		file = openRawFile(kHFSAttributesFileID, &volume->volumeHeader->attributesFile, NULL, volume);
+		if(file != NULL)
+			volume->attrTree = openAttributesTree(file);
+	}
+
 	volume->allocationFile = openRawFile(kHFSAllocationFileID, &volume->volumeHeader->allocationFile, NULL, volume);
 	if(volume->catalogTree == NULL) {
 		closeBTree(volume->catalogTree);
@@ -154,7 +209,17 @@ Volume* openVolume(io_func* io) {
 }
 
 void closeVolume(Volume *volume) {
+	if(volume->transaction > 0) {
+		volume->transaction = 1;
+		commitVolumeTransaction(volume);
+	}
+
+	invalidateExtentsCache(volume);
+	flushAllocationBitmap(volume);
+	releaseAllocationBitmap(volume);
 	CLOSE(volume->allocationFile);
+	if(volume->attrTree)
+		closeBTree(volume->attrTree);
 	closeBTree(volume->catalogTree);
 	closeBTree(volume->extentsTree);
 	free(volume->volumeHeader);
@@ -0,0 +1,137 @@
+#include "hfs/hfsplus.h"
+
+// The attributes B-tree, as far as reading inline attributes goes. That is all
+// the compressed file support needs, so nothing in here writes to it.
+
+static int attrCompare(BTKey* vLeft, BTKey* vRight) {
+	HFSPlusAttrKey* left = (HFSPlusAttrKey*) vLeft;
+	HFSPlusAttrKey* right = (HFSPlusAttrKey*) vRight;
+	uint16_t i;
+
+	if(left->fileID != right->fileID)
+		return (left->fileID < right->fileID) ? -1 : 1;
+
+	// names are ordered by code unit, not case folded like in the catalog
+	for(i = 0; i < left->name.length && i < right->name.length; i++) {
+		if(left->name.unicode[i] != right->name.unicode[i])
+			return (left->name.unicode[i] < right->name.unicode[i]) ? -1 : 1;
+	}
+
+	if(left->name.length != right->name.length)
+		return (left->name.length < right->name.length) ? -1 : 1;
+
+	if(left->startBlock != right->startBlock)
+		return (left->startBlock < right->startBlock) ? -1 : 1;
+
+	return 0;
+}
+
+#define ATTR_NAME_START (sizeof(HFSPlusAttrKey) - sizeof(HFSUniStr255) + sizeof(uint16_t))
+
+static BTKey* attrKeyRead(off_t offset, io_func* io) {
+	HFSPlusAttrKey* key;
+	uint16_t i;
+
+	key = (HFSPlusAttrKey*) malloc(sizeof(HFSPlusAttrKey));
+	if(key == NULL)
+		return NULL;
+
+	if(!READ(io, offset, ATTR_NAME_START, key)) {
+		free(key);
+		return NULL;
+	}
+
+	FLIPENDIAN(key->keyLength);
+	FLIPENDIAN(key->fileID);
+	FLIPENDIAN(key->startBlock);
+	FLIPENDIAN(key->name.length);
+
+	if(key->name.length > 255 || !READ(io, offset + ATTR_NAME_START, key->name.length * sizeof(uint16_t), key->name.unicode)) {
+		free(key);
+		return NULL;
+	}
+
+	for(i = 0; i < key->name.length; i++)
+		FLIPENDIAN(key->name.unicode[i]);
+
+	return (BTKey*) key;
+}
+
+static int attrKeyWrite(off_t offset, BTKey* toWrite, io_func* io) {
+	return FALSE;
+}
+
+static void attrKeyPrint(BTKey* toPrint) {
+	HFSPlusAttrKey* key = (HFSPlusAttrKey*) toPrint;
+
+	printf("attribute%d:", (int)key->fileID);
+	printUnicode(&key->name);
+}
+
+// Inline records come back with their data, the others as the bare header.
+static BTKey* attrDataRead(off_t offset, io_func* io) {
+	HFSPlusAttrData* record;
+	HFSPlusAttrData header;
+
+	if(!READ(io, offset, sizeof(HFSPlusAttrData), &header))
+		return NULL;
+
+	FLIPENDIAN(header.recordType);
+	FLIPENDIAN(header.size);
+
+	if(header.recordType != kHFSPlusAttrInlineData)
+		header.size = 0;
+
+	record = (HFSPlusAttrData*) malloc(sizeof(HFSPlusAttrData) + header.size);
+	if(record == NULL)
+		return NULL;
+
+	memcpy(record, &header, sizeof(HFSPlusAttrData));
+	if(header.size > 0 && !READ(io, offset + sizeof(HFSPlusAttrData), header.size, record->data)) {
+		free(record);
+		return NULL;
+	}
+
+	return (BTKey*) record;
+}
+
+BTree* openAttributesTree(io_func* file) {
+	return openBTree(file, &attrCompare, &attrKeyRead, &attrKeyWrite, &attrKeyPrint, &attrDataRead);
+}
+
+// The value of fileID's attribute name in a new buffer, and its size. 0 when
+// there is no such attribute, or it is too big to be stored inline.
+size_t getAttribute(Volume* volume, uint32_t fileID, const char* name, uint8_t** data) {
+	HFSPlusAttrKey key;
+	HFSPlusAttrData* record;
+	size_t size;
+	int exact;
+
+	*data = NULL;
+	if(volume->attrTree == NULL)
+		return 0;
+
+	key.fileID = fileID;
+	key.startBlock = 0;
+	ASCIIToUnicode(name, &key.name);
+	key.keyLength = ATTR_NAME_START - sizeof(key.keyLength) + (key.name.length * sizeof(uint16_t));
+
+	record = (HFSPlusAttrData*) search(volume->attrTree, (BTKey*)(&key), &exact, NULL, NULL);
+	if(record == NULL)
+		return 0;
+
+	if(!exact || record->recordType != kHFSPlusAttrInlineData || record->size == 0) {
+		free(record);
+		return 0;
+	}
+
+	size = record->size;
+	*data = (uint8_t*) malloc(size);
+	if(*data != NULL)
+		memcpy(*data, record->data, size);
+	else
+		size = 0;
+
+	free(record);
+	return size;
+}
@@ -5,6 +5,7 @@
 #include "clock.h"
 #include "gpio.h"
 #include "timer.h"
+#include "openiboot-asmhelpers.h"
 
 static const I2CInfo I2CInit[] = {
 			{0, 0, I2CNoError, 0, 0, I2CDone, 0, 0, 0, 0, 0, NULL, 0, NULL, I2C0_SCL_GPIO, I2C0_SDA_GPIO, I2C0 + IICCON, I2C0 + IICSTAT, I2C0 + IICADD, I2C0 + IICDS, I2C0 + IICLC,
@@ -14,10 +15,15 @@ static const I2CInfo I2CInit[] = {
 		};
 
 static I2CInfo I2C[2];
+static Semaphore I2CQueueSignal;
 
 static void init_i2c(I2CInfo* i2c, FrequencyBase freqBase);
+static void i2c_clock_changed(void* opaque);
+static void i2c_start(I2CInfo* i2c);
+static int i2c_poll(I2CInfo* i2c);
 static I2CError i2c_readwrite(I2CInfo* i2c);
 static void do_i2c(I2CInfo* i2c);
+static void i2c_queue_task(void* opaque);
 
 int i2c_setup() {
 	memcpy(I2C, I2CInit, sizeof(I2CInfo) * 2);
@@ -28,46 +34,222 @@ int i2c_setup() {
 	init_i2c(&I2C[0], FrequencyBasePeripheral);
 	init_i2c(&I2C[1], FrequencyBasePeripheral);
 
+	clock_add_change_handler(i2c_clock_changed, NULL);
+
+	semaphore_init(&I2CQueueSignal, 0);
+	if(task_create("i2c", i2c_queue_task, NULL, 0) == NULL)
+		bufferPrintf("i2c: could not start the queue task\r\n");
+
 	return 0;
 }
 
+static void i2c_load(I2CInfo* i2c, I2CRequest* request) {
+	i2c->address = request->address;
+	i2c->is_write = request->is_write;
+	i2c->registers = request->registers;
+	i2c->num_regs = request->num_regs;
+	i2c->bufferLen = request->bufferLen;
+	i2c->buffer = request->buffer;
+}
+
+// With nothing queued or running on the bus the transfer is done right here,
+// as it always was, which also keeps this usable from interrupt context.
+static I2CError i2c_run(I2CRequest* request) {
+	I2CInfo* i2c = &I2C[request->bus];
+
+	EnterCriticalSection();
+	if(i2c->queue != NULL || i2c->current != NULL) {
+		LeaveCriticalSection();
+		i2c_submit(request);
+		return i2c_wait(request);
+	}
+	i2c->current = request;
+	LeaveCriticalSection();
+
+	i2c_load(i2c, request);
+	request->error = i2c_readwrite(i2c);
+
+	EnterCriticalSection();
+	i2c->current = NULL;
+	int queued = (i2c->queue != NULL);
+	LeaveCriticalSection();
+
+	if(queued)
+		semaphore_signal(&I2CQueueSignal);
+
+	return request->error;
+}
+
 I2CError i2c_rx(int bus, int iicaddr, const uint8_t* registers, int num_regs, void* buffer, int len) {
-	I2C[bus].address = iicaddr;
-	I2C[bus].is_write = FALSE;
-	I2C[bus].registers = registers;
-	I2C[bus].num_regs = num_regs;
-	I2C[bus].bufferLen = len;
-	I2C[bus].buffer = (uint8_t*) buffer;
-	return i2c_readwrite(&I2C[bus]);
+	I2CRequest request;
+	memset(&request, 0, sizeof(request));
+	request.bus = bus;
+	request.address = iicaddr;
+	request.is_write = FALSE;
+	request.registers = registers;
+	request.num_regs = num_regs;
+	request.bufferLen = len;
+	request.buffer = (uint8_t*) buffer;
+	return i2c_run(&request);
 }
 
 I2CError i2c_tx(int bus, int iicaddr, void* buffer, int len) {
-	I2C[bus].address = iicaddr;
-	I2C[bus].is_write = TRUE;
-	I2C[bus].registers = NULL;
-	I2C[bus].num_regs = 0;
-	I2C[bus].bufferLen = len;
-	I2C[bus].buffer = (uint8_t*) buffer;
-	return i2c_readwrite(&I2C[bus]);
+	I2CRequest request;
+	memset(&request, 0, sizeof(request));
+	request.bus = bus;
+	request.address = iicaddr;
+	request.is_write = TRUE;
+	request.registers = NULL;
+	request.num_regs = 0;
+	request.bufferLen = len;
+	request.buffer = (uint8_t*) buffer;
+	return i2c_run(&request);
 }
 
-static void init_i2c(I2CInfo* i2c, FrequencyBase freqBase) {
+void i2c_submit(I2CRequest* request) {
+	completion_init(&request->completion);
+	request->error = I2CNoError;
+	request->next = NULL;
+
+	EnterCriticalSection();
+	I2CRequest** link = &I2C[request->bus].queue;
+	while(*link != NULL)
+		link = &(*link)->next;
+	*link = request;
+	LeaveCriticalSection();
+
+	semaphore_signal(&I2CQueueSignal);
+}
+
+I2CError i2c_wait(I2CRequest* request) {
+	while(completion_wait(&request->completion, 1000000) != 0);
+	return request->error;
+}
+
+I2CError i2c_tx_queued(int bus, int iicaddr, const void* buffer, int len) {
+	I2CRequest* request = (I2CRequest*) malloc(sizeof(I2CRequest) + len);
+	if(request == NULL)
+		return -1;
+
+	memset(request, 0, sizeof(I2CRequest));
+	request->bus = bus;
+	request->address = iicaddr;
+	request->is_write = TRUE;
+	request->buffer = (uint8_t*) (request + 1);
+	request->bufferLen = len;
+	request->freeWhenDone = TRUE;
+	memcpy(request->buffer, buffer, len);
+
+	i2c_submit(request);
+	return I2CNoError;
+}
+
+// An empty request never touches the bus; it only completes in its turn.
+void i2c_flush(int bus) {
+	I2CRequest request;
+	memset(&request, 0, sizeof(request));
+	request.bus = bus;
+	i2c_submit(&request);
+	i2c_wait(&request);
+}
+
+static void i2c_finish(I2CRequest* request) {
+	// the callback may resubmit or free the request
+	if(request->callback)
+		request->callback(request, request->opaque);
+
+	if(request->freeWhenDone)
+		free(request);
+	else
+		completion_signal(&request->completion);
+}
+
+static void i2c_queue_task(void* opaque) {
+	while(TRUE) {
+		int busy = FALSE;
+		int bus;
+
+		for(bus = 0; bus < 2; bus++) {
+			I2CInfo* i2c = &I2C[bus];
+			I2CRequest* request = i2c->running;
+
+			if(request != NULL) {
+				if(!i2c_poll(i2c)) {
+					busy = TRUE;
+					continue;
+				}
+
+				request->error = i2c->error_code;
+				EnterCriticalSection();
+				i2c->running = NULL;
+				i2c->current = NULL;
+				LeaveCriticalSection();
+				i2c_finish(request);
+			}
+
+			EnterCriticalSection();
+			if(i2c->current != NULL || i2c->queue == NULL) {
+				// someone is running a transfer of their own on it
+				busy = busy || (i2c->queue != NULL);
+				LeaveCriticalSection();
+				continue;
+			}
+			request = i2c->queue;
+			i2c->queue = request->next;
+
+			if(request->buffer == NULL && request->registers == NULL) {
+				LeaveCriticalSection();
+				i2c_finish(request);
+				busy = TRUE;
+				continue;
+			}
+
+			i2c->current = request;
+			i2c->running = request;
+			LeaveCriticalSection();
+
+			i2c_load(i2c, request);
+			i2c_start(i2c);
+			busy = TRUE;
+		}
+
+		if(busy)
+			task_yield();
+		else
+			semaphore_wait(&I2CQueueSignal);
+	}
+}
+
+static uint32_t i2c_clock_settings(I2CInfo* i2c, FrequencyBase freqBase) {
+	uint32_t settings;
 	i2c->frequency = 256000000000ULL / clock_get_frequency(freqBase);
 	int divisorRequired = 640000/i2c->frequency;
 	int prescaler;
 	if(divisorRequired < 512) {
 		// round up
-		i2c->iiccon_settings = IICCON_INIT | IICCON_TXCLKSRC_FPCLK16;
+		settings = IICCON_INIT | IICCON_TXCLKSRC_FPCLK16;
 		prescaler = ((divisorRequired + 0x1F) >> 5) - 1;
 	} else {
-		i2c->iiccon_settings = IICCON_INIT | IICCON_TXCLKSRC_FPCLK512;
+		settings = IICCON_INIT | IICCON_TXCLKSRC_FPCLK512;
 		prescaler = ((divisorRequired + 0x1FF) >> 9) - 1;
 	}
 
 	if(prescaler == 0)
 		prescaler = 1;
 
-	i2c->iiccon_settings |= prescaler;
+	return settings | prescaler;
+}
+
+static void i2c_clock_changed(void* opaque) {
+	int i;
+	for(i = 0; i < 2; i++) {
+		// a transfer may be under way, keep its ack setting
+		I2C[i].iiccon_settings = i2c_clock_settings(&I2C[i], FrequencyBasePeripheral) | (I2C[i].iiccon_settings & IICCON_ACKGEN);
+	}
+}
+
+static void init_i2c(I2CInfo* i2c, FrequencyBase freqBase) {
+	i2c->iiccon_settings = i2c_clock_settings(i2c, freqBase);
 
 	gpio_custom_io(i2c->iic_sda_gpio, 0xE); // pull sda low?
 
@@ -81,7 +263,7 @@ static void init_i2c(I2CInfo* i2c, FrequencyBase freqBase) {
 	gpio_custom_io(i2c->iic_sda_gpio, 0x2);
 }
 
-static I2CError i2c_readwrite(I2CInfo* i2c) {
+static void i2c_start(I2CInfo* i2c) {
 	SET_REG(i2c->register_IICCON, i2c->iiccon_settings);
 
 	i2c->iiccon_settings |= IICCON_ACKGEN;
@@ -92,24 +274,33 @@ static I2CError i2c_readwrite(I2CInfo* i2c) {
 	SET_REG(i2c->register_20, IICCON_INIT);
 
 	do_i2c(i2c);
+}
+
+// Moves the transfer along if the bus has finished the last step. Returns
+// whether it is done.
+static int i2c_poll(I2CInfo* i2c) {
+	int hardware_status;
+	do {
+		hardware_status = GET_REG(i2c->register_20);
+		SET_REG(i2c->register_20, hardware_status);
+		i2c->operation_result &= ~hardware_status;
+	} while(hardware_status != 0);
+
+	if(i2c->state == I2CDone) {
+		return TRUE;
+	}
+
+	do_i2c(i2c);
+	return FALSE;
+}
+
+static I2CError i2c_readwrite(I2CInfo* i2c) {
+	i2c_start(i2c);
 
 	if(i2c->error_code != I2CNoError)
 		return i2c->error_code;
 
-	while(TRUE) {
-		int hardware_status;
-		do {
-			hardware_status = GET_REG(i2c->register_20);
-			SET_REG(i2c->register_20, hardware_status);
-			i2c->operation_result &= ~hardware_status;
-		} while(hardware_status != 0);
-
-		if(i2c->state == I2CDone) {
-			break;
-		}
-
-		do_i2c(i2c);
-	}
+	while(!i2c_poll(i2c));
 
 	return i2c->error_code;
 }
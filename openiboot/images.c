@@ -4,6 +4,8 @@
 #include "util.h"
 #include "aes.h"
 #include "sha1.h"
+#include "nvram.h"
+#include "bootprof.h"
 
 static const uint32_t NOREnd = 0xF0000;
 
@@ -21,11 +23,174 @@ static const uint8_t Img2HashPadding[] = {	0xAD, 0x2E, 0xE3, 0x8D, 0x2D, 0x9B, 0
 
 static int IsImg3 = FALSE;
 
+// The images live in one array, linked in NOR order for imageList walkers,
+// with a hash of type to the first of each type for images_get.
+static Image* ImageArray = NULL;
+static int NumImages = 0;
+static int MaxImages = 0;
+static uint8_t ImageSlots[IMAGES_HASH_SIZE];
+
+// Set when images are released to be rewritten, so the saved index is not trusted
+static int ImagesRescan = FALSE;
+
+static Image* images_add() {
+	if(NumImages == MaxImages) {
+		MaxImages = MaxImages ? (MaxImages * 2) : 16;
+		ImageArray = (Image*) realloc(ImageArray, MaxImages * sizeof(Image));
+	}
+
+	Image* image = &ImageArray[NumImages++];
+	memset(image, 0, sizeof(Image));
+	return image;
+}
+
+static uint32_t images_slot(uint32_t type) {
+	return ((type * 0x9E3779B1) >> 24) & (IMAGES_HASH_SIZE - 1);
+}
+
+// Only once the array has stopped moving
+static void images_index() {
+	int i;
+
+	memset(ImageSlots, 0, sizeof(ImageSlots));
+	imageList = (NumImages > 0) ? ImageArray : NULL;
+
+	for(i = 0; i < NumImages; i++) {
+		ImageArray[i].next = (i + 1 < NumImages) ? &ImageArray[i + 1] : NULL;
+
+		// the table holds index + 1, and never more than IMAGES_HASH_SIZE - 1 of them
+		if(i >= (IMAGES_HASH_SIZE - 1))
+			continue;
+
+		uint32_t slot = images_slot(ImageArray[i].type);
+		while(ImageSlots[slot] != 0 && ImageArray[ImageSlots[slot] - 1].type != ImageArray[i].type)
+			slot = (slot + 1) & (IMAGES_HASH_SIZE - 1);
+
+		if(ImageSlots[slot] == 0)
+			ImageSlots[slot] = i + 1;
+	}
+}
+
+static uint32_t parseIndexHex(const char** str) {
+	uint32_t value = 0;
+	const char* pos = *str;
+
+	while(*pos == ' ' || *pos == ':')
+		pos++;
+
+	while(TRUE) {
+		char c = *pos;
+		if(c >= '0' && c <= '9')
+			value = (value << 4) | (c - '0');
+		else if(c >= 'a' && c <= 'f')
+			value = (value << 4) | (c - 'a' + 10);
+		else
+			break;
+		pos++;
+	}
+
+	*str = pos;
+	return value;
+}
+
+static int img3_check(const Image* image) {
+	AppleImg3RootHeader rootHeader;
+
+	nor_read(&rootHeader, image->offset, sizeof(rootHeader));
+	return rootHeader.base.magic == IMG3_MAGIC && rootHeader.extra.name == image->type
+		&& rootHeader.base.size == image->padded && rootHeader.base.dataSize == image->length;
+}
+
+// The index saved by the last scan: generation, where the images start, how
+// many there are, then type:offset:length:padded each, all in hex. It is
+// trusted if the first and last images are still where it says and nothing
+// follows the last one.
+static int img3_load_index(uint32_t* generation) {
+	const char* index = nvram_getvar(IMAGES_INDEX_VAR);
+	*generation = 0;
+
+	if(index == NULL)
+		return FALSE;
+
+	*generation = parseIndexHex(&index);
+	uint32_t start = parseIndexHex(&index);
+	uint32_t count = parseIndexHex(&index);
+	uint32_t offset = ImagesStart;
+	uint32_t i;
+
+	if(start != ImagesStart || count == 0)
+		return FALSE;
+
+	for(i = 0; i < count; i++) {
+		if(*index != ' ')
+			break;
+
+		Image* image = images_add();
+		image->type = parseIndexHex(&index);
+		image->offset = parseIndexHex(&index);
+		image->length = parseIndexHex(&index);
+		image->padded = parseIndexHex(&index);
+		image->index = i;
+		image->hashMatch = TRUE;
+
+		// img3 images follow each other with no gaps
+		if(image->offset != offset)
+			break;
+
+		offset += image->padded;
+	}
+
+	if(i != count || *index != '\0' || !img3_check(&ImageArray[0]) || !img3_check(&ImageArray[count - 1])) {
+		NumImages = 0;
+		return FALSE;
+	}
+
+	if(offset < NOREnd) {
+		uint32_t magic;
+		nor_read(&magic, offset, sizeof(magic));
+		if(magic == IMG3_MAGIC) {
+			NumImages = 0;
+			return FALSE;
+		}
+	}
+
+	MaxOffset = offset;
+	return TRUE;
+}
+
+static void img3_save_index(uint32_t generation) {
+	char* index = (char*) malloc(30 + (NumImages * 40));
+	char* pos = index;
+	int i;
+
+	sprintf(pos, "%x %x %x", generation, ImagesStart, NumImages);
+	pos += strlen(pos);
+	for(i = 0; i < NumImages; i++) {
+		sprintf(pos, " %x:%x:%x:%x", ImageArray[i].type, ImageArray[i].offset, ImageArray[i].length, ImageArray[i].padded);
+		pos += strlen(pos);
+	}
+
+	nvram_setvar(IMAGES_INDEX_VAR, index);
+	nvram_save();
+	free(index);
+}
+
 static void calculateHash(Img2Header* header, uint8_t* hash);
+static int images_verify_finish(Image* image, SHA1_CTX* context);
 static void calculateDataHash(void* buffer, int len, uint8_t* hash);
 
 static int img3_setup() {
 	Image* curImage = NULL;
+	uint32_t generation;
+
+	if(img3_load_index(&generation) && !ImagesRescan) {
+		images_index();
+		return 0;
+	}
+
+	NumImages = 0;
+	ImagesRescan = FALSE;
+
 	AppleImg3RootHeader* rootHeader = (AppleImg3RootHeader*) malloc(sizeof(AppleImg3RootHeader));
 
 	uint32_t offset = ImagesStart;
@@ -35,13 +200,7 @@ static int img3_setup() {
 		if(rootHeader->base.magic != IMG3_MAGIC)
 			break;
 
-		if(curImage == NULL) {
-			curImage = (Image*) malloc(sizeof(Image));
-			imageList = curImage;
-		} else {
-			curImage->next = (Image*) malloc(sizeof(Image));
-			curImage = curImage->next;
-		}
+		curImage = images_add();
 
 		curImage->type = rootHeader->extra.name;
 		curImage->offset = offset;
@@ -50,8 +209,6 @@ static int img3_setup() {
 		curImage->index = index++;
 		curImage->hashMatch = TRUE;
 
-		curImage->next = NULL;
-
 		if((offset + curImage->padded) > MaxOffset) {
 			MaxOffset = offset + curImage->padded;
 		}
@@ -61,6 +218,12 @@ static int img3_setup() {
 
 	free(rootHeader);
 
+	images_index();
+
+	// next boot can skip all this
+	if(NumImages > 0)
+		img3_save_index(generation + 1);
+
 	return 0;
 }
 
@@ -115,13 +278,7 @@ int images_setup() {
 			continue;
 		}
 
-		if(curImage == NULL) {
-			curImage = (Image*) malloc(sizeof(Image));
-			imageList = curImage;
-		} else {
-			curImage->next = (Image*) malloc(sizeof(Image));
-			curImage = curImage->next;
-		}
+		curImage = images_add();
 
 		curImage->type = curImg2->imageType;
 		curImage->offset = curOffset;
@@ -139,8 +296,6 @@ int images_setup() {
 			curImage->hashMatch = FALSE;
 		}
 
-		curImage->next = NULL;
-
 		if((curOffset + curImage->padded) > MaxOffset) {
 			MaxOffset = curOffset + curImage->padded;
 		}
@@ -149,6 +304,8 @@ int images_setup() {
 	free(curImg2);
 	free(header);
 
+	images_index();
+
 	return 0;
 }
 
@@ -163,13 +320,21 @@ void images_list() {
 }
 
 Image* images_get(uint32_t type) {
-	Image* curImage = imageList;
+	uint32_t slot = images_slot(type);
 
-	while(curImage != NULL) {
+	while(ImageSlots[slot] != 0) {
+		Image* curImage = &ImageArray[ImageSlots[slot] - 1];
 		if(type == curImage->type) {
 			return curImage;
 		}
-		curImage = curImage->next;
+		slot = (slot + 1) & (IMAGES_HASH_SIZE - 1);
+	}
+
+	// past what the table holds
+	int i;
+	for(i = IMAGES_HASH_SIZE - 1; i < NumImages; i++) {
+		if(type == ImageArray[i].type)
+			return &ImageArray[i];
 	}
 
 	return NULL;
@@ -196,14 +361,13 @@ void images_rewind() {
 }
 
 void images_release() {
-	Image* curImage = imageList;
-	Image* toRelease = NULL;
-	while(curImage != NULL) {
-		toRelease = curImage;
-		curImage = curImage->next;
-		free(toRelease);
-	}
+	free(ImageArray);
+	ImageArray = NULL;
+	NumImages = 0;
+	MaxImages = 0;
+	memset(ImageSlots, 0, sizeof(ImageSlots));
 	imageList = NULL;
+	ImagesRescan = TRUE;
 }
 
 void images_duplicate(Image* image, uint32_t type, int index) {
@@ -316,6 +480,8 @@ void images_erase(Image* image) {
 	if(image == NULL)
 		return;
 
+	image->verified = FALSE;
+
 	nor_erase_sector(image->offset);
 
 	images_release();
@@ -327,6 +493,8 @@ void images_write(Image* image, void* data, unsigned int length, int encrypt) {
 	if(image == NULL)
 		return;
 
+	image->verified = FALSE;
+
 	uint32_t padded = length;
 	if((length & 0xF) != 0) {
 		padded = (padded & ~0xF) + 0x10;
@@ -372,55 +540,394 @@ void images_write(Image* image, void* data, unsigned int length, int encrypt) {
 
 }
 
-unsigned int images_read(Image* image, void** data) {
-	if(image == NULL) {
-		*data = NULL;
+// Payloads are read and decrypted this many bytes at a time. Must be a
+// multiple of the AES block size.
+#ifndef IMAGES_READ_CHUNK
+#define IMAGES_READ_CHUNK 0x10000
+#endif
+
+typedef struct ImagePayload {
+	uint32_t offset;
+	uint32_t length;
+	int hasKey;
+	uint32_t kbag[(sizeof(AppleImg3KBAGHeader) + 16 + 32) / 4];
+} ImagePayload;
+
+// Find the encrypted payload of an image by walking its tag headers in NOR,
+// without reading the rest of the container.
+static int images_find_payload(Image* image, ImagePayload* payload) {
+	payload->hasKey = FALSE;
+
+	if(!IsImg3) {
+		payload->offset = image->offset + sizeof(Img2Header);
+		payload->length = image->length;
+		return TRUE;
+	}
+
+	AppleImg3Header header;
+	uint32_t start = image->offset + sizeof(AppleImg3RootHeader);
+	uint32_t offset = start;
+	int found = FALSE;
+
+	while((offset - start) < image->length) {
+		nor_read(&header, offset, sizeof(header));
+		if(header.size < sizeof(header))
+			break;
+
+		if(header.magic == IMG3_DATA_MAGIC) {
+			payload->offset = offset + sizeof(AppleImg3Header);
+			payload->length = header.dataSize;
+			found = TRUE;
+		}
+
+		if(header.magic == IMG3_KBAG_MAGIC && !payload->hasKey) {
+			nor_read(payload->kbag, offset + sizeof(AppleImg3Header), sizeof(payload->kbag));
+			payload->hasKey = TRUE;
+		}
+
+		offset += header.size;
+	}
+
+	return found;
+}
+
+unsigned int images_read_to(Image* image, void* buffer, size_t bufferSize) {
+	ImagePayload payload;
+	AppleImg3KBAGHeader* kbag = NULL;
+	uint8_t* key = NULL;
+	uint32_t iv[4];
+	AESSession session;
+	SHA1_CTX context;
+	int hashing;
+
+	if(image == NULL || !images_find_payload(image, &payload))
+		return 0;
+
+	if(payload.length > bufferSize) {
+		bufferPrintf("images: payload of %d bytes does not fit in %d\r\n", payload.length, bufferSize);
 		return 0;
 	}
 
-	*data = malloc(image->padded);
+	uint32_t toDecrypt;
 	if(!IsImg3) {
-		nor_read(*data, image->offset + sizeof(Img2Header), image->length);
-		aes_838_decrypt(*data, image->length, NULL);
-		return image->length;
+		toDecrypt = payload.length;
+		memset(iv, 0, sizeof(iv));
+	} else if(payload.hasKey) {
+		kbag = (AppleImg3KBAGHeader*) payload.kbag;
+		if(kbag->key_modifier == 1) {
+			aes_decrypt((uint8_t*)payload.kbag + sizeof(AppleImg3KBAGHeader), 16 + (kbag->key_bits / 8), AESGID, NULL, NULL);
+		}
+		memcpy(iv, (uint8_t*)payload.kbag + sizeof(AppleImg3KBAGHeader), sizeof(iv));
+		key = (uint8_t*)payload.kbag + sizeof(AppleImg3KBAGHeader) + 16;
+		toDecrypt = (payload.length / 16) * 16;
 	} else {
-		nor_read(*data, image->offset, image->padded);
-
-		uint32_t dataOffset = 0;
-		uint32_t dataLength = 0;
-		uint32_t kbagOffset = 0;
-		uint32_t kbagLength = 0;
-		uint32_t offset = (uint32_t)(*data + sizeof(AppleImg3RootHeader));
-		while((offset - (uint32_t)(*data + sizeof(AppleImg3RootHeader))) < image->length) {
-			AppleImg3Header* header = (AppleImg3Header*) offset;
-			if(header->magic == IMG3_DATA_MAGIC) {
-				dataOffset = offset + sizeof(AppleImg3Header);
-				dataLength = header->dataSize;
-			}
-			if(header->magic == IMG3_KBAG_MAGIC) {
-				kbagOffset = offset + sizeof(AppleImg3Header);
-				kbagLength = header->dataSize;
-			}
-			offset += header->size;
+		toDecrypt = 0;
+	}
+
+	bootprof_begin("images_read");
+
+	// img2 data is hashed on the way through, so a verify after this needs
+	// no second pass over NOR
+	hashing = !IsImg3 && !image->verified;
+	if(hashing)
+		SHA1Init(&context);
+
+	if(toDecrypt > 0)
+		aes_session_open(&session, FALSE, AESCustom, IsImg3 ? key : aes_838_key(), iv);
+
+	// decrypt each chunk as it comes off NOR, in one session so the IV
+	// carries across chunks. The engine works on chunk N while chunk N+1 is
+	// being read.
+	uint8_t* cur = (uint8_t*) buffer;
+	uint32_t done = 0;
+	while(done < payload.length) {
+		uint32_t toRead = payload.length - done;
+		if(toRead > IMAGES_READ_CHUNK)
+			toRead = IMAGES_READ_CHUNK;
+
+		nor_read(cur, payload.offset + done, toRead);
+
+		// the engine decrypts in place, so this has to come first
+		if(hashing)
+			SHA1Update(&context, cur, toRead);
+
+		if(done < toDecrypt) {
+			uint32_t len = toDecrypt - done;
+			if(len > toRead)
+				len = toRead;
+
+			aes_session_process_async(&session, cur, len);
+		}
+
+		cur += toRead;
+		done += toRead;
+	}
+
+	if(toDecrypt > 0)
+		aes_session_close(&session);
+
+	// the hash covers the padding after the data as well, which is at most a block
+	uint8_t tail[16];
+	uint32_t tailLength = image->padded - payload.length;
+	if(hashing && image->padded >= payload.length && tailLength <= sizeof(tail)) {
+		nor_read(tail, payload.offset + payload.length, tailLength);
+		SHA1Update(&context, tail, tailLength);
+		images_verify_finish(image, &context);
+	}
+
+	bootprof_end("images_read", image->type);
+
+	return payload.length;
+}
+
+unsigned int images_read(Image* image, void** data) {
+	ImagePayload payload;
+
+	if(image == NULL || !images_find_payload(image, &payload)) {
+		*data = NULL;
+		return 0;
+	}
+
+	// round up so the last AES block never runs past the allocation
+	*data = malloc((payload.length + 15) & ~15);
+	return images_read_to(image, *data, payload.length);
+}
+
+typedef struct Img3Injection {
+	uint32_t dataTag;	// from the first tag
+	uint32_t dataTagSize;
+	uint32_t newTagSize;
+	uint32_t newDataSize;	// all of the tags
+	uint32_t newSize;	// the whole container
+	int encrypted;
+	uint8_t IVKey[16 + (256 / 8)];
+} Img3Injection;
+
+// Finds the DATA tag and the key, and works out the new sizes, without
+// touching anything.
+static int images_prepare_injection(const void* img3Data, size_t newDataLen, Img3Injection* injection) {
+	const AppleImg3RootHeader* rootHeader = (const AppleImg3RootHeader*) img3Data;
+	const uint8_t* tags = (const uint8_t*) img3Data + sizeof(AppleImg3RootHeader);
+	const AppleImg3KBAGHeader* kbag = NULL;
+	uint32_t offset = 0;
+	int found = FALSE;
+
+	while(offset < rootHeader->base.dataSize) {
+		const AppleImg3Header* header = (const AppleImg3Header*)(tags + offset);
+		if(header->size < sizeof(AppleImg3Header))
+			break;
+
+		if(header->magic == IMG3_DATA_MAGIC) {
+			injection->dataTag = offset;
+			injection->dataTagSize = header->size;
+			found = TRUE;
+		}
+		if(header->magic == IMG3_KBAG_MAGIC)
+			kbag = (const AppleImg3KBAGHeader*)(tags + offset + sizeof(AppleImg3Header));
+
+		offset += header->size;
+	}
+
+	if(!found) {
+		bufferPrintf("images: no DATA tag to inject into\r\n");
+		return FALSE;
+	}
+
+	injection->encrypted = (kbag != NULL);
+	if(kbag != NULL && kbag->key_modifier == 1) {
+		memcpy(injection->IVKey, (const uint8_t*) kbag + sizeof(AppleImg3KBAGHeader), 16 + (kbag->key_bits / 8));
+		aes_decrypt(injection->IVKey, 16 + (kbag->key_bits / 8), AESGID, NULL, NULL);
+	}
+
+	injection->newTagSize = sizeof(AppleImg3Header) + (((newDataLen + 3)/4)*4);
+	injection->newDataSize = rootHeader->base.dataSize - injection->dataTagSize + injection->newTagSize;
+	injection->newSize = (((injection->newDataSize + sizeof(AppleImg3RootHeader)) + 0x3F)/0x40)*0x40;
+	return TRUE;
+}
+
+// Writes the DATA tag at tag, which may be where the old one was.
+static void images_write_data_tag(uint8_t* tag, const Img3Injection* injection, const void* newData, size_t newDataLen) {
+	AppleImg3Header* header = (AppleImg3Header*) tag;
+	header->magic = IMG3_DATA_MAGIC;
+	header->size = injection->newTagSize;
+	header->dataSize = newDataLen;
+
+	memcpy(tag + sizeof(AppleImg3Header), newData, newDataLen);
+	memset(tag + sizeof(AppleImg3Header) + newDataLen, 0, injection->newTagSize - sizeof(AppleImg3Header) - newDataLen);
+
+	if(injection->encrypted && newDataLen >= 16)
+		aes_encrypt(tag + sizeof(AppleImg3Header), (newDataLen / 16) * 16, AESCustom, &injection->IVKey[16], injection->IVKey);
+}
+
+// Builds the new container into out, which holds injection->newSize bytes
+// and must not overlap img3Data.
+static void images_inject_img3_to(const void* img3Data, void* out, const Img3Injection* injection, const void* newData, size_t newDataLen) {
+	const AppleImg3RootHeader* oldHeader = (const AppleImg3RootHeader*) img3Data;
+	const uint8_t* oldTags = (const uint8_t*) img3Data + sizeof(AppleImg3RootHeader);
+	AppleImg3RootHeader* rootHeader = (AppleImg3RootHeader*) out;
+	uint8_t* tags = (uint8_t*) out + sizeof(AppleImg3RootHeader);
+	uint32_t after = injection->dataTag + injection->dataTagSize;
+
+	memcpy(rootHeader, oldHeader, sizeof(AppleImg3RootHeader));
+	rootHeader->base.dataSize = injection->newDataSize;
+	rootHeader->base.size = injection->newSize;
+	if(oldHeader->extra.shshOffset > injection->dataTag)
+		rootHeader->extra.shshOffset = oldHeader->extra.shshOffset - injection->dataTagSize + injection->newTagSize;
+
+	memcpy(tags, oldTags, injection->dataTag);
+	images_write_data_tag(tags + injection->dataTag, injection, newData, newDataLen);
+	memcpy(tags + injection->dataTag + injection->newTagSize, oldTags + after, oldHeader->base.dataSize - after);
+	memset(tags + injection->newDataSize, 0, injection->newSize - sizeof(AppleImg3RootHeader) - injection->newDataSize);
+}
+
+void* images_inject_img3(const void* img3Data, const void* newData, size_t newDataLen) {
+	Img3Injection injection;
+	if(!images_prepare_injection(img3Data, newDataLen, &injection))
+		return NULL;
+
+	void* newImg3 = malloc(injection.newSize);
+	if(newImg3 != NULL)
+		images_inject_img3_to(img3Data, newImg3, &injection, newData, newDataLen);
+	return newImg3;
+}
+
+int images_inject_img3_in_place(void* img3Data, size_t capacity, const void* newData, size_t newDataLen) {
+	Img3Injection injection;
+	if(!images_prepare_injection(img3Data, newDataLen, &injection) || injection.newSize > capacity)
+		return FALSE;
+
+	AppleImg3RootHeader* rootHeader = (AppleImg3RootHeader*) img3Data;
+	uint8_t* tags = (uint8_t*) img3Data + sizeof(AppleImg3RootHeader);
+	uint32_t after = injection.dataTag + injection.dataTagSize;
+
+	// slide whatever follows DATA (SHSH and CERT) to where the new DATA ends
+	memmove(tags + injection.dataTag + injection.newTagSize, tags + after, rootHeader->base.dataSize - after);
+	images_write_data_tag(tags + injection.dataTag, &injection, newData, newDataLen);
+
+	if(rootHeader->extra.shshOffset > injection.dataTag)
+		rootHeader->extra.shshOffset = rootHeader->extra.shshOffset - injection.dataTagSize + injection.newTagSize;
+	rootHeader->base.dataSize = injection.newDataSize;
+	rootHeader->base.size = injection.newSize;
+	memset(tags + injection.newDataSize, 0, injection.newSize - sizeof(AppleImg3RootHeader) - injection.newDataSize);
+
+	return TRUE;
+}
+
+// Lays the whole list out in RAM as it should end up in NOR, then only
+// rewrites the sectors that differ and checks each by streaming it back.
+// Frees the list.
+static int images_flash_list(ImageDataList* list) {
+	ImageDataList* cur;
+	uint32_t total = 0;
+	int ret = 0;
+
+	for(cur = list; cur != NULL; cur = cur->next) {
+		Img3Injection injection;
+		if(cur->newData == NULL) {
+			total += ((AppleImg3RootHeader*) cur->data)->base.size;
+		} else if(images_prepare_injection(cur->data, cur->newDataLen, &injection)) {
+			total += injection.newSize;
+		} else {
+			ret = -1;
 		}
+	}
+
+	// one more byte to destroy any image following the new ones
+	uint32_t end = ImagesStart + total;
+	uint32_t planEnd = (end < MaxOffset) ? (end + 1) : end;
+	if(planEnd > 0xfc000) {
+		bufferPrintf("writing images of size %d at %x would overflow NOR!\r\n", total, ImagesStart);
+		ret = -1;
+	}
+
+	uint8_t* plan = NULL;
+	uint8_t* sector = NULL;
+	uint32_t sectorSize = getNORSectorSize();
+	if(ret == 0) {
+		plan = malloc(planEnd - ImagesStart);
+		sector = malloc(sectorSize);
+	}
+
+	uint32_t offset = ImagesStart;
+	while(list != NULL) {
+		cur = list;
+		list = list->next;
+
+		if(plan != NULL) {
+			uint8_t* at = plan + (offset - ImagesStart);
+			Img3Injection injection;
+			uint32_t size;
+
+			if(cur->newData != NULL) {
+				images_prepare_injection(cur->data, cur->newDataLen, &injection);
+				images_inject_img3_to(cur->data, at, &injection, cur->newData, cur->newDataLen);
+			} else {
+				memcpy(at, cur->data, ((AppleImg3RootHeader*) cur->data)->base.size);
+			}
 
-		AppleImg3KBAGHeader* kbag = (AppleImg3KBAGHeader*) kbagOffset;
+			// entries sharing data can still be flashed as different types
+			images_change_type(at, cur->type);
+			size = ((AppleImg3RootHeader*) at)->base.size;
 
-    if(kbag != 0) {
-      if(kbag->key_modifier == 1) {
-        aes_decrypt((void*)(kbagOffset + sizeof(AppleImg3KBAGHeader)), 16 + (kbag->key_bits / 8), AESGID, NULL, NULL);
-      }
+			bufferPrintf("Planning: ");
+			print_fourcc(cur->type);
+			bufferPrintf(" (%x, %d bytes)\r\n", offset, size);
+			offset += size;
+		}
 
-      aes_decrypt((void*)dataOffset, (dataLength / 16) * 16, AESCustom, (uint8_t*)(kbagOffset + sizeof(AppleImg3KBAGHeader) + 16), (uint8_t*)(kbagOffset + sizeof(AppleImg3KBAGHeader)));
-    }
+		if(!cur->borrowed)
+			free(cur->data);
+		free(cur);
+	}
 
-		uint8_t* newBuf = malloc(dataLength);
-		memcpy(newBuf, (void*)dataOffset, dataLength);
-		free(*data);
-		*data = newBuf;
+	if(plan == NULL)
+		return ret;
+
+	if(planEnd > end)
+		plan[end - ImagesStart] = 0;
+
+	uint32_t written = 0;
+	uint32_t sectors = 0;
+	for(offset = ImagesStart; offset < planEnd;) {
+		uint32_t next = (offset - (offset % sectorSize)) + sectorSize;
+		uint32_t len = ((next < planEnd) ? next : planEnd) - offset;
+		uint8_t* want = plan + (offset - ImagesStart);
+
+		sectors++;
+		nor_read(sector, offset, len);
+		if(memcmp(sector, want, len) != 0) {
+			uint8_t wantHash[20];
+			uint8_t gotHash[20];
+			SHA1_CTX context;
+
+			nor_write(want, offset, len);
+			written++;
+
+			SHA1Init(&context);
+			SHA1Update(&context, want, len);
+			SHA1Final(wantHash, &context);
+
+			nor_read(sector, offset, len);
+			SHA1Init(&context);
+			SHA1Update(&context, sector, len);
+			SHA1Final(gotHash, &context);
+
+			if(memcmp(wantHash, gotHash, sizeof(wantHash)) != 0) {
+				bufferPrintf("verify failed for sector at %x!\r\n", offset);
+				ret = -1;
+				break;
+			}
+		}
 
-		return dataLength;
+		offset += len;
 	}
+
+	bufferPrintf("Flashed %d of %d sectors\r\n", written, sectors);
+
+	free(sector);
+	free(plan);
+
+	return ret;
 }
 
 void images_install(void* newData, size_t newDataLen) {
@@ -447,6 +954,8 @@ void images_install(void* newData, size_t newDataLen) {
 
 		cur->type = curImage->type;
 		cur->next = NULL;
+		cur->newData = NULL;
+		cur->borrowed = FALSE;
 		cur->data = malloc(curImage->padded);
 		nor_read(cur->data, curImage->offset, curImage->padded);
 
@@ -462,41 +971,35 @@ void images_install(void* newData, size_t newDataLen) {
 	if(!isUpgrade) {
 		bufferPrintf("Performing installation... (%d bytes)\r\n", newDataLen);
 
+		// the original goes back in as ibox, so both are laid out from
+		// the one copy
 		ImageDataList* ibox = malloc(sizeof(ImageDataList));
 		ibox->type = fourcc("ibox");
 		ibox->data = iboot->data;
+		ibox->newData = NULL;
+		ibox->borrowed = FALSE;
 		ibox->next = iboot->next;
 
 		iboot->next = ibox;
-		iboot->data = images_inject_img3(iboot->data, newData, newDataLen);
-		images_change_type(ibox->data, ibox->type);
+		iboot->newData = newData;
+		iboot->newDataLen = newDataLen;
+		iboot->borrowed = TRUE;
 	} else {
 		bufferPrintf("Performing upgrade... (%d bytes)\r\n", newDataLen);
-		void* newIBoot = images_inject_img3(iboot->data, newData, newDataLen);
-		free(iboot->data);
-		iboot->data = newIBoot;
+		// the old container's size is as much as its buffer holds
+		if(!images_inject_img3_in_place(iboot->data, ((AppleImg3RootHeader*) iboot->data)->base.size, newData, newDataLen)) {
+			iboot->newData = newData;
+			iboot->newDataLen = newDataLen;
+		}
 	}
 
 
 	bufferPrintf("Flashing...\r\n");
 
-	images_rewind();
-	while(list != NULL) {
-		cur = list;
-		list = list->next;
-		AppleImg3RootHeader* header = (AppleImg3RootHeader*) cur->data;
-
-		bufferPrintf("Flashing: ");
-		print_fourcc(cur->type);
-		bufferPrintf(" (%x, %d bytes)\r\n", cur->data, header->base.size);
-
-		images_append(cur->data, header->base.size);
-
-		free(cur->data);
-		free(cur);
-	}
-
-	bufferPrintf("Done with installation!\r\n");
+	if(images_flash_list(list) != 0)
+		bufferPrintf("Installation failed!\r\n");
+	else
+		bufferPrintf("Done with installation!\r\n");
 
 	images_release();
 	images_setup();
@@ -527,6 +1030,8 @@ void images_uninstall() {
 
 			cur->type = curImage->type;
 			cur->next = NULL;
+			cur->newData = NULL;
+			cur->borrowed = FALSE;
 			cur->data = malloc(curImage->padded);
 			nor_read(cur->data, curImage->offset, curImage->padded);
 
@@ -558,23 +1063,10 @@ void images_uninstall() {
 
 	bufferPrintf("Flashing...\r\n");
 
-	images_rewind();
-	while(list != NULL) {
-		cur = list;
-		list = list->next;
-		AppleImg3RootHeader* header = (AppleImg3RootHeader*) cur->data;
-
-		bufferPrintf("Flashing: ");
-		print_fourcc(cur->type);
-		bufferPrintf(" (%x, %d bytes)\r\n", cur->data, header->base.size);
-
-		images_append(cur->data, header->base.size);
-
-		free(cur->data);
-		free(cur);
-	}
-
-	bufferPrintf("Done with uninstallation!\r\n");
+	if(images_flash_list(list) != 0)
+		bufferPrintf("Uninstallation failed!\r\n");
+	else
+		bufferPrintf("Done with uninstallation!\r\n");
 
 	images_release();
 	images_setup();
@@ -587,78 +1079,6 @@ void images_change_type(const void* img3Data, uint32_t type) {
 	header->extra.name = type;
 }
 
-void* images_inject_img3(const void* img3Data, const void* newData, size_t newDataLen) {
-	uint8_t IVKey[16 + (256 / 8)];
-	uint8_t* IV = IVKey;
-	uint8_t* Key = &IVKey[16];
-
-	uint32_t dataOffset = 0;
-	uint32_t dataLength = 0;
-	uint32_t kbagOffset = 0;
-	uint32_t kbagLength = 0;
-	uint32_t offset = (uint32_t)(img3Data + sizeof(AppleImg3RootHeader));
-
-	size_t contentsLength = ((AppleImg3RootHeader*) img3Data)->base.dataSize;
-
-	while((offset - (uint32_t)(img3Data + sizeof(AppleImg3RootHeader))) < contentsLength) {
-		AppleImg3Header* header = (AppleImg3Header*) offset;
-		if(header->magic == IMG3_DATA_MAGIC) {
-			dataOffset = offset + sizeof(AppleImg3Header);
-			dataLength = header->size;
-		}
-		if(header->magic == IMG3_KBAG_MAGIC) {
-			kbagOffset = offset + sizeof(AppleImg3Header);
-			kbagLength = header->dataSize;
-		}
-		offset += header->size;
-	}
-
-	AppleImg3KBAGHeader* kbag = (AppleImg3KBAGHeader*) kbagOffset;
-
-	if(kbag != 0 && kbag->key_modifier == 1) {
-		memcpy(IVKey, (void*)(kbagOffset + sizeof(AppleImg3KBAGHeader)), 16 + (kbag->key_bits / 8));
-		aes_decrypt(IVKey, 16 + (kbag->key_bits / 8), AESGID, NULL, NULL);
-	}
-
-	void* newImg3 = malloc(sizeof(AppleImg3RootHeader));
-
-	memcpy(newImg3, img3Data, sizeof(AppleImg3RootHeader));
-	AppleImg3RootHeader* rootHeader = (AppleImg3RootHeader*) newImg3;
-
-	rootHeader->base.dataSize = rootHeader->base.dataSize - dataLength + (((newDataLen + 3)/4)*4) + sizeof(AppleImg3Header);
-	rootHeader->base.size = (((rootHeader->base.dataSize + sizeof(AppleImg3RootHeader)) + 0x3F)/0x40)*0x40;
-	newImg3 = realloc(newImg3, rootHeader->base.size);
-	rootHeader = (AppleImg3RootHeader*) newImg3;
-	void* cursor = newImg3 + sizeof(AppleImg3RootHeader);
-	memset(cursor, 0, rootHeader->base.size - sizeof(AppleImg3RootHeader));
-
-	offset = (uint32_t)(img3Data + sizeof(AppleImg3RootHeader));
-	while((offset - (uint32_t)(img3Data + sizeof(AppleImg3RootHeader))) < contentsLength) {
-		AppleImg3Header* header = (AppleImg3Header*) offset;
-		if(header->magic == IMG3_DATA_MAGIC) {
-			memcpy(cursor, (void*) offset, sizeof(AppleImg3Header));
-			AppleImg3Header* newHeader = (AppleImg3Header*) cursor;
-			newHeader->dataSize = newDataLen;
-			newHeader->size = sizeof(AppleImg3Header) + (((newHeader->dataSize + 3)/4)*4);
-
-			memcpy(cursor + sizeof(AppleImg3Header), newData, newDataLen);
-      if(kbag != 0) {
-  			aes_encrypt(cursor + sizeof(AppleImg3Header), (newDataLen / 16) * 16, AESCustom, Key, IV);
-      }
-			cursor += newHeader->size;
-		} else {
-			if(header->magic == IMG3_SHSH_MAGIC) {
-				rootHeader->extra.shshOffset = (uint32_t)cursor - (uint32_t)newImg3 - sizeof(AppleImg3RootHeader);
-			}
-			memcpy(cursor, (void*) offset, header->size);
-			cursor += header->size;
-		}
-		offset += header->size;
-	}
-
-	return newImg3;
-}
-
 static void calculateHash(Img2Header* header, uint8_t* hash) {
 	SHA1_CTX context;
 	SHA1Init(&context);
@@ -668,34 +1088,63 @@ static void calculateHash(Img2Header* header, uint8_t* hash) {
 	aes_img2verify_encrypt(hash, 32, NULL);
 }
 
+static void finishDataHash(SHA1_CTX* context, uint8_t* hash) {
+	SHA1Final(hash, context);
+	memcpy(hash + 20, Img2HashPadding, 64 - 20);
+	aes_img2verify_encrypt(hash, 64, NULL);
+}
+
 static void calculateDataHash(void* buffer, int len, uint8_t* hash) {
 	SHA1_CTX context;
 	SHA1Init(&context);
 	SHA1Update(&context, buffer, len);
-	SHA1Final(hash, &context);
-	memcpy(hash + 20, Img2HashPadding, 64 - 20);
-	aes_img2verify_encrypt(hash, 64, NULL);
+	finishDataHash(&context, hash);
 }
 
-int images_verify(Image* image) {
+// Finishes the hash of the image's data and keeps the result for the rest of
+// this boot
+static int images_verify_finish(Image* image, SHA1_CTX* context) {
 	uint8_t hash[0x40];
 	int retVal = 0;
 
-	if(image == NULL) {
-		return 1;
-	}
-
 	if(!image->hashMatch)
 		retVal |= 1 << 2;
 
-	void* data = malloc(image->padded);
-	nor_read(data, image->offset + sizeof(Img2Header), image->padded);
-	calculateDataHash(data, image->padded, hash);
-	free(data);
+	finishDataHash(context, hash);
 
 	if(memcmp(hash, image->dataHash, 0x40) != 0)
 		retVal |= 1 << 3;
 
+	image->verifyResult = retVal;
+	image->verified = TRUE;
 	return retVal;
 }
 
+int images_verify(Image* image) {
+	if(image == NULL) {
+		return 1;
+	}
+
+	if(image->verified)
+		return image->verifyResult;
+
+	// hash chunk by chunk as it is read instead of pulling in the whole image
+	uint32_t chunkSize = (image->padded < IMAGES_READ_CHUNK) ? image->padded : IMAGES_READ_CHUNK;
+	uint8_t* chunk = malloc(chunkSize);
+	uint32_t done = 0;
+	SHA1_CTX context;
+	SHA1Init(&context);
+	while(done < image->padded) {
+		uint32_t toRead = image->padded - done;
+		if(toRead > chunkSize)
+			toRead = chunkSize;
+
+		nor_read(chunk, image->offset + sizeof(Img2Header) + done, toRead);
+		SHA1Update(&context, chunk, toRead);
+		done += toRead;
+	}
+	free(chunk);
+
+	return images_verify_finish(image, &context);
+}
+
@@ -0,0 +1,199 @@
+const uint16_t dataAndroidOSRLE[] = {
+	0x006b, 0x006b, 0x006b, 0x006b, 0x006b, 0x006b, 0x006b, 0x006b, 0x0027, 0xc002, 0x39c7, 0x0015,
+	0x5aeb, 0x000d, 0x0018, 0xc002, 0x4a69, 0x0011, 0x528a, 0x0010, 0x0028, 0x0027, 0xc001, 0x2945,
+	0x0019, 0x8001, 0x7bef, 0xc001, 0x31c6, 0x0016, 0x0016, 0xc003, 0x18e3, 0x001b, 0x7bef, 0x0001,
+	0x4208, 0x0014, 0x0028, 0x0028, 0xc003, 0x5aeb, 0x000c, 0x6b6d, 0x0006, 0x0020, 0x001f, 0x0015,
+	0xc002, 0x6b4d, 0x000a, 0x6b4d, 0x0007, 0x0029, 0x0028, 0xc003, 0x18c3, 0x001c, 0x7bcf, 0x0002,
+	0x4248, 0x0013, 0x0014, 0xc003, 0x2965, 0x0018, 0x73ce, 0x0001, 0x3186, 0x0018, 0x0029, 0x0029,
+	0xc003, 0x528a, 0x0011, 0x73ae, 0x0003, 0x0861, 0x001e, 0x0004, 0xc00b, 0x10a2, 0x001c, 0x2985,
+	0x0017, 0x39e7, 0x0014, 0x4208, 0x0012, 0x39e7, 0x0011, 0x39e7, 0x0011, 0x4228, 0x0011, 0x4208,
+	0x0013, 0x2965, 0x0017, 0x18c3, 0x001b, 0x0020, 0x001f, 0x0004, 0xc002, 0x738e, 0x0007, 0x5b0b,
+	0x000c, 0x002a, 0x0029, 0xc003, 0x0020, 0x001f, 0x73ae, 0x0004, 0x4a69, 0x0011, 0x0001, 0xc004,
+	0x18e3, 0x001b, 0x52aa, 0x000f, 0x6b6d, 0x0006, 0x7bcf, 0x0002, 0x4003, 0x7bef, 0x4003, 0x8410,
+	0x8002, 0x7bef, 0x7bef, 0xc004, 0x7bef, 0x0001, 0x738e, 0x0005, 0x5acb, 0x000d, 0x2124, 0x0019,
+	0x0001, 0xc003, 0x31a6, 0x0016, 0x7bef, 0x0001, 0x2104, 0x001b, 0x002a, 0x002a, 0xc003, 0x4228,
+	0x0013, 0x7bcf, 0x0002, 0x738e, 0x0007, 0x8002, 0x8410, 0x7bef, 0x400c, 0x8410, 0x8002, 0x7bef,
+	0x8410, 0xc003, 0x6b6d, 0x0007, 0x7bcf, 0x0003, 0x52aa, 0x000e, 0x002b, 0x0029, 0xc002, 0x2965,
+	0x0017, 0x6b6d, 0x0007, 0x8002, 0x7bef, 0x7bef, 0x4010, 0x8410, 0x8002, 0x7bef, 0x7bef, 0xc003,
+	0x6b6d, 0x0005, 0x39e7, 0x0014, 0x0020, 0x001f, 0x0029, 0x0027, 0xc002, 0x0841, 0x001e, 0x5aeb,
+	0x000b, 0x8002, 0x7bef, 0x7bef, 0x4015, 0x8410, 0x8001, 0x7bef, 0xc002, 0x634c, 0x0008, 0x10a2,
+	0x001c, 0x0028, 0x0026, 0xc002, 0x2104, 0x001a, 0x73ae, 0x0005, 0x8001, 0x7bef, 0x4018, 0x8410,
+	0x8001, 0x7bef, 0xc002, 0x73ae, 0x0003, 0x3186, 0x0017, 0x0027, 0x0025, 0xc002, 0x2104, 0x0019,
+	0x73ae, 0x0003, 0x8001, 0x7bef, 0x401a, 0x8410, 0x8001, 0x7bef, 0xc002, 0x7bef, 0x0001, 0x31a6,
+	0x0016, 0x0026, 0x0024, 0xc002, 0x2124, 0x001a, 0x73ae, 0x0003, 0x8001, 0x7bef, 0x4003, 0x8410,
+	0x8003, 0x7bef, 0x7bcf, 0x7bef, 0x4010, 0x8410, 0x8003, 0x7bef, 0x7bcf, 0x7bef, 0x4003, 0x8410,
+	0x8001, 0x7bef, 0xc002, 0x7bcf, 0x0002, 0x31a6, 0x0017, 0x0025, 0x0023, 0xc002, 0x1082, 0x001d,
+	0x738e, 0x0005, 0x8001, 0x7bef, 0x4003, 0x8410, 0x8005, 0x7bef, 0x9492, 0xb5b6, 0x9cd3, 0x7bef,
+	0x400e, 0x8410, 0x8005, 0x7bef, 0x9492, 0xb5b6, 0x9cf3, 0x7bef, 0x4003, 0x8410, 0x8001, 0x7bef,
+	0xc002, 0x73ae, 0x0003, 0x18e3, 0x001b, 0x0024, 0x0023, 0xc001, 0x5b0b, 0x000b, 0x8001, 0x7bef,
+	0x4003, 0x8410, 0x8007, 0x7bef, 0x8c51, 0xef7d, 0xffff, 0xf7be, 0x94b2, 0x7bef, 0x400c, 0x8410,
+	0x8007, 0x7bef, 0x8c71, 0xef7d, 0xffff, 0xf7de, 0x94b2, 0x7bef, 0x4003, 0x8410, 0x8001, 0x7bef,
+	0xc002, 0x634c, 0x0008, 0x0020, 0x001f, 0x0023, 0x0022, 0xc001, 0x39c7, 0x0016, 0x8001, 0x7bef,
+	0x4004, 0x8410, 0x8002, 0x7bef, 0x94b2, 0x4003, 0xffff, 0x8002, 0xad55, 0x7bcf, 0x400c, 0x8410,
+	0x8002, 0x7bef, 0x94b2, 0x4003, 0xffff, 0x8002, 0xa534, 0x7bcf, 0x4004, 0x8410, 0x8001, 0x7bcf,
+	0xc001, 0x4a49, 0x0012, 0x0023, 0x0021, 0xc002, 0x0020, 0x001f, 0x73ae, 0x0006, 0x8001, 0x7bef,
+	0x4006, 0x8410, 0x8003, 0xc638, 0xffdf, 0xd69a, 0x4010, 0x8410, 0x8005, 0xc638, 0xffdf, 0xd6ba,
+	0x8430, 0x7bef, 0x4004, 0x8410, 0x8001, 0x7bef, 0xc002, 0x73ae, 0x0003, 0x10a2, 0x001d, 0x0022,
+	0x0021, 0xc001, 0x39c7, 0x0016, 0x8001, 0x7bef, 0x4007, 0x8410, 0x8004, 0x7bef, 0x8c71, 0x8410,
+	0x7bef, 0x400f, 0x8410, 0x8004, 0x7bef, 0x8c71, 0x8410, 0x7bef, 0x4006, 0x8410, 0x8001, 0x7bef,
+	0xc001, 0x4a49, 0x0012, 0x0022, 0x0021, 0xc001, 0x6b4d, 0x000a, 0x8001, 0x7bef, 0x4008, 0x8410,
+	0x8001, 0x7bef, 0x4012, 0x8410, 0x8001, 0x7bef, 0x4008, 0x8410, 0x8001, 0x7bef, 0xc002, 0x73ae,
+	0x0006, 0x0020, 0x001f, 0x0021, 0x0020, 0xc002, 0x18e3, 0x001b, 0x7bcf, 0x0002, 0x4026, 0x8410,
+	0x8001, 0x7bef, 0xc001, 0x3186, 0x0017, 0x0021, 0x0020, 0xc001, 0x3a07, 0x0014, 0x8001, 0x7bef,
+	0x4026, 0x8410, 0x8001, 0x7bef, 0xc001, 0x528a, 0x0010, 0x0021, 0x0020, 0xc001, 0x52aa, 0x000e,
+	0x8001, 0x7bef, 0x4026, 0x8410, 0x8001, 0x7bef, 0xc001, 0x6b6d, 0x0008, 0x0021, 0x0020, 0xc001,
+	0x634c, 0x0009, 0x8001, 0x7bef, 0x4026, 0x8410, 0x8001, 0x7bef, 0xc001, 0x6b4d, 0x0006, 0x0021,
+	0x0020, 0xc001, 0x6b4d, 0x0006, 0x4028, 0x7bef, 0xc002, 0x738e, 0x0004, 0x0841, 0x001e, 0x0020,
+	0x0020, 0xc02b, 0x3a07, 0x0011, 0x528a, 0x000d, 0x4a69, 0x000e, 0x4a69, 0x000e, 0x4a69, 0x000e,
+	0x4a69, 0x000e, 0x4a69, 0x000e, 0x4a69, 0x000e, 0x4a69, 0x000e, 0x4a69, 0x000e, 0x4a69, 0x000e,
+	0x4a69, 0x000e, 0x4a69, 0x000e, 0x4a69, 0x000e, 0x4a69, 0x000e, 0x4a69, 0x000e, 0x4a69, 0x000e,
+	0x4a69, 0x000e, 0x4a69, 0x000e, 0x4a69, 0x000e, 0x4a69, 0x000e, 0x4a69, 0x000e, 0x4a69, 0x000e,
+	0x4a69, 0x000e, 0x4a69, 0x000e, 0x4a69, 0x000e, 0x4a69, 0x000e, 0x4a69, 0x000e, 0x4a69, 0x000e,
+	0x4a69, 0x000e, 0x4a69, 0x000e, 0x4a69, 0x000e, 0x4a69, 0x000e, 0x4a69, 0x000e, 0x4a69, 0x000e,
+	0x4a69, 0x000e, 0x4a69, 0x000e, 0x4a69, 0x000e, 0x4a69, 0x000e, 0x4a69, 0x000e, 0x528a, 0x000d,
+	0x4228, 0x0010, 0x0020, 0x001f, 0x0020, 0x0017, 0xc006, 0x1082, 0x001d, 0x4a49, 0x0011, 0x5acb,
+	0x000b, 0x52aa, 0x000c, 0x39c7, 0x0014, 0x0020, 0x001f, 0x0031, 0xc005, 0x3186, 0x0016, 0x52aa,
+	0x000d, 0x5aeb, 0x000a, 0x4a69, 0x0010, 0x18e3, 0x001b, 0x0018, 0x0016, 0xc002, 0x2965, 0x0018,
+	0x73ae, 0x0003, 0x4004, 0x7bef, 0xc002, 0x73ae, 0x0006, 0x2104, 0x001b, 0x0002, 0xc02b, 0x52aa,
+	0x000c, 0x6b4d, 0x0006, 0x632c, 0x0007, 0x632c, 0x0007, 0x632c, 0x0007, 0x632c, 0x0007, 0x632c,
+	0x0007, 0x632c, 0x0007, 0x632c, 0x0007, 0x632c, 0x0007, 0x632c, 0x0007, 0x632c, 0x0007, 0x632c,
+	0x0007, 0x632c, 0x0007, 0x632c, 0x0007, 0x632c, 0x0007, 0x632c, 0x0007, 0x632c, 0x0007, 0x632c,
+	0x0007, 0x632c, 0x0007, 0x632c, 0x0007, 0x632c, 0x0007, 0x632c, 0x0007, 0x632c, 0x0007, 0x632c,
+	0x0007, 0x632c, 0x0007, 0x632c, 0x0007, 0x632c, 0x0007, 0x632c, 0x0007, 0x632c, 0x0007, 0x632c,
+	0x0007, 0x632c, 0x0007, 0x632c, 0x0007, 0x632c, 0x0007, 0x632c, 0x0007, 0x632c, 0x0007, 0x632c,
+	0x0007, 0x632c, 0x0007, 0x632c, 0x0007, 0x632c, 0x0007, 0x6b4d, 0x0006, 0x630c, 0x0009, 0x0020,
+	0x001f, 0x0001, 0xc002, 0x0861, 0x001e, 0x6b6d, 0x0009, 0x8004, 0x7bef, 0x7bef, 0x8410, 0x7bef,
+	0xc002, 0x7bef, 0x0001, 0x39e7, 0x0014, 0x0017, 0x0015, 0xc002, 0x18c3, 0x001c, 0x73ae, 0x0003,
+	0x8001, 0x7bef, 0x4004, 0x8410, 0x8001, 0x7bcf, 0xc002, 0x738e, 0x0007, 0x0020, 0x001f, 0x0001,
+	0xc001, 0x6b4d, 0x0006, 0x8001, 0x7bef, 0x4026, 0x8410, 0x8001, 0x7bef, 0xc002, 0x73ae, 0x0003,
+	0x0841, 0x001e, 0x0001, 0xc001, 0x630c, 0x000b, 0x8001, 0x7bcf, 0x4004, 0x8410, 0x8001, 0x7bef,
+	0xc002, 0x7bef, 0x0001, 0x2945, 0x0019, 0x0016, 0x0015, 0xc001, 0x4248, 0x0012, 0x8001, 0x7bcf,
+	0x4006, 0x8410, 0x8001, 0x7bef, 0xc001, 0x3186, 0x0017, 0x0001, 0xc001, 0x6b4d, 0x0006, 0x4028,
+	0x8410, 0xc004, 0x73ae, 0x0003, 0x0020, 0x001f, 0x18c3, 0x001c, 0x7bef, 0x0001, 0x4006, 0x8410,
+	0x8001, 0x7bef, 0xc001, 0x5acb, 0x000d, 0x0016, 0x0015, 0xc001, 0x6b4d, 0x000a, 0x8001, 0x7bef,
+	0x4006, 0x8410, 0x8001, 0x7bef, 0xc001, 0x528a, 0x0010, 0x0001, 0xc001, 0x6b4d, 0x0006, 0x4028,
+	0x8410, 0xc001, 0x73ae, 0x0003, 0x0001, 0xc001, 0x31c6, 0x0016, 0x8001, 0x7bef, 0x4006, 0x8410,
+	0x8001, 0x7bef, 0xc001, 0x6b8d, 0x0006, 0x0016, 0x0015, 0xc001, 0x738e, 0x0008, 0x8001, 0x7bef,
+	0x4006, 0x8410, 0x8001, 0x7bef, 0xc001, 0x52aa, 0x000f, 0x0001, 0xc001, 0x632c, 0x0007, 0x4028,
+	0x8410, 0xc001, 0x73ae, 0x0003, 0x0001, 0xc001, 0x39e7, 0x0015, 0x8001, 0x7bef, 0x4006, 0x8410,
+	0x8001, 0x7bef, 0xc001, 0x73ae, 0x0005, 0x0016, 0x0015, 0xc001, 0x738e, 0x0008, 0x8001, 0x7bef,
+	0x4006, 0x8410, 0x8001, 0x7bef, 0xc001, 0x52aa, 0x000f, 0x0001, 0xc001, 0x632c, 0x0007, 0x4028,
+	0x8410, 0xc001, 0x73ae, 0x0003, 0x0001, 0xc001, 0x39e7, 0x0015, 0x8001, 0x7bef, 0x4006, 0x8410,
+	0x8001, 0x7bef, 0xc001, 0x73ae, 0x0005, 0x0016, 0x0015, 0xc001, 0x738e, 0x0008, 0x8001, 0x7bef,
+	0x4006, 0x8410, 0x8001, 0x7bef, 0xc001, 0x52aa, 0x000f, 0x0001, 0xc001, 0x632c, 0x0007, 0x4028,
+	0x8410, 0xc001, 0x73ae, 0x0003, 0x0001, 0xc001, 0x39e7, 0x0015, 0x8001, 0x7bef, 0x4006, 0x8410,
+	0x8001, 0x7bef, 0xc001, 0x73ae, 0x0005, 0x0016, 0x0015, 0xc001, 0x738e, 0x0008, 0x8001, 0x7bef,
+	0x4006, 0x8410, 0x8001, 0x7bef, 0xc001, 0x52aa, 0x000f, 0x0001, 0xc001, 0x632c, 0x0007, 0x4028,
+	0x8410, 0xc001, 0x73ae, 0x0003, 0x0001, 0xc001, 0x39e7, 0x0015, 0x8001, 0x7bef, 0x4006, 0x8410,
+	0x8001, 0x7bef, 0xc001, 0x73ae, 0x0005, 0x0016, 0x0015, 0xc001, 0x738e, 0x0008, 0x8001, 0x7bef,
+	0x4006, 0x8410, 0x8001, 0x7bef, 0xc001, 0x52aa, 0x000f, 0x0001, 0xc001, 0x632c, 0x0007, 0x4028,
+	0x8410, 0xc001, 0x73ae, 0x0003, 0x0001, 0xc001, 0x39e7, 0x0015, 0x8001, 0x7bef, 0x4006, 0x8410,
+	0x8001, 0x7bef, 0xc001, 0x73ae, 0x0005, 0x0016, 0x0015, 0xc001, 0x738e, 0x0008, 0x8001, 0x7bef,
+	0x4006, 0x8410, 0x8001, 0x7bef, 0xc001, 0x52aa, 0x000f, 0x0001, 0xc001, 0x632c, 0x0007, 0x4028,
+	0x8410, 0xc001, 0x73ae, 0x0003, 0x0001, 0xc001, 0x39e7, 0x0015, 0x8001, 0x7bef, 0x4006, 0x8410,
+	0x8001, 0x7bef, 0xc001, 0x73ae, 0x0005, 0x0016, 0x0015, 0xc001, 0x738e, 0x0008, 0x8001, 0x7bef,
+	0x4006, 0x8410, 0x8001, 0x7bef, 0xc001, 0x52aa, 0x000f, 0x0001, 0xc001, 0x632c, 0x0007, 0x4028,
+	0x8410, 0xc001, 0x73ae, 0x0003, 0x0001, 0xc001, 0x39e7, 0x0015, 0x8001, 0x7bef, 0x4006, 0x8410,
+	0x8001, 0x7bef, 0xc001, 0x73ae, 0x0005, 0x0016, 0x0015, 0xc001, 0x738e, 0x0008, 0x8001, 0x7bef,
+	0x4006, 0x8410, 0x8001, 0x7bef, 0xc001, 0x52aa, 0x000f, 0x0001, 0xc001, 0x632c, 0x0007, 0x4028,
+	0x8410, 0xc001, 0x73ae, 0x0003, 0x0001, 0xc001, 0x39e7, 0x0015, 0x8001, 0x7bef, 0x4006, 0x8410,
+	0x8001, 0x7bef, 0xc001, 0x73ae, 0x0005, 0x0016, 0x0015, 0xc001, 0x738e, 0x0008, 0x8001, 0x7bef,
+	0x4006, 0x8410, 0x8001, 0x7bef, 0xc001, 0x52aa, 0x000f, 0x0001, 0xc001, 0x632c, 0x0007, 0x4028,
+	0x8410, 0xc001, 0x73ae, 0x0003, 0x0001, 0xc001, 0x39e7, 0x0015, 0x8001, 0x7bef, 0x4006, 0x8410,
+	0x8001, 0x7bef, 0xc001, 0x73ae, 0x0005, 0x0016, 0x0015, 0xc001, 0x738e, 0x0008, 0x8001, 0x7bef,
+	0x4006, 0x8410, 0x8001, 0x7bef, 0xc001, 0x52aa, 0x000f, 0x0001, 0xc001, 0x632c, 0x0007, 0x4028,
+	0x8410, 0xc001, 0x73ae, 0x0003, 0x0001, 0xc001, 0x39e7, 0x0015, 0x8001, 0x7bef, 0x4006, 0x8410,
+	0x8001, 0x7bef, 0xc001, 0x73ae, 0x0005, 0x0016, 0x0015, 0xc001, 0x738e, 0x0008, 0x8001, 0x7bef,
+	0x4006, 0x8410, 0x8001, 0x7bef, 0xc001, 0x52aa, 0x000f, 0x0001, 0xc001, 0x632c, 0x0007, 0x4028,
+	0x8410, 0xc001, 0x73ae, 0x0003, 0x0001, 0xc001, 0x39e7, 0x0015, 0x8001, 0x7bef, 0x4006, 0x8410,
+	0x8001, 0x7bef, 0xc001, 0x73ae, 0x0005, 0x0016, 0x0015, 0xc001, 0x738e, 0x0008, 0x8001, 0x7bef,
+	0x4006, 0x8410, 0x8001, 0x7bef, 0xc001, 0x52aa, 0x000f, 0x0001, 0xc001, 0x632c, 0x0007, 0x4028,
+	0x8410, 0xc001, 0x73ae, 0x0003, 0x0001, 0xc001, 0x39e7, 0x0015, 0x8001, 0x7bef, 0x4006, 0x8410,
+	0x8001, 0x7bef, 0xc001, 0x73ae, 0x0005, 0x0016, 0x0015, 0xc001, 0x738e, 0x0008, 0x8001, 0x7bef,
+	0x4006, 0x8410, 0x8001, 0x7bef, 0xc001, 0x52aa, 0x000f, 0x0001, 0xc001, 0x632c, 0x0007, 0x4028,
+	0x8410, 0xc001, 0x73ae, 0x0003, 0x0001, 0xc001, 0x39e7, 0x0015, 0x8001, 0x7bef, 0x4006, 0x8410,
+	0x8001, 0x7bef, 0xc001, 0x73ae, 0x0005, 0x0016, 0x0015, 0xc001, 0x738e, 0x0008, 0x8001, 0x7bef,
+	0x4006, 0x8410, 0x8001, 0x7bef, 0xc001, 0x52aa, 0x000f, 0x0001, 0xc001, 0x632c, 0x0007, 0x4028,
+	0x8410, 0xc001, 0x73ae, 0x0003, 0x0001, 0xc001, 0x39e7, 0x0015, 0x8001, 0x7bef, 0x4006, 0x8410,
+	0x8001, 0x7bef, 0xc001, 0x73ae, 0x0005, 0x0016, 0x0015, 0xc001, 0x738e, 0x0008, 0x8001, 0x7bef,
+	0x4006, 0x8410, 0x8001, 0x7bef, 0xc001, 0x52aa, 0x000f, 0x0001, 0xc001, 0x632c, 0x0007, 0x4028,
+	0x8410, 0xc001, 0x73ae, 0x0003, 0x0001, 0xc001, 0x39e7, 0x0015, 0x8001, 0x7bef, 0x4006, 0x8410,
+	0x8001, 0x7bef, 0xc001, 0x73ae, 0x0005, 0x0016, 0x0015, 0xc001, 0x738e, 0x0008, 0x8001, 0x7bef,
+	0x4006, 0x8410, 0x8001, 0x7bef, 0xc001, 0x52aa, 0x000f, 0x0001, 0xc001, 0x632c, 0x0007, 0x4028,
+	0x8410, 0xc001, 0x73ae, 0x0003, 0x0001, 0xc001, 0x39e7, 0x0015, 0x8001, 0x7bef, 0x4006, 0x8410,
+	0x8001, 0x7bef, 0xc001, 0x73ae, 0x0005, 0x0016, 0x0015, 0xc001, 0x738e, 0x0008, 0x8001, 0x7bef,
+	0x4006, 0x8410, 0x8001, 0x7bef, 0xc001, 0x52aa, 0x000f, 0x0001, 0xc001, 0x632c, 0x0007, 0x4028,
+	0x8410, 0xc001, 0x73ae, 0x0003, 0x0001, 0xc001, 0x39e7, 0x0015, 0x8001, 0x7bef, 0x4006, 0x8410,
+	0x8001, 0x7bef, 0xc001, 0x73ae, 0x0005, 0x0016, 0x0015, 0xc001, 0x738e, 0x0008, 0x8001, 0x7bef,
+	0x4006, 0x8410, 0x8001, 0x7bef, 0xc001, 0x52aa, 0x000f, 0x0001, 0xc001, 0x632c, 0x0007, 0x4028,
+	0x8410, 0xc001, 0x73ae, 0x0003, 0x0001, 0xc001, 0x39e7, 0x0015, 0x8001, 0x7bef, 0x4006, 0x8410,
+	0x8001, 0x7bef, 0xc001, 0x73ae, 0x0005, 0x0016, 0x0015, 0xc001, 0x73ae, 0x0008, 0x8001, 0x7bef,
+	0x4006, 0x8410, 0x8001, 0x7bef, 0xc001, 0x52aa, 0x000f, 0x0001, 0xc001, 0x632c, 0x0007, 0x4028,
+	0x8410, 0xc001, 0x73ae, 0x0003, 0x0001, 0xc001, 0x39e7, 0x0015, 0x8001, 0x7bef, 0x4006, 0x8410,
+	0x8001, 0x7bef, 0xc001, 0x73ae, 0x0005, 0x0016, 0x0015, 0xc001, 0x636c, 0x0009, 0x8001, 0x7bef,
+	0x4006, 0x8410, 0x8001, 0x7bef, 0xc001, 0x52aa, 0x000f, 0x0001, 0xc001, 0x632c, 0x0007, 0x4028,
+	0x8410, 0xc001, 0x73ae, 0x0003, 0x0001, 0xc001, 0x31c6, 0x0016, 0x8001, 0x7bef, 0x4006, 0x8410,
+	0x8001, 0x7bef, 0xc001, 0x6b8d, 0x0006, 0x0016, 0x0015, 0xc001, 0x528a, 0x0010, 0x8001, 0x7bef,
+	0x4006, 0x8410, 0x8001, 0x7bef, 0xc001, 0x39e7, 0x0015, 0x0001, 0xc001, 0x6b4d, 0x0006, 0x4028,
+	0x8410, 0xc001, 0x73ae, 0x0003, 0x0001, 0xc001, 0x2104, 0x001a, 0x8001, 0x7bef, 0x4006, 0x8410,
+	0x8001, 0x7bef, 0xc001, 0x632c, 0x000a, 0x0016, 0x0015, 0xc002, 0x2104, 0x001a, 0x7bcf, 0x0002,
+	0x8001, 0x7bef, 0x4004, 0x8410, 0x8001, 0x7bef, 0xc002, 0x738e, 0x0005, 0x0861, 0x001e, 0x0001,
+	0xc001, 0x6b4d, 0x0006, 0x4028, 0x8410, 0xc002, 0x73ae, 0x0003, 0x0020, 0x001f, 0x0001, 0xc001,
+	0x634c, 0x0009, 0x8001, 0x7bcf, 0x4005, 0x8410, 0x8001, 0x7bef, 0xc001, 0x3186, 0x0017, 0x0016,
+	0x0016, 0xc002, 0x39e7, 0x0014, 0x7bef, 0x0001, 0x8004, 0x7bef, 0x8410, 0x8410, 0x7bef, 0xc002,
+	0x738e, 0x0004, 0x2945, 0x0019, 0x0002, 0xc001, 0x6b4d, 0x0006, 0x4028, 0x8410, 0xc002, 0x73ae,
+	0x0003, 0x0841, 0x001e, 0x0001, 0xc002, 0x2104, 0x001b, 0x73ae, 0x0005, 0x8005, 0x7bef, 0x7bef,
+	0x8410, 0x7bef, 0x7bef, 0xc001, 0x4a89, 0x0010, 0x0017, 0x0017, 0xc006, 0x2124, 0x0019, 0x5aeb,
+	0x000c, 0x6b4d, 0x0006, 0x6b4d, 0x0007, 0x4a69, 0x000f, 0x0881, 0x001d, 0x0003, 0xc001, 0x6b4d,
+	0x0006, 0x4028, 0x8410, 0xc002, 0x73ae, 0x0003, 0x0841, 0x001e, 0x0002, 0xc006, 0x0841, 0x001e,
+	0x4228, 0x0011, 0x6b4d, 0x0007, 0x6b4d, 0x0006, 0x630c, 0x000a, 0x3186, 0x0017, 0x0018, 0x0020,
+	0xc001, 0x6b4d, 0x0006, 0x4028, 0x8410, 0xc002, 0x73ae, 0x0003, 0x0841, 0x001e, 0x0020, 0x0020,
+	0xc001, 0x6b4d, 0x0006, 0x4028, 0x8410, 0xc002, 0x73ae, 0x0003, 0x0841, 0x001e, 0x0020, 0x0020,
+	0xc001, 0x6b4d, 0x0007, 0x4028, 0x8410, 0xc002, 0x738e, 0x0004, 0x0841, 0x001e, 0x0020, 0x0020,
+	0xc001, 0x5b0b, 0x000c, 0x8001, 0x7bcf, 0x4026, 0x8410, 0x8001, 0x7bef, 0xc001, 0x738e, 0x0007,
+	0x0021, 0x0020, 0xc001, 0x3186, 0x0018, 0x8002, 0x7bef, 0x7bef, 0x4025, 0x8410, 0x8001, 0x7bcf,
+	0xc001, 0x4228, 0x0013, 0x0021, 0x0021, 0xc001, 0x4228, 0x0013, 0x8002, 0x7bef, 0x7bef, 0x4023,
+	0x8410, 0x8001, 0x7bef, 0xc001, 0x5b0b, 0x000d, 0x0022, 0x0022, 0xc002, 0x39c7, 0x0014, 0x738e,
+	0x0005, 0x8001, 0x8410, 0x4003, 0x7bef, 0x400a, 0x8410, 0x4006, 0x7bef, 0x400a, 0x8410, 0x4004,
+	0x7bef, 0xc003, 0x73ae, 0x0003, 0x4248, 0x0011, 0x0020, 0x001f, 0x0022, 0x0023, 0xc006, 0x0020,
+	0x001f, 0x18e3, 0x001a, 0x31a6, 0x0017, 0x31a6, 0x0017, 0x3186, 0x0018, 0x528a, 0x000f, 0x8001,
+	0x7bef, 0x4006, 0x8410, 0x8001, 0x7bef, 0xc008, 0x73ae, 0x0003, 0x31c6, 0x0016, 0x31a6, 0x0017,
+	0x31a6, 0x0017, 0x31a6, 0x0017, 0x31a6, 0x0017, 0x3186, 0x0017, 0x738e, 0x0005, 0x8001, 0x7bef,
+	0x4006, 0x8410, 0x8001, 0x7bef, 0xc006, 0x5aeb, 0x000c, 0x2965, 0x0018, 0x31a6, 0x0017, 0x31a6,
+	0x0017, 0x2124, 0x0019, 0x0841, 0x001e, 0x0024, 0x0028, 0xc001, 0x2985, 0x0015, 0x8001, 0x7bef,
+	0x4006, 0x8410, 0x8001, 0x7bef, 0xc002, 0x73ae, 0x0004, 0x0020, 0x001f, 0x0005, 0xc001, 0x6b4d,
+	0x0007, 0x8001, 0x7bef, 0x4007, 0x8410, 0xc001, 0x39e7, 0x0011, 0x0029, 0x0028, 0xc001, 0x2965,
+	0x0015, 0x4007, 0x8410, 0x8001, 0x7bef, 0xc002, 0x73ae, 0x0004, 0x0020, 0x001f, 0x0005, 0xc001,
+	0x6b6d, 0x0007, 0x8001, 0x7bef, 0x4007, 0x8410, 0xc001, 0x39e7, 0x0011, 0x0029, 0x0028, 0xc001,
+	0x2985, 0x0015, 0x4007, 0x8410, 0x8001, 0x7bef, 0xc002, 0x73ae, 0x0004, 0x0020, 0x001f, 0x0005,
+	0xc001, 0x6b6d, 0x0007, 0x8001, 0x7bef, 0x4007, 0x8410, 0xc001, 0x39e7, 0x0011, 0x0029, 0x0028,
+	0xc001, 0x2985, 0x0015, 0x4007, 0x8410, 0x8001, 0x7bef, 0xc002, 0x73ae, 0x0004, 0x0020, 0x001f,
+	0x0005, 0xc001, 0x6b6d, 0x0007, 0x8001, 0x7bef, 0x4007, 0x8410, 0xc001, 0x39e7, 0x0011, 0x0029,
+	0x0028, 0xc001, 0x2985, 0x0015, 0x4007, 0x8410, 0x8001, 0x7bef, 0xc002, 0x73ae, 0x0004, 0x0020,
+	0x001f, 0x0005, 0xc001, 0x6b6d, 0x0007, 0x8001, 0x7bef, 0x4007, 0x8410, 0xc001, 0x39e7, 0x0011,
+	0x0029, 0x0028, 0xc001, 0x2985, 0x0015, 0x4007, 0x8410, 0x8001, 0x7bef, 0xc002, 0x73ae, 0x0004,
+	0x0020, 0x001f, 0x0005, 0xc001, 0x6b6d, 0x0007, 0x8001, 0x7bef, 0x4007, 0x8410, 0xc001, 0x39e7,
+	0x0011, 0x0029, 0x0028, 0xc001, 0x2985, 0x0015, 0x4007, 0x8410, 0x8001, 0x7bef, 0xc002, 0x73ae,
+	0x0004, 0x0020, 0x001f, 0x0005, 0xc001, 0x6b6d, 0x0007, 0x8001, 0x7bef, 0x4007, 0x8410, 0xc001,
+	0x39e7, 0x0011, 0x0029, 0x0028, 0xc001, 0x2985, 0x0015, 0x4007, 0x8410, 0x8001, 0x7bef, 0xc002,
+	0x73ae, 0x0004, 0x0020, 0x001f, 0x0005, 0xc001, 0x6b6d, 0x0007, 0x8001, 0x7bef, 0x4007, 0x8410,
+	0xc001, 0x39e7, 0x0011, 0x0029, 0x0028, 0xc001, 0x2965, 0x0015, 0x4007, 0x8410, 0x8001, 0x7bef,
+	0xc002, 0x73ae, 0x0004, 0x0020, 0x001f, 0x0005, 0xc001, 0x6b4d, 0x0007, 0x8001, 0x7bef, 0x4007,
+	0x8410, 0xc001, 0x39e7, 0x0011, 0x0029, 0x0028, 0xc001, 0x2985, 0x0015, 0x4007, 0x8410, 0x8001,
+	0x7bef, 0xc002, 0x73ae, 0x0004, 0x0020, 0x001f, 0x0005, 0xc001, 0x6b6d, 0x0007, 0x8001, 0x7bef,
+	0x4007, 0x8410, 0xc001, 0x39e7, 0x0011, 0x0029, 0x0028, 0xc001, 0x2124, 0x0019, 0x8001, 0x7bef,
+	0x4006, 0x8410, 0x8001, 0x7bef, 0xc001, 0x6b6d, 0x0007, 0x0006, 0xc001, 0x5aeb, 0x000c, 0x8001,
+	0x7bef, 0x4006, 0x8410, 0x8001, 0x7bef, 0xc001, 0x3a07, 0x0014, 0x0029, 0x0029, 0xc001, 0x6b4d,
+	0x000a, 0x8001, 0x7bcf, 0x4005, 0x8410, 0x8001, 0x7bcf, 0xc001, 0x39e7, 0x0014, 0x0006, 0xc002,
+	0x2965, 0x0018, 0x73ce, 0x0001, 0x4005, 0x8410, 0x8001, 0x7bef, 0xc002, 0x6b8d, 0x0006, 0x0861,
+	0x001e, 0x0029, 0x0029, 0xc002, 0x18c3, 0x001c, 0x6b6d, 0x0006, 0x4005, 0x7bef, 0xc001, 0x52aa,
+	0x000f, 0x0008, 0xc001, 0x4228, 0x0013, 0x4005, 0x7bef, 0xc002, 0x73ae, 0x0003, 0x2945, 0x0019,
+	0x002a, 0x002a, 0xc006, 0x0841, 0x001e, 0x4a69, 0x0010, 0x6b6d, 0x0007, 0x738e, 0x0005, 0x632c,
+	0x0009, 0x31a6, 0x0016, 0x000a, 0xc006, 0x2104, 0x0019, 0x5b0b, 0x000b, 0x738e, 0x0005, 0x6b6d,
+	0x0006, 0x528a, 0x000e, 0x10a2, 0x001c, 0x002b, 0x006b, 0x006b, 0x006b, 0x006b, 0x006b, 0x006b,
+	0x006b, 0x006b, 0x006b, 0x006b, 0x006b, 0x006b, 0x006b, 0x006b, 0x006b, 0x006b, 0x006b, 0x006b,
+	0x006b, 0x006b, 0x006b, 0x006b, 0x006b, 0x006b,
+};
+
+const int dataAndroidOSRLE_width = 107;
+const int dataAndroidOSRLE_height = 107;
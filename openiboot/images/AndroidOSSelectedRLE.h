@@ -0,0 +1,689 @@
+const uint16_t dataAndroidOSSelectedRLE[] = {
+	0x000a, 0xc056, 0x0841, 0x001c, 0x1082, 0x0018, 0x18e3, 0x0013, 0x18e3, 0x0013, 0x18e3, 0x0013,
+	0x18e3, 0x0013, 0x18e3, 0x0013, 0x18e3, 0x0013, 0x18e3, 0x0013, 0x18e3, 0x0013, 0x18e3, 0x0013,
+	0x18e3, 0x0013, 0x18e3, 0x0013, 0x18e3, 0x0013, 0x18e3, 0x0013, 0x18e3, 0x0013, 0x18e3, 0x0013,
+	0x18e3, 0x0013, 0x18e3, 0x0013, 0x18e3, 0x0013, 0x18e3, 0x0013, 0x18e3, 0x0013, 0x18e3, 0x0013,
+	0x18e3, 0x0013, 0x18e3, 0x0013, 0x18e3, 0x0013, 0x18e3, 0x0013, 0x18e3, 0x0013, 0x18e3, 0x0013,
+	0x18e3, 0x0013, 0x18e3, 0x0013, 0x18e3, 0x0013, 0x18e3, 0x0013, 0x18e3, 0x0013, 0x18e3, 0x0013,
+	0x18e3, 0x0013, 0x18e3, 0x0013, 0x18e3, 0x0013, 0x18e3, 0x0013, 0x18e3, 0x0013, 0x18e3, 0x0013,
+	0x18e3, 0x0013, 0x18e3, 0x0013, 0x18e3, 0x0013, 0x18e3, 0x0013, 0x18e3, 0x0013, 0x18e3, 0x0013,
+	0x18e3, 0x0013, 0x18e3, 0x0013, 0x18e3, 0x0013, 0x18e3, 0x0013, 0x18e3, 0x0013, 0x18e3, 0x0013,
+	0x18e3, 0x0013, 0x18e3, 0x0013, 0x18e3, 0x0013, 0x18e3, 0x0013, 0x18e3, 0x0013, 0x18e3, 0x0013,
+	0x18e3, 0x0013, 0x18e3, 0x0013, 0x18e3, 0x0013, 0x18e3, 0x0013, 0x18e3, 0x0013, 0x18e3, 0x0013,
+	0x18e3, 0x0013, 0x18e3, 0x0013, 0x18e3, 0x0013, 0x18e3, 0x0013, 0x18e3, 0x0013, 0x18e3, 0x0013,
+	0x18e3, 0x0013, 0x18e3, 0x0013, 0x18e3, 0x0013, 0x18e3, 0x0013, 0x18e3, 0x0013, 0x18e3, 0x0013,
+	0x18e3, 0x0013, 0x18e3, 0x0013, 0x18e3, 0x0013, 0x18e3, 0x0013, 0x18e3, 0x0013, 0x18e3, 0x0013,
+	0x18e3, 0x0013, 0x10a2, 0x0016, 0x0861, 0x001a, 0x000b, 0x0007, 0xc003, 0x0861, 0x0019, 0x2965,
+	0x000c, 0x39e7, 0x0004, 0x4056, 0x4a49, 0xc003, 0x4208, 0x0002, 0x3186, 0x0009, 0x18c3, 0x0014,
+	0x0008, 0x0005, 0xc002, 0x0020, 0x001e, 0x2965, 0x000b, 0x4003, 0x4a49, 0x8002, 0x4208, 0x39c7,
+	0x4016, 0x2965, 0x4007, 0x3166, 0x4019, 0x3186, 0x4007, 0x3166, 0x4015, 0x2965, 0x8002, 0x31a6,
+	0x39e7, 0x4003, 0x4a49, 0xc002, 0x31a6, 0x0008, 0x10a2, 0x0017, 0x0006, 0x0004, 0xc002, 0x0861,
+	0x0019, 0x39e7, 0x0004, 0x8004, 0x4a49, 0x4a49, 0x2945, 0x0841, 0x4016, 0x0000, 0x4004, 0x0020,
+	0x4003, 0x0821, 0x4005, 0x0841, 0x4003, 0x0861, 0x4004, 0x1062, 0x4005, 0x1082, 0x4004, 0x1062,
+	0x4003, 0x0861, 0x4005, 0x0841, 0x4003, 0x0821, 0x4004, 0x0020, 0x4015, 0x0000, 0x8005, 0x0020,
+	0x20e4, 0x4208, 0x4a49, 0x4a49, 0xc001, 0x2945, 0x000d, 0x0005, 0x0003, 0xc001, 0x0861, 0x0019,
+	0x8004, 0x4a49, 0x4a49, 0x31a6, 0x0841, 0x4016, 0x0000, 0x4004, 0x0020, 0x8002, 0x0821, 0x0821,
+	0x4004, 0x0841, 0x8003, 0x0861, 0x1062, 0x1062, 0x4015, 0x1082, 0x8003, 0x1062, 0x1062, 0x0861,
+	0x4004, 0x0841, 0x8002, 0x0821, 0x0821, 0x4004, 0x0020, 0x4016, 0x0000, 0x8003, 0x2124, 0x4a49,
+	0x4a49, 0xc001, 0x2965, 0x000c, 0x0004, 0x0002, 0xc001, 0x0841, 0x001b, 0x8003, 0x4a49, 0x4a49,
+	0x2945, 0x4016, 0x0000, 0x4003, 0x0020, 0x4003, 0x0821, 0x8005, 0x0841, 0x0841, 0x0861, 0x0861,
+	0x1062, 0x4006, 0x1082, 0x4011, 0x10a2, 0x4006, 0x1082, 0x8005, 0x1062, 0x0861, 0x0861, 0x0841,
+	0x0841, 0x4003, 0x0821, 0x4003, 0x0020, 0x4015, 0x0000, 0x8003, 0x10a2, 0x4a49, 0x4a49, 0xc001,
+	0x18e3, 0x0012, 0x0003, 0x0002, 0xc001, 0x31a6, 0x0008, 0x8002, 0x4a49, 0x2965, 0x4015, 0x0000,
+	0x4003, 0x0020, 0x8002, 0x0821, 0x0821, 0x4003, 0x0841, 0x8002, 0x0861, 0x1062, 0x4004, 0x1082,
+	0x4009, 0x10a2, 0x4009, 0x18a3, 0x4009, 0x10a2, 0x4004, 0x1082, 0x8002, 0x1062, 0x0861, 0x4003,
+	0x0841, 0x8002, 0x0821, 0x0821, 0x4003, 0x0020, 0x4014, 0x0000, 0x8003, 0x18c3, 0x4a49, 0x4a49,
+	0xc001, 0x0861, 0x001a, 0x0002, 0x0001, 0xc001, 0x18e3, 0x0012, 0x8002, 0x4a49, 0x4208, 0x4014,
+	0x0000, 0x4003, 0x0020, 0x8002, 0x0821, 0x0821, 0x4003, 0x0841, 0x8002, 0x0861, 0x1062, 0x4003,
+	0x1082, 0x4006, 0x10a2, 0x4008, 0x18a3, 0x4005, 0x18c3, 0x400a, 0x18a3, 0x4004, 0x10a2, 0x4003,
+	0x1082, 0x8002, 0x1062, 0x0861, 0x4003, 0x0841, 0x8002, 0x0821, 0x0821, 0x4003, 0x0020, 0x4013,
+	0x0000, 0x8002, 0x2965, 0x4a49, 0xc001, 0x3186, 0x000a, 0x0002, 0x0001, 0xc001, 0x31a6, 0x0008,
+	0x8002, 0x4a49, 0x18c3, 0x4013, 0x0000, 0x4003, 0x0020, 0x8001, 0x0821, 0x4003, 0x0841, 0x8002,
+	0x0861, 0x1062, 0x4003, 0x1082, 0x4004, 0x10a2, 0x8002, 0x4a49, 0x6b4d, 0x4003, 0x18a3, 0x4013,
+	0x18c3, 0x8006, 0x18a3, 0x18a3, 0x5aeb, 0x5acb, 0x18a3, 0x18a3, 0x4003, 0x10a2, 0x4003, 0x1082,
+	0x8002, 0x1062, 0x0861, 0x4003, 0x0841, 0x8001, 0x0821, 0x4003, 0x0020, 0x4012, 0x0000, 0x8003,
+	0x0821, 0x4a49, 0x4a49, 0xc001, 0x0861, 0x0019, 0x0001, 0xc001, 0x0861, 0x0019, 0x8002, 0x4a49,
+	0x4208, 0x4012, 0x0000, 0x4003, 0x0020, 0x8008, 0x0821, 0x0821, 0x0841, 0x0841, 0x0861, 0x1062,
+	0x1082, 0x1082, 0x4004, 0x10a2, 0x4003, 0x18a3, 0x8003, 0x39e7, 0x7bef, 0x4a49, 0x4016, 0x18c3,
+	0x8003, 0x31a6, 0x7bef, 0x528a, 0x4005, 0x18a3, 0x4004, 0x10a2, 0x8007, 0x1082, 0x1062, 0x0861,
+	0x0841, 0x0841, 0x0821, 0x0821, 0x4003, 0x0020, 0x4011, 0x0000, 0x8002, 0x2945, 0x4a49, 0xc001,
+	0x2124, 0x000f, 0x0001, 0xc001, 0x18e3, 0x0012, 0x8002, 0x4a49, 0x2945, 0x4011, 0x0000, 0x4003,
+	0x0020, 0x8007, 0x0821, 0x0841, 0x0841, 0x0861, 0x1062, 0x1082, 0x1082, 0x4004, 0x10a2, 0x4003,
+	0x18a3, 0x4003, 0x18c3, 0x8003, 0x6b2d, 0x73ae, 0x18e3, 0x4004, 0x18c3, 0x400d, 0x18e3, 0x4004,
+	0x18c3, 0x8002, 0x738e, 0x738e, 0x4004, 0x18c3, 0x4004, 0x18a3, 0x4004, 0x10a2, 0x8006, 0x1082,
+	0x1062, 0x0861, 0x0841, 0x0841, 0x0821, 0x4003, 0x0020, 0x4010, 0x0000, 0x8002, 0x1082, 0x4a49,
+	0xc001, 0x39c7, 0x0007, 0x0001, 0xc001, 0x2965, 0x000b, 0x8002, 0x4a49, 0x18c3, 0x4010, 0x0000,
+	0x8007, 0x0020, 0x0020, 0x0821, 0x0821, 0x0841, 0x0841, 0x0861, 0x4003, 0x1082, 0x4003, 0x10a2,
+	0x4003, 0x18a3, 0x4005, 0x18c3, 0x8003, 0x3186, 0x7bef, 0x5aeb, 0x4006, 0x18e3, 0x400d, 0x20e4,
+	0x8004, 0x18e3, 0x4228, 0x7bcf, 0x4a29, 0x4006, 0x18c3, 0x4004, 0x18a3, 0x4003, 0x10a2, 0x8009,
+	0x1082, 0x1082, 0x0861, 0x0841, 0x0841, 0x0821, 0x0821, 0x0020, 0x0020, 0x400f, 0x0000, 0x8003,
+	0x0020, 0x4a49, 0x4a49, 0xc001, 0x0000, 0x001f, 0xc001, 0x39c7, 0x0007, 0x8002, 0x4a49, 0x1082,
+	0x400f, 0x0000, 0x8009, 0x0020, 0x0020, 0x0821, 0x0821, 0x0841, 0x0861, 0x1062, 0x1082, 0x1082,
+	0x4003, 0x10a2, 0x8002, 0x18a3, 0x18a3, 0x4007, 0x18c3, 0x8013, 0x18e3, 0x18e3, 0x630c, 0x7bef,
+	0x2945, 0x20e4, 0x20e4, 0x2104, 0x2104, 0x3186, 0x4a49, 0x528a, 0x52aa, 0x528a, 0x528a, 0x52aa,
+	0x52aa, 0x4a29, 0x31a6, 0x4003, 0x2104, 0x8007, 0x20e4, 0x20e4, 0x7bcf, 0x6b6d, 0x20e4, 0x18e3,
+	0x18e3, 0x4007, 0x18c3, 0x4003, 0x18a3, 0x4003, 0x10a2, 0x8008, 0x1082, 0x1062, 0x0861, 0x0841,
+	0x0821, 0x0821, 0x0020, 0x0020, 0x400f, 0x0000, 0x8002, 0x4228, 0x4a49, 0xc001, 0x0020, 0x001d,
+	0xc001, 0x39c7, 0x0006, 0x8002, 0x4a49, 0x1062, 0x400d, 0x0000, 0x4003, 0x0020, 0x8004, 0x0821,
+	0x0841, 0x0841, 0x0861, 0x4003, 0x1082, 0x8002, 0x10a2, 0x10a2, 0x4003, 0x18a3, 0x4006, 0x18c3,
+	0x4003, 0x18e3, 0x8009, 0x20e4, 0x2925, 0x7bef, 0x630c, 0x2104, 0x39c7, 0x632c, 0x73ae, 0x8410,
+	0x4003, 0x7bef, 0x4003, 0x8410, 0x800a, 0x7bef, 0x7bef, 0x8410, 0x7bcf, 0x6b4d, 0x4208, 0x2104,
+	0x4a69, 0x7bef, 0x39c7, 0x4004, 0x20e4, 0x4003, 0x18e3, 0x4004, 0x18c3, 0x4003, 0x18a3, 0x4003,
+	0x10a2, 0x8006, 0x1082, 0x1082, 0x0861, 0x0841, 0x0841, 0x0821, 0x4003, 0x0020, 0x400d, 0x0000,
+	0x8002, 0x4208, 0x4a49, 0xc001, 0x0841, 0x001c, 0xc001, 0x39c7, 0x0006, 0x8002, 0x4a49, 0x1062,
+	0x400c, 0x0000, 0x4003, 0x0020, 0x8006, 0x0821, 0x0841, 0x0841, 0x1062, 0x1082, 0x1082, 0x4003,
+	0x10a2, 0x8002, 0x18a3, 0x18a3, 0x4005, 0x18c3, 0x4003, 0x18e3, 0x8002, 0x20e4, 0x20e4, 0x4003,
+	0x2104, 0x8005, 0x5acb, 0x7bef, 0x7bcf, 0x7bef, 0x7bef, 0x400c, 0x8410, 0x8005, 0x7bef, 0x8410,
+	0x7bcf, 0x7bef, 0x6b4d, 0x4004, 0x2104, 0x4003, 0x20e4, 0x4003, 0x18e3, 0x4004, 0x18c3, 0x4003,
+	0x18a3, 0x4003, 0x10a2, 0x8005, 0x1082, 0x1062, 0x0841, 0x0841, 0x0821, 0x4003, 0x0020, 0x400c,
+	0x0000, 0x8002, 0x4208, 0x4a49, 0xc001, 0x0841, 0x001c, 0xc001, 0x39c7, 0x0006, 0x8002, 0x4a49,
+	0x1062, 0x400b, 0x0000, 0x4003, 0x0020, 0x8006, 0x0821, 0x0841, 0x0841, 0x1062, 0x1082, 0x1082,
+	0x4003, 0x10a2, 0x8001, 0x18a3, 0x4005, 0x18c3, 0x4003, 0x18e3, 0x8001, 0x20e4, 0x4005, 0x2104,
+	0x8004, 0x4a49, 0x73ae, 0x7bef, 0x7bef, 0x4010, 0x8410, 0x8005, 0x7bef, 0x7bef, 0x7bcf, 0x52aa,
+	0x2124, 0x4005, 0x2104, 0x8002, 0x20e4, 0x20e4, 0x4003, 0x18e3, 0x4004, 0x18c3, 0x8002, 0x18a3,
+	0x18a3, 0x4003, 0x10a2, 0x8005, 0x1082, 0x1062, 0x0841, 0x0841, 0x0821, 0x4003, 0x0020, 0x400b,
+	0x0000, 0x8002, 0x4208, 0x4a49, 0xc001, 0x0841, 0x001c, 0xc001, 0x39c7, 0x0006, 0x8002, 0x4a49,
+	0x1062, 0x400a, 0x0000, 0x4003, 0x0020, 0x800a, 0x0821, 0x0841, 0x0861, 0x1062, 0x1082, 0x1082,
+	0x10a2, 0x10a2, 0x18a3, 0x18a3, 0x4005, 0x18c3, 0x8003, 0x18e3, 0x18e3, 0x20e4, 0x4005, 0x2104,
+	0x8004, 0x2965, 0x6b6d, 0x7bef, 0x7bef, 0x4015, 0x8410, 0x8004, 0x7bef, 0x738e, 0x39c7, 0x2124,
+	0x4005, 0x2104, 0x8004, 0x20e4, 0x20e4, 0x18e3, 0x18e3, 0x4004, 0x18c3, 0x8002, 0x18a3, 0x18a3,
+	0x4003, 0x10a2, 0x8005, 0x1082, 0x1062, 0x0861, 0x0841, 0x0821, 0x4003, 0x0020, 0x400a, 0x0000,
+	0x8002, 0x4208, 0x4a49, 0xc001, 0x0841, 0x001c, 0xc001, 0x39c7, 0x0006, 0x8002, 0x4a49, 0x1062,
+	0x400a, 0x0000, 0x800c, 0x0020, 0x0020, 0x0821, 0x0841, 0x0861, 0x1062, 0x1082, 0x1082, 0x10a2,
+	0x10a2, 0x18a3, 0x18a3, 0x4004, 0x18c3, 0x8004, 0x18e3, 0x18e3, 0x20e4, 0x20e4, 0x4004, 0x2104,
+	0x8004, 0x2124, 0x4208, 0x7bef, 0x7bef, 0x4018, 0x8410, 0x8005, 0x7bef, 0x7bef, 0x4a69, 0x2124,
+	0x2124, 0x4004, 0x2104, 0x4003, 0x20e4, 0x8002, 0x18e3, 0x18e3, 0x4003, 0x18c3, 0x4003, 0x18a3,
+	0x8009, 0x10a2, 0x10a2, 0x1082, 0x1062, 0x0861, 0x0841, 0x0821, 0x0020, 0x0020, 0x400a, 0x0000,
+	0x8002, 0x4208, 0x4a49, 0xc001, 0x0841, 0x001c, 0xc001, 0x39c7, 0x0006, 0x8002, 0x4a49, 0x1062,
+	0x4009, 0x0000, 0x8007, 0x0020, 0x0020, 0x0821, 0x0841, 0x0861, 0x1062, 0x1082, 0x4003, 0x10a2,
+	0x8002, 0x18a3, 0x18a3, 0x4004, 0x18c3, 0x8003, 0x18e3, 0x18e3, 0x20e4, 0x4004, 0x2104, 0x8005,
+	0x2124, 0x2124, 0x41e8, 0x7bcf, 0x7bef, 0x401a, 0x8410, 0x8003, 0x7bef, 0x7bef, 0x4a69, 0x4003,
+	0x2124, 0x4004, 0x2104, 0x8004, 0x20e4, 0x20e4, 0x18e3, 0x18e3, 0x4003, 0x18c3, 0x4003, 0x18a3,
+	0x8009, 0x10a2, 0x10a2, 0x1082, 0x1062, 0x0861, 0x0841, 0x0821, 0x0020, 0x0020, 0x4009, 0x0000,
+	0x8002, 0x4208, 0x4a49, 0xc001, 0x0841, 0x001c, 0xc001, 0x39c7, 0x0006, 0x8002, 0x4a49, 0x1062,
+	0x4008, 0x0000, 0x8007, 0x0020, 0x0020, 0x0821, 0x0841, 0x0841, 0x1062, 0x1082, 0x4003, 0x10a2,
+	0x8001, 0x18a3, 0x4004, 0x18c3, 0x8003, 0x18e3, 0x18e3, 0x20e4, 0x4004, 0x2104, 0x4003, 0x2124,
+	0x8003, 0x4228, 0x7bcf, 0x7bef, 0x4003, 0x8410, 0x8003, 0x7bef, 0x7bcf, 0x7bef, 0x4010, 0x8410,
+	0x8003, 0x7bef, 0x7bcf, 0x7bef, 0x4003, 0x8410, 0x8004, 0x7bef, 0x7bef, 0x528a, 0x2925, 0x4003,
+	0x2124, 0x4004, 0x2104, 0x8004, 0x20e4, 0x20e4, 0x18e3, 0x18e3, 0x4003, 0x18c3, 0x800b, 0x18a3,
+	0x18a3, 0x10a2, 0x10a2, 0x1082, 0x1062, 0x0841, 0x0841, 0x0821, 0x0020, 0x0020, 0x4008, 0x0000,
+	0x8002, 0x4208, 0x4a49, 0xc001, 0x0841, 0x001c, 0xc001, 0x39c7, 0x0006, 0x8002, 0x4a49, 0x1062,
+	0x4007, 0x0000, 0x800b, 0x0020, 0x0020, 0x0821, 0x0841, 0x0841, 0x1062, 0x1082, 0x1082, 0x10a2,
+	0x10a2, 0x18a3, 0x4004, 0x18c3, 0x8003, 0x18e3, 0x18e3, 0x20e4, 0x4004, 0x2104, 0x4003, 0x2124,
+	0x8003, 0x31a6, 0x7bcf, 0x7bef, 0x4003, 0x8410, 0x8005, 0x7bef, 0x9492, 0xb5b6, 0x9cd3, 0x7bef,
+	0x400e, 0x8410, 0x8005, 0x7bef, 0x9492, 0xb5b6, 0x9cf3, 0x7bef, 0x4003, 0x8410, 0x8005, 0x7bef,
+	0x7bef, 0x4208, 0x2945, 0x2925, 0x4003, 0x2124, 0x4003, 0x2104, 0x8004, 0x20e4, 0x20e4, 0x18e3,
+	0x18e3, 0x4003, 0x18c3, 0x800b, 0x18a3, 0x18a3, 0x10a2, 0x10a2, 0x1082, 0x1062, 0x0841, 0x0841,
+	0x0821, 0x0020, 0x0020, 0x4007, 0x0000, 0x8002, 0x4208, 0x4a49, 0xc001, 0x0841, 0x001c, 0xc001,
+	0x39c7, 0x0006, 0x8002, 0x4a49, 0x1062, 0x4006, 0x0000, 0x800b, 0x0020, 0x0020, 0x0821, 0x0821,
+	0x0841, 0x1062, 0x1082, 0x1082, 0x10a2, 0x10a2, 0x18a3, 0x4004, 0x18c3, 0x8003, 0x18e3, 0x18e3,
+	0x20e4, 0x4003, 0x2104, 0x4003, 0x2124, 0x8004, 0x2925, 0x2945, 0x6b6d, 0x7bef, 0x4003, 0x8410,
+	0x8007, 0x7bef, 0x8c51, 0xef7d, 0xffff, 0xf7be, 0x94b2, 0x7bef, 0x400c, 0x8410, 0x8007, 0x7bef,
+	0x8c71, 0xef7d, 0xffff, 0xf7de, 0x94b2, 0x7bef, 0x4003, 0x8410, 0x8008, 0x7bef, 0x73ae, 0x2965,
+	0x2945, 0x2925, 0x2925, 0x2124, 0x2124, 0x4003, 0x2104, 0x8004, 0x20e4, 0x20e4, 0x18e3, 0x18e3,
+	0x4003, 0x18c3, 0x800b, 0x18a3, 0x18a3, 0x10a2, 0x10a2, 0x1082, 0x1062, 0x0841, 0x0841, 0x0821,
+	0x0020, 0x0020, 0x4006, 0x0000, 0x8002, 0x4208, 0x4a49, 0xc001, 0x0841, 0x001c, 0xc001, 0x39c7,
+	0x0006, 0x8002, 0x4a49, 0x1062, 0x4006, 0x0000, 0x800a, 0x0020, 0x0020, 0x0821, 0x0841, 0x0861,
+	0x1082, 0x1082, 0x10a2, 0x10a2, 0x18a3, 0x4004, 0x18c3, 0x8003, 0x18e3, 0x18e3, 0x20e4, 0x4003,
+	0x2104, 0x4003, 0x2124, 0x8004, 0x2945, 0x2945, 0x5acb, 0x7bef, 0x4004, 0x8410, 0x8002, 0x7bef,
+	0x94b2, 0x4003, 0xffff, 0x8002, 0xad55, 0x7bcf, 0x400c, 0x8410, 0x8002, 0x7bef, 0x94b2, 0x4003,
+	0xffff, 0x8002, 0xa534, 0x7bcf, 0x4004, 0x8410, 0x8002, 0x7bcf, 0x632c, 0x4003, 0x2945, 0x8003,
+	0x2925, 0x2124, 0x2124, 0x4004, 0x2104, 0x8003, 0x20e4, 0x18e3, 0x18e3, 0x4003, 0x18c3, 0x800a,
+	0x18a3, 0x18a3, 0x10a2, 0x10a2, 0x1082, 0x0861, 0x0841, 0x0821, 0x0020, 0x0020, 0x4006, 0x0000,
+	0x8002, 0x4208, 0x4a49, 0xc001, 0x0841, 0x001c, 0xc001, 0x39c7, 0x0006, 0x8002, 0x4a49, 0x1062,
+	0x4005, 0x0000, 0x800b, 0x0020, 0x0020, 0x0821, 0x0841, 0x0861, 0x1082, 0x1082, 0x10a2, 0x10a2,
+	0x18a3, 0x18a3, 0x4003, 0x18c3, 0x8003, 0x18e3, 0x18e3, 0x20e4, 0x4003, 0x2104, 0x8008, 0x2124,
+	0x2124, 0x2925, 0x2945, 0x2945, 0x3166, 0x7bef, 0x7bef, 0x4006, 0x8410, 0x8003, 0xc638, 0xffdf,
+	0xd69a, 0x4010, 0x8410, 0x8005, 0xc638, 0xffdf, 0xd6ba, 0x8430, 0x7bef, 0x4004, 0x8410, 0x8003,
+	0x7bef, 0x7bef, 0x39e7, 0x4004, 0x2945, 0x4003, 0x2124, 0x4003, 0x2104, 0x8003, 0x20e4, 0x18e3,
+	0x18e3, 0x4003, 0x18c3, 0x8001, 0x18a3, 0x4003, 0x10a2, 0x8006, 0x1082, 0x0861, 0x0841, 0x0821,
+	0x0020, 0x0020, 0x4005, 0x0000, 0x8002, 0x4208, 0x4a49, 0xc001, 0x0841, 0x001c, 0xc001, 0x39c7,
+	0x0006, 0x8002, 0x4a49, 0x1062, 0x4004, 0x0000, 0x800b, 0x0020, 0x0020, 0x0821, 0x0841, 0x0841,
+	0x1062, 0x1082, 0x10a2, 0x10a2, 0x18a3, 0x18a3, 0x4003, 0x18c3, 0x8003, 0x18e3, 0x18e3, 0x20e4,
+	0x4003, 0x2104, 0x8003, 0x2124, 0x2124, 0x2925, 0x4003, 0x2945, 0x8002, 0x5acb, 0x7bef, 0x4007,
+	0x8410, 0x8004, 0x7bef, 0x8c71, 0x8410, 0x7bef, 0x400f, 0x8410, 0x8004, 0x7bef, 0x8c71, 0x8410,
+	0x7bef, 0x4006, 0x8410, 0x8004, 0x7bef, 0x632c, 0x2965, 0x2965, 0x4003, 0x2945, 0x8003, 0x2925,
+	0x2124, 0x2124, 0x4003, 0x2104, 0x8003, 0x20e4, 0x18e3, 0x18e3, 0x4003, 0x18c3, 0x800a, 0x18a3,
+	0x10a2, 0x10a2, 0x1082, 0x1062, 0x0841, 0x0841, 0x0821, 0x0020, 0x0020, 0x4004, 0x0000, 0x8002,
+	0x4208, 0x4a49, 0xc001, 0x0841, 0x001c, 0xc001, 0x39c7, 0x0006, 0x8002, 0x4a49, 0x1062, 0x4004,
+	0x0000, 0x800a, 0x0020, 0x0020, 0x0821, 0x0841, 0x0861, 0x1082, 0x1082, 0x10a2, 0x10a2, 0x18a3,
+	0x4003, 0x18c3, 0x8003, 0x18e3, 0x18e3, 0x20e4, 0x4003, 0x2104, 0x8002, 0x2124, 0x2124, 0x4003,
+	0x2945, 0x8004, 0x2965, 0x2965, 0x73ae, 0x7bef, 0x4008, 0x8410, 0x8001, 0x7bef, 0x4012, 0x8410,
+	0x8001, 0x7bef, 0x4008, 0x8410, 0x8003, 0x7bef, 0x7bef, 0x31a6, 0x4003, 0x2965, 0x8005, 0x2945,
+	0x2945, 0x2925, 0x2124, 0x2124, 0x4003, 0x2104, 0x8003, 0x20e4, 0x18e3, 0x18e3, 0x4003, 0x18c3,
+	0x8009, 0x18a3, 0x10a2, 0x10a2, 0x1082, 0x0861, 0x0841, 0x0841, 0x0020, 0x0020, 0x4004, 0x0000,
+	0x8002, 0x4208, 0x4a49, 0xc001, 0x0841, 0x001c, 0xc001, 0x39c7, 0x0006, 0x8002, 0x4a49, 0x1062,
+	0x4003, 0x0000, 0x800a, 0x0020, 0x0020, 0x0821, 0x0841, 0x0861, 0x1082, 0x1082, 0x10a2, 0x10a2,
+	0x18a3, 0x4003, 0x18c3, 0x8003, 0x18e3, 0x18e3, 0x20e4, 0x4003, 0x2104, 0x8002, 0x2124, 0x2124,
+	0x4003, 0x2945, 0x8004, 0x2965, 0x2965, 0x4228, 0x7bef, 0x4026, 0x8410, 0x8003, 0x7bef, 0x52aa,
+	0x3186, 0x4003, 0x2965, 0x8005, 0x2945, 0x2945, 0x2925, 0x2124, 0x2124, 0x4003, 0x2104, 0x8002,
+	0x20e4, 0x18e3, 0x4004, 0x18c3, 0x8009, 0x18a3, 0x10a2, 0x10a2, 0x1082, 0x0861, 0x0841, 0x0821,
+	0x0020, 0x0020, 0x4003, 0x0000, 0x8002, 0x4208, 0x4a49, 0xc001, 0x0841, 0x001c, 0xc001, 0x39c7,
+	0x0006, 0x8002, 0x4a49, 0x1062, 0x4003, 0x0000, 0x8009, 0x0020, 0x0821, 0x0841, 0x0841, 0x1062,
+	0x1082, 0x10a2, 0x10a2, 0x18a3, 0x4004, 0x18c3, 0x8002, 0x18e3, 0x20e4, 0x4003, 0x2104, 0x8002,
+	0x2124, 0x2124, 0x4003, 0x2945, 0x8005, 0x2965, 0x2965, 0x3166, 0x630c, 0x7bef, 0x4026, 0x8410,
+	0x8004, 0x7bef, 0x6b4d, 0x3186, 0x3186, 0x4003, 0x2965, 0x800a, 0x2945, 0x2945, 0x2925, 0x2124,
+	0x2124, 0x2104, 0x2104, 0x20e4, 0x20e4, 0x18e3, 0x4003, 0x18c3, 0x8009, 0x18a3, 0x18a3, 0x10a2,
+	0x1082, 0x1062, 0x0841, 0x0841, 0x0821, 0x0020, 0x4003, 0x0000, 0x8002, 0x4208, 0x4a49, 0xc001,
+	0x0841, 0x001c, 0xc001, 0x39c7, 0x0006, 0x800e, 0x4a49, 0x1062, 0x0000, 0x0000, 0x0020, 0x0020,
+	0x0821, 0x0841, 0x0861, 0x1082, 0x1082, 0x10a2, 0x18a3, 0x18a3, 0x4003, 0x18c3, 0x8002, 0x18e3,
+	0x20e4, 0x4003, 0x2104, 0x8002, 0x2124, 0x2124, 0x4003, 0x2945, 0x8006, 0x2965, 0x2965, 0x3186,
+	0x3186, 0x738e, 0x7bef, 0x4026, 0x8410, 0x800c, 0x7bef, 0x7bcf, 0x31a6, 0x3186, 0x3186, 0x3166,
+	0x2965, 0x2965, 0x2945, 0x2945, 0x2925, 0x2124, 0x4003, 0x2104, 0x8003, 0x20e4, 0x20e4, 0x18e3,
+	0x4003, 0x18c3, 0x800d, 0x18a3, 0x18a3, 0x10a2, 0x1082, 0x0861, 0x0841, 0x0821, 0x0020, 0x0020,
+	0x0000, 0x0000, 0x4208, 0x4a49, 0xc001, 0x0841, 0x001c, 0xc001, 0x39c7, 0x0006, 0x800d, 0x4a49,
+	0x1062, 0x0000, 0x0000, 0x0020, 0x0821, 0x0841, 0x0841, 0x1062, 0x1082, 0x10a2, 0x10a2, 0x18a3,
+	0x4003, 0x18c3, 0x8002, 0x18e3, 0x18e3, 0x4003, 0x2104, 0x800c, 0x2124, 0x2124, 0x2925, 0x2945,
+	0x2945, 0x2965, 0x2965, 0x3186, 0x3186, 0x31a6, 0x7bcf, 0x7bef, 0x4026, 0x8410, 0x800d, 0x7bef,
+	0x7bcf, 0x31a6, 0x31a6, 0x3186, 0x3186, 0x3166, 0x2965, 0x2965, 0x2945, 0x2945, 0x2925, 0x2124,
+	0x4003, 0x2104, 0x8002, 0x20e4, 0x18e3, 0x4004, 0x18c3, 0x800c, 0x18a3, 0x18a3, 0x10a2, 0x1082,
+	0x0841, 0x0841, 0x0821, 0x0020, 0x0000, 0x0000, 0x4208, 0x4a49, 0xc001, 0x0841, 0x001c, 0xc001,
+	0x39c7, 0x0006, 0x800d, 0x4a49, 0x1062, 0x0000, 0x0020, 0x0020, 0x0821, 0x0841, 0x0861, 0x1082,
+	0x10a2, 0x10a2, 0x18a3, 0x18a3, 0x4003, 0x18c3, 0x8010, 0x18e3, 0x20e4, 0x2104, 0x2104, 0x2124,
+	0x2124, 0x2925, 0x2945, 0x2945, 0x2965, 0x2965, 0x3186, 0x3186, 0x31a6, 0x31a6, 0x73ae, 0x4029,
+	0x7bef, 0x800c, 0x39e7, 0x31a6, 0x31a6, 0x3186, 0x3186, 0x3166, 0x2965, 0x2965, 0x2945, 0x2945,
+	0x2925, 0x2124, 0x4003, 0x2104, 0x8002, 0x20e4, 0x18e3, 0x4003, 0x18c3, 0x800c, 0x18a3, 0x18a3,
+	0x10a2, 0x1082, 0x0861, 0x0841, 0x0821, 0x0020, 0x0020, 0x0000, 0x4208, 0x4a49, 0xc001, 0x0841,
+	0x001c, 0xc001, 0x39c7, 0x0006, 0x800c, 0x4a49, 0x1062, 0x0000, 0x0020, 0x0821, 0x0841, 0x0841,
+	0x1062, 0x1082, 0x10a2, 0x10a2, 0x18a3, 0x4003, 0x18c3, 0x8002, 0x18e3, 0x20e4, 0x4003, 0x2104,
+	0x8008, 0x2124, 0x2124, 0x2945, 0x2945, 0x2965, 0x2965, 0x3166, 0x3186, 0x4003, 0x31a6, 0x8001,
+	0x62ec, 0x4006, 0x6b4d, 0x4009, 0x6b6d, 0x400b, 0x738e, 0x400a, 0x6b6d, 0x4004, 0x6b4d, 0x8013,
+	0x632c, 0x39e7, 0x39c7, 0x31a6, 0x31a6, 0x3186, 0x3186, 0x3166, 0x2965, 0x2945, 0x2945, 0x2925,
+	0x2124, 0x2124, 0x2104, 0x2104, 0x20e4, 0x20e4, 0x18e3, 0x4003, 0x18c3, 0x800b, 0x18a3, 0x18a3,
+	0x10a2, 0x1082, 0x0841, 0x0841, 0x0821, 0x0020, 0x0000, 0x4208, 0x4a49, 0xc001, 0x0841, 0x001c,
+	0xc001, 0x39c7, 0x0006, 0x800b, 0x4a49, 0x1082, 0x0020, 0x0020, 0x0821, 0x0841, 0x0861, 0x1082,
+	0x10a2, 0x10a2, 0x18a3, 0x4003, 0x18c3, 0x8015, 0x18e3, 0x18e3, 0x20e4, 0x2104, 0x2104, 0x2124,
+	0x2124, 0x2945, 0x39c7, 0x630c, 0x6b6d, 0x6b4d, 0x5acb, 0x39c7, 0x31a6, 0x31a6, 0x39c7, 0x39c7,
+	0x39e7, 0x39e7, 0x41e8, 0x4003, 0x4208, 0x8002, 0x4228, 0x4228, 0x4004, 0x4a49, 0x4008, 0x4a69,
+	0x4004, 0x528a, 0x4005, 0x4a69, 0x4004, 0x4a49, 0x8003, 0x4a29, 0x4228, 0x4228, 0x4003, 0x4208,
+	0x4003, 0x39e7, 0x4003, 0x39c7, 0x801c, 0x52aa, 0x6b6d, 0x6b6d, 0x632c, 0x4208, 0x2945, 0x2945,
+	0x2925, 0x2124, 0x2124, 0x2104, 0x2104, 0x20e4, 0x18e3, 0x18e3, 0x18c3, 0x18c3, 0x18a3, 0x18a3,
+	0x10a2, 0x1082, 0x0861, 0x0841, 0x0821, 0x0020, 0x0020, 0x4208, 0x4a49, 0xc001, 0x0841, 0x001c,
+	0xc001, 0x39c7, 0x0006, 0x800b, 0x4a49, 0x1082, 0x0020, 0x0020, 0x0821, 0x0841, 0x1062, 0x1082,
+	0x10a2, 0x18a3, 0x18a3, 0x4003, 0x18c3, 0x8008, 0x18e3, 0x20e4, 0x2104, 0x2104, 0x2124, 0x2124,
+	0x2925, 0x4a69, 0x4006, 0x7bef, 0x8004, 0x4a69, 0x39c7, 0x39c7, 0x6b6d, 0x400e, 0x7bcf, 0x400e,
+	0x7bef, 0x400c, 0x7bcf, 0x8004, 0x73ae, 0x4208, 0x39e7, 0x4228, 0x4003, 0x7bef, 0x800d, 0x8410,
+	0x7bef, 0x7bef, 0x5acb, 0x2945, 0x2945, 0x2925, 0x2124, 0x2104, 0x2104, 0x20e4, 0x20e4, 0x18e3,
+	0x4003, 0x18c3, 0x800a, 0x18a3, 0x18a3, 0x10a2, 0x1062, 0x0841, 0x0841, 0x0020, 0x0020, 0x4208,
+	0x4a49, 0xc001, 0x0841, 0x001c, 0xc001, 0x39c7, 0x0006, 0x800f, 0x4a49, 0x1082, 0x0020, 0x0821,
+	0x0841, 0x0861, 0x1082, 0x1082, 0x10a2, 0x18a3, 0x18a3, 0x18c3, 0x18c3, 0x18e3, 0x20e4, 0x4003,
+	0x2104, 0x8005, 0x2124, 0x2124, 0x39e7, 0x7bef, 0x7bef, 0x4004, 0x8410, 0x8006, 0x7bcf, 0x7bef,
+	0x39e7, 0x39e7, 0x73ae, 0x7bef, 0x4026, 0x8410, 0x8006, 0x7bef, 0x7bef, 0x4228, 0x39e7, 0x7bcf,
+	0x7bcf, 0x4004, 0x8410, 0x8018, 0x7bef, 0x7bef, 0x528a, 0x2945, 0x2945, 0x2124, 0x2124, 0x2104,
+	0x2104, 0x20e4, 0x18e3, 0x18e3, 0x18c3, 0x18c3, 0x18a3, 0x18a3, 0x10a2, 0x1082, 0x0861, 0x0841,
+	0x0821, 0x0020, 0x4208, 0x4a49, 0xc001, 0x0841, 0x001c, 0xc001, 0x39c7, 0x0006, 0x800a, 0x4a49,
+	0x1082, 0x0020, 0x0821, 0x0841, 0x1062, 0x1082, 0x10a2, 0x18a3, 0x18a3, 0x4003, 0x18c3, 0x8009,
+	0x18e3, 0x20e4, 0x2104, 0x2104, 0x2124, 0x2124, 0x2945, 0x630c, 0x7bcf, 0x4006, 0x8410, 0x8004,
+	0x7bef, 0x5aeb, 0x39e7, 0x73ae, 0x4028, 0x8410, 0x8004, 0x7bef, 0x4208, 0x528a, 0x7bef, 0x4006,
+	0x8410, 0x800b, 0x7bef, 0x6b6d, 0x2945, 0x2945, 0x2925, 0x2124, 0x2104, 0x2104, 0x20e4, 0x20e4,
+	0x18e3, 0x4003, 0x18c3, 0x8009, 0x18a3, 0x10a2, 0x1082, 0x1062, 0x0841, 0x0821, 0x0020, 0x4208,
+	0x4a49, 0xc001, 0x0841, 0x001c, 0xc001, 0x39c7, 0x0006, 0x800a, 0x4a49, 0x1082, 0x0821, 0x0841,
+	0x0861, 0x1082, 0x1082, 0x10a2, 0x18a3, 0x18a3, 0x4003, 0x18c3, 0x8001, 0x20e4, 0x4003, 0x2104,
+	0x8005, 0x2124, 0x2124, 0x2945, 0x7bcf, 0x7bef, 0x4006, 0x8410, 0x8004, 0x7bef, 0x738e, 0x41e8,
+	0x73ae, 0x4028, 0x8410, 0x8004, 0x7bef, 0x4208, 0x632c, 0x7bef, 0x4006, 0x8410, 0x8017, 0x7bef,
+	0x7bcf, 0x2965, 0x2945, 0x2945, 0x2124, 0x2124, 0x2104, 0x2104, 0x20e4, 0x18e3, 0x18e3, 0x18c3,
+	0x18c3, 0x18a3, 0x18a3, 0x10a2, 0x1082, 0x0861, 0x0841, 0x0821, 0x4208, 0x4a49, 0xc001, 0x0841,
+	0x001c, 0xc001, 0x39c7, 0x0006, 0x8009, 0x4a49, 0x1082, 0x0821, 0x0841, 0x0861, 0x1082, 0x10a2,
+	0x10a2, 0x18a3, 0x4003, 0x18c3, 0x800a, 0x18e3, 0x20e4, 0x2104, 0x2104, 0x2124, 0x2124, 0x2945,
+	0x2945, 0x8410, 0x7bef, 0x4006, 0x8410, 0x8004, 0x7bef, 0x738e, 0x4208, 0x73ae, 0x4028, 0x8410,
+	0x8004, 0x7bef, 0x4228, 0x6b2d, 0x7bef, 0x4006, 0x8410, 0x8017, 0x7bef, 0x7bef, 0x2965, 0x2945,
+	0x2945, 0x2925, 0x2124, 0x2104, 0x2104, 0x20e4, 0x20e4, 0x18e3, 0x18c3, 0x18c3, 0x18a3, 0x18a3,
+	0x10a2, 0x1082, 0x0861, 0x0841, 0x0821, 0x4208, 0x4a49, 0xc001, 0x0841, 0x001c, 0xc001, 0x39c7,
+	0x0006, 0x8009, 0x4a49, 0x1082, 0x0821, 0x0841, 0x1062, 0x1082, 0x10a2, 0x18a3, 0x18a3, 0x4003,
+	0x18c3, 0x800a, 0x20e4, 0x20e4, 0x2104, 0x2104, 0x2124, 0x2124, 0x2945, 0x2945, 0x8410, 0x7bef,
+	0x4006, 0x8410, 0x8004, 0x7bef, 0x73ae, 0x4208, 0x73ae, 0x4028, 0x8410, 0x8004, 0x7bef, 0x4228,
+	0x6b4d, 0x7bef, 0x4006, 0x8410, 0x800c, 0x7bef, 0x7bef, 0x2965, 0x2965, 0x2945, 0x2945, 0x2124,
+	0x2124, 0x2104, 0x2104, 0x20e4, 0x18e3, 0x4003, 0x18c3, 0x8008, 0x18a3, 0x18a3, 0x10a2, 0x1062,
+	0x0841, 0x0821, 0x4208, 0x4a49, 0xc001, 0x0841, 0x001c, 0xc001, 0x39c7, 0x0006, 0x800d, 0x4a49,
+	0x1082, 0x0841, 0x0841, 0x1082, 0x1082, 0x10a2, 0x18a3, 0x18a3, 0x18c3, 0x18c3, 0x18e3, 0x20e4,
+	0x4003, 0x2104, 0x8006, 0x2124, 0x2925, 0x2945, 0x2965, 0x8410, 0x7bef, 0x4006, 0x8410, 0x8004,
+	0x7bef, 0x73ae, 0x4208, 0x7bcf, 0x4028, 0x8410, 0x8004, 0x7bef, 0x4a29, 0x6b4d, 0x7bef, 0x4006,
+	0x8410, 0x8017, 0x7bef, 0x7bef, 0x3166, 0x2965, 0x2945, 0x2945, 0x2925, 0x2124, 0x2104, 0x2104,
+	0x20e4, 0x18e3, 0x18e3, 0x18c3, 0x18c3, 0x18a3, 0x18a3, 0x10a2, 0x1082, 0x0841, 0x0841, 0x4208,
+	0x4a49, 0xc001, 0x0841, 0x001c, 0xc001, 0x39c7, 0x0006, 0x8008, 0x4a49, 0x1082, 0x0841, 0x0861,
+	0x1082, 0x10a2, 0x10a2, 0x18a3, 0x4003, 0x18c3, 0x800b, 0x18e3, 0x20e4, 0x2104, 0x2104, 0x2124,
+	0x2124, 0x2945, 0x2945, 0x2965, 0x8410, 0x7bef, 0x4006, 0x8410, 0x8004, 0x7bef, 0x73ae, 0x4228,
+	0x7bcf, 0x4028, 0x8410, 0x8004, 0x7bef, 0x4a49, 0x6b4d, 0x7bef, 0x4006, 0x8410, 0x8008, 0x7bef,
+	0x7bef, 0x3186, 0x2965, 0x2965, 0x2945, 0x2945, 0x2124, 0x4003, 0x2104, 0x800c, 0x20e4, 0x18e3,
+	0x18c3, 0x18c3, 0x18a3, 0x18a3, 0x10a2, 0x1082, 0x0861, 0x0841, 0x4208, 0x4a49, 0xc001, 0x0841,
+	0x001c, 0xc001, 0x39c7, 0x0006, 0x8008, 0x4a49, 0x1082, 0x0841, 0x1062, 0x1082, 0x10a2, 0x18a3,
+	0x18a3, 0x4003, 0x18c3, 0x800b, 0x20e4, 0x20e4, 0x2104, 0x2104, 0x2124, 0x2124, 0x2945, 0x2945,
+	0x2965, 0x8410, 0x7bef, 0x4006, 0x8410, 0x8004, 0x7bef, 0x73ae, 0x4228, 0x7bcf, 0x4028, 0x8410,
+	0x8004, 0x7bef, 0x4a49, 0x6b4d, 0x7bef, 0x4006, 0x8410, 0x800d, 0x7bef, 0x8410, 0x3186, 0x3166,
+	0x2965, 0x2945, 0x2945, 0x2124, 0x2124, 0x2104, 0x2104, 0x20e4, 0x18e3, 0x4003, 0x18c3, 0x8007,
+	0x18a3, 0x10a2, 0x10a2, 0x1062, 0x0841, 0x4208, 0x4a49, 0xc001, 0x0841, 0x001c, 0xc001, 0x39c7,
+	0x0006, 0x800c, 0x4a49, 0x1082, 0x0841, 0x1062, 0x1082, 0x10a2, 0x18a3, 0x18a3, 0x18c3, 0x18c3,
+	0x18e3, 0x20e4, 0x4003, 0x2104, 0x8007, 0x2124, 0x2925, 0x2945, 0x2965, 0x2965, 0x8410, 0x7bef,
+	0x4006, 0x8410, 0x8004, 0x7bef, 0x73ae, 0x4a29, 0x7bcf, 0x4028, 0x8410, 0x8004, 0x7bef, 0x4a49,
+	0x6b6d, 0x7bef, 0x4006, 0x8410, 0x8017, 0x7bef, 0x8410, 0x3186, 0x3166, 0x2965, 0x2945, 0x2945,
+	0x2925, 0x2124, 0x2104, 0x2104, 0x20e4, 0x18e3, 0x18e3, 0x18c3, 0x18c3, 0x18a3, 0x18a3, 0x10a2,
+	0x1062, 0x0841, 0x4208, 0x4a49, 0xc001, 0x0841, 0x001c, 0xc001, 0x39c7, 0x0006, 0x8016, 0x4a49,
+	0x10a2, 0x0841, 0x1082, 0x1082, 0x10a2, 0x18a3, 0x18a3, 0x18c3, 0x18c3, 0x18e3, 0x20e4, 0x2104,
+	0x2104, 0x2124, 0x2925, 0x2945, 0x2945, 0x2965, 0x3166, 0x8410, 0x7bef, 0x4006, 0x8410, 0x8004,
+	0x7bef, 0x73ae, 0x4a49, 0x7bcf, 0x4028, 0x8410, 0x8004, 0x7bef, 0x4a69, 0x6b6d, 0x7bef, 0x4006,
+	0x8410, 0x8009, 0x7bef, 0x8410, 0x3186, 0x3186, 0x2965, 0x2965, 0x2945, 0x2945, 0x2124, 0x4003,
+	0x2104, 0x800b, 0x18e3, 0x18e3, 0x18c3, 0x18c3, 0x18a3, 0x18a3, 0x10a2, 0x1082, 0x0841, 0x4208,
+	0x4a49, 0xc001, 0x0841, 0x001c, 0xc001, 0x39c7, 0x0006, 0x8007, 0x4a49, 0x10a2, 0x0861, 0x1082,
+	0x1082, 0x10a2, 0x18a3, 0x4003, 0x18c3, 0x800c, 0x18e3, 0x20e4, 0x2104, 0x2104, 0x2124, 0x2925,
+	0x2945, 0x2945, 0x2965, 0x3166, 0x8410, 0x7bef, 0x4006, 0x8410, 0x8004, 0x7bef, 0x73ae, 0x4a49,
+	0x7bcf, 0x4028, 0x8410, 0x8004, 0x7bef, 0x4a69, 0x6b6d, 0x7bef, 0x4006, 0x8410, 0x8009, 0x7bef,
+	0x8410, 0x3186, 0x3186, 0x3166, 0x2965, 0x2945, 0x2945, 0x2124, 0x4003, 0x2104, 0x800b, 0x20e4,
+	0x18e3, 0x18c3, 0x18c3, 0x18a3, 0x18a3, 0x10a2, 0x1082, 0x0861, 0x4208, 0x4a49, 0xc001, 0x0841,
+	0x001c, 0xc001, 0x39c7, 0x0006, 0x8016, 0x4a49, 0x10a2, 0x0861, 0x1082, 0x10a2, 0x10a2, 0x18a3,
+	0x18c3, 0x18c3, 0x18e3, 0x20e4, 0x20e4, 0x2104, 0x2104, 0x2124, 0x2925, 0x2945, 0x2945, 0x2965,
+	0x3186, 0x8410, 0x7bef, 0x4006, 0x8410, 0x8004, 0x7bef, 0x73ae, 0x4a49, 0x7bcf, 0x4028, 0x8410,
+	0x8004, 0x7bef, 0x4a69, 0x6b6d, 0x7bef, 0x4006, 0x8410, 0x800e, 0x7bef, 0x8410, 0x31a6, 0x3186,
+	0x3186, 0x2965, 0x2945, 0x2945, 0x2925, 0x2124, 0x2104, 0x2104, 0x20e4, 0x18e3, 0x4003, 0x18c3,
+	0x8006, 0x18a3, 0x10a2, 0x1082, 0x0861, 0x4208, 0x4a49, 0xc001, 0x0841, 0x001c, 0xc001, 0x39c7,
+	0x0006, 0x8016, 0x4a49, 0x10a2, 0x0861, 0x1082, 0x10a2, 0x18a3, 0x18a3, 0x18c3, 0x18c3, 0x18e3,
+	0x20e4, 0x2104, 0x2104, 0x2124, 0x2124, 0x2925, 0x2945, 0x2965, 0x2965, 0x3186, 0x8410, 0x7bef,
+	0x4006, 0x8410, 0x8004, 0x7bef, 0x7bcf, 0x4a49, 0x7bcf, 0x4028, 0x8410, 0x8004, 0x7bef, 0x528a,
+	0x6b6d, 0x7bef, 0x4006, 0x8410, 0x800e, 0x7bef, 0x8410, 0x31a6, 0x3186, 0x3186, 0x2965, 0x2945,
+	0x2945, 0x2925, 0x2124, 0x2104, 0x2104, 0x20e4, 0x18e3, 0x4003, 0x18c3, 0x8006, 0x18a3, 0x10a2,
+	0x10a2, 0x1062, 0x4208, 0x4a49, 0xc001, 0x0841, 0x001c, 0xc001, 0x39c7, 0x0006, 0x8016, 0x4a49,
+	0x10a2, 0x1062, 0x1082, 0x10a2, 0x18a3, 0x18a3, 0x18c3, 0x18c3, 0x18e3, 0x20e4, 0x2104, 0x2104,
+	0x2124, 0x2124, 0x2945, 0x2945, 0x2965, 0x3166, 0x3186, 0x8410, 0x7bef, 0x4006, 0x8410, 0x8004,
+	0x7bef, 0x7bcf, 0x4a69, 0x7bcf, 0x4028, 0x8410, 0x8004, 0x7bef, 0x528a, 0x6b6d, 0x7bef, 0x4006,
+	0x8410, 0x800e, 0x7bef, 0x8410, 0x31a6, 0x3186, 0x3186, 0x2965, 0x2965, 0x2945, 0x2925, 0x2124,
+	0x2124, 0x2104, 0x20e4, 0x20e4, 0x4003, 0x18c3, 0x8006, 0x18a3, 0x18a3, 0x10a2, 0x1062, 0x4208,
+	0x4a49, 0xc001, 0x0841, 0x001c, 0xc001, 0x39c7, 0x0006, 0x8016, 0x4a49, 0x10a2, 0x1062, 0x1082,
+	0x10a2, 0x18a3, 0x18a3, 0x18c3, 0x18c3, 0x18e3, 0x20e4, 0x2104, 0x2104, 0x2124, 0x2925, 0x2945,
+	0x2945, 0x2965, 0x3186, 0x3186, 0x8410, 0x7bef, 0x4006, 0x8410, 0x8004, 0x7bef, 0x7bcf, 0x4a69,
+	0x7bcf, 0x4028, 0x8410, 0x8004, 0x7bef, 0x528a, 0x738e, 0x7bef, 0x4006, 0x8410, 0x8017, 0x7bef,
+	0x8410, 0x31a6, 0x31a6, 0x3186, 0x3166, 0x2965, 0x2945, 0x2945, 0x2124, 0x2124, 0x2104, 0x20e4,
+	0x20e4, 0x18e3, 0x18c3, 0x18c3, 0x18a3, 0x18a3, 0x10a2, 0x1062, 0x4208, 0x4a49, 0xc001, 0x0841,
+	0x001c, 0xc001, 0x39c7, 0x0006, 0x8016, 0x4a49, 0x10a2, 0x1062, 0x10a2, 0x10a2, 0x18a3, 0x18a3,
+	0x18c3, 0x18c3, 0x18e3, 0x20e4, 0x2104, 0x2104, 0x2124, 0x2925, 0x2945, 0x2945, 0x2965, 0x3186,
+	0x3186, 0x8410, 0x7bef, 0x4006, 0x8410, 0x8004, 0x7bef, 0x7bcf, 0x4a69, 0x7bcf, 0x4028, 0x8410,
+	0x8004, 0x7bef, 0x528a, 0x738e, 0x7bef, 0x4006, 0x8410, 0x800f, 0x7bef, 0x8410, 0x31a6, 0x31a6,
+	0x3186, 0x3166, 0x2965, 0x2945, 0x2945, 0x2124, 0x2124, 0x2104, 0x2104, 0x20e4, 0x18e3, 0x4003,
+	0x18c3, 0x8005, 0x18a3, 0x10a2, 0x1062, 0x4208, 0x4a49, 0xc001, 0x0841, 0x001c, 0xc001, 0x39c7,
+	0x0006, 0x8016, 0x4a49, 0x10a2, 0x1062, 0x10a2, 0x10a2, 0x18a3, 0x18a3, 0x18c3, 0x18c3, 0x18e3,
+	0x20e4, 0x2104, 0x2104, 0x2124, 0x2925, 0x2945, 0x2945, 0x2965, 0x3186, 0x3186, 0x8410, 0x7bef,
+	0x4006, 0x8410, 0x8004, 0x7bef, 0x7bcf, 0x4a69, 0x7bcf, 0x4028, 0x8410, 0x8004, 0x7bef, 0x528a,
+	0x738e, 0x7bef, 0x4006, 0x8410, 0x800f, 0x7bef, 0x8410, 0x31a6, 0x31a6, 0x3186, 0x3166, 0x2965,
+	0x2945, 0x2945, 0x2124, 0x2124, 0x2104, 0x2104, 0x20e4, 0x18e3, 0x4003, 0x18c3, 0x8005, 0x18a3,
+	0x10a2, 0x1082, 0x4208, 0x4a49, 0xc001, 0x0841, 0x001c, 0xc001, 0x39c7, 0x0006, 0x8016, 0x4a49,
+	0x18a3, 0x1082, 0x10a2, 0x10a2, 0x18a3, 0x18c3, 0x18c3, 0x18e3, 0x18e3, 0x20e4, 0x2104, 0x2104,
+	0x2124, 0x2925, 0x2945, 0x2945, 0x2965, 0x3186, 0x3186, 0x8410, 0x7bef, 0x4006, 0x8410, 0x8004,
+	0x7bef, 0x7bcf, 0x4a69, 0x7bcf, 0x4028, 0x8410, 0x8004, 0x7bef, 0x528a, 0x738e, 0x7bef, 0x4006,
+	0x8410, 0x800f, 0x7bef, 0x8410, 0x39a7, 0x31a6, 0x3186, 0x3166, 0x2965, 0x2945, 0x2945, 0x2124,
+	0x2124, 0x2104, 0x2104, 0x20e4, 0x18e3, 0x4003, 0x18c3, 0x8005, 0x18a3, 0x10a2, 0x1082, 0x4228,
+	0x4a49, 0xc001, 0x0841, 0x001c, 0xc001, 0x39c7, 0x0006, 0x8016, 0x4a49, 0x18a3, 0x1082, 0x10a2,
+	0x10a2, 0x18a3, 0x18c3, 0x18c3, 0x18e3, 0x18e3, 0x20e4, 0x2104, 0x2104, 0x2124, 0x2925, 0x2945,
+	0x2945, 0x2965, 0x3186, 0x3186, 0x8410, 0x7bef, 0x4006, 0x8410, 0x8004, 0x7bef, 0x7bcf, 0x4a69,
+	0x7bcf, 0x4028, 0x8410, 0x8004, 0x7bef, 0x528a, 0x738e, 0x7bef, 0x4006, 0x8410, 0x800f, 0x7bef,
+	0x8410, 0x39a7, 0x31a6, 0x3186, 0x3166, 0x2965, 0x2945, 0x2945, 0x2124, 0x2124, 0x2104, 0x2104,
+	0x20e4, 0x18e3, 0x4003, 0x18c3, 0x8005, 0x18a3, 0x10a2, 0x1082, 0x4228, 0x4a49, 0xc001, 0x0841,
+	0x001c, 0xc001, 0x39c7, 0x0006, 0x8016, 0x4a49, 0x18a3, 0x1082, 0x10a2, 0x10a2, 0x18a3, 0x18c3,
+	0x18c3, 0x18e3, 0x18e3, 0x20e4, 0x2104, 0x2104, 0x2124, 0x2925, 0x2945, 0x2945, 0x2965, 0x3186,
+	0x3186, 0x8410, 0x7bef, 0x4006, 0x8410, 0x8004, 0x7bef, 0x7bcf, 0x4a69, 0x7bcf, 0x4028, 0x8410,
+	0x8004, 0x7bef, 0x528a, 0x738e, 0x7bef, 0x4006, 0x8410, 0x800f, 0x7bef, 0x8410, 0x39a7, 0x31a6,
+	0x3186, 0x3166, 0x2965, 0x2945, 0x2945, 0x2124, 0x2124, 0x2104, 0x2104, 0x20e4, 0x18e3, 0x4003,
+	0x18c3, 0x8005, 0x18a3, 0x10a2, 0x1082, 0x4228, 0x4a49, 0xc001, 0x0841, 0x001c, 0xc001, 0x39c7,
+	0x0006, 0x8016, 0x4a49, 0x18a3, 0x1082, 0x10a2, 0x10a2, 0x18a3, 0x18c3, 0x18c3, 0x18e3, 0x18e3,
+	0x20e4, 0x2104, 0x2104, 0x2124, 0x2925, 0x2945, 0x2945, 0x2965, 0x3186, 0x3186, 0x8410, 0x7bef,
+	0x4006, 0x8410, 0x8004, 0x7bef, 0x7bcf, 0x4a69, 0x7bcf, 0x4028, 0x8410, 0x8004, 0x7bef, 0x528a,
+	0x738e, 0x7bef, 0x4006, 0x8410, 0x800f, 0x7bef, 0x8410, 0x39a7, 0x31a6, 0x3186, 0x3166, 0x2965,
+	0x2945, 0x2945, 0x2124, 0x2124, 0x2104, 0x2104, 0x20e4, 0x18e3, 0x4003, 0x18c3, 0x8005, 0x18a3,
+	0x10a2, 0x1082, 0x4228, 0x4a49, 0xc001, 0x0841, 0x001c, 0xc001, 0x39c7, 0x0006, 0x8016, 0x4a49,
+	0x18a3, 0x1082, 0x10a2, 0x10a2, 0x18a3, 0x18c3, 0x18c3, 0x18e3, 0x18e3, 0x20e4, 0x2104, 0x2104,
+	0x2124, 0x2925, 0x2945, 0x2945, 0x2965, 0x3186, 0x3186, 0x8410, 0x7bef, 0x4006, 0x8410, 0x8004,
+	0x7bef, 0x7bcf, 0x4a69, 0x7bcf, 0x4028, 0x8410, 0x8004, 0x7bef, 0x528a, 0x738e, 0x7bef, 0x4006,
+	0x8410, 0x800f, 0x7bef, 0x8410, 0x39a7, 0x31a6, 0x3186, 0x3166, 0x2965, 0x2945, 0x2945, 0x2124,
+	0x2124, 0x2104, 0x2104, 0x20e4, 0x18e3, 0x4003, 0x18c3, 0x8005, 0x18a3, 0x10a2, 0x1082, 0x4228,
+	0x4a49, 0xc001, 0x0841, 0x001c, 0xc001, 0x39c7, 0x0006, 0x8016, 0x4a49, 0x10a2, 0x1062, 0x10a2,
+	0x10a2, 0x18a3, 0x18a3, 0x18c3, 0x18c3, 0x18e3, 0x20e4, 0x2104, 0x2104, 0x2124, 0x2925, 0x2945,
+	0x2945, 0x2965, 0x3186, 0x3186, 0x7bef, 0x7bef, 0x4006, 0x8410, 0x8004, 0x7bef, 0x7bcf, 0x4a69,
+	0x7bcf, 0x4028, 0x8410, 0x8004, 0x7bef, 0x528a, 0x738e, 0x7bef, 0x4006, 0x8410, 0x800f, 0x7bef,
+	0x7bef, 0x39a7, 0x31a6, 0x3186, 0x3186, 0x2965, 0x2945, 0x2945, 0x2124, 0x2124, 0x2104, 0x2104,
+	0x20e4, 0x18e3, 0x4003, 0x18c3, 0x8005, 0x18a3, 0x10a2, 0x1082, 0x4208, 0x4a49, 0xc001, 0x0841,
+	0x001c, 0xc001, 0x39c7, 0x0006, 0x8016, 0x4a49, 0x10a2, 0x1062, 0x10a2, 0x10a2, 0x18a3, 0x18a3,
+	0x18c3, 0x18c3, 0x18e3, 0x20e4, 0x2104, 0x2104, 0x2124, 0x2925, 0x2945, 0x2965, 0x2965, 0x3186,
+	0x3186, 0x6b6d, 0x7bef, 0x4006, 0x8410, 0x8004, 0x7bef, 0x738e, 0x4a69, 0x7bcf, 0x4028, 0x8410,
+	0x8004, 0x7bef, 0x528a, 0x630c, 0x7bef, 0x4006, 0x8410, 0x800f, 0x7bef, 0x73ae, 0x39a7, 0x31a6,
+	0x3186, 0x3186, 0x2965, 0x2945, 0x2945, 0x2124, 0x2124, 0x2104, 0x2104, 0x20e4, 0x18e3, 0x4003,
+	0x18c3, 0x8005, 0x18a3, 0x10a2, 0x1062, 0x4208, 0x4a49, 0xc001, 0x0841, 0x001c, 0xc001, 0x39c7,
+	0x0006, 0x8017, 0x4a49, 0x10a2, 0x1062, 0x1082, 0x10a2, 0x18a3, 0x18a3, 0x18c3, 0x18c3, 0x18e3,
+	0x20e4, 0x2104, 0x2104, 0x2124, 0x2925, 0x2945, 0x2965, 0x2965, 0x3186, 0x3186, 0x4a69, 0x7bef,
+	0x7bef, 0x4004, 0x8410, 0x8005, 0x7bef, 0x8410, 0x528a, 0x4a69, 0x7bcf, 0x4028, 0x8410, 0x8005,
+	0x7bef, 0x52aa, 0x528a, 0x8410, 0x7bcf, 0x4005, 0x8410, 0x8017, 0x7bef, 0x5aeb, 0x39a7, 0x31a6,
+	0x3186, 0x3186, 0x2965, 0x2945, 0x2945, 0x2124, 0x2124, 0x2104, 0x20e4, 0x20e4, 0x18e3, 0x18c3,
+	0x18c3, 0x18a3, 0x18a3, 0x10a2, 0x1062, 0x4208, 0x4a49, 0xc001, 0x0841, 0x001c, 0xc001, 0x39c7,
+	0x0006, 0x8020, 0x4a49, 0x10a2, 0x1062, 0x1082, 0x10a2, 0x18a3, 0x18a3, 0x18c3, 0x18c3, 0x18e3,
+	0x20e4, 0x2104, 0x2104, 0x2124, 0x2124, 0x2945, 0x2945, 0x2965, 0x3166, 0x3186, 0x31a6, 0x630c,
+	0x7bef, 0x7bef, 0x8410, 0x8410, 0x7bef, 0x7bef, 0x632c, 0x4a49, 0x4a69, 0x7bcf, 0x4029, 0x8410,
+	0x8020, 0x52aa, 0x4a69, 0x62ec, 0x8410, 0x7bef, 0x7bef, 0x8410, 0x7bef, 0x7bef, 0x6b6d, 0x39c7,
+	0x39a7, 0x3186, 0x3186, 0x3166, 0x2965, 0x2945, 0x2945, 0x2124, 0x2124, 0x2104, 0x2104, 0x20e4,
+	0x18e3, 0x18c3, 0x18c3, 0x18a3, 0x18a3, 0x10a2, 0x1062, 0x4208, 0x4a49, 0xc001, 0x0841, 0x001c,
+	0xc001, 0x39c7, 0x0006, 0x8017, 0x4a49, 0x10a2, 0x0861, 0x1082, 0x10a2, 0x18a3, 0x18a3, 0x18c3,
+	0x18c3, 0x18e3, 0x20e4, 0x2104, 0x2104, 0x2124, 0x2124, 0x2945, 0x2945, 0x2965, 0x2965, 0x3186,
+	0x31a6, 0x31a6, 0x528a, 0x4003, 0x7bcf, 0x8006, 0x6b6d, 0x528a, 0x4a29, 0x4a49, 0x4a69, 0x7bef,
+	0x4029, 0x8410, 0x8005, 0x52aa, 0x4a69, 0x4a69, 0x528a, 0x6b4d, 0x4003, 0x7bcf, 0x800b, 0x5aeb,
+	0x39c7, 0x39c7, 0x31a6, 0x31a6, 0x3186, 0x2965, 0x2965, 0x2945, 0x2945, 0x2124, 0x4003, 0x2104,
+	0x800a, 0x18e3, 0x18e3, 0x18c3, 0x18c3, 0x18a3, 0x18a3, 0x10a2, 0x1062, 0x4208, 0x4a49, 0xc001,
+	0x0841, 0x001c, 0xc001, 0x39c7, 0x0006, 0x800b, 0x4a49, 0x10a2, 0x0861, 0x1082, 0x10a2, 0x10a2,
+	0x18a3, 0x18c3, 0x18c3, 0x18e3, 0x20e4, 0x4003, 0x2104, 0x8012, 0x2124, 0x2945, 0x2945, 0x2965,
+	0x3166, 0x3186, 0x3186, 0x31a6, 0x39c7, 0x39c7, 0x39e7, 0x41e8, 0x4208, 0x4228, 0x4a29, 0x4a49,
+	0x4a69, 0x7bcf, 0x4028, 0x8410, 0x8014, 0x7bef, 0x52aa, 0x4a69, 0x4a69, 0x4a49, 0x4228, 0x4228,
+	0x4208, 0x41e8, 0x39e7, 0x39c7, 0x39c7, 0x31a6, 0x3186, 0x3186, 0x2965, 0x2965, 0x2945, 0x2925,
+	0x2124, 0x4003, 0x2104, 0x8001, 0x18e3, 0x4003, 0x18c3, 0x8006, 0x18a3, 0x18a3, 0x1082, 0x0861,
+	0x4208, 0x4a49, 0xc001, 0x0841, 0x001c, 0xc001, 0x39c7, 0x0006, 0x8020, 0x4a49, 0x10a2, 0x0861,
+	0x1082, 0x10a2, 0x10a2, 0x18a3, 0x18c3, 0x18c3, 0x18e3, 0x18e3, 0x20e4, 0x2104, 0x2104, 0x2124,
+	0x2925, 0x2945, 0x2965, 0x2965, 0x3186, 0x3186, 0x31a6, 0x39a7, 0x39c7, 0x39e7, 0x41e8, 0x4208,
+	0x4208, 0x4228, 0x4a49, 0x4a49, 0x7bcf, 0x4028, 0x8410, 0x8018, 0x7bef, 0x528a, 0x4a69, 0x4a49,
+	0x4a49, 0x4228, 0x4208, 0x4208, 0x39e7, 0x39c7, 0x39c7, 0x39a7, 0x31a6, 0x3186, 0x3186, 0x2965,
+	0x2945, 0x2945, 0x2925, 0x2124, 0x2104, 0x2104, 0x20e4, 0x18e3, 0x4003, 0x18c3, 0x8006, 0x18a3,
+	0x10a2, 0x1082, 0x0861, 0x4208, 0x4a49, 0xc001, 0x0841, 0x001c, 0xc001, 0x39c7, 0x0006, 0x8020,
+	0x4a49, 0x10a2, 0x0841, 0x1082, 0x10a2, 0x10a2, 0x18a3, 0x18a3, 0x18c3, 0x18c3, 0x18e3, 0x20e4,
+	0x2104, 0x2104, 0x2124, 0x2925, 0x2945, 0x2945, 0x2965, 0x3166, 0x3186, 0x31a6, 0x39a7, 0x39c7,
+	0x39e7, 0x39e7, 0x4208, 0x4208, 0x4228, 0x4a29, 0x4a49, 0x7bcf, 0x4029, 0x8410, 0x8017, 0x528a,
+	0x4a69, 0x4a49, 0x4a29, 0x4228, 0x4208, 0x4208, 0x39e7, 0x39c7, 0x39c7, 0x39a7, 0x31a6, 0x3186,
+	0x3166, 0x2965, 0x2945, 0x2945, 0x2925, 0x2124, 0x2104, 0x2104, 0x20e4, 0x18e3, 0x4003, 0x18c3,
+	0x8006, 0x18a3, 0x10a2, 0x1082, 0x0861, 0x4208, 0x4a49, 0xc001, 0x0841, 0x001c, 0xc001, 0x39c7,
+	0x0006, 0x8021, 0x4a49, 0x1082, 0x0841, 0x1062, 0x10a2, 0x10a2, 0x18a3, 0x18a3, 0x18c3, 0x18c3,
+	0x18e3, 0x20e4, 0x2104, 0x2104, 0x2124, 0x2124, 0x2945, 0x2945, 0x2965, 0x3166, 0x3186, 0x3186,
+	0x31a6, 0x39c7, 0x39c7, 0x39e7, 0x4208, 0x4208, 0x4228, 0x4a29, 0x4a49, 0x7bef, 0x7bcf, 0x4026,
+	0x8410, 0x8022, 0x7bef, 0x8410, 0x4a69, 0x4a49, 0x4a49, 0x4228, 0x4228, 0x4208, 0x41e8, 0x39e7,
+	0x39c7, 0x39c7, 0x31a6, 0x3186, 0x3186, 0x2965, 0x2965, 0x2945, 0x2945, 0x2124, 0x2124, 0x2104,
+	0x2104, 0x20e4, 0x18e3, 0x18c3, 0x18c3, 0x18a3, 0x18a3, 0x10a2, 0x1082, 0x0841, 0x4208, 0x4a49,
+	0xc001, 0x0841, 0x001c, 0xc001, 0x39c7, 0x0006, 0x800c, 0x4a49, 0x1082, 0x0841, 0x1062, 0x1082,
+	0x10a2, 0x18a3, 0x18a3, 0x18c3, 0x18c3, 0x18e3, 0x20e4, 0x4003, 0x2104, 0x8013, 0x2124, 0x2925,
+	0x2945, 0x2965, 0x2965, 0x3186, 0x3186, 0x31a6, 0x39a7, 0x39c7, 0x39e7, 0x39e7, 0x4208, 0x4208,
+	0x4228, 0x4a29, 0x6b4d, 0x7bef, 0x7bef, 0x4025, 0x8410, 0x8022, 0x7bcf, 0x73ae, 0x4a69, 0x4a49,
+	0x4a29, 0x4228, 0x4208, 0x4208, 0x39e7, 0x39e7, 0x39c7, 0x39a7, 0x31a6, 0x3186, 0x3186, 0x2965,
+	0x2945, 0x2945, 0x2925, 0x2124, 0x2124, 0x2104, 0x2104, 0x18e3, 0x18e3, 0x18c3, 0x18c3, 0x18a3,
+	0x18a3, 0x10a2, 0x1062, 0x0841, 0x4208, 0x4a49, 0xc001, 0x0841, 0x001c, 0xc001, 0x39c7, 0x0006,
+	0x8023, 0x4a49, 0x1082, 0x0841, 0x0861, 0x1082, 0x10a2, 0x10a2, 0x18a3, 0x18c3, 0x18c3, 0x18e3,
+	0x18e3, 0x20e4, 0x2104, 0x2104, 0x2124, 0x2925, 0x2945, 0x2945, 0x2965, 0x3186, 0x3186, 0x31a6,
+	0x31a6, 0x39c7, 0x39c7, 0x39e7, 0x4208, 0x4208, 0x4228, 0x4a29, 0x4a49, 0x738e, 0x7bef, 0x7bef,
+	0x4023, 0x8410, 0x8019, 0x7bef, 0x8410, 0x4a69, 0x4a49, 0x4a49, 0x4a29, 0x4228, 0x4208, 0x4208,
+	0x39e7, 0x39c7, 0x39c7, 0x31a6, 0x31a6, 0x3186, 0x3166, 0x2965, 0x2945, 0x2945, 0x2925, 0x2124,
+	0x2104, 0x2104, 0x20e4, 0x18e3, 0x4003, 0x18c3, 0x8007, 0x18a3, 0x18a3, 0x1082, 0x0861, 0x0841,
+	0x4208, 0x4a49, 0xc001, 0x0841, 0x001c, 0xc001, 0x39c7, 0x0006, 0x8008, 0x4a49, 0x1082, 0x0841,
+	0x0841, 0x1082, 0x10a2, 0x10a2, 0x18a3, 0x4003, 0x18c3, 0x8019, 0x18e3, 0x20e4, 0x2104, 0x2104,
+	0x2124, 0x2925, 0x2945, 0x2945, 0x2965, 0x3166, 0x3186, 0x3186, 0x31a6, 0x39a7, 0x39c7, 0x39e7,
+	0x39e7, 0x4208, 0x4208, 0x4228, 0x4a49, 0x4a49, 0x6b4d, 0x7bef, 0x8410, 0x4003, 0x7bef, 0x400a,
+	0x8410, 0x4006, 0x7bef, 0x400a, 0x8410, 0x4005, 0x7bef, 0x8019, 0x73ae, 0x528a, 0x4a69, 0x4a49,
+	0x4a29, 0x4228, 0x4208, 0x4208, 0x39e7, 0x39e7, 0x39c7, 0x39a7, 0x31a6, 0x3186, 0x3186, 0x3166,
+	0x2965, 0x2945, 0x2945, 0x2124, 0x2124, 0x2104, 0x2104, 0x20e4, 0x18e3, 0x4003, 0x18c3, 0x8007,
+	0x18a3, 0x10a2, 0x1082, 0x0861, 0x0841, 0x4208, 0x4a49, 0xc001, 0x0841, 0x001c, 0xc001, 0x39c7,
+	0x0006, 0x8008, 0x4a49, 0x1082, 0x0821, 0x0841, 0x1062, 0x1082, 0x10a2, 0x18a3, 0x4003, 0x18c3,
+	0x801e, 0x18e3, 0x20e4, 0x2104, 0x2104, 0x2124, 0x2124, 0x2925, 0x2945, 0x2965, 0x2965, 0x3186,
+	0x3186, 0x31a6, 0x39a7, 0x39c7, 0x39c7, 0x39e7, 0x41e8, 0x4208, 0x4228, 0x4228, 0x4a49, 0x4a49,
+	0x528a, 0x62ec, 0x6b6d, 0x738e, 0x6b6d, 0x7bcf, 0x7bef, 0x4006, 0x8410, 0x8004, 0x7bef, 0x8410,
+	0x7bcf, 0x7bcf, 0x4003, 0x7bef, 0x8003, 0x7bcf, 0x8410, 0x7bef, 0x4006, 0x8410, 0x8002, 0x7bef,
+	0x7bef, 0x4003, 0x738e, 0x8007, 0x632c, 0x52aa, 0x4a69, 0x4a69, 0x4a49, 0x4a29, 0x4228, 0x4003,
+	0x4208, 0x800c, 0x39e7, 0x39c7, 0x39c7, 0x31a6, 0x31a6, 0x3186, 0x3186, 0x2965, 0x2945, 0x2945,
+	0x2925, 0x2124, 0x4003, 0x2104, 0x800c, 0x18e3, 0x18e3, 0x18c3, 0x18c3, 0x18a3, 0x18a3, 0x10a2,
+	0x1082, 0x0841, 0x0821, 0x4208, 0x4a49, 0xc001, 0x0841, 0x001c, 0xc001, 0x39c7, 0x0006, 0x8029,
+	0x4a49, 0x1082, 0x0821, 0x0841, 0x0861, 0x1082, 0x10a2, 0x10a2, 0x18a3, 0x18c3, 0x18c3, 0x18e3,
+	0x20e4, 0x20e4, 0x2104, 0x2104, 0x2124, 0x2925, 0x2945, 0x2945, 0x2965, 0x3166, 0x3186, 0x3186,
+	0x31a6, 0x39a7, 0x39c7, 0x39e7, 0x39e7, 0x4208, 0x4208, 0x4228, 0x4228, 0x4a49, 0x4a49, 0x4a69,
+	0x4a69, 0x528a, 0x528a, 0x6b2d, 0x7bef, 0x4006, 0x8410, 0x8003, 0x7bef, 0x8410, 0x630c, 0x4005,
+	0x62ec, 0x8002, 0x8410, 0x7bef, 0x4007, 0x8410, 0x8002, 0x6b6d, 0x52aa, 0x4003, 0x528a, 0x8019,
+	0x4a69, 0x4a69, 0x4a49, 0x4a49, 0x4a29, 0x4228, 0x4208, 0x4208, 0x39e7, 0x39e7, 0x39c7, 0x39a7,
+	0x31a6, 0x3186, 0x3186, 0x3166, 0x2965, 0x2945, 0x2945, 0x2925, 0x2124, 0x2104, 0x2104, 0x20e4,
+	0x18e3, 0x4003, 0x18c3, 0x8008, 0x18a3, 0x18a3, 0x1082, 0x0861, 0x0841, 0x0821, 0x4208, 0x4a49,
+	0xc001, 0x0841, 0x001c, 0xc001, 0x39c7, 0x0006, 0x8009, 0x4a49, 0x1082, 0x0821, 0x0841, 0x0861,
+	0x1082, 0x10a2, 0x10a2, 0x18a3, 0x4003, 0x18c3, 0x801c, 0x18e3, 0x20e4, 0x2104, 0x2104, 0x2124,
+	0x2124, 0x2925, 0x2945, 0x2965, 0x2965, 0x3186, 0x3186, 0x31a6, 0x31a6, 0x39c7, 0x39c7, 0x39e7,
+	0x39e7, 0x4208, 0x4208, 0x4228, 0x4a29, 0x4a49, 0x4a49, 0x4a69, 0x4a69, 0x528a, 0x632c, 0x4007,
+	0x8410, 0x8002, 0x7bef, 0x8410, 0x4006, 0x5aeb, 0x8002, 0x8410, 0x7bef, 0x4007, 0x8410, 0x8001,
+	0x6b6d, 0x4003, 0x528a, 0x8011, 0x4a69, 0x4a69, 0x4a49, 0x4a49, 0x4a29, 0x4228, 0x4208, 0x4208,
+	0x39e7, 0x39e7, 0x39c7, 0x39c7, 0x31a6, 0x31a6, 0x3186, 0x3186, 0x2965, 0x4003, 0x2945, 0x8006,
+	0x2124, 0x2124, 0x2104, 0x2104, 0x20e4, 0x18e3, 0x4003, 0x18c3, 0x8008, 0x18a3, 0x10a2, 0x1082,
+	0x0861, 0x0841, 0x0821, 0x4208, 0x4a49, 0xc001, 0x0841, 0x001c, 0xc001, 0x39c7, 0x0006, 0x8009,
+	0x4a49, 0x1082, 0x0020, 0x0821, 0x0841, 0x1062, 0x1082, 0x10a2, 0x18a3, 0x4003, 0x18c3, 0x800e,
+	0x18e3, 0x20e4, 0x20e4, 0x2104, 0x2104, 0x2124, 0x2925, 0x2945, 0x2945, 0x2965, 0x2965, 0x3186,
+	0x3186, 0x31a6, 0x4003, 0x39c7, 0x800b, 0x39e7, 0x41e8, 0x4208, 0x4228, 0x4228, 0x4a29, 0x4a49,
+	0x4a49, 0x4a69, 0x4a69, 0x630c, 0x4007, 0x8410, 0x8003, 0x7bef, 0x8410, 0x5aeb, 0x4005, 0x5acb,
+	0x8002, 0x8410, 0x7bef, 0x4007, 0x8410, 0x801d, 0x6b6d, 0x528a, 0x528a, 0x4a69, 0x4a69, 0x4a49,
+	0x4a49, 0x4a29, 0x4228, 0x4208, 0x4208, 0x41e8, 0x39e7, 0x39c7, 0x39c7, 0x39a7, 0x31a6, 0x3186,
+	0x3186, 0x3166, 0x2965, 0x2945, 0x2945, 0x2925, 0x2124, 0x2104, 0x2104, 0x20e4, 0x20e4, 0x4003,
+	0x18c3, 0x8009, 0x18a3, 0x18a3, 0x10a2, 0x1082, 0x0841, 0x0821, 0x0821, 0x4208, 0x4a49, 0xc001,
+	0x0841, 0x001c, 0xc001, 0x39c7, 0x0006, 0x800a, 0x4a49, 0x1082, 0x0020, 0x0821, 0x0841, 0x0861,
+	0x1082, 0x10a2, 0x10a2, 0x18a3, 0x4003, 0x18c3, 0x801b, 0x18e3, 0x20e4, 0x2104, 0x2104, 0x2124,
+	0x2124, 0x2945, 0x2945, 0x2965, 0x2965, 0x3186, 0x3186, 0x31a6, 0x31a6, 0x39c7, 0x39c7, 0x39e7,
+	0x39e7, 0x41e8, 0x4208, 0x4228, 0x4228, 0x4a29, 0x4a49, 0x4a49, 0x4a69, 0x630c, 0x4007, 0x8410,
+	0x8002, 0x7bef, 0x8410, 0x4006, 0x5acb, 0x8002, 0x8410, 0x7bef, 0x4007, 0x8410, 0x8001, 0x6b4d,
+	0x4003, 0x4a69, 0x4003, 0x4a49, 0x8001, 0x4228, 0x4003, 0x4208, 0x8012, 0x39e7, 0x39e7, 0x39c7,
+	0x39a7, 0x31a6, 0x3186, 0x3186, 0x3166, 0x2965, 0x2945, 0x2945, 0x2925, 0x2124, 0x2124, 0x2104,
+	0x2104, 0x20e4, 0x18e3, 0x4003, 0x18c3, 0x8009, 0x18a3, 0x10a2, 0x1082, 0x0861, 0x0841, 0x0821,
+	0x0020, 0x4208, 0x4a49, 0xc001, 0x0841, 0x001c, 0xc001, 0x39c7, 0x0006, 0x800a, 0x4a49, 0x1082,
+	0x0020, 0x0020, 0x0841, 0x0841, 0x1062, 0x10a2, 0x10a2, 0x18a3, 0x4003, 0x18c3, 0x801b, 0x18e3,
+	0x20e4, 0x20e4, 0x2104, 0x2104, 0x2124, 0x2925, 0x2945, 0x2945, 0x2965, 0x2965, 0x3186, 0x3186,
+	0x31a6, 0x31a6, 0x39c7, 0x39c7, 0x39e7, 0x39e7, 0x4208, 0x4208, 0x4228, 0x4228, 0x4a29, 0x4a49,
+	0x4a49, 0x630c, 0x4007, 0x8410, 0x8003, 0x7bef, 0x8410, 0x5acb, 0x4005, 0x52aa, 0x8002, 0x8410,
+	0x7bef, 0x4007, 0x8410, 0x8007, 0x6b4d, 0x4a69, 0x4a69, 0x4a49, 0x4a49, 0x4a29, 0x4228, 0x4003,
+	0x4208, 0x8009, 0x39e7, 0x39e7, 0x39c7, 0x39c7, 0x39a7, 0x31a6, 0x3186, 0x3186, 0x2965, 0x4003,
+	0x2945, 0x8006, 0x2925, 0x2124, 0x2104, 0x2104, 0x20e4, 0x20e4, 0x4003, 0x18c3, 0x800a, 0x18a3,
+	0x18a3, 0x10a2, 0x1082, 0x0841, 0x0841, 0x0821, 0x0020, 0x4208, 0x4a49, 0xc001, 0x0841, 0x001c,
+	0xc001, 0x39c7, 0x0006, 0x800b, 0x4a49, 0x1082, 0x0020, 0x0020, 0x0821, 0x0841, 0x0861, 0x1082,
+	0x10a2, 0x10a2, 0x18a3, 0x4003, 0x18c3, 0x8006, 0x18e3, 0x20e4, 0x2104, 0x2104, 0x2124, 0x2124,
+	0x4003, 0x2945, 0x800c, 0x2965, 0x2965, 0x3186, 0x3186, 0x31a6, 0x31a6, 0x39c7, 0x39c7, 0x39e7,
+	0x39e7, 0x4208, 0x4208, 0x4003, 0x4228, 0x8002, 0x4a49, 0x62ec, 0x4007, 0x8410, 0x8003, 0x7bef,
+	0x8410, 0x52aa, 0x4003, 0x528a, 0x8004, 0x52aa, 0x52aa, 0x8410, 0x7bef, 0x4007, 0x8410, 0x8001,
+	0x6b4d, 0x4003, 0x4a49, 0x8002, 0x4a29, 0x4228, 0x4003, 0x4208, 0x8013, 0x39e7, 0x39e7, 0x39c7,
+	0x39c7, 0x39a7, 0x31a6, 0x3186, 0x3186, 0x3166, 0x2965, 0x2945, 0x2945, 0x2925, 0x2124, 0x2124,
+	0x2104, 0x2104, 0x20e4, 0x18e3, 0x4003, 0x18c3, 0x800a, 0x18a3, 0x18a3, 0x1082, 0x0861, 0x0841,
+	0x0821, 0x0020, 0x0020, 0x4208, 0x4a49, 0xc001, 0x0841, 0x001c, 0xc001, 0x39c7, 0x0006, 0x800b,
+	0x4a49, 0x1062, 0x0000, 0x0020, 0x0821, 0x0841, 0x0841, 0x1082, 0x10a2, 0x10a2, 0x18a3, 0x4003,
+	0x18c3, 0x8007, 0x18e3, 0x20e4, 0x20e4, 0x2104, 0x2104, 0x2124, 0x2124, 0x4003, 0x2945, 0x800a,
+	0x2965, 0x3166, 0x3186, 0x3186, 0x31a6, 0x39a7, 0x39c7, 0x39c7, 0x39e7, 0x39e7, 0x4003, 0x4208,
+	0x8003, 0x4228, 0x4228, 0x62ec, 0x4007, 0x8410, 0x8003, 0x7bef, 0x8410, 0x52aa, 0x4005, 0x528a,
+	0x8002, 0x7bef, 0x7bef, 0x4007, 0x8410, 0x8005, 0x6b2d, 0x4a49, 0x4a49, 0x4228, 0x4228, 0x4003,
+	0x4208, 0x8006, 0x39e7, 0x39e7, 0x39c7, 0x39c7, 0x39a7, 0x31a6, 0x4003, 0x3186, 0x800a, 0x2965,
+	0x2965, 0x2945, 0x2945, 0x2124, 0x2124, 0x2104, 0x2104, 0x20e4, 0x20e4, 0x4003, 0x18c3, 0x800b,
+	0x18a3, 0x18a3, 0x10a2, 0x1082, 0x0861, 0x0841, 0x0821, 0x0020, 0x0000, 0x4208, 0x4a49, 0xc001,
+	0x0841, 0x001c, 0xc001, 0x39c7, 0x0006, 0x800c, 0x4a49, 0x1062, 0x0000, 0x0020, 0x0020, 0x0821,
+	0x0841, 0x0861, 0x1082, 0x10a2, 0x18a3, 0x18a3, 0x4003, 0x18c3, 0x8002, 0x18e3, 0x20e4, 0x4003,
+	0x2104, 0x8014, 0x2124, 0x2925, 0x2945, 0x2945, 0x2965, 0x2965, 0x3166, 0x3186, 0x3186, 0x31a6,
+	0x39a7, 0x39c7, 0x39c7, 0x39e7, 0x39e7, 0x41e8, 0x4208, 0x4208, 0x4228, 0x5aeb, 0x4007, 0x8410,
+	0x8003, 0x7bef, 0x8410, 0x528a, 0x4005, 0x4a69, 0x8002, 0x7bef, 0x7bef, 0x4007, 0x8410, 0x800d,
+	0x632c, 0x4a29, 0x4228, 0x4228, 0x4208, 0x4208, 0x41e8, 0x39e7, 0x39e7, 0x39c7, 0x39c7, 0x39a7,
+	0x31a6, 0x4003, 0x3186, 0x8006, 0x2965, 0x2965, 0x2945, 0x2945, 0x2925, 0x2124, 0x4003, 0x2104,
+	0x8002, 0x20e4, 0x18e3, 0x4003, 0x18c3, 0x800b, 0x18a3, 0x18a3, 0x10a2, 0x1062, 0x0841, 0x0821,
+	0x0020, 0x0020, 0x0000, 0x4208, 0x4a49, 0xc001, 0x0841, 0x001c, 0xc001, 0x39c7, 0x0006, 0x800c,
+	0x4a49, 0x1062, 0x0000, 0x0000, 0x0020, 0x0821, 0x0841, 0x0841, 0x1082, 0x10a2, 0x18a3, 0x18a3,
+	0x4003, 0x18c3, 0x8003, 0x18e3, 0x18e3, 0x20e4, 0x4003, 0x2104, 0x8006, 0x2124, 0x2925, 0x2945,
+	0x2945, 0x2965, 0x3166, 0x4003, 0x3186, 0x800a, 0x31a6, 0x39a7, 0x39c7, 0x39c7, 0x39e7, 0x39e7,
+	0x41e8, 0x4208, 0x4208, 0x5aeb, 0x4007, 0x8410, 0x8003, 0x7bef, 0x8410, 0x528a, 0x4005, 0x4a69,
+	0x8002, 0x7bef, 0x7bef, 0x4007, 0x8410, 0x8002, 0x632c, 0x4228, 0x4003, 0x4208, 0x4003, 0x39e7,
+	0x8004, 0x39c7, 0x39c7, 0x39a7, 0x31a6, 0x4003, 0x3186, 0x800b, 0x2965, 0x2965, 0x2945, 0x2945,
+	0x2925, 0x2124, 0x2124, 0x2104, 0x2104, 0x20e4, 0x18e3, 0x4003, 0x18c3, 0x800c, 0x18a3, 0x18a3,
+	0x10a2, 0x1082, 0x0861, 0x0841, 0x0821, 0x0020, 0x0000, 0x0000, 0x4208, 0x4a49, 0xc001, 0x0841,
+	0x001c, 0xc001, 0x39c7, 0x0006, 0x800d, 0x4a49, 0x1062, 0x0000, 0x0000, 0x0020, 0x0020, 0x0821,
+	0x0841, 0x0861, 0x1082, 0x10a2, 0x18a3, 0x18a3, 0x4003, 0x18c3, 0x8007, 0x18e3, 0x20e4, 0x20e4,
+	0x2104, 0x2104, 0x2124, 0x2124, 0x4003, 0x2945, 0x800e, 0x2965, 0x3166, 0x3186, 0x3186, 0x31a6,
+	0x31a6, 0x39a7, 0x39c7, 0x39c7, 0x39e7, 0x39e7, 0x41e8, 0x41e8, 0x5acb, 0x4007, 0x8410, 0x8003,
+	0x7bef, 0x8410, 0x4a69, 0x4005, 0x4a49, 0x8002, 0x7bef, 0x7bef, 0x4007, 0x8410, 0x8001, 0x632c,
+	0x4003, 0x4208, 0x8002, 0x39e7, 0x39e7, 0x4003, 0x39c7, 0x8002, 0x39a7, 0x31a6, 0x4003, 0x3186,
+	0x800c, 0x2965, 0x2965, 0x2945, 0x2945, 0x2925, 0x2124, 0x2124, 0x2104, 0x2104, 0x20e4, 0x20e4,
+	0x18e3, 0x4003, 0x18c3, 0x800c, 0x18a3, 0x10a2, 0x1082, 0x0861, 0x0841, 0x0821, 0x0020, 0x0020,
+	0x0000, 0x0000, 0x4208, 0x4a49, 0xc001, 0x0841, 0x001c, 0xc001, 0x39c7, 0x0006, 0x8002, 0x4a49,
+	0x1062, 0x4003, 0x0000, 0x8009, 0x0020, 0x0821, 0x0841, 0x0841, 0x1062, 0x1082, 0x10a2, 0x18a3,
+	0x18a3, 0x4003, 0x18c3, 0x8007, 0x18e3, 0x20e4, 0x20e4, 0x2104, 0x2104, 0x2124, 0x2124, 0x4003,
+	0x2945, 0x8004, 0x2965, 0x3166, 0x3186, 0x3186, 0x4003, 0x31a6, 0x4003, 0x39c7, 0x8004, 0x39e7,
+	0x39e7, 0x5acb, 0x7bef, 0x4006, 0x8410, 0x8002, 0x7bef, 0x7bef, 0x4006, 0x4a29, 0x8002, 0x7bcf,
+	0x7bef, 0x4006, 0x8410, 0x8003, 0x7bef, 0x6b4d, 0x4208, 0x4003, 0x39e7, 0x8005, 0x39c7, 0x39c7,
+	0x39a7, 0x39a7, 0x31a6, 0x4003, 0x3186, 0x8007, 0x2965, 0x2965, 0x2945, 0x2945, 0x2925, 0x2124,
+	0x2124, 0x4003, 0x2104, 0x8002, 0x20e4, 0x18e3, 0x4003, 0x18c3, 0x8008, 0x18a3, 0x18a3, 0x10a2,
+	0x1082, 0x0841, 0x0841, 0x0821, 0x0020, 0x4003, 0x0000, 0x8002, 0x4208, 0x4a49, 0xc001, 0x0841,
+	0x001c, 0xc001, 0x39c7, 0x0006, 0x8002, 0x4a49, 0x1062, 0x4003, 0x0000, 0x8009, 0x0020, 0x0020,
+	0x0821, 0x0841, 0x0861, 0x1082, 0x10a2, 0x18a3, 0x18a3, 0x4003, 0x18c3, 0x8003, 0x18e3, 0x18e3,
+	0x20e4, 0x4003, 0x2104, 0x8002, 0x2124, 0x2124, 0x4003, 0x2945, 0x8002, 0x2965, 0x2965, 0x4003,
+	0x3186, 0x8003, 0x31a6, 0x31a6, 0x39a7, 0x4003, 0x39c7, 0x8003, 0x39e7, 0x7bef, 0x7bcf, 0x4005,
+	0x8410, 0x8002, 0x7bcf, 0x6b4d, 0x4006, 0x4228, 0x8002, 0x5aeb, 0x7bef, 0x4005, 0x8410, 0x8005,
+	0x7bef, 0x8410, 0x4228, 0x39e7, 0x39e7, 0x4003, 0x39c7, 0x8003, 0x39a7, 0x31a6, 0x31a6, 0x4003,
+	0x3186, 0x8002, 0x2965, 0x2965, 0x4003, 0x2945, 0x8002, 0x2124, 0x2124, 0x4003, 0x2104, 0x8002,
+	0x20e4, 0x18e3, 0x4004, 0x18c3, 0x8008, 0x18a3, 0x10a2, 0x1082, 0x0861, 0x0841, 0x0821, 0x0020,
+	0x0020, 0x4003, 0x0000, 0x8002, 0x4208, 0x4a49, 0xc001, 0x0841, 0x001c, 0xc001, 0x39c7, 0x0006,
+	0x8002, 0x4a49, 0x1062, 0x4004, 0x0000, 0x8009, 0x0020, 0x0020, 0x0841, 0x0841, 0x0861, 0x1082,
+	0x10a2, 0x18a3, 0x18a3, 0x4003, 0x18c3, 0x8003, 0x18e3, 0x18e3, 0x20e4, 0x4003, 0x2104, 0x8002,
+	0x2124, 0x2124, 0x4003, 0x2945, 0x8005, 0x2965, 0x2965, 0x3166, 0x3186, 0x3186, 0x4003, 0x31a6,
+	0x4003, 0x39c7, 0x8002, 0x4a69, 0x7bcf, 0x4005, 0x7bef, 0x8001, 0x7bcf, 0x4008, 0x4208, 0x8001,
+	0x6b6d, 0x4006, 0x7bef, 0x8002, 0x5acb, 0x39e7, 0x4003, 0x39c7, 0x8003, 0x39a7, 0x39a7, 0x31a6,
+	0x4004, 0x3186, 0x8002, 0x2965, 0x2965, 0x4003, 0x2945, 0x8002, 0x2124, 0x2124, 0x4003, 0x2104,
+	0x8002, 0x20e4, 0x20e4, 0x4004, 0x18c3, 0x8008, 0x18a3, 0x10a2, 0x10a2, 0x1062, 0x0841, 0x0841,
+	0x0821, 0x0020, 0x4004, 0x0000, 0x8002, 0x4208, 0x4a49, 0xc001, 0x0841, 0x001c, 0xc001, 0x39c7,
+	0x0006, 0x8002, 0x4a49, 0x1062, 0x4004, 0x0000, 0x800a, 0x0020, 0x0020, 0x0821, 0x0841, 0x0841,
+	0x1062, 0x1082, 0x10a2, 0x18a3, 0x18a3, 0x4003, 0x18c3, 0x8003, 0x18e3, 0x18e3, 0x20e4, 0x4003,
+	0x2104, 0x8002, 0x2124, 0x2124, 0x4003, 0x2945, 0x8003, 0x2965, 0x2965, 0x3166, 0x4003, 0x3186,
+	0x800d, 0x31a6, 0x31a6, 0x39a7, 0x39c7, 0x39c7, 0x4208, 0x6b4d, 0x7bcf, 0x7bef, 0x7bcf, 0x5aeb,
+	0x39e7, 0x39e7, 0x4007, 0x4208, 0x8007, 0x41e8, 0x52aa, 0x7bcf, 0x7bef, 0x7bef, 0x6b6d, 0x4a49,
+	0x4003, 0x39c7, 0x8004, 0x39a7, 0x39a7, 0x31a6, 0x31a6, 0x4003, 0x3186, 0x8008, 0x3166, 0x2965,
+	0x2965, 0x2945, 0x2945, 0x2925, 0x2124, 0x2124, 0x4003, 0x2104, 0x8003, 0x20e4, 0x20e4, 0x18e3,
+	0x4003, 0x18c3, 0x8009, 0x18a3, 0x18a3, 0x10a2, 0x1082, 0x0861, 0x0841, 0x0821, 0x0020, 0x0020,
+	0x4004, 0x0000, 0x8002, 0x4208, 0x4a49, 0xc001, 0x0841, 0x001c, 0xc001, 0x39c7, 0x0006, 0x8002,
+	0x4a49, 0x1062, 0x4005, 0x0000, 0x800a, 0x0020, 0x0020, 0x0821, 0x0841, 0x0861, 0x1082, 0x10a2,
+	0x10a2, 0x18a3, 0x18a3, 0x4003, 0x18c3, 0x8003, 0x18e3, 0x20e4, 0x20e4, 0x4003, 0x2104, 0x8009,
+	0x2124, 0x2124, 0x2925, 0x2945, 0x2945, 0x2965, 0x2965, 0x3166, 0x3166, 0x4003, 0x3186, 0x8004,
+	0x31a6, 0x31a6, 0x39a7, 0x39a7, 0x4006, 0x39c7, 0x400b, 0x39e7, 0x4005, 0x39c7, 0x8004, 0x39a7,
+	0x39a7, 0x31a6, 0x31a6, 0x4004, 0x3186, 0x4003, 0x2965, 0x8005, 0x2945, 0x2945, 0x2925, 0x2124,
+	0x2124, 0x4003, 0x2104, 0x8003, 0x20e4, 0x20e4, 0x18e3, 0x4003, 0x18c3, 0x8009, 0x18a3, 0x18a3,
+	0x10a2, 0x1082, 0x0861, 0x0841, 0x0821, 0x0020, 0x0020, 0x4005, 0x0000, 0x8002, 0x4208, 0x4a49,
+	0xc001, 0x0841, 0x001c, 0xc001, 0x39c7, 0x0006, 0x8002, 0x4a49, 0x1062, 0x4006, 0x0000, 0x8009,
+	0x0020, 0x0020, 0x0821, 0x0841, 0x0861, 0x1082, 0x10a2, 0x18a3, 0x18a3, 0x4004, 0x18c3, 0x8005,
+	0x18e3, 0x20e4, 0x20e4, 0x2104, 0x2104, 0x4003, 0x2124, 0x4004, 0x2945, 0x8003, 0x2965, 0x2965,
+	0x3166, 0x4004, 0x3186, 0x8004, 0x31a6, 0x31a6, 0x39a7, 0x39a7, 0x4011, 0x39c7, 0x8002, 0x39a7,
+	0x39a7, 0x4003, 0x31a6, 0x4004, 0x3186, 0x8003, 0x3166, 0x2965, 0x2965, 0x4003, 0x2945, 0x8003,
+	0x2925, 0x2124, 0x2124, 0x4003, 0x2104, 0x8003, 0x20e4, 0x20e4, 0x18e3, 0x4004, 0x18c3, 0x8008,
+	0x18a3, 0x10a2, 0x1082, 0x0861, 0x0841, 0x0821, 0x0821, 0x0020, 0x4006, 0x0000, 0x8002, 0x4208,
+	0x4a49, 0xc001, 0x0841, 0x001c, 0xc001, 0x39c7, 0x0006, 0x8002, 0x4a49, 0x1062, 0x4006, 0x0000,
+	0x800a, 0x0020, 0x0020, 0x0821, 0x0841, 0x0841, 0x1062, 0x1082, 0x10a2, 0x18a3, 0x18a3, 0x4004,
+	0x18c3, 0x8003, 0x18e3, 0x18e3, 0x20e4, 0x4003, 0x2104, 0x8003, 0x2124, 0x2124, 0x2925, 0x4003,
+	0x2945, 0x4003, 0x2965, 0x4005, 0x3186, 0x4004, 0x31a6, 0x4004, 0x39a7, 0x4005, 0x39c7, 0x4005,
+	0x39a7, 0x4003, 0x31a6, 0x4005, 0x3186, 0x8001, 0x3166, 0x4003, 0x2965, 0x4003, 0x2945, 0x8003,
+	0x2925, 0x2124, 0x2124, 0x4003, 0x2104, 0x8003, 0x20e4, 0x20e4, 0x18e3, 0x4004, 0x18c3, 0x8009,
+	0x18a3, 0x10a2, 0x10a2, 0x1062, 0x0841, 0x0841, 0x0821, 0x0020, 0x0020, 0x4006, 0x0000, 0x8002,
+	0x4208, 0x4a49, 0xc001, 0x0841, 0x001c, 0xc001, 0x39c7, 0x0006, 0x8002, 0x4a49, 0x1062, 0x4007,
+	0x0000, 0x800a, 0x0020, 0x0020, 0x0821, 0x0841, 0x0841, 0x1062, 0x10a2, 0x10a2, 0x18a3, 0x18a3,
+	0x4004, 0x18c3, 0x8003, 0x18e3, 0x18e3, 0x20e4, 0x4003, 0x2104, 0x4003, 0x2124, 0x4004, 0x2945,
+	0x4003, 0x2965, 0x8001, 0x3166, 0x4005, 0x3186, 0x400f, 0x31a6, 0x4006, 0x3186, 0x8001, 0x3166,
+	0x4003, 0x2965, 0x4003, 0x2945, 0x8001, 0x2925, 0x4003, 0x2124, 0x4003, 0x2104, 0x8003, 0x20e4,
+	0x20e4, 0x18e3, 0x4004, 0x18c3, 0x8009, 0x18a3, 0x10a2, 0x10a2, 0x1082, 0x0841, 0x0841, 0x0821,
+	0x0020, 0x0020, 0x4007, 0x0000, 0x8002, 0x4208, 0x4a49, 0xc001, 0x0841, 0x001c, 0xc001, 0x39c7,
+	0x0006, 0x8002, 0x4a49, 0x1062, 0x4008, 0x0000, 0x800a, 0x0020, 0x0020, 0x0821, 0x0841, 0x0841,
+	0x1062, 0x10a2, 0x10a2, 0x18a3, 0x18a3, 0x4004, 0x18c3, 0x8003, 0x18e3, 0x18e3, 0x20e4, 0x4003,
+	0x2104, 0x4004, 0x2124, 0x4004, 0x2945, 0x4004, 0x2965, 0x8001, 0x3166, 0x4014, 0x3186, 0x8001,
+	0x3166, 0x4004, 0x2965, 0x4003, 0x2945, 0x8004, 0x2925, 0x2925, 0x2124, 0x2124, 0x4004, 0x2104,
+	0x8003, 0x20e4, 0x20e4, 0x18e3, 0x4004, 0x18c3, 0x8009, 0x18a3, 0x18a3, 0x10a2, 0x1082, 0x0861,
+	0x0841, 0x0821, 0x0020, 0x0020, 0x4008, 0x0000, 0x8002, 0x4208, 0x4a49, 0xc001, 0x0841, 0x001c,
+	0xc001, 0x39c7, 0x0006, 0x8002, 0x4a49, 0x1062, 0x4009, 0x0000, 0x800a, 0x0020, 0x0020, 0x0821,
+	0x0841, 0x0861, 0x1062, 0x10a2, 0x10a2, 0x18a3, 0x18a3, 0x4004, 0x18c3, 0x8004, 0x18e3, 0x2104,
+	0x632c, 0x4a49, 0x4003, 0x2104, 0x4003, 0x2124, 0x8001, 0x2925, 0x4005, 0x2945, 0x8006, 0x2965,
+	0x4a49, 0x5aab, 0x2965, 0x2965, 0x3166, 0x4007, 0x3186, 0x8009, 0x39a7, 0x632c, 0x39a7, 0x3186,
+	0x3186, 0x3166, 0x2965, 0x5aab, 0x4a49, 0x4003, 0x2965, 0x8003, 0x2945, 0x2945, 0x4a69, 0x4003,
+	0x632c, 0x8009, 0x5acb, 0x31a6, 0x2104, 0x2104, 0x39e7, 0x630c, 0x632c, 0x632c, 0x4a69, 0x4004,
+	0x18c3, 0x8009, 0x18a3, 0x18a3, 0x10a2, 0x1082, 0x0861, 0x0841, 0x0821, 0x0821, 0x0020, 0x4009,
+	0x0000, 0x8002, 0x4208, 0x4a49, 0xc001, 0x0841, 0x001c, 0xc001, 0x39c7, 0x0006, 0x8002, 0x4a49,
+	0x1062, 0x400a, 0x0000, 0x8008, 0x0020, 0x0020, 0x0821, 0x0841, 0x0861, 0x1062, 0x10a2, 0x10a2,
+	0x4003, 0x18a3, 0x4003, 0x18c3, 0x8004, 0x39e7, 0x630c, 0x630c, 0x2124, 0x4004, 0x2104, 0x4004,
+	0x2124, 0x4004, 0x2945, 0x8002, 0x4a29, 0x52aa, 0x4011, 0x2965, 0x8002, 0x52aa, 0x4a49, 0x4004,
+	0x2945, 0x801a, 0x5acb, 0x5acb, 0x3186, 0x2124, 0x2124, 0x4a69, 0x632c, 0x3166, 0x2945, 0x632c,
+	0x3186, 0x18e3, 0x2124, 0x5aab, 0x4a49, 0x18c3, 0x18c3, 0x18a3, 0x10a2, 0x10a2, 0x1082, 0x0861,
+	0x0841, 0x0821, 0x0821, 0x0020, 0x400a, 0x0000, 0x8002, 0x4208, 0x4a49, 0xc001, 0x0841, 0x001c,
+	0xc001, 0x39c7, 0x0006, 0x8002, 0x4a49, 0x1062, 0x400a, 0x0000, 0x4003, 0x0020, 0x8006, 0x0821,
+	0x0841, 0x0861, 0x1062, 0x10a2, 0x10a2, 0x4003, 0x18a3, 0x802e, 0x18c3, 0x18c3, 0x5aab, 0x39e7,
+	0x5aeb, 0x39c7, 0x20e4, 0x20e4, 0x632c, 0x52aa, 0x632c, 0x632c, 0x4a69, 0x2124, 0x2124, 0x52aa,
+	0x632c, 0x632c, 0x52aa, 0x52aa, 0x2945, 0x632c, 0x5aeb, 0x4a69, 0x2945, 0x528a, 0x632c, 0x632c,
+	0x52aa, 0x3166, 0x3186, 0x632c, 0x31a6, 0x31a6, 0x5acb, 0x632c, 0x5aeb, 0x5aeb, 0x4228, 0x2945,
+	0x2945, 0x2925, 0x39e7, 0x630c, 0x2945, 0x2124, 0x4003, 0x2104, 0x8014, 0x4a49, 0x4a69, 0x3186,
+	0x630c, 0x18e3, 0x18e3, 0x18c3, 0x39c7, 0x5acb, 0x18a3, 0x18a3, 0x10a2, 0x10a2, 0x1082, 0x0861,
+	0x0841, 0x0821, 0x0821, 0x0020, 0x0020, 0x400a, 0x0000, 0x8002, 0x4208, 0x4a49, 0xc001, 0x0841,
+	0x001c, 0xc001, 0x39c7, 0x0006, 0x8002, 0x4a49, 0x1062, 0x400b, 0x0000, 0x4003, 0x0020, 0x802f,
+	0x0821, 0x0841, 0x0841, 0x1062, 0x1082, 0x10a2, 0x10a2, 0x18a3, 0x18a3, 0x2945, 0x632c, 0x2124,
+	0x39e7, 0x528a, 0x18e3, 0x20e4, 0x632c, 0x5acb, 0x2124, 0x4208, 0x632c, 0x2945, 0x4208, 0x5aeb,
+	0x2965, 0x3166, 0x5aeb, 0x52aa, 0x2925, 0x632c, 0x528a, 0x2945, 0x4228, 0x5aeb, 0x3186, 0x2945,
+	0x52aa, 0x4a69, 0x3186, 0x632c, 0x3186, 0x52aa, 0x52aa, 0x2945, 0x39c7, 0x632c, 0x4228, 0x4003,
+	0x2124, 0x8002, 0x4228, 0x4a69, 0x4004, 0x2104, 0x8014, 0x20e4, 0x39a7, 0x5aab, 0x2104, 0x5aeb,
+	0x632c, 0x4a49, 0x4a49, 0x2965, 0x18a3, 0x18a3, 0x10a2, 0x10a2, 0x1082, 0x0861, 0x0841, 0x0821,
+	0x0821, 0x0020, 0x0020, 0x400b, 0x0000, 0x8002, 0x4208, 0x4a49, 0xc001, 0x0841, 0x001c, 0xc001,
+	0x39c7, 0x0006, 0x8002, 0x4a49, 0x1062, 0x400c, 0x0000, 0x4003, 0x0020, 0x8035, 0x0821, 0x0841,
+	0x0841, 0x1062, 0x1082, 0x10a2, 0x10a2, 0x18a3, 0x4208, 0x528a, 0x18c3, 0x2104, 0x632c, 0x2124,
+	0x18e3, 0x632c, 0x4208, 0x20e4, 0x3186, 0x632c, 0x2945, 0x52aa, 0x4208, 0x2104, 0x2124, 0x4a49,
+	0x52aa, 0x2124, 0x632c, 0x4208, 0x2925, 0x52aa, 0x4228, 0x2925, 0x2925, 0x39e7, 0x5aeb, 0x3186,
+	0x632c, 0x3186, 0x632c, 0x39a7, 0x2124, 0x2124, 0x5acb, 0x4228, 0x2124, 0x2124, 0x2104, 0x4208,
+	0x4a49, 0x2104, 0x2104, 0x4003, 0x20e4, 0x8012, 0x39c7, 0x5aab, 0x18e3, 0x18c3, 0x2965, 0x4a29,
+	0x4a69, 0x632c, 0x4a69, 0x10a2, 0x1082, 0x1062, 0x0841, 0x0841, 0x0821, 0x0821, 0x0020, 0x0020,
+	0x400c, 0x0000, 0x8002, 0x4208, 0x4a49, 0xc001, 0x0841, 0x001c, 0xc001, 0x39c7, 0x0006, 0x8002,
+	0x4a49, 0x1062, 0x400d, 0x0000, 0x4003, 0x0020, 0x8008, 0x0821, 0x0841, 0x0841, 0x0861, 0x1082,
+	0x10a2, 0x10a2, 0x630c, 0x4004, 0x632c, 0x8021, 0x39e7, 0x18c3, 0x632c, 0x39c7, 0x18e3, 0x3186,
+	0x632c, 0x2945, 0x52aa, 0x4208, 0x2104, 0x2104, 0x4a29, 0x52aa, 0x2124, 0x632c, 0x41e8, 0x2124,
+	0x52aa, 0x4228, 0x2124, 0x2124, 0x39c7, 0x5aeb, 0x2965, 0x632c, 0x2965, 0x632c, 0x39a7, 0x2124,
+	0x2124, 0x5acb, 0x4208, 0x4003, 0x2104, 0x8002, 0x39c7, 0x5aeb, 0x4003, 0x20e4, 0x8013, 0x18e3,
+	0x18e3, 0x4a69, 0x4228, 0x39e7, 0x52aa, 0x18c3, 0x18a3, 0x18a3, 0x2124, 0x632c, 0x1082, 0x0861,
+	0x0841, 0x0841, 0x0821, 0x0821, 0x0020, 0x0020, 0x400d, 0x0000, 0x8002, 0x4208, 0x4a49, 0xc001,
+	0x0841, 0x001c, 0xc001, 0x31a6, 0x0008, 0x8002, 0x4a49, 0x10a2, 0x400f, 0x0000, 0x8047, 0x0020,
+	0x0020, 0x0821, 0x0841, 0x0841, 0x0861, 0x1062, 0x3166, 0x630c, 0x10a2, 0x18a3, 0x18a3, 0x39e7,
+	0x52aa, 0x18c3, 0x632c, 0x39c7, 0x18c3, 0x3186, 0x632c, 0x2925, 0x4208, 0x5aeb, 0x2945, 0x2945,
+	0x5aeb, 0x52aa, 0x2104, 0x632c, 0x39e7, 0x2104, 0x4208, 0x5aeb, 0x2945, 0x2104, 0x5acb, 0x4a69,
+	0x2965, 0x632c, 0x2945, 0x52aa, 0x52aa, 0x2104, 0x31a6, 0x632c, 0x4208, 0x2104, 0x2104, 0x20e4,
+	0x20e4, 0x5aab, 0x5aab, 0x2925, 0x18e3, 0x18e3, 0x4a69, 0x630c, 0x2104, 0x2104, 0x632c, 0x39e7,
+	0x18a3, 0x10a2, 0x4228, 0x630c, 0x0861, 0x0841, 0x0841, 0x0821, 0x0020, 0x0020, 0x400f, 0x0000,
+	0x8002, 0x4228, 0x4a49, 0xc001, 0x0020, 0x001d, 0xc001, 0x2965, 0x000b, 0x8002, 0x4a49, 0x18c3,
+	0x4010, 0x0000, 0x802d, 0x0020, 0x0020, 0x0821, 0x0821, 0x0841, 0x0841, 0x4a49, 0x41e8, 0x10a2,
+	0x10a2, 0x18a3, 0x18c3, 0x632c, 0x2945, 0x632c, 0x39c7, 0x18c3, 0x3166, 0x632c, 0x2124, 0x18e3,
+	0x528a, 0x632c, 0x630c, 0x52aa, 0x52aa, 0x2104, 0x632c, 0x39e7, 0x2104, 0x2104, 0x52aa, 0x632c,
+	0x632c, 0x52aa, 0x2124, 0x2945, 0x632c, 0x2945, 0x2945, 0x5acb, 0x632c, 0x5acb, 0x5aeb, 0x4208,
+	0x4003, 0x20e4, 0x8003, 0x18e3, 0x2104, 0x4a49, 0x4003, 0x632c, 0x800f, 0x528a, 0x2104, 0x18c3,
+	0x18a3, 0x39a7, 0x5acb, 0x632c, 0x632c, 0x52aa, 0x20e4, 0x0841, 0x0821, 0x0821, 0x0020, 0x0020,
+	0x4010, 0x0000, 0x8002, 0x4a49, 0x4a49, 0xc001, 0x0000, 0x001f, 0xc001, 0x2104, 0x0011, 0x8002,
+	0x4a49, 0x2945, 0x4011, 0x0000, 0x4003, 0x0020, 0x8008, 0x0821, 0x0841, 0x0841, 0x0861, 0x1062,
+	0x1082, 0x10a2, 0x10a2, 0x4003, 0x18a3, 0x4007, 0x18c3, 0x4006, 0x18e3, 0x4010, 0x20e4, 0x4003,
+	0x18e3, 0x4008, 0x18c3, 0x4003, 0x18a3, 0x800a, 0x10a2, 0x1082, 0x1082, 0x0861, 0x0841, 0x0841,
+	0x0821, 0x0821, 0x0020, 0x0020, 0x4010, 0x0000, 0x8002, 0x1082, 0x4a49, 0xc001, 0x39c7, 0x0007,
+	0x0001, 0xc001, 0x1082, 0x0018, 0x8002, 0x4a49, 0x41e8, 0x4012, 0x0000, 0x4003, 0x0020, 0x8001,
+	0x0821, 0x4003, 0x0841, 0x8005, 0x0861, 0x1082, 0x1082, 0x10a2, 0x10a2, 0x4003, 0x18a3, 0x400a,
+	0x18c3, 0x4005, 0x18e3, 0x4005, 0x20e4, 0x4005, 0x18e3, 0x400b, 0x18c3, 0x4003, 0x18a3, 0x8004,
+	0x10a2, 0x10a2, 0x1082, 0x0861, 0x4003, 0x0841, 0x8001, 0x0821, 0x4003, 0x0020, 0x4011, 0x0000,
+	0x8002, 0x2124, 0x4a49, 0xc001, 0x2945, 0x000e, 0x0001, 0x0001, 0xc001, 0x31a6, 0x0008, 0x8002,
+	0x4a49, 0x10a2, 0x4013, 0x0000, 0x4003, 0x0020, 0x8009, 0x0821, 0x0841, 0x0841, 0x0861, 0x1062,
+	0x1082, 0x1082, 0x10a2, 0x10a2, 0x4004, 0x18a3, 0x401e, 0x18c3, 0x4003, 0x18a3, 0x4003, 0x10a2,
+	0x8009, 0x1082, 0x1062, 0x0861, 0x0841, 0x0841, 0x0821, 0x0821, 0x0020, 0x0020, 0x4012, 0x0000,
+	0x8003, 0x0020, 0x4228, 0x4a49, 0xc001, 0x1082, 0x0018, 0x0001, 0x0001, 0xc001, 0x2124, 0x0010,
+	0x8002, 0x4a49, 0x39e7, 0x4014, 0x0000, 0x4003, 0x0020, 0x800a, 0x0821, 0x0821, 0x0841, 0x0841,
+	0x0861, 0x0861, 0x1062, 0x1082, 0x10a2, 0x10a2, 0x4006, 0x18a3, 0x4017, 0x18c3, 0x4004, 0x18a3,
+	0x800a, 0x10a2, 0x10a2, 0x1082, 0x1082, 0x0861, 0x0861, 0x0841, 0x0841, 0x0821, 0x0821, 0x4003,
+	0x0020, 0x4013, 0x0000, 0x8002, 0x2124, 0x4a49, 0xc001, 0x3186, 0x0009, 0x0002, 0x0002, 0xc001,
+	0x39c7, 0x0007, 0x8002, 0x4a49, 0x2945, 0x4015, 0x0000, 0x4003, 0x0020, 0x8002, 0x0821, 0x0821,
+	0x4003, 0x0841, 0x8006, 0x0861, 0x1062, 0x1082, 0x1082, 0x10a2, 0x10a2, 0x4009, 0x18a3, 0x400c,
+	0x18c3, 0x4006, 0x18a3, 0x4003, 0x10a2, 0x8003, 0x1082, 0x1082, 0x0861, 0x4003, 0x0841, 0x8002,
+	0x0821, 0x0821, 0x4003, 0x0020, 0x4014, 0x0000, 0x8003, 0x1082, 0x4a49, 0x4a49, 0xc001, 0x1082,
+	0x0018, 0x0002, 0x0002, 0xc001, 0x0861, 0x0019, 0x8003, 0x4a49, 0x4a49, 0x2104, 0x4016, 0x0000,
+	0x4003, 0x0020, 0x8002, 0x0821, 0x0821, 0x4003, 0x0841, 0x8002, 0x0861, 0x0861, 0x4003, 0x1082,
+	0x4004, 0x10a2, 0x4011, 0x18a3, 0x4004, 0x10a2, 0x4003, 0x1082, 0x8002, 0x0861, 0x0861, 0x4003,
+	0x0841, 0x8002, 0x0821, 0x0821, 0x4003, 0x0020, 0x4015, 0x0000, 0x8003, 0x1062, 0x4228, 0x4a49,
+	0xc001, 0x2965, 0x000c, 0x0003, 0x0003, 0xc001, 0x18c3, 0x0015, 0x8004, 0x4a49, 0x4a49, 0x2965,
+	0x0020, 0x4016, 0x0000, 0x4003, 0x0020, 0x4003, 0x0821, 0x4003, 0x0841, 0x8003, 0x0861, 0x0861,
+	0x1062, 0x4004, 0x1082, 0x4010, 0x10a2, 0x4003, 0x1082, 0x8003, 0x1062, 0x0861, 0x0861, 0x4003,
+	0x0841, 0x4003, 0x0821, 0x4003, 0x0020, 0x4016, 0x0000, 0x8003, 0x18c3, 0x4a49, 0x4a49, 0xc001,
+	0x2965, 0x000b, 0x0004, 0x0004, 0xc001, 0x18c3, 0x0015, 0x8005, 0x4a49, 0x4a49, 0x4228, 0x20e4,
+	0x0821, 0x4016, 0x0000, 0x4003, 0x0020, 0x4004, 0x0821, 0x4004, 0x0841, 0x4003, 0x0861, 0x8002,
+	0x1062, 0x1062, 0x400b, 0x1082, 0x8002, 0x1062, 0x1062, 0x4003, 0x0861, 0x4004, 0x0841, 0x4004,
+	0x0821, 0x4003, 0x0020, 0x4016, 0x0000, 0x8004, 0x10a2, 0x39c7, 0x4a49, 0x4a49, 0xc001, 0x2965,
+	0x000c, 0x0005, 0x0005, 0xc002, 0x0861, 0x001a, 0x3186, 0x0009, 0x4003, 0x4a49, 0x8003, 0x31a6,
+	0x2965, 0x2124, 0x4011, 0x20e4, 0x4010, 0x2104, 0x4010, 0x2124, 0x400f, 0x2104, 0x4010, 0x20e4,
+	0x8006, 0x2104, 0x2965, 0x3186, 0x4228, 0x4a49, 0x4a49, 0xc002, 0x39c7, 0x0006, 0x18e3, 0x0013,
+	0x0006, 0x0007, 0xc003, 0x18c3, 0x0014, 0x3186, 0x000a, 0x4208, 0x0002, 0x4057, 0x4a49, 0xc002,
+	0x31a6, 0x0008, 0x2124, 0x0010, 0x0008, 0x0009, 0xc058, 0x0020, 0x001e, 0x10a2, 0x0017, 0x18e3,
+	0x0013, 0x2124, 0x0010, 0x2945, 0x000d, 0x2945, 0x000d, 0x2945, 0x000d, 0x2945, 0x000d, 0x2945,
+	0x000d, 0x2945, 0x000d, 0x2945, 0x000d, 0x2945, 0x000d, 0x2945, 0x000d, 0x2945, 0x000d, 0x2945,
+	0x000d, 0x2945, 0x000d, 0x2945, 0x000d, 0x2945, 0x000d, 0x2945, 0x000d, 0x2945, 0x000d, 0x2945,
+	0x000d, 0x2945, 0x000d, 0x2945, 0x000d, 0x2945, 0x000d, 0x2945, 0x000d, 0x2945, 0x000d, 0x2945,
+	0x000d, 0x2945, 0x000d, 0x2945, 0x000d, 0x2945, 0x000d, 0x2945, 0x000d, 0x2945, 0x000d, 0x2945,
+	0x000d, 0x2945, 0x000d, 0x2945, 0x000d, 0x2945, 0x000d, 0x2945, 0x000d, 0x2945, 0x000d, 0x2945,
+	0x000d, 0x2945, 0x000d, 0x2945, 0x000d, 0x2945, 0x000d, 0x2945, 0x000d, 0x2945, 0x000d, 0x2945,
+	0x000d, 0x2945, 0x000d, 0x2945, 0x000d, 0x2945, 0x000d, 0x2945, 0x000d, 0x2945, 0x000d, 0x2945,
+	0x000d, 0x2945, 0x000d, 0x2945, 0x000d, 0x2945, 0x000d, 0x2945, 0x000d, 0x2945, 0x000d, 0x2945,
+	0x000d, 0x2945, 0x000d, 0x2945, 0x000d, 0x2945, 0x000d, 0x2945, 0x000d, 0x2945, 0x000d, 0x2945,
+	0x000d, 0x2945, 0x000d, 0x2945, 0x000d, 0x2945, 0x000d, 0x2945, 0x000d, 0x2945, 0x000d, 0x2945,
+	0x000d, 0x2945, 0x000d, 0x2945, 0x000d, 0x2945, 0x000d, 0x2945, 0x000d, 0x2945, 0x000d, 0x2945,
+	0x000d, 0x2945, 0x000d, 0x2945, 0x000d, 0x2945, 0x000d, 0x2945, 0x000d, 0x2945, 0x000d, 0x2945,
+	0x000d, 0x2945, 0x000d, 0x2945, 0x000d, 0x2945, 0x000d, 0x2945, 0x000e, 0x18e3, 0x0013, 0x18c3,
+	0x0015, 0x0020, 0x001d, 0x000a,
+};
+
+const int dataAndroidOSSelectedRLE_width = 107;
+const int dataAndroidOSSelectedRLE_height = 107;
@@ -0,0 +1,232 @@
+const uint16_t dataConsoleRLE[] = {
+	0x406a, 0x0000, 0x406a, 0x0000, 0x406a, 0x0000, 0x406a, 0x0000, 0x406a, 0x0000, 0x406a, 0x0000,
+	0x406a, 0x0000, 0x4038, 0x0000, 0x8005, 0x0020, 0x0020, 0x0000, 0x0020, 0x0821, 0x402d, 0x0000,
+	0x4035, 0x0000, 0x800b, 0x0841, 0x0821, 0x0000, 0x18a3, 0x0841, 0x0000, 0x18a3, 0x0841, 0x0000,
+	0x0841, 0x0841, 0x402a, 0x0000, 0x4032, 0x0000, 0x8011, 0x1082, 0x1082, 0x0000, 0x2925, 0x0821,
+	0x0841, 0x39c7, 0x0000, 0x1082, 0x39e7, 0x0000, 0x0020, 0x31a6, 0x0821, 0x0000, 0x1082, 0x1082,
+	0x4027, 0x0000, 0x402f, 0x0000, 0x8017, 0x0841, 0x18c3, 0x0000, 0x39a7, 0x1062, 0x10a2, 0x4208,
+	0x0000, 0x39c7, 0x39c7, 0x0000, 0x4a49, 0x2124, 0x0000, 0x39e7, 0x3186, 0x0000, 0x1082, 0x39e7,
+	0x0020, 0x0000, 0x0861, 0x1082, 0x4024, 0x0000, 0x402d, 0x0000, 0x801c, 0x20e4, 0x0000, 0x2925,
+	0x2945, 0x0821, 0x52aa, 0x0000, 0x4a29, 0x39e7, 0x1062, 0x6b2d, 0x10a2, 0x2945, 0x630c, 0x0000,
+	0x2945, 0x630c, 0x0020, 0x0861, 0x5acb, 0x18c3, 0x0000, 0x1082, 0x39e7, 0x0821, 0x0000, 0x0000,
+	0x0020, 0x4021, 0x0000, 0x402a, 0x0000, 0x801f, 0x0841, 0x0841, 0x0000, 0x4208, 0x0000, 0x4a69,
+	0x2945, 0x2945, 0x5acb, 0x10a2, 0x6b2d, 0x2945, 0x4a49, 0x5aeb, 0x10a2, 0x632c, 0x39e7, 0x10a2,
+	0x6b4d, 0x39c7, 0x0020, 0x5acb, 0x4a69, 0x0000, 0x10a2, 0x5acb, 0x18c3, 0x0000, 0x0000, 0x2925,
+	0x10a2, 0x4021, 0x0000, 0x4028, 0x0000, 0x8020, 0x0821, 0x0000, 0x2104, 0x20e4, 0x0841, 0x5acb,
+	0x1062, 0x632c, 0x2965, 0x528a, 0x528a, 0x4208, 0x6b4d, 0x4208, 0x6b4d, 0x4a49, 0x4a69, 0x6b4d,
+	0x2965, 0x5aeb, 0x632c, 0x10a2, 0x528a, 0x6b4d, 0x0841, 0x18c3, 0x632c, 0x39c7, 0x0000, 0x0020,
+	0x4228, 0x3186, 0x4003, 0x0000, 0x8001, 0x0020, 0x401e, 0x0000, 0x4028, 0x0000, 0x801f, 0x2945,
+	0x0000, 0x39c7, 0x39c7, 0x2104, 0x6b4d, 0x3186, 0x6b6d, 0x4a69, 0x6b6d, 0x630c, 0x6b2d, 0x6b4d,
+	0x6b2d, 0x6b6d, 0x632c, 0x6b6d, 0x632c, 0x5acb, 0x6b6d, 0x528a, 0x4a69, 0x6b6d, 0x39c7, 0x18e3,
+	0x6b4d, 0x5aeb, 0x0000, 0x10a2, 0x5acb, 0x4a69, 0x4003, 0x0000, 0x8002, 0x2945, 0x1082, 0x401e,
+	0x0000, 0x4026, 0x0000, 0x8009, 0x1082, 0x0000, 0x4a49, 0x1082, 0x4a69, 0x52aa, 0x4a29, 0x738e,
+	0x630c, 0x400d, 0x738e, 0x800f, 0x6b4d, 0x738e, 0x630c, 0x31a6, 0x6b6d, 0x6b6d, 0x18a3, 0x2124,
+	0x6b4d, 0x630c, 0x0821, 0x0000, 0x18c3, 0x528a, 0x2925, 0x401f, 0x0000, 0x4026, 0x0000, 0x8007,
+	0x4228, 0x0020, 0x5aeb, 0x39e7, 0x5aeb, 0x6b6d, 0x6b4d, 0x4011, 0x738e, 0x800c, 0x6b4d, 0x738e,
+	0x738e, 0x4228, 0x39e7, 0x738e, 0x6b6d, 0x1082, 0x0020, 0x39c7, 0x6b6d, 0x2965, 0x4003, 0x0000,
+	0x8002, 0x1082, 0x0020, 0x401b, 0x0000, 0x4023, 0x0000, 0x8008, 0x0020, 0x2104, 0x0000, 0x5aeb,
+	0x2945, 0x630c, 0x6b4d, 0x6b6d, 0x4006, 0x73ae, 0x8005, 0x738e, 0x6b6d, 0x6b4d, 0x6b6d, 0x738e,
+	0x400a, 0x73ae, 0x800e, 0x738e, 0x630c, 0x73ae, 0x73ae, 0x2925, 0x18c3, 0x62ec, 0x73ae, 0x3186,
+	0x0000, 0x0000, 0x10a2, 0x4208, 0x2124, 0x401c, 0x0000, 0x4024, 0x0000, 0x8005, 0x528a, 0x1082,
+	0x630c, 0x632c, 0x6b6d, 0x4004, 0x73ae, 0x8005, 0x6b2d, 0x4a49, 0x2965, 0x18c3, 0x1062, 0x4003,
+	0x0841, 0x8005, 0x1062, 0x18e3, 0x31a6, 0x5aab, 0x738e, 0x4009, 0x73ae, 0x800a, 0x4a69, 0x4228,
+	0x73ae, 0x73ae, 0x39c7, 0x0000, 0x0861, 0x4228, 0x6b4d, 0x2124, 0x401d, 0x0000, 0x4022, 0x0000,
+	0x8005, 0x2945, 0x0000, 0x5acb, 0x52aa, 0x630c, 0x4003, 0x7bcf, 0x8004, 0x738e, 0x4a49, 0x18e3,
+	0x0821, 0x400b, 0x0000, 0x8003, 0x1082, 0x4208, 0x738e, 0x4006, 0x7bcf, 0x800a, 0x73ae, 0x6b6d,
+	0x7bcf, 0x7bcf, 0x41e8, 0x0841, 0x41e8, 0x738e, 0x738e, 0x18c3, 0x4003, 0x0000, 0x8002, 0x0841,
+	0x0861, 0x4019, 0x0000, 0x4022, 0x0000, 0x8009, 0x4a69, 0x31a6, 0x4a69, 0x7bcf, 0x73ae, 0x7bcf,
+	0x7bcf, 0x4a49, 0x1082, 0x4004, 0x0000, 0x8007, 0x0821, 0x1082, 0x1082, 0x20e4, 0x1082, 0x1082,
+	0x0841, 0x4005, 0x0000, 0x8002, 0x1082, 0x52aa, 0x4008, 0x7bcf, 0x800c, 0x528a, 0x39c7, 0x6b6d,
+	0x7bcf, 0x6b4d, 0x1082, 0x0000, 0x0000, 0x10a2, 0x4a49, 0x39c7, 0x0841, 0x4019, 0x0000, 0x4020,
+	0x0000, 0x8009, 0x2945, 0x0861, 0x39c7, 0x73ae, 0x632c, 0x7bef, 0x7bef, 0x6b4d, 0x2124, 0x4003,
+	0x0000, 0x800e, 0x0861, 0x2124, 0x39a7, 0x52aa, 0x62ec, 0x632c, 0x6b2d, 0x632c, 0x528a, 0x528a,
+	0x2124, 0x2965, 0x0000, 0x0821, 0x4003, 0x0000, 0x8001, 0x39e7, 0x4006, 0x7bef, 0x800b, 0x7bcf,
+	0x6b6d, 0x7bef, 0x7bef, 0x630c, 0x0841, 0x0000, 0x2945, 0x52aa, 0x738e, 0x39c7, 0x401b, 0x0000,
+	0x4020, 0x0000, 0x8003, 0x3186, 0x630c, 0x39a7, 0x4003, 0x7bef, 0x8008, 0x52aa, 0x0841, 0x0000,
+	0x0000, 0x0841, 0x2965, 0x632c, 0x73ae, 0x4007, 0x7bef, 0x8006, 0x7bcf, 0x7bcf, 0x52aa, 0x4a69,
+	0x1082, 0x0821, 0x4003, 0x0000, 0x8001, 0x3186, 0x4008, 0x7bef, 0x8007, 0x5aeb, 0x20e4, 0x39c7,
+	0x6b4d, 0x7bef, 0x738e, 0x2104, 0x401c, 0x0000, 0x401e, 0x0000, 0x800d, 0x18a3, 0x2965, 0x1082,
+	0x8410, 0x73ae, 0x8410, 0x8410, 0x4208, 0x0000, 0x0000, 0x0020, 0x2945, 0x5aeb, 0x400d, 0x8410,
+	0x8008, 0x73ae, 0x4a49, 0x4228, 0x0000, 0x0020, 0x0000, 0x0000, 0x31a6, 0x4006, 0x8410, 0x8007,
+	0x7bcf, 0x5aeb, 0x7bcf, 0x8410, 0x8410, 0x5acb, 0x0861, 0x4003, 0x0000, 0x8003, 0x18a3, 0x2965,
+	0x1082, 0x4017, 0x0000, 0x401f, 0x0000, 0x800b, 0x738e, 0x4a49, 0x738e, 0x8410, 0x8410, 0x39e7,
+	0x0000, 0x0000, 0x1062, 0x528a, 0x7bcf, 0x4010, 0x8410, 0x8003, 0x4a69, 0x4a69, 0x18a3, 0x4003,
+	0x0000, 0x8001, 0x4a49, 0x4008, 0x8410, 0x8009, 0x7bef, 0x39e7, 0x0000, 0x0000, 0x18c3, 0x39c7,
+	0x630c, 0x630c, 0x2925, 0x4018, 0x0000, 0x401d, 0x0000, 0x8003, 0x3186, 0x0861, 0x4208, 0x4003,
+	0x8430, 0x8005, 0x39c7, 0x0000, 0x0000, 0x18c3, 0x6b6d, 0x4013, 0x8430, 0x8003, 0x738e, 0x18e3,
+	0x2124, 0x4003, 0x0000, 0x8001, 0x6b6d, 0x4006, 0x8430, 0x8009, 0x738e, 0x3186, 0x2104, 0x4a69,
+	0x738e, 0x8430, 0x8410, 0x4208, 0x0020, 0x4019, 0x0000, 0x401d, 0x0000, 0x800a, 0x39c7, 0x7bef,
+	0x52aa, 0x8430, 0x8c51, 0x4a49, 0x0000, 0x0000, 0x18a3, 0x7bcf, 0x4014, 0x8c51, 0x8003, 0x8410,
+	0x8430, 0x2124, 0x4003, 0x0000, 0x8002, 0x2104, 0x8430, 0x4004, 0x8c51, 0x8003, 0x8430, 0x738e,
+	0x7bcf, 0x4003, 0x8c51, 0x8002, 0x630c, 0x10a2, 0x401b, 0x0000, 0x401b, 0x0000, 0x800b, 0x1082,
+	0x3186, 0x0821, 0x73ae, 0x8c51, 0x8c51, 0x630c, 0x0000, 0x0000, 0x1082, 0x73ae, 0x4016, 0x8c51,
+	0x8007, 0x7bcf, 0x4a29, 0x4a69, 0x0020, 0x0000, 0x0000, 0x630c, 0x4008, 0x8c51, 0x8002, 0x7bcf,
+	0x2965, 0x4004, 0x0000, 0x8004, 0x1062, 0x2124, 0x2124, 0x0821, 0x4015, 0x0000, 0x401c, 0x0000,
+	0x8009, 0x630c, 0x6b6d, 0x738e, 0x8c71, 0x7bef, 0x1062, 0x0000, 0x0841, 0x6b6d, 0x4019, 0x8c71,
+	0x8001, 0x2945, 0x4003, 0x0000, 0x8002, 0x20e4, 0x8c51, 0x4005, 0x8c71, 0x800b, 0x8430, 0x4a69,
+	0x18a3, 0x10a2, 0x3186, 0x4a69, 0x630c, 0x73ae, 0x738e, 0x4208, 0x10a2, 0x4016, 0x0000, 0x401a,
+	0x0000, 0x800a, 0x18c3, 0x18c3, 0x18a3, 0x8c51, 0x8c71, 0x8c71, 0x2965, 0x0000, 0x0000, 0x5aab,
+	0x4019, 0x8c71, 0x8007, 0x8410, 0x5acb, 0x52aa, 0x0841, 0x0000, 0x0000, 0x738e, 0x4005, 0x8c71,
+	0x8003, 0x7bef, 0x6b4d, 0x7bef, 0x4003, 0x8c71, 0x8003, 0x8430, 0x4228, 0x1062, 0x4018, 0x0000,
+	0x401a, 0x0000, 0x800a, 0x1082, 0x7bef, 0x632c, 0x7bef, 0x9492, 0x630c, 0x0000, 0x0000, 0x3186,
+	0x8c71, 0x401a, 0x9492, 0x8002, 0x8c71, 0x2945, 0x4003, 0x0000, 0x8001, 0x4208, 0x4009, 0x9492,
+	0x8003, 0x8410, 0x4a49, 0x0861, 0x401a, 0x0000, 0x4019, 0x0000, 0x800a, 0x1082, 0x0000, 0x2965,
+	0x9492, 0x9492, 0x8c51, 0x18a3, 0x0000, 0x18a3, 0x7bef, 0x401b, 0x9492, 0x8007, 0x7bef, 0x4a49,
+	0x39a7, 0x0000, 0x0000, 0x18a3, 0x8c71, 0x4006, 0x9492, 0x8003, 0x7bef, 0x4a29, 0x0821, 0x4004,
+	0x0000, 0x8004, 0x0020, 0x1082, 0x18a3, 0x0821, 0x4014, 0x0000, 0x4019, 0x0000, 0x8009, 0x2945,
+	0x7bcf, 0x630c, 0x8430, 0x94b2, 0x4a69, 0x0000, 0x0000, 0x528a, 0x401d, 0x94b2, 0x8002, 0x8430,
+	0x2104, 0x4003, 0x0000, 0x8001, 0x7bef, 0x4005, 0x94b2, 0x800c, 0x7bcf, 0x4228, 0x39c7, 0x4a49,
+	0x5acb, 0x630c, 0x738e, 0x7bef, 0x7bcf, 0x5aeb, 0x3186, 0x0841, 0x4014, 0x0000, 0x401a, 0x0000,
+	0x8008, 0x31a6, 0x94b2, 0x94b2, 0x8c71, 0x1082, 0x0000, 0x1082, 0x8430, 0x401d, 0x94b2, 0x8006,
+	0x528a, 0x18c3, 0x1062, 0x0000, 0x0000, 0x6b2d, 0x400b, 0x94b2, 0x8003, 0x8430, 0x52aa, 0x18c3,
+	0x4017, 0x0000, 0x4018, 0x0000, 0x8009, 0x2945, 0x6b4d, 0x5aeb, 0x8430, 0x9cd3, 0x528a, 0x0000,
+	0x0000, 0x4a69, 0x401f, 0x9cd3, 0x8005, 0x8c71, 0x2124, 0x0000, 0x0000, 0x4a49, 0x4008, 0x9cd3,
+	0x8004, 0x8c71, 0x630c, 0x2945, 0x0020, 0x4019, 0x0000, 0x4019, 0x0000, 0x8008, 0x4228, 0x9cf3,
+	0x9cf3, 0x9cd3, 0x18e3, 0x0000, 0x0861, 0x8c51, 0x401e, 0x9cf3, 0x8002, 0x8c51, 0x18a3, 0x4003,
+	0x0000, 0x8001, 0x3186, 0x4005, 0x9cf3, 0x8004, 0x94d2, 0x73ae, 0x39c7, 0x0841, 0x401c, 0x0000,
+	0x4017, 0x0000, 0x800a, 0x18c3, 0x4a49, 0x4a49, 0x8410, 0x9cf3, 0x738e, 0x0000, 0x0000, 0x39c7,
+	0x9cd3, 0x401e, 0x9cf3, 0x8006, 0x94b2, 0x7bcf, 0x4228, 0x0000, 0x0000, 0x2104, 0x4005, 0x9cf3,
+	0x800c, 0x94b2, 0x73ae, 0x6b4d, 0x6b4d, 0x6b2d, 0x5aeb, 0x528a, 0x4a69, 0x4a49, 0x4228, 0x31a6,
+	0x18c3, 0x4014, 0x0000, 0x4017, 0x0000, 0x8009, 0x0821, 0x4a69, 0x9cd3, 0x9d13, 0x9d13, 0x4208,
+	0x0000, 0x0000, 0x632c, 0x401f, 0x9d13, 0x8007, 0x9cf3, 0x73ae, 0x2945, 0x0000, 0x0000, 0x18c3,
+	0x9cf3, 0x400b, 0x9d13, 0x8005, 0x94b2, 0x738e, 0x528a, 0x3166, 0x1062, 0x4014, 0x0000, 0x4016,
+	0x0000, 0x800a, 0x0821, 0x2124, 0x31a6, 0x6b6d, 0xa514, 0x9cf3, 0x18c3, 0x0000, 0x1082, 0x8c71,
+	0x401f, 0xa514, 0x8002, 0x94b2, 0x3186, 0x4003, 0x0000, 0x8002, 0x18a3, 0x9cf3, 0x4006, 0xa514,
+	0x8006, 0x9cf3, 0x8c51, 0x632c, 0x4a29, 0x2124, 0x0841, 0x4018, 0x0000, 0x4016, 0x0000, 0x800a,
+	0x0020, 0x4a69, 0x94b2, 0xa534, 0xa534, 0x7bef, 0x0000, 0x0000, 0x2965, 0xa514, 0x4021, 0xa534,
+	0x8005, 0x52aa, 0x0000, 0x0000, 0x18c3, 0xa514, 0x4004, 0xa534, 0x8004, 0x9cf3, 0x6b6d, 0x3186,
+	0x0821, 0x401c, 0x0000, 0x4016, 0x0000, 0x8009, 0x0841, 0x1082, 0x39e7, 0x9cd3, 0xa534, 0x52aa,
+	0x0000, 0x0000, 0x4a69, 0x4020, 0xa534, 0x8006, 0x9cd3, 0x4208, 0x0841, 0x0000, 0x0000, 0x2104,
+	0x4006, 0xa534, 0x8009, 0x9d13, 0x94b2, 0x8430, 0x6b6d, 0x4a69, 0x3186, 0x18e3, 0x1062, 0x0020,
+	0x4016, 0x0000, 0x4016, 0x0000, 0x8009, 0x31a6, 0x8410, 0xa534, 0xad55, 0xad55, 0x39c7, 0x0000,
+	0x0000, 0x630c, 0x4020, 0xad55, 0x8006, 0x9cf3, 0x4228, 0x0861, 0x0000, 0x0000, 0x3186, 0x400d,
+	0xad55, 0x8004, 0x94b2, 0x73ae, 0x4a69, 0x18e3, 0x4014, 0x0000, 0x4017, 0x0000, 0x8008, 0x18c3,
+	0x738e, 0xad55, 0xad55, 0x2104, 0x0000, 0x0000, 0x738e, 0x4021, 0xad55, 0x8005, 0x9cf3, 0x39c7,
+	0x0000, 0x0000, 0x4a69, 0x4005, 0xad55, 0x800c, 0xa534, 0x9cf3, 0x94b2, 0x8430, 0x738e, 0x52aa,
+	0x41e8, 0x2945, 0x18c3, 0x1082, 0x0841, 0x0020, 0x4014, 0x0000, 0x4015, 0x0000, 0x800a, 0x0861,
+	0x630c, 0x9cd3, 0xad75, 0xad75, 0x9cf3, 0x0841, 0x0000, 0x0841, 0x8c51, 0x401f, 0xad75, 0x8003,
+	0xad55, 0x5aab, 0x0020, 0x4003, 0x0000, 0x8001, 0x6b6d, 0x4005, 0xad75, 0x8003, 0x94b2, 0x52aa,
+	0x18e3, 0x401d, 0x0000, 0x4016, 0x0000, 0x8009, 0x0841, 0x3186, 0x94b2, 0xad75, 0x8c71, 0x0000,
+	0x0000, 0x0841, 0x8c71, 0x4020, 0xad75, 0x8006, 0xa554, 0x4a69, 0x0020, 0x0000, 0x0000, 0x8c71,
+	0x4007, 0xad75, 0x8004, 0xa514, 0x8430, 0x528a, 0x20e4, 0x401a, 0x0000, 0x4015, 0x0000, 0x800a,
+	0x10a2, 0x5aeb, 0x9cf3, 0xb596, 0xb596, 0x8410, 0x0000, 0x0000, 0x0841, 0x9492, 0x401f, 0xb596,
+	0x8007, 0xa534, 0x8410, 0x5aab, 0x0841, 0x0000, 0x1082, 0xa554, 0x400b, 0xb596, 0x8004, 0x9492,
+	0x6b4d, 0x39c7, 0x1082, 0x4016, 0x0000, 0x4015, 0x0000, 0x800a, 0x18c3, 0x4208, 0x632c, 0xad55,
+	0xb596, 0x7bcf, 0x0000, 0x0000, 0x0861, 0x8c71, 0x401f, 0xb596, 0x8002, 0x9492, 0x0020, 0x4003,
+	0x0000, 0x8001, 0x41e8, 0x4005, 0xb596, 0x8001, 0x9cf3, 0x4004, 0x8410, 0x8007, 0x7bef, 0x7bef,
+	0x8410, 0x8410, 0x7bcf, 0x5acb, 0x2124, 0x4015, 0x0000, 0x4015, 0x0000, 0x8006, 0x0020, 0x41e8,
+	0x94d2, 0xb5b6, 0xb5b6, 0x7bcf, 0x4003, 0x0000, 0x8001, 0x7bef, 0x4020, 0xb5b6, 0x8005, 0x8410,
+	0x0841, 0x0000, 0x0000, 0x7bef, 0x4005, 0xb5b6, 0x8003, 0xa534, 0x630c, 0x18e3, 0x401e, 0x0000,
+	0x4015, 0x0000, 0x8006, 0x39e7, 0x73ae, 0x7bcf, 0xad75, 0xb5b6, 0x8410, 0x4003, 0x0000, 0x8001,
+	0x73ae, 0x401e, 0xb5b6, 0x8007, 0x9cf3, 0x4a69, 0x39a7, 0x0841, 0x0000, 0x0861, 0xad55, 0x4007,
+	0xb5b6, 0x8003, 0xb596, 0x7bcf, 0x2945, 0x401c, 0x0000, 0x4016, 0x0000, 0x8005, 0x0841, 0x7bef,
+	0xb5d6, 0xbdd7, 0x9492, 0x4003, 0x0000, 0x8001, 0x5acb, 0x401e, 0xbdd7, 0x8002, 0xb596, 0x2124,
+	0x4003, 0x0000, 0x8001, 0x4a49, 0x400b, 0xbdd7, 0x8002, 0x8c71, 0x39a7, 0x401a, 0x0000, 0x4015,
+	0x0000, 0x800b, 0x2945, 0x94b2, 0xa514, 0xad75, 0xbdf7, 0xad55, 0x0841, 0x0000, 0x0000, 0x39e7,
+	0xb596, 0x401c, 0xbdf7, 0x8007, 0xb596, 0xad75, 0x8c71, 0x0841, 0x0000, 0x0000, 0x94d2, 0x4005,
+	0xbdf7, 0x800b, 0x9492, 0x6b4d, 0x8410, 0x94d2, 0xad55, 0xb596, 0xbdf7, 0xbdf7, 0x9cf3, 0x52aa,
+	0x10a2, 0x4017, 0x0000, 0x4015, 0x0000, 0x800b, 0x18c3, 0x1062, 0x4a69, 0xb5b6, 0xbdf7, 0xbdf7,
+	0x2104, 0x0000, 0x0000, 0x18e3, 0xad75, 0x401c, 0xbdf7, 0x8006, 0x8c51, 0x0821, 0x0841, 0x0000,
+	0x0000, 0x39a7, 0x4006, 0xbdf7, 0x800c, 0xb5b6, 0x738e, 0x0861, 0x0000, 0x0841, 0x10a2, 0x20e4,
+	0x2945, 0x4228, 0x5aeb, 0x52aa, 0x2104, 0x4016, 0x0000, 0x4016, 0x0000, 0x800b, 0x630c, 0xbdf7,
+	0xb596, 0xbe17, 0xbe17, 0x4208, 0x0000, 0x0000, 0x0020, 0x7bcf, 0xbdf7, 0x4019, 0xbe17, 0x8004,
+	0xbdf7, 0xbe17, 0xbe17, 0x3186, 0x4003, 0x0000, 0x8001, 0x94b2, 0x4008, 0xbe17, 0x8002, 0xad55,
+	0x4a69, 0x401e, 0x0000, 0x4015, 0x0000, 0x8007, 0x2945, 0x528a, 0x31a6, 0x9cf3, 0xc618, 0xc618,
+	0x6b6d, 0x4003, 0x0000, 0x8001, 0x39e7, 0x401a, 0xc618, 0x8007, 0xbe17, 0x4a69, 0x39e7, 0x2945,
+	0x0000, 0x0000, 0x4228, 0x4005, 0xc618, 0x8002, 0xbdd7, 0xbe17, 0x4004, 0xc618, 0x8002, 0x8c71,
+	0x2925, 0x401c, 0x0000, 0x4017, 0x0000, 0x800a, 0x9492, 0xc638, 0xc618, 0xc638, 0xa554, 0x0821,
+	0x0000, 0x0000, 0x18a3, 0x8c71, 0x4018, 0xc638, 0x8003, 0xc618, 0xc638, 0x738e, 0x4003, 0x0000,
+	0x8002, 0x1082, 0xb596, 0x4005, 0xc638, 0x8005, 0xad75, 0x5acb, 0x5aab, 0x8430, 0xad75, 0x4003,
+	0xc638, 0x8002, 0x632c, 0x0841, 0x401a, 0x0000, 0x4015, 0x0000, 0x8008, 0x0861, 0x738e, 0x7bef,
+	0x632c, 0xbdf7, 0xc638, 0xc638, 0x31a6, 0x4003, 0x0000, 0x8002, 0x41e8, 0xbdd7, 0x4017, 0xc638,
+	0x8007, 0x7bef, 0x4a49, 0x6b2d, 0x0020, 0x0000, 0x0000, 0x7bcf, 0x4007, 0xc638, 0x800b, 0xb596,
+	0x39a7, 0x0000, 0x0821, 0x2945, 0x5acb, 0x8c51, 0xad75, 0x9cd3, 0x39e7, 0x0020, 0x4018, 0x0000,
+	0x4015, 0x0000, 0x8008, 0x1082, 0x1082, 0x18a3, 0xb5d6, 0xc638, 0xce59, 0xce59, 0x7bef, 0x4004,
+	0x0000, 0x8002, 0x8430, 0xc618, 0x4014, 0xce59, 0x8003, 0xbdf7, 0xc618, 0xa554, 0x4004, 0x0000,
+	0x8001, 0x4228, 0x400a, 0xce59, 0x8001, 0x630c, 0x4004, 0x0000, 0x8004, 0x0020, 0x2945, 0x528a,
+	0x2965, 0x4018, 0x0000, 0x4016, 0x0000, 0x8008, 0x1082, 0xa514, 0x8410, 0x94b2, 0xce59, 0xce59,
+	0xc638, 0x2104, 0x4003, 0x0000, 0x8002, 0x1082, 0xa554, 0x4014, 0xce59, 0x8008, 0x9cf3, 0x20e4,
+	0x632c, 0x18c3, 0x0000, 0x0000, 0x20e4, 0xbdf7, 0x4005, 0xce59, 0x8003, 0xc618, 0x9cf3, 0xc618,
+	0x4003, 0xce59, 0x8002, 0x8430, 0x0861, 0x401e, 0x0000, 0x4016, 0x0000, 0x8003, 0x4208, 0x2124,
+	0x31a6, 0x4004, 0xce79, 0x8001, 0x8410, 0x4003, 0x0000, 0x8004, 0x0020, 0x2965, 0xb5b6, 0xce59,
+	0x4010, 0xce79, 0x8004, 0xbdd7, 0x9492, 0xbdf7, 0x0861, 0x4003, 0x0000, 0x8002, 0x1062, 0xad55,
+	0x4006, 0xce79, 0x8009, 0xce59, 0x8410, 0x18e3, 0x5aeb, 0xad55, 0xce79, 0xce79, 0xad55, 0x2104,
+	0x401d, 0x0000, 0x4017, 0x0000, 0x8008, 0x1082, 0xc618, 0x8c51, 0xb596, 0xce99, 0xce99, 0xce79,
+	0x39c7, 0x4003, 0x0000, 0x8004, 0x0020, 0x2945, 0x9cf3, 0xc638, 0x400d, 0xce99, 0x800a, 0xc658,
+	0xb5b6, 0xce59, 0x1062, 0x2965, 0x1082, 0x0000, 0x0000, 0x0841, 0x9cd3, 0x4009, 0xce99, 0x8008,
+	0x7bcf, 0x0000, 0x0020, 0x3186, 0x738e, 0xbdf7, 0xc638, 0x4a69, 0x401c, 0x0000, 0x4016, 0x0000,
+	0x8004, 0x0841, 0x6b6d, 0x4208, 0x528a, 0x4004, 0xd69a, 0x8002, 0xb5b6, 0x18a3, 0x4004, 0x0000,
+	0x8003, 0x2124, 0x738e, 0xa534, 0x400a, 0xd69a, 0x8006, 0xce79, 0xb596, 0xce79, 0x2104, 0x630c,
+	0x2124, 0x4003, 0x0000, 0x8002, 0x1082, 0x9cf3, 0x4006, 0xd69a, 0x8002, 0xbdd7, 0xc638, 0x4003,
+	0xd69a, 0x8001, 0x73ae, 0x4003, 0x0000, 0x8005, 0x0861, 0x4208, 0x8430, 0x5acb, 0x0841, 0x401a,
+	0x0000, 0x4016, 0x0000, 0x8006, 0x0841, 0x0861, 0x0861, 0xce79, 0x94b2, 0xb5b6, 0x4003, 0xd6ba,
+	0x8002, 0x9cf3, 0x0841, 0x4004, 0x0000, 0x8010, 0x1082, 0x39c7, 0x8410, 0xb5b6, 0xad75, 0xd6ba,
+	0xd69a, 0xd69a, 0xd6ba, 0xbdf7, 0xd6ba, 0x8c71, 0xc638, 0x2945, 0x7bcf, 0x18e3, 0x4004, 0x0000,
+	0x8002, 0x2104, 0xad55, 0x4007, 0xd6ba, 0x8007, 0xbdf7, 0x4228, 0x7bcf, 0xce79, 0xd6ba, 0xd6ba,
+	0x6b4d, 0x4005, 0x0000, 0x8002, 0x18e3, 0x1062, 0x401a, 0x0000, 0x4018, 0x0000, 0x8005, 0x8430,
+	0x630c, 0x4228, 0xd6ba, 0xd69a, 0x4003, 0xd6ba, 0x8002, 0x94b2, 0x0841, 0x4004, 0x0000, 0x800f,
+	0x0821, 0x0000, 0x4a49, 0x39e7, 0x7bcf, 0x7bef, 0x6b4d, 0xa514, 0x4208, 0x94d2, 0x20e4, 0x4a69,
+	0x18a3, 0x0000, 0x0020, 0x4003, 0x0000, 0x8002, 0x4228, 0xbe17, 0x4009, 0xd6ba, 0x8007, 0xa534,
+	0x0000, 0x2945, 0x8430, 0xd69a, 0xd6ba, 0x630c, 0x4020, 0x0000, 0x4017, 0x0000, 0x8006, 0x18c3,
+	0x31a6, 0x0000, 0xbdd7, 0x9cf3, 0xad55, 0x4004, 0xd6da, 0x8002, 0x9cf3, 0x18e3, 0x4006, 0x0000,
+	0x8008, 0x0821, 0x0841, 0x1082, 0x1062, 0x2124, 0x1062, 0x1062, 0x0841, 0x4005, 0x0000, 0x8002,
+	0x1082, 0x7bcf, 0x4007, 0xd6da, 0x8002, 0xce99, 0xa554, 0x4003, 0xd6da, 0x8007, 0x7bcf, 0x0000,
+	0x0000, 0x3186, 0x94b2, 0xd6da, 0x5aeb, 0x401f, 0x0000, 0x4019, 0x0000, 0x8005, 0x632c, 0x94b2,
+	0x2965, 0xd6ba, 0xd6ba, 0x4004, 0xdedb, 0x8002, 0xc618, 0x4228, 0x4010, 0x0000, 0x8003, 0x0821,
+	0x4a69, 0xbdf7, 0x4009, 0xdedb, 0x8006, 0x73ae, 0x52aa, 0xce99, 0xdedb, 0xdedb, 0x4208, 0x4003,
+	0x0000, 0x8003, 0x39c7, 0xa534, 0x4a49, 0x401e, 0x0000, 0x4018, 0x0000, 0x8006, 0x1082, 0x5aeb,
+	0x0000, 0x8c51, 0xbdf7, 0x9492, 0x4006, 0xdefb, 0x8003, 0x9cf3, 0x39c7, 0x0821, 0x400b, 0x0000,
+	0x8003, 0x18e3, 0x5aeb, 0xb5d6, 0x4008, 0xdefb, 0x800a, 0xd6ba, 0xdefb, 0xdefb, 0xd6da, 0x18c3,
+	0x2124, 0xad55, 0xdefb, 0xce79, 0x20e4, 0x4004, 0x0000, 0x8002, 0x39a7, 0x10a2, 0x401d, 0x0000,
+	0x4018, 0x0000, 0x8008, 0x0821, 0x0000, 0x18c3, 0xbdf7, 0x2124, 0xad55, 0xd6ba, 0xce59, 0x4006,
+	0xdefb, 0x800d, 0xbdd7, 0x7bef, 0x4228, 0x2124, 0x10a2, 0x0861, 0x0861, 0x18a3, 0x2925, 0x4228,
+	0x738e, 0xad55, 0xd6ba, 0x400a, 0xdefb, 0x800b, 0x9cf3, 0xad75, 0xdefb, 0xdefb, 0x9d13, 0x0000,
+	0x0020, 0x73ae, 0xdefb, 0xad55, 0x0020, 0x4022, 0x0000, 0x401a, 0x0000, 0x8008, 0x62ec, 0x39c7,
+	0x2124, 0xdf1b, 0x6b4d, 0xce59, 0xdf1b, 0xdefb, 0x4007, 0xdf1b, 0x8006, 0xdefb, 0xd69a, 0xce79,
+	0xce79, 0xd6ba, 0xdefb, 0x400b, 0xdf1b, 0x800e, 0xdedb, 0xdf1b, 0xdf1b, 0xc638, 0x18c3, 0xa514,
+	0xdf1b, 0xdf1b, 0x39e7, 0x0000, 0x0000, 0x39c7, 0xce59, 0x7bcf, 0x4022, 0x0000, 0x401a, 0x0000,
+	0x8007, 0x18c3, 0x0000, 0x8430, 0x8430, 0x4228, 0xe71c, 0x9cf3, 0x4003, 0xdefb, 0x4016, 0xe71c,
+	0x800f, 0x9cd3, 0xb5b6, 0xe71c, 0xe71c, 0x5acb, 0x0821, 0x94b2, 0xe71c, 0xbdd7, 0x0821, 0x0000,
+	0x0000, 0x18a3, 0x8c51, 0x4208, 0x4021, 0x0000, 0x401b, 0x0000, 0x8009, 0x0861, 0x7bef, 0x0821,
+	0x9492, 0xb596, 0x52aa, 0xe73c, 0xa534, 0xdf1b, 0x4013, 0xe73c, 0x800d, 0xd69a, 0xe73c, 0xe73c,
+	0xb5b6, 0x2104, 0xce79, 0xe73c, 0xbe17, 0x0000, 0x0000, 0x7bef, 0xe73c, 0x62ec, 0x4004, 0x0000,
+	0x8002, 0x2945, 0x0821, 0x4020, 0x0000, 0x401b, 0x0000, 0x800b, 0x18c3, 0x20e4, 0x0000, 0xb5b6,
+	0x2965, 0x73ae, 0xce79, 0x5acb, 0xe73c, 0xce79, 0xdefb, 0x400e, 0xe73c, 0x8011, 0xdefb, 0xe73c,
+	0xe73c, 0xa514, 0x9492, 0xe73c, 0xe73c, 0x2945, 0x2965, 0xdefb, 0xe73c, 0x39e7, 0x0000, 0x0000,
+	0x738e, 0xd6da, 0x18a3, 0x4025, 0x0000, 0x401d, 0x0000, 0x800e, 0x31a6, 0x6b6d, 0x0000, 0xb5b6,
+	0x632c, 0x52aa, 0xef5d, 0x6b6d, 0xdf1b, 0xd6ba, 0xce99, 0xef5d, 0xe73c, 0xe75c, 0x4003, 0xef5d,
+	0x8012, 0xe73c, 0xe75c, 0xef5d, 0xd69a, 0xdf1b, 0xef5d, 0xad55, 0xb5b6, 0xef5d, 0xce79, 0x20e4,
+	0xc658, 0xef5d, 0x8c51, 0x0000, 0x4a49, 0xef5d, 0xad55, 0x4003, 0x0000, 0x8003, 0x632c, 0x7bcf,
+	0x0020, 0x4024, 0x0000, 0x401d, 0x0000, 0x8024, 0x31a6, 0x1082, 0x1082, 0xad75, 0x0821, 0x7bef,
+	0xbdf7, 0x2965, 0xef7d, 0x9492, 0xb5b6, 0xef7d, 0x94b2, 0xef5d, 0xdefb, 0xce79, 0xef7d, 0xce59,
+	0xce79, 0xef7d, 0xa514, 0xa534, 0xef7d, 0xad55, 0x4a49, 0xef7d, 0xef7d, 0x2124, 0x39e7, 0xef7d,
+	0xce59, 0x0020, 0x0000, 0x630c, 0xef7d, 0x2104, 0x4003, 0x0000, 0x8002, 0x39e7, 0x18c3, 0x4024,
+	0x0000, 0x401f, 0x0000, 0x8022, 0x39c7, 0x630c, 0x0000, 0xa534, 0x632c, 0x2945, 0xef7d, 0x31a6,
+	0xb5b6, 0xe71c, 0x4a29, 0xef7d, 0xc638, 0x8410, 0xef7d, 0xad75, 0x8430, 0xef7d, 0xa514, 0x4a69,
+	0xef7d, 0xce79, 0x0020, 0xad55, 0xef7d, 0x632c, 0x0000, 0x8c51, 0xef7d, 0x2945, 0x0000, 0x0000,
+	0x8410, 0x94b2, 0x4029, 0x0000, 0x401f, 0x0000, 0x801e, 0x2104, 0x1062, 0x0000, 0x94d2, 0x1062,
+	0x4208, 0xd69a, 0x0000, 0xbdd7, 0xc638, 0x18c3, 0xef9d, 0xad55, 0x39c7, 0xef9d, 0xa514, 0x2965,
+	0xef9d, 0xb596, 0x0020, 0xce79, 0xef5d, 0x0861, 0x3186, 0xef9d, 0x9492, 0x0000, 0x0861, 0xce99,
+	0x8410, 0x4003, 0x0000, 0x8002, 0x7bef, 0x2104, 0x4028, 0x0000, 0x4021, 0x0000, 0x8021, 0x10a2,
+	0x5aeb, 0x0000, 0x52aa, 0x9492, 0x0000, 0xbdd7, 0x8c71, 0x0000, 0xe75c, 0x8c51, 0x0821, 0xef7d,
+	0x9cf3, 0x0000, 0xd69a, 0xc618, 0x0000, 0x7bcf, 0xf79e, 0x2965, 0x0000, 0xa514, 0xc638, 0x0000,
+	0x0000, 0x39c7, 0xbdf7, 0x0020, 0x0000, 0x0000, 0x0821, 0x18a3, 0x4028, 0x0000, 0x4021, 0x0000,
+	0x801d, 0x0861, 0x10a2, 0x0000, 0x4a69, 0x39c7, 0x0000, 0xad55, 0x4a69, 0x0000, 0xce79, 0x632c,
+	0x0000, 0xd6ba, 0x9492, 0x0000, 0x94d2, 0xce79, 0x0000, 0x18e3, 0xef7d, 0x4228, 0x0000, 0x2945,
+	0xd6ba, 0x10a2, 0x0000, 0x0000, 0x632c, 0x2945, 0x402c, 0x0000, 0x4024, 0x0000, 0x801a, 0x2945,
+	0x0861, 0x0000, 0x7bef, 0x18e3, 0x0000, 0xa534, 0x4a29, 0x0000, 0xa534, 0x8410, 0x0000, 0x528a,
+	0xce59, 0x0000, 0x0000, 0xad55, 0x6b4d, 0x0000, 0x0000, 0x8430, 0x4a49, 0x0000, 0x0000, 0x0861,
+	0x2124, 0x402c, 0x0000, 0x4027, 0x0000, 0x8013, 0x4a49, 0x0841, 0x0000, 0x73ae, 0x3186, 0x0000,
+	0x632c, 0x6b4d, 0x0000, 0x1082, 0xa514, 0x0841, 0x0000, 0x4a69, 0x7bef, 0x0000, 0x0000, 0x2104,
+	0x528a, 0x4030, 0x0000, 0x4027, 0x0000, 0x800f, 0x0841, 0x0000, 0x0000, 0x39e7, 0x18c3, 0x0000,
+	0x2965, 0x4208, 0x0000, 0x0000, 0x6b4d, 0x1082, 0x0000, 0x0841, 0x4a49, 0x4003, 0x0000, 0x8001,
+	0x0861, 0x4030, 0x0000, 0x402d, 0x0000, 0x8009, 0x0841, 0x1082, 0x0000, 0x0000, 0x2104, 0x0861,
+	0x0000, 0x0000, 0x0020, 0x4034, 0x0000, 0x406a, 0x0000, 0x406a, 0x0000, 0x406a, 0x0000, 0x406a,
+	0x0000, 0x406a, 0x0000, 0x406a, 0x0000, 0x406a, 0x0000, 0x406a, 0x0000, 0x406a, 0x0000, 0x406a,
+	0x0000, 0x406a, 0x0000, 0x406a, 0x0000, 0x406a, 0x0000, 0x406a, 0x0000, 0x406a, 0x0000, 0x406a,
+	0x0000, 0x406a, 0x0000, 0x406a, 0x0000, 0x406a, 0x0000, 0x406a, 0x0000, 0x406a, 0x0000, 0x406a,
+	0x0000, 0x406a, 0x0000, 0x406a, 0x0000, 0x406a, 0x0000, 0x406a, 0x0000,
+};
+
+const int dataConsoleRLE_width = 106;
+const int dataConsoleRLE_height = 107;
@@ -0,0 +1,683 @@
+const uint16_t dataConsoleSelectedRLE[] = {
+	0x400a, 0x0000, 0x8002, 0x0841, 0x1082, 0x4052, 0x20e4, 0x8002, 0x18c3, 0x1062, 0x400a, 0x0000,
+	0x4007, 0x0000, 0x8003, 0x1082, 0x3186, 0x4208, 0x4056, 0x4a49, 0x8003, 0x4a29, 0x31a6, 0x18e3,
+	0x4007, 0x0000, 0x4005, 0x0000, 0x8002, 0x0821, 0x3186, 0x4003, 0x4a49, 0x8002, 0x4208, 0x39c7,
+	0x4016, 0x2965, 0x4007, 0x3166, 0x4019, 0x3186, 0x4007, 0x3166, 0x4015, 0x2965, 0x8002, 0x31a6,
+	0x39e7, 0x4003, 0x4a49, 0x8002, 0x39c7, 0x18a3, 0x4005, 0x0000, 0x4004, 0x0000, 0x8006, 0x1082,
+	0x4208, 0x4a49, 0x4a49, 0x2945, 0x0841, 0x4016, 0x0000, 0x4004, 0x0020, 0x4003, 0x0821, 0x4005,
+	0x0841, 0x4003, 0x0861, 0x4004, 0x1062, 0x4005, 0x1082, 0x4004, 0x1062, 0x4003, 0x0861, 0x4005,
+	0x0841, 0x4003, 0x0821, 0x4004, 0x0020, 0x4015, 0x0000, 0x8006, 0x0020, 0x20e4, 0x4208, 0x4a49,
+	0x4a49, 0x2965, 0x4004, 0x0000, 0x4003, 0x0000, 0x8005, 0x1082, 0x4a49, 0x4a49, 0x31a6, 0x0841,
+	0x4016, 0x0000, 0x4004, 0x0020, 0x8002, 0x0821, 0x0821, 0x4004, 0x0841, 0x8003, 0x0861, 0x1062,
+	0x1062, 0x4015, 0x1082, 0x8003, 0x1062, 0x1062, 0x0861, 0x4004, 0x0841, 0x8002, 0x0821, 0x0821,
+	0x4004, 0x0020, 0x4016, 0x0000, 0x8004, 0x2124, 0x4a49, 0x4a49, 0x3166, 0x4003, 0x0000, 0x8006,
+	0x0000, 0x0000, 0x0861, 0x4a49, 0x4a49, 0x2945, 0x4016, 0x0000, 0x4003, 0x0020, 0x4003, 0x0821,
+	0x8005, 0x0841, 0x0841, 0x0861, 0x0861, 0x1062, 0x4006, 0x1082, 0x4011, 0x10a2, 0x4006, 0x1082,
+	0x8005, 0x1062, 0x0861, 0x0861, 0x0841, 0x0841, 0x4003, 0x0821, 0x4003, 0x0020, 0x4015, 0x0000,
+	0x8006, 0x10a2, 0x4a49, 0x4a49, 0x2104, 0x0000, 0x0000, 0x8005, 0x0000, 0x0000, 0x39c7, 0x4a49,
+	0x2965, 0x4015, 0x0000, 0x4003, 0x0020, 0x8002, 0x0821, 0x0821, 0x4003, 0x0841, 0x8002, 0x0861,
+	0x1062, 0x4004, 0x1082, 0x4009, 0x10a2, 0x4009, 0x18a3, 0x4009, 0x10a2, 0x4004, 0x1082, 0x8002,
+	0x1062, 0x0861, 0x4003, 0x0841, 0x8002, 0x0821, 0x0821, 0x4003, 0x0020, 0x4014, 0x0000, 0x8005,
+	0x18c3, 0x4a49, 0x4a49, 0x1062, 0x0000, 0x8004, 0x0000, 0x2104, 0x4a49, 0x4208, 0x4014, 0x0000,
+	0x4003, 0x0020, 0x8002, 0x0821, 0x0821, 0x4003, 0x0841, 0x8002, 0x0861, 0x1062, 0x4003, 0x1082,
+	0x4006, 0x10a2, 0x4008, 0x18a3, 0x4007, 0x18c3, 0x8003, 0x18a3, 0x18c3, 0x18c3, 0x4005, 0x18a3,
+	0x4004, 0x10a2, 0x4003, 0x1082, 0x8002, 0x1062, 0x0861, 0x4003, 0x0841, 0x8002, 0x0821, 0x0821,
+	0x4003, 0x0020, 0x4013, 0x0000, 0x8004, 0x2965, 0x4a49, 0x31a6, 0x0000, 0x8004, 0x0000, 0x39c7,
+	0x4a49, 0x18c3, 0x4013, 0x0000, 0x4003, 0x0020, 0x8001, 0x0821, 0x4003, 0x0841, 0x8002, 0x0861,
+	0x1062, 0x4003, 0x1082, 0x4004, 0x10a2, 0x4005, 0x18a3, 0x4009, 0x18c3, 0x800b, 0x2104, 0x20e4,
+	0x18c3, 0x2945, 0x20e4, 0x18c3, 0x2945, 0x20e4, 0x18c3, 0x20e4, 0x20e4, 0x4005, 0x18a3, 0x4003,
+	0x10a2, 0x4003, 0x1082, 0x8002, 0x1062, 0x0861, 0x4003, 0x0841, 0x8001, 0x0821, 0x4003, 0x0020,
+	0x4012, 0x0000, 0x8004, 0x0821, 0x4a49, 0x4a49, 0x1082, 0x8003, 0x1082, 0x4a49, 0x4208, 0x4012,
+	0x0000, 0x4003, 0x0020, 0x8008, 0x0821, 0x0821, 0x0841, 0x0841, 0x0861, 0x1062, 0x1082, 0x1082,
+	0x4004, 0x10a2, 0x4004, 0x18a3, 0x4008, 0x18c3, 0x8013, 0x18e3, 0x18c3, 0x2945, 0x2925, 0x18c3,
+	0x39a7, 0x20e4, 0x2104, 0x4208, 0x18c3, 0x2124, 0x4a29, 0x18c3, 0x18c3, 0x4208, 0x20e4, 0x18c3,
+	0x2124, 0x2124, 0x4005, 0x18a3, 0x4004, 0x10a2, 0x8007, 0x1082, 0x1062, 0x0861, 0x0841, 0x0841,
+	0x0821, 0x0821, 0x4003, 0x0020, 0x4011, 0x0000, 0x8003, 0x2945, 0x4a49, 0x2945, 0x8003, 0x2104,
+	0x4a49, 0x2945, 0x4011, 0x0000, 0x4003, 0x0020, 0x8007, 0x0821, 0x0841, 0x0841, 0x0861, 0x1062,
+	0x1082, 0x1082, 0x4004, 0x10a2, 0x4003, 0x18a3, 0x400a, 0x18c3, 0x8017, 0x2104, 0x2965, 0x18e3,
+	0x4228, 0x2925, 0x2945, 0x4a69, 0x18e3, 0x4a29, 0x4228, 0x18e3, 0x528a, 0x39a7, 0x18c3, 0x4a49,
+	0x41e8, 0x18c3, 0x2925, 0x4228, 0x18e3, 0x18c3, 0x2104, 0x2124, 0x4004, 0x18a3, 0x4004, 0x10a2,
+	0x8006, 0x1082, 0x1062, 0x0861, 0x0841, 0x0841, 0x0821, 0x4003, 0x0020, 0x4010, 0x0000, 0x8003,
+	0x1082, 0x4a49, 0x39c7, 0x8003, 0x3186, 0x4a49, 0x18c3, 0x4010, 0x0000, 0x8007, 0x0020, 0x0020,
+	0x0821, 0x0821, 0x0841, 0x0841, 0x0861, 0x4003, 0x1082, 0x4003, 0x10a2, 0x4003, 0x18a3, 0x4007,
+	0x18c3, 0x4003, 0x18e3, 0x8019, 0x3186, 0x18e3, 0x39c7, 0x39c7, 0x2104, 0x5acb, 0x20e4, 0x528a,
+	0x4a49, 0x2945, 0x6b2d, 0x2945, 0x39c7, 0x630c, 0x20e4, 0x39e7, 0x632c, 0x2104, 0x2124, 0x5aeb,
+	0x2965, 0x18c3, 0x2925, 0x4a29, 0x20e4, 0x4003, 0x18c3, 0x4003, 0x18a3, 0x4003, 0x10a2, 0x8009,
+	0x1082, 0x1082, 0x0861, 0x0841, 0x0841, 0x0821, 0x0821, 0x0020, 0x0020, 0x400f, 0x0000, 0x8003,
+	0x0020, 0x4a49, 0x4a49, 0x8003, 0x39c7, 0x4a49, 0x1082, 0x400f, 0x0000, 0x8009, 0x0020, 0x0020,
+	0x0821, 0x0821, 0x0841, 0x0861, 0x1062, 0x1082, 0x1082, 0x4003, 0x10a2, 0x8002, 0x18a3, 0x18a3,
+	0x4007, 0x18c3, 0x4003, 0x18e3, 0x8021, 0x2104, 0x2124, 0x20e4, 0x4a69, 0x2104, 0x52aa, 0x39e7,
+	0x39e7, 0x62ec, 0x2965, 0x6b4d, 0x39e7, 0x528a, 0x630c, 0x2965, 0x632c, 0x4a49, 0x2965, 0x6b4d,
+	0x4a49, 0x2104, 0x5aeb, 0x52aa, 0x20e4, 0x2965, 0x62ec, 0x2965, 0x18c3, 0x18c3, 0x39a7, 0x2925,
+	0x18c3, 0x18c3, 0x4003, 0x18a3, 0x4003, 0x10a2, 0x8008, 0x1082, 0x1062, 0x0861, 0x0841, 0x0821,
+	0x0821, 0x0020, 0x0020, 0x400f, 0x0000, 0x8002, 0x4228, 0x4a49, 0x8003, 0x39e7, 0x4a49, 0x1062,
+	0x400d, 0x0000, 0x4003, 0x0020, 0x8004, 0x0821, 0x0841, 0x0841, 0x0861, 0x4003, 0x1082, 0x8002,
+	0x10a2, 0x10a2, 0x4003, 0x18a3, 0x4006, 0x18c3, 0x4003, 0x18e3, 0x8020, 0x2104, 0x20e4, 0x39a7,
+	0x31a6, 0x2925, 0x62ec, 0x2945, 0x632c, 0x4208, 0x5acb, 0x5acb, 0x4a69, 0x6b4d, 0x4a69, 0x6b4d,
+	0x52aa, 0x52aa, 0x6b4d, 0x4208, 0x630c, 0x6b2d, 0x3166, 0x5acb, 0x6b4d, 0x2124, 0x3186, 0x6b2d,
+	0x4a49, 0x20e4, 0x2104, 0x4a69, 0x4208, 0x4004, 0x18c3, 0x4003, 0x18a3, 0x4003, 0x10a2, 0x8006,
+	0x1082, 0x1082, 0x0861, 0x0841, 0x0841, 0x0821, 0x4003, 0x0020, 0x400d, 0x0000, 0x8002, 0x4208,
+	0x4a49, 0x8003, 0x39e7, 0x4a49, 0x1062, 0x400c, 0x0000, 0x4003, 0x0020, 0x8006, 0x0821, 0x0841,
+	0x0841, 0x1062, 0x1082, 0x1082, 0x4003, 0x10a2, 0x8002, 0x18a3, 0x18a3, 0x4005, 0x18c3, 0x4003,
+	0x18e3, 0x8029, 0x20e4, 0x20e4, 0x2104, 0x39e7, 0x2104, 0x4a49, 0x4a49, 0x39c7, 0x6b4d, 0x4228,
+	0x6b6d, 0x52aa, 0x6b6d, 0x632c, 0x6b4d, 0x6b6d, 0x6b4d, 0x6b6d, 0x6b2d, 0x6b6d, 0x6b2d, 0x630c,
+	0x6b6d, 0x5acb, 0x5acb, 0x6b6d, 0x4a49, 0x31a6, 0x6b4d, 0x630c, 0x2104, 0x2965, 0x630c, 0x52aa,
+	0x18e3, 0x18e3, 0x20e4, 0x39c7, 0x2124, 0x18c3, 0x18c3, 0x4003, 0x18a3, 0x4003, 0x10a2, 0x8005,
+	0x1082, 0x1062, 0x0841, 0x0841, 0x0821, 0x4003, 0x0020, 0x400c, 0x0000, 0x8002, 0x4208, 0x4a49,
+	0x8003, 0x39e7, 0x4a49, 0x1062, 0x400b, 0x0000, 0x4003, 0x0020, 0x8006, 0x0821, 0x0841, 0x0841,
+	0x1062, 0x1082, 0x1082, 0x4003, 0x10a2, 0x8001, 0x18a3, 0x4005, 0x18c3, 0x4003, 0x18e3, 0x800c,
+	0x20e4, 0x2104, 0x2104, 0x2945, 0x2104, 0x52aa, 0x3186, 0x5acb, 0x5aeb, 0x52aa, 0x738e, 0x632c,
+	0x400d, 0x738e, 0x8010, 0x6b4d, 0x738e, 0x6b2d, 0x4a29, 0x6b6d, 0x6b6d, 0x3186, 0x39c7, 0x6b6d,
+	0x632c, 0x2124, 0x20e4, 0x3166, 0x5acb, 0x39c7, 0x18e3, 0x4004, 0x18c3, 0x8002, 0x18a3, 0x18a3,
+	0x4003, 0x10a2, 0x8005, 0x1082, 0x1062, 0x0841, 0x0841, 0x0821, 0x4003, 0x0020, 0x400b, 0x0000,
+	0x8002, 0x4208, 0x4a49, 0x8003, 0x39e7, 0x4a49, 0x1062, 0x400a, 0x0000, 0x4003, 0x0020, 0x800a,
+	0x0821, 0x0841, 0x0861, 0x1062, 0x1082, 0x1082, 0x10a2, 0x10a2, 0x18a3, 0x18a3, 0x4005, 0x18c3,
+	0x8003, 0x18e3, 0x18e3, 0x20e4, 0x4003, 0x2104, 0x8008, 0x2124, 0x528a, 0x2124, 0x632c, 0x4a69,
+	0x630c, 0x6b6d, 0x6b6d, 0x4011, 0x738e, 0x8015, 0x6b4d, 0x738e, 0x738e, 0x528a, 0x4a69, 0x738e,
+	0x6b6d, 0x2965, 0x2124, 0x4a49, 0x6b6d, 0x4208, 0x20e4, 0x18e3, 0x18e3, 0x2945, 0x18e3, 0x18c3,
+	0x18c3, 0x18a3, 0x18a3, 0x4003, 0x10a2, 0x8005, 0x1082, 0x1062, 0x0861, 0x0841, 0x0821, 0x4003,
+	0x0020, 0x400a, 0x0000, 0x8002, 0x4208, 0x4a49, 0x8003, 0x39e7, 0x4a49, 0x1062, 0x400a, 0x0000,
+	0x800c, 0x0020, 0x0020, 0x0821, 0x0841, 0x0861, 0x1062, 0x1082, 0x1082, 0x10a2, 0x10a2, 0x18a3,
+	0x18a3, 0x4004, 0x18c3, 0x800e, 0x18e3, 0x18e3, 0x20e4, 0x20e4, 0x2104, 0x2104, 0x2124, 0x39c7,
+	0x2124, 0x632c, 0x4208, 0x6b4d, 0x6b6d, 0x6b6d, 0x4006, 0x73ae, 0x8001, 0x738e, 0x4003, 0x6b6d,
+	0x8001, 0x738e, 0x400a, 0x73ae, 0x800f, 0x738e, 0x6b4d, 0x73ae, 0x73ae, 0x39e7, 0x31a6, 0x632c,
+	0x73ae, 0x4228, 0x2104, 0x20e4, 0x2965, 0x4a69, 0x39a7, 0x18e3, 0x4003, 0x18c3, 0x4003, 0x18a3,
+	0x8009, 0x10a2, 0x10a2, 0x1082, 0x1062, 0x0861, 0x0841, 0x0821, 0x0020, 0x0020, 0x400a, 0x0000,
+	0x8002, 0x4208, 0x4a49, 0x8003, 0x39e7, 0x4a49, 0x1062, 0x4009, 0x0000, 0x8007, 0x0020, 0x0020,
+	0x0821, 0x0841, 0x0861, 0x1062, 0x1082, 0x4003, 0x10a2, 0x8002, 0x18a3, 0x18a3, 0x4004, 0x18c3,
+	0x8003, 0x18e3, 0x18e3, 0x20e4, 0x4004, 0x2104, 0x8006, 0x2124, 0x5aeb, 0x3186, 0x6b2d, 0x6b4d,
+	0x738e, 0x4004, 0x73ae, 0x8005, 0x6b6d, 0x5acb, 0x4a49, 0x39e7, 0x31a6, 0x4003, 0x3186, 0x8004,
+	0x31a6, 0x41e8, 0x4a69, 0x630c, 0x400a, 0x73ae, 0x800d, 0x5acb, 0x52aa, 0x73ae, 0x73ae, 0x4a69,
+	0x2104, 0x2945, 0x528a, 0x6b6d, 0x39c7, 0x20e4, 0x18e3, 0x18e3, 0x4003, 0x18c3, 0x4003, 0x18a3,
+	0x8009, 0x10a2, 0x10a2, 0x1082, 0x1062, 0x0861, 0x0841, 0x0821, 0x0020, 0x0020, 0x4009, 0x0000,
+	0x8002, 0x4208, 0x4a49, 0x8003, 0x39e7, 0x4a49, 0x1062, 0x4008, 0x0000, 0x8007, 0x0020, 0x0020,
+	0x0821, 0x0841, 0x0841, 0x1062, 0x1082, 0x4003, 0x10a2, 0x8001, 0x18a3, 0x4004, 0x18c3, 0x8003,
+	0x18e3, 0x18e3, 0x20e4, 0x4004, 0x2104, 0x8006, 0x2124, 0x4208, 0x2124, 0x630c, 0x62ec, 0x6b4d,
+	0x4003, 0x7bcf, 0x8006, 0x73ae, 0x5acb, 0x41e8, 0x3186, 0x2965, 0x2965, 0x4009, 0x3166, 0x8003,
+	0x39c7, 0x52aa, 0x73ae, 0x4006, 0x7bcf, 0x8010, 0x73ae, 0x738e, 0x7bcf, 0x7bcf, 0x528a, 0x2945,
+	0x528a, 0x738e, 0x738e, 0x31a6, 0x2104, 0x2104, 0x20e4, 0x2124, 0x2124, 0x18e3, 0x4003, 0x18c3,
+	0x800b, 0x18a3, 0x18a3, 0x10a2, 0x10a2, 0x1082, 0x1062, 0x0841, 0x0841, 0x0821, 0x0020, 0x0020,
+	0x4008, 0x0000, 0x8002, 0x4208, 0x4a49, 0x8003, 0x39e7, 0x4a49, 0x1062, 0x4007, 0x0000, 0x800b,
+	0x0020, 0x0020, 0x0821, 0x0841, 0x0841, 0x1062, 0x1082, 0x1082, 0x10a2, 0x10a2, 0x18a3, 0x4004,
+	0x18c3, 0x8003, 0x18e3, 0x18e3, 0x20e4, 0x4004, 0x2104, 0x8005, 0x2124, 0x2124, 0x5acb, 0x4a49,
+	0x5acb, 0x4004, 0x7bcf, 0x800d, 0x5acb, 0x39c7, 0x2965, 0x3166, 0x3186, 0x3186, 0x31a6, 0x39c7,
+	0x39c7, 0x4208, 0x39c7, 0x39e7, 0x31a6, 0x4005, 0x3186, 0x8002, 0x39e7, 0x632c, 0x4008, 0x7bcf,
+	0x800e, 0x5aeb, 0x4a69, 0x738e, 0x7bcf, 0x738e, 0x3186, 0x2124, 0x2104, 0x3186, 0x52aa, 0x4a49,
+	0x2124, 0x18e3, 0x18e3, 0x4003, 0x18c3, 0x800b, 0x18a3, 0x18a3, 0x10a2, 0x10a2, 0x1082, 0x1062,
+	0x0841, 0x0841, 0x0821, 0x0020, 0x0020, 0x4007, 0x0000, 0x8002, 0x4208, 0x4a49, 0x8003, 0x39e7,
+	0x4a49, 0x1062, 0x4006, 0x0000, 0x800b, 0x0020, 0x0020, 0x0821, 0x0821, 0x0841, 0x1062, 0x1082,
+	0x1082, 0x10a2, 0x10a2, 0x18a3, 0x4004, 0x18c3, 0x8003, 0x18e3, 0x18e3, 0x20e4, 0x4003, 0x2104,
+	0x8020, 0x2124, 0x2124, 0x4208, 0x3166, 0x4a69, 0x7bcf, 0x6b6d, 0x7bef, 0x7bef, 0x738e, 0x4228,
+	0x3166, 0x3186, 0x3186, 0x39c7, 0x4a29, 0x528a, 0x632c, 0x6b4d, 0x6b6d, 0x738e, 0x6b6d, 0x630c,
+	0x630c, 0x4a49, 0x4a69, 0x31a6, 0x39c7, 0x31a6, 0x31a6, 0x3186, 0x52aa, 0x4006, 0x7bef, 0x8010,
+	0x7bcf, 0x738e, 0x7bef, 0x7bef, 0x6b4d, 0x2965, 0x2925, 0x4208, 0x630c, 0x73ae, 0x4a69, 0x2104,
+	0x20e4, 0x20e4, 0x18e3, 0x18e3, 0x4003, 0x18c3, 0x800b, 0x18a3, 0x18a3, 0x10a2, 0x10a2, 0x1082,
+	0x1062, 0x0841, 0x0841, 0x0821, 0x0020, 0x0020, 0x4006, 0x0000, 0x8002, 0x4208, 0x4a49, 0x8003,
+	0x39e7, 0x4a49, 0x1062, 0x4006, 0x0000, 0x800a, 0x0020, 0x0020, 0x0821, 0x0841, 0x0861, 0x1082,
+	0x1082, 0x10a2, 0x10a2, 0x18a3, 0x4004, 0x18c3, 0x8003, 0x18e3, 0x18e3, 0x20e4, 0x4003, 0x2104,
+	0x4003, 0x2124, 0x8003, 0x4a49, 0x6b4d, 0x4a69, 0x4003, 0x7bef, 0x8008, 0x632c, 0x31a6, 0x3186,
+	0x3186, 0x31a6, 0x4a69, 0x738e, 0x7bcf, 0x4009, 0x7bef, 0x8008, 0x6b2d, 0x630c, 0x4208, 0x39c7,
+	0x39a7, 0x31a6, 0x31a6, 0x528a, 0x4008, 0x7bef, 0x8007, 0x6b4d, 0x41e8, 0x528a, 0x738e, 0x7bef,
+	0x73ae, 0x39e7, 0x4004, 0x2104, 0x8003, 0x20e4, 0x18e3, 0x18e3, 0x4003, 0x18c3, 0x800a, 0x18a3,
+	0x18a3, 0x10a2, 0x10a2, 0x1082, 0x0861, 0x0841, 0x0821, 0x0020, 0x0020, 0x4006, 0x0000, 0x8002,
+	0x4208, 0x4a49, 0x8003, 0x39e7, 0x4a49, 0x1062, 0x4005, 0x0000, 0x800b, 0x0020, 0x0020, 0x0821,
+	0x0841, 0x0861, 0x1082, 0x1082, 0x10a2, 0x10a2, 0x18a3, 0x18a3, 0x4003, 0x18c3, 0x8003, 0x18e3,
+	0x18e3, 0x20e4, 0x4003, 0x2104, 0x800f, 0x2124, 0x2124, 0x39a7, 0x4a49, 0x31a6, 0x8410, 0x7bcf,
+	0x8410, 0x8410, 0x5acb, 0x3186, 0x3186, 0x31a6, 0x4a69, 0x6b4d, 0x400d, 0x8410, 0x8008, 0x7bcf,
+	0x630c, 0x5aeb, 0x39c7, 0x39c7, 0x39a7, 0x31a6, 0x52aa, 0x4006, 0x8410, 0x8007, 0x7bef, 0x6b4d,
+	0x7bef, 0x8410, 0x8410, 0x632c, 0x3186, 0x4003, 0x2124, 0x8006, 0x3186, 0x4208, 0x2965, 0x20e4,
+	0x18e3, 0x18e3, 0x4003, 0x18c3, 0x8001, 0x18a3, 0x4003, 0x10a2, 0x8006, 0x1082, 0x0861, 0x0841,
+	0x0821, 0x0020, 0x0020, 0x4005, 0x0000, 0x8002, 0x4208, 0x4a49, 0x8003, 0x39e7, 0x4a49, 0x1062,
+	0x4004, 0x0000, 0x800b, 0x0020, 0x0020, 0x0821, 0x0841, 0x0841, 0x1062, 0x1082, 0x10a2, 0x10a2,
+	0x18a3, 0x18a3, 0x4003, 0x18c3, 0x8003, 0x18e3, 0x18e3, 0x20e4, 0x4003, 0x2104, 0x800f, 0x2124,
+	0x2124, 0x2925, 0x2945, 0x73ae, 0x5acb, 0x73ae, 0x8410, 0x8410, 0x52aa, 0x3186, 0x3186, 0x39e7,
+	0x632c, 0x7bef, 0x4010, 0x8410, 0x8003, 0x632c, 0x632c, 0x4a29, 0x4003, 0x39c7, 0x8001, 0x630c,
+	0x4009, 0x8410, 0x800d, 0x52aa, 0x2945, 0x2945, 0x39c7, 0x4a69, 0x6b4d, 0x6b4d, 0x41e8, 0x2104,
+	0x2104, 0x20e4, 0x18e3, 0x18e3, 0x4003, 0x18c3, 0x800a, 0x18a3, 0x10a2, 0x10a2, 0x1082, 0x1062,
+	0x0841, 0x0841, 0x0821, 0x0020, 0x0020, 0x4004, 0x0000, 0x8002, 0x4208, 0x4a49, 0x8003, 0x39e7,
+	0x4a49, 0x1062, 0x4004, 0x0000, 0x800a, 0x0020, 0x0020, 0x0821, 0x0841, 0x0861, 0x1082, 0x1082,
+	0x10a2, 0x10a2, 0x18a3, 0x4003, 0x18c3, 0x8003, 0x18e3, 0x18e3, 0x20e4, 0x4003, 0x2104, 0x8006,
+	0x2124, 0x2124, 0x2945, 0x4a49, 0x3186, 0x5aab, 0x4003, 0x8430, 0x8005, 0x52aa, 0x3186, 0x31a6,
+	0x4208, 0x73ae, 0x4013, 0x8430, 0x8003, 0x7bcf, 0x4a69, 0x528a, 0x4003, 0x39c7, 0x8001, 0x73ae,
+	0x4006, 0x8430, 0x800a, 0x7bcf, 0x528a, 0x4208, 0x5aeb, 0x7bcf, 0x8430, 0x8430, 0x52aa, 0x2945,
+	0x2124, 0x4003, 0x2104, 0x8003, 0x20e4, 0x18e3, 0x18e3, 0x4003, 0x18c3, 0x8009, 0x18a3, 0x10a2,
+	0x10a2, 0x1082, 0x0861, 0x0841, 0x0841, 0x0020, 0x0020, 0x4004, 0x0000, 0x8002, 0x4208, 0x4a49,
+	0x8003, 0x39e7, 0x4a49, 0x1062, 0x4003, 0x0000, 0x800a, 0x0020, 0x0020, 0x0821, 0x0841, 0x0861,
+	0x1082, 0x1082, 0x10a2, 0x10a2, 0x18a3, 0x4003, 0x18c3, 0x8003, 0x18e3, 0x18e3, 0x20e4, 0x4003,
+	0x2104, 0x800e, 0x2124, 0x2124, 0x2945, 0x2945, 0x528a, 0x8410, 0x632c, 0x8c51, 0x8c51, 0x62ec,
+	0x31a6, 0x31a6, 0x4228, 0x8410, 0x4014, 0x8c51, 0x8003, 0x8430, 0x8430, 0x528a, 0x4003, 0x39e7,
+	0x8002, 0x4a69, 0x8430, 0x4004, 0x8c51, 0x8003, 0x8430, 0x7bcf, 0x7bef, 0x4003, 0x8c51, 0x8006,
+	0x6b6d, 0x39a7, 0x2945, 0x2925, 0x2124, 0x2124, 0x4003, 0x2104, 0x8002, 0x20e4, 0x18e3, 0x4004,
+	0x18c3, 0x8009, 0x18a3, 0x10a2, 0x10a2, 0x1082, 0x0861, 0x0841, 0x0821, 0x0020, 0x0020, 0x4003,
+	0x0000, 0x8002, 0x4208, 0x4a49, 0x8003, 0x39e7, 0x4a49, 0x1062, 0x4003, 0x0000, 0x8009, 0x0020,
+	0x0821, 0x0841, 0x0841, 0x1062, 0x1082, 0x10a2, 0x10a2, 0x18a3, 0x4004, 0x18c3, 0x8002, 0x18e3,
+	0x20e4, 0x4003, 0x2104, 0x800e, 0x2124, 0x2124, 0x2945, 0x31a6, 0x4a69, 0x3186, 0x7bcf, 0x8c51,
+	0x8c51, 0x6b6d, 0x31a6, 0x31a6, 0x41e8, 0x7bef, 0x4016, 0x8c51, 0x8007, 0x8410, 0x632c, 0x6b4d,
+	0x4208, 0x41e8, 0x39e7, 0x738e, 0x4008, 0x8c51, 0x800e, 0x7bef, 0x4a49, 0x2965, 0x2965, 0x2945,
+	0x2945, 0x3186, 0x4208, 0x41e8, 0x2925, 0x2104, 0x20e4, 0x20e4, 0x18e3, 0x4003, 0x18c3, 0x8009,
+	0x18a3, 0x18a3, 0x10a2, 0x1082, 0x1062, 0x0841, 0x0841, 0x0821, 0x0020, 0x4003, 0x0000, 0x8002,
+	0x4208, 0x4a49, 0x800f, 0x39e7, 0x4a49, 0x1062, 0x0000, 0x0000, 0x0020, 0x0020, 0x0821, 0x0841,
+	0x0861, 0x1082, 0x1082, 0x10a2, 0x18a3, 0x18a3, 0x4003, 0x18c3, 0x8002, 0x18e3, 0x20e4, 0x4003,
+	0x2104, 0x8002, 0x2124, 0x2124, 0x4003, 0x2945, 0x8009, 0x738e, 0x7bcf, 0x7bcf, 0x8c71, 0x8410,
+	0x39e7, 0x31a6, 0x39c7, 0x7bcf, 0x4019, 0x8c71, 0x8005, 0x52aa, 0x4208, 0x4208, 0x41e8, 0x528a,
+	0x4006, 0x8c71, 0x800b, 0x8c51, 0x632c, 0x4208, 0x39e7, 0x528a, 0x630c, 0x6b6d, 0x7bef, 0x7bcf,
+	0x52aa, 0x3186, 0x4003, 0x2104, 0x8003, 0x20e4, 0x20e4, 0x18e3, 0x4003, 0x18c3, 0x800d, 0x18a3,
+	0x18a3, 0x10a2, 0x1082, 0x0861, 0x0841, 0x0821, 0x0020, 0x0020, 0x0000, 0x0000, 0x4208, 0x4a49,
+	0x800e, 0x39e7, 0x4a49, 0x1062, 0x0000, 0x0000, 0x0020, 0x0821, 0x0841, 0x0841, 0x1062, 0x1082,
+	0x10a2, 0x10a2, 0x18a3, 0x4003, 0x18c3, 0x8002, 0x18e3, 0x18e3, 0x4003, 0x2104, 0x800e, 0x2124,
+	0x2124, 0x2925, 0x2945, 0x39e7, 0x41e8, 0x39e7, 0x8c51, 0x8c71, 0x8c71, 0x528a, 0x31a6, 0x39c7,
+	0x6b6d, 0x4019, 0x8c71, 0x8007, 0x8c51, 0x738e, 0x738e, 0x4a29, 0x4208, 0x4208, 0x7bef, 0x4005,
+	0x8c71, 0x8003, 0x8430, 0x73ae, 0x8430, 0x4003, 0x8c71, 0x8006, 0x8c51, 0x5acb, 0x31a6, 0x2945,
+	0x2925, 0x2124, 0x4003, 0x2104, 0x8002, 0x20e4, 0x18e3, 0x4004, 0x18c3, 0x800c, 0x18a3, 0x18a3,
+	0x10a2, 0x1082, 0x0841, 0x0841, 0x0821, 0x0020, 0x0000, 0x0000, 0x4208, 0x4a49, 0x800e, 0x39e7,
+	0x4a49, 0x1062, 0x0000, 0x0020, 0x0020, 0x0821, 0x0841, 0x0861, 0x1082, 0x10a2, 0x10a2, 0x18a3,
+	0x18a3, 0x4003, 0x18c3, 0x8013, 0x18e3, 0x20e4, 0x2104, 0x2104, 0x2124, 0x2124, 0x2925, 0x2945,
+	0x2945, 0x39c7, 0x8410, 0x738e, 0x8430, 0x9492, 0x738e, 0x31a6, 0x39c7, 0x5aab, 0x8c71, 0x401a,
+	0x9492, 0x8006, 0x8c71, 0x5acb, 0x4228, 0x4228, 0x4208, 0x632c, 0x4009, 0x9492, 0x8009, 0x8430,
+	0x62ec, 0x39a7, 0x2965, 0x2965, 0x2945, 0x2945, 0x2925, 0x2124, 0x4003, 0x2104, 0x8002, 0x20e4,
+	0x18e3, 0x4003, 0x18c3, 0x800c, 0x18a3, 0x18a3, 0x10a2, 0x1082, 0x0861, 0x0841, 0x0821, 0x0020,
+	0x0020, 0x0000, 0x4208, 0x4a49, 0x800d, 0x39e7, 0x4a49, 0x1062, 0x0000, 0x0020, 0x0821, 0x0841,
+	0x0841, 0x1062, 0x1082, 0x10a2, 0x10a2, 0x18a3, 0x4003, 0x18c3, 0x8002, 0x18e3, 0x20e4, 0x4003,
+	0x2104, 0x800e, 0x2124, 0x2124, 0x2945, 0x2945, 0x31a6, 0x3166, 0x4a69, 0x9492, 0x9492, 0x8c71,
+	0x4228, 0x39c7, 0x4a29, 0x8430, 0x401b, 0x9492, 0x8006, 0x8c51, 0x6b6d, 0x630c, 0x4a29, 0x4228,
+	0x4a69, 0x4007, 0x9492, 0x8011, 0x8430, 0x630c, 0x39c7, 0x3186, 0x3186, 0x3166, 0x2965, 0x2965,
+	0x31a6, 0x39a7, 0x2945, 0x2124, 0x2104, 0x2104, 0x20e4, 0x20e4, 0x18e3, 0x4003, 0x18c3, 0x800b,
+	0x18a3, 0x18a3, 0x10a2, 0x1082, 0x0841, 0x0841, 0x0821, 0x0020, 0x0000, 0x4208, 0x4a49, 0x800c,
+	0x39e7, 0x4a49, 0x1082, 0x0020, 0x0020, 0x0821, 0x0841, 0x0861, 0x1082, 0x10a2, 0x10a2, 0x18a3,
+	0x4003, 0x18c3, 0x8007, 0x18e3, 0x18e3, 0x20e4, 0x2104, 0x2104, 0x2124, 0x2124, 0x4003, 0x2945,
+	0x8009, 0x4a49, 0x8410, 0x738e, 0x8c71, 0x94b2, 0x632c, 0x39c7, 0x39c7, 0x6b4d, 0x401d, 0x94b2,
+	0x8006, 0x8c71, 0x5acb, 0x4a49, 0x4a29, 0x4a29, 0x8c51, 0x4005, 0x94b2, 0x8020, 0x8430, 0x630c,
+	0x5aeb, 0x632c, 0x6b6d, 0x73ae, 0x7bef, 0x8430, 0x8410, 0x6b6d, 0x4a69, 0x2965, 0x2124, 0x2124,
+	0x2104, 0x2104, 0x20e4, 0x18e3, 0x18e3, 0x18c3, 0x18c3, 0x18a3, 0x18a3, 0x10a2, 0x1082, 0x0861,
+	0x0841, 0x0821, 0x0020, 0x0020, 0x4208, 0x4a49, 0x800c, 0x39e7, 0x4a49, 0x1082, 0x0020, 0x0020,
+	0x0821, 0x0841, 0x1062, 0x1082, 0x10a2, 0x18a3, 0x18a3, 0x4003, 0x18c3, 0x8013, 0x18e3, 0x20e4,
+	0x2104, 0x2104, 0x2124, 0x2124, 0x2925, 0x2945, 0x2945, 0x2965, 0x3166, 0x52aa, 0x94b2, 0x94b2,
+	0x9492, 0x4208, 0x39c7, 0x4a29, 0x8c71, 0x401d, 0x94b2, 0x8006, 0x738e, 0x5acb, 0x528a, 0x4a49,
+	0x4a49, 0x7bef, 0x400b, 0x94b2, 0x800d, 0x8c71, 0x6b4d, 0x4208, 0x2965, 0x2945, 0x2945, 0x2925,
+	0x2124, 0x2104, 0x2104, 0x20e4, 0x20e4, 0x18e3, 0x4003, 0x18c3, 0x800a, 0x18a3, 0x18a3, 0x10a2,
+	0x1062, 0x0841, 0x0841, 0x0020, 0x0020, 0x4208, 0x4a49, 0x8010, 0x39e7, 0x4a49, 0x1082, 0x0020,
+	0x0821, 0x0841, 0x0861, 0x1082, 0x1082, 0x10a2, 0x18a3, 0x18a3, 0x18c3, 0x18c3, 0x18e3, 0x20e4,
+	0x4003, 0x2104, 0x800e, 0x2124, 0x2124, 0x2945, 0x2945, 0x2965, 0x4a69, 0x7bcf, 0x738e, 0x8c71,
+	0x9cd3, 0x6b4d, 0x39c7, 0x39e7, 0x6b4d, 0x401f, 0x9cd3, 0x8005, 0x9492, 0x5aeb, 0x4a69, 0x4a49,
+	0x6b6d, 0x4008, 0x9cd3, 0x801d, 0x9492, 0x73ae, 0x4a69, 0x31a6, 0x3186, 0x3186, 0x2965, 0x2965,
+	0x2945, 0x2945, 0x2124, 0x2124, 0x2104, 0x2104, 0x20e4, 0x18e3, 0x18e3, 0x18c3, 0x18c3, 0x18a3,
+	0x18a3, 0x10a2, 0x1082, 0x0861, 0x0841, 0x0821, 0x0020, 0x4208, 0x4a49, 0x800b, 0x39e7, 0x4a49,
+	0x1082, 0x0020, 0x0821, 0x0841, 0x1062, 0x1082, 0x10a2, 0x18a3, 0x18a3, 0x4003, 0x18c3, 0x8006,
+	0x18e3, 0x20e4, 0x2104, 0x2104, 0x2124, 0x2124, 0x4003, 0x2945, 0x800a, 0x2965, 0x3166, 0x62ec,
+	0x9cf3, 0x9cf3, 0x9cd3, 0x4a69, 0x39c7, 0x4228, 0x9492, 0x401e, 0x9cf3, 0x8006, 0x9492, 0x5acb,
+	0x528a, 0x4a69, 0x4a69, 0x632c, 0x4005, 0x9cf3, 0x8014, 0x9cd3, 0x8430, 0x5aeb, 0x4208, 0x39c7,
+	0x39a7, 0x31a6, 0x3186, 0x3186, 0x2965, 0x2965, 0x2945, 0x2945, 0x2925, 0x2124, 0x2104, 0x2104,
+	0x20e4, 0x20e4, 0x18e3, 0x4003, 0x18c3, 0x8009, 0x18a3, 0x10a2, 0x1082, 0x1062, 0x0841, 0x0821,
+	0x0020, 0x4208, 0x4a49, 0x800b, 0x39e7, 0x4a49, 0x1082, 0x0821, 0x0841, 0x0861, 0x1082, 0x1082,
+	0x10a2, 0x18a3, 0x18a3, 0x4003, 0x18c3, 0x8001, 0x20e4, 0x4003, 0x2104, 0x800e, 0x2124, 0x2124,
+	0x2945, 0x2945, 0x2965, 0x4208, 0x630c, 0x630c, 0x8c51, 0x9cf3, 0x8410, 0x39c7, 0x39e7, 0x630c,
+	0x401f, 0x9cf3, 0x8006, 0x9cd3, 0x8c71, 0x738e, 0x528a, 0x4a69, 0x5aeb, 0x4005, 0x9cf3, 0x8020,
+	0x9cd3, 0x8430, 0x7bef, 0x7bef, 0x7bcf, 0x73ae, 0x6b6d, 0x6b2d, 0x632c, 0x5aeb, 0x528a, 0x39e7,
+	0x2945, 0x2945, 0x2124, 0x2124, 0x2104, 0x2104, 0x20e4, 0x18e3, 0x18e3, 0x18c3, 0x18c3, 0x18a3,
+	0x18a3, 0x10a2, 0x1082, 0x0861, 0x0841, 0x0821, 0x4208, 0x4a49, 0x800a, 0x39e7, 0x4a49, 0x1082,
+	0x0821, 0x0841, 0x0861, 0x1082, 0x10a2, 0x10a2, 0x18a3, 0x4003, 0x18c3, 0x8013, 0x18e3, 0x20e4,
+	0x2104, 0x2104, 0x2124, 0x2124, 0x2945, 0x2945, 0x2965, 0x2965, 0x3186, 0x632c, 0x9cf3, 0x9d13,
+	0x9d13, 0x630c, 0x39e7, 0x4208, 0x7bef, 0x4020, 0x9d13, 0x8006, 0x8c71, 0x632c, 0x528a, 0x528a,
+	0x5acb, 0x9cf3, 0x400b, 0x9d13, 0x8019, 0x9cd3, 0x8410, 0x6b4d, 0x528a, 0x31a6, 0x2945, 0x2945,
+	0x2925, 0x2124, 0x2104, 0x2104, 0x20e4, 0x20e4, 0x18e3, 0x18c3, 0x18c3, 0x18a3, 0x18a3, 0x10a2,
+	0x1082, 0x0861, 0x0841, 0x0821, 0x4208, 0x4a49, 0x800a, 0x39e7, 0x4a49, 0x1082, 0x0821, 0x0841,
+	0x1062, 0x1082, 0x10a2, 0x18a3, 0x18a3, 0x4003, 0x18c3, 0x8013, 0x20e4, 0x20e4, 0x2104, 0x2104,
+	0x2124, 0x2124, 0x2945, 0x2945, 0x2965, 0x3186, 0x4a49, 0x52aa, 0x7bef, 0xa514, 0x9cf3, 0x4a49,
+	0x39e7, 0x4a49, 0x94b2, 0x401f, 0xa514, 0x8007, 0x9cf3, 0x6b6d, 0x52aa, 0x52aa, 0x528a, 0x5acb,
+	0x9cf3, 0x4006, 0xa514, 0x8013, 0x9d13, 0x9492, 0x7bef, 0x6b2d, 0x528a, 0x39e7, 0x31a6, 0x3186,
+	0x3186, 0x2965, 0x2965, 0x2945, 0x2945, 0x2124, 0x2124, 0x2104, 0x2104, 0x20e4, 0x18e3, 0x4003,
+	0x18c3, 0x8008, 0x18a3, 0x18a3, 0x10a2, 0x1062, 0x0841, 0x0821, 0x4208, 0x4a49, 0x800e, 0x39e7,
+	0x4a49, 0x1082, 0x0841, 0x0841, 0x1082, 0x1082, 0x10a2, 0x18a3, 0x18a3, 0x18c3, 0x18c3, 0x18e3,
+	0x20e4, 0x4003, 0x2104, 0x800f, 0x2124, 0x2925, 0x2945, 0x2965, 0x2965, 0x3186, 0x632c, 0x9cd3,
+	0xa534, 0xa534, 0x8c71, 0x39e7, 0x41e8, 0x5acb, 0xa514, 0x4021, 0xa534, 0x8005, 0x7bef, 0x52aa,
+	0x52aa, 0x5aeb, 0xa514, 0x4004, 0xa534, 0x8020, 0xa514, 0x8430, 0x630c, 0x4208, 0x39e7, 0x39e7,
+	0x39c7, 0x39a7, 0x31a6, 0x3186, 0x3186, 0x3166, 0x2965, 0x2945, 0x2945, 0x2925, 0x2124, 0x2104,
+	0x2104, 0x20e4, 0x18e3, 0x18e3, 0x18c3, 0x18c3, 0x18a3, 0x18a3, 0x10a2, 0x1082, 0x0841, 0x0841,
+	0x4208, 0x4a49, 0x8009, 0x39e7, 0x4a49, 0x1082, 0x0841, 0x0861, 0x1082, 0x10a2, 0x10a2, 0x18a3,
+	0x4003, 0x18c3, 0x8013, 0x18e3, 0x20e4, 0x2104, 0x2104, 0x2124, 0x2124, 0x2945, 0x2945, 0x2965,
+	0x2965, 0x31a6, 0x39e7, 0x5aeb, 0x9cf3, 0xa534, 0x738e, 0x39e7, 0x4208, 0x6b6d, 0x4020, 0xa534,
+	0x8006, 0xa514, 0x73ae, 0x5aeb, 0x5aab, 0x52aa, 0x632c, 0x4006, 0xa534, 0x8010, 0xa514, 0x9cf3,
+	0x9492, 0x8410, 0x6b6d, 0x5acb, 0x4a49, 0x4208, 0x39a7, 0x3186, 0x3186, 0x2965, 0x2965, 0x2945,
+	0x2945, 0x2124, 0x4003, 0x2104, 0x800c, 0x20e4, 0x18e3, 0x18c3, 0x18c3, 0x18a3, 0x18a3, 0x10a2,
+	0x1082, 0x0861, 0x0841, 0x4208, 0x4a49, 0x8009, 0x39e7, 0x4a49, 0x1082, 0x0841, 0x1062, 0x1082,
+	0x10a2, 0x18a3, 0x18a3, 0x4003, 0x18c3, 0x8013, 0x20e4, 0x20e4, 0x2104, 0x2104, 0x2124, 0x2124,
+	0x2945, 0x2945, 0x2965, 0x3166, 0x52aa, 0x8c71, 0xa534, 0xad55, 0xad55, 0x630c, 0x41e8, 0x4208,
+	0x7bef, 0x4020, 0xad55, 0x8006, 0xa534, 0x7bcf, 0x62ec, 0x5acb, 0x52aa, 0x6b6d, 0x400d, 0xad55,
+	0x800e, 0x9cf3, 0x8430, 0x6b4d, 0x4228, 0x3166, 0x2965, 0x2945, 0x2945, 0x2124, 0x2124, 0x2104,
+	0x2104, 0x20e4, 0x18e3, 0x4003, 0x18c3, 0x8007, 0x18a3, 0x10a2, 0x10a2, 0x1062, 0x0841, 0x4208,
+	0x4a49, 0x800d, 0x39e7, 0x4a49, 0x1082, 0x0841, 0x1062, 0x1082, 0x10a2, 0x18a3, 0x18a3, 0x18c3,
+	0x18c3, 0x18e3, 0x20e4, 0x4003, 0x2104, 0x800f, 0x2124, 0x2925, 0x2945, 0x2965, 0x2965, 0x3186,
+	0x3186, 0x4228, 0x8430, 0xad55, 0xad55, 0x528a, 0x4208, 0x4228, 0x8c51, 0x4021, 0xad55, 0x8005,
+	0xa534, 0x73ae, 0x5acb, 0x5acb, 0x7bef, 0x4005, 0xad55, 0x8020, 0xa554, 0xa514, 0x9cf3, 0x94b2,
+	0x8430, 0x73ae, 0x632c, 0x52aa, 0x4a29, 0x4208, 0x39c7, 0x31a6, 0x3166, 0x2965, 0x2945, 0x2945,
+	0x2925, 0x2124, 0x2104, 0x2104, 0x20e4, 0x18e3, 0x18e3, 0x18c3, 0x18c3, 0x18a3, 0x18a3, 0x10a2,
+	0x1062, 0x0841, 0x4208, 0x4a49, 0x801f, 0x39e7, 0x4a49, 0x10a2, 0x0841, 0x1082, 0x1082, 0x10a2,
+	0x18a3, 0x18a3, 0x18c3, 0x18c3, 0x18e3, 0x20e4, 0x2104, 0x2104, 0x2124, 0x2925, 0x2945, 0x2945,
+	0x2965, 0x3166, 0x39c7, 0x7bcf, 0xa514, 0xad75, 0xad75, 0xa514, 0x4228, 0x4208, 0x4a49, 0x94b2,
+	0x4020, 0xad75, 0x8006, 0x8430, 0x630c, 0x5aeb, 0x5acb, 0x5acb, 0x8c71, 0x4005, 0xad75, 0x8012,
+	0x9d13, 0x7bcf, 0x5aab, 0x4228, 0x4208, 0x4208, 0x41e8, 0x39e7, 0x39c7, 0x39c7, 0x31a6, 0x3186,
+	0x3186, 0x2965, 0x2965, 0x2945, 0x2945, 0x2124, 0x4003, 0x2104, 0x800b, 0x18e3, 0x18e3, 0x18c3,
+	0x18c3, 0x18a3, 0x18a3, 0x10a2, 0x1082, 0x0841, 0x4208, 0x4a49, 0x8008, 0x39e7, 0x4a49, 0x10a2,
+	0x0861, 0x1082, 0x1082, 0x10a2, 0x18a3, 0x4003, 0x18c3, 0x8014, 0x18e3, 0x20e4, 0x2104, 0x2104,
+	0x2124, 0x2925, 0x2945, 0x2945, 0x2965, 0x3166, 0x3186, 0x39c7, 0x5aab, 0x9cf3, 0xad75, 0x9cd3,
+	0x4208, 0x4208, 0x4a49, 0x9cd3, 0x4020, 0xad75, 0x8006, 0xad55, 0x8410, 0x630c, 0x5aeb, 0x5acb,
+	0x9cf3, 0x4007, 0xad75, 0x8010, 0xa554, 0x94b2, 0x73ae, 0x52aa, 0x41e8, 0x39e7, 0x39c7, 0x39c7,
+	0x31a6, 0x3186, 0x3186, 0x3166, 0x2965, 0x2945, 0x2945, 0x2124, 0x4003, 0x2104, 0x800b, 0x20e4,
+	0x18e3, 0x18c3, 0x18c3, 0x18a3, 0x18a3, 0x10a2, 0x1082, 0x0861, 0x4208, 0x4a49, 0x801f, 0x39e7,
+	0x4a49, 0x10a2, 0x0861, 0x1082, 0x10a2, 0x10a2, 0x18a3, 0x18c3, 0x18c3, 0x18e3, 0x20e4, 0x20e4,
+	0x2104, 0x2104, 0x2124, 0x2925, 0x2945, 0x2945, 0x2965, 0x3186, 0x4208, 0x73ae, 0xa514, 0xb596,
+	0xb596, 0x9492, 0x4208, 0x4208, 0x4a69, 0x9d13, 0x401f, 0xb596, 0x8007, 0xad75, 0x9cf3, 0x8c51,
+	0x632c, 0x5aeb, 0x632c, 0xad75, 0x400b, 0xb596, 0x8011, 0x9cf3, 0x8410, 0x630c, 0x4228, 0x31a6,
+	0x31a6, 0x3186, 0x3186, 0x2965, 0x2945, 0x2945, 0x2925, 0x2124, 0x2104, 0x2104, 0x20e4, 0x18e3,
+	0x4003, 0x18c3, 0x8006, 0x18a3, 0x10a2, 0x1082, 0x0861, 0x4208, 0x4a49, 0x801f, 0x39e7, 0x4a49,
+	0x10a2, 0x0861, 0x1082, 0x10a2, 0x18a3, 0x18a3, 0x18c3, 0x18c3, 0x18e3, 0x20e4, 0x2104, 0x2104,
+	0x2124, 0x2124, 0x2925, 0x2945, 0x2965, 0x2965, 0x3186, 0x4228, 0x630c, 0x7bef, 0xad75, 0xb596,
+	0x8c71, 0x4208, 0x4228, 0x4a69, 0x9cf3, 0x401f, 0xb596, 0x8002, 0xa534, 0x632c, 0x4003, 0x630c,
+	0x8001, 0x7bef, 0x4005, 0xb596, 0x8001, 0xa554, 0x4004, 0x94b2, 0x8013, 0x9492, 0x9492, 0x94b2,
+	0x94b2, 0x8c71, 0x73ae, 0x528a, 0x31a6, 0x3186, 0x3186, 0x2965, 0x2945, 0x2945, 0x2925, 0x2124,
+	0x2104, 0x2104, 0x20e4, 0x18e3, 0x4003, 0x18c3, 0x8006, 0x18a3, 0x10a2, 0x10a2, 0x1062, 0x4208,
+	0x4a49, 0x801f, 0x39e7, 0x4a49, 0x10a2, 0x1062, 0x1082, 0x10a2, 0x18a3, 0x18a3, 0x18c3, 0x18c3,
+	0x18e3, 0x20e4, 0x2104, 0x2104, 0x2124, 0x2124, 0x2945, 0x2945, 0x2965, 0x3166, 0x3186, 0x31a6,
+	0x630c, 0xa514, 0xb5b6, 0xb5b6, 0x8c71, 0x4208, 0x4228, 0x4a49, 0x94b2, 0x4020, 0xb5b6, 0x8005,
+	0x9cf3, 0x6b4d, 0x630c, 0x630c, 0x9cd3, 0x4005, 0xb5b6, 0x8018, 0xad75, 0x8430, 0x5aeb, 0x4a49,
+	0x4a49, 0x4a29, 0x4228, 0x4208, 0x41e8, 0x39e7, 0x39c7, 0x39c7, 0x31a6, 0x3186, 0x3186, 0x2965,
+	0x2965, 0x2945, 0x2925, 0x2124, 0x2124, 0x2104, 0x20e4, 0x20e4, 0x4003, 0x18c3, 0x8006, 0x18a3,
+	0x18a3, 0x10a2, 0x1062, 0x4208, 0x4a49, 0x801f, 0x39e7, 0x4a49, 0x10a2, 0x1062, 0x1082, 0x10a2,
+	0x18a3, 0x18a3, 0x18c3, 0x18c3, 0x18e3, 0x20e4, 0x2104, 0x2104, 0x2124, 0x2925, 0x2945, 0x2945,
+	0x2965, 0x3186, 0x3186, 0x5aeb, 0x8c51, 0x8c71, 0xb596, 0xb5b6, 0x94b2, 0x4208, 0x4228, 0x4a49,
+	0x8c71, 0x401e, 0xb5b6, 0x8007, 0xad75, 0x8c51, 0x7bef, 0x6b4d, 0x630c, 0x6b2d, 0xb596, 0x4008,
+	0xb5b6, 0x801e, 0x9492, 0x630c, 0x4a29, 0x4228, 0x4208, 0x4208, 0x39e7, 0x39c7, 0x39c7, 0x31a6,
+	0x31a6, 0x3186, 0x3166, 0x2965, 0x2945, 0x2945, 0x2124, 0x2124, 0x2104, 0x20e4, 0x20e4, 0x18e3,
+	0x18c3, 0x18c3, 0x18a3, 0x18a3, 0x10a2, 0x1062, 0x4208, 0x4a49, 0x801f, 0x39e7, 0x4a49, 0x10a2,
+	0x1062, 0x10a2, 0x10a2, 0x18a3, 0x18a3, 0x18c3, 0x18c3, 0x18e3, 0x20e4, 0x2104, 0x2104, 0x2124,
+	0x2925, 0x2945, 0x2945, 0x2965, 0x3186, 0x3186, 0x31a6, 0x39e7, 0x9492, 0xbdd7, 0xbdd7, 0x9d13,
+	0x4208, 0x4228, 0x4a49, 0x8410, 0x401e, 0xbdd7, 0x8006, 0xb5b6, 0x7bcf, 0x6b4d, 0x632c, 0x632c,
+	0x8430, 0x400b, 0xbdd7, 0x8014, 0x9cf3, 0x632c, 0x4228, 0x4208, 0x39e7, 0x39c7, 0x39c7, 0x31a6,
+	0x31a6, 0x3186, 0x3166, 0x2965, 0x2945, 0x2945, 0x2124, 0x2124, 0x2104, 0x2104, 0x20e4, 0x18e3,
+	0x4003, 0x18c3, 0x8005, 0x18a3, 0x10a2, 0x1062, 0x4208, 0x4a49, 0x8020, 0x39e7, 0x4a49, 0x10a2,
+	0x1062, 0x10a2, 0x10a2, 0x18a3, 0x18a3, 0x18c3, 0x18c3, 0x18e3, 0x20e4, 0x2104, 0x2104, 0x2124,
+	0x2925, 0x2945, 0x2945, 0x2965, 0x3186, 0x3186, 0x528a, 0x9d13, 0xad55, 0xb596, 0xbdf7, 0xad75,
+	0x4a49, 0x4228, 0x4a49, 0x6b6d, 0xb5b6, 0x401c, 0xbdf7, 0x8007, 0xb5b6, 0xb5b6, 0xa554, 0x6b6d,
+	0x6b2d, 0x632c, 0xad55, 0x4005, 0xbdf7, 0x801a, 0xa534, 0x8c71, 0x9cd3, 0xa534, 0xb596, 0xb5b6,
+	0xbdf7, 0xbdf7, 0xad55, 0x7bcf, 0x4a69, 0x39e7, 0x39c7, 0x31a6, 0x31a6, 0x3186, 0x3166, 0x2965,
+	0x2945, 0x2945, 0x2124, 0x2124, 0x2104, 0x2104, 0x20e4, 0x18e3, 0x4003, 0x18c3, 0x8005, 0x18a3,
+	0x10a2, 0x1082, 0x4208, 0x4a49, 0x8020, 0x39e7, 0x4a49, 0x18a3, 0x1082, 0x10a2, 0x10a2, 0x18a3,
+	0x18c3, 0x18c3, 0x18e3, 0x18e3, 0x20e4, 0x2104, 0x2104, 0x2124, 0x2925, 0x2945, 0x2945, 0x2965,
+	0x3186, 0x3186, 0x4228, 0x4208, 0x6b6d, 0xb5d6, 0xbdf7, 0xbdf7, 0x5acb, 0x4228, 0x4a49, 0x5acb,
+	0xb596, 0x401c, 0xbdf7, 0x8006, 0xad55, 0x6b6d, 0x738e, 0x6b4d, 0x6b2d, 0x7bef, 0x4006, 0xbdf7,
+	0x801a, 0xb5d6, 0x94b2, 0x5acb, 0x528a, 0x528a, 0x52aa, 0x5acb, 0x630c, 0x6b6d, 0x7bef, 0x73ae,
+	0x52aa, 0x39c7, 0x39a7, 0x31a6, 0x3186, 0x3166, 0x2965, 0x2945, 0x2945, 0x2124, 0x2124, 0x2104,
+	0x2104, 0x20e4, 0x18e3, 0x4003, 0x18c3, 0x8005, 0x18a3, 0x10a2, 0x1082, 0x4228, 0x4a49, 0x8020,
+	0x39e7, 0x4a49, 0x18a3, 0x1082, 0x10a2, 0x10a2, 0x18a3, 0x18c3, 0x18c3, 0x18e3, 0x18e3, 0x20e4,
+	0x2104, 0x2104, 0x2124, 0x2925, 0x2945, 0x2945, 0x2965, 0x3186, 0x3186, 0x31a6, 0x7bcf, 0xbdf7,
+	0xb5b6, 0xbe17, 0xbe17, 0x6b6d, 0x4228, 0x4a49, 0x4a69, 0x94b2, 0x401d, 0xbe17, 0x8005, 0x8410,
+	0x6b4d, 0x6b4d, 0x6b2d, 0xad75, 0x4008, 0xbe17, 0x8018, 0xb596, 0x7bef, 0x4a69, 0x4a49, 0x4a49,
+	0x4228, 0x4228, 0x4208, 0x41e8, 0x39e7, 0x39c7, 0x39a7, 0x31a6, 0x3186, 0x3166, 0x2965, 0x2945,
+	0x2945, 0x2124, 0x2124, 0x2104, 0x2104, 0x20e4, 0x18e3, 0x4003, 0x18c3, 0x8005, 0x18a3, 0x10a2,
+	0x1082, 0x4228, 0x4a49, 0x8020, 0x39e7, 0x4a49, 0x18a3, 0x1082, 0x10a2, 0x10a2, 0x18a3, 0x18c3,
+	0x18c3, 0x18e3, 0x18e3, 0x20e4, 0x2104, 0x2104, 0x2124, 0x2925, 0x2945, 0x2945, 0x2965, 0x3186,
+	0x3186, 0x528a, 0x738e, 0x5aeb, 0xad55, 0xc618, 0xc618, 0x8c51, 0x4a29, 0x4a49, 0x4a69, 0x738e,
+	0x401b, 0xc618, 0x8006, 0x9492, 0x8c51, 0x8410, 0x6b6d, 0x6b4d, 0x8c51, 0x4005, 0xc618, 0x8001,
+	0xbdf7, 0x4005, 0xc618, 0x8016, 0xa534, 0x630c, 0x4a49, 0x4228, 0x4228, 0x4208, 0x41e8, 0x39e7,
+	0x39c7, 0x39a7, 0x31a6, 0x3186, 0x3166, 0x2965, 0x2945, 0x2945, 0x2124, 0x2124, 0x2104, 0x2104,
+	0x20e4, 0x18e3, 0x4003, 0x18c3, 0x8005, 0x18a3, 0x10a2, 0x1082, 0x4228, 0x4a49, 0x8021, 0x39e7,
+	0x4a49, 0x18a3, 0x1082, 0x10a2, 0x10a2, 0x18a3, 0x18c3, 0x18c3, 0x18e3, 0x18e3, 0x20e4, 0x2104,
+	0x2104, 0x2124, 0x2925, 0x2945, 0x2945, 0x2965, 0x3186, 0x3186, 0x31a6, 0x39c7, 0xa514, 0xc638,
+	0xc618, 0xc638, 0xb596, 0x4a49, 0x4a49, 0x4a69, 0x5acb, 0xa534, 0x401a, 0xc638, 0x8006, 0xa514,
+	0x6b6d, 0x6b6d, 0x6b4d, 0x738e, 0xbdd7, 0x4005, 0xc638, 0x8005, 0xbdd7, 0x8c51, 0x8c51, 0x9d13,
+	0xb5b6, 0x4003, 0xc638, 0x8014, 0x8c51, 0x4a69, 0x4228, 0x4208, 0x41e8, 0x39e7, 0x39c7, 0x39a7,
+	0x31a6, 0x3186, 0x3166, 0x2965, 0x2945, 0x2945, 0x2124, 0x2124, 0x2104, 0x2104, 0x20e4, 0x18e3,
+	0x4003, 0x18c3, 0x8005, 0x18a3, 0x10a2, 0x1082, 0x4228, 0x4a49, 0x8022, 0x39e7, 0x4a49, 0x18a3,
+	0x1082, 0x10a2, 0x10a2, 0x18a3, 0x18c3, 0x18c3, 0x18e3, 0x18e3, 0x20e4, 0x2104, 0x2104, 0x2124,
+	0x2925, 0x2945, 0x2945, 0x2965, 0x3186, 0x3186, 0x39e7, 0x8c51, 0x9492, 0x8410, 0xc618, 0xc638,
+	0xc638, 0x6b4d, 0x4a49, 0x4a49, 0x4a69, 0x73ae, 0xbdf7, 0x4017, 0xc638, 0x8007, 0xa554, 0x9492,
+	0x9cf3, 0x738e, 0x6b6d, 0x6b4d, 0xa514, 0x4007, 0xc638, 0x801b, 0xbdf7, 0x73ae, 0x52aa, 0x52aa,
+	0x6b4d, 0x8410, 0xa514, 0xb5d6, 0xad55, 0x6b4d, 0x4228, 0x41e8, 0x39e7, 0x39c7, 0x39a7, 0x31a6,
+	0x3186, 0x3166, 0x2965, 0x2945, 0x2945, 0x2124, 0x2124, 0x2104, 0x2104, 0x20e4, 0x18e3, 0x4003,
+	0x18c3, 0x8005, 0x18a3, 0x10a2, 0x1082, 0x4228, 0x4a49, 0x8023, 0x39e7, 0x4a49, 0x10a2, 0x1062,
+	0x10a2, 0x10a2, 0x18a3, 0x18a3, 0x18c3, 0x18c3, 0x18e3, 0x20e4, 0x2104, 0x2104, 0x2124, 0x2925,
+	0x2945, 0x2945, 0x2965, 0x3186, 0x3186, 0x41e8, 0x4208, 0x4a49, 0xbdf7, 0xc638, 0xce59, 0xce59,
+	0x94d2, 0x4a49, 0x4a69, 0x4a69, 0x528a, 0xa514, 0xc638, 0x4014, 0xce59, 0x8004, 0xc638, 0xc638,
+	0xbdd7, 0x738e, 0x4003, 0x6b6d, 0x8001, 0x8c51, 0x400a, 0xce59, 0x8019, 0x8c71, 0x528a, 0x528a,
+	0x4a69, 0x4a49, 0x4a49, 0x630c, 0x7bcf, 0x5aeb, 0x4208, 0x39e7, 0x39c7, 0x39a7, 0x31a6, 0x3186,
+	0x3186, 0x2965, 0x2945, 0x2945, 0x2124, 0x2124, 0x2104, 0x2104, 0x20e4, 0x18e3, 0x4003, 0x18c3,
+	0x8005, 0x18a3, 0x10a2, 0x1082, 0x4208, 0x4a49, 0x8023, 0x39e7, 0x4a49, 0x10a2, 0x1062, 0x10a2,
+	0x10a2, 0x18a3, 0x18a3, 0x18c3, 0x18c3, 0x18e3, 0x20e4, 0x2104, 0x2104, 0x2124, 0x2925, 0x2945,
+	0x2965, 0x2965, 0x3186, 0x3186, 0x31a6, 0x4228, 0xad75, 0x94b2, 0xa534, 0xce59, 0xce59, 0xc638,
+	0x5aeb, 0x4a69, 0x4a69, 0x528a, 0x5aeb, 0xb5b6, 0x4014, 0xce59, 0x8008, 0xb5b6, 0x7bef, 0x9cf3,
+	0x7bef, 0x6b6d, 0x6b6d, 0x7bcf, 0xc638, 0x4005, 0xce59, 0x8003, 0xc638, 0xb596, 0xc638, 0x4003,
+	0xce59, 0x8018, 0xa514, 0x52aa, 0x4a69, 0x4a49, 0x4a49, 0x4228, 0x4228, 0x4208, 0x39e7, 0x39e7,
+	0x39c7, 0x39a7, 0x31a6, 0x3186, 0x3186, 0x2965, 0x2945, 0x2945, 0x2124, 0x2124, 0x2104, 0x2104,
+	0x20e4, 0x18e3, 0x4003, 0x18c3, 0x8005, 0x18a3, 0x10a2, 0x1062, 0x4208, 0x4a49, 0x8019, 0x39e7,
+	0x4a49, 0x10a2, 0x1062, 0x1082, 0x10a2, 0x18a3, 0x18a3, 0x18c3, 0x18c3, 0x18e3, 0x20e4, 0x2104,
+	0x2104, 0x2124, 0x2925, 0x2945, 0x2965, 0x2965, 0x3186, 0x3186, 0x39a7, 0x632c, 0x528a, 0x630c,
+	0x4004, 0xce79, 0x8008, 0x9cf3, 0x4a49, 0x4a69, 0x528a, 0x52aa, 0x6b6d, 0xbdf7, 0xce59, 0x4010,
+	0xce79, 0x8009, 0xc638, 0xb596, 0xc638, 0x73ae, 0x738e, 0x6b6d, 0x6b6d, 0x738e, 0xbdf7, 0x4007,
+	0xce79, 0x8025, 0xa534, 0x6b4d, 0x8c71, 0xb5d6, 0xce79, 0xce79, 0xb5b6, 0x630c, 0x4a49, 0x4a49,
+	0x4228, 0x4208, 0x4208, 0x39e7, 0x39c7, 0x39c7, 0x39a7, 0x31a6, 0x3186, 0x3186, 0x2965, 0x2945,
+	0x2945, 0x2124, 0x2124, 0x2104, 0x20e4, 0x20e4, 0x18e3, 0x18c3, 0x18c3, 0x18a3, 0x18a3, 0x10a2,
+	0x1062, 0x4208, 0x4a49, 0x8026, 0x39e7, 0x4a49, 0x10a2, 0x1062, 0x1082, 0x10a2, 0x18a3, 0x18a3,
+	0x18c3, 0x18c3, 0x18e3, 0x20e4, 0x2104, 0x2104, 0x2124, 0x2124, 0x2945, 0x2945, 0x2965, 0x3166,
+	0x3186, 0x31a6, 0x39a7, 0x4228, 0xc638, 0x9cf3, 0xbdd7, 0xce99, 0xce99, 0xce79, 0x6b6d, 0x4a69,
+	0x4a69, 0x528a, 0x52aa, 0x6b6d, 0xb596, 0xce59, 0x400d, 0xce99, 0x800a, 0xce79, 0xc618, 0xce79,
+	0x73ae, 0x8430, 0x7bcf, 0x6b6d, 0x6b6d, 0x738e, 0xb5b6, 0x4009, 0xce99, 0x8024, 0x9cf3, 0x5acb,
+	0x5aab, 0x738e, 0x94b2, 0xc638, 0xc658, 0x7bcf, 0x4a49, 0x4228, 0x4208, 0x4208, 0x39e7, 0x39c7,
+	0x39c7, 0x39a7, 0x3186, 0x3186, 0x3166, 0x2965, 0x2945, 0x2945, 0x2124, 0x2124, 0x2104, 0x2104,
+	0x20e4, 0x18e3, 0x18c3, 0x18c3, 0x18a3, 0x18a3, 0x10a2, 0x1062, 0x4208, 0x4a49, 0x801a, 0x39e7,
+	0x4a49, 0x10a2, 0x0861, 0x1082, 0x10a2, 0x18a3, 0x18a3, 0x18c3, 0x18c3, 0x18e3, 0x20e4, 0x2104,
+	0x2104, 0x2124, 0x2124, 0x2945, 0x2945, 0x2965, 0x2965, 0x3186, 0x31a6, 0x39e7, 0x8c51, 0x6b4d,
+	0x73ae, 0x4004, 0xd69a, 0x8009, 0xbe17, 0x5acb, 0x4a69, 0x528a, 0x528a, 0x52aa, 0x6b4d, 0x9cd3,
+	0xbdd7, 0x400a, 0xd69a, 0x8006, 0xce99, 0xc618, 0xce99, 0x7bef, 0x9cf3, 0x7bef, 0x4003, 0x6b6d,
+	0x8002, 0x73ae, 0xb5d6, 0x4006, 0xd69a, 0x8002, 0xc638, 0xce59, 0x4003, 0xd69a, 0x8016, 0x9cf3,
+	0x52aa, 0x528a, 0x528a, 0x52aa, 0x73ae, 0x9cf3, 0x8410, 0x4a49, 0x4208, 0x4208, 0x39e7, 0x39c7,
+	0x39c7, 0x31a6, 0x31a6, 0x3186, 0x2965, 0x2965, 0x2945, 0x2945, 0x2124, 0x4003, 0x2104, 0x800a,
+	0x18e3, 0x18e3, 0x18c3, 0x18c3, 0x18a3, 0x18a3, 0x10a2, 0x1062, 0x4208, 0x4a49, 0x800c, 0x39e7,
+	0x4a49, 0x10a2, 0x0861, 0x1082, 0x10a2, 0x10a2, 0x18a3, 0x18c3, 0x18c3, 0x18e3, 0x20e4, 0x4003,
+	0x2104, 0x800d, 0x2124, 0x2945, 0x2945, 0x2965, 0x3166, 0x3186, 0x3186, 0x39e7, 0x4208, 0x4208,
+	0xce79, 0xa534, 0xbdf7, 0x4003, 0xd6ba, 0x8001, 0xb596, 0x4003, 0x528a, 0x8012, 0x52aa, 0x5aab,
+	0x632c, 0x7bcf, 0xa534, 0xc618, 0xbdf7, 0xd6ba, 0xd69a, 0xd69a, 0xd6ba, 0xce59, 0xd6ba, 0xb596,
+	0xce79, 0x8410, 0xa534, 0x7bcf, 0x4004, 0x6b6d, 0x8002, 0x7bef, 0xbdf7, 0x4007, 0xd6ba, 0x801b,
+	0xc658, 0x8430, 0xa514, 0xd69a, 0xd6ba, 0xd6ba, 0x94b2, 0x528a, 0x528a, 0x4a69, 0x4a69, 0x4a49,
+	0x5acb, 0x4a69, 0x4208, 0x41e8, 0x39e7, 0x39c7, 0x39c7, 0x31a6, 0x3186, 0x3186, 0x2965, 0x2965,
+	0x2945, 0x2925, 0x2124, 0x4003, 0x2104, 0x8001, 0x18e3, 0x4003, 0x18c3, 0x8006, 0x18a3, 0x18a3,
+	0x1082, 0x0861, 0x4208, 0x4a49, 0x801b, 0x39e7, 0x4a49, 0x10a2, 0x0861, 0x1082, 0x10a2, 0x10a2,
+	0x18a3, 0x18c3, 0x18c3, 0x18e3, 0x18e3, 0x20e4, 0x2104, 0x2104, 0x2124, 0x2925, 0x2945, 0x2965,
+	0x2965, 0x3186, 0x3186, 0x31a6, 0x39c7, 0x9cd3, 0x8410, 0x6b6d, 0x4005, 0xd6ba, 0x8013, 0xad55,
+	0x52aa, 0x528a, 0x52aa, 0x52aa, 0x5aab, 0x5aeb, 0x5aeb, 0x8430, 0x8410, 0xa534, 0xa534, 0x9cf3,
+	0xbdd7, 0x8c51, 0xb5b6, 0x7bcf, 0x9492, 0x73ae, 0x4005, 0x6b6d, 0x8002, 0x8c71, 0xce59, 0x4009,
+	0xd6ba, 0x801e, 0xbdd7, 0x5acb, 0x738e, 0xa534, 0xd6ba, 0xd6ba, 0x8c71, 0x4a69, 0x4a69, 0x4a49,
+	0x4a49, 0x4228, 0x4208, 0x4208, 0x39e7, 0x39c7, 0x39c7, 0x39a7, 0x31a6, 0x3186, 0x3186, 0x2965,
+	0x2945, 0x2945, 0x2925, 0x2124, 0x2104, 0x2104, 0x20e4, 0x18e3, 0x4003, 0x18c3, 0x8006, 0x18a3,
+	0x10a2, 0x1082, 0x0861, 0x4208, 0x4a49, 0x801d, 0x39e7, 0x4a49, 0x10a2, 0x0841, 0x1082, 0x10a2,
+	0x10a2, 0x18a3, 0x18a3, 0x18c3, 0x18c3, 0x18e3, 0x20e4, 0x2104, 0x2104, 0x2124, 0x2925, 0x2945,
+	0x2945, 0x2965, 0x3166, 0x3186, 0x31a6, 0x4a49, 0x62ec, 0x39e7, 0xc618, 0xad75, 0xb5b6, 0x4004,
+	0xd6da, 0x800f, 0xb596, 0x630c, 0x528a, 0x52aa, 0x5aab, 0x5acb, 0x5acb, 0x5aeb, 0x630c, 0x632c,
+	0x6b4d, 0x6b4d, 0x7bcf, 0x6b6d, 0x6b6d, 0x4006, 0x6b4d, 0x8002, 0x738e, 0xa534, 0x4007, 0xd6da,
+	0x8002, 0xd6ba, 0xbdf7, 0x4003, 0xd6da, 0x801d, 0x9d13, 0x5acb, 0x52aa, 0x738e, 0xad75, 0xd6da,
+	0x8c51, 0x4a69, 0x4a49, 0x4a29, 0x4228, 0x4208, 0x4208, 0x39e7, 0x39c7, 0x39c7, 0x39a7, 0x31a6,
+	0x3186, 0x3166, 0x2965, 0x2945, 0x2945, 0x2925, 0x2124, 0x2104, 0x2104, 0x20e4, 0x18e3, 0x4003,
+	0x18c3, 0x8006, 0x18a3, 0x10a2, 0x1082, 0x0861, 0x4208, 0x4a49, 0x801e, 0x39e7, 0x4a49, 0x1082,
+	0x0841, 0x1062, 0x10a2, 0x10a2, 0x18a3, 0x18a3, 0x18c3, 0x18c3, 0x18e3, 0x20e4, 0x2104, 0x2104,
+	0x2124, 0x2124, 0x2945, 0x2945, 0x2965, 0x3166, 0x3186, 0x3186, 0x31a6, 0x39c7, 0x8410, 0xad55,
+	0x5aeb, 0xd6ba, 0xd6ba, 0x4004, 0xdedb, 0x8009, 0xce59, 0x7bef, 0x52aa, 0x52aa, 0x5aab, 0x5acb,
+	0x5acb, 0x5aeb, 0x5aeb, 0x4003, 0x630c, 0x4003, 0x632c, 0x8001, 0x6b2d, 0x4003, 0x6b4d, 0x8002,
+	0x9492, 0xce59, 0x4009, 0xdedb, 0x802a, 0xa514, 0x8c71, 0xd6ba, 0xdedb, 0xdedb, 0x7bef, 0x52aa,
+	0x528a, 0x528a, 0x738e, 0xb5d6, 0x7bcf, 0x4a49, 0x4228, 0x4228, 0x4208, 0x41e8, 0x39e7, 0x39c7,
+	0x39c7, 0x31a6, 0x3186, 0x3186, 0x2965, 0x2965, 0x2945, 0x2945, 0x2124, 0x2124, 0x2104, 0x2104,
+	0x20e4, 0x18e3, 0x18c3, 0x18c3, 0x18a3, 0x18a3, 0x10a2, 0x1082, 0x0841, 0x4208, 0x4a49, 0x800d,
+	0x39e7, 0x4a49, 0x1082, 0x0841, 0x1062, 0x1082, 0x10a2, 0x18a3, 0x18a3, 0x18c3, 0x18c3, 0x18e3,
+	0x20e4, 0x4003, 0x2104, 0x800e, 0x2124, 0x2925, 0x2945, 0x2965, 0x2965, 0x3186, 0x3186, 0x31a6,
+	0x4208, 0x7bef, 0x39e7, 0x9d13, 0xc658, 0xad55, 0x4006, 0xdefb, 0x8008, 0xb5b6, 0x73ae, 0x5acb,
+	0x5aab, 0x5acb, 0x5acb, 0x5aeb, 0x5aeb, 0x4004, 0x630c, 0x8005, 0x632c, 0x632c, 0x73ae, 0x94d2,
+	0xce59, 0x4008, 0xdefb, 0x802d, 0xdedb, 0xdefb, 0xdefb, 0xdedb, 0x6b4d, 0x738e, 0xbdf7, 0xdefb,
+	0xd69a, 0x632c, 0x528a, 0x528a, 0x4a69, 0x4a69, 0x6b6d, 0x52aa, 0x4228, 0x4208, 0x4208, 0x39e7,
+	0x39e7, 0x39c7, 0x39a7, 0x31a6, 0x3186, 0x3186, 0x2965, 0x2945, 0x2945, 0x2925, 0x2124, 0x2124,
+	0x2104, 0x2104, 0x18e3, 0x18e3, 0x18c3, 0x18c3, 0x18a3, 0x18a3, 0x10a2, 0x1062, 0x0841, 0x4208,
+	0x4a49, 0x8020, 0x39e7, 0x4a49, 0x1082, 0x0841, 0x0861, 0x1082, 0x10a2, 0x10a2, 0x18a3, 0x18c3,
+	0x18c3, 0x18e3, 0x18e3, 0x20e4, 0x2104, 0x2104, 0x2124, 0x2925, 0x2945, 0x2945, 0x2965, 0x3186,
+	0x3186, 0x31a6, 0x39c7, 0x39c7, 0x4a69, 0xc638, 0x5acb, 0xbdd7, 0xd6da, 0xce99, 0x4006, 0xdefb,
+	0x800d, 0xc658, 0xa514, 0x8410, 0x738e, 0x632c, 0x630c, 0x632c, 0x6b4d, 0x73ae, 0x8c51, 0xa514,
+	0xc618, 0xdedb, 0x400a, 0xdefb, 0x8023, 0xbdd7, 0xc618, 0xdefb, 0xdefb, 0xbdd7, 0x5acb, 0x5acb,
+	0x9cf3, 0xdefb, 0xbdf7, 0x528a, 0x4a69, 0x4a69, 0x4a49, 0x4a49, 0x4a29, 0x4228, 0x4208, 0x4208,
+	0x39e7, 0x39c7, 0x39c7, 0x31a6, 0x31a6, 0x3186, 0x3166, 0x2965, 0x2945, 0x2945, 0x2925, 0x2124,
+	0x2104, 0x2104, 0x20e4, 0x18e3, 0x4003, 0x18c3, 0x8007, 0x18a3, 0x18a3, 0x1082, 0x0861, 0x0841,
+	0x4208, 0x4a49, 0x8009, 0x39e7, 0x4a49, 0x1082, 0x0841, 0x0841, 0x1082, 0x10a2, 0x10a2, 0x18a3,
+	0x4003, 0x18c3, 0x8016, 0x18e3, 0x20e4, 0x2104, 0x2104, 0x2124, 0x2925, 0x2945, 0x2945, 0x2965,
+	0x3166, 0x3186, 0x3186, 0x31a6, 0x39a7, 0x8410, 0x632c, 0x5acb, 0xdf1b, 0x8c71, 0xce99, 0xdf1b,
+	0xdefb, 0x4007, 0xdf1b, 0x8005, 0xdefb, 0xd6da, 0xd6ba, 0xd6ba, 0xdedb, 0x400c, 0xdf1b, 0x8026,
+	0xdefb, 0xdf1b, 0xdf1b, 0xd69a, 0x6b6d, 0xbdd7, 0xdf1b, 0xdf1b, 0x7bef, 0x5aab, 0x52aa, 0x73ae,
+	0xd69a, 0x9cf3, 0x4a69, 0x4a69, 0x4a49, 0x4a29, 0x4228, 0x4208, 0x4208, 0x39e7, 0x39e7, 0x39c7,
+	0x39a7, 0x31a6, 0x3186, 0x3186, 0x3166, 0x2965, 0x2945, 0x2945, 0x2124, 0x2124, 0x2104, 0x2104,
+	0x20e4, 0x18e3, 0x4003, 0x18c3, 0x8007, 0x18a3, 0x10a2, 0x1082, 0x0861, 0x0841, 0x4208, 0x4a49,
+	0x8009, 0x39e7, 0x4a49, 0x1082, 0x0821, 0x0841, 0x1062, 0x1082, 0x10a2, 0x18a3, 0x4003, 0x18c3,
+	0x8018, 0x18e3, 0x20e4, 0x2104, 0x2104, 0x2124, 0x2124, 0x2925, 0x2945, 0x2965, 0x2965, 0x3186,
+	0x3186, 0x31a6, 0x39c7, 0x4a49, 0x39c7, 0x9d13, 0x9cf3, 0x738e, 0xe71c, 0xb596, 0xdefb, 0xdf1b,
+	0xdf1b, 0x4016, 0xe71c, 0x8012, 0xb5d6, 0xc658, 0xe71c, 0xe71c, 0x9492, 0x5aeb, 0xb596, 0xe71c,
+	0xce59, 0x5aab, 0x52aa, 0x528a, 0x5aeb, 0xad55, 0x73ae, 0x4a49, 0x4a29, 0x4228, 0x4003, 0x4208,
+	0x800c, 0x39e7, 0x39c7, 0x39c7, 0x31a6, 0x31a6, 0x3186, 0x3186, 0x2965, 0x2945, 0x2945, 0x2925,
+	0x2124, 0x4003, 0x2104, 0x800c, 0x18e3, 0x18e3, 0x18c3, 0x18c3, 0x18a3, 0x18a3, 0x10a2, 0x1082,
+	0x0841, 0x0821, 0x4208, 0x4a49, 0x8024, 0x39e7, 0x4a49, 0x1082, 0x0821, 0x0841, 0x0861, 0x1082,
+	0x10a2, 0x10a2, 0x18a3, 0x18c3, 0x18c3, 0x18e3, 0x20e4, 0x20e4, 0x2104, 0x2104, 0x2124, 0x2925,
+	0x2945, 0x2945, 0x2965, 0x3166, 0x3186, 0x3186, 0x31a6, 0x39a7, 0x4208, 0x9cd3, 0x4208, 0xad55,
+	0xbe17, 0x7bef, 0xe73c, 0xb5d6, 0xe71c, 0x4013, 0xe73c, 0x8028, 0xdedb, 0xe73c, 0xe73c, 0xc658,
+	0x6b6d, 0xd6ba, 0xe73c, 0xce79, 0x5acb, 0x5aab, 0xa514, 0xe73c, 0x8c71, 0x528a, 0x528a, 0x4a69,
+	0x4a69, 0x632c, 0x4a49, 0x4a29, 0x4228, 0x4208, 0x4208, 0x39e7, 0x39e7, 0x39c7, 0x39a7, 0x31a6,
+	0x3186, 0x3186, 0x3166, 0x2965, 0x2945, 0x2945, 0x2925, 0x2124, 0x2104, 0x2104, 0x20e4, 0x18e3,
+	0x4003, 0x18c3, 0x8008, 0x18a3, 0x18a3, 0x1082, 0x0861, 0x0841, 0x0821, 0x4208, 0x4a49, 0x800a,
+	0x39e7, 0x4a49, 0x1082, 0x0821, 0x0841, 0x0861, 0x1082, 0x10a2, 0x10a2, 0x18a3, 0x4003, 0x18c3,
+	0x8019, 0x18e3, 0x20e4, 0x2104, 0x2104, 0x2124, 0x2124, 0x2925, 0x2945, 0x2965, 0x2965, 0x3186,
+	0x3186, 0x31a6, 0x31a6, 0x4a69, 0x528a, 0x39e7, 0xc618, 0x630c, 0x94b2, 0xd6ba, 0x8430, 0xe73c,
+	0xd6ba, 0xdf1b, 0x400e, 0xe73c, 0x8022, 0xe71c, 0xe73c, 0xe73c, 0xbdf7, 0xb596, 0xe73c, 0xe73c,
+	0x738e, 0x73ae, 0xdf1b, 0xe73c, 0x7bef, 0x52aa, 0x52aa, 0x9cf3, 0xdefb, 0x5aeb, 0x4a69, 0x4a69,
+	0x4a49, 0x4a49, 0x4a29, 0x4228, 0x4208, 0x4208, 0x39e7, 0x39e7, 0x39c7, 0x39c7, 0x31a6, 0x31a6,
+	0x3186, 0x3186, 0x2965, 0x4003, 0x2945, 0x8006, 0x2124, 0x2124, 0x2104, 0x2104, 0x20e4, 0x18e3,
+	0x4003, 0x18c3, 0x8008, 0x18a3, 0x10a2, 0x1082, 0x0861, 0x0841, 0x0821, 0x4208, 0x4a49, 0x800a,
+	0x39e7, 0x4a49, 0x1082, 0x0020, 0x0821, 0x0841, 0x1062, 0x1082, 0x10a2, 0x18a3, 0x4003, 0x18c3,
+	0x801e, 0x18e3, 0x20e4, 0x20e4, 0x2104, 0x2104, 0x2124, 0x2925, 0x2945, 0x2945, 0x2965, 0x2965,
+	0x3186, 0x3186, 0x31a6, 0x39c7, 0x39c7, 0x630c, 0x8c71, 0x41e8, 0xc638, 0x8c51, 0x8410, 0xef5d,
+	0x94b2, 0xe73c, 0xdedb, 0xdedb, 0xef5d, 0xe73c, 0xe75c, 0x4003, 0xef5d, 0x8030, 0xe75c, 0xe75c,
+	0xef5d, 0xdefb, 0xe73c, 0xef5d, 0xc618, 0xce59, 0xef5d, 0xd6ba, 0x6b4d, 0xd6ba, 0xef5d, 0xad75,
+	0x5aab, 0x8410, 0xef5d, 0xc618, 0x52aa, 0x528a, 0x528a, 0x9492, 0x9cf3, 0x4a69, 0x4a49, 0x4a49,
+	0x4a29, 0x4228, 0x4208, 0x4208, 0x41e8, 0x39e7, 0x39c7, 0x39c7, 0x39a7, 0x31a6, 0x3186, 0x3186,
+	0x3166, 0x2965, 0x2945, 0x2945, 0x2925, 0x2124, 0x2104, 0x2104, 0x20e4, 0x20e4, 0x4003, 0x18c3,
+	0x8009, 0x18a3, 0x18a3, 0x10a2, 0x1082, 0x0841, 0x0821, 0x0821, 0x4208, 0x4a49, 0x800b, 0x39e7,
+	0x4a49, 0x1082, 0x0020, 0x0821, 0x0841, 0x0861, 0x1082, 0x10a2, 0x10a2, 0x18a3, 0x4003, 0x18c3,
+	0x803b, 0x18e3, 0x20e4, 0x2104, 0x2104, 0x2124, 0x2124, 0x2945, 0x2945, 0x2965, 0x2965, 0x3186,
+	0x3186, 0x31a6, 0x31a6, 0x39c7, 0x630c, 0x4a29, 0x4a49, 0xbdf7, 0x4228, 0x9cf3, 0xce79, 0x632c,
+	0xef7d, 0xad75, 0xc638, 0xef7d, 0xb596, 0xef5d, 0xe71c, 0xdedb, 0xef7d, 0xd6ba, 0xd6da, 0xef7d,
+	0xbdd7, 0xbdf7, 0xef7d, 0xc618, 0x8430, 0xef7d, 0xef7d, 0x6b6d, 0x7bef, 0xef7d, 0xd6ba, 0x5aab,
+	0x52aa, 0x9492, 0xef7d, 0x6b2d, 0x528a, 0x4a69, 0x4a69, 0x73ae, 0x5acb, 0x4a49, 0x4a49, 0x4228,
+	0x4003, 0x4208, 0x8012, 0x39e7, 0x39e7, 0x39c7, 0x39a7, 0x31a6, 0x3186, 0x3186, 0x3166, 0x2965,
+	0x2945, 0x2945, 0x2925, 0x2124, 0x2124, 0x2104, 0x2104, 0x20e4, 0x18e3, 0x4003, 0x18c3, 0x8009,
+	0x18a3, 0x10a2, 0x1082, 0x0861, 0x0841, 0x0821, 0x0020, 0x4208, 0x4a49, 0x800b, 0x39e7, 0x4a49,
+	0x1082, 0x0020, 0x0020, 0x0841, 0x0841, 0x1062, 0x10a2, 0x10a2, 0x18a3, 0x4003, 0x18c3, 0x8033,
+	0x18e3, 0x20e4, 0x20e4, 0x2104, 0x2104, 0x2124, 0x2925, 0x2945, 0x2945, 0x2965, 0x2965, 0x3186,
+	0x3186, 0x31a6, 0x31a6, 0x39c7, 0x39c7, 0x632c, 0x8430, 0x4208, 0xb5d6, 0x8c71, 0x630c, 0xef7d,
+	0x6b4d, 0xc638, 0xe73c, 0x7bef, 0xef7d, 0xd6ba, 0xa534, 0xef7d, 0xc638, 0xad55, 0xef7d, 0xbdf7,
+	0x8430, 0xef7d, 0xdedb, 0x5aab, 0xc618, 0xef7d, 0x94b2, 0x52aa, 0xad75, 0xef7d, 0x6b6d, 0x528a,
+	0x528a, 0xa534, 0xb596, 0x4003, 0x4a69, 0x8004, 0x4a49, 0x4a49, 0x4a29, 0x4228, 0x4003, 0x4208,
+	0x8009, 0x39e7, 0x39e7, 0x39c7, 0x39c7, 0x39a7, 0x31a6, 0x3186, 0x3186, 0x2965, 0x4003, 0x2945,
+	0x8006, 0x2925, 0x2124, 0x2104, 0x2104, 0x20e4, 0x20e4, 0x4003, 0x18c3, 0x800a, 0x18a3, 0x18a3,
+	0x10a2, 0x1082, 0x0841, 0x0841, 0x0821, 0x0020, 0x4208, 0x4a49, 0x800c, 0x39e7, 0x4a49, 0x1082,
+	0x0020, 0x0020, 0x0821, 0x0841, 0x0861, 0x1082, 0x10a2, 0x10a2, 0x18a3, 0x4003, 0x18c3, 0x8006,
+	0x18e3, 0x20e4, 0x2104, 0x2104, 0x2124, 0x2124, 0x4003, 0x2945, 0x802a, 0x2965, 0x2965, 0x3186,
+	0x3186, 0x31a6, 0x31a6, 0x39c7, 0x528a, 0x4a29, 0x41e8, 0xad75, 0x4a49, 0x738e, 0xdedb, 0x4a29,
+	0xce59, 0xd69a, 0x5aeb, 0xef9d, 0xbe17, 0x738e, 0xef9d, 0xbdf7, 0x6b6d, 0xef9d, 0xc638, 0x52aa,
+	0xdedb, 0xef7d, 0x5acb, 0x738e, 0xef9d, 0xb596, 0x528a, 0x5acb, 0xdedb, 0xa534, 0x528a, 0x4a69,
+	0x4a69, 0xa514, 0x630c, 0x4003, 0x4a49, 0x8002, 0x4a29, 0x4228, 0x4003, 0x4208, 0x8013, 0x39e7,
+	0x39e7, 0x39c7, 0x39c7, 0x39a7, 0x31a6, 0x3186, 0x3186, 0x3166, 0x2965, 0x2945, 0x2945, 0x2925,
+	0x2124, 0x2124, 0x2104, 0x2104, 0x20e4, 0x18e3, 0x4003, 0x18c3, 0x800a, 0x18a3, 0x18a3, 0x1082,
+	0x0861, 0x0841, 0x0821, 0x0020, 0x0020, 0x4208, 0x4a49, 0x800c, 0x39e7, 0x4a49, 0x1062, 0x0000,
+	0x0020, 0x0821, 0x0841, 0x0841, 0x1082, 0x10a2, 0x10a2, 0x18a3, 0x4003, 0x18c3, 0x8007, 0x18e3,
+	0x20e4, 0x20e4, 0x2104, 0x2104, 0x2124, 0x2124, 0x4003, 0x2945, 0x8025, 0x2965, 0x3166, 0x3186,
+	0x3186, 0x31a6, 0x39a7, 0x39c7, 0x39c7, 0x4a69, 0x8410, 0x4208, 0x7bef, 0xad55, 0x4228, 0xce59,
+	0xad55, 0x4a49, 0xef7d, 0xad55, 0x4a69, 0xef7d, 0xb5b6, 0x4a69, 0xdefb, 0xd69a, 0x528a, 0xa514,
+	0xf79e, 0x6b6d, 0x528a, 0xbdf7, 0xd69a, 0x528a, 0x528a, 0x73ae, 0xce79, 0x528a, 0x4003, 0x4a69,
+	0x8005, 0x5acb, 0x4a49, 0x4a49, 0x4228, 0x4228, 0x4003, 0x4208, 0x8006, 0x39e7, 0x39e7, 0x39c7,
+	0x39c7, 0x39a7, 0x31a6, 0x4003, 0x3186, 0x800a, 0x2965, 0x2965, 0x2945, 0x2945, 0x2124, 0x2124,
+	0x2104, 0x2104, 0x20e4, 0x20e4, 0x4003, 0x18c3, 0x800b, 0x18a3, 0x18a3, 0x10a2, 0x1082, 0x0861,
+	0x0841, 0x0821, 0x0020, 0x0000, 0x4208, 0x4a49, 0x800d, 0x39e7, 0x4a49, 0x1062, 0x0000, 0x0020,
+	0x0020, 0x0821, 0x0841, 0x0861, 0x1082, 0x10a2, 0x18a3, 0x18a3, 0x4003, 0x18c3, 0x8002, 0x18e3,
+	0x20e4, 0x4003, 0x2104, 0x8029, 0x2124, 0x2925, 0x2945, 0x2945, 0x2965, 0x2965, 0x3166, 0x3186,
+	0x3186, 0x31a6, 0x39a7, 0x39c7, 0x4228, 0x4a69, 0x39e7, 0x7bcf, 0x6b6d, 0x4208, 0xbdf7, 0x7bcf,
+	0x4a29, 0xd6da, 0x9492, 0x4a49, 0xdefb, 0xad75, 0x4a69, 0xb5b6, 0xdedb, 0x4a69, 0x630c, 0xef7d,
+	0x7bef, 0x4a69, 0x6b4d, 0xdf1b, 0x5acb, 0x4a69, 0x4a69, 0x9492, 0x6b4d, 0x4004, 0x4a49, 0x800c,
+	0x4a29, 0x4228, 0x4228, 0x4208, 0x4208, 0x41e8, 0x39e7, 0x39e7, 0x39c7, 0x39c7, 0x39a7, 0x31a6,
+	0x4003, 0x3186, 0x8006, 0x2965, 0x2965, 0x2945, 0x2945, 0x2925, 0x2124, 0x4003, 0x2104, 0x8002,
+	0x20e4, 0x18e3, 0x4003, 0x18c3, 0x800b, 0x18a3, 0x18a3, 0x10a2, 0x1062, 0x0841, 0x0821, 0x0020,
+	0x0020, 0x0000, 0x4208, 0x4a49, 0x800d, 0x39e7, 0x4a49, 0x1062, 0x0000, 0x0000, 0x0020, 0x0821,
+	0x0841, 0x0841, 0x1082, 0x10a2, 0x18a3, 0x18a3, 0x4003, 0x18c3, 0x8003, 0x18e3, 0x18e3, 0x20e4,
+	0x4003, 0x2104, 0x8006, 0x2124, 0x2925, 0x2945, 0x2945, 0x2965, 0x3166, 0x4003, 0x3186, 0x8024,
+	0x31a6, 0x39a7, 0x39c7, 0x39c7, 0x39e7, 0x5aeb, 0x4a29, 0x4208, 0x9cf3, 0x5acb, 0x4228, 0xbdf7,
+	0x7bcf, 0x4a29, 0xbdf7, 0xa534, 0x4a49, 0x8410, 0xd6da, 0x4a69, 0x4a69, 0xc618, 0x94b2, 0x4a69,
+	0x4a69, 0xa554, 0x7bef, 0x4a49, 0x4a49, 0x528a, 0x630c, 0x4a49, 0x4a49, 0x4a29, 0x4228, 0x4228,
+	0x4003, 0x4208, 0x4003, 0x39e7, 0x8004, 0x39c7, 0x39c7, 0x39a7, 0x31a6, 0x4003, 0x3186, 0x800b,
+	0x2965, 0x2965, 0x2945, 0x2945, 0x2925, 0x2124, 0x2124, 0x2104, 0x2104, 0x20e4, 0x18e3, 0x4003,
+	0x18c3, 0x800c, 0x18a3, 0x18a3, 0x10a2, 0x1082, 0x0861, 0x0841, 0x0821, 0x0020, 0x0000, 0x0000,
+	0x4208, 0x4a49, 0x800e, 0x39e7, 0x4a49, 0x1062, 0x0000, 0x0000, 0x0020, 0x0020, 0x0821, 0x0841,
+	0x0861, 0x1082, 0x10a2, 0x18a3, 0x18a3, 0x4003, 0x18c3, 0x8007, 0x18e3, 0x20e4, 0x20e4, 0x2104,
+	0x2104, 0x2124, 0x2124, 0x4003, 0x2945, 0x8023, 0x2965, 0x3166, 0x3186, 0x3186, 0x31a6, 0x31a6,
+	0x39a7, 0x39c7, 0x39c7, 0x39e7, 0x39e7, 0x41e8, 0x73ae, 0x4a29, 0x4208, 0x9cd3, 0x6b2d, 0x4228,
+	0x8c71, 0x9492, 0x4a49, 0x528a, 0xbdd7, 0x4a69, 0x4a49, 0x7bef, 0xa514, 0x4a49, 0x4a49, 0x630c,
+	0x8410, 0x4a49, 0x4a49, 0x4a29, 0x4a29, 0x4003, 0x4228, 0x4004, 0x4208, 0x8002, 0x39e7, 0x39e7,
+	0x4003, 0x39c7, 0x8002, 0x39a7, 0x31a6, 0x4003, 0x3186, 0x800c, 0x2965, 0x2965, 0x2945, 0x2945,
+	0x2925, 0x2124, 0x2124, 0x2104, 0x2104, 0x20e4, 0x20e4, 0x18e3, 0x4003, 0x18c3, 0x800c, 0x18a3,
+	0x10a2, 0x1082, 0x0861, 0x0841, 0x0821, 0x0020, 0x0020, 0x0000, 0x0000, 0x4208, 0x4a49, 0x8003,
+	0x39e7, 0x4a49, 0x1062, 0x4003, 0x0000, 0x8009, 0x0020, 0x0821, 0x0841, 0x0841, 0x1062, 0x1082,
+	0x10a2, 0x18a3, 0x18a3, 0x4003, 0x18c3, 0x8007, 0x18e3, 0x20e4, 0x20e4, 0x2104, 0x2104, 0x2124,
+	0x2124, 0x4003, 0x2945, 0x8004, 0x2965, 0x3166, 0x3186, 0x3186, 0x4003, 0x31a6, 0x4003, 0x39c7,
+	0x8014, 0x39e7, 0x4208, 0x41e8, 0x4208, 0x6b6d, 0x528a, 0x4208, 0x632c, 0x738e, 0x4228, 0x4228,
+	0x9492, 0x528a, 0x4a29, 0x4a69, 0x7bef, 0x4a49, 0x4a29, 0x4a29, 0x4a69, 0x4005, 0x4228, 0x4004,
+	0x4208, 0x4003, 0x39e7, 0x8005, 0x39c7, 0x39c7, 0x39a7, 0x39a7, 0x31a6, 0x4003, 0x3186, 0x8007,
+	0x2965, 0x2965, 0x2945, 0x2945, 0x2925, 0x2124, 0x2124, 0x4003, 0x2104, 0x8002, 0x20e4, 0x18e3,
+	0x4003, 0x18c3, 0x8008, 0x18a3, 0x18a3, 0x10a2, 0x1082, 0x0841, 0x0841, 0x0821, 0x0020, 0x4003,
+	0x0000, 0x8002, 0x4208, 0x4a49, 0x8003, 0x39e7, 0x4a49, 0x1062, 0x4003, 0x0000, 0x8009, 0x0020,
+	0x0020, 0x0821, 0x0841, 0x0861, 0x1082, 0x10a2, 0x18a3, 0x18a3, 0x4003, 0x18c3, 0x8003, 0x18e3,
+	0x18e3, 0x20e4, 0x4003, 0x2104, 0x8002, 0x2124, 0x2124, 0x4003, 0x2945, 0x8002, 0x2965, 0x2965,
+	0x4003, 0x3186, 0x8003, 0x31a6, 0x31a6, 0x39a7, 0x4003, 0x39c7, 0x8002, 0x39e7, 0x39e7, 0x4003,
+	0x4208, 0x8009, 0x4a49, 0x4a69, 0x4208, 0x4208, 0x5acb, 0x4a69, 0x4228, 0x4228, 0x4a49, 0x4004,
+	0x4228, 0x4007, 0x4208, 0x4003, 0x39e7, 0x4003, 0x39c7, 0x8003, 0x39a7, 0x31a6, 0x31a6, 0x4003,
+	0x3186, 0x8002, 0x2965, 0x2965, 0x4003, 0x2945, 0x8002, 0x2124, 0x2124, 0x4003, 0x2104, 0x8002,
+	0x20e4, 0x18e3, 0x4004, 0x18c3, 0x8008, 0x18a3, 0x10a2, 0x1082, 0x0861, 0x0841, 0x0821, 0x0020,
+	0x0020, 0x4003, 0x0000, 0x8002, 0x4208, 0x4a49, 0x8003, 0x39e7, 0x4a49, 0x1062, 0x4004, 0x0000,
+	0x8009, 0x0020, 0x0020, 0x0841, 0x0841, 0x0861, 0x1082, 0x10a2, 0x18a3, 0x18a3, 0x4003, 0x18c3,
+	0x8003, 0x18e3, 0x18e3, 0x20e4, 0x4003, 0x2104, 0x8002, 0x2124, 0x2124, 0x4003, 0x2945, 0x8005,
+	0x2965, 0x2965, 0x3166, 0x3186, 0x3186, 0x4003, 0x31a6, 0x4004, 0x39c7, 0x4003, 0x39e7, 0x8001,
+	0x41e8, 0x4010, 0x4208, 0x4004, 0x39e7, 0x4003, 0x39c7, 0x8003, 0x39a7, 0x39a7, 0x31a6, 0x4004,
+	0x3186, 0x8002, 0x2965, 0x2965, 0x4003, 0x2945, 0x8002, 0x2124, 0x2124, 0x4003, 0x2104, 0x8002,
+	0x20e4, 0x20e4, 0x4004, 0x18c3, 0x8008, 0x18a3, 0x10a2, 0x10a2, 0x1062, 0x0841, 0x0841, 0x0821,
+	0x0020, 0x4004, 0x0000, 0x8002, 0x4208, 0x4a49, 0x8003, 0x39e7, 0x4a49, 0x1062, 0x4004, 0x0000,
+	0x800a, 0x0020, 0x0020, 0x0821, 0x0841, 0x0841, 0x1062, 0x1082, 0x10a2, 0x18a3, 0x18a3, 0x4003,
+	0x18c3, 0x8003, 0x18e3, 0x18e3, 0x20e4, 0x4003, 0x2104, 0x8002, 0x2124, 0x2124, 0x4003, 0x2945,
+	0x8003, 0x2965, 0x2965, 0x3166, 0x4003, 0x3186, 0x8003, 0x31a6, 0x31a6, 0x39a7, 0x4005, 0x39c7,
+	0x4005, 0x39e7, 0x4007, 0x4208, 0x8001, 0x41e8, 0x4006, 0x39e7, 0x4003, 0x39c7, 0x8004, 0x39a7,
+	0x39a7, 0x31a6, 0x31a6, 0x4003, 0x3186, 0x8008, 0x3166, 0x2965, 0x2965, 0x2945, 0x2945, 0x2925,
+	0x2124, 0x2124, 0x4003, 0x2104, 0x8003, 0x20e4, 0x20e4, 0x18e3, 0x4003, 0x18c3, 0x8009, 0x18a3,
+	0x18a3, 0x10a2, 0x1082, 0x0861, 0x0841, 0x0821, 0x0020, 0x0020, 0x4004, 0x0000, 0x8002, 0x4208,
+	0x4a49, 0x8003, 0x39e7, 0x4a49, 0x1062, 0x4005, 0x0000, 0x800a, 0x0020, 0x0020, 0x0821, 0x0841,
+	0x0861, 0x1082, 0x10a2, 0x10a2, 0x18a3, 0x18a3, 0x4003, 0x18c3, 0x8003, 0x18e3, 0x20e4, 0x20e4,
+	0x4003, 0x2104, 0x8009, 0x2124, 0x2124, 0x2925, 0x2945, 0x2945, 0x2965, 0x2965, 0x3166, 0x3166,
+	0x4003, 0x3186, 0x8004, 0x31a6, 0x31a6, 0x39a7, 0x39a7, 0x4006, 0x39c7, 0x400b, 0x39e7, 0x4005,
+	0x39c7, 0x8004, 0x39a7, 0x39a7, 0x31a6, 0x31a6, 0x4004, 0x3186, 0x4003, 0x2965, 0x8005, 0x2945,
+	0x2945, 0x2925, 0x2124, 0x2124, 0x4003, 0x2104, 0x8003, 0x20e4, 0x20e4, 0x18e3, 0x4003, 0x18c3,
+	0x8009, 0x18a3, 0x18a3, 0x10a2, 0x1082, 0x0861, 0x0841, 0x0821, 0x0020, 0x0020, 0x4005, 0x0000,
+	0x8002, 0x4208, 0x4a49, 0x8003, 0x39e7, 0x4a49, 0x1062, 0x4006, 0x0000, 0x8009, 0x0020, 0x0020,
+	0x0821, 0x0841, 0x0861, 0x1082, 0x10a2, 0x18a3, 0x18a3, 0x4004, 0x18c3, 0x8005, 0x18e3, 0x20e4,
+	0x20e4, 0x2104, 0x2104, 0x4003, 0x2124, 0x4004, 0x2945, 0x8003, 0x2965, 0x2965, 0x3166, 0x4004,
+	0x3186, 0x8004, 0x31a6, 0x31a6, 0x39a7, 0x39a7, 0x4011, 0x39c7, 0x8002, 0x39a7, 0x39a7, 0x4003,
+	0x31a6, 0x4004, 0x3186, 0x8003, 0x3166, 0x2965, 0x2965, 0x4003, 0x2945, 0x8003, 0x2925, 0x2124,
+	0x2124, 0x4003, 0x2104, 0x8003, 0x20e4, 0x20e4, 0x18e3, 0x4004, 0x18c3, 0x8008, 0x18a3, 0x10a2,
+	0x1082, 0x0861, 0x0841, 0x0821, 0x0821, 0x0020, 0x4006, 0x0000, 0x8002, 0x4208, 0x4a49, 0x8003,
+	0x39e7, 0x4a49, 0x1062, 0x4006, 0x0000, 0x800a, 0x0020, 0x0020, 0x0821, 0x0841, 0x0841, 0x1062,
+	0x1082, 0x10a2, 0x18a3, 0x18a3, 0x4004, 0x18c3, 0x8003, 0x18e3, 0x18e3, 0x20e4, 0x4003, 0x2104,
+	0x8003, 0x2124, 0x2124, 0x2925, 0x4003, 0x2945, 0x4003, 0x2965, 0x4005, 0x3186, 0x4004, 0x31a6,
+	0x4004, 0x39a7, 0x4005, 0x39c7, 0x4005, 0x39a7, 0x4003, 0x31a6, 0x4005, 0x3186, 0x8001, 0x3166,
+	0x4003, 0x2965, 0x4003, 0x2945, 0x8003, 0x2925, 0x2124, 0x2124, 0x4003, 0x2104, 0x8003, 0x20e4,
+	0x20e4, 0x18e3, 0x4004, 0x18c3, 0x8009, 0x18a3, 0x10a2, 0x10a2, 0x1062, 0x0841, 0x0841, 0x0821,
+	0x0020, 0x0020, 0x4006, 0x0000, 0x8002, 0x4208, 0x4a49, 0x8003, 0x39e7, 0x4a49, 0x1062, 0x4007,
+	0x0000, 0x800a, 0x0020, 0x0020, 0x0821, 0x0841, 0x0841, 0x1062, 0x10a2, 0x10a2, 0x18a3, 0x18a3,
+	0x4004, 0x18c3, 0x8003, 0x18e3, 0x18e3, 0x20e4, 0x4003, 0x2104, 0x4003, 0x2124, 0x4004, 0x2945,
+	0x4003, 0x2965, 0x8001, 0x3166, 0x4005, 0x3186, 0x400f, 0x31a6, 0x4006, 0x3186, 0x8001, 0x3166,
+	0x4003, 0x2965, 0x4003, 0x2945, 0x8001, 0x2925, 0x4003, 0x2124, 0x4003, 0x2104, 0x8003, 0x20e4,
+	0x20e4, 0x18e3, 0x4004, 0x18c3, 0x8009, 0x18a3, 0x10a2, 0x10a2, 0x1082, 0x0841, 0x0841, 0x0821,
+	0x0020, 0x0020, 0x4007, 0x0000, 0x8002, 0x4208, 0x4a49, 0x8003, 0x39e7, 0x4a49, 0x1062, 0x4008,
+	0x0000, 0x800a, 0x0020, 0x0020, 0x0821, 0x0841, 0x0841, 0x1062, 0x10a2, 0x10a2, 0x18a3, 0x18a3,
+	0x4004, 0x18c3, 0x8003, 0x18e3, 0x18e3, 0x20e4, 0x4003, 0x2104, 0x4004, 0x2124, 0x4004, 0x2945,
+	0x4004, 0x2965, 0x8001, 0x3166, 0x4014, 0x3186, 0x8001, 0x3166, 0x4004, 0x2965, 0x4003, 0x2945,
+	0x8004, 0x2925, 0x2925, 0x2124, 0x2124, 0x4004, 0x2104, 0x8003, 0x20e4, 0x20e4, 0x18e3, 0x4004,
+	0x18c3, 0x8009, 0x18a3, 0x18a3, 0x10a2, 0x1082, 0x0861, 0x0841, 0x0821, 0x0020, 0x0020, 0x4008,
+	0x0000, 0x8002, 0x4208, 0x4a49, 0x8003, 0x39e7, 0x4a49, 0x1062, 0x4009, 0x0000, 0x800a, 0x0020,
+	0x0020, 0x0821, 0x0841, 0x0861, 0x1062, 0x10a2, 0x10a2, 0x18a3, 0x18a3, 0x4004, 0x18c3, 0x8004,
+	0x18e3, 0x18e3, 0x20e4, 0x20e4, 0x4003, 0x2104, 0x8002, 0x2124, 0x4a69, 0x4003, 0x632c, 0x8001,
+	0x4a49, 0x4003, 0x2945, 0x4005, 0x2965, 0x8001, 0x3166, 0x400c, 0x3186, 0x8001, 0x3166, 0x4004,
+	0x2965, 0x8002, 0x4a69, 0x4a69, 0x4004, 0x2945, 0x8001, 0x2925, 0x4003, 0x2124, 0x4003, 0x2104,
+	0x8004, 0x20e4, 0x20e4, 0x18e3, 0x18e3, 0x4004, 0x18c3, 0x8009, 0x18a3, 0x18a3, 0x10a2, 0x1082,
+	0x0861, 0x0841, 0x0821, 0x0821, 0x0020, 0x4009, 0x0000, 0x8002, 0x4208, 0x4a49, 0x8003, 0x39e7,
+	0x4a49, 0x1062, 0x400a, 0x0000, 0x8008, 0x0020, 0x0020, 0x0821, 0x0841, 0x0861, 0x1062, 0x10a2,
+	0x10a2, 0x4003, 0x18a3, 0x4004, 0x18c3, 0x800c, 0x18e3, 0x20e4, 0x20e4, 0x2104, 0x2104, 0x528a,
+	0x5acb, 0x2965, 0x2124, 0x3186, 0x5aeb, 0x4a49, 0x4005, 0x2945, 0x4013, 0x2965, 0x8006, 0x2945,
+	0x4a69, 0x4a69, 0x2945, 0x2925, 0x2925, 0x4003, 0x2124, 0x4004, 0x2104, 0x8004, 0x20e4, 0x20e4,
+	0x18e3, 0x18e3, 0x4004, 0x18c3, 0x8009, 0x18a3, 0x10a2, 0x10a2, 0x1082, 0x0861, 0x0841, 0x0821,
+	0x0821, 0x0020, 0x400a, 0x0000, 0x8002, 0x4208, 0x4a49, 0x8003, 0x39e7, 0x4a49, 0x1062, 0x400a,
+	0x0000, 0x4003, 0x0020, 0x8006, 0x0821, 0x0841, 0x0861, 0x1062, 0x10a2, 0x10a2, 0x4003, 0x18a3,
+	0x4004, 0x18c3, 0x8030, 0x18e3, 0x18e3, 0x20e4, 0x2965, 0x630c, 0x2925, 0x2104, 0x2104, 0x2124,
+	0x39a7, 0x630c, 0x2124, 0x4228, 0x632c, 0x632c, 0x5acb, 0x31a6, 0x2945, 0x632c, 0x52aa, 0x632c,
+	0x632c, 0x4a69, 0x2945, 0x3186, 0x5acb, 0x632c, 0x632c, 0x4a49, 0x2965, 0x39c7, 0x5aeb, 0x632c,
+	0x630c, 0x4208, 0x2945, 0x4a69, 0x4a69, 0x2124, 0x3166, 0x5acb, 0x632c, 0x632c, 0x4a29, 0x2104,
+	0x2104, 0x20e4, 0x20e4, 0x4003, 0x18e3, 0x4003, 0x18c3, 0x800b, 0x18a3, 0x18a3, 0x10a2, 0x10a2,
+	0x1082, 0x0861, 0x0841, 0x0821, 0x0821, 0x0020, 0x0020, 0x400a, 0x0000, 0x8002, 0x4208, 0x4a49,
+	0x8003, 0x39e7, 0x4a49, 0x1062, 0x400b, 0x0000, 0x4003, 0x0020, 0x8009, 0x0821, 0x0841, 0x0841,
+	0x1062, 0x1082, 0x10a2, 0x10a2, 0x18a3, 0x18a3, 0x4005, 0x18c3, 0x8004, 0x18e3, 0x39c7, 0x52aa,
+	0x20e4, 0x4004, 0x2104, 0x8027, 0x2124, 0x31a6, 0x632c, 0x39a7, 0x2925, 0x4228, 0x5aeb, 0x2945,
+	0x632c, 0x5acb, 0x2965, 0x4228, 0x632c, 0x2965, 0x4a49, 0x4a69, 0x2945, 0x31a6, 0x632c, 0x31a6,
+	0x630c, 0x4228, 0x2945, 0x39c7, 0x632c, 0x3166, 0x4a69, 0x4a69, 0x2124, 0x5acb, 0x39e7, 0x2104,
+	0x2945, 0x630c, 0x3186, 0x20e4, 0x20e4, 0x18e3, 0x18e3, 0x4004, 0x18c3, 0x800b, 0x18a3, 0x18a3,
+	0x10a2, 0x10a2, 0x1082, 0x0861, 0x0841, 0x0821, 0x0821, 0x0020, 0x0020, 0x400b, 0x0000, 0x8002,
+	0x4208, 0x4a49, 0x8003, 0x39e7, 0x4a49, 0x1062, 0x400c, 0x0000, 0x4003, 0x0020, 0x8009, 0x0821,
+	0x0841, 0x0841, 0x1062, 0x1082, 0x10a2, 0x10a2, 0x18a3, 0x18a3, 0x4005, 0x18c3, 0x8002, 0x39c7,
+	0x528a, 0x4003, 0x20e4, 0x4003, 0x2104, 0x8014, 0x4208, 0x52aa, 0x2124, 0x2124, 0x2945, 0x632c,
+	0x3166, 0x632c, 0x4228, 0x2925, 0x39c7, 0x632c, 0x3186, 0x39e7, 0x632c, 0x4a69, 0x4a69, 0x2945,
+	0x39c7, 0x632c, 0x4003, 0x2124, 0x8005, 0x5acb, 0x41e8, 0x4a69, 0x4a49, 0x2945, 0x4005, 0x632c,
+	0x8001, 0x39c7, 0x4003, 0x18e3, 0x4004, 0x18c3, 0x800b, 0x18a3, 0x18a3, 0x10a2, 0x1082, 0x1062,
+	0x0841, 0x0841, 0x0821, 0x0821, 0x0020, 0x0020, 0x400c, 0x0000, 0x8002, 0x4208, 0x4a49, 0x8003,
+	0x39e7, 0x4a49, 0x1062, 0x400d, 0x0000, 0x4003, 0x0020, 0x8009, 0x0821, 0x0841, 0x0841, 0x0861,
+	0x1082, 0x10a2, 0x10a2, 0x18a3, 0x18a3, 0x4004, 0x18c3, 0x8028, 0x2945, 0x630c, 0x2104, 0x18e3,
+	0x18e3, 0x20e4, 0x3186, 0x632c, 0x4208, 0x528a, 0x2104, 0x2104, 0x2945, 0x632c, 0x2965, 0x632c,
+	0x41e8, 0x2124, 0x39a7, 0x632c, 0x2965, 0x2124, 0x2124, 0x4228, 0x4a69, 0x632c, 0x4228, 0x630c,
+	0x2124, 0x2124, 0x2104, 0x5acb, 0x39e7, 0x4a49, 0x4a49, 0x2945, 0x632c, 0x2124, 0x20e4, 0x20e4,
+	0x4003, 0x18e3, 0x4004, 0x18c3, 0x800c, 0x18a3, 0x18a3, 0x10a2, 0x10a2, 0x1082, 0x0861, 0x0841,
+	0x0841, 0x0821, 0x0821, 0x0020, 0x0020, 0x400d, 0x0000, 0x8002, 0x4208, 0x4a49, 0x8003, 0x39c7,
+	0x4a49, 0x10a2, 0x400f, 0x0000, 0x800c, 0x0020, 0x0020, 0x0821, 0x0841, 0x0841, 0x0861, 0x1062,
+	0x1082, 0x10a2, 0x10a2, 0x18a3, 0x18a3, 0x4003, 0x18c3, 0x8029, 0x528a, 0x5aab, 0x2124, 0x18e3,
+	0x2965, 0x5aab, 0x4228, 0x3186, 0x632c, 0x2965, 0x2104, 0x4228, 0x5aeb, 0x2104, 0x632c, 0x39e7,
+	0x2104, 0x31a6, 0x632c, 0x2965, 0x528a, 0x528a, 0x2104, 0x2925, 0x5aeb, 0x39c7, 0x630c, 0x4208,
+	0x2104, 0x39c7, 0x632c, 0x2945, 0x4a49, 0x4a49, 0x20e4, 0x5aeb, 0x4208, 0x18e3, 0x3186, 0x632c,
+	0x2124, 0x4004, 0x18c3, 0x800b, 0x18a3, 0x18a3, 0x10a2, 0x10a2, 0x1082, 0x0861, 0x0841, 0x0841,
+	0x0821, 0x0020, 0x0020, 0x400f, 0x0000, 0x8002, 0x4228, 0x4a49, 0x8003, 0x3186, 0x4a49, 0x18c3,
+	0x4010, 0x0000, 0x800a, 0x0020, 0x0020, 0x0821, 0x0821, 0x0841, 0x0841, 0x1062, 0x1082, 0x10a2,
+	0x10a2, 0x4003, 0x18a3, 0x8003, 0x18c3, 0x20e4, 0x4a69, 0x4003, 0x632c, 0x8023, 0x41e8, 0x18e3,
+	0x18e3, 0x4208, 0x632c, 0x632c, 0x5acb, 0x2965, 0x2104, 0x632c, 0x39e7, 0x2104, 0x31a6, 0x632c,
+	0x2945, 0x2945, 0x5aeb, 0x632c, 0x632c, 0x528a, 0x2104, 0x3186, 0x630c, 0x632c, 0x630c, 0x39e7,
+	0x20e4, 0x4a49, 0x4a49, 0x18e3, 0x2945, 0x5aab, 0x632c, 0x632c, 0x39e7, 0x4003, 0x18c3, 0x800c,
+	0x18a3, 0x18a3, 0x10a2, 0x10a2, 0x1082, 0x1062, 0x0861, 0x0841, 0x0821, 0x0821, 0x0020, 0x0020,
+	0x4010, 0x0000, 0x8002, 0x4a49, 0x4a49, 0x8003, 0x2124, 0x4a49, 0x2945, 0x4011, 0x0000, 0x4003,
+	0x0020, 0x8008, 0x0821, 0x0841, 0x0841, 0x0861, 0x1062, 0x1082, 0x10a2, 0x10a2, 0x4003, 0x18a3,
+	0x4007, 0x18c3, 0x4006, 0x18e3, 0x4010, 0x20e4, 0x4003, 0x18e3, 0x4008, 0x18c3, 0x4003, 0x18a3,
+	0x800a, 0x10a2, 0x1082, 0x1082, 0x0861, 0x0841, 0x0841, 0x0821, 0x0821, 0x0020, 0x0020, 0x4010,
+	0x0000, 0x8003, 0x1082, 0x4a49, 0x39c7, 0x8003, 0x1082, 0x4a49, 0x41e8, 0x4012, 0x0000, 0x4003,
+	0x0020, 0x8001, 0x0821, 0x4003, 0x0841, 0x8005, 0x0861, 0x1082, 0x1082, 0x10a2, 0x10a2, 0x4003,
+	0x18a3, 0x400a, 0x18c3, 0x4005, 0x18e3, 0x4005, 0x20e4, 0x4005, 0x18e3, 0x400b, 0x18c3, 0x4003,
+	0x18a3, 0x8004, 0x10a2, 0x10a2, 0x1082, 0x0861, 0x4003, 0x0841, 0x8001, 0x0821, 0x4003, 0x0020,
+	0x4011, 0x0000, 0x8003, 0x2124, 0x4a49, 0x2945, 0x8004, 0x0000, 0x39c7, 0x4a49, 0x10a2, 0x4013,
+	0x0000, 0x4003, 0x0020, 0x8009, 0x0821, 0x0841, 0x0841, 0x0861, 0x1062, 0x1082, 0x1082, 0x10a2,
+	0x10a2, 0x4004, 0x18a3, 0x401e, 0x18c3, 0x4003, 0x18a3, 0x4003, 0x10a2, 0x8009, 0x1082, 0x1062,
+	0x0861, 0x0841, 0x0841, 0x0821, 0x0821, 0x0020, 0x0020, 0x4012, 0x0000, 0x8004, 0x0020, 0x4228,
+	0x4a49, 0x10a2, 0x8004, 0x0000, 0x2124, 0x4a49, 0x39e7, 0x4014, 0x0000, 0x4003, 0x0020, 0x800a,
+	0x0821, 0x0821, 0x0841, 0x0841, 0x0861, 0x0861, 0x1062, 0x1082, 0x10a2, 0x10a2, 0x4006, 0x18a3,
+	0x4017, 0x18c3, 0x4004, 0x18a3, 0x800a, 0x10a2, 0x10a2, 0x1082, 0x1082, 0x0861, 0x0861, 0x0841,
+	0x0841, 0x0821, 0x0821, 0x4003, 0x0020, 0x4013, 0x0000, 0x8004, 0x2124, 0x4a49, 0x31a6, 0x0000,
+	0x8005, 0x0000, 0x0000, 0x39c7, 0x4a49, 0x2945, 0x4015, 0x0000, 0x4003, 0x0020, 0x8002, 0x0821,
+	0x0821, 0x4003, 0x0841, 0x8006, 0x0861, 0x1062, 0x1082, 0x1082, 0x10a2, 0x10a2, 0x4009, 0x18a3,
+	0x400c, 0x18c3, 0x4006, 0x18a3, 0x4003, 0x10a2, 0x8003, 0x1082, 0x1082, 0x0861, 0x4003, 0x0841,
+	0x8002, 0x0821, 0x0821, 0x4003, 0x0020, 0x4014, 0x0000, 0x8005, 0x1082, 0x4a49, 0x4a49, 0x10a2,
+	0x0000, 0x8006, 0x0000, 0x0000, 0x1082, 0x4a49, 0x4a49, 0x2104, 0x4016, 0x0000, 0x4003, 0x0020,
+	0x8002, 0x0821, 0x0821, 0x4003, 0x0841, 0x8002, 0x0861, 0x0861, 0x4003, 0x1082, 0x4004, 0x10a2,
+	0x4011, 0x18a3, 0x4004, 0x10a2, 0x4003, 0x1082, 0x8002, 0x0861, 0x0861, 0x4003, 0x0841, 0x8002,
+	0x0821, 0x0821, 0x4003, 0x0020, 0x4015, 0x0000, 0x8006, 0x1062, 0x4228, 0x4a49, 0x2965, 0x0000,
+	0x0000, 0x4003, 0x0000, 0x8005, 0x18c3, 0x4a49, 0x4a49, 0x2965, 0x0020, 0x4016, 0x0000, 0x4003,
+	0x0020, 0x4003, 0x0821, 0x4003, 0x0841, 0x8003, 0x0861, 0x0861, 0x1062, 0x4004, 0x1082, 0x4010,
+	0x10a2, 0x4003, 0x1082, 0x8003, 0x1062, 0x0861, 0x0861, 0x4003, 0x0841, 0x4003, 0x0821, 0x4003,
+	0x0020, 0x4016, 0x0000, 0x8004, 0x18c3, 0x4a49, 0x4a49, 0x3186, 0x4003, 0x0000, 0x4004, 0x0000,
+	0x8006, 0x18c3, 0x4a49, 0x4a49, 0x4228, 0x20e4, 0x0821, 0x4016, 0x0000, 0x4003, 0x0020, 0x4004,
+	0x0821, 0x4004, 0x0841, 0x4003, 0x0861, 0x8002, 0x1062, 0x1062, 0x400b, 0x1082, 0x8002, 0x1062,
+	0x1062, 0x4003, 0x0861, 0x4004, 0x0841, 0x4004, 0x0821, 0x4003, 0x0020, 0x4016, 0x0000, 0x8005,
+	0x10a2, 0x39c7, 0x4a49, 0x4a49, 0x3166, 0x4004, 0x0000, 0x4005, 0x0000, 0x8002, 0x1062, 0x39a7,
+	0x4003, 0x4a49, 0x8003, 0x31a6, 0x2965, 0x2124, 0x4011, 0x20e4, 0x4010, 0x2104, 0x4010, 0x2124,
+	0x400f, 0x2104, 0x4010, 0x20e4, 0x8008, 0x2104, 0x2965, 0x3186, 0x4228, 0x4a49, 0x4a49, 0x39e7,
+	0x20e4, 0x4005, 0x0000, 0x4007, 0x0000, 0x8003, 0x18e3, 0x31a6, 0x4228, 0x4057, 0x4a49, 0x8002,
+	0x39c7, 0x2124, 0x4007, 0x0000, 0x4009, 0x0000, 0x8004, 0x0020, 0x18a3, 0x20e4, 0x2124, 0x4050,
+	0x2965, 0x8004, 0x2945, 0x20e4, 0x18c3, 0x0841, 0x4009, 0x0000,
+};
+
+const int dataConsoleSelectedRLE_width = 106;
+const int dataConsoleSelectedRLE_height = 107;
@@ -0,0 +1,340 @@
+const uint16_t dataHeaderRLE[] = {
+	0x40d5, 0x0000, 0x8008, 0x0841, 0x1082, 0x18c3, 0x20e4, 0x18e3, 0x18c3, 0x1082, 0x0841, 0x4006,
+	0x0000, 0x40d3, 0x0000, 0x800d, 0x1082, 0x2945, 0x4208, 0x4a69, 0x52aa, 0x528a, 0x4a69, 0x4228,
+	0x31a6, 0x2124, 0x18c3, 0x0841, 0x0020, 0x4003, 0x0000, 0x40d1, 0x0000, 0x8003, 0x0841, 0x2965,
+	0x5aab, 0x4006, 0x738e, 0x8009, 0x6b4d, 0x5aeb, 0x4a69, 0x39a7, 0x2104, 0x1082, 0x0821, 0x0000,
+	0x0000, 0x40d0, 0x0000, 0x8013, 0x1062, 0x4a49, 0x738e, 0x5aeb, 0x31a6, 0x2124, 0x20e4, 0x20e4,
+	0x3186, 0x62ec, 0x73ae, 0x7bcf, 0x6b6d, 0x52aa, 0x39e7, 0x2124, 0x1082, 0x0821, 0x0000, 0x40cf,
+	0x0000, 0x8014, 0x1082, 0x52aa, 0x738e, 0x31a6, 0x2104, 0x4208, 0x5aab, 0x5acb, 0x4a69, 0x2124,
+	0x0841, 0x4208, 0x7bef, 0x7bef, 0x738e, 0x52aa, 0x41e8, 0x2104, 0x0841, 0x0000, 0x40ce, 0x0000,
+	0x8007, 0x0841, 0x5acb, 0x738e, 0x2104, 0x4208, 0x7bcf, 0x8410, 0x4003, 0x8430, 0x800b, 0x7bef,
+	0x4a49, 0x0841, 0x4a49, 0x8430, 0x8410, 0x6b6d, 0x4a49, 0x39c7, 0x18c3, 0x0000, 0x4008, 0x0000,
+	0x800c, 0x0841, 0x18e3, 0x39e7, 0x5acb, 0x6b6d, 0x73ae, 0x73ae, 0x738e, 0x630c, 0x4a49, 0x2925,
+	0x0841, 0x404e, 0x0000, 0x8006, 0x0861, 0x2965, 0x3166, 0x3166, 0x3186, 0x20e4, 0x4004, 0x0000,
+	0x8001, 0x18c3, 0x400e, 0x3166, 0x8004, 0x2965, 0x2925, 0x18a3, 0x0861, 0x404f, 0x0000, 0x8004,
+	0x4a49, 0x7bef, 0x2104, 0x52aa, 0x4008, 0x8c51, 0x8009, 0x4208, 0x0841, 0x73ae, 0x8c51, 0x8410,
+	0x630c, 0x39c7, 0x2925, 0x0861, 0x4006, 0x0000, 0x8004, 0x0841, 0x2945, 0x6b4d, 0x94b2, 0x4009,
+	0x9cd3, 0x8003, 0x7bef, 0x39c7, 0x0861, 0x404c, 0x0000, 0x8002, 0x31a6, 0xc638, 0x4003, 0xce59,
+	0x8001, 0x8430, 0x4004, 0x0000, 0x8001, 0x6b6d, 0x4010, 0xce59, 0x8004, 0xbdf7, 0xa514, 0x5aeb,
+	0x18e3, 0x404c, 0x0000, 0x8005, 0x2124, 0x8430, 0x39c7, 0x4228, 0x8c71, 0x4008, 0x9492, 0x8009,
+	0x8410, 0x10a2, 0x4208, 0x9492, 0x8c71, 0x7bef, 0x5aab, 0x2104, 0x0841, 0x4005, 0x0000, 0x8002,
+	0x18a3, 0x5acb, 0x4003, 0x9cd3, 0x8008, 0x9492, 0x8410, 0x7bcf, 0x738e, 0x738e, 0x7bcf, 0x8410,
+	0x8c71, 0x4003, 0x9cd3, 0x8002, 0x738e, 0x2945, 0x404b, 0x0000, 0x8002, 0x31a6, 0xc618, 0x4003,
+	0xce59, 0x8001, 0x8430, 0x4004, 0x0000, 0x8001, 0x6b6d, 0x4013, 0xce59, 0x8003, 0xb5d6, 0x5acb,
+	0x0841, 0x4037, 0x0000, 0x8006, 0x18e3, 0x39e7, 0x4208, 0x4208, 0x41e8, 0x2104, 0x400c, 0x0000,
+	0x8005, 0x0020, 0x5aeb, 0x6b6d, 0x2124, 0x8430, 0x400a, 0x94b2, 0x8008, 0x3186, 0x20e4, 0x94b2,
+	0x94b2, 0x7bef, 0x52aa, 0x41e8, 0x18e3, 0x4004, 0x0000, 0x8009, 0x2925, 0x7bef, 0x9cd3, 0x9cd3,
+	0x8c51, 0x632c, 0x39c7, 0x18c3, 0x0821, 0x4003, 0x0000, 0x8008, 0x1082, 0x3166, 0x52aa, 0x8410,
+	0x9cd3, 0x9cd3, 0x9492, 0x41e8, 0x404a, 0x0000, 0x8002, 0x31a6, 0xc618, 0x4003, 0xce59, 0x8001,
+	0x8430, 0x4004, 0x0000, 0x8001, 0x6b6d, 0x4015, 0xce59, 0x8001, 0x738e, 0x4037, 0x0000, 0x8001,
+	0x5acb, 0x4004, 0xce59, 0x8001, 0x738e, 0x400c, 0x0000, 0x8004, 0x2104, 0x8c51, 0x39c7, 0x52aa,
+	0x400b, 0x9cf3, 0x8008, 0x528a, 0x1062, 0x9492, 0x9cf3, 0x8c51, 0x5acb, 0x2965, 0x1082, 0x4003,
+	0x0000, 0x8006, 0x2104, 0x8430, 0x9cd3, 0x9cd3, 0x73ae, 0x2965, 0x400a, 0x0000, 0x8006, 0x18e3,
+	0x5aeb, 0x94b2, 0x9cd3, 0x94b2, 0x4208, 0x4049, 0x0000, 0x8001, 0x39a7, 0x4004, 0xce59, 0x8001,
+	0x8c71, 0x4004, 0x0000, 0x8001, 0x6b6d, 0x4005, 0xce59, 0x4009, 0xc618, 0x4008, 0xce59, 0x8001,
+	0x4a29, 0x4036, 0x0000, 0x8002, 0x5aab, 0xc638, 0x4003, 0xce59, 0x8001, 0x6b6d, 0x400c, 0x0000,
+	0x8004, 0x4a69, 0x8c51, 0x2124, 0x7bef, 0x400b, 0xa534, 0x8008, 0x5aab, 0x1062, 0x9492, 0xa534,
+	0x94b2, 0x6b6d, 0x4a49, 0x2104, 0x8008, 0x0000, 0x0000, 0x1082, 0x7bef, 0x9cd3, 0x9cd3, 0x632c,
+	0x1082, 0x400d, 0x0000, 0x8005, 0x4a29, 0x94b2, 0x9cd3, 0x8c71, 0x2965, 0x4048, 0x0000, 0x8006,
+	0x18c3, 0x5aeb, 0x630c, 0x630c, 0x632c, 0x4208, 0x4004, 0x0000, 0x8001, 0x6b6d, 0x4004, 0xce59,
+	0x8002, 0xa534, 0x4228, 0x4008, 0x41e8, 0x8003, 0x4a29, 0x630c, 0xad55, 0x4005, 0xce59, 0x8002,
+	0x9cf3, 0x0020, 0x4035, 0x0000, 0x8002, 0x52aa, 0xc638, 0x4003, 0xce59, 0x8001, 0x6b6d, 0x400b,
+	0x0000, 0x8005, 0x0821, 0x738e, 0x6b6d, 0x2945, 0x9492, 0x400b, 0xad55, 0x8008, 0x4a49, 0x10a2,
+	0xa534, 0xad55, 0x9492, 0x5acb, 0x3186, 0x10a2, 0x8007, 0x0000, 0x0821, 0x5acb, 0x9cd3, 0x9cd3,
+	0x6b6d, 0x0861, 0x400f, 0x0000, 0x8005, 0x4a69, 0x9cd3, 0x9cd3, 0x7bcf, 0x1082, 0x4051, 0x0000,
+	0x8001, 0x6b6d, 0x4004, 0xce59, 0x8001, 0x94b2, 0x400b, 0x0000, 0x8002, 0x2104, 0xa514, 0x4004,
+	0xce59, 0x8002, 0xbdd7, 0x2104, 0x4035, 0x0000, 0x8002, 0x52aa, 0xc638, 0x4003, 0xce59, 0x8001,
+	0x6b6d, 0x400b, 0x0000, 0x8005, 0x1082, 0x8c51, 0x630c, 0x2945, 0x9cf3, 0x400a, 0xb596, 0x8009,
+	0xad55, 0x2965, 0x3186, 0xb596, 0xad75, 0x8c51, 0x632c, 0x4228, 0x18c3, 0x8006, 0x0000, 0x2925,
+	0x94b2, 0x9cd3, 0x8410, 0x20e4, 0x4010, 0x0000, 0x8005, 0x0841, 0x6b4d, 0x9cd3, 0x9cd3, 0x4a49,
+	0x4051, 0x0000, 0x8001, 0x6b6d, 0x4004, 0xce59, 0x8002, 0x9cd3, 0x0841, 0x400b, 0x0000, 0x8002,
+	0x52aa, 0xc618, 0x4003, 0xce59, 0x8002, 0xbdf7, 0x41e8, 0x4035, 0x0000, 0x8002, 0x52aa, 0xc638,
+	0x4003, 0xce59, 0x8001, 0x6b6d, 0x400b, 0x0000, 0x8005, 0x18c3, 0x9cd3, 0x630c, 0x2104, 0x9cf3,
+	0x400a, 0xb5b6, 0x8009, 0x9492, 0x1062, 0x738e, 0xb5b6, 0xb596, 0x9492, 0x5aab, 0x2104, 0x0841,
+	0x8005, 0x0821, 0x630c, 0x9cd3, 0x9cd3, 0x4a49, 0x4012, 0x0000, 0x8005, 0x2945, 0x8c71, 0x9cd3,
+	0x8410, 0x18a3, 0x400b, 0x0000, 0x8006, 0x20e4, 0x39c7, 0x4208, 0x39e7, 0x2965, 0x0861, 0x4010,
+	0x0000, 0x8006, 0x1082, 0x3186, 0x41e8, 0x4208, 0x39c7, 0x2104, 0x4011, 0x0000, 0x8006, 0x1082,
+	0x31a6, 0x4208, 0x4208, 0x31a6, 0x18e3, 0x4012, 0x0000, 0x8001, 0x6b6d, 0x4004, 0xce59, 0x8002,
+	0x9cd3, 0x0841, 0x400b, 0x0000, 0x8002, 0x3166, 0xb5b6, 0x4003, 0xce59, 0x8002, 0xbdf7, 0x4228,
+	0x400a, 0x0000, 0x8008, 0x0020, 0x2965, 0x4a49, 0x5aab, 0x5aab, 0x4a49, 0x3186, 0x0821, 0x4011,
+	0x0000, 0x8007, 0x2945, 0x4a29, 0x52aa, 0x5acb, 0x4a69, 0x31a6, 0x0841, 0x400b, 0x0000, 0x8006,
+	0x528a, 0xc638, 0xce59, 0xce59, 0xc658, 0x6b4d, 0x400b, 0x0000, 0x8005, 0x18c3, 0x9cd3, 0x7bef,
+	0x0861, 0x94b2, 0x400a, 0xbdf7, 0x8009, 0x4a29, 0x18c3, 0xb596, 0xbdf7, 0xa554, 0x5acb, 0x4228,
+	0x39a7, 0x0861, 0x8005, 0x10a2, 0x9492, 0x9cd3, 0x8410, 0x18e3, 0x4012, 0x0000, 0x8011, 0x0841,
+	0x6b2d, 0x9cd3, 0x9cd3, 0x31a6, 0x0000, 0x0000, 0x0020, 0x4208, 0x6b6d, 0x4a49, 0x0020, 0x0000,
+	0x0020, 0x31a6, 0x738e, 0x9492, 0x4003, 0x94b2, 0x8004, 0x9492, 0x8c51, 0x5acb, 0x18c3, 0x400c,
+	0x0000, 0x8003, 0x2104, 0x62ec, 0x8c51, 0x4004, 0x94b2, 0x8004, 0x9492, 0x73ae, 0x39c7, 0x0020,
+	0x4006, 0x0000, 0x8009, 0x1062, 0x52aa, 0x6b4d, 0x4a29, 0x0000, 0x0000, 0x18c3, 0x5aeb, 0x8c51,
+	0x4004, 0x94b2, 0x8003, 0x9492, 0x6b6d, 0x31a6, 0x4006, 0x0000, 0x8006, 0x2104, 0x8410, 0x8c51,
+	0x8c51, 0x8c71, 0x5acb, 0x4004, 0x0000, 0x8001, 0x6b6d, 0x4004, 0xce59, 0x8002, 0x9cd3, 0x0841,
+	0x400b, 0x0000, 0x8002, 0x2925, 0xb596, 0x4003, 0xce59, 0x8002, 0xbdf7, 0x39c7, 0x4008, 0x0000,
+	0x8004, 0x18e3, 0x6b4d, 0xa534, 0xbe17, 0x4004, 0xc638, 0x8004, 0xbe17, 0xa534, 0x6b4d, 0x2104,
+	0x400c, 0x0000, 0x8005, 0x18a3, 0x5aeb, 0x9cf3, 0xbdf7, 0xc618, 0x4003, 0xc638, 0x8004, 0xc618,
+	0xad75, 0x73ae, 0x2925, 0x4005, 0x0000, 0x8005, 0x18a3, 0x73ae, 0x8c71, 0x8430, 0xa534, 0x4004,
+	0xce59, 0x8006, 0xad75, 0x8430, 0x8c51, 0x9492, 0x6b2d, 0x1082, 0x4006, 0x0000, 0x8005, 0x1082,
+	0x8c71, 0xa534, 0x1082, 0x6b4d, 0x4009, 0xc618, 0x800a, 0x8430, 0x0861, 0x73ae, 0xc618, 0xbdd7,
+	0x9cd3, 0x8430, 0x39c7, 0x0841, 0x0000, 0x8004, 0x39c7, 0x9cd3, 0x9cd3, 0x630c, 0x4014, 0x0000,
+	0x8019, 0x39e7, 0x94d2, 0x9cd3, 0x5aeb, 0x0841, 0x0000, 0x0841, 0x6b2d, 0x9cd3, 0x738e, 0x0000,
+	0x1082, 0x6b4d, 0x9cd3, 0x94d2, 0x9492, 0x8c71, 0x8c51, 0x8c71, 0x9492, 0x9cd3, 0x9cd3, 0x9492,
+	0x4228, 0x0821, 0x4008, 0x0000, 0x800e, 0x0821, 0x4a69, 0x94b2, 0x9cd3, 0x9cd3, 0x9492, 0x8c71,
+	0x8c51, 0x8c71, 0x94b2, 0x9cd3, 0x94d2, 0x6b6d, 0x18a3, 0x4005, 0x0000, 0x8012, 0x18a3, 0x8410,
+	0x9cd3, 0x6b6d, 0x0020, 0x39c7, 0x8c71, 0x9cd3, 0x94b2, 0x8c71, 0x8c51, 0x8c71, 0x9492, 0x9cd3,
+	0x9cd3, 0x94b2, 0x5acb, 0x0821, 0x4004, 0x0000, 0x8002, 0x31a6, 0xc618, 0x4003, 0xce59, 0x8001,
+	0x8c51, 0x4004, 0x0000, 0x8001, 0x6b6d, 0x4004, 0xce59, 0x8002, 0x9cd3, 0x0841, 0x400b, 0x0000,
+	0x8002, 0x39c7, 0xbdd7, 0x4003, 0xce59, 0x8002, 0xb596, 0x18a3, 0x4006, 0x0000, 0x8003, 0x0841,
+	0x630c, 0xbdd7, 0x400a, 0xce59, 0x8003, 0xbdf7, 0x630c, 0x0841, 0x4008, 0x0000, 0x8003, 0x0821,
+	0x528a, 0xb5b6, 0x400a, 0xce59, 0x8003, 0xc638, 0x73ae, 0x1082, 0x4003, 0x0000, 0x8002, 0x2104,
+	0xb596, 0x400b, 0xce59, 0x8002, 0x9cf3, 0x18c3, 0x4006, 0x0000, 0x8006, 0x0841, 0x6b6d, 0xce59,
+	0x4a49, 0x0841, 0xa514, 0x4006, 0xce59, 0x800c, 0xc638, 0x9492, 0x1082, 0x4a29, 0xc618, 0xce59,
+	0xb5d6, 0x8430, 0x39c7, 0x31a6, 0x18e3, 0x0000, 0x8004, 0x630c, 0x9cd3, 0x9492, 0x41e8, 0x4014,
+	0x0000, 0x801a, 0x2104, 0x8430, 0x9cd3, 0x8410, 0x1082, 0x0000, 0x0821, 0x630c, 0x9cd3, 0x6b4d,
+	0x1082, 0x738e, 0x9cd3, 0x8430, 0x52aa, 0x2945, 0x10a2, 0x0861, 0x1082, 0x2945, 0x5acb, 0x8c71,
+	0x9cd3, 0x9cd3, 0x528a, 0x0020, 0x4006, 0x0000, 0x8010, 0x0841, 0x5aeb, 0x9cd3, 0x9cd3, 0x8c51,
+	0x5aab, 0x2925, 0x1062, 0x0861, 0x18c3, 0x41e8, 0x7bcf, 0x94b2, 0x9cd3, 0x7bef, 0x10a2, 0x4004,
+	0x0000, 0x8012, 0x10a2, 0x8410, 0x9cd3, 0x630c, 0x3186, 0x9cd3, 0x9492, 0x632c, 0x3186, 0x1082,
+	0x0861, 0x1082, 0x2945, 0x5aeb, 0x9492, 0x9cd3, 0x9cd3, 0x528a, 0x4004, 0x0000, 0x8002, 0x3186,
+	0xc618, 0x4003, 0xce59, 0x8001, 0x8430, 0x4004, 0x0000, 0x8001, 0x6b6d, 0x4004, 0xce59, 0x8002,
+	0x9cd3, 0x0841, 0x400b, 0x0000, 0x8001, 0x73ae, 0x4004, 0xce59, 0x8001, 0x8410, 0x4006, 0x0000,
+	0x8002, 0x0861, 0x8410, 0x400e, 0xce59, 0x8002, 0x8c51, 0x1082, 0x4006, 0x0000, 0x8002, 0x0841,
+	0x738e, 0x400e, 0xce59, 0x8006, 0x9cd3, 0x18c3, 0x0000, 0x0000, 0x2104, 0xb5b6, 0x400b, 0xce59,
+	0x8002, 0x9d13, 0x18c3, 0x4007, 0x0000, 0x8017, 0x4a49, 0xc638, 0xad75, 0x2104, 0x2104, 0x94d2,
+	0xc618, 0xce79, 0xce99, 0xce59, 0xb5b6, 0x6b6d, 0x1062, 0x39e7, 0xc618, 0xce99, 0xc638, 0x94b2,
+	0x5aeb, 0x630c, 0x18e3, 0x0000, 0x0000, 0x8004, 0x7bef, 0x9cd3, 0x8430, 0x2104, 0x4014, 0x0000,
+	0x800e, 0x0841, 0x6b6d, 0x9cd3, 0x94b2, 0x18e3, 0x0000, 0x0821, 0x630c, 0x9cd3, 0x738e, 0x630c,
+	0x9cd3, 0x6b4d, 0x18a3, 0x4007, 0x0000, 0x8005, 0x2945, 0x8410, 0x9cd3, 0x9cd3, 0x39c7, 0x4006,
+	0x0000, 0x8005, 0x4a69, 0x94d2, 0x9cd3, 0x7bef, 0x2124, 0x4006, 0x0000, 0x8006, 0x0821, 0x52aa,
+	0x94b2, 0x9cd3, 0x6b6d, 0x0821, 0x4003, 0x0000, 0x8007, 0x10a2, 0x8410, 0x9cd3, 0x73ae, 0x8c51,
+	0x8c51, 0x31a6, 0x4007, 0x0000, 0x8005, 0x39e7, 0x94b2, 0x9cd3, 0x8430, 0x20e4, 0x4003, 0x0000,
+	0x8002, 0x3186, 0xc618, 0x4003, 0xce59, 0x8001, 0x8430, 0x4004, 0x0000, 0x8001, 0x6b6d, 0x4004,
+	0xce59, 0x8001, 0x94b2, 0x400a, 0x0000, 0x8003, 0x1082, 0x5acb, 0xbe17, 0x4003, 0xce59, 0x8002,
+	0xad75, 0x2104, 0x4005, 0x0000, 0x8002, 0x0821, 0x7bef, 0x4005, 0xce59, 0x8006, 0xb596, 0x8c71,
+	0x73ae, 0x738e, 0x8c71, 0xad75, 0x4005, 0xce59, 0x8002, 0x8430, 0x0841, 0x4005, 0x0000, 0x8001,
+	0x6b4d, 0x4005, 0xce59, 0x8006, 0xb5b6, 0x9492, 0x73ae, 0x738e, 0x8c51, 0xad75, 0x4005, 0xce59,
+	0x8008, 0x94b2, 0x1062, 0x0000, 0x18e3, 0x9492, 0xa534, 0xa514, 0xb5b6, 0x4004, 0xce59, 0x8006,
+	0xbdd7, 0xa534, 0xa534, 0xa554, 0x7bef, 0x10a2, 0x4007, 0x0000, 0x8017, 0x2104, 0x9492, 0xd6ba,
+	0x9cf3, 0x2124, 0x0000, 0x4208, 0x6b4d, 0x738e, 0x52aa, 0x18e3, 0x1082, 0x630c, 0xce99, 0xd6ba,
+	0xce59, 0xa534, 0x73ae, 0x5aeb, 0x1062, 0x1062, 0x0000, 0x0000, 0x8004, 0x8c51, 0x9cd3, 0x7bef,
+	0x1062, 0x4015, 0x0000, 0x800c, 0x62ec, 0x9cd3, 0x9cd3, 0x2965, 0x0000, 0x0821, 0x632c, 0x9cd3,
+	0x9492, 0x9cd3, 0x738e, 0x0861, 0x4009, 0x0000, 0x8005, 0x2124, 0x8c51, 0x9cd3, 0x8c51, 0x1082,
+	0x4004, 0x0000, 0x8005, 0x2104, 0x8c51, 0x9cd3, 0x8c51, 0x18e3, 0x4009, 0x0000, 0x8004, 0x5acb,
+	0x9cd3, 0x94b2, 0x4208, 0x4003, 0x0000, 0x8006, 0x10a2, 0x8410, 0x9cd3, 0x9cd3, 0x94b2, 0x3186,
+	0x4009, 0x0000, 0x8004, 0x630c, 0x9cd3, 0x94d2, 0x4a29, 0x4003, 0x0000, 0x8002, 0x3186, 0xc618,
+	0x4003, 0xce59, 0x8001, 0x8430, 0x4004, 0x0000, 0x8001, 0x6b6d, 0x4004, 0xce59, 0x8003, 0xad75,
+	0x5acb, 0x528a, 0x4007, 0x52aa, 0x8002, 0x630c, 0x9492, 0x4003, 0xce59, 0x8003, 0xc658, 0xa534,
+	0x31a6, 0x4006, 0x0000, 0x8002, 0x528a, 0xc658, 0x4004, 0xce59, 0x8002, 0x8430, 0x2945, 0x4004,
+	0x0000, 0x8002, 0x2124, 0x7bef, 0x4005, 0xce59, 0x8001, 0x528a, 0x4004, 0x0000, 0x8002, 0x31a6,
+	0xc658, 0x4004, 0xce59, 0x8002, 0x9492, 0x31a6, 0x4004, 0x0000, 0x8003, 0x20e4, 0x73ae, 0xc618,
+	0x4004, 0xce59, 0x8010, 0x6b6d, 0x0000, 0x0000, 0x0861, 0x1082, 0x0821, 0x5aeb, 0xc638, 0xce59,
+	0xce59, 0xc658, 0x738e, 0x0841, 0x1062, 0x1082, 0x0861, 0x4008, 0x0000, 0x8014, 0x0821, 0x4a49,
+	0xb5d6, 0xdefb, 0xc618, 0x630c, 0x2965, 0x18e3, 0x18e3, 0x2965, 0x52aa, 0xad75, 0xdefb, 0xdefb,
+	0xce59, 0xad75, 0x8410, 0x52aa, 0x2925, 0x2124, 0x4003, 0x0000, 0x8003, 0x8c71, 0x9cd3, 0x73ae,
+	0x4016, 0x0000, 0x800b, 0x52aa, 0x9cd3, 0x9cd3, 0x39c7, 0x0000, 0x0821, 0x630c, 0x9cd3, 0x9cd3,
+	0x8c71, 0x2945, 0x400b, 0x0000, 0x8004, 0x528a, 0x94b2, 0x9cd3, 0x4a49, 0x4004, 0x0000, 0x8004,
+	0x5acb, 0x9cd3, 0x9cd3, 0x39c7, 0x400a, 0x0000, 0x800c, 0x0861, 0x8430, 0x9cd3, 0x73ae, 0x0841,
+	0x0000, 0x0000, 0x10a2, 0x8410, 0x9cd3, 0x9cd3, 0x630c, 0x400a, 0x0000, 0x8004, 0x2925, 0x94d2,
+	0x9cd3, 0x5aeb, 0x4003, 0x0000, 0x8002, 0x3186, 0xc618, 0x4003, 0xce59, 0x8001, 0x8430, 0x4004,
+	0x0000, 0x8001, 0x6b6d, 0x4013, 0xce59, 0x8002, 0x8c51, 0x18a3, 0x4006, 0x0000, 0x8002, 0x1082,
+	0xa534, 0x4004, 0xce59, 0x8002, 0x8410, 0x0821, 0x4007, 0x0000, 0x8001, 0x73ae, 0x4004, 0xce59,
+	0x8006, 0xad55, 0x18c3, 0x0000, 0x0000, 0x0841, 0x94b2, 0x4004, 0xce59, 0x8002, 0x9492, 0x1082,
+	0x4007, 0x0000, 0x8002, 0x6b4d, 0xc638, 0x4003, 0xce59, 0x8002, 0xbdf7, 0x18e3, 0x4004, 0x0000,
+	0x8006, 0x528a, 0xc638, 0xce59, 0xce59, 0xc658, 0x6b4d, 0x400d, 0x0000, 0x8009, 0x1082, 0x6b2d,
+	0xbdd7, 0xe71c, 0xe73c, 0xdefb, 0xc638, 0xc638, 0xdefb, 0x4003, 0xe73c, 0x8006, 0xc638, 0xa534,
+	0x8410, 0x4a69, 0x4208, 0x10a2, 0x4004, 0x0000, 0x8003, 0x8c71, 0x9cd3, 0x738e, 0x4016, 0x0000,
+	0x800b, 0x4a69, 0x9cd3, 0x9cd3, 0x4208, 0x0000, 0x0821, 0x630c, 0x9cd3, 0x9cd3, 0x632c, 0x0821,
+	0x400b, 0x0000, 0x800c, 0x1082, 0x8430, 0x9cd3, 0x7bef, 0x0020, 0x0000, 0x0000, 0x18a3, 0x7bef,
+	0x9cd3, 0x7bcf, 0x0841, 0x400b, 0x0000, 0x800b, 0x4a49, 0x9cd3, 0x8c71, 0x2965, 0x0000, 0x0000,
+	0x10a2, 0x8410, 0x9cd3, 0x94b2, 0x2124, 0x400a, 0x0000, 0x8009, 0x10a2, 0x8c71, 0x9cd3, 0x6b4d,
+	0x0821, 0x0000, 0x0000, 0x3186, 0xc618, 0x4003, 0xce59, 0x8001, 0x8430, 0x4004, 0x0000, 0x8001,
+	0x6b6d, 0x4013, 0xce59, 0x8003, 0x9cf3, 0x632c, 0x2124, 0x4005, 0x0000, 0x8002, 0x4a69, 0xc638,
+	0x4003, 0xce59, 0x8002, 0xad55, 0x10a2, 0x4008, 0x0000, 0x8002, 0x1082, 0xa534, 0x4004, 0xce59,
+	0x8004, 0x4a49, 0x0000, 0x0000, 0x2965, 0x4004, 0xce59, 0x8002, 0xb596, 0x2925, 0x4008, 0x0000,
+	0x8002, 0x0841, 0x9492, 0x4004, 0xce59, 0x8001, 0x6b4d, 0x4004, 0x0000, 0x8002, 0x52aa, 0xc638,
+	0x4003, 0xce59, 0x8001, 0x6b6d, 0x400e, 0x0000, 0x8011, 0x20e4, 0x5aeb, 0x9cf3, 0xce59, 0xdf1b,
+	0xef5d, 0xef5d, 0xe73c, 0xd6da, 0xce79, 0xb5b6, 0x8410, 0x7bef, 0x39c7, 0x4208, 0x0000, 0x0841,
+	0x4004, 0x0000, 0x8003, 0x8c71, 0x9cd3, 0x738e, 0x4016, 0x0000, 0x800a, 0x4a69, 0x9cd3, 0x9cd3,
+	0x4208, 0x0000, 0x0821, 0x630c, 0x9cd3, 0x9cd3, 0x4a29, 0x400d, 0x0000, 0x800a, 0x6b4d, 0x9cd3,
+	0x9492, 0x18c3, 0x0000, 0x0000, 0x3186, 0x94b2, 0x9cd3, 0x4a49, 0x400c, 0x0000, 0x800b, 0x18e3,
+	0x94b2, 0x94d2, 0x4a69, 0x0000, 0x0000, 0x10a2, 0x8410, 0x9cd3, 0x8430, 0x0821, 0x400a, 0x0000,
+	0x8009, 0x1082, 0x7bef, 0x9cd3, 0x6b6d, 0x0841, 0x0000, 0x0000, 0x3186, 0xc618, 0x4003, 0xce59,
+	0x8001, 0x8430, 0x4004, 0x0000, 0x8001, 0x6b6d, 0x4015, 0xce59, 0x8002, 0xa554, 0x39a7, 0x4004,
+	0x0000, 0x8001, 0x7bef, 0x4003, 0xce59, 0x8002, 0xc658, 0x6b4d, 0x400a, 0x0000, 0x8001, 0x528a,
+	0x4004, 0xce59, 0x8004, 0x7bcf, 0x0841, 0x0000, 0x630c, 0x4004, 0xce59, 0x8001, 0x738e, 0x400a,
+	0x0000, 0x8002, 0x4a69, 0xc618, 0x4003, 0xce59, 0x8001, 0x9cf3, 0x4004, 0x0000, 0x8002, 0x52aa,
+	0xc638, 0x4003, 0xce59, 0x8001, 0x6b6d, 0x400f, 0x0000, 0x800f, 0x18a3, 0x4a49, 0x73ae, 0x94b2,
+	0xa534, 0xb5b6, 0xad55, 0x94b2, 0x9492, 0x630c, 0x6b4d, 0x2945, 0x2965, 0x0000, 0x0821, 0x4005,
+	0x0000, 0x8003, 0x8c71, 0x9cd3, 0x73ae, 0x4016, 0x0000, 0x800a, 0x528a, 0x9cd3, 0x9cd3, 0x39c7,
+	0x0000, 0x0821, 0x630c, 0x9cd3, 0x9492, 0x3186, 0x400d, 0x0000, 0x800a, 0x4a49, 0x94b2, 0x94b2,
+	0x39a7, 0x0000, 0x0000, 0x4228, 0x9cd3, 0x94d2, 0x2104, 0x400c, 0x0000, 0x800a, 0x0841, 0x8410,
+	0x9cd3, 0x630c, 0x0000, 0x0000, 0x10a2, 0x8410, 0x9cd3, 0x738e, 0x400b, 0x0000, 0x8009, 0x1062,
+	0x7bcf, 0x9cd3, 0x6b6d, 0x0861, 0x0000, 0x0000, 0x3186, 0xc618, 0x4003, 0xce59, 0x8001, 0x8430,
+	0x4004, 0x0000, 0x8001, 0x6b6d, 0x4004, 0xce59, 0x8003, 0xb596, 0x630c, 0x5acb, 0x4007, 0x5aeb,
+	0x8003, 0x62ec, 0x738e, 0xa514, 0x4005, 0xce59, 0x8006, 0xad55, 0x2124, 0x0000, 0x0000, 0x0841,
+	0x9cd3, 0x4003, 0xce59, 0x8002, 0xbe17, 0x2965, 0x400a, 0x0000, 0x8002, 0x2945, 0xbdf7, 0x4003,
+	0xce59, 0x8004, 0xa514, 0x1082, 0x0000, 0x8c51, 0x4003, 0xce59, 0x8002, 0xc638, 0x4228, 0x400a,
+	0x0000, 0x8002, 0x18c3, 0xad75, 0x4003, 0xce59, 0x8002, 0xb596, 0x18a3, 0x4003, 0x0000, 0x8002,
+	0x52aa, 0xc638, 0x4003, 0xce59, 0x8001, 0x6b6d, 0x4010, 0x0000, 0x800c, 0x1062, 0x2124, 0x4208,
+	0x52aa, 0x630c, 0x5aeb, 0x5acb, 0x4208, 0x39c7, 0x2925, 0x0841, 0x0841, 0x4007, 0x0000, 0x8004,
+	0x8c71, 0x9cd3, 0x7bef, 0x0861, 0x4015, 0x0000, 0x800a, 0x5aeb, 0x9cd3, 0x9cd3, 0x3186, 0x0000,
+	0x0821, 0x630c, 0x9cd3, 0x8430, 0x2124, 0x400d, 0x0000, 0x800b, 0x3186, 0x94b2, 0x94b2, 0x4a49,
+	0x0000, 0x0000, 0x52aa, 0x9cd3, 0x9492, 0x39e7, 0x2925, 0x400b, 0x2945, 0x800a, 0x3186, 0x8410,
+	0x9cd3, 0x738e, 0x0020, 0x0000, 0x10a2, 0x8410, 0x9cd3, 0x6b4d, 0x400b, 0x0000, 0x8009, 0x1062,
+	0x7bcf, 0x9cd3, 0x6b6d, 0x0861, 0x0000, 0x0000, 0x3186, 0xc618, 0x4003, 0xce59, 0x8001, 0x8430,
+	0x4004, 0x0000, 0x8001, 0x6b6d, 0x4004, 0xce59, 0x8002, 0x94d2, 0x0841, 0x4009, 0x0000, 0x8004,
+	0x0821, 0x1082, 0x528a, 0xbdf7, 0x4004, 0xce59, 0x8005, 0x8430, 0x0000, 0x0000, 0x18e3, 0xa534,
+	0x4003, 0xce59, 0x8002, 0xb596, 0x0841, 0x400a, 0x0000, 0x8002, 0x18c3, 0x9cf3, 0x4003, 0xce59,
+	0x8004, 0xb5d6, 0x18c3, 0x0000, 0xa514, 0x4003, 0xce59, 0x8002, 0xad75, 0x2945, 0x400b, 0x0000,
+	0x8001, 0x94b2, 0x4003, 0xce59, 0x8002, 0xbdd7, 0x3166, 0x4003, 0x0000, 0x8002, 0x52aa, 0xc638,
+	0x4003, 0xce59, 0x8001, 0x6b6d, 0x4012, 0x0000, 0x8007, 0x0821, 0x1082, 0x18c3, 0x18c3, 0x18a3,
+	0x0841, 0x0841, 0x400a, 0x0000, 0x8004, 0x8410, 0x9cd3, 0x8430, 0x20e4, 0x4014, 0x0000, 0x800b,
+	0x0841, 0x6b6d, 0x9cd3, 0x94d2, 0x2104, 0x0000, 0x0821, 0x630c, 0x9cd3, 0x8410, 0x18e3, 0x400d,
+	0x0000, 0x800a, 0x2124, 0x9492, 0x94d2, 0x52aa, 0x0000, 0x0000, 0x5aeb, 0x9cd3, 0x94d2, 0x94b2,
+	0x400d, 0x9492, 0x8009, 0x94d2, 0x9cd3, 0x73ae, 0x0861, 0x0000, 0x10a2, 0x8410, 0x9cd3, 0x6b4d,
+	0x400b, 0x0000, 0x8009, 0x1062, 0x7bcf, 0x9cd3, 0x6b6d, 0x0861, 0x0000, 0x0000, 0x3186, 0xc618,
+	0x4003, 0xce59, 0x8001, 0x8430, 0x4004, 0x0000, 0x8001, 0x6b6d, 0x4004, 0xce59, 0x8002, 0x9cd3,
+	0x0841, 0x400c, 0x0000, 0x8002, 0x5aeb, 0xc638, 0x4003, 0xce59, 0x8005, 0xb5b6, 0x2965, 0x0000,
+	0x2945, 0xad75, 0x4003, 0xce59, 0x8001, 0x9d13, 0x400b, 0x0000, 0x8002, 0x1082, 0x8c51, 0x4003,
+	0xce59, 0x8004, 0xc618, 0x20e4, 0x0020, 0xad75, 0x4003, 0xce59, 0x8002, 0xa514, 0x18e3, 0x400b,
+	0x0000, 0x8001, 0x8410, 0x4003, 0xce59, 0x8002, 0xbdf7, 0x39e7, 0x4003, 0x0000, 0x8002, 0x52aa,
+	0xc638, 0x4003, 0xce59, 0x8001, 0x6b6d, 0x4023, 0x0000, 0x8004, 0x6b2d, 0x9cd3, 0x9492, 0x39c7,
+	0x4014, 0x0000, 0x800b, 0x18e3, 0x8410, 0x9cd3, 0x8430, 0x1082, 0x0000, 0x0821, 0x630c, 0x9cd3,
+	0x7bef, 0x18c3, 0x400d, 0x0000, 0x8009, 0x2104, 0x9492, 0x94d2, 0x52aa, 0x0000, 0x0020, 0x5aeb,
+	0x9cd3, 0x94b2, 0x4010, 0x8c71, 0x8007, 0x6b6d, 0x1062, 0x0000, 0x10a2, 0x8410, 0x9cd3, 0x6b4d,
+	0x400b, 0x0000, 0x8009, 0x1062, 0x7bcf, 0x9cd3, 0x6b6d, 0x0861, 0x0000, 0x0000, 0x3186, 0xc618,
+	0x4003, 0xce59, 0x8001, 0x8430, 0x4004, 0x0000, 0x8001, 0x6b6d, 0x4004, 0xce59, 0x8002, 0x9cd3,
+	0x0841, 0x400c, 0x0000, 0x8002, 0x1062, 0xad75, 0x4003, 0xce59, 0x8005, 0xc638, 0x5aeb, 0x0000,
+	0x2965, 0xad75, 0x4003, 0xce59, 0x8001, 0x9cd3, 0x400b, 0x0000, 0x8002, 0x1062, 0x8430, 0x4003,
+	0xce59, 0x8004, 0xc638, 0x2104, 0x0821, 0xb596, 0x4003, 0xce59, 0x8002, 0x9cf3, 0x18c3, 0x400b,
+	0x0000, 0x8001, 0x7bef, 0x4003, 0xce59, 0x8002, 0xbdf7, 0x4208, 0x4003, 0x0000, 0x8002, 0x52aa,
+	0xc638, 0x4003, 0xce59, 0x8001, 0x6b6d, 0x4023, 0x0000, 0x8004, 0x4208, 0x9cd3, 0x9cd3, 0x5acb,
+	0x4014, 0x0000, 0x800b, 0x39c7, 0x94b2, 0x9cd3, 0x630c, 0x0841, 0x0000, 0x0821, 0x630c, 0x9cd3,
+	0x8410, 0x2104, 0x400d, 0x0000, 0x800b, 0x2945, 0x9492, 0x94d2, 0x528a, 0x0000, 0x0000, 0x5acb,
+	0x9cd3, 0x8c71, 0x2124, 0x0841, 0x400e, 0x1062, 0x8007, 0x0861, 0x0000, 0x0000, 0x10a2, 0x8410,
+	0x9cd3, 0x6b4d, 0x400b, 0x0000, 0x8009, 0x1062, 0x7bcf, 0x9cd3, 0x6b6d, 0x0861, 0x0000, 0x0000,
+	0x3186, 0xc618, 0x4003, 0xce59, 0x8001, 0x8430, 0x4004, 0x0000, 0x8001, 0x6b6d, 0x4004, 0xce59,
+	0x8002, 0x9cd3, 0x0841, 0x400d, 0x0000, 0x8001, 0x94b2, 0x4004, 0xce59, 0x8004, 0x73ae, 0x0000,
+	0x2124, 0xad55, 0x4003, 0xce59, 0x8001, 0xa534, 0x400b, 0x0000, 0x8002, 0x1082, 0x9492, 0x4003,
+	0xce59, 0x8004, 0xbdf7, 0x18c3, 0x0000, 0xad55, 0x4003, 0xce59, 0x8002, 0xa534, 0x2104, 0x400b,
+	0x0000, 0x8001, 0x8c51, 0x4003, 0xce59, 0x8002, 0xbdf7, 0x39c7, 0x4003, 0x0000, 0x8002, 0x52aa,
+	0xc638, 0x4003, 0xce59, 0x8001, 0x6b6d, 0x4023, 0x0000, 0x8005, 0x18c3, 0x94b2, 0x9cd3, 0x7bef,
+	0x10a2, 0x4012, 0x0000, 0x800c, 0x0020, 0x630c, 0x9cd3, 0x9cd3, 0x39c7, 0x0000, 0x0000, 0x0821,
+	0x630c, 0x9cd3, 0x8c71, 0x2965, 0x400d, 0x0000, 0x800a, 0x39c7, 0x94b2, 0x94b2, 0x4228, 0x0000,
+	0x0000, 0x528a, 0x9cd3, 0x9492, 0x20e4, 0x4012, 0x0000, 0x8004, 0x10a2, 0x8410, 0x9cd3, 0x6b4d,
+	0x400b, 0x0000, 0x8009, 0x1062, 0x7bcf, 0x9cd3, 0x6b6d, 0x0861, 0x0000, 0x0000, 0x3186, 0xc618,
+	0x4003, 0xce59, 0x8001, 0x8430, 0x4004, 0x0000, 0x8001, 0x6b6d, 0x4004, 0xce59, 0x8002, 0x9cd3,
+	0x0841, 0x400d, 0x0000, 0x8001, 0x9492, 0x4004, 0xce59, 0x8004, 0x8410, 0x0000, 0x1082, 0xa514,
+	0x4003, 0xce59, 0x8002, 0xbdd7, 0x18a3, 0x400a, 0x0000, 0x8002, 0x20e4, 0xad75, 0x4003, 0xce59,
+	0x8004, 0xad75, 0x18a3, 0x0000, 0x9cd3, 0x4003, 0xce59, 0x8002, 0xbdd7, 0x31a6, 0x400a, 0x0000,
+	0x8002, 0x0821, 0xa514, 0x4003, 0xce59, 0x8002, 0xb5d6, 0x2124, 0x4003, 0x0000, 0x8002, 0x52aa,
+	0xc638, 0x4003, 0xce59, 0x8001, 0x6b6d, 0x4023, 0x0000, 0x8005, 0x0020, 0x6b2d, 0x9cd3, 0x94b2,
+	0x4a29, 0x4012, 0x0000, 0x800c, 0x2124, 0x8c71, 0x9cd3, 0x8430, 0x18a3, 0x0000, 0x0000, 0x0821,
+	0x630c, 0x9cd3, 0x94b2, 0x4208, 0x400d, 0x0000, 0x800a, 0x52aa, 0x94d2, 0x94b2, 0x2965, 0x0000,
+	0x0000, 0x41e8, 0x9cd3, 0x9cd3, 0x31a6, 0x400d, 0x0000, 0x8009, 0x18c3, 0x2104, 0x18a3, 0x0000,
+	0x0000, 0x10a2, 0x8410, 0x9cd3, 0x6b4d, 0x400b, 0x0000, 0x8009, 0x1062, 0x7bcf, 0x9cd3, 0x6b6d,
+	0x0861, 0x0000, 0x0000, 0x3186, 0xc618, 0x4003, 0xce59, 0x8001, 0x8430, 0x4004, 0x0000, 0x8001,
+	0x6b6d, 0x4004, 0xce59, 0x8002, 0x9cd3, 0x0841, 0x400c, 0x0000, 0x8002, 0x0020, 0xa534, 0x4004,
+	0xce59, 0x8004, 0x7bef, 0x0000, 0x0000, 0x8c71, 0x4003, 0xce59, 0x8002, 0xc638, 0x4a29, 0x400a,
+	0x0000, 0x8001, 0x39a7, 0x4004, 0xce59, 0x8004, 0x8c71, 0x1062, 0x0000, 0x73ae, 0x4004, 0xce59,
+	0x8001, 0x52aa, 0x400a, 0x0000, 0x8002, 0x3166, 0xb5b6, 0x4003, 0xce59, 0x8002, 0xad55, 0x0841,
+	0x4003, 0x0000, 0x8002, 0x52aa, 0xc638, 0x4003, 0xce59, 0x8001, 0x6b6d, 0x4023, 0x0000, 0x8006,
+	0x0000, 0x2965, 0x9cd3, 0x9cd3, 0x7bef, 0x1082, 0x4011, 0x0000, 0x800c, 0x630c, 0x9cd3, 0x9cd3,
+	0x528a, 0x0020, 0x0000, 0x0000, 0x0821, 0x630c, 0x9cd3, 0x9cd3, 0x5aeb, 0x400d, 0x0000, 0x800b,
+	0x73ae, 0x9cd3, 0x8c71, 0x1062, 0x0000, 0x0000, 0x2965, 0x8c71, 0x9cd3, 0x52aa, 0x0020, 0x400b,
+	0x0000, 0x800a, 0x1062, 0x7bef, 0x8c51, 0x5aeb, 0x0000, 0x0000, 0x10a2, 0x8410, 0x9cd3, 0x6b4d,
+	0x400b, 0x0000, 0x8009, 0x1062, 0x7bcf, 0x9cd3, 0x6b6d, 0x0861, 0x0000, 0x0000, 0x3186, 0xc618,
+	0x4003, 0xce59, 0x8001, 0x8430, 0x4004, 0x0000, 0x8001, 0x6b6d, 0x4004, 0xce59, 0x8002, 0x9cd3,
+	0x0861, 0x400c, 0x0000, 0x8002, 0x39c7, 0xbdf7, 0x4004, 0xce59, 0x8004, 0x6b4d, 0x0000, 0x0000,
+	0x6b4d, 0x4004, 0xce59, 0x8001, 0x8c51, 0x400a, 0x0000, 0x8001, 0x7bcf, 0x4004, 0xce59, 0x8004,
+	0x630c, 0x0020, 0x0000, 0x4a29, 0x4004, 0xce59, 0x8002, 0x9492, 0x0841, 0x4009, 0x0000, 0x8001,
+	0x6b4d, 0x4004, 0xce59, 0x8001, 0x8c51, 0x4004, 0x0000, 0x8002, 0x52aa, 0xc638, 0x4003, 0xce59,
+	0x8001, 0x6b4d, 0x4023, 0x0000, 0x8007, 0x0000, 0x0841, 0x6b4d, 0x9cd3, 0x9cd3, 0x5aeb, 0x0020,
+	0x400f, 0x0000, 0x8005, 0x39e7, 0x94b2, 0x9cd3, 0x8430, 0x18c3, 0x4003, 0x0000, 0x8006, 0x0821,
+	0x630c, 0x9cd3, 0x9cd3, 0x8430, 0x18c3, 0x400b, 0x0000, 0x8004, 0x2925, 0x8c71, 0x9cd3, 0x6b6d,
+	0x4003, 0x0000, 0x8005, 0x1062, 0x73ae, 0x9cd3, 0x8c51, 0x1082, 0x400b, 0x0000, 0x800a, 0x39e7,
+	0x9cd3, 0x9cd3, 0x4a69, 0x0000, 0x0000, 0x10a2, 0x8410, 0x9cd3, 0x6b4d, 0x400b, 0x0000, 0x8009,
+	0x1062, 0x7bcf, 0x9cd3, 0x6b6d, 0x0861, 0x0000, 0x0000, 0x3186, 0xc618, 0x4003, 0xce59, 0x8001,
+	0x8430, 0x4004, 0x0000, 0x8001, 0x6b6d, 0x4004, 0xce59, 0x8001, 0x94b2, 0x400c, 0x0000, 0x8002,
+	0x2104, 0x9cf3, 0x4004, 0xce59, 0x8006, 0xbdf7, 0x4208, 0x0000, 0x0000, 0x3166, 0xbdd7, 0x4003,
+	0xce59, 0x8002, 0xbe17, 0x39c7, 0x4008, 0x0000, 0x8002, 0x31a6, 0xbdf7, 0x4003, 0xce59, 0x8006,
+	0xc638, 0x3186, 0x0000, 0x0000, 0x18c3, 0xbdd7, 0x4003, 0xce59, 0x8002, 0xc638, 0x528a, 0x4008,
+	0x0000, 0x8002, 0x2104, 0xb596, 0x4004, 0xce59, 0x8001, 0x4a29, 0x4004, 0x0000, 0x8002, 0x52aa,
+	0xc638, 0x4003, 0xce59, 0x8001, 0x6b6d, 0x4023, 0x0000, 0x8007, 0x0000, 0x0000, 0x20e4, 0x8430,
+	0x9cd3, 0x94b2, 0x52aa, 0x400e, 0x0000, 0x8005, 0x31a6, 0x8c71, 0x9cd3, 0x94b2, 0x39e7, 0x4004,
+	0x0000, 0x8002, 0x0821, 0x630c, 0x4003, 0x9cd3, 0x8001, 0x5acb, 0x400b, 0x0000, 0x8004, 0x6b4d,
+	0x9cd3, 0x9cd3, 0x3186, 0x4004, 0x0000, 0x8004, 0x528a, 0x9cd3, 0x9cd3, 0x4a69, 0x400a, 0x0000,
+	0x800b, 0x0841, 0x8410, 0x9cd3, 0x8430, 0x10a2, 0x0000, 0x0000, 0x10a2, 0x8410, 0x9cd3, 0x6b4d,
+	0x400b, 0x0000, 0x8009, 0x1062, 0x7bcf, 0x9cd3, 0x6b6d, 0x0861, 0x0000, 0x0000, 0x3186, 0xc618,
+	0x4003, 0xce59, 0x8001, 0x8430, 0x4004, 0x0000, 0x8001, 0x6b6d, 0x4004, 0xce59, 0x8003, 0xa514,
+	0x2945, 0x2104, 0x4008, 0x2124, 0x8003, 0x39a7, 0x630c, 0xa534, 0x4005, 0xce59, 0x8002, 0x9cf3,
+	0x0861, 0x4003, 0x0000, 0x8001, 0x8c51, 0x4004, 0xce59, 0x8002, 0xad75, 0x31a6, 0x4006, 0x0000,
+	0x8002, 0x2965, 0xad55, 0x4004, 0xce59, 0x8002, 0x8430, 0x0841, 0x4003, 0x0000, 0x8001, 0x6b4d,
+	0x4004, 0xce59, 0x8002, 0xb5b6, 0x4208, 0x4006, 0x0000, 0x8002, 0x2104, 0x9cf3, 0x4004, 0xce59,
+	0x8002, 0xa534, 0x0841, 0x4004, 0x0000, 0x8002, 0x528a, 0xc618, 0x4003, 0xce59, 0x8001, 0x9492,
+	0x4023, 0x0000, 0x4003, 0x0000, 0x8006, 0x3186, 0x9492, 0x9cd3, 0x94b2, 0x630c, 0x18a3, 0x400a,
+	0x0000, 0x8007, 0x0841, 0x4a69, 0x8c71, 0x9cd3, 0x9cd3, 0x528a, 0x0821, 0x4004, 0x0000, 0x8007,
+	0x0821, 0x630c, 0x9cd3, 0x8c51, 0x8430, 0x94b2, 0x4228, 0x4009, 0x0000, 0x8005, 0x4a69, 0x94b2,
+	0x9cd3, 0x6b6d, 0x0020, 0x4004, 0x0000, 0x8005, 0x10a2, 0x8410, 0x9cd3, 0x9492, 0x39c7, 0x4009,
+	0x0000, 0x8004, 0x5aeb, 0x9cd3, 0x94d2, 0x52aa, 0x4003, 0x0000, 0x8004, 0x10a2, 0x8410, 0x9cd3,
+	0x6b4d, 0x400b, 0x0000, 0x8009, 0x1062, 0x7bcf, 0x9cd3, 0x6b6d, 0x0861, 0x0000, 0x0000, 0x3186,
+	0xc618, 0x4003, 0xce59, 0x8001, 0x8430, 0x4004, 0x0000, 0x8001, 0x6b6d, 0x4004, 0xce59, 0x8003,
+	0xc638, 0xb596, 0xad75, 0x4006, 0xb596, 0x8003, 0xad75, 0xb596, 0xb5b6, 0x4006, 0xce59, 0x8002,
+	0xc618, 0x39e7, 0x4004, 0x0000, 0x8002, 0x2104, 0xb5b6, 0x4004, 0xce59, 0x8008, 0xb5b6, 0x6b6d,
+	0x3186, 0x10a2, 0x1082, 0x3166, 0x6b4d, 0xb596, 0x4004, 0xce59, 0x8002, 0xb5b6, 0x3166, 0x4004,
+	0x0000, 0x8002, 0x18c3, 0xa534, 0x4004, 0xce59, 0x8008, 0xbdd7, 0x73ae, 0x39c7, 0x18a3, 0x1082,
+	0x2945, 0x632c, 0xad75, 0x4004, 0xce59, 0x8002, 0xc658, 0x39c7, 0x4005, 0x0000, 0x8002, 0x4208,
+	0xbdf7, 0x4003, 0xce59, 0x8006, 0xc618, 0x8410, 0x52aa, 0x5aeb, 0x4a69, 0x1062, 0x401e, 0x0000,
+	0x4004, 0x0000, 0x8008, 0x31a6, 0x8c71, 0x9cd3, 0x9cd3, 0x8430, 0x528a, 0x2104, 0x0020, 0x4005,
+	0x0000, 0x8008, 0x10a2, 0x4208, 0x7bcf, 0x94b2, 0x9cd3, 0x94b2, 0x528a, 0x0821, 0x4005, 0x0000,
+	0x8009, 0x0821, 0x630c, 0x9cd3, 0x73ae, 0x4208, 0x8c51, 0x9492, 0x5acb, 0x1082, 0x4005, 0x0000,
+	0x8006, 0x1062, 0x5acb, 0x94b2, 0x9cd3, 0x8c51, 0x18c3, 0x4006, 0x0000, 0x8006, 0x39a7, 0x8c71,
+	0x9cd3, 0x8c71, 0x4a49, 0x0841, 0x4005, 0x0000, 0x8006, 0x18c3, 0x6b2d, 0x94d2, 0x9cd3, 0x7bcf,
+	0x0841, 0x4003, 0x0000, 0x8004, 0x10a2, 0x8410, 0x9cd3, 0x6b4d, 0x400b, 0x0000, 0x8009, 0x1062,
+	0x7bcf, 0x9cd3, 0x6b6d, 0x0861, 0x0000, 0x0000, 0x3186, 0xc618, 0x4003, 0xce59, 0x8001, 0x8430,
+	0x4004, 0x0000, 0x8001, 0x6b6d, 0x4015, 0xce59, 0x8002, 0xc618, 0x528a, 0x4006, 0x0000, 0x8002,
+	0x4208, 0xc618, 0x4005, 0xce59, 0x8004, 0xbdd7, 0xb596, 0xb596, 0xbdd7, 0x4005, 0xce59, 0x8002,
+	0xc618, 0x4a49, 0x4006, 0x0000, 0x8002, 0x3186, 0xb5b6, 0x4005, 0xce59, 0x8005, 0xbdf7, 0xb596,
+	0xb596, 0xb5d6, 0xc638, 0x4005, 0xce59, 0x8001, 0x5acb, 0x4006, 0x0000, 0x8002, 0x18e3, 0xad75,
+	0x4005, 0xce59, 0x8004, 0xc638, 0xc638, 0x9cd3, 0x18c3, 0x401e, 0x0000, 0x4005, 0x0000, 0x8013,
+	0x2104, 0x73ae, 0x94d2, 0x9cd3, 0x94d2, 0x9492, 0x7bef, 0x6b4d, 0x62ec, 0x5aeb, 0x6b2d, 0x7bcf,
+	0x8c71, 0x94b2, 0x9cd3, 0x9cd3, 0x8c51, 0x39c7, 0x0020, 0x4006, 0x0000, 0x8013, 0x0821, 0x630c,
+	0x9cd3, 0x7bef, 0x1082, 0x39c7, 0x94b2, 0x94d2, 0x8c51, 0x632c, 0x4a49, 0x39e7, 0x4228, 0x630c,
+	0x8430, 0x9cd3, 0x9cd3, 0x8430, 0x2925, 0x4008, 0x0000, 0x800f, 0x4208, 0x9492, 0x9cd3, 0x94b2,
+	0x8410, 0x5acb, 0x4208, 0x39e7, 0x4a49, 0x6b4d, 0x8c71, 0x9cd3, 0x9cd3, 0x7bef, 0x18c3, 0x4004,
+	0x0000, 0x8004, 0x10a2, 0x8410, 0x9cd3, 0x6b4d, 0x400b, 0x0000, 0x8009, 0x1062, 0x7bcf, 0x9cd3,
+	0x6b6d, 0x0861, 0x0000, 0x0000, 0x31a6, 0xc618, 0x4003, 0xce59, 0x8001, 0x8430, 0x4004, 0x0000,
+	0x8001, 0x6b6d, 0x4014, 0xce59, 0x8002, 0x9cd3, 0x31a6, 0x4008, 0x0000, 0x8002, 0x4208, 0xb596,
+	0x400c, 0xce59, 0x8002, 0xb5b6, 0x4a29, 0x4008, 0x0000, 0x8002, 0x3186, 0xad55, 0x400c, 0xce59,
+	0x8003, 0xc618, 0x52aa, 0x0020, 0x4007, 0x0000, 0x8001, 0x738e, 0x4007, 0xce59, 0x8002, 0x9cf3,
+	0x18c3, 0x401e, 0x0000, 0x4006, 0x0000, 0x8005, 0x0841, 0x41e8, 0x7bcf, 0x9492, 0x94d2, 0x4007,
+	0x9cd3, 0x8004, 0x94b2, 0x8430, 0x528a, 0x10a2, 0x4008, 0x0000, 0x8009, 0x0821, 0x630c, 0x9cd3,
+	0x7bef, 0x18c3, 0x0000, 0x3186, 0x7bef, 0x94b2, 0x4005, 0x9cd3, 0x8004, 0x94d2, 0x9492, 0x6b4d,
+	0x18c3, 0x400a, 0x0000, 0x8003, 0x2965, 0x73ae, 0x9492, 0x4006, 0x9cd3, 0x8004, 0x94b2, 0x9492,
+	0x62ec, 0x1082, 0x4005, 0x0000, 0x8004, 0x10a2, 0x7bef, 0x9492, 0x6b4d, 0x400b, 0x0000, 0x8009,
+	0x1062, 0x73ae, 0x9492, 0x6b4d, 0x0861, 0x0000, 0x0000, 0x3186, 0xbdd7, 0x4003, 0xc618, 0x8001,
+	0x8430, 0x4004, 0x0000, 0x8001, 0x6b6d, 0x400f, 0xc618, 0x8006, 0xbe17, 0xbdf7, 0xad55, 0x7bef,
+	0x41e8, 0x0821, 0x400a, 0x0000, 0x8004, 0x20e4, 0x7bef, 0xbdf7, 0xc638, 0x4006, 0xce59, 0x8004,
+	0xc638, 0xbdf7, 0x8410, 0x2104, 0x400a, 0x0000, 0x8004, 0x18a3, 0x738e, 0xb5b6, 0xc638, 0x4006,
+	0xce59, 0x8004, 0xc638, 0xbdf7, 0x8c71, 0x2945, 0x4009, 0x0000, 0x8004, 0x0841, 0x738e, 0xbdd7,
+	0xc618, 0x4004, 0xc638, 0x8002, 0x94b2, 0x18c3, 0x401e, 0x0000, 0x4008, 0x0000, 0x800c, 0x0020,
+	0x2925, 0x4a69, 0x6b2d, 0x73ae, 0x8410, 0x8410, 0x7bcf, 0x6b6d, 0x52aa, 0x31a6, 0x0861, 0x400a,
+	0x0000, 0x8010, 0x0821, 0x630c, 0x9cd3, 0x7bef, 0x18c3, 0x0000, 0x0000, 0x0841, 0x39c7, 0x62ec,
+	0x73ae, 0x8410, 0x7bef, 0x6b6d, 0x528a, 0x2104, 0x400d, 0x0000, 0x800a, 0x0020, 0x3166, 0x5acb,
+	0x738e, 0x8410, 0x8410, 0x7bcf, 0x6b4d, 0x4a69, 0x20e4, 0x4007, 0x0000, 0x8004, 0x0821, 0x2124,
+	0x3166, 0x20e4, 0x400b, 0x0000, 0x800d, 0x0020, 0x2104, 0x3186, 0x2104, 0x0020, 0x0000, 0x0000,
+	0x1062, 0x39c7, 0x39e7, 0x39c7, 0x41e8, 0x2925, 0x4004, 0x0000, 0x8001, 0x2104, 0x400d, 0x4208,
+	0x8004, 0x41e8, 0x39c7, 0x2965, 0x18c3, 0x4010, 0x0000, 0x800a, 0x20e4, 0x5acb, 0x8410, 0x9cd3,
+	0xa534, 0xa534, 0x9cd3, 0x8410, 0x5acb, 0x2104, 0x400e, 0x0000, 0x800a, 0x18a3, 0x528a, 0x7bef,
+	0x94b2, 0xa534, 0xa554, 0x9cf3, 0x8430, 0x630c, 0x2925, 0x400d, 0x0000, 0x8008, 0x18c3, 0x4208,
+	0x5acb, 0x630c, 0x5aeb, 0x528a, 0x3166, 0x0821, 0x401e, 0x0000, 0x400d, 0x0000, 0x8002, 0x0841,
+	0x0841, 0x400f, 0x0000, 0x8005, 0x0821, 0x630c, 0x9cd3, 0x7bef, 0x18c3, 0x4006, 0x0000, 0x8002,
+	0x0841, 0x0020, 0x4014, 0x0000, 0x8002, 0x0821, 0x0841, 0x4051, 0x0000, 0x8002, 0x0020, 0x0020,
+	0x4017, 0x0000, 0x8001, 0x0821, 0x4037, 0x0000, 0x401e, 0x0000, 0x8005, 0x0821, 0x630c, 0x9cd3,
+	0x7bef, 0x18c3, 0x40c0, 0x0000, 0x401e, 0x0000, 0x8005, 0x0821, 0x630c, 0x9cd3, 0x7bef, 0x18c3,
+	0x40c0, 0x0000, 0x401e, 0x0000, 0x8005, 0x0821, 0x630c, 0x9cd3, 0x7bef, 0x18c3, 0x40c0, 0x0000,
+	0x401e, 0x0000, 0x8005, 0x0821, 0x630c, 0x9cd3, 0x7bef, 0x18c3, 0x40c0, 0x0000, 0x401e, 0x0000,
+	0x8005, 0x0821, 0x630c, 0x9cd3, 0x7bef, 0x18c3, 0x40c0, 0x0000, 0x401e, 0x0000, 0x8005, 0x0841,
+	0x6b2d, 0x9cd3, 0x8410, 0x18e3, 0x40c0, 0x0000, 0x401e, 0x0000, 0x8005, 0x0020, 0x39e7, 0x630c,
+	0x4a49, 0x1082, 0x40c0, 0x0000,
+};
+
+const int dataHeaderRLE_width = 227;
+const int dataHeaderRLE_height = 46;
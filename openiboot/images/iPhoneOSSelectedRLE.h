@@ -0,0 +1,716 @@
+const uint16_t dataiPhoneOSSelectedRLE[] = {
+	0x400a, 0x0000, 0x8002, 0x0841, 0x1082, 0x4052, 0x20e4, 0x8002, 0x18c3, 0x1062, 0x400a, 0x0000,
+	0x4007, 0x0000, 0x8003, 0x1082, 0x3186, 0x4208, 0x4056, 0x4a49, 0x8003, 0x4a29, 0x31a6, 0x18e3,
+	0x4007, 0x0000, 0x4005, 0x0000, 0x8002, 0x0821, 0x3186, 0x4003, 0x4a49, 0x8002, 0x4208, 0x39c7,
+	0x4016, 0x2965, 0x4007, 0x3166, 0x4019, 0x3186, 0x4007, 0x3166, 0x4015, 0x2965, 0x8002, 0x31a6,
+	0x39e7, 0x4003, 0x4a49, 0x8002, 0x39c7, 0x18a3, 0x4005, 0x0000, 0x4004, 0x0000, 0x8006, 0x1082,
+	0x4208, 0x4a49, 0x4a49, 0x2945, 0x0841, 0x4016, 0x0000, 0x4004, 0x0020, 0x4003, 0x0821, 0x4005,
+	0x0841, 0x4003, 0x0861, 0x4004, 0x1062, 0x4005, 0x1082, 0x4004, 0x1062, 0x4003, 0x0861, 0x4005,
+	0x0841, 0x4003, 0x0821, 0x4004, 0x0020, 0x4015, 0x0000, 0x8006, 0x0020, 0x20e4, 0x4208, 0x4a49,
+	0x4a49, 0x2965, 0x4004, 0x0000, 0x4003, 0x0000, 0x8005, 0x1082, 0x4a49, 0x4a49, 0x31a6, 0x0841,
+	0x4016, 0x0000, 0x4004, 0x0020, 0x8002, 0x0821, 0x0821, 0x4004, 0x0841, 0x8003, 0x0861, 0x1062,
+	0x1062, 0x4015, 0x1082, 0x8003, 0x1062, 0x1062, 0x0861, 0x4004, 0x0841, 0x8002, 0x0821, 0x0821,
+	0x4004, 0x0020, 0x4016, 0x0000, 0x8004, 0x2124, 0x4a49, 0x4a49, 0x3166, 0x4003, 0x0000, 0x8006,
+	0x0000, 0x0000, 0x0861, 0x4a49, 0x4a49, 0x2945, 0x4016, 0x0000, 0x4003, 0x0020, 0x4003, 0x0821,
+	0x8005, 0x0841, 0x0841, 0x0861, 0x0861, 0x1062, 0x4006, 0x1082, 0x4011, 0x10a2, 0x4006, 0x1082,
+	0x8005, 0x1062, 0x0861, 0x0861, 0x0841, 0x0841, 0x4003, 0x0821, 0x4003, 0x0020, 0x4015, 0x0000,
+	0x8006, 0x10a2, 0x4a49, 0x4a49, 0x2104, 0x0000, 0x0000, 0x8005, 0x0000, 0x0000, 0x39c7, 0x4a49,
+	0x2965, 0x4015, 0x0000, 0x4003, 0x0020, 0x8002, 0x0821, 0x0821, 0x4003, 0x0841, 0x8002, 0x0861,
+	0x1062, 0x4004, 0x1082, 0x4009, 0x10a2, 0x4009, 0x18a3, 0x4009, 0x10a2, 0x4004, 0x1082, 0x8002,
+	0x1062, 0x0861, 0x4003, 0x0841, 0x8002, 0x0821, 0x0821, 0x4003, 0x0020, 0x4014, 0x0000, 0x8005,
+	0x18c3, 0x4a49, 0x4a49, 0x1062, 0x0000, 0x8004, 0x0000, 0x2104, 0x4a49, 0x4208, 0x4014, 0x0000,
+	0x4003, 0x0020, 0x8002, 0x0821, 0x0821, 0x4003, 0x0841, 0x8002, 0x0861, 0x1062, 0x4003, 0x1082,
+	0x4006, 0x10a2, 0x4008, 0x18a3, 0x4005, 0x18c3, 0x400a, 0x18a3, 0x4004, 0x10a2, 0x4003, 0x1082,
+	0x8002, 0x1062, 0x0861, 0x4003, 0x0841, 0x8002, 0x0821, 0x0821, 0x4003, 0x0020, 0x4013, 0x0000,
+	0x8004, 0x2965, 0x4a49, 0x31a6, 0x0000, 0x8004, 0x0000, 0x39c7, 0x4a49, 0x18c3, 0x4013, 0x0000,
+	0x4003, 0x0020, 0x8001, 0x0821, 0x4003, 0x0841, 0x8002, 0x0861, 0x1062, 0x4003, 0x1082, 0x4004,
+	0x10a2, 0x4005, 0x18a3, 0x4013, 0x18c3, 0x4006, 0x18a3, 0x4003, 0x10a2, 0x4003, 0x1082, 0x8002,
+	0x1062, 0x0861, 0x4003, 0x0841, 0x8001, 0x0821, 0x4003, 0x0020, 0x4012, 0x0000, 0x8004, 0x0821,
+	0x4a49, 0x4a49, 0x1082, 0x8003, 0x1082, 0x4a49, 0x4208, 0x4012, 0x0000, 0x4003, 0x0020, 0x8008,
+	0x0821, 0x0821, 0x0841, 0x0841, 0x0861, 0x1062, 0x1082, 0x1082, 0x4004, 0x10a2, 0x4004, 0x18a3,
+	0x4018, 0x18c3, 0x8003, 0x18a3, 0x2124, 0x18c3, 0x4005, 0x18a3, 0x4004, 0x10a2, 0x8007, 0x1082,
+	0x1062, 0x0861, 0x0841, 0x0841, 0x0821, 0x0821, 0x4003, 0x0020, 0x4011, 0x0000, 0x8003, 0x2945,
+	0x4a49, 0x2945, 0x8003, 0x2104, 0x4a49, 0x2945, 0x4011, 0x0000, 0x4003, 0x0020, 0x8007, 0x0821,
+	0x0841, 0x0841, 0x0861, 0x1062, 0x1082, 0x1082, 0x4004, 0x10a2, 0x4003, 0x18a3, 0x400a, 0x18c3,
+	0x400d, 0x18e3, 0x800a, 0x18c3, 0x18c3, 0x2965, 0x8410, 0xdedb, 0xffdf, 0xb5b6, 0x18a3, 0x18c3,
+	0x18c3, 0x4004, 0x18a3, 0x4004, 0x10a2, 0x8006, 0x1082, 0x1062, 0x0861, 0x0841, 0x0841, 0x0821,
+	0x4003, 0x0020, 0x4010, 0x0000, 0x8003, 0x1082, 0x4a49, 0x39c7, 0x8003, 0x3186, 0x4a49, 0x18c3,
+	0x4010, 0x0000, 0x8007, 0x0020, 0x0020, 0x0821, 0x0821, 0x0841, 0x0841, 0x0861, 0x4003, 0x1082,
+	0x4003, 0x10a2, 0x4003, 0x18a3, 0x4007, 0x18c3, 0x4007, 0x18e3, 0x400a, 0x20e4, 0x8009, 0x18e3,
+	0x2945, 0xa514, 0xffff, 0xffff, 0xffdf, 0xf7de, 0xb596, 0x18a3, 0x4004, 0x18c3, 0x4004, 0x18a3,
+	0x4003, 0x10a2, 0x8009, 0x1082, 0x1082, 0x0861, 0x0841, 0x0841, 0x0821, 0x0821, 0x0020, 0x0020,
+	0x400f, 0x0000, 0x8003, 0x0020, 0x4a49, 0x4a49, 0x8003, 0x39c7, 0x4a49, 0x1082, 0x400f, 0x0000,
+	0x8009, 0x0020, 0x0020, 0x0821, 0x0821, 0x0841, 0x0861, 0x1062, 0x1082, 0x1082, 0x4003, 0x10a2,
+	0x8002, 0x18a3, 0x18a3, 0x4007, 0x18c3, 0x4004, 0x18e3, 0x4003, 0x20e4, 0x400c, 0x2104, 0x8009,
+	0x18c3, 0x6b6d, 0xf7de, 0xffff, 0xf79e, 0xef5d, 0xe75c, 0xf79e, 0x8410, 0x4008, 0x18c3, 0x4003,
+	0x18a3, 0x4003, 0x10a2, 0x8008, 0x1082, 0x1062, 0x0861, 0x0841, 0x0821, 0x0821, 0x0020, 0x0020,
+	0x400f, 0x0000, 0x8002, 0x4228, 0x4a49, 0x8003, 0x39e7, 0x4a49, 0x1062, 0x400d, 0x0000, 0x4003,
+	0x0020, 0x8004, 0x0821, 0x0841, 0x0841, 0x0861, 0x4003, 0x1082, 0x8002, 0x10a2, 0x10a2, 0x4003,
+	0x18a3, 0x4006, 0x18c3, 0x4003, 0x18e3, 0x8002, 0x20e4, 0x20e4, 0x400f, 0x2104, 0x800c, 0x20e4,
+	0xa534, 0xffff, 0xf7be, 0xef7d, 0xef5d, 0xe75c, 0xe73c, 0xf79e, 0x528a, 0x18e3, 0x20e4, 0x4003,
+	0x18e3, 0x4004, 0x18c3, 0x4003, 0x18a3, 0x4003, 0x10a2, 0x8006, 0x1082, 0x1082, 0x0861, 0x0841,
+	0x0841, 0x0821, 0x4003, 0x0020, 0x400d, 0x0000, 0x8002, 0x4208, 0x4a49, 0x8003, 0x39e7, 0x4a49,
+	0x1062, 0x400c, 0x0000, 0x4003, 0x0020, 0x8006, 0x0821, 0x0841, 0x0841, 0x1062, 0x1082, 0x1082,
+	0x4003, 0x10a2, 0x8002, 0x18a3, 0x18a3, 0x4005, 0x18c3, 0x4003, 0x18e3, 0x8002, 0x20e4, 0x20e4,
+	0x4009, 0x2104, 0x4008, 0x2124, 0x800c, 0x20e4, 0xb5b6, 0xffff, 0xef7d, 0xef5d, 0xe75c, 0xe75c,
+	0xe73c, 0xe73c, 0xef5d, 0x2945, 0x2104, 0x4003, 0x20e4, 0x4003, 0x18e3, 0x4004, 0x18c3, 0x4003,
+	0x18a3, 0x4003, 0x10a2, 0x8005, 0x1082, 0x1062, 0x0841, 0x0841, 0x0821, 0x4003, 0x0020, 0x400c,
+	0x0000, 0x8002, 0x4208, 0x4a49, 0x8003, 0x39e7, 0x4a49, 0x1062, 0x400b, 0x0000, 0x4003, 0x0020,
+	0x8006, 0x0821, 0x0841, 0x0841, 0x1062, 0x1082, 0x1082, 0x4003, 0x10a2, 0x8001, 0x18a3, 0x4005,
+	0x18c3, 0x4003, 0x18e3, 0x8001, 0x20e4, 0x4007, 0x2104, 0x400c, 0x2124, 0x800c, 0x2104, 0x9cf3,
+	0xffff, 0xef7d, 0xef5d, 0xe75c, 0xe75c, 0xe73c, 0xe73c, 0xef5d, 0xbdd7, 0x18e3, 0x4004, 0x2104,
+	0x8002, 0x20e4, 0x20e4, 0x4003, 0x18e3, 0x4004, 0x18c3, 0x8002, 0x18a3, 0x18a3, 0x4003, 0x10a2,
+	0x8005, 0x1082, 0x1062, 0x0841, 0x0841, 0x0821, 0x4003, 0x0020, 0x400b, 0x0000, 0x8002, 0x4208,
+	0x4a49, 0x8003, 0x39e7, 0x4a49, 0x1062, 0x400a, 0x0000, 0x4003, 0x0020, 0x800a, 0x0821, 0x0841,
+	0x0861, 0x1062, 0x1082, 0x1082, 0x10a2, 0x10a2, 0x18a3, 0x18a3, 0x4005, 0x18c3, 0x8003, 0x18e3,
+	0x18e3, 0x20e4, 0x4006, 0x2104, 0x4005, 0x2124, 0x8002, 0x2925, 0x2925, 0x4007, 0x2945, 0x800e,
+	0x2925, 0x630c, 0xffff, 0xef7d, 0xef5d, 0xe75c, 0xe75c, 0xe73c, 0xe73c, 0xe71c, 0xf7be, 0x5acb,
+	0x2104, 0x2124, 0x4005, 0x2104, 0x8004, 0x20e4, 0x20e4, 0x18e3, 0x18e3, 0x4004, 0x18c3, 0x8002,
+	0x18a3, 0x18a3, 0x4003, 0x10a2, 0x8005, 0x1082, 0x1062, 0x0861, 0x0841, 0x0821, 0x4003, 0x0020,
+	0x400a, 0x0000, 0x8002, 0x4208, 0x4a49, 0x8003, 0x39e7, 0x4a49, 0x1062, 0x400a, 0x0000, 0x800c,
+	0x0020, 0x0020, 0x0821, 0x0841, 0x0861, 0x1062, 0x1082, 0x1082, 0x10a2, 0x10a2, 0x18a3, 0x18a3,
+	0x4004, 0x18c3, 0x8004, 0x18e3, 0x18e3, 0x20e4, 0x20e4, 0x4004, 0x2104, 0x4005, 0x2124, 0x8001,
+	0x2925, 0x400b, 0x2945, 0x800c, 0x2965, 0xf7be, 0xf7de, 0xef7d, 0xef5d, 0xe75c, 0xe73c, 0xe73c,
+	0xe71c, 0xe75c, 0xce79, 0x2104, 0x4004, 0x2124, 0x4004, 0x2104, 0x4003, 0x20e4, 0x8002, 0x18e3,
+	0x18e3, 0x4003, 0x18c3, 0x4003, 0x18a3, 0x8009, 0x10a2, 0x10a2, 0x1082, 0x1062, 0x0861, 0x0841,
+	0x0821, 0x0020, 0x0020, 0x400a, 0x0000, 0x8002, 0x4208, 0x4a49, 0x8003, 0x39e7, 0x4a49, 0x1062,
+	0x4009, 0x0000, 0x8007, 0x0020, 0x0020, 0x0821, 0x0841, 0x0861, 0x1062, 0x1082, 0x4003, 0x10a2,
+	0x8002, 0x18a3, 0x18a3, 0x4004, 0x18c3, 0x8003, 0x18e3, 0x18e3, 0x20e4, 0x4004, 0x2104, 0x4004,
+	0x2124, 0x8001, 0x2925, 0x4007, 0x2945, 0x4006, 0x2965, 0x8005, 0x2945, 0x94b2, 0xffff, 0xef9d,
+	0xef5d, 0x4003, 0xe73c, 0x8008, 0xe71c, 0xe73c, 0xef7d, 0x4a49, 0x2124, 0x2945, 0x2925, 0x2925,
+	0x4003, 0x2124, 0x4004, 0x2104, 0x8004, 0x20e4, 0x20e4, 0x18e3, 0x18e3, 0x4003, 0x18c3, 0x4003,
+	0x18a3, 0x8009, 0x10a2, 0x10a2, 0x1082, 0x1062, 0x0861, 0x0841, 0x0821, 0x0020, 0x0020, 0x4009,
+	0x0000, 0x8002, 0x4208, 0x4a49, 0x8003, 0x39e7, 0x4a49, 0x1062, 0x4008, 0x0000, 0x8007, 0x0020,
+	0x0020, 0x0821, 0x0841, 0x0841, 0x1062, 0x1082, 0x4003, 0x10a2, 0x8001, 0x18a3, 0x4004, 0x18c3,
+	0x8003, 0x18e3, 0x18e3, 0x20e4, 0x4004, 0x2104, 0x4004, 0x2124, 0x4006, 0x2945, 0x4005, 0x2965,
+	0x4005, 0x3166, 0x8004, 0x2965, 0xf7be, 0xffdf, 0xef7d, 0x4003, 0xe73c, 0x8005, 0xe71c, 0xe71c,
+	0xe73c, 0x7bcf, 0x2124, 0x4005, 0x2945, 0x8001, 0x2925, 0x4003, 0x2124, 0x4004, 0x2104, 0x8004,
+	0x20e4, 0x20e4, 0x18e3, 0x18e3, 0x4003, 0x18c3, 0x800b, 0x18a3, 0x18a3, 0x10a2, 0x10a2, 0x1082,
+	0x1062, 0x0841, 0x0841, 0x0821, 0x0020, 0x0020, 0x4008, 0x0000, 0x8002, 0x4208, 0x4a49, 0x8003,
+	0x39e7, 0x4a49, 0x1062, 0x4007, 0x0000, 0x800b, 0x0020, 0x0020, 0x0821, 0x0841, 0x0841, 0x1062,
+	0x1082, 0x1082, 0x10a2, 0x10a2, 0x18a3, 0x4004, 0x18c3, 0x8003, 0x18e3, 0x18e3, 0x20e4, 0x4004,
+	0x2104, 0x4003, 0x2124, 0x4005, 0x2945, 0x4004, 0x2965, 0x8001, 0x3166, 0x4008, 0x3186, 0x800b,
+	0x6b2d, 0xffff, 0xef9d, 0xe73c, 0xe73c, 0xe71c, 0xe71c, 0xdedb, 0xce99, 0x9492, 0x2124, 0x4004,
+	0x2965, 0x4004, 0x2945, 0x8001, 0x2925, 0x4003, 0x2124, 0x4003, 0x2104, 0x8004, 0x20e4, 0x20e4,
+	0x18e3, 0x18e3, 0x4003, 0x18c3, 0x800b, 0x18a3, 0x18a3, 0x10a2, 0x10a2, 0x1082, 0x1062, 0x0841,
+	0x0841, 0x0821, 0x0020, 0x0020, 0x4007, 0x0000, 0x8002, 0x4208, 0x4a49, 0x8003, 0x39e7, 0x4a49,
+	0x1062, 0x4006, 0x0000, 0x800b, 0x0020, 0x0020, 0x0821, 0x0821, 0x0841, 0x1062, 0x1082, 0x1082,
+	0x10a2, 0x10a2, 0x18a3, 0x4004, 0x18c3, 0x8003, 0x18e3, 0x18e3, 0x20e4, 0x4003, 0x2104, 0x4003,
+	0x2124, 0x8001, 0x2925, 0x4004, 0x2945, 0x4003, 0x2965, 0x8001, 0x3166, 0x4005, 0x3186, 0x4005,
+	0x31a6, 0x800c, 0x2965, 0xb5d6, 0xffff, 0xef7d, 0xe73c, 0xdefb, 0xd6ba, 0xbdf7, 0xbdf7, 0x94b2,
+	0x2945, 0x2965, 0x4003, 0x3166, 0x4003, 0x2965, 0x4003, 0x2945, 0x8004, 0x2925, 0x2925, 0x2124,
+	0x2124, 0x4003, 0x2104, 0x8004, 0x20e4, 0x20e4, 0x18e3, 0x18e3, 0x4003, 0x18c3, 0x800b, 0x18a3,
+	0x18a3, 0x10a2, 0x10a2, 0x1082, 0x1062, 0x0841, 0x0841, 0x0821, 0x0020, 0x0020, 0x4006, 0x0000,
+	0x8002, 0x4208, 0x4a49, 0x8003, 0x39e7, 0x4a49, 0x1062, 0x4006, 0x0000, 0x800a, 0x0020, 0x0020,
+	0x0821, 0x0841, 0x0861, 0x1082, 0x1082, 0x10a2, 0x10a2, 0x18a3, 0x4004, 0x18c3, 0x8003, 0x18e3,
+	0x18e3, 0x20e4, 0x4003, 0x2104, 0x4003, 0x2124, 0x4004, 0x2945, 0x8004, 0x2965, 0x2965, 0x3166,
+	0x3166, 0x4003, 0x3186, 0x4009, 0x31a6, 0x800a, 0x2965, 0xe73c, 0xf79e, 0xd6ba, 0xc638, 0xad75,
+	0xa534, 0xbdd7, 0x8430, 0x2945, 0x4007, 0x3186, 0x4003, 0x2965, 0x4003, 0x2945, 0x8003, 0x2925,
+	0x2124, 0x2124, 0x4004, 0x2104, 0x8003, 0x20e4, 0x18e3, 0x18e3, 0x4003, 0x18c3, 0x800a, 0x18a3,
+	0x18a3, 0x10a2, 0x10a2, 0x1082, 0x0861, 0x0841, 0x0821, 0x0020, 0x0020, 0x4006, 0x0000, 0x8002,
+	0x4208, 0x4a49, 0x8003, 0x39e7, 0x4a49, 0x1062, 0x4005, 0x0000, 0x800b, 0x0020, 0x0020, 0x0821,
+	0x0841, 0x0861, 0x1082, 0x1082, 0x10a2, 0x10a2, 0x18a3, 0x18a3, 0x4003, 0x18c3, 0x8003, 0x18e3,
+	0x18e3, 0x20e4, 0x4003, 0x2104, 0x8003, 0x2124, 0x2124, 0x2925, 0x4003, 0x2945, 0x4003, 0x2965,
+	0x8001, 0x3166, 0x4003, 0x3186, 0x4005, 0x31a6, 0x8001, 0x39a7, 0x4006, 0x39c7, 0x8008, 0xad75,
+	0xa514, 0x9492, 0x94d2, 0xb596, 0xb5d6, 0x5acb, 0x2965, 0x4005, 0x31a6, 0x4004, 0x3186, 0x8003,
+	0x3166, 0x2965, 0x2965, 0x4004, 0x2945, 0x4003, 0x2124, 0x4003, 0x2104, 0x8003, 0x20e4, 0x18e3,
+	0x18e3, 0x4003, 0x18c3, 0x8001, 0x18a3, 0x4003, 0x10a2, 0x8006, 0x1082, 0x0861, 0x0841, 0x0821,
+	0x0020, 0x0020, 0x4005, 0x0000, 0x8002, 0x4208, 0x4a49, 0x8003, 0x39e7, 0x4a49, 0x1062, 0x4004,
+	0x0000, 0x800b, 0x0020, 0x0020, 0x0821, 0x0841, 0x0841, 0x1062, 0x1082, 0x10a2, 0x10a2, 0x18a3,
+	0x18a3, 0x4003, 0x18c3, 0x8003, 0x18e3, 0x18e3, 0x20e4, 0x4003, 0x2104, 0x8003, 0x2124, 0x2124,
+	0x2925, 0x4003, 0x2945, 0x8003, 0x2965, 0x2965, 0x3166, 0x4003, 0x3186, 0x4004, 0x31a6, 0x4007,
+	0x39c7, 0x800a, 0x39e7, 0x39e7, 0x4a49, 0xb5b6, 0xa534, 0xbdd7, 0xad75, 0x6b4d, 0x3186, 0x3186,
+	0x4004, 0x39c7, 0x8001, 0x39a7, 0x4003, 0x31a6, 0x4004, 0x3186, 0x8003, 0x3166, 0x2965, 0x2965,
+	0x4003, 0x2945, 0x8003, 0x2925, 0x2124, 0x2124, 0x4003, 0x2104, 0x8003, 0x20e4, 0x18e3, 0x18e3,
+	0x4003, 0x18c3, 0x800a, 0x18a3, 0x10a2, 0x10a2, 0x1082, 0x1062, 0x0841, 0x0841, 0x0821, 0x0020,
+	0x0020, 0x4004, 0x0000, 0x8002, 0x4208, 0x4a49, 0x8003, 0x39e7, 0x4a49, 0x1062, 0x4004, 0x0000,
+	0x800a, 0x0020, 0x0020, 0x0821, 0x0841, 0x0861, 0x1082, 0x1082, 0x10a2, 0x10a2, 0x18a3, 0x4003,
+	0x18c3, 0x8003, 0x18e3, 0x18e3, 0x20e4, 0x4003, 0x2104, 0x8002, 0x2124, 0x2124, 0x4003, 0x2945,
+	0x8003, 0x2965, 0x2965, 0x3166, 0x4003, 0x3186, 0x4006, 0x31a6, 0x8002, 0x39a7, 0x39c7, 0x4007,
+	0x39e7, 0x8007, 0x31a6, 0x8c51, 0x6b6d, 0x4208, 0x3166, 0x31a6, 0x39c7, 0x4003, 0x39e7, 0x8003,
+	0x39c7, 0x39c7, 0x39a7, 0x4009, 0x3186, 0x4003, 0x2965, 0x8005, 0x2945, 0x2945, 0x2925, 0x2124,
+	0x2124, 0x4003, 0x2104, 0x8003, 0x20e4, 0x18e3, 0x18e3, 0x4003, 0x18c3, 0x8009, 0x18a3, 0x10a2,
+	0x10a2, 0x1082, 0x0861, 0x0841, 0x0841, 0x0020, 0x0020, 0x4004, 0x0000, 0x8002, 0x4208, 0x4a49,
+	0x8003, 0x39e7, 0x4a49, 0x1062, 0x4003, 0x0000, 0x800a, 0x0020, 0x0020, 0x0821, 0x0841, 0x0861,
+	0x1082, 0x1082, 0x10a2, 0x10a2, 0x18a3, 0x4003, 0x18c3, 0x8003, 0x18e3, 0x18e3, 0x20e4, 0x4003,
+	0x2104, 0x8002, 0x2124, 0x2124, 0x4003, 0x2945, 0x8013, 0x2965, 0x2965, 0x3166, 0x3186, 0x3186,
+	0x31a6, 0x3186, 0x2965, 0x4228, 0x6b4d, 0x8c51, 0x9cd3, 0x9cd3, 0x8c51, 0x6b4d, 0x4a49, 0x31a6,
+	0x39c7, 0x41e8, 0x4003, 0x4208, 0x8001, 0x39e7, 0x4003, 0x39c7, 0x8010, 0x39e7, 0x41e8, 0x4208,
+	0x41e8, 0x39c7, 0x3186, 0x4208, 0x630c, 0x8430, 0x9d13, 0xb596, 0xad55, 0x9492, 0x6b6d, 0x4228,
+	0x2945, 0x4003, 0x3186, 0x4003, 0x2965, 0x8005, 0x2945, 0x2945, 0x2925, 0x2124, 0x2124, 0x4003,
+	0x2104, 0x8002, 0x20e4, 0x18e3, 0x4004, 0x18c3, 0x8009, 0x18a3, 0x10a2, 0x10a2, 0x1082, 0x0861,
+	0x0841, 0x0821, 0x0020, 0x0020, 0x4003, 0x0000, 0x8002, 0x4208, 0x4a49, 0x8003, 0x39e7, 0x4a49,
+	0x1062, 0x4003, 0x0000, 0x8009, 0x0020, 0x0821, 0x0841, 0x0841, 0x1062, 0x1082, 0x10a2, 0x10a2,
+	0x18a3, 0x4004, 0x18c3, 0x8002, 0x18e3, 0x20e4, 0x4003, 0x2104, 0x8002, 0x2124, 0x2124, 0x4003,
+	0x2945, 0x8009, 0x2965, 0x2965, 0x3166, 0x3186, 0x3186, 0x3166, 0x39c7, 0x8430, 0xdf1b, 0x4008,
+	0xffff, 0x8004, 0xe73c, 0x9492, 0x4208, 0x39c7, 0x4008, 0x4208, 0x8004, 0x31a6, 0x4a49, 0x8c71,
+	0xd6ba, 0x4005, 0xffff, 0x8006, 0xffdf, 0xffdf, 0xffff, 0xf7be, 0xd6ba, 0x7bcf, 0x4003, 0x3186,
+	0x4003, 0x2965, 0x800a, 0x2945, 0x2945, 0x2925, 0x2124, 0x2124, 0x2104, 0x2104, 0x20e4, 0x20e4,
+	0x18e3, 0x4003, 0x18c3, 0x8009, 0x18a3, 0x18a3, 0x10a2, 0x1082, 0x1062, 0x0841, 0x0841, 0x0821,
+	0x0020, 0x4003, 0x0000, 0x8002, 0x4208, 0x4a49, 0x800f, 0x39e7, 0x4a49, 0x1062, 0x0000, 0x0000,
+	0x0020, 0x0020, 0x0821, 0x0841, 0x0861, 0x1082, 0x1082, 0x10a2, 0x18a3, 0x18a3, 0x4003, 0x18c3,
+	0x8002, 0x18e3, 0x20e4, 0x4003, 0x2104, 0x8002, 0x2124, 0x2124, 0x4003, 0x2945, 0x8002, 0x2965,
+	0x2965, 0x4003, 0x3186, 0x8003, 0x3166, 0x9492, 0xffdf, 0x4003, 0xffff, 0x8002, 0xffdf, 0xffdf,
+	0x4005, 0xf7de, 0x800d, 0xffdf, 0xffff, 0xf7be, 0xad55, 0x528a, 0x39c7, 0x39e7, 0x4208, 0x4208,
+	0x39c7, 0x4a49, 0x8c71, 0xdefb, 0x4003, 0xffff, 0x8003, 0xf7de, 0xf79e, 0xef9d, 0x4004, 0xef7d,
+	0x800f, 0xef9d, 0xf79e, 0xf7be, 0xffdf, 0xdf1b, 0x6b2d, 0x2945, 0x3186, 0x3166, 0x2965, 0x2965,
+	0x2945, 0x2945, 0x2925, 0x2124, 0x4003, 0x2104, 0x8003, 0x20e4, 0x20e4, 0x18e3, 0x4003, 0x18c3,
+	0x800d, 0x18a3, 0x18a3, 0x10a2, 0x1082, 0x0861, 0x0841, 0x0821, 0x0020, 0x0020, 0x0000, 0x0000,
+	0x4208, 0x4a49, 0x800e, 0x39e7, 0x4a49, 0x1062, 0x0000, 0x0000, 0x0020, 0x0821, 0x0841, 0x0841,
+	0x1062, 0x1082, 0x10a2, 0x10a2, 0x18a3, 0x4003, 0x18c3, 0x8002, 0x18e3, 0x18e3, 0x4003, 0x2104,
+	0x8007, 0x2124, 0x2124, 0x2925, 0x2945, 0x2945, 0x2965, 0x2965, 0x4003, 0x3186, 0x8002, 0x4a69,
+	0xe73c, 0x4003, 0xffff, 0x8001, 0xffdf, 0x4008, 0xf7de, 0x4003, 0xf7be, 0x8007, 0xffff, 0xffdf,
+	0xdedb, 0xad55, 0x9492, 0x9cf3, 0xdedb, 0x4003, 0xffff, 0x8003, 0xf7de, 0xf7be, 0xf79e, 0x4004,
+	0xef9d, 0x8013, 0xf79e, 0xf7be, 0xf7be, 0xef9d, 0xe73c, 0xdedb, 0xd69a, 0xd69a, 0xdf1b, 0xb596,
+	0x3166, 0x3186, 0x3166, 0x2965, 0x2965, 0x2945, 0x2945, 0x2925, 0x2124, 0x4003, 0x2104, 0x8002,
+	0x20e4, 0x18e3, 0x4004, 0x18c3, 0x800c, 0x18a3, 0x18a3, 0x10a2, 0x1082, 0x0841, 0x0841, 0x0821,
+	0x0020, 0x0000, 0x0000, 0x4208, 0x4a49, 0x800e, 0x39e7, 0x4a49, 0x1062, 0x0000, 0x0020, 0x0020,
+	0x0821, 0x0841, 0x0861, 0x1082, 0x10a2, 0x10a2, 0x18a3, 0x18a3, 0x4003, 0x18c3, 0x800f, 0x18e3,
+	0x20e4, 0x2104, 0x2104, 0x2124, 0x2124, 0x2925, 0x2945, 0x2945, 0x2965, 0x2965, 0x3186, 0x3186,
+	0x3166, 0x6b6d, 0x4003, 0xffff, 0x8001, 0xffdf, 0x4008, 0xf7de, 0x4008, 0xf7be, 0x8008, 0xf7de,
+	0xffdf, 0xffff, 0xf7de, 0xf7be, 0xef9d, 0xef9d, 0xf79e, 0x4003, 0xef9d, 0x8017, 0xf79e, 0xf7be,
+	0xf7be, 0xf79e, 0xe73c, 0xdedb, 0xd69a, 0xd69a, 0xd6ba, 0xdedb, 0xdedb, 0xdefb, 0xe75c, 0xce99,
+	0x3186, 0x3186, 0x3166, 0x2965, 0x2965, 0x2945, 0x2945, 0x2925, 0x2124, 0x4003, 0x2104, 0x8002,
+	0x20e4, 0x18e3, 0x4003, 0x18c3, 0x800c, 0x18a3, 0x18a3, 0x10a2, 0x1082, 0x0861, 0x0841, 0x0821,
+	0x0020, 0x0020, 0x0000, 0x4208, 0x4a49, 0x800d, 0x39e7, 0x4a49, 0x1062, 0x0000, 0x0020, 0x0821,
+	0x0841, 0x0841, 0x1062, 0x1082, 0x10a2, 0x10a2, 0x18a3, 0x4003, 0x18c3, 0x8002, 0x18e3, 0x20e4,
+	0x4003, 0x2104, 0x800a, 0x2124, 0x2124, 0x2945, 0x2945, 0x2965, 0x2965, 0x3166, 0x3186, 0x3166,
+	0x73ae, 0x4003, 0xffff, 0x400a, 0xf7de, 0x4008, 0xf7be, 0x4003, 0xf79e, 0x8001, 0xef9d, 0x4005,
+	0xf79e, 0x4003, 0xf7be, 0x8005, 0xef5d, 0xdefb, 0xd69a, 0xd69a, 0xd6ba, 0x4006, 0xdefb, 0x8011,
+	0xdedb, 0xe73c, 0xce59, 0x2965, 0x3186, 0x3166, 0x2965, 0x2945, 0x2945, 0x2925, 0x2124, 0x2124,
+	0x2104, 0x2104, 0x20e4, 0x20e4, 0x18e3, 0x4003, 0x18c3, 0x800b, 0x18a3, 0x18a3, 0x10a2, 0x1082,
+	0x0841, 0x0841, 0x0821, 0x0020, 0x0000, 0x4208, 0x4a49, 0x800c, 0x39e7, 0x4a49, 0x1082, 0x0020,
+	0x0020, 0x0821, 0x0841, 0x0861, 0x1082, 0x10a2, 0x10a2, 0x18a3, 0x4003, 0x18c3, 0x8007, 0x18e3,
+	0x18e3, 0x20e4, 0x2104, 0x2104, 0x2124, 0x2124, 0x4003, 0x2945, 0x8008, 0x2965, 0x3166, 0x3186,
+	0x3186, 0x630c, 0xffff, 0xffff, 0xf7de, 0x4004, 0xf7be, 0x4008, 0xf7de, 0x400a, 0xf7be, 0x4004,
+	0xf79e, 0x8007, 0xf7be, 0xf7de, 0xf79e, 0xe71c, 0xd6ba, 0xd69a, 0xd6da, 0x4007, 0xdefb, 0x4004,
+	0xdedb, 0x801d, 0xe75c, 0x9cf3, 0x2965, 0x3186, 0x2965, 0x2965, 0x2945, 0x2945, 0x2925, 0x2124,
+	0x2124, 0x2104, 0x2104, 0x20e4, 0x18e3, 0x18e3, 0x18c3, 0x18c3, 0x18a3, 0x18a3, 0x10a2, 0x1082,
+	0x0861, 0x0841, 0x0821, 0x0020, 0x0020, 0x4208, 0x4a49, 0x800c, 0x39e7, 0x4a49, 0x1082, 0x0020,
+	0x0020, 0x0821, 0x0841, 0x1062, 0x1082, 0x10a2, 0x18a3, 0x18a3, 0x4003, 0x18c3, 0x8011, 0x18e3,
+	0x20e4, 0x2104, 0x2104, 0x2124, 0x2124, 0x2925, 0x2945, 0x2945, 0x2965, 0x3166, 0x3186, 0x3186,
+	0x41e8, 0xffdf, 0xffff, 0xf7de, 0x4007, 0xf7be, 0x8005, 0xf7de, 0xf7be, 0xf7be, 0xf7de, 0xf7de,
+	0x400e, 0xf7be, 0x8008, 0xf7de, 0xef9d, 0xdefb, 0xd69a, 0xd6ba, 0xdefb, 0xdf1b, 0xdf1b, 0x4005,
+	0xdefb, 0x4004, 0xdedb, 0x8012, 0xd6ba, 0xdedb, 0xef9d, 0xbdd7, 0x2965, 0x3186, 0x3186, 0x2965,
+	0x2965, 0x2945, 0x2945, 0x2925, 0x2124, 0x2104, 0x2104, 0x20e4, 0x20e4, 0x18e3, 0x4003, 0x18c3,
+	0x800a, 0x18a3, 0x18a3, 0x10a2, 0x1062, 0x0841, 0x0841, 0x0020, 0x0020, 0x4208, 0x4a49, 0x8010,
+	0x39e7, 0x4a49, 0x1082, 0x0020, 0x0821, 0x0841, 0x0861, 0x1082, 0x1082, 0x10a2, 0x18a3, 0x18a3,
+	0x18c3, 0x18c3, 0x18e3, 0x20e4, 0x4003, 0x2104, 0x800c, 0x2124, 0x2124, 0x2945, 0x2945, 0x2965,
+	0x2965, 0x3186, 0x3186, 0x2965, 0xd6ba, 0xffff, 0xf7de, 0x4019, 0xf7be, 0x8009, 0xffdf, 0xef9d,
+	0xdefb, 0xd69a, 0xd6da, 0xe71c, 0xe71c, 0xdf1b, 0xdf1b, 0x4005, 0xdefb, 0x4004, 0xdedb, 0x8005,
+	0xd6ba, 0xd6ba, 0xef7d, 0x9492, 0x2965, 0x4004, 0x3186, 0x8017, 0x2965, 0x2965, 0x2945, 0x2945,
+	0x2124, 0x2124, 0x2104, 0x2104, 0x20e4, 0x18e3, 0x18e3, 0x18c3, 0x18c3, 0x18a3, 0x18a3, 0x10a2,
+	0x1082, 0x0861, 0x0841, 0x0821, 0x0020, 0x4208, 0x4a49, 0x800b, 0x39e7, 0x4a49, 0x1082, 0x0020,
+	0x0821, 0x0841, 0x1062, 0x1082, 0x10a2, 0x18a3, 0x18a3, 0x4003, 0x18c3, 0x8006, 0x18e3, 0x20e4,
+	0x2104, 0x2104, 0x2124, 0x2124, 0x4003, 0x2945, 0x8009, 0x2965, 0x3166, 0x3186, 0x3186, 0x73ae,
+	0xffff, 0xf7de, 0xf79e, 0xf79e, 0x4016, 0xf7be, 0x800a, 0xf7de, 0xf79e, 0xdefb, 0xce99, 0xdedb,
+	0xe73c, 0xe73c, 0xe71c, 0xdf1b, 0xdf1b, 0x4003, 0xdefb, 0x4004, 0xdedb, 0x8001, 0xd6da, 0x4003,
+	0xd6ba, 0x8003, 0xef7d, 0x7bcf, 0x2965, 0x4003, 0x31a6, 0x800d, 0x3186, 0x3186, 0x2965, 0x2965,
+	0x2945, 0x2945, 0x2925, 0x2124, 0x2104, 0x2104, 0x20e4, 0x20e4, 0x18e3, 0x4003, 0x18c3, 0x8009,
+	0x18a3, 0x10a2, 0x1082, 0x1062, 0x0841, 0x0821, 0x0020, 0x4208, 0x4a49, 0x800b, 0x39e7, 0x4a49,
+	0x1082, 0x0821, 0x0841, 0x0861, 0x1082, 0x1082, 0x10a2, 0x18a3, 0x18a3, 0x4003, 0x18c3, 0x8001,
+	0x20e4, 0x4003, 0x2104, 0x800b, 0x2124, 0x2124, 0x2945, 0x2945, 0x2965, 0x2965, 0x3186, 0x3186,
+	0x3166, 0xf79e, 0xffff, 0x4003, 0xf79e, 0x400a, 0xf7be, 0x8001, 0xf7de, 0x4009, 0xf7be, 0x800b,
+	0xffdf, 0xf7de, 0xe71c, 0xce99, 0xd6ba, 0xe73c, 0xe75c, 0xe73c, 0xe73c, 0xe71c, 0xdf1b, 0x4004,
+	0xdefb, 0x8003, 0xdedb, 0xdedb, 0xd6da, 0x4004, 0xd6ba, 0x8003, 0xe75c, 0x8430, 0x3186, 0x4003,
+	0x39c7, 0x801a, 0x31a6, 0x31a6, 0x3186, 0x3186, 0x2965, 0x2965, 0x2945, 0x2945, 0x2124, 0x2124,
+	0x2104, 0x2104, 0x20e4, 0x18e3, 0x18e3, 0x18c3, 0x18c3, 0x18a3, 0x18a3, 0x10a2, 0x1082, 0x0861,
+	0x0841, 0x0821, 0x4208, 0x4a49, 0x800a, 0x39e7, 0x4a49, 0x1082, 0x0821, 0x0841, 0x0861, 0x1082,
+	0x10a2, 0x10a2, 0x18a3, 0x4003, 0x18c3, 0x8010, 0x18e3, 0x20e4, 0x2104, 0x2104, 0x2124, 0x2124,
+	0x2945, 0x2945, 0x2965, 0x2965, 0x3166, 0x3186, 0x3186, 0x73ae, 0xffff, 0xf7be, 0x4004, 0xf79e,
+	0x4011, 0xf7be, 0x8007, 0xffdf, 0xffff, 0xef7d, 0xd69a, 0xd69a, 0xe73c, 0xef5d, 0x4003, 0xe73c,
+	0x8005, 0xe71c, 0xdf1b, 0xdf1b, 0xdefb, 0xdefb, 0x4003, 0xdedb, 0x8001, 0xd6da, 0x4003, 0xd6ba,
+	0x8004, 0xd69a, 0xe71c, 0xad55, 0x3186, 0x4003, 0x39e7, 0x801b, 0x39c7, 0x39a7, 0x31a6, 0x3186,
+	0x3186, 0x3166, 0x2965, 0x2945, 0x2945, 0x2925, 0x2124, 0x2104, 0x2104, 0x20e4, 0x20e4, 0x18e3,
+	0x18c3, 0x18c3, 0x18a3, 0x18a3, 0x10a2, 0x1082, 0x0861, 0x0841, 0x0821, 0x4208, 0x4a49, 0x800a,
+	0x39e7, 0x4a49, 0x1082, 0x0821, 0x0841, 0x1062, 0x1082, 0x10a2, 0x18a3, 0x18a3, 0x4003, 0x18c3,
+	0x8011, 0x20e4, 0x20e4, 0x2104, 0x2104, 0x2124, 0x2124, 0x2945, 0x2945, 0x2965, 0x3166, 0x3186,
+	0x3186, 0x2965, 0xdefb, 0xffff, 0xf79e, 0xef9d, 0x4004, 0xf79e, 0x400e, 0xf7be, 0x800d, 0xf7de,
+	0xffff, 0xf7be, 0xdefb, 0xce79, 0xdf1b, 0xef7d, 0xef5d, 0xe75c, 0xe73c, 0xe73c, 0xe71c, 0xdf1b,
+	0x4004, 0xdefb, 0x8003, 0xdedb, 0xdedb, 0xd6da, 0x4005, 0xd6ba, 0x8016, 0xdedb, 0x39c7, 0x4208,
+	0x4208, 0x41e8, 0x39e7, 0x39c7, 0x39c7, 0x39a7, 0x31a6, 0x3186, 0x3186, 0x2965, 0x2965, 0x2945,
+	0x2945, 0x2124, 0x2124, 0x2104, 0x2104, 0x20e4, 0x18e3, 0x4003, 0x18c3, 0x8008, 0x18a3, 0x18a3,
+	0x10a2, 0x1062, 0x0841, 0x0821, 0x4208, 0x4a49, 0x800e, 0x39e7, 0x4a49, 0x1082, 0x0841, 0x0841,
+	0x1082, 0x1082, 0x10a2, 0x18a3, 0x18a3, 0x18c3, 0x18c3, 0x18e3, 0x20e4, 0x4003, 0x2104, 0x800d,
+	0x2124, 0x2925, 0x2945, 0x2965, 0x2965, 0x3166, 0x3186, 0x31a6, 0x4228, 0xffff, 0xf7be, 0xef7d,
+	0xef9d, 0x4004, 0xf79e, 0x400d, 0xf7be, 0x800e, 0xffdf, 0xffff, 0xef5d, 0xce99, 0xd6ba, 0xef5d,
+	0xef7d, 0xef5d, 0xe75c, 0xe73c, 0xe73c, 0xe71c, 0xdf1b, 0xdf1b, 0x4003, 0xdefb, 0x8002, 0xdedb,
+	0xdedb, 0x4003, 0xd6ba, 0x4003, 0xd69a, 0x8022, 0xe73c, 0x73ae, 0x41e8, 0x4228, 0x4208, 0x4208,
+	0x39e7, 0x39e7, 0x39c7, 0x39a7, 0x31a6, 0x3186, 0x3186, 0x3166, 0x2965, 0x2945, 0x2945, 0x2925,
+	0x2124, 0x2104, 0x2104, 0x20e4, 0x18e3, 0x18e3, 0x18c3, 0x18c3, 0x18a3, 0x18a3, 0x10a2, 0x1082,
+	0x0841, 0x0841, 0x4208, 0x4a49, 0x8009, 0x39e7, 0x4a49, 0x1082, 0x0841, 0x0861, 0x1082, 0x10a2,
+	0x10a2, 0x18a3, 0x4003, 0x18c3, 0x800a, 0x18e3, 0x20e4, 0x2104, 0x2104, 0x2124, 0x2124, 0x2945,
+	0x2945, 0x2965, 0x2965, 0x4003, 0x3186, 0x8006, 0x8410, 0xffff, 0xef9d, 0xef7d, 0xef9d, 0xef9d,
+	0x4004, 0xf79e, 0x400a, 0xf7be, 0x800a, 0xf7de, 0xffdf, 0xf7de, 0xdefb, 0xce59, 0xdf1b, 0xef7d,
+	0xef7d, 0xef5d, 0xe75c, 0x4003, 0xe73c, 0x8004, 0xe71c, 0xdf1b, 0xdefb, 0xdefb, 0x4003, 0xdedb,
+	0x4004, 0xd6ba, 0x8016, 0xd69a, 0xd69a, 0xd6ba, 0xd69a, 0x39c7, 0x4228, 0x4a29, 0x4228, 0x4208,
+	0x4208, 0x39e7, 0x39c7, 0x39c7, 0x39a7, 0x31a6, 0x3186, 0x3186, 0x2965, 0x2965, 0x2945, 0x2945,
+	0x2124, 0x4003, 0x2104, 0x800c, 0x20e4, 0x18e3, 0x18c3, 0x18c3, 0x18a3, 0x18a3, 0x10a2, 0x1082,
+	0x0861, 0x0841, 0x4208, 0x4a49, 0x8009, 0x39e7, 0x4a49, 0x1082, 0x0841, 0x1062, 0x1082, 0x10a2,
+	0x18a3, 0x18a3, 0x4003, 0x18c3, 0x8011, 0x20e4, 0x20e4, 0x2104, 0x2104, 0x2124, 0x2124, 0x2945,
+	0x2945, 0x2965, 0x3166, 0x3186, 0x31a6, 0x2965, 0xc638, 0xffff, 0xef7d, 0xef7d, 0x4003, 0xef9d,
+	0x4003, 0xf79e, 0x4009, 0xf7be, 0x800d, 0xf7de, 0xffff, 0xf79e, 0xce79, 0xce79, 0xef5d, 0xef9d,
+	0xef7d, 0xef5d, 0xe75c, 0xe75c, 0xe73c, 0xe73c, 0x4003, 0xdf1b, 0x8004, 0xdefb, 0xdefb, 0xdedb,
+	0xd6da, 0x4003, 0xd6ba, 0x4004, 0xd69a, 0x8019, 0xdefb, 0x9492, 0x4208, 0x4a49, 0x4a29, 0x4228,
+	0x4208, 0x4208, 0x39e7, 0x39e7, 0x39c7, 0x39c7, 0x31a6, 0x3186, 0x3186, 0x3166, 0x2965, 0x2945,
+	0x2945, 0x2124, 0x2124, 0x2104, 0x2104, 0x20e4, 0x18e3, 0x4003, 0x18c3, 0x8007, 0x18a3, 0x10a2,
+	0x10a2, 0x1062, 0x0841, 0x4208, 0x4a49, 0x800d, 0x39e7, 0x4a49, 0x1082, 0x0841, 0x1062, 0x1082,
+	0x10a2, 0x18a3, 0x18a3, 0x18c3, 0x18c3, 0x18e3, 0x20e4, 0x4003, 0x2104, 0x800b, 0x2124, 0x2925,
+	0x2945, 0x2965, 0x2965, 0x3186, 0x3186, 0x31a6, 0x3186, 0xef9d, 0xf7be, 0x4003, 0xef7d, 0x8002,
+	0xef9d, 0xef9d, 0x4004, 0xf79e, 0x4007, 0xf7be, 0x8014, 0xf7de, 0xffff, 0xe75c, 0xc638, 0xd6ba,
+	0xef7d, 0xef9d, 0xef7d, 0xef7d, 0xef5d, 0xe75c, 0xe73c, 0xe73c, 0xe71c, 0xdf1b, 0xdf1b, 0xdefb,
+	0xdefb, 0xdedb, 0xdedb, 0x4003, 0xd6ba, 0x4003, 0xd69a, 0x8004, 0xce99, 0xce79, 0xe73c, 0x5acb,
+	0x4003, 0x4a49, 0x801e, 0x4a29, 0x4228, 0x4208, 0x4208, 0x39e7, 0x39c7, 0x39c7, 0x31a6, 0x31a6,
+	0x3186, 0x3166, 0x2965, 0x2945, 0x2945, 0x2925, 0x2124, 0x2104, 0x2104, 0x20e4, 0x18e3, 0x18e3,
+	0x18c3, 0x18c3, 0x18a3, 0x18a3, 0x10a2, 0x1062, 0x0841, 0x4208, 0x4a49, 0x801c, 0x39e7, 0x4a49,
+	0x10a2, 0x0841, 0x1082, 0x1082, 0x10a2, 0x18a3, 0x18a3, 0x18c3, 0x18c3, 0x18e3, 0x20e4, 0x2104,
+	0x2104, 0x2124, 0x2925, 0x2945, 0x2945, 0x2965, 0x3166, 0x3186, 0x31a6, 0x31a6, 0x39c7, 0xffff,
+	0xef9d, 0xef5d, 0x4003, 0xef7d, 0x8002, 0xef9d, 0xef9d, 0x4003, 0xf79e, 0x4006, 0xf7be, 0x8006,
+	0xffdf, 0xffff, 0xdefb, 0xbe17, 0xdedb, 0xef9d, 0x4003, 0xef7d, 0x800b, 0xef5d, 0xe75c, 0xe73c,
+	0xe73c, 0xe71c, 0xdf1b, 0xdf1b, 0xdefb, 0xdefb, 0xdedb, 0xdedb, 0x4003, 0xd6ba, 0x4003, 0xd69a,
+	0x8018, 0xce99, 0xce79, 0xd69a, 0xe71c, 0x4228, 0x4a69, 0x4a69, 0x4a49, 0x4a49, 0x4228, 0x4208,
+	0x4208, 0x41e8, 0x39e7, 0x39c7, 0x39c7, 0x31a6, 0x3186, 0x3186, 0x2965, 0x2965, 0x2945, 0x2945,
+	0x2124, 0x4003, 0x2104, 0x800b, 0x18e3, 0x18e3, 0x18c3, 0x18c3, 0x18a3, 0x18a3, 0x10a2, 0x1082,
+	0x0841, 0x4208, 0x4a49, 0x8008, 0x39e7, 0x4a49, 0x10a2, 0x0861, 0x1082, 0x1082, 0x10a2, 0x18a3,
+	0x4003, 0x18c3, 0x8016, 0x18e3, 0x20e4, 0x2104, 0x2104, 0x2124, 0x2925, 0x2945, 0x2945, 0x2965,
+	0x3166, 0x3186, 0x31a6, 0x31a6, 0x4a69, 0xffff, 0xef7d, 0xef5d, 0xef5d, 0xef7d, 0xef7d, 0xef9d,
+	0xef9d, 0x4003, 0xf79e, 0x4005, 0xf7be, 0x8006, 0xf7de, 0xffdf, 0xd69a, 0xbdf7, 0xdf1b, 0xef9d,
+	0x4003, 0xef7d, 0x8002, 0xef5d, 0xe75c, 0x4003, 0xe73c, 0x8001, 0xdf1b, 0x4003, 0xdefb, 0x8005,
+	0xdedb, 0xdedb, 0xd6da, 0xd6ba, 0xd6ba, 0x4003, 0xd69a, 0x8019, 0xce99, 0xce79, 0xce79, 0xd6da,
+	0xdedb, 0x4208, 0x4a69, 0x4a69, 0x4a49, 0x4a49, 0x4228, 0x4228, 0x4208, 0x41e8, 0x39e7, 0x39c7,
+	0x39c7, 0x31a6, 0x3186, 0x3186, 0x3166, 0x2965, 0x2945, 0x2945, 0x2124, 0x4003, 0x2104, 0x800b,
+	0x20e4, 0x18e3, 0x18c3, 0x18c3, 0x18a3, 0x18a3, 0x10a2, 0x1082, 0x0861, 0x4208, 0x4a49, 0x801f,
+	0x39e7, 0x4a49, 0x10a2, 0x0861, 0x1082, 0x10a2, 0x10a2, 0x18a3, 0x18c3, 0x18c3, 0x18e3, 0x20e4,
+	0x20e4, 0x2104, 0x2104, 0x2124, 0x2925, 0x2945, 0x2945, 0x2965, 0x3186, 0x3186, 0x31a6, 0x39a7,
+	0x5aeb, 0xffff, 0xef5d, 0xe75c, 0xef5d, 0xef7d, 0xef7d, 0x4003, 0xef9d, 0x4003, 0xf79e, 0x4003,
+	0xf7be, 0x8006, 0xf7de, 0xf7de, 0xce79, 0xbdf7, 0xe71c, 0xef9d, 0x4003, 0xef7d, 0x8007, 0xef5d,
+	0xef5d, 0xe75c, 0xe73c, 0xe73c, 0xe71c, 0xdf1b, 0x4003, 0xdefb, 0x8004, 0xdedb, 0xd6da, 0xd6ba,
+	0xd6ba, 0x4003, 0xd69a, 0x801f, 0xce99, 0xce79, 0xce79, 0xce59, 0xdefb, 0xd6ba, 0x4208, 0x528a,
+	0x4a69, 0x4a69, 0x4a49, 0x4a49, 0x4228, 0x4208, 0x4208, 0x39e7, 0x39c7, 0x39c7, 0x31a6, 0x31a6,
+	0x3186, 0x3186, 0x2965, 0x2945, 0x2945, 0x2925, 0x2124, 0x2104, 0x2104, 0x20e4, 0x18e3, 0x4003,
+	0x18c3, 0x8006, 0x18a3, 0x10a2, 0x1082, 0x0861, 0x4208, 0x4a49, 0x801d, 0x39e7, 0x4a49, 0x10a2,
+	0x0861, 0x1082, 0x10a2, 0x18a3, 0x18a3, 0x18c3, 0x18c3, 0x18e3, 0x20e4, 0x2104, 0x2104, 0x2124,
+	0x2124, 0x2925, 0x2945, 0x2965, 0x2965, 0x3186, 0x3186, 0x31a6, 0x39a7, 0x6b4d, 0xffff, 0xe75c,
+	0xe75c, 0xef5d, 0x4003, 0xef7d, 0x8004, 0xef9d, 0xef9d, 0xf79e, 0xf79e, 0x4003, 0xf7be, 0x8005,
+	0xf7de, 0xf7be, 0xc658, 0xbdd7, 0xe71c, 0x4004, 0xef7d, 0x800e, 0xef5d, 0xef5d, 0xe75c, 0xe73c,
+	0xe73c, 0xe71c, 0xdf1b, 0xdf1b, 0xdefb, 0xdefb, 0xdedb, 0xd6da, 0xd6ba, 0xd6ba, 0x4003, 0xd69a,
+	0x8020, 0xce99, 0xce79, 0xce79, 0xce59, 0xce59, 0xe73c, 0xd6ba, 0x4208, 0x528a, 0x528a, 0x4a69,
+	0x4a49, 0x4a49, 0x4228, 0x4228, 0x4208, 0x41e8, 0x39e7, 0x39c7, 0x39a7, 0x31a6, 0x3186, 0x3186,
+	0x2965, 0x2945, 0x2945, 0x2925, 0x2124, 0x2104, 0x2104, 0x20e4, 0x18e3, 0x4003, 0x18c3, 0x8006,
+	0x18a3, 0x10a2, 0x10a2, 0x1062, 0x4208, 0x4a49, 0x8015, 0x39e7, 0x4a49, 0x10a2, 0x1062, 0x1082,
+	0x10a2, 0x18a3, 0x18a3, 0x18c3, 0x18c3, 0x18e3, 0x20e4, 0x2104, 0x2104, 0x2124, 0x2124, 0x2945,
+	0x2945, 0x2965, 0x3166, 0x3186, 0x4003, 0x31a6, 0x8008, 0x6b6d, 0xffff, 0xe73c, 0xe75c, 0xef5d,
+	0xef5d, 0xef7d, 0xef7d, 0x4003, 0xef9d, 0x8008, 0xf79e, 0xf79e, 0xf7be, 0xf7de, 0xf7be, 0xc618,
+	0xb5b6, 0xe71c, 0x4004, 0xef7d, 0x8003, 0xef5d, 0xef5d, 0xe75c, 0x4003, 0xe73c, 0x8008, 0xdf1b,
+	0xdf1b, 0xdefb, 0xdefb, 0xdedb, 0xd6da, 0xd6ba, 0xd6ba, 0x4003, 0xd69a, 0x8002, 0xce79, 0xce79,
+	0x4004, 0xce59, 0x801b, 0xe75c, 0xdedb, 0x4228, 0x528a, 0x528a, 0x4a69, 0x4a49, 0x4a49, 0x4a29,
+	0x4228, 0x4208, 0x41e8, 0x39e7, 0x39c7, 0x39c7, 0x31a6, 0x3186, 0x3186, 0x2965, 0x2965, 0x2945,
+	0x2925, 0x2124, 0x2124, 0x2104, 0x20e4, 0x20e4, 0x4003, 0x18c3, 0x8006, 0x18a3, 0x18a3, 0x10a2,
+	0x1062, 0x4208, 0x4a49, 0x8022, 0x39e7, 0x4a49, 0x10a2, 0x1062, 0x1082, 0x10a2, 0x18a3, 0x18a3,
+	0x18c3, 0x18c3, 0x18e3, 0x20e4, 0x2104, 0x2104, 0x2124, 0x2925, 0x2945, 0x2945, 0x2965, 0x3186,
+	0x3186, 0x31a6, 0x31a6, 0x39a7, 0x6b6d, 0xffff, 0xe73c, 0xe73c, 0xe75c, 0xef5d, 0xef7d, 0xef7d,
+	0xef9d, 0xef9d, 0x4003, 0xf79e, 0x8005, 0xf7be, 0xf7be, 0xbe17, 0xb596, 0xdf1b, 0x4003, 0xef7d,
+	0x4003, 0xef5d, 0x800c, 0xe75c, 0xe75c, 0xe73c, 0xe73c, 0xe71c, 0xdf1b, 0xdefb, 0xdefb, 0xdedb,
+	0xdedb, 0xd6ba, 0xd6ba, 0x4003, 0xd69a, 0x4003, 0xce79, 0x8028, 0xce59, 0xce59, 0xc658, 0xce59,
+	0xe73c, 0xef5d, 0x4228, 0x528a, 0x528a, 0x4a69, 0x4a69, 0x4a49, 0x4a29, 0x4228, 0x4208, 0x4208,
+	0x39e7, 0x39c7, 0x39c7, 0x31a6, 0x31a6, 0x3186, 0x3166, 0x2965, 0x2945, 0x2945, 0x2124, 0x2124,
+	0x2104, 0x20e4, 0x20e4, 0x18e3, 0x18c3, 0x18c3, 0x18a3, 0x18a3, 0x10a2, 0x1062, 0x4208, 0x4a49,
+	0x8020, 0x39e7, 0x4a49, 0x10a2, 0x1062, 0x10a2, 0x10a2, 0x18a3, 0x18a3, 0x18c3, 0x18c3, 0x18e3,
+	0x20e4, 0x2104, 0x2104, 0x2124, 0x2925, 0x2945, 0x2945, 0x2965, 0x3186, 0x3186, 0x31a6, 0x31a6,
+	0x39a7, 0x6b4d, 0xffff, 0xe73c, 0xe73c, 0xef5d, 0xef5d, 0xef7d, 0xef7d, 0x4003, 0xef9d, 0x8006,
+	0xf79e, 0xf7be, 0xf7be, 0xbe17, 0xad75, 0xdefb, 0x4003, 0xef7d, 0x4003, 0xef5d, 0x8006, 0xe75c,
+	0xe75c, 0xe73c, 0xe73c, 0xe71c, 0xdf1b, 0x4003, 0xdefb, 0x8008, 0xdedb, 0xd6ba, 0xd6ba, 0xd69a,
+	0xd69a, 0xce99, 0xce79, 0xce79, 0x4003, 0xce59, 0x801f, 0xc658, 0xc638, 0xc638, 0xdf1b, 0xffdf,
+	0x4a49, 0x528a, 0x528a, 0x4a69, 0x4a69, 0x4a49, 0x4a49, 0x4228, 0x4208, 0x4208, 0x39e7, 0x39c7,
+	0x39c7, 0x31a6, 0x31a6, 0x3186, 0x3166, 0x2965, 0x2945, 0x2945, 0x2124, 0x2124, 0x2104, 0x2104,
+	0x20e4, 0x18e3, 0x4003, 0x18c3, 0x8005, 0x18a3, 0x10a2, 0x1062, 0x4208, 0x4a49, 0x802f, 0x39e7,
+	0x4a49, 0x10a2, 0x1062, 0x10a2, 0x10a2, 0x18a3, 0x18a3, 0x18c3, 0x18c3, 0x18e3, 0x20e4, 0x2104,
+	0x2104, 0x2124, 0x2925, 0x2945, 0x2945, 0x2965, 0x3186, 0x3186, 0x31a6, 0x39a7, 0x39c7, 0x5acb,
+	0xffdf, 0xe73c, 0xe73c, 0xe75c, 0xef5d, 0xef7d, 0xef7d, 0xef9d, 0xef9d, 0xf79e, 0xf7be, 0xf7de,
+	0xc618, 0xa554, 0xd6ba, 0xef7d, 0xef5d, 0xef7d, 0xef5d, 0xef5d, 0xe75c, 0xe75c, 0x4003, 0xe73c,
+	0x8002, 0xe71c, 0xdf1b, 0x4003, 0xdefb, 0x8003, 0xdedb, 0xd6ba, 0xd6ba, 0x4003, 0xd69a, 0x8002,
+	0xce79, 0xce79, 0x4003, 0xce59, 0x8001, 0xc658, 0x4003, 0xc638, 0x801c, 0xd6ba, 0xffff, 0x630c,
+	0x52aa, 0x528a, 0x4a69, 0x4a69, 0x4a49, 0x4a49, 0x4228, 0x4208, 0x4208, 0x41e8, 0x39e7, 0x39c7,
+	0x31a6, 0x31a6, 0x3186, 0x3166, 0x2965, 0x2945, 0x2945, 0x2124, 0x2124, 0x2104, 0x2104, 0x20e4,
+	0x18e3, 0x4003, 0x18c3, 0x8005, 0x18a3, 0x10a2, 0x1082, 0x4208, 0x4a49, 0x8027, 0x39e7, 0x4a49,
+	0x18a3, 0x1082, 0x10a2, 0x10a2, 0x18a3, 0x18c3, 0x18c3, 0x18e3, 0x18e3, 0x20e4, 0x2104, 0x2104,
+	0x2124, 0x2925, 0x2945, 0x2945, 0x2965, 0x3186, 0x3186, 0x31a6, 0x39a7, 0x39c7, 0x4a49, 0xf7de,
+	0xe73c, 0xe73c, 0xe75c, 0xef5d, 0xef7d, 0xef7d, 0xef9d, 0xef9d, 0xf79e, 0xf7de, 0xce59, 0xa514,
+	0xce79, 0x4005, 0xef5d, 0x8002, 0xe75c, 0xe75c, 0x4003, 0xe73c, 0x8031, 0xe71c, 0xdf1b, 0xdf1b,
+	0xdefb, 0xdefb, 0xdedb, 0xd6da, 0xd6ba, 0xd6ba, 0xd69a, 0xd69a, 0xce99, 0xce79, 0xce79, 0xce59,
+	0xce59, 0xc658, 0xc638, 0xc638, 0xc618, 0xc618, 0xce59, 0xffff, 0x9cf3, 0x4a69, 0x528a, 0x528a,
+	0x4a69, 0x4a49, 0x4a49, 0x4228, 0x4228, 0x4208, 0x41e8, 0x39e7, 0x39c7, 0x39a7, 0x31a6, 0x3186,
+	0x3166, 0x2965, 0x2945, 0x2945, 0x2124, 0x2124, 0x2104, 0x2104, 0x20e4, 0x18e3, 0x4003, 0x18c3,
+	0x8005, 0x18a3, 0x10a2, 0x1082, 0x4228, 0x4a49, 0x802c, 0x39e7, 0x4a49, 0x18a3, 0x1082, 0x10a2,
+	0x10a2, 0x18a3, 0x18c3, 0x18c3, 0x18e3, 0x18e3, 0x20e4, 0x2104, 0x2104, 0x2124, 0x2925, 0x2945,
+	0x2945, 0x2965, 0x3186, 0x3186, 0x31a6, 0x39a7, 0x39c7, 0x39e7, 0xf7be, 0xe73c, 0xe73c, 0xe75c,
+	0xef5d, 0xef7d, 0xef7d, 0xef9d, 0xef9d, 0xf7de, 0xd6ba, 0x9cf3, 0xc618, 0xe75c, 0xe75c, 0xef5d,
+	0xef5d, 0xe75c, 0xe75c, 0x4004, 0xe73c, 0x8002, 0xdf1b, 0xdf1b, 0x4003, 0xdefb, 0x8008, 0xdedb,
+	0xd6da, 0xd6ba, 0xd6ba, 0xd69a, 0xd69a, 0xce99, 0xce79, 0x4003, 0xce59, 0x8002, 0xc638, 0xc638,
+	0x4005, 0xc618, 0x801b, 0xef5d, 0xef5d, 0x4208, 0x528a, 0x528a, 0x4a69, 0x4a49, 0x4a49, 0x4228,
+	0x4228, 0x4208, 0x41e8, 0x39e7, 0x39c7, 0x39a7, 0x31a6, 0x3186, 0x3166, 0x2965, 0x2945, 0x2945,
+	0x2124, 0x2124, 0x2104, 0x2104, 0x20e4, 0x18e3, 0x4003, 0x18c3, 0x8005, 0x18a3, 0x10a2, 0x1082,
+	0x4228, 0x4a49, 0x8028, 0x39e7, 0x4a49, 0x18a3, 0x1082, 0x10a2, 0x10a2, 0x18a3, 0x18c3, 0x18c3,
+	0x18e3, 0x18e3, 0x20e4, 0x2104, 0x2104, 0x2124, 0x2925, 0x2945, 0x2945, 0x2965, 0x3186, 0x3186,
+	0x31a6, 0x39a7, 0x39c7, 0x31a6, 0xe73c, 0xe75c, 0xe73c, 0xe75c, 0xef5d, 0xef7d, 0xef7d, 0xef9d,
+	0xf7be, 0xdf1b, 0x9cf3, 0xb596, 0xe71c, 0xe75c, 0xef5d, 0x4003, 0xe75c, 0x4004, 0xe73c, 0x8002,
+	0xe71c, 0xdf1b, 0x4003, 0xdefb, 0x8004, 0xdedb, 0xdedb, 0xd6ba, 0xd6ba, 0x4003, 0xd69a, 0x8007,
+	0xce79, 0xce79, 0xce59, 0xce59, 0xc658, 0xc638, 0xc638, 0x4004, 0xc618, 0x801c, 0xbe17, 0xd69a,
+	0xffff, 0x6b4d, 0x528a, 0x528a, 0x4a69, 0x4a49, 0x4a49, 0x4228, 0x4228, 0x4208, 0x41e8, 0x39e7,
+	0x39c7, 0x39a7, 0x31a6, 0x3186, 0x3166, 0x2965, 0x2945, 0x2945, 0x2124, 0x2124, 0x2104, 0x2104,
+	0x20e4, 0x18e3, 0x4003, 0x18c3, 0x8005, 0x18a3, 0x10a2, 0x1082, 0x4228, 0x4a49, 0x8027, 0x39e7,
+	0x4a49, 0x18a3, 0x1082, 0x10a2, 0x10a2, 0x18a3, 0x18c3, 0x18c3, 0x18e3, 0x18e3, 0x20e4, 0x2104,
+	0x2104, 0x2124, 0x2925, 0x2945, 0x2945, 0x2965, 0x3186, 0x3186, 0x31a6, 0x39a7, 0x39c7, 0x3186,
+	0xc638, 0xef7d, 0xe73c, 0xe75c, 0xef5d, 0xef7d, 0xef7d, 0xf7be, 0xef7d, 0xa534, 0xa514, 0xdedb,
+	0xe73c, 0xe75c, 0x4006, 0xe73c, 0x8003, 0xe71c, 0xe71c, 0xdf1b, 0x4003, 0xdefb, 0x800e, 0xdedb,
+	0xdedb, 0xd6ba, 0xd6ba, 0xd69a, 0xd69a, 0xce99, 0xce79, 0xce79, 0xce59, 0xce59, 0xc658, 0xc638,
+	0xc638, 0x4003, 0xc618, 0x801e, 0xbe17, 0xbe17, 0xbdf7, 0xc618, 0xef9d, 0xdefb, 0x4208, 0x528a,
+	0x4a69, 0x4a49, 0x4a49, 0x4a29, 0x4228, 0x4208, 0x41e8, 0x39e7, 0x39c7, 0x39a7, 0x31a6, 0x3186,
+	0x3166, 0x2965, 0x2945, 0x2945, 0x2124, 0x2124, 0x2104, 0x2104, 0x20e4, 0x18e3, 0x4003, 0x18c3,
+	0x8005, 0x18a3, 0x10a2, 0x1082, 0x4228, 0x4a49, 0x8024, 0x39e7, 0x4a49, 0x18a3, 0x1082, 0x10a2,
+	0x10a2, 0x18a3, 0x18c3, 0x18c3, 0x18e3, 0x18e3, 0x20e4, 0x2104, 0x2104, 0x2124, 0x2925, 0x2945,
+	0x2945, 0x2965, 0x3186, 0x3186, 0x31a6, 0x39a7, 0x39c7, 0x39a7, 0x94b2, 0xf7be, 0xe73c, 0xe75c,
+	0xef7d, 0xef7d, 0xef9d, 0xf7be, 0xb5b6, 0x94b2, 0xce59, 0x4008, 0xe73c, 0x8003, 0xe71c, 0xdf1b,
+	0xdf1b, 0x4003, 0xdefb, 0x8002, 0xdedb, 0xdedb, 0x4003, 0xd6ba, 0x8009, 0xd69a, 0xce99, 0xce79,
+	0xce79, 0xce59, 0xce59, 0xc658, 0xc638, 0xc638, 0x4004, 0xc618, 0x801e, 0xbe17, 0xbe17, 0xbdf7,
+	0xbdf7, 0xce79, 0xffff, 0x8430, 0x4a69, 0x4a69, 0x4a49, 0x4a49, 0x4a29, 0x4228, 0x4208, 0x41e8,
+	0x39e7, 0x39c7, 0x39a7, 0x31a6, 0x3186, 0x3166, 0x2965, 0x2945, 0x2945, 0x2124, 0x2124, 0x2104,
+	0x2104, 0x20e4, 0x18e3, 0x4003, 0x18c3, 0x8005, 0x18a3, 0x10a2, 0x1082, 0x4228, 0x4a49, 0x8016,
+	0x39e7, 0x4a49, 0x10a2, 0x1062, 0x10a2, 0x10a2, 0x18a3, 0x18a3, 0x18c3, 0x18c3, 0x18e3, 0x20e4,
+	0x2104, 0x2104, 0x2124, 0x2925, 0x2945, 0x2945, 0x2965, 0x3186, 0x3186, 0x31a6, 0x4003, 0x39c7,
+	0x800b, 0x630c, 0xf7be, 0xe73c, 0xef5d, 0xef7d, 0xef7d, 0xf7de, 0xce59, 0x8c71, 0xb5b6, 0xdf1b,
+	0x4006, 0xe73c, 0x8004, 0xe71c, 0xe71c, 0xdf1b, 0xdf1b, 0x4003, 0xdefb, 0x8002, 0xdedb, 0xd6da,
+	0x4003, 0xd6ba, 0x8004, 0xd69a, 0xd69a, 0xce79, 0xce79, 0x4003, 0xce59, 0x4003, 0xc638, 0x4004,
+	0xc618, 0x8001, 0xbe17, 0x4003, 0xbdf7, 0x801a, 0xc618, 0xdefb, 0xffff, 0x528a, 0x4a69, 0x4a49,
+	0x4a49, 0x4a29, 0x4228, 0x4208, 0x41e8, 0x39e7, 0x39c7, 0x39a7, 0x31a6, 0x3186, 0x3186, 0x2965,
+	0x2945, 0x2945, 0x2124, 0x2124, 0x2104, 0x2104, 0x20e4, 0x18e3, 0x4003, 0x18c3, 0x8005, 0x18a3,
+	0x10a2, 0x1082, 0x4208, 0x4a49, 0x8026, 0x39e7, 0x4a49, 0x10a2, 0x1062, 0x10a2, 0x10a2, 0x18a3,
+	0x18a3, 0x18c3, 0x18c3, 0x18e3, 0x20e4, 0x2104, 0x2104, 0x2124, 0x2925, 0x2945, 0x2965, 0x2965,
+	0x3186, 0x3186, 0x31a6, 0x39a7, 0x39c7, 0x39e7, 0x39e7, 0xef9d, 0xe75c, 0xe75c, 0xef7d, 0xf7be,
+	0xe71c, 0x9492, 0x9cf3, 0xd6ba, 0xdf1b, 0xe73c, 0xe73c, 0x4004, 0xe71c, 0x4003, 0xdf1b, 0x4003,
+	0xdefb, 0x8002, 0xdedb, 0xdedb, 0x4003, 0xd6ba, 0x8004, 0xd69a, 0xce99, 0xce99, 0xce79, 0x4003,
+	0xce59, 0x4003, 0xc638, 0x4004, 0xc618, 0x8001, 0xbe17, 0x4003, 0xbdf7, 0x801b, 0xbe17, 0xbdf7,
+	0xc618, 0xe75c, 0xef9d, 0x4228, 0x4a49, 0x4a49, 0x4228, 0x4228, 0x4208, 0x39e7, 0x39e7, 0x39c7,
+	0x39a7, 0x31a6, 0x3186, 0x3186, 0x2965, 0x2945, 0x2945, 0x2124, 0x2124, 0x2104, 0x2104, 0x20e4,
+	0x18e3, 0x4003, 0x18c3, 0x8005, 0x18a3, 0x10a2, 0x1062, 0x4208, 0x4a49, 0x8023, 0x39e7, 0x4a49,
+	0x10a2, 0x1062, 0x1082, 0x10a2, 0x18a3, 0x18a3, 0x18c3, 0x18c3, 0x18e3, 0x20e4, 0x2104, 0x2104,
+	0x2124, 0x2925, 0x2945, 0x2965, 0x2965, 0x3186, 0x3186, 0x31a6, 0x39a7, 0x39c7, 0x39c7, 0x3186,
+	0xce79, 0xef7d, 0xef5d, 0xef7d, 0xf79e, 0xa534, 0x8c51, 0xc638, 0xdefb, 0x4007, 0xdf1b, 0x4004,
+	0xdefb, 0x4003, 0xdedb, 0x4003, 0xd6ba, 0x8004, 0xd69a, 0xd69a, 0xce99, 0xce79, 0x4003, 0xce59,
+	0x4003, 0xc638, 0x4005, 0xc618, 0x4007, 0xbdf7, 0x8020, 0xc638, 0xef5d, 0xe73c, 0x4228, 0x4a49,
+	0x4228, 0x4208, 0x4208, 0x39e7, 0x39c7, 0x39c7, 0x39a7, 0x31a6, 0x3186, 0x3186, 0x2965, 0x2945,
+	0x2945, 0x2124, 0x2124, 0x2104, 0x20e4, 0x20e4, 0x18e3, 0x18c3, 0x18c3, 0x18a3, 0x18a3, 0x10a2,
+	0x1062, 0x4208, 0x4a49, 0x8023, 0x39e7, 0x4a49, 0x10a2, 0x1062, 0x1082, 0x10a2, 0x18a3, 0x18a3,
+	0x18c3, 0x18c3, 0x18e3, 0x20e4, 0x2104, 0x2104, 0x2124, 0x2124, 0x2945, 0x2945, 0x2965, 0x3166,
+	0x3186, 0x31a6, 0x39a7, 0x39c7, 0x39e7, 0x39c7, 0x8410, 0xf7be, 0xe75c, 0xf7be, 0xc638, 0x8410,
+	0xad55, 0xdedb, 0xdefb, 0x4007, 0xdf1b, 0x4003, 0xdefb, 0x4003, 0xdedb, 0x4003, 0xd6ba, 0x8005,
+	0xd69a, 0xd69a, 0xce99, 0xce79, 0xce79, 0x4003, 0xce59, 0x4003, 0xc638, 0x4004, 0xc618, 0x8001,
+	0xbe17, 0x4008, 0xbdf7, 0x801f, 0xc618, 0xe73c, 0xef7d, 0x5acb, 0x39e7, 0x4208, 0x4208, 0x39e7,
+	0x39c7, 0x39c7, 0x39a7, 0x3186, 0x3186, 0x3166, 0x2965, 0x2945, 0x2945, 0x2124, 0x2124, 0x2104,
+	0x2104, 0x20e4, 0x18e3, 0x18c3, 0x18c3, 0x18a3, 0x18a3, 0x10a2, 0x1062, 0x4208, 0x4a49, 0x8022,
+	0x39e7, 0x4a49, 0x10a2, 0x0861, 0x1082, 0x10a2, 0x18a3, 0x18a3, 0x18c3, 0x18c3, 0x18e3, 0x20e4,
+	0x2104, 0x2104, 0x2124, 0x2124, 0x2945, 0x2945, 0x2965, 0x2965, 0x3186, 0x31a6, 0x31a6, 0x39c7,
+	0x39e7, 0x39e7, 0x4228, 0xf7be, 0xef7d, 0xe73c, 0x8c71, 0x8c51, 0xce79, 0xdedb, 0x400a, 0xdefb,
+	0x8005, 0xdedb, 0xdedb, 0xd6da, 0xd6ba, 0xd6ba, 0x4003, 0xd69a, 0x8008, 0xce99, 0xce79, 0xce79,
+	0xce59, 0xce59, 0xc658, 0xc638, 0xc638, 0x4006, 0xc618, 0x8002, 0xbe17, 0xbe17, 0x4008, 0xbdf7,
+	0x8011, 0xbe17, 0xd6ba, 0xef7d, 0x9cd3, 0x39c7, 0x4208, 0x39e7, 0x39c7, 0x39c7, 0x31a6, 0x31a6,
+	0x3186, 0x2965, 0x2965, 0x2945, 0x2945, 0x2124, 0x4003, 0x2104, 0x800a, 0x18e3, 0x18e3, 0x18c3,
+	0x18c3, 0x18a3, 0x18a3, 0x10a2, 0x1062, 0x4208, 0x4a49, 0x800c, 0x39e7, 0x4a49, 0x10a2, 0x0861,
+	0x1082, 0x10a2, 0x10a2, 0x18a3, 0x18c3, 0x18c3, 0x18e3, 0x20e4, 0x4003, 0x2104, 0x8013, 0x2124,
+	0x2945, 0x2945, 0x2965, 0x3166, 0x3186, 0x3186, 0x31a6, 0x39c7, 0x39c7, 0x39e7, 0x3186, 0xce59,
+	0xf7be, 0xad75, 0x73ae, 0xb596, 0xd6ba, 0xdedb, 0x4008, 0xdefb, 0x4003, 0xdedb, 0x4004, 0xd6ba,
+	0x8003, 0xd69a, 0xd69a, 0xce99, 0x4003, 0xce79, 0x8005, 0xce59, 0xce59, 0xc658, 0xc638, 0xc638,
+	0x4006, 0xc618, 0x8002, 0xbdf7, 0xbe17, 0x400a, 0xbdf7, 0x800f, 0xc618, 0xf79e, 0x8c71, 0x39e7,
+	0x39e7, 0x39c7, 0x39c7, 0x31a6, 0x3186, 0x3186, 0x2965, 0x2965, 0x2945, 0x2925, 0x2124, 0x4003,
+	0x2104, 0x8001, 0x18e3, 0x4003, 0x18c3, 0x8006, 0x18a3, 0x18a3, 0x1082, 0x0861, 0x4208, 0x4a49,
+	0x8021, 0x39e7, 0x4a49, 0x10a2, 0x0861, 0x1082, 0x10a2, 0x10a2, 0x18a3, 0x18c3, 0x18c3, 0x18e3,
+	0x18e3, 0x20e4, 0x2104, 0x2104, 0x2124, 0x2925, 0x2945, 0x2965, 0x2965, 0x3186, 0x3186, 0x31a6,
+	0x39a7, 0x39c7, 0x39e7, 0x39c7, 0x738e, 0xe73c, 0x7bcf, 0x8c51, 0xce79, 0xd6ba, 0x4003, 0xdedb,
+	0x8001, 0xdefb, 0x4007, 0xdedb, 0x4004, 0xd6ba, 0x4003, 0xd69a, 0x8002, 0xce99, 0xce79, 0x4003,
+	0xce59, 0x8001, 0xc658, 0x4004, 0xc638, 0x4004, 0xc618, 0x8003, 0xbe17, 0xbdf7, 0xbe17, 0x400a,
+	0xbdf7, 0x8013, 0xbdd7, 0xe73c, 0x52aa, 0x39e7, 0x39c7, 0x39c7, 0x39a7, 0x31a6, 0x3186, 0x3186,
+	0x2965, 0x2945, 0x2945, 0x2925, 0x2124, 0x2104, 0x2104, 0x20e4, 0x18e3, 0x4003, 0x18c3, 0x8006,
+	0x18a3, 0x10a2, 0x1082, 0x0861, 0x4208, 0x4a49, 0x8021, 0x39e7, 0x4a49, 0x10a2, 0x0841, 0x1082,
+	0x10a2, 0x10a2, 0x18a3, 0x18a3, 0x18c3, 0x18c3, 0x18e3, 0x20e4, 0x2104, 0x2104, 0x2124, 0x2925,
+	0x2945, 0x2945, 0x2965, 0x3166, 0x3186, 0x31a6, 0x39a7, 0x39c7, 0x39e7, 0x39e7, 0x39a7, 0x9cd3,
+	0x6b6d, 0xb596, 0xd69a, 0xd6ba, 0x4009, 0xdedb, 0x4005, 0xd6ba, 0x4003, 0xd69a, 0x8003, 0xce99,
+	0xce79, 0xce79, 0x4003, 0xce59, 0x8001, 0xc658, 0x4004, 0xc638, 0x4005, 0xc618, 0x8001, 0xbe17,
+	0x400a, 0xbdf7, 0x8014, 0xbdd7, 0xc618, 0xdf1b, 0x31a6, 0x39e7, 0x39c7, 0x39c7, 0x39a7, 0x31a6,
+	0x3186, 0x3166, 0x2965, 0x2945, 0x2945, 0x2925, 0x2124, 0x2104, 0x2104, 0x20e4, 0x18e3, 0x4003,
+	0x18c3, 0x8006, 0x18a3, 0x10a2, 0x1082, 0x0861, 0x4208, 0x4a49, 0x8025, 0x39e7, 0x4a49, 0x1082,
+	0x0841, 0x1062, 0x10a2, 0x10a2, 0x18a3, 0x18a3, 0x18c3, 0x18c3, 0x18e3, 0x20e4, 0x2104, 0x2104,
+	0x2124, 0x2124, 0x2945, 0x2945, 0x2965, 0x3166, 0x3186, 0x3186, 0x31a6, 0x39c7, 0x39c7, 0x39e7,
+	0x39a7, 0x4a69, 0x8c71, 0xce59, 0xce99, 0xd6ba, 0xd6da, 0xd6da, 0xdedb, 0xd6da, 0x4003, 0xdedb,
+	0x8002, 0xd6da, 0xd6da, 0x4004, 0xd6ba, 0x4003, 0xd69a, 0x4003, 0xce79, 0x4004, 0xce59, 0x4005,
+	0xc638, 0x4005, 0xc618, 0x8001, 0xbe17, 0x4008, 0xbdf7, 0x4003, 0xbdd7, 0x801c, 0xd6da, 0xad55,
+	0x31a6, 0x39e7, 0x39c7, 0x39c7, 0x31a6, 0x3186, 0x3186, 0x2965, 0x2965, 0x2945, 0x2945, 0x2124,
+	0x2124, 0x2104, 0x2104, 0x20e4, 0x18e3, 0x18c3, 0x18c3, 0x18a3, 0x18a3, 0x10a2, 0x1082, 0x0841,
+	0x4208, 0x4a49, 0x800d, 0x39e7, 0x4a49, 0x1082, 0x0841, 0x1062, 0x1082, 0x10a2, 0x18a3, 0x18a3,
+	0x18c3, 0x18c3, 0x18e3, 0x20e4, 0x4003, 0x2104, 0x8010, 0x2124, 0x2925, 0x2945, 0x2965, 0x2965,
+	0x3186, 0x3186, 0x31a6, 0x39a7, 0x39c7, 0x39e7, 0x39e7, 0x3186, 0xc618, 0xce79, 0xce99, 0x400c,
+	0xd6ba, 0x4003, 0xd69a, 0x4003, 0xce99, 0x8002, 0xce79, 0xce79, 0x4004, 0xce59, 0x4005, 0xc638,
+	0x4006, 0xc618, 0x8001, 0xbe17, 0x4003, 0xbdf7, 0x4007, 0xbdd7, 0x801c, 0xef9d, 0x5aab, 0x39e7,
+	0x39e7, 0x39c7, 0x39a7, 0x31a6, 0x3186, 0x3186, 0x2965, 0x2945, 0x2945, 0x2925, 0x2124, 0x2124,
+	0x2104, 0x2104, 0x18e3, 0x18e3, 0x18c3, 0x18c3, 0x18a3, 0x18a3, 0x10a2, 0x1062, 0x0841, 0x4208,
+	0x4a49, 0x8020, 0x39e7, 0x4a49, 0x1082, 0x0841, 0x0861, 0x1082, 0x10a2, 0x10a2, 0x18a3, 0x18c3,
+	0x18c3, 0x18e3, 0x18e3, 0x20e4, 0x2104, 0x2104, 0x2124, 0x2925, 0x2945, 0x2945, 0x2965, 0x3186,
+	0x3186, 0x31a6, 0x31a6, 0x39c7, 0x39c7, 0x39e7, 0x31a6, 0xa514, 0xdefb, 0xce99, 0x400c, 0xd6ba,
+	0x4003, 0xd69a, 0x8002, 0xce99, 0xce99, 0x4003, 0xce79, 0x4004, 0xce59, 0x8001, 0xc658, 0x4004,
+	0xc638, 0x4006, 0xc618, 0x4004, 0xbdf7, 0x4003, 0xbdd7, 0x8016, 0xb5d6, 0xb5d6, 0xb5b6, 0xce99,
+	0xdefb, 0x3186, 0x39e7, 0x39c7, 0x39c7, 0x31a6, 0x31a6, 0x3186, 0x3166, 0x2965, 0x2945, 0x2945,
+	0x2925, 0x2124, 0x2104, 0x2104, 0x20e4, 0x18e3, 0x4003, 0x18c3, 0x8007, 0x18a3, 0x18a3, 0x1082,
+	0x0861, 0x0841, 0x4208, 0x4a49, 0x8009, 0x39e7, 0x4a49, 0x1082, 0x0841, 0x0841, 0x1082, 0x10a2,
+	0x10a2, 0x18a3, 0x4003, 0x18c3, 0x8013, 0x18e3, 0x20e4, 0x2104, 0x2104, 0x2124, 0x2925, 0x2945,
+	0x2945, 0x2965, 0x3166, 0x3186, 0x3186, 0x31a6, 0x39a7, 0x39c7, 0x39e7, 0x39e7, 0x41e8, 0xe75c,
+	0x4003, 0xd69a, 0x4009, 0xd6ba, 0x4004, 0xd69a, 0x8003, 0xce99, 0xce79, 0xce79, 0x4007, 0xce59,
+	0x4005, 0xc638, 0x4004, 0xc618, 0x8001, 0xbe17, 0x4003, 0xbdf7, 0x4004, 0xbdd7, 0x8016, 0xb5d6,
+	0xb5b6, 0xbdd7, 0xf7be, 0x6b6d, 0x39c7, 0x39e7, 0x39c7, 0x39a7, 0x31a6, 0x3186, 0x3186, 0x3166,
+	0x2965, 0x2945, 0x2945, 0x2124, 0x2124, 0x2104, 0x2104, 0x20e4, 0x18e3, 0x4003, 0x18c3, 0x8007,
+	0x18a3, 0x10a2, 0x1082, 0x0861, 0x0841, 0x4208, 0x4a49, 0x8009, 0x39e7, 0x4a49, 0x1082, 0x0821,
+	0x0841, 0x1062, 0x1082, 0x10a2, 0x18a3, 0x4003, 0x18c3, 0x8015, 0x18e3, 0x20e4, 0x2104, 0x2104,
+	0x2124, 0x2124, 0x2925, 0x2945, 0x2965, 0x2965, 0x3186, 0x3186, 0x31a6, 0x39a7, 0x39c7, 0x39c7,
+	0x39e7, 0x31a6, 0x8c51, 0xe75c, 0xce79, 0x400c, 0xd69a, 0x8002, 0xce99, 0xce99, 0x4006, 0xce79,
+	0x4005, 0xce59, 0x8001, 0xc658, 0x4004, 0xc638, 0x4004, 0xc618, 0x4003, 0xbdf7, 0x8003, 0xbdd7,
+	0xbdd7, 0xb5d6, 0x4003, 0xb5b6, 0x800f, 0xd6ba, 0xdf1b, 0x3186, 0x39e7, 0x39c7, 0x39c7, 0x31a6,
+	0x31a6, 0x3186, 0x3186, 0x2965, 0x2945, 0x2945, 0x2925, 0x2124, 0x4003, 0x2104, 0x800c, 0x18e3,
+	0x18e3, 0x18c3, 0x18c3, 0x18a3, 0x18a3, 0x10a2, 0x1082, 0x0841, 0x0821, 0x4208, 0x4a49, 0x8021,
+	0x39e7, 0x4a49, 0x1082, 0x0821, 0x0841, 0x0861, 0x1082, 0x10a2, 0x10a2, 0x18a3, 0x18c3, 0x18c3,
+	0x18e3, 0x20e4, 0x20e4, 0x2104, 0x2104, 0x2124, 0x2925, 0x2945, 0x2945, 0x2965, 0x3166, 0x3186,
+	0x3186, 0x31a6, 0x39a7, 0x39c7, 0x39e7, 0x39e7, 0x31a6, 0xdedb, 0xd6ba, 0x400d, 0xd69a, 0x8001,
+	0xce99, 0x4006, 0xce79, 0x4006, 0xce59, 0x8001, 0xc658, 0x4003, 0xc638, 0x4004, 0xc618, 0x4003,
+	0xbdf7, 0x8008, 0xbdd7, 0xbdd7, 0xb5d6, 0xb5b6, 0xb5b6, 0xc618, 0xffff, 0x5aeb, 0x4003, 0x39c7,
+	0x800e, 0x39a7, 0x31a6, 0x3186, 0x3186, 0x3166, 0x2965, 0x2945, 0x2945, 0x2925, 0x2124, 0x2104,
+	0x2104, 0x20e4, 0x18e3, 0x4003, 0x18c3, 0x8008, 0x18a3, 0x18a3, 0x1082, 0x0861, 0x0841, 0x0821,
+	0x4208, 0x4a49, 0x800a, 0x39e7, 0x4a49, 0x1082, 0x0821, 0x0841, 0x0861, 0x1082, 0x10a2, 0x10a2,
+	0x18a3, 0x4003, 0x18c3, 0x800e, 0x18e3, 0x20e4, 0x2104, 0x2104, 0x2124, 0x2124, 0x2925, 0x2945,
+	0x2965, 0x2965, 0x3186, 0x3186, 0x31a6, 0x31a6, 0x4004, 0x39c7, 0x8003, 0x5acb, 0xef7d, 0xce79,
+	0x400a, 0xd69a, 0x8002, 0xce99, 0xce99, 0x4008, 0xce79, 0x4007, 0xce59, 0x8002, 0xc638, 0xc638,
+	0x4003, 0xc618, 0x8001, 0xbe17, 0x4003, 0xbdf7, 0x8008, 0xbdd7, 0xb5d6, 0xb5b6, 0xb5b6, 0xb5d6,
+	0xef7d, 0xbdd7, 0x3186, 0x4003, 0x39c7, 0x8005, 0x31a6, 0x31a6, 0x3186, 0x3186, 0x2965, 0x4003,
+	0x2945, 0x8006, 0x2124, 0x2124, 0x2104, 0x2104, 0x20e4, 0x18e3, 0x4003, 0x18c3, 0x8008, 0x18a3,
+	0x10a2, 0x1082, 0x0861, 0x0841, 0x0821, 0x4208, 0x4a49, 0x800a, 0x39e7, 0x4a49, 0x1082, 0x0020,
+	0x0821, 0x0841, 0x1062, 0x1082, 0x10a2, 0x18a3, 0x4003, 0x18c3, 0x800e, 0x18e3, 0x20e4, 0x20e4,
+	0x2104, 0x2104, 0x2124, 0x2925, 0x2945, 0x2945, 0x2965, 0x2965, 0x3186, 0x3186, 0x31a6, 0x4004,
+	0x39c7, 0x8004, 0x3186, 0xa534, 0xe73c, 0xce59, 0x4008, 0xd69a, 0x4007, 0xce99, 0x4007, 0xce79,
+	0x4004, 0xce59, 0x4003, 0xc638, 0x8003, 0xc618, 0xc618, 0xbe17, 0x4003, 0xbdf7, 0x8006, 0xbdd7,
+	0xb5d6, 0xb5b6, 0xb5b6, 0xd6ba, 0xf7de, 0x4004, 0x39c7, 0x800e, 0x39a7, 0x31a6, 0x3186, 0x3186,
+	0x3166, 0x2965, 0x2945, 0x2945, 0x2925, 0x2124, 0x2104, 0x2104, 0x20e4, 0x20e4, 0x4003, 0x18c3,
+	0x8009, 0x18a3, 0x18a3, 0x10a2, 0x1082, 0x0841, 0x0821, 0x0821, 0x4208, 0x4a49, 0x800b, 0x39e7,
+	0x4a49, 0x1082, 0x0020, 0x0821, 0x0841, 0x0861, 0x1082, 0x10a2, 0x10a2, 0x18a3, 0x4003, 0x18c3,
+	0x8016, 0x18e3, 0x20e4, 0x2104, 0x2104, 0x2124, 0x2124, 0x2945, 0x2945, 0x2965, 0x2965, 0x3186,
+	0x3186, 0x31a6, 0x31a6, 0x39c7, 0x39c7, 0x39e7, 0x39c7, 0x31a6, 0xdf1b, 0xd6ba, 0xce79, 0x4004,
+	0xce99, 0x8002, 0xd69a, 0xd69a, 0x400a, 0xce99, 0x8002, 0xce79, 0xce99, 0x4005, 0xce79, 0x8005,
+	0xce59, 0xce59, 0xc658, 0xc638, 0xc638, 0x4003, 0xc618, 0x4003, 0xbdf7, 0x8018, 0xbdd7, 0xb5b6,
+	0xb5b6, 0xce59, 0xffff, 0x6b4d, 0x39a7, 0x39c7, 0x39c7, 0x39a7, 0x31a6, 0x3186, 0x3186, 0x3166,
+	0x2965, 0x2945, 0x2945, 0x2925, 0x2124, 0x2124, 0x2104, 0x2104, 0x20e4, 0x18e3, 0x4003, 0x18c3,
+	0x8009, 0x18a3, 0x10a2, 0x1082, 0x0861, 0x0841, 0x0821, 0x0020, 0x4208, 0x4a49, 0x800b, 0x39e7,
+	0x4a49, 0x1082, 0x0020, 0x0020, 0x0841, 0x0841, 0x1062, 0x10a2, 0x10a2, 0x18a3, 0x4003, 0x18c3,
+	0x800f, 0x18e3, 0x20e4, 0x20e4, 0x2104, 0x2104, 0x2124, 0x2925, 0x2945, 0x2945, 0x2965, 0x2965,
+	0x3186, 0x3186, 0x31a6, 0x31a6, 0x4004, 0x39c7, 0x8004, 0x528a, 0xf7be, 0xce79, 0xce79, 0x4005,
+	0xce99, 0x4004, 0xd69a, 0x8007, 0xce99, 0xd69a, 0xd69a, 0xce99, 0xd69a, 0xd69a, 0xce99, 0x4003,
+	0xd69a, 0x4003, 0xce79, 0x4003, 0xce59, 0x800e, 0xc658, 0xc638, 0xc638, 0xc618, 0xc618, 0xbdf7,
+	0xbdf7, 0xbdd7, 0xbdd7, 0xb5d6, 0xc638, 0xf7de, 0xad75, 0x3186, 0x4003, 0x39c7, 0x8005, 0x39a7,
+	0x31a6, 0x3186, 0x3186, 0x2965, 0x4003, 0x2945, 0x8006, 0x2925, 0x2124, 0x2104, 0x2104, 0x20e4,
+	0x20e4, 0x4003, 0x18c3, 0x800a, 0x18a3, 0x18a3, 0x10a2, 0x1082, 0x0841, 0x0841, 0x0821, 0x0020,
+	0x4208, 0x4a49, 0x800c, 0x39e7, 0x4a49, 0x1082, 0x0020, 0x0020, 0x0821, 0x0841, 0x0861, 0x1082,
+	0x10a2, 0x10a2, 0x18a3, 0x4003, 0x18c3, 0x8006, 0x18e3, 0x20e4, 0x2104, 0x2104, 0x2124, 0x2124,
+	0x4003, 0x2945, 0x8006, 0x2965, 0x2965, 0x3186, 0x3186, 0x31a6, 0x31a6, 0x4003, 0x39c7, 0x8005,
+	0x31a6, 0x73ae, 0xf7be, 0xce59, 0xce79, 0x4003, 0xce99, 0x400a, 0xd69a, 0x8001, 0xce99, 0x4008,
+	0xce79, 0x4003, 0xce59, 0x800c, 0xc638, 0xc638, 0xc618, 0xc618, 0xbe17, 0xbdf7, 0xbdd7, 0xbdd7,
+	0xc638, 0xf79e, 0xdf1b, 0x3186, 0x4003, 0x39c7, 0x800f, 0x39a7, 0x31a6, 0x3186, 0x3186, 0x3166,
+	0x2965, 0x2945, 0x2945, 0x2925, 0x2124, 0x2124, 0x2104, 0x2104, 0x20e4, 0x18e3, 0x4003, 0x18c3,
+	0x800a, 0x18a3, 0x18a3, 0x1082, 0x0861, 0x0841, 0x0821, 0x0020, 0x0020, 0x4208, 0x4a49, 0x800c,
+	0x39e7, 0x4a49, 0x1062, 0x0000, 0x0020, 0x0821, 0x0841, 0x0841, 0x1082, 0x10a2, 0x10a2, 0x18a3,
+	0x4003, 0x18c3, 0x8007, 0x18e3, 0x20e4, 0x20e4, 0x2104, 0x2104, 0x2124, 0x2124, 0x4003, 0x2945,
+	0x8006, 0x2965, 0x3166, 0x3186, 0x3186, 0x31a6, 0x39a7, 0x4003, 0x39c7, 0x8006, 0x3186, 0x8c71,
+	0xf7be, 0xce59, 0xce59, 0xce79, 0x4009, 0xd69a, 0x8003, 0xce79, 0xce59, 0xce59, 0x400a, 0xce79,
+	0x8011, 0xce59, 0xc638, 0xc638, 0xc618, 0xbe17, 0xbdf7, 0xbdf7, 0xc618, 0xce99, 0xf79e, 0xf7be,
+	0x41e8, 0x39a7, 0x39c7, 0x39c7, 0x39a7, 0x31a6, 0x4003, 0x3186, 0x800a, 0x2965, 0x2965, 0x2945,
+	0x2945, 0x2124, 0x2124, 0x2104, 0x2104, 0x20e4, 0x20e4, 0x4003, 0x18c3, 0x800b, 0x18a3, 0x18a3,
+	0x10a2, 0x1082, 0x0861, 0x0841, 0x0821, 0x0020, 0x0000, 0x4208, 0x4a49, 0x800d, 0x39e7, 0x4a49,
+	0x1062, 0x0000, 0x0020, 0x0020, 0x0821, 0x0841, 0x0861, 0x1082, 0x10a2, 0x18a3, 0x18a3, 0x4003,
+	0x18c3, 0x8002, 0x18e3, 0x20e4, 0x4003, 0x2104, 0x800b, 0x2124, 0x2925, 0x2945, 0x2945, 0x2965,
+	0x2965, 0x3166, 0x3186, 0x3186, 0x31a6, 0x39a7, 0x4003, 0x39c7, 0x8007, 0x3166, 0x9cd3, 0xffdf,
+	0xd69a, 0xc658, 0xce79, 0xce79, 0x4003, 0xd69a, 0x8001, 0xce99, 0x4003, 0xce79, 0x800b, 0xce99,
+	0xdedb, 0xe73c, 0xe73c, 0xe71c, 0xdefb, 0xdefb, 0xe71c, 0xe73c, 0xdefb, 0xd6ba, 0x4003, 0xd69a,
+	0x800f, 0xce99, 0xce79, 0xce59, 0xc658, 0xce59, 0xce99, 0xdefb, 0xffdf, 0xf7be, 0x4a49, 0x31a6,
+	0x39c7, 0x39c7, 0x39a7, 0x31a6, 0x4003, 0x3186, 0x8006, 0x2965, 0x2965, 0x2945, 0x2945, 0x2925,
+	0x2124, 0x4003, 0x2104, 0x8002, 0x20e4, 0x18e3, 0x4003, 0x18c3, 0x800b, 0x18a3, 0x18a3, 0x10a2,
+	0x1062, 0x0841, 0x0821, 0x0020, 0x0020, 0x0000, 0x4208, 0x4a49, 0x800d, 0x39e7, 0x4a49, 0x1062,
+	0x0000, 0x0000, 0x0020, 0x0821, 0x0841, 0x0841, 0x1082, 0x10a2, 0x18a3, 0x18a3, 0x4003, 0x18c3,
+	0x8003, 0x18e3, 0x18e3, 0x20e4, 0x4003, 0x2104, 0x8006, 0x2124, 0x2925, 0x2945, 0x2945, 0x2965,
+	0x3166, 0x4003, 0x3186, 0x8002, 0x31a6, 0x39a7, 0x4003, 0x39c7, 0x8029, 0x3166, 0x8c71, 0xffff,
+	0xe75c, 0xd69a, 0xce79, 0xce59, 0xce79, 0xce79, 0xd69a, 0xd6ba, 0xdedb, 0xe73c, 0xdf1b, 0xad75,
+	0x73ae, 0x52aa, 0x4228, 0x41e8, 0x41e8, 0x4a29, 0x6b2d, 0x9cf3, 0xd69a, 0xe73c, 0xdf1b, 0xdefb,
+	0xdefb, 0xdf1b, 0xdefb, 0xdf1b, 0xe73c, 0xf7be, 0xffff, 0xdefb, 0x4208, 0x31a6, 0x39c7, 0x39c7,
+	0x39a7, 0x31a6, 0x4003, 0x3186, 0x800b, 0x2965, 0x2965, 0x2945, 0x2945, 0x2925, 0x2124, 0x2124,
+	0x2104, 0x2104, 0x20e4, 0x18e3, 0x4003, 0x18c3, 0x800c, 0x18a3, 0x18a3, 0x10a2, 0x1082, 0x0861,
+	0x0841, 0x0821, 0x0020, 0x0000, 0x0000, 0x4208, 0x4a49, 0x800e, 0x39e7, 0x4a49, 0x1062, 0x0000,
+	0x0000, 0x0020, 0x0020, 0x0821, 0x0841, 0x0861, 0x1082, 0x10a2, 0x18a3, 0x18a3, 0x4003, 0x18c3,
+	0x8007, 0x18e3, 0x20e4, 0x20e4, 0x2104, 0x2104, 0x2124, 0x2124, 0x4003, 0x2945, 0x8007, 0x2965,
+	0x3166, 0x3186, 0x3186, 0x31a6, 0x31a6, 0x39a7, 0x4003, 0x39c7, 0x801b, 0x3166, 0x5acb, 0xdedb,
+	0xffff, 0xffff, 0xf7be, 0xf7be, 0xf7de, 0xffff, 0xffff, 0xd6ba, 0x8410, 0x4208, 0x31a6, 0x39e7,
+	0x4208, 0x4208, 0x4228, 0x4228, 0x4208, 0x41e8, 0x39a7, 0x31a6, 0x5acb, 0xa534, 0xe71c, 0xffdf,
+	0x4004, 0xffff, 0x8008, 0xf7be, 0x8c51, 0x3186, 0x31a6, 0x39c7, 0x39c7, 0x39a7, 0x31a6, 0x4003,
+	0x3186, 0x800c, 0x2965, 0x2965, 0x2945, 0x2945, 0x2925, 0x2124, 0x2124, 0x2104, 0x2104, 0x20e4,
+	0x20e4, 0x18e3, 0x4003, 0x18c3, 0x800c, 0x18a3, 0x10a2, 0x1082, 0x0861, 0x0841, 0x0821, 0x0020,
+	0x0020, 0x0000, 0x0000, 0x4208, 0x4a49, 0x8003, 0x39e7, 0x4a49, 0x1062, 0x4003, 0x0000, 0x8009,
+	0x0020, 0x0821, 0x0841, 0x0841, 0x1062, 0x1082, 0x10a2, 0x18a3, 0x18a3, 0x4003, 0x18c3, 0x8007,
+	0x18e3, 0x20e4, 0x20e4, 0x2104, 0x2104, 0x2124, 0x2124, 0x4003, 0x2945, 0x8004, 0x2965, 0x3166,
+	0x3186, 0x3186, 0x4003, 0x31a6, 0x4003, 0x39c7, 0x800d, 0x31a6, 0x3166, 0x5aab, 0x94d2, 0xc638,
+	0xce79, 0xbe17, 0x9492, 0x5aab, 0x31a6, 0x39c7, 0x4208, 0x4208, 0x4007, 0x4228, 0x8011, 0x4208,
+	0x4208, 0x39e7, 0x3186, 0x39e7, 0x6b4d, 0x9cd3, 0xa534, 0x9492, 0x630c, 0x31a6, 0x3186, 0x31a6,
+	0x39c7, 0x39a7, 0x39a7, 0x31a6, 0x4003, 0x3186, 0x8007, 0x2965, 0x2965, 0x2945, 0x2945, 0x2925,
+	0x2124, 0x2124, 0x4003, 0x2104, 0x8002, 0x20e4, 0x18e3, 0x4003, 0x18c3, 0x8008, 0x18a3, 0x18a3,
+	0x10a2, 0x1082, 0x0841, 0x0841, 0x0821, 0x0020, 0x4003, 0x0000, 0x8002, 0x4208, 0x4a49, 0x8003,
+	0x39e7, 0x4a49, 0x1062, 0x4003, 0x0000, 0x8009, 0x0020, 0x0020, 0x0821, 0x0841, 0x0861, 0x1082,
+	0x10a2, 0x18a3, 0x18a3, 0x4003, 0x18c3, 0x8003, 0x18e3, 0x18e3, 0x20e4, 0x4003, 0x2104, 0x8002,
+	0x2124, 0x2124, 0x4003, 0x2945, 0x8002, 0x2965, 0x2965, 0x4003, 0x3186, 0x8003, 0x31a6, 0x31a6,
+	0x39a7, 0x4003, 0x39c7, 0x800a, 0x31a6, 0x3186, 0x2965, 0x3166, 0x3186, 0x31a6, 0x39c7, 0x39e7,
+	0x4208, 0x4208, 0x4008, 0x4228, 0x4003, 0x4208, 0x8003, 0x41e8, 0x39e7, 0x39c7, 0x4003, 0x3186,
+	0x8007, 0x31a6, 0x39a7, 0x39c7, 0x39a7, 0x39a7, 0x31a6, 0x31a6, 0x4003, 0x3186, 0x8002, 0x2965,
+	0x2965, 0x4003, 0x2945, 0x8002, 0x2124, 0x2124, 0x4003, 0x2104, 0x8002, 0x20e4, 0x18e3, 0x4004,
+	0x18c3, 0x8008, 0x18a3, 0x10a2, 0x1082, 0x0861, 0x0841, 0x0821, 0x0020, 0x0020, 0x4003, 0x0000,
+	0x8002, 0x4208, 0x4a49, 0x8003, 0x39e7, 0x4a49, 0x1062, 0x4004, 0x0000, 0x8009, 0x0020, 0x0020,
+	0x0841, 0x0841, 0x0861, 0x1082, 0x10a2, 0x18a3, 0x18a3, 0x4003, 0x18c3, 0x8003, 0x18e3, 0x18e3,
+	0x20e4, 0x4003, 0x2104, 0x8002, 0x2124, 0x2124, 0x4003, 0x2945, 0x8005, 0x2965, 0x2965, 0x3166,
+	0x3186, 0x3186, 0x4003, 0x31a6, 0x4006, 0x39c7, 0x8003, 0x39e7, 0x39e7, 0x41e8, 0x400f, 0x4208,
+	0x8002, 0x39e7, 0x39e7, 0x4005, 0x39c7, 0x8003, 0x39a7, 0x39a7, 0x31a6, 0x4004, 0x3186, 0x8002,
+	0x2965, 0x2965, 0x4003, 0x2945, 0x8002, 0x2124, 0x2124, 0x4003, 0x2104, 0x8002, 0x20e4, 0x20e4,
+	0x4004, 0x18c3, 0x8008, 0x18a3, 0x10a2, 0x10a2, 0x1062, 0x0841, 0x0841, 0x0821, 0x0020, 0x4004,
+	0x0000, 0x8002, 0x4208, 0x4a49, 0x8003, 0x39e7, 0x4a49, 0x1062, 0x4004, 0x0000, 0x800a, 0x0020,
+	0x0020, 0x0821, 0x0841, 0x0841, 0x1062, 0x1082, 0x10a2, 0x18a3, 0x18a3, 0x4003, 0x18c3, 0x8003,
+	0x18e3, 0x18e3, 0x20e4, 0x4003, 0x2104, 0x8002, 0x2124, 0x2124, 0x4003, 0x2945, 0x8003, 0x2965,
+	0x2965, 0x3166, 0x4003, 0x3186, 0x8003, 0x31a6, 0x31a6, 0x39a7, 0x4005, 0x39c7, 0x4005, 0x39e7,
+	0x4007, 0x4208, 0x8001, 0x41e8, 0x4006, 0x39e7, 0x4003, 0x39c7, 0x8004, 0x39a7, 0x39a7, 0x31a6,
+	0x31a6, 0x4003, 0x3186, 0x8008, 0x3166, 0x2965, 0x2965, 0x2945, 0x2945, 0x2925, 0x2124, 0x2124,
+	0x4003, 0x2104, 0x8003, 0x20e4, 0x20e4, 0x18e3, 0x4003, 0x18c3, 0x8009, 0x18a3, 0x18a3, 0x10a2,
+	0x1082, 0x0861, 0x0841, 0x0821, 0x0020, 0x0020, 0x4004, 0x0000, 0x8002, 0x4208, 0x4a49, 0x8003,
+	0x39e7, 0x4a49, 0x1062, 0x4005, 0x0000, 0x800a, 0x0020, 0x0020, 0x0821, 0x0841, 0x0861, 0x1082,
+	0x10a2, 0x10a2, 0x18a3, 0x18a3, 0x4003, 0x18c3, 0x8003, 0x18e3, 0x20e4, 0x20e4, 0x4003, 0x2104,
+	0x8009, 0x2124, 0x2124, 0x2925, 0x2945, 0x2945, 0x2965, 0x2965, 0x3166, 0x3166, 0x4003, 0x3186,
+	0x8004, 0x31a6, 0x31a6, 0x39a7, 0x39a7, 0x4006, 0x39c7, 0x400b, 0x39e7, 0x4005, 0x39c7, 0x8004,
+	0x39a7, 0x39a7, 0x31a6, 0x31a6, 0x4004, 0x3186, 0x4003, 0x2965, 0x8005, 0x2945, 0x2945, 0x2925,
+	0x2124, 0x2124, 0x4003, 0x2104, 0x8003, 0x20e4, 0x20e4, 0x18e3, 0x4003, 0x18c3, 0x8009, 0x18a3,
+	0x18a3, 0x10a2, 0x1082, 0x0861, 0x0841, 0x0821, 0x0020, 0x0020, 0x4005, 0x0000, 0x8002, 0x4208,
+	0x4a49, 0x8003, 0x39e7, 0x4a49, 0x1062, 0x4006, 0x0000, 0x8009, 0x0020, 0x0020, 0x0821, 0x0841,
+	0x0861, 0x1082, 0x10a2, 0x18a3, 0x18a3, 0x4004, 0x18c3, 0x8005, 0x18e3, 0x20e4, 0x20e4, 0x2104,
+	0x2104, 0x4003, 0x2124, 0x4004, 0x2945, 0x8003, 0x2965, 0x2965, 0x3166, 0x4004, 0x3186, 0x8004,
+	0x31a6, 0x31a6, 0x39a7, 0x39a7, 0x4011, 0x39c7, 0x8002, 0x39a7, 0x39a7, 0x4003, 0x31a6, 0x4004,
+	0x3186, 0x8003, 0x3166, 0x2965, 0x2965, 0x4003, 0x2945, 0x8003, 0x2925, 0x2124, 0x2124, 0x4003,
+	0x2104, 0x8003, 0x20e4, 0x20e4, 0x18e3, 0x4004, 0x18c3, 0x8008, 0x18a3, 0x10a2, 0x1082, 0x0861,
+	0x0841, 0x0821, 0x0821, 0x0020, 0x4006, 0x0000, 0x8002, 0x4208, 0x4a49, 0x8003, 0x39e7, 0x4a49,
+	0x1062, 0x4006, 0x0000, 0x800a, 0x0020, 0x0020, 0x0821, 0x0841, 0x0841, 0x1062, 0x1082, 0x10a2,
+	0x18a3, 0x18a3, 0x4004, 0x18c3, 0x8003, 0x18e3, 0x18e3, 0x20e4, 0x4003, 0x2104, 0x8003, 0x2124,
+	0x2124, 0x2925, 0x4003, 0x2945, 0x4003, 0x2965, 0x4005, 0x3186, 0x4004, 0x31a6, 0x4004, 0x39a7,
+	0x4005, 0x39c7, 0x4005, 0x39a7, 0x4003, 0x31a6, 0x4005, 0x3186, 0x8001, 0x3166, 0x4003, 0x2965,
+	0x4003, 0x2945, 0x8003, 0x2925, 0x2124, 0x2124, 0x4003, 0x2104, 0x8003, 0x20e4, 0x20e4, 0x18e3,
+	0x4004, 0x18c3, 0x8009, 0x18a3, 0x10a2, 0x10a2, 0x1062, 0x0841, 0x0841, 0x0821, 0x0020, 0x0020,
+	0x4006, 0x0000, 0x8002, 0x4208, 0x4a49, 0x8003, 0x39e7, 0x4a49, 0x1062, 0x4007, 0x0000, 0x800a,
+	0x0020, 0x0020, 0x0821, 0x0841, 0x0841, 0x1062, 0x10a2, 0x10a2, 0x18a3, 0x18a3, 0x4004, 0x18c3,
+	0x8003, 0x18e3, 0x18e3, 0x20e4, 0x4003, 0x2104, 0x4003, 0x2124, 0x4004, 0x2945, 0x4003, 0x2965,
+	0x8001, 0x3166, 0x4005, 0x3186, 0x400f, 0x31a6, 0x4006, 0x3186, 0x8001, 0x3166, 0x4003, 0x2965,
+	0x4003, 0x2945, 0x8001, 0x2925, 0x4003, 0x2124, 0x4003, 0x2104, 0x8003, 0x20e4, 0x20e4, 0x18e3,
+	0x4004, 0x18c3, 0x8009, 0x18a3, 0x10a2, 0x10a2, 0x1082, 0x0841, 0x0841, 0x0821, 0x0020, 0x0020,
+	0x4007, 0x0000, 0x8002, 0x4208, 0x4a49, 0x8003, 0x39e7, 0x4a49, 0x1062, 0x4008, 0x0000, 0x800a,
+	0x0020, 0x0020, 0x0821, 0x0841, 0x0841, 0x1062, 0x10a2, 0x10a2, 0x18a3, 0x18a3, 0x4004, 0x18c3,
+	0x8003, 0x18e3, 0x18e3, 0x20e4, 0x4003, 0x2104, 0x4004, 0x2124, 0x4004, 0x2945, 0x4004, 0x2965,
+	0x8001, 0x3166, 0x4014, 0x3186, 0x8001, 0x3166, 0x4004, 0x2965, 0x4003, 0x2945, 0x8004, 0x2925,
+	0x2925, 0x2124, 0x2124, 0x4004, 0x2104, 0x8003, 0x20e4, 0x20e4, 0x18e3, 0x4004, 0x18c3, 0x8009,
+	0x18a3, 0x18a3, 0x10a2, 0x1082, 0x0861, 0x0841, 0x0821, 0x0020, 0x0020, 0x4008, 0x0000, 0x8002,
+	0x4208, 0x4a49, 0x8003, 0x39e7, 0x4a49, 0x1062, 0x4009, 0x0000, 0x800a, 0x0020, 0x0020, 0x0821,
+	0x0841, 0x0861, 0x1062, 0x10a2, 0x10a2, 0x18a3, 0x18a3, 0x4004, 0x18c3, 0x8007, 0x18e3, 0x18e3,
+	0x20e4, 0x2945, 0x632c, 0x2945, 0x39e7, 0x4004, 0x632c, 0x8005, 0x5aeb, 0x3186, 0x39c7, 0x632c,
+	0x3186, 0x4005, 0x2965, 0x8001, 0x3166, 0x400c, 0x3186, 0x8001, 0x3166, 0x4006, 0x2965, 0x8004,
+	0x2945, 0x2945, 0x39c7, 0x5acb, 0x4003, 0x632c, 0x8009, 0x4a49, 0x2104, 0x2104, 0x2124, 0x52aa,
+	0x632c, 0x632c, 0x5aeb, 0x3166, 0x4003, 0x18c3, 0x8009, 0x18a3, 0x18a3, 0x10a2, 0x1082, 0x0861,
+	0x0841, 0x0821, 0x0821, 0x0020, 0x4009, 0x0000, 0x8002, 0x4208, 0x4a49, 0x8003, 0x39e7, 0x4a49,
+	0x1062, 0x400a, 0x0000, 0x8008, 0x0020, 0x0020, 0x0821, 0x0841, 0x0861, 0x1062, 0x10a2, 0x10a2,
+	0x4003, 0x18a3, 0x4004, 0x18c3, 0x800e, 0x18e3, 0x20e4, 0x20e4, 0x2104, 0x39e7, 0x5aeb, 0x2104,
+	0x2124, 0x2124, 0x52aa, 0x528a, 0x39c7, 0x632c, 0x3186, 0x4003, 0x2945, 0x4013, 0x2965, 0x4004,
+	0x2945, 0x801a, 0x39e7, 0x632c, 0x4228, 0x2124, 0x2124, 0x31a6, 0x5acb, 0x528a, 0x2104, 0x4a49,
+	0x52aa, 0x18e3, 0x18e3, 0x39e7, 0x632c, 0x2104, 0x18c3, 0x18a3, 0x10a2, 0x10a2, 0x1082, 0x0861,
+	0x0841, 0x0821, 0x0821, 0x0020, 0x400a, 0x0000, 0x8002, 0x4208, 0x4a49, 0x8003, 0x39e7, 0x4a49,
+	0x1062, 0x400a, 0x0000, 0x4003, 0x0020, 0x8006, 0x0821, 0x0841, 0x0861, 0x1062, 0x10a2, 0x10a2,
+	0x4003, 0x18a3, 0x4004, 0x18c3, 0x8005, 0x2124, 0x632c, 0x2945, 0x39e7, 0x5aeb, 0x4003, 0x2104,
+	0x8022, 0x41e8, 0x5aeb, 0x39a7, 0x632c, 0x52aa, 0x632c, 0x632c, 0x4208, 0x2945, 0x39c7, 0x5aeb,
+	0x632c, 0x630c, 0x4208, 0x2945, 0x4a29, 0x630c, 0x5acb, 0x632c, 0x630c, 0x39c7, 0x2965, 0x39c7,
+	0x630c, 0x632c, 0x630c, 0x4208, 0x2945, 0x2945, 0x2925, 0x2124, 0x5acb, 0x4228, 0x2124, 0x4003,
+	0x2104, 0x8014, 0x2945, 0x632c, 0x2965, 0x528a, 0x41e8, 0x18e3, 0x18c3, 0x18c3, 0x5acb, 0x39a7,
+	0x18a3, 0x10a2, 0x10a2, 0x1082, 0x0861, 0x0841, 0x0821, 0x0821, 0x0020, 0x0020, 0x400a, 0x0000,
+	0x8002, 0x4208, 0x4a49, 0x8003, 0x39e7, 0x4a49, 0x1062, 0x400b, 0x0000, 0x4003, 0x0020, 0x8009,
+	0x0821, 0x0841, 0x0841, 0x1062, 0x1082, 0x10a2, 0x10a2, 0x18a3, 0x18a3, 0x4003, 0x18c3, 0x8024,
+	0x2124, 0x632c, 0x2925, 0x39c7, 0x5aeb, 0x20e4, 0x2104, 0x2104, 0x52aa, 0x528a, 0x31a6, 0x632c,
+	0x4a69, 0x2124, 0x4a69, 0x5acb, 0x2945, 0x630c, 0x4228, 0x2945, 0x39c7, 0x632c, 0x3186, 0x4228,
+	0x632c, 0x4208, 0x2965, 0x5aeb, 0x4a49, 0x2965, 0x5aeb, 0x31a6, 0x2945, 0x39e7, 0x630c, 0x2945,
+	0x4003, 0x2124, 0x8002, 0x632c, 0x2965, 0x4003, 0x2104, 0x8014, 0x20e4, 0x20e4, 0x5aab, 0x31a6,
+	0x41e8, 0x632c, 0x5aab, 0x4a49, 0x4208, 0x18a3, 0x18a3, 0x10a2, 0x10a2, 0x1082, 0x0861, 0x0841,
+	0x0821, 0x0821, 0x0020, 0x0020, 0x400b, 0x0000, 0x8002, 0x4208, 0x4a49, 0x8003, 0x39e7, 0x4a49,
+	0x1062, 0x400c, 0x0000, 0x4003, 0x0020, 0x800f, 0x0821, 0x0841, 0x0841, 0x1062, 0x1082, 0x10a2,
+	0x10a2, 0x18a3, 0x18a3, 0x18c3, 0x18c3, 0x2104, 0x632c, 0x2124, 0x39c7, 0x4004, 0x632c, 0x8016,
+	0x5aeb, 0x2945, 0x31a6, 0x632c, 0x3186, 0x2124, 0x4208, 0x5aeb, 0x39a7, 0x632c, 0x2124, 0x2925,
+	0x2925, 0x5acb, 0x4208, 0x4228, 0x630c, 0x2925, 0x2925, 0x52aa, 0x4a69, 0x4208, 0x4005, 0x632c,
+	0x8007, 0x2965, 0x2124, 0x2104, 0x2104, 0x632c, 0x2945, 0x2104, 0x4003, 0x20e4, 0x8012, 0x18e3,
+	0x5aeb, 0x31a6, 0x18c3, 0x18c3, 0x4208, 0x4a29, 0x5acb, 0x632c, 0x2124, 0x1082, 0x1062, 0x0841,
+	0x0841, 0x0821, 0x0821, 0x0020, 0x0020, 0x400c, 0x0000, 0x8002, 0x4208, 0x4a49, 0x8003, 0x39e7,
+	0x4a49, 0x1062, 0x400d, 0x0000, 0x4003, 0x0020, 0x800f, 0x0821, 0x0841, 0x0841, 0x0861, 0x1082,
+	0x10a2, 0x10a2, 0x18a3, 0x18a3, 0x18c3, 0x2104, 0x632c, 0x2124, 0x39c7, 0x5aeb, 0x4003, 0x18e3,
+	0x800a, 0x20e4, 0x2104, 0x3186, 0x632c, 0x2945, 0x2104, 0x4208, 0x5aeb, 0x31a6, 0x630c, 0x4003,
+	0x2124, 0x800c, 0x5acb, 0x41e8, 0x4228, 0x5aeb, 0x2124, 0x2124, 0x52aa, 0x4a69, 0x41e8, 0x5acb,
+	0x2124, 0x2124, 0x4006, 0x2104, 0x8017, 0x5acb, 0x39e7, 0x20e4, 0x20e4, 0x18e3, 0x18e3, 0x2945,
+	0x632c, 0x20e4, 0x630c, 0x3186, 0x18a3, 0x18a3, 0x10a2, 0x4a69, 0x39c7, 0x0861, 0x0841, 0x0841,
+	0x0821, 0x0821, 0x0020, 0x0020, 0x400d, 0x0000, 0x8002, 0x4208, 0x4a49, 0x8003, 0x39c7, 0x4a49,
+	0x10a2, 0x400f, 0x0000, 0x8012, 0x0020, 0x0020, 0x0821, 0x0841, 0x0841, 0x0861, 0x1062, 0x1082,
+	0x10a2, 0x10a2, 0x18a3, 0x2104, 0x632c, 0x2104, 0x39c7, 0x5aeb, 0x18c3, 0x18c3, 0x4003, 0x18e3,
+	0x8032, 0x3186, 0x632c, 0x2945, 0x2104, 0x4208, 0x5aeb, 0x2124, 0x630c, 0x4208, 0x2104, 0x39c7,
+	0x632c, 0x2965, 0x4208, 0x5aeb, 0x2104, 0x2104, 0x52aa, 0x4a49, 0x2945, 0x632c, 0x31a6, 0x2104,
+	0x4208, 0x5aeb, 0x2104, 0x2104, 0x20e4, 0x20e4, 0x31a6, 0x632c, 0x4208, 0x18e3, 0x18e3, 0x3166,
+	0x5aeb, 0x4208, 0x18c3, 0x4a29, 0x52aa, 0x2104, 0x10a2, 0x2124, 0x5acb, 0x39a7, 0x0841, 0x0841,
+	0x0821, 0x0020, 0x0020, 0x400f, 0x0000, 0x8002, 0x4228, 0x4a49, 0x8003, 0x3186, 0x4a49, 0x18c3,
+	0x4010, 0x0000, 0x800f, 0x0020, 0x0020, 0x0821, 0x0821, 0x0841, 0x0841, 0x1062, 0x1082, 0x10a2,
+	0x10a2, 0x2104, 0x632c, 0x2104, 0x39c7, 0x5aeb, 0x4004, 0x18c3, 0x801a, 0x18e3, 0x3186, 0x632c,
+	0x2925, 0x20e4, 0x4208, 0x5aeb, 0x2104, 0x3186, 0x630c, 0x632c, 0x630c, 0x39e7, 0x2104, 0x4208,
+	0x5aeb, 0x2104, 0x2104, 0x52aa, 0x4a49, 0x2104, 0x39e7, 0x630c, 0x632c, 0x5aeb, 0x3186, 0x4003,
+	0x20e4, 0x800c, 0x18e3, 0x18e3, 0x39c7, 0x5aab, 0x632c, 0x632c, 0x630c, 0x39e7, 0x18c3, 0x18a3,
+	0x18e3, 0x4a69, 0x4003, 0x632c, 0x8006, 0x31a6, 0x0841, 0x0821, 0x0821, 0x0020, 0x0020, 0x4010,
+	0x0000, 0x8002, 0x4a49, 0x4a49, 0x8003, 0x2124, 0x4a49, 0x2945, 0x4011, 0x0000, 0x4003, 0x0020,
+	0x8008, 0x0821, 0x0841, 0x0841, 0x0861, 0x1062, 0x1082, 0x10a2, 0x10a2, 0x4003, 0x18a3, 0x4007,
+	0x18c3, 0x4006, 0x18e3, 0x4010, 0x20e4, 0x4003, 0x18e3, 0x4008, 0x18c3, 0x4003, 0x18a3, 0x800a,
+	0x10a2, 0x1082, 0x1082, 0x0861, 0x0841, 0x0841, 0x0821, 0x0821, 0x0020, 0x0020, 0x4010, 0x0000,
+	0x8003, 0x1082, 0x4a49, 0x39c7, 0x8003, 0x1082, 0x4a49, 0x41e8, 0x4012, 0x0000, 0x4003, 0x0020,
+	0x8001, 0x0821, 0x4003, 0x0841, 0x8005, 0x0861, 0x1082, 0x1082, 0x10a2, 0x10a2, 0x4003, 0x18a3,
+	0x400a, 0x18c3, 0x4005, 0x18e3, 0x4005, 0x20e4, 0x4005, 0x18e3, 0x400b, 0x18c3, 0x4003, 0x18a3,
+	0x8004, 0x10a2, 0x10a2, 0x1082, 0x0861, 0x4003, 0x0841, 0x8001, 0x0821, 0x4003, 0x0020, 0x4011,
+	0x0000, 0x8003, 0x2124, 0x4a49, 0x2945, 0x8004, 0x0000, 0x39c7, 0x4a49, 0x10a2, 0x4013, 0x0000,
+	0x4003, 0x0020, 0x8009, 0x0821, 0x0841, 0x0841, 0x0861, 0x1062, 0x1082, 0x1082, 0x10a2, 0x10a2,
+	0x4004, 0x18a3, 0x401e, 0x18c3, 0x4003, 0x18a3, 0x4003, 0x10a2, 0x8009, 0x1082, 0x1062, 0x0861,
+	0x0841, 0x0841, 0x0821, 0x0821, 0x0020, 0x0020, 0x4012, 0x0000, 0x8004, 0x0020, 0x4228, 0x4a49,
+	0x10a2, 0x8004, 0x0000, 0x2124, 0x4a49, 0x39e7, 0x4014, 0x0000, 0x4003, 0x0020, 0x800a, 0x0821,
+	0x0821, 0x0841, 0x0841, 0x0861, 0x0861, 0x1062, 0x1082, 0x10a2, 0x10a2, 0x4006, 0x18a3, 0x4017,
+	0x18c3, 0x4004, 0x18a3, 0x800a, 0x10a2, 0x10a2, 0x1082, 0x1082, 0x0861, 0x0861, 0x0841, 0x0841,
+	0x0821, 0x0821, 0x4003, 0x0020, 0x4013, 0x0000, 0x8004, 0x2124, 0x4a49, 0x31a6, 0x0000, 0x8005,
+	0x0000, 0x0000, 0x39c7, 0x4a49, 0x2945, 0x4015, 0x0000, 0x4003, 0x0020, 0x8002, 0x0821, 0x0821,
+	0x4003, 0x0841, 0x8006, 0x0861, 0x1062, 0x1082, 0x1082, 0x10a2, 0x10a2, 0x4009, 0x18a3, 0x400c,
+	0x18c3, 0x4006, 0x18a3, 0x4003, 0x10a2, 0x8003, 0x1082, 0x1082, 0x0861, 0x4003, 0x0841, 0x8002,
+	0x0821, 0x0821, 0x4003, 0x0020, 0x4014, 0x0000, 0x8005, 0x1082, 0x4a49, 0x4a49, 0x10a2, 0x0000,
+	0x8006, 0x0000, 0x0000, 0x1082, 0x4a49, 0x4a49, 0x2104, 0x4016, 0x0000, 0x4003, 0x0020, 0x8002,
+	0x0821, 0x0821, 0x4003, 0x0841, 0x8002, 0x0861, 0x0861, 0x4003, 0x1082, 0x4004, 0x10a2, 0x4011,
+	0x18a3, 0x4004, 0x10a2, 0x4003, 0x1082, 0x8002, 0x0861, 0x0861, 0x4003, 0x0841, 0x8002, 0x0821,
+	0x0821, 0x4003, 0x0020, 0x4015, 0x0000, 0x8006, 0x1062, 0x4228, 0x4a49, 0x2965, 0x0000, 0x0000,
+	0x4003, 0x0000, 0x8005, 0x18c3, 0x4a49, 0x4a49, 0x2965, 0x0020, 0x4016, 0x0000, 0x4003, 0x0020,
+	0x4003, 0x0821, 0x4003, 0x0841, 0x8003, 0x0861, 0x0861, 0x1062, 0x4004, 0x1082, 0x4010, 0x10a2,
+	0x4003, 0x1082, 0x8003, 0x1062, 0x0861, 0x0861, 0x4003, 0x0841, 0x4003, 0x0821, 0x4003, 0x0020,
+	0x4016, 0x0000, 0x8004, 0x18c3, 0x4a49, 0x4a49, 0x3186, 0x4003, 0x0000, 0x4004, 0x0000, 0x8006,
+	0x18c3, 0x4a49, 0x4a49, 0x4228, 0x20e4, 0x0821, 0x4016, 0x0000, 0x4003, 0x0020, 0x4004, 0x0821,
+	0x4004, 0x0841, 0x4003, 0x0861, 0x8002, 0x1062, 0x1062, 0x400b, 0x1082, 0x8002, 0x1062, 0x1062,
+	0x4003, 0x0861, 0x4004, 0x0841, 0x4004, 0x0821, 0x4003, 0x0020, 0x4016, 0x0000, 0x8005, 0x10a2,
+	0x39c7, 0x4a49, 0x4a49, 0x3166, 0x4004, 0x0000, 0x4005, 0x0000, 0x8002, 0x1062, 0x39a7, 0x4003,
+	0x4a49, 0x8003, 0x31a6, 0x2965, 0x2124, 0x4011, 0x20e4, 0x4010, 0x2104, 0x4010, 0x2124, 0x400f,
+	0x2104, 0x4010, 0x20e4, 0x8008, 0x2104, 0x2965, 0x3186, 0x4228, 0x4a49, 0x4a49, 0x39e7, 0x20e4,
+	0x4005, 0x0000, 0x4007, 0x0000, 0x8003, 0x18e3, 0x31a6, 0x4228, 0x4057, 0x4a49, 0x8002, 0x39c7,
+	0x2124, 0x4007, 0x0000, 0x4009, 0x0000, 0x8004, 0x0020, 0x18a3, 0x20e4, 0x2124, 0x4050, 0x2965,
+	0x8004, 0x2945, 0x20e4, 0x18c3, 0x0841, 0x4009, 0x0000,
+};
+
+const int dataiPhoneOSSelectedRLE_width = 106;
+const int dataiPhoneOSSelectedRLE_height = 107;
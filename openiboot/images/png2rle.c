@@ -0,0 +1,268 @@
+/*
+ * Converts a PNG on stdin to a run-length encoded, premultiplied RGB565
+ * image for framebuffer_draw_rle_image and writes it as a C include on
+ * stdout. Only 8-bit, non-interlaced PNGs are handled, which is all the
+ * menu uses. Needs zlib.
+ *
+ * Each row is a sequence of runs. A run starts with a word holding the
+ * run type in the top two bits and the pixel count below:
+ *
+ *   0  skip:  fully transparent pixels, nothing follows
+ *   1  fill:  opaque pixels of one colour, one colour word follows
+ *   2  copy:  opaque pixels, one colour word per pixel follows
+ *   3  blend: translucent pixels, a premultiplied colour word and an
+ *             inverse alpha (0 to 32) word per pixel follow
+ *
+ * Runs never cross the end of a row.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <zlib.h>
+
+#define RUN_SKIP 0
+#define RUN_FILL 1
+#define RUN_COPY 2
+#define RUN_BLEND 3
+#define RUN_MAX 0x3FFF
+
+static unsigned char* readAll(size_t* size)
+{
+	size_t allocated = 65536;
+	unsigned char* data = malloc(allocated);
+	size_t n;
+
+	*size = 0;
+	while((n = fread(data + *size, 1, allocated - *size, stdin)) > 0) {
+		*size += n;
+		if(*size == allocated) {
+			allocated *= 2;
+			data = realloc(data, allocated);
+		}
+	}
+
+	return data;
+}
+
+static unsigned int be32(const unsigned char* p)
+{
+	return (p[0] << 24) | (p[1] << 16) | (p[2] << 8) | p[3];
+}
+
+static int paeth(int a, int b, int c)
+{
+	int p = a + b - c;
+	int pa = abs(p - a);
+	int pb = abs(p - b);
+	int pc = abs(p - c);
+	if(pa <= pb && pa <= pc)
+		return a;
+	if(pb <= pc)
+		return b;
+	return c;
+}
+
+// Decodes to 8-bit RGBA.
+static unsigned char* decodePNG(const unsigned char* png, size_t size, int* width, int* height)
+{
+	static const int channelsForType[7] = { 1, 0, 3, 0, 2, 0, 4 };
+	unsigned char* idat = NULL;
+	size_t idatSize = 0;
+	size_t pos = 8;
+	int depth = 0, type = 0, interlace = 0;
+
+	if(size < 8 || memcmp(png, "\x89PNG\r\n\x1a\n", 8) != 0) {
+		fprintf(stderr, "png2rle: not a PNG\n");
+		return NULL;
+	}
+
+	while(pos + 12 <= size) {
+		unsigned int len = be32(png + pos);
+		const unsigned char* chunk = png + pos + 8;
+
+		if(memcmp(png + pos + 4, "IHDR", 4) == 0) {
+			*width = be32(chunk);
+			*height = be32(chunk + 4);
+			depth = chunk[8];
+			type = chunk[9];
+			interlace = chunk[12];
+		} else if(memcmp(png + pos + 4, "IDAT", 4) == 0) {
+			idat = realloc(idat, idatSize + len);
+			memcpy(idat + idatSize, chunk, len);
+			idatSize += len;
+		} else if(memcmp(png + pos + 4, "IEND", 4) == 0) {
+			break;
+		}
+
+		pos += len + 12;
+	}
+
+	if(depth != 8 || interlace != 0 || type > 6 || channelsForType[type] == 0) {
+		fprintf(stderr, "png2rle: only 8-bit non-interlaced grey, RGB and alpha PNGs are supported\n");
+		return NULL;
+	}
+
+	int channels = channelsForType[type];
+	size_t stride = (size_t)*width * channels;
+	uLongf rawSize = (stride + 1) * *height;
+	unsigned char* raw = malloc(rawSize);
+	if(uncompress(raw, &rawSize, idat, idatSize) != Z_OK || rawSize != (stride + 1) * *height) {
+		fprintf(stderr, "png2rle: bad image data\n");
+		return NULL;
+	}
+
+	unsigned char* pixels = calloc(stride, *height);
+	int x, y;
+	for(y = 0; y < *height; y++) {
+		unsigned char* line = raw + y * (stride + 1) + 1;
+		unsigned char* out = pixels + y * stride;
+		unsigned char* prev = (y > 0) ? (pixels + (y - 1) * stride) : NULL;
+		int filter = line[-1];
+		size_t i;
+
+		for(i = 0; i < stride; i++) {
+			int a = (i >= channels) ? out[i - channels] : 0;
+			int b = prev ? prev[i] : 0;
+			int c = (prev && i >= channels) ? prev[i - channels] : 0;
+			switch(filter) {
+				case 0: out[i] = line[i]; break;
+				case 1: out[i] = line[i] + a; break;
+				case 2: out[i] = line[i] + b; break;
+				case 3: out[i] = line[i] + ((a + b) >> 1); break;
+				case 4: out[i] = line[i] + paeth(a, b, c); break;
+				default:
+					fprintf(stderr, "png2rle: bad filter %d\n", filter);
+					return NULL;
+			}
+		}
+	}
+
+	unsigned char* rgba = malloc((size_t)*width * *height * 4);
+	for(y = 0; y < *height; y++) {
+		for(x = 0; x < *width; x++) {
+			unsigned char* in = pixels + y * stride + x * channels;
+			unsigned char* out = rgba + ((size_t)y * *width + x) * 4;
+			switch(type) {
+				case 0: out[0] = out[1] = out[2] = in[0]; out[3] = 0xFF; break;
+				case 2: out[0] = in[0]; out[1] = in[1]; out[2] = in[2]; out[3] = 0xFF; break;
+				case 4: out[0] = out[1] = out[2] = in[0]; out[3] = in[1]; break;
+				case 6: out[0] = in[0]; out[1] = in[1]; out[2] = in[2]; out[3] = in[3]; break;
+			}
+		}
+	}
+
+	free(raw);
+	free(pixels);
+	free(idat);
+	return rgba;
+}
+
+static unsigned short* Words;
+static int WordCount;
+
+static void emit(unsigned short word)
+{
+	Words = realloc(Words, (WordCount + 1) * sizeof(unsigned short));
+	Words[WordCount++] = word;
+}
+
+// Alpha is quantised to 5 bits first and the colour is premultiplied by the
+// quantised value, so colour + (background * inverse alpha) / 32 can never
+// overflow a channel.
+static int quantiseAlpha(int alpha)
+{
+	return (alpha * 32 + 127) / 255;
+}
+
+static unsigned short premultiplied565(const unsigned char* p, int alpha32)
+{
+	int r = ((p[0] * 31 + 127) / 255) * alpha32 / 32;
+	int g = ((p[1] * 63 + 127) / 255) * alpha32 / 32;
+	int b = ((p[2] * 31 + 127) / 255) * alpha32 / 32;
+	return (r << 11) | (g << 5) | b;
+}
+
+static int runType(const unsigned char* p)
+{
+	int alpha32 = quantiseAlpha(p[3]);
+	if(alpha32 == 0)
+		return RUN_SKIP;
+	if(alpha32 == 32)
+		return RUN_COPY;
+	return RUN_BLEND;
+}
+
+int main(int argc, char *argv[])
+{
+	size_t size;
+	int width = 0, height = 0;
+	int x, y, i;
+
+	if(argc < 2) {
+		fprintf(stderr, "Usage: %s <name> < image.png > image.h\n", argv[0]);
+		return 1;
+	}
+
+	unsigned char* png = readAll(&size);
+	unsigned char* rgba = decodePNG(png, size, &width, &height);
+	if(rgba == NULL)
+		return 1;
+
+	for(y = 0; y < height; y++) {
+		const unsigned char* row = rgba + (size_t)y * width * 4;
+		x = 0;
+		while(x < width) {
+			int type = runType(row + x * 4);
+			int count = 1;
+
+			if(type == RUN_COPY) {
+				// A fill is worth it for three or more equal pixels.
+				unsigned short colour = premultiplied565(row + x * 4, 32);
+				while(x + count < width && count < RUN_MAX && runType(row + (x + count) * 4) == RUN_COPY
+						&& premultiplied565(row + (x + count) * 4, 32) == colour)
+					count++;
+
+				if(count >= 3) {
+					emit((RUN_FILL << 14) | count);
+					emit(colour);
+					x += count;
+					continue;
+				}
+
+				count = 1;
+				while(x + count < width && count < RUN_MAX && runType(row + (x + count) * 4) == RUN_COPY) {
+					unsigned short next = premultiplied565(row + (x + count) * 4, 32);
+					if(x + count + 2 < width && runType(row + (x + count + 1) * 4) == RUN_COPY && runType(row + (x + count + 2) * 4) == RUN_COPY
+							&& premultiplied565(row + (x + count + 1) * 4, 32) == next && premultiplied565(row + (x + count + 2) * 4, 32) == next)
+						break;
+					count++;
+				}
+			} else {
+				while(x + count < width && count < RUN_MAX && runType(row + (x + count) * 4) == type)
+					count++;
+			}
+
+			emit((type << 14) | count);
+			for(i = 0; i < count && type != RUN_SKIP; i++) {
+				const unsigned char* p = row + (x + i) * 4;
+				int alpha32 = quantiseAlpha(p[3]);
+				emit(premultiplied565(p, alpha32));
+				if(type == RUN_BLEND)
+					emit(32 - alpha32);
+			}
+
+			x += count;
+		}
+	}
+
+	printf("const uint16_t %s[] = {", argv[1]);
+	for(i = 0; i < WordCount; i++) {
+		if(i % 12 == 0)
+			printf("\n\t");
+		printf("0x%04x,%s", Words[i], (i % 12 == 11 || i == WordCount - 1) ? "" : " ");
+	}
+	printf("\n};\n\nconst int %s_width = %d;\nconst int %s_height = %d;\n", argv[1], width, argv[1], height);
+
+	return 0;
+}
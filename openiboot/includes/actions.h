@@ -3,14 +3,79 @@
 
 #include "openiboot.h"
 
+// where Linux is told to find the initrd
+#define INITRD_LOAD 0x06000000
+
 void chainload(uint32_t address);
+
+// A warm chainload leaves a Handoff at HANDOFF_ADDRESS for the openiboot it
+// starts, which then takes over the hardware it describes instead of
+// starting that from scratch. Only state that lives in the hardware itself
+// can be handed over; anything on the heap is gone once the new image runs.
+#define HANDOFF_ADDRESS (INITRD_LOAD - 0x1000)
+#define HANDOFF_MAGIC 0x57524D48	// 'WRMH'
+#define HANDOFF_VERSION 1
+
+typedef enum HandoffFlags {
+	HandoffLCD = 1 << 0,		// panel and controller left running, gamma installed
+	HandoffConsole = 1 << 1		// straight to the console, no menu
+} HandoffFlags;
+
+typedef struct Handoff {
+	uint32_t magic;
+	uint32_t version;
+	uint32_t flags;
+	uint32_t panelID;
+	uint32_t timestamp;	// low 32 bits of the system microtime at the jump
+	uint32_t crc;		// crc32 of everything before it
+} Handoff;
+
+void chainload_warm(uint32_t address);
+
+// Takes the handoff left in memory, if any, and clears it so it is only
+// used once. handoff_get returns NULL when this is a cold start.
+void handoff_take();
+const Handoff* handoff_get();
+int handoff_has(HandoffFlags flag);
+
+// A kernel suspending to RAM sets PMU_RESUMEFLAG and leaves a ResumeRecord
+// at RESUME_ADDRESS, both of which survive the sleep while the boot chain runs
+// again on wake. resume_check then goes straight to the vector, the way
+// chainload leaves things: interrupts masked, MMU and caches off. Whatever the
+// kernel needs kept has to stay clear of openiboot, its heap and the page table.
+#define RESUME_ADDRESS (HANDOFF_ADDRESS - 0x1000)
+#define RESUME_MAGIC 0x52534D45	// 'RSME'
+#define RESUME_VERSION 1
+
+typedef struct ResumeRecord {
+	uint32_t magic;
+	uint32_t version;
+	uint32_t vector;	// physical address to jump to
+	uint32_t crc;		// crc32 of everything before it
+} ResumeRecord;
+
+// Returns if this is no resume, or the record is not valid.
+void resume_check();
+
+// boot_linux leaves a copy of the FTL tables for the kernel in the
+// FTL_HANDOFF_SIZE bytes below RESUME_ADDRESS, described by an
+// ATAG_IPHONE_FTL, and leaves what they take out of the memory tags.
+#define FTL_HANDOFF_SIZE 0x40000
+#define FTL_HANDOFF_ADDRESS (RESUME_ADDRESS - FTL_HANDOFF_SIZE)
+
 void set_kernel(void* location, int size);
+void set_kernel_in_place(void* location, int size);
 void set_ramdisk(void* location, int size);
+void set_ramdisk_in_place(int size);
 void set_rootfs(int partition, const char* fileName);
 void boot_linux(const char* args);
 
 #ifndef NO_HFS
-void boot_linux_from_files();
+// Reads /zImage and /android.img.gz into place, returns 0 once both are there
+int load_linux_from_files();
+
+// With loaded set, boots what an earlier load_linux_from_files read as is
+void boot_linux_from_files(int loaded);
 #endif
 
 #endif
@@ -23,11 +23,42 @@ void aes_836_encrypt(void* data, int size, const void* iv);
 void aes_836_decrypt(void* data, int size, const void* iv);
 void aes_838_encrypt(void* data, int size, const void* iv);
 void aes_838_decrypt(void* data, int size, const void* iv);
+void aes_838_decrypt_async(void* data, int size, const void* iv);
+const void* aes_838_key();
 void aes_img2verify_encrypt(void* data, int size, const void* iv);
 void aes_img2verify_decrypt(void* data, int size, const void* iv);
 
 void aes_encrypt(void* data, int size, AESKeyType keyType, const void* key, const void* iv);
 void aes_decrypt(void* data, int size, AESKeyType keyType, const void* key, const void* iv);
 
+// Start a decryption and return without waiting for it. The key and IV are
+// loaded into the engine before this returns, but data must not be touched
+// until aes_wait(). Any other AES call waits for the pending one first.
+void aes_decrypt_async(void* data, int size, AESKeyType keyType, const void* key, const void* iv);
+int aes_busy();
+void aes_wait();
+
+// A series of buffers under one key, chained as if they were one long CBC
+// stream. The engine is set up for the key once, then only given each
+// buffer, unless another AES call used it in between. key must stay valid
+// until the session is closed, and every buffer but the last should be a
+// multiple of 16 bytes.
+typedef struct AESSession {
+	int encrypt;
+	AESKeyType keyType;
+	const void* key;
+	uint8_t iv[AES_128_CBC_IV_SIZE];
+} AESSession;
+
+void aes_session_open(AESSession* session, int encrypt, AESKeyType keyType, const void* key, const void* iv);
+void aes_session_process(AESSession* session, void* data, int size);
+
+// Starts the next buffer on iv instead of carrying on from the last one
+void aes_session_set_iv(AESSession* session, const void* iv);
+
+// Like aes_decrypt_async, data must not be touched until aes_wait()
+void aes_session_process_async(AESSession* session, void* data, int size);
+void aes_session_close(AESSession* session);
+
 #endif
 
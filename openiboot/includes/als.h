@@ -5,6 +5,8 @@ int als_setup();
 void als_sethighthreshold(uint16_t value);
 void als_setlowthreshold(uint16_t value);
 uint16_t als_data();
+// The register als_data reads its two bytes from, with the command bits set
+uint8_t als_data_register();
 void als_setchannel(int channel);
 void als_enable_interrupt();
 void als_disable_interrupt();
@@ -3,7 +3,52 @@
 
 #include "openiboot.h"
 
+// Events the ARM1176 can count, two at a time beside the cycle counter.
+typedef enum ARMPerfEvent {
+	ARMPerfICacheMiss = 0x0,
+	ARMPerfInstructionStall = 0x1,
+	ARMPerfDataStall = 0x2,
+	ARMPerfITLBMiss = 0x3,
+	ARMPerfDTLBMiss = 0x4,
+	ARMPerfBranch = 0x5,
+	ARMPerfBranchMispredict = 0x6,
+	ARMPerfInstruction = 0x7,
+	ARMPerfDCacheAccess = 0x9,
+	ARMPerfDCacheMiss = 0xB,
+	ARMPerfDCacheWriteBack = 0xC,
+	ARMPerfMainTLBMiss = 0xF,
+	ARMPerfExternalAccess = 0x10,
+	ARMPerfLSUStall = 0x11,
+	ARMPerfWriteBufferDrain = 0x12,
+	ARMPerfCycle = 0xFF
+} ARMPerfEvent;
+
+// Counts since arm_perf_begin. The counters are 32 bits, so at full clock
+// the cycle count wraps after about ten seconds; overflowed says it did.
+typedef struct ARMPerfScope {
+	uint32_t start[3];
+	uint32_t cycles;
+	uint32_t events[2];
+	int overflowed;
+	int open;
+} ARMPerfScope;
+
 int arm_setup();
 void arm_disable_caches();
 
+// Picks what the two event counters count from now on.
+void arm_perf_select(ARMPerfEvent event0, ARMPerfEvent event1);
+ARMPerfEvent arm_perf_event(int counter);
+const char* arm_perf_event_name(ARMPerfEvent event);
+int arm_perf_event_find(const char* name);
+
+void arm_perf_begin(ARMPerfScope* scope);
+void arm_perf_end(ARMPerfScope* scope);
+void arm_perf_add(ARMPerfScope* total, const ARMPerfScope* scope);
+void arm_perf_print(const char* what, const ARMPerfScope* scope);
+
+// Measures the statement or block that follows into scope. Leaving it with
+// break or return skips the end, so don't.
+#define ARM_PERF_MEASURE(scope) for(arm_perf_begin(scope); (scope)->open; arm_perf_end(scope))
+
 #endif
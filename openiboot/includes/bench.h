@@ -0,0 +1,9 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+#include "openiboot.h"
+
+void cmd_bench(int argc, char** argv);
+void cmd_membench(int argc, char** argv);
+
+#endif
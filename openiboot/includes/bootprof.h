@@ -0,0 +1,42 @@
+#ifndef BOOTPROF_H
+#define BOOTPROF_H
+
+#include "openiboot.h"
+
+// Timeline of the boot, from OpenIBootStart to the handoff. The ring keeps
+// the last BOOTPROF_ENTRIES records; it is there from the start, so nothing
+// has to turn it on. "bootprof" prints it, RPCBootProfile fetches it and
+// boot_linux passes what fits to the kernel as ATAG_IPHONE_BOOTPROF.
+#ifndef BOOTPROF_ENTRIES
+#define BOOTPROF_ENTRIES 128
+#endif
+
+#define BOOTPROF_NAME_LEN 15
+
+typedef enum BootProfileKind {
+	BootProfileMark = 0,
+	BootProfileBegin = 1,
+	BootProfileEnd = 2
+} BootProfileKind;
+
+typedef struct BootProfileEntry {
+	uint32_t timestamp;	// low 32 bits of the system microtime
+	uint32_t arg;		// meaning depends on the record, e.g. a size
+	uint8_t kind;		// BootProfileKind
+	char name[BOOTPROF_NAME_LEN];	// not terminated when it is full
+} __attribute__ ((__packed__)) BootProfileEntry;
+
+void bootprof_record(BootProfileKind kind, const char* name, uint32_t arg);
+
+#define bootprof_mark(name, arg) bootprof_record(BootProfileMark, name, arg)
+#define bootprof_begin(name) bootprof_record(BootProfileBegin, name, 0)
+#define bootprof_end(name, arg) bootprof_record(BootProfileEnd, name, arg)
+
+// Copies up to maxEntries of the newest records, oldest first, and returns
+// how many.
+int bootprof_read(BootProfileEntry* entries, int maxEntries);
+int bootprof_count();
+uint32_t bootprof_dropped();
+void bootprof_print();
+
+#endif
@@ -4,6 +4,31 @@
 #include "openiboot.h"
 #include "hardware/buttons.h"
 
+// How long a pin has to stay put after an edge before it counts, in microseconds
+#ifndef BUTTONS_DEBOUNCE
+#define BUTTONS_DEBOUNCE 20000
+#endif
+
+// Presses and releases not taken yet, a power of two
+#ifndef BUTTONS_QUEUE
+#define BUTTONS_QUEUE 16
+#endif
+
+typedef struct ButtonEvent {
+	int button;		// BUTTONS_HOME, BUTTONS_HOLD, ...
+	int pushed;
+	uint64_t time;		// system microtime of the first edge
+} ButtonEvent;
+
+// Reads the GPIO and the PMU on every call
 int buttons_is_pushed(int);
 
+int buttons_setup();
+
+// Takes the oldest press or release, waiting up to timeout microseconds for
+// one to come in. Returns FALSE if none did.
+int buttons_wait_event(ButtonEvent* event, uint32_t timeout);
+
+void buttons_flush();
+
 #endif
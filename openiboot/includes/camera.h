@@ -1,6 +1,25 @@
 #ifndef CAMERA_H
 #define CAMERA_H
 
+#include "openiboot.h"
+
+// Sensor registers are 16 bits wide, with 16 bit addresses
+#define CAMERA_MODEL_ID 0x3000
+
+// In a register table, waits value milliseconds instead of writing
+#define CAMERA_DELAY 0xFFFF
+
+typedef struct CameraRegister {
+	uint16_t addr;
+	uint16_t value;
+} CameraRegister;
+
 int camera_setup();
 
+uint16_t camera_readw(uint16_t addr);
+void camera_writew(uint16_t addr, uint16_t value);
+
+// Writes a whole table in one burst of queued transfers and waits for it
+void camera_write_regs(const CameraRegister* regs, int count);
+
 #endif
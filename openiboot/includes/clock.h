@@ -27,6 +27,33 @@ extern uint32_t ClockSDiv;
 
 extern uint32_t TicksPerSec;
 
+// How much the clock PLL is divided down by while idle, as a power of two
+#ifndef CLOCK_IDLE_SDIV
+#define CLOCK_IDLE_SDIV 1
+#endif
+
+// How long to stay at full speed after the last bit of work, in microseconds
+#ifndef CLOCK_IDLE_DELAY
+#define CLOCK_IDLE_DELAY 2000000
+#endif
+
+#define CLOCK_CHANGE_HANDLERS 8
+
+// Called, with interrupts off, after the frequencies change. Drivers with
+// dividers worked out from a frequency redo them here.
+typedef void (*ClockChangeHandler)(void* opaque);
+
+typedef enum ClockPerformance {
+	ClockPerformanceLow,
+	ClockPerformanceHigh
+} ClockPerformance;
+
+typedef enum ClockGovernor {
+	ClockGovernorAuto,
+	ClockGovernorHigh,
+	ClockGovernorLow
+} ClockGovernor;
+
 typedef enum FrequencyBase {
 	FrequencyBaseClock,
 	FrequencyBaseMemory,
@@ -45,4 +72,18 @@ uint32_t clock_get_frequency(FrequencyBase freqBase);
 uint32_t clock_calculate_frequency(uint32_t pdiv, uint32_t mdiv, FrequencyBase freqBase);
 void clock_set_sdiv(int sdiv);
 
+int clock_add_change_handler(ClockChangeHandler handler, void* opaque);
+void clock_set_governor(ClockGovernor governor);
+ClockGovernor clock_get_governor();
+ClockPerformance clock_get_performance();
+
+// Work that wants full speed is bracketed by clock_boost_begin and
+// clock_boost_end, or calls clock_governor_busy as it goes along. Idle loops
+// call clock_governor_idle, which slows down once nothing has been busy for
+// CLOCK_IDLE_DELAY. Task context only.
+void clock_boost_begin();
+void clock_boost_end();
+void clock_governor_busy();
+void clock_governor_idle();
+
 #endif
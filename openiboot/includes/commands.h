@@ -13,4 +13,8 @@ typedef struct OPIBCommand {
 
 extern OPIBCommand CommandList[];
 
+int commands_setup();
+OPIBCommand* command_find(const char* name);
+int command_run(int argc, char** argv);
+
 #endif
@@ -1,6 +1,8 @@
 #ifndef DMA_H
 #define DMA_H
 
+#include "tasks.h"
+
 #define ERROR_DMA 0x13
 #define ERROR_BUSY 0x15
 #define ERROR_ALIGN 0x9
@@ -11,6 +13,7 @@ typedef struct DMARequest {
 	int started;
 	int done;
 	DMAHandler handler;
+	Completion completion;
 	// TODO: fill this thing out
 } DMARequest;
 
@@ -21,10 +24,21 @@ typedef struct DMALinkedList {
     uint32_t control;
 } DMALinkedList;
 
+typedef struct DMASegment {
+	uint32_t address;
+	uint32_t size;
+} DMASegment;
+
 #define DMA_I2S0_RX 19
 #define DMA_I2S0_TX 20
 #define DMA_I2S1_RX 14
 #define DMA_I2S1_TX 15
+#define DMA_SPI0_RX 21
+#define DMA_SPI0_TX 22
+#define DMA_SPI1_RX 10
+#define DMA_SPI1_TX 11
+#define DMA_SPI2_RX 12
+#define DMA_SPI2_TX 13
 #define DMA_MEMORY 25
 #define DMA_NAND 8
 
@@ -32,11 +46,32 @@ int dma_setup();
 int dma_shutdown();
 int dma_request(int Source, int SourceTransferWidth, int SourceBurstSize, int Destination, int DestinationTransferWidth, int DestinationBurstSize, int* controller, int* channel, DMAHandler handler);
 int dma_perform(uint32_t Source, uint32_t Destination, int size, int continueList, int* controller, int* channel);
+int dma_perform_sg(uint32_t Source, uint32_t Destination, const DMASegment* segments, int numSegments, int* controller, int* channel);
+int dma_perform_cyclic(uint32_t Source, uint32_t Destination, const DMASegment* segments, int numSegments, int* controller, int* channel);
+int dma_reserve(int Source, int Destination, int* controller, int* channel);
+void dma_release(int controller, int channel);
 int dma_finish(int controller, int channel, int timeout);
+void dma_cancel(int controller, int channel);
 uint32_t dma_dstpos(int controller, int channel);
 uint32_t dma_srcpos(int controller, int channel);
 void dma_pause(int controller, int channel);
 void dma_resume(int controller, int channel);
 
+// Memory mapped uncached but bufferable, for descriptors and buffers that the
+// CPU and devices share without any cache maintenance. It is whole sections
+// taken from the heap on first use; allocations are DMA_ALIGN aligned.
+#ifndef DMA_COHERENT_SIZE
+#define DMA_COHERENT_SIZE 0x100000
+#endif
+
+void* dma_coherent_alloc(uint32_t size);
+void dma_coherent_free(void* ptr);
+int dma_coherent_contains(const void* ptr);
+// (Re)applies the uncached mapping, for when the page table is rebuilt
+void dma_coherent_map();
+
+int dma_memcpy_async(void* dest, const void* src, uint32_t size, DMAHandler handler, int* controller, int* channel);
+void* dma_memcpy(void* dest, const void* src, uint32_t size);
+
 #endif
 
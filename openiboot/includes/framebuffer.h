@@ -23,12 +23,19 @@ int framebuffer_y();
 void framebuffer_putc(int c);
 void framebuffer_print(const char* str);
 void framebuffer_print_force(const char* str);
+// Draws whatever framebuffer_print has queued right away.
+void framebuffer_flush();
 void framebuffer_setloc(int x, int y);
 void framebuffer_clear();
+void framebuffer_reset_scroll();
 uint32_t* framebuffer_load_image(const char* data, int len, int* width, int* height, int alpha);
 void framebuffer_blend_image(uint32_t* dst, int dstWidth, int dstHeight, uint32_t* src, int srcWidth, int srcHeight, int x, int y);
+void framebuffer_blend_image_premultiplied(uint32_t* dst, int dstWidth, int dstHeight, uint32_t* src, int srcWidth, int srcHeight, int x, int y);
 void framebuffer_draw_image(uint32_t* image, int x, int y, int width, int height);
 void framebuffer_capture_image(uint32_t* image, int x, int y, int width, int height);
+void framebuffer_save_rect(void* buffer, int x, int y, int width, int height);
+void framebuffer_restore_rect(const void* buffer, int x, int y, int width, int height);
+void framebuffer_draw_rle_image(const uint16_t* data, int x, int y, int width, int height);
 void framebuffer_draw_rect(uint32_t color, int x, int y, int width, int height);
 void framebuffer_draw_rect_hgradient(int starting, int ending, int x, int y, int width, int height);
 void framebuffer_setcolors(uint32_t fore, uint32_t back);
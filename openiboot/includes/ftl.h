@@ -27,6 +27,9 @@ typedef struct VFLCxt {
 	uint32_t checksum2;				// 0x7FC
 } VFLCxt;
 
+// logs the FTLCxt has room for; pLog[FTL_NUM_LOGS] is scratch for merges
+#define FTL_NUM_LOGS 17
+
 typedef struct FTLCxtLog {
 	uint32_t usn;					// 0x0
 	uint16_t wVbn;					// 0x4
@@ -119,6 +122,42 @@ int FTL_Write(int logicalPageNumber, int totalPagesToRead, uint8_t* pBuf);
 int ftl_read(void* buffer, uint64_t offset, int size);
 int ftl_write(void* buffer, uint64_t offset, int size);
 void ftl_printdata();
+void ftl_print_pools();
 int ftl_sync();
 
+// The count logical pages from lpn hold nothing worth keeping. Reading them
+// back afterwards gives whatever older copy the FTL still has.
+int ftl_discard(uint32_t lpn, int count);
+
+// What ftl_export leaves for a kernel to take the FTL over as it is, instead
+// of reading every table from NAND again. Each table is a copy of what the
+// FTL has in memory, at a physical address; the pointers inside FTLCxt mean
+// nothing to the kernel.
+#define FTL_EXPORT_VERSION 1
+#define FTL_EXPORT_ALIGN 0x1000
+
+typedef struct FTLExportTable {
+	uint32_t address;
+	uint32_t size;
+} FTLExportTable;
+
+typedef struct FTLExport {
+	uint32_t version;		// FTL_EXPORT_VERSION
+	uint32_t crc;			// crc32 of the size bytes from start
+	uint32_t start;
+	uint32_t size;			// rounded up to FTL_EXPORT_ALIGN where that fits
+	uint32_t banks;
+	FTLExportTable vflCxt;		// a VFLCxt for each bank
+	FTLExportTable ftlCxt;
+	FTLExportTable mapTable;
+	FTLExportTable pageOffsets;	// wPageOffsets of every log
+	FTLExportTable eraseCounters;
+	FTLExportTable readCounters;
+} FTLExport;
+
+// Copies the tables to the space bytes at start. On success the FTL is left
+// locked, so it can no longer change behind the copy: only call it right
+// before handing over to the kernel.
+int ftl_export(void* start, uint32_t space, FTLExport* export);
+
 #endif
@@ -19,6 +19,9 @@
 #define ACCEL_OUTY	0x2B
 #define ACCEL_OUTZ	0x2D
 
+// set in the register address to read several in a row
+#define ACCEL_AUTOINCREMENT	0x80
+
 #define ACCEL_WHOAMI_VALUE	0x3B
 
 #define ACCEL_CTRL_REG1_DR	(1 << 7)
@@ -7,11 +7,16 @@
 #define ARM11_CPSR_FIQDISABLE 0x40
 #define ARM11_CPSR_IRQDISABLE 0x80
 #define ARM11_CPSR_MODEMASK 0x1F
+#define ARM11_CPSR_USERMODE 0x10
 #define ARM11_CPSR_IRQMODE 0x12
 #define ARM11_CPSR_FIQMODE 0x11
 #define ARM11_CPSR_ABORTMODE 0x17
 #define ARM11_CPSR_UNDEFINEDMODE 0x1B
 #define ARM11_CPSR_SUPERVISORMODE 0x13
+#define ARM11_CPSR_SYSTEMMODE 0x1F
+
+#define ARM11_DataCacheSize 0x4000
+#define ARM11_CacheLineSize 32
 
 #define ARM11_Control_INSTRUCTIONCACHE 0x1000
 #define ARM11_Control_DATACACHE 0x4
@@ -24,6 +29,15 @@
 #define ARM11_AuxControl_DYNAMICBRANCHPREDICTION 0x2
 #define ARM11_AuxControl_STATICBRANCHPREDICTION 0x4
 
+// Performance monitor control register
+#define ARM11_PMNC_ENABLE 0x1
+#define ARM11_PMNC_RESETCOUNTS 0x2
+#define ARM11_PMNC_RESETCYCLES 0x4
+#define ARM11_PMNC_OVERFLOWS 0x700		// write 1 to clear
+#define ARM11_PMNC_EVENT0_SHIFT 20
+#define ARM11_PMNC_EVENT1_SHIFT 12
+#define ARM11_PMNC_EVENT_MASK 0xFF
+
 #define ARM11_AccessControl_CP0_PRIVILEGED (0x01 << 0)
 #define ARM11_AccessControl_CP0_ALL (0x11 << 0)
 #define ARM11_AccessControl_CP1_PRIVILEGED (0x01 << 2)
@@ -9,6 +9,7 @@
 
 #define VIC_MaxInterrupt 0x40
 #define VIC_InterruptSeparator 0x20
+#define VIC_PriorityLevels 0x10
 
 // Devices
 
@@ -18,12 +19,14 @@
 // Registers
 
 #define VICIRQSTATUS 0x000
+#define VICFIQSTATUS 0x004
 #define VICRAWINTR 0x8
 #define VICINTSELECT 0xC
 #define VICINTENABLE 0x10
 #define VICINTENCLEAR 0x14
 #define VICSWPRIORITYMASK 0x24
 #define VICVECTADDRS 0x100
+#define VICVECTPRIORITYS 0x200
 #define VICADDRESS 0xF00
 #define VICPERIPHID0 0xFE0
 #define VICPERIPHID1 0xFE4
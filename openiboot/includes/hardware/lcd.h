@@ -5,6 +5,10 @@
 
 // Device
 #define LCD 0x38900000
+
+// The windows are laid out from here up to the end of RAM
+#define LCDFramebufferStart 0x0fd00000
+#define LCDFramebufferEnd 0x10000000
 //#define LCD_I2C_BUS 0
 
 // Registers
@@ -45,9 +49,10 @@
 #define VIDTCON2_HOZVALMASK 0x3FF
 #define VIDTCON2_HOZVALSHIFT 16
 
-#define GET_HSTATUS(x) GET_BITS(x, 4, 2);
-#define GET_VSTATUS(x) GET_BITS(x, 6, 2);
-#define GET_LINECNT(x) GET_BITS(x, 8, 9);
+#define GET_HSTATUS(x) GET_BITS(x, 4, 2)
+#define GET_VSTATUS(x) GET_BITS(x, 6, 2)
+#define GET_LINECNT(x) GET_BITS(x, 8, 9)
+#define VSTATUS_ACTIVE 2
 #define LCD_CLOCKGATE1 0x7
 #define LCD_CLOCKGATE2 0x1D
 
@@ -19,6 +19,11 @@
 #define MT_SPI_CS GPIO_SPI2_CS0
 #endif
 
+// A-Speed bootloader data packets: a 6 byte header, the data, then a 2 byte
+// checksum. The bootloader only takes whole 1K packets.
+#define MT_BOOTLOADER_PACKET 0x400
+#define MT_BOOTLOADER_DATA (MT_BOOTLOADER_PACKET - 8)
+
 #define MT_INFO_FAMILYID 0xD1
 #define MT_INFO_SENSORINFO 0xD3
 #define MT_INFO_SENSORREGIONDESC 0xD0
@@ -45,6 +45,8 @@
 #define NAND_CMD_ID 0x90
 #define NAND_CMD_READSTATUS 0x70
 #define NAND_CMD_READ 0x30
+#define NAND_CMD_READCACHE 0x31
+#define NAND_CMD_READCACHEEND 0x3F
 
 #define FMANUM_TRANSFERSETTING 4
 
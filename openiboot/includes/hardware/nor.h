@@ -34,6 +34,8 @@
 #define NOR_SPI_ERSE_4KB 0x20
 #define NOR_SPI_JEDECID 0x9F
 
+#define NOR_SPI_PAGE 256
+
 #define NOR_SPI_SR_BUSY 0
 #define NOR_SPI_SR_WEL 1
 #define NOR_SPI_SR_BP0 2
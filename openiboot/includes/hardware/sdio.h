@@ -31,6 +31,11 @@
 #define SDIO_NUMBLK	0x4C
 #define SDIO_REMBLK	0x50
 
+// SDIO_CLKDIV settings for identification, full speed and high speed
+#define SDIO_CLKDIV_INIT	(1 << 7)	// ~400 KHz
+#define SDIO_CLKDIV_FULL	(1 << 1)	// ~25 MHz
+#define SDIO_CLKDIV_HIGH	(1 << 0)	// ~50 MHz
+
 #ifndef CONFIG_IPOD
 #define SDIO_GPIO_DEVICE_RESET 0x607
 #endif
@@ -25,6 +25,13 @@
 #define TX_BUFFER_LEFT(x) GET_BITS(status, 4, 4)
 #define RX_BUFFER_LEFT(x) GET_BITS(status, 8, 4)
 
+// The interrupt enables in the setup register. With DMA the FIFOs are left
+// to the DMA requests and only the one status interrupt stays on.
+#define SPISETUP_INTERRUPTSHIFT 5
+#define SPISETUP_INTERRUPTMASK (0x3F << SPISETUP_INTERRUPTSHIFT)
+#define SPISETUP_INTERRUPTS_CPU 0x3D
+#define SPISETUP_INTERRUPTS_DMA 0x2
+
 #define CLOCK_SHIFT 12
 #define MAX_DIVIDER 0x3FF
 
@@ -29,11 +29,15 @@
 // Values
 #define NUM_UARTS 5
 #define UART_CLOCKGATE 0x29
+#define UART0_INTERRUPT 0x18
+#define UART_INTERRUPT(ureg) (UART0_INTERRUPT + (ureg))
 
 #define UART_CLOCK_SELECTION_MASK (0x3 << 10) // Bit 10-11
 #define UART_CLOCK_SELECTION_SHIFT 10 // Bit 10-11
 #define UART_UCON_UNKMASK 0x7000
 #define UART_UCON_LOOPBACKMODE (0x1 << 5)
+#define UART_UCON_RXTIMEOUT (0x1 << 7)
+#define UART_UCON_RXINT_LEVEL (0x1 << 8)
 #define UART_UCON_RXMODE_SHIFT 0
 #define UART_UCON_RXMODE_MASK (0x3 << UART_UCON_RXMODE_SHIFT)
 #define UART_UCON_TXMODE_SHIFT 2
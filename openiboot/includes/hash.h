@@ -0,0 +1,42 @@
+#ifndef HASH_H
+#define HASH_H
+
+#include "openiboot.h"
+
+// Digests of a range of memory, NOR, VFL or FTL worked out on the device, so
+// checking what was flashed costs a read of the flash rather than a USB
+// transfer of it. The range is cut into blocks of blockSize bytes, the last
+// one possibly short, and each block gets a digest of its own. "hash" prints
+// them and RPCHash returns them.
+typedef enum HashAlgorithm {
+	HashCRC32 = 0,		// 4 bytes, as crc32 gives it
+	HashAdler32 = 1,	// 4 bytes, as adler32 gives it
+	HashSHA1 = 2		// 20 bytes
+} HashAlgorithm;
+
+typedef enum HashSource {
+	HashMemory = 0,		// offset is an address
+	HashNOR = 1,
+	HashVFL = 2,		// virtual pages back to back, empty ones as 0xFF
+	HashFTL = 3		// the block device ftl_read gives
+} HashSource;
+
+#define HASH_MAX_DIGEST 20
+
+// Bytes read from flash at a time
+#ifndef HASH_CHUNK
+#define HASH_CHUNK 0x10000
+#endif
+
+// Size of one digest, or 0 for an algorithm there is no such thing as.
+int hash_digest_size(HashAlgorithm algorithm);
+
+// How many digests hash_range gives for length bytes, or 0 if blockSize is 0.
+uint32_t hash_blocks(uint64_t length, uint32_t blockSize);
+
+// Writes the digests of each block of length bytes at offset to digests,
+// back to back. Returns 0, or -1 if the arguments make no sense or a read
+// failed.
+int hash_range(HashAlgorithm algorithm, HashSource source, uint64_t offset, uint64_t length, uint32_t blockSize, uint8_t* digests);
+
+#endif
@@ -0,0 +1,37 @@
+#ifndef HEAPPROF_H
+#define HEAPPROF_H
+
+#include "openiboot.h"
+
+// Allocations are tagged with the address they were made from. The profiler
+// keeps nothing until heapprof_start, which takes its tables straight from
+// sbrk so they never show up in the heap they describe.
+#ifndef HEAPPROF_RECORDS
+#define HEAPPROF_RECORDS 8192
+#endif
+
+#ifndef HEAPPROF_SITES
+#define HEAPPROF_SITES 256
+#endif
+
+// Bucket n counts allocations of less than 2^n bytes, and at least 2^(n-1).
+#define HEAPPROF_BUCKETS 24
+
+// Set once the tables exist. malloc.c only calls in here while it is set.
+extern int HeapProfiling;
+
+void heapprof_alloc(void* ptr, size_t size, void* caller);
+void heapprof_free(void* ptr);
+
+// Every command invocation starts a new generation, so allocations that
+// outlive the command that made them can be told apart.
+void heapprof_command();
+
+int heapprof_start();
+void heapprof_stop();
+void heapprof_reset();
+void heapprof_mark();
+void heapprof_print(int maxSites);
+void heapprof_print_leaks();
+
+#endif
@@ -3,6 +3,7 @@
 
 #include "openiboot.h"
 #include "hfs/common.h"
+#include "aes.h"
 
 typedef struct MBRPartitionRecord {
 	uint8_t status;
@@ -30,5 +31,15 @@ extern int HasBDevInit;
 int bdev_setup();
 unsigned int bdev_get_start(int partition);
 io_func* bdev_open(int partition);
+int bdev_read(uint64_t offset, size_t size, void* buffer);
+int bdev_write(uint64_t offset, size_t size, void* buffer);
+int bdev_flush();
+void bdev_print_cache_stats();
+
+// From now on bdev_open hands out the partition through the AES engine. Each
+// page is encrypted on its own in CBC mode, with its page number within the
+// partition as the IV. key is only used with AESCustom, and is 32 bytes.
+void bdev_set_key(int partition, AESKeyType keyType, const void* key);
+void bdev_clear_key(int partition);
 
 #endif
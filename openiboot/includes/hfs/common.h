@@ -61,12 +61,14 @@ struct io_func_struct;
 typedef int (*readFunc)(struct io_func_struct* io, off_t location, size_t size, void *buffer);
 typedef int (*writeFunc)(struct io_func_struct* io, off_t location, size_t size, void *buffer);
 typedef void (*closeFunc)(struct io_func_struct* io);
+typedef int (*discardFunc)(struct io_func_struct* io, off_t location, size_t size);
 
 typedef struct io_func_struct {
   void* data;
   readFunc read;
   writeFunc write;
   closeFunc close;
+  discardFunc discard;	/* NULL if the backing store does not care */
 } io_func;
 
 #endif
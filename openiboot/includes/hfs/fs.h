@@ -14,16 +14,41 @@ typedef struct ExtentList {
 	ExtentListItem extents[16];
 } ExtentList;
 
+// fs_extract_stream reads the file FS_STREAM_CHUNK bytes at a time into
+// buffer, calling consume after each chunk. consume may move buffer
+// before the next chunk is read, and returns non-zero to stop.
+#ifndef FS_STREAM_CHUNK
+#define FS_STREAM_CHUNK 0x20000
+#endif
+
+typedef struct FSStream {
+	uint8_t* buffer;
+	uint32_t size;
+	int (*consume)(struct FSStream* stream, uint32_t offset, uint32_t len);
+	void* opaque;
+} FSStream;
+
 extern int HasFSInit;
 
 uint32_t readHFSFile(HFSPlusCatalogFile* file, uint8_t** buffer, Volume* volume);
 
 int fs_setup();
+
+// Volumes stay mounted between calls until NAND is written under them. This
+// drops them all, for when a partition reads differently, e.g. a new key.
+void fs_invalidate();
 ExtentList* fs_get_extents(int partition, const char* fileName);
+int fs_read_extents(ExtentList* list, uint32_t size, void* location);
 void fs_cmd_ls(int argc, char** argv);
 void fs_cmd_cat(int argc, char** argv);
 void fs_cmd_extract(int argc, char** argv);
 void fs_cmd_add(int argc, char** argv);
 int fs_extract(int partition, const char* file, void* location);
+int fs_extract_stream(int partition, const char* file, FSStream* stream);
+
+// fs_extract_max leaves files of more than maxSize bytes alone. fs_store
+// creates or overwrites the file and syncs the FTL; TRUE if it worked.
+int fs_extract_max(int partition, const char* file, void* location, uint32_t maxSize);
+int fs_store(int partition, const char* file, void* location, uint32_t size);
 
 #endif
@@ -0,0 +1,58 @@
+#ifndef HFSCOMPRESS_H
+#define HFSCOMPRESS_H
+
+#include "hfs/hfsplus.h"
+
+// Files with UF_COMPRESSED set keep their data in the com.apple.decmpfs
+// attribute (type 3) or in the resource fork (type 4), zlib compressed in
+// chunks of CMPFS_CHUNK_SIZE bytes. The decmpfs header is little endian, the
+// resource fork header big endian and its chunk table little endian again.
+
+#define CMPFS_MAGIC 0x636D7066
+#define CMPFS_ATTRIBUTE "com.apple.decmpfs"
+#define CMPFS_CHUNK_SIZE 0x10000
+
+#define CMPFS_INLINE_ZLIB 3
+#define CMPFS_RESOURCE_ZLIB 4
+
+typedef struct HFSPlusDecmpfs {
+	uint32_t magic;
+	uint32_t flags;
+	uint64_t size;
+	uint8_t data[0];
+} __attribute__ ((packed)) HFSPlusDecmpfs;
+
+typedef struct HFSPlusCmpfRsrcHead {
+	uint32_t headerSize;
+	uint32_t totalSize;
+	uint32_t dataSize;
+	uint32_t flags;
+} __attribute__ ((packed)) HFSPlusCmpfRsrcHead;
+
+typedef struct HFSPlusCmpfRsrcBlock {
+	uint32_t offset;
+	uint32_t size;
+} __attribute__ ((packed)) HFSPlusCmpfRsrcBlock;
+
+typedef struct HFSPlusCompressed {
+	uint32_t type;
+	uint32_t size;			// of the file once decompressed
+	uint32_t numChunks;
+	uint32_t chunkSize;		// every chunk but the last decompresses to this much
+
+	uint8_t* decmpfs;		// the attribute, inline data and all
+	size_t decmpfsSize;
+
+	io_func* rsrc;
+	uint32_t chunksStart;		// where chunk offsets count from in the fork
+	HFSPlusCmpfRsrcBlock* chunks;
+
+	uint8_t* input;			// room for the biggest compressed chunk
+} HFSPlusCompressed;
+
+int isHFSPlusCompressed(HFSPlusCatalogFile* file);
+HFSPlusCompressed* openHFSPlusCompressed(Volume* volume, HFSPlusCatalogFile* file);
+int readHFSPlusCompressedChunk(HFSPlusCompressed* data, uint32_t chunk, uint8_t* buffer);
+void closeHFSPlusCompressed(HFSPlusCompressed* data);
+
+#endif
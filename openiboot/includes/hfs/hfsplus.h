@@ -299,6 +299,8 @@ struct HFSPlusBSDInfo {
 } __attribute__((__packed__));
 typedef struct HFSPlusBSDInfo HFSPlusBSDInfo;
 
+#define UF_COMPRESSED 040	/* in ownerFlags: the data is in com.apple.decmpfs */
+
 enum {
     kHFSPlusFolderRecord        = 0x0001,
     kHFSPlusFileRecord          = 0x0002,
@@ -376,6 +378,29 @@ struct HFSPlusCatalogThread {
 } __attribute__((__packed__));
 typedef struct HFSPlusCatalogThread HFSPlusCatalogThread;
 
+enum {
+	kHFSPlusAttrInlineData	= 0x10,
+	kHFSPlusAttrForkData	= 0x20,
+	kHFSPlusAttrExtents	= 0x30
+};
+
+struct HFSPlusAttrData {
+	uint32_t    recordType;
+	uint32_t    reserved[2];
+	uint32_t    size;
+	uint8_t     data[0];
+} __attribute__((__packed__));
+typedef struct HFSPlusAttrData HFSPlusAttrData;
+
+struct HFSPlusAttrKey {
+	uint16_t     keyLength;
+	uint16_t     pad;
+	uint32_t     fileID;
+	uint32_t     startBlock;
+	HFSUniStr255 name;
+} __attribute__((__packed__));
+typedef struct HFSPlusAttrKey HFSPlusAttrKey;
+
 struct HFSPlusCatalogRecord {
   int16_t recordType;
   unsigned char data[0];
@@ -397,8 +422,25 @@ struct Extent {
 
 typedef struct Extent Extent;
 
+// physically contiguous run of one or more extents, indexed by file block
+typedef struct {
+  uint32_t fileBlock;
+  uint32_t startBlock;
+  uint32_t blockCount;
+} ExtentRun;
+
+// the overflow extents of one data fork, as getOverflowExtents decoded them
+typedef struct ExtentsCacheEntry {
+  HFSCatalogNodeID fileID;
+  uint32_t startBlock;		/* file block the first overflow record starts at */
+  uint32_t count;
+  HFSPlusExtentDescriptor* extents;
+  struct ExtentsCacheEntry* next;
+} ExtentsCacheEntry;
+
 typedef struct {
   io_func* io;
+  io_func* cache;
   BTHeaderRec *headerRec;
   compareFunc compare;
   dataReadFunc keyRead;
@@ -407,13 +449,41 @@ typedef struct {
   dataReadFunc dataRead;
 } BTree;
 
+/* Walks the leaf records in key order from where search() lands, following
+   fLink from one leaf to the next. Each leaf is read once and its records are
+   decoded from the copy. */
+typedef struct {
+  BTree* tree;
+  uint32_t nodeNumber;
+  int recordNumber;
+  uint16_t numRecords;
+  uint8_t* node;
+  io_func nodeIO;
+} BTLeafCursor;
+
+typedef struct {
+  BTLeafCursor leaf;
+  HFSCatalogNodeID parentID;
+} CatalogCursor;
+
 typedef struct {
   io_func* image;
   HFSPlusVolumeHeader* volumeHeader;
 
   BTree* extentsTree;
   BTree* catalogTree;
+  BTree* attrTree;		/* NULL if the volume has no attributes file */
   io_func* allocationFile;
+
+  uint8_t* allocationBitmap;	/* copy of the allocation file, NULL until first used */
+  uint32_t allocationBitmapSize;
+  uint8_t* allocationDirty;	/* one byte per ALLOCATION_CHUNK of the bitmap */
+
+  int transaction;		/* nesting depth of beginVolumeTransaction */
+  int headerDirty;		/* updateVolume was held back by the transaction */
+
+  ExtentsCacheEntry* extentsCache;	/* most recently used first */
+  int extentsCacheCount;
 } Volume;
 
 
@@ -423,6 +493,8 @@ typedef struct {
   Volume* volume;
   HFSPlusForkData* forkData;
   Extent* extents;
+  ExtentRun* runs;
+  uint32_t numRuns;
 } RawFile;
 
 #ifdef __cplusplus
@@ -447,6 +519,10 @@ extern "C" {
 
 	void* search(BTree* tree, BTKey* searchKey, int *exact, uint32_t *nodeNumber, int *recordNumber);
 
+	int openLeafCursor(BTree* tree, BTKey* searchKey, BTLeafCursor* cursor);
+	int leafCursorNext(BTLeafCursor* cursor, BTKey** key, void** data);
+	void closeLeafCursor(BTLeafCursor* cursor);
+
 	io_func* openFlatFile(const char* fileName);
 	io_func* openFlatFileRO(const char* fileName);
 
@@ -455,6 +531,11 @@ extern "C" {
 	void flipExtentRecord(HFSPlusExtentRecord* extentRecord);
 
 	BTree* openExtentsTree(io_func* file);
+	HFSPlusExtentDescriptor* getOverflowExtents(Volume* volume, HFSCatalogNodeID fileID, uint32_t startBlock, uint32_t blocks, uint32_t* count);
+	void invalidateExtentsCache(Volume* volume);
+
+	BTree* openAttributesTree(io_func* file);
+	size_t getAttribute(Volume* volume, uint32_t fileID, const char* name, uint8_t** data);
 
 	void ASCIIToUnicode(const char* ascii, HFSUniStr255* unistr);
 
@@ -464,6 +545,7 @@ extern "C" {
 
 	BTree* openCatalogTree(io_func* file);
 	int updateCatalog(Volume* volume, HFSPlusCatalogRecord* catalogRecord);
+	void invalidateCatalogCache();
 	int move(const char* source, const char* dest, Volume* volume);
 	int removeFile(const char* fileName, Volume* volume);
 	HFSCatalogNodeID newFolder(const char* pathName, Volume* volume);
@@ -475,6 +557,9 @@ extern "C" {
 	HFSPlusCatalogRecord* getRecordByCNID(HFSCatalogNodeID CNID, Volume* volume);
 	HFSPlusCatalogRecord* getLinkTarget(HFSPlusCatalogRecord* record, HFSCatalogNodeID parentID, HFSPlusCatalogKey *key, Volume* volume);
 	CatalogRecordList* getFolderContents(HFSCatalogNodeID CNID, Volume* volume);
+	int openCatalogCursor(HFSCatalogNodeID CNID, Volume* volume, CatalogCursor* cursor);
+	HFSPlusCatalogRecord* catalogCursorNext(CatalogCursor* cursor, HFSPlusCatalogKey** key);
+	void closeCatalogCursor(CatalogCursor* cursor);
 	HFSPlusCatalogRecord* getRecordFromPath(const char* path, Volume* volume, char **name, HFSPlusCatalogKey* retKey);
 	HFSPlusCatalogRecord* getRecordFromPath2(const char* path, Volume* volume, char **name, HFSPlusCatalogKey* retKey, char traverse);
 	HFSPlusCatalogRecord* getRecordFromPath3(const char* path, Volume* volume, char **name, HFSPlusCatalogKey* retKey, char traverse, char returnLink, HFSCatalogNodeID parentID);
@@ -482,15 +567,22 @@ extern "C" {
 
 	int isBlockUsed(Volume* volume, uint32_t block);
 	int setBlockUsed(Volume* volume, uint32_t block, int used);
+	int flushAllocationBitmap(Volume* volume);
+	void releaseAllocationBitmap(Volume* volume);
 	int allocate(RawFile* rawFile, off_t size);
+	int allocate2(RawFile* rawFile, off_t size, int zero);
 
 	void flipForkData(HFSPlusForkData* forkData);
 
 	Volume* openVolume(io_func* io);
 	void closeVolume(Volume *volume);
 	int updateVolume(Volume* volume);
+	void beginVolumeTransaction(Volume* volume);
+	int commitVolumeTransaction(Volume* volume);
 
 	int debugBTree(BTree* tree, int displayTree);
+	int setBTreeWriteBack(BTree* tree, int writeBack);
+	int flushBTree(BTree* tree);
 
 	int addToBTree(BTree* tree, BTKey* searchKey, size_t length, unsigned char* content);
 
@@ -3,6 +3,7 @@
 
 #include "openiboot.h"
 #include "clock.h"
+#include "tasks.h"
 
 typedef enum I2CError {
 	I2CNoError = 0
@@ -21,6 +22,28 @@ typedef enum I2CState {
 } I2CState;
 
 
+struct I2CRequest;
+typedef void (*I2CRequestCallback)(struct I2CRequest* request, void* opaque);
+
+// A queued transfer, with the same arguments as i2c_rx (is_write FALSE) or
+// i2c_tx (is_write TRUE, no registers). The callback is run from the queue
+// task; error holds what the synchronous call would have returned.
+typedef struct I2CRequest {
+	int bus;
+	int address;
+	int is_write;
+	const uint8_t* registers;
+	int num_regs;
+	uint8_t* buffer;
+	int bufferLen;
+	I2CError error;
+	I2CRequestCallback callback;
+	void* opaque;
+	int freeWhenDone;
+	Completion completion;
+	struct I2CRequest* next;
+} I2CRequest;
+
 typedef struct I2CInfo {
 	uint32_t field_0;
 	uint32_t frequency;
@@ -47,10 +70,21 @@ typedef struct I2CInfo {
 	uint32_t register_18;
 	uint32_t register_1C;
 	uint32_t register_20;
+	I2CRequest* queue;
+	I2CRequest* current;
+	I2CRequest* running;
 } I2CInfo;
 
 int i2c_setup();
 I2CError i2c_rx(int bus, int iicaddr, const uint8_t* registers, int num_regs, void* buffer, int len);
 I2CError i2c_tx(int bus, int iicaddr, void* buffer, int len);
 
+void i2c_submit(I2CRequest* request);
+I2CError i2c_wait(I2CRequest* request);
+// Copies the data and queues the write without waiting for it, for the long
+// runs of register writes devices get set up with.
+I2CError i2c_tx_queued(int bus, int iicaddr, const void* buffer, int len);
+// Waits until everything queued on the bus so far has gone out.
+void i2c_flush(int bus);
+
 #endif
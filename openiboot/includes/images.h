@@ -76,11 +76,18 @@ typedef struct Image {
 	uint32_t padded;
 	uint8_t dataHash[0x40];
 	int hashMatch;
+	int verified;		// verifyResult holds what images_verify found
+	int verifyResult;
 } Image;
 
 typedef struct ImageDataList {
 	uint32_t type;
 	void* data;
+	// When set, data goes to NOR with these bytes in its DATA tag instead,
+	// built straight into the flash plan.
+	const void* newData;
+	size_t newDataLen;
+	int borrowed;	// data belongs to another entry
 	struct ImageDataList* next;
 } ImageDataList;
 
@@ -92,6 +99,16 @@ static inline void print_fourcc(uint32_t code) {
 	bufferPrintf("%c%c%c%c", (code >> 24) & 0xFF, (code >> 16) & 0xFF, (code >> 8) & 0xFF, code & 0xFF);
 }
 
+// Slots for images_get, a power of two
+#ifndef IMAGES_HASH_SIZE
+#define IMAGES_HASH_SIZE 64
+#endif
+
+// Where the img3 layout is kept between boots, so an unchanged NOR needs no scan
+#define IMAGES_INDEX_VAR "opib-image-index"
+
+extern Image* imageList;
+
 int images_setup();
 void images_list();
 Image* images_get(uint32_t type);
@@ -102,10 +119,14 @@ void images_from_template(Image* image, uint32_t type, int index, void* dataBuff
 void images_erase(Image* image);
 void images_write(Image* image, void* data, unsigned int length, int encrypt);
 unsigned int images_read(Image* image, void** data);
+unsigned int images_read_to(Image* image, void* buffer, size_t bufferSize);
 int images_verify(Image* image);
 void images_append(void* data, int len);
 void images_rewind();
 void* images_inject_img3(const void* img3Data, const void* newData, size_t newDataLen);
+// Swaps the DATA tag without another buffer, if the new container fits in
+// capacity bytes. Returns FALSE and leaves img3Data alone otherwise.
+int images_inject_img3_in_place(void* img3Data, size_t capacity, const void* newData, size_t newDataLen);
 void images_install(void* newData, size_t newDataLen);
 void images_uninstall();
 void images_change_type(const void* img3Data, uint32_t type);
@@ -0,0 +1,17 @@
+#ifndef INFLATE_H
+#define INFLATE_H
+
+#include "openiboot.h"
+
+// Deflate streams, with the two byte zlib header in front if zlib is set.
+// The adler32 at the end is not checked.
+
+// Returns how many bytes were written to out, or -1 if the data is corrupt or
+// does not fit in outLen bytes.
+int inflate_buffer(void* out, uint32_t outLen, const void* in, uint32_t inLen, int zlib);
+
+// Decompresses into a buffer of sizeHint bytes, which is grown when it is not
+// enough. Returns it, with its length in outLen, or NULL.
+void* inflate_malloc(const void* in, uint32_t inLen, uint32_t sizeHint, int zlib, uint32_t* outLen);
+
+#endif
@@ -10,12 +10,59 @@ typedef struct InterruptHandler {
         InterruptServiceRoutine handler;
         uint32_t token;
         uint32_t useEdgeIC;
+        uint32_t preemptMask;
 } InterruptHandler;
 
+// PL192 priority levels, 0 is the highest. While a handler runs, interrupts
+// of a strictly higher level on either VIC may preempt it, so handlers left
+// at the lowest level never nest into each other.
+#define INTERRUPT_PRIORITY_HIGHEST 0
+#define INTERRUPT_PRIORITY_LOWEST (VIC_PriorityLevels - 1)
+
+#ifndef DMA_INTERRUPT_PRIORITY
+#define DMA_INTERRUPT_PRIORITY 0
+#endif
+
+#ifndef USB_INTERRUPT_PRIORITY
+#define USB_INTERRUPT_PRIORITY 4
+#endif
+
+#ifndef SPI_INTERRUPT_PRIORITY
+#define SPI_INTERRUPT_PRIORITY 8
+#endif
+
+#ifndef UART_INTERRUPT_PRIORITY
+#define UART_INTERRUPT_PRIORITY 6
+#endif
+
+// FIQs preempt every IRQ handler but not each other, and are only held off
+// by critical sections. Audio DMA (DMAC1) and USB go there unless these are
+// defined.
+//#define NO_AUDIO_FIQ
+//#define NO_USB_FIQ
+
 extern InterruptHandler InterruptHandlerTable[VIC_MaxInterrupt];
 
+// What the IRQ entry pushed onto the system mode stack, with pc and cpsr
+// being where the interrupt was taken. lr is the system mode one.
+typedef struct IRQSavedFrame {
+	uint32_t r0;
+	uint32_t r1;
+	uint32_t r2;
+	uint32_t r3;
+	uint32_t r12;
+	uint32_t lr;
+	uint32_t pc;
+	uint32_t cpsr;
+} IRQSavedFrame;
+
+// The frame of the innermost IRQ being handled, NULL outside of them.
+extern IRQSavedFrame* volatile IRQFrame;
+
 int interrupt_setup();
 int interrupt_install(int irq_no, InterruptServiceRoutine handler, uint32_t token);
+int interrupt_install_fiq(int irq_no, InterruptServiceRoutine handler, uint32_t token);
+int interrupt_set_priority(int irq_no, int priority);
 int interrupt_enable(int irq_no);
 int interrupt_disable(int irq_no);
 
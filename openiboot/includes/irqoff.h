@@ -0,0 +1,36 @@
+#ifndef IRQOFF_H
+#define IRQOFF_H
+
+#include "openiboot.h"
+#include "hardware/interrupt.h"
+
+// Tracks how long interrupts stay off: the outermost critical sections by the
+// address they were entered from, and the IRQ and FIQ handlers by source. It
+// costs one load and compare per critical section until irqoff_start.
+#ifndef IRQOFF_SITES
+#define IRQOFF_SITES 256
+#endif
+
+// Bucket n counts durations of less than 2^n timer ticks, and at least 2^(n-1).
+#define IRQOFF_BUCKETS 20
+
+// Read by EnterCriticalSection and LeaveCriticalSection.
+extern volatile int IRQOffTracking;
+
+void critsect_entered(void* caller);
+void critsect_left();
+
+// interrupt_install calls this, so handlers installed while tracking are
+// timed too.
+void irqoff_wrap(int irq_no);
+
+// The source is expected to interrupt at ticks, so the next dispatch also
+// measures how late it came in.
+void irqoff_expect(int irq_no, uint64_t ticks);
+
+int irqoff_start();
+void irqoff_stop();
+void irqoff_reset();
+void irqoff_print(int maxSites);
+
+#endif
@@ -0,0 +1,73 @@
+#ifndef LATENCY_H
+#define LATENCY_H
+
+#include "openiboot.h"
+#include "timer.h"
+
+// Operations with a latency histogram. The order is part of the RPC reply.
+typedef enum LatencyOperation {
+	LatencyNANDRead = 0,
+	LatencyNANDReadMultiple,
+	LatencyNANDWrite,
+	LatencyNANDErase,
+	LatencyVFLRead,
+	LatencyVFLWrite,
+	LatencyFTLRead,
+	LatencyFTLWrite,
+	LatencyMergeSimple,
+	LatencyMergeCopy,
+	LatencyMergeCompact,
+	LatencyBDevRead,
+	LatencyBDevWrite,
+	LatencyNANDWriteMultiple,
+	LatencyOperationCount
+} LatencyOperation;
+
+// Bucket n counts operations that took less than 2^n microseconds, and at
+// least 2^(n-1); the last bucket takes everything longer.
+#define LATENCY_BUCKETS 24
+
+typedef struct LatencyHistogram {
+	uint32_t count;
+	uint32_t max;
+	uint64_t total;
+	uint32_t buckets[LATENCY_BUCKETS];
+} __attribute__ ((__packed__)) LatencyHistogram;
+
+// One entry of the I/O trace. address is the lpn for the FTL, the virtual
+// page for the VFL, LATENCY_NAND_ADDRESS for NAND, the 512 byte sector for
+// the block device and the lbn for merges. count is in the same units.
+typedef struct IOTraceEntry {
+	uint32_t timestamp;	// low 32 bits of the system microtime at the start
+	uint16_t operation;	// LatencyOperation
+	uint16_t count;
+	uint32_t address;
+	uint32_t latency;	// microseconds
+} __attribute__ ((__packed__)) IOTraceEntry;
+
+#ifndef IOTRACE_ENTRIES
+#define IOTRACE_ENTRIES 4096
+#endif
+
+#define LATENCY_NAND_ADDRESS(bank, page) (((bank) << 28) | (page))
+
+static inline uint64_t latency_start() {
+	return timer_get_system_microtime();
+}
+
+// Adds to the operation's histogram, and to the trace while it is on.
+void latency_record(LatencyOperation operation, uint32_t address, uint32_t count, uint64_t start);
+const LatencyHistogram* latency_get();
+void latency_reset();
+void latency_print();
+
+// The trace ring keeps the last IOTRACE_ENTRIES operations. iotrace_read
+// copies up to maxEntries of them, oldest first, and returns how many.
+int iotrace_start();
+void iotrace_stop();
+int iotrace_enabled();
+void iotrace_clear();
+uint32_t iotrace_dropped();
+int iotrace_read(IOTraceEntry* entries, int maxEntries);
+
+#endif
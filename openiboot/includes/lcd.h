@@ -75,8 +75,11 @@ extern uint32_t NextFramebuffer;
 int lcd_setup();
 void lcd_fill(uint32_t color);
 void lcd_shutdown();
+// TRUE once the panel has been brought up and is showing the framebuffer
+int lcd_running();
 void lcd_set_backlight_level(int level);
 void lcd_window_address(int window, uint32_t framebuffer);
+void lcd_wait_vsync();
 
 #endif
 
@@ -0,0 +1,46 @@
+#ifndef LZSS_H
+#define LZSS_H
+
+#include "openiboot.h"
+
+// Apple's LZSS, as in kernelcaches and what mk8900image -z produces: a
+// 4096 byte window, matches of 3 to 18 bytes and a window of spaces to
+// start from.
+
+#define LZSS_N 4096
+#define LZSS_F 18
+#define LZSS_THRESHOLD 2
+
+// Big endian "comp" container header, as written by xpwn
+#define LZSS_COMP_SIGNATURE 0x636F6D70
+#define LZSS_SIGNATURE 0x6C7A7373
+
+typedef struct LZSSCompHeader {
+	uint32_t signature;
+	uint32_t compressionType;
+	uint32_t checksum;
+	uint32_t lengthUncompressed;
+	uint32_t lengthCompressed;
+	uint8_t padding[0x16C];
+} __attribute__ ((__packed__)) LZSSCompHeader;
+
+// Decodes compressed data handed over in pieces of any size. The output is
+// written linearly and doubles as the window.
+typedef struct LZSSStream {
+	uint8_t* start;
+	uint8_t* out;
+	uint8_t* end;
+	uint32_t flags;
+	int havePending;
+	uint8_t pending;
+} LZSSStream;
+
+void lzss_stream_init(LZSSStream* stream, void* dst, uint32_t dstLen);
+// Returns -1 once the output would not fit
+int lzss_stream_feed(LZSSStream* stream, const uint8_t* src, uint32_t len);
+uint32_t lzss_stream_length(LZSSStream* stream);
+
+// Checks a comp header; returns the uncompressed length, or -1
+int lzss_comp_check(const LZSSCompHeader* header, uint32_t* compressedLength, uint32_t* checksum);
+
+#endif
@@ -44,6 +44,22 @@ typedef struct FingerData
 	uint16_t unk_1A;
 } FingerData;
 
+// Once set up, the driver reads a frame from a task on each ATN interrupt and
+// queues one event per finger. Only the newest MULTITOUCH_EVENTS are kept.
+#ifndef MULTITOUCH_EVENTS
+#define MULTITOUCH_EVENTS 256
+#endif
+
+typedef struct MultitouchEvent
+{
+	uint32_t timestamp;	// low 32 bits of the system microtime when the frame was read
+	uint8_t frameNum;
+	uint8_t finger;		// index within the frame
+	uint8_t numFingers;
+	uint8_t type;		// frame type
+	FingerData data;
+} __attribute__ ((__packed__)) MultitouchEvent;
+
 #ifdef CONFIG_IPHONE
 int multitouch_setup(const uint8_t* ASpeedFirmware, int ASpeedFirmwareLen, const uint8_t* mainFirmware, int mainFirmwareLen);
 #else
@@ -52,4 +68,19 @@ int multitouch_setup(const uint8_t* constructedFirmware, int constructedFirmware
 
 void multitouch_on();
 
+// Takes up to maxEvents queued events, oldest first, and returns how many.
+int multitouch_read_events(MultitouchEvent* events, int maxEvents);
+int multitouch_pending();
+uint32_t multitouch_dropped();
+
+// Waits up to timeout microseconds for an event; returns 0 if one is queued
+// and -1 otherwise.
+int multitouch_wait(uint32_t timeout);
+
+// Prints every finger of every frame as it arrives.
+void multitouch_set_verbose(int verbose);
+
+// For the drivers: queues the fingers of one frame, header first.
+void multitouch_queue_frame(const uint8_t* data, int len, int sensorWidth, int sensorHeight);
+
 #endif
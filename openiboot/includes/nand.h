@@ -2,6 +2,7 @@
 #define NAND_H
 
 #include "openiboot.h"
+#include "tasks.h"
 
 #define ERROR_ARG 0x80010000
 #define ERROR_NAND 0x80020000
@@ -22,8 +23,11 @@ typedef struct NANDDeviceType {
 	uint32_t userSuBlksTotal;
 	uint32_t ecc1;
 	uint32_t ecc2;
+	uint32_t flags;
 } NANDDeviceType;
 
+#define NAND_FLAG_CACHEREAD 0x1
+
 typedef struct NANDFTLData {
 	uint16_t sysSuBlks;
 	uint16_t field_2;
@@ -77,18 +81,65 @@ typedef struct NANDData {
 	int* banksTable;
 } NANDData;
 
+typedef enum NANDOperation {
+	NANDOperationRead,
+	NANDOperationWrite,
+	NANDOperationErase
+} NANDOperation;
+
+struct NANDRequest;
+typedef void (*NANDRequestCallback)(struct NANDRequest* request, void* opaque);
+
+// A queued NAND operation. page is the block number for erases. Fill in the
+// operation, its arguments and optionally a callback, then nand_submit it.
+// The callback is run from the queue task; status holds the same value the
+// synchronous call would have returned.
+typedef struct NANDRequest {
+	NANDOperation operation;
+	int bank;
+	int page;
+	uint8_t* buffer;
+	uint8_t* spare;
+	int doECC;
+	int status;
+	NANDRequestCallback callback;
+	void* opaque;
+	Completion completion;
+	uint64_t started;
+	struct NANDRequest* next;
+} NANDRequest;
+
 extern int HasNANDInit;
 
 int nand_setup();
 int nand_bank_reset(int bank, int timeout);
 int nand_read(int bank, int page, uint8_t* buffer, uint8_t* spare, int doECC, int checkBadBlocks);
+int nand_read_spare(int bank, int page, uint8_t* spare, int doECC);
 int nand_read_multiple(uint16_t* bank, uint32_t* pages, uint8_t* main, SpareData* spare, int pagesCount);
+void nand_read_spare_multiple(uint16_t* bank, uint32_t* pages, SpareData* spare, int* status, int pagesCount);
 int nand_read_alternate_ecc(int bank, int page, uint8_t* buffer);
 int nand_erase(int bank, int block);
 int nand_write(int bank, int page, uint8_t* buffer, uint8_t* spare, int doECC);
+
+// Programs pagesCount pages with ECC, the banks working on theirs at the same
+// time. Each bank programs its pages lowest first, whatever order they come
+// in. status gets what nand_write would have returned for each page; returns
+// 0 if they all wrote, -1 otherwise.
+int nand_write_multiple(uint16_t* bank, uint32_t* pages, uint8_t* main, SpareData* spare, int* status, int pagesCount);
+
+void nand_submit(NANDRequest* request);
+int nand_wait(NANDRequest* request);
 int nand_read_status();
 int nand_calculate_ecc(uint8_t* data, uint8_t* ecc);
+int nand_ecc_corrected_in_software();
+// Goes up with every page written or block erased, by anyone, so a cache of
+// something on NAND can tell it may be out of date.
+uint32_t nand_write_generation();
 NANDData* nand_get_geometry();
 NANDFTLData* nand_get_ftl_data();
 
+// Finds the fastest bus timing the chip reads back reliably at, and uses it;
+// with save set it is also kept in nvram for later boots.
+int nand_calibrate(int save);
+
 #endif
@@ -0,0 +1,57 @@
+#ifndef NANDDUMP_H
+#define NANDDUMP_H
+
+#include "openiboot.h"
+#include "nand.h"
+
+// Raw NAND images, read by a task into a ring of buffers for the USB code to
+// send. The stream is an NANDDumpHeader followed by batches, each of up to
+// NANDDUMP_PAGES pages of every bank. A batch holds the main areas of its
+// pages, page by page across the banks the way the VFL stripes them, then a
+// NANDDumpSpare for each in the same order.
+
+#define NANDDUMP_MAGIC 0x4E444D50
+
+// Pages of each bank per batch, read with one nand_read_multiple
+#ifndef NANDDUMP_PAGES
+#define NANDDUMP_PAGES 4
+#endif
+
+#ifndef NANDDUMP_BUFFERS
+#define NANDDUMP_BUFFERS 4
+#endif
+
+typedef struct NANDDumpHeader {
+	uint32_t magic;
+	uint32_t banks;
+	uint32_t bytesPerPage;
+	uint32_t bytesPerSpare;		// sizeof(NANDDumpSpare)
+	uint32_t firstPage;
+	uint32_t pages;			// of each bank
+	uint32_t pagesPerBatch;
+	uint32_t reserved;
+} __attribute__ ((__packed__)) NANDDumpHeader;
+
+typedef struct NANDDumpSpare {
+	SpareData spare;
+	uint32_t status;		// what nand_read returned for the page
+} __attribute__ ((__packed__)) NANDDumpSpare;
+
+// Called from the dump task each time another buffer is ready.
+typedef void (*NANDDumpReadyHandler)(void);
+
+// Starts reading pages firstPage up to firstPage + pages of every bank.
+// Returns the length of the whole stream, or 0 if it could not be started.
+uint64_t nanddump_start(uint32_t firstPage, uint32_t pages, NANDDumpReadyHandler ready);
+
+// The oldest buffer not yet sent and its length, or NULL if it is still
+// being read. Safe from interrupt context.
+uint8_t* nanddump_peek(uint32_t* length);
+
+// The buffer nanddump_peek gave out has been sent and may be reused.
+void nanddump_consume();
+
+void nanddump_stop();
+int nanddump_active();
+
+#endif
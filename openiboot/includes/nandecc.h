@@ -0,0 +1,32 @@
+#ifndef NANDECC_H
+#define NANDECC_H
+
+#include "openiboot.h"
+
+// Reed-Solomon over GF(2^10) in software, laid out like the NAND controller's
+// ECC engine: each 512 byte sector gets 2 * strength ten bit parity symbols,
+// 10, 15 or 20 bytes for the strengths 4, 6 and 8 that ecc1 and ecc2 of the
+// NAND table give. Nothing here touches the hardware, so the host tools can
+// build it as it is.
+#define NANDECC_SECTOR_SIZE 512
+#define NANDECC_MAX_STRENGTH 8
+
+// The parity bytes of each sector are stored back to front, as on NAND with
+// more than four sectors per page.
+#define NANDECC_REVERSED 0x1
+
+// Parity bytes per sector, or 0 for a strength the engine does not have.
+int nandecc_bytes(int strength);
+
+void nandecc_encode(int strength, const uint8_t* sector, uint8_t* ecc);
+
+// Fixes up to strength symbol errors in the sector and its parity. Returns how
+// many symbols were corrected, or -1 when there are more errors than that.
+int nandecc_correct(int strength, uint8_t* sector, uint8_t* ecc);
+
+// nandecc_correct on each sector of a page, with the parity of sector i at
+// ecc + i * nandecc_bytes(strength). Returns the symbols corrected in total,
+// or -1 if any sector could not be.
+int nandecc_correct_page(int strength, int sectors, int flags, uint8_t* data, uint8_t* ecc);
+
+#endif
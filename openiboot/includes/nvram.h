@@ -25,12 +25,35 @@ typedef struct NVRamAtom {
 	uint8_t* data;
 } NVRamAtom;
 
+// The environment is kept in one arena of NVRAM_SIZE bytes, found through
+// an open addressed hash table of NVRAM_ENV_SLOTS (a power of two).
+#ifndef NVRAM_ENV_SLOTS
+#define NVRAM_ENV_SLOTS 256
+#endif
+
+#define NVRAM_ENV_MAX ((NVRAM_ENV_SLOTS * 3) / 4)
+
+// name and value are offsets into the arena
 typedef struct EnvironmentVar {
-	char* name;
-	char* value;
-	struct EnvironmentVar* next;
+	uint32_t hash;
+	uint16_t name;
+	uint16_t value;
+	uint8_t changed;
 } EnvironmentVar;
 
+// Saves append the changed variables as records in the erased tail of the
+// common atom, so only their bytes get programmed. The bank is rewritten in
+// iBoot's format, with the journal folded in, once the tail is full; until
+// then iBoot sees the environment as of that last rewrite.
+//#define NO_NVRAM_JOURNAL
+
+// Followed by length bytes of name=value and padding to a halfword.
+// An erased length ends the journal.
+typedef struct NVRamJournalRecord {
+	uint16_t length;
+	uint16_t check;
+} __attribute__ ((packed)) NVRamJournalRecord;
+
 int nvram_setup();
 void nvram_listvars();
 const char* nvram_getvar(const char* name);
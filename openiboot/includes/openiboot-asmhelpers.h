@@ -22,7 +22,11 @@ void WriteAuxiliaryControlRegister(uint32_t regData);
 void WriteDomainAccessControlRegister(uint32_t regData);
 uint32_t ReadDataFaultStatusRegister();
 uint32_t ReadFaultAddressRegister();
+uint32_t ReadBankedLR(uint32_t mode);
 void WritePeripheralPortMemoryRemapRegister(uint32_t regData);
+uint32_t ReadPerformanceMonitorControl();
+void WritePerformanceMonitorControl(uint32_t regData);
+void ReadPerformanceCounters(uint32_t* counters);
 void GiveFullAccessCP10CP11();
 void EnableVFP();
 void WaitForInterrupt();
@@ -37,9 +41,19 @@ void InvalidateCPUDataCache();
 void CleanAndInvalidateCPUDataCache();
 void ClearCPUCaches();
 
+// For DMA buffers: clean before the device reads memory, invalidate before it
+// writes. Lines only partly in the range are cleaned as well as invalidated,
+// so that whatever else shares them survives. Ranges the size of the cache or
+// more fall back to the whole cache.
+void CleanDataCacheRange(const void* start, uint32_t length);
+void InvalidateDataCacheRange(void* start, uint32_t length);
+void CleanAndInvalidateDataCacheRange(void* start, uint32_t length);
+
 void CallArm(uint32_t address);
 void CallThumb(uint32_t address);
 
+void SwapTaskContext(TaskDescriptor* save, TaskDescriptor* resume);
+
 void Reboot();
 
 #endif
@@ -36,6 +36,38 @@ extern void* _start;
 extern void* OpenIBootEnd;
 extern int received_file_size;
 
+// (Re)starts the OpenIBoot interface on the USB port, or the ACM console
+// in its place when that is enabled
+void startUSB();
+
+// Runs a line as if it had come in over USB. Safe from interrupt context.
+void queueConsoleCommand(const char* command);
+
+// For long loops in commands, once per step: yields to the other tasks and
+// returns TRUE once "cancel" has come in, after which the command should stop.
+int command_cancelled();
+
+typedef enum BootStageID {
+	BootStageDisplay,
+	BootStageAudio,
+	BootStageNAND,
+	BootStageFS,
+	BootStageCamera,
+	BootStageRadio,
+	BootStageSDIO,
+	BootStageWLAN,
+	BootStageAccel,
+	BootStageALS,
+	BootStageCount
+} BootStageID;
+
+// Waits for the devices being brought up in the background, then prints how
+// long each one took
+void waitForBootStages();
+
+// Waits for just the one stage, if it has been started at all
+void waitForBootStageID(BootStageID id);
+
 typedef enum Boolean {
 	FALSE = 0,
 	TRUE = 1
@@ -85,8 +117,8 @@ typedef enum TaskState {
 #define TaskDescriptorIdentifier2 0x74736b32
 
 struct Event {
-	LinkedList	list;
-	uint64_t	deadline;
+	uint32_t	heapIndex;	// position in the event heap, 0 when not queued
+	uint64_t	deadline;	// in timer ticks
 	uint64_t	interval;
 	EventHandler	handler;
 	void*		opaque;
@@ -17,12 +17,30 @@ typedef enum PowerSupplyType {
 	PowerSupplyTypeUSBBrick1000mA
 } PowerSupplyType;
 
+// Most registers pmu_write_regs puts in one bus write
+#ifndef PMU_WRITE_BATCH
+#define PMU_WRITE_BATCH 16
+#endif
+
+// Battery voltage and charger type readings are reused for this long, in
+// microseconds
+#ifndef PMU_ADC_CACHE_TIME
+#define PMU_ADC_CACHE_TIME 1000000
+#endif
+
+// Registers below this may be shadowed
+#define PMU_SHADOW_REGS 0x40
+
 #define PMU_IBOOTSTATE 0xF
 #define PMU_IBOOTDEBUG 0x0
 #define PMU_IBOOTSTAGE 0x1
 #define PMU_IBOOTERRORCOUNT 0x2
 #define PMU_IBOOTERRORSTAGE 0x3
 
+// set to PMU_RESUME_MAGIC by a kernel going into suspend-to-RAM
+#define PMU_RESUMEFLAG 0x4
+#define PMU_RESUME_MAGIC 0xA5
+
 int pmu_setup();
 void pmu_poweroff();
 void pmu_set_iboot_stage(uint8_t stage);
@@ -32,6 +50,9 @@ int pmu_get_reg(int reg);
 int pmu_get_regs(int reg, uint8_t* out, int count);
 int pmu_write_reg(int reg, int data, int verify);
 int pmu_write_regs(const PMURegisterData* regs, int num);
+// Anything that changed the PMU behind its back, such as iic_write, should
+// call this so the shadowed registers and cached readings are read again.
+void pmu_forget_shadows();
 int pmu_get_battery_voltage();
 PowerSupplyType pmu_get_power_supply();
 void pmu_charge_settings(int UseUSB, int SuspendUSB, int StopCharger);
@@ -3,6 +3,8 @@
 
 int vsprintf(char *buf, const char *fmt, va_list args);
 int sprintf(char *buf, const char *fmt, ...);
+int vsnprintf(char *buf, size_t size, const char *fmt, va_list args);
+int snprintf(char *buf, size_t size, const char *fmt, ...);
 int vprintf(const char *fmt, va_list args);
 int printf(const char *fmt, ...);
 int puts(const char *str);
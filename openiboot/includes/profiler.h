@@ -0,0 +1,43 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include "openiboot.h"
+
+// Samples where the CPU is on every tick of ProfileTimer, counting each pair
+// of the interrupted PC and LR. Code in critical sections, and in handlers at
+// the timer interrupt's priority or above, is never interrupted by it and so
+// never shows up.
+#ifndef PROFILER_SLOTS
+#define PROFILER_SLOTS 4096
+#endif
+
+#ifndef PROFILER_DEFAULT_HZ
+#define PROFILER_DEFAULT_HZ 1000
+#endif
+
+#define PROFILER_MAGIC 0x464F5250
+
+// What profiler_dump writes: this, then entries of those.
+typedef struct ProfilerDumpHeader {
+	uint32_t magic;
+	uint32_t hz;
+	uint32_t samples;
+	uint32_t dropped;		// pairs that did not fit in the table
+	uint32_t entries;
+} __attribute__ ((__packed__)) ProfilerDumpHeader;
+
+typedef struct ProfilerEntry {
+	uint32_t pc;
+	uint32_t lr;
+	uint32_t count;
+} __attribute__ ((__packed__)) ProfilerEntry;
+
+int profiler_start(uint32_t hz);
+void profiler_stop();
+void profiler_reset();
+void profiler_print(int maxEntries);
+
+// Writes the samples to address for getfile, returning how many bytes.
+uint32_t profiler_dump(void* address);
+
+#endif
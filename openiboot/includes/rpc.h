@@ -0,0 +1,103 @@
+#ifndef RPC_H
+#define RPC_H
+
+#include "openiboot.h"
+
+// Binary requests carried over the USB bulk endpoints. See OPENIBOOTCMD_RPC
+// in usb.h for the transport.
+
+typedef enum RPCOperation {
+	RPCMemRead = 0,		// args: address, length
+	RPCMemWrite = 1,	// args: address; data: bytes to write
+	RPCNANDRead = 2,	// args: bank, page, doECC; reply: page data then spare
+	RPCNANDWrite = 3,	// args: bank, page, doECC; data: page data then spare
+	RPCNANDErase = 4,	// args: bank, block
+	RPCVFLRead = 5,		// args: virtual page; reply: page data then spare
+				// (the NAND and VFL operations return the driver's code as status)
+	RPCFTLRead = 6,		// args: offset low, offset high, length
+	RPCFTLWrite = 7,	// args: offset low, offset high; data: bytes to write
+	RPCImagesList = 8,	// reply: array of RPCImageInfo
+	RPCImagesRead = 9,	// args: type; reply: decrypted payload
+	RPCImagesVerify = 10,	// args: type; status: images_verify result
+	RPCLatency = 11,	// args: reset afterwards; reply: LatencyHistogram per LatencyOperation
+	RPCIOTrace = 12,	// args: 0 fetch, 1 start, 2 stop; clear after fetch
+				// reply: IOTraceEntry array, oldest first
+	RPCMultitouchEvents = 13,	// args: max events, microseconds to wait for one
+				// reply: MultitouchEvent array, oldest first, taken off the queue
+	RPCBootProfile = 14,	// reply: BootProfileEntry array, oldest first; status: records dropped
+	RPCAESKBAGs = 15,	// data: RPCKBAG array; reply: the same array, each decrypted with the GID key
+	RPCHash = 16,		// data: RPCHashRange; reply: one digest per block, back to back
+	RPCDeltaWrite = 17	// data: RPCDeltaHeader, then RPCDeltaBlocks each followed by its data
+				// reply: uint32_t count of blocks written before any failure
+} RPCOperation;
+
+#define RPC_OK 0
+#define RPC_ERROR_OPERATION -1
+#define RPC_ERROR_ARGUMENTS -2
+#define RPC_ERROR_IO -3
+#define RPC_ERROR_MEMORY -4
+
+#define RPC_MAX_DATA 0x20000
+
+typedef struct RPCRequest {
+	uint32_t operation;
+	uint32_t tag;		// echoed in the response
+	uint32_t args[4];
+	uint32_t dataLen;	// bytes following this header
+} __attribute__ ((__packed__)) RPCRequest;
+
+typedef struct RPCResponse {
+	uint32_t operation;
+	uint32_t tag;
+	int32_t status;
+	uint32_t dataLen;	// bytes following this header
+} __attribute__ ((__packed__)) RPCResponse;
+
+typedef struct RPCImageInfo {
+	uint32_t type;
+	uint32_t offset;
+	uint32_t length;
+	uint32_t padded;
+	uint32_t index;
+} __attribute__ ((__packed__)) RPCImageInfo;
+
+// The IV and key of an Img3 KBAG tag, without the type and key size in
+// front. AES-128 and AES-192 keys are padded out with zeros.
+typedef struct RPCKBAG {
+	uint8_t iv[16];
+	uint8_t key[32];
+} __attribute__ ((__packed__)) RPCKBAG;
+
+// What RPCHash works out; algorithm and source as in hash.h.
+typedef struct RPCHashRange {
+	uint32_t algorithm;
+	uint32_t source;
+	uint64_t offset;
+	uint64_t length;
+	uint32_t blockSize;
+} __attribute__ ((__packed__)) RPCHashRange;
+
+// For updating NOR or an FTL partition in place: the host asks RPCHash for
+// the digests of what is there, compares them with its own and sends only
+// the blocks that differ. target is HashNOR or HashFTL; NOR goes through
+// nor_write, which only erases sectors that need it, and FTL through
+// ftl_write, committed with ftl_sync afterwards if sync is set. The image
+// list is read again after NOR has been written.
+typedef struct RPCDeltaHeader {
+	uint32_t target;
+	uint32_t count;
+	uint32_t sync;
+} __attribute__ ((__packed__)) RPCDeltaHeader;
+
+typedef struct RPCDeltaBlock {
+	uint64_t offset;
+	uint32_t length;	// bytes of data following this
+} __attribute__ ((__packed__)) RPCDeltaBlock;
+
+#define RPC_MAX_REQUEST (sizeof(RPCRequest) + RPC_MAX_DATA)
+
+// Runs one request and returns a DMA-aligned response buffer that the caller
+// frees. Never returns NULL unless memory is exhausted.
+RPCResponse* rpc_handle(const RPCRequest* request, uint32_t requestLen, uint32_t* responseLen);
+
+#endif
@@ -3,7 +3,28 @@
 
 #include "openiboot.h"
 
+// Scripts are compiled before they run. Besides commands, one per line,
+// they can have
+//	let <name> <value> [+ - * / % <value>]
+//	if <value> == != < <= > >= <value> ... [else ...] end
+//	for <name> <from> <to> [step] ... end
+//	repeat <count> ... end
+// with $name anywhere in a line standing for a script or NVRAM variable.
+// Lines starting with # are comments.
+#ifndef SCRIPT_MAX_DEPTH
+#define SCRIPT_MAX_DEPTH 16
+#endif
+
+#ifndef SCRIPT_MAX_VARS
+#define SCRIPT_MAX_VARS 32
+#endif
+
+#define SCRIPT_NAME_MAX 32
+#define SCRIPT_VALUE_MAX 128
+#define SCRIPT_LINE_MAX 512
+
 void startScripting();
+int script_run(const char* text, uint32_t size);
 
 //static void processCommand(char*);
 
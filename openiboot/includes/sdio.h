@@ -3,6 +3,29 @@
 
 #include "openiboot.h"
 #include "interrupt.h"
+#include "tasks.h"
+
+struct SDIORequest;
+typedef void (*SDIORequestCallback)(struct SDIORequest* request, void* opaque);
+
+// A queued CMD53 transfer, run by the sdio task with the same arguments as
+// sdio_writesb/sdio_readsb (incr_addr FALSE) or the memcpy calls (TRUE).
+// error holds what the synchronous call would have returned. Without a
+// callback the request completes for sdio_wait; with one, the callback is
+// run from the sdio task instead and owns the request from then on.
+typedef struct SDIORequest {
+	int isWrite;
+	int function;
+	uint32_t address;
+	int incr_addr;
+	void* buffer;
+	int count;
+	int error;
+	SDIORequestCallback callback;
+	void* opaque;
+	Completion completion;
+	struct SDIORequest* next;
+} SDIORequest;
 
 int sdio_setup();
 
@@ -18,4 +41,7 @@ int sdio_readsb(int function, void* dst, uint32_t address, int count);
 int sdio_memcpy_toio(int function, uint32_t address, void* src, int count);
 int sdio_memcpy_fromio(int function, void* dst, uint32_t address, int count);
 
+void sdio_submit(SDIORequest* request);
+int sdio_wait(SDIORequest* request);
+
 #endif
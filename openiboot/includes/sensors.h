@@ -0,0 +1,45 @@
+#ifndef SENSORS_H
+#define SENSORS_H
+
+#include "openiboot.h"
+
+// Samples the accelerometer and the ambient light sensor together at a fixed
+// rate, from the event queue through queued I2C requests, so nobody has to
+// wait on the bus for a reading. Each sample is timestamped and kept in a
+// ring that readers go through with a cursor of their own.
+
+// Samples kept, a power of two
+#ifndef SENSORS_RING
+#define SENSORS_RING 64
+#endif
+
+typedef enum SensorValid {
+	SensorAccelValid = 1 << 0,
+	SensorLightValid = 1 << 1
+} SensorValid;
+
+typedef struct SensorSample {
+	uint64_t time;		// system microtime the reads were started
+	int8_t x;
+	int8_t y;
+	int8_t z;
+	uint8_t valid;		// SensorValid, for the reads that went through
+	uint16_t light;		// als_data of the current channel
+} SensorSample;
+
+// interval in microseconds; starting again only changes it
+int sensors_start(uint32_t interval);
+void sensors_stop();
+int sensors_running();
+
+// The newest sample, FALSE if there is none yet
+int sensors_latest(SensorSample* sample);
+
+// Copies up to max samples from *cursor on, starting with 0, and moves the
+// cursor past them. Samples overwritten before they were read are skipped.
+int sensors_read(uint32_t* cursor, SensorSample* samples, int max);
+
+// Samples not taken because the last reads had not finished yet
+uint32_t sensors_missed();
+
+#endif
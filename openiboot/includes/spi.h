@@ -2,6 +2,7 @@
 #define SPI_H
 
 #include "openiboot.h"
+#include "tasks.h"
 
 typedef struct SPIRegister {
 	uint32_t control;
@@ -26,6 +27,37 @@ typedef enum SPIOption13 {
 	SPIOption13Setting2 = 32
 } SPIOption13;
 
+// Called from interrupt context once a transfer has completely finished.
+typedef void (*SPIHandler)(int port, uint32_t token);
+
+typedef enum SPIDirection {
+	SPIDataNone = 0,
+	SPIDataOut,
+	SPIDataIn
+} SPIDirection;
+
+// One chip-selected exchange: the command bytes go out, then the data phase
+// in direction, then chip select is let go unless keepSelected is set.
+// Fill it in and spi_submit it; status is 0 once it has gone through, -1 if
+// it was abandoned. handler, if not NULL, is called from interrupt context
+// when it is done.
+typedef struct SPITransaction {
+	int cs;				// GPIO of the chip select, driven low while selected, or -1
+	int keepSelected;
+	const uint8_t* command;
+	int commandLen;
+	SPIDirection direction;
+	const uint8_t* out;
+	uint8_t* in;
+	int dataLen;
+	int status;
+	SPIHandler handler;
+	uint32_t token;
+	Completion completion;
+	int phase;
+	struct SPITransaction* next;
+} SPITransaction;
+
 typedef struct SPIInfo {
 	int option13;
 	int isActiveLow;
@@ -43,12 +75,49 @@ typedef struct SPIInfo {
 	volatile int counter;
 	volatile int txDone;
 	volatile int rxDone;
+	int clearTransmitJunk;
+	int dma;
+	int txController;
+	int txChannel;
+	int rxController;
+	int rxChannel;
+	SPIHandler handler;
+	uint32_t token;
+	Completion completion;
+	SPITransaction* queue;
+	SPITransaction* queueTail;
 } SPIInfo;
 
+// Transfers of at least this many bytes in each direction go by DMA, on two
+// channels each port reserves the first time.
+#ifndef SPI_DMA_MIN
+#define SPI_DMA_MIN 64
+#endif
+
 int spi_setup();
 int spi_tx(int port, const uint8_t* buffer, int len, int block, int unknown);
 int spi_rx(int port, uint8_t* buffer, int len, int block, int noTransmitJunk);
 int spi_txrx(int port, const uint8_t* outBuffer, int outLen, uint8_t* inBuffer, int inLen, int block);
+
+// These return straight away; handler, if not NULL, is called on completion.
+// Only one transfer may be in flight on a port.
+int spi_tx_async(int port, const uint8_t* buffer, int len, int unknown, SPIHandler handler, uint32_t token);
+int spi_rx_async(int port, uint8_t* buffer, int len, int noTransmitJunk, SPIHandler handler, uint32_t token);
+int spi_txrx_async(int port, const uint8_t* outBuffer, int outLen, uint8_t* inBuffer, int inLen, SPIHandler handler, uint32_t token);
+// Blocks the calling task until the transfer on the port is done, or
+// abandons it after timeout microseconds and returns -1.
+int spi_wait(int port, uint32_t timeout);
+
+// Transactions on a port run back to back in the order they were submitted,
+// each phase started from the interrupt that ends the one before. Nothing
+// else may use the port while any are queued.
+int spi_submit(int port, SPITransaction* transaction);
+// Blocks until the transaction is done and returns its status. After timeout
+// microseconds it and everything queued behind it are abandoned.
+int spi_transaction_wait(int port, SPITransaction* transaction, uint32_t timeout);
+// spi_submit and spi_transaction_wait, with a timeout to suit the length.
+int spi_transaction(int port, SPITransaction* transaction);
+
 void spi_set_baud(int port, int baud, SPIOption13 option13, int isMaster, int isActiveLow, int lastClockEdgeMissing);
 
 #endif
@@ -3,6 +3,57 @@
 
 #include "openiboot.h"
 
+#define TASK_DEFAULT_STACK 0x4000
+
+// Tasks waiting on a mutex or semaphore, linked through runqueueList
+typedef struct TaskQueue {
+	TaskDescriptor* head;
+	TaskDescriptor* tail;
+} TaskQueue;
+
+typedef struct Mutex {
+	TaskDescriptor* owner;
+	uint32_t count;
+	TaskQueue waiters;
+} Mutex;
+
+typedef struct Semaphore {
+	int32_t value;
+	TaskQueue waiters;
+} Semaphore;
+
+typedef struct Completion {
+	volatile int done;
+	TaskQueue waiters;
+} Completion;
+
 int tasks_setup();
 
+TaskDescriptor* task_create(const char* name, TaskRoutineFunction routine, void* opaque, uint32_t stackSize);
+void task_yield();
+void task_sleep(uint32_t microseconds);
+// Outside of interrupt handlers and critical sections, once the scheduler is up
+int task_can_sleep();
+void task_exit(uint32_t exitState);
+void tasks_list();
+
+// mutex_lock may not be used from interrupt context. Locks are recursive.
+void mutex_init(Mutex* mutex);
+void mutex_lock(Mutex* mutex);
+void mutex_unlock(Mutex* mutex);
+
+// semaphore_signal may be used from interrupt context, e.g. a DMA completion
+// handler waking the task that started the transfer.
+void semaphore_init(Semaphore* semaphore, int32_t value);
+void semaphore_wait(Semaphore* semaphore);
+void semaphore_signal(Semaphore* semaphore);
+
+// A completion latches once signalled, until it is initialized again.
+// completion_signal may be used from interrupt context. completion_wait
+// returns 0 once signalled or -1 after timeout microseconds; with a timeout
+// of 0 it only checks and never blocks.
+void completion_init(Completion* completion);
+void completion_signal(Completion* completion);
+int completion_wait(Completion* completion, uint32_t timeout);
+
 #endif
@@ -35,9 +35,32 @@ int timer_init(int timer_id, uint32_t interval, uint32_t interval2, uint32_t pre
 uint64_t timer_get_system_microtime();
 void timer_get_rtc_ticks(uint64_t* ticks, uint64_t* sec_divisor);
 
+// The raw timebase, TicksPerSec to the second. Loops that only compare times
+// are cheapest done in ticks; the conversions are valid after timer_setup.
+uint64_t timer_get_ticks();
+uint64_t timer_ticks_to_us(uint64_t ticks);
+uint64_t timer_us_to_ticks(uint64_t us);
+
+// Delays of UDELAY_SLEEP_MIN microseconds or more sleep the task when it is
+// allowed to (see task_can_sleep); anything else spins.
+#ifndef UDELAY_SLEEP_MIN
+#define UDELAY_SLEEP_MIN 1000
+#endif
+
 void udelay(uint64_t delay);
 int has_elapsed(uint64_t startTime, uint64_t elapsedTime);
 
+// For loops polling hardware: once POLL_SPIN_TIME has passed since startTime,
+// each call sleeps POLL_SLEEP_TIME where the task may sleep.
+#ifndef POLL_SPIN_TIME
+#define POLL_SPIN_TIME 200
+#endif
+#ifndef POLL_SLEEP_TIME
+#define POLL_SLEEP_TIME 500
+#endif
+
+void poll_wait(uint64_t startTime);
+
 extern int RTCHasInit;
 
 #endif
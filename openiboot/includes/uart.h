@@ -42,6 +42,33 @@ int uart_set_baud_rate(int ureg, uint32_t baud);
 int uart_write(int ureg, const char *buffer, uint32_t length);
 int uart_read(int ureg, char *buffer, uint32_t length, uint64_t timeout);
 
+// With buffered receive on, the UART's interrupt moves incoming bytes from the
+// FIFO to a ring of UART_RX_RING bytes and reads come from there, sleeping
+// instead of spinning while they wait. Must be a power of two.
+#ifndef UART_RX_RING
+#define UART_RX_RING 0x1000
+#endif
+
+int uart_set_rx_buffered(int ureg, OnOff buffered);
+// Like uart_read, but returns as soon as anything has been read.
+int uart_read_some(int ureg, char *buffer, uint32_t length, uint64_t timeout);
+// Bytes dropped because the ring was full
+uint32_t uart_rx_overruns(int ureg);
+
+// With buffered transmit on, writes are copied to a ring of UART_TX_RING
+// bytes and the FIFO-empty interrupt feeds the UART from there. A write
+// only waits when the ring is full. Not for UARTs with flow control. The
+// console (UART 0) starts out buffered unless UART_TX_SYNC is defined.
+// Must be a power of two.
+#ifndef UART_TX_RING
+#define UART_TX_RING 0x1000
+#endif
+
+int uart_set_tx_buffered(int ureg, OnOff buffered);
+// Waits until everything written so far is out on the wire. Safe with
+// interrupts off, for panics and before handing the machine over.
+void uart_flush(int ureg);
+
 extern int UartHasInit;
 
 #endif
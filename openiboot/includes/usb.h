@@ -13,7 +13,12 @@
 #define USB_SETUP_PACKETS_AT_A_TIME 1
 #define CONTROL_SEND_BUFFER_LEN 0x80
 #define CONTROL_RECV_BUFFER_LEN 0x80
-#define TX_QUEUE_LEN 0x80
+
+// bulk and interrupt transfers that can wait behind the one in flight, per
+// endpoint and direction
+#ifndef USB_TRANSFER_QUEUE_LEN
+#define USB_TRANSFER_QUEUE_LEN 4
+#endif
 
 // one packet at a time
 #define USB_MULTICOUNT 1
@@ -178,6 +183,9 @@ typedef struct USBFirstStringDescriptor {
 typedef struct USBInterface {
 	USBInterfaceDescriptor descriptor;
 	USBEndpointDescriptor* endpointDescriptors;
+	// class-specific descriptors, sent right after the interface descriptor
+	uint8_t* classDescriptors;
+	uint16_t classDescriptorsLength;
 } USBInterface;
 
 typedef struct USBConfiguration {
@@ -193,23 +201,102 @@ typedef struct USBSetupPacket {
 	uint16_t wLength;
 } __attribute__ ((__packed__)) USBSetupPacket;
 
-typedef struct RingBuffer {
-	int8_t* writePtr;
-	int8_t* readPtr;
-	uint32_t count;
-	uint32_t size;
-	int8_t* bufferStart;
-	int8_t* bufferEnd;
-} RingBuffer;
+typedef struct USBTransfer {
+	uint8_t* buffer;
+	int length;
+	int done;
+	int chunk;
+	USBTransferType type;
+} USBTransfer;
+
+typedef struct USBTransferQueue {
+	USBTransfer transfers[USB_TRANSFER_QUEUE_LEN];
+	int head;
+	int count;
+	Boolean started;
+} USBTransferQueue;
 
 typedef void (*USBStartHandler)(void);
 typedef void (*USBEnumerateHandler)(USBInterface* interface);
 
+// Gets class requests on the control endpoint. Returns how many bytes of
+// buffer to send back in the data stage, or -1 to stall.
+typedef int (*USBClassRequestHandler)(USBSetupPacket* setupPacket, uint8_t* buffer);
+
 #define OPENIBOOTCMD_DUMPBUFFER 0
 #define OPENIBOOTCMD_DUMPBUFFER_LEN 1
 #define OPENIBOOTCMD_DUMPBUFFER_GOAHEAD 2
 #define OPENIBOOTCMD_SENDCOMMAND 3
 #define OPENIBOOTCMD_SENDCOMMAND_GOAHEAD 4
+#define OPENIBOOTCMD_SENDFILE 5
+#define OPENIBOOTCMD_SENDFILE_GOAHEAD 6
+#define OPENIBOOTCMD_NOTIFY 7
+
+// Sent once the CRC32 trailer of a sendfile stream is in. dataLen is 1 if
+// it matched the data (and the CRC given to "sendfile", if any), else 0.
+#define OPENIBOOTCMD_SENDFILE_DONE 11
+
+// Binary RPC (see rpc.h): the host sends OPENIBOOTCMD_RPC with the request
+// length, waits for OPENIBOOTCMD_RPC_GOAHEAD (dataLen of zero means busy),
+// then writes the request to the bulk out endpoint. When it has run, the
+// device sends OPENIBOOTCMD_RPC_REPLY with the response length, and the host
+// collects it with OPENIBOOTCMD_DUMPBUFFER_GOAHEAD like a getfile.
+#define OPENIBOOTCMD_RPC 8
+#define OPENIBOOTCMD_RPC_GOAHEAD 9
+#define OPENIBOOTCMD_RPC_REPLY 10
+
+// Bulk throughput benchmark: the host sends OPENIBOOTCMD_BENCH_COUNT with the
+// number of transfers, then one of the modes with the size of each, up to
+// USBBENCH_MAX_TRANSFER. The reply is OPENIBOOTCMD_BENCH_GOAHEAD with the
+// size, or zero for no. Sink takes the transfers from the bulk out endpoint,
+// source sends them on bulk in, and echo sends each one back before taking
+// the next. OPENIBOOTCMD_BENCH_DONE follows with the microseconds from the
+// goahead to the end of the last transfer.
+#define OPENIBOOTCMD_BENCH_COUNT 12
+#define OPENIBOOTCMD_BENCH_SINK 13
+#define OPENIBOOTCMD_BENCH_SOURCE 14
+#define OPENIBOOTCMD_BENCH_ECHO 15
+#define OPENIBOOTCMD_BENCH_GOAHEAD 16
+#define OPENIBOOTCMD_BENCH_DONE 17
+
+// Command batches: the host sends OPENIBOOTCMD_SENDBATCH with the length of
+// up to OPENIBOOTCMD_BATCH_MAX bytes of newline separated commands, waits for
+// OPENIBOOTCMD_SENDBATCH_GOAHEAD and writes them to the bulk out endpoint.
+// The goahead carries the number given to the first command of the batch,
+// counting on from the last batch, or zero for busy. Empty lines get no
+// number. Once each command has run the console gets "batch: <number> done".
+// The next batch may be sent as soon as this one is written; commands are
+// queued, not run, as they come in.
+#define OPENIBOOTCMD_SENDBATCH 18
+#define OPENIBOOTCMD_SENDBATCH_GOAHEAD 19
+
+#ifndef OPENIBOOTCMD_BATCH_MAX
+#define OPENIBOOTCMD_BATCH_MAX 0x4000
+#endif
+
+#ifndef USBBENCH_MAX_TRANSFER
+#define USBBENCH_MAX_TRANSFER 0x10000
+#endif
+
+// "getfile <address> <length> z" sends the data run-length coded: a
+// GetFileZHeader, then GetFileZRun records until length bytes are covered.
+// A run with GETFILEZ_FILL set in fill stands for length copies of its low
+// byte; any other run is followed by length bytes of data.
+//
+// "getfile <address> <length> c" sends the data followed by its CRC32, four
+// more bytes than length, so the host can check it and ask again.
+#define GETFILEZ_MAGIC 0x5A42494F
+#define GETFILEZ_FILL 0x100
+
+typedef struct GetFileZHeader {
+	uint32_t magic;
+	uint32_t length;
+}  __attribute__ ((__packed__)) GetFileZHeader;
+
+typedef struct GetFileZRun {
+	uint32_t length;
+	uint32_t fill;
+}  __attribute__ ((__packed__)) GetFileZRun;
 
 typedef struct OpenIBootCmd {
 	uint32_t command;
@@ -247,10 +334,21 @@ int usb_start(USBEnumerateHandler hEnumerate, USBStartHandler hStart);
 int usb_shutdown();
 int usb_install_ep_handler(int endpoint, USBDirection direction, USBEndpointHandler handler, uint32_t token);
 void usb_add_endpoint(USBInterface* interface, int endpoint, USBDirection direction, USBTransferType transferType);
+// For functions with more than one interface, from the enumerate handler.
+// The new interface gets the next number; earlier USBInterface pointers are
+// not valid after this.
+USBInterface* usb_add_interface(uint8_t bInterfaceClass, uint8_t bInterfaceSubClass, uint8_t bInterfaceProtocol);
+void usb_add_class_descriptor(USBInterface* interface, const void* descriptor, int length);
+void usb_set_device_class(uint8_t bDeviceClass, uint8_t bDeviceSubClass, uint8_t bDeviceProtocol);
+void usb_set_interface_class(uint8_t bInterfaceClass, uint8_t bInterfaceSubClass, uint8_t bInterfaceProtocol);
+void usb_set_class_request_handler(USBClassRequestHandler handler);
 void usb_send_interrupt(uint8_t endpoint, void* buffer, int bufferLen);
 void usb_send_bulk(uint8_t endpoint, void* buffer, int bufferLen);
 void usb_receive_bulk(uint8_t endpoint, void* buffer, int bufferLen);
 void usb_receive_interrupt(uint8_t endpoint, void* buffer, int bufferLen);
+// How much the last OUT transfer to finish on endpoint got, which a short
+// packet can make less than was asked for
+int usb_received_length(uint8_t endpoint);
 USBSpeed usb_get_speed();
 
 USBDeviceDescriptor* usb_get_device_descriptor();
@@ -0,0 +1,87 @@
+#ifndef USBACM_H
+#define USBACM_H
+
+#include "openiboot.h"
+
+// The console as a USB CDC-ACM serial port, in place of the OpenIBoot
+// interface, so a plain terminal on the host can drive it. Scrollback goes
+// out on a bulk IN endpoint as it is written and typed lines are queued as
+// commands, with no interrupt endpoint handshakes in between. It is picked
+// with the opib-usb-console NVRAM variable set to acm, or the usbacm command.
+
+#define USBACM_CDC_CLASS 0x02
+#define USBACM_ACM_SUBCLASS 0x02
+#define USBACM_DATA_CLASS 0x0A
+
+// the same endpoints as the OpenIBoot interface, so their directions match
+#define USBACM_DATA_IN 1
+#define USBACM_DATA_OUT 2
+#define USBACM_NOTIFY 3
+
+#define USBACM_REQUEST_SET_LINE_CODING 0x20
+#define USBACM_REQUEST_GET_LINE_CODING 0x21
+#define USBACM_REQUEST_SET_CONTROL_LINE_STATE 0x22
+#define USBACM_REQUEST_SEND_BREAK 0x23
+
+#define USBACM_CS_INTERFACE 0x24
+#define USBACM_HEADER 0x00
+#define USBACM_CALL_MANAGEMENT 0x01
+#define USBACM_ABSTRACT_CONTROL 0x02
+#define USBACM_UNION 0x06
+
+// Scrollback sent in one go, at most
+#ifndef USBACM_TX_SIZE
+#define USBACM_TX_SIZE 0x1000
+#endif
+
+#ifndef USBACM_LINE_MAX
+#define USBACM_LINE_MAX 512
+#endif
+
+typedef struct USBACMFunctionalDescriptors {
+	struct {
+		uint8_t bFunctionLength;
+		uint8_t bDescriptorType;
+		uint8_t bDescriptorSubtype;
+		uint16_t bcdCDC;
+	} __attribute__ ((__packed__)) header;
+
+	struct {
+		uint8_t bFunctionLength;
+		uint8_t bDescriptorType;
+		uint8_t bDescriptorSubtype;
+		uint8_t bmCapabilities;
+		uint8_t bDataInterface;
+	} __attribute__ ((__packed__)) callManagement;
+
+	struct {
+		uint8_t bFunctionLength;
+		uint8_t bDescriptorType;
+		uint8_t bDescriptorSubtype;
+		uint8_t bmCapabilities;
+	} __attribute__ ((__packed__)) abstractControl;
+
+	struct {
+		uint8_t bFunctionLength;
+		uint8_t bDescriptorType;
+		uint8_t bDescriptorSubtype;
+		uint8_t bMasterInterface;
+		uint8_t bSlaveInterface0;
+	} __attribute__ ((__packed__)) unionFunction;
+} __attribute__ ((__packed__)) USBACMFunctionalDescriptors;
+
+typedef struct USBACMLineCoding {
+	uint32_t dwDTERate;
+	uint8_t bCharFormat;
+	uint8_t bParityType;
+	uint8_t bDataBits;
+} __attribute__ ((__packed__)) USBACMLineCoding;
+
+// Whether startUSB brings the console up as ACM
+int usbacm_enabled();
+void usbacm_set_enabled(int enabled);
+
+// What startUSB does instead when it is
+void usbacm_start();
+
+#endif
@@ -0,0 +1,34 @@
+#ifndef USBAUDIO_H
+#define USBAUDIO_H
+
+#include "openiboot.h"
+
+// Streams what the codec captures to the host over a bulk IN endpoint, as raw
+// 16-bit little endian stereo at 44.1kHz. The capture periods go out straight
+// from the DMA ring, so nothing is copied on the way.
+
+#define USBAUDIO_INTERFACE_CLASS 0xFF
+#define USBAUDIO_INTERFACE_SUBCLASS 0x01
+#define USBAUDIO_INTERFACE_PROTOCOL 0x00
+
+#define USBAUDIO_ENDPOINT 1
+
+// Class requests to the interface. STATUS answers with a USBAudioStatus, and
+// STOP ends the stream and brings the OpenIBoot interface back.
+#define USBAUDIO_REQUEST_STATUS 0x01
+#define USBAUDIO_REQUEST_STOP 0x02
+
+typedef struct USBAudioStatus {
+	uint32_t rate;
+	uint16_t channels;
+	uint16_t bits;
+	uint32_t periodSize;
+	uint32_t periodsSent;
+	uint32_t overruns;	// periods lost before they could be sent
+} __attribute__ ((__packed__)) USBAudioStatus;
+
+// Takes over the USB port until the host sends STOP or, unless it is 0,
+// seconds have gone by.
+int usbaudio_run(uint32_t seconds);
+
+#endif
@@ -0,0 +1,74 @@
+#ifndef USBMSC_H
+#define USBMSC_H
+
+#include "openiboot.h"
+
+// USB mass storage, Bulk-Only Transport with the SCSI transparent command
+// set, exporting the whole FTL (MBR included) with NAND page sized blocks.
+
+#define USBMSC_INTERFACE_CLASS 0x08
+#define USBMSC_INTERFACE_SUBCLASS 0x06
+#define USBMSC_INTERFACE_PROTOCOL 0x50
+
+#define USBMSC_REQUEST_RESET 0xFF
+#define USBMSC_REQUEST_GET_MAX_LUN 0xFE
+
+#define USBMSC_CBW_SIGNATURE 0x43425355
+#define USBMSC_CSW_SIGNATURE 0x53425355
+
+#define USBMSC_CBW_DATA_IN 0x80
+
+#define USBMSC_CSW_PASSED 0
+#define USBMSC_CSW_FAILED 1
+#define USBMSC_CSW_PHASE_ERROR 2
+
+// Each of the two data buffers. Reads from NAND overlap with sending the
+// other buffer, and writes to NAND with receiving it.
+#ifndef USBMSC_BUFFER_SIZE
+#define USBMSC_BUFFER_SIZE 0x40000
+#endif
+
+typedef enum SCSIOperation {
+	SCSITestUnitReady = 0x00,
+	SCSIRequestSense = 0x03,
+	SCSIInquiry = 0x12,
+	SCSIModeSense6 = 0x1A,
+	SCSIStartStopUnit = 0x1B,
+	SCSIPreventAllowMediumRemoval = 0x1E,
+	SCSIReadFormatCapacities = 0x23,
+	SCSIReadCapacity10 = 0x25,
+	SCSIRead10 = 0x28,
+	SCSIWrite10 = 0x2A,
+	SCSIVerify10 = 0x2F,
+	SCSISynchronizeCache10 = 0x35,
+	SCSIModeSense10 = 0x5A
+} SCSIOperation;
+
+#define SCSI_SENSE_NONE 0x00
+#define SCSI_SENSE_NOT_READY 0x02
+#define SCSI_SENSE_MEDIUM_ERROR 0x03
+#define SCSI_SENSE_ILLEGAL_REQUEST 0x05
+#define SCSI_SENSE_DATA_PROTECT 0x07
+
+typedef struct USBMSCCommandBlockWrapper {
+	uint32_t signature;
+	uint32_t tag;
+	uint32_t dataLength;
+	uint8_t flags;
+	uint8_t lun;
+	uint8_t cbLength;
+	uint8_t cb[16];
+} __attribute__ ((__packed__)) USBMSCCommandBlockWrapper;
+
+typedef struct USBMSCCommandStatusWrapper {
+	uint32_t signature;
+	uint32_t tag;
+	uint32_t residue;
+	uint8_t status;
+} __attribute__ ((__packed__)) USBMSCCommandStatusWrapper;
+
+// Takes over the USB port until the host ejects the disk, then flushes
+// everything to NAND and brings the OpenIBoot interface back up.
+int usbmsc_run(int readOnly);
+
+#endif
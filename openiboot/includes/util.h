@@ -10,6 +10,56 @@
 #define DebugPrintf(...)
 #endif
 
+// Leveled logging. LogPrintf calls above LOG_LEVEL compile out entirely.
+// Errors, warnings and info always print; debug and trace only for the
+// subsystems set in LogMask, from the log command or opib-log-mask.
+#define LOG_ERROR 0
+#define LOG_WARN 1
+#define LOG_INFO 2
+#define LOG_DEBUG 3
+#define LOG_TRACE 4
+
+#ifndef LOG_LEVEL
+#if defined(DEBUG)
+#define LOG_LEVEL LOG_TRACE
+#elif defined(SMALL)
+#define LOG_LEVEL LOG_INFO
+#else
+#define LOG_LEVEL LOG_DEBUG
+#endif
+#endif
+
+typedef enum LogSubsystem {
+	LogFTL,
+	LogNAND,
+	LogUSB,
+	LogMultitouch,
+	LogSDIO,
+	LogWLAN,
+	LogNOR,
+	LogImages,
+	LogAudio,
+	LogRadio,
+	LogSubsystems
+} LogSubsystem;
+
+#define LOG_MASK_VAR "opib-log-mask"
+
+extern uint32_t LogMask;
+
+#define LogPrintf(level, subsystem, ...) \
+	do { \
+		if((level) <= LOG_LEVEL && ((level) <= LOG_INFO || (LogMask & (1 << (subsystem))) != 0)) \
+			bufferPrintf(__VA_ARGS__); \
+	} while(0)
+
+#define LogDebug(subsystem, ...) LogPrintf(LOG_DEBUG, subsystem, __VA_ARGS__)
+#define LogTrace(subsystem, ...) LogPrintf(LOG_TRACE, subsystem, __VA_ARGS__)
+
+const char* log_subsystem_name(int subsystem);
+// Returns the subsystem called name, or -1
+int log_subsystem_find(const char* name);
+
 void panic();
 
 void __assert(const char* file, int line, const char* m);
@@ -27,7 +77,10 @@ int tolower(int c);
 int putchar(int c);
 unsigned long int parseNumber(const char* str);
 unsigned long int strtoul(const char* str, char** endptr, int base);
+#define TOKENIZE_MAX_ARGS 32
+
 char** tokenize(char* commandline, int* argc);
+int tokenize_into(char* commandline, char** arguments, int maxArgs);
 void dump_memory(uint32_t start, int length);
 void buffer_dump_memory(uint32_t start, int length);
 void hexdump(uint32_t start, int length);
@@ -39,16 +92,28 @@ void uartPrint(const char* toBuffer);
 void uartPrintf(const char* format, ...);
 void fbPrintf(const char* format, ...);
 void bufferFlush(char* destination, size_t length);
-char* getScrollback();
 size_t getScrollbackLen();
+uint32_t getScrollbackDropped();
+
+typedef void (*ScrollbackHandler)(void);
+void setScrollbackHandler(ScrollbackHandler handler);
 
 void hexToBytes(const char* hex, uint8_t** buffer, int* bytes);
 void bytesToHex(const uint8_t* buffer, int bytes);
 
 uint32_t crc32(uint32_t* ckSum, const void *buffer, size_t len);
 uint32_t adler32(uint8_t *buf, int32_t len);
+// Carries on an adler32 over more data; adler32 of nothing is 1.
+uint32_t adler32_update(uint32_t adler, const uint8_t *buf, int32_t len);
 
 #include "printf.h"
 #include "malloc-2.8.3.h"
 
+// DMA_ALIGN aligned and padded, from the DMA arena. Release with free.
+void* malloc_dma(size_t size);
+
+// From the boot arena, only released all at once by free_boot_arena.
+void* malloc_boot(size_t size);
+void free_boot_arena();
+
 #endif
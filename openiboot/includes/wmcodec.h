@@ -1,3 +1,5 @@
+#include "dma.h"
+
 struct sound_settings_info {
 	const char *unit;
 	char numdecimals;
@@ -37,6 +39,56 @@ uint32_t audiohw_get_position();
 uint32_t audiohw_get_total();
 void audiohw_mute(int mute);
 
+// Streamed playback, from a ring of AUDIO_STREAM_PERIODS buffers of
+// AUDIO_STREAM_PERIOD bytes in coherent memory. refill is called from the
+// audio task with each buffer as it comes free and returns how many bytes it
+// put there; anything short of size ends the stream once it has played.
+#ifndef AUDIO_STREAM_PERIODS
+#define AUDIO_STREAM_PERIODS 2
+#endif
+
+#ifndef AUDIO_STREAM_PERIOD
+#define AUDIO_STREAM_PERIOD 0x4000
+#endif
+
+typedef uint32_t (*AudioRefillHandler)(void* buffer, uint32_t size, void* opaque);
+
+int audiohw_play_stream(AudioRefillHandler refill, void* opaque, int use_speaker);
+int audiohw_stream_active();
+// Periods that played before the task could refill them
+uint32_t audiohw_stream_underruns();
+
+// For the stream: plays the periods round and round until audiohw_stop,
+// calling handler as each one finishes.
+int audiohw_play_periods(const DMASegment* periods, int count, int use_speaker, DMAHandler handler);
+void audiohw_stop();
+
+// Streamed capture from the codec's ADCs into a ring of AUDIO_CAPTURE_PERIODS
+// buffers of AUDIO_CAPTURE_PERIOD bytes of 16-bit stereo in coherent memory.
+// handler is called from the capture task with each period as it fills, in
+// order, and has it until it returns. The DMA is back round to that buffer
+// AUDIO_CAPTURE_PERIODS - 1 periods later. Playback can run at the same time.
+#ifndef AUDIO_CAPTURE_PERIODS
+#define AUDIO_CAPTURE_PERIODS 4
+#endif
+
+#ifndef AUDIO_CAPTURE_PERIOD
+#define AUDIO_CAPTURE_PERIOD 0x4000
+#endif
+
+typedef void (*AudioCaptureHandler)(void* buffer, uint32_t size, void* opaque);
+
+int audiohw_capture_stream(AudioCaptureHandler handler, void* opaque);
+void audiohw_capture_end();
+int audiohw_capture_active();
+// Periods the DMA wrote over before the handler could have them
+uint32_t audiohw_capture_overruns();
+
+// For the capture stream: receives into the periods round and round until
+// audiohw_capture_stop, calling handler as each one fills.
+int audiohw_capture_periods(const DMASegment* periods, int count, DMAHandler handler);
+void audiohw_capture_stop();
+
 void audiohw_switch_normal_call(int in_call);
 
 #ifdef CONFIG_3G
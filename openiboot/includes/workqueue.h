@@ -0,0 +1,36 @@
+#ifndef WORKQUEUE_H
+#define WORKQUEUE_H
+
+#include "openiboot.h"
+
+// Deferred work for interrupt handlers. A handler posts a Work and returns;
+// the work task then runs it with interrupts enabled, where it may take
+// locks, sleep, print or talk to I2C devices. Work is run in the order it
+// was posted.
+
+#ifndef WORKQUEUE_STACK
+#define WORKQUEUE_STACK 0x4000
+#endif
+
+typedef void (*WorkRoutine)(void* opaque);
+
+typedef struct Work {
+	WorkRoutine routine;
+	void* opaque;
+	volatile int queued;
+	struct Work* next;
+} Work;
+
+int workqueue_setup();
+
+void work_init(Work* work, WorkRoutine routine, void* opaque);
+
+// Safe from interrupt context. Posting a Work that has not run yet does
+// nothing and returns FALSE; it still runs once.
+int work_post(Work* work);
+
+// Runs everything posted so far on the calling task, for before the work
+// task is up or for code that must see it done. Returns how many ran.
+int work_run_pending();
+
+#endif
@@ -0,0 +1,548 @@
+#ifndef SMALL
+#ifndef NO_STBIMAGE
+
+#include "openiboot.h"
+#include "inflate.h"
+#include "util.h"
+
+// Codes of up to INFLATE_FAST_BITS bits take one table lookup, which also says
+// what the symbol stands for: a literal, or the base and extra bits of a length
+// or a distance. Longer codes are rare, they are decoded canonically from the
+// code counts, a bit at a time.
+#ifndef INFLATE_FAST_BITS
+#define INFLATE_FAST_BITS 10
+#endif
+
+#define INFLATE_FAST_SIZE (1 << INFLATE_FAST_BITS)
+#define INFLATE_MAX_BITS 15
+
+// value in bits 0-15, code length in 16-19, extra bits in 20-23, kind above that
+#define ENTRY(kind, extra, length, value) (((uint32_t)(kind) << 24) | ((extra) << 20) | ((length) << 16) | (value))
+#define ENTRY_VALUE(e) ((e) & 0xFFFF)
+#define ENTRY_LENGTH(e) (((e) >> 16) & 0xF)
+#define ENTRY_EXTRA(e) (((e) >> 20) & 0xF)
+#define ENTRY_KIND(e) ((e) >> 24)
+
+enum {
+	KindLiteral,
+	KindCopy,
+	KindEnd,
+	KindInvalid,
+	KindLong
+};
+
+enum {
+	TableLiterals,
+	TableDistances,
+	TableCodeLengths
+};
+
+typedef struct InflateTable {
+	int type;
+	uint32_t fast[INFLATE_FAST_SIZE];
+	uint16_t count[INFLATE_MAX_BITS + 1];
+	uint16_t symbols[288];
+} InflateTable;
+
+typedef struct Inflate {
+	const uint8_t* in;
+	const uint8_t* inEnd;
+	uint32_t pastEnd;		// zero bytes fed to the bit buffer after the end of in
+	uint32_t bitBuffer;
+	uint32_t bitCount;
+
+	uint8_t* outStart;
+	uint8_t* out;
+	uint8_t* outEnd;
+	int expandable;
+
+	InflateTable literals;
+	InflateTable distances;
+	InflateTable codeLengths;
+} Inflate;
+
+static const uint16_t LengthBase[29] = {
+	3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+	35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+
+static const uint8_t LengthExtra[29] = {
+	0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+	3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+
+static const uint16_t DistanceBase[30] = {
+	1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+	257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577 };
+
+static const uint8_t DistanceExtra[30] = {
+	0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+	7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+
+static const uint8_t CodeLengthOrder[19] = {
+	16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15 };
+
+static InflateTable FixedLiterals;
+static InflateTable FixedDistances;
+static int FixedBuilt = FALSE;
+
+static uint32_t symbolEntry(int type, int symbol, int length) {
+	switch(type) {
+		case TableLiterals:
+			if(symbol < 256)
+				return ENTRY(KindLiteral, 0, length, symbol);
+			if(symbol == 256)
+				return ENTRY(KindEnd, 0, length, 0);
+			if(symbol < 286)
+				return ENTRY(KindCopy, LengthExtra[symbol - 257], length, LengthBase[symbol - 257]);
+			return ENTRY(KindInvalid, 0, length, 0);
+
+		case TableDistances:
+			if(symbol < 30)
+				return ENTRY(KindCopy, DistanceExtra[symbol], length, DistanceBase[symbol]);
+			return ENTRY(KindInvalid, 0, length, 0);
+
+		default:
+			return ENTRY(KindLiteral, 0, length, symbol);
+	}
+}
+
+static uint32_t reverseBits(uint32_t code, int length) {
+	uint32_t reversed = 0;
+	while(length-- > 0) {
+		reversed = (reversed << 1) | (code & 1);
+		code >>= 1;
+	}
+	return reversed;
+}
+
+// Over-subscribed code lengths are corrupt. Incomplete ones are allowed, their
+// missing codes decode as invalid if they ever turn up.
+static int buildTable(InflateTable* table, int type, const uint8_t* lengths, int num) {
+	uint16_t offsets[INFLATE_MAX_BITS + 1];
+	uint32_t code;
+	int index;
+	int left;
+	int len;
+	int i;
+
+	table->type = type;
+	memset(table->count, 0, sizeof(table->count));
+	for(i = 0; i < num; i++)
+		table->count[lengths[i]]++;
+
+	table->count[0] = 0;
+	left = 1;
+	for(len = 1; len <= INFLATE_MAX_BITS; len++) {
+		left = (left << 1) - table->count[len];
+		if(left < 0)
+			return FALSE;
+	}
+
+	offsets[1] = 0;
+	for(len = 1; len < INFLATE_MAX_BITS; len++)
+		offsets[len + 1] = offsets[len] + table->count[len];
+
+	for(i = 0; i < num; i++) {
+		if(lengths[i] != 0)
+			table->symbols[offsets[lengths[i]]++] = i;
+	}
+
+	for(i = 0; i < INFLATE_FAST_SIZE; i++)
+		table->fast[i] = ENTRY(KindLong, 0, 0, 0);
+
+	// codes go out most significant bit first, so the table is indexed by the
+	// reversed code, repeated for every value of the bits after it
+	code = 0;
+	index = 0;
+	for(len = 1; len <= INFLATE_FAST_BITS; len++) {
+		for(i = 0; i < table->count[len]; i++) {
+			uint32_t entry = symbolEntry(type, table->symbols[index++], len);
+			uint32_t fill;
+
+			for(fill = reverseBits(code, len); fill < INFLATE_FAST_SIZE; fill += (1 << len))
+				table->fast[fill] = entry;
+
+			code++;
+		}
+		code <<= 1;
+	}
+
+	return TRUE;
+}
+
+static void buildFixedTables() {
+	uint8_t lengths[288];
+	int i;
+
+	for(i = 0; i < 144; i++)
+		lengths[i] = 8;
+	for(; i < 256; i++)
+		lengths[i] = 9;
+	for(; i < 280; i++)
+		lengths[i] = 7;
+	for(; i < 288; i++)
+		lengths[i] = 8;
+	buildTable(&FixedLiterals, TableLiterals, lengths, 288);
+
+	for(i = 0; i < 32; i++)
+		lengths[i] = 5;
+	buildTable(&FixedDistances, TableDistances, lengths, 32);
+
+	FixedBuilt = TRUE;
+}
+
+// Past the end of the input the buffer is topped up with zeroes, which is only
+// corrupt if they are actually used; see inflateOverrun.
+static inline void refill(Inflate* s) {
+	while(s->bitCount <= 24) {
+		uint32_t byte = 0;
+		if(s->in < s->inEnd)
+			byte = *(s->in++);
+		else
+			s->pastEnd++;
+
+		s->bitBuffer |= byte << s->bitCount;
+		s->bitCount += 8;
+	}
+}
+
+static inline int inflateOverrun(Inflate* s) {
+	return (s->pastEnd * 8) > s->bitCount;
+}
+
+static inline uint32_t getBits(Inflate* s, int n) {
+	uint32_t value;
+
+	if(s->bitCount < n)
+		refill(s);
+
+	value = s->bitBuffer & ((1 << n) - 1);
+	s->bitBuffer >>= n;
+	s->bitCount -= n;
+	return value;
+}
+
+static uint32_t decodeLong(Inflate* s, InflateTable* table) {
+	uint32_t bits = s->bitBuffer;
+	int code = 0;
+	int first = 0;
+	int index = 0;
+	int len;
+
+	for(len = 1; len <= INFLATE_MAX_BITS; len++) {
+		int count = table->count[len];
+
+		code |= bits & 1;
+		bits >>= 1;
+		if((code - first) < count) {
+			s->bitBuffer >>= len;
+			s->bitCount -= len;
+			return symbolEntry(table->type, table->symbols[index + code - first], len);
+		}
+
+		index += count;
+		first = (first + count) << 1;
+		code <<= 1;
+	}
+
+	return ENTRY(KindInvalid, 0, 0, 0);
+}
+
+static inline uint32_t decode(Inflate* s, InflateTable* table) {
+	uint32_t entry;
+
+	if(s->bitCount < INFLATE_MAX_BITS)
+		refill(s);
+
+	entry = table->fast[s->bitBuffer & (INFLATE_FAST_SIZE - 1)];
+	if(ENTRY_KIND(entry) == KindLong)
+		return decodeLong(s, table);
+
+	s->bitBuffer >>= ENTRY_LENGTH(entry);
+	s->bitCount -= ENTRY_LENGTH(entry);
+	return entry;
+}
+
+static int grow(Inflate* s, uint32_t needed) {
+	uint32_t used = s->out - s->outStart;
+	uint32_t size = s->outEnd - s->outStart;
+	uint8_t* buffer;
+
+	if(!s->expandable)
+		return FALSE;
+
+	while((size - used) < needed)
+		size *= 2;
+
+	buffer = (uint8_t*) realloc(s->outStart, size);
+	if(buffer == NULL)
+		return FALSE;
+
+	s->outStart = buffer;
+	s->out = buffer + used;
+	s->outEnd = buffer + size;
+	return TRUE;
+}
+
+static int inflateCodes(Inflate* s, InflateTable* literals, InflateTable* distances) {
+	while(TRUE) {
+		uint32_t entry;
+		uint32_t length;
+		uint32_t distance;
+		uint8_t* from;
+
+		// the buffer holds four bytes, so a fifth zero means a truncated block,
+		// which would otherwise decode zero bits into an output without end
+		if(s->pastEnd > 4)
+			return FALSE;
+
+		entry = decode(s, literals);
+		if(ENTRY_KIND(entry) == KindLiteral) {
+			if(s->out == s->outEnd && !grow(s, 1))
+				return FALSE;
+
+			*(s->out++) = ENTRY_VALUE(entry);
+			continue;
+		}
+
+		if(ENTRY_KIND(entry) == KindEnd)
+			return TRUE;
+
+		if(ENTRY_KIND(entry) != KindCopy)
+			return FALSE;
+
+		length = ENTRY_VALUE(entry) + getBits(s, ENTRY_EXTRA(entry));
+
+		entry = decode(s, distances);
+		if(ENTRY_KIND(entry) != KindCopy)
+			return FALSE;
+
+		distance = ENTRY_VALUE(entry) + getBits(s, ENTRY_EXTRA(entry));
+		if(distance > (uint32_t)(s->out - s->outStart))
+			return FALSE;
+
+		if(length > (uint32_t)(s->outEnd - s->out) && !grow(s, length))
+			return FALSE;
+
+		from = s->out - distance;
+		if(distance == 1) {
+			memset(s->out, *from, length);
+			s->out += length;
+		} else if(distance >= length) {
+			memcpy(s->out, from, length);
+			s->out += length;
+		} else {
+			// overlapping, every byte may be one just written
+			while(length-- > 0)
+				*(s->out++) = *(from++);
+		}
+	}
+}
+
+static int inflateStored(Inflate* s) {
+	uint32_t unread;
+	uint32_t length;
+
+	// to the next byte boundary, then give back the whole bytes still buffered
+	getBits(s, s->bitCount & 7);
+	unread = s->bitCount / 8;
+	if(unread < s->pastEnd)
+		return FALSE;
+
+	s->in -= unread - s->pastEnd;
+	s->pastEnd = 0;
+	s->bitBuffer = 0;
+	s->bitCount = 0;
+
+	if((s->inEnd - s->in) < 4)
+		return FALSE;
+
+	length = s->in[0] | (s->in[1] << 8);
+	if((s->in[2] | (s->in[3] << 8)) != (length ^ 0xFFFF))
+		return FALSE;
+
+	s->in += 4;
+	if(length > (uint32_t)(s->inEnd - s->in))
+		return FALSE;
+
+	if(length > (uint32_t)(s->outEnd - s->out) && !grow(s, length))
+		return FALSE;
+
+	memcpy(s->out, s->in, length);
+	s->out += length;
+	s->in += length;
+	return TRUE;
+}
+
+static int inflateDynamic(Inflate* s) {
+	uint8_t lengths[286 + 30];
+	uint32_t numLiterals;
+	uint32_t numDistances;
+	uint32_t numCodes;
+	uint32_t i;
+
+	numLiterals = getBits(s, 5) + 257;
+	numDistances = getBits(s, 5) + 1;
+	numCodes = getBits(s, 4) + 4;
+	if(numLiterals > 286 || numDistances > 30)
+		return FALSE;
+
+	memset(lengths, 0, 19);
+	for(i = 0; i < numCodes; i++)
+		lengths[CodeLengthOrder[i]] = getBits(s, 3);
+
+	if(!buildTable(&s->codeLengths, TableCodeLengths, lengths, 19))
+		return FALSE;
+
+	i = 0;
+	while(i < (numLiterals + numDistances)) {
+		uint32_t entry = decode(s, &s->codeLengths);
+		uint32_t symbol = ENTRY_VALUE(entry);
+		uint32_t repeat;
+		uint8_t value = 0;
+
+		if(ENTRY_KIND(entry) != KindLiteral)
+			return FALSE;
+
+		if(symbol < 16) {
+			lengths[i++] = symbol;
+			continue;
+		}
+
+		if(symbol == 16) {
+			if(i == 0)
+				return FALSE;
+			value = lengths[i - 1];
+			repeat = 3 + getBits(s, 2);
+		} else if(symbol == 17) {
+			repeat = 3 + getBits(s, 3);
+		} else {
+			repeat = 11 + getBits(s, 7);
+		}
+
+		if((i + repeat) > (numLiterals + numDistances))
+			return FALSE;
+
+		memset(lengths + i, value, repeat);
+		i += repeat;
+	}
+
+	// no end of block code means no way out of this block
+	if(lengths[256] == 0)
+		return FALSE;
+
+	if(!buildTable(&s->literals, TableLiterals, lengths, numLiterals))
+		return FALSE;
+
+	if(!buildTable(&s->distances, TableDistances, lengths + numLiterals, numDistances))
+		return FALSE;
+
+	return inflateCodes(s, &s->literals, &s->distances);
+}
+
+static int inflateStream(Inflate* s, int zlib) {
+	int final;
+
+	if(zlib) {
+		uint32_t cmf;
+		uint32_t flg;
+
+		if((s->inEnd - s->in) < 2)
+			return FALSE;
+
+		cmf = s->in[0];
+		flg = s->in[1];
+		if((cmf & 0x0F) != 8 || (((cmf << 8) | flg) % 31) != 0 || (flg & 0x20))
+			return FALSE;
+
+		s->in += 2;
+	}
+
+	do {
+		int ok;
+
+		final = getBits(s, 1);
+		switch(getBits(s, 2)) {
+			case 0:
+				ok = inflateStored(s);
+				break;
+
+			case 1:
+				if(!FixedBuilt)
+					buildFixedTables();
+				ok = inflateCodes(s, &FixedLiterals, &FixedDistances);
+				break;
+
+			case 2:
+				ok = inflateDynamic(s);
+				break;
+
+			default:
+				ok = FALSE;
+				break;
+		}
+
+		if(!ok || inflateOverrun(s))
+			return FALSE;
+	} while(!final);
+
+	return TRUE;
+}
+
+static int inflateRun(uint8_t** out, uint32_t* outLen, const void* in, uint32_t inLen, int zlib, int expandable) {
+	Inflate* s;
+	int ok;
+
+	// the tables take up a good 14K, too much for a task stack
+	s = (Inflate*) malloc(sizeof(Inflate));
+	if(s == NULL)
+		return FALSE;
+
+	s->in = (const uint8_t*) in;
+	s->inEnd = s->in + inLen;
+	s->pastEnd = 0;
+	s->bitBuffer = 0;
+	s->bitCount = 0;
+	s->outStart = *out;
+	s->out = *out;
+	s->outEnd = *out + *outLen;
+	s->expandable = expandable;
+
+	ok = inflateStream(s, zlib);
+
+	*out = s->outStart;
+	*outLen = s->out - s->outStart;
+	free(s);
+	return ok;
+}
+
+int inflate_buffer(void* out, uint32_t outLen, const void* in, uint32_t inLen, int zlib) {
+	uint8_t* buffer = (uint8_t*) out;
+
+	if(!inflateRun(&buffer, &outLen, in, inLen, zlib, FALSE))
+		return -1;
+
+	return outLen;
+}
+
+void* inflate_malloc(const void* in, uint32_t inLen, uint32_t sizeHint, int zlib, uint32_t* outLen) {
+	uint8_t* buffer;
+	uint32_t size;
+
+	size = (sizeHint > 0) ? sizeHint : 1;
+	buffer = (uint8_t*) malloc(size);
+	if(buffer == NULL)
+		return NULL;
+
+	if(!inflateRun(&buffer, &size, in, inLen, zlib, TRUE)) {
+		free(buffer);
+		return NULL;
+	}
+
+	if(outLen)
+		*outLen = size;
+
+	return buffer;
+}
+
+#endif
+#endif
@@ -3,8 +3,11 @@
 #include "hardware/interrupt.h"
 #include "hardware/edgeic.h"
 #include "util.h"
+#include "irqoff.h"
 #include "openiboot-asmhelpers.h"
 
+IRQSavedFrame* volatile IRQFrame = NULL;
+
 int interrupt_setup() {
 	if((0xfff & (GET_REG(VIC0 + VICPERIPHID0) | (GET_REG(VIC0 + VICPERIPHID1) << 8) | (GET_REG(VIC0 + VICPERIPHID2) << 16) | (GET_REG(VIC0 + VICPERIPHID3) << 24))) != 0x192) {
 		/* peripheral ID for vic0 doesn't match PL 192, which is the VIC we are expecting */
@@ -28,14 +31,17 @@ int interrupt_setup() {
 	SET_REG(VIC0 + VICSWPRIORITYMASK, 0xffff); // unmask all 16 interrupt levels
 	SET_REG(VIC1 + VICSWPRIORITYMASK, 0xffff);
 
-	// Set interrupt vector addresses to the interrupt number. This will signal the interrupt handler to consult the handler tables
+	memset(InterruptHandlerTable, 0, sizeof(InterruptHandlerTable));
+
+	// Point each vector address at its handler table entry, so the interrupt handler can use what it reads from VICADDRESS directly
 	int i;
 	for(i = 0; i < VIC_InterruptSeparator; i++) {
-		SET_REG(VIC0 + VICVECTADDRS + (i * 4), i);
-		SET_REG(VIC1 + VICVECTADDRS + (i * 4), VIC_InterruptSeparator + i);
+		SET_REG(VIC0 + VICVECTADDRS + (i * 4), (uint32_t) &InterruptHandlerTable[i]);
+		SET_REG(VIC1 + VICVECTADDRS + (i * 4), (uint32_t) &InterruptHandlerTable[VIC_InterruptSeparator + i]);
 	}
 
-	memset(InterruptHandlerTable, 0, sizeof(InterruptHandlerTable));
+	for(i = 0; i < VIC_MaxInterrupt; i++)
+		interrupt_set_priority(i, INTERRUPT_PRIORITY_LOWEST);
 
 	return 0;
 }
@@ -49,6 +55,46 @@ int interrupt_install(int irq_no, InterruptServiceRoutine handler, uint32_t toke
 	InterruptHandlerTable[irq_no].handler = handler;
 	InterruptHandlerTable[irq_no].token = token;
 	InterruptHandlerTable[irq_no].useEdgeIC = 0;
+	irqoff_wrap(irq_no);
+	if(irq_no < VIC_InterruptSeparator) {
+		SET_REG(VIC0 + VICINTSELECT, GET_REG(VIC0 + VICINTSELECT) & ~(1 << irq_no));
+	} else {
+		SET_REG(VIC1 + VICINTSELECT, GET_REG(VIC1 + VICINTSELECT) & ~(1 << (irq_no - VIC_InterruptSeparator)));
+	}
+	LeaveCriticalSection();
+
+	return 0;
+}
+
+// The handler runs in FIQ mode, ahead of whatever IRQ handler is running.
+int interrupt_install_fiq(int irq_no, InterruptServiceRoutine handler, uint32_t token) {
+	if(interrupt_install(irq_no, handler, token) != 0) {
+		return -1;
+	}
+
+	EnterCriticalSection();
+	if(irq_no < VIC_InterruptSeparator) {
+		SET_REG(VIC0 + VICINTSELECT, GET_REG(VIC0 + VICINTSELECT) | (1 << irq_no));
+	} else {
+		SET_REG(VIC1 + VICINTSELECT, GET_REG(VIC1 + VICINTSELECT) | (1 << (irq_no - VIC_InterruptSeparator)));
+	}
+	LeaveCriticalSection();
+
+	return 0;
+}
+
+int interrupt_set_priority(int irq_no, int priority) {
+	if(irq_no >= VIC_MaxInterrupt || priority < 0 || priority >= VIC_PriorityLevels) {
+		return -1;
+	}
+
+	EnterCriticalSection();
+	if(irq_no < VIC_InterruptSeparator) {
+		SET_REG(VIC0 + VICVECTPRIORITYS + (irq_no * 4), priority);
+	} else {
+		SET_REG(VIC1 + VICVECTPRIORITYS + ((irq_no - VIC_InterruptSeparator) * 4), priority);
+	}
+	InterruptHandlerTable[irq_no].preemptMask = (1 << priority) - 1;
 	LeaveCriticalSection();
 
 	return 0;
@@ -0,0 +1,266 @@
+#include "openiboot.h"
+#include "irqoff.h"
+#include "interrupt.h"
+#include "timer.h"
+#include "util.h"
+#include "openiboot-asmhelpers.h"
+#include "hardware/timer.h"
+
+typedef struct IRQOffStat {
+	uint32_t count;
+	uint32_t max;
+	uint64_t total;
+	uint32_t buckets[IRQOFF_BUCKETS];
+} IRQOffStat;
+
+typedef struct IRQOffSite {
+	void* caller;
+	IRQOffStat stat;
+} IRQOffSite;
+
+typedef struct IRQOffSource {
+	InterruptServiceRoutine handler;
+	uint32_t token;
+	IRQOffStat handlerStat;
+	IRQOffStat latency;
+	uint32_t deadline;
+	int expected;
+} IRQOffSource;
+
+volatile int IRQOffTracking = FALSE;
+
+// Site 0 takes every caller once the table is full.
+static IRQOffSite* Sites = NULL;
+static uint32_t SiteCount;
+static IRQOffSource Sources[VIC_MaxInterrupt];
+
+static void* CritSectCaller;
+static uint32_t CritSectStart;
+static int CritSectOpen = FALSE;
+
+// The low word is enough for durations, and is one register read.
+static inline uint32_t irqoff_ticks() {
+	return GET_REG(TIMER + TIMER_TICKSLOW);
+}
+
+static void stat_record(IRQOffStat* stat, uint32_t ticks) {
+	int bucket = 0;
+	while(bucket < (IRQOFF_BUCKETS - 1) && (ticks >> bucket) != 0)
+		bucket++;
+
+	stat->count++;
+	stat->total += ticks;
+	stat->buckets[bucket]++;
+	if(ticks > stat->max)
+		stat->max = ticks;
+}
+
+static IRQOffSite* site_find(void* caller) {
+	uint32_t slot = (((uint32_t) caller) * 2654435761U) & (IRQOFF_SITES - 1);
+	uint32_t i;
+
+	for(i = 0; i < IRQOFF_SITES; i++) {
+		if(slot != 0) {
+			if(Sites[slot].caller == caller)
+				return &Sites[slot];
+
+			if(Sites[slot].caller == NULL) {
+				if(SiteCount >= (IRQOFF_SITES - 1))
+					return &Sites[0];
+
+				Sites[slot].caller = caller;
+				SiteCount++;
+				return &Sites[slot];
+			}
+		}
+		slot = (slot + 1) & (IRQOFF_SITES - 1);
+	}
+
+	return &Sites[0];
+}
+
+// Both run with interrupts off.
+void critsect_entered(void* caller) {
+	CritSectCaller = caller;
+	CritSectStart = irqoff_ticks();
+	CritSectOpen = TRUE;
+}
+
+void critsect_left() {
+	if(!CritSectOpen)
+		return;
+
+	CritSectOpen = FALSE;
+	stat_record(&site_find(CritSectCaller)->stat, irqoff_ticks() - CritSectStart);
+}
+
+static void irqoff_dispatch(uint32_t irq_no) {
+	IRQOffSource* source = &Sources[irq_no];
+	uint32_t start = irqoff_ticks();
+
+	// a shared source may come in early for something else
+	if(source->expected && (int32_t)(start - source->deadline) >= 0) {
+		source->expected = FALSE;
+		stat_record(&source->latency, start - source->deadline);
+	}
+
+	source->handler(source->token);
+	stat_record(&source->handlerStat, irqoff_ticks() - start);
+}
+
+void irqoff_wrap(int irq_no) {
+	InterruptHandler* entry = &InterruptHandlerTable[irq_no];
+
+	if(!IRQOffTracking || entry->handler == NULL || entry->handler == irqoff_dispatch)
+		return;
+
+	EnterCriticalSection();
+	Sources[irq_no].handler = entry->handler;
+	Sources[irq_no].token = entry->token;
+	entry->handler = irqoff_dispatch;
+	entry->token = irq_no;
+	LeaveCriticalSection();
+}
+
+void irqoff_expect(int irq_no, uint64_t ticks) {
+	if(!IRQOffTracking)
+		return;
+
+	Sources[irq_no].deadline = (uint32_t) ticks;
+	Sources[irq_no].expected = TRUE;
+}
+
+int irqoff_start() {
+	int i;
+
+	if(Sites == NULL) {
+		Sites = (IRQOffSite*) malloc(sizeof(IRQOffSite) * IRQOFF_SITES);
+		if(Sites == NULL) {
+			bufferPrintf("irqoff: out of memory\r\n");
+			return -1;
+		}
+		irqoff_reset();
+	}
+
+	if(IRQOffTracking)
+		return 0;
+
+	IRQOffTracking = TRUE;
+	for(i = 0; i < VIC_MaxInterrupt; i++)
+		irqoff_wrap(i);
+
+	return 0;
+}
+
+void irqoff_stop() {
+	int i;
+
+	if(!IRQOffTracking)
+		return;
+
+	EnterCriticalSection();
+	IRQOffTracking = FALSE;
+	CritSectOpen = FALSE;
+	for(i = 0; i < VIC_MaxInterrupt; i++) {
+		if(InterruptHandlerTable[i].handler == irqoff_dispatch) {
+			InterruptHandlerTable[i].handler = Sources[i].handler;
+			InterruptHandlerTable[i].token = Sources[i].token;
+		}
+		Sources[i].expected = FALSE;
+	}
+	LeaveCriticalSection();
+}
+
+void irqoff_reset() {
+	int i;
+
+	if(Sites == NULL)
+		return;
+
+	EnterCriticalSection();
+	memset(Sites, 0, sizeof(IRQOffSite) * IRQOFF_SITES);
+	SiteCount = 0;
+	for(i = 0; i < VIC_MaxInterrupt; i++) {
+		memset(&Sources[i].handlerStat, 0, sizeof(IRQOffStat));
+		memset(&Sources[i].latency, 0, sizeof(IRQOffStat));
+	}
+	LeaveCriticalSection();
+}
+
+static uint32_t ticks_us(uint64_t ticks) {
+	return (uint32_t) timer_ticks_to_us(ticks);
+}
+
+static void stat_print(const IRQOffStat* stat) {
+	uint32_t count = 0;
+	int i;
+
+	bufferPrintf("%d times, max %d us, mean %d us\r\n\t\t", stat->count, ticks_us(stat->max),
+			ticks_us(stat->total / stat->count));
+
+	// buckets under a microsecond are shown together
+	for(i = 0; i < IRQOFF_BUCKETS; i++) {
+		uint32_t bound = ticks_us((uint64_t) 1 << i);
+		count += stat->buckets[i];
+		if(i < (IRQOFF_BUCKETS - 1) && ticks_us((uint64_t) 1 << (i + 1)) <= 1)
+			continue;
+
+		if(count != 0) {
+			if(i == (IRQOFF_BUCKETS - 1))
+				bufferPrintf(" >=%dus:%d", ticks_us((uint64_t) 1 << (i - 1)), count);
+			else
+				bufferPrintf(" <%dus:%d", (bound > 0) ? bound : 1, count);
+		}
+		count = 0;
+	}
+	bufferPrintf("\r\n");
+}
+
+void irqoff_print(int maxSites) {
+	static uint8_t printed[IRQOFF_SITES];
+	int i;
+	int j;
+
+	if(Sites == NULL) {
+		bufferPrintf("irqoff: tracking not started\r\n");
+		return;
+	}
+
+	bufferPrintf("irqoff: %d critical section sites, %s\r\n", SiteCount, IRQOffTracking ? "tracking" : "stopped");
+
+	// the worst offenders are the ones that kept interrupts off the longest
+	memset(printed, 0, sizeof(printed));
+	for(i = 0; i < maxSites; i++) {
+		int best = -1;
+		for(j = 0; j < IRQOFF_SITES; j++) {
+			if(printed[j] || Sites[j].stat.count == 0)
+				continue;
+
+			if(best < 0 || Sites[j].stat.max > Sites[best].stat.max)
+				best = j;
+		}
+
+		if(best < 0)
+			break;
+
+		printed[best] = TRUE;
+		if(best == 0)
+			bufferPrintf("\t(other): ");
+		else
+			bufferPrintf("\t0x%x: ", (uint32_t) Sites[best].caller);
+		stat_print(&Sites[best].stat);
+	}
+
+	bufferPrintf("handlers:\r\n");
+	for(i = 0; i < VIC_MaxInterrupt; i++) {
+		if(Sources[i].handlerStat.count == 0)
+			continue;
+
+		bufferPrintf("\tirq %d: ", i);
+		stat_print(&Sources[i].handlerStat);
+		if(Sources[i].latency.count != 0) {
+			bufferPrintf("\tirq %d entry latency: ", i);
+			stat_print(&Sources[i].latency);
+		}
+	}
+}
@@ -0,0 +1,133 @@
+#include "openiboot.h"
+#include "latency.h"
+#include "timer.h"
+#include "util.h"
+
+static LatencyHistogram Histograms[LatencyOperationCount];
+
+static const char* OperationNames[LatencyOperationCount] = {
+	"nand_read",
+	"nand_read_multiple",
+	"nand_write",
+	"nand_erase",
+	"VFL_Read",
+	"VFL_Write",
+	"FTL_Read",
+	"FTL_Write",
+	"simple merge",
+	"copy merge",
+	"compact scattered",
+	"bdev read",
+	"bdev write",
+	"nand_write_multiple"
+};
+
+// Allocated on the first iotrace_start, so it costs nothing until it is used.
+static IOTraceEntry* Trace = NULL;
+static int TraceOn = FALSE;
+static uint32_t TraceNext = 0;
+static uint32_t TraceTotal = 0;
+
+void latency_record(LatencyOperation operation, uint32_t address, uint32_t count, uint64_t start) {
+	uint64_t elapsed = timer_get_system_microtime() - start;
+	LatencyHistogram* histogram = &Histograms[operation];
+
+	int bucket = 0;
+	while(bucket < (LATENCY_BUCKETS - 1) && (elapsed >> bucket) != 0)
+		bucket++;
+
+	histogram->count++;
+	histogram->total += elapsed;
+	histogram->buckets[bucket]++;
+	if(elapsed > histogram->max)
+		histogram->max = (elapsed > 0xFFFFFFFF) ? 0xFFFFFFFF : elapsed;
+
+	if(TraceOn) {
+		IOTraceEntry* entry = &Trace[TraceNext];
+		entry->timestamp = (uint32_t) start;
+		entry->operation = operation;
+		entry->count = (count > 0xFFFF) ? 0xFFFF : count;
+		entry->address = address;
+		entry->latency = (elapsed > 0xFFFFFFFF) ? 0xFFFFFFFF : elapsed;
+		TraceNext = (TraceNext + 1) % IOTRACE_ENTRIES;
+		TraceTotal++;
+	}
+}
+
+const LatencyHistogram* latency_get() {
+	return Histograms;
+}
+
+void latency_reset() {
+	memset(Histograms, 0, sizeof(Histograms));
+}
+
+void latency_print() {
+	int i;
+	int j;
+	for(i = 0; i < LatencyOperationCount; i++) {
+		LatencyHistogram* histogram = &Histograms[i];
+		if(histogram->count == 0)
+			continue;
+
+		bufferPrintf("%s: %d calls, average %d us, max %d us\r\n", OperationNames[i], histogram->count,
+				(uint32_t)(histogram->total / histogram->count), histogram->max);
+
+		for(j = 0; j < LATENCY_BUCKETS; j++) {
+			if(histogram->buckets[j] == 0)
+				continue;
+
+			if(j == 0)
+				bufferPrintf("\t< 1 us: %d\r\n", histogram->buckets[j]);
+			else if(j == (LATENCY_BUCKETS - 1))
+				bufferPrintf("\t>= %d us: %d\r\n", 1 << (j - 1), histogram->buckets[j]);
+			else
+				bufferPrintf("\t< %d us: %d\r\n", 1 << j, histogram->buckets[j]);
+		}
+	}
+}
+
+int iotrace_start() {
+	if(Trace == NULL) {
+		Trace = (IOTraceEntry*) malloc(sizeof(IOTraceEntry) * IOTRACE_ENTRIES);
+		if(Trace == NULL)
+			return -1;
+	}
+
+	TraceOn = TRUE;
+	return 0;
+}
+
+void iotrace_stop() {
+	TraceOn = FALSE;
+}
+
+int iotrace_enabled() {
+	return TraceOn;
+}
+
+void iotrace_clear() {
+	TraceNext = 0;
+	TraceTotal = 0;
+}
+
+uint32_t iotrace_dropped() {
+	return (TraceTotal > IOTRACE_ENTRIES) ? (TraceTotal - IOTRACE_ENTRIES) : 0;
+}
+
+int iotrace_read(IOTraceEntry* entries, int maxEntries) {
+	if(Trace == NULL)
+		return 0;
+
+	uint32_t held = (TraceTotal > IOTRACE_ENTRIES) ? IOTRACE_ENTRIES : TraceTotal;
+	uint32_t first = (TraceNext + IOTRACE_ENTRIES - held) % IOTRACE_ENTRIES;
+	int i;
+
+	if(maxEntries > held)
+		maxEntries = held;
+
+	for(i = 0; i < maxEntries; i++)
+		memcpy(&entries[i], &Trace[(first + i) % IOTRACE_ENTRIES], sizeof(IOTraceEntry));
+
+	return maxEntries;
+}
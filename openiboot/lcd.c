@@ -12,9 +12,11 @@
 #include "timer.h"
 #include "pmu.h"
 #include "nvram.h"
+#include "actions.h"
 
 static int lcd_has_init = FALSE;
 static int lcd_init_attempted = FALSE;
+static int lcd_display_up = FALSE;
 
 const static LCDInfo optC = {FrequencyBaseDisplay, 10800000, 320, 15, 15, 16, 480, 4, 4, 4, 1, 0, 0, 0, 0};
 static LCDInfo curTimings;
@@ -149,6 +151,11 @@ static void setWindowBuffer(int window, uint32_t* buffer);
 static void configWindow(int window, int option28, int option16, int option12, int option0);
 static void configLCD(int option20, int option24, int option16);
 static void configureLCDClock(LCDInfo* info);
+static uint32_t vidcon1(LCDInfo* info);
+static uint32_t vidtcon0(LCDInfo* info);
+static uint32_t vidtcon1(LCDInfo* info);
+static uint32_t vidtcon2(LCDInfo* info);
+static int adoptLCD(LCDInfo* info);
 static void configureClockCON0(int OTFClockDivisor, int clockSource, int option4);
 
 static Window* createWindow(int zero0, int zero1, int width, int height, ColorSpace colorSpace);
@@ -164,12 +171,13 @@ static void vline_rgb888(Framebuffer* framebuffer, int start, int line_no, int l
 static void vline_rgb565(Framebuffer* framebuffer, int start, int line_no, int length, int fill);
 
 static void setCommandMode(OnOff swt);
+static void panelTransaction(SPITransaction* transaction, int cs, const uint8_t* command, int commandLen, uint8_t* in, int inLen);
 static void transmitCommandOnSPI0(int command, int subcommand);
 static void transmitCommandOnSPI1(int command, int subcommand);
 static void setPanelRegister(int command, int subcommand);
 static void transmitShortCommandOnSPI1(int command);
 static void resetLCD();
-static void enterRegisterMode();
+static int enterRegisterMode();
 static int getPanelRegister(int status_id);
 static void togglePixelClock(OnOff swt);
 static void displayPanelInfo(uint8_t* panelID);
@@ -179,15 +187,32 @@ static void installGammaTable(int tableNo, uint8_t* table);
 
 static void syrah_quiesce();
 
+// keep the pixel clock where it was when the source it divides changes
+static void lcd_clock_changed(void* opaque) {
+	LCDInfo* info = &curTimings;
+
+	if(info->freqBase != FrequencyBaseBus && info->freqBase != FrequencyBaseDisplay)
+		return;
+
+	info->OTFClockDivisor = clock_get_frequency(info->freqBase) / info->pixelsPerSecond;
+
+	SET_REG(LCD + VIDCON0,
+		(GET_REG(LCD + VIDCON0) & ~(VIDCON0_OTFCLOCKDIVISORMASK << VIDCON0_OTFCLOCKDIVISORSHIFT))
+		| (((info->OTFClockDivisor - 1) & VIDCON0_OTFCLOCKDIVISORMASK) << VIDCON0_OTFCLOCKDIVISORSHIFT));
+}
+
 int lcd_setup() {
 	int backlightLevel = 0;
 
-	NextFramebuffer = 0x0fd00000;
+	NextFramebuffer = LCDFramebufferStart;
 	numWindows = 2;
 
 	if(!lcd_has_init) {
 		if(!lcd_init_attempted) {
 			if(initDisplay() == 0) {
+				lcd_display_up = TRUE;
+				clock_add_change_handler(lcd_clock_changed, NULL);
+
 				const char* envBL = nvram_getvar("backlight-level");
 				if(envBL) {
 					backlightLevel = parseNumber(envBL);
@@ -214,6 +239,10 @@ int lcd_setup() {
 	return 0;
 }
 
+int lcd_running() {
+	return lcd_display_up && (GET_REG(LCD + VIDCON0) & VIDCON0_ENVID_F);
+}
+
 void lcd_shutdown() {
 	lcd_fill(0x000000);
 	udelay(40000);
@@ -236,7 +265,29 @@ static int initDisplay() {
 	clock_gate_switch(LCD_CLOCKGATE1, ON);
 	clock_gate_switch(LCD_CLOCKGATE2, ON);
 
+	// an openiboot chaining to us warm left the panel up with these same
+	// timings, so only the window needs setting up again
+	if(handoff_has(HandoffLCD) && (GET_REG(LCD + VIDCON0) & VIDCON0_ENVID_F)) {
+		LCDPanelID = handoff_get()->panelID;
+		info->OTFClockDivisor = clock_get_frequency(info->freqBase) / info->pixelsPerSecond;
+
+		// what syrah_init would have left for syrah_quiesce
+		spi_set_baud(1, 1000000, SPIOption13Setting0, 1, 1, 1);
+		spi_set_baud(0, 500000, SPIOption13Setting0, 1, 0, 0);
+
+		currentWindow = createWindow(0, 0, info->width, info->height, RGB565);
+		if(currentWindow == NULL)
+			return -1;
+
+		framebuffer_fill(&currentWindow->framebuffer, 0, 0, currentWindow->framebuffer.width, currentWindow->framebuffer.height, 0x0);
+		bufferPrintf("lcd: taken over from the previous openiboot\r\n");
+		return 0;
+	}
+
 	if(GET_REG(LCD + VIDCON0) & VIDCON0_ENVID_F) {
+		if(adoptLCD(info) == 0)
+			return 0;
+
 		syrah_quiesce();
 	}
 
@@ -263,6 +314,49 @@ static int initDisplay() {
 	return 0;
 }
 
+// iBoot leaves the panel lit for its logo. If the controller is running the
+// timings we would have set anyway and the panel answers, it is kept as it
+// is, gamma tables included, and only the window is set up again.
+static int adoptLCD(LCDInfo* info) {
+	int clockSource = (info->freqBase == FrequencyBaseBus) ? VIDCON0_BUSCLOCK : VIDCON0_DISPLAYCLOCK;
+
+	// the rest of VIDCON1 is the line counter and sync status
+	uint32_t polarities = (1 << VIDCON1_IVCLKSHIFT) | (1 << VIDCON1_IHSYNCSHIFT) | (1 << VIDCON1_IVSYNCSHIFT) | (1 << VIDCON1_IVDENSHIFT);
+
+	if(GET_REG(LCD + VIDTCON0) != vidtcon0(info) || GET_REG(LCD + VIDTCON1) != vidtcon1(info)
+			|| GET_REG(LCD + VIDTCON2) != vidtcon2(info) || (GET_REG(LCD + VIDCON1) & polarities) != vidcon1(info)
+			|| ((GET_REG(LCD + VIDCON0) >> VIDCON0_CLOCKSHIFT) & VIDCON0_CLOCKMASK) != clockSource)
+		return -1;
+
+	spi_set_baud(1, 1000000, SPIOption13Setting0, 1, 1, 1);
+	spi_set_baud(0, 500000, SPIOption13Setting0, 1, 0, 0);
+
+	if(enterRegisterMode() != 0)
+		return -1;
+
+	uint8_t panelID[3];
+	panelID[0] = getPanelRegister(0x5A);
+	panelID[1] = getPanelRegister(0x5B);
+	panelID[2] = getPanelRegister(0x5C);
+	if(panelID[1] == 0 || panelID[1] == 0x80 || panelID[1] == 0xFF)
+		return -1;
+
+	displayPanelInfo(panelID);
+	LCDPanelID = (panelID[0] << 16) | (panelID[1] << 8) | panelID[2];
+
+	// the clocks may have moved since iBoot set the divisor
+	info->OTFClockDivisor = clock_get_frequency(info->freqBase) / info->pixelsPerSecond;
+	configureClockCON0(info->OTFClockDivisor, clockSource, 0);
+
+	currentWindow = createWindow(0, 0, info->width, info->height, RGB565);
+	if(currentWindow == NULL)
+		return -1;
+
+	framebuffer_fill(&currentWindow->framebuffer, 0, 0, currentWindow->framebuffer.width, currentWindow->framebuffer.height, 0x0);
+	bufferPrintf("lcd: taken over from iBoot\r\n");
+	return 0;
+}
+
 static void installGammaTables(uint32_t panelID) {
 	const GammaTableDescriptor* curTable = gammaTables;
 
@@ -403,8 +497,10 @@ static Window* createWindow(int zero0, int zero1, int width, int height, ColorSp
 
 	uint32_t currentFramebuffer = NextFramebuffer;
 
+	// twice the size we need, the console scrolls by moving the window
+	// down into the second half
 	NextFramebuffer = (currentFramebuffer
-		+ (lineBytes * height)	// size we need
+		+ (lineBytes * height * 2)	// size we need
 		+ 0xFFF)		// round up
 		& 0xFFFFF000;		// align
 
@@ -525,6 +621,16 @@ void lcd_window_address(int window, uint32_t framebuffer) {
 	SET_REG(windowBase + 8, framebuffer);
 }
 
+// Waits for the panel to leave the active lines, so that a new window
+// address is picked up between frames. Gives up after about a frame.
+void lcd_wait_vsync() {
+	uint64_t startTime = timer_get_system_microtime();
+	while(GET_VSTATUS(GET_REG(LCD + VIDCON1)) == VSTATUS_ACTIVE) {
+		if(has_elapsed(startTime, 20000))
+			break;
+	}
+}
+
 static void setLayer(int window, int zero0, int zero1) {
 	uint32_t data = zero0 << 16 | zero1;
 	switch(window) {
@@ -698,6 +804,29 @@ static void configLCD(int option20, int option24, int option16) {
 
 }
 
+static uint32_t vidcon1(LCDInfo* info) {
+	return ((info->IVClk ? 1 : 0) << VIDCON1_IVCLKSHIFT)
+		| ((info->IHSync ? 1 : 0) << VIDCON1_IHSYNCSHIFT)
+		| ((info->IVSync ? 1 : 0) << VIDCON1_IVSYNCSHIFT)
+		| ((info->IVDen ? 1 : 0) << VIDCON1_IVDENSHIFT);
+}
+
+static uint32_t vidtcon0(LCDInfo* info) {
+	return (((info->verticalBackPorch - 1) & VIDTCON_BACKPORCHMASK) << VIDTCON_BACKPORCHSHIFT)
+		| (((info->verticalFrontPorch - 1) & VIDTCON_FRONTPORCHMASK) << VIDTCON_FRONTPORCHSHIFT)
+		| (((info->verticalSyncPulseWidth - 1) & VIDTCON_SYNCPULSEWIDTHMASK) << VIDTCON_SYNCPULSEWIDTHSHIFT);
+}
+
+static uint32_t vidtcon1(LCDInfo* info) {
+	return (((info->horizontalBackPorch - 1) & VIDTCON_BACKPORCHMASK) << VIDTCON_BACKPORCHSHIFT)
+		| (((info->horizontalFrontPorch - 1) & VIDTCON_FRONTPORCHMASK) << VIDTCON_FRONTPORCHSHIFT)
+		| (((info->horizontalSyncPulseWidth - 1) & VIDTCON_SYNCPULSEWIDTHMASK) << VIDTCON_SYNCPULSEWIDTHSHIFT);
+}
+
+static uint32_t vidtcon2(LCDInfo* info) {
+	return (((info->width - 1) & VIDTCON2_HOZVALMASK) << VIDTCON2_HOZVALSHIFT) | (((info->height - 1) & VIDTCON2_LINEVALMASK) << VIDTCON2_LINEVALSHIFT);
+}
+
 static void configureLCDClock(LCDInfo* info) {
 	int clockSource;
 	if(info->freqBase == FrequencyBaseBus) {
@@ -718,27 +847,16 @@ static void configureLCDClock(LCDInfo* info) {
 
 	uint32_t framesPer1000Second = ((uint64_t)frequency * (uint64_t)1000000)/info->OTFClockDivisor/pixelsPerFrame/1000;
 
-	SET_REG(LCD + VIDCON1,
-		((info->IVClk ? 1 : 0) << VIDCON1_IVCLKSHIFT)
-		| ((info->IHSync ? 1 : 0) << VIDCON1_IHSYNCSHIFT)
-		| ((info->IVSync ? 1 : 0) << VIDCON1_IVSYNCSHIFT)
-		| ((info->IVDen ? 1 : 0) << VIDCON1_IVDENSHIFT));
+	SET_REG(LCD + VIDCON1, vidcon1(info));
 
 	SET_REG(LCD + VIDTCON3, 1);
 
-	SET_REG(LCD + VIDTCON0,
-		(((info->verticalBackPorch - 1) & VIDTCON_BACKPORCHMASK) << VIDTCON_BACKPORCHSHIFT)
-		| (((info->verticalFrontPorch - 1) & VIDTCON_FRONTPORCHMASK) << VIDTCON_FRONTPORCHSHIFT)
-		| (((info->verticalSyncPulseWidth - 1) & VIDTCON_SYNCPULSEWIDTHMASK) << VIDTCON_SYNCPULSEWIDTHSHIFT));
-
-	SET_REG(LCD + VIDTCON1,
-		(((info->horizontalBackPorch - 1) & VIDTCON_BACKPORCHMASK) << VIDTCON_BACKPORCHSHIFT)
-		| (((info->horizontalFrontPorch - 1) & VIDTCON_FRONTPORCHMASK) << VIDTCON_FRONTPORCHSHIFT)
-		| (((info->horizontalSyncPulseWidth - 1) & VIDTCON_SYNCPULSEWIDTHMASK) << VIDTCON_SYNCPULSEWIDTHSHIFT));
+	SET_REG(LCD + VIDTCON0, vidtcon0(info));
+	SET_REG(LCD + VIDTCON1, vidtcon1(info));
 
 	configureClockCON0(info->OTFClockDivisor, clockSource, 0);
 
-	SET_REG(LCD + VIDTCON2, (((info->width - 1) & VIDTCON2_HOZVALMASK) << VIDTCON2_HOZVALSHIFT) | (((info->height - 1) & VIDTCON2_LINEVALMASK) << VIDTCON2_LINEVALSHIFT));
+	SET_REG(LCD + VIDTCON2, vidtcon2(info));
 
 	bufferPrintf("fps set to: %d.%03d\r\n", framesPer1000Second / 1000, framesPer1000Second % 1000);
 }
@@ -828,28 +946,23 @@ static int syrah_init() {
 	transmitCommandOnSPI1(0x36, 0x8);
 	udelay(30000);
 
-	uint8_t lcdCommand[2];
+	uint8_t lcdCommand[3];
 	uint8_t panelID[3];
 
 	memset(panelID, 0, 3);
 
+	// all three reads go out back to back
+	SPITransaction readID[3];
 	lcdCommand[0] = 0xDA;
-	gpio_pin_output(LCD_PANEL_CS, 0);
-	spi_tx(LCD_PANEL_SPI, lcdCommand, 1, TRUE, 0);
-	spi_rx(LCD_PANEL_SPI, &panelID[0], 1, TRUE, 0);
-	gpio_pin_output(LCD_PANEL_CS, 1);
-
-	lcdCommand[0] = 0xDB;
-	gpio_pin_output(LCD_PANEL_CS, 0);
-	spi_tx(LCD_PANEL_SPI, lcdCommand, 1, TRUE, 0);
-	spi_rx(LCD_PANEL_SPI, &panelID[1], 1, TRUE, 0);
-	gpio_pin_output(LCD_PANEL_CS, 1);
-
-	lcdCommand[0] = 0xDC;
-	gpio_pin_output(LCD_PANEL_CS, 0);
-	spi_tx(LCD_PANEL_SPI, lcdCommand, 1, TRUE, 0);
-	spi_rx(LCD_PANEL_SPI, &panelID[2], 1, TRUE, 0);
-	gpio_pin_output(LCD_PANEL_CS, 1);
+	lcdCommand[1] = 0xDB;
+	lcdCommand[2] = 0xDC;
+
+	int i;
+	for(i = 0; i < 3; i++) {
+		panelTransaction(&readID[i], LCD_PANEL_CS, &lcdCommand[i], 1, &panelID[i], 1);
+		spi_submit(LCD_PANEL_SPI, &readID[i]);
+	}
+	spi_transaction_wait(LCD_PANEL_SPI, &readID[2], 10000);
 
 	if((panelID[2] & 0x7) == 1 || (panelID[2] & 0x7) == 3) {
 		panelID[2] |= 0x8;
@@ -1101,7 +1214,7 @@ static void setCommandMode(OnOff swt) {
 	}
 }
 
-static void enterRegisterMode() {
+static int enterRegisterMode() {
 	int tries = 0;
 	int status;
 
@@ -1112,63 +1225,75 @@ static void enterRegisterMode() {
 
 		if(tries >= 20000) {
 			bufferPrintf("enter register mode timeout %x\r\n", status);
-			break;
+			return -1;
 		}
 	} while((status & 0x1) != 1);
+
+	return 0;
+}
+
+// A command, then inLen bytes read back, with cs held low throughout
+static void panelTransaction(SPITransaction* transaction, int cs, const uint8_t* command, int commandLen, uint8_t* in, int inLen) {
+	memset(transaction, 0, sizeof(SPITransaction));
+	transaction->cs = cs;
+	transaction->command = command;
+	transaction->commandLen = commandLen;
+	transaction->direction = (inLen > 0) ? SPIDataIn : SPIDataNone;
+	transaction->in = in;
+	transaction->dataLen = inLen;
 }
 
 static void transmitCommandOnSPI0(int command, int subcommand) {
+	SPITransaction transaction;
 	uint8_t lcdCommand[2];
 	lcdCommand[0] = command;
 	lcdCommand[1] = subcommand;
 
 	gpio_custom_io(LCD_GPIO_CONTROL_ENABLE, 0x2 | 1);
-	gpio_pin_output(LCD_CS, 0);
-	spi_tx(LCD_SPI, lcdCommand, 2, TRUE, 0);
-	gpio_pin_output(LCD_CS, 1);
+	panelTransaction(&transaction, LCD_CS, lcdCommand, 2, NULL, 0);
+	spi_transaction(LCD_SPI, &transaction);
 	gpio_custom_io(LCD_GPIO_CONTROL_ENABLE, 0x2 | 0);
 
 }
 
 static void transmitCommandOnSPI1(int command, int subcommand) {
+	SPITransaction transaction;
 	uint8_t lcdCommand[2];
 	lcdCommand[0] = command;
 	lcdCommand[1] = subcommand;
 
-	gpio_pin_output(LCD_PANEL_CS, 0);
-	spi_tx(LCD_PANEL_SPI, lcdCommand, 2, TRUE, 0);
-	gpio_pin_output(LCD_PANEL_CS, 1);
+	panelTransaction(&transaction, LCD_PANEL_CS, lcdCommand, 2, NULL, 0);
+	spi_transaction(LCD_PANEL_SPI, &transaction);
 }
 
 static void setPanelRegister(int reg, int value) {
+	SPITransaction transaction;
 	uint8_t lcdCommand[2];
 	lcdCommand[0] = reg & 0x7F;
 	lcdCommand[1] = value;
 
-	gpio_pin_output(LCD_PANEL_CS, 0);
-	spi_tx(LCD_PANEL_SPI, lcdCommand, 2, TRUE, 0);
-	gpio_pin_output(LCD_PANEL_CS, 1);
+	panelTransaction(&transaction, LCD_PANEL_CS, lcdCommand, 2, NULL, 0);
+	spi_transaction(LCD_PANEL_SPI, &transaction);
 }
 
 
 static void transmitShortCommandOnSPI1(int command) {
+	SPITransaction transaction;
 	uint8_t lcdCommand[1];
 	lcdCommand[0] = command;
 
-	gpio_pin_output(LCD_PANEL_CS, 0);
-	spi_tx(LCD_PANEL_SPI, lcdCommand, 1, TRUE, 0);
-	gpio_pin_output(LCD_PANEL_CS, 1);
+	panelTransaction(&transaction, LCD_PANEL_CS, lcdCommand, 1, NULL, 0);
+	spi_transaction(LCD_PANEL_SPI, &transaction);
 }
 
 static int getPanelRegister(int reg) {
+	SPITransaction transaction;
 	uint8_t lcdCommand[1];
 	uint8_t buffer[1];
 	lcdCommand[0] = 0x80 | reg;
 
-	gpio_pin_output(LCD_PANEL_CS, 0);
-	spi_tx(LCD_PANEL_SPI, lcdCommand, 1, TRUE, 0);
-	spi_rx(LCD_PANEL_SPI, buffer, 1, TRUE, 0);
-	gpio_pin_output(LCD_PANEL_CS, 1);
+	panelTransaction(&transaction, LCD_PANEL_CS, lcdCommand, 1, buffer, 1);
+	spi_transaction(LCD_PANEL_SPI, &transaction);
 
 	return buffer[0];
 }
@@ -1189,6 +1314,16 @@ static void syrah_quiesce() {
 	setPanelRegister(0x7B, 0x0);
 }
 
+#ifdef __arm__
+// ARM mode STM loop in framebuffer-blend.S
+void FillWords(uint32_t* dst, uint32_t value, int count);
+#else
+static void FillWords(uint32_t* dst, uint32_t value, int count) {
+	while(count-- > 0)
+		*dst++ = value;
+}
+#endif
+
 static void framebuffer_fill(Framebuffer* framebuffer, int x, int y, int width, int height, int fill) {
 	if(x >= framebuffer->width)
 		return;
@@ -1207,23 +1342,25 @@ static void framebuffer_fill(Framebuffer* framebuffer, int x, int y, int width,
 		maxLine = y + height;
 	}
 
+	// whole lines follow each other, so they go as one run
+	if(x == 0 && width == framebuffer->width) {
+		framebuffer->hline(framebuffer, 0, y, framebuffer->lineWidth * (maxLine - y), fill);
+		return;
+	}
+
 	int line;
-	for(line = y; line < height; line++) {
+	for(line = y; line < maxLine; line++) {
 		framebuffer->hline(framebuffer, x, line, width, fill);
 	}
 }
 
 static void hline_rgb888(Framebuffer* framebuffer, int start, int line_no, int length, int fill) {
-	int i;
 	volatile uint32_t* line;
 
 	fill = fill & 0xffffff;	// no alpha
 	line = &framebuffer->buffer[line_no * framebuffer->lineWidth];
 
-	int stop = start + length;
-	for(i = start; i < stop; i++) {
-		line[i] = fill;
-	}
+	FillWords((uint32_t*) &line[start], fill, length);
 }
 
 static void vline_rgb888(Framebuffer* framebuffer, int start, int line_no, int length, int fill) {
@@ -1240,17 +1377,25 @@ static void vline_rgb888(Framebuffer* framebuffer, int start, int line_no, int l
 }
 
 static void hline_rgb565(Framebuffer* framebuffer, int start, int line_no, int length, int fill) {
-	int i;
 	volatile uint16_t* line;
 	uint16_t fill565;
 
 	fill565= ((((fill >> 16) & 0xFF) >> 3) << 11) | ((((fill >> 8) & 0xFF) >> 2) << 5) | ((fill & 0xFF) >> 3);
-	line = &((uint16_t*)framebuffer->buffer)[line_no * framebuffer->lineWidth];
+	line = &((uint16_t*)framebuffer->buffer)[line_no * framebuffer->lineWidth + start];
 
-	int stop = start + length;
-	for(i = start; i < stop; i++) {
-		line[i] = fill565;
+	if(length <= 0)
+		return;
+
+	// two pixels to a word, with the odd ones at either end on their own
+	if(((uint32_t) line) & 2) {
+		*line++ = fill565;
+		length--;
 	}
+
+	FillWords((uint32_t*) line, fill565 | (fill565 << 16), length / 2);
+
+	if(length & 1)
+		line[length - 1] = fill565;
 }
 
 static void vline_rgb565(Framebuffer* framebuffer, int start, int line_no, int length, int fill) {
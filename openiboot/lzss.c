@@ -0,0 +1,79 @@
+#include "openiboot.h"
+#include "lzss.h"
+#include "util.h"
+
+void lzss_stream_init(LZSSStream* stream, void* dst, uint32_t dstLen) {
+	stream->start = stream->out = (uint8_t*) dst;
+	stream->end = stream->start + dstLen;
+	stream->flags = 0;
+	stream->havePending = FALSE;
+}
+
+int lzss_stream_feed(LZSSStream* stream, const uint8_t* src, uint32_t len) {
+	const uint8_t* srcEnd = src + len;
+	uint8_t* out = stream->out;
+	uint32_t flags = stream->flags;
+	int ret = 0;
+
+	while(src < srcEnd) {
+		if(stream->havePending) {
+			uint32_t i = stream->pending | ((*src & 0xF0) << 4);
+			uint32_t count = (*src & 0x0F) + LZSS_THRESHOLD + 1;
+			src++;
+			stream->havePending = FALSE;
+			flags >>= 1;
+
+			if(count > (stream->end - out)) {
+				ret = -1;
+				break;
+			}
+
+			// ring position i was last written this far back
+			uint32_t r = (LZSS_N - LZSS_F + (out - stream->start)) & (LZSS_N - 1);
+			const uint8_t* from = out - (((r - i - 1) & (LZSS_N - 1)) + 1);
+			while(count-- > 0) {
+				*out++ = (from < stream->start) ? ' ' : *from;
+				from++;
+			}
+			continue;
+		}
+
+		if((flags & 0x100) == 0) {
+			flags = *src++ | 0xFF00;
+			continue;
+		}
+
+		if(flags & 1) {
+			if(out >= stream->end) {
+				ret = -1;
+				break;
+			}
+			*out++ = *src++;
+			flags >>= 1;
+		} else {
+			stream->pending = *src++;
+			stream->havePending = TRUE;
+		}
+	}
+
+	stream->out = out;
+	stream->flags = flags;
+	return ret;
+}
+
+uint32_t lzss_stream_length(LZSSStream* stream) {
+	return stream->out - stream->start;
+}
+
+static uint32_t be32(uint32_t x) {
+	return (x << 24) | ((x & 0xFF00) << 8) | ((x >> 8) & 0xFF00) | (x >> 24);
+}
+
+int lzss_comp_check(const LZSSCompHeader* header, uint32_t* compressedLength, uint32_t* checksum) {
+	if(be32(header->signature) != LZSS_COMP_SIGNATURE || be32(header->compressionType) != LZSS_SIGNATURE)
+		return -1;
+
+	*compressedLength = be32(header->lengthCompressed);
+	*checksum = be32(header->checksum);
+	return be32(header->lengthUncompressed);
+}
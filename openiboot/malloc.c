@@ -4,6 +4,7 @@
 #include "timer.h"
 #include "wdt.h"
 #include "openiboot-asmhelpers.h"
+#include "heapprof.h"
 
 #define HAVE_MMAP 0
 #define MALLOC_FAILURE_ACTION { printf("malloc failed!\r\n"); }
@@ -17,8 +18,23 @@
 #define LACKS_ERRNO_H
 #define LACKS_STDLIB_H
 #define LACKS_SYS_TYPES_H
+#define LACKS_TIME_H
 #define USE_LOCKS 1
 
+// Separate arenas for DMA buffers and for boot-time allocations, see the
+// end of this file. With FOOTERS every chunk knows its arena, so free and
+// realloc work on all of them. The footer magic is seeded from the timer.
+#define MSPACES 1
+#define FOOTERS 1
+#define time(t) ((size_t) timer_get_system_microtime())
+
+// Allocations are reported to the heap profiler, charged to whoever called
+// into the allocator. calloc, realloc and memalign allocate through malloc,
+// which must not record the allocation a second time.
+static int ProfileNested = 0;
+#define PROFILE_ALLOC(mem, bytes) if(HeapProfiling && !ProfileNested) heapprof_alloc((mem), (bytes), __builtin_return_address(0))
+#define PROFILE_FREE(mem) if(HeapProfiling) heapprof_free(mem)
+
 static void* CurBreakValue = NULL;
 
 extern char _end;
@@ -1189,7 +1205,7 @@ int mspace_mallopt(int, int);
 #ifndef LACKS_ERRNO_H
 #include <errno.h>       /* for MALLOC_FAILURE_ACTION */
 #endif /* LACKS_ERRNO_H */
-#if FOOTERS
+#if FOOTERS && !defined(LACKS_TIME_H)
 #include <time.h>        /* for magic initialization */
 #endif /* FOOTERS */
 #ifndef LACKS_STDLIB_H
@@ -1321,7 +1337,7 @@ int mspace_mallopt(int, int);
 #define IS_MMAPPED_BIT       (SIZE_T_ZERO)
 #define USE_MMAP_BIT         (SIZE_T_ZERO)
 #define CALL_MMAP(s)         MFAIL
-#define CALL_MUNMAP(a, s)    (-1)
+#define CALL_MUNMAP(a, s)    ((void)(a), -1)
 #define DIRECT_MMAP(s)       MFAIL
 
 #else /* HAVE_MMAP */
@@ -4197,6 +4213,7 @@ void* dlmalloc(size_t bytes) {
 
   postaction:
     POSTACTION(gm);
+    PROFILE_ALLOC(mem, bytes);
     return mem;
   }
 
@@ -4210,6 +4227,8 @@ void dlfree(void* mem) {
      with special cases for top, dv, mmapped chunks, and usage errors.
   */
 
+  PROFILE_FREE(mem);
+
   if (mem != 0) {
     mchunkptr p  = mem2chunk(mem);
 #if FOOTERS
@@ -4312,15 +4331,24 @@ void* dlcalloc(size_t n_elements, size_t elem_size) {
         (req / n_elements != elem_size))
       req = MAX_SIZE_T; /* force downstream failure on overflow */
   }
+  ProfileNested++;
   mem = dlmalloc(req);
+  ProfileNested--;
   if (mem != 0 && calloc_must_clear(mem2chunk(mem)))
     memset(mem, 0, req);
+  PROFILE_ALLOC(mem, req);
   return mem;
 }
 
 void* dlrealloc(void* oldmem, size_t bytes) {
-  if (oldmem == 0)
-    return dlmalloc(bytes);
+  void* mem;
+  if (oldmem == 0) {
+    ProfileNested++;
+    mem = dlmalloc(bytes);
+    ProfileNested--;
+    PROFILE_ALLOC(mem, bytes);
+    return mem;
+  }
 #ifdef REALLOC_ZERO_BYTES_FREES
   if (bytes == 0) {
     dlfree(oldmem);
@@ -4337,12 +4365,24 @@ void* dlrealloc(void* oldmem, size_t bytes) {
       return 0;
     }
 #endif /* FOOTERS */
-    return internal_realloc(m, oldmem, bytes);
+    ProfileNested++;
+    mem = internal_realloc(m, oldmem, bytes);
+    ProfileNested--;
+    if (mem != 0) {
+      PROFILE_FREE(oldmem);
+      PROFILE_ALLOC(mem, bytes);
+    }
+    return mem;
   }
 }
 
 void* dlmemalign(size_t alignment, size_t bytes) {
-  return internal_memalign(gm, alignment, bytes);
+  void* mem;
+  ProfileNested++;
+  mem = internal_memalign(gm, alignment, bytes);
+  ProfileNested--;
+  PROFILE_ALLOC(mem, bytes);
+  return mem;
 }
 
 void** dlindependent_calloc(size_t n_elements, size_t elem_size,
@@ -4838,6 +4878,87 @@ int mspace_mallopt(int param_number, int value) {
 
 #endif /* MSPACES */
 
+/* -------------------------- openiboot arenas --------------------------- */
+
+// Page buffers handed to the NAND and DMA controllers come from their own
+// mspace, aligned and padded to DMA_ALIGN, so they neither share cache lines
+// with unrelated data nor fragment the general heap. The arena starts with
+// DMA_ARENA_INITIAL bytes of its own and grows through sbrk like the heap.
+
+#ifndef DMA_ARENA_INITIAL
+#define DMA_ARENA_INITIAL (1024 * 1024)
+#endif
+
+static mspace DMAArena = NULL;
+
+void* malloc_dma(size_t size) {
+	void* mem;
+
+	size = (size + DMA_ALIGN - 1) & ~(DMA_ALIGN - 1);
+
+	if(DMAArena == NULL) {
+		void* base = sbrk(DMA_ARENA_INITIAL);
+		DMAArena = create_mspace_with_base(base, DMA_ARENA_INITIAL, USE_LOCKS);
+	}
+
+	ProfileNested++;
+	if(DMAArena == NULL)
+		mem = dlmemalign(DMA_ALIGN, size);
+	else
+		mem = mspace_memalign(DMAArena, DMA_ALIGN, size);
+	ProfileNested--;
+
+	PROFILE_ALLOC(mem, size);
+	return mem;
+}
+
+// Boot-time allocations (the menu's images and the like) are carved out of
+// large chunks of the general heap and all given back by free_boot_arena.
+// They cannot be freed one by one.
+
+#ifndef BOOT_ARENA_CHUNK
+#define BOOT_ARENA_CHUNK (256 * 1024)
+#endif
+
+typedef struct BootArenaChunk {
+	struct BootArenaChunk* next;
+	size_t used;
+	size_t size;
+} BootArenaChunk;
+
+static BootArenaChunk* BootArena = NULL;
+
+void* malloc_boot(size_t size) {
+	size_t header = (sizeof(BootArenaChunk) + 7) & ~7;
+	void* ret;
+
+	size = (size + 7) & ~7;
+
+	if(BootArena == NULL || (BootArena->used + size) > BootArena->size) {
+		size_t chunkSize = ((header + size) > BOOT_ARENA_CHUNK) ? (header + size) : BOOT_ARENA_CHUNK;
+		BootArenaChunk* chunk = (BootArenaChunk*) dlmalloc(chunkSize);
+		if(chunk == NULL)
+			return NULL;
+
+		chunk->next = BootArena;
+		chunk->used = header;
+		chunk->size = chunkSize;
+		BootArena = chunk;
+	}
+
+	ret = (uint8_t*) BootArena + BootArena->used;
+	BootArena->used += size;
+	return ret;
+}
+
+void free_boot_arena() {
+	while(BootArena != NULL) {
+		BootArenaChunk* next = BootArena->next;
+		dlfree(BootArena);
+		BootArena = next;
+	}
+}
+
 /* -------------------- Alternative MORECORE functions ------------------- */
 
 /*
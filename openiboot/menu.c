@@ -7,22 +7,26 @@
 #include "framebuffer.h"
 #include "buttons.h"
 #include "timer.h"
-#include "images/ConsolePNG.h"
-#include "images/iPhoneOSPNG.h"
-#include "images/AndroidOSPNG.h"
-#include "images/ConsoleSelectedPNG.h"
-#include "images/iPhoneOSSelectedPNG.h"
-#include "images/AndroidOSSelectedPNG.h"
-#include "images/HeaderPNG.h"
+#include "clock.h"
+#include "bootprof.h"
+#include "dma.h"
+#include "images/ConsoleRLE.h"
+#include "images/iPhoneOSRLE.h"
+#include "images/AndroidOSRLE.h"
+#include "images/ConsoleSelectedRLE.h"
+#include "images/iPhoneOSSelectedRLE.h"
+#include "images/AndroidOSSelectedRLE.h"
+#include "images/HeaderRLE.h"
 #include "images.h"
 #include "actions.h"
-#include "stb_image.h"
 #include "pmu.h"
 #include "nand.h"
 #include "radio.h"
 #include "hfs/fs.h"
 #include "ftl.h"
 #include "scripting.h"
+#include "nvram.h"
+#include "tasks.h"
 
 int globalFtlHasBeenRestored = 0; /* global variable to tell wether a ftl_restore has been done*/
 
@@ -30,31 +34,30 @@ static uint32_t FBWidth;
 static uint32_t FBHeight;
 
 
-static uint32_t* imgiPhoneOS;
+static const uint16_t* imgiPhoneOS;
 static int imgiPhoneOSWidth;
 static int imgiPhoneOSHeight;
 static int imgiPhoneOSX;
 static int imgiPhoneOSY;
 
-static uint32_t* imgConsole;
+static const uint16_t* imgConsole;
 static int imgConsoleWidth;
 static int imgConsoleHeight;
 static int imgConsoleX;
 static int imgConsoleY;
 
-static uint32_t* imgAndroidOS;
-static uint32_t* imgAndroidOS_unblended;
+static const uint16_t* imgAndroidOS;
+static void* imgAndroidOSBackground;
 static int imgAndroidOSWidth;
 static int imgAndroidOSHeight;
 static int imgAndroidOSX;
 static int imgAndroidOSY;
 
-static uint32_t* imgiPhoneOSSelected;
-static uint32_t* imgConsoleSelected;
-static uint32_t* imgAndroidOSSelected;
-static uint32_t* imgAndroidOSSelected_unblended;
+static const uint16_t* imgiPhoneOSSelected;
+static const uint16_t* imgConsoleSelected;
+static const uint16_t* imgAndroidOSSelected;
 
-static uint32_t* imgHeader;
+static const uint16_t* imgHeader;
 static int imgHeaderWidth;
 static int imgHeaderHeight;
 static int imgHeaderX;
@@ -68,34 +71,53 @@ typedef enum MenuSelection {
 
 static MenuSelection Selection;
 
-volatile uint32_t* OtherFramebuffer;
+// The menu is double buffered. Each buffer remembers which image of every
+// item it holds, so a redraw only draws what changed since that buffer was
+// last on screen, and the buffers are flipped between frames.
+#define MENU_ITEMS 3
 
-static void drawSelectionBox() {
-	volatile uint32_t* oldFB = CurFramebuffer;
+static volatile uint32_t* MenuBuffers[2];
+static int BackBuffer;
+static int Shown[2][MENU_ITEMS];
 
-	CurFramebuffer = OtherFramebuffer;
-	currentWindow->framebuffer.buffer = CurFramebuffer;
-	OtherFramebuffer = oldFB;
+// The Android images are translucent, so they are drawn over a saved copy
+// of the background rather than over each other.
+static void drawAndroidOS(const uint16_t* image) {
+	framebuffer_restore_rect(imgAndroidOSBackground, imgAndroidOSX, imgAndroidOSY, imgAndroidOSWidth, imgAndroidOSHeight);
+	framebuffer_draw_rle_image(image, imgAndroidOSX, imgAndroidOSY, imgAndroidOSWidth, imgAndroidOSHeight);
+}
 
-	if(Selection == MenuSelectioniPhoneOS) {
-		framebuffer_draw_image(imgiPhoneOSSelected, imgiPhoneOSX, imgiPhoneOSY, imgiPhoneOSWidth, imgiPhoneOSHeight);
-		framebuffer_draw_image(imgConsole, imgConsoleX, imgConsoleY, imgConsoleWidth, imgConsoleHeight);
-		framebuffer_draw_image(imgAndroidOS, imgAndroidOSX, imgAndroidOSY, imgAndroidOSWidth, imgAndroidOSHeight);
+static void drawItem(MenuSelection item, int selected) {
+	switch(item) {
+		case MenuSelectioniPhoneOS:
+			framebuffer_draw_rle_image(selected ? imgiPhoneOSSelected : imgiPhoneOS, imgiPhoneOSX, imgiPhoneOSY, imgiPhoneOSWidth, imgiPhoneOSHeight);
+			break;
+		case MenuSelectionConsole:
+			framebuffer_draw_rle_image(selected ? imgConsoleSelected : imgConsole, imgConsoleX, imgConsoleY, imgConsoleWidth, imgConsoleHeight);
+			break;
+		case MenuSelectionAndroidOS:
+			drawAndroidOS(selected ? imgAndroidOSSelected : imgAndroidOS);
+			break;
 	}
+}
 
-	if(Selection == MenuSelectionConsole) {
-		framebuffer_draw_image(imgiPhoneOS, imgiPhoneOSX, imgiPhoneOSY, imgiPhoneOSWidth, imgiPhoneOSHeight);
-		framebuffer_draw_image(imgConsoleSelected, imgConsoleX, imgConsoleY, imgConsoleWidth, imgConsoleHeight);
-		framebuffer_draw_image(imgAndroidOS, imgAndroidOSX, imgAndroidOSY, imgAndroidOSWidth, imgAndroidOSHeight);
-	}
+static void drawSelectionBox() {
+	int item;
 
-	if(Selection == MenuSelectionAndroidOS) {
-		framebuffer_draw_image(imgiPhoneOS, imgiPhoneOSX, imgiPhoneOSY, imgiPhoneOSWidth, imgiPhoneOSHeight);
-		framebuffer_draw_image(imgConsole, imgConsoleX, imgConsoleY, imgConsoleWidth, imgConsoleHeight);
-		framebuffer_draw_image(imgAndroidOSSelected, imgAndroidOSX, imgAndroidOSY, imgAndroidOSWidth, imgAndroidOSHeight);
+	CurFramebuffer = MenuBuffers[BackBuffer];
+	currentWindow->framebuffer.buffer = CurFramebuffer;
+
+	for(item = 0; item < MENU_ITEMS; item++) {
+		int selected = (item == Selection);
+		if(Shown[BackBuffer][item] != selected) {
+			drawItem(item, selected);
+			Shown[BackBuffer][item] = selected;
+		}
 	}
 
+	lcd_wait_vsync();
 	lcd_window_address(2, (uint32_t) CurFramebuffer);
+	BackBuffer ^= 1;
 }
 
 static void toggle(int forward) {
@@ -120,17 +142,135 @@ static void toggle(int forward) {
 	drawSelectionBox();
 }
 
+// While the menu waits, a task reads ahead what the likely choice boots:
+// the kernel and initrd when that is Android, and iBoot in any case, as it
+// is small. The likely choice is opib-default-os, or else the last one
+// made, kept in opib-last-os. A linux script may change what is booted, so
+// with one set Linux is left to load after the choice.
+#ifndef MENU_PRELOAD_STACK
+#define MENU_PRELOAD_STACK 0x10000
+#endif
+
+// The buttons wake the menu up; without them it still checks the timeout
+// and the clock governor this often.
+#ifndef MENU_IDLE_WAKE
+#define MENU_IDLE_WAKE 100000
+#endif
+
+static const char* MenuSelectionNames[MENU_ITEMS] = {"iphoneos", "console", "android"};
+
+static Completion PreloadDone;
+static int PreloadStarted = FALSE;
+static volatile int PreloadChosen = FALSE;
+static volatile MenuSelection PreloadChoice;
+static void* PreloadedIBoot = NULL;
+static int PreloadedLinux = FALSE;
+
+static int parseSelection(const char* name, MenuSelection* selection) {
+	int i;
+
+	if(name == NULL)
+		return FALSE;
+
+	for(i = 0; i < MENU_ITEMS; i++) {
+		if(strcmp(name, MenuSelectionNames[i]) == 0) {
+			*selection = i;
+			return TRUE;
+		}
+	}
+
+	return FALSE;
+}
+
+static Image* iBootImage() {
+	Image* image = images_get(fourcc("ibox"));
+	if(image == NULL)
+		image = images_get(fourcc("ibot"));
+	return image;
+}
+
+static int linuxScripted() {
+	const char* scriptingLinux = nvram_getvar("scripting-linux");
+	return scriptingLinux && (strcmp(scriptingLinux, "true") == 0 || strcmp(scriptingLinux, "1") == 0);
+}
+
+static void preloadTask(void* opaque) {
+	MenuSelection likely = (MenuSelection) opaque;
+
+	clock_boost_begin();
+
+#ifndef NO_HFS
+	if(likely == MenuSelectionAndroidOS && !linuxScripted()) {
+		bootprof_begin("preload linux");
+		waitForBootStageID(BootStageFS);
+		PreloadedLinux = (load_linux_from_files() == 0);
+		bootprof_end("preload linux", PreloadedLinux);
+	}
+#endif
+
+	// once something else has been chosen, iBoot is of no more use
+	if(!PreloadChosen || PreloadChoice == MenuSelectioniPhoneOS) {
+		Image* image = iBootImage();
+		if(image != NULL) {
+			bootprof_begin("preload iboot");
+			unsigned int size = images_read(image, &PreloadedIBoot);
+			bootprof_end("preload iboot", size);
+		}
+	}
+
+	clock_boost_end();
+	completion_signal(&PreloadDone);
+}
+
+static void preloadStart(MenuSelection likely) {
+	completion_init(&PreloadDone);
+	PreloadStarted = (task_create("preload", preloadTask, (void*) likely, MENU_PRELOAD_STACK) != NULL);
+}
+
+// Lets the task know what has been chosen and waits for it to finish.
+static void preloadFinish(MenuSelection choice) {
+	if(!PreloadStarted)
+		return;
+
+	PreloadChoice = choice;
+	PreloadChosen = TRUE;
+	completion_wait(&PreloadDone, 0xFFFFFFFF);
+
+	if(choice != MenuSelectioniPhoneOS && PreloadedIBoot) {
+		free(PreloadedIBoot);
+		PreloadedIBoot = NULL;
+	}
+}
+
 int menu_setup(int timeout) {
 	FBWidth = currentWindow->framebuffer.width;
 	FBHeight = currentWindow->framebuffer.height;	
 
-	imgiPhoneOS = framebuffer_load_image(dataiPhoneOSPNG, dataiPhoneOSPNG_size, &imgiPhoneOSWidth, &imgiPhoneOSHeight, TRUE);
-	imgiPhoneOSSelected = framebuffer_load_image(dataiPhoneOSSelectedPNG, dataiPhoneOSSelectedPNG_size, &imgiPhoneOSWidth, &imgiPhoneOSHeight, TRUE);
-	imgConsole = framebuffer_load_image(dataConsolePNG, dataConsolePNG_size, &imgConsoleWidth, &imgConsoleHeight, TRUE);
-	imgConsoleSelected = framebuffer_load_image(dataConsoleSelectedPNG, dataConsoleSelectedPNG_size, &imgConsoleWidth, &imgConsoleHeight, TRUE);
-	imgAndroidOS_unblended = framebuffer_load_image(dataAndroidOSPNG, dataAndroidOSPNG_size, &imgAndroidOSWidth, &imgAndroidOSHeight, TRUE);
-	imgAndroidOSSelected_unblended = framebuffer_load_image(dataAndroidOSSelectedPNG, dataAndroidOSSelectedPNG_size, &imgAndroidOSWidth, &imgAndroidOSHeight, TRUE);
-	imgHeader = framebuffer_load_image(dataHeaderPNG, dataHeaderPNG_size, &imgHeaderWidth, &imgHeaderHeight, TRUE);
+	imgiPhoneOS = dataiPhoneOSRLE;
+	imgiPhoneOSSelected = dataiPhoneOSSelectedRLE;
+	imgiPhoneOSWidth = dataiPhoneOSRLE_width;
+	imgiPhoneOSHeight = dataiPhoneOSRLE_height;
+
+	imgConsole = dataConsoleRLE;
+	imgConsoleSelected = dataConsoleSelectedRLE;
+	imgConsoleWidth = dataConsoleRLE_width;
+	imgConsoleHeight = dataConsoleRLE_height;
+
+	imgAndroidOS = dataAndroidOSRLE;
+	imgAndroidOSSelected = dataAndroidOSSelectedRLE;
+	imgAndroidOSWidth = dataAndroidOSRLE_width;
+	imgAndroidOSHeight = dataAndroidOSRLE_height;
+
+	MenuSelection likely = MenuSelectioniPhoneOS;
+	const char* lastChoice = nvram_getvar("opib-last-os");
+	if(!parseSelection(nvram_getvar("opib-default-os"), &likely))
+		parseSelection(lastChoice, &likely);
+
+	preloadStart(likely);
+
+	imgHeader = dataHeaderRLE;
+	imgHeaderWidth = dataHeaderRLE_width;
+	imgHeaderHeight = dataHeaderRLE_height;
 
 	bufferPrintf("menu: images loaded\r\n");
 
@@ -146,7 +286,7 @@ int menu_setup(int timeout) {
 	imgHeaderX = (FBWidth - imgHeaderWidth) / 2;
 	imgHeaderY = 17;
 
-	framebuffer_draw_image(imgHeader, imgHeaderX, imgHeaderY, imgHeaderWidth, imgHeaderHeight);
+	framebuffer_draw_rle_image(imgHeader, imgHeaderX, imgHeaderY, imgHeaderWidth, imgHeaderHeight);
 
 	framebuffer_draw_rect_hgradient(0, 42, 0, 360, FBWidth, (FBHeight - 12) - 360);
 	framebuffer_draw_rect_hgradient(0x22, 0x22, 0, FBHeight - 12, FBWidth, 12);
@@ -157,88 +297,94 @@ int menu_setup(int timeout) {
 	framebuffer_setcolors(COLOR_WHITE, COLOR_BLACK);
 	framebuffer_setloc(0, 0);
 
-	imgAndroidOS = malloc(imgAndroidOSWidth * imgAndroidOSHeight * sizeof(uint32_t));
-	imgAndroidOSSelected = malloc(imgAndroidOSWidth * imgAndroidOSHeight * sizeof(uint32_t));
+	imgAndroidOSBackground = malloc_boot(imgAndroidOSWidth * imgAndroidOSHeight * sizeof(uint32_t));
+	framebuffer_save_rect(imgAndroidOSBackground, imgAndroidOSX, imgAndroidOSY, imgAndroidOSWidth, imgAndroidOSHeight);
 
-	framebuffer_capture_image(imgAndroidOS, imgAndroidOSX, imgAndroidOSY, imgAndroidOSWidth, imgAndroidOSHeight);
-	framebuffer_capture_image(imgAndroidOSSelected, imgAndroidOSX, imgAndroidOSY, imgAndroidOSWidth, imgAndroidOSHeight);
+	Selection = likely;
 
-	framebuffer_blend_image(imgAndroidOS, imgAndroidOSWidth, imgAndroidOSHeight, imgAndroidOS_unblended, imgAndroidOSWidth, imgAndroidOSHeight, 0, 0);
-	framebuffer_blend_image(imgAndroidOSSelected, imgAndroidOSWidth, imgAndroidOSHeight, imgAndroidOSSelected_unblended, imgAndroidOSWidth, imgAndroidOSHeight, 0, 0);
-
-	Selection = MenuSelectioniPhoneOS;
-
-	OtherFramebuffer = CurFramebuffer;
-	CurFramebuffer = (volatile uint32_t*) NextFramebuffer;
+	// both buffers start out with the background and none of the items
+	MenuBuffers[0] = CurFramebuffer;
+	MenuBuffers[1] = (volatile uint32_t*) NextFramebuffer;
+	dma_memcpy((void*) MenuBuffers[1], (void*) MenuBuffers[0], currentWindow->lineBytes * FBHeight);
+	memset(Shown, 0xFF, sizeof(Shown));
+	BackBuffer = 0;
 
 	drawSelectionBox();
 
 	pmu_set_iboot_stage(0);
 
-	memcpy((void*)NextFramebuffer, (void*) CurFramebuffer, NextFramebuffer - (uint32_t)CurFramebuffer);
+	// anything pressed before the menu was up is not meant for it
+	buttons_flush();
 
 	uint64_t startTime = timer_get_system_microtime();
 	while(TRUE) {
-		if(buttons_is_pushed(BUTTONS_HOLD)) {
-			toggle(TRUE);
-			startTime = timer_get_system_microtime();
-			udelay(200000);
-		}
-#ifndef CONFIG_IPOD
-		if(!buttons_is_pushed(BUTTONS_VOLUP)) {
-			toggle(FALSE);
-			startTime = timer_get_system_microtime();
-			udelay(200000);
-		}
-		if(!buttons_is_pushed(BUTTONS_VOLDOWN)) {
-			toggle(TRUE);
+		ButtonEvent event;
+		if(buttons_wait_event(&event, MENU_IDLE_WAKE)) {
+			if(!event.pushed)
+				continue;
+
+			if(event.button == BUTTONS_HOME)
+				break;
+
+			if(event.button == BUTTONS_HOLD || event.button == BUTTONS_VOLDOWN)
+				toggle(TRUE);
+			else if(event.button == BUTTONS_VOLUP)
+				toggle(FALSE);
+
 			startTime = timer_get_system_microtime();
-			udelay(200000);
-		}
-#endif
-		if(buttons_is_pushed(BUTTONS_HOME)) {
-			break;
 		}
 		if(timeout > 0 && has_elapsed(startTime, (uint64_t)timeout * 1000)) {
 			bufferPrintf("menu: timed out, selecting current item\r\n");
 			break;
 		}
-		udelay(10000);
+		clock_governor_idle();
+	}
+
+	clock_boost_begin();
+	bootprof_mark("menu selection", Selection);
+
+	// nothing may be left touching the hardware when booting something else
+	preloadFinish(Selection);
+	waitForBootStages();
+
+	if(lastChoice == NULL || strcmp(lastChoice, MenuSelectionNames[Selection]) != 0) {
+		nvram_setvar("opib-last-os", MenuSelectionNames[Selection]);
+		nvram_save();
 	}
 
 	if(Selection == MenuSelectioniPhoneOS) {
-		Image* image = images_get(fourcc("ibox"));
-		if(image == NULL)
-			image = images_get(fourcc("ibot"));
-		void* imageData;
-		images_read(image, &imageData);
+		void* imageData = PreloadedIBoot;
+		if(imageData == NULL)
+			images_read(iBootImage(), &imageData);
 		chainload((uint32_t)imageData);
 	}
 
 	if(Selection == MenuSelectionConsole) {
 		// Reset framebuffer back to original if necessary
-		if((uint32_t) CurFramebuffer == NextFramebuffer)
+		if(CurFramebuffer != MenuBuffers[0])
 		{
-			CurFramebuffer = OtherFramebuffer;
+			CurFramebuffer = MenuBuffers[0];
 			currentWindow->framebuffer.buffer = CurFramebuffer;
 			lcd_window_address(2, (uint32_t) CurFramebuffer);
 		}
 
 		framebuffer_setdisplaytext(TRUE);
 		framebuffer_clear();
+		free_boot_arena();
 	}
 
 	if(Selection == MenuSelectionAndroidOS) {
 		// Reset framebuffer back to original if necessary
-		if((uint32_t) CurFramebuffer == NextFramebuffer)
+		if(CurFramebuffer != MenuBuffers[0])
 		{
-			CurFramebuffer = OtherFramebuffer;
+			CurFramebuffer = MenuBuffers[0];
 			currentWindow->framebuffer.buffer = CurFramebuffer;
 			lcd_window_address(2, (uint32_t) CurFramebuffer);
 		}
 
 		framebuffer_setdisplaytext(TRUE);
 		framebuffer_clear();
+		free_boot_arena();
 
 #ifndef NO_HFS
 #ifndef CONFIG_IPOD
@@ -260,10 +406,12 @@ int menu_setup(int timeout) {
 
 		pmu_set_iboot_stage(0);
 		startScripting("linux"); //start script mode if there is a script file
-		boot_linux_from_files();
+		boot_linux_from_files(PreloadedLinux);
 #endif
 	}
 
+	clock_boost_end();
+
 	return 0;
 }
 
@@ -1,4 +1,5 @@
 #include "nor_files.h"
+#include "lzss.h"
 #include <stdio.h>
 #include <string.h>
 #define BUFFERSIZE (1024*1024)
@@ -34,15 +35,67 @@ char createImage(char* inElf, size_t inElfSize, char** outImage, size_t* outImag
 	return 1;
 }
 
+// Puts the lzss-stub decompressor in front of the LZSS compressed image.
+// The stub ends with its header: the uncompressed and compressed sizes.
+char compressImage(char* stubElf, size_t stubElfSize, char** image, size_t* imageSize) {
+	char* stub;
+	size_t stubSize;
+
+	if(!createImage(stubElf, stubElfSize, &stub, &stubSize) || stubSize < 8) {
+		return 0;
+	}
+
+	size_t maxSize = stubSize + *imageSize + (*imageSize / 8) + 16;
+	char* out = (char*) malloc(maxSize);
+	memcpy(out, stub, stubSize);
+	free(stub);
+
+	uint8_t* end = compress_lzss((uint8_t*)(out + stubSize), maxSize - stubSize, (uint8_t*) *image, *imageSize);
+	if(end == NULL) {
+		free(out);
+		return 0;
+	}
+
+	uint32_t* header = (uint32_t*)(out + stubSize - 8);
+	header[0] = *imageSize;
+	header[1] = (uint32_t)((char*)end - (out + stubSize));
+
+	printf("compressed %d bytes to %d\n", (int) *imageSize, (int) header[1]);
+
+	free(*image);
+	*image = out;
+	*imageSize = stubSize + header[1];
+	return 1;
+}
+
 int main(int argc, char* argv[]) {
 	char* inElf;
 	size_t inElfSize;
 	char* outImage;
 	size_t outImageSize;
+	char* stubElf = NULL;
+	size_t stubElfSize = 0;
+	const char* name = argv[0];
 	init_libxpwn();
 
+	if(argc >= 3 && strcmp(argv[1], "-z") == 0) {
+		AbstractFile* stubFile = openAbstractFile(createAbstractFileFromFile(fopen(argv[2], "rb")));
+		if(!stubFile) {
+			fprintf(stderr, "error: cannot open decompressor stub\n");
+			return 6;
+		}
+
+		stubElfSize = (size_t) stubFile->getLength(stubFile);
+		stubElf = (char*) malloc(stubElfSize);
+		stubFile->read(stubFile, stubElf, stubElfSize);
+		stubFile->close(stubFile);
+
+		argv += 2;
+		argc -= 2;
+	}
+
 	if(argc < 3) {
-		printf("usage: %s <infile> <outfile> [template] [certificate]\n", argv[0]);
+		printf("usage: %s [-z <stub>] <infile> <outfile> [template] [certificate]\n", argv[0]);
 		return 0;
 	}
 
@@ -104,6 +157,14 @@ int main(int argc, char* argv[]) {
 		free(inElf);
 	}
 
+	if(stubElf != NULL) {
+		if(!compressImage(stubElf, stubElfSize, &outImage, &outImageSize)) {
+			fprintf(stderr, "error: cannot compress image\n");
+			return 7;
+		}
+		free(stubElf);
+	}
+
 	newFile->write(newFile, outImage, outImageSize);
 	newFile->close(newFile);
 
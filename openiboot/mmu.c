@@ -2,7 +2,9 @@
 #include "mmu.h"
 #include "hardware/s5l8900.h"
 #include "hardware/arm.h"
+#include "hardware/lcd.h"
 #include "openiboot-asmhelpers.h"
+#include "dma.h"
 
 uint32_t* CurrentPageTable;
 
@@ -46,8 +48,13 @@ void initialize_pagetable() {
 	mmu_map_section_range(0x08000000, 0x10000000, 0x08000000, TRUE, TRUE);	// unknown, but mapped by iPhone
 	mmu_map_section(AMC0, AMC0, TRUE, TRUE);
 
-	// Make our own code cacheable and bufferable
-	//mmu_map_section_range(OpenIBootLoad, (uint32_t) &OpenIBootEnd, OpenIBootLoad, TRUE, TRUE);
+	// All of RAM, our own code included, is write-back. Drivers keep their DMA
+	// buffers coherent with the range helpers in openiboot-asmhelpers.S.
+	mmu_map_section_range(MemoryStart, RAMEnd, MemoryStart, TRUE, TRUE);
+
+	// The LCD scans the framebuffers out by itself, so they are write-through:
+	// reads still come from the cache, but nothing lingers there unseen.
+	mmu_map_section_range(LCDFramebufferStart, LCDFramebufferEnd, LCDFramebufferStart, TRUE, FALSE);
 
 	// Make ROM buffer cacheable and bufferable
 	mmu_map_section(ROM, ROM, TRUE, TRUE);
@@ -57,6 +64,9 @@ void initialize_pagetable() {
 
 	// Remap upper half of memory to the lower half
 	mmu_map_section_range(MemoryHigher, MemoryEnd, MemoryStart, FALSE, FALSE);
+
+	// Put back the uncached DMA region, if it was taken before we got here
+	dma_coherent_map();
 }
 
 void mmu_map_section(uint32_t section, uint32_t target, Boolean cacheable, Boolean bufferable) {
@@ -76,7 +86,7 @@ void mmu_map_section(uint32_t section, uint32_t target, Boolean cacheable, Boole
 	InvalidateUnifiedTLBUnlockedEntries();
 }
 
-void mmu_map_section_range(uint32_t rangeStart, uint32_t rangeEnd, uint32_t target, Boolean bufferable, Boolean cacheable) {
+void mmu_map_section_range(uint32_t rangeStart, uint32_t rangeEnd, uint32_t target, Boolean cacheable, Boolean bufferable) {
 	uint32_t currentSection;
 	uint32_t curTargetSection = target;
 	Boolean started = FALSE;
@@ -88,7 +98,7 @@ void mmu_map_section_range(uint32_t rangeStart, uint32_t rangeEnd, uint32_t targ
 			break;
 		}
 		started = TRUE;
-		mmu_map_section(currentSection, curTargetSection, bufferable, cacheable);
+		mmu_map_section(currentSection, curTargetSection, cacheable, bufferable);
 		curTargetSection += MMU_SECTION_SIZE;
 	}
 }
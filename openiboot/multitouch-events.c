@@ -0,0 +1,132 @@
+#include "openiboot.h"
+#include "openiboot-asmhelpers.h"
+#include "multitouch.h"
+#include "tasks.h"
+#include "timer.h"
+#include "util.h"
+
+static MultitouchEvent Events[MULTITOUCH_EVENTS];
+static uint32_t EventsHead = 0;
+static uint32_t EventsTail = 0;
+static uint32_t EventsDropped = 0;
+static Completion EventsReady;
+static int EventsVerbose = FALSE;
+
+static void print_frame(const MTFrameHeader* header, const FingerData* finger, int sensorWidth, int sensorHeight)
+{
+	int i;
+
+	bufferPrintf("------START------\r\n");
+
+	for(i = 0; i < header->numFingers; ++i)
+	{
+		bufferPrintf("multitouch: finger %d -- id=%d, event=%d, X(%d/%d, vel: %d), Y(%d/%d, vel: %d), radii(%d, %d, %d, angle: %d), contactDensity: %d\r\n",
+				i, finger->id, finger->event,
+				finger->x, sensorWidth, finger->velX,
+				finger->y, sensorHeight, finger->velY,
+				finger->radius1, finger->radius2, finger->radius3, finger->angle,
+				finger->contactDensity);
+
+		finger = (const FingerData*) (((const uint8_t*) finger) + header->fingerDataLen);
+	}
+
+	bufferPrintf("-------END-------\r\n");
+}
+
+void multitouch_queue_frame(const uint8_t* data, int len, int sensorWidth, int sensorHeight)
+{
+	const MTFrameHeader* header = (const MTFrameHeader*) data;
+	uint32_t now = (uint32_t) timer_get_system_microtime();
+	int numFingers;
+	int copyLen;
+	int i;
+
+	if(header->type != 0x44 && header->type != 0x43)
+		bufferPrintf("multitouch: unknown frame type 0x%x\r\n", header->type);
+
+	if(header->headerLen < 12)
+	{
+		bufferPrintf("multitouch: no finger data in frame\r\n");
+		return;
+	}
+
+	// never trust the header past the end of what was read
+	numFingers = header->numFingers;
+	if(header->fingerDataLen == 0 || len < header->headerLen)
+		numFingers = 0;
+	else if(numFingers > ((len - header->headerLen) / header->fingerDataLen))
+		numFingers = (len - header->headerLen) / header->fingerDataLen;
+
+	copyLen = (header->fingerDataLen < sizeof(FingerData)) ? header->fingerDataLen : sizeof(FingerData);
+
+	if(EventsVerbose)
+		print_frame(header, (const FingerData*)(data + header->headerLen), sensorWidth, sensorHeight);
+
+	EnterCriticalSection();
+	for(i = 0; i < numFingers; ++i)
+	{
+		MultitouchEvent* event = &Events[EventsHead % MULTITOUCH_EVENTS];
+
+		event->timestamp = now;
+		event->frameNum = header->frameNum;
+		event->finger = i;
+		event->numFingers = numFingers;
+		event->type = header->type;
+		memset(&event->data, 0, sizeof(FingerData));
+		memcpy(&event->data, data + header->headerLen + (i * header->fingerDataLen), copyLen);
+
+		EventsHead++;
+		if((EventsHead - EventsTail) > MULTITOUCH_EVENTS)
+		{
+			EventsTail++;
+			EventsDropped++;
+		}
+	}
+	LeaveCriticalSection();
+
+	if(numFingers > 0)
+		completion_signal(&EventsReady);
+}
+
+int multitouch_read_events(MultitouchEvent* events, int maxEvents)
+{
+	int count = 0;
+
+	EnterCriticalSection();
+	while(count < maxEvents && EventsTail != EventsHead)
+	{
+		memcpy(&events[count], &Events[EventsTail % MULTITOUCH_EVENTS], sizeof(MultitouchEvent));
+		EventsTail++;
+		count++;
+	}
+
+	// only rearm once signalled, when nobody can be left waiting on it
+	if(EventsTail == EventsHead && completion_wait(&EventsReady, 0) == 0)
+		completion_init(&EventsReady);
+	LeaveCriticalSection();
+
+	return count;
+}
+
+int multitouch_pending()
+{
+	return EventsHead - EventsTail;
+}
+
+uint32_t multitouch_dropped()
+{
+	return EventsDropped;
+}
+
+int multitouch_wait(uint32_t timeout)
+{
+	if(EventsTail != EventsHead)
+		return 0;
+
+	return completion_wait(&EventsReady, timeout);
+}
+
+void multitouch_set_verbose(int verbose)
+{
+	EventsVerbose = verbose;
+}
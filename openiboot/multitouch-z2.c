@@ -7,10 +7,16 @@
 #include "util.h"
 #include "spi.h"
 #include "syscfg.h"
+#include "tasks.h"
 
 static void multitouch_atn(uint32_t token);
+static void multitouch_reader(void* opaque);
 
+// Setup polls GotATN for its acknowledgements. Once it is done, the reader
+// task takes over and reads one frame per ATN.
 volatile int GotATN;
+static Semaphore ATNSignal;
+static int ReaderStarted = FALSE;
 
 static uint8_t* OutputPacket;
 static uint8_t* InputPacket;
@@ -170,7 +176,7 @@ static int loadConstructedFirmware(const uint8_t* firmware, int len)
 
 	for(try = 0; try < 5; ++try)
 	{
-		bufferPrintf("multitouch: uploading data packet\r\n");
+		LogDebug(LogMultitouch, "multitouch: uploading data packet\r\n");
 
 		GotATN = 0;
 		mt_spi_tx(FAST_SPEED, firmware, len);
@@ -203,7 +209,7 @@ static int loadProxCal(const uint8_t* firmware, int len)
 
 		for(try = 0; try < 5; ++try)
 		{
-			bufferPrintf("multitouch: uploading prox calibration data packet\r\n");
+			LogDebug(LogMultitouch, "multitouch: uploading prox calibration data packet\r\n");
 
 			GotATN = 0;
 			mt_spi_tx(FAST_SPEED, OutputPacket, toUpload + 0x10);
@@ -244,7 +250,7 @@ static int loadCal(const uint8_t* firmware, int len)
 
 		for(try = 0; try < 5; ++try)
 		{
-			bufferPrintf("multitouch: uploading calibration data packet\r\n");
+			LogDebug(LogMultitouch, "multitouch: uploading calibration data packet\r\n");
 
 			GotATN = 0;
 			mt_spi_tx(FAST_SPEED, OutputPacket, toUpload + 0x10);
@@ -412,7 +418,7 @@ static void sendExecutePacket()
 
 	mt_spi_txrx(NORMAL_SPEED, tx, sizeof(tx), rx, sizeof(rx));
 
-	bufferPrintf("multitouch: execute packet sent\r\n");
+	LogDebug(LogMultitouch, "multitouch: execute packet sent\r\n");
 }
 
 static int determineInterfaceVersion()
@@ -629,38 +635,9 @@ static int getReport(int id, uint8_t* buffer, int* outLen)
 static void multitouch_atn(uint32_t token)
 {
 	++GotATN;
+	semaphore_signal(&ATNSignal);
 }
 
-static void newPacket(const uint8_t* data, int len)
-{
-	MTFrameHeader* header = (MTFrameHeader*) data;
-	if(header->type != 0x44 && header->type != 0x43)
-		bufferPrintf("multitouch: unknown frame type 0x%x\r\n", header->type);
-
-	FingerData* finger = (FingerData*)(data + (header->headerLen));
-
-	if(header->headerLen < 12)
-		bufferPrintf("multitouch: no finger data in frame\r\n");
-
-	bufferPrintf("------START------\r\n");
-
-	int i;
-	for(i = 0; i < header->numFingers; ++i)
-	{
-		bufferPrintf("multitouch: finger %d -- id=%d, event=%d, X(%d/%d, vel: %d), Y(%d/%d, vel: %d), radii(%d, %d, %d, angle: %d), contactDensity: %d\r\n",
-				i, finger->id, finger->event,
-				finger->x, SensorWidth, finger->velX,
-				finger->y, SensorHeight, finger->velY,
-				finger->radius1, finger->radius2, finger->radius3, finger->angle,
-				finger->contactDensity);
-
-		//framebuffer_draw_rect(0xFF0000, (finger->x * framebuffer_width()) / SensorWidth - 2 , ((SensorHeight - finger->y) * framebuffer_height()) / SensorHeight - 2, 4, 4);
-		//hexdump((uint32_t) finger, sizeof(FingerData));
-		finger = (FingerData*) (((uint8_t*) finger) + header->fingerDataLen);
-	}
-
-	bufferPrintf("-------END-------\r\n");
-}
 
 static int readFrameLength(int* len)
 {
@@ -765,7 +742,7 @@ static int readResultData(int len)
 		return FALSE;
 	}
 
-	newPacket(InputPacket + 5, packetLen - 2);
+	multitouch_queue_frame(InputPacket + 5, packetLen - 2, SensorWidth, SensorHeight);
 	return TRUE;
 }
 
@@ -804,6 +781,15 @@ static int readFrame()
 	return ret;
 }
 
+static void multitouch_reader(void* opaque)
+{
+	while(TRUE)
+	{
+		semaphore_wait(&ATNSignal);
+		readFrame();
+	}
+}
+
 int multitouch_setup(const uint8_t* constructedFirmware, int constructedFirmwareLen)
 {
 	int err;
@@ -835,11 +821,13 @@ int multitouch_setup(const uint8_t* constructedFirmware, int constructedFirmware
 		return -1;
 	}
 
+	// frames are read by DMA, so keep them to their own cache lines
 	OutputPacket = (uint8_t*) malloc(0x400);
-	InputPacket = (uint8_t*) malloc(0x400);
+	InputPacket = (uint8_t*) memalign(DMA_ALIGN, 0x400);
 	GetInfoPacket = (uint8_t*) malloc(0x400);
-	GetResultPacket = (uint8_t*) malloc(0x400);
+	GetResultPacket = (uint8_t*) memalign(DMA_ALIGN, 0x400);
 
+	semaphore_init(&ATNSignal, 0);
 	gpio_register_interrupt(MT_ATN_INTERRUPT, 0, 0, 0, multitouch_atn, 0);
 	gpio_interrupt_enable(MT_ATN_INTERRUPT);
 
@@ -985,18 +973,16 @@ int multitouch_setup(const uint8_t* constructedFirmware, int constructedFirmware
 	GotATN = 0;
 	CurNOP = 1;
 
-	while(TRUE)
+	// there could be a frame waiting already
+	semaphore_signal(&ATNSignal);
+	if(!ReaderStarted)
 	{
-		EnterCriticalSection();
-		if(!GotATN)
+		if(task_create("multitouch", multitouch_reader, NULL, 0) == NULL)
 		{
-			LeaveCriticalSection();
-			continue;
+			bufferPrintf("multitouch: could not start the reader task\r\n");
+			return -1;
 		}
-		--GotATN;
-		LeaveCriticalSection();
-
-		readFrame();
+		ReaderStarted = TRUE;
 	}
 
 	return 0;
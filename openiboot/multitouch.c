@@ -6,10 +6,20 @@
 #include "timer.h"
 #include "util.h"
 #include "spi.h"
+#include "tasks.h"
+#include "nvram.h"
 
 static void multitouch_atn(uint32_t token);
+static void multitouch_reader(void* opaque);
 
-volatile int GotATN;
+// Signalled once per ATN; the reader task reads frames until none are left.
+static Semaphore ATNSignal;
+static int ReaderStarted = FALSE;
+
+// Holds the CRC of the firmware last uploaded. If the chip is still up and
+// answering on the next boot, the same firmware is not uploaded again.
+#define MT_FIRMWARE_VAR "opib-multitouch-fw"
+static int FirmwareAlive = FALSE;
 
 static uint8_t* OutputPacket;
 static uint8_t* InputPacket;
@@ -48,6 +58,8 @@ const MTSPISetting MTFastSpeed= {4500000, 0, 10000};
 
 static int mt_spi_txrx(const MTSPISetting* setting, const uint8_t* outBuffer, int outLen, uint8_t* inBuffer, int inLen);
 static int mt_spi_tx(const MTSPISetting* setting, const uint8_t* outBuffer, int outLen);
+static void mt_spi_tx_start(const MTSPISetting* setting, const uint8_t* outBuffer, int outLen);
+static int mt_spi_tx_finish(const MTSPISetting* setting, int outLen);
 
 static int makeBootloaderDataPacket(uint8_t* output, uint32_t destAddress, const uint8_t* data, int dataLen, int* cksumOut);
 static int verifyUpload(int checksum);
@@ -57,6 +69,7 @@ static void sendBlankDataPacket();
 static int loadASpeedFirmware(const uint8_t* firmware, int len);
 static int loadMainFirmware(const uint8_t* firmware, int len);
 static int determineInterfaceVersion();
+static int probeFirmware();
 
 static int getReportInfo(int id, uint8_t* err, uint16_t* len);
 static int getReport(int id, uint8_t* buffer, int* outLen);
@@ -65,20 +78,28 @@ static int readFrameLength(int* len);
 static int readFrame();
 static int readResultData(int len);
 
-static void newPacket(const uint8_t* data, int len);
-
 int MultitouchOn = FALSE;
 
+static void multitouch_power_cycle()
+{
+	bufferPrintf("multitouch: powering on\r\n");
+	gpio_pin_output(MT_GPIO_POWER, 0);
+	udelay(200000);
+	gpio_pin_output(MT_GPIO_POWER, 1);
+
+	udelay(15000);
+}
+
 void multitouch_on()
 {
 	if(!MultitouchOn)
 	{
-		bufferPrintf("multitouch: powering on\r\n");
-		gpio_pin_output(MT_GPIO_POWER, 0);
-		udelay(200000);
-		gpio_pin_output(MT_GPIO_POWER, 1);
+		// a warm reboot may have left our firmware running, so leave it be
+		if(nvram_getvar(MT_FIRMWARE_VAR) != NULL && probeFirmware())
+			FirmwareAlive = TRUE;
+		else
+			multitouch_power_cycle();
 
-		udelay(15000);
 		MultitouchOn = TRUE;
 	}
 }
@@ -89,42 +110,72 @@ int multitouch_setup(const uint8_t* ASpeedFirmware, int ASpeedFirmwareLen, const
 			(uint32_t) ASpeedFirmware, (uint32_t)(ASpeedFirmware + ASpeedFirmwareLen),
 			(uint32_t) mainFirmware, (uint32_t)(mainFirmware + mainFirmwareLen));
 
-	OutputPacket = (uint8_t*) malloc(0x400);
-	InputPacket = (uint8_t*) malloc(0x400);
+	// frames are read by DMA, so keep them to their own cache lines. The
+	// firmware upload builds one packet while the other is sent.
+	OutputPacket = (uint8_t*) memalign(DMA_ALIGN, MT_BOOTLOADER_PACKET * 2);
+	InputPacket = (uint8_t*) memalign(DMA_ALIGN, 0x400);
 	GetInfoPacket = (uint8_t*) malloc(0x400);
-	GetResultPacket = (uint8_t*) malloc(0x400);
+	GetResultPacket = (uint8_t*) memalign(DMA_ALIGN, 0x400);
 
 	memset(GetInfoPacket, 0x82, 0x400);
 	memset(GetResultPacket, 0x68, 0x400);
 
+	semaphore_init(&ATNSignal, 0);
 	gpio_register_interrupt(MT_ATN_INTERRUPT, 0, 0, 0, multitouch_atn, 0);
 	gpio_interrupt_enable(MT_ATN_INTERRUPT);
 
 	multitouch_on();
 
-	bufferPrintf("multitouch: Sending A-Speed firmware...\r\n");
-	if(!loadASpeedFirmware(ASpeedFirmware, ASpeedFirmwareLen))
-	{
-		free(InputPacket);
-		free(OutputPacket);
-		free(GetInfoPacket);
-		free(GetResultPacket);
-		return -1;
-	}
+	uint32_t firmwareCRC = 0;
+	char firmwareCRCString[9];
+	crc32(&firmwareCRC, ASpeedFirmware, ASpeedFirmwareLen);
+	crc32(&firmwareCRC, mainFirmware, mainFirmwareLen);
+	sprintf(firmwareCRCString, "%08x", firmwareCRC);
 
-	udelay(1000);
+	const char* loadedCRCString = nvram_getvar(MT_FIRMWARE_VAR);
+	int loaded = loadedCRCString != NULL && strcmp(loadedCRCString, firmwareCRCString) == 0;
 
-	bufferPrintf("multitouch: Sending main firmware...\r\n");
-	if(!loadMainFirmware(mainFirmware, mainFirmwareLen))
+	if(FirmwareAlive && loaded)
 	{
-		free(InputPacket);
-		free(OutputPacket);
-		free(GetInfoPacket);
-		free(GetResultPacket);
-		return -1;
+		bufferPrintf("multitouch: firmware already loaded\r\n");
+	} else
+	{
+		// whatever is running has to go before the bootloader listens again
+		if(FirmwareAlive)
+			multitouch_power_cycle();
+
+		bufferPrintf("multitouch: Sending A-Speed firmware...\r\n");
+		if(!loadASpeedFirmware(ASpeedFirmware, ASpeedFirmwareLen))
+		{
+			free(InputPacket);
+			free(OutputPacket);
+			free(GetInfoPacket);
+			free(GetResultPacket);
+			return -1;
+		}
+
+		udelay(1000);
+
+		bufferPrintf("multitouch: Sending main firmware...\r\n");
+		if(!loadMainFirmware(mainFirmware, mainFirmwareLen))
+		{
+			free(InputPacket);
+			free(OutputPacket);
+			free(GetInfoPacket);
+			free(GetResultPacket);
+			return -1;
+		}
+
+		udelay(1000);
+
+		if(!loaded)
+		{
+			nvram_setvar(MT_FIRMWARE_VAR, firmwareCRCString);
+			nvram_save();
+		}
 	}
 
-	udelay(1000);
+	FirmwareAlive = FALSE;
 
 	bufferPrintf("multitouch: Determining interface version...\r\n");
 	if(!determineInterfaceVersion())
@@ -231,54 +282,28 @@ int multitouch_setup(const uint8_t* ASpeedFirmware, int ASpeedFirmwareLen, const
 
 	CurNOP = 0x64;
 
-	GotATN = 0;
-
-	while(TRUE)
+	// there could be a frame waiting already
+	semaphore_signal(&ATNSignal);
+	if(!ReaderStarted)
 	{
-		EnterCriticalSection();
-		if(!GotATN)
+		if(task_create("multitouch", multitouch_reader, NULL, 0) == NULL)
 		{
-			LeaveCriticalSection();
-			continue;
+			bufferPrintf("multitouch: could not start the reader task\r\n");
+			return -1;
 		}
-		--GotATN;
-		LeaveCriticalSection();
-
-		while(readFrame() == 1);
+		ReaderStarted = TRUE;
 	}
 
 	return 0;
 }
 
-static void newPacket(const uint8_t* data, int len)
+static void multitouch_reader(void* opaque)
 {
-	MTFrameHeader* header = (MTFrameHeader*) data;
-	if(header->type != 0x44 && header->type != 0x43)
-		bufferPrintf("multitouch: unknown frame type 0x%x\r\n", header->type);
-
-	FingerData* finger = (FingerData*)(data + (header->headerLen));
-
-	if(header->headerLen < 12)
-		bufferPrintf("multitouch: no finger data in frame\r\n");
-
-	bufferPrintf("------START------\r\n");
-
-	int i;
-	for(i = 0; i < header->numFingers; ++i)
+	while(TRUE)
 	{
-		bufferPrintf("multitouch: finger %d -- id=%d, event=%d, X(%d/%d, vel: %d), Y(%d/%d, vel: %d), radii(%d, %d, %d, angle: %d), contactDensity: %d\r\n",
-				i, finger->id, finger->event,
-				finger->x, SensorWidth, finger->velX,
-				finger->y, SensorHeight, finger->velY,
-				finger->radius1, finger->radius2, finger->radius3, finger->angle,
-				finger->contactDensity);
-
-		//framebuffer_draw_rect(0xFF0000, (finger->x * framebuffer_width()) / SensorWidth - 2 , ((SensorHeight - finger->y) * framebuffer_height()) / SensorHeight - 2, 4, 4);
-		//hexdump((uint32_t) finger, sizeof(FingerData));
-		finger = (FingerData*) (((uint8_t*) finger) + header->fingerDataLen);
+		semaphore_wait(&ATNSignal);
+		while(readFrame() == 1);
 	}
-
-	bufferPrintf("-------END-------\r\n");
 }
 
 static int readFrame()
@@ -346,7 +371,7 @@ static int readResultData(int len)
 			continue;
 		}
 
-		newPacket(InputPacket + 1, len - 3);
+		multitouch_queue_frame(InputPacket + 1, len - 3, SensorWidth, SensorHeight);
 		return TRUE;
 	}
 
@@ -514,21 +539,29 @@ static int loadASpeedFirmware(const uint8_t* firmware, int len)
 	uint32_t address = 0x40000000;
 	const uint8_t* data = firmware;
 	int left = len;
+	uint8_t* packet = OutputPacket;
+	uint8_t* nextPacket = OutputPacket + MT_BOOTLOADER_PACKET;
+	int checksum;
+	int nextChecksum = 0;
+	int toUpload;
+	int nextToUpload;
+
+	toUpload = makeBootloaderDataPacket(packet, address, data, left, &checksum);
 
 	while(left > 0)
 	{
-		int checksum;
-		int toUpload = left;
-		if(toUpload > 0x3F8)
-			toUpload = 0x3F8;
-
-		makeBootloaderDataPacket(OutputPacket, address, data, toUpload, &checksum);
+		nextToUpload = 0;
 
 		int try;
 		for(try = 0; try < 5; ++try)
 		{
-			bufferPrintf("multitouch: uploading data packet\r\n");
-			mt_spi_tx(NORMAL_SPEED, OutputPacket, 0x400);
+			mt_spi_tx_start(NORMAL_SPEED, packet, MT_BOOTLOADER_PACKET);
+
+			// build the next packet while this one goes out
+			if(try == 0 && left > toUpload)
+				nextToUpload = makeBootloaderDataPacket(nextPacket, address + toUpload, data + toUpload, left - toUpload, &nextChecksum);
+
+			mt_spi_tx_finish(NORMAL_SPEED, MT_BOOTLOADER_PACKET);
 
 			udelay(300);
 
@@ -542,6 +575,12 @@ static int loadASpeedFirmware(const uint8_t* firmware, int len)
 		address += toUpload;
 		data += toUpload;
 		left -= toUpload;
+
+		uint8_t* sent = packet;
+		packet = nextPacket;
+		nextPacket = sent;
+		checksum = nextChecksum;
+		toUpload = nextToUpload;
 	}
 
 	sendExecutePacket();
@@ -576,6 +615,17 @@ static int loadMainFirmware(const uint8_t* firmware, int len)
 	return TRUE;
 }
 
+static int probeFirmware()
+{
+	uint8_t tx[4];
+	uint8_t rx[4];
+
+	memset(tx, 0xD0, 4);
+	mt_spi_txrx(NORMAL_SPEED, tx, sizeof(tx), rx, sizeof(rx));
+
+	return rx[0] == 0xAA;
+}
+
 static int verifyUpload(int checksum)
 {
 	uint8_t tx[4];
@@ -606,7 +656,7 @@ static int verifyUpload(int checksum)
 		return FALSE;
 	}
 
-	bufferPrintf("multitouch: data verification successful\r\n");
+	LogDebug(LogMultitouch, "multitouch: data verification successful\r\n");
 	return TRUE;
 }
 
@@ -623,7 +673,7 @@ static void sendExecutePacket()
 
 	mt_spi_txrx(NORMAL_SPEED, tx, sizeof(tx), rx, sizeof(rx));
 
-	bufferPrintf("multitouch: execute packet sent\r\n");
+	LogDebug(LogMultitouch, "multitouch: execute packet sent\r\n");
 }
 
 static void sendBlankDataPacket()
@@ -638,13 +688,13 @@ static void sendBlankDataPacket()
 
 	mt_spi_txrx(NORMAL_SPEED, tx, sizeof(tx), rx, sizeof(rx));
 
-	bufferPrintf("multitouch: blank data packet sent\r\n");
+	LogDebug(LogMultitouch, "multitouch: blank data packet sent\r\n");
 }
 
 static int makeBootloaderDataPacket(uint8_t* output, uint32_t destAddress, const uint8_t* data, int dataLen, int* cksumOut)
 {
-	if(dataLen > 0x3F8)
-		dataLen = 0x3F8;
+	if(dataLen > MT_BOOTLOADER_DATA)
+		dataLen = MT_BOOTLOADER_DATA;
 
 	output[0] = 0xC2;
 	output[1] = (destAddress >> 24) & 0xFF;
@@ -668,9 +718,9 @@ static int makeBootloaderDataPacket(uint8_t* output, uint32_t destAddress, const
 		checksum += output[i];
 	}
 
-	memset(output + dataLen + 6, 0, 0x3F8 - dataLen);
-	output[0x3FE] = (checksum >> 8) & 0xFF;
-	output[0x3FF] = checksum & 0xFF;
+	memset(output + dataLen + 6, 0, MT_BOOTLOADER_DATA - dataLen);
+	output[MT_BOOTLOADER_PACKET - 2] = (checksum >> 8) & 0xFF;
+	output[MT_BOOTLOADER_PACKET - 1] = checksum & 0xFF;
 
 	*cksumOut = checksum;
 
@@ -679,7 +729,7 @@ static int makeBootloaderDataPacket(uint8_t* output, uint32_t destAddress, const
 
 static void multitouch_atn(uint32_t token)
 {
-	++GotATN;
+	semaphore_signal(&ATNSignal);
 }
 
 
@@ -693,6 +743,24 @@ int mt_spi_tx(const MTSPISetting* setting, const uint8_t* outBuffer, int outLen)
 	return ret;
 }
 
+// mt_spi_tx in two halves, so the caller can get on with something else
+// while the data goes out.
+void mt_spi_tx_start(const MTSPISetting* setting, const uint8_t* outBuffer, int outLen)
+{
+	spi_set_baud(MT_SPI, setting->speed, SPIOption13Setting0, 1, 1, 1);
+	gpio_pin_output(MT_SPI_CS, 0);
+	udelay(setting->txDelay);
+	spi_tx_async(MT_SPI, outBuffer, outLen, TRUE, NULL, 0);
+}
+
+int mt_spi_tx_finish(const MTSPISetting* setting, int outLen)
+{
+	// twice the time on the wire, and then some
+	int ret = spi_wait(MT_SPI, (uint32_t)(((uint64_t) outLen * 8 * 1000000 * 2) / setting->speed) + 10000);
+	gpio_pin_output(MT_SPI_CS, 1);
+	return (ret == 0) ? outLen : -1;
+}
+
 int mt_spi_txrx(const MTSPISetting* setting, const uint8_t* outBuffer, int outLen, uint8_t* inBuffer, int inLen)
 {
 	spi_set_baud(MT_SPI, setting->speed, SPIOption13Setting0, 1, 1, 1);
@@ -7,6 +7,9 @@
 #include "openiboot-asmhelpers.h"
 #include "dma.h"
 #include "hardware/interrupt.h"
+#include "latency.h"
+#include "nvram.h"
+#include "nandecc.h"
 
 int HasNANDInit = FALSE;
 
@@ -17,38 +20,54 @@ static uint8_t WEHighHoldTime;
 static uint8_t WPPulseTime;
 static uint8_t NANDSetting3;
 static uint8_t NANDSetting4;
+static uint8_t TableWEHighHoldTime;
+static uint8_t TableWPPulseTime;
 static uint32_t TotalECCDataSize;
 static uint32_t ECCType2;
 static int NumValidBanks = 0;
+static int NANDDMAController = 0;
+static int NANDDMAChannel = 0;
 static const int NoMultibankCmdStatus = 1;
 static int LargePages;
+static int CacheRead;
+
+// Held while the controller is in use, by the queue task as well as by the
+// synchronous calls.
+static Mutex NANDLock;
+static Semaphore NANDQueueSignal;
+static NANDRequest* NANDQueue = NULL;
+static NANDRequest* BankRequest[NAND_NUM_BANKS];
 
 static NANDData Geometry;
 static NANDFTLData FTLData;
 
 static uint8_t* aTemporaryReadEccBuf;
 static uint8_t* aTemporarySBuf;
+static uint8_t* aTemporarySBuf2;
 
 #define SECTOR_SIZE 512
 
 static const NANDDeviceType SupportedDevices[] = {
-	{0x2555D5EC, 8192, 128, 4, 64, 4, 2, 4, 2, 7744, 4, 6},
-	{0xB614D5EC, 4096, 128, 8, 128, 4, 2, 4, 2, 3872, 4, 6},
-	{0xB655D7EC, 8192, 128, 8, 128, 4, 2, 4, 2, 7744, 4, 6},
+	{0x2555D5EC, 8192, 128, 4, 64, 4, 2, 4, 2, 7744, 4, 6, NAND_FLAG_CACHEREAD},
+	{0xB614D5EC, 4096, 128, 8, 128, 4, 2, 4, 2, 3872, 4, 6, NAND_FLAG_CACHEREAD},
+	{0xB655D7EC, 8192, 128, 8, 128, 4, 2, 4, 2, 7744, 4, 6, NAND_FLAG_CACHEREAD},
 	{0xA514D3AD, 4096, 128, 4, 64, 4, 2, 4, 2, 3872, 4, 6},
 	{0xA555D5AD, 8192, 128, 4, 64, 4, 2, 4, 2, 7744, 4, 6},
 	{0xB614D5AD, 4096, 128, 8, 128, 4, 2, 4, 2, 3872, 4, 6},
 	{0xB655D7AD, 8192, 128, 8, 128, 4, 2, 4, 2, 7744, 4, 6},
-	{0xA585D598, 8320, 128, 4, 64, 6, 2, 4, 2, 7744, 4, 6},
-	{0xBA94D598, 4096, 128, 8, 216, 6, 2, 4, 2, 3872, 8, 8},
-	{0xBA95D798, 8192, 128, 8, 216, 6, 2, 4, 2, 7744, 8, 8},
-	{0x3ED5D789, 8192, 128, 8, 216, 4, 2, 4, 2, 7744, 8, 8},
-	{0x3E94D589, 4096, 128, 8, 216, 4, 2, 4, 2, 3872, 8, 8},
-	{0x3ED5D72C, 8192, 128, 8, 216, 4, 2, 4, 2, 7744, 8, 8},
-	{0x3E94D52C, 4096, 128, 8, 216, 4, 2, 4, 2, 3872, 8, 8},
+	{0xA585D598, 8320, 128, 4, 64, 6, 2, 4, 2, 7744, 4, 6, NAND_FLAG_CACHEREAD},
+	{0xBA94D598, 4096, 128, 8, 216, 6, 2, 4, 2, 3872, 8, 8, NAND_FLAG_CACHEREAD},
+	{0xBA95D798, 8192, 128, 8, 216, 6, 2, 4, 2, 7744, 8, 8, NAND_FLAG_CACHEREAD},
+	{0x3ED5D789, 8192, 128, 8, 216, 4, 2, 4, 2, 7744, 8, 8, NAND_FLAG_CACHEREAD},
+	{0x3E94D589, 4096, 128, 8, 216, 4, 2, 4, 2, 3872, 8, 8, NAND_FLAG_CACHEREAD},
+	{0x3ED5D72C, 8192, 128, 8, 216, 4, 2, 4, 2, 7744, 8, 8, NAND_FLAG_CACHEREAD},
+	{0x3E94D52C, 4096, 128, 8, 216, 4, 2, 4, 2, 3872, 8, 8, NAND_FLAG_CACHEREAD},
 	{0}
 };
 
+static void nand_queue_task(void* opaque);
+static void nand_lock(int bank);
+
 static int wait_for_ready(int timeout) {
 	if((GET_REG(NAND + FMCSTAT) & FMCSTAT_READY) != 0) {
 		return 0;
@@ -59,6 +78,8 @@ static int wait_for_ready(int timeout) {
 		if(has_elapsed(startTime, timeout * 1000)) {
 			return ERROR_TIMEOUT;
 		}
+
+		poll_wait(startTime);
 	}
 
 	return 0;
@@ -201,10 +222,55 @@ static int wait_for_nand_bank_ready(int bank) {
 	return 0;
 }
 
+// The pulse and hold times from the device table are what every part of
+// that type is good for. nand_calibrate looks for the tightest ones this
+// particular chip still reads back ECC clean at, and can keep them in
+// nvram for later boots.
+// The value is tied to the device ID and the bus clock it was found at:
+// bits 31-16 fold the ID, bits 15-8 are the bus MHz, then 4 bits each for
+// the pulse and hold times.
+#define NAND_TIMING_VAR "opib-nand-timing"
+
+#ifndef NAND_CALIBRATE_PAGES
+#define NAND_CALIBRATE_PAGES 8
+#endif
+
+#ifndef NAND_CALIBRATE_PASSES
+#define NAND_CALIBRATE_PASSES 4
+#endif
+
+static uint32_t nand_timing_key() {
+	uint32_t fold = (Geometry.DeviceID ^ (Geometry.DeviceID >> 16)) & 0xFFFF;
+	return (fold << 8) | ((clock_get_frequency(FrequencyBaseBus) / 1000000) & 0xFF);
+}
+
+static void nand_apply_saved_timing() {
+	const char* value = nvram_getvar(NAND_TIMING_VAR);
+	if(value == NULL)
+		return;
+
+	uint32_t timing = parseNumber(value);
+	uint8_t twp = (timing >> 4) & 0xF;
+	uint8_t twh = timing & 0xF;
+
+	// anything looser than the table, or found for another chip or clock, is stale
+	if((timing >> 8) != nand_timing_key() || twp > TableWPPulseTime || twh > TableWEHighHoldTime) {
+		bufferPrintf("nand: ignoring saved timing 0x%x\r\n", timing);
+		return;
+	}
+
+	WPPulseTime = twp;
+	WEHighHoldTime = twh;
+	bufferPrintf("nand: using calibrated timing twp=%d twh=%d\r\n", twp, twh);
+}
+
 int nand_setup() {
 	if(HasNANDInit)
 		return 0;
 
+	mutex_init(&NANDLock);
+	semaphore_init(&NANDQueueSignal, 0);
+
 	WEHighHoldTime = 7;
 	WPPulseTime = 7;
 	NANDSetting3 = 7;
@@ -292,6 +358,9 @@ int nand_setup() {
 	if(NANDSetting4 > 7)
 		NANDSetting4 = 7;
 
+	TableWPPulseTime = WPPulseTime;
+	TableWEHighHoldTime = WEHighHoldTime;
+
 	Geometry.blocksPerBank = nandType->blocksPerBank;
 	Geometry.banksTotal = NumValidBanks;
 	Geometry.sectorsPerPage = nandType->sectorsPerPage;
@@ -301,6 +370,12 @@ int nand_setup() {
 	Geometry.field_2F = 3;
 	Geometry.pagesPerBlock = nandType->pagesPerBlock;
 
+#ifndef NAND_NO_CACHEREAD
+	CacheRead = (nandType->flags & NAND_FLAG_CACHEREAD) ? TRUE : FALSE;
+#else
+	CacheRead = FALSE;
+#endif
+
 	if(Geometry.sectorsPerPage > 4) {
 		LargePages = TRUE;
 	} else {
@@ -350,6 +425,8 @@ int nand_setup() {
 
 	Geometry.field_22 = bits;
 
+	nand_apply_saved_timing();
+
 	bufferPrintf("nand: DEVICE: %08x\r\n", Geometry.DeviceID);
 	bufferPrintf("nand: BANKS_TOTAL: %d\r\n", Geometry.banksTotal);
 	bufferPrintf("nand: BLOCKS_PER_BANK: %d\r\n", Geometry.blocksPerBank);
@@ -361,11 +438,22 @@ int nand_setup() {
 	bufferPrintf("nand: BYTES_PER_SPARE: %d\r\n", Geometry.bytesPerSpare);
 	bufferPrintf("nand: BYTES_PER_PAGE: %d\r\n", Geometry.bytesPerPage);
 	bufferPrintf("nand: PAGES_PER_BLOCK: %d\r\n", Geometry.pagesPerBlock);
+	bufferPrintf("nand: CACHE_READ: %s\r\n", CacheRead ? "yes" : "no");
 
-	aTemporaryReadEccBuf = (uint8_t*) malloc(Geometry.bytesPerPage);
+	aTemporaryReadEccBuf = (uint8_t*) malloc_dma(Geometry.bytesPerPage);
 	memset(aTemporaryReadEccBuf, 0xFF, SECTOR_SIZE);
 
-	aTemporarySBuf = (uint8_t*) malloc(Geometry.bytesPerSpare);
+	aTemporarySBuf = (uint8_t*) malloc_dma(Geometry.bytesPerSpare);
+	aTemporarySBuf2 = (uint8_t*) malloc_dma(Geometry.bytesPerSpare);
+
+	// every page and spare transfer goes through this one channel
+	if(dma_reserve(DMA_NAND, DMA_MEMORY, &NANDDMAController, &NANDDMAChannel) != 0) {
+		NANDDMAController = 0;
+		NANDDMAChannel = 0;
+	}
+
+	if(task_create("nand", nand_queue_task, NULL, 0) == NULL)
+		bufferPrintf("nand: could not start the request queue\r\n");
 
 	HasNANDInit = TRUE;
 
@@ -373,8 +461,8 @@ int nand_setup() {
 }
 
 static int transferFromFlash(void* buffer, int size) {
-	int controller = 0;
-	int channel = 0;
+	int controller = NANDDMAController;
+	int channel = NANDDMAChannel;
 
 	if((((uint32_t)buffer) & 0x3) != 0) {
 		// the buffer needs to be aligned for DMA, last two bits have to be clear
@@ -385,13 +473,14 @@ static int transferFromFlash(void* buffer, int size) {
 	SET_REG(NAND + FMDNUM, size - 1);
 	SET_REG(NAND + FMCTRL1, FMCTRL1_DOREADDATA);
 
-	CleanCPUDataCache();
+	InvalidateDataCacheRange(buffer, size);
 
 	dma_request(DMA_NAND, 4, 4, DMA_MEMORY, 4, 4, &controller, &channel, NULL);
 	dma_perform(DMA_NAND, (uint32_t)buffer, size, 0, &controller, &channel);
 
 	if(dma_finish(controller, channel, 500) != 0) {
 		bufferPrintf("nand: dma timed out\r\n");
+		dma_pause(controller, channel);
 		return ERROR_TIMEOUT;
 	}
 
@@ -402,14 +491,12 @@ static int transferFromFlash(void* buffer, int size) {
 
 	SET_REG(NAND + FMCTRL1, FMCTRL1_FLUSHFIFOS);
 
-	CleanAndInvalidateCPUDataCache();
-
 	return 0;
 }
 
 static int transferToFlash(void* buffer, int size) {
-	int controller = 0;
-	int channel = 0;
+	int controller = NANDDMAController;
+	int channel = NANDDMAChannel;
 
 	if((((uint32_t)buffer) & 0x3) != 0) {
 		// the buffer needs to be aligned for DMA, last two bits have to be clear
@@ -420,13 +507,14 @@ static int transferToFlash(void* buffer, int size) {
 	SET_REG(NAND + FMDNUM, size - 1);
 	SET_REG(NAND + FMCTRL1, 0x7F4);
 
-	CleanCPUDataCache();
+	CleanDataCacheRange(buffer, size);
 
 	dma_request(DMA_MEMORY, 4, 4, DMA_NAND, 4, 4, &controller, &channel, NULL);
 	dma_perform((uint32_t)buffer, DMA_NAND, size, 0, &controller, &channel);
 
 	if(dma_finish(controller, channel, 500) != 0) {
 		bufferPrintf("nand: dma timed out\r\n");
+		dma_pause(controller, channel);
 		return ERROR_TIMEOUT;
 	}
 
@@ -437,18 +525,26 @@ static int transferToFlash(void* buffer, int size) {
 
 	SET_REG(NAND + FMCTRL1, FMCTRL1_FLUSHFIFOS);
 
-	CleanAndInvalidateCPUDataCache();
-
 	return 0;
 }
 
+static int ecc_bytes_per_sector(int setting) {
+	if(setting == 4)
+		return 15;
+	else if(setting == 8)
+		return 20;
+	else
+		return 10;
+}
+
 static void ecc_perform(int setting, int sectors, uint8_t* sectorData, uint8_t* eccData) {
 	SET_REG(NANDECC + NANDECC_CLEARINT, 1);
 	SET_REG(NANDECC + NANDECC_SETUP, ((sectors - 1) & 0x3) | setting);
 	SET_REG(NANDECC + NANDECC_DATA, (uint32_t) sectorData);
 	SET_REG(NANDECC + NANDECC_ECC, (uint32_t) eccData);
 
-	CleanCPUDataCache();
+	CleanDataCacheRange(sectorData, sectors * SECTOR_SIZE);
+	CleanDataCacheRange(eccData, sectors * ecc_bytes_per_sector(setting));
 
 	SET_REG(NANDECC + NANDECC_START, 1);
 }
@@ -459,7 +555,8 @@ static void ecc_generate(int setting, int sectors, uint8_t* sectorData, uint8_t*
 	SET_REG(NANDECC + NANDECC_DATA, (uint32_t) sectorData);
 	SET_REG(NANDECC + NANDECC_ECC, (uint32_t) eccData);
 
-	CleanAndInvalidateCPUDataCache();
+	CleanDataCacheRange(sectorData, sectors * SECTOR_SIZE);
+	InvalidateDataCacheRange(eccData, sectors * ecc_bytes_per_sector(setting));
 
 	SET_REG(NANDECC + NANDECC_START, 2);
 }
@@ -493,6 +590,35 @@ static int ecc_finish() {
 	return 0;
 }
 
+// The strength nandecc calls an engine setting
+static int ecc_strength(int setting) {
+	if(setting == 4)
+		return 6;
+	else if(setting == 8)
+		return 8;
+	else
+		return 4;
+}
+
+// With more than four sectors in a page, the engine wants the ECC bytes of
+// each sector in the opposite order to how they are stored.
+static void ecc_swap(uint8_t* ecc, int eccSize, int sectors) {
+	int i;
+	for(i = 0; i < sectors; i++) {
+		// loop through each sector
+		uint8_t* x = &ecc[eccSize * i]; // first byte of ECC
+		uint8_t* y = x + eccSize - 1; // last byte of ECC
+		while(x < y) {
+			// swap the byte order of them
+			uint8_t t = *y;
+			*y = *x;
+			*x = t;
+			x++;
+			y--;
+		}
+	}
+}
+
 static int generateECC(int setting, uint8_t* data, uint8_t* ecc) {
 	int eccSize = 0;
 
@@ -522,20 +648,7 @@ static int generateECC(int setting, uint8_t* data, uint8_t* ecc) {
 
 		if(LargePages) {
 			// If there are more than 4 sectors in a page...
-			int i;
-			for(i = 0; i < toCheck; i++) {
-				// loop through each sector that we have generated this time's ECC
-				uint8_t* x = &eccPtr[eccSize * i]; // first byte of ECC
-				uint8_t* y = x + eccSize - 1; // last byte of ECC
-				while(x < y) {
-					// swap the byte order of them
-					uint8_t t = *y;
-					*y = *x;
-					*x = t;
-					x++;
-					y--;
-				}
-			}
+			ecc_swap(eccPtr, eccSize, toCheck);
 		}
 
 		dataPtr += toCheck * SECTOR_SIZE;
@@ -546,81 +659,174 @@ static int generateECC(int setting, uint8_t* data, uint8_t* ecc) {
 	return 0;
 }
 
-static int checkECC(int setting, uint8_t* data, uint8_t* ecc) {
-	int eccSize = 0;
+// An ECC check of one page, done four sectors at a time. ecc_check_start sets
+// the engine going on the first batch and returns, so that the next page can be
+// transferred while it runs; ecc_check_finish does the rest.
+typedef struct ECCCheck {
+	int status;
+	int setting;
+	int eccSize;
+	uint8_t* data;
+	uint8_t* ecc;
+	int sectorsLeft;
+	int toCheck;
+} ECCCheck;
+
+static void ecc_check_next(ECCCheck* check) {
+	check->toCheck = (check->sectorsLeft > 4) ? 4 : check->sectorsLeft;
+
+	if(LargePages) {
+		// If there are more than 4 sectors in a page...
+		ecc_swap(check->ecc, check->eccSize, check->toCheck);
+	}
+
+	ecc_perform(check->setting, check->toCheck, check->data, check->ecc);
+}
+
+static void ecc_check_start(ECCCheck* check, int setting, uint8_t* data, uint8_t* ecc) {
+	check->status = 0;
+	check->eccSize = 0;
+	check->toCheck = 0;
+	check->setting = setting;
+	check->data = data;
+	check->ecc = ecc;
+	check->sectorsLeft = Geometry.sectorsPerPage;
 
 	if(setting == 4) {
-		eccSize = 15;
+		check->eccSize = 15;
 	} else if(setting == 8) {
-		eccSize = 20;
+		check->eccSize = 20;
 	} else if(setting == 0) {
-		eccSize = 10;
+		check->eccSize = 10;
 	} else {
+		check->status = ERROR_ECC;
+		return;
+	}
+
+	ecc_check_next(check);
+}
+
+static int ecc_check_finish(ECCCheck* check) {
+	if(check->status != 0)
+		return check->status;
+
+	while(TRUE) {
+		if(ecc_finish() != 0)
+			return (check->status = ERROR_ECC);
+
+		check->data += check->toCheck * SECTOR_SIZE;
+		check->ecc += check->toCheck * check->eccSize;
+		check->sectorsLeft -= check->toCheck;
+
+		if(check->sectorsLeft <= 0)
+			return 0;
+
+		ecc_check_next(check);
+	}
+}
+
+static int checkECC(int setting, uint8_t* data, uint8_t* ecc) {
+	ECCCheck check;
+	ecc_check_start(&check, setting, data, ecc);
+	return ecc_check_finish(&check);
+}
+
+static uint32_t ECCSoftwareCorrected = 0;
+
+// Counts everything that changes what NAND holds, see nand_write_generation
+static volatile uint32_t WriteGeneration = 0;
+
+// The engine gave up on a page, data and its ECC bytes ecc as check had them.
+// The software decoder gets a go, and what it makes of the page only counts
+// if the engine passes it afterwards.
+static int ecc_recover(ECCCheck* check, uint8_t* data, uint8_t* ecc) {
+	if(check->eccSize == 0)
 		return ERROR_ECC;
+
+	if(LargePages) {
+		// the check swapped the sectors it got to, put them back like on flash
+		ecc_swap(ecc, check->eccSize, ((check->ecc - ecc) / check->eccSize) + check->toCheck);
 	}
 
-	uint8_t* dataPtr = data;
-	uint8_t* eccPtr = ecc;
-	int sectorsLeft = Geometry.sectorsPerPage;
+	int corrected = nandecc_correct_page(ecc_strength(check->setting), Geometry.sectorsPerPage, LargePages ? NANDECC_REVERSED : 0, data, ecc);
+	if(corrected <= 0)
+		return ERROR_ECC;
 
-	while(sectorsLeft > 0) {
-		int toCheck;
-		if(sectorsLeft > 4)
-			toCheck = 4;
-		else
-			toCheck = sectorsLeft;
+	if(checkECC(check->setting, data, ecc) != 0)
+		return ERROR_ECC;
 
-		if(LargePages) {
-			// If there are more than 4 sectors in a page...
-			int i;
-			for(i = 0; i < toCheck; i++) {
-				// loop through each sector that we have to check this time's ECC
-				uint8_t* x = &eccPtr[eccSize * i]; // first byte of ECC
-				uint8_t* y = x + eccSize - 1; // last byte of ECC
-				while(x < y) {
-					// swap the byte order of them
-					uint8_t t = *y;
-					*y = *x;
-					*x = t;
-					x++;
-					y--;
-				}
-			}
-		}
+	ECCSoftwareCorrected++;
+	bufferPrintf("nand: corrected %d symbols in software that the ECC engine could not\r\n", corrected);
+	return 0;
+}
 
-		ecc_perform(setting, toCheck, dataPtr, eccPtr);
-		if(ecc_finish() != 0)
-			return ERROR_ECC;
+// Same for the spare, which is checked as a sector of its own: the SpareData
+// and 0xFF for the rest.
+static int ecc_recover_spare(uint8_t* sector, uint8_t* ecc) {
+	int i;
 
-		dataPtr += toCheck * SECTOR_SIZE;
-		eccPtr += toCheck * eccSize;
-		sectorsLeft -= toCheck;
+	memset(sector + sizeof(SpareData), 0xFF, SECTOR_SIZE - sizeof(SpareData));
+	if(nandecc_correct_page(ecc_strength(ECCType), 1, 0, sector, ecc) <= 0)
+		return ERROR_ECC;
+
+	for(i = sizeof(SpareData); i < SECTOR_SIZE; i++) {
+		if(sector[i] != 0xFF)
+			return ERROR_ECC;
 	}
 
+	ecc_perform(ECCType, 1, sector, ecc);
+	if(ecc_finish() != 0)
+		return ERROR_ECC;
+
+	ECCSoftwareCorrected++;
 	return 0;
 }
 
+uint32_t nand_write_generation() {
+	return WriteGeneration;
+}
+
+int nand_ecc_corrected_in_software() {
+	return ECCSoftwareCorrected;
+}
+
+// Blank if at most one byte is not 0xFF (erased pages can have a bit flip).
+// Whole words of 0xFF are skipped and the scan stops at the second bad byte.
 static int isEmptyBlock(uint8_t* buffer, int size) {
-	int i;
+	int i = 0;
 	int found = 0;
-	for(i = 0; i < size; i++) {
-		if(buffer[i] != 0xFF) {
-			found++;
+
+	if((((uint32_t)buffer) & 0x3) == 0) {
+		const uint32_t* words = (const uint32_t*) buffer;
+		for(; (i + 4) <= size; i += 4) {
+			uint32_t word = words[i / 4];
+			if(word == 0xFFFFFFFF)
+				continue;
+
+			found += ((word & 0xFF) != 0xFF) + (((word >> 8) & 0xFF) != 0xFF)
+				+ (((word >> 16) & 0xFF) != 0xFF) + ((word >> 24) != 0xFF);
+			if(found > 1)
+				return 0;
 		}
 	}
 
-	if(found <= 1)
-		return 1;
-	else
-		return 0;
+	for(; i < size; i++) {
+		if(buffer[i] != 0xFF && ++found > 1)
+			return 0;
+	}
+
+	return 1;
 }
 
-int nand_erase(int bank, int block) {
+// Send an erase to a bank without waiting for the bank to finish it.
+static int nand_erase_issue(int bank, int block) {
 	int pageAddr;
 
 	if(bank >= Geometry.banksTotal)
 		return ERROR_ARG;
 
+	WriteGeneration++;
+
 	if(block >= Geometry.blocksPerBank)
 		return ERROR_ARG;
 
@@ -645,32 +851,36 @@ int nand_erase(int bank, int block) {
 	SET_REG(NAND + NAND_CMD, 0xD0);
 	wait_for_ready(500);
 
+	return 0;
+
+FIL_erase_error:
+	return -1;
+
+}
+
+static int nand_do_erase(int bank, int block) {
+	int ret;
+	if((ret = nand_erase_issue(bank, block)) != 0)
+		return ret;
+
 	while((nand_read_status() & (1 << 6)) == 0);
 
 	if(nand_read_status() & 0x1)
 		return -1;
 	else
 		return 0;
-
-FIL_erase_error:
-	return -1;
-
 }
 
 int nand_calculate_ecc(uint8_t* data, uint8_t* ecc) {
-	return generateECC(ECCType, data, ecc);
+	mutex_lock(&NANDLock);
+	int ret = generateECC(ECCType, data, ecc);
+	mutex_unlock(&NANDLock);
+	return ret;
 }
 
-int nand_read(int bank, int page, uint8_t* buffer, uint8_t* spare, int doECC, int checkBlank) {
-	if(bank >= Geometry.banksTotal)
-		return ERROR_ARG;
-
-	if(page >= Geometry.pagesPerBank)
-		return ERROR_ARG;
-
-	if(buffer == NULL && spare == NULL)
-		return ERROR_ARG;
-
+// Send the read command for a page to a bank. The bank is then busy loading the
+// page into its data register, and other banks can be addressed in the meantime.
+static int nand_read_issue(int bank, int page, int hasBuffer) {
 	SET_REG(NAND + FMCTRL0,
 		((WEHighHoldTime & FMCTRL_TWH_MASK) << FMCTRL_TWH_SHIFT) | ((WPPulseTime & FMCTRL_TWP_MASK) << FMCTRL_TWP_SHIFT)
 		| (1 << (banksTable[bank] + 1)) | FMCTRL0_ON | FMCTRL0_WPB);
@@ -683,7 +893,7 @@ int nand_read(int bank, int page, uint8_t* buffer, uint8_t* spare, int doECC, in
 
 	SET_REG(NAND + FMANUM, FMANUM_TRANSFERSETTING);
 
-	if(buffer) {
+	if(hasBuffer) {
 		SET_REG(NAND + FMADDR0, page << 16); // lower bits of the page number to the upper bits of CONFIG3
 		SET_REG(NAND + FMADDR1, (page >> 16) & 0xFF); // upper bits of the page number
 
@@ -704,6 +914,33 @@ int nand_read(int bank, int page, uint8_t* buffer, uint8_t* spare, int doECC, in
 		goto FIL_read_error;
 	}
 
+	return 0;
+
+FIL_read_error:
+	nand_bank_reset(bank, 100);
+	return ERROR_NAND;
+}
+
+// Move the page a bank has finished loading into its cache register. With
+// NAND_CMD_READCACHE the bank goes on to load the following page meanwhile.
+static int nand_read_issue_cache(int bank, int last) {
+	SET_REG(NAND + FMCTRL0,
+		((WEHighHoldTime & FMCTRL_TWH_MASK) << FMCTRL_TWH_SHIFT) | ((WPPulseTime & FMCTRL_TWP_MASK) << FMCTRL_TWP_SHIFT)
+		| (1 << (banksTable[bank] + 1)) | FMCTRL0_ON | FMCTRL0_WPB);
+
+	SET_REG(NAND + NAND_CMD, last ? NAND_CMD_READCACHEEND : NAND_CMD_READCACHE);
+	if(wait_for_ready(500) != 0) {
+		bufferPrintf("nand: sending cache read command failed\r\n");
+		nand_bank_reset(bank, 100);
+		return ERROR_NAND;
+	}
+
+	return 0;
+}
+
+// Wait for a bank that has been sent nand_read_issue to go ready, then DMA the
+// page out. The raw spare, ECC bytes included, goes to rawSpare.
+static int nand_read_transfer(int bank, uint8_t* buffer, uint8_t* rawSpare) {
 	if(wait_for_nand_bank_ready(bank) != 0) {
 		bufferPrintf("nand: nand bank not ready after a long time\r\n");
 		goto FIL_read_error;
@@ -716,23 +953,53 @@ int nand_read(int bank, int page, uint8_t* buffer, uint8_t* spare, int doECC, in
 		}
 	}
 
-	if(transferFromFlash(aTemporarySBuf, Geometry.bytesPerSpare) != 0) {
+	if(transferFromFlash(rawSpare, Geometry.bytesPerSpare) != 0) {
 		bufferPrintf("nand: transferFromFlash for spare failed\r\n");
 		goto FIL_read_error;
 	}
 
+	return 0;
+
+FIL_read_error:
+	nand_bank_reset(bank, 100);
+	return ERROR_NAND;
+}
+
+// Check a transferred page and hand out its spare. If mainCheck is given, the
+// ECC check of the main area has already been started on it.
+static int nand_read_verify(uint8_t* buffer, uint8_t* rawSpare, uint8_t* spare, int doECC, int checkBlank, ECCCheck* mainCheck) {
+	ECCCheck check;
 	int eccFailed = 0;
 	if(doECC) {
+		int mainFailed = FALSE;
+		int spareFailed;
+
 		if(buffer) {
-			eccFailed = (checkECC(ECCType, buffer, aTemporarySBuf + sizeof(SpareData)) != 0);
+			if(mainCheck == NULL) {
+				mainCheck = &check;
+				ecc_check_start(mainCheck, ECCType, buffer, rawSpare + sizeof(SpareData));
+			}
+
+			mainFailed = (ecc_check_finish(mainCheck) != 0);
 		}
 
-		memcpy(aTemporaryReadEccBuf, aTemporarySBuf, sizeof(SpareData));
-		ecc_perform(ECCType, 1, aTemporaryReadEccBuf, aTemporarySBuf + sizeof(SpareData) + TotalECCDataSize);
-		if(ecc_finish() != 0) {
-			memset(aTemporaryReadEccBuf, 0xFF, SECTOR_SIZE);
-			eccFailed |= 1;
+		memcpy(aTemporaryReadEccBuf, rawSpare, sizeof(SpareData));
+		ecc_perform(ECCType, 1, aTemporaryReadEccBuf, rawSpare + sizeof(SpareData) + TotalECCDataSize);
+		spareFailed = (ecc_finish() != 0);
+
+		// erased pages fail too, and there is nothing to decode in them
+		if((mainFailed || spareFailed) && isEmptyBlock(rawSpare, Geometry.bytesPerSpare) == 0) {
+			if(mainFailed)
+				mainFailed = (ecc_recover(mainCheck, buffer, rawSpare + sizeof(SpareData)) != 0);
+
+			if(spareFailed)
+				spareFailed = (ecc_recover_spare(aTemporaryReadEccBuf, rawSpare + sizeof(SpareData) + TotalECCDataSize) != 0);
 		}
+
+		if(spareFailed)
+			memset(aTemporaryReadEccBuf, 0xFF, SECTOR_SIZE);
+
+		eccFailed = (mainFailed || spareFailed);
 	}
 
 	if(spare) {
@@ -740,12 +1007,12 @@ int nand_read(int bank, int page, uint8_t* buffer, uint8_t* spare, int doECC, in
 			// We can only copy the first 12 bytes because the rest is probably changed by the ECC check routine
 			memcpy(spare, aTemporaryReadEccBuf, sizeof(SpareData));
 		} else {
-			memcpy(spare, aTemporarySBuf, Geometry.bytesPerSpare);
+			memcpy(spare, rawSpare, Geometry.bytesPerSpare);
 		}
 	}
 
 	if(eccFailed || checkBlank) {
-		if(isEmptyBlock(aTemporarySBuf, Geometry.bytesPerSpare) != 0) {
+		if(isEmptyBlock(rawSpare, Geometry.bytesPerSpare) != 0) {
 			return ERROR_EMPTYBLOCK;
 		} else if(eccFailed) {
 			return ERROR_NAND;
@@ -753,16 +1020,47 @@ int nand_read(int bank, int page, uint8_t* buffer, uint8_t* spare, int doECC, in
 	}
 
 	return 0;
+}
 
-FIL_read_error:
-	nand_bank_reset(bank, 100);
-	return ERROR_NAND;
+static int nand_read_finish(int bank, uint8_t* buffer, uint8_t* spare, int doECC, int checkBlank) {
+	int ret;
+	if((ret = nand_read_transfer(bank, buffer, aTemporarySBuf)) != 0)
+		return ret;
+
+	return nand_read_verify(buffer, aTemporarySBuf, spare, doECC, checkBlank, NULL);
 }
 
-int nand_write(int bank, int page, uint8_t* buffer, uint8_t* spare, int doECC) {
+static int nand_do_read(int bank, int page, uint8_t* buffer, uint8_t* spare, int doECC, int checkBlank) {
+	int ret;
+
 	if(bank >= Geometry.banksTotal)
 		return ERROR_ARG;
 
+	if(page >= Geometry.pagesPerBank)
+		return ERROR_ARG;
+
+	if(buffer == NULL && spare == NULL)
+		return ERROR_ARG;
+
+	if((ret = nand_read_issue(bank, page, buffer != NULL)) != 0)
+		return ret;
+
+	return nand_read_finish(bank, buffer, spare, doECC, checkBlank);
+}
+
+// Sends the column address of the spare area and moves only bytesPerSpare
+// bytes over the bus. For scans that look at page types and USNs.
+int nand_read_spare(int bank, int page, uint8_t* spare, int doECC) {
+	return nand_read(bank, page, NULL, spare, doECC, TRUE);
+}
+
+// Program a page without waiting for the bank to finish it.
+static int nand_write_issue(int bank, int page, uint8_t* buffer, uint8_t* spare, int doECC) {
+	if(bank >= Geometry.banksTotal)
+		return ERROR_ARG;
+
+	WriteGeneration++;
+
 	if(page >= Geometry.pagesPerBank)
 		return ERROR_ARG;
 
@@ -824,18 +1122,24 @@ int nand_write(int bank, int page, uint8_t* buffer, uint8_t* spare, int doECC) {
 	SET_REG(NAND + NAND_CMD, 0x10);
 	wait_for_ready(500);
 
+	return 0;
+
+FIL_write_error:
+	nand_bank_reset(bank, 100);
+	return ERROR_NAND;
+}
+
+static int nand_do_write(int bank, int page, uint8_t* buffer, uint8_t* spare, int doECC) {
+	int ret;
+	if((ret = nand_write_issue(bank, page, buffer, spare, doECC)) != 0)
+		return ret;
+
 	while((nand_read_status() & (1 << 6)) == 0);
 
 	if(nand_read_status() & 0x1)
 		return -1;
 	else
 		return 0;
-
-	return 0;
-
-FIL_write_error:
-	nand_bank_reset(bank, 100);
-	return ERROR_NAND;
 }
 
 NANDData* nand_get_geometry() {
@@ -846,32 +1150,692 @@ NANDFTLData* nand_get_ftl_data() {
 	return &FTLData;
 }
 
-int nand_read_multiple(uint16_t* bank, uint32_t* pages, uint8_t* main, SpareData* spare, int pagesCount) {
+static int nand_calibrate_pass(int count, const int* banks, const int* pages, const uint32_t* crcs, uint8_t* buffer, uint8_t* spare) {
+	int pass;
 	int i;
-	unsigned int ret;
-	for(i = 0; i < pagesCount; i++) {
-		ret = nand_read(bank[i], pages[i], main, (uint8_t*) &spare[i], TRUE, TRUE);
-		if(ret > 1)
-			return ret;
 
-		main += Geometry.bytesPerPage;
+	for(pass = 0; pass < NAND_CALIBRATE_PASSES; pass++) {
+		for(i = 0; i < count; i++) {
+			uint32_t crc = 0;
+			if(nand_do_read(banks[i], pages[i], buffer, spare, TRUE, TRUE) != 0) {
+				nand_bank_reset(banks[i], 100);
+				return FALSE;
+			}
+
+			crc32(&crc, buffer, Geometry.bytesPerPage);
+			if(crc != crcs[i])
+				return FALSE;
+		}
+	}
+
+	return TRUE;
+}
+
+// Only pages already on the flash are read back, from the system blocks,
+// since openiboot has no block of its own to write test patterns to. The
+// controller is held for the whole sweep so nothing else sees a failing
+// timing.
+int nand_calibrate(int save) {
+	int banks[NAND_CALIBRATE_PAGES];
+	int pages[NAND_CALIBRATE_PAGES];
+	uint32_t crcs[NAND_CALIBRATE_PAGES];
+	int count = 0;
+	int bank;
+	int block;
+	uint8_t twp;
+	uint8_t twh;
+
+	if(!HasNANDInit)
+		return ERROR_ARG;
+
+	uint8_t* buffer = malloc_dma(Geometry.bytesPerPage);
+	uint8_t* spare = malloc_dma(Geometry.bytesPerSpare);
+	if(buffer == NULL || spare == NULL) {
+		free(buffer);
+		free(spare);
+		return ERROR_ARG;
+	}
+
+	nand_lock(-1);
+
+	WPPulseTime = TableWPPulseTime;
+	WEHighHoldTime = TableWEHighHoldTime;
+
+	// pages that read back clean at the table timing are the reference
+	for(block = 1; block < FTLData.sysSuBlks && count < NAND_CALIBRATE_PAGES; block++) {
+		for(bank = 0; bank < Geometry.banksTotal && count < NAND_CALIBRATE_PAGES; bank++) {
+			int page = block * Geometry.pagesPerBlock;
+			if(nand_do_read(bank, page, buffer, spare, TRUE, TRUE) != 0)
+				continue;
+
+			banks[count] = bank;
+			pages[count] = page;
+			crcs[count] = 0;
+			crc32(&crcs[count], buffer, Geometry.bytesPerPage);
+			count++;
+		}
+	}
+
+	if(count == 0) {
+		mutex_unlock(&NANDLock);
+		free(buffer);
+		free(spare);
+		bufferPrintf("nand: no pages to calibrate against\r\n");
+		return ERROR_NAND;
+	}
+
+	uint8_t bestWP = TableWPPulseTime;
+	uint8_t bestWH = TableWEHighHoldTime;
+	for(twp = 0; twp <= TableWPPulseTime; twp++) {
+		for(twh = 0; twh <= TableWEHighHoldTime; twh++) {
+			if((twp + twh) >= (bestWP + bestWH))
+				continue;
+
+			WPPulseTime = twp;
+			WEHighHoldTime = twh;
+			if(nand_calibrate_pass(count, banks, pages, crcs, buffer, spare)) {
+				bestWP = twp;
+				bestWH = twh;
+			}
+		}
+	}
+
+	// one cycle of margin over the fastest setting that passed
+	WPPulseTime = (bestWP < TableWPPulseTime) ? (bestWP + 1) : TableWPPulseTime;
+	WEHighHoldTime = (bestWH < TableWEHighHoldTime) ? (bestWH + 1) : TableWEHighHoldTime;
+
+	// and it has to hold up at that too
+	if(!nand_calibrate_pass(count, banks, pages, crcs, buffer, spare)) {
+		WPPulseTime = TableWPPulseTime;
+		WEHighHoldTime = TableWEHighHoldTime;
+	}
+
+	twp = WPPulseTime;
+	twh = WEHighHoldTime;
+	mutex_unlock(&NANDLock);
+
+	free(buffer);
+	free(spare);
+
+	bufferPrintf("nand: calibrated on %d pages: twp=%d twh=%d (table %d/%d)\r\n", count, twp, twh, TableWPPulseTime, TableWEHighHoldTime);
+
+	if(save) {
+		char value[16];
+		sprintf(value, "0x%x", (nand_timing_key() << 8) | (twp << 4) | twh);
+		nvram_setvar(NAND_TIMING_VAR, value);
+		nvram_save();
 	}
 
 	return 0;
 }
 
-int nand_read_alternate_ecc(int bank, int page, uint8_t* buffer) {
+#ifndef NAND_SCHEDULE_PAGES
+#define NAND_SCHEDULE_PAGES 64
+#endif
+
+// Puts count pages into the order they are best sent to the banks in: each
+// bank's pages by block and page, so cache reads and programs follow on, and
+// the banks taken round-robin, so consecutive pages keep different banks busy.
+// order gets indices into bank and pages; the banks have to be valid.
+static void nand_schedule(const uint16_t* bank, const uint32_t* pages, int count, uint16_t* order) {
+	uint16_t sorted[NAND_SCHEDULE_PAGES];
+	int first[NAND_NUM_BANKS];
+	int left[NAND_NUM_BANKS];
+	int i;
+	int j;
+	int b;
+
+	for(b = 0; b < NAND_NUM_BANKS; b++)
+		left[b] = 0;
+
+	for(i = 0; i < count; i++)
+		left[bank[i]]++;
+
+	j = 0;
+	for(b = 0; b < NAND_NUM_BANKS; b++) {
+		first[b] = j;
+		j += left[b];
+	}
+
+	// insertion sort into each bank's run, stable for repeated pages
+	for(b = 0; b < NAND_NUM_BANKS; b++)
+		left[b] = 0;
+
+	for(i = 0; i < count; i++) {
+		b = bank[i];
+		j = first[b] + left[b]++;
+		while(j > first[b] && pages[sorted[j - 1]] > pages[i]) {
+			sorted[j] = sorted[j - 1];
+			j--;
+		}
+		sorted[j] = i;
+	}
+
+	j = 0;
+	while(j < count) {
+		for(b = 0; b < NAND_NUM_BANKS; b++) {
+			if(left[b] == 0)
+				continue;
+
+			order[j++] = sorted[first[b]++];
+			left[b]--;
+		}
+	}
+}
+
+static uint16_t ScheduleOrder[NAND_SCHEDULE_PAGES];
+
+// Reads pages in the order nand_schedule gave, each into its place in main
+// and spare.
+static int nand_do_read_scheduled(uint16_t* bank, uint32_t* pages, uint8_t* main, SpareData* spare, const uint16_t* order, int pagesCount) {
+	int i;
+	int j;
+	int waveCount;
+	unsigned int ret = 0;
+
+	// The main area ECC of each page runs while the next page is transferred,
+	// so the raw spares alternate between two buffers.
+	ECCCheck check;
+	int pending = -1;
+	uint8_t* rawSpares[2] = {aTemporarySBuf, aTemporarySBuf2};
+
+	// The page each bank is loading after a cache read command, or -1.
+	int cacheNext[NAND_NUM_BANKS];
+	for(i = 0; i < NAND_NUM_BANKS; i++)
+		cacheNext[i] = -1;
+
+	// Pages are read in waves: the read command goes out to every bank in the wave
+	// before the first one is drained, so the banks fetch their pages concurrently.
+	// A wave ends at the first bank that is already busy with an earlier page.
+	for(i = 0; i < pagesCount; i += waveCount) {
+		for(waveCount = 0; (i + waveCount) < pagesCount && waveCount < Geometry.banksTotal; waveCount++) {
+			int cur = order[i + waveCount];
+
+			for(j = i; j < (i + waveCount); j++) {
+				if(bank[order[j]] == bank[cur])
+					break;
+			}
+
+			if(j != (i + waveCount))
+				break;
+
+			// If this bank's next page in the list follows on in the same block, let
+			// the bank load it while this one is read out.
+			int follows = FALSE;
+			if(CacheRead && ((pages[cur] + 1) % Geometry.pagesPerBlock) != 0) {
+				for(j = i + waveCount + 1; j < pagesCount; j++) {
+					if(bank[order[j]] == bank[cur]) {
+						follows = (pages[order[j]] == (pages[cur] + 1));
+						break;
+					}
+				}
+			}
+
+			if(cacheNext[bank[cur]] == pages[cur]) {
+				ret = nand_read_issue_cache(bank[cur], !follows);
+			} else {
+				ret = nand_read_issue(bank[cur], pages[cur], TRUE);
+				if(ret == 0 && follows) {
+					ret = wait_for_nand_bank_ready(bank[cur]);
+					if(ret == 0)
+						ret = nand_read_issue_cache(bank[cur], FALSE);
+				}
+			}
+
+			cacheNext[bank[cur]] = (ret == 0 && follows) ? (pages[cur] + 1) : -1;
+
+			if(ret != 0)
+				goto done;
+		}
+
+		for(j = i; j < (i + waveCount); j++) {
+			uint8_t* rawSpare = rawSpares[j & 1];
+			uint8_t* pageMain = main + (order[j] * Geometry.bytesPerPage);
+			unsigned int transferred = nand_read_transfer(bank[order[j]], pageMain, rawSpare);
+
+			if(pending >= 0) {
+				ret = nand_read_verify(main + (order[pending] * Geometry.bytesPerPage), rawSpares[pending & 1], (uint8_t*) &spare[order[pending]], TRUE, TRUE, &check);
+				pending = -1;
+				if(ret > 1)
+					goto done;
+			}
+
+			if(transferred != 0) {
+				ret = transferred;
+				goto done;
+			}
+
+			ecc_check_start(&check, ECCType, pageMain, rawSpare + sizeof(SpareData));
+			pending = j;
+		}
+	}
+
+	ret = 0;
+
+done:
+	if(pending >= 0) {
+		unsigned int verified = nand_read_verify(main + (order[pending] * Geometry.bytesPerPage), rawSpares[pending & 1], (uint8_t*) &spare[order[pending]], TRUE, TRUE, &check);
+		if(ret == 0 && verified > 1)
+			ret = verified;
+	}
+
+	// A bank stopped in the middle of a cache read stays in that mode until reset.
+	for(i = 0; i < NAND_NUM_BANKS; i++) {
+		if(cacheNext[i] != -1)
+			nand_bank_reset(i, 100);
+	}
+
+	return ret;
+}
+
+// The list is taken NAND_SCHEDULE_PAGES at a time, and each of those is read
+// in the order nand_schedule puts it in.
+static int nand_do_read_multiple(uint16_t* bank, uint32_t* pages, uint8_t* main, SpareData* spare, int pagesCount) {
+	int i;
+	int j;
+
+	for(i = 0; i < pagesCount; i += NAND_SCHEDULE_PAGES) {
+		int count = pagesCount - i;
+		if(count > NAND_SCHEDULE_PAGES)
+			count = NAND_SCHEDULE_PAGES;
+
+		for(j = i; j < (i + count); j++) {
+			if(bank[j] >= Geometry.banksTotal || pages[j] >= Geometry.pagesPerBank)
+				return ERROR_ARG;
+		}
+
+		nand_schedule(bank + i, pages + i, count, ScheduleOrder);
+
+		int ret = nand_do_read_scheduled(bank + i, pages + i, main + (i * Geometry.bytesPerPage), spare + i, ScheduleOrder, count);
+		if(ret != 0)
+			return ret;
+	}
+
+	return 0;
+}
+
+// Spare-only version of nand_read_multiple that keeps going past bad pages and
+// leaves the nand_read result of every page in status. The spare of an empty
+// page reads back as all 0xFF.
+static void nand_do_read_spare_multiple(uint16_t* bank, uint32_t* pages, SpareData* spare, int* status, int pagesCount) {
+	int i;
+	int j;
+	int waveCount;
+
+	for(i = 0; i < pagesCount; i += waveCount) {
+		for(waveCount = 0; (i + waveCount) < pagesCount && waveCount < Geometry.banksTotal; waveCount++) {
+			int cur = i + waveCount;
+
+			for(j = i; j < cur; j++) {
+				if(bank[j] == bank[cur])
+					break;
+			}
+
+			if(j != cur)
+				break;
+
+			if(bank[cur] >= Geometry.banksTotal || pages[cur] >= Geometry.pagesPerBank)
+				status[cur] = ERROR_ARG;
+			else
+				status[cur] = nand_read_issue(bank[cur], pages[cur], FALSE);
+		}
+
+		for(j = i; j < (i + waveCount); j++) {
+			if(status[j] == 0)
+				status[j] = nand_read_finish(bank[j], NULL, (uint8_t*) &spare[j], TRUE, TRUE);
+
+			if(status[j] == ERROR_EMPTYBLOCK)
+				memset(&spare[j], 0xFF, sizeof(SpareData));
+		}
+	}
+}
+
+static int nand_do_read_alternate_ecc(int bank, int page, uint8_t* buffer) {
 	int ret;
-	if((ret = nand_read(bank, page, buffer, aTemporarySBuf, FALSE, TRUE)) != 0) {
-		DebugPrintf("nand: Raw read failed.\r\n");
+	if((ret = nand_do_read(bank, page, buffer, aTemporarySBuf, FALSE, TRUE)) != 0) {
+		LogDebug(LogNAND, "nand: Raw read failed.\r\n");
 		return ret;
 	}
 
-	if(checkECC(ECCType2, buffer, aTemporarySBuf) != 0) {
-		DebugPrintf("nand: Alternate ECC check failed, but raw read succeeded.\r\n");
+	ECCCheck check;
+	ecc_check_start(&check, ECCType2, buffer, aTemporarySBuf);
+	if(ecc_check_finish(&check) != 0 && (isEmptyBlock(aTemporarySBuf, Geometry.bytesPerSpare) != 0 || ecc_recover(&check, buffer, aTemporarySBuf) != 0)) {
+		LogDebug(LogNAND, "nand: Alternate ECC check failed, but raw read succeeded.\r\n");
 		return ERROR_NAND;
 	}
 
 	return 0;
 }
 
+
+// Take the controller for a synchronous operation on a bank, or on all of them
+// for -1. Queued operations still in flight there are let finish first.
+static void nand_lock(int bank) {
+	while(TRUE) {
+		int i;
+		mutex_lock(&NANDLock);
+		for(i = 0; i < NAND_NUM_BANKS; i++) {
+			if(BankRequest[i] != NULL && (bank == -1 || bank == i))
+				break;
+		}
+
+		if(i == NAND_NUM_BANKS)
+			return;
+
+		mutex_unlock(&NANDLock);
+		task_yield();
+	}
+}
+
+int nand_read(int bank, int page, uint8_t* buffer, uint8_t* spare, int doECC, int checkBlank) {
+	if(bank >= Geometry.banksTotal)
+		return ERROR_ARG;
+
+	nand_lock(bank);
+	uint64_t start = latency_start();
+	int ret = nand_do_read(bank, page, buffer, spare, doECC, checkBlank);
+	latency_record(LatencyNANDRead, LATENCY_NAND_ADDRESS(bank, page), 1, start);
+	LogTrace(LogNAND, "nand: read bank %d page 0x%x: %d\r\n", bank, page, ret);
+	mutex_unlock(&NANDLock);
+	return ret;
+}
+
+int nand_write(int bank, int page, uint8_t* buffer, uint8_t* spare, int doECC) {
+	if(bank >= Geometry.banksTotal)
+		return ERROR_ARG;
+
+	nand_lock(bank);
+	uint64_t start = latency_start();
+	int ret = nand_do_write(bank, page, buffer, spare, doECC);
+	latency_record(LatencyNANDWrite, LATENCY_NAND_ADDRESS(bank, page), 1, start);
+	LogTrace(LogNAND, "nand: wrote bank %d page 0x%x: %d\r\n", bank, page, ret);
+	mutex_unlock(&NANDLock);
+	return ret;
+}
+
+int nand_erase(int bank, int block) {
+	if(bank >= Geometry.banksTotal)
+		return ERROR_ARG;
+
+	nand_lock(bank);
+	uint64_t start = latency_start();
+	int ret = nand_do_erase(bank, block);
+	latency_record(LatencyNANDErase, LATENCY_NAND_ADDRESS(bank, block), 1, start);
+	LogTrace(LogNAND, "nand: erased bank %d block 0x%x: %d\r\n", bank, block, ret);
+	mutex_unlock(&NANDLock);
+	return ret;
+}
+
+int nand_read_multiple(uint16_t* bank, uint32_t* pages, uint8_t* main, SpareData* spare, int pagesCount) {
+	nand_lock(-1);
+	uint64_t start = latency_start();
+	int ret = nand_do_read_multiple(bank, pages, main, spare, pagesCount);
+	latency_record(LatencyNANDReadMultiple, (pagesCount > 0) ? LATENCY_NAND_ADDRESS(bank[0], pages[0]) : 0, pagesCount, start);
+	mutex_unlock(&NANDLock);
+	return ret;
+}
+
+void nand_read_spare_multiple(uint16_t* bank, uint32_t* pages, SpareData* spare, int* status, int pagesCount) {
+	nand_lock(-1);
+	nand_do_read_spare_multiple(bank, pages, spare, status, pagesCount);
+	mutex_unlock(&NANDLock);
+}
+
+int nand_read_alternate_ecc(int bank, int page, uint8_t* buffer) {
+	if(bank >= Geometry.banksTotal)
+		return ERROR_ARG;
+
+	nand_lock(bank);
+	int ret = nand_do_read_alternate_ecc(bank, page, buffer);
+	mutex_unlock(&NANDLock);
+	return ret;
+}
+
+// Request queue. Each bank works on at most one queued request at a time, and
+// requests for a bank are started in the order they were submitted. While one
+// bank is busy erasing or programming, the others are free to be used.
+
+#ifndef NAND_QUEUE_TIMEOUT
+#define NAND_QUEUE_TIMEOUT 500000
+#endif
+
+// Read the status register of a bank once, without waiting for it to go ready.
+static int nand_bank_poll(int bank, uint32_t* status) {
+	SET_REG(NAND + FMCTRL0,
+			((WEHighHoldTime & FMCTRL_TWH_MASK) << FMCTRL_TWH_SHIFT) | ((WPPulseTime & FMCTRL_TWP_MASK) << FMCTRL_TWP_SHIFT)
+			| (1 << (banksTable[bank] + 1)) | FMCTRL0_ON | FMCTRL0_WPB);
+
+	SET_REG(NAND + FMCTRL1, FMCTRL1_FLUSHFIFOS);
+	SET_REG(NAND + NAND_CMD, NAND_CMD_READSTATUS);
+	wait_for_ready(500);
+
+	SET_REG(NAND + FMDNUM, 0);
+	SET_REG(NAND + FMCTRL1, FMCTRL1_DOREADDATA);
+
+	if(wait_for_transfer_done(500) != 0)
+		return ERROR_TIMEOUT;
+
+	*status = GET_REG(NAND + FMFIFO);
+	SET_REG(NAND + FMCTRL1, FMCTRL1_FLUSHRXFIFO);
+	return 0;
+}
+
+// Programs pages in the order nand_schedule gave, in waves like the reads: every
+// bank in a wave is sent its page before the first one is waited on.
+static int nand_do_write_scheduled(uint16_t* bank, uint32_t* pages, uint8_t* main, SpareData* spare, int* status, const uint16_t* order, int pagesCount) {
+	int i;
+	int j;
+	int waveCount;
+	int ret = 0;
+
+	for(i = 0; i < pagesCount; i += waveCount) {
+		for(waveCount = 0; (i + waveCount) < pagesCount && waveCount < Geometry.banksTotal; waveCount++) {
+			int cur = order[i + waveCount];
+
+			for(j = i; j < (i + waveCount); j++) {
+				if(bank[order[j]] == bank[cur])
+					break;
+			}
+
+			if(j != (i + waveCount))
+				break;
+
+			status[cur] = nand_write_issue(bank[cur], pages[cur], main + (cur * Geometry.bytesPerPage), (uint8_t*) &spare[cur], TRUE);
+		}
+
+		for(j = i; j < (i + waveCount); j++) {
+			int cur = order[j];
+			if(status[cur] != 0) {
+				ret = -1;
+				continue;
+			}
+
+			uint64_t started = timer_get_system_microtime();
+			uint32_t bankStatus;
+			while(TRUE) {
+				if(nand_bank_poll(bank[cur], &bankStatus) == 0 && (bankStatus & (1 << 6)) != 0) {
+					status[cur] = (bankStatus & 0x1) ? -1 : 0;
+					break;
+				}
+
+				if(has_elapsed(started, NAND_QUEUE_TIMEOUT)) {
+					bufferPrintf("nand: bank %d timed out programming page 0x%x\r\n", bank[cur], pages[cur]);
+					nand_bank_reset(bank[cur], 100);
+					status[cur] = ERROR_TIMEOUT;
+					break;
+				}
+			}
+
+			if(status[cur] != 0)
+				ret = -1;
+		}
+	}
+
+	return ret;
+}
+
+int nand_write_multiple(uint16_t* bank, uint32_t* pages, uint8_t* main, SpareData* spare, int* status, int pagesCount) {
+	int ret = 0;
+	int i;
+	int j;
+
+	nand_lock(-1);
+	uint64_t start = latency_start();
+	for(i = 0; i < pagesCount; i += NAND_SCHEDULE_PAGES) {
+		int count = pagesCount - i;
+		if(count > NAND_SCHEDULE_PAGES)
+			count = NAND_SCHEDULE_PAGES;
+
+		int valid = TRUE;
+		for(j = i; j < (i + count); j++) {
+			status[j] = ERROR_ARG;
+			if(bank[j] >= Geometry.banksTotal || pages[j] >= Geometry.pagesPerBank)
+				valid = FALSE;
+		}
+
+		if(!valid) {
+			ret = -1;
+			continue;
+		}
+
+		nand_schedule(bank + i, pages + i, count, ScheduleOrder);
+
+		if(nand_do_write_scheduled(bank + i, pages + i, main + (i * Geometry.bytesPerPage), spare + i, status + i, ScheduleOrder, count) != 0)
+			ret = -1;
+	}
+	latency_record(LatencyNANDWriteMultiple, (pagesCount > 0) ? LATENCY_NAND_ADDRESS(bank[0], pages[0]) : 0, pagesCount, start);
+	mutex_unlock(&NANDLock);
+	return ret;
+}
+
+static int nand_request_start(NANDRequest* request) {
+	switch(request->operation) {
+		case NANDOperationRead:
+			if(request->page >= Geometry.pagesPerBank || (request->buffer == NULL && request->spare == NULL))
+				return ERROR_ARG;
+
+			return nand_read_issue(request->bank, request->page, request->buffer != NULL);
+
+		case NANDOperationWrite:
+			return nand_write_issue(request->bank, request->page, request->buffer, request->spare, request->doECC);
+
+		case NANDOperationErase:
+			return nand_erase_issue(request->bank, request->page);
+	}
+
+	return ERROR_ARG;
+}
+
+// Finish the requests whose banks have gone ready and start the ones waiting
+// on a free bank. Finished requests are handed back through finished. Returns
+// whether anything is still queued or in flight.
+static int nand_queue_run(NANDRequest** finished) {
+	int bank;
+	int busy = FALSE;
+	for(bank = 0; bank < Geometry.banksTotal; bank++) {
+		NANDRequest* request = BankRequest[bank];
+		if(request == NULL)
+			continue;
+
+		uint32_t status;
+		if(nand_bank_poll(bank, &status) != 0 || (status & (1 << 6)) == 0) {
+			if(!has_elapsed(request->started, NAND_QUEUE_TIMEOUT)) {
+				busy = TRUE;
+				continue;
+			}
+
+			bufferPrintf("nand: bank %d timed out on a queued request\r\n", bank);
+			nand_bank_reset(bank, 100);
+			request->status = ERROR_TIMEOUT;
+		} else if(request->operation == NANDOperationRead) {
+			request->status = nand_read_finish(bank, request->buffer, request->spare, request->doECC, TRUE);
+		} else {
+			request->status = (status & 0x1) ? -1 : 0;
+		}
+
+		BankRequest[bank] = NULL;
+		request->next = *finished;
+		*finished = request;
+	}
+
+	uint32_t waiting = 0;
+	NANDRequest** link = &NANDQueue;
+	while(*link != NULL) {
+		NANDRequest* request = *link;
+		uint32_t bit = 1 << request->bank;
+		if(BankRequest[request->bank] != NULL || (waiting & bit) != 0) {
+			waiting |= bit;
+			link = &request->next;
+			busy = TRUE;
+			continue;
+		}
+
+		*link = request->next;
+
+		int ret = nand_request_start(request);
+		if(ret != 0) {
+			request->status = ret;
+			request->next = *finished;
+			*finished = request;
+			continue;
+		}
+
+		request->started = timer_get_system_microtime();
+		BankRequest[request->bank] = request;
+		busy = TRUE;
+	}
+
+	return busy;
+}
+
+static void nand_queue_task(void* opaque) {
+	while(TRUE) {
+		NANDRequest* finished = NULL;
+
+		mutex_lock(&NANDLock);
+		int busy = nand_queue_run(&finished);
+		mutex_unlock(&NANDLock);
+
+		// the callback may resubmit or free the request
+		while(finished != NULL) {
+			NANDRequest* request = finished;
+			finished = request->next;
+			if(request->callback)
+				request->callback(request, request->opaque);
+			completion_signal(&request->completion);
+		}
+
+		if(busy)
+			task_yield();
+		else
+			semaphore_wait(&NANDQueueSignal);
+	}
+}
+
+void nand_submit(NANDRequest* request) {
+	completion_init(&request->completion);
+	request->status = 0;
+	request->next = NULL;
+
+	if(!HasNANDInit || request->bank < 0 || request->bank >= Geometry.banksTotal) {
+		request->status = ERROR_ARG;
+		if(request->callback)
+			request->callback(request, request->opaque);
+		completion_signal(&request->completion);
+		return;
+	}
+
+	mutex_lock(&NANDLock);
+	NANDRequest** link = &NANDQueue;
+	while(*link != NULL)
+		link = &(*link)->next;
+	*link = request;
+	mutex_unlock(&NANDLock);
+
+	semaphore_signal(&NANDQueueSignal);
+}
+
+int nand_wait(NANDRequest* request) {
+	while(completion_wait(&request->completion, NAND_QUEUE_TIMEOUT) != 0);
+	return request->status;
+}
@@ -0,0 +1,242 @@
+#include "openiboot.h"
+#include "openiboot-asmhelpers.h"
+#include "nanddump.h"
+#include "nand.h"
+#include "tasks.h"
+#include "util.h"
+#include "hardware/nand.h"
+
+static NANDDumpHeader* DumpHeader = NULL;
+static uint8_t* DumpBuffers[NANDDUMP_BUFFERS];
+static uint32_t DumpBufferSize = 0;
+static Semaphore DumpSignal;
+static int DumpTaskStarted = FALSE;
+
+static uint16_t DumpBanks[NAND_NUM_BANKS * NANDDUMP_PAGES];
+static uint32_t DumpPageList[NAND_NUM_BANKS * NANDDUMP_PAGES];
+static SpareData DumpSpares[NAND_NUM_BANKS * NANDDUMP_PAGES];
+
+static uint32_t DumpFirst;
+static uint32_t DumpPages;
+static uint32_t DumpBatches;
+static NANDDumpReadyHandler DumpReady;
+
+// Things sent are counted with the header as the first, so batch n goes out
+// as number n + 1. The task fills batch n into buffer n % NANDDUMP_BUFFERS
+// once the batch that was there before has been sent.
+static volatile uint32_t DumpSent;
+static volatile uint32_t DumpFilled;
+static volatile int DumpActive = FALSE;
+
+// Bumped on every start and stop, so a batch read for a dump that has been
+// stopped in the meantime is thrown away.
+static volatile uint32_t DumpGeneration = 0;
+
+static uint32_t batch_pages(uint32_t batch)
+{
+	uint32_t left = DumpPages - (batch * NANDDUMP_PAGES);
+	return (left > NANDDUMP_PAGES) ? NANDDUMP_PAGES : left;
+}
+
+static uint32_t batch_length(uint32_t batch)
+{
+	NANDData* geometry = nand_get_geometry();
+	return batch_pages(batch) * geometry->banksTotal * (geometry->bytesPerPage + sizeof(NANDDumpSpare));
+}
+
+static uint32_t batches_sent()
+{
+	return (DumpSent > 0) ? (DumpSent - 1) : 0;
+}
+
+static void nanddump_fill(uint32_t batch)
+{
+	NANDData* geometry = nand_get_geometry();
+	uint8_t* buffer = DumpBuffers[batch % NANDDUMP_BUFFERS];
+	uint32_t page = DumpFirst + (batch * NANDDUMP_PAGES);
+	int count = batch_pages(batch) * geometry->banksTotal;
+	NANDDumpSpare* spares = (NANDDumpSpare*)(buffer + (count * geometry->bytesPerPage));
+	int i;
+
+	for(i = 0; i < count; i++)
+	{
+		DumpBanks[i] = i % geometry->banksTotal;
+		DumpPageList[i] = page + (i / geometry->banksTotal);
+	}
+
+	if(nand_read_multiple(DumpBanks, DumpPageList, buffer, DumpSpares, count) == 0)
+	{
+		for(i = 0; i < count; i++)
+		{
+			memcpy(&spares[i].spare, &DumpSpares[i], sizeof(SpareData));
+			spares[i].status = 0;
+		}
+		return;
+	}
+
+	// one bad or empty page stops the whole read, so go through them one at a time
+	for(i = 0; i < count; i++)
+	{
+		memset(&spares[i].spare, 0xFF, sizeof(SpareData));
+		spares[i].status = nand_read(DumpBanks[i], DumpPageList[i], buffer + (i * geometry->bytesPerPage),
+				(uint8_t*) &spares[i].spare, TRUE, FALSE);
+	}
+}
+
+static void nanddump_task(void* opaque)
+{
+	while(TRUE)
+	{
+		semaphore_wait(&DumpSignal);
+
+		while(DumpActive && DumpFilled < DumpBatches && DumpFilled < (batches_sent() + NANDDUMP_BUFFERS))
+		{
+			uint32_t generation = DumpGeneration;
+			nanddump_fill(DumpFilled);
+
+			if(generation != DumpGeneration)
+				break;
+
+			DumpFilled++;
+			if(DumpReady)
+				DumpReady();
+		}
+	}
+}
+
+uint64_t nanddump_start(uint32_t firstPage, uint32_t pages, NANDDumpReadyHandler ready)
+{
+	NANDData* geometry;
+	int i;
+
+	if(!HasNANDInit)
+	{
+		bufferPrintf("nanddump: NAND not initialized\r\n");
+		return 0;
+	}
+
+	geometry = nand_get_geometry();
+	if(pages == 0 || firstPage >= geometry->pagesPerBank || pages > (geometry->pagesPerBank - firstPage))
+	{
+		bufferPrintf("nanddump: pages 0x%x - 0x%x are out of range\r\n", firstPage, firstPage + pages - 1);
+		return 0;
+	}
+
+	nanddump_stop();
+
+	if(DumpHeader == NULL)
+	{
+		DumpBufferSize = NANDDUMP_PAGES * geometry->banksTotal * (geometry->bytesPerPage + sizeof(NANDDumpSpare));
+
+		DumpHeader = (NANDDumpHeader*) malloc_dma(sizeof(NANDDumpHeader));
+		for(i = 0; i < NANDDUMP_BUFFERS; i++)
+			DumpBuffers[i] = malloc_dma(DumpBufferSize);
+
+		for(i = 0; i < NANDDUMP_BUFFERS; i++)
+		{
+			if(DumpHeader == NULL || DumpBuffers[i] == NULL)
+				break;
+		}
+
+		if(i != NANDDUMP_BUFFERS)
+		{
+			bufferPrintf("nanddump: out of memory\r\n");
+			if(DumpHeader)
+				free(DumpHeader);
+			for(i = 0; i < NANDDUMP_BUFFERS; i++)
+			{
+				if(DumpBuffers[i])
+					free(DumpBuffers[i]);
+				DumpBuffers[i] = NULL;
+			}
+			DumpHeader = NULL;
+			return 0;
+		}
+	}
+
+	if(!DumpTaskStarted)
+	{
+		semaphore_init(&DumpSignal, 0);
+		if(task_create("nanddump", nanddump_task, NULL, 0) == NULL)
+		{
+			bufferPrintf("nanddump: could not start the dump task\r\n");
+			return 0;
+		}
+		DumpTaskStarted = TRUE;
+	}
+
+	DumpHeader->magic = NANDDUMP_MAGIC;
+	DumpHeader->banks = geometry->banksTotal;
+	DumpHeader->bytesPerPage = geometry->bytesPerPage;
+	DumpHeader->bytesPerSpare = sizeof(NANDDumpSpare);
+	DumpHeader->firstPage = firstPage;
+	DumpHeader->pages = pages;
+	DumpHeader->pagesPerBatch = NANDDUMP_PAGES;
+	DumpHeader->reserved = 0;
+
+	EnterCriticalSection();
+	DumpGeneration++;
+	DumpFirst = firstPage;
+	DumpPages = pages;
+	DumpBatches = (pages + NANDDUMP_PAGES - 1) / NANDDUMP_PAGES;
+	DumpReady = ready;
+	DumpSent = 0;
+	DumpFilled = 0;
+	DumpActive = TRUE;
+	LeaveCriticalSection();
+
+	semaphore_signal(&DumpSignal);
+
+	return sizeof(NANDDumpHeader)
+		+ ((uint64_t) pages * geometry->banksTotal * (geometry->bytesPerPage + sizeof(NANDDumpSpare)));
+}
+
+uint8_t* nanddump_peek(uint32_t* length)
+{
+	uint32_t batch;
+
+	if(!DumpActive)
+		return NULL;
+
+	if(DumpSent == 0)
+	{
+		*length = sizeof(NANDDumpHeader);
+		return (uint8_t*) DumpHeader;
+	}
+
+	batch = DumpSent - 1;
+	if(batch >= DumpFilled)
+		return NULL;
+
+	*length = batch_length(batch);
+	return DumpBuffers[batch % NANDDUMP_BUFFERS];
+}
+
+void nanddump_consume()
+{
+	if(!DumpActive)
+		return;
+
+	DumpSent++;
+	if(batches_sent() >= DumpBatches)
+	{
+		DumpActive = FALSE;
+		DumpGeneration++;
+		return;
+	}
+
+	semaphore_signal(&DumpSignal);
+}
+
+void nanddump_stop()
+{
+	EnterCriticalSection();
+	DumpActive = FALSE;
+	DumpGeneration++;
+	LeaveCriticalSection();
+}
+
+int nanddump_active()
+{
+	return DumpActive;
+}
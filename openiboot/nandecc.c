@@ -0,0 +1,407 @@
+#include "openiboot.h"
+#include "nandecc.h"
+#include "util.h"
+
+// The code as far as the engine's is known. A sector is read as a little
+// endian bit stream of ten bit symbols, the first of them the highest power,
+// and the parity symbols follow it the same way.
+#define GF_BITS 10
+#define GF_SIZE (1 << GF_BITS)
+#define GF_POLY 0x409		// x^10 + x^3 + 1
+#define RS_FCR 1		// the generator's roots are alpha^1 to alpha^(2 * strength)
+
+// 410 symbols, the last of which only has six bits of the sector in it
+#define DATA_SYMBOLS (((NANDECC_SECTOR_SIZE * 8) + GF_BITS - 1) / GF_BITS)
+#define MAX_PARITY (2 * NANDECC_MAX_STRENGTH)
+
+static uint16_t GFExp[2 * GF_SIZE];
+static uint16_t GFLog[GF_SIZE];
+static int GFReady = FALSE;
+
+// The parity register keeps two symbols to a word, the highest power in the
+// low half of the first one. feedback has a whole register's worth of
+// generator multiples for each symbol fed back, so a data symbol is taken in
+// with a shift and an XOR per word.
+typedef struct RSCode {
+	int strength;
+	int parity;
+	int words;
+	uint16_t generator[MAX_PARITY + 1];
+	uint32_t* feedback;
+} RSCode;
+
+static RSCode Codes[3];
+
+static inline uint16_t gf_mul(uint16_t a, uint16_t b) {
+	if(a == 0 || b == 0)
+		return 0;
+
+	return GFExp[GFLog[a] + GFLog[b]];
+}
+
+static inline uint16_t gf_div(uint16_t a, uint16_t b) {
+	if(a == 0)
+		return 0;
+
+	return GFExp[GFLog[a] + (GF_SIZE - 1) - GFLog[b]];
+}
+
+static void gf_init() {
+	uint32_t x = 1;
+	int i;
+
+	for(i = 0; i < (GF_SIZE - 1); i++) {
+		GFExp[i] = x;
+		GFLog[x] = i;
+		x <<= 1;
+		if(x & GF_SIZE)
+			x ^= GF_POLY;
+	}
+
+	for(; i < (2 * GF_SIZE); i++)
+		GFExp[i] = GFExp[i - (GF_SIZE - 1)];
+
+	GFLog[0] = 0;
+	GFReady = TRUE;
+}
+
+static RSCode* rs_code(int strength) {
+	RSCode* code;
+	int i;
+	int k;
+
+	if(strength == 4)
+		code = &Codes[0];
+	else if(strength == 6)
+		code = &Codes[1];
+	else if(strength == 8)
+		code = &Codes[2];
+	else
+		return NULL;
+
+	if(code->feedback != NULL)
+		return code;
+
+	if(!GFReady)
+		gf_init();
+
+	code->strength = strength;
+	code->parity = 2 * strength;
+	code->words = strength;
+
+	// the product of (x + alpha^i) over the roots, coefficient k of x^k
+	memset(code->generator, 0, sizeof(code->generator));
+	code->generator[0] = 1;
+	for(i = 0; i < code->parity; i++) {
+		uint16_t root = GFExp[RS_FCR + i];
+		code->generator[i + 1] = code->generator[i];
+		for(k = i; k > 0; k--)
+			code->generator[k] = code->generator[k - 1] ^ gf_mul(code->generator[k], root);
+		code->generator[0] = gf_mul(code->generator[0], root);
+	}
+
+	uint32_t* feedback = (uint32_t*) malloc(GF_SIZE * code->words * sizeof(uint32_t));
+	if(feedback == NULL)
+		return NULL;
+
+	for(i = 0; i < GF_SIZE; i++) {
+		uint32_t* row = feedback + (i * code->words);
+		memset(row, 0, code->words * sizeof(uint32_t));
+		for(k = 0; k < code->parity; k++)
+			row[k / 2] |= ((uint32_t) gf_mul(i, code->generator[code->parity - 1 - k])) << ((k & 1) * 16);
+	}
+
+	code->feedback = feedback;
+	return code;
+}
+
+static inline uint16_t get_symbol(const uint8_t* bytes, int index) {
+	int bit = index * GF_BITS;
+	const uint8_t* p = bytes + (bit / 8);
+	return ((p[0] | (p[1] << 8)) >> (bit % 8)) & (GF_SIZE - 1);
+}
+
+// The remainder of the sector times x^parity by the generator, symbol k of it
+// the coefficient of x^(parity - 1 - k). Inlined for each strength, so that
+// the loops over the register words are unrolled.
+static inline __attribute__((always_inline)) void rs_remainder_words(RSCode* code, const int words, const uint8_t* sector, uint16_t* parity) {
+	uint32_t reg[NANDECC_MAX_STRENGTH];
+	const uint8_t* p = sector;
+	int i;
+	int w;
+
+	for(w = 0; w < words; w++)
+		reg[w] = 0;
+
+#define RS_FEED(symbol) \
+	do { \
+		const uint32_t* fb = code->feedback + ((((symbol) ^ reg[0]) & (GF_SIZE - 1)) * words); \
+		for(w = 0; w < (words - 1); w++) \
+			reg[w] = ((reg[w] >> 16) | (reg[w + 1] << 16)) ^ fb[w]; \
+		reg[words - 1] = (reg[words - 1] >> 16) ^ fb[words - 1]; \
+	} while(0)
+
+	// five bytes are four whole symbols
+	for(i = 0; i < (NANDECC_SECTOR_SIZE / 5); i++, p += 5) {
+		uint32_t low = p[0] | (p[1] << 8) | (p[2] << 16) | (p[3] << 24);
+		uint32_t high = p[4];
+		RS_FEED(low);
+		RS_FEED(low >> 10);
+		RS_FEED(low >> 20);
+		RS_FEED((low >> 30) | (high << 2));
+	}
+
+	// 512 is two bytes past the last group: a symbol and six bits of another
+	uint32_t tail = p[0] | (p[1] << 8);
+	RS_FEED(tail);
+	RS_FEED(tail >> 10);
+
+#undef RS_FEED
+
+	for(i = 0; i < code->parity; i++)
+		parity[i] = (reg[i / 2] >> ((i & 1) * 16)) & (GF_SIZE - 1);
+}
+
+static void rs_remainder(RSCode* code, const uint8_t* sector, uint16_t* parity) {
+	switch(code->words) {
+		case 4:
+			rs_remainder_words(code, 4, sector, parity);
+			break;
+		case 6:
+			rs_remainder_words(code, 6, sector, parity);
+			break;
+		default:
+			rs_remainder_words(code, 8, sector, parity);
+			break;
+	}
+}
+
+static void pack_parity(RSCode* code, const uint16_t* parity, uint8_t* ecc) {
+	int i;
+
+	memset(ecc, 0, code->parity * GF_BITS / 8);
+	for(i = 0; i < code->parity; i++) {
+		int bit = i * GF_BITS;
+		ecc[bit / 8] |= (parity[i] << (bit % 8)) & 0xFF;
+		ecc[(bit / 8) + 1] |= parity[i] >> (8 - (bit % 8));
+	}
+}
+
+// Flips the bits of value into symbol index of a bit stream.
+static void xor_symbol(uint8_t* bytes, int index, uint16_t value) {
+	int bit = index * GF_BITS;
+	int i;
+
+	for(i = 0; i < GF_BITS; i++) {
+		if(value & (1 << i))
+			bytes[(bit + i) / 8] ^= 1 << ((bit + i) % 8);
+	}
+}
+
+int nandecc_bytes(int strength) {
+	if(strength != 4 && strength != 6 && strength != 8)
+		return 0;
+
+	return (2 * strength * GF_BITS) / 8;
+}
+
+void nandecc_encode(int strength, const uint8_t* sector, uint8_t* ecc) {
+	uint16_t parity[MAX_PARITY];
+	RSCode* code = rs_code(strength);
+
+	if(code == NULL)
+		return;
+
+	rs_remainder(code, sector, parity);
+	pack_parity(code, parity, ecc);
+}
+
+int nandecc_correct(int strength, uint8_t* sector, uint8_t* ecc) {
+	uint16_t computed[MAX_PARITY];
+	uint16_t syndromes[MAX_PARITY];
+	uint16_t lambda[MAX_PARITY + 1];
+	uint16_t previous[MAX_PARITY + 1];
+	uint16_t omega[MAX_PARITY];
+	int positions[NANDECC_MAX_STRENGTH];
+	uint16_t values[NANDECC_MAX_STRENGTH];
+	int found = 0;
+	int degree = 0;
+	int i;
+	int k;
+
+	RSCode* code = rs_code(strength);
+	if(code == NULL)
+		return -1;
+
+	const int parity = code->parity;
+	const int n = DATA_SYMBOLS + parity;
+
+	// The received parity plus the one the data should have is the received
+	// word's remainder by the generator, so it has the same syndromes. Clean
+	// sectors, nearly all of them, stop at the compare.
+	rs_remainder(code, sector, computed);
+
+	int clean = TRUE;
+	for(i = 0; i < parity; i++) {
+		computed[i] ^= get_symbol(ecc, i);
+		if(computed[i] != 0)
+			clean = FALSE;
+	}
+
+	if(clean)
+		return 0;
+
+	for(i = 0; i < parity; i++) {
+		uint16_t root = GFExp[RS_FCR + i];
+		uint16_t s = 0;
+		for(k = 0; k < parity; k++)
+			s = gf_mul(s, root) ^ computed[k];
+		syndromes[i] = s;
+	}
+
+	// Berlekamp-Massey for the error locator
+	uint16_t lastDiscrepancy = 1;
+	int shift = 1;
+
+	memset(lambda, 0, sizeof(lambda));
+	memset(previous, 0, sizeof(previous));
+	lambda[0] = 1;
+	previous[0] = 1;
+
+	for(i = 0; i < parity; i++) {
+		uint16_t d = syndromes[i];
+		for(k = 1; k <= degree; k++)
+			d ^= gf_mul(lambda[k], syndromes[i - k]);
+
+		if(d == 0) {
+			shift++;
+			continue;
+		}
+
+		uint16_t scale = gf_div(d, lastDiscrepancy);
+		if((2 * degree) <= i) {
+			uint16_t saved[MAX_PARITY + 1];
+			memcpy(saved, lambda, sizeof(saved));
+			for(k = 0; (k + shift) <= parity; k++)
+				lambda[k + shift] ^= gf_mul(scale, previous[k]);
+
+			degree = i + 1 - degree;
+			memcpy(previous, saved, sizeof(previous));
+			lastDiscrepancy = d;
+			shift = 1;
+		} else {
+			for(k = 0; (k + shift) <= parity; k++)
+				lambda[k + shift] ^= gf_mul(scale, previous[k]);
+
+			shift++;
+		}
+	}
+
+	if(degree > strength)
+		return -1;
+
+	// Chien search: the error at power d of the code word makes alpha^-d a root
+	for(i = 0; i < n && found <= degree; i++) {
+		uint16_t sum = 1;
+		for(k = 1; k <= degree; k++) {
+			if(lambda[k] != 0)
+				sum ^= GFExp[(GFLog[lambda[k]] + ((GF_SIZE - 1 - i) * k) % (GF_SIZE - 1)) % (GF_SIZE - 1)];
+		}
+
+		if(sum != 0)
+			continue;
+
+		if(found == degree)
+			return -1;
+
+		positions[found++] = i;
+	}
+
+	if(found != degree)
+		return -1;
+
+	for(i = 0; i < parity; i++) {
+		uint16_t s = 0;
+		for(k = 0; k <= i; k++)
+			s ^= gf_mul(syndromes[i - k], lambda[k]);
+		omega[i] = s;
+	}
+
+	// Forney for the values, checked all before anything is changed
+	for(i = 0; i < found; i++) {
+		int power = positions[i];
+		int inverse = (GF_SIZE - 1 - power) % (GF_SIZE - 1);
+		uint16_t numerator = 0;
+		uint16_t denominator = 0;
+
+		for(k = 0; k < parity; k++) {
+			if(omega[k] != 0)
+				numerator ^= GFExp[(GFLog[omega[k]] + (inverse * k) % (GF_SIZE - 1)) % (GF_SIZE - 1)];
+		}
+
+		for(k = 1; k <= degree; k += 2) {
+			if(lambda[k] != 0)
+				denominator ^= GFExp[(GFLog[lambda[k]] + (inverse * (k - 1)) % (GF_SIZE - 1)) % (GF_SIZE - 1)];
+		}
+
+		if(denominator == 0)
+			return -1;
+
+		uint16_t value = gf_div(numerator, denominator);
+		int scale = ((1 - RS_FCR) * power) % (GF_SIZE - 1);
+		if(scale < 0)
+			scale += GF_SIZE - 1;
+		value = gf_mul(value, GFExp[scale]);
+
+		int index = n - 1 - power;
+		if(index == (DATA_SYMBOLS - 1) && (value >> ((NANDECC_SECTOR_SIZE * 8) - (index * GF_BITS))) != 0)
+			return -1;	// the padding past the sector is always zero
+
+		values[i] = value;
+	}
+
+	for(i = 0; i < found; i++) {
+		int index = n - 1 - positions[i];
+		if(index < DATA_SYMBOLS)
+			xor_symbol(sector, index, values[i]);
+		else
+			xor_symbol(ecc, index - DATA_SYMBOLS, values[i]);
+	}
+
+	return found;
+}
+
+int nandecc_correct_page(int strength, int sectors, int flags, uint8_t* data, uint8_t* ecc) {
+	uint8_t parity[MAX_PARITY * GF_BITS / 8];
+	int eccBytes = nandecc_bytes(strength);
+	int total = 0;
+	int i;
+	int k;
+
+	if(eccBytes == 0)
+		return -1;
+
+	for(i = 0; i < sectors; i++) {
+		uint8_t* sectorECC = ecc + (i * eccBytes);
+		int ret;
+
+		if(flags & NANDECC_REVERSED) {
+			for(k = 0; k < eccBytes; k++)
+				parity[k] = sectorECC[eccBytes - 1 - k];
+
+			ret = nandecc_correct(strength, data + (i * NANDECC_SECTOR_SIZE), parity);
+
+			for(k = 0; k < eccBytes; k++)
+				sectorECC[eccBytes - 1 - k] = parity[k];
+		} else {
+			ret = nandecc_correct(strength, data + (i * NANDECC_SECTOR_SIZE), sectorECC);
+		}
+
+		if(ret < 0)
+			return -1;
+
+		total += ret;
+	}
+
+	return total;
+}
@@ -33,29 +33,38 @@ static void nor_unprepare() {
 	Prepared--;
 }
 
+#ifdef CONFIG_3G
+// One command to the chip, chip select held for the data phase after it
+static int nor_spi(const uint8_t* command, int commandLen, SPIDirection direction, void* data, int len) {
+	SPITransaction transaction;
+	memset(&transaction, 0, sizeof(transaction));
+	transaction.cs = GPIO_SPI0_CS0;
+	transaction.command = command;
+	transaction.commandLen = commandLen;
+	transaction.direction = direction;
+	transaction.out = data;
+	transaction.in = data;
+	transaction.dataLen = len;
+	return spi_transaction(0, &transaction);
+}
+#endif
+
 static NorInfo* probeNOR() {
 	nor_prepare();
 
 #ifdef CONFIG_3G
 	uint8_t command = NOR_SPI_JEDECID;
 	uint8_t deviceID[3];
-	gpio_pin_output(GPIO_SPI0_CS0, 0);
-	spi_tx(0, &command, 1, TRUE, 0);
-	spi_rx(0, deviceID, 3, TRUE, 0);
-	gpio_pin_output(GPIO_SPI0_CS0, 1);
+	nor_spi(&command, 1, SPIDataIn, deviceID, 3);
 	uint16_t vendor = deviceID[0];
 	uint16_t device = deviceID[2];
 
 	// Unprotect NOR
 	command = NOR_SPI_EWSR;
-	gpio_pin_output(GPIO_SPI0_CS0, 0);
-	spi_tx(0, &command, 1, TRUE, 0);
-	gpio_pin_output(GPIO_SPI0_CS0, 1);
+	nor_spi(&command, 1, SPIDataNone, NULL, 0);
 
 	uint8_t wrsrCommand[2] = {NOR_SPI_WRSR, 0};
-	gpio_pin_output(GPIO_SPI0_CS0, 0);
-	spi_tx(0, wrsrCommand, 2, TRUE, 0);
-	gpio_pin_output(GPIO_SPI0_CS0, 1);
+	nor_spi(wrsrCommand, 2, SPIDataNone, NULL, 0);
 #else
 	SET_REG16(NOR + COMMAND, COMMAND_UNLOCK);
 	SET_REG16(NOR + LOCK, LOCK_UNLOCK);
@@ -89,10 +98,7 @@ static uint8_t nor_get_status() {
 	uint8_t command[1];
 	command[0] = NOR_SPI_RDSR;
 
-	gpio_pin_output(GPIO_SPI0_CS0, 0);
-	spi_tx(0, command, sizeof(command), TRUE, 0);
-	spi_rx(0, &data, sizeof(data), TRUE, 0);
-	gpio_pin_output(GPIO_SPI0_CS0, 1);
+	nor_spi(command, sizeof(command), SPIDataIn, &data, sizeof(data));
 
 	nor_unprepare();
 
@@ -110,6 +116,9 @@ static int nor_wait_for_ready(int timeout) {
 			bufferPrintf("nor: timed out waiting for ready\r\n");
 			return -1;
 		}
+
+		// erases take milliseconds
+		poll_wait(startTime);
 	}
 
 	return 0;
@@ -126,9 +135,7 @@ static void nor_write_enable() {
 	uint8_t command[1];
 	command[0] = NOR_SPI_WREN;
 
-	gpio_pin_output(GPIO_SPI0_CS0, 0);
-	spi_tx(0, command, sizeof(command), TRUE, 0);
-	gpio_pin_output(GPIO_SPI0_CS0, 1);
+	nor_spi(command, sizeof(command), SPIDataNone, NULL, 0);
 
 	nor_unprepare();
 }
@@ -144,9 +151,7 @@ static void nor_write_disable() {
 	uint8_t command[1];
 	command[0] = NOR_SPI_WRDI;
 
-	gpio_pin_output(GPIO_SPI0_CS0, 0);
-	spi_tx(0, command, sizeof(command), TRUE, 0);
-	gpio_pin_output(GPIO_SPI0_CS0, 1);
+	nor_spi(command, sizeof(command), SPIDataNone, NULL, 0);
 
 	nor_unprepare();
 
@@ -171,9 +176,7 @@ static int nor_serial_prepare_write(uint32_t offset, uint16_t data) {
 	command[4] = data & 0xFF;
 	command[5] = (data >> 8) & 0xFF;
 
-	gpio_pin_output(GPIO_SPI0_CS0, 0);
-	spi_tx(0, command, sizeof(command), TRUE, 0);
-	gpio_pin_output(GPIO_SPI0_CS0, 1);
+	nor_spi(command, sizeof(command), SPIDataNone, NULL, 0);
 
 	nor_unprepare();
 
@@ -203,9 +206,31 @@ static int nor_serial_write_byte(uint32_t offset, uint8_t data) {
 	command[3] = offset & 0xFF;
 	command[4] = data & 0xFF;
 
-	gpio_pin_output(GPIO_SPI0_CS0, 0);
-	spi_tx(0, command, sizeof(command), TRUE, 0);
-	gpio_pin_output(GPIO_SPI0_CS0, 1);
+	nor_spi(command, sizeof(command), SPIDataNone, NULL, 0);
+
+	nor_unprepare();
+
+	return 0;
+}
+
+// Page program: up to NOR_SPI_PAGE bytes that must not cross a page boundary.
+static int nor_serial_write_page(uint32_t offset, const uint8_t* data, int len) {
+	nor_prepare();
+
+	if(nor_wait_for_ready(100) != 0) {
+		nor_unprepare();
+		return -1;
+	}
+
+	nor_write_enable();
+
+	uint8_t command[4];
+	command[0] = NOR_SPI_PRGM;
+	command[1] = (offset >> 16) & 0xFF;
+	command[2] = (offset >> 8) & 0xFF;
+	command[3] = offset & 0xFF;
+
+	nor_spi(command, sizeof(command), SPIDataOut, (void*) data, len);
 
 	nor_unprepare();
 
@@ -233,9 +258,7 @@ int nor_write_word(uint32_t offset, uint16_t data) {
 			command[1] = data & 0xFF;
 			command[2] = (data >> 8) & 0xFF;
 
-			gpio_pin_output(GPIO_SPI0_CS0, 0);
-			spi_tx(0, command, sizeof(command), TRUE, 0);
-			gpio_pin_output(GPIO_SPI0_CS0, 1);
+			nor_spi(command, sizeof(command), SPIDataNone, NULL, 0);
 		}
 	} else
 	{
@@ -275,10 +298,7 @@ uint16_t nor_read_word(uint32_t offset) {
 	command[2] = (offset >> 8) & 0xFF;
 	command[3] = offset & 0xFF;
 
-	gpio_pin_output(GPIO_SPI0_CS0, 0);
-	spi_tx(0, command, sizeof(command), TRUE, 0);
-	spi_rx(0, (uint8_t*) &data, sizeof(data), TRUE, 0);
-	gpio_pin_output(GPIO_SPI0_CS0, 1);
+	nor_spi(command, sizeof(command), SPIDataIn, (uint8_t*) &data, sizeof(data));
 
 #else
 	data = GET_REG16(NOR + offset);
@@ -305,9 +325,7 @@ int nor_erase_sector(uint32_t offset) {
 	command[2] = (offset >> 8) & 0xFF;
 	command[3] = offset & 0xFF;
 
-	gpio_pin_output(GPIO_SPI0_CS0, 0);
-	spi_tx(0, command, sizeof(command), TRUE, 0);
-	gpio_pin_output(GPIO_SPI0_CS0, 1);
+	nor_spi(command, sizeof(command), SPIDataNone, NULL, 0);
 
 	nor_write_disable();
 #else
@@ -336,33 +354,60 @@ int nor_erase_sector(uint32_t offset) {
 	return 0;
 }
 
+#ifdef CONFIG_3G
+// Bytes clocked out per READ command. The chip streams sequential data for as
+// long as chip select stays low, so large spans only pay the command overhead
+// once per burst.
+#ifndef NOR_SPI_BURST
+#define NOR_SPI_BURST 0x1000
+#endif
+#define NOR_SPI_MIN_BURST 0x10
+#endif
+
 void nor_read(void* buffer, int offset, int len) {
 	nor_prepare();
 #ifdef CONFIG_3G
 	uint8_t command[4];
 	uint8_t* data = buffer;
+	int burst = NOR_SPI_BURST;
 	while(len > 0) {
-		int toRead = (len > 0x10) ? 0x10 : len;
+		int toRead = (len > burst) ? burst : len;
 
 		command[0] = NOR_SPI_READ;
 		command[1] = (offset >> 16) & 0xFF;
 		command[2] = (offset >> 8) & 0xFF;
 		command[3] = offset & 0xFF;
 
-		gpio_pin_output(GPIO_SPI0_CS0, 0);
-		spi_tx(0, command, sizeof(command), TRUE, 0);
-		if(spi_rx(0, data, toRead, TRUE, 0) < 0)
+		if(nor_spi(command, sizeof(command), SPIDataIn, data, toRead) != 0)
 		{
-			gpio_pin_output(GPIO_SPI0_CS0, 1);
+			// retry the span in smaller pieces
+			if(burst > NOR_SPI_MIN_BURST)
+				burst >>= 1;
 			continue;
 		}
-		gpio_pin_output(GPIO_SPI0_CS0, 1);
 
 		len -= toRead;
 		data += toRead;
 		offset += toRead;
 	}
 #else
+	if((offset & 1) == 0 && (((uint32_t)buffer) & 1) == 0) {
+		// NOR sits in data mode outside of commands, so it can be read
+		// straight off the bus without going through nor_read_word
+		const volatile uint16_t* src = (const volatile uint16_t*)(NOR + offset);
+		uint16_t* dest = (uint16_t*) buffer;
+		for(; len >= 2; len -= 2)
+			*(dest++) = *(src++);
+
+		if(len > 0) {
+			uint16_t lastWord = *src;
+			*((uint8_t*)dest) = *((uint8_t*)(&lastWord));
+		}
+
+		nor_unprepare();
+		return;
+	}
+
 	uint16_t* alignedBuffer = (uint16_t*) buffer;
 	for(; len >= 2; len -= 2) {
 		*alignedBuffer = nor_read_word(offset);
@@ -380,48 +425,136 @@ void nor_read(void* buffer, int offset, int len) {
 	nor_unprepare();
 }
 
-int nor_write(void* buffer, int offset, int len) {
-	nor_prepare();
-
-	int startSector = offset / NORSectorSize;
-	int endSector = (offset + len) / NORSectorSize;
-
-	int numSectors = endSector - startSector + 1;
-	uint8_t* sectorsToChange = (uint8_t*) malloc(NORSectorSize * numSectors);
-	nor_read(sectorsToChange, startSector * NORSectorSize, NORSectorSize * numSectors);
-
-	int offsetFromStart = offset - (startSector * NORSectorSize);
+// Program a contiguous, halfword-aligned run that is already erased or only
+// needs 1->0 transitions.
+static int nor_program(uint32_t offset, const uint16_t* data, int numWords) {
+#ifdef CONFIG_3G
+	if(NORVendor != 0xBF) {
+		const uint8_t* bytes = (const uint8_t*) data;
+		int len = numWords * 2;
+		while(len > 0) {
+			int toWrite = NOR_SPI_PAGE - (offset % NOR_SPI_PAGE);
+			if(toWrite > len)
+				toWrite = len;
+
+			if(nor_serial_write_page(offset, bytes, toWrite) != 0)
+				return -1;
 
-	memcpy(sectorsToChange + offsetFromStart, buffer, len);
+			offset += toWrite;
+			bytes += toWrite;
+			len -= toWrite;
+		}
+		return 0;
+	}
+#endif
 
 	int i;
-	for(i = 0; i < numSectors; i++) {
-		if(nor_erase_sector((i + startSector) * NORSectorSize) != 0) {
-			nor_unprepare();
+	for(i = 0; i < numWords; i++) {
+		if(nor_write_word(offset + (i * 2), data[i]) != 0) {
+#ifdef CONFIG_3G
+			nor_write_disable();
+#endif
 			return -1;
 		}
+	}
 
-		int j;
-		uint16_t* curSector = (uint16_t*)(sectorsToChange + (i * NORSectorSize));
-		for(j = 0; j < (NORSectorSize / 2); j++) {
-			if(nor_write_word(((i + startSector) * NORSectorSize) + (j * 2), curSector[j]) != 0) {
-				nor_unprepare();
 #ifdef CONFIG_3G
-				nor_write_disable();
+	// end the auto-increment sequence so the next run starts at its own address
+	nor_write_disable();
 #endif
-				return -1;
+
+	return 0;
+}
+
+// Rewrite one sector from old to new contents, erasing only when some bit has
+// to go from 0 back to 1 and programming only the words that need it.
+static int nor_update_sector(uint32_t offset, const uint16_t* current, const uint16_t* target) {
+	int numWords = NORSectorSize / 2;
+	int needsErase = FALSE;
+	int changed = FALSE;
+	int i;
+
+	for(i = 0; i < numWords; i++) {
+		if(current[i] != target[i])
+			changed = TRUE;
+
+		if((current[i] & target[i]) != target[i]) {
+			needsErase = TRUE;
+			break;
+		}
+	}
+
+	if(!changed)
+		return 0;
+
+	if(needsErase && nor_erase_sector(offset) != 0)
+		return -1;
+
+	i = 0;
+	while(i < numWords) {
+		int runStart;
+		if(needsErase) {
+			if(target[i] == 0xFFFF) {
+				i++;
+				continue;
+			}
+			runStart = i;
+			while(i < numWords && target[i] != 0xFFFF)
+				i++;
+		} else {
+			if(target[i] == current[i]) {
+				i++;
+				continue;
 			}
+			runStart = i;
+			while(i < numWords && target[i] != current[i])
+				i++;
+		}
+
+		if(nor_program(offset + (runStart * 2), target + runStart, i - runStart) != 0)
+			return -1;
+	}
+
+	return 0;
+}
+
+int nor_write(void* buffer, int offset, int len) {
+	if(len <= 0)
+		return 0;
+
+	nor_prepare();
+
+	int startSector = offset / NORSectorSize;
+	int endSector = (offset + len - 1) / NORSectorSize;
+
+	uint16_t* original = (uint16_t*) malloc(NORSectorSize);
+	uint16_t* updated = (uint16_t*) malloc(NORSectorSize);
+
+	const uint8_t* data = (const uint8_t*) buffer;
+	int ret = 0;
+	int sector;
+	for(sector = startSector; sector <= endSector; sector++) {
+		int sectorStart = sector * NORSectorSize;
+		int from = (offset > sectorStart) ? (offset - sectorStart) : 0;
+		int to = ((offset + len) < (sectorStart + NORSectorSize)) ? (offset + len - sectorStart) : NORSectorSize;
+
+		nor_read(original, sectorStart, NORSectorSize);
+		memcpy(updated, original, NORSectorSize);
+		memcpy(((uint8_t*)updated) + from, data, to - from);
+		data += to - from;
+
+		if(nor_update_sector(sectorStart, original, updated) != 0) {
+			ret = -1;
+			break;
 		}
-#ifdef CONFIG_3G
-		nor_write_disable();
-#endif
 	}
 
-	free(sectorsToChange);
+	free(updated);
+	free(original);
 
 	nor_unprepare();
 
-	return 0;
+	return ret;
 }
 
 int getNORSectorSize() {
@@ -12,7 +12,17 @@ static uint32_t oldestBank;
 static NVRamAtom* newestBank;
 static uint8_t* newestBankData;
 
-static EnvironmentVar* variables;
+static char* EnvArena;
+static uint32_t EnvArenaUsed;
+static EnvironmentVar EnvVars[NVRAM_ENV_MAX];
+static int EnvCount;
+static int16_t EnvSlots[NVRAM_ENV_SLOTS];
+static int EnvDirty;
+
+// offsets into the newest bank
+static uint32_t JournalStart;
+static uint32_t JournalEnd;
+static uint32_t JournalPos;
 
 static uint8_t checkNVRamInfo(NVRamInfo* info) {
 	uint32_t c = info->ckByteSeed;
@@ -30,14 +40,9 @@ static uint8_t checkNVRamInfo(NVRamInfo* info) {
 	return c;
 }
 
+// readAtoms hands out all of a bank's atoms in one allocation
 static void releaseAtoms(NVRamAtom* atoms) {
-	NVRamAtom* toRelease;
-
-	while(atoms != NULL) {
-		toRelease = atoms;
-		atoms = atoms->next;
-		free(toRelease);
-	}
+	free(atoms);
 }
 
 static NVRamAtom* findAtom(NVRamAtom* atoms, const char* type) {
@@ -50,30 +55,71 @@ static NVRamAtom* findAtom(NVRamAtom* atoms, const char* type) {
 	return NULL;
 }
 
+// The journal takes whatever follows the empty string ending the environment
+static void findJournal(NVRamAtom* atoms, uint8_t* bankData, uint32_t* start, uint32_t* end) {
+	*start = *end = 0;
+
+	NVRamAtom* commonAtom = findAtom(atoms, "common");
+	if(commonAtom == NULL)
+		return;
+
+	uint32_t pos = commonAtom->data - bankData;
+	uint32_t atomEnd = pos + commonAtom->size - sizeof(NVRamInfo);
+	while(pos < atomEnd && bankData[pos] != '\0') {
+		while(pos < atomEnd && bankData[pos] != '\0')
+			pos++;
+		pos++;
+	}
+
+	pos = (pos + 2) & ~1;
+	if(pos < atomEnd) {
+		*start = pos;
+		*end = atomEnd & ~1;
+	}
+}
+
+// The adler32 the bank had before anything was appended to the journal
+static uint32_t journaledAdler(NVRamAtom* atoms, uint8_t* bankData) {
+	uint32_t start;
+	uint32_t end;
+
+	findJournal(atoms, bankData, &start, &end);
+	if(start == end)
+		return 0;
+
+	uint8_t* copy = (uint8_t*) malloc(NVRAM_SIZE);
+	memcpy(copy, bankData, NVRAM_SIZE);
+	memset(copy + start, 0xFF, end - start);
+	uint32_t adler = adler32(copy + 0x14, NVRAM_SIZE - 0x14);
+	free(copy);
+
+	return adler;
+}
+
 static NVRamAtom* readAtoms(uint8_t* bankData) {
-	NVRamAtom* lastAtom = NULL;
-	NVRamAtom* firstAtom = NULL;
 	size_t position = 0;
+	int numAtoms = 0;
+	int i;
+
 	while(position < NVRAM_SIZE) {
-		if(lastAtom == NULL) {
-			firstAtom = (NVRamAtom*) malloc(sizeof(NVRamAtom));
-			lastAtom = firstAtom;
-		} else {
-			lastAtom->next = (NVRamAtom*) malloc(sizeof(NVRamAtom));
-			lastAtom = lastAtom->next;
-		}
+		NVRamInfo* info = (NVRamInfo*) &bankData[position];
 
-		lastAtom->info = (NVRamInfo*) &bankData[position];
-		lastAtom->size = lastAtom->info->size << 4;
-		lastAtom->data = &bankData[position + sizeof(NVRamInfo)];
-		lastAtom->next = NULL;
+		if(info->size == 0 || checkNVRamInfo(info) != info->ckByte)
+			return NULL;
 
-		position += lastAtom->size;
+		position += info->size << 4;
+		numAtoms++;
+	}
 
-		if(checkNVRamInfo(lastAtom->info) != lastAtom->info->ckByte) {
-			releaseAtoms(firstAtom);
-			return NULL;
-		}
+	NVRamAtom* firstAtom = (NVRamAtom*) malloc(sizeof(NVRamAtom) * numAtoms);
+	position = 0;
+	for(i = 0; i < numAtoms; i++) {
+		NVRamAtom* atom = &firstAtom[i];
+		atom->info = (NVRamInfo*) &bankData[position];
+		atom->size = atom->info->size << 4;
+		atom->data = &bankData[position + sizeof(NVRamInfo)];
+		atom->next = (i + 1 < numAtoms) ? &firstAtom[i + 1] : NULL;
+		position += atom->size;
 	}
 
 	NVRamAtom* ckDataAtom = findAtom(firstAtom, "nvram");
@@ -83,7 +129,8 @@ static NVRamAtom* readAtoms(uint8_t* bankData) {
 	}
 
 	NVRamData* ckData = (NVRamData*) ckDataAtom->data;
-	if(ckData->adler != adler32(bankData + 0x14, NVRAM_SIZE - 0x14)) {
+	if(ckData->adler != adler32(bankData + 0x14, NVRAM_SIZE - 0x14)
+			&& ckData->adler != journaledAdler(firstAtom, bankData)) {
 		releaseAtoms(firstAtom);
 		return NULL;	
 	}
@@ -91,144 +138,358 @@ static NVRamAtom* readAtoms(uint8_t* bankData) {
 	return firstAtom;
 }
 
-static void releaseEnvironment(EnvironmentVar* vars) {
-	EnvironmentVar* toRelease;
+static uint32_t envHash(const char* name) {
+	uint32_t hash = 5381;
+	while(*name != '\0')
+		hash = (hash * 33) ^ (uint8_t) *(name++);
+	return hash;
+}
 
-	while(vars != NULL) {
-		toRelease = vars;
-		vars = vars->next;
-		free(toRelease);
+// The slot holding name, or the empty one it would go in
+static int envFind(const char* name, uint32_t hash) {
+	int slot = hash & (NVRAM_ENV_SLOTS - 1);
+	while(EnvSlots[slot] >= 0) {
+		EnvironmentVar* var = &EnvVars[EnvSlots[slot]];
+		if(var->hash == hash && strcmp(EnvArena + var->name, name) == 0)
+			break;
+		slot = (slot + 1) & (NVRAM_ENV_SLOTS - 1);
 	}
+	return slot;
 }
 
-void nvram_save() {
-	NVRamAtom* commonAtom = findAtom(newestBank, "common");
-	EnvironmentVar* var = variables;
-	memset(commonAtom->data, 0, commonAtom->size - sizeof(NVRamInfo));
+static void envReset() {
+	EnvArenaUsed = 0;
+	EnvCount = 0;
+	memset(EnvSlots, 0xFF, sizeof(EnvSlots));
+}
 
-	char* pos = (char*) commonAtom->data;
-	while(var != NULL) {
-		if(var->name[0] == '\0')
-			break;
+// Drops the old copies of replaced values
+static void envCompact() {
+	char* old = (char*) malloc(EnvArenaUsed);
+	int i;
+
+	memcpy(old, EnvArena, EnvArenaUsed);
+	EnvArenaUsed = 0;
 
-		sprintf(pos, "%s=%s", var->name, var->value);
-		pos += strlen(pos) + 1;
-		var = var->next;
+	for(i = 0; i < EnvCount; i++) {
+		EnvironmentVar* var = &EnvVars[i];
+		size_t nameLen = strlen(old + var->name) + 1;
+		size_t valueLen = strlen(old + var->value) + 1;
+
+		memcpy(EnvArena + EnvArenaUsed, old + var->name, nameLen);
+		var->name = EnvArenaUsed;
+		EnvArenaUsed += nameLen;
+
+		memcpy(EnvArena + EnvArenaUsed, old + var->value, valueLen);
+		var->value = EnvArenaUsed;
+		EnvArenaUsed += valueLen;
 	}
 
-	NVRamAtom* ckDataAtom = findAtom(newestBank, "nvram");
-	NVRamData* ckData = (NVRamData*) ckDataAtom->data;
+	free(old);
+}
 
-	ckData->epoch++;
-	ckData->adler = adler32(newestBankData + 0x14, NVRAM_SIZE - 0x14);
-
-	NVRamAtom* atom = newestBank;
-	uint32_t offset = oldestBank;
-	while(atom != NULL) {
-		nor_write(atom->info, offset, sizeof(NVRamInfo));
-		offset += sizeof(NVRamInfo);
-		nor_write(atom->data, offset, atom->size - sizeof(NVRamInfo));
-		offset += atom->size - sizeof(NVRamInfo);
-		atom = atom->next;
+static int envStore(const char* str, size_t len) {
+	if((EnvArenaUsed + len + 1) > NVRAM_SIZE) {
+		envCompact();
+		if((EnvArenaUsed + len + 1) > NVRAM_SIZE)
+			return -1;
 	}
 
-	releaseAtoms(bank1Atoms);
-	releaseAtoms(bank2Atoms);
-	releaseEnvironment(variables);
+	int offset = EnvArenaUsed;
+	memcpy(EnvArena + offset, str, len);
+	EnvArena[offset + len] = '\0';
+	EnvArenaUsed += len + 1;
+	return offset;
+}
+
+static int envSet(const char* name, size_t nameLen, const char* value, size_t valueLen) {
+	char key[nameLen + 1];
+	memcpy(key, name, nameLen);
+	key[nameLen] = '\0';
+
+	uint32_t hash = envHash(key);
+	int slot = envFind(key, hash);
+	int offset;
+
+	if(EnvSlots[slot] >= 0) {
+		EnvironmentVar* var = &EnvVars[EnvSlots[slot]];
+		if(strlen(EnvArena + var->value) == valueLen && memcmp(EnvArena + var->value, value, valueLen) == 0)
+			return 0;
 
-	free(bank1Data);
-	free(bank2Data);
+		if((offset = envStore(value, valueLen)) < 0)
+			return -1;
+
+		var->value = offset;
+		var->changed = TRUE;
+		return 1;
+	}
+
+	if(EnvCount >= NVRAM_ENV_MAX)
+		return -1;
 
-	nvram_setup();
+	EnvironmentVar* var = &EnvVars[EnvCount];
+	if((offset = envStore(key, nameLen)) < 0)
+		return -1;
+	var->name = offset;
+
+	if((offset = envStore(value, valueLen)) < 0)
+		return -1;
+	var->value = offset;
+
+	var->hash = hash;
+	var->changed = TRUE;
+	EnvSlots[slot] = EnvCount++;
+	return 1;
 }
 
-const char* nvram_getvar(const char* name) {
-	EnvironmentVar* var = variables;
-	while(var != NULL) {
-		if(strcmp(var->name, name) == 0) {
-			return var->value;
-		}
-		var = var->next;
+// Writes the variables out as name=value strings, ended by an empty one, and
+// leaves the rest erased for the journal
+static int serializeEnvironment(char* buffer, size_t size) {
+	size_t pos = 0;
+	int i;
+
+#ifdef NO_NVRAM_JOURNAL
+	memset(buffer, 0, size);
+#else
+	memset(buffer, 0xFF, size);
+#endif
+
+	for(i = 0; i < EnvCount; i++) {
+		const char* name = EnvArena + EnvVars[i].name;
+		const char* value = EnvArena + EnvVars[i].value;
+		size_t nameLen = strlen(name);
+		size_t valueLen = strlen(value);
+
+		if((pos + nameLen + 1 + valueLen + 1) >= size)
+			return -1;
+
+		memcpy(buffer + pos, name, nameLen);
+		pos += nameLen;
+		buffer[pos++] = '=';
+		memcpy(buffer + pos, value, valueLen);
+		pos += valueLen;
+		buffer[pos++] = '\0';
 	}
-	return NULL;
+
+	buffer[pos++] = '\0';
+	if(pos & 1)
+		buffer[pos] = '\0';
+
+	return 0;
 }
 
-void nvram_setvar(const char* name, const char* value) {
-	EnvironmentVar* var = variables;
-	while(var != NULL) {
-		if(strcmp(var->name, name) == 0) {
-			free(var->value);
-			var->value = strdup(value);
+static uint16_t journalCheck(const uint8_t* payload, uint16_t length) {
+	uint32_t crc = 0;
+	crc32(&crc, payload, length);
+	return (crc & 0xFFFF) ^ length;
+}
+
+static uint32_t newestBankOffset() {
+	return (newestBankData == bank1Data) ? NVRAM_START : (NVRAM_START + NVRAM_SIZE);
+}
+
+static void replayJournal() {
+	JournalPos = JournalStart;
+
+	while((JournalPos + sizeof(NVRamJournalRecord)) <= JournalEnd) {
+		NVRamJournalRecord* record = (NVRamJournalRecord*) (newestBankData + JournalPos);
+		const char* payload = (const char*) (record + 1);
+		uint32_t next = JournalPos + sizeof(NVRamJournalRecord) + ((record->length + 1) & ~1);
+
+		if(record->length == 0xFFFF && record->check == 0xFFFF)
 			return;
+
+		// iBoot pads with zeroes, leaving no room for a journal until the next rewrite
+		if(record->length == 0 && record->check == 0)
+			break;
+
+		if(record->length == 0 || next > JournalEnd
+				|| record->check != journalCheck((const uint8_t*) payload, record->length)) {
+			// half written, or not erased to begin with; nothing more goes here
+			bufferPrintf("nvram: journal ends in a bad record\r\n");
+			break;
 		}
-		var = var->next;
+
+		uint32_t len = record->length;
+		uint32_t nameLen = 0;
+		while(nameLen < len && payload[nameLen] != '=')
+			nameLen++;
+
+		if(nameLen < len)
+			envSet(payload, nameLen, payload + nameLen + 1, len - nameLen - 1);
+		else
+			envSet(payload, len, "", 0);
+
+		JournalPos = next;
 	}
 
-	var = (EnvironmentVar*) malloc(sizeof(EnvironmentVar));
-	var->next = variables;
-	var->name = strdup(name);
-	var->value = strdup(value);
-	variables = var;
+	JournalPos = JournalEnd;
+}
+
+// Appends every changed variable, or fails if they do not all fit
+static int appendJournal() {
+	uint32_t pos = JournalPos;
+	int i;
+
+	for(i = 0; i < EnvCount; i++) {
+		if(EnvVars[i].changed)
+			pos += sizeof(NVRamJournalRecord) + ((strlen(EnvArena + EnvVars[i].name) + strlen(EnvArena + EnvVars[i].value) + 2) & ~1);
+	}
+
+	if(pos > JournalEnd)
+		return -1;
+
+	pos = JournalPos;
+	for(i = 0; i < EnvCount; i++) {
+		if(!EnvVars[i].changed)
+			continue;
+
+		NVRamJournalRecord* record = (NVRamJournalRecord*) (newestBankData + pos);
+		char* payload = (char*) (record + 1);
+		size_t nameLen = strlen(EnvArena + EnvVars[i].name);
+		size_t valueLen = strlen(EnvArena + EnvVars[i].value);
+
+		memcpy(payload, EnvArena + EnvVars[i].name, nameLen);
+		payload[nameLen] = '=';
+		memcpy(payload + nameLen + 1, EnvArena + EnvVars[i].value, valueLen);
+
+		record->length = nameLen + 1 + valueLen;
+		if(record->length & 1)
+			payload[record->length] = 0xFF;
+		record->check = journalCheck((const uint8_t*) payload, record->length);
+
+		pos += sizeof(NVRamJournalRecord) + ((record->length + 1) & ~1);
+	}
+
+	if(nor_write(newestBankData + JournalPos, newestBankOffset() + JournalPos, pos - JournalPos) != 0)
+		return -1;
+
+	JournalPos = pos;
+	return 0;
+}
+
+static void clearChanged() {
+	int i;
+	for(i = 0; i < EnvCount; i++)
+		EnvVars[i].changed = FALSE;
+	EnvDirty = FALSE;
+}
+
+void nvram_save() {
+	if(!EnvDirty)
+		return;
+
+#ifndef NO_NVRAM_JOURNAL
+	if(appendJournal() == 0) {
+		clearChanged();
+		return;
+	}
+#endif
+
+	// the new bank is built in the buffer of the one it replaces
+	uint8_t* bankData = (oldestBank == NVRAM_START) ? bank1Data : bank2Data;
+	memcpy(bankData, newestBankData, NVRAM_SIZE);
+
+	NVRamAtom* atoms = readAtoms(bankData);
+	NVRamAtom* commonAtom = findAtom(atoms, "common");
+	NVRamAtom* ckDataAtom = findAtom(atoms, "nvram");
+
+	if(commonAtom == NULL || serializeEnvironment((char*) commonAtom->data, commonAtom->size - sizeof(NVRamInfo)) != 0) {
+		bufferPrintf("nvram: environment does not fit in the common atom, not saved\r\n");
+		releaseAtoms(atoms);
+		return;
+	}
+
+	NVRamData* ckData = (NVRamData*) ckDataAtom->data;
+
+	ckData->epoch++;
+	ckData->adler = adler32(bankData + 0x14, NVRAM_SIZE - 0x14);
+
+	nor_write(bankData, oldestBank, NVRAM_SIZE);
+
+	if(oldestBank == NVRAM_START) {
+		releaseAtoms(bank1Atoms);
+		bank1Atoms = atoms;
+		oldestBank = NVRAM_START + NVRAM_SIZE;
+	} else {
+		releaseAtoms(bank2Atoms);
+		bank2Atoms = atoms;
+		oldestBank = NVRAM_START;
+	}
+
+	newestBank = atoms;
+	newestBankData = bankData;
+	clearChanged();
+
+	findJournal(newestBank, newestBankData, &JournalStart, &JournalEnd);
+	JournalPos = JournalStart;
+}
+
+const char* nvram_getvar(const char* name) {
+	if(EnvArena == NULL)
+		return NULL;
+
+	int slot = envFind(name, envHash(name));
+	if(EnvSlots[slot] < 0)
+		return NULL;
+
+	return EnvArena + EnvVars[EnvSlots[slot]].value;
+}
+
+void nvram_setvar(const char* name, const char* value) {
+	if(EnvArena == NULL)
+		return;
+
+	// a compaction would move a value that is already in the arena
+	char* copy = NULL;
+	if(value >= EnvArena && value < (EnvArena + NVRAM_SIZE))
+		value = copy = strdup(value);
+
+	int ret = envSet(name, strlen(name), value, strlen(value));
+	if(ret < 0)
+		bufferPrintf("nvram: no room for %s\r\n", name);
+	else if(ret > 0)
+		EnvDirty = TRUE;
+
+	if(copy)
+		free(copy);
 }
 
 void nvram_listvars() {
-	EnvironmentVar* var = variables;
-	while(var != NULL) {
-		bufferPrintf("%s = %s\r\n", var->name, var->value);
-		var = var->next;
+	int i;
+	for(i = 0; i < EnvCount; i++) {
+		bufferPrintf("%s = %s\r\n", EnvArena + EnvVars[i].name, EnvArena + EnvVars[i].value);
 	}
 }
 
-static EnvironmentVar* loadEnvironment(NVRamAtom* atoms) {
-	EnvironmentVar* toRet = NULL;
-	EnvironmentVar* curVar = NULL;
+static void loadEnvironment(NVRamAtom* atoms) {
+	envReset();
 
 	NVRamAtom* commonAtom = findAtom(atoms, "common");
-	char* loc = (char*) commonAtom->data;
-	char* name = loc;
-	char* value = NULL;
-	size_t nameLen = 0;
-	while(TRUE) {
-		if(*loc == '\0') {
-			if(curVar == NULL) {
-				toRet = curVar = (EnvironmentVar*) malloc(sizeof(EnvironmentVar));
-			} else {
-				curVar->next = (EnvironmentVar*) malloc(sizeof(EnvironmentVar)); 
-				curVar = curVar->next;
-			}
-
-			curVar->next = NULL;
-
-			curVar->name = (char*) malloc(nameLen + 1);
-			memcpy(curVar->name, name, nameLen);
-			curVar->name[nameLen] = '\0';
-
-			if(value) {
-				size_t valueLen = strlen(value);
-				curVar->value = (char*) malloc(valueLen + 1);
-				memcpy(curVar->value, value, valueLen);
-				curVar->value[valueLen] = '\0';
-			} else {
-				curVar->value = (char*) malloc(1);
-				curVar->value[0] = '\0';
-			}
-
-			if(nameLen == 0) {
-				break;
-			}
-
-			name = loc + 1;
-			nameLen = 0;
-			value = NULL;
-		} else if(*loc == '=') {
-			value = loc + 1;
-		} else if(value == NULL) {
-			nameLen++;
+	if(commonAtom == NULL)
+		return;
+
+	const char* loc = (const char*) commonAtom->data;
+	const char* end = loc + commonAtom->size - sizeof(NVRamInfo);
+
+	while(loc < end && *loc != '\0') {
+		const char* value = NULL;
+		size_t len = 0;
+
+		while((loc + len) < end && loc[len] != '\0') {
+			if(value == NULL && loc[len] == '=')
+				value = loc + len;
+			len++;
 		}
-		loc++;
-	}
 
-	return toRet;
+		if(value == NULL) {
+			envSet(loc, len, "", 0);
+		} else {
+			envSet(loc, value - loc, value + 1, len - (value - loc) - 1);
+		}
+
+		loc += len + 1;
+	}
 }
 
 int nvram_setup() {
@@ -257,11 +518,11 @@ int nvram_setup() {
 	NVRamAtom* ckDataAtom2 = findAtom(bank2Atoms, "nvram");
 
 	if(ckDataAtom1 == NULL) {
-		oldestBank = NVRAM_START + NVRAM_SIZE;
+		oldestBank = NVRAM_START;
 		newestBank = bank2Atoms;
 		newestBankData = bank2Data;
 	} else if(ckDataAtom2 == NULL) {
-		oldestBank = NVRAM_START;
+		oldestBank = NVRAM_START + NVRAM_SIZE;
 		newestBank = bank1Atoms;
 		newestBankData = bank1Data;
 	} else if(((NVRamData*)(ckDataAtom1->data))->epoch < ((NVRamData*)(ckDataAtom2->data))->epoch) {
@@ -274,7 +535,12 @@ int nvram_setup() {
 		newestBankData = bank1Data;
 	}
 
-	variables = loadEnvironment(newestBank);
+	EnvArena = (char*) malloc(NVRAM_SIZE);
+	loadEnvironment(newestBank);
+
+	findJournal(newestBank, newestBankData, &JournalStart, &JournalEnd);
+	replayJournal();
+	clearChanged();
 
 	return 0;
 }
@@ -9,6 +9,7 @@
 .equ InterruptHandler.handler, 0x0
 .equ InterruptHandler.token, (InterruptHandler.handler + 0x4)
 .equ InterruptHandler.useEdgeIC, (InterruptHandler.token + 0x4)
+.equ InterruptHandler.preemptMask, (InterruptHandler.useEdgeIC + 0x4)
 
 # TaskDescriptor
 .equ TaskDescriptor.identifier1, 0x0
@@ -4,6 +4,7 @@
 #include "arm.h"
 #include "uart.h"
 #include "usb.h"
+#include "usbacm.h"
 #include "mmu.h"
 #include "clock.h"
 #include "timer.h"
@@ -28,10 +29,12 @@
 #include "camera.h"
 #include "util.h"
 #include "commands.h"
+#include "rpc.h"
 #include "framebuffer.h"
 #include "menu.h"
 #include "pmu.h"
 #include "nand.h"
+#include "nanddump.h"
 #include "ftl.h"
 #include "hfs/bdev.h"
 #include "hfs/fs.h"
@@ -41,6 +44,10 @@
 #include "wmcodec.h"
 #include "wdt.h"
 #include "als.h"
+#include "bootprof.h"
+#include "actions.h"
+#include "buttons.h"
+#include "workqueue.h"
 
 int received_file_size;
 
@@ -52,18 +59,51 @@ extern uint8_t _binary_payload_bin_end;
 extern uint8_t _binary_payload_bin_size;
 
 static void processCommand(char* command);
+static void queueCommand(const char* command, uint32_t batchNumber);
+static int isCancel(const char* command);
+static void processRPC();
+static int usbTransferActive();
+static void scrollbackChanged();
+
+typedef enum BootStageGroup {
+	BootStagesEarly,	// before the menu
+	BootStagesLate		// only once we stay in openiboot
+} BootStageGroup;
+
+static void startBootStages(BootStageGroup group);
 
 typedef struct CommandQueue {
 	struct CommandQueue* next;
 	char* command;
+	uint32_t batchNumber;	// 0 if it did not come in a batch
 } CommandQueue;
 
 CommandQueue* commandQueue = NULL;
 
-static void startUSB();
+// Signalled by the USB side whenever it leaves the main loop something to do
+static Completion MainLoopWake;
+
+// Poll anyway this often, for anything that changes without a signal
+#ifndef MAIN_LOOP_IDLE
+#define MAIN_LOOP_IDLE 100000
+#endif
+
+// Commands run on a task of their own, so a long one leaves the main loop
+// serving RPC and the clock governor. "cancel" never gets queued; it sets
+// CommandCancel for the running command to see in command_cancelled.
+static Completion CommandWake;
+static volatile int CommandRunning = FALSE;
+static volatile int CommandCancel = FALSE;
+
+#ifndef COMMAND_TASK_STACK
+#define COMMAND_TASK_STACK 0x10000
+#endif
+
+static void commandTask(void* opaque);
 
 void OpenIBootStart() {
 	setup_openiboot();
+	startBootStages(BootStagesEarly);
 	pmu_charge_settings(TRUE, FALSE, FALSE);
 
 	framebuffer_setdisplaytext(TRUE);
@@ -72,7 +112,9 @@ void OpenIBootStart() {
 #ifndef SMALL
 #ifndef NO_STBIMAGE
 	const char* hideMenu = nvram_getvar("opib-hide-menu");
-	if(hideMenu && (strcmp(hideMenu, "1") == 0 || strcmp(hideMenu, "true") == 0)) {
+	if(handoff_has(HandoffConsole)) {
+		bufferPrintf("Warm chainload, skipping the boot menu.\r\n");
+	} else if(hideMenu && (strcmp(hideMenu, "1") == 0 || strcmp(hideMenu, "true") == 0)) {
 		bufferPrintf("Boot menu hidden. Use 'setenv opib-hide-menu false' and then 'saveenv' to unhide.\r\n");
 	} else {
 		framebuffer_setdisplaytext(FALSE);
@@ -81,28 +123,19 @@ void OpenIBootStart() {
 		if(sMenuTimeout)
 			menuTimeout = parseNumber(sMenuTimeout);
 
+		bootprof_mark("menu", 0);
 		menu_setup(menuTimeout);
 	}
 #endif
 #endif
 
+	commands_setup();
+	completion_init(&MainLoopWake);
+	completion_init(&CommandWake);
 	startUSB();
 
-#ifndef CONFIG_IPOD
-	camera_setup();
-	radio_setup();
-#endif
-	sdio_setup();
-	wlan_setup();
-	accel_setup();
-#ifndef CONFIG_IPOD
-	als_setup();
-#endif
-
-	nand_setup();
-#ifndef NO_HFS
-	fs_setup();
-#endif
+	startBootStages(BootStagesLate);
+	waitForBootStages();
 
 	pmu_set_iboot_stage(0);
 	startScripting("openiboot"); //start script mode if there is a file
@@ -113,30 +146,239 @@ void OpenIBootStart() {
 	DebugPrintf("                    DEBUG MODE\r\n");
 
 	audiohw_postinit();
+	bootprof_mark("console", 0);
+
+	if(task_create("commands", commandTask, NULL, COMMAND_TASK_STACK) == NULL) {
+		bufferPrintf("openiboot: cannot start the command task, running commands here\r\n");
+		commandTask(NULL);
+	}
+
+	while(TRUE) {
+		EnterCriticalSection();
+		// rearmed before looking, so nothing signalled from here on is missed
+		completion_init(&MainLoopWake);
+		LeaveCriticalSection();
+
+		processRPC();
+
+		if(usbTransferActive() || CommandRunning)
+			clock_governor_busy();
+		else
+			clock_governor_idle();
+
+		// sleep until there is more to do; other tasks run meanwhile
+		completion_wait(&MainLoopWake, MAIN_LOOP_IDLE);
+	}
+	// should not reach here
+
+}
 
-	// Process command queue
+static void commandTask(void* opaque) {
 	while(TRUE) {
 		char* command = NULL;
+		uint32_t batchNumber = 0;
 		CommandQueue* cur;
 		EnterCriticalSection();
+		// rearmed before looking, so nothing queued from here on is missed
+		completion_init(&CommandWake);
 		if(commandQueue != NULL) {
 			cur = commandQueue;
 			command = cur->command;
+			batchNumber = cur->batchNumber;
 			commandQueue = commandQueue->next;
 			free(cur);
+			CommandRunning = TRUE;
+			CommandCancel = FALSE;
 		}
 		LeaveCriticalSection();
 
-		if(command) {
-			processCommand(command);
-			free(command);
+		if(!command) {
+			completion_wait(&CommandWake, MAIN_LOOP_IDLE);
+			continue;
 		}
+
+		clock_boost_begin();
+		processCommand(command);
+		clock_boost_end();
+		free(command);
+
+		CommandRunning = FALSE;
+		if(CommandCancel)
+			bufferPrintf("Cancelled.\r\n");
+
+		if(batchNumber != 0)
+			bufferPrintf("batch: %u done\r\n", batchNumber);
+
+		task_yield();
 	}
-	// should not reach here
+}
 
+int command_cancelled() {
+	// a loop that asks is one that runs for a while, so let the others in
+	task_yield();
+	return CommandCancel;
+}
+
+static int isCancel(const char* command) {
+	while(*command == ' ' || *command == '\t')
+		command++;
+
+	const char* word = "cancel";
+	while(*word != '\0' && *command == *word) {
+		command++;
+		word++;
+	}
+
+	if(*word != '\0')
+		return FALSE;
+
+	while(*command == ' ' || *command == '\t' || *command == '\r' || *command == '\n')
+		command++;
+
+	return *command == '\0';
+}
+
+// Bring-up of everything past the core devices in setup_openiboot. A stage
+// starts once the stages in its after mask are done. Parallel ones get a task
+// of their own, so their waits on the hardware overlap with what the boot
+// task does meanwhile; the rest run on the boot task in table order. Stages
+// sharing an unlocked bus (SPI, the radio UART) must not run side by side.
+typedef struct BootStage {
+	const char* name;
+	int (*setup)();
+	BootStageGroup group;
+	int parallel;
+	uint32_t after;
+	int started;
+	int reported;
+	Completion done;
+	uint64_t startTime;
+	uint64_t endTime;
+} BootStage;
+
+#ifndef BOOT_STAGE_STACK
+#define BOOT_STAGE_STACK 0x10000
+#endif
+
+// complain this often about a stage that is not done yet
+#define BOOT_STAGE_TIMEOUT 5000000
+
+static int setup_display() {
+	lcd_setup();
+	framebuffer_setup();
+	return 0;
+}
+
+static int setup_audio() {
+	audiohw_init();
+	return 0;
+}
+
+#ifdef CONFIG_IPOD
+#define camera_setup NULL
+#define radio_setup NULL
+#define als_setup NULL
+#endif
+
+#ifdef NO_HFS
+#define fs_setup NULL
+#endif
+
+static BootStage BootStages[BootStageCount] = {
+	{"display", setup_display, BootStagesEarly, FALSE, 0},
+	{"audio", setup_audio, BootStagesEarly, FALSE, 1 << BootStageDisplay},
+	{"nand", nand_setup, BootStagesEarly, TRUE, 0},
+	{"fs", fs_setup, BootStagesEarly, TRUE, 1 << BootStageNAND},
+	{"camera", camera_setup, BootStagesLate, FALSE, 0},
+	{"radio", radio_setup, BootStagesLate, TRUE, 0},
+	{"sdio", sdio_setup, BootStagesLate, FALSE, 0},
+	{"wlan", wlan_setup, BootStagesLate, TRUE, 1 << BootStageSDIO},
+	{"accel", accel_setup, BootStagesLate, FALSE, 0},
+	{"als", als_setup, BootStagesLate, FALSE, 0}
+};
+
+static void waitForBootStage(BootStage* stage) {
+	while(completion_wait(&stage->done, BOOT_STAGE_TIMEOUT) != 0)
+		bufferPrintf("boot: still waiting for %s\r\n", stage->name);
+}
+
+static void runBootStage(BootStage* stage) {
+	int i;
+	for(i = 0; i < BootStageCount; i++) {
+		if(stage->after & (1 << i))
+			waitForBootStage(&BootStages[i]);
+	}
+
+	clock_boost_begin();
+	bootprof_begin(stage->name);
+	stage->startTime = timer_get_system_microtime();
+	stage->setup();
+	stage->endTime = timer_get_system_microtime();
+	bootprof_end(stage->name, 0);
+	clock_boost_end();
+
+	completion_signal(&stage->done);
+}
+
+static void bootStageTask(void* opaque) {
+	runBootStage((BootStage*) opaque);
+}
+
+static void startBootStages(BootStageGroup group) {
+	int running[BootStageCount];
+	int i;
+
+	for(i = 0; i < BootStageCount; i++) {
+		BootStage* stage = &BootStages[i];
+		running[i] = (stage->group != group);
+		if(running[i])
+			continue;
+
+		completion_init(&stage->done);
+		stage->started = TRUE;
+
+		if(stage->setup == NULL) {
+			completion_signal(&stage->done);
+			running[i] = TRUE;
+		}
+	}
+
+	// the tasks first, so they get going while the boot task is busy
+	for(i = 0; i < BootStageCount; i++) {
+		BootStage* stage = &BootStages[i];
+		if(!running[i] && stage->parallel)
+			running[i] = (task_create(stage->name, bootStageTask, stage, BOOT_STAGE_STACK) != NULL);
+	}
+
+	for(i = 0; i < BootStageCount; i++) {
+		if(!running[i])
+			runBootStage(&BootStages[i]);
+	}
+}
+
+void waitForBootStageID(BootStageID id) {
+	if(BootStages[id].started)
+		waitForBootStage(&BootStages[id]);
+}
+
+void waitForBootStages() {
+	int i;
+	for(i = 0; i < BootStageCount; i++) {
+		BootStage* stage = &BootStages[i];
+		if(!stage->started || stage->reported)
+			continue;
+
+		waitForBootStage(stage);
+		stage->reported = TRUE;
+
+		if(stage->setup != NULL)
+			bufferPrintf("boot: %s took %d ms, done at %d ms\r\n", stage->name,
+					(uint32_t)((stage->endTime - stage->startTime) / 1000), (uint32_t)(stage->endTime / 1000));
+	}
 }
 
 static uint8_t* controlSendBuffer = NULL;
+static uint8_t* notifySendBuffer = NULL;
 static uint8_t* controlRecvBuffer = NULL;
 static uint8_t* dataSendBuffer = NULL;
 static uint8_t* dataRecvBuffer = NULL;
@@ -148,9 +390,294 @@ static size_t lastRxLen = 0;
 
 static uint8_t* sendFilePtr = NULL;
 static uint32_t sendFileBytesLeft = 0;
+static uint32_t lastTxLen = 0;
+
+// "getfile ... c": the CRC32 of the data goes out after it
+static uint32_t* sendFileTrailer = NULL;
+static int sendFileTrailerPending = FALSE;
 
 static int USB_BYTES_AT_A_TIME = 0;
 
+// File transfers are armed this many packets at a time instead of one packet per
+// interrupt. usb.c splits them up to fit DEPTSIZ and chains the pieces itself.
+#define USB_STREAM_PACKETS 2048
+
+static int streamingFile = FALSE;
+static uint64_t streamStartTime;
+static uint32_t* streamTrailer = NULL;
+
+// The chunk in flight. Each one is checksummed as soon as the next is armed,
+// so the CRC is ready by the time the trailer comes in.
+static size_t streamPending = 0;
+static uint32_t streamCRC = 0;
+
+// Optional size and CRC32 given to "sendfile"
+static uint32_t sendFileExpectedLen = 0;
+static uint32_t sendFileExpectedCRC = 0;
+static int sendFileCheckCRC = FALSE;
+
+// RPC requests are received in interrupt context and run from the main loop.
+// The response goes back through the getfile path.
+typedef enum RPCState {
+	RPCIdle,
+	RPCReceiving,
+	RPCReady,
+	RPCSending,
+	RPCSent
+} RPCState;
+
+// A "nanddump" goes out through the getfile path too, reporting at most
+// NANDDUMP_ROUND bytes at a time since all of it may not fit in a dataLen.
+// Chunks are sent straight out of the dump buffers; if the next one has not
+// been read yet, the dump task sends it when it is.
+#define NANDDUMP_ROUND 0x1000000
+
+static uint64_t dumpBytesLeft = 0;
+static uint64_t dumpTotal = 0;
+static uint32_t dumpOffset = 0;
+static uint32_t dumpInFlight = 0;
+static int dumpStalled = FALSE;
+
+// "getfile ... z" works out its runs up front, so the length is known before
+// anything is sent. Data runs go straight from memory and only the run
+// headers go through zSendBuffer.
+#ifndef GETFILEZ_BLOCK
+#define GETFILEZ_BLOCK 0x1000
+#endif
+
+typedef struct GetFileZPlan {
+	uint32_t offset;
+	GetFileZRun run;
+} GetFileZPlan;
+
+static GetFileZPlan* zPlan = NULL;
+static uint32_t zRuns = 0;
+static uint32_t zRun = 0;
+static uint32_t zRunOffset = 0;
+static int zStarted = FALSE;
+static int zRunStarted = FALSE;
+static int zInFlight = FALSE;
+static uint8_t* zSource = NULL;
+static uint8_t* zSendBuffer = NULL;
+static uint32_t zLength = 0;
+static uint32_t zTotal = 0;
+static uint32_t zBytesLeft = 0;
+static uint32_t zCRC = 0;
+
+// OPENIBOOTCMD_BENCH_* state; benchMode is the command that started it, 0 when idle
+static uint32_t benchMode = 0;
+static uint32_t benchCount = 0;
+static uint32_t benchSize = 0;
+static uint32_t benchLeft = 0;
+static uint64_t benchStart;
+static uint8_t* benchBuffer = NULL;
+static uint8_t* benchSendBuffer = NULL;
+
+static uint8_t* rpcRequestBuffer = NULL;
+static uint8_t* rpcSendBuffer = NULL;
+static uint32_t rpcRequestLen = 0;
+static RPCResponse* rpcResponse = NULL;
+static volatile RPCState rpcState = RPCIdle;
+
+// OPENIBOOTCMD_SENDBATCH; batchNext is the number the next command gets
+static uint8_t* batchRecvBuffer = NULL;
+static uint32_t batchRecvLen = 0;
+static uint32_t batchNext = 1;
+static int batchReceiving = FALSE;
+
+// files and RPCs going over USB want full speed while they last
+static int usbTransferActive() {
+	return streamingFile || rxLeft > 0 || sendFileBytesLeft > 0 || rpcState != RPCIdle
+		|| dataRecvBuffer != commandRecvBuffer || dumpBytesLeft > 0 || zBytesLeft > 0 || benchMode != 0
+		|| batchReceiving;
+}
+
+static size_t streamChunk(size_t left) {
+	size_t chunk = USB_BYTES_AT_A_TIME * USB_STREAM_PACKETS;
+	return (left > chunk) ? chunk : left;
+}
+
+static uint32_t streamRate(uint64_t bytes) {
+	uint64_t elapsed = timer_get_system_microtime() - streamStartTime;
+	if(elapsed == 0)
+		elapsed = 1;
+
+	// bytes per microsecond * 1000000 / 1024
+	return (uint32_t)((bytes * 1000000) / (elapsed * 1024));
+}
+
+static void dumpSendChunk() {
+	uint32_t length;
+	uint8_t* buffer = nanddump_peek(&length);
+	if(buffer == NULL) {
+		dumpStalled = TRUE;
+		return;
+	}
+
+	size_t toRead = length - dumpOffset;
+	if(toRead > left)
+		toRead = left;
+
+	usb_send_bulk(1, buffer + dumpOffset, toRead);
+	dumpInFlight = toRead;
+	dumpBytesLeft -= toRead;
+	left -= toRead;
+}
+
+static void dumpChunkSent() {
+	uint32_t length;
+	if(dumpInFlight == 0)
+		return;
+
+	if(nanddump_peek(&length) == NULL) {
+		// stopped under us
+		dumpInFlight = 0;
+		return;
+	}
+
+	dumpOffset += dumpInFlight;
+	dumpInFlight = 0;
+	if(dumpOffset >= length) {
+		dumpOffset = 0;
+		nanddump_consume();
+	}
+
+	if(dumpBytesLeft == 0)
+		bufferPrintf("nand dump sent (%d KB, %d KB/s).\r\n", (uint32_t)(dumpTotal / 1024), streamRate(dumpTotal));
+}
+
+// called by the dump task with each buffer it fills
+static void dumpReady() {
+	EnterCriticalSection();
+	if(dumpStalled && left > 0) {
+		dumpStalled = FALSE;
+		dumpSendChunk();
+	}
+	LeaveCriticalSection();
+}
+
+// GETFILEZ_FILL | the byte value if the block holds nothing else, or 0
+static uint32_t zBlockFill(const uint8_t* data, uint32_t size) {
+	uint32_t i;
+
+	if((((uint32_t)data) & 0x3) == 0 && (size & 0x3) == 0) {
+		const uint32_t* words = (const uint32_t*) data;
+		uint32_t pattern = data[0] * 0x01010101;
+		for(i = 0; i < (size / 4); i++) {
+			if(words[i] != pattern)
+				return 0;
+		}
+	} else {
+		for(i = 1; i < size; i++) {
+			if(data[i] != data[0])
+				return 0;
+		}
+	}
+
+	return GETFILEZ_FILL | data[0];
+}
+
+static void getFileCompressed(uint8_t* source, uint32_t length) {
+	uint32_t blocks = (length + GETFILEZ_BLOCK - 1) / GETFILEZ_BLOCK;
+	uint32_t total = sizeof(GetFileZHeader);
+	uint32_t runs = 0;
+	uint32_t offset;
+	uint32_t crc = 0;
+
+	if(zBytesLeft > 0 || zInFlight)
+		return;
+
+	// nothing is sending from the old one any more
+	if(zPlan)
+		free(zPlan);
+
+	zPlan = malloc((blocks > 0 ? blocks : 1) * sizeof(GetFileZPlan));
+	if(zPlan == NULL) {
+		bufferPrintf("getfile: out of memory for %d blocks\r\n", blocks);
+		return;
+	}
+
+	for(offset = 0; offset < length; offset += GETFILEZ_BLOCK) {
+		uint32_t size = ((length - offset) > GETFILEZ_BLOCK) ? GETFILEZ_BLOCK : (length - offset);
+		uint32_t fill = zBlockFill(source + offset, size);
+
+		if(runs > 0 && zPlan[runs - 1].run.fill == fill) {
+			zPlan[runs - 1].run.length += size;
+		} else {
+			zPlan[runs].offset = offset;
+			zPlan[runs].run.length = size;
+			zPlan[runs].run.fill = fill;
+			runs++;
+		}
+	}
+
+	for(offset = 0; offset < runs; offset++) {
+		total += sizeof(GetFileZRun);
+		if(!(zPlan[offset].run.fill & GETFILEZ_FILL))
+			total += zPlan[offset].run.length;
+	}
+
+	crc32(&crc, source, length);
+
+	EnterCriticalSection();
+	zSource = source;
+	zLength = length;
+	zRuns = runs;
+	zRun = 0;
+	zRunOffset = 0;
+	zStarted = FALSE;
+	zRunStarted = FALSE;
+	zCRC = crc;
+	zTotal = zBytesLeft = total;
+	LeaveCriticalSection();
+}
+
+static void zSend(uint8_t* data, size_t length) {
+	usb_send_bulk(1, data, length);
+	zInFlight = TRUE;
+	zBytesLeft -= length;
+	left -= length;
+
+	if(zBytesLeft == 0)
+		bufferPrintf("file sent (%d bytes as %d, crc32 %08x, %d KB/s).\r\n", zLength, zTotal, zCRC, streamRate(zLength));
+}
+
+static void zNextRun() {
+	zRun++;
+	zRunOffset = 0;
+	zRunStarted = FALSE;
+}
+
+static void zSendChunk() {
+	if(!zStarted) {
+		GetFileZHeader* header = (GetFileZHeader*) zSendBuffer;
+		header->magic = GETFILEZ_MAGIC;
+		header->length = zLength;
+		zStarted = TRUE;
+		zSend(zSendBuffer, sizeof(GetFileZHeader));
+		return;
+	}
+
+	GetFileZPlan* plan = &zPlan[zRun];
+	if(!zRunStarted) {
+		memcpy(zSendBuffer, &plan->run, sizeof(GetFileZRun));
+		zRunStarted = TRUE;
+		if(plan->run.fill & GETFILEZ_FILL)
+			zNextRun();
+
+		zSend(zSendBuffer, sizeof(GetFileZRun));
+		return;
+	}
+
+	size_t toRead = streamChunk(plan->run.length - zRunOffset);
+	uint8_t* data = zSource + plan->offset + zRunOffset;
+	zRunOffset += toRead;
+	if(zRunOffset == plan->run.length)
+		zNextRun();
+
+	zSend(data, toRead);
+}
+
 static void addToCommandQueue(const char* command) {
 	EnterCriticalSection();
 
@@ -163,9 +690,55 @@ static void addToCommandQueue(const char* command) {
 		return;
 	}
 
+	queueCommand(command, 0);
+	LeaveCriticalSection();
+}
+
+// Splits a batch that has come in into its commands.
+static void addBatchToCommandQueue(char* batch, uint32_t length) {
+	char* end = batch + length;
+	char* line = batch;
+
+	while(line < end) {
+		char* eol = line;
+		while(eol < end && *eol != '\n')
+			eol++;
+
+		*eol = '\0';
+		if(eol > line && *(eol - 1) == '\r')
+			*(eol - 1) = '\0';
+
+		if(*line != '\0')
+			queueCommand(line, batchNext++);
+
+		line = eol + 1;
+	}
+}
+
+void queueConsoleCommand(const char* command) {
+	EnterCriticalSection();
+	queueCommand(command, 0);
+	LeaveCriticalSection();
+}
+
+static void queueCommand(const char* command, uint32_t batchNumber) {
+	if(isCancel(command)) {
+		if(CommandRunning) {
+			CommandCancel = TRUE;
+			bufferPrintf("Cancelling...\r\n");
+		} else {
+			bufferPrintf("Nothing to cancel.\r\n");
+		}
+
+		if(batchNumber != 0)
+			bufferPrintf("batch: %u done\r\n", batchNumber);
+		return;
+	}
+
 	CommandQueue* toAdd = malloc(sizeof(CommandQueue));
 	toAdd->next = NULL;
 	toAdd->command = strdup(command);
+	toAdd->batchNumber = batchNumber;
 
 	CommandQueue* prev = NULL;
 	CommandQueue* cur = commandQueue;
@@ -179,12 +752,12 @@ static void addToCommandQueue(const char* command) {
 	} else {
 		prev->next = toAdd;
 	}
-	LeaveCriticalSection();
+	completion_signal(&CommandWake);
 }
 
 static void processCommand(char* command) {
-	int argc;
-	char** argv = tokenize(command, &argc);
+	char* argv[TOKENIZE_MAX_ARGS];
+	int argc = tokenize_into(command, argv, TOKENIZE_MAX_ARGS);
 
 	if(strcmp(argv[0], "sendfile") == 0) {
 		if(argc >= 2) {
@@ -192,44 +765,217 @@ static void processCommand(char* command) {
 			EnterCriticalSection();
 			if(dataRecvBuffer == commandRecvBuffer) {
 				dataRecvBuffer = (uint8_t*) parseNumber(argv[1]);
+				sendFileExpectedLen = (argc >= 3) ? parseNumber(argv[2]) : 0;
+				sendFileCheckCRC = (argc >= 4);
+				sendFileExpectedCRC = sendFileCheckCRC ? parseNumber(argv[3]) : 0;
 			}
 			LeaveCriticalSection();
-			free(argv);
 			return;
 		}
 	}
 
 	if(strcmp(argv[0], "getfile") == 0) {
+		if(argc >= 4 && strcmp(argv[3], "z") == 0) {
+			getFileCompressed((uint8_t*) parseNumber(argv[1]), parseNumber(argv[2]));
+			return;
+		}
+
 		if(argc >= 3) {
+			uint8_t* address = (uint8_t*) parseNumber(argv[1]);
+			uint32_t length = parseNumber(argv[2]);
+			int checked = (argc >= 4 && strcmp(argv[3], "c") == 0);
+			uint32_t crc = 0;
+
+			// worked out here rather than after the last chunk in interrupt context
+			if(checked)
+				crc32(&crc, address, length);
+
 			// enter file mode
 			EnterCriticalSection();
 			if(sendFileBytesLeft == 0) {
-				sendFilePtr = (uint8_t*) parseNumber(argv[1]);
-				sendFileBytesLeft = parseNumber(argv[2]);
+				sendFilePtr = address;
+				sendFileBytesLeft = lastTxLen = length;
+				*sendFileTrailer = crc;
+				sendFileTrailerPending = checked;
 			}
 			LeaveCriticalSection();
-			free(argv);
+
+			// the host collects it like console output, so tell it there is some
+			scrollbackChanged();
 			return;
 		}
 	}
 
-	OPIBCommand* curCommand = CommandList;
-
-	int success = FALSE;
-	while(curCommand->name != NULL) {
-		if(strcmp(argv[0], curCommand->name) == 0) {
-			curCommand->routine(argc, argv);
-			success = TRUE;
-			break;
+	if(strcmp(argv[0], "nanddump") == 0) {
+		if(argc >= 3) {
+			if(dumpBytesLeft == 0 && dumpInFlight == 0) {
+				uint64_t total = nanddump_start(parseNumber(argv[1]), parseNumber(argv[2]), dumpReady);
+				EnterCriticalSection();
+				dumpBytesLeft = dumpTotal = total;
+				dumpOffset = 0;
+				dumpStalled = FALSE;
+				LeaveCriticalSection();
+			}
+			return;
 		}
-		curCommand++;
 	}
 
-	if(!success) {
+	if(!command_run(argc, argv)) {
 		bufferPrintf("unknown command: %s\r\n", command);
 	}
+}
+
+// Returns how much went out, which is less than toRead at the end of the
+// data when a CRC32 trailer follows it.
+static size_t sendFileChunk(size_t toRead) {
+	if(toRead > sendFileBytesLeft)
+		toRead = sendFileBytesLeft;
+
+	usb_send_bulk(1, sendFilePtr, toRead);
+	sendFilePtr += toRead;
+	sendFileBytesLeft -= toRead;
+	if(sendFileBytesLeft == 0) {
+		if(rpcState == RPCSending) {
+			// the main loop frees the response
+			rpcState = RPCSent;
+			completion_signal(&MainLoopWake);
+			streamingFile = FALSE;
+			return toRead;
+		}
+
+		if(sendFileTrailerPending) {
+			bufferPrintf("file sent (%d bytes, crc32 %08x, %d KB/s).\r\n", lastTxLen, *sendFileTrailer, streamRate(lastTxLen));
+			sendFileTrailerPending = FALSE;
+			sendFilePtr = (uint8_t*) sendFileTrailer;
+			sendFileBytesLeft = sizeof(uint32_t);
+			lastTxLen = 0;
+			return toRead;
+		}
+
+		if(lastTxLen == 0) {
+			// that was the trailer
+			streamingFile = FALSE;
+			return toRead;
+		}
+
+		uint32_t crc = 0;
+		crc32(&crc, sendFilePtr - lastTxLen, lastTxLen);
+		bufferPrintf("file sent (%d bytes, crc32 %08x, %d KB/s).\r\n", lastTxLen, crc, streamRate(lastTxLen));
+		streamingFile = FALSE;
+	}
 
-	free(argv);
+	return toRead;
+}
+
+// Endpoint 3 carries both replies and unsolicited OPENIBOOTCMD_NOTIFY messages. Only one
+// transfer may be programmed at a time, so anything else waits for controlSent.
+static int controlSending = FALSE;
+static int replyPending = FALSE;
+static int notifyPending = FALSE;
+static int consoleNotified = FALSE;
+static int consoleStarted = FALSE;
+static int rpcReplyPending = FALSE;
+static int benchReplyPending = FALSE;
+
+static void sendNotify() {
+	OpenIBootCmd* notify = (OpenIBootCmd*)notifySendBuffer;
+	notify->command = OPENIBOOTCMD_NOTIFY;
+	notify->dataLen = getScrollbackLen();
+	controlSending = TRUE;
+	usb_send_interrupt(3, notifySendBuffer, sizeof(OpenIBootCmd));
+}
+
+static void sendReply() {
+	EnterCriticalSection();
+	if(controlSending) {
+		replyPending = TRUE;
+	} else {
+		controlSending = TRUE;
+		usb_send_interrupt(3, controlSendBuffer, sizeof(OpenIBootCmd));
+	}
+	LeaveCriticalSection();
+}
+
+static void sendRPCReply() {
+	controlSending = TRUE;
+	usb_send_interrupt(3, rpcSendBuffer, sizeof(OpenIBootCmd));
+}
+
+static void sendBenchReply() {
+	controlSending = TRUE;
+	usb_send_interrupt(3, benchSendBuffer, sizeof(OpenIBootCmd));
+}
+
+// one bench transfer is done, start the next or report
+static void benchNext() {
+	if(--benchLeft > 0) {
+		if(benchMode == OPENIBOOTCMD_BENCH_SOURCE)
+			usb_send_bulk(1, benchBuffer, benchSize);
+		else
+			usb_receive_bulk(2, benchBuffer, benchSize);
+		return;
+	}
+
+	OpenIBootCmd* reply = (OpenIBootCmd*)benchSendBuffer;
+	uint64_t elapsed = timer_get_system_microtime() - benchStart;
+	reply->command = OPENIBOOTCMD_BENCH_DONE;
+	reply->dataLen = (elapsed > 0xFFFFFFFF) ? 0xFFFFFFFF : (uint32_t) elapsed;
+	benchMode = 0;
+
+	EnterCriticalSection();
+	if(controlSending)
+		benchReplyPending = TRUE;
+	else
+		sendBenchReply();
+	LeaveCriticalSection();
+}
+
+static void processRPC() {
+	if(rpcState == RPCSent) {
+		free(rpcResponse);
+		rpcResponse = NULL;
+		rpcState = RPCIdle;
+		return;
+	}
+
+	if(rpcState != RPCReady)
+		return;
+
+	uint32_t responseLen;
+	RPCResponse* response = rpc_handle((RPCRequest*) rpcRequestBuffer, rpcRequestLen, &responseLen);
+
+	EnterCriticalSection();
+	OpenIBootCmd* reply = (OpenIBootCmd*)rpcSendBuffer;
+	reply->command = OPENIBOOTCMD_RPC_REPLY;
+	reply->dataLen = responseLen;
+
+	if(response == NULL) {
+		rpcState = RPCIdle;
+	} else {
+		rpcResponse = response;
+		sendFilePtr = (uint8_t*) response;
+		sendFileBytesLeft = lastTxLen = responseLen;
+		rpcState = RPCSending;
+	}
+
+	if(controlSending)
+		rpcReplyPending = TRUE;
+	else
+		sendRPCReply();
+	LeaveCriticalSection();
+}
+
+// Tells the host there is new output, once per OPENIBOOTCMD_DUMPBUFFER
+static void scrollbackChanged() {
+	EnterCriticalSection();
+	if(consoleStarted && !consoleNotified) {
+		consoleNotified = TRUE;
+		if(controlSending)
+			notifyPending = TRUE;
+		else
+			sendNotify();
+	}
+	LeaveCriticalSection();
 }
 
 static void controlReceived(uint32_t token) {
@@ -239,34 +985,56 @@ static void controlReceived(uint32_t token) {
 	if(cmd->command == OPENIBOOTCMD_DUMPBUFFER) {
 		int length;
 
-		if(sendFileBytesLeft > 0) {
-			length = sendFileBytesLeft;
+		// the host is draining the scrollback, so anything printed from now on needs a new notification
+		consoleNotified = FALSE;
+
+		if(dumpBytesLeft > 0) {
+			length = (dumpBytesLeft > NANDDUMP_ROUND) ? NANDDUMP_ROUND : dumpBytesLeft;
+		} else if(zBytesLeft > 0) {
+			length = zBytesLeft;
+		} else if(sendFileBytesLeft > 0) {
+			length = sendFileBytesLeft + (sendFileTrailerPending ? sizeof(uint32_t) : 0);
 		} else {
 			length = getScrollbackLen(); // getScrollbackLen();// USB_BYTES_AT_A_TIME;
 		}
 
 		reply->command = OPENIBOOTCMD_DUMPBUFFER_LEN;
 		reply->dataLen = length;
-		usb_send_interrupt(3, controlSendBuffer, sizeof(OpenIBootCmd));
+		sendReply();
 		//uartPrintf("got dumpbuffer cmd, returning length: %d\r\n", length);
 	} else if(cmd->command == OPENIBOOTCMD_DUMPBUFFER_GOAHEAD) {
 		left = cmd->dataLen;
 
 		//uartPrintf("got dumpbuffer goahead, writing length: %d\r\n", (int)left);
 
-		size_t toRead = (left > USB_BYTES_AT_A_TIME) ? USB_BYTES_AT_A_TIME: left;
-		if(sendFileBytesLeft > 0) {
-			usb_send_bulk(1, sendFilePtr, toRead);
-			sendFilePtr += toRead;
-			sendFileBytesLeft -= toRead;
-			if(sendFileBytesLeft == 0) {
-				bufferPrintf("file sent.\r\n");
-			}
+		if(dumpBytesLeft > 0) {
+			if(dumpBytesLeft == dumpTotal && dumpInFlight == 0)
+				streamStartTime = timer_get_system_microtime();
+
+			// with a chunk still in flight, dataSent carries on
+			if(dumpInFlight == 0 && !dumpStalled)
+				dumpSendChunk();
+		} else if(zBytesLeft > 0) {
+			if(!zStarted)
+				streamStartTime = timer_get_system_microtime();
+
+			if(!zInFlight)
+				zSendChunk();
 		} else {
-			bufferFlush((char*) dataSendBuffer, toRead);
-			usb_send_bulk(1, dataSendBuffer, toRead);
+			size_t toRead = (left > USB_BYTES_AT_A_TIME) ? USB_BYTES_AT_A_TIME: left;
+			if(sendFileBytesLeft > 0) {
+				toRead = streamChunk(left);
+				if(!streamingFile) {
+					streamingFile = TRUE;
+					streamStartTime = timer_get_system_microtime();
+				}
+				toRead = sendFileChunk(toRead);
+			} else {
+				bufferFlush((char*) dataSendBuffer, toRead);
+				usb_send_bulk(1, dataSendBuffer, toRead);
+			}
+			left -= toRead;
 		}
-		left -= toRead;
 	} else if(cmd->command == OPENIBOOTCMD_SENDCOMMAND) {
 		dataRecvPtr = dataRecvBuffer;
 		rxLeft = cmd->dataLen;
@@ -276,18 +1044,197 @@ static void controlReceived(uint32_t token) {
 
 		reply->command = OPENIBOOTCMD_SENDCOMMAND_GOAHEAD;
 		reply->dataLen = cmd->dataLen;
-		usb_send_interrupt(3, controlSendBuffer, sizeof(OpenIBootCmd));
+		sendReply();
 
 		size_t toRead = (rxLeft > USB_BYTES_AT_A_TIME) ? USB_BYTES_AT_A_TIME: rxLeft;
 		usb_receive_bulk(2, dataRecvPtr, toRead);
 		rxLeft -= toRead;
 		dataRecvPtr += toRead;
+	} else if(cmd->command == OPENIBOOTCMD_SENDFILE) {
+		// Streams straight into the buffer given to "sendfile", followed by a
+		// four byte CRC32 trailer and answered with OPENIBOOTCMD_SENDFILE_DONE.
+		// A dataLen of zero in the reply means no, as does a size other than
+		// the one given to "sendfile".
+		reply->command = OPENIBOOTCMD_SENDFILE_GOAHEAD;
+		reply->dataLen = 0;
+
+		if(dataRecvBuffer != commandRecvBuffer && !streamingFile && (((uint32_t)dataRecvBuffer) & 0x3) == 0
+				&& (sendFileExpectedLen == 0 || cmd->dataLen == sendFileExpectedLen)) {
+			streamingFile = TRUE;
+			streamCRC = 0;
+			streamStartTime = timer_get_system_microtime();
+			dataRecvPtr = dataRecvBuffer;
+			rxLeft = cmd->dataLen;
+			lastRxLen = rxLeft;
+			reply->dataLen = cmd->dataLen;
+		}
+
+		sendReply();
+
+		if(streamingFile) {
+			size_t toRead = streamChunk(rxLeft);
+			streamPending = toRead;
+			if(toRead == 0) {
+				dataRecvPtr = NULL;
+				usb_receive_bulk(2, streamTrailer, sizeof(uint32_t));
+			} else {
+				usb_receive_bulk(2, dataRecvPtr, toRead);
+				rxLeft -= toRead;
+				dataRecvPtr += toRead;
+			}
+		}
+	} else if(cmd->command == OPENIBOOTCMD_RPC) {
+		// One request at a time. A dataLen of zero in the reply means no.
+		int accept = (rpcState == RPCIdle && !streamingFile && rxLeft == 0 && sendFileBytesLeft == 0
+				&& cmd->dataLen >= sizeof(RPCRequest) && cmd->dataLen <= RPC_MAX_REQUEST);
+
+		reply->command = OPENIBOOTCMD_RPC_GOAHEAD;
+		reply->dataLen = accept ? cmd->dataLen : 0;
+		sendReply();
+
+		if(accept) {
+			rpcState = RPCReceiving;
+			dataRecvPtr = rpcRequestBuffer;
+			rxLeft = rpcRequestLen = cmd->dataLen;
+
+			size_t toRead = streamChunk(rxLeft);
+			usb_receive_bulk(2, dataRecvPtr, toRead);
+			rxLeft -= toRead;
+			dataRecvPtr += toRead;
+		}
+	} else if(cmd->command == OPENIBOOTCMD_SENDBATCH) {
+		int accept = (!batchReceiving && rpcState == RPCIdle && !streamingFile && rxLeft == 0
+				&& dataRecvBuffer == commandRecvBuffer && cmd->dataLen > 0 && cmd->dataLen <= OPENIBOOTCMD_BATCH_MAX);
+
+		reply->command = OPENIBOOTCMD_SENDBATCH_GOAHEAD;
+		reply->dataLen = accept ? batchNext : 0;
+		sendReply();
+
+		if(accept) {
+			batchReceiving = TRUE;
+			dataRecvPtr = batchRecvBuffer;
+			rxLeft = batchRecvLen = cmd->dataLen;
+
+			size_t toRead = streamChunk(rxLeft);
+			usb_receive_bulk(2, dataRecvPtr, toRead);
+			rxLeft -= toRead;
+			dataRecvPtr += toRead;
+		}
+	} else if(cmd->command == OPENIBOOTCMD_BENCH_COUNT) {
+		benchCount = cmd->dataLen;
+	} else if(cmd->command == OPENIBOOTCMD_BENCH_SINK || cmd->command == OPENIBOOTCMD_BENCH_SOURCE
+			|| cmd->command == OPENIBOOTCMD_BENCH_ECHO) {
+		int accept = (!usbTransferActive() && left == 0 && benchCount > 0
+				&& cmd->dataLen > 0 && cmd->dataLen <= USBBENCH_MAX_TRANSFER);
+
+		reply->command = OPENIBOOTCMD_BENCH_GOAHEAD;
+		reply->dataLen = accept ? cmd->dataLen : 0;
+		sendReply();
+
+		if(accept) {
+			benchMode = cmd->command;
+			benchSize = cmd->dataLen;
+			benchLeft = benchCount;
+			benchStart = timer_get_system_microtime();
+
+			if(benchMode == OPENIBOOTCMD_BENCH_SOURCE)
+				usb_send_bulk(1, benchBuffer, benchSize);
+			else
+				usb_receive_bulk(2, benchBuffer, benchSize);
+		}
 	}
 
 	usb_receive_interrupt(4, controlRecvBuffer, sizeof(OpenIBootCmd));
 }
 
+static void streamReceived() {
+	uint8_t* received = dataRecvPtr - streamPending;
+	size_t receivedLen = streamPending;
+
+	streamPending = 0;
+	if(rxLeft > 0) {
+		size_t toRead = streamChunk(rxLeft);
+		usb_receive_bulk(2, dataRecvPtr, toRead);
+		rxLeft -= toRead;
+		dataRecvPtr += toRead;
+		streamPending = toRead;
+	} else if(dataRecvPtr != NULL) {
+		// all of the data is in, now fetch the trailer
+		dataRecvPtr = NULL;
+		usb_receive_bulk(2, streamTrailer, sizeof(uint32_t));
+	} else {
+		OpenIBootCmd* reply = (OpenIBootCmd*)controlSendBuffer;
+		int ok = (streamCRC == *streamTrailer) && (!sendFileCheckCRC || streamCRC == sendFileExpectedCRC);
+
+		if(ok) {
+			bufferPrintf("file received (%d bytes, crc32 %08x, %d KB/s).\r\n", lastRxLen, streamCRC, streamRate(lastRxLen));
+			received_file_size = lastRxLen;
+		} else {
+			bufferPrintf("file received with bad crc32 (%08x, expected %08x)!\r\n", streamCRC,
+					sendFileCheckCRC ? sendFileExpectedCRC : *streamTrailer);
+			received_file_size = 0;
+		}
+
+		dataRecvBuffer = commandRecvBuffer;
+		streamingFile = FALSE;
+		sendFileExpectedLen = 0;
+		sendFileCheckCRC = FALSE;
+
+		reply->command = OPENIBOOTCMD_SENDFILE_DONE;
+		reply->dataLen = ok;
+		sendReply();
+	}
+
+	// runs while the next chunk is arriving
+	if(receivedLen > 0)
+		crc32(&streamCRC, received, receivedLen);
+}
+
 static void dataReceived(uint32_t token) {
+	if(benchMode == OPENIBOOTCMD_BENCH_SINK) {
+		benchNext();
+		return;
+	}
+
+	if(benchMode == OPENIBOOTCMD_BENCH_ECHO) {
+		usb_send_bulk(1, benchBuffer, benchSize);
+		return;
+	}
+
+	if(streamingFile) {
+		streamReceived();
+		return;
+	}
+
+	if(rpcState == RPCReceiving) {
+		if(rxLeft > 0) {
+			size_t toRead = streamChunk(rxLeft);
+			usb_receive_bulk(2, dataRecvPtr, toRead);
+			rxLeft -= toRead;
+			dataRecvPtr += toRead;
+		} else {
+			rpcState = RPCReady;
+			completion_signal(&MainLoopWake);
+		}
+		return;
+	}
+
+	if(batchReceiving) {
+		if(rxLeft > 0) {
+			size_t toRead = streamChunk(rxLeft);
+			usb_receive_bulk(2, dataRecvPtr, toRead);
+			rxLeft -= toRead;
+			dataRecvPtr += toRead;
+		} else {
+			// the commands are copied out, so the buffer is free for the next batch
+			EnterCriticalSection();
+			addBatchToCommandQueue((char*) batchRecvBuffer, batchRecvLen);
+			batchReceiving = FALSE;
+			LeaveCriticalSection();
+		}
+		return;
+	}
+
 	//uartPrintf("receiving remainder: %d\r\n", (int)rxLeft);
 	if(rxLeft > 0) {
 		size_t toRead = (rxLeft > USB_BYTES_AT_A_TIME) ? USB_BYTES_AT_A_TIME: rxLeft;
@@ -302,15 +1249,34 @@ static void dataReceived(uint32_t token) {
 
 static void dataSent(uint32_t token) {
 	//uartPrintf("sending remainder: %d\r\n", (int)left);
+	if(benchMode == OPENIBOOTCMD_BENCH_SOURCE || benchMode == OPENIBOOTCMD_BENCH_ECHO) {
+		benchNext();
+		return;
+	}
+
+	if(dumpInFlight > 0) {
+		dumpChunkSent();
+		if(left > 0)
+			dumpSendChunk();
+		return;
+	}
+
+	if(zInFlight) {
+		zInFlight = FALSE;
+		if(left > 0 && zBytesLeft > 0)
+			zSendChunk();
+		return;
+	}
+
 	if(left > 0) {
 		size_t toRead = (left > USB_BYTES_AT_A_TIME) ? USB_BYTES_AT_A_TIME: left;
 		if(sendFileBytesLeft > 0) {
-			usb_send_bulk(1, sendFilePtr, toRead);
-			sendFilePtr += toRead;
-			sendFileBytesLeft -= toRead;
-			if(sendFileBytesLeft == 0) {
-				bufferPrintf("file sent.\r\n");
+			toRead = streamChunk(left);
+			if(!streamingFile) {
+				streamingFile = TRUE;
+				streamStartTime = timer_get_system_microtime();
 			}
+			toRead = sendFileChunk(toRead);
 		} else {
 			bufferFlush((char*) dataSendBuffer, toRead);
 			usb_send_bulk(1, dataSendBuffer, toRead);
@@ -321,6 +1287,23 @@ static void dataSent(uint32_t token) {
 
 static void controlSent(uint32_t token) {
 	//uartPrintf("control sent\r\n");
+	EnterCriticalSection();
+	controlSending = FALSE;
+	if(replyPending) {
+		replyPending = FALSE;
+		controlSending = TRUE;
+		usb_send_interrupt(3, controlSendBuffer, sizeof(OpenIBootCmd));
+	} else if(rpcReplyPending) {
+		rpcReplyPending = FALSE;
+		sendRPCReply();
+	} else if(benchReplyPending) {
+		benchReplyPending = FALSE;
+		sendBenchReply();
+	} else if(notifyPending) {
+		notifyPending = FALSE;
+		sendNotify();
+	}
+	LeaveCriticalSection();
 }
 
 static void enumerateHandler(USBInterface* interface) {
@@ -330,16 +1313,43 @@ static void enumerateHandler(USBInterface* interface) {
 	usb_add_endpoint(interface, 4, USBOut, USBInterrupt);
 
 	if(!controlSendBuffer)
-		controlSendBuffer = memalign(DMA_ALIGN, 512);
+		controlSendBuffer = dma_coherent_alloc(512);
+
+	if(!notifySendBuffer)
+		notifySendBuffer = dma_coherent_alloc(512);
 
 	if(!controlRecvBuffer)
-		controlRecvBuffer = memalign(DMA_ALIGN, 512);
+		controlRecvBuffer = dma_coherent_alloc(512);
 
 	if(!dataSendBuffer)
-		dataSendBuffer = memalign(DMA_ALIGN, 512);
+		dataSendBuffer = dma_coherent_alloc(512);
 
 	if(!dataRecvBuffer)
-		dataRecvBuffer = commandRecvBuffer = memalign(DMA_ALIGN, 512);
+		dataRecvBuffer = commandRecvBuffer = dma_coherent_alloc(512);
+
+	if(!streamTrailer)
+		streamTrailer = dma_coherent_alloc(512);
+
+	if(!zSendBuffer)
+		zSendBuffer = dma_coherent_alloc(512);
+
+	if(!rpcSendBuffer)
+		rpcSendBuffer = dma_coherent_alloc(512);
+
+	if(!rpcRequestBuffer)
+		rpcRequestBuffer = memalign(DMA_ALIGN, RPC_MAX_REQUEST);
+
+	if(!sendFileTrailer)
+		sendFileTrailer = dma_coherent_alloc(512);
+
+	if(!batchRecvBuffer)
+		batchRecvBuffer = memalign(DMA_ALIGN, OPENIBOOTCMD_BATCH_MAX + 1);
+
+	if(!benchSendBuffer)
+		benchSendBuffer = dma_coherent_alloc(512);
+
+	if(!benchBuffer)
+		benchBuffer = memalign(DMA_ALIGN, USBBENCH_MAX_TRANSFER);
 }
 
 static void startHandler() {
@@ -349,17 +1359,57 @@ static void startHandler() {
 		USB_BYTES_AT_A_TIME = 0x80;
 	}
 
+	controlSending = FALSE;
+	replyPending = FALSE;
+	notifyPending = FALSE;
+	consoleNotified = FALSE;
+	consoleStarted = TRUE;
+	rpcReplyPending = FALSE;
+	benchReplyPending = FALSE;
+	benchMode = 0;
+
+	// a transfer cut off by a reset will never complete
+	if(dumpBytesLeft > 0 || dumpInFlight > 0) {
+		nanddump_stop();
+		dumpBytesLeft = 0;
+		dumpInFlight = 0;
+		dumpStalled = FALSE;
+	}
+
+	zBytesLeft = 0;
+	zInFlight = FALSE;
+
+	if(batchReceiving) {
+		batchReceiving = FALSE;
+		rxLeft = 0;
+	}
+
+	if(rpcState == RPCReceiving) {
+		rpcState = RPCIdle;
+	} else if(rpcState == RPCSending) {
+		sendFileBytesLeft = 0;
+		streamingFile = FALSE;
+		rpcState = RPCSent;
+		completion_signal(&MainLoopWake);
+	}
+
 	usb_receive_interrupt(4, controlRecvBuffer, sizeof(OpenIBootCmd));
 }
 
-static void startUSB()
+void startUSB()
 {
+	if(usbacm_enabled()) {
+		usbacm_start();
+		return;
+	}
+
 	usb_setup();
 	usb_install_ep_handler(4, USBOut, controlReceived, 0);
 	usb_install_ep_handler(2, USBOut, dataReceived, 0);
 	usb_install_ep_handler(3, USBIn, controlSent, 0);
 	usb_install_ep_handler(1, USBIn, dataSent, 0);
 	usb_start(enumerateHandler, startHandler);
+	setScrollbackHandler(scrollbackChanged);
 }
 
 static int setup_devices() {
@@ -395,22 +1445,36 @@ static int setup_openiboot() {
 	mmu_setup();
 	tasks_setup();
 	setup_devices();
+	bootprof_mark("devices", 0);
+
+	// before anything that could take over what the last openiboot left running
+	handoff_take();
 
 	LeaveCriticalSection();
 
+	// a kernel waking up from sleep needs none of the rest
+	resume_check();
+
 	clock_set_sdiv(0);
 
 	aes_setup();
 
 	nor_setup();
+	bootprof_mark("nor", 0);
 	syscfg_setup();
-	images_setup();
+	// images keep their index in nvram
 	nvram_setup();
+	bootprof_mark("nvram", 0);
 
-	lcd_setup();
-	framebuffer_setup();
+	const char* logMask = nvram_getvar(LOG_MASK_VAR);
+	if(logMask)
+		LogMask = parseNumber(logMask);
 
-	audiohw_init();
+	images_setup();
+	bootprof_mark("images", 0);
+
+	buttons_setup();
+	workqueue_setup();
 
 	return 0;
 }
@@ -1,14 +1,71 @@
 #include "openiboot.h"
 #include "pmu.h"
 #include "hardware/pmu.h"
+#include "hardware/lcd.h"
 #include "i2c.h"
 #include "timer.h"
 #include "gpio.h"
 #include "lcd.h"
+#include "util.h"
 
 static uint32_t GPMemCachedPresent = 0;
 static uint8_t GPMemCache[PMU_MAXREG + 1];
 
+// Shadows of the registers only openiboot itself changes, so reading them
+// back costs nothing and writing the value they already hold is skipped.
+// Status, ADC and RTC registers are always read from the PMU.
+static uint8_t Shadow[PMU_SHADOW_REGS];
+static uint32_t ShadowValid[(PMU_SHADOW_REGS + 31) / 32];
+
+// The last battery reading and power supply identification
+static int BatteryVoltage;
+static uint64_t BatteryVoltageTime;
+static int BatteryVoltageValid = FALSE;
+static PowerSupplyType SupplyType;
+static int SupplyMBCS1;
+static uint64_t SupplyTime;
+static int SupplyValid = FALSE;
+
+static int shadowed(int reg) {
+	switch(reg) {
+		case PMU_GPIOCTL:
+		case PMU_GPIO1CFG:
+		case PMU_GPIO1CFG + 1:
+		case PMU_GPIO1CFG + 2:
+		case LCD_I2C_COMMAND:
+			return TRUE;
+	}
+
+	return FALSE;
+}
+
+static int shadow_get(int reg, uint8_t* out) {
+	if(!shadowed(reg) || (ShadowValid[reg / 32] & (1 << (reg % 32))) == 0)
+		return FALSE;
+
+	*out = Shadow[reg];
+	return TRUE;
+}
+
+static void shadow_set(int reg, uint8_t data) {
+	if(!shadowed(reg))
+		return;
+
+	Shadow[reg] = data;
+	ShadowValid[reg / 32] |= 1 << (reg % 32);
+}
+
+static void shadow_forget(int reg) {
+	if(shadowed(reg))
+		ShadowValid[reg / 32] &= ~(1 << (reg % 32));
+}
+
+void pmu_forget_shadows() {
+	memset(ShadowValid, 0, sizeof(ShadowValid));
+	BatteryVoltageValid = FALSE;
+	SupplyValid = FALSE;
+}
+
 int pmu_setup() {
 	return 0;
 }
@@ -75,27 +132,49 @@ int pmu_get_reg(int reg) {
 	uint8_t registers[1];
 	uint8_t out[1];
 
+	if(shadow_get(reg, &out[0]))
+		return out[0];
+
 	registers[0] = reg;
 
-	i2c_rx(PMU_I2C_BUS, PMU_GETADDR, registers, 1, out, 1);
+	if(i2c_rx(PMU_I2C_BUS, PMU_GETADDR, registers, 1, out, 1) == 0)
+		shadow_set(reg, out[0]);
+
 	return out[0];
 }
 
 int pmu_get_regs(int reg, uint8_t* out, int count) {
 	uint8_t registers[1];
+	int i;
 
 	registers[0] = reg;
 
-	return i2c_rx(PMU_I2C_BUS, PMU_GETADDR, registers, 1, out, count);
+	int ret = i2c_rx(PMU_I2C_BUS, PMU_GETADDR, registers, 1, out, count);
+	if(ret == 0) {
+		for(i = 0; i < count; i++)
+			shadow_set(reg + i, out[i]);
+	}
+
+	return ret;
 }
 
 int pmu_write_reg(int reg, int data, int verify) {
 	uint8_t command[2];
+	uint8_t current;
+
+	// a verified write always goes out, so the check sees the PMU itself
+	if(!verify && shadow_get(reg, &current) && current == (uint8_t) data)
+		return 0;
 
 	command[0] = reg;
 	command[1] = data;
 
-	i2c_tx(PMU_I2C_BUS, PMU_SETADDR, command, sizeof(command));
+	if(i2c_tx(PMU_I2C_BUS, PMU_SETADDR, command, sizeof(command)) != 0) {
+		shadow_forget(reg);
+		return verify ? -1 : 0;
+	}
+
+	shadow_set(reg, data);
 
 	if(!verify)
 		return 0;
@@ -106,29 +185,80 @@ int pmu_write_reg(int reg, int data, int verify) {
 
 	if(buffer == data)
 		return 0;
-	else
-		return -1;
+
+	shadow_forget(reg);
+	return -1;
 }
 
-int pmu_write_regs(const PMURegisterData* regs, int num) {
+// One bus write for registers reg up to reg + count, without reading back
+static void pmu_write_run(int reg, const uint8_t* data, int count) {
+	uint8_t command[PMU_WRITE_BATCH + 1];
 	int i;
-	for(i = 0; i < num; i++) {
-		pmu_write_reg(regs[i].reg, regs[i].data, 1);
+
+	command[0] = reg;
+	memcpy(command + 1, data, count);
+	i2c_tx(PMU_I2C_BUS, PMU_SETADDR, command, count + 1);
+
+	for(i = 0; i < count; i++)
+		shadow_set(reg + i, data[i]);
+}
+
+// The PMU steps its register address after every byte, the same as the reads
+// in pmu_get_regs rely on, so each run of consecutive registers goes out as
+// one write and is verified with one read.
+int pmu_write_regs(const PMURegisterData* regs, int num) {
+	uint8_t command[PMU_WRITE_BATCH + 1];
+	uint8_t readback[PMU_WRITE_BATCH];
+	int ret = 0;
+	int i = 0;
+
+	while(i < num) {
+		int count = 0;
+		command[0] = regs[i].reg;
+		while((i + count) < num && count < PMU_WRITE_BATCH && regs[i + count].reg == (regs[i].reg + count)) {
+			command[count + 1] = regs[i + count].data;
+			count++;
+		}
+
+		i2c_tx(PMU_I2C_BUS, PMU_SETADDR, command, count + 1);
+
+		uint8_t pmuReg = regs[i].reg;
+		int j;
+		if(i2c_rx(PMU_I2C_BUS, PMU_GETADDR, &pmuReg, 1, readback, count) != 0 || memcmp(readback, command + 1, count) != 0) {
+			for(j = 0; j < count; j++)
+				shadow_forget(regs[i].reg + j);
+			ret = -1;
+		} else {
+			for(j = 0; j < count; j++)
+				shadow_set(regs[i].reg + j, readback[j]);
+		}
+
+		i += count;
 	}
 
-	return 0;
+	return ret;
 }
 
 int query_adc(int flags) {
 	pmu_write_reg(PMU_ADCC3, 0, FALSE);
 	pmu_write_reg(PMU_ADCC3, 0, FALSE);
 	udelay(30);
-	pmu_write_reg(PMU_ADCC2, 0, FALSE);
-	pmu_write_reg(PMU_ADCC1, PMU_ADCC1_ADCSTART | (PMU_ADCC1_ADC_AV_16 << PMU_ADCC1_ADC_AV_SHIFT) | (PMU_ADCC1_ADCINMUX_BATSNS_DIV << PMU_ADCC1_ADCINMUX_SHIFT) | flags, FALSE);
+
+	// ADCC2 and ADCC1 follow each other, so the start goes out in one write
+	uint8_t start[2];
+	start[PMU_ADCC2 - PMU_ADCC2] = 0;
+	start[PMU_ADCC1 - PMU_ADCC2] = PMU_ADCC1_ADCSTART | (PMU_ADCC1_ADC_AV_16 << PMU_ADCC1_ADC_AV_SHIFT) | (PMU_ADCC1_ADCINMUX_BATSNS_DIV << PMU_ADCC1_ADCINMUX_SHIFT) | flags;
+	pmu_write_run(PMU_ADCC2, start, sizeof(start));
 	udelay(30000);
-	uint8_t lower = pmu_get_reg(PMU_ADCS3);
+
+	// both halves of the result, and the ready bit, in one read
+	uint8_t result[PMU_ADCS3 - PMU_ADCS1 + 1];
+	if(pmu_get_regs(PMU_ADCS1, result, sizeof(result)) != 0)
+		return -1;
+
+	uint8_t lower = result[PMU_ADCS3 - PMU_ADCS1];
 	if((lower & 0x80) == 0x80) {
-		uint8_t upper = pmu_get_reg(PMU_ADCS1);
+		uint8_t upper = result[0];
 		return ((upper << 2) | (lower & 0x3)) * 6000 / 1023;
 	} else {
 		return -1;
@@ -136,7 +266,17 @@ int query_adc(int flags) {
 }
 
 int pmu_get_battery_voltage() {
-	return query_adc(0);
+	if(BatteryVoltageValid && !has_elapsed(BatteryVoltageTime, PMU_ADC_CACHE_TIME))
+		return BatteryVoltage;
+
+	int voltage = query_adc(0);
+	if(voltage < 0)
+		return voltage;
+
+	BatteryVoltage = voltage;
+	BatteryVoltageTime = timer_get_system_microtime();
+	BatteryVoltageValid = TRUE;
+	return voltage;
 }
 
 static int bcd_to_int(int bcd) {
@@ -333,12 +473,19 @@ PowerSupplyType pmu_get_power_supply() {
 	if(mbcs1 & PMU_MBCS1_ADAPTPRES)
 		return PowerSupplyTypeFirewire;
 
-	if(mbcs1 & PMU_MBCS1_USBOK)
-		return identify_usb_charger();
-	else
+	if(!(mbcs1 & PMU_MBCS1_USBOK))
 		return PowerSupplyTypeBattery;
 
+	// telling chargers apart takes two ADC readings; a cable pulled out and
+	// put back in between shows up as a change of MBCS1 in most cases
+	if(SupplyValid && SupplyMBCS1 == mbcs1 && !has_elapsed(SupplyTime, PMU_ADC_CACHE_TIME))
+		return SupplyType;
 
+	SupplyType = identify_usb_charger();
+	SupplyMBCS1 = mbcs1;
+	SupplyTime = timer_get_system_microtime();
+	SupplyValid = TRUE;
+	return SupplyType;
 }
 
 void pmu_charge_settings(int UseUSB, int SuspendUSB, int StopCharger) {
@@ -304,28 +304,264 @@ EMIT2:				if((flags & PR_LJ) == 0)
 #if 1 /* testing */
 /*****************************************************************************
 SPRINTF
+Same conversions as do_printf, but runs of plain text and strings go out
+with one copy each and 32-bit numbers are converted without division, as
+Thumb has no divide and no long multiply.
 *****************************************************************************/
-static int vsprintf_help(unsigned c, void **ptr)
+typedef struct
 {
-	char *dst;
+	char *pos;
+	uint32_t room;		/* bytes left, not counting the NUL */
+	int count;
+} sprintf_out_t;
 
-	dst = *ptr;
-	*dst++ = (char)c;
-	*ptr = dst;
-	return 0 ;
+static void sprintf_copy(sprintf_out_t *out, const char *str, uint32_t len)
+{
+	out->count += len;
+	if(len > out->room)
+		len = out->room;
+	memcpy(out->pos, str, len);
+	out->pos += len;
+	out->room -= len;
+}
+
+static void sprintf_fill(sprintf_out_t *out, char c, uint32_t len)
+{
+	out->count += len;
+	if(len > out->room)
+		len = out->room;
+	memset(out->pos, c, len);
+	out->pos += len;
+	out->room -= len;
+}
+
+static const uint32_t sprintf_pow10[] =
+{
+	1000000000, 100000000, 10000000, 1000000, 100000,
+	10000, 1000, 100, 10, 1
+};
+
+/* converts num into the end of buf, returns where it starts */
+static char *sprintf_num(char *where, uint64_t num, unsigned radix, unsigned flags)
+{
+	const char *digits = (flags & PR_CA) ? "0123456789ABCDEF" : "0123456789abcdef";
+
+	if(radix == 16)
+	{
+		do
+		{
+			*--where = digits[num & 0xF];
+			num >>= 4;
+		}
+		while(num != 0);
+	}
+	else if(radix == 8)
+	{
+		do
+		{
+			*--where = digits[num & 0x7];
+			num >>= 3;
+		}
+		while(num != 0);
+	}
+	else if(num <= 0xFFFFFFFF)
+	{
+		char tmp[10];
+		uint32_t n = (uint32_t)num;
+		int i, len = 0;
+
+		for(i = 0; i < 10; i++)
+		{
+			char digit = '0';
+			while(n >= sprintf_pow10[i])
+			{
+				n -= sprintf_pow10[i];
+				digit++;
+			}
+			if(digit != '0' || len > 0 || i == 9)
+				tmp[len++] = digit;
+		}
+		where -= len;
+		memcpy(where, tmp, len);
+	}
+	else
+	{
+		do
+		{
+			*--where = digits[num % 10];
+			num /= 10;
+		}
+		while(num != 0);
+	}
+
+	return where;
+}
+
+int vsnprintf(char *buf, size_t size, const char *fmt, va_list args)
+{
+	sprintf_out_t out;
+	unsigned flags, given_wd, actual_wd, radix;
+	char numbuf[PR_BUFLEN];
+	const char *where;
+	uint64_t num;
+
+	out.pos = buf;
+	out.room = (size > 0) ? (size - 1) : 0;
+	out.count = 0;
+
+	while(*fmt)
+	{
+		const char *run = fmt;
+		while(*fmt && *fmt != '%')
+			fmt++;
+		if(fmt != run)
+			sprintf_copy(&out, run, fmt - run);
+		if(*fmt == '\0')
+			break;
+
+		fmt++;
+		if(*fmt == '%')
+		{
+			sprintf_copy(&out, fmt++, 1);
+			continue;
+		}
+
+		flags = given_wd = 0;
+		if(*fmt == '-')
+		{
+			flags |= PR_LJ;
+			fmt++;
+			if(*fmt == '-')	/* %-- is illegal */
+			{
+				fmt++;
+				continue;
+			}
+		}
+		if(*fmt == '0')
+		{
+			flags |= PR_LZ;
+			fmt++;
+		}
+		while(*fmt >= '0' && *fmt <= '9')
+			given_wd = 10 * given_wd + (*fmt++ - '0');
+		for(;; fmt++)
+		{
+			if(*fmt == 'F' || *fmt == 'L')
+				flags |= PR_FP;
+			else if(*fmt == 'l')
+				flags |= PR_32;
+			else if(*fmt == 'h')
+				flags |= PR_16;
+			else if(*fmt != 'N')
+				break;
+		}
+
+		radix = 0;
+		switch(*fmt)
+		{
+		case 'X':
+			flags |= PR_CA;
+			/* FALL THROUGH */
+		case 'x':
+		case 'p':
+		case 'n':
+			radix = 16;
+			break;
+		case 'd':
+		case 'i':
+			flags |= PR_SG;
+			/* FALL THROUGH */
+		case 'u':
+			radix = 10;
+			break;
+		case 'o':
+			radix = 8;
+			break;
+		case 'c':
+			flags &= ~PR_LZ;
+			numbuf[0] = (char)va_arg(args, unsigned int);
+			where = numbuf;
+			actual_wd = 1;
+			goto EMIT;
+		case 's':
+			flags &= ~PR_LZ;
+			where = va_arg(args, const char *);
+			if(where == NULL)
+				where = "(null)";
+			actual_wd = strlen(where);
+			goto EMIT;
+		case '\0':
+			continue;
+		default:
+			fmt++;
+			continue;
+		}
+
+		if(flags & PR_FP)
+			num = va_arg(args, uint64_t);
+		else if(flags & PR_SG)
+		{
+			int value = va_arg(args, int);
+			if(value < 0)
+			{
+				flags |= PR_WS;
+				num = -(int64_t)value;
+			}
+			else
+				num = value;
+		}
+		else
+			num = va_arg(args, unsigned int);
+
+		if((flags & (PR_FP | PR_SG)) == (PR_FP | PR_SG) && (int64_t)num < 0)
+		{
+			flags |= PR_WS;
+			num = -(int64_t)num;
+		}
+
+		where = sprintf_num(numbuf + PR_BUFLEN, num, radix, flags);
+		actual_wd = (numbuf + PR_BUFLEN) - where;
+		if(flags & PR_WS)
+			actual_wd++;
+		/* if we pad left with ZEROES, do the sign now */
+		if((flags & (PR_WS | PR_LZ)) == (PR_WS | PR_LZ))
+			sprintf_copy(&out, "-", 1);
+EMIT:
+		if((flags & PR_LJ) == 0 && given_wd > actual_wd)
+			sprintf_fill(&out, (flags & PR_LZ) ? '0' : ' ', given_wd - actual_wd);
+		/* if we pad left with SPACES, do the sign now */
+		if((flags & (PR_WS | PR_LZ)) == PR_WS)
+			sprintf_copy(&out, "-", 1);
+		sprintf_copy(&out, where, actual_wd - ((flags & PR_WS) ? 1 : 0));
+		if((flags & PR_LJ) != 0 && given_wd > actual_wd)
+			sprintf_fill(&out, ' ', given_wd - actual_wd);
+		fmt++;
+	}
+
+	if(size > 0)
+		*out.pos = '\0';
+	return out.count;
 }
 /*****************************************************************************
 *****************************************************************************/
-int vsprintf(char *buf, const char *fmt, va_list args)
+int snprintf(char *buf, size_t size, const char *fmt, ...)
 {
+	va_list args;
 	int rv;
 
-	rv = do_printf(fmt, args, vsprintf_help, (void *)buf);
-	buf[rv] = '\0';
+	va_start(args, fmt);
+	rv = vsnprintf(buf, size, fmt, args);
+	va_end(args);
 	return rv;
 }
 /*****************************************************************************
 *****************************************************************************/
+int vsprintf(char *buf, const char *fmt, va_list args)
+{
+	return vsnprintf(buf, 0x7FFFFFFF, fmt, args);
+}
+/*****************************************************************************
+*****************************************************************************/
 int sprintf(char *buf, const char *fmt, ...)
 {
 	va_list args;
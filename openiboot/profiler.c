@@ -0,0 +1,171 @@
+#include "openiboot.h"
+#include "profiler.h"
+#include "interrupt.h"
+#include "timer.h"
+#include "util.h"
+#include "openiboot-asmhelpers.h"
+#include "hardware/arm.h"
+#include "hardware/timer.h"
+
+// Open addressing on (pc, lr). Entries are never removed until a reset, so a
+// zero count ends a probe chain.
+static ProfilerEntry* Entries = NULL;
+static uint32_t EntryCount;
+static uint32_t Samples;
+static uint32_t Dropped;
+static uint32_t Hz;
+static uint32_t Interval;
+static volatile int Sampling = FALSE;
+
+static inline uint32_t entry_slot(uint32_t pc, uint32_t lr) {
+	return ((pc >> 1) * 2654435761U + lr) & (PROFILER_SLOTS - 1);
+}
+
+static void profiler_record(uint32_t pc, uint32_t lr) {
+	uint32_t slot = entry_slot(pc, lr);
+
+	Samples++;
+
+	while(Entries[slot].count != 0) {
+		if(Entries[slot].pc == pc && Entries[slot].lr == lr) {
+			Entries[slot].count++;
+			return;
+		}
+		slot = (slot + 1) & (PROFILER_SLOTS - 1);
+	}
+
+	if(EntryCount >= (PROFILER_SLOTS / 4 * 3)) {
+		Dropped++;
+		return;
+	}
+
+	Entries[slot].pc = pc;
+	Entries[slot].lr = lr;
+	Entries[slot].count = 1;
+	EntryCount++;
+}
+
+static void profiler_program_timer() {
+	timer_init(ProfileTimer, Interval, 0, 0, 0, FALSE, FALSE, FALSE, TRUE);
+	timer_on_off(ProfileTimer, ON);
+}
+
+static void profilerTimerHandler() {
+	IRQSavedFrame* frame = IRQFrame;
+
+	if(!Sampling)
+		return;
+
+	if(frame != NULL) {
+		// Tasks run in supervisor mode, whose LR is banked rather than in the frame.
+		uint32_t mode = frame->cpsr & ARM11_CPSR_MODEMASK;
+		uint32_t lr = (mode == ARM11_CPSR_SYSTEMMODE || mode == ARM11_CPSR_USERMODE) ? frame->lr : ReadBankedLR(mode);
+		profiler_record(frame->pc & ~1, lr & ~1);
+	}
+
+	profiler_program_timer();
+}
+
+int profiler_start(uint32_t hz) {
+	if(hz == 0)
+		hz = PROFILER_DEFAULT_HZ;
+
+	if(Entries == NULL) {
+		Entries = (ProfilerEntry*) malloc(sizeof(ProfilerEntry) * PROFILER_SLOTS);
+		if(Entries == NULL) {
+			bufferPrintf("profile: out of memory\r\n");
+			return -1;
+		}
+		profiler_reset();
+	}
+
+	profiler_stop();
+
+	Hz = hz;
+	Interval = (uint32_t) timer_us_to_ticks(1000000 / hz);
+	if(Interval == 0)
+		Interval = 1;
+
+	Timers[ProfileTimer].handler2 = profilerTimerHandler;
+	Sampling = TRUE;
+	profiler_program_timer();
+	return 0;
+}
+
+void profiler_stop() {
+	EnterCriticalSection();
+	Sampling = FALSE;
+	timer_on_off(ProfileTimer, OFF);
+	LeaveCriticalSection();
+}
+
+void profiler_reset() {
+	if(Entries == NULL)
+		return;
+
+	EnterCriticalSection();
+	memset(Entries, 0, sizeof(ProfilerEntry) * PROFILER_SLOTS);
+	EntryCount = 0;
+	Samples = 0;
+	Dropped = 0;
+	LeaveCriticalSection();
+}
+
+void profiler_print(int maxEntries) {
+	static uint8_t printed[PROFILER_SLOTS];
+	int i;
+	int j;
+
+	if(Entries == NULL) {
+		bufferPrintf("profile: profiler not started\r\n");
+		return;
+	}
+
+	bufferPrintf("profile: %d samples at %d Hz, %d pairs, %d dropped, %s\r\n",
+			Samples, Hz, EntryCount, Dropped, Sampling ? "sampling" : "stopped");
+
+	memset(printed, 0, sizeof(printed));
+	for(i = 0; i < maxEntries; i++) {
+		int best = -1;
+		for(j = 0; j < PROFILER_SLOTS; j++) {
+			if(printed[j] || Entries[j].count == 0)
+				continue;
+
+			if(best < 0 || Entries[j].count > Entries[best].count)
+				best = j;
+		}
+
+		if(best < 0)
+			break;
+
+		printed[best] = TRUE;
+		bufferPrintf("\t0x%08x (from 0x%08x): %d\r\n", Entries[best].pc, Entries[best].lr, Entries[best].count);
+	}
+}
+
+uint32_t profiler_dump(void* address) {
+	ProfilerDumpHeader* header = (ProfilerDumpHeader*) address;
+	ProfilerEntry* entries = (ProfilerEntry*)(header + 1);
+	uint32_t count = 0;
+	int i;
+
+	if(Entries == NULL) {
+		bufferPrintf("profile: profiler not started\r\n");
+		return 0;
+	}
+
+	EnterCriticalSection();
+	for(i = 0; i < PROFILER_SLOTS; i++) {
+		if(Entries[i].count != 0)
+			memcpy(&entries[count++], &Entries[i], sizeof(ProfilerEntry));
+	}
+
+	header->magic = PROFILER_MAGIC;
+	header->hz = Hz;
+	header->samples = Samples;
+	header->dropped = Dropped;
+	header->entries = count;
+	LeaveCriticalSection();
+
+	return sizeof(ProfilerDumpHeader) + (count * sizeof(ProfilerEntry));
+}
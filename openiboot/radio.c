@@ -16,6 +16,18 @@
 static int radio_nvram_read_all(char** res);
 static char* radio_nvram = NULL;
 static int radio_nvram_len;
+
+// Where each record of radio_nvram is, found once when it is read
+typedef struct RadioNVRAMRecord
+{
+	int type;
+	int size;	// of the data, without the record's header
+	uint8_t* data;
+} RadioNVRAMRecord;
+
+static RadioNVRAMRecord* radio_nvram_records = NULL;
+static int radio_nvram_count = 0;
+static int radio_nvram_loaded = FALSE;
 static int RadioAvailable = FALSE;
 
 static char* response_buf;
@@ -158,6 +170,9 @@ int radio_setup_2g()
 
 int radio_setup()
 {
+	// responses land in a ring from the UART interrupt, whether or not anyone is reading yet
+	uart_set_rx_buffered(RADIO_UART, ON);
+
 #if CONFIG_3G
     return radio_setup_3g();
 #else
@@ -165,34 +180,69 @@ int radio_setup()
 #endif
 }
 
-int radio_nvram_get(int type_in, uint8_t** data_out)
+// Reads the baseband's NVRAM the first time it is needed. The AT round trips
+// are not repeated after that, whether or not they got anything.
+static void radio_nvram_load()
 {
-	if(!RadioAvailable)
-		return -1;
+	char* cursor;
+	int n;
 
-	if(radio_nvram == NULL)
-	{
-		bufferPrintf("radio: reading baseband nvram... ");
-		radio_nvram_len = radio_nvram_read_all(&radio_nvram);
-		bufferPrintf("done\r\n");
-	}
+	if(radio_nvram_loaded)
+		return;
+
+	radio_nvram_loaded = TRUE;
 
-	char* cursor = radio_nvram;
-	while(cursor < (radio_nvram + radio_nvram_len))
+	bufferPrintf("radio: reading baseband nvram... ");
+	radio_nvram_len = radio_nvram_read_all(&radio_nvram);
+	bufferPrintf("done\r\n");
+
+	for(n = 0; n < 2; n++)
 	{
-		int type = (cursor[0] << 8) | cursor[1];
-		int size = ((cursor[2] << 8) | cursor[3]) * 2;
-		if(size == 0)
+		// count the records, then fill them in
+		radio_nvram_count = 0;
+		cursor = radio_nvram;
+		while((cursor + 4) <= (radio_nvram + radio_nvram_len))
+		{
+			int size = ((cursor[2] << 8) | cursor[3]) * 2;
+			if(size < 4)
+				break;
+
+			if(radio_nvram_records)
+			{
+				RadioNVRAMRecord* record = &radio_nvram_records[radio_nvram_count];
+				record->type = (cursor[0] << 8) | cursor[1];
+				record->size = size - 4;
+				record->data = (uint8_t*)(cursor + 4);
+			}
+
+			radio_nvram_count++;
+			cursor += size;
+		}
+
+		if(radio_nvram_count == 0)
 			break;
 
-		uint8_t* data = (uint8_t*)(cursor + 4);
+		if(!radio_nvram_records)
+			radio_nvram_records = (RadioNVRAMRecord*) malloc(sizeof(RadioNVRAMRecord) * radio_nvram_count);
+	}
+}
+
+int radio_nvram_get(int type_in, uint8_t** data_out)
+{
+	int i;
+
+	if(!RadioAvailable)
+		return -1;
+
+	radio_nvram_load();
 
-		if(type == type_in)
+	for(i = 0; i < radio_nvram_count; i++)
+	{
+		if(radio_nvram_records[i].type == type_in)
 		{
-			*data_out = data;
-			return size - 4;
+			*data_out = radio_nvram_records[i].data;
+			return radio_nvram_records[i].size;
 		}
-		cursor += size;
 	}
 
 	return -1;
@@ -200,27 +250,20 @@ int radio_nvram_get(int type_in, uint8_t** data_out)
 
 void radio_nvram_list()
 {
-	if(radio_nvram == NULL)
-	{
-		bufferPrintf("radio: reading baseband nvram... ");
-		radio_nvram_len = radio_nvram_read_all(&radio_nvram);
-		bufferPrintf("done\r\n");
-	}
+	int i;
 
-	char* cursor = radio_nvram;
-	while(cursor < (radio_nvram + radio_nvram_len))
-	{
-		int type = (cursor[0] << 8) | cursor[1];
-		int size = ((cursor[2] << 8) | cursor[3]) * 2;
-		if(size == 0)
-			break;
+	radio_nvram_load();
 
-		uint8_t* data = (uint8_t*)(cursor + 4);
+	for(i = 0; i < radio_nvram_count; i++)
+	{
+		int type = radio_nvram_records[i].type;
+		int size = radio_nvram_records[i].size;
+		uint8_t* data = radio_nvram_records[i].data;
 
 		switch(type)
 		{
 			case 1:
-				bufferPrintf("Wi-Fi TX Cal Data : <%d bytes, CRC = %08X>\r\n", size - 4, crc32(0, data, size - 4));
+				bufferPrintf("Wi-Fi TX Cal Data : <%d bytes, CRC = %08X>\r\n", size, crc32(0, data, size));
 				break;
 
 			case 4:
@@ -247,10 +290,8 @@ void radio_nvram_list()
 				break;
 
 			default:
-				bufferPrintf("Unknown entry %d  : <%d bytes @ 0x%p>\r\n", type, size - 4, data);
+				bufferPrintf("Unknown entry %d  : <%d bytes @ 0x%p>\r\n", type, size, data);
 		}
-
-		cursor += size;
 	}
 }
 
@@ -295,46 +336,65 @@ int radio_write(const char* str)
 	return uart_write(RADIO_UART, str, len);
 }
 
-int radio_read(char* buf, int len)
+#define RADIO_RESULT_NONE 0
+#define RADIO_RESULT_OK 1
+#define RADIO_RESULT_ERROR 2
+
+static int line_ends_with(const char* line, int lineLen, const char* suffix)
 {
-	int i = 0;
-	char* curLine = buf;
+	int suffixLen = strlen(suffix);
+	return lineLen >= suffixLen && memcmp(line + lineLen - suffixLen, suffix, suffixLen) == 0;
+}
 
-	while(i < (len - 1))
-	{
-		int n = 0;
-		uint64_t startTime = timer_get_system_microtime();
-		while(n == 0)
-		{
-			n = uart_read(RADIO_UART, buf + i, (len - 1) - i, 10000);
-			if(n == 0 && has_elapsed(startTime,  500000))
-			{
-				return i;
-			}
-		}
+// Reads into buf from pos until a final result line or half a second of
+// silence, looking at each line once as it completes. Returns the new end
+// of the data, which is always NUL terminated.
+static int radio_read_result(char* buf, int pos, int len, int* result)
+{
+	int lineStart = pos;
 
-		i += n;
+	*result = RADIO_RESULT_NONE;
 
-		buf[i] = '\0';
+	// a line may have been cut off by the end of the previous read
+	while(lineStart > 0 && buf[lineStart - 1] != '\r' && buf[lineStart - 1] != '\n')
+		--lineStart;
 
-		if(strstr(curLine, "OK\r") != NULL)
-		{
+	while(pos < (len - 1))
+	{
+		int n = uart_read_some(RADIO_UART, buf + pos, (len - 1) - pos, 500000);
+		if(n <= 0)
 			break;
-		} else if(strstr(curLine, "ERROR\r") != NULL)
+
+		int end = pos + n;
+		for(; pos < end; ++pos)
 		{
-			break;
-		} else {
-			char* x = strchr(curLine, '\r');
-			if(x != NULL)
-				curLine = x;
-
-			x = strchr(curLine, '\n');
-			if(x != NULL)
-				curLine = x;
+			if(buf[pos] != '\r' && buf[pos] != '\n')
+				continue;
+
+			int lineLen = pos - lineStart;
+			const char* line = buf + lineStart;
+			lineStart = pos + 1;
+
+			if(lineLen == 2 && memcmp(line, "OK", 2) == 0)
+				*result = RADIO_RESULT_OK;
+			else if(line_ends_with(line, lineLen, "ERROR"))
+				*result = RADIO_RESULT_ERROR;
+			else if(!line_ends_with(line, lineLen, "OK"))
+				continue;
+
+			buf[end] = '\0';
+			return end;
 		}
 	}
 
-	return i;
+	buf[pos] = '\0';
+	return pos;
+}
+
+int radio_read(char* buf, int len)
+{
+	int result;
+	return radio_read_result(buf, 0, len, &result);
 }
 
 int radio_wait_for_ok(int tries)
@@ -347,18 +407,13 @@ int radio_cmd(const char* cmd, int tries)
 	int i;
 	for(i = 0; i < tries; ++i)
 	{
-		int n;
+		int result;
 
 		radio_write(cmd);
 
-		n = radio_read(response_buf, RESPONSE_BUF_SIZE - 1);
+		radio_read_result(response_buf, 0, RESPONSE_BUF_SIZE - 1, &result);
 
-		if(n == 0)
-			continue;
-
-		if(strstr(response_buf, "\nOK\r") != NULL)
-			break;
-		else if(strstr(response_buf, "\rOK\r") != NULL)
+		if(result == RADIO_RESULT_OK)
 			break;
 	}
 
@@ -377,6 +432,7 @@ static int radio_nvram_read_idx(int idx, char** res)
 	int curPos;
 	int c;
 	int searchLen;
+	int result;
 
 	sprintf(cmd, "at+xdrv=9,1,%d\r\n", idx);
 
@@ -387,13 +443,12 @@ static int radio_nvram_read_idx(int idx, char** res)
 
 	curBuf = malloc(curBufSize);
 
-	curPos = radio_read(curBuf, curBufSize);
-	while(curPos == (curBufSize - 1))
+	curPos = radio_read_result(curBuf, 0, curBufSize, &result);
+	while(curPos == (curBufSize - 1) && result == RADIO_RESULT_NONE)
 	{
-		curBufSize += 100;
+		curBufSize *= 2;
 		curBuf = realloc(curBuf, curBufSize);
-		c = radio_read(curBuf + curPos, curBufSize - curPos);
-		curPos += c;
+		curPos = radio_read_result(curBuf, curPos, curBufSize, &result);
 	}
 
 	sprintf(cmd, "+XDRV: 9,1,0,%d,", idx);
@@ -0,0 +1,370 @@
+#include "openiboot.h"
+#include "rpc.h"
+#include "util.h"
+#include "nand.h"
+#include "ftl.h"
+#include "images.h"
+#include "latency.h"
+#include "multitouch.h"
+#include "bootprof.h"
+#include "aes.h"
+#include "hash.h"
+#include "nor.h"
+#include "hardware/s5l8900.h"
+
+static RPCResponse* rpc_allocate(const RPCRequest* request, uint32_t dataLen) {
+	RPCResponse* response = (RPCResponse*) memalign(DMA_ALIGN, sizeof(RPCResponse) + dataLen);
+	if(response == NULL)
+		return NULL;
+
+	response->operation = request->operation;
+	response->tag = request->tag;
+	response->status = RPC_OK;
+	response->dataLen = dataLen;
+	return response;
+}
+
+static RPCResponse* rpc_status(const RPCRequest* request, int32_t status) {
+	RPCResponse* response = rpc_allocate(request, 0);
+	if(response != NULL)
+		response->status = status;
+	return response;
+}
+
+static RPCResponse* rpc_nand_read(const RPCRequest* request, int useVFL) {
+	NANDData* geometry = nand_get_geometry();
+	uint32_t pageLen = geometry->bytesPerPage;
+	uint32_t spareLen = geometry->bytesPerSpare;
+
+	RPCResponse* response = rpc_allocate(request, pageLen + spareLen);
+	if(response == NULL)
+		return NULL;
+
+	// the driver's return code goes back as the status, with whatever made it
+	// into the buffer, so the host can tell an empty page from a failed read
+	uint8_t* data = (uint8_t*)(response + 1);
+	if(useVFL)
+		response->status = VFL_Read(request->args[0], data, data + pageLen, TRUE, NULL);
+	else
+		response->status = nand_read(request->args[0], request->args[1], data, data + pageLen, request->args[2], FALSE);
+
+	return response;
+}
+
+static RPCResponse* rpc_images_list(const RPCRequest* request) {
+	uint32_t count = 0;
+	Image* image;
+	for(image = imageList; image != NULL; image = image->next)
+		count++;
+
+	RPCResponse* response = rpc_allocate(request, count * sizeof(RPCImageInfo));
+	if(response == NULL)
+		return NULL;
+
+	RPCImageInfo* info = (RPCImageInfo*)(response + 1);
+	for(image = imageList; image != NULL; image = image->next) {
+		info->type = image->type;
+		info->offset = image->offset;
+		info->length = image->length;
+		info->padded = image->padded;
+		info->index = image->index;
+		info++;
+	}
+
+	return response;
+}
+
+static RPCResponse* rpc_images_read(const RPCRequest* request) {
+	Image* image = images_get(request->args[0]);
+	if(image == NULL)
+		return rpc_status(request, RPC_ERROR_ARGUMENTS);
+
+	// the payload is never larger than the padded container
+	RPCResponse* response = rpc_allocate(request, (image->padded + 15) & ~15);
+	if(response == NULL)
+		return NULL;
+
+	response->dataLen = images_read_to(image, response + 1, image->padded);
+	if(response->dataLen == 0)
+		response->status = RPC_ERROR_IO;
+
+	return response;
+}
+
+static RPCResponse* rpc_aes_kbags(const RPCRequest* request, const uint8_t* data) {
+	uint32_t count = request->dataLen / sizeof(RPCKBAG);
+	uint32_t i;
+
+	if(count == 0 || request->dataLen != (count * sizeof(RPCKBAG)) || request->dataLen > RPC_MAX_DATA)
+		return rpc_status(request, RPC_ERROR_ARGUMENTS);
+
+	RPCResponse* response = rpc_allocate(request, request->dataLen);
+	if(response == NULL)
+		return NULL;
+
+	// One pass over the lot keeps the engine set up for the GID key. That
+	// chains each KBAG onto the one before, so the first block of every
+	// other one gets the previous ciphertext XORed back out to make its IV
+	// zero again, as cmd_aes would have used.
+	RPCKBAG* kbags = (RPCKBAG*)(response + 1);
+	memcpy(kbags, data, request->dataLen);
+	aes_decrypt(kbags, request->dataLen, AESGID, NULL, NULL);
+
+	for(i = 1; i < count; i++) {
+		const uint8_t* previous = data + (i * sizeof(RPCKBAG)) - AES_128_CBC_IV_SIZE;
+		int j;
+		for(j = 0; j < AES_128_CBC_IV_SIZE; j++)
+			kbags[i].iv[j] ^= previous[j];
+	}
+
+	return response;
+}
+
+static RPCResponse* rpc_hash(const RPCRequest* request, const uint8_t* data) {
+	RPCHashRange range;
+
+	if(request->dataLen < sizeof(RPCHashRange))
+		return rpc_status(request, RPC_ERROR_ARGUMENTS);
+
+	memcpy(&range, data, sizeof(RPCHashRange));
+
+	uint32_t blocks = hash_blocks(range.length, range.blockSize);
+	int digestSize = hash_digest_size(range.algorithm);
+	if(blocks == 0 || digestSize == 0 || blocks > (RPC_MAX_DATA / digestSize))
+		return rpc_status(request, RPC_ERROR_ARGUMENTS);
+
+	RPCResponse* response = rpc_allocate(request, blocks * digestSize);
+	if(response == NULL)
+		return NULL;
+
+	if(hash_range(range.algorithm, range.source, range.offset, range.length, range.blockSize, (uint8_t*)(response + 1)) != 0) {
+		response->status = RPC_ERROR_IO;
+		response->dataLen = 0;
+	}
+
+	return response;
+}
+
+static RPCResponse* rpc_delta_write(const RPCRequest* request, const uint8_t* data) {
+	const uint8_t* end = data + request->dataLen;
+	RPCDeltaHeader header;
+	uint32_t i;
+
+	if(request->dataLen < sizeof(RPCDeltaHeader))
+		return rpc_status(request, RPC_ERROR_ARGUMENTS);
+
+	memcpy(&header, data, sizeof(RPCDeltaHeader));
+	data += sizeof(RPCDeltaHeader);
+
+	if(header.target != HashNOR && header.target != HashFTL)
+		return rpc_status(request, RPC_ERROR_ARGUMENTS);
+
+	RPCResponse* response = rpc_allocate(request, sizeof(uint32_t));
+	if(response == NULL)
+		return NULL;
+
+	// blocks go down in the order they came, and the count says how far it
+	// got, so after a failure the host can carry on from there
+	uint32_t* written = (uint32_t*)(response + 1);
+	*written = 0;
+
+	for(i = 0; i < header.count; i++) {
+		RPCDeltaBlock block;
+		if((end - data) < sizeof(RPCDeltaBlock)) {
+			response->status = RPC_ERROR_ARGUMENTS;
+			break;
+		}
+
+		memcpy(&block, data, sizeof(RPCDeltaBlock));
+		data += sizeof(RPCDeltaBlock);
+		if((end - data) < block.length) {
+			response->status = RPC_ERROR_ARGUMENTS;
+			break;
+		}
+
+		int ok;
+		if(header.target == HashNOR)
+			ok = (nor_write((void*) data, (int) block.offset, block.length) == 0);
+		else
+			ok = ftl_write((void*) data, block.offset, block.length);
+
+		if(!ok) {
+			response->status = RPC_ERROR_IO;
+			break;
+		}
+
+		data += block.length;
+		(*written)++;
+	}
+
+	if(header.target == HashFTL && header.sync && *written > 0 && !ftl_sync())
+		response->status = RPC_ERROR_IO;
+
+	// the image list may be describing what used to be there
+	if(header.target == HashNOR && *written > 0) {
+		images_release();
+		images_setup();
+	}
+
+	return response;
+}
+
+RPCResponse* rpc_handle(const RPCRequest* request, uint32_t requestLen, uint32_t* responseLen) {
+	RPCResponse* response;
+	const uint8_t* data = (const uint8_t*)(request + 1);
+
+	if(requestLen < sizeof(RPCRequest) || request->dataLen > (requestLen - sizeof(RPCRequest))) {
+		response = rpc_status(request, RPC_ERROR_ARGUMENTS);
+		goto done;
+	}
+
+	switch(request->operation) {
+		case RPCMemRead:
+			if(request->args[1] > RPC_MAX_DATA) {
+				response = rpc_status(request, RPC_ERROR_ARGUMENTS);
+				break;
+			}
+			response = rpc_allocate(request, request->args[1]);
+			if(response != NULL)
+				memcpy(response + 1, (void*) request->args[0], request->args[1]);
+			break;
+
+		case RPCMemWrite:
+			memcpy((void*) request->args[0], data, request->dataLen);
+			response = rpc_status(request, RPC_OK);
+			break;
+
+		case RPCNANDRead:
+			response = rpc_nand_read(request, FALSE);
+			break;
+
+		case RPCNANDWrite:
+		{
+			NANDData* geometry = nand_get_geometry();
+			if(request->dataLen < (geometry->bytesPerPage + geometry->bytesPerSpare)) {
+				response = rpc_status(request, RPC_ERROR_ARGUMENTS);
+				break;
+			}
+			// nand_write wants aligned buffers and the data follows a 28 byte header
+			uint8_t* buffer = memalign(DMA_ALIGN, request->dataLen);
+			if(buffer == NULL) {
+				response = NULL;
+				break;
+			}
+			memcpy(buffer, data, request->dataLen);
+			int ret = nand_write(request->args[0], request->args[1], buffer, buffer + geometry->bytesPerPage, request->args[2]);
+			free(buffer);
+			response = rpc_status(request, ret);
+			break;
+		}
+
+		case RPCNANDErase:
+			response = rpc_status(request, nand_erase(request->args[0], request->args[1]));
+			break;
+
+		case RPCVFLRead:
+			response = rpc_nand_read(request, TRUE);
+			break;
+
+		case RPCFTLRead:
+			if(request->args[2] > RPC_MAX_DATA) {
+				response = rpc_status(request, RPC_ERROR_ARGUMENTS);
+				break;
+			}
+			response = rpc_allocate(request, request->args[2]);
+			if(response != NULL && !ftl_read(response + 1, ((uint64_t)request->args[1] << 32) | request->args[0], request->args[2])) {
+				response->status = RPC_ERROR_IO;
+				response->dataLen = 0;
+			}
+			break;
+
+		case RPCFTLWrite:
+			response = rpc_status(request, ftl_write((void*) data, ((uint64_t)request->args[1] << 32) | request->args[0], request->dataLen) ? RPC_OK : RPC_ERROR_IO);
+			break;
+
+		case RPCImagesList:
+			response = rpc_images_list(request);
+			break;
+
+		case RPCImagesRead:
+			response = rpc_images_read(request);
+			break;
+
+		case RPCImagesVerify:
+			response = rpc_status(request, images_verify(images_get(request->args[0])));
+			break;
+
+		case RPCLatency:
+			response = rpc_allocate(request, sizeof(LatencyHistogram) * LatencyOperationCount);
+			if(response != NULL)
+				memcpy(response + 1, latency_get(), sizeof(LatencyHistogram) * LatencyOperationCount);
+			if(request->args[0])
+				latency_reset();
+			break;
+
+		case RPCIOTrace:
+			if(request->args[0] == 1) {
+				response = rpc_status(request, iotrace_start() == 0 ? RPC_OK : RPC_ERROR_MEMORY);
+				break;
+			} else if(request->args[0] == 2) {
+				iotrace_stop();
+				response = rpc_status(request, RPC_OK);
+				break;
+			} else if(request->args[0] != 0) {
+				response = rpc_status(request, RPC_ERROR_ARGUMENTS);
+				break;
+			}
+
+			response = rpc_allocate(request, sizeof(IOTraceEntry) * IOTRACE_ENTRIES);
+			if(response != NULL)
+				response->dataLen = sizeof(IOTraceEntry) * iotrace_read((IOTraceEntry*)(response + 1), IOTRACE_ENTRIES);
+			if(request->args[1])
+				iotrace_clear();
+			break;
+
+		case RPCMultitouchEvents:
+			if(request->args[0] > (RPC_MAX_DATA / sizeof(MultitouchEvent))) {
+				response = rpc_status(request, RPC_ERROR_ARGUMENTS);
+				break;
+			}
+
+			multitouch_wait(request->args[1]);
+			response = rpc_allocate(request, sizeof(MultitouchEvent) * request->args[0]);
+			if(response != NULL)
+				response->dataLen = sizeof(MultitouchEvent) * multitouch_read_events((MultitouchEvent*)(response + 1), request->args[0]);
+			break;
+
+		case RPCBootProfile:
+			response = rpc_allocate(request, sizeof(BootProfileEntry) * BOOTPROF_ENTRIES);
+			if(response != NULL) {
+				response->dataLen = sizeof(BootProfileEntry) * bootprof_read((BootProfileEntry*)(response + 1), BOOTPROF_ENTRIES);
+				response->status = bootprof_dropped();
+			}
+			break;
+
+		case RPCAESKBAGs:
+			response = rpc_aes_kbags(request, data);
+			break;
+
+		case RPCHash:
+			response = rpc_hash(request, data);
+			break;
+
+		case RPCDeltaWrite:
+			response = rpc_delta_write(request, data);
+			break;
+
+		default:
+			response = rpc_status(request, RPC_ERROR_OPERATION);
+			break;
+	}
+
+done:
+	if(response == NULL) {
+		*responseLen = 0;
+		return NULL;
+	}
+
+	*responseLen = sizeof(RPCResponse) + response->dataLen;
+	return response;
+}
@@ -7,29 +7,488 @@
 #include "hfs/hfsplus.h"
 #include "printf.h"
 #include "util.h"
+#include "heapprof.h"
+#include "scripting.h"
 
-int scriptCommand(char* command){
-    int argc;
-	char** argv = tokenize(command, &argc);
+typedef enum ScriptOpType {
+	ScriptCall,
+	ScriptLet,
+	ScriptBranch,	// to target unless the condition holds
+	ScriptJump
+} ScriptOpType;
 
-	OPIBCommand* curCommand = CommandList;
+typedef struct ScriptOp {
+	ScriptOpType type;
+	int line;
+	OPIBCommand* command;
+	int argc;
+	char** argv;
+	int var;
+	const char* a;
+	const char* op;
+	const char* b;
+	int target;
+} ScriptOp;
 
-	int success = FALSE;
-	while(curCommand->name != NULL) {
-		if(strcmp(argv[0], curCommand->name) == 0) {
-			curCommand->routine(argc, argv);
-			success = TRUE;
+typedef struct ScriptBlock {
+	int type;
+	int op;
+	int loopStart;
+	int var;
+	const char* step;
+} ScriptBlock;
+
+#define SCRIPT_BLOCK_IF 0
+#define SCRIPT_BLOCK_ELSE 1
+#define SCRIPT_BLOCK_LOOP 2
+
+typedef struct ScriptVar {
+	char name[SCRIPT_NAME_MAX];
+	char value[SCRIPT_VALUE_MAX];
+} ScriptVar;
+
+typedef struct Script {
+	char* text;
+	ScriptOp* ops;
+	int numOps;
+	int maxOps;
+	ScriptBlock blocks[SCRIPT_MAX_DEPTH];
+	int depth;
+	ScriptVar vars[SCRIPT_MAX_VARS];
+	int numVars;
+	int loops;
+} Script;
+
+static int script_var(Script* script, const char* name) {
+	int i;
+	for(i = 0; i < script->numVars; i++) {
+		if(strcmp(script->vars[i].name, name) == 0)
+			return i;
+	}
+
+	if(script->numVars == SCRIPT_MAX_VARS || strlen(name) >= SCRIPT_NAME_MAX)
+		return -1;
+
+	strcpy(script->vars[script->numVars].name, name);
+	script->vars[script->numVars].value[0] = '\0';
+	return script->numVars++;
+}
+
+static int is_name_char(char c) {
+	return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_' || c == '-';
+}
+
+// Replaces $name with a script variable, or failing that an NVRAM one
+static void script_expand(Script* script, const char* in, char* out, int size) {
+	int pos = 0;
+
+	while(*in != '\0' && pos < (size - 1)) {
+		if(*in != '$' || !is_name_char(in[1])) {
+			out[pos++] = *(in++);
+			continue;
+		}
+
+		char name[SCRIPT_NAME_MAX];
+		int len = 0;
+		in++;
+		while(is_name_char(*in)) {
+			if(len < (SCRIPT_NAME_MAX - 1))
+				name[len++] = *in;
+			in++;
+		}
+		name[len] = '\0';
+
+		const char* value = NULL;
+		int i;
+		for(i = 0; i < script->numVars; i++) {
+			if(strcmp(script->vars[i].name, name) == 0) {
+				value = script->vars[i].value;
+				break;
+			}
+		}
+
+		if(value == NULL)
+			value = nvram_getvar(name);
+
+		while(value != NULL && *value != '\0' && pos < (size - 1))
+			out[pos++] = *(value++);
+	}
+
+	out[pos] = '\0';
+}
+
+static int is_number(const char* str) {
+	if(*str == '-')
+		str++;
+	return *str >= '0' && *str <= '9';
+}
+
+static long script_number(const char* str) {
+	if(*str == '-')
+		return -((long) parseNumber(str + 1));
+	return (long) parseNumber(str);
+}
+
+static int script_compare(const char* a, const char* op, const char* b) {
+	long cmp;
+
+	if(is_number(a) && is_number(b)) {
+		long x = script_number(a);
+		long y = script_number(b);
+		cmp = (x < y) ? -1 : ((x > y) ? 1 : 0);
+	} else {
+		cmp = strcmp(a, b);
+	}
+
+	if(strcmp(op, "==") == 0)
+		return cmp == 0;
+	else if(strcmp(op, "!=") == 0)
+		return cmp != 0;
+	else if(strcmp(op, "<") == 0)
+		return cmp < 0;
+	else if(strcmp(op, "<=") == 0)
+		return cmp <= 0;
+	else if(strcmp(op, ">") == 0)
+		return cmp > 0;
+	else
+		return cmp >= 0;
+}
+
+// Loop tests (var set) compare the counter itself against b
+static int script_condition(Script* script, ScriptOp* op) {
+	char a[SCRIPT_VALUE_MAX];
+	char b[SCRIPT_VALUE_MAX];
+
+	if(op->var >= 0)
+		strcpy(a, script->vars[op->var].value);
+	else
+		script_expand(script, op->a, a, sizeof(a));
+
+	script_expand(script, op->b, b, sizeof(b));
+
+	return script_compare(a, op->op, b);
+}
+
+static int script_let(Script* script, ScriptOp* op) {
+	char* value = script->vars[op->var].value;
+	char a[SCRIPT_VALUE_MAX];
+	char b[SCRIPT_VALUE_MAX];
+
+	// no a is the variable's own value, for loop steps
+	if(op->a == NULL)
+		strcpy(a, value);
+	else
+		script_expand(script, op->a, a, sizeof(a));
+
+	if(op->op == NULL) {
+		strcpy(value, a);
+		return 0;
+	}
+
+	script_expand(script, op->b, b, sizeof(b));
+	long x = script_number(a);
+	long y = script_number(b);
+	long result;
+
+	switch(op->op[0]) {
+		case '+':
+			result = x + y;
 			break;
+		case '-':
+			result = x - y;
+			break;
+		case '*':
+			result = x * y;
+			break;
+		default:
+			if(y == 0) {
+				bufferPrintf("script: line %d: division by zero\r\n", op->line);
+				return -1;
+			}
+			result = (op->op[0] == '/') ? (x / y) : (x % y);
+			break;
+	}
+
+	sprintf(value, "%d", (int) result);
+	return 0;
+}
+
+static void script_call(Script* script, ScriptOp* op) {
+	char buffer[SCRIPT_LINE_MAX];
+	char* argv[TOKENIZE_MAX_ARGS];
+	int pos = 0;
+	int i;
+
+	// commands get their own copies, so nothing they do to argv sticks
+	for(i = 0; i < op->argc; i++) {
+		argv[i] = buffer + pos;
+		script_expand(script, op->argv[i], argv[i], sizeof(buffer) - pos);
+		pos += strlen(argv[i]) + 1;
+		if(pos >= sizeof(buffer))
+			pos = sizeof(buffer) - 1;
+	}
+
+	bufferPrintf("\r\n");
+	for(i = 0; i < op->argc; i++)
+		bufferPrintf((i == 0) ? "%s" : " %s", argv[i]);
+	bufferPrintf("\r\n");
+
+	heapprof_command();
+	op->command->routine(op->argc, argv);
+}
+
+static ScriptOp* script_emit(Script* script, ScriptOpType type, int line) {
+	if(script->numOps == script->maxOps) {
+		script->maxOps = script->maxOps ? (script->maxOps * 2) : 64;
+		script->ops = (ScriptOp*) realloc(script->ops, script->maxOps * sizeof(ScriptOp));
+	}
+
+	ScriptOp* op = &script->ops[script->numOps++];
+	memset(op, 0, sizeof(ScriptOp));
+	op->type = type;
+	op->line = line;
+	return op;
+}
+
+static int is_compare(const char* op) {
+	return strcmp(op, "==") == 0 || strcmp(op, "!=") == 0 || strcmp(op, "<") == 0
+		|| strcmp(op, "<=") == 0 || strcmp(op, ">") == 0 || strcmp(op, ">=") == 0;
+}
+
+static int is_arithmetic(const char* op) {
+	return op[1] == '\0' && (op[0] == '+' || op[0] == '-' || op[0] == '*' || op[0] == '/' || op[0] == '%');
+}
+
+static int script_loop(Script* script, int line, int var, const char* from, const char* to, const char* step) {
+	if(script->depth == SCRIPT_MAX_DEPTH)
+		return -1;
+
+	ScriptOp* op = script_emit(script, ScriptLet, line);
+	op->var = var;
+	op->a = from;
+
+	ScriptBlock* block = &script->blocks[script->depth++];
+	block->type = SCRIPT_BLOCK_LOOP;
+	block->loopStart = script->numOps;
+	block->var = var;
+	block->step = step;
+	block->op = script->numOps;
+
+	op = script_emit(script, ScriptBranch, line);
+	op->b = to;
+	op->var = var;
+	op->op = (step[0] == '-') ? ">=" : "<=";
+	return 0;
+}
+
+static int script_compile_line(Script* script, char* line, int lineNo) {
+	char* argv[TOKENIZE_MAX_ARGS];
+	int argc;
+	int i;
+	int n;
+
+	while(*line == ' ' || *line == '\t')
+		line++;
+
+	if(*line == '\0' || *line == '#')
+		return 0;
+
+	// runs of spaces would come out as empty arguments
+	argc = tokenize_into(line, argv, TOKENIZE_MAX_ARGS);
+	for(i = 0, n = 0; i < argc; i++) {
+		if(argv[i][0] != '\0')
+			argv[n++] = argv[i];
+	}
+	argc = n;
+
+	if(argc == 0)
+		return 0;
+
+	ScriptOp* op;
+	ScriptBlock* block;
+
+	if(strcmp(argv[0], "let") == 0) {
+		if(argc != 3 && !(argc == 5 && is_arithmetic(argv[3])))
+			return -1;
+
+		op = script_emit(script, ScriptLet, lineNo);
+		if((op->var = script_var(script, argv[1])) < 0)
+			return -1;
+		op->a = argv[2];
+		if(argc == 5) {
+			op->op = argv[3];
+			op->b = argv[4];
+		}
+	} else if(strcmp(argv[0], "if") == 0) {
+		if(argc != 4 || !is_compare(argv[2]) || script->depth == SCRIPT_MAX_DEPTH)
+			return -1;
+
+		op = script_emit(script, ScriptBranch, lineNo);
+		op->a = argv[1];
+		op->op = argv[2];
+		op->b = argv[3];
+		op->var = -1;
+
+		block = &script->blocks[script->depth++];
+		block->type = SCRIPT_BLOCK_IF;
+		block->op = script->numOps - 1;
+	} else if(strcmp(argv[0], "else") == 0) {
+		if(argc != 1 || script->depth == 0 || script->blocks[script->depth - 1].type != SCRIPT_BLOCK_IF)
+			return -1;
+
+		block = &script->blocks[script->depth - 1];
+		script_emit(script, ScriptJump, lineNo);
+		script->ops[block->op].target = script->numOps;
+		block->type = SCRIPT_BLOCK_ELSE;
+		block->op = script->numOps - 1;
+	} else if(strcmp(argv[0], "end") == 0) {
+		if(argc != 1 || script->depth == 0)
+			return -1;
+
+		block = &script->blocks[--script->depth];
+		if(block->type == SCRIPT_BLOCK_LOOP) {
+			op = script_emit(script, ScriptLet, lineNo);
+			op->var = block->var;
+			op->a = NULL;
+			op->op = "+";
+			op->b = block->step;
+
+			op = script_emit(script, ScriptJump, lineNo);
+			op->target = block->loopStart;
+		}
+
+		script->ops[block->op].target = script->numOps;
+	} else if(strcmp(argv[0], "for") == 0) {
+		if(argc != 4 && argc != 5)
+			return -1;
+
+		int var = script_var(script, argv[1]);
+		if(var < 0)
+			return -1;
+
+		return script_loop(script, lineNo, var, argv[2], argv[3], (argc == 5) ? argv[4] : "1");
+	} else if(strcmp(argv[0], "repeat") == 0) {
+		char name[SCRIPT_NAME_MAX];
+
+		if(argc != 2)
+			return -1;
+
+		// a counter no script can name, so nested repeats don't collide
+		sprintf(name, "repeat.%d", script->loops++);
+		int var = script_var(script, name);
+		if(var < 0)
+			return -1;
+
+		return script_loop(script, lineNo, var, "1", argv[1], "1");
+	} else {
+		op = script_emit(script, ScriptCall, lineNo);
+		op->command = command_find(argv[0]);
+		if(op->command == NULL) {
+			bufferPrintf("script: line %d: unknown command: %s\r\n", lineNo, argv[0]);
+			return -1;
+		}
+
+		op->argc = argc;
+		op->argv = (char**) malloc(argc * sizeof(char*));
+		memcpy(op->argv, argv, argc * sizeof(char*));
+	}
+
+	return 0;
+}
+
+static void script_free(Script* script) {
+	int i;
+	for(i = 0; i < script->numOps; i++) {
+		if(script->ops[i].argv)
+			free(script->ops[i].argv);
+	}
+
+	free(script->ops);
+	free(script->text);
+	free(script);
+}
+
+// Compiles the whole script before running any of it, so a mistake anywhere
+// stops it before anything has been done.
+static Script* script_compile(const char* text, uint32_t size) {
+	Script* script = (Script*) malloc(sizeof(Script));
+	memset(script, 0, sizeof(Script));
+
+	// the ops point into this copy
+	script->text = (char*) malloc(size + 1);
+	memcpy(script->text, text, size);
+	script->text[size] = '\0';
+
+	char* line = script->text;
+	int lineNo = 1;
+	while(line != NULL && *line != '\0') {
+		char* next = line;
+		while(*next != '\0' && *next != '\n')
+			next++;
+
+		if(*next == '\n')
+			*(next++) = '\0';
+		else
+			next = NULL;
+
+		char* cr = line + strlen(line);
+		while(cr > line && (cr[-1] == '\r' || cr[-1] == ' ' || cr[-1] == '\t'))
+			*(--cr) = '\0';
+
+		if(script_compile_line(script, line, lineNo) != 0) {
+			bufferPrintf("script: error on line %d\r\n", lineNo);
+			script_free(script);
+			return NULL;
 		}
-		curCommand++;
+
+		line = next;
+		lineNo++;
+	}
+
+	if(script->depth != 0) {
+		bufferPrintf("script: missing end\r\n");
+		script_free(script);
+		return NULL;
 	}
 
-	if(!success) {
-		bufferPrintf("unknown command: %s\r\n", command);
+	return script;
+}
+
+int script_run(const char* text, uint32_t size) {
+	Script* script = script_compile(text, size);
+	int pc = 0;
+
+	if(script == NULL)
+		return -1;
+
+	while(pc < script->numOps) {
+		ScriptOp* op = &script->ops[pc++];
+
+		switch(op->type) {
+			case ScriptCall:
+				script_call(script, op);
+				break;
+
+			case ScriptLet:
+				if(script_let(script, op) != 0) {
+					script_free(script);
+					return -1;
+				}
+				break;
+
+			case ScriptBranch:
+				if(!script_condition(script, op))
+					pc = op->target;
+				break;
+
+			case ScriptJump:
+				pc = op->target;
+				break;
+		}
 	}
 
-	free(argv);
-	return success;
+	script_free(script);
+	return 0;
 }
 
 void startScripting(char* loadedFrom)
@@ -108,58 +567,7 @@ void startScripting(char* loadedFrom)
 	closeVolume(volume);
 	CLOSE(io);
 
-	char* addrBOF = (char*) address; /* pointer on the begening of the file*/
-	char* addrEOF = (char*) (address + size); /*pointer 1 byte after the file */
-	char* addr; /*pointer on the current space on memory*/
-
-#if 0
-	//addrEOF = (void*)address+size+1;
-	/* ----- counting how many lines are present in the script file by the '\n' -----  */
-	addr = addrBOF;
-	while(addr < addrEOF)
-	{
-		if(*addr=='\r'){
-			numberOfLines++;
-		}
-		addr++;
-	}
-	bufferPrintf("number of lines : %d\r\n", numberOfLines);
-#endif
-
-	char* bufferLine = malloc(100);
-
-	/* ----- extracting each line to the buffer -----*/
-	addr = addrBOF;
-	while(addr < addrEOF)
-	{
-		int charAt = 0;
-		while((*addr != '\n') && (addr < addrEOF))
-		{
-			if(*addr != '\r')
-			{
-				bufferLine[charAt] = *addr;
-				//bufferPrintf("reading char : %c\r\n",*addr);
-				charAt++;
-			}
-			addr++;
-		}
-
-		bufferLine[charAt]='\0';
-
-		bufferPrintf("\r\n%s\r\n", bufferLine);
-
-		bufferLine[charAt]='\n';
-		bufferLine[charAt + 1] = '\0';
-
-		if(scriptCommand(bufferLine))
-		{
-			//bufferPrintf("command sent\r\n");
-		}
-		/*else { //error in command, function scriptCommand returned false
-		}*/
-		addr++;
-	}
+	script_run((const char*) address, size);
 
-	free(bufferLine);
 	free(address);
 }
@@ -6,6 +6,7 @@
 #include "gpio.h"
 #include "timer.h"
 #include "interrupt.h"
+#include "tasks.h"
 #include "hardware/sdio.h"
 
 #define SDIO_CARD_BUSY   0x80000000      /* Card Power up status bit */
@@ -15,6 +16,9 @@
 #define SUCCESS_NO_DATA 0
 #define SUCCESS_DATA (2 << 4)
 
+// CMD53 has a nine bit count, of blocks or of bytes (where 0 means 512)
+#define SDIO_MAX_BLOCKS 511
+
 int sdio_wait_for_ready(int timeout);
 int sdio_wait_for_cmd_ready(int timeout);
 int sdio_execute_command(int timeout);
@@ -27,7 +31,9 @@ int sdio_io_rw_direct(int isWrite, int function, uint32_t address, uint8_t in, u
 int sdio_io_rw_extended(int isWrite, int function, uint32_t address, int incr_addr, void* buffer, int blocks, int count);
 int sdio_io_rw_ext_helper(int isWrite, int function, uint32_t address, int incr_addr, void* buffer, int count);
 int sdio_read_cis(int function);
+static int sdio_set_bus(int lowspeed, int widebus, int highspeed);
 static void sdio_handle_interrupt(uint32_t token);
+static void sdio_task(void* opaque);
 
 typedef struct SDIOFunction
 {
@@ -41,19 +47,37 @@ typedef struct SDIOFunction
 uint32_t RCA;
 int NumberOfFunctions;
 
+// what sdio_setup negotiated, for sdio_status
+static int BusWidth = 1;
+static int HighSpeed = FALSE;
+static uint32_t BusClock = 400;		// KHz
+static uint32_t MaxTransferSpeed = 0;	// KHz, from the function 0 CIS
+
 SDIOFunction* SDIOFunctions;
 
+// One command on the bus at a time, between callers and the sdio task
+static Semaphore SDIOLock;
+static Completion SDIOTransferDone;
+static Semaphore SDIOTaskSignal;
+static volatile int SDIOCardInterrupt = FALSE;
+static SDIORequest* SDIOQueue = NULL;
+
 int sdio_setup()
 {
 	int i;
 
+	semaphore_init(&SDIOLock, 1);
+	semaphore_init(&SDIOTaskSignal, 0);
+	if(task_create("sdio", sdio_task, NULL, 0) == NULL)
+		bufferPrintf("sdio: could not start the sdio task\r\n");
+
 	interrupt_install(0x2a, sdio_handle_interrupt, 0);
 	interrupt_enable(0x2a);
 
 	clock_gate_switch(SDIO_CLOCKGATE, ON);
 
 	// SDCLK = PCLK/128 ~= 400 KHz
-	SET_REG(SDIO + SDIO_CLKDIV, 1 << 7);
+	SET_REG(SDIO + SDIO_CLKDIV, SDIO_CLKDIV_INIT);
 
 	// Reset FIFO
 	SET_REG(SDIO + SDIO_DCTRL, 0x3);
@@ -190,79 +214,122 @@ int sdio_setup()
 	bufferPrintf("sdio: cccr version: %d, sdio version: %d, low-speed: %d, high-speed: %d, wide bus: %d, multi-block: %d, functions: %d\r\n",
 			cccr_version, sdio_version, lowspeed, highspeed, widebus, multiblock, NumberOfFunctions);
 
-	if(!lowspeed)
-	{
-		// Crank us up to PCLK/4 ~= 25 MHz
-		SET_REG(SDIO + SDIO_CLKDIV, 1 << 1);
-	}
+	SDIOFunctions = (SDIOFunction*) malloc((NumberOfFunctions + 1) * sizeof(SDIOFunction));
+	memset(SDIOFunctions, 0, (NumberOfFunctions + 1) * sizeof(SDIOFunction));
 
-	if(highspeed)
+	for(i = 0; i <= NumberOfFunctions; ++i)
 	{
-		if(sdio_io_rw_direct(FALSE, 0, 0x13, data, 0) != 0)
+		SDIOFunctions[i].irqHandler = NULL;
+
+		if(sdio_read_cis(i) != 0)
 		{
-			bufferPrintf("sdio: could not set high-speed\r\n");
+			bufferPrintf("sdio: could not read CIS for function %d\r\n", i);
+			free(SDIOFunctions);
+			SDIOFunctions = NULL;
 			return -1;
 		}
-	}
-
-	{
-		uint8_t readBack;
 
-		if(sdio_io_rw_direct(FALSE, 0, 0x7, 0, &data) != 0)
+		// initialize the maximum block size
+		if(sdio_set_block_size(i, SDIOFunctions[i].maxBlockSize) != 0)
 		{
-			bufferPrintf("sdio: could not get bus interface control\r\n");
+			bufferPrintf("sdio: could not set function block size\r\n");
+			free(SDIOFunctions);
+			SDIOFunctions = NULL;
 			return -1;
 		}
 
-		if(widebus)
+		// the common CIS has the maximum speed, read the rest at it
+		if(i == 0 && sdio_set_bus(lowspeed, widebus, highspeed) != 0)
 		{
-			// set wide bus on the card
-			data = (data & 0x3) | 2;
+			free(SDIOFunctions);
+			SDIOFunctions = NULL;
+			return -1;
 		}
+	}
 
-		if((data & (1 << 7)) == 0)
-		{
-			bufferPrintf("sdio: turning off pull-up resistor on DAT[3]\r\n");
-			data |= 1 << 7;
-		}
+	bufferPrintf("sdio: Ready!\r\n");
 
-		if(sdio_io_rw_direct(TRUE, 0, 0x7, data, &readBack) != 0 || (readBack != data))
-		{
-			bufferPrintf("sdio: could not set bus interface control\r\n");
-			return -1;
-		}
+	return 0;
+}
 
+static int sdio_set_bus(int lowspeed, int widebus, int highspeed)
+{
+	uint8_t data;
+	uint8_t readBack;
+
+	if(sdio_io_rw_direct(FALSE, 0, 0x7, 0, &data) != 0)
+	{
+		bufferPrintf("sdio: could not get bus interface control\r\n");
+		return -1;
+	}
+
+	if(widebus)
+	{
+		// set wide bus on the card
+		data = (data & ~0x3) | 2;
+	}
+
+	if((data & (1 << 7)) == 0)
+	{
+		bufferPrintf("sdio: turning off pull-up resistor on DAT[3]\r\n");
+		data |= 1 << 7;
+	}
+
+	if(sdio_io_rw_direct(TRUE, 0, 0x7, data, &readBack) != 0 || (readBack != data))
+	{
+		bufferPrintf("sdio: could not set bus interface control\r\n");
+		return -1;
+	}
+
+	if(widebus)
+	{
 		// set wide bus on the controller
 		SET_REG(SDIO + SDIO_CTRL, GET_REG(SDIO + SDIO_CTRL) | (1 << 2));
+		BusWidth = 4;
 	}
 
-	SDIOFunctions = (SDIOFunction*) malloc((NumberOfFunctions + 1) * sizeof(SDIOFunction));
+	// low speed cards stay at the identification clock
+	if(lowspeed)
+		return 0;
 
-	for(i = 0; i <= NumberOfFunctions; ++i)
+	if(highspeed)
 	{
-		SDIOFunctions[i].irqHandler = NULL;
-
-		if(sdio_read_cis(i) != 0)
+		// enable high-speed and read it back, the card may still refuse
+		if(sdio_io_rw_direct(FALSE, 0, 0x13, 0, &data) == 0
+				&& sdio_io_rw_direct(TRUE, 0, 0x13, data | (1 << 1), &readBack) == 0
+				&& (readBack & (1 << 1)))
 		{
-			bufferPrintf("sdio: could not read CIS for function %d\r\n", i);
-			free(SDIOFunctions);
-			return -1;
+			SET_REG(SDIO + SDIO_CLKDIV, SDIO_CLKDIV_HIGH);
+			HighSpeed = TRUE;
+			BusClock = 50000;
+			return 0;
 		}
 
-		// initialize the maximum block size
-		if(sdio_set_block_size(i, SDIOFunctions[i].maxBlockSize) != 0)
-		{
-			bufferPrintf("sdio: could not set function block size\r\n");
-			free(SDIOFunctions);
-			return -1;
-		}
+		bufferPrintf("sdio: could not set high-speed, staying at full speed\r\n");
 	}
 
-	bufferPrintf("sdio: Ready!\r\n");
+	if(MaxTransferSpeed == 0 || MaxTransferSpeed >= 25000)
+	{
+		// Crank us up to PCLK/4 ~= 25 MHz
+		SET_REG(SDIO + SDIO_CLKDIV, SDIO_CLKDIV_FULL);
+		BusClock = 25000;
+	}
 
 	return 0;
 }
 
+// TRAN_SPEED: a rate unit in bits 0-2 and a multiplier (in tenths) in bits 3-6
+static uint32_t sdio_tran_speed(uint8_t value)
+{
+	static const uint32_t units[] = { 100, 1000, 10000, 100000 };
+	static const uint8_t multipliers[] = { 0, 10, 12, 13, 15, 20, 25, 30, 35, 40, 45, 50, 55, 60, 70, 80 };
+
+	if((value & 0x7) > 3)
+		return 0;
+
+	return units[value & 0x7] * multipliers[(value >> 3) & 0xF] / 10;
+}
+
 int sdio_read_cis(int function)
 {
 	int i;
@@ -310,8 +377,10 @@ int sdio_read_cis(int function)
 			{
 				SDIOFunctions[function].maxBlockSize = buf[1] | (buf[2] << 8);
 				SDIOFunctions[function].enableTimeout = 0;
-				bufferPrintf("Function: %d, max block size: %d\r\n",
-						function, SDIOFunctions[function].maxBlockSize);
+				if(len > 3)
+					MaxTransferSpeed = sdio_tran_speed(buf[3]);
+				bufferPrintf("Function: %d, max block size: %d, max speed: %d KHz\r\n",
+						function, SDIOFunctions[function].maxBlockSize, MaxTransferSpeed);
 			}
 			else
 			{
@@ -336,6 +405,16 @@ int sdio_read_cis(int function)
 
 int sdio_set_block_size(int function, int blocksize)
 {
+	if(blocksize == 0)
+		blocksize = SDIOFunctions[function].maxBlockSize;
+
+	if(SDIOFunctions[function].maxBlockSize && blocksize > SDIOFunctions[function].maxBlockSize)
+	{
+		bufferPrintf("sdio: block size %d is over the maximum of %d for function %d\r\n",
+				blocksize, SDIOFunctions[function].maxBlockSize, function);
+		return -1;
+	}
+
 	if(sdio_io_rw_direct(TRUE, 0, (function * 0x100) + 0x10, blocksize & 0xFF, NULL) != 0)
 		return -1;
 
@@ -586,7 +665,7 @@ int sdio_select_card(uint32_t rca)
 
 }
 
-int sdio_io_rw_direct(int isWrite, int function, uint32_t address, uint8_t in, uint8_t* out)
+static int sdio_io_rw_direct_locked(int isWrite, int function, uint32_t address, uint8_t in, uint8_t* out)
 {
 	int ret;
 
@@ -641,7 +720,15 @@ int sdio_io_rw_direct(int isWrite, int function, uint32_t address, uint8_t in, u
 	}
 }
 
-int sdio_io_rw_extended(int isWrite, int function, uint32_t address, int incr_addr, void* buffer, int blocks, int count)
+int sdio_io_rw_direct(int isWrite, int function, uint32_t address, uint8_t in, uint8_t* out)
+{
+	semaphore_wait(&SDIOLock);
+	int ret = sdio_io_rw_direct_locked(isWrite, function, address, in, out);
+	semaphore_signal(&SDIOLock);
+	return ret;
+}
+
+static int sdio_io_rw_extended_locked(int isWrite, int function, uint32_t address, int incr_addr, void* buffer, int blocks, int count)
 {
 	int ret;
 
@@ -656,7 +743,11 @@ int sdio_io_rw_extended(int isWrite, int function, uint32_t address, int incr_ad
 
 	sdio_clear_state();
 
-	CleanAndInvalidateCPUDataCache();
+	uint32_t length = blocks ? (count * SDIOFunctions[function].blocksize) : count;
+	if(isWrite)
+		CleanDataCacheRange(buffer, length);
+	else
+		InvalidateDataCacheRange(buffer, length);
 
 	SET_REG(SDIO + SDIO_BADDR, buf);
 
@@ -690,8 +781,11 @@ int sdio_io_rw_extended(int isWrite, int function, uint32_t address, int incr_ad
 	SET_REG(SDIO + SDIO_DCTRL, 3);
 	SET_REG(SDIO + SDIO_DCTRL, 0);
 
-	// disable block transfer done IRQ, we're going to handle it via polling
-	SET_REG(SDIO + SDIO_IRQMASK, GET_REG(SDIO + SDIO_IRQMASK) & ~3);
+	// the controller DMAs the data and interrupts when it is done; keep the card
+	// interrupt off until then
+	uint32_t irqMask = GET_REG(SDIO + SDIO_IRQMASK);
+	completion_init(&SDIOTransferDone);
+	SET_REG(SDIO + SDIO_IRQMASK, (irqMask & ~2) | 1);
 
 	// set the argument
 	SET_REG(SDIO + SDIO_ARGU, arg);
@@ -709,7 +803,10 @@ int sdio_io_rw_extended(int isWrite, int function, uint32_t address, int incr_ad
 
 	ret = sdio_wait_for_cmd_ready(100);
 	if(ret)
+	{
+		SET_REG(SDIO + SDIO_IRQMASK, irqMask);
 		return ret;
+	}
 
 	int status = sdio_execute_command(100);
 	ret = status & 0xF;
@@ -722,7 +819,10 @@ int sdio_io_rw_extended(int isWrite, int function, uint32_t address, int incr_ad
 
 		// see if everything except IO_CURRENT_STATE is in a no error state
 		if((flags & (~0x30)) != 0)
+		{
+			SET_REG(SDIO + SDIO_IRQMASK, irqMask);
 			return -1;
+		}
 
 		// clear the bits we acknlowedged
 		sdio_clear_state();
@@ -730,41 +830,47 @@ int sdio_io_rw_extended(int isWrite, int function, uint32_t address, int incr_ad
 		// start data transfer
 		SET_REG(SDIO + SDIO_DCTRL, 0x10);
 
-		// wait until all data transfer is done
-		uint64_t startTime = timer_get_system_microtime();
-		while((GET_REG(SDIO + SDIO_IRQ) & 1) == 0)
+		// sleep until all data transfer is done; multi-block transfers get time for the data on top
+		ret = completion_wait(&SDIOTransferDone, (100 * 1000) + (length * 8));
+
+		SET_REG(SDIO + SDIO_IRQMASK, irqMask);
+
+		if(ret != 0)
 		{
 			//bufferPrintf("dsta: 0x%x, fsta: 0x%x, state: 0x%x\r\n", GET_REG(SDIO + SDIO_DSTA), GET_REG(SDIO + SDIO_FSTA), GET_REG(SDIO + SDIO_STATE));
-			// FIXME: yield
-			if(has_elapsed(startTime, 100 * 1000)) {
-				return ERROR_TIMEOUT;
-			}
+			SET_REG(SDIO + SDIO_CTRL, GET_REG(SDIO + SDIO_CTRL) & ~0x8000);
+			return ERROR_TIMEOUT;
 		}
 
-		// clear the interrupt bit
-		SET_REG(SDIO + SDIO_IRQ, 1);
-
-		// reenable interrupts
-		SET_REG(SDIO + SDIO_IRQMASK, GET_REG(SDIO + SDIO_IRQMASK) | 3);
-
 		status = GET_REG(SDIO + SDIO_DSTA);
 
-		CleanAndInvalidateCPUDataCache();
-
 		SET_REG(SDIO + SDIO_CTRL, GET_REG(SDIO + SDIO_CTRL) & ~0x8000);
 
 		return (status >> 15);
 	} else
+	{
+		SET_REG(SDIO + SDIO_IRQMASK, irqMask);
 		return -1;
+	}
+}
+
+int sdio_io_rw_extended(int isWrite, int function, uint32_t address, int incr_addr, void* buffer, int blocks, int count)
+{
+	semaphore_wait(&SDIOLock);
+	int ret = sdio_io_rw_extended_locked(isWrite, function, address, incr_addr, buffer, blocks, count);
+	semaphore_signal(&SDIOLock);
+	return ret;
 }
 
 int sdio_io_rw_ext_helper(int isWrite, int function, uint32_t address, int incr_addr, void* buffer, int count)
 {
 	int ret;
 
-	if(count >= SDIOFunctions[function].blocksize)
+	while(count >= SDIOFunctions[function].blocksize)
 	{
 		int blocks = count / SDIOFunctions[function].blocksize;
+		if(blocks > SDIO_MAX_BLOCKS)
+			blocks = SDIO_MAX_BLOCKS;
 
 		ret = sdio_io_rw_extended(isWrite, function, address, incr_addr, buffer, 1, blocks);
 
@@ -779,7 +885,9 @@ int sdio_io_rw_ext_helper(int isWrite, int function, uint32_t address, int incr_
 
 		int done = blocks * SDIOFunctions[function].blocksize;
 
-		address += done;
+		if(incr_addr)
+			address += done;
+
 		buffer = (void*)(((uint32_t)buffer) + done);
 		count -= done;
 	}
@@ -820,6 +928,9 @@ int sdio_claim_irq(int function, InterruptServiceRoutine handler, uint32_t token
 	if(ret)
 		return ret;
 
+	// in case one came in before there was anyone to handle it
+	SET_REG(SDIO + SDIO_IRQMASK, GET_REG(SDIO + SDIO_IRQMASK) | 2);
+
 	return 0;
 }
 
@@ -868,31 +979,103 @@ int sdio_memcpy_fromio(int function, void* dst, uint32_t address, int count)
 	return sdio_io_rw_ext_helper(FALSE, function, address, TRUE, dst, count);
 }
 
-static void sdio_handle_interrupt(uint32_t token)
+void sdio_submit(SDIORequest* request)
 {
-	int status = GET_REG(SDIO + SDIO_IRQ);	
-	SET_REG(SDIO + SDIO_IRQ, status);
+	completion_init(&request->completion);
+	request->error = 0;
+	request->next = NULL;
+
+	EnterCriticalSection();
+	SDIORequest** link = &SDIOQueue;
+	while(*link != NULL)
+		link = &(*link)->next;
+	*link = request;
+	LeaveCriticalSection();
+
+	semaphore_signal(&SDIOTaskSignal);
+}
 
-	// SDIO irq, find handler
-	if(status & 2)
-	{
-		SET_REG(SDIO + SDIO_IRQMASK, GET_REG(SDIO + SDIO_IRQMASK) & ~2);
-		uint8_t reg;
+int sdio_wait(SDIORequest* request)
+{
+	while(completion_wait(&request->completion, 1000000) != 0);
+	return request->error;
+}
 
-		int ret = sdio_io_rw_direct(FALSE, 0, 0x5, 0, &reg);
-		if(!ret)
+static void sdio_card_interrupt()
+{
+	uint8_t reg;
+
+	if(SDIOFunctions == NULL)
+		return;
+
+	int ret = sdio_io_rw_direct(FALSE, 0, 0x5, 0, &reg);
+	if(!ret)
+	{
+		int i;
+		for(i = 1; i <= NumberOfFunctions; ++i)
 		{
-			int i;
-			for(i = 1; i <= 8; ++i)
+			if((reg & (1 << i)) != 0 && SDIOFunctions[i].irqHandler)
 			{
-				if((reg & (1 << i)) != 0 && SDIOFunctions[i].irqHandler)
-				{
-					SDIOFunctions[i].irqHandler(SDIOFunctions[i].irqHandlerToken);
-				}
+				SDIOFunctions[i].irqHandler(SDIOFunctions[i].irqHandlerToken);
 			}
 		}
+	}
+
+	SET_REG(SDIO + SDIO_IRQMASK, GET_REG(SDIO + SDIO_IRQMASK) | 2);
+}
+
+// Runs queued transfers and the function interrupt handlers, which need the bus
+// and so cannot be run from the interrupt itself.
+static void sdio_task(void* opaque)
+{
+	while(TRUE)
+	{
+		semaphore_wait(&SDIOTaskSignal);
+
+		if(SDIOCardInterrupt)
+		{
+			SDIOCardInterrupt = FALSE;
+			sdio_card_interrupt();
+		}
+
+		while(TRUE)
+		{
+			EnterCriticalSection();
+			SDIORequest* request = SDIOQueue;
+			if(request != NULL)
+				SDIOQueue = request->next;
+			LeaveCriticalSection();
+
+			if(request == NULL)
+				break;
+
+			request->error = sdio_io_rw_ext_helper(request->isWrite, request->function, request->address,
+					request->incr_addr, request->buffer, request->count);
+
+			// the callback may resubmit or free the request
+			if(request->callback)
+				request->callback(request, request->opaque);
+			else
+				completion_signal(&request->completion);
+		}
+	}
+}
 
-		SET_REG(SDIO + SDIO_IRQMASK, GET_REG(SDIO + SDIO_IRQMASK) | 2);
+static void sdio_handle_interrupt(uint32_t token)
+{
+	int status = GET_REG(SDIO + SDIO_IRQ);	
+	SET_REG(SDIO + SDIO_IRQ, status);
+
+	// block transfer done
+	if(status & 1)
+		completion_signal(&SDIOTransferDone);
+
+	// SDIO irq, leave it masked until the sdio task has run the handlers
+	if(status & 2)
+	{
+		SET_REG(SDIO + SDIO_IRQMASK, GET_REG(SDIO + SDIO_IRQMASK) & ~2);
+		SDIOCardInterrupt = TRUE;
+		semaphore_signal(&SDIOTaskSignal);
 	}
 }
 
@@ -961,5 +1144,7 @@ void sdio_status()
 	printf("remblk  = 0x%08x\n", (int) GET_REG(SDIO + SDIO_REMBLK));
 	bufferPrintf("Status: 0x%x\r\n", (GET_REG(SDIO + SDIO_DSTA) >> 15) & 0xF);
 	bufferPrintf("OCR: 0x%x\r\n", GET_REG(SDIO + SDIO_RESP0) >> 7);
+	bufferPrintf("Bus: %d-bit at %d KHz%s (card maximum %d KHz)\r\n",
+			BusWidth, BusClock, HighSpeed ? ", high-speed" : "", MaxTransferSpeed);
 }
 
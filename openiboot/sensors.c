@@ -0,0 +1,172 @@
+#include "openiboot.h"
+#include "openiboot-asmhelpers.h"
+#include "sensors.h"
+#include "accel.h"
+#include "event.h"
+#include "i2c.h"
+#include "timer.h"
+#include "util.h"
+#include "hardware/accel.h"
+#ifndef CONFIG_IPOD
+#include "als.h"
+#include "hardware/als.h"
+#endif
+
+static SensorSample SensorRing[SENSORS_RING];
+static volatile uint32_t SensorCount = 0;
+static uint32_t SensorInterval = 0;
+static Event SensorEvent;
+static volatile int SensorsRunning = FALSE;
+static volatile uint32_t SensorsMissed = 0;
+
+// The reads of one sample, outstanding until Pending drops to 0
+static volatile int Pending = 0;
+static uint64_t PendingTime;
+
+// all three axes in one read, OUTX to OUTZ with the unused registers between
+static uint8_t AccelRegister = ACCEL_OUTX | ACCEL_AUTOINCREMENT;
+static uint8_t AccelData[ACCEL_OUTZ - ACCEL_OUTX + 1];
+static I2CRequest AccelRequest;
+
+#ifndef CONFIG_IPOD
+static uint8_t LightRegister;
+static uint16_t LightData;
+static I2CRequest LightRequest;
+#endif
+
+static void sensors_store() {
+	SensorSample* sample = &SensorRing[SensorCount % SENSORS_RING];
+
+	sample->time = PendingTime;
+	sample->valid = 0;
+
+	if(AccelRequest.error == I2CNoError) {
+		sample->x = (int8_t) AccelData[0];
+		sample->y = (int8_t) AccelData[ACCEL_OUTY - ACCEL_OUTX];
+		sample->z = (int8_t) AccelData[ACCEL_OUTZ - ACCEL_OUTX];
+		sample->valid |= SensorAccelValid;
+	}
+
+#ifndef CONFIG_IPOD
+	if(LightRequest.error == I2CNoError) {
+		sample->light = LightData;
+		sample->valid |= SensorLightValid;
+	}
+#endif
+
+	SensorCount++;
+}
+
+// from the I2C queue task
+static void sensors_done(I2CRequest* request, void* opaque) {
+	EnterCriticalSection();
+	if(--Pending == 0)
+		sensors_store();
+	LeaveCriticalSection();
+}
+
+static void sensors_request(I2CRequest* request, int bus, int address, const uint8_t* reg, void* buffer, int len) {
+	memset(request, 0, sizeof(I2CRequest));
+	request->bus = bus;
+	request->address = address;
+	request->is_write = FALSE;
+	request->registers = reg;
+	request->num_regs = 1;
+	request->buffer = (uint8_t*) buffer;
+	request->bufferLen = len;
+	request->callback = sensors_done;
+}
+
+static void sensors_tick(Event* event, void* opaque) {
+	if(!SensorsRunning)
+		return;
+
+	event_readd(event, SensorInterval);
+
+	// a slow bus only lowers the rate, the requests are never queued twice
+	if(Pending != 0) {
+		SensorsMissed++;
+		return;
+	}
+
+	PendingTime = timer_get_system_microtime();
+
+#ifndef CONFIG_IPOD
+	Pending = 2;
+	i2c_submit(&AccelRequest);
+	i2c_submit(&LightRequest);
+#else
+	Pending = 1;
+	i2c_submit(&AccelRequest);
+#endif
+}
+
+int sensors_start(uint32_t interval) {
+	if(interval == 0)
+		return -1;
+
+	EnterCriticalSection();
+	SensorInterval = interval;
+	if(SensorsRunning) {
+		LeaveCriticalSection();
+		return 0;
+	}
+
+	if(Pending == 0) {
+		sensors_request(&AccelRequest, ACCEL_I2C_BUS, ACCEL_GETADDR, &AccelRegister, AccelData, sizeof(AccelData));
+#ifndef CONFIG_IPOD
+		// the channel in use is picked up on every start
+		LightRegister = als_data_register();
+		sensors_request(&LightRequest, ALS_I2C, ALS_ADDR, &LightRegister, &LightData, sizeof(LightData));
+#endif
+	}
+
+	SensorsRunning = TRUE;
+	LeaveCriticalSection();
+
+	return event_add(&SensorEvent, interval, sensors_tick, NULL);
+}
+
+void sensors_stop() {
+	EnterCriticalSection();
+	SensorsRunning = FALSE;
+	event_cancel(&SensorEvent);
+	LeaveCriticalSection();
+}
+
+int sensors_running() {
+	return SensorsRunning;
+}
+
+int sensors_latest(SensorSample* sample) {
+	int ret = FALSE;
+
+	EnterCriticalSection();
+	if(SensorCount > 0) {
+		*sample = SensorRing[(SensorCount - 1) % SENSORS_RING];
+		ret = TRUE;
+	}
+	LeaveCriticalSection();
+
+	return ret;
+}
+
+int sensors_read(uint32_t* cursor, SensorSample* samples, int max) {
+	int count = 0;
+
+	EnterCriticalSection();
+	if((SensorCount - *cursor) > SENSORS_RING)
+		*cursor = SensorCount - SENSORS_RING;
+
+	while(count < max && *cursor != SensorCount) {
+		samples[count++] = SensorRing[*cursor % SENSORS_RING];
+		(*cursor)++;
+	}
+	LeaveCriticalSection();
+
+	return count;
+}
+
+uint32_t sensors_missed() {
+	return SensorsMissed;
+}
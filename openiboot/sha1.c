@@ -12,24 +12,20 @@ A million repetitions of "a"
   34AA973C D4C4DAA4 F61EEB2B DBAD2731 6534016F
 */
 
-#define LITTLE_ENDIAN /* This should be #define'd if true. */
-#define SHA1HANDSOFF /* Copies data before messing with it. */
-
 #include "util.h"
 #include "sha1.h"
 
 #define rol(value, bits) (((value) << (bits)) | ((value) >> (32 - (bits))))
 
+/* Load a big-endian word a byte at a time so the input need not be aligned. */
+#define load_be32(p) (((uint32_t)(p)[0] << 24) | ((uint32_t)(p)[1] << 16) \
+    | ((uint32_t)(p)[2] << 8) | (uint32_t)(p)[3])
+
 /* blk0() and blk() perform the initial expand. */
 /* I got the idea of expanding during the round function from SSLeay */
-#ifdef LITTLE_ENDIAN
-#define blk0(i) (block->l[i] = (rol(block->l[i],24)&0xFF00FF00) \
-    |(rol(block->l[i],8)&0x00FF00FF))
-#else
-#define blk0(i) block->l[i]
-#endif
-#define blk(i) (block->l[i&15] = rol(block->l[(i+13)&15]^block->l[(i+8)&15] \
-    ^block->l[(i+2)&15]^block->l[i&15],1))
+#define blk0(i) (block[i] = load_be32(buffer + (i) * 4))
+#define blk(i) (block[i&15] = rol(block[(i+13)&15]^block[(i+8)&15] \
+    ^block[(i+2)&15]^block[i&15],1))
 
 /* (R0+R1), R2, R3, R4 are the different operations used in SHA1 */
 #define R0(v,w,x,y,z,i) z+=((w&(x^y))^y)+blk0(i)+0x5A827999+rol(v,5);w=rol(w,30);
@@ -39,23 +35,15 @@ A million repetitions of "a"
 #define R4(v,w,x,y,z,i) z+=(w^x^y)+blk(i)+0xCA62C1D6+rol(v,5);w=rol(w,30);
 
 
-/* Hash a single 512-bit block. This is the core of the algorithm. */
+/* Hash a single 512-bit block. This is the core of the algorithm.
+   The message schedule lives in registers/stack rather than a static
+   workspace, and the input is never copied. */
 
-void SHA1Transform(unsigned long state[5], unsigned char buffer[64])
+void SHA1Transform(uint32_t state[5], const unsigned char buffer[64])
 {
-unsigned long a, b, c, d, e;
-typedef union {
-    unsigned char c[64];
-    unsigned long l[16];
-} CHAR64LONG16;
-CHAR64LONG16* block;
-#ifdef SHA1HANDSOFF
-static unsigned char workspace[64];
-    block = (CHAR64LONG16*)workspace;
-    memcpy(block, buffer, 64);
-#else
-    block = (CHAR64LONG16*)buffer;
-#endif
+uint32_t a, b, c, d, e;
+uint32_t block[16];
+
     /* Copy context->state[] to working vars */
     a = state[0];
     b = state[1];
@@ -89,8 +77,6 @@ static unsigned char workspace[64];
     state[2] += c;
     state[3] += d;
     state[4] += e;
-    /* Wipe variables */
-    a = b = c = d = e = 0;
 }
 
 
@@ -108,9 +94,10 @@ void SHA1Init(SHA1_CTX* context)
 }
 
 
-/* Run your data through this. */
+/* Run your data through this. Whole blocks are hashed straight from the
+   caller's buffer; only a partial block is staged in the context. */
 
-void SHA1Update(SHA1_CTX* context, unsigned char* data, unsigned int len)
+void SHA1Update(SHA1_CTX* context, const unsigned char* data, unsigned int len)
 {
 unsigned int i, j;
 
@@ -134,31 +121,35 @@ unsigned int i, j;
 
 void SHA1Final(unsigned char digest[20], SHA1_CTX* context)
 {
-unsigned long i, j;
+unsigned int i, j;
 unsigned char finalcount[8];
 
     for (i = 0; i < 8; i++) {
         finalcount[i] = (unsigned char)((context->count[(i >= 4 ? 0 : 1)]
          >> ((3-(i & 3)) * 8) ) & 255);  /* Endian independent */
     }
-    SHA1Update(context, (unsigned char *)"\200", 1);
-    while ((context->count[0] & 504) != 448) {
-        SHA1Update(context, (unsigned char *)"\0", 1);
+
+    /* Pad in place rather than feeding the padding through a byte at a time */
+    j = (context->count[0] >> 3) & 63;
+    context->buffer[j++] = 0x80;
+    if (j > 56) {
+        memset(&context->buffer[j], 0, 64 - j);
+        SHA1Transform(context->state, context->buffer);
+        j = 0;
     }
-    SHA1Update(context, finalcount, 8);  /* Should cause a SHA1Transform() */
+    memset(&context->buffer[j], 0, 56 - j);
+    memcpy(&context->buffer[56], finalcount, 8);
+    SHA1Transform(context->state, context->buffer);
+
     for (i = 0; i < 20; i++) {
         digest[i] = (unsigned char)
          ((context->state[i>>2] >> ((3-(i & 3)) * 8) ) & 255);
     }
     /* Wipe variables */
-    i = j = 0;
     memset(context->buffer, 0, 64);
     memset(context->state, 0, 20);
     memset(context->count, 0, 8);
     memset(&finalcount, 0, 8);
-#ifdef SHA1HANDSOFF  /* make SHA1Transform overwrite it's own static vars */
-    SHA1Transform(context->state, context->buffer);
-#endif
 }
 
 
@@ -7,6 +7,8 @@
 #include "chipid.h"
 #include "timer.h"
 #include "interrupt.h"
+#include "dma.h"
+#include "gpio.h"
 
 static const SPIRegister SPIRegs[NUM_SPIPORTS] = {
 	{SPI0 + CONTROL, SPI0 + SETUP, SPI0 + STATUS, SPI0 + UNKREG1, SPI0 + TXDATA, SPI0 + RXDATA, SPI0 + CLKDIVIDER, SPI0 + UNKREG2, SPI0 + UNKREG3},
@@ -14,9 +16,16 @@ static const SPIRegister SPIRegs[NUM_SPIPORTS] = {
 	{SPI2 + CONTROL, SPI2 + SETUP, SPI2 + STATUS, SPI2 + UNKREG1, SPI2 + TXDATA, SPI2 + RXDATA, SPI2 + CLKDIVIDER, SPI2 + UNKREG2, SPI2 + UNKREG3}
 };
 
+static const int SPIDMATx[NUM_SPIPORTS] = {DMA_SPI0_TX, DMA_SPI1_TX, DMA_SPI2_TX};
+static const int SPIDMARx[NUM_SPIPORTS] = {DMA_SPI0_RX, DMA_SPI1_RX, DMA_SPI2_RX};
+
 static SPIInfo spi_info[NUM_SPIPORTS];
 
 static void spiIRQHandler(uint32_t port);
+static void spiDMAHandler(int status, int controller, int channel);
+static void spi_check_done(int port);
+static void spi_clock_changed(void* opaque);
+static void spi_transaction_step(int port, uint32_t token);
 
 int spi_setup() {
 	clock_gate_switch(SPI0_CLOCKGATE, ON);
@@ -34,137 +43,412 @@ int spi_setup() {
 	interrupt_install(SPI0_IRQ, spiIRQHandler, 0);
 	interrupt_install(SPI1_IRQ, spiIRQHandler, 1);
 	interrupt_install(SPI2_IRQ, spiIRQHandler, 2);
+	interrupt_set_priority(SPI0_IRQ, SPI_INTERRUPT_PRIORITY);
+	interrupt_set_priority(SPI1_IRQ, SPI_INTERRUPT_PRIORITY);
+	interrupt_set_priority(SPI2_IRQ, SPI_INTERRUPT_PRIORITY);
 	interrupt_enable(SPI0_IRQ);
 	interrupt_enable(SPI1_IRQ);
 	interrupt_enable(SPI2_IRQ);
 
+	clock_add_change_handler(spi_clock_changed, NULL);
+
 	return 0;
 }
 
-int spi_tx(int port, const uint8_t* buffer, int len, int block, int unknown) {
-	if(port > (NUM_SPIPORTS - 1)) {
-		return -1;
+// Picks DMA for the whole transfer if every direction in use is at least
+// SPI_DMA_MIN bytes and the port's channels could be reserved.
+static int spi_use_dma(int port, int outLen, int inLen) {
+	SPIInfo* info = &spi_info[port];
+
+	if((outLen > 0 && outLen < SPI_DMA_MIN) || (inLen > 0 && inLen < SPI_DMA_MIN))
+		return FALSE;
+
+	if(outLen > 0 && info->txController == 0) {
+		if(dma_reserve(DMA_MEMORY, SPIDMATx[port], &info->txController, &info->txChannel) != 0)
+			info->txController = -1;
 	}
 
+	if(inLen > 0 && info->rxController == 0) {
+		if(dma_reserve(SPIDMARx[port], DMA_MEMORY, &info->rxController, &info->rxChannel) != 0)
+			info->rxController = -1;
+	}
+
+	return (outLen == 0 || info->txController > 0) && (inLen == 0 || info->rxController > 0);
+}
+
+static void spi_set_interrupts(int port, int value) {
+	SET_REG(SPIRegs[port].setup, (GET_REG(SPIRegs[port].setup) & ~SPISETUP_INTERRUPTMASK) | (value << SPISETUP_INTERRUPTSHIFT));
+}
+
+// Sets up a transfer of outLen bytes out and inLen bytes in; spi_start then
+// sets it going. A direction of length 0 counts as done from the start.
+static void spi_prepare(int port, const uint8_t* outBuffer, int outLen, uint8_t* inBuffer, int inLen, SPIHandler handler, uint32_t token) {
+	SPIInfo* info = &spi_info[port];
+
 	SET_REG(SPIRegs[port].control, GET_REG(SPIRegs[port].control) | (1 << 2));
 	SET_REG(SPIRegs[port].control, GET_REG(SPIRegs[port].control) | (1 << 3));
 
-	spi_info[port].txBuffer = buffer;
-
-	if(len > MAX_TX_BUFFER)
-		spi_info[port].txCurrentLen = MAX_TX_BUFFER;
-	else
-		spi_info[port].txCurrentLen = len;
+	info->handler = handler;
+	info->token = token;
+	info->clearTransmitJunk = FALSE;
+	completion_init(&info->completion);
+
+	info->dma = spi_use_dma(port, outLen, inLen);
+	spi_set_interrupts(port, (info->dma || info->option5) ? SPISETUP_INTERRUPTS_DMA : SPISETUP_INTERRUPTS_CPU);
+
+	info->txTotalLen = outLen;
+	info->txDone = (outLen == 0);
+	info->rxCurrentLen = 0;
+	info->rxTotalLen = inLen;
+	info->rxDone = (inLen == 0);
+	info->counter = 0;
+
+	if(info->dma) {
+		// the interrupt handler leaves the FIFOs alone without buffers
+		info->txBuffer = NULL;
+		info->rxBuffer = NULL;
+
+		if(outLen > 0) {
+			CleanDataCacheRange(outBuffer, outLen);
+			dma_request(DMA_MEMORY, 1, 1, SPIDMATx[port], 1, 1, &info->txController, &info->txChannel, spiDMAHandler);
+		}
 
-	spi_info[port].txTotalLen = len;
-	spi_info[port].txDone = FALSE;
+		if(inLen > 0) {
+			InvalidateDataCacheRange(inBuffer, inLen);
+			dma_request(SPIDMARx[port], 1, 1, DMA_MEMORY, 1, 1, &info->rxController, &info->rxChannel, spiDMAHandler);
+		}
 
-	if(unknown == 0) {
-		SET_REG(SPIRegs[port].unkReg2, 0);
+		info->txCurrentLen = outLen;
+		return;
 	}
 
+	info->txBuffer = (outLen > 0) ? outBuffer : NULL;
+	info->rxBuffer = (inLen > 0) ? inBuffer : NULL;
+
+	if(outLen > MAX_TX_BUFFER)
+		info->txCurrentLen = MAX_TX_BUFFER;
+	else
+		info->txCurrentLen = outLen;
+
 	int i;
-	for(i = 0; i < spi_info[port].txCurrentLen; i++) {
-		SET_REG(SPIRegs[port].txData, buffer[i]);
+	for(i = 0; i < info->txCurrentLen; i++) {
+		SET_REG(SPIRegs[port].txData, outBuffer[i]);
+	}
+}
+
+static void spi_start(int port, const uint8_t* outBuffer, uint8_t* inBuffer) {
+	SPIInfo* info = &spi_info[port];
+
+	if(info->dma) {
+		if(!info->rxDone)
+			dma_perform(SPIDMARx[port], (uint32_t) inBuffer, info->rxTotalLen, 0, &info->rxController, &info->rxChannel);
+		if(!info->txDone)
+			dma_perform((uint32_t) outBuffer, SPIDMATx[port], info->txTotalLen, 0, &info->txController, &info->txChannel);
 	}
 
 	SET_REG(SPIRegs[port].control, 1);
+}
 
-	if(block) {
-		while(!spi_info[port].txDone || GET_BITS(GET_REG(SPIRegs[port].status), 4, 4) != 0) {
-			// yield
-		}
-		return len;
-	} else {
+// Called from interrupt context whenever a direction finishes.
+static void spi_check_done(int port) {
+	SPIInfo* info = &spi_info[port];
+
+	EnterCriticalSection();
+	if(!info->txDone || !info->rxDone || info->completion.done) {
+		LeaveCriticalSection();
+		return;
+	}
+
+	// the last bytes queued may still be on their way out
+	while(GET_BITS(GET_REG(SPIRegs[port].status), 4, 4) != 0);
+
+	if(info->clearTransmitJunk) {
+		SET_REG(SPIRegs[port].setup, GET_REG(SPIRegs[port].setup) & ~1);
+	}
+
+	completion_signal(&info->completion);
+	LeaveCriticalSection();
+
+	if(info->handler)
+		info->handler(port, info->token);
+}
+
+// 1ms plus twice the time the transfer takes on the wire
+static uint32_t spi_timeout(int port, int len) {
+	uint32_t baud = spi_info[port].baud ? spi_info[port].baud : 1000000;
+	return 1000 + (uint32_t)(((uint64_t)len * 8 * 2 * 1000000) / baud);
+}
+
+// Stops the transfer in progress where it is. Call in a critical section.
+static void spi_abandon(int port) {
+	SPIInfo* info = &spi_info[port];
+
+	if(info->dma) {
+		if(!info->txDone)
+			dma_pause(info->txController, info->txChannel);
+		if(!info->rxDone)
+			dma_pause(info->rxController, info->rxChannel);
+	}
+
+	info->txBuffer = NULL;
+	info->rxBuffer = NULL;
+	info->txDone = TRUE;
+	info->rxDone = TRUE;
+	info->handler = NULL;
+	if(info->clearTransmitJunk) {
+		SET_REG(SPIRegs[port].setup, GET_REG(SPIRegs[port].setup) & ~1);
+	}
+	completion_signal(&info->completion);
+}
+
+int spi_wait(int port, uint32_t timeout) {
+	if(port > (NUM_SPIPORTS - 1)) {
+		return -1;
+	}
+
+	SPIInfo* info = &spi_info[port];
+	if(completion_wait(&info->completion, timeout) == 0)
+		return 0;
+
+	EnterCriticalSection();
+	if(info->completion.done) {
+		LeaveCriticalSection();
 		return 0;
 	}
+
+	spi_abandon(port);
+	LeaveCriticalSection();
+
+	return -1;
 }
 
-int spi_rx(int port, uint8_t* buffer, int len, int block, int noTransmitJunk) {
+int spi_tx_async(int port, const uint8_t* buffer, int len, int unknown, SPIHandler handler, uint32_t token) {
 	if(port > (NUM_SPIPORTS - 1)) {
 		return -1;
 	}
 
-	SET_REG(SPIRegs[port].control, GET_REG(SPIRegs[port].control) | (1 << 2));
-	SET_REG(SPIRegs[port].control, GET_REG(SPIRegs[port].control) | (1 << 3));
+	spi_prepare(port, buffer, len, NULL, 0, handler, token);
+
+	if(unknown == 0) {
+		SET_REG(SPIRegs[port].unkReg2, 0);
+	}
+
+	spi_start(port, buffer, NULL);
+	return 0;
+}
+
+int spi_rx_async(int port, uint8_t* buffer, int len, int noTransmitJunk, SPIHandler handler, uint32_t token) {
+	if(port > (NUM_SPIPORTS - 1)) {
+		return -1;
+	}
 
-	spi_info[port].rxBuffer = buffer;
-	spi_info[port].rxDone = FALSE;
-	spi_info[port].rxCurrentLen = 0;
-	spi_info[port].rxTotalLen = len;
-	spi_info[port].counter = 0;
+	spi_prepare(port, NULL, 0, buffer, len, handler, token);
 
 	if(noTransmitJunk == 0) {
+		spi_info[port].clearTransmitJunk = TRUE;
 		SET_REG(SPIRegs[port].setup, GET_REG(SPIRegs[port].setup) | 1);
 	}
 
 	SET_REG(SPIRegs[port].unkReg2, len);
-	SET_REG(SPIRegs[port].control, 1);
+	spi_start(port, NULL, buffer);
+	return 0;
+}
 
-	if(block) {
-		uint64_t startTime = timer_get_system_microtime();
-		while(!spi_info[port].rxDone) {
-			// yield
-			if(has_elapsed(startTime, 1000)) {
-				EnterCriticalSection();
-				spi_info[port].rxDone = TRUE;
-				spi_info[port].rxBuffer = NULL;
-				LeaveCriticalSection();
-				if(noTransmitJunk == 0) {
-					SET_REG(SPIRegs[port].setup, GET_REG(SPIRegs[port].setup) & ~1);
-				}
-				return -1;
+int spi_txrx_async(int port, const uint8_t* outBuffer, int outLen, uint8_t* inBuffer, int inLen, SPIHandler handler, uint32_t token) {
+	if(port > (NUM_SPIPORTS - 1)) {
+		return -1;
+	}
+
+	spi_prepare(port, outBuffer, outLen, inBuffer, inLen, handler, token);
+	SET_REG(SPIRegs[port].unkReg2, inLen);
+	spi_start(port, outBuffer, inBuffer);
+	return 0;
+}
+
+int spi_tx(int port, const uint8_t* buffer, int len, int block, int unknown) {
+	if(spi_tx_async(port, buffer, len, unknown, NULL, 0) != 0)
+		return -1;
+
+	if(!block)
+		return 0;
+
+	if(spi_wait(port, spi_timeout(port, len)) != 0)
+		return -1;
+
+	return len;
+}
+
+int spi_rx(int port, uint8_t* buffer, int len, int block, int noTransmitJunk) {
+	if(spi_rx_async(port, buffer, len, noTransmitJunk, NULL, 0) != 0)
+		return -1;
+
+	if(!block)
+		return 0;
+
+	if(spi_wait(port, spi_timeout(port, len)) != 0)
+		return -1;
+
+	return len;
+}
+
+int spi_txrx(int port, const uint8_t* outBuffer, int outLen, uint8_t* inBuffer, int inLen, int block)
+{
+	if(spi_txrx_async(port, outBuffer, outLen, inBuffer, inLen, NULL, 0) != 0)
+		return -1;
+
+	if(!block)
+		return 0;
+
+	if(spi_wait(port, spi_timeout(port, (outLen > inLen) ? outLen : inLen)) != 0)
+		return -1;
+
+	return inLen;
+}
+
+// Moves the transaction at the head of the queue on by a phase: select and
+// send the command, then the data, then let go and start on the next one.
+// Runs as the handler of each transfer it starts, so from interrupt context
+// after the first.
+static void spi_transaction_step(int port, uint32_t token) {
+	SPIInfo* info = &spi_info[port];
+	SPITransaction* transaction;
+
+	while((transaction = info->queue) != NULL) {
+		if(transaction->phase == 0) {
+			transaction->phase = 1;
+			if(transaction->cs >= 0)
+				gpio_pin_output(transaction->cs, 0);
+
+			if(transaction->commandLen > 0) {
+				spi_tx_async(port, transaction->command, transaction->commandLen, 0, spi_transaction_step, 0);
+				return;
 			}
 		}
-		if(noTransmitJunk == 0) {
-			SET_REG(SPIRegs[port].setup, GET_REG(SPIRegs[port].setup) & ~1);
+
+		if(transaction->phase == 1) {
+			transaction->phase = 2;
+			if(transaction->dataLen > 0 && transaction->direction == SPIDataOut) {
+				spi_tx_async(port, transaction->out, transaction->dataLen, 0, spi_transaction_step, 0);
+				return;
+			} else if(transaction->dataLen > 0 && transaction->direction == SPIDataIn) {
+				spi_rx_async(port, transaction->in, transaction->dataLen, 0, spi_transaction_step, 0);
+				return;
+			}
 		}
-		return len;
+
+		if(transaction->cs >= 0 && !transaction->keepSelected)
+			gpio_pin_output(transaction->cs, 1);
+
+		info->queue = transaction->next;
+		if(info->queue == NULL)
+			info->queueTail = NULL;
+
+		transaction->status = 0;
+		completion_signal(&transaction->completion);
+		if(transaction->handler)
+			transaction->handler(port, transaction->token);
+	}
+}
+
+int spi_submit(int port, SPITransaction* transaction) {
+	if(port > (NUM_SPIPORTS - 1)) {
+		return -1;
+	}
+
+	SPIInfo* info = &spi_info[port];
+
+	transaction->status = -1;
+	transaction->phase = 0;
+	transaction->next = NULL;
+	completion_init(&transaction->completion);
+
+	EnterCriticalSection();
+	if(info->queue == NULL) {
+		info->queue = transaction;
+		info->queueTail = transaction;
+		spi_transaction_step(port, 0);
 	} else {
-		return 0;
+		info->queueTail->next = transaction;
+		info->queueTail = transaction;
 	}
+	LeaveCriticalSection();
+
+	return 0;
 }
 
-int spi_txrx(int port, const uint8_t* outBuffer, int outLen, uint8_t* inBuffer, int inLen, int block)
-{
+int spi_transaction_wait(int port, SPITransaction* transaction, uint32_t timeout) {
 	if(port > (NUM_SPIPORTS - 1)) {
 		return -1;
 	}
 
-	SET_REG(SPIRegs[port].control, GET_REG(SPIRegs[port].control) | (1 << 2));
-	SET_REG(SPIRegs[port].control, GET_REG(SPIRegs[port].control) | (1 << 3));
+	SPIInfo* info = &spi_info[port];
+	if(completion_wait(&transaction->completion, timeout) == 0)
+		return transaction->status;
 
-	spi_info[port].txBuffer = outBuffer;
+	EnterCriticalSection();
+	if(transaction->completion.done) {
+		LeaveCriticalSection();
+		return transaction->status;
+	}
 
-	if(outLen > MAX_TX_BUFFER)
-		spi_info[port].txCurrentLen = MAX_TX_BUFFER;
-	else
-		spi_info[port].txCurrentLen = outLen;
+	// whatever is queued behind it was waiting on the same stuck port
+	if(!info->completion.done)
+		spi_abandon(port);
 
-	spi_info[port].txTotalLen = outLen;
-	spi_info[port].txDone = FALSE;
+	while(info->queue != NULL) {
+		SPITransaction* abandoned = info->queue;
+		info->queue = abandoned->next;
 
-	spi_info[port].rxBuffer = inBuffer;
-	spi_info[port].rxDone = FALSE;
-	spi_info[port].rxCurrentLen = 0;
-	spi_info[port].rxTotalLen = inLen;
-	spi_info[port].counter = 0;
+		if(abandoned->cs >= 0 && abandoned->phase > 0)
+			gpio_pin_output(abandoned->cs, 1);
 
-	int i;
-	for(i = 0; i < spi_info[port].txCurrentLen; i++) {
-		SET_REG(SPIRegs[port].txData, outBuffer[i]);
+		abandoned->status = -1;
+		completion_signal(&abandoned->completion);
 	}
+	info->queueTail = NULL;
+	LeaveCriticalSection();
 
-	SET_REG(SPIRegs[port].unkReg2, inLen);
-	SET_REG(SPIRegs[port].control, 1);
+	return -1;
+}
 
-	if(block) {
-		while(!spi_info[port].txDone || !spi_info[port].rxDone || GET_BITS(GET_REG(SPIRegs[port].status), 4, 4) != 0) {
-			// yield
-		}
-		return inLen;
+int spi_transaction(int port, SPITransaction* transaction) {
+	if(spi_submit(port, transaction) != 0)
+		return -1;
+
+	return spi_transaction_wait(port, transaction, spi_timeout(port, transaction->commandLen + transaction->dataLen));
+}
+
+static uint32_t spi_divider(int port, int baud) {
+	uint32_t clockFrequency;
+
+	if(spi_info[port].clockSource == PCLK) {
+		clockFrequency = PeripheralFrequency;
 	} else {
-		return 0;
+		clockFrequency = FixedFrequency;
+	}
+
+	uint32_t divider;
+
+	if(chipid_spi_clocktype() != 0) {
+		divider = clockFrequency / baud;
+		if(divider < 2)
+			divider = 2;
+	} else {
+		divider = clockFrequency / (baud * 2 - 1);
+	}
+
+	return divider;
+}
+
+static void spi_clock_changed(void* opaque) {
+	int i;
+	for(i = 0; i < NUM_SPIPORTS; i++) {
+		if(spi_info[i].clockSource != PCLK || spi_info[i].baud == 0)
+			continue;
+
+		uint32_t divider = spi_divider(i, spi_info[i].baud);
+		if(divider <= MAX_DIVIDER)
+			SET_REG(SPIRegs[i].clkDivider, divider);
 	}
 }
 
@@ -192,23 +476,7 @@ void spi_set_baud(int port, int baud, SPIOption13 option13, int isMaster, int is
 	spi_info[port].isActiveLow = isActiveLow;
 	spi_info[port].lastClockEdgeMissing = lastClockEdgeMissing;
 
-	uint32_t clockFrequency;
-
-	if(spi_info[port].clockSource == PCLK) {
-		clockFrequency = PeripheralFrequency;
-	} else {
-		clockFrequency = FixedFrequency;
-	}
-
-	uint32_t divider;
-
-	if(chipid_spi_clocktype() != 0) {
-		divider = clockFrequency / baud;
-		if(divider < 2)
-			divider = 2;
-	} else {
-		divider = clockFrequency / (baud * 2 - 1);
-	}
+	uint32_t divider = spi_divider(port, baud);
 
 	if(divider > MAX_DIVIDER) {
 		return;
@@ -221,7 +489,7 @@ void spi_set_baud(int port, int baud, SPIOption13 option13, int isMaster, int is
 	uint32_t options = (lastClockEdgeMissing << 1)
 			| (isActiveLow << 2)
 			| ((isMaster ? 0x3 : 0) << 3)
-			| ((spi_info[port].option5 ? 0x2 : 0x3D) << 5)
+			| ((spi_info[port].option5 ? SPISETUP_INTERRUPTS_DMA : SPISETUP_INTERRUPTS_CPU) << SPISETUP_INTERRUPTSHIFT)
 			| (spi_info[port].clockSource << CLOCK_SHIFT)
 			| spi_info[port].option13 << 13;
 
@@ -242,6 +510,7 @@ static void spiIRQHandler(uint32_t port) {
 	}
 
 	int i;
+	int finished = FALSE;
 
 	if(status & (1 << 1)) {
 		while(TRUE) {
@@ -263,6 +532,7 @@ static void spiIRQHandler(uint32_t port) {
 				} else {
 					spi_info[port].txDone = TRUE;
 					spi_info[port].txBuffer = NULL;
+					finished = TRUE;
 				}
 			}
 
@@ -288,6 +558,7 @@ dorx:
 
 			spi_info[port].rxDone = TRUE;
 			spi_info[port].rxBuffer = NULL;
+			finished = TRUE;
 
 		}
 
@@ -299,5 +570,30 @@ dorx:
 
 	// acknowledge interrupt handling complete
 	SET_REG(SPIRegs[port].status, status);
+
+	if(finished)
+		spi_check_done(port);
+}
+
+static void spiDMAHandler(int status, int controller, int channel) {
+	int port;
+	for(port = 0; port < NUM_SPIPORTS; port++) {
+		SPIInfo* info = &spi_info[port];
+		if(!info->dma)
+			continue;
+
+		if(!info->txDone && controller == info->txController && channel == info->txChannel) {
+			dma_finish(controller, channel, 0);
+			info->txDone = TRUE;
+		} else if(!info->rxDone && controller == info->rxController && channel == info->rxChannel) {
+			dma_finish(controller, channel, 0);
+			info->rxDone = TRUE;
+		} else {
+			continue;
+		}
+
+		spi_check_done(port);
+		return;
+	}
 }
 
@@ -50,6 +50,8 @@ int syscfg_setup()
 	if(header.magic != SCFG_MAGIC)
 	{
 		bufferPrintf("syscfg: cannot find readable syscfg partition!\r\n");
+		// so that lookups find nothing rather than going through garbage
+		header.entries = 0;
 		return -1;
 	}
 
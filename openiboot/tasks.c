@@ -1,4 +1,8 @@
+#include "openiboot.h"
+#include "openiboot-asmhelpers.h"
 #include "tasks.h"
+#include "event.h"
+#include "timer.h"
 #include "util.h"
 
 const TaskDescriptor bootstrapTaskInit = {
@@ -8,7 +12,7 @@ const TaskDescriptor bootstrapTaskInit = {
 	TASK_RUNNING,
 	1,
 	{0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
-	{{0, 0}, 0, 0, 0, 0},
+	{0, 0, 0, 0, 0},
 	{0, 0},
 	0,
 	0,
@@ -21,9 +25,331 @@ const TaskDescriptor bootstrapTaskInit = {
 
 TaskDescriptor bootstrapTask;
 
+// Tasks switch when they block, sleep or yield. Every switch happens inside a
+// critical section; each task keeps its own nesting count, so the resumed task
+// picks up with interrupts in the state it left them.
+static TaskQueue RunQueue;
+
+// A task cannot free the stack it is running on, so the next one to run does.
+static TaskDescriptor* ZombieTask = NULL;
+
+static void queue_push(TaskQueue* queue, TaskDescriptor* task) {
+	task->runqueueList.next = NULL;
+	if(queue->tail == NULL)
+		queue->head = task;
+	else
+		queue->tail->runqueueList.next = task;
+	queue->tail = task;
+}
+
+static TaskDescriptor* queue_pop(TaskQueue* queue) {
+	TaskDescriptor* task = queue->head;
+	if(task != NULL) {
+		queue->head = task->runqueueList.next;
+		if(queue->head == NULL)
+			queue->tail = NULL;
+		task->runqueueList.next = NULL;
+	}
+	return task;
+}
+
+static void queue_remove(TaskQueue* queue, TaskDescriptor* task) {
+	TaskDescriptor* prev = NULL;
+	TaskDescriptor* cur = queue->head;
+
+	while(cur != NULL && cur != task) {
+		prev = cur;
+		cur = cur->runqueueList.next;
+	}
+
+	if(cur == NULL)
+		return;
+
+	if(prev == NULL)
+		queue->head = task->runqueueList.next;
+	else
+		prev->runqueueList.next = task->runqueueList.next;
+
+	if(queue->tail == task)
+		queue->tail = prev;
+
+	task->runqueueList.next = NULL;
+}
+
+static void task_make_ready(TaskDescriptor* task) {
+	task->state = TASK_READY;
+	queue_push(&RunQueue, task);
+}
+
+static void task_reap() {
+	if(ZombieTask != NULL && ZombieTask != CurrentRunning) {
+		free(ZombieTask->storage);
+		free(ZombieTask);
+		ZombieTask = NULL;
+	}
+}
+
+// Nothing is runnable: sleep the core until an interrupt is pending, then let
+// it in. WFI wakes on a pending interrupt even while they are masked.
+static void task_idle() {
+	WaitForInterrupt();
+	EnableCPUFIQ();
+	EnableCPUIRQ();
+	DisableCPUIRQ();
+	DisableCPUFIQ();
+}
+
+// Must be called inside a critical section. Returns when the calling task is
+// scheduled again.
+static void task_switch() {
+	TaskDescriptor* prev = CurrentRunning;
+	TaskDescriptor* next;
+
+	while((next = queue_pop(&RunQueue)) == NULL) {
+		if(prev->state == TASK_RUNNING)
+			return;
+
+		task_idle();
+	}
+
+	if(prev->state == TASK_RUNNING)
+		task_make_ready(prev);
+
+	next->state = TASK_RUNNING;
+	CurrentRunning = next;
+	SwapTaskContext(prev, next);
+
+	task_reap();
+}
+
+static void task_entry() {
+	task_reap();
+
+	// new tasks start inside the critical section of the switch that started them
+	LeaveCriticalSection();
+
+	CurrentRunning->taskRoutine(CurrentRunning->unknown_passed_value);
+	task_exit(0);
+}
+
 int tasks_setup() {
 	memcpy(&bootstrapTask, &bootstrapTaskInit, sizeof(TaskDescriptor));
+	bootstrapTask.taskList.next = &bootstrapTask;
+	bootstrapTask.taskList.prev = &bootstrapTask;
+	RunQueue.head = RunQueue.tail = NULL;
 	CurrentRunning = &bootstrapTask;
 	return 0;
 }
 
+TaskDescriptor* task_create(const char* name, TaskRoutineFunction routine, void* opaque, uint32_t stackSize) {
+	if(stackSize == 0)
+		stackSize = TASK_DEFAULT_STACK;
+
+	stackSize = (stackSize + 7) & ~7;
+
+	TaskDescriptor* task = (TaskDescriptor*) malloc(sizeof(TaskDescriptor));
+	void* stack = memalign(8, stackSize);
+	if(task == NULL || stack == NULL) {
+		free(task);
+		free(stack);
+		return NULL;
+	}
+
+	memset(task, 0, sizeof(TaskDescriptor));
+	task->identifier1 = TaskDescriptorIdentifier1;
+	task->identifier2 = TaskDescriptorIdentifier2;
+	task->criticalSectionNestCount = 1;
+	task->taskRoutine = routine;
+	task->unknown_passed_value = opaque;
+	task->storage = stack;
+	task->storageSize = stackSize;
+	size_t nameLen = strlen(name);
+	if(nameLen > (sizeof(task->taskName) - 1))
+		nameLen = sizeof(task->taskName) - 1;
+	memcpy(task->taskName, name, nameLen);
+
+	task->savedRegisters.sp = ((uint32_t) stack) + stackSize;
+	task->savedRegisters.lr = (uint32_t) &task_entry;
+
+	EnterCriticalSection();
+	task->taskList.next = &bootstrapTask;
+	task->taskList.prev = bootstrapTask.taskList.prev;
+	((TaskDescriptor*)bootstrapTask.taskList.prev)->taskList.next = task;
+	bootstrapTask.taskList.prev = task;
+	task_make_ready(task);
+	LeaveCriticalSection();
+
+	return task;
+}
+
+void task_yield() {
+	EnterCriticalSection();
+	task_switch();
+	LeaveCriticalSection();
+}
+
+static void task_wakeup(Event* event, void* opaque) {
+	TaskDescriptor* task = (TaskDescriptor*) opaque;
+	if(task->state == TASK_SLEEPING)
+		task_make_ready(task);
+}
+
+int task_can_sleep() {
+	// interrupt handlers run with the interrupted task's count raised
+	return CurrentRunning != NULL && CurrentRunning->criticalSectionNestCount == 0;
+}
+
+void task_sleep(uint32_t microseconds) {
+	EnterCriticalSection();
+	CurrentRunning->state = TASK_SLEEPING;
+	if(event_add(&CurrentRunning->sleepEvent, microseconds, task_wakeup, CurrentRunning) != 0) {
+		CurrentRunning->state = TASK_RUNNING;
+		LeaveCriticalSection();
+
+		// not udelay, which would come straight back here
+		uint64_t startTime = timer_get_system_microtime();
+		while(!has_elapsed(startTime, microseconds));
+		return;
+	}
+	task_switch();
+	LeaveCriticalSection();
+}
+
+void task_exit(uint32_t exitState) {
+	TaskDescriptor* task = CurrentRunning;
+
+	if(task == &bootstrapTask) {
+		bufferPrintf("tasks: bootstrap task cannot exit\r\n");
+		return;
+	}
+
+	EnterCriticalSection();
+	task->exitState = exitState;
+	task->state = TASK_STOPPED;
+
+	((TaskDescriptor*)task->taskList.prev)->taskList.next = task->taskList.next;
+	((TaskDescriptor*)task->taskList.next)->taskList.prev = task->taskList.prev;
+
+	task_reap();
+	ZombieTask = task;
+
+	// never returns, the next task frees this one
+	task_switch();
+}
+
+void tasks_list() {
+	static const char* stateNames[] = {"?", "ready", "running", "?", "sleeping", "stopped"};
+	TaskDescriptor* task = &bootstrapTask;
+
+	EnterCriticalSection();
+	do {
+		bufferPrintf("%-16s %-9s stack: %d bytes\r\n", task->taskName, stateNames[task->state], task->storageSize);
+		task = task->taskList.next;
+	} while(task != &bootstrapTask);
+	LeaveCriticalSection();
+}
+
+void mutex_init(Mutex* mutex) {
+	mutex->owner = NULL;
+	mutex->count = 0;
+	mutex->waiters.head = mutex->waiters.tail = NULL;
+}
+
+void mutex_lock(Mutex* mutex) {
+	EnterCriticalSection();
+	if(mutex->owner == CurrentRunning) {
+		mutex->count++;
+	} else {
+		while(mutex->owner != NULL) {
+			CurrentRunning->state = TASK_SLEEPING;
+			queue_push(&mutex->waiters, CurrentRunning);
+			task_switch();
+		}
+		mutex->owner = CurrentRunning;
+		mutex->count = 1;
+	}
+	LeaveCriticalSection();
+}
+
+void mutex_unlock(Mutex* mutex) {
+	EnterCriticalSection();
+	if(mutex->owner == CurrentRunning && --mutex->count == 0) {
+		mutex->owner = NULL;
+		TaskDescriptor* waiter = queue_pop(&mutex->waiters);
+		if(waiter != NULL)
+			task_make_ready(waiter);
+	}
+	LeaveCriticalSection();
+}
+
+void semaphore_init(Semaphore* semaphore, int32_t value) {
+	semaphore->value = value;
+	semaphore->waiters.head = semaphore->waiters.tail = NULL;
+}
+
+void semaphore_wait(Semaphore* semaphore) {
+	EnterCriticalSection();
+	while(semaphore->value <= 0) {
+		CurrentRunning->state = TASK_SLEEPING;
+		queue_push(&semaphore->waiters, CurrentRunning);
+		task_switch();
+	}
+	semaphore->value--;
+	LeaveCriticalSection();
+}
+
+void semaphore_signal(Semaphore* semaphore) {
+	EnterCriticalSection();
+	semaphore->value++;
+	TaskDescriptor* waiter = queue_pop(&semaphore->waiters);
+	if(waiter != NULL)
+		task_make_ready(waiter);
+	LeaveCriticalSection();
+}
+
+void completion_init(Completion* completion) {
+	completion->done = FALSE;
+	completion->waiters.head = completion->waiters.tail = NULL;
+}
+
+void completion_signal(Completion* completion) {
+	TaskDescriptor* waiter;
+
+	EnterCriticalSection();
+	completion->done = TRUE;
+	while((waiter = queue_pop(&completion->waiters)) != NULL)
+		task_make_ready(waiter);
+	LeaveCriticalSection();
+}
+
+int completion_wait(Completion* completion, uint32_t timeout) {
+	uint64_t startTime = timer_get_system_microtime();
+	int ret = 0;
+
+	EnterCriticalSection();
+	while(!completion->done) {
+		uint64_t elapsed = timer_get_system_microtime() - startTime;
+		if(elapsed >= timeout) {
+			ret = -1;
+			break;
+		}
+
+		// the sleep event doubles as the timeout; whichever comes first wakes us
+		CurrentRunning->state = TASK_SLEEPING;
+		queue_push(&completion->waiters, CurrentRunning);
+		if(event_add(&CurrentRunning->sleepEvent, timeout - elapsed, task_wakeup, CurrentRunning) != 0) {
+			queue_remove(&completion->waiters, CurrentRunning);
+			CurrentRunning->state = TASK_RUNNING;
+			task_idle();
+			continue;
+		}
+
+		task_switch();
+
+		event_cancel(&CurrentRunning->sleepEvent);
+		queue_remove(&completion->waiters, CurrentRunning);
+	}
+	LeaveCriticalSection();
+
+	return ret;
+}
@@ -3,6 +3,7 @@
 #include "clock.h"
 #include "interrupt.h"
 #include "hardware/timer.h"
+#include "tasks.h"
 
 const TimerRegisters HWTimers[] = {
 		{	TIMER + TIMER_0 + TIMER_CONFIG, TIMER + TIMER_0 + TIMER_STATE, TIMER + TIMER_0 + TIMER_COUNT_BUFFER, 
@@ -28,6 +29,35 @@ static void callTimerHandler(int timer_id, uint32_t flags);
 
 int RTCHasInit;
 
+// Conversions between ticks and microseconds are a multiply and a shift,
+// worked out once in timer_setup, so nothing that reads the time divides.
+typedef struct TimerScale {
+	uint32_t mult;
+	uint32_t shift;
+} TimerScale;
+
+static TimerScale TicksToUs;
+static TimerScale UsToTicks;
+
+// the largest shift that still leaves mult in 32 bits
+static void timer_calc_scale(TimerScale* scale, uint32_t from, uint32_t to) {
+	uint32_t shift = 32;
+	while(shift > 0 && ((((uint64_t)to) << shift) / from) > 0xFFFFFFFFULL)
+		shift--;
+
+	scale->mult = (uint32_t)((((uint64_t)to) << shift) / from);
+	scale->shift = shift;
+}
+
+// The low half is done on its own so nothing needs more than 64 bits.
+static inline uint64_t timer_scale(const TimerScale* scale, uint64_t value) {
+	uint32_t high = (uint32_t)(value >> 32);
+	uint32_t low = (uint32_t)value;
+
+	return ((((uint64_t)high) * scale->mult) << (32 - scale->shift))
+		+ ((((uint64_t)low) * scale->mult) >> scale->shift);
+}
+
 static void timer_init_rtc() {
 	SET_REG(TIMER + TIMER_UNKREG0, TIMER_UNKREG0_RESET1);
 	SET_REG(TIMER + TIMER_UNKREG2, TIMER_UNKREG2_RESET);
@@ -46,6 +76,9 @@ int timer_setup() {
 	/* stop/cleanup any existing timers */
 	timer_stop_all();
 
+	timer_calc_scale(&TicksToUs, TicksPerSec, uSecPerSec);
+	timer_calc_scale(&UsToTicks, uSecPerSec, TicksPerSec);
+
 	/* do some voodoo */
 	timer_init_rtc();
 
@@ -217,14 +250,18 @@ static void callTimerHandler(int timer_id, uint32_t flags) {
 }
 
 uint64_t timer_get_system_microtime() {
-        uint64_t ticks;
-        uint64_t sec_divisor;
+	return timer_ticks_to_us(timer_get_ticks());
+}
 
-        timer_get_rtc_ticks(&ticks, &sec_divisor);          
-        return (ticks * uSecPerSec)/sec_divisor;
+uint64_t timer_ticks_to_us(uint64_t ticks) {
+	return timer_scale(&TicksToUs, ticks);
 }
 
-void timer_get_rtc_ticks(uint64_t* ticks, uint64_t* sec_divisor) {
+uint64_t timer_us_to_ticks(uint64_t us) {
+	return timer_scale(&UsToTicks, us);
+}
+
+uint64_t timer_get_ticks() {
 	register uint32_t ticksHigh;
 	register uint32_t ticksLow;
 	register uint32_t ticksHigh2;
@@ -236,7 +273,11 @@ void timer_get_rtc_ticks(uint64_t* ticks, uint64_t* sec_divisor) {
 		ticksHigh2 = GET_REG(TIMER + TIMER_TICKSHIGH);
 	} while(ticksHigh != ticksHigh2);
 
-	*ticks = (((uint64_t)ticksHigh) << 32) | ticksLow;
+	return (((uint64_t)ticksHigh) << 32) | ticksLow;
+}
+
+void timer_get_rtc_ticks(uint64_t* ticks, uint64_t* sec_divisor) {
+	*ticks = timer_get_ticks();
 	*sec_divisor = TicksPerSec;
 }
 
@@ -245,10 +286,22 @@ void udelay(uint64_t delay) {
 		return;
 	}
 
-	uint64_t startTime = timer_get_system_microtime();
+	// long waits let other tasks run, or the core idle in WFI
+	if(delay >= UDELAY_SLEEP_MIN && delay <= 0xFFFFFFFF && task_can_sleep()) {
+		task_sleep(delay);
+		return;
+	}
+
+	uint64_t startTicks = timer_get_ticks();
+	uint64_t delayTicks = timer_us_to_ticks(delay);
 
 	// loop while elapsed time is less than requested delay
-	while((timer_get_system_microtime() - startTime) < delay);
+	while((timer_get_ticks() - startTicks) < delayTicks);
+}
+
+void poll_wait(uint64_t startTime) {
+	if(has_elapsed(startTime, POLL_SPIN_TIME) && task_can_sleep())
+		task_sleep(POLL_SLEEP_TIME);
 }
 
 int has_elapsed(uint64_t startTime, uint64_t elapsedTime) {
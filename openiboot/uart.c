@@ -3,6 +3,10 @@
 #include "clock.h"
 #include "hardware/uart.h"
 #include "timer.h"
+#include "interrupt.h"
+#include "tasks.h"
+#include "util.h"
+#include "openiboot-asmhelpers.h"
 
 const UARTRegisters HWUarts[] = {
 	{UART + UART0 + UART_ULCON, UART + UART0 + UART_UCON, UART + UART0 + UART_UFCON, 0,
@@ -30,6 +34,97 @@ UARTSettings UARTs[5];
 
 int UartHasInit;
 
+typedef struct UARTRing {
+	char* data;
+	volatile uint32_t head;
+	volatile uint32_t tail;
+	uint32_t overruns;
+	Completion ready;
+	int enabled;
+} UARTRing;
+
+static UARTRing UARTRings[NUM_UARTS];
+
+typedef struct UARTTxRing {
+	char* data;
+	volatile uint32_t head;
+	volatile uint32_t tail;
+	int enabled;
+} UARTTxRing;
+
+static UARTTxRing UARTTxRings[NUM_UARTS];
+
+static int uart_can_read(int ureg) {
+	if(UARTs[ureg].fifo) {
+		uint32_t ufstat = GET_REG(HWUarts[ureg].UFSTAT);
+		return (ufstat & UART_UFSTAT_RXFIFO_FULL) | (ufstat & UART_UFSTAT_RXCOUNT_MASK);
+	} else {
+		return GET_REG(HWUarts[ureg].UTRSTAT) & UART_UTRSTAT_RECEIVEDATAREADY;
+	}
+}
+
+static int uart_can_write(int ureg) {
+	if(UARTs[ureg].fifo)
+		return (GET_REG(HWUarts[ureg].UFSTAT) & UART_UFSTAT_TXFIFO_FULL) == 0;
+	else
+		return GET_REG(HWUarts[ureg].UTRSTAT) & UART_UTRSTAT_TRANSMITTEREMPTY;
+}
+
+// Moves as much of the transmit ring into the FIFO as it takes, with
+// interrupts off.
+static void uart_tx_fill(int ureg) {
+	UARTTxRing* ring = &UARTTxRings[ureg];
+
+	while(ring->tail != ring->head && uart_can_write(ureg)) {
+		SET_REG(HWUarts[ureg].UTXH, ring->data[ring->tail % UART_TX_RING]);
+		ring->tail++;
+	}
+}
+
+static void uartIRQHandler(uint32_t token) {
+	int ureg = token;
+	const UARTRegisters* uart = &HWUarts[ureg];
+	UARTRing* ring = &UARTRings[ureg];
+	int received = FALSE;
+	uint32_t discard;
+
+	// the transmit interrupt is a pulse as the FIFO runs empty
+	if(UARTTxRings[ureg].enabled)
+		uart_tx_fill(ureg);
+
+	if(!ring->enabled)
+		return;
+
+	// drain everything, the interrupt is level triggered
+	while(uart_can_read(ureg)) {
+		if(GET_REG(uart->UERSTAT)) {
+			discard = GET_REG(uart->URXH);
+			continue;
+		}
+
+		char c = GET_REG(uart->URXH);
+		if((ring->head - ring->tail) >= UART_RX_RING) {
+			ring->overruns++;
+			continue;
+		}
+
+		ring->data[ring->head % UART_RX_RING] = c;
+		ring->head++;
+		received = TRUE;
+	}
+
+	if(received)
+		completion_signal(&ring->ready);
+}
+
+static void uart_clock_changed(void* opaque) {
+	int i;
+	for(i = 0; i < NUM_UARTS; i++) {
+		if(UARTs[i].clock == UART_CLOCK_PCLK)
+			uart_set_baud_rate(i, UARTs[i].baud);
+	}
+}
+
 int uart_setup() {
 	int i;
 
@@ -81,8 +176,15 @@ int uart_setup() {
 
 	uart_set_mode(0, UART_POLL_MODE);
 
+	clock_add_change_handler(uart_clock_changed, NULL);
+
 	UartHasInit = TRUE;
 
+#ifndef UART_TX_SYNC
+	// the console, so printing doesn't wait on the baud rate
+	uart_set_tx_buffered(0, ON);
+#endif
+
 	return 0;
 }
 
@@ -205,6 +307,35 @@ int uart_write(int ureg, const char *buffer, uint32_t length) {
 		return -1; // unhandled uart mode
 
 	int written = 0;
+	UARTTxRing* ring = &UARTTxRings[ureg];
+	if(ring->enabled) {
+		EnterCriticalSection();
+		while(written < length) {
+			uint32_t room = UART_TX_RING - (ring->head - ring->tail);
+			if(room == 0) {
+				// full, so this one waits on the wire after all
+				while(!uart_can_write(ureg));
+				uart_tx_fill(ureg);
+				continue;
+			}
+
+			if(room > (length - written))
+				room = length - written;
+
+			uint32_t i;
+			for(i = 0; i < room; i++)
+				ring->data[(ring->head + i) % UART_TX_RING] = buffer[written + i];
+
+			ring->head += room;
+			written += room;
+		}
+
+		// what doesn't fit in the FIFO now goes from the interrupt
+		uart_tx_fill(ureg);
+		LeaveCriticalSection();
+		return written;
+	}
+
 	while(written < length) {
 		if(settings->fifo) {
 			// spin until the tx fifo buffer is no longer full
@@ -231,33 +362,158 @@ int uart_write(int ureg, const char *buffer, uint32_t length) {
 	return written;
 }
 
-int uart_read(int ureg, char *buffer, uint32_t length, uint64_t timeout) {
+// The one handler does both directions, so it stays on while either needs it.
+static void uart_update_interrupt(int ureg) {
+	if(UARTRings[ureg].enabled || UARTTxRings[ureg].enabled) {
+		interrupt_install(UART_INTERRUPT(ureg), uartIRQHandler, ureg);
+		interrupt_set_priority(UART_INTERRUPT(ureg), UART_INTERRUPT_PRIORITY);
+		interrupt_enable(UART_INTERRUPT(ureg));
+	} else {
+		interrupt_disable(UART_INTERRUPT(ureg));
+	}
+}
+
+int uart_set_tx_buffered(int ureg, OnOff buffered) {
 	if(!UartHasInit)
-		return -1;
+		uart_setup();
 
 	if(ureg > 4)
 		return -1; // Invalid ureg
 
-	const UARTRegisters* uart = &HWUarts[ureg];
-	UARTSettings* settings = &UARTs[ureg];
+	UARTTxRing* ring = &UARTTxRings[ureg];
 
-	if(settings->mode != UART_POLL_MODE)
-		return -1; // unhandled uart mode
+	if(buffered == ON) {
+		if(ring->enabled)
+			return 0;
+
+		// the interrupt can't sit and wait for CTS
+		if(UARTs[ureg].flow_control)
+			return -1;
+
+		if(ring->data == NULL) {
+			ring->data = malloc(UART_TX_RING);
+			if(ring->data == NULL)
+				return -1;
+		}
+
+		ring->head = 0;
+		ring->tail = 0;
+		ring->enabled = TRUE;
+	} else {
+		if(!ring->enabled)
+			return 0;
+
+		uart_flush(ureg);
+		ring->enabled = FALSE;
+	}
+
+	uart_update_interrupt(ureg);
+	return 0;
+}
+
+void uart_flush(int ureg) {
+	if(!UartHasInit || ureg > 4)
+		return;
+
+	UARTTxRing* ring = &UARTTxRings[ureg];
+
+	// polls, so it works with interrupts off too
+	EnterCriticalSection();
+	while(ring->enabled && ring->tail != ring->head)
+		uart_tx_fill(ureg);
 
+	while((GET_REG(HWUarts[ureg].UTRSTAT) & UART_UTRSTAT_TRANSMITTEREMPTY) == 0);
+	LeaveCriticalSection();
+}
+
+int uart_set_rx_buffered(int ureg, OnOff buffered) {
+	if(!UartHasInit)
+		uart_setup();
+
+	if(ureg > 4)
+		return -1; // Invalid ureg
+
+	UARTRing* ring = &UARTRings[ureg];
+
+	if(buffered == ON) {
+		if(ring->enabled)
+			return 0;
+
+		if(ring->data == NULL) {
+			ring->data = malloc(UART_RX_RING);
+			if(ring->data == NULL)
+				return -1;
+		}
+
+		ring->head = 0;
+		ring->tail = 0;
+		ring->overruns = 0;
+		completion_init(&ring->ready);
+		ring->enabled = TRUE;
+
+		// interrupt while anything is in the FIFO, and after a pause for what is left below the trigger level
+		SET_REG(HWUarts[ureg].UCON, GET_REG(HWUarts[ureg].UCON) | UART_UCON_RXTIMEOUT | UART_UCON_RXINT_LEVEL);
+	} else {
+		if(!ring->enabled)
+			return 0;
+
+		SET_REG(HWUarts[ureg].UCON, GET_REG(HWUarts[ureg].UCON) & ~(UART_UCON_RXTIMEOUT | UART_UCON_RXINT_LEVEL));
+		ring->enabled = FALSE;
+	}
+
+	uart_update_interrupt(ureg);
+	return 0;
+}
+
+uint32_t uart_rx_overruns(int ureg) {
+	if(ureg > 4)
+		return 0;
+
+	return UARTRings[ureg].overruns;
+}
+
+static int uart_read_ring(int ureg, char *buffer, uint32_t length, uint64_t timeout, int some) {
+	UARTRing* ring = &UARTRings[ureg];
 	uint64_t startTime = timer_get_system_microtime();
 	int written = 0;
-	uint32_t discard;
 
 	while(written < length) {
-		register int canRead = 0;
-		if(settings->fifo) {
-			uint32_t ufstat = GET_REG(uart->UFSTAT);
-			canRead = (ufstat & UART_UFSTAT_RXFIFO_FULL) | (ufstat & UART_UFSTAT_RXCOUNT_MASK);
-		} else {
-			canRead = GET_REG(uart->UTRSTAT) & UART_UTRSTAT_RECEIVEDATAREADY;
+		if(ring->tail != ring->head) {
+			buffer[written++] = ring->data[ring->tail % UART_RX_RING];
+			ring->tail++;
+			continue;
 		}
 
-		if(canRead) {
+		if(some && written > 0)
+			break;
+
+		uint64_t elapsed = timer_get_system_microtime() - startTime;
+		if(elapsed >= timeout)
+			break;
+
+		// rearm before looking again, so a byte arriving in between still wakes us
+		EnterCriticalSection();
+		completion_init(&ring->ready);
+		int empty = (ring->tail == ring->head);
+		LeaveCriticalSection();
+
+		if(empty) {
+			uint64_t left = timeout - elapsed;
+			completion_wait(&ring->ready, (left > 0xFFFFFFFF) ? 0xFFFFFFFF : (uint32_t) left);
+		}
+	}
+
+	return written;
+}
+
+static int uart_read_poll(int ureg, char *buffer, uint32_t length, uint64_t timeout, int some) {
+	const UARTRegisters* uart = &HWUarts[ureg];
+	uint64_t startTime = timer_get_system_microtime();
+	int written = 0;
+	uint32_t discard;
+
+	while(written < length) {
+		if(uart_can_read(ureg)) {
 			if(GET_REG(uart->UERSTAT)) {
 				discard = GET_REG(uart->URXH);
 			} else {
@@ -266,6 +522,10 @@ int uart_read(int ureg, char *buffer, uint32_t length, uint64_t timeout) {
 				buffer++;
 			}
 		} else {
+			if(some && written > 0) {
+				break;
+			}
+
 			if((timer_get_system_microtime() - startTime) >= timeout) {
 				break;
 			}
@@ -275,3 +535,27 @@ int uart_read(int ureg, char *buffer, uint32_t length, uint64_t timeout) {
 	return written;
 }
 
+static int uart_read_internal(int ureg, char *buffer, uint32_t length, uint64_t timeout, int some) {
+	if(!UartHasInit)
+		return -1;
+
+	if(ureg > 4)
+		return -1; // Invalid ureg
+
+	if(UARTs[ureg].mode != UART_POLL_MODE)
+		return -1; // unhandled uart mode
+
+	if(UARTRings[ureg].enabled)
+		return uart_read_ring(ureg, buffer, length, timeout, some);
+	else
+		return uart_read_poll(ureg, buffer, length, timeout, some);
+}
+
+int uart_read(int ureg, char *buffer, uint32_t length, uint64_t timeout) {
+	return uart_read_internal(ureg, buffer, length, timeout, FALSE);
+}
+
+int uart_read_some(int ureg, char *buffer, uint32_t length, uint64_t timeout) {
+	return uart_read_internal(ureg, buffer, length, timeout, TRUE);
+}
+
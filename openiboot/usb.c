@@ -8,6 +8,7 @@
 #include "clock.h"
 #include "interrupt.h"
 #include "openiboot-asmhelpers.h"
+#include "dma.h"
 
 static void change_state(USBState new_state);
 
@@ -38,10 +39,33 @@ static USBConfiguration* configurations;
 static uint8_t* controlSendBuffer = NULL;
 static uint8_t* controlRecvBuffer = NULL;
 
-static RingBuffer* txQueue = NULL;
+// IN endpoints that are programmed and waiting for their turn at the shared
+// non-periodic FIFO, one bit each. Control and interrupt endpoints always go
+// first so console replies never wait behind a stream; bulk endpoints take
+// turns after that.
+static uint32_t txPendingUrgent;
+static uint32_t txPendingBulk;
+static uint8_t lastBulkSent;
+
+// The head of each queue is on the wire. Transfers bigger than one DEPTSIZ
+// programming can describe go out in chunks chained from the completion
+// interrupt, and the endpoint handler only runs once the whole transfer is done.
+static USBTransferQueue inTransfers[USB_NUM_ENDPOINTS];
+static USBTransferQueue outTransfers[USB_NUM_ENDPOINTS];
 
 static USBEnumerateHandler enumerateHandler;
 static USBStartHandler startHandler;
+static USBClassRequestHandler classRequestHandler = NULL;
+
+static uint8_t interfaceClass = OPENIBOOT_INTERFACE_CLASS;
+static uint8_t interfaceSubClass = OPENIBOOT_INTERFACE_SUBCLASS;
+static uint8_t interfaceProtocol = OPENIBOOT_INTERFACE_PROTOCOL;
+
+static uint8_t deviceClass = 0;
+static uint8_t deviceSubClass = 0;
+static uint8_t deviceProtocol = 0;
+
+static int outReceived[USB_NUM_ENDPOINTS];
 
 static void usbIRQHandler(uint32_t token);
 
@@ -77,12 +101,14 @@ static void handleRxInterrupts(int endpoint);
 
 static int advanceTxQueue();
 
-static RingBuffer* createRingBuffer(int size);
-static int8_t ringBufferDequeue(RingBuffer* buffer);
-static int8_t ringBufferEnqueue(RingBuffer* buffer, uint8_t value);
+static void queueTx(int endpoint, USBTransferType transferType);
 
 static void usbTxRx(int endpoint, USBDirection direction, USBTransferType transferType, void* buffer, int bufferLen);
 
+static void queueTransfer(int endpoint, USBDirection direction, USBTransferType transferType, void* buffer, int bufferLen);
+static int transferDone(int endpoint, USBDirection direction);
+static void nextTransfer(int endpoint, USBDirection direction);
+
 int usb_setup() {
 	int i;
 
@@ -112,10 +138,12 @@ int usb_setup() {
 				endpoint_directions[i] = USBOut;
 				break;
 		}
-		bufferPrintf("EP %d: %d\r\n", i, endpoint_directions[i]);
+		LogDebug(LogUSB, "EP %d: %d\r\n", i, endpoint_directions[i]);
 	}
 
 	memset(endpoint_handlers, 0, sizeof(endpoint_handlers));
+	memset(inTransfers, 0, sizeof(inTransfers));
+	memset(outTransfers, 0, sizeof(outTransfers));
 
 	// Set up the hardware
 	clock_gate_switch(USB_OTGCLOCKGATE, ON);
@@ -177,7 +205,12 @@ int usb_setup() {
 	SET_REG(USB + DIEPMSK, USB_EPINT_NONE);
 	SET_REG(USB + DOEPMSK, USB_EPINT_NONE);
 
+#ifndef NO_USB_FIQ
+	interrupt_install_fiq(USB_INTERRUPT, usbIRQHandler, 0);
+#else
 	interrupt_install(USB_INTERRUPT, usbIRQHandler, 0);
+	interrupt_set_priority(USB_INTERRUPT, USB_INTERRUPT_PRIORITY);
+#endif
 
 	usb_inited = TRUE;
 
@@ -188,17 +221,17 @@ int usb_start(USBEnumerateHandler hEnumerate, USBStartHandler hStart) {
 	enumerateHandler = hEnumerate;
 	startHandler = hStart;
 	currentlySending = 0xFF;
-
-	if(txQueue == NULL)
-		txQueue = createRingBuffer(TX_QUEUE_LEN);
+	txPendingUrgent = 0;
+	txPendingBulk = 0;
+	lastBulkSent = 0;
 
 	initializeDescriptors();
 
 	if(controlSendBuffer == NULL)
-		controlSendBuffer = memalign(DMA_ALIGN, CONTROL_SEND_BUFFER_LEN);
+		controlSendBuffer = dma_coherent_alloc(CONTROL_SEND_BUFFER_LEN);
 
 	if(controlRecvBuffer == NULL)
-		controlRecvBuffer = memalign(DMA_ALIGN, CONTROL_RECV_BUFFER_LEN);
+		controlRecvBuffer = dma_coherent_alloc(CONTROL_RECV_BUFFER_LEN);
 
 	SET_REG(USB + GAHBCFG, GAHBCFG_DMAEN | GAHBCFG_BSTLEN_INCR8 | GAHBCFG_MASKINT);
 	SET_REG(USB + GUSBCFG, GUSBCFG_PHYIF16BIT | GUSBCFG_SRPENABLE | GUSBCFG_HNPENABLE | ((5 & GUSBCFG_TURNAROUND_MASK) << GUSBCFG_TURNAROUND_SHIFT));
@@ -242,26 +275,36 @@ int usb_start(USBEnumerateHandler hEnumerate, USBStartHandler hStart) {
 }
 
 static void receiveControl(void* buffer, int bufferLen) {
-	CleanAndInvalidateCPUDataCache();
+	// setup packets can come in back to back, anywhere in the buffer
+	if(!dma_coherent_contains(buffer))
+		InvalidateDataCacheRange(buffer, CONTROL_RECV_BUFFER_LEN);
 	receive(USB_CONTROLEP, USBControl, buffer, USB_MAX_PACKETSIZE, bufferLen);
 }
 
-static void usbTxRx(int endpoint, USBDirection direction, USBTransferType transferType, void* buffer, int bufferLen) {
-	int packetLength;
-
+static int packetLengthFor(USBTransferType transferType) {
 	if(transferType == USBControl || transferType == USBInterrupt) {
-		packetLength = USB_MAX_PACKETSIZE;
+		return USB_MAX_PACKETSIZE;
 	} else {
-		packetLength = packetsizeFromSpeed(usb_speed);
+		return packetsizeFromSpeed(usb_speed);
 	}
+}
 
-	CleanAndInvalidateCPUDataCache();
+static void usbTxRx(int endpoint, USBDirection direction, USBTransferType transferType, void* buffer, int bufferLen) {
+	int packetLength = packetLengthFor(transferType);
+
+	// buffers from dma_coherent_alloc need no maintenance at all
+	int coherent = dma_coherent_contains(buffer);
 
 	if(direction == USBOut) {
+		if(!coherent)
+			InvalidateDataCacheRange(buffer, bufferLen);
 		receive(endpoint, transferType, buffer, packetLength, bufferLen);
 		return;
 	}
 
+	if(!coherent)
+		CleanDataCacheRange(buffer, bufferLen);
+
 	if(GNPTXFSTS_GET_TXQSPCAVAIL(GET_REG(USB + GNPTXFSTS)) == 0) {
 		// no space available
 		return;
@@ -280,8 +323,8 @@ static void usbTxRx(int endpoint, USBDirection direction, USBTransferType transf
 	}
 
 	int packetCount = bufferLen / packetLength;
-	if((bufferLen % packetLength) != 0)
-		++packetCount;
+	if((bufferLen % packetLength) != 0 || bufferLen == 0)
+		++packetCount;	// a zero length transfer is still one packet
 
 
 	InEPRegs[endpoint].transferSize = ((packetCount & DEPTSIZ_PKTCNT_MASK) << DEPTSIZ_PKTCNT_SHIFT)
@@ -329,6 +372,13 @@ static int resetUSB() {
 	SET_REG(USB + DOEPMSK, USB_EPINT_XferCompl | USB_EPINT_SetUp | USB_EPINT_Back2BackSetup);
 	SET_REG(USB + DIEPMSK, USB_EPINT_XferCompl | USB_EPINT_AHBErr | USB_EPINT_TimeOUT);
 
+	// whatever was in flight is gone with the reset
+	memset(inTransfers, 0, sizeof(inTransfers));
+	memset(outTransfers, 0, sizeof(outTransfers));
+	txPendingUrgent = 0;
+	txPendingBulk = 0;
+	currentlySending = 0xFF;
+
 	receiveControl(controlRecvBuffer, sizeof(USBSetupPacket));
 
 	return 0;
@@ -369,18 +419,22 @@ static void callEndpointHandlers() {
 	int endpoint;
 	for(endpoint = 0; endpoint < USB_NUM_ENDPOINTS; endpoint++) {
 		if((status & ((1 << endpoint) << DAINTMSK_OUT_SHIFT)) == ((1 << endpoint) << DAINTMSK_OUT_SHIFT)) {
-			if((outInterruptStatus[endpoint] & USB_EPINT_XferCompl) == USB_EPINT_XferCompl) {
+			if((outInterruptStatus[endpoint] & USB_EPINT_XferCompl) == USB_EPINT_XferCompl
+					&& transferDone(endpoint, USBOut)) {
 				if(endpoint_handlers[endpoint].out.handler != NULL) {
 					endpoint_handlers[endpoint].out.handler(endpoint_handlers[endpoint].out.token);
 				}
+				nextTransfer(endpoint, USBOut);
 			}
 		}
 
 		if((status & ((1 << endpoint) << DAINTMSK_IN_SHIFT)) == ((1 << endpoint) << DAINTMSK_IN_SHIFT)) {
-			if((inInterruptStatus[endpoint] & USB_EPINT_XferCompl) == USB_EPINT_XferCompl) {
+			if((inInterruptStatus[endpoint] & USB_EPINT_XferCompl) == USB_EPINT_XferCompl
+					&& transferDone(endpoint, USBIn)) {
 				if(endpoint_handlers[endpoint].in.handler != NULL) {
 					endpoint_handlers[endpoint].in.handler(endpoint_handlers[endpoint].in.token);
 				}
+				nextTransfer(endpoint, USBIn);
 			}
 		}
 
@@ -424,7 +478,6 @@ static void handleTxInterrupts(int endpoint) {
 		InEPRegs[endpoint].interrupt = USB_EPINT_TimeOUT;
 		//uartPrintf("\t\tUSB_EPINT_TimeOUT\r\n");
 		currentlySending = 0xFF;
-		//ringBufferDequeue(txQueue);
 	}
 
 	if((inInterruptStatus[endpoint] & USB_EPINT_AHBErr) == USB_EPINT_AHBErr) {
@@ -479,7 +532,7 @@ static void handleRxInterrupts(int endpoint) {
 
 static void sendControl(void* buffer, int bufferLen) {
 	usbTxRx(USB_CONTROLEP, USBIn, USBControl, buffer, bufferLen);
-	ringBufferEnqueue(txQueue, USB_CONTROLEP);
+	queueTx(USB_CONTROLEP, USBControl);
 	advanceTxQueue();
 }
 
@@ -488,24 +541,114 @@ static void stallControl(void) {
 }
 
 void usb_send_bulk(uint8_t endpoint, void* buffer, int bufferLen) {
-	usbTxRx(endpoint, USBIn, USBBulk, buffer, bufferLen);
-	ringBufferEnqueue(txQueue, endpoint);
-	advanceTxQueue();
+	queueTransfer(endpoint, USBIn, USBBulk, buffer, bufferLen);
 }
 
 void usb_send_interrupt(uint8_t endpoint, void* buffer, int bufferLen) {
-	usbTxRx(endpoint, USBIn, USBInterrupt, buffer, bufferLen);
-	ringBufferEnqueue(txQueue, endpoint);
-	advanceTxQueue();
+	queueTransfer(endpoint, USBIn, USBInterrupt, buffer, bufferLen);
 }
 
 
 void usb_receive_bulk(uint8_t endpoint, void* buffer, int bufferLen) {
-	usbTxRx(endpoint, USBOut, USBBulk, buffer, bufferLen);
+	queueTransfer(endpoint, USBOut, USBBulk, buffer, bufferLen);
 }
 
 void usb_receive_interrupt(uint8_t endpoint, void* buffer, int bufferLen) {
-	usbTxRx(endpoint, USBOut, USBInterrupt, buffer, bufferLen);
+	queueTransfer(endpoint, USBOut, USBInterrupt, buffer, bufferLen);
+}
+
+int usb_received_length(uint8_t endpoint) {
+	return outReceived[endpoint];
+}
+
+static USBTransferQueue* transferQueue(int endpoint, USBDirection direction) {
+	return (direction == USBIn) ? &inTransfers[endpoint] : &outTransfers[endpoint];
+}
+
+// The most one programming of DEPTSIZ can move, in whole packets so that
+// only the last chunk of a transfer can end in a short packet.
+static int maxChunk(int packetLength) {
+	int packets = DEPTSIZ_PKTCNT_MASK;
+	if((packets * packetLength) > DEPTSIZ_XFERSIZ_MASK)
+		packets = DEPTSIZ_XFERSIZ_MASK / packetLength;
+
+	return packets * packetLength;
+}
+
+static void startTransfer(int endpoint, USBDirection direction) {
+	USBTransferQueue* queue = transferQueue(endpoint, direction);
+	USBTransfer* transfer = &queue->transfers[queue->head];
+	int left = transfer->length - transfer->done;
+	int max = maxChunk(packetLengthFor(transfer->type));
+
+	transfer->chunk = (left > max) ? max : left;
+	queue->started = TRUE;
+
+	usbTxRx(endpoint, direction, transfer->type, transfer->buffer + transfer->done, transfer->chunk);
+	if(direction == USBIn) {
+		queueTx(endpoint, transfer->type);
+		advanceTxQueue();
+	}
+}
+
+static void queueTransfer(int endpoint, USBDirection direction, USBTransferType transferType, void* buffer, int bufferLen) {
+	USBTransferQueue* queue = transferQueue(endpoint, direction);
+
+	EnterCriticalSection();
+	if(queue->count == USB_TRANSFER_QUEUE_LEN) {
+		LeaveCriticalSection();
+		bufferPrintf("usb: transfer queue full on endpoint %d\r\n", endpoint);
+		return;
+	}
+
+	USBTransfer* transfer = &queue->transfers[(queue->head + queue->count) % USB_TRANSFER_QUEUE_LEN];
+	transfer->buffer = (uint8_t*) buffer;
+	transfer->length = bufferLen;
+	transfer->done = 0;
+	transfer->chunk = 0;
+	transfer->type = transferType;
+	queue->count++;
+
+	if(!queue->started)
+		startTransfer(endpoint, direction);
+	LeaveCriticalSection();
+}
+
+// Called on XferCompl. Either programs the next chunk and returns FALSE, or
+// retires the transfer at the head of the queue. Control transfers never go
+// through the queues and always count as done.
+static int transferDone(int endpoint, USBDirection direction) {
+	USBTransferQueue* queue = transferQueue(endpoint, direction);
+	if(!queue->started)
+		return TRUE;
+
+	USBTransfer* transfer = &queue->transfers[queue->head];
+	int moved = transfer->chunk;
+	if(direction == USBOut)
+		moved -= OutEPRegs[endpoint].transferSize & DEPTSIZ_XFERSIZ_MASK;
+
+	transfer->done += moved;
+
+	// a short packet ends an OUT transfer early
+	if(transfer->done < transfer->length && moved == transfer->chunk) {
+		startTransfer(endpoint, direction);
+		return FALSE;
+	}
+
+	if(direction == USBOut)
+		outReceived[endpoint] = transfer->done;
+
+	queue->head = (queue->head + 1) % USB_TRANSFER_QUEUE_LEN;
+	queue->count--;
+	queue->started = FALSE;
+	return TRUE;
+}
+
+// The handler may already have started a transfer of its own.
+static void nextTransfer(int endpoint, USBDirection direction) {
+	USBTransferQueue* queue = transferQueue(endpoint, direction);
+	if(queue->count > 0 && !queue->started)
+		startTransfer(endpoint, direction);
 }
 
 
@@ -516,7 +659,27 @@ static int advanceTxQueue() {
 		return -1;
 	}
 
-	int8_t nextEP = ringBufferDequeue(txQueue);
+	int nextEP = -1;
+	int i;
+	if(txPendingUrgent != 0) {
+		for(i = 0; i < USB_NUM_ENDPOINTS; i++) {
+			if(txPendingUrgent & (1 << i)) {
+				nextEP = i;
+				txPendingUrgent &= ~(1 << i);
+				break;
+			}
+		}
+	} else if(txPendingBulk != 0) {
+		for(i = 1; i <= USB_NUM_ENDPOINTS; i++) {
+			int ep = (lastBulkSent + i) % USB_NUM_ENDPOINTS;
+			if(txPendingBulk & (1 << ep)) {
+				nextEP = lastBulkSent = ep;
+				txPendingBulk &= ~(1 << ep);
+				break;
+			}
+		}
+	}
+
 	if(nextEP < 0) {
 		LeaveCriticalSection();
 		return -1;
@@ -575,7 +738,7 @@ static void usbIRQHandler(uint32_t token) {
 
 		if((status & GINTMSK_RESET) == GINTMSK_RESET) {
 			if(usb_state < USBError) {
-				bufferPrintf("usb: reset detected\r\n");
+				LogDebug(LogUSB, "usb: reset detected\r\n");
 				change_state(USBPowered);
 			}
 
@@ -584,7 +747,7 @@ static void usbIRQHandler(uint32_t token) {
 			SET_REG(USB + GINTSTS, GINTMSK_RESET);
 
 			if(retval) {
-				bufferPrintf("usb: listening for further usb events\r\n");
+				LogDebug(LogUSB, "usb: listening for further usb events\r\n");
 				return;	
 			}
 
@@ -604,7 +767,15 @@ static void usbIRQHandler(uint32_t token) {
 				uint16_t length;
 				uint32_t totalLength;
 				USBStringDescriptor* strDesc;
-				if(USBSetupPacketRequestTypeType(setupPacket->bmRequestType) != USBSetupPacketVendor) {
+				if(USBSetupPacketRequestTypeType(setupPacket->bmRequestType) == USBSetupPacketClass && classRequestHandler != NULL) {
+					int ret = classRequestHandler(setupPacket, controlSendBuffer);
+					if(ret < 0)
+						stallControl();
+					else
+						sendControl(controlSendBuffer, (ret > setupPacket->wLength) ? setupPacket->wLength : ret);
+
+					receiveControl(controlRecvBuffer, sizeof(USBSetupPacket));
+				} else if(USBSetupPacketRequestTypeType(setupPacket->bmRequestType) != USBSetupPacketVendor) {
 					switch(setupPacket->bRequest) {
 						case USB_GET_DESCRIPTOR:
 							length = setupPacket->wLength;
@@ -728,9 +899,9 @@ static void create_descriptors() {
 		deviceDescriptor.bLength = sizeof(USBDeviceDescriptor);
 		deviceDescriptor.bDescriptorType = USBDeviceDescriptorType;
 		deviceDescriptor.bcdUSB = USB_2_0;
-		deviceDescriptor.bDeviceClass = 0;
-		deviceDescriptor.bDeviceSubClass = 0;
-		deviceDescriptor.bDeviceProtocol = 0;
+		deviceDescriptor.bDeviceClass = deviceClass;
+		deviceDescriptor.bDeviceSubClass = deviceSubClass;
+		deviceDescriptor.bDeviceProtocol = deviceProtocol;
 		deviceDescriptor.bMaxPacketSize = USB_MAX_PACKETSIZE;
 		deviceDescriptor.idVendor = 0x525;
 		deviceDescriptor.idProduct = PRODUCT_IPHONE;
@@ -742,9 +913,9 @@ static void create_descriptors() {
 
 		deviceQualifierDescriptor.bDescriptorType = USBDeviceDescriptorType;
 		deviceQualifierDescriptor.bcdUSB = USB_2_0;
-		deviceQualifierDescriptor.bDeviceClass = 0;
-		deviceQualifierDescriptor.bDeviceSubClass = 0;
-		deviceQualifierDescriptor.bDeviceProtocol = 0;
+		deviceQualifierDescriptor.bDeviceClass = deviceClass;
+		deviceQualifierDescriptor.bDeviceSubClass = deviceSubClass;
+		deviceQualifierDescriptor.bDeviceProtocol = deviceProtocol;
 		deviceDescriptor.bMaxPacketSize = USB_MAX_PACKETSIZE;
 		deviceDescriptor.bNumConfigurations = 0;
 
@@ -767,7 +938,7 @@ static void setConfiguration(int i) {
 	for(j = 0; j < configurations[i].descriptor.bNumInterfaces; j++) {
 		int8_t k;
 		for(k = 0; k < configurations[i].interfaces[j].descriptor.bNumEndpoints; k++) {
-			int endpoint = configurations[i].interfaces[j].endpointDescriptors[k].bEndpointAddress & 0x3;
+			int endpoint = configurations[i].interfaces[j].endpointDescriptors[k].bEndpointAddress & 0xF;
 			if((configurations[i].interfaces[j].endpointDescriptors[k].bEndpointAddress & (0x1 << 7)) == (0x1 << 7)) {
 				InEPRegs[endpoint].control = InEPRegs[endpoint].control | DCTL_SETD0PID;
 			} else {
@@ -792,6 +963,8 @@ static uint32_t getConfigurationTree(int i, uint8_t speed_id, void* buffer) {
 	for(j = 0; j < configurations[i].descriptor.bNumInterfaces; j++) {
 		memcpy(buf + pos, &configurations[i].interfaces[j].descriptor, sizeof(USBInterfaceDescriptor));
 		pos += sizeof(USBInterfaceDescriptor);
+		memcpy(buf + pos, configurations[i].interfaces[j].classDescriptors, configurations[i].interfaces[j].classDescriptorsLength);
+		pos += configurations[i].interfaces[j].classDescriptorsLength;
 		int8_t k;
 		for(k = 0; k < configurations[i].interfaces[j].descriptor.bNumEndpoints; k++) {
 			memcpy(buf + pos, &configurations[i].interfaces[j].endpointDescriptors[k], sizeof(USBEndpointDescriptor));
@@ -805,7 +978,7 @@ static uint32_t getConfigurationTree(int i, uint8_t speed_id, void* buffer) {
 USBConfigurationDescriptor* usb_get_configuration_descriptor(int index, uint8_t speed_id) {
 	if(index == 0 && configurations[0].interfaces == NULL) {
 		USBInterface* interface = addInterfaceDescriptor(&configurations[0], 0, 0,
-			OPENIBOOT_INTERFACE_CLASS, OPENIBOOT_INTERFACE_SUBCLASS, OPENIBOOT_INTERFACE_PROTOCOL, addStringDescriptor("IF0"));
+			interfaceClass, interfaceSubClass, interfaceProtocol, addStringDescriptor("IF0"));
 
 		enumerateHandler(interface);
 		endConfiguration(&configurations[0]);
@@ -825,6 +998,21 @@ void usb_add_endpoint(USBInterface* interface, int endpoint, USBDirection direct
 	}
 }
 
+USBInterface* usb_add_interface(uint8_t bInterfaceClass, uint8_t bInterfaceSubClass, uint8_t bInterfaceProtocol) {
+	char name[8];
+	uint8_t number = configurations[0].descriptor.bNumInterfaces;
+
+	sprintf(name, "IF%d", number);
+	return addInterfaceDescriptor(&configurations[0], number, 0,
+		bInterfaceClass, bInterfaceSubClass, bInterfaceProtocol, addStringDescriptor(name));
+}
+
+void usb_add_class_descriptor(USBInterface* interface, const void* descriptor, int length) {
+	interface->classDescriptors = (uint8_t*) realloc(interface->classDescriptors, interface->classDescriptorsLength + length);
+	memcpy(interface->classDescriptors + interface->classDescriptorsLength, descriptor, length);
+	interface->classDescriptorsLength += length;
+}
+
 static void initializeDescriptors() {
 	numStringDescriptors = 0;
 	stringDescriptors = NULL;
@@ -846,6 +1034,7 @@ static void releaseConfigurations() {
 		int8_t j;
 		for(j = 0; j < configurations[i].descriptor.bNumInterfaces; j++) {
 			free(configurations[i].interfaces[j].endpointDescriptors);
+			free(configurations[i].interfaces[j].classDescriptors);
 		}
 		free(configurations[i].interfaces);
 	}
@@ -879,7 +1068,8 @@ static void endConfiguration(USBConfiguration* configuration) {
 
 	int i;
 	for(i = 0; i < configurations->descriptor.bNumInterfaces; i++) {
-		configuration->descriptor.wTotalLength += sizeof(USBInterfaceDescriptor) + (configuration->interfaces[i].descriptor.bNumEndpoints * sizeof(USBEndpointDescriptor));
+		configuration->descriptor.wTotalLength += sizeof(USBInterfaceDescriptor) + configuration->interfaces[i].classDescriptorsLength
+			+ (configuration->interfaces[i].descriptor.bNumEndpoints * sizeof(USBEndpointDescriptor));
 	}
 }
 
@@ -898,6 +1088,8 @@ static USBInterface* addInterfaceDescriptor(USBConfiguration* configuration, uin
 	configuration->interfaces[newIndex].descriptor.iInterface = iInterface;
 	configuration->interfaces[newIndex].descriptor.bNumEndpoints = 0;
 	configuration->interfaces[newIndex].endpointDescriptors = NULL;
+	configuration->interfaces[newIndex].classDescriptors = NULL;
+	configuration->interfaces[newIndex].classDescriptorsLength = 0;
 
 	return &configuration->interfaces[newIndex];
 }
@@ -1000,7 +1192,25 @@ int usb_install_ep_handler(int endpoint, USBDirection direction, USBEndpointHand
 	return 0;
 }
 
+void usb_set_interface_class(uint8_t bInterfaceClass, uint8_t bInterfaceSubClass, uint8_t bInterfaceProtocol) {
+	interfaceClass = bInterfaceClass;
+	interfaceSubClass = bInterfaceSubClass;
+	interfaceProtocol = bInterfaceProtocol;
+}
+
+void usb_set_device_class(uint8_t bDeviceClass, uint8_t bDeviceSubClass, uint8_t bDeviceProtocol) {
+	deviceClass = bDeviceClass;
+	deviceSubClass = bDeviceSubClass;
+	deviceProtocol = bDeviceProtocol;
+}
+
+void usb_set_class_request_handler(USBClassRequestHandler handler) {
+	classRequestHandler = handler;
+}
+
 int usb_shutdown() {
+	interrupt_disable(USB_INTERRUPT);
+
 	power_ctrl(POWER_USB, ON);
 	clock_gate_switch(USB_OTGCLOCKGATE, ON);
 	clock_gate_switch(USB_PHYCLOCKGATE, ON);
@@ -1020,11 +1230,17 @@ int usb_shutdown() {
 	releaseConfigurations();
 	releaseStringDescriptors();
 
+	// the next usb_setup starts over as the OpenIBoot interface
+	usb_set_interface_class(OPENIBOOT_INTERFACE_CLASS, OPENIBOOT_INTERFACE_SUBCLASS, OPENIBOOT_INTERFACE_PROTOCOL);
+	usb_set_device_class(0, 0, 0);
+	classRequestHandler = NULL;
+	usb_inited = FALSE;
+
 	return 0;
 }
 
 static void change_state(USBState new_state) {
-	bufferPrintf("USB state change: %d -> %d\r\n", usb_state, new_state);
+	LogDebug(LogUSB, "USB state change: %d -> %d\r\n", usb_state, new_state);
 	usb_state = new_state;
 	if(usb_state == USBConfigured) {
 		// TODO: set to host powered
@@ -1032,58 +1248,13 @@ static void change_state(USBState new_state) {
 }
 
 
-static RingBuffer* createRingBuffer(int size) {
-	RingBuffer* buffer;
-	buffer = (RingBuffer*) malloc(sizeof(RingBuffer));
-	buffer->bufferStart = (int8_t*) memalign(DMA_ALIGN, size);
-	buffer->bufferEnd = buffer->bufferStart + size;
-	buffer->size = size;
-	buffer->count = 0;
-	buffer->readPtr = buffer->bufferStart;
-	buffer->writePtr = buffer->bufferStart;
-
-	return buffer;
-}
-
-static int8_t ringBufferDequeue(RingBuffer* buffer) {
+static void queueTx(int endpoint, USBTransferType transferType) {
 	EnterCriticalSection();
-	if(buffer->count == 0) {
-		LeaveCriticalSection();
-		return -1;
-	}
-
-	int8_t value = *buffer->readPtr;
-	buffer->readPtr++;
-	buffer->count--;
-
-	if(buffer->readPtr == buffer->bufferEnd) {
-		buffer->readPtr = buffer->bufferStart;
-	}
-
-	//uartPrintf("queue(dequeue): %d %x %x %x %x\r\n", buffer->count, buffer->readPtr, buffer->writePtr, buffer->bufferStart, buffer->bufferEnd);
+	if(transferType == USBBulk)
+		txPendingBulk |= 1 << endpoint;
+	else
+		txPendingUrgent |= 1 << endpoint;
 	LeaveCriticalSection();
-	return value;
-}
-
-static int8_t ringBufferEnqueue(RingBuffer* buffer, uint8_t value) {
-	EnterCriticalSection();
-	if(buffer->count == buffer->size) {
-		LeaveCriticalSection();
-		return -1;
-	}
-
-	*buffer->writePtr = value;
-	buffer->writePtr++;
-	buffer->count++;
-
-	if(buffer->writePtr == buffer->bufferEnd) {
-		buffer->writePtr = buffer->bufferStart;
-	}
-
-	//uartPrintf("queue(enqueue): %d %x %x %x %x\r\n", buffer->count, buffer->readPtr, buffer->writePtr, buffer->bufferStart, buffer->bufferEnd);
-	LeaveCriticalSection();
-
-	return value;
 }
 
 USBSpeed usb_get_speed() {
@@ -0,0 +1,191 @@
+#include "openiboot.h"
+#include "usbacm.h"
+#include "usb.h"
+#include "util.h"
+#include "nvram.h"
+#include "openiboot-asmhelpers.h"
+
+#define USBACM_VAR "opib-usb-console"
+
+static int Enabled = -1;
+
+static uint8_t* TxBuffer = NULL;
+static uint8_t* RxBuffer = NULL;
+static uint32_t RxSize;
+
+static volatile int Configured = FALSE;
+static volatile int TxBusy = FALSE;
+
+// Typed characters are echoed back ahead of the scrollback, since terminals
+// leave that to the other end.
+static char Echo[64];
+static int EchoLength = 0;
+
+static char Line[USBACM_LINE_MAX];
+static int LineLength = 0;
+
+static USBACMLineCoding LineCoding = { 115200, 0, 0, 8 };
+
+// Sends whatever is waiting, unless something already is on its way. From a
+// critical section.
+static void txNext() {
+	uint32_t length;
+	uint32_t pending;
+
+	if(!Configured || TxBusy)
+		return;
+
+	memcpy(TxBuffer, Echo, EchoLength);
+	length = EchoLength;
+	EchoLength = 0;
+
+	pending = getScrollbackLen();
+	if(pending > (USBACM_TX_SIZE - length))
+		pending = USBACM_TX_SIZE - length;
+
+	if(pending > 0) {
+		bufferFlush((char*) TxBuffer + length, pending);
+		length += pending;
+	}
+
+	if(length == 0)
+		return;
+
+	TxBusy = TRUE;
+	usb_send_bulk(USBACM_DATA_IN, TxBuffer, length);
+}
+
+static void scrollbackChanged() {
+	EnterCriticalSection();
+	txNext();
+	LeaveCriticalSection();
+}
+
+static void echo(const char* text, int length) {
+	if((EchoLength + length) > sizeof(Echo))
+		return;
+
+	memcpy(Echo + EchoLength, text, length);
+	EchoLength += length;
+}
+
+static void typed(char c) {
+	if(c == '\r' || c == '\n') {
+		// a CR LF pair is one line, not an empty one after it
+		if(LineLength == 0 && c == '\n')
+			return;
+
+		echo("\r\n", 2);
+		Line[LineLength] = '\0';
+		if(LineLength > 0)
+			queueConsoleCommand(Line);
+		LineLength = 0;
+	} else if(c == '\b' || c == 0x7F) {
+		if(LineLength > 0) {
+			LineLength--;
+			echo("\b \b", 3);
+		}
+	} else if(LineLength < (USBACM_LINE_MAX - 1)) {
+		Line[LineLength++] = c;
+		echo(&c, 1);
+	}
+}
+
+static void dataReceived(uint32_t token) {
+	int length = usb_received_length(USBACM_DATA_OUT);
+	int i;
+
+	EnterCriticalSection();
+	for(i = 0; i < length; i++)
+		typed(RxBuffer[i]);
+
+	txNext();
+	LeaveCriticalSection();
+
+	usb_receive_bulk(USBACM_DATA_OUT, RxBuffer, RxSize);
+}
+
+static void dataSent(uint32_t token) {
+	EnterCriticalSection();
+	TxBusy = FALSE;
+	txNext();
+	LeaveCriticalSection();
+}
+
+static void enumerateHandler(USBInterface* interface) {
+	USBACMFunctionalDescriptors functional = {
+		{ sizeof(functional.header), USBACM_CS_INTERFACE, USBACM_HEADER, 0x0110 },
+		{ sizeof(functional.callManagement), USBACM_CS_INTERFACE, USBACM_CALL_MANAGEMENT, 0x00, 1 },
+		{ sizeof(functional.abstractControl), USBACM_CS_INTERFACE, USBACM_ABSTRACT_CONTROL, 0x02 },
+		{ sizeof(functional.unionFunction), USBACM_CS_INTERFACE, USBACM_UNION, 0, 1 }
+	};
+
+	usb_add_class_descriptor(interface, &functional, sizeof(functional));
+	usb_add_endpoint(interface, USBACM_NOTIFY, USBIn, USBInterrupt);
+
+	interface = usb_add_interface(USBACM_DATA_CLASS, 0, 0);
+	usb_add_endpoint(interface, USBACM_DATA_IN, USBIn, USBBulk);
+	usb_add_endpoint(interface, USBACM_DATA_OUT, USBOut, USBBulk);
+}
+
+static void startHandler() {
+	RxSize = (usb_get_speed() == USBHighSpeed) ? 512 : 64;
+
+	EnterCriticalSection();
+	Configured = TRUE;
+	TxBusy = FALSE;
+	LineLength = 0;
+	EchoLength = 0;
+	LeaveCriticalSection();
+
+	usb_receive_bulk(USBACM_DATA_OUT, RxBuffer, RxSize);
+	scrollbackChanged();
+}
+
+static int classRequest(USBSetupPacket* setupPacket, uint8_t* buffer) {
+	switch(setupPacket->bRequest) {
+		case USBACM_REQUEST_GET_LINE_CODING:
+			memcpy(buffer, &LineCoding, sizeof(LineCoding));
+			return sizeof(LineCoding);
+
+		case USBACM_REQUEST_SET_LINE_CODING:
+			// there is no UART behind it, so the rate and framing mean nothing
+		case USBACM_REQUEST_SET_CONTROL_LINE_STATE:
+		case USBACM_REQUEST_SEND_BREAK:
+			return 0;
+	}
+
+	return -1;
+}
+
+int usbacm_enabled() {
+	if(Enabled < 0) {
+		const char* var = nvram_getvar(USBACM_VAR);
+		Enabled = (var && strcmp(var, "acm") == 0);
+	}
+
+	return Enabled;
+}
+
+void usbacm_set_enabled(int enabled) {
+	Enabled = enabled;
+}
+
+void usbacm_start() {
+	if(TxBuffer == NULL)
+		TxBuffer = malloc_dma(USBACM_TX_SIZE);
+
+	if(RxBuffer == NULL)
+		RxBuffer = malloc_dma(512);
+
+	Configured = FALSE;
+
+	usb_setup();
+	usb_install_ep_handler(USBACM_DATA_IN, USBIn, dataSent, 0);
+	usb_install_ep_handler(USBACM_DATA_OUT, USBOut, dataReceived, 0);
+	usb_set_device_class(USBACM_CDC_CLASS, 0, 0);
+	usb_set_interface_class(USBACM_CDC_CLASS, USBACM_ACM_SUBCLASS, 0);
+	usb_set_class_request_handler(classRequest);
+	usb_start(enumerateHandler, startHandler);
+	setScrollbackHandler(scrollbackChanged);
+}
@@ -0,0 +1,113 @@
+#include "openiboot.h"
+#include "usbaudio.h"
+#include "usb.h"
+#include "util.h"
+#include "tasks.h"
+#include "timer.h"
+#include "wmcodec.h"
+
+// How often the send waits look for a bus reset or STOP
+#define USBAUDIO_POLL 100000
+
+// Bumped on every SET_CONFIGURATION, like usbmsc. A send that was waiting
+// for the host when it came is given up on.
+static volatile uint32_t Generation;
+static volatile int Stopped;
+static volatile int Sending;
+static Completion InDone;
+
+static uint32_t PeriodsSent;
+
+static void dataSent(uint32_t token) {
+	completion_signal(&InDone);
+}
+
+static void enumerateHandler(USBInterface* interface) {
+	usb_add_endpoint(interface, USBAUDIO_ENDPOINT, USBIn, USBBulk);
+}
+
+static void startHandler() {
+	Generation++;
+}
+
+static int classRequest(USBSetupPacket* setupPacket, uint8_t* buffer) {
+	USBAudioStatus* status = (USBAudioStatus*) buffer;
+
+	switch(setupPacket->bRequest) {
+		case USBAUDIO_REQUEST_STATUS:
+			status->rate = 44100;
+			status->channels = 2;
+			status->bits = 16;
+			status->periodSize = AUDIO_CAPTURE_PERIOD;
+			status->periodsSent = PeriodsSent;
+			status->overruns = audiohw_capture_overruns();
+			return sizeof(USBAudioStatus);
+
+		case USBAUDIO_REQUEST_STOP:
+			Stopped = TRUE;
+			return 0;
+	}
+
+	return -1;
+}
+
+// From the capture task, with each period as it fills. It goes out from
+// where the DMA put it and has to be gone before the ring comes back round,
+// so periods are only dropped while there is no host to send them to.
+static void periodCaptured(void* buffer, uint32_t size, void* opaque) {
+	uint32_t generation = Generation;
+
+	if(Stopped || generation == 0)
+		return;
+
+	Sending = TRUE;
+	completion_init(&InDone);
+	usb_send_bulk(USBAUDIO_ENDPOINT, buffer, size);
+
+	while(completion_wait(&InDone, USBAUDIO_POLL) != 0) {
+		if(Stopped || generation != Generation) {
+			Sending = FALSE;
+			return;
+		}
+	}
+
+	PeriodsSent++;
+	Sending = FALSE;
+}
+
+int usbaudio_run(uint32_t seconds) {
+	Generation = 0;
+	Stopped = FALSE;
+	Sending = FALSE;
+	PeriodsSent = 0;
+
+	// the console must not send notifications on endpoints that are gone
+	setScrollbackHandler(NULL);
+	usb_shutdown();
+
+	usb_setup();
+	usb_install_ep_handler(USBAUDIO_ENDPOINT, USBIn, dataSent, 0);
+	usb_set_interface_class(USBAUDIO_INTERFACE_CLASS, USBAUDIO_INTERFACE_SUBCLASS, USBAUDIO_INTERFACE_PROTOCOL);
+	usb_set_class_request_handler(classRequest);
+	usb_start(enumerateHandler, startHandler);
+
+	if(audiohw_capture_stream(periodCaptured, NULL) != 0) {
+		bufferPrintf("usbaudio: could not start capturing\r\n");
+		Stopped = TRUE;
+	}
+
+	uint64_t startTime = timer_get_system_microtime();
+	while(!Stopped && (seconds == 0 || !has_elapsed(startTime, (uint64_t)seconds * 1000000)))
+		task_sleep(USBAUDIO_POLL);
+
+	Stopped = TRUE;
+	audiohw_capture_end();
+	while(Sending)
+		task_yield();
+
+	usb_shutdown();
+	startUSB();
+
+	bufferPrintf("usbaudio: sent %d periods of %d bytes, %d lost\r\n", PeriodsSent, AUDIO_CAPTURE_PERIOD, audiohw_capture_overruns());
+	return 0;
+}
@@ -0,0 +1,424 @@
+#ifndef NO_HFS
+
+#include "openiboot.h"
+#include "usbmsc.h"
+#include "usb.h"
+#include "util.h"
+#include "tasks.h"
+#include "nand.h"
+#include "ftl.h"
+#include "hfs/bdev.h"
+#include "hardware/s5l8900.h"
+
+// How often the waits below look for a bus reset or an eject.
+#define USBMSC_POLL 100000
+
+static USBMSCCommandBlockWrapper* CBW = NULL;
+static USBMSCCommandStatusWrapper* CSW = NULL;
+static uint8_t* Buffers[2] = { NULL, NULL };
+
+static uint32_t BlockSize;
+static uint32_t BlockCount;
+static int ReadOnly;
+static volatile int Ejected;
+
+// Bumped on every SET_CONFIGURATION. Whatever command was in progress is
+// given up on, since the transfers it was waiting for are gone.
+static volatile uint32_t Generation;
+static Completion Configured;
+static Completion InDone;
+static Completion OutDone;
+
+static uint8_t SenseKey;
+static uint8_t SenseASC;
+static uint8_t SenseASCQ;
+
+static uint32_t Transferred;
+
+static void dataSent(uint32_t token) {
+	completion_signal(&InDone);
+}
+
+static void dataReceived(uint32_t token) {
+	completion_signal(&OutDone);
+}
+
+static void enumerateHandler(USBInterface* interface) {
+	usb_add_endpoint(interface, 1, USBIn, USBBulk);
+	usb_add_endpoint(interface, 2, USBOut, USBBulk);
+}
+
+static void startHandler() {
+	Generation++;
+	completion_signal(&Configured);
+}
+
+static int classRequest(USBSetupPacket* setupPacket, uint8_t* buffer) {
+	switch(setupPacket->bRequest) {
+		case USBMSC_REQUEST_RESET:
+			// Nothing is ever stalled, so the endpoints are still in step
+			// with the commands. A host that gives up on one resets the port.
+			return 0;
+
+		case USBMSC_REQUEST_GET_MAX_LUN:
+			buffer[0] = 0;
+			return 1;
+	}
+
+	return -1;
+}
+
+static int waitFor(Completion* completion, uint32_t generation) {
+	while(completion_wait(completion, USBMSC_POLL) != 0) {
+		if(generation != Generation)
+			return FALSE;
+	}
+
+	return TRUE;
+}
+
+static void send(void* buffer, uint32_t len) {
+	completion_init(&InDone);
+	usb_send_bulk(1, buffer, len);
+}
+
+static void receive(void* buffer, uint32_t len) {
+	completion_init(&OutDone);
+	usb_receive_bulk(2, buffer, len);
+}
+
+static uint32_t be32(const uint8_t* p) {
+	return (p[0] << 24) | (p[1] << 16) | (p[2] << 8) | p[3];
+}
+
+static void putBE32(uint8_t* p, uint32_t value) {
+	p[0] = value >> 24;
+	p[1] = value >> 16;
+	p[2] = value >> 8;
+	p[3] = value;
+}
+
+static int fail(uint8_t key, uint8_t asc, uint8_t ascq) {
+	SenseKey = key;
+	SenseASC = asc;
+	SenseASCQ = ascq;
+	return USBMSC_CSW_FAILED;
+}
+
+// Sends a response of len bytes, cut down to what the host asked for. When
+// the response comes up short on a packet boundary a zero length packet
+// ends the data stage, so the host is never left waiting.
+static int sendResponse(uint32_t len, uint32_t generation) {
+	uint32_t packetSize = (usb_get_speed() == USBHighSpeed) ? 512 : 64;
+
+	if(len > CBW->dataLength)
+		len = CBW->dataLength;
+
+	send(Buffers[0], len);
+	if(!waitFor(&InDone, generation))
+		return FALSE;
+
+	Transferred += len;
+	if(len < CBW->dataLength && len != 0 && (len % packetSize) == 0) {
+		send(Buffers[0], 0);
+		return waitFor(&InDone, generation);
+	}
+
+	return TRUE;
+}
+
+// Throws away whatever the host sends along with a command that failed.
+static int discardData(uint32_t generation) {
+	uint32_t left = CBW->dataLength - Transferred;
+	while(left > 0) {
+		uint32_t chunk = (left > USBMSC_BUFFER_SIZE) ? USBMSC_BUFFER_SIZE : left;
+		receive(Buffers[0], chunk);
+		if(!waitFor(&OutDone, generation))
+			return FALSE;
+
+		left -= chunk;
+	}
+
+	return TRUE;
+}
+
+static int readBlocks(uint32_t lba, uint32_t count, uint32_t generation) {
+	uint64_t offset = (uint64_t)lba * BlockSize;
+	uint32_t left = count * BlockSize;
+	int status = USBMSC_CSW_PASSED;
+	int inFlight = FALSE;
+	int cur = 0;
+
+	while(left > 0) {
+		uint32_t chunk = (left > USBMSC_BUFFER_SIZE) ? USBMSC_BUFFER_SIZE : left;
+
+		// the other buffer is still going out while this one fills
+		if(status == USBMSC_CSW_PASSED && !bdev_read(offset, chunk, Buffers[cur])) {
+			bufferPrintf("usbmsc: read error at block %d\r\n", (uint32_t)(offset / BlockSize));
+			status = fail(SCSI_SENSE_MEDIUM_ERROR, 0x11, 0x00);
+		}
+
+		// the host still expects every byte, so an error is padded out
+		if(status != USBMSC_CSW_PASSED)
+			memset(Buffers[cur], 0, chunk);
+
+		if(inFlight && !waitFor(&InDone, generation))
+			return -1;
+
+		send(Buffers[cur], chunk);
+		inFlight = TRUE;
+		Transferred += chunk;
+		offset += chunk;
+		left -= chunk;
+		cur ^= 1;
+	}
+
+	if(inFlight && !waitFor(&InDone, generation))
+		return -1;
+
+	return status;
+}
+
+static int writeBlocks(uint32_t lba, uint32_t count, uint32_t generation) {
+	uint64_t offset = (uint64_t)lba * BlockSize;
+	uint32_t left = count * BlockSize;
+	uint32_t chunk = (left > USBMSC_BUFFER_SIZE) ? USBMSC_BUFFER_SIZE : left;
+	int status = USBMSC_CSW_PASSED;
+	int cur = 0;
+
+	if(left > 0)
+		receive(Buffers[cur], chunk);
+
+	while(left > 0) {
+		if(!waitFor(&OutDone, generation))
+			return -1;
+
+		Transferred += chunk;
+		left -= chunk;
+
+		// start on the next chunk while this one goes to NAND
+		uint32_t next = (left > USBMSC_BUFFER_SIZE) ? USBMSC_BUFFER_SIZE : left;
+		if(left > 0)
+			receive(Buffers[cur ^ 1], next);
+
+		if(status == USBMSC_CSW_PASSED && !bdev_write(offset, chunk, Buffers[cur])) {
+			bufferPrintf("usbmsc: write error at block %d\r\n", (uint32_t)(offset / BlockSize));
+			status = fail(SCSI_SENSE_MEDIUM_ERROR, 0x0C, 0x00);
+		}
+
+		offset += chunk;
+		chunk = next;
+		cur ^= 1;
+	}
+
+	return status;
+}
+
+// Returns the CSW status, or -1 if the command was cut off by a reset.
+static int processCommand(uint32_t generation) {
+	uint8_t* cb = CBW->cb;
+	uint8_t* response = Buffers[0];
+	uint32_t lba;
+	uint32_t count;
+
+	switch(cb[0]) {
+		case SCSITestUnitReady:
+			if(Ejected)
+				return fail(SCSI_SENSE_NOT_READY, 0x3A, 0x00);
+			return USBMSC_CSW_PASSED;
+
+		case SCSIRequestSense:
+			memset(response, 0, 18);
+			response[0] = 0x70;
+			response[2] = SenseKey;
+			response[7] = 10;
+			response[12] = SenseASC;
+			response[13] = SenseASCQ;
+			SenseKey = SenseASC = SenseASCQ = 0;
+			return sendResponse(18, generation) ? USBMSC_CSW_PASSED : -1;
+
+		case SCSIInquiry:
+			if(cb[1] & 0x1)
+				return fail(SCSI_SENSE_ILLEGAL_REQUEST, 0x24, 0x00);
+
+			memset(response, 0, 36);
+			response[1] = 0x80;	// removable, so that ejecting hands the port back
+			response[2] = 0x04;
+			response[3] = 0x02;
+			response[4] = 36 - 5;
+			memcpy(response + 8, "Apple   ", 8);
+			memcpy(response + 16, "OpenIBoot NAND  ", 16);
+			memcpy(response + 32, "0.1 ", 4);
+			return sendResponse(36, generation) ? USBMSC_CSW_PASSED : -1;
+
+		case SCSIModeSense6:
+			memset(response, 0, 4);
+			response[0] = 3;
+			response[2] = ReadOnly ? 0x80 : 0;
+			return sendResponse(4, generation) ? USBMSC_CSW_PASSED : -1;
+
+		case SCSIModeSense10:
+			memset(response, 0, 8);
+			response[1] = 6;
+			response[3] = ReadOnly ? 0x80 : 0;
+			return sendResponse(8, generation) ? USBMSC_CSW_PASSED : -1;
+
+		case SCSIStartStopUnit:
+			// LoEj without Start
+			if((cb[4] & 0x3) == 0x2)
+				Ejected = TRUE;
+			return USBMSC_CSW_PASSED;
+
+		case SCSIPreventAllowMediumRemoval:
+			return USBMSC_CSW_PASSED;
+
+		case SCSIReadFormatCapacities:
+			memset(response, 0, 12);
+			response[3] = 8;
+			putBE32(response + 4, BlockCount);
+			putBE32(response + 8, BlockSize);
+			response[8] = 0x02;	// formatted media
+			return sendResponse(12, generation) ? USBMSC_CSW_PASSED : -1;
+
+		case SCSIReadCapacity10:
+			putBE32(response, BlockCount - 1);
+			putBE32(response + 4, BlockSize);
+			return sendResponse(8, generation) ? USBMSC_CSW_PASSED : -1;
+
+		case SCSIRead10:
+		case SCSIWrite10:
+			lba = be32(cb + 2);
+			count = (cb[7] << 8) | cb[8];
+
+			if(lba >= BlockCount || count > (BlockCount - lba))
+				return fail(SCSI_SENSE_ILLEGAL_REQUEST, 0x21, 0x00);
+
+			if(((uint64_t)count * BlockSize) != CBW->dataLength)
+				return USBMSC_CSW_PHASE_ERROR;
+
+			if(cb[0] == SCSIRead10)
+				return readBlocks(lba, count, generation);
+
+			if(ReadOnly)
+				return fail(SCSI_SENSE_DATA_PROTECT, 0x27, 0x00);
+
+			return writeBlocks(lba, count, generation);
+
+		case SCSIVerify10:
+			return USBMSC_CSW_PASSED;
+
+		case SCSISynchronizeCache10:
+			if(!bdev_flush())
+				return fail(SCSI_SENSE_MEDIUM_ERROR, 0x0C, 0x00);
+			return USBMSC_CSW_PASSED;
+	}
+
+	return fail(SCSI_SENSE_ILLEGAL_REQUEST, 0x20, 0x00);
+}
+
+// Handles one CBW. Returns FALSE if the bus was reset along the way.
+static int handleCommand(uint32_t generation) {
+	receive(CBW, sizeof(USBMSCCommandBlockWrapper));
+	if(!waitFor(&OutDone, generation))
+		return FALSE;
+
+	if(CBW->signature != USBMSC_CBW_SIGNATURE) {
+		bufferPrintf("usbmsc: bad CBW signature %x\r\n", CBW->signature);
+		return TRUE;
+	}
+
+	Transferred = 0;
+	int status = processCommand(generation);
+	if(status < 0)
+		return FALSE;
+
+	// finish the data stage the host expects before giving it the status
+	if(Transferred < CBW->dataLength) {
+		if(CBW->flags & USBMSC_CBW_DATA_IN) {
+			if(!sendResponse(0, generation))
+				return FALSE;
+		} else if(!discardData(generation)) {
+			return FALSE;
+		}
+	}
+
+	CSW->signature = USBMSC_CSW_SIGNATURE;
+	CSW->tag = CBW->tag;
+	CSW->residue = CBW->dataLength - Transferred;
+	CSW->status = status;
+
+	send(CSW, sizeof(USBMSCCommandStatusWrapper));
+	return waitFor(&InDone, generation);
+}
+
+static void releaseBuffers() {
+	free(CBW);
+	free(CSW);
+	free(Buffers[0]);
+	free(Buffers[1]);
+	CBW = NULL;
+	CSW = NULL;
+	Buffers[0] = Buffers[1] = NULL;
+}
+
+int usbmsc_run(int readOnly) {
+	bdev_setup();
+	if(!HasFTLInit) {
+		bufferPrintf("usbmsc: FTL is not available\r\n");
+		return -1;
+	}
+
+	NANDData* geometry = nand_get_geometry();
+	BlockSize = geometry->bytesPerPage;
+	BlockCount = geometry->userPagesTotal - 1;	// FTL_Read refuses the last page
+	ReadOnly = readOnly;
+
+	CBW = (USBMSCCommandBlockWrapper*) memalign(DMA_ALIGN, 512);
+	CSW = (USBMSCCommandStatusWrapper*) memalign(DMA_ALIGN, 512);
+	Buffers[0] = (uint8_t*) malloc_dma(USBMSC_BUFFER_SIZE);
+	Buffers[1] = (uint8_t*) malloc_dma(USBMSC_BUFFER_SIZE);
+	if(CBW == NULL || CSW == NULL || Buffers[0] == NULL || Buffers[1] == NULL) {
+		bufferPrintf("usbmsc: out of memory\r\n");
+		releaseBuffers();
+		return -1;
+	}
+
+	bufferPrintf("usbmsc: exporting %d blocks of %d bytes%s, eject the disk on the host to finish\r\n",
+			BlockCount, BlockSize, readOnly ? " read-only" : "");
+
+	Ejected = FALSE;
+	Generation = 0;
+	SenseKey = SenseASC = SenseASCQ = 0;
+	completion_init(&Configured);
+
+	// the console must not send notifications on endpoints that are gone
+	setScrollbackHandler(NULL);
+	usb_shutdown();
+
+	usb_setup();
+	usb_install_ep_handler(1, USBIn, dataSent, 0);
+	usb_install_ep_handler(2, USBOut, dataReceived, 0);
+	usb_set_interface_class(USBMSC_INTERFACE_CLASS, USBMSC_INTERFACE_SUBCLASS, USBMSC_INTERFACE_PROTOCOL);
+	usb_set_class_request_handler(classRequest);
+	usb_start(enumerateHandler, startHandler);
+
+	while(!Ejected) {
+		if(completion_wait(&Configured, USBMSC_POLL) != 0)
+			continue;
+
+		uint32_t generation = Generation;
+		while(!Ejected && handleCommand(generation));
+	}
+
+	bdev_flush();
+	ftl_sync();
+
+	usb_shutdown();
+	releaseBuffers();
+	startUSB();
+
+	bufferPrintf("usbmsc: disk ejected\r\n");
+	return 0;
+}
+
+#endif
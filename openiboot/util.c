@@ -12,27 +12,98 @@ void __assert(const char* file, int line, const char* m) {
 
 void abort() {
 	bufferPrintf("openiboot ABORT!!\r\n");
+	uart_flush(0);
 	while(TRUE);
 }
 
 void panic() {
 	bufferPrintf("openiboot PANIC!!\r\n");
+	uart_flush(0);
 	while(TRUE);
 }
 
+// The C files are built as Thumb, where LDM/STM can only use the low registers,
+// so the bulk loops move 16 bytes per burst through r3-r6.
+#ifdef __arm__
+#define BURST_COPY16(d, s) \
+	__asm__ __volatile__("ldmia %1!, {r3, r4, r5, r6}\n\tstmia %0!, {r3, r4, r5, r6}" \
+		: "+l"(d), "+l"(s) : : "r3", "r4", "r5", "r6", "memory")
+#define BURST_FILL16(d, v) \
+	__asm__ __volatile__("mov r3, %1\n\tmov r4, %1\n\tmov r5, %1\n\tmov r6, %1\n\tstmia %0!, {r3, r4, r5, r6}" \
+		: "+l"(d) : "l"(v) : "r3", "r4", "r5", "r6", "cc", "memory")
+#else
+#define BURST_COPY16(d, s) do { (d)[0] = (s)[0]; (d)[1] = (s)[1]; (d)[2] = (s)[2]; (d)[3] = (s)[3]; (d) += 4; (s) += 4; } while(0)
+#define BURST_FILL16(d, v) do { (d)[0] = (v); (d)[1] = (v); (d)[2] = (v); (d)[3] = (v); (d) += 4; } while(0)
+#endif
+
 void* memset(void* x, int fill, uint32_t size) {
-	uint32_t i;
-	for(i = 0; i < size; i++) {
-		((uint8_t*)x)[i] = (uint8_t) fill;
+	uint8_t* d = (uint8_t*) x;
+
+	while(size > 0 && (((uint32_t)d) & 0x3) != 0) {
+		*d++ = (uint8_t) fill;
+		size--;
+	}
+
+	if(size >= 4) {
+		uint32_t* dw = (uint32_t*) d;
+		uint32_t pattern = (uint8_t) fill;
+		pattern |= pattern << 8;
+		pattern |= pattern << 16;
+
+		while(size >= 16) {
+			BURST_FILL16(dw, pattern);
+			size -= 16;
+		}
+
+		while(size >= 4) {
+			*dw++ = pattern;
+			size -= 4;
+		}
+
+		d = (uint8_t*) dw;
+	}
+
+	while(size > 0) {
+		*d++ = (uint8_t) fill;
+		size--;
 	}
+
 	return x;
 }
 
 void* memcpy(void* dest, const void* src, uint32_t size) {
-	uint32_t i;
-	for(i = 0; i < size; i++) {
-		((uint8_t*)dest)[i] = ((uint8_t*)src)[i];
+	uint8_t* d = (uint8_t*) dest;
+	const uint8_t* s = (const uint8_t*) src;
+
+	// word copies only work if both sides can be brought to the same alignment
+	if(((((uint32_t)d) ^ ((uint32_t)s)) & 0x3) == 0) {
+		while(size > 0 && (((uint32_t)d) & 0x3) != 0) {
+			*d++ = *s++;
+			size--;
+		}
+
+		uint32_t* dw = (uint32_t*) d;
+		const uint32_t* sw = (const uint32_t*) s;
+
+		while(size >= 16) {
+			BURST_COPY16(dw, sw);
+			size -= 16;
+		}
+
+		while(size >= 4) {
+			*dw++ = *sw++;
+			size -= 4;
+		}
+
+		d = (uint8_t*) dw;
+		s = (const uint8_t*) sw;
+	}
+
+	while(size > 0) {
+		*d++ = *s++;
+		size--;
 	}
+
 	return dest;
 }
 
@@ -102,39 +173,74 @@ char* strcpy(char* dst, const char* src) {
 }
 
 int memcmp(const void* s1, const void* s2, uint32_t size) {
-	uint32_t i;
 	const uint8_t* a = s1;
 	const uint8_t* b = s2;
-	for(i = 0; i < size; i++) {
-		if(a[i] == b[i])
-			continue;
 
-		if(a[i] < b[i])
-			return -1;
+	// skip over the matching prefix a word at a time, then find the differing byte
+	if(((((uint32_t)a) ^ ((uint32_t)b)) & 0x3) == 0) {
+		while(size > 0 && (((uint32_t)a) & 0x3) != 0) {
+			if(*a != *b)
+				return (*a < *b) ? -1 : 1;
+
+			a++;
+			b++;
+			size--;
+		}
+
+		while(size >= 4 && *((const uint32_t*)a) == *((const uint32_t*)b)) {
+			a += 4;
+			b += 4;
+			size -= 4;
+		}
+	}
+
+	while(size > 0) {
+		if(*a != *b)
+			return (*a < *b) ? -1 : 1;
 
-		if(a[i] > b[i])
-			return 1;
+		a++;
+		b++;
+		size--;
 	}
 
 	return 0;
-
 }
 
-/* Adapted from public domain memmove function from  David MacKenzie <djm@gnu.ai.mit.edu>.  */
 void* memmove(void *dest, const void* src, size_t length)
 {
-	register uint8_t* myDest = dest;
-	const register uint8_t* mySrc = src;
-	if (mySrc < myDest)
-		/* Moving from low mem to hi mem; start at end.  */
-		for(src += length, myDest += length; length; --length)
-			*--myDest = *--mySrc;
-	else if (src != myDest)
-	{
-		/* Moving from hi mem to low mem; start at beginning.  */
-		for (; length; --length)
-			*myDest++ = *mySrc++;
+	uint8_t* d = dest;
+	const uint8_t* s = src;
+
+	// memcpy walks upwards, so it is safe unless dest overlaps the end of src
+	if(d <= s || d >= (s + length))
+		return memcpy(dest, src, length);
+
+	d += length;
+	s += length;
+
+	if(((((uint32_t)d) ^ ((uint32_t)s)) & 0x3) == 0) {
+		while(length > 0 && (((uint32_t)d) & 0x3) != 0) {
+			*--d = *--s;
+			length--;
+		}
+
+		uint32_t* dw = (uint32_t*) d;
+		const uint32_t* sw = (const uint32_t*) s;
+
+		while(length >= 4) {
+			*--dw = *--sw;
+			length -= 4;
+		}
+
+		d = (uint8_t*) dw;
+		s = (const uint8_t*) sw;
+	}
+
+	while(length > 0) {
+		*--d = *--s;
+		length--;
 	}
+
 	return dest;
 }
 
@@ -195,36 +301,26 @@ unsigned long int strtoul(const char* str, char** endptr, int base) {
 			str += 2;
 	}
 
-	char maxDigit;
+	// letters only count as digits up to the base, '0' to '9' always do
+	unsigned int letters = (base > 10) ? (base - 10) : 0;
+	unsigned long int result = 0;
 
-	if(base <= 10) {
-		maxDigit = '0' + base - 1;
-	} else {
-		maxDigit = 'a' + base - 11;
-	}
+	while(TRUE) {
+		unsigned int digit = (unsigned char)*str - '0';
+		if(digit > 9) {
+			unsigned int letter = ((unsigned char)*str | 0x20) - 'a';
+			if(letter >= letters)
+				break;
 
-	const char *myEndPtr = str;
-	while(*myEndPtr != '\0' && ((*myEndPtr >= '0' && *myEndPtr <= '9') || (tolower(*myEndPtr) >= 'a' && tolower(*myEndPtr) <= maxDigit))) {
-		myEndPtr++;
-	}
+			digit = 10 + letter;
+		}
 
-	if(endptr != NULL) {
-		*endptr = (char*) myEndPtr;
+		result = (result * base) + digit;
+		str++;
 	}
 
-	myEndPtr--;
-
-	unsigned long int result = 0;
-	unsigned long int currentPlace = 1;
-	while(myEndPtr >= str) {
-		if(*myEndPtr >= '0' && *myEndPtr <= '9') {
-			result += currentPlace * (*myEndPtr - '0');
-		} else if(tolower(*myEndPtr) >= 'a' && tolower(*myEndPtr) <= maxDigit) {
-			result += currentPlace * (10 + (tolower(*myEndPtr) - 'a'));
-		}
-
-		currentPlace *= base;
-		myEndPtr--;
+	if(endptr != NULL) {
+		*endptr = (char*) str;
 	}
 
 	return result;
@@ -254,15 +350,13 @@ void bytesToHex(const uint8_t* buffer, int bytes) {
 	}
 }
 
-char** tokenize(char* commandline, int* argc) {
+int tokenize_into(char* commandline, char** arguments, int maxArgs) {
 	char* pos;
-	char** arguments;
 	int curArg = 1;
 	int inQuote = FALSE;
 	int inEscape = TRUE;
 
 	pos = commandline;
-	arguments = (char**) malloc(sizeof(char*) * 10);
 	arguments[0] = commandline;
 	while(*commandline != '\0') {
 		if(pos != commandline)
@@ -279,7 +373,7 @@ char** tokenize(char* commandline, int* argc) {
 			} else {
 				inQuote = TRUE;
 			}
-		} else if(*commandline == ' ' && inQuote == FALSE) {
+		} else if(*commandline == ' ' && inQuote == FALSE && curArg < maxArgs) {
 			*pos = '\0';
 			arguments[curArg] = pos + 1;
 			if(*(commandline + 1) == '\"')
@@ -298,8 +392,15 @@ char** tokenize(char* commandline, int* argc) {
 		pos++;
 	}
 
-	*argc = curArg;
+	// escapes leave pos behind, so the end has to be marked again
+	*pos = '\0';
 
+	return curArg;
+}
+
+char** tokenize(char* commandline, int* argc) {
+	char** arguments = (char**) malloc(sizeof(char*) * TOKENIZE_MAX_ARGS);
+	*argc = tokenize_into(commandline, arguments, TOKENIZE_MAX_ARGS);
 	return arguments;
 }
 
@@ -422,75 +523,141 @@ void hexdump(uint32_t start, int length) {
 	bufferPrintf("\r\n");
 }
 
-static char* MyBuffer= NULL;
-static char* pMyBuffer = NULL;
-static size_t MyBufferLen = 0;
-
+// The scrollback is a ring with free-running head and tail indices. Producers only
+// ever advance the head and bufferFlush only ever advances the tail, so the USB side
+// can drain it without locking anybody out. Must be a power of two.
+#ifndef SCROLLBACK_LEN
 #define SCROLLBACK_LEN (1024*16)
+#endif
+
+#if (SCROLLBACK_LEN & (SCROLLBACK_LEN - 1)) != 0
+#error SCROLLBACK_LEN must be a power of two
+#endif
+
+static char* Scrollback = NULL;
+static volatile uint32_t ScrollbackHead = 0;
+static volatile uint32_t ScrollbackTail = 0;
+static uint32_t ScrollbackDropped = 0;
+static uint32_t ScrollbackDroppedPending = 0;
+
+static ScrollbackHandler scrollbackHandler = NULL;
+
+void setScrollbackHandler(ScrollbackHandler handler) {
+	scrollbackHandler = handler;
+}
+
+static int scrollbackInit() {
+	if(Scrollback == NULL)
+		Scrollback = (char*) malloc(SCROLLBACK_LEN);
+
+	return Scrollback != NULL;
+}
+
+static size_t scrollbackFree() {
+	return SCROLLBACK_LEN - (ScrollbackHead - ScrollbackTail);
+}
+
+// copy into the ring at the given position, splitting the copy where it wraps
+static void scrollbackWrite(uint32_t pos, const void* data, size_t len) {
+	uint32_t offset = pos & (SCROLLBACK_LEN - 1);
+	size_t first = SCROLLBACK_LEN - offset;
+	if(first > len)
+		first = len;
+
+	memcpy(Scrollback + offset, data, first);
+	memcpy(Scrollback, (const uint8_t*)data + first, len - first);
+}
 
 void bufferDump(uint32_t location, unsigned int len) {
+	static const uint8_t padding[0x80] = {0};
+
 	EnterCriticalSection();
-	if(pMyBuffer == NULL) {
-		MyBuffer = (char*) malloc(SCROLLBACK_LEN);
-		MyBufferLen = 0;
-		pMyBuffer = MyBuffer;
+	if(!scrollbackInit()) {
+		LeaveCriticalSection();
+		return;
 	}
 
-	memcpy(pMyBuffer, &len, sizeof(uint32_t));
-	memcpy(pMyBuffer + sizeof(uint32_t), &location, sizeof(uint32_t));
-	memcpy(pMyBuffer + sizeof(uint32_t) + sizeof(uint32_t), (void*) location, len);
 	uint32_t crc = 0;
 	crc32(&crc, (void*) location, len);
-	*((uint32_t*)(pMyBuffer + sizeof(uint32_t) + sizeof(uint32_t) + len)) = crc;
 	int totalLen = sizeof(uint32_t) + sizeof(uint32_t) + len + sizeof(uint32_t);
 	if(totalLen % 0x80 != 0) {
 		totalLen += 0x80 - (totalLen % 0x80);
 	}
-	MyBufferLen += totalLen;
-	pMyBuffer += totalLen;
+
+	if(totalLen > scrollbackFree()) {
+		ScrollbackDropped += totalLen;
+		ScrollbackDroppedPending += totalLen;
+		LeaveCriticalSection();
+		return;
+	}
+
+	uint32_t pos = ScrollbackHead;
+	scrollbackWrite(pos, &len, sizeof(uint32_t));
+	pos += sizeof(uint32_t);
+	scrollbackWrite(pos, &location, sizeof(uint32_t));
+	pos += sizeof(uint32_t);
+	scrollbackWrite(pos, (void*) location, len);
+	pos += len;
+	scrollbackWrite(pos, &crc, sizeof(uint32_t));
+	pos += sizeof(uint32_t);
+	scrollbackWrite(pos, padding, (ScrollbackHead + totalLen) - pos);
+
+	ScrollbackHead += totalLen;
 	LeaveCriticalSection();
 }
 
+// Producers are expected to be serialized by the caller, which bufferPrintf's own
+// critical section already does. Output that doesn't fit is dropped and counted, and
+// a marker noting the loss goes in ahead of the next message that fits.
 int addToBuffer(const char* toBuffer, int len) {
-	EnterCriticalSection();
-	if(pMyBuffer == NULL) {
-		MyBuffer = (char*) malloc(SCROLLBACK_LEN);
-		MyBufferLen = 0;
-		pMyBuffer = MyBuffer;
-		*pMyBuffer = '\0';
+	if(!scrollbackInit())
+		return 0;
+
+	if(ScrollbackDroppedPending > 0) {
+		char marker[48];
+		int markerLen = sprintf(marker, "\r\n[%d bytes of output dropped]\r\n", ScrollbackDroppedPending);
+		if((markerLen + len) > scrollbackFree()) {
+			ScrollbackDropped += len;
+			ScrollbackDroppedPending += len;
+			return 0;
+		}
+
+		scrollbackWrite(ScrollbackHead, marker, markerLen);
+		ScrollbackHead += markerLen;
+		ScrollbackDroppedPending = 0;
 	}
 
-	if((MyBufferLen + len) > SCROLLBACK_LEN) {
-		LeaveCriticalSection();
+	if(len > scrollbackFree()) {
+		ScrollbackDropped += len;
+		ScrollbackDroppedPending += len;
 		return 0;
 	}
 
-	MyBufferLen += len;
+	scrollbackWrite(ScrollbackHead, toBuffer, len);
 
-	if((MyBufferLen + 1) > SCROLLBACK_LEN) {
-		len -= (MyBufferLen + 1) - SCROLLBACK_LEN;
-		MyBufferLen = SCROLLBACK_LEN;
-	}
+	// only publish the new head once the data is in place
+	ScrollbackHead += len;
 
-	memcpy(pMyBuffer, toBuffer, len);
-	pMyBuffer[len] = '\0';
-	pMyBuffer += len;
-	LeaveCriticalSection();
+	if(scrollbackHandler)
+		scrollbackHandler();
 
 	return 1;
 }
 
-void bufferPrint(const char* toBuffer) {
+static void bufferPrintLen(const char* toBuffer, int len) {
 	if(UartHasInit)
-		uartPrint(toBuffer);
+		uart_write(0, toBuffer, len);
 
 	if(FramebufferHasInit)
 		framebuffer_print(toBuffer);
 
-	int len = strlen(toBuffer);
 	addToBuffer(toBuffer, len);
 }
 
+void bufferPrint(const char* toBuffer) {
+	bufferPrintLen(toBuffer, strlen(toBuffer));
+}
+
 void uartPrint(const char* toBuffer) {
 	uart_write(0, toBuffer, strlen(toBuffer));
 }
@@ -498,34 +665,43 @@ void uartPrint(const char* toBuffer) {
 void bufferPrintf(const char* format, ...) {
 	static char buffer[1000];
 	EnterCriticalSection();
-	buffer[0] = '\0';
 
 	va_list args;
 	va_start(args, format);
-	vsprintf(buffer, format, args);
+	int len = vsnprintf(buffer, sizeof(buffer), format, args);
 	va_end(args);
-	bufferPrint(buffer);
+
+	if(len >= sizeof(buffer))
+		len = sizeof(buffer) - 1;
+
+	bufferPrintLen(buffer, len);
 	LeaveCriticalSection();
 }
 
 void bufferFlush(char* destination, size_t length) {
-	EnterCriticalSection();
-	memcpy(destination, MyBuffer, length);
-	memmove(MyBuffer, MyBuffer + length, MyBufferLen - length);
-	MyBufferLen -= length;
-	pMyBuffer -= length;
-	*pMyBuffer = '\0';
-	LeaveCriticalSection();
+	uint32_t tail = ScrollbackTail;
+	size_t available = ScrollbackHead - tail;
+	if(length > available)
+		length = available;
+
+	uint32_t offset = tail & (SCROLLBACK_LEN - 1);
+	size_t first = SCROLLBACK_LEN - offset;
+	if(first > length)
+		first = length;
+
+	memcpy(destination, Scrollback + offset, first);
+	memcpy(destination + first, Scrollback, length - first);
+
+	ScrollbackTail = tail + length;
 }
 
 void uartPrintf(const char* format, ...) {
 	static char buffer[1000];
 	EnterCriticalSection();
-	buffer[0] = '\0';
 
 	va_list args;
 	va_start(args, format);
-	vsprintf(buffer, format, args);
+	vsnprintf(buffer, sizeof(buffer), format, args);
 	va_end(args);
 	uartPrint(buffer);
 	LeaveCriticalSection();
@@ -534,22 +710,44 @@ void uartPrintf(const char* format, ...) {
 void fbPrintf(const char* format, ...) {
 	static char buffer[1000];
 	EnterCriticalSection();
-	buffer[0] = '\0';
 
 	va_list args;
 	va_start(args, format);
-	vsprintf(buffer, format, args);
+	vsnprintf(buffer, sizeof(buffer), format, args);
 	va_end(args);
 	framebuffer_print(buffer);
 	LeaveCriticalSection();
 }
 
-char* getScrollback() {
-	return MyBuffer;
+uint32_t LogMask = 0;
+
+static const char* LogSubsystemNames[LogSubsystems] = {
+	"ftl", "nand", "usb", "multitouch", "sdio", "wlan", "nor", "images", "audio", "radio"
+};
+
+const char* log_subsystem_name(int subsystem) {
+	if(subsystem < 0 || subsystem >= LogSubsystems)
+		return NULL;
+
+	return LogSubsystemNames[subsystem];
+}
+
+int log_subsystem_find(const char* name) {
+	int i;
+	for(i = 0; i < LogSubsystems; i++) {
+		if(strcmp(LogSubsystemNames[i], name) == 0)
+			return i;
+	}
+
+	return -1;
 }
 
 size_t getScrollbackLen() {
-	return MyBufferLen;
+	return ScrollbackHead - ScrollbackTail;
+}
+
+uint32_t getScrollbackDropped() {
+	return ScrollbackDropped;
 }
 
 /*
@@ -563,7 +761,7 @@ size_t getScrollbackLen() {
 /* ========================================================================
  * Table of CRC-32's of all single-byte values (made by make_crc_table)
  */
-static uint64_t crc_table[256] = {
+static const uint32_t crc_table[256] = {
   0x00000000L, 0x77073096L, 0xee0e612cL, 0x990951baL, 0x076dc419L,
   0x706af48fL, 0xe963a535L, 0x9e6495a3L, 0x0edb8832L, 0x79dcb8a4L,
   0xe0d5e91eL, 0x97d2d988L, 0x09b64c2bL, 0x7eb17cbdL, 0xe7b82d07L,
@@ -620,9 +818,28 @@ static uint64_t crc_table[256] = {
 
 /* ========================================================================= */
 #define DO1(buf) crc = crc_table[((int)crc ^ (*buf++)) & 0xff] ^ (crc >> 8);
-#define DO2(buf)  DO1(buf); DO1(buf);
-#define DO4(buf)  DO2(buf); DO2(buf);
-#define DO8(buf)  DO4(buf); DO4(buf);
+
+#ifndef SMALL
+/*
+ * Slice-by-8: crc_slice[k][n] is the CRC of byte n followed by k zero bytes,
+ * so eight input bytes fold into the CRC with eight independent lookups.
+ */
+static uint32_t crc_slice[8][256];
+static int crc_slice_ready = FALSE;
+
+static void make_crc_slice()
+{
+  int n, k;
+  for (n = 0; n < 256; n++)
+    crc_slice[0][n] = crc_table[n];
+
+  for (k = 1; k < 8; k++)
+    for (n = 0; n < 256; n++)
+      crc_slice[k][n] = (crc_slice[k - 1][n] >> 8) ^ crc_table[crc_slice[k - 1][n] & 0xff];
+
+  crc_slice_ready = TRUE;
+}
+#endif
 
 /* ========================================================================= */
 uint32_t crc32(uint32_t* ckSum, const void *buffer, size_t len)
@@ -638,16 +855,32 @@ uint32_t crc32(uint32_t* ckSum, const void *buffer, size_t len)
   if (buf == NULL) return crc;
   
   crc = crc ^ 0xffffffffL;
+
+#ifndef SMALL
+  if (!crc_slice_ready)
+    make_crc_slice();
+
+  while (len && (((uint32_t)buf) & 3)) {
+    DO1(buf);
+    len--;
+  }
+
   while (len >= 8)
   {
-    DO8(buf);
+    uint32_t one = *((const uint32_t*)buf) ^ crc;
+    uint32_t two = *((const uint32_t*)(buf + 4));
+    crc = crc_slice[7][one & 0xff] ^ crc_slice[6][(one >> 8) & 0xff]
+        ^ crc_slice[5][(one >> 16) & 0xff] ^ crc_slice[4][one >> 24]
+        ^ crc_slice[3][two & 0xff] ^ crc_slice[2][(two >> 8) & 0xff]
+        ^ crc_slice[1][(two >> 16) & 0xff] ^ crc_slice[0][two >> 24];
+    buf += 8;
     len -= 8;
   }
-  if (len)
-  {
-    do {
-DO1(buf);
-    } while (--len);
+#endif
+
+  while (len) {
+    DO1(buf);
+    len--;
   }
   
   crc = crc ^ 0xffffffffL;
@@ -659,29 +892,50 @@ DO1(buf);
 }
 
 #define BASE 65521L /* largest prime smaller than 65536 */
-#define NMAX 5000  
-// NMAX (was 5521) the largest n such that 255n(n+1)/2 + (n+1)(BASE-1) <= 2^32-1
+#define NMAX 5552
+// NMAX is the largest n such that 255n(n+1)/2 + (n+1)(BASE-1) <= 2^32-1
 
 #define ADLER_DO1(buf,i)  {s1 += buf[i]; s2 += s1;}
-#define ADLER_DO2(buf,i)  ADLER_DO1(buf,i); ADLER_DO1(buf,i+1);
-#define ADLER_DO4(buf,i)  ADLER_DO2(buf,i); ADLER_DO2(buf,i+2);
-#define ADLER_DO8(buf,i)  ADLER_DO4(buf,i); ADLER_DO4(buf,i+4);
-#define ADLER_DO16(buf)   ADLER_DO8(buf,0); ADLER_DO8(buf,8);
+// one little-endian word, lowest address first
+#define ADLER_WORD(w)     {s1 += (w) & 0xff; s2 += s1; s1 += ((w) >> 8) & 0xff; s2 += s1; \
+                           s1 += ((w) >> 16) & 0xff; s2 += s1; s1 += (w) >> 24; s2 += s1;}
 
 uint32_t adler32(uint8_t *buf, int32_t len)
 {
-    unsigned long s1 = 1; // adler & 0xffff;
-    unsigned long s2 = 0; // (adler >> 16) & 0xffff;
+    return adler32_update(1, buf, len);
+}
+
+uint32_t adler32_update(uint32_t adler, const uint8_t *buf, int32_t len)
+{
+    uint32_t s1 = adler & 0xffff;
+    uint32_t s2 = (adler >> 16) & 0xffff;
     int k;
 
     while (len > 0) {
         k = len < NMAX ? len : NMAX;
         len -= k;
+
+        while (k > 0 && (((uint32_t)buf) & 3)) {
+            ADLER_DO1(buf, 0);
+            buf++;
+            k--;
+        }
+
+        // whole words, four at a time, so each byte costs a shift rather than a load
         while (k >= 16) {
-            ADLER_DO16(buf);
+            const uint32_t* words = (const uint32_t*) buf;
+            uint32_t w0 = words[0];
+            uint32_t w1 = words[1];
+            uint32_t w2 = words[2];
+            uint32_t w3 = words[3];
+            ADLER_WORD(w0);
+            ADLER_WORD(w1);
+            ADLER_WORD(w2);
+            ADLER_WORD(w3);
             buf += 16;
             k -= 16;
         }
+
         if (k != 0) do {
             s1 += *buf++;
             s2 += s1;
@@ -3,6 +3,7 @@
 #include "sdio.h"
 #include "interrupt.h"
 #include "timer.h"
+#include "tasks.h"
 #include "wlan.h"
 
 // No, I'm not really going to write a network stack here. But we're going to try to upload the firmware to
@@ -51,9 +52,18 @@
 #define CONFIGURATION_REG               0x03
 #define HOST_POWER_UP                   (0x1U << 1)
 
+// The helper takes a 4 byte length and up to 60 bytes of firmware per block
+#define WLAN_HELPER_BLOCK       64
+#define WLAN_HELPER_CHUNK       (WLAN_HELPER_BLOCK - 4)
+
+// Largest piece of a firmware request sent in one multi-block transfer
+#ifndef WLAN_FW_CHUNK
+#define WLAN_FW_CHUNK           0x4000
+#endif
 
 static uint32_t scratch_reg;
 static uint32_t ioport;
+static Completion DownloadReady;
 
 static uint16_t wlan_read_scratch(int* err)
 {
@@ -75,49 +85,73 @@ static uint16_t wlan_read_scratch(int* err)
 
 void wlan_interrupt(uint32_t token)
 {
+	int ret;
+	uint8_t cause;
+
+	cause = sdio_readb(1, IF_SDIO_H_INT_STATUS, &ret);
+	if (ret)
+		return;
+
+	// the card keeps the line asserted until its causes are cleared
+	sdio_writeb(1, ~cause, IF_SDIO_H_INT_STATUS, &ret);
+
+	if (cause & IF_SDIO_H_INT_DNLD)
+		completion_signal(&DownloadReady);
 }
 
-int wlan_prog_helper(const uint8_t * firmware, int size)
+// Sleeps until the card can take more firmware. The download interrupt does
+// the waking, with a short poll behind it in case it never comes.
+static int wlan_wait_for_download(uint32_t timeout)
 {
 	int ret;
 	uint8_t status;
+	uint64_t startTime = timer_get_system_microtime();
+
+	while (TRUE) {
+		completion_init(&DownloadReady);
+
+		status = sdio_readb(1, IF_SDIO_STATUS, &ret);
+		if (ret)
+			return ret;
+
+		if ((status & IF_SDIO_IO_RDY) &&
+				(status & IF_SDIO_DL_RDY))
+			return 0;
+
+		if(has_elapsed(startTime, timeout))
+			return -1;
+
+		completion_wait(&DownloadReady, 1000);
+	}
+}
+
+int wlan_prog_helper(const uint8_t * firmware, int size)
+{
+	int ret;
 	uint8_t *chunk_buffer;
 	uint32_t chunk_size;
 	uint64_t startTime;
 
 	bufferPrintf("wlan: programming firmware helper...\r\n");
 
-	chunk_buffer = (uint8_t*) memalign(64, 4);
+	chunk_buffer = (uint8_t*) memalign(DMA_ALIGN, WLAN_HELPER_BLOCK);
 	if (!chunk_buffer) {
 		ret = -1;
 		goto release_fw;
 	}
 
-	ret = sdio_set_block_size(1, 32);
+	// each chunk goes as a single block
+	ret = sdio_set_block_size(1, WLAN_HELPER_BLOCK);
 	if (ret)
 		goto release;
 
 	while (size) {
-		startTime = timer_get_system_microtime();
-		while (TRUE) {
-			status = sdio_readb(1, IF_SDIO_STATUS, &ret);
-			if (ret)
-				goto release;
-
-			if ((status & IF_SDIO_IO_RDY) &&
-					(status & IF_SDIO_DL_RDY))
-				break;
-
-			if(has_elapsed(startTime, 1000 * 1000)) {
-				ret = -1;
-				goto release;
-			}
-
-			udelay(1000);
-		}
+		ret = wlan_wait_for_download(1000 * 1000);
+		if (ret)
+			goto release;
 
-		if(size > 60)
-			chunk_size = 60;
+		if(size > WLAN_HELPER_CHUNK)
+			chunk_size = WLAN_HELPER_CHUNK;
 		else
 			chunk_size = size;
 
@@ -128,7 +162,7 @@ int wlan_prog_helper(const uint8_t * firmware, int size)
 		//bufferPrintf("wlan: sending %d bytes chunk\r\n", chunk_size);
 		
 		ret = sdio_writesb(1, ioport,
-				chunk_buffer, 64);
+				chunk_buffer, WLAN_HELPER_BLOCK);
 		if (ret)
 			goto release;
 
@@ -138,7 +172,7 @@ int wlan_prog_helper(const uint8_t * firmware, int size)
 
 	/* an empty block marks the end of the transfer */
 	memset(chunk_buffer, 0, 4);
-	ret = sdio_writesb(1, ioport, chunk_buffer, 64);
+	ret = sdio_writesb(1, ioport, chunk_buffer, WLAN_HELPER_BLOCK);
 	if (ret)
 		goto release;
 
@@ -165,7 +199,7 @@ int wlan_prog_helper(const uint8_t * firmware, int size)
 			goto release;
 		}
 
-		udelay(10000);
+		udelay(1000);
 	}
 
 	ret = 0;
@@ -185,7 +219,6 @@ release_fw:
 int wlan_prog_real(const uint8_t* firmware, size_t size)
 {
 	int ret;
-	uint8_t status;
 	uint8_t *chunk_buffer;
 	uint32_t chunk_size;
 	size_t req_size;
@@ -193,31 +226,20 @@ int wlan_prog_real(const uint8_t* firmware, size_t size)
 
 	bufferPrintf("wlan: programming firmware...\r\n");
 
-	chunk_buffer = (uint8_t*) memalign(512, 4);
+	chunk_buffer = (uint8_t*) memalign(DMA_ALIGN, WLAN_FW_CHUNK);
 	if (!chunk_buffer) {
 		ret = -1;
 		goto release_fw;
 	}
 	
-	ret = sdio_set_block_size(1, 32);
+	ret = sdio_set_block_size(1, IF_SDIO_BLOCK_SIZE);
 	if (ret)
 		goto release;
 
 	while (size) {
-		startTime = timer_get_system_microtime();
-		while (1) {
-			status = sdio_readb(1, IF_SDIO_STATUS, &ret);
-			if (ret)
-				goto release;
-			if ((status & IF_SDIO_IO_RDY) &&
-					(status & IF_SDIO_DL_RDY))
-				break;
-			if(has_elapsed(startTime, 1000 * 1000)) {
-				ret = -1;
-				goto release;
-			}
-			udelay(1000);
-		}
+		ret = wlan_wait_for_download(1000 * 1000);
+		if (ret)
+			goto release;
 
 		req_size = sdio_readb(1, IF_SDIO_RD_BASE, &ret);
 		if (ret)
@@ -245,22 +267,17 @@ int wlan_prog_real(const uint8_t* firmware, size_t size)
 			req_size = size;
 
 		while (req_size) {
-			if(req_size > 512)
-				chunk_size = 512;
+			if(req_size > WLAN_FW_CHUNK)
+				chunk_size = WLAN_FW_CHUNK;
 			else
 				chunk_size = req_size;
 
 			memcpy(chunk_buffer, firmware, chunk_size);
 
-			//bufferPrintf("wlan: sending %d bytes (%d bytes) chunk\r\n",
-			//   chunk_size, (chunk_size + 31) / 32 * 32);
-
+			// pad to whole blocks, so it all goes in block mode
 			int to_send;
-			to_send = chunk_size / 32;
-			to_send *= 32;
-
-			if(to_send < chunk_size)
-				to_send += 32;
+			to_send = (chunk_size + IF_SDIO_BLOCK_SIZE - 1) / IF_SDIO_BLOCK_SIZE;
+			to_send *= IF_SDIO_BLOCK_SIZE;
 
 			ret = sdio_writesb(1, ioport,
 					chunk_buffer, to_send);
@@ -294,7 +311,7 @@ int wlan_prog_real(const uint8_t* firmware, size_t size)
 			goto release;
 		}
 
-		udelay(10000);
+		udelay(1000);
 	}
 
 	ret = 0;
@@ -332,6 +349,14 @@ int wlan_setup()
 		return -1;
 	}
 
+	// only download ready is waited on, before there is firmware to talk to
+	sdio_writeb(1, IF_SDIO_H_INT_DNLD, IF_SDIO_H_INT_MASK, &ret);
+	if(ret)
+	{
+		bufferPrintf("wlan: cannot set the interrupt mask\r\n");
+		return -1;
+	}
+
 	ioport = sdio_readb(1, 0x0, &ret);
 	if(ret)
 	{
@@ -52,13 +52,13 @@ void wmcodec_write(int reg, int data)
 	buffer[0] = (reg << 1) | ((data & 0x100) >> 8);
 	buffer[1] = d;
 
-	i2c_tx(WMCODEC_I2C, WMCODEC_I2C_SLAVE_ADDR, buffer, 2);
+	// queued, so the long register runs in set up do not hold up the caller
+	i2c_tx_queued(WMCODEC_I2C, WMCODEC_I2C_SLAVE_ADDR, buffer, 2);
 }
 
 static void iis_transfer_done(int status, int controller, int channel)
 {
 	++transfersDone;
-	CleanCPUDataCache();
 	dma_finish(controller, channel, 0);
 	dma_controller = -1;
 	dma_channel = -1;
@@ -104,30 +104,26 @@ uint32_t audiohw_get_total()
 	return pcm_buffer_size;
 }
 
-void audiohw_play_pcm(const void* addr_in, uint32_t size, int use_speaker)
+// Picks the interface and DMA peripheral for the output and sets the
+// interface up for 16-bit I2S.
+static void iis_prepare(int use_speaker, uint32_t* i2sController, uint32_t* dma)
 {
-	pcm_buffer = addr_in;
-	pcm_buffer_size = size;
-
-	uint32_t i2sController;
-	uint32_t dma;
-
 #ifdef CONFIG_IPHONE
 	if(use_speaker)
 	{
-		i2sController = BB_I2S;
-		dma = DMA_BB_I2S_TX;
+		*i2sController = BB_I2S;
+		*dma = DMA_BB_I2S_TX;
 	}
 	else
 	{
 #endif
-		i2sController = WM_I2S;
-		dma = DMA_WM_I2S_TX;
+		*i2sController = WM_I2S;
+		*dma = DMA_WM_I2S_TX;
 #ifdef CONFIG_IPHONE
 	}
 #endif
 
-	SET_REG(i2sController + I2S_TXCON,
+	SET_REG(*i2sController + I2S_TXCON,
 			(1 << 24) |  /* undocumented */
 			(1 << 20) |  /* undocumented */
 			(0 << 16) |  /* burst length */
@@ -139,14 +135,39 @@ void audiohw_play_pcm(const void* addr_in, uint32_t size, int use_speaker)
 			(0 << 5) |   /* 0 = 16-bit */
 			(0 << 3) |   /* bit clock per frame */
 			(1 << 0));    /* channel index */
+}
+
+static void iis_start(uint32_t i2sController)
+{
+	SET_REG(i2sController + I2S_CLKCON, (1 << 0)); /* 1 = power on */
+	SET_REG(i2sController + I2S_TXCOM, 
+			(0 << 3) |   /* 1 = transmit mode on */
+			(1 << 2) |   /* 1 = I2S interface enable */
+			(1 << 1) |   /* 1 = DMA request enable */
+			(0 << 0));    /* 0 = LRCK on */
+}
+
+void audiohw_play_pcm(const void* addr_in, uint32_t size, int use_speaker)
+{
+	pcm_buffer = addr_in;
+	pcm_buffer_size = size;
+
+	uint32_t i2sController;
+	uint32_t dma;
+
+	iis_prepare(use_speaker, &i2sController, &dma);
 
 	int controller = 0;
 	int channel = 0;
 
 	transfersDone = 0;
 	stopTransfers = 0;
-	
-	CleanCPUDataCache();
+
+	// Only the samples need to reach RAM; the descriptors are coherent
+	CleanDataCacheRange(pcm_buffer, pcm_buffer_size);
+
+	// the codec has to be set up before the samples start
+	i2c_flush(WMCODEC_I2C);
 
 	dma_request(DMA_MEMORY, 2, 1, dma, 2, 1, &controller, &channel, iis_transfer_done);
 
@@ -155,15 +176,52 @@ void audiohw_play_pcm(const void* addr_in, uint32_t size, int use_speaker)
 	dma_controller = controller;
 	dma_channel = channel;
 
-	SET_REG(i2sController + I2S_CLKCON, (1 << 0)); /* 1 = power on */
-	SET_REG(i2sController + I2S_TXCOM, 
-			(0 << 3) |   /* 1 = transmit mode on */
-			(1 << 2) |   /* 1 = I2S interface enable */
-			(1 << 1) |   /* 1 = DMA request enable */
-			(0 << 0));    /* 0 = LRCK on */
+	iis_start(i2sController);
+}
 
-	CleanAndInvalidateCPUDataCache();
+int audiohw_play_periods(const DMASegment* periods, int count, int use_speaker, DMAHandler handler)
+{
+	uint32_t i2sController;
+	uint32_t dma;
+	int controller = 0;
+	int channel = 0;
+	int i;
+
+	iis_prepare(use_speaker, &i2sController, &dma);
+
+	pcm_buffer = (const void*) periods[0].address;
+	pcm_buffer_size = 0;
+	for(i = 0; i < count; i++)
+		pcm_buffer_size += periods[i].size;
+
+	transfersDone = 0;
+	stopTransfers = 0;
+
+	i2c_flush(WMCODEC_I2C);
+
+	dma_request(DMA_MEMORY, 2, 1, dma, 2, 1, &controller, &channel, handler);
+
+	if(dma_perform_cyclic(DMA_MEMORY, dma, periods, count, &controller, &channel) != 0)
+	{
+		dma_cancel(controller, channel);
+		return -1;
+	}
 
+	dma_controller = controller;
+	dma_channel = channel;
+
+	iis_start(i2sController);
+	return 0;
+}
+
+void audiohw_stop()
+{
+	if(dma_controller == -1)
+		return;
+
+	dma_cancel(dma_controller, dma_channel);
+	dma_controller = -1;
+	dma_channel = -1;
 }
 
 #define VOLUME_MIN -890
@@ -504,3 +562,72 @@ void audiohw_set_monitor(bool enable) {
     (void)enable;
 }
 #endif /* HAVE_RECORDING */
+
+// The ADCs and their input PGAs, on top of the outputs audiohw_preinit powers
+static void capture_power(int on)
+{
+	wmcodec_write(PWRMGMT2, on ? 0x18f : 0x180);
+}
+
+// The receive side of the codec's interface, for capture. It runs alongside
+// playback on its own DMA channel.
+static int capture_dma_controller = -1;
+static int capture_dma_channel = -1;
+
+static void iis_rx_start(uint32_t i2sController)
+{
+	SET_REG(i2sController + I2S_RXCON,
+			(1 << 24) |  /* undocumented */
+			(1 << 20) |  /* undocumented */
+			(0 << 16) |  /* burst length */
+			(0 << 15) |  /* 0 = falling edge */
+			(0 << 13) |  /* 0 = basic I2S format */
+			(0 << 12) |  /* 0 = MSB first */
+			(0 << 11) |  /* 0 = left channel for low polarity */
+			(3 << 8) |   /* MCLK divider */
+			(0 << 5) |   /* 0 = 16-bit */
+			(0 << 3) |   /* bit clock per frame */
+			(1 << 0));    /* channel index */
+
+	SET_REG(i2sController + I2S_CLKCON, (1 << 0)); /* 1 = power on */
+	SET_REG(i2sController + I2S_RXCOM,
+			(1 << 2) |   /* 1 = I2S interface enable */
+			(1 << 1));   /* 1 = DMA request enable */
+}
+
+int audiohw_capture_periods(const DMASegment* periods, int count, DMAHandler handler)
+{
+	int controller = 0;
+	int channel = 0;
+
+	audiohw_capture_stop();
+	capture_power(TRUE);
+	i2c_flush(WMCODEC_I2C);
+
+	dma_request(DMA_WM_I2S_RX, 2, 1, DMA_MEMORY, 2, 1, &controller, &channel, handler);
+
+	if(dma_perform_cyclic(DMA_WM_I2S_RX, DMA_MEMORY, periods, count, &controller, &channel) != 0)
+	{
+		dma_cancel(controller, channel);
+		capture_power(FALSE);
+		return -1;
+	}
+
+	capture_dma_controller = controller;
+	capture_dma_channel = channel;
+
+	iis_rx_start(WM_I2S);
+	return 0;
+}
+
+void audiohw_capture_stop()
+{
+	if(capture_dma_controller == -1)
+		return;
+
+	SET_REG(WM_I2S + I2S_RXCOM, 0);
+	dma_cancel(capture_dma_controller, capture_dma_channel);
+	capture_dma_controller = -1;
+	capture_dma_channel = -1;
+	capture_power(FALSE);
+}
@@ -26,6 +26,7 @@
 #include "util.h"
 #include "openiboot-asmhelpers.h"
 #include "gpio.h"
+#include "workqueue.h"
 
 const void* pcm_buffer;
 uint32_t pcm_buffer_size;
@@ -37,6 +38,9 @@ volatile static int transfersDone;
 
 volatile static int stopTransfers;
 
+// the jack status is read over I2C, so it is handled outside the interrupt
+static Work JackWork;
+
 void audiohw_preinit();
 static void switch_hp_speakers(int use_speakers);
 
@@ -57,7 +61,8 @@ void wmcodec_write(int reg, int data)
 	buffer[1] = (data >> 8) & 0xFF;
 	buffer[2] = data & 0xFF;
 
-	i2c_tx(WMCODEC_I2C, WMCODEC_I2C_SLAVE_ADDR, buffer, sizeof(buffer));
+	// queued, so the long register runs in set up do not hold up the caller
+	i2c_tx_queued(WMCODEC_I2C, WMCODEC_I2C_SLAVE_ADDR, buffer, sizeof(buffer));
 	regcache[reg] = data;
 }
 
@@ -79,7 +84,6 @@ int wmcodec_read(int reg)
 static void iis_transfer_done(int status, int controller, int channel)
 {
 	++transfersDone;
-	CleanCPUDataCache();
 	dma_finish(controller, channel, 0);
 	dma_controller = -1;
 	dma_channel = -1;
@@ -125,20 +129,15 @@ uint32_t audiohw_get_total()
 	return pcm_buffer_size;
 }
 
-void audiohw_play_pcm(const void* addr_in, uint32_t size, int use_speaker)
+// Picks the interface and DMA peripheral for the output and sets the
+// interface up for 16-bit I2S.
+static void iis_prepare(int use_speaker, uint32_t* i2sController, uint32_t* dma)
 {
-	pcm_buffer = addr_in;
-	pcm_buffer_size = size;
-
-	uint32_t i2sController;
-	uint32_t dma;
-
 	switch_hp_speakers(use_speaker);
+	*i2sController = WM_I2S;
+	*dma = DMA_WM_I2S_TX;
 
-	i2sController = WM_I2S;
-	dma = DMA_WM_I2S_TX;
-
-	SET_REG(i2sController + I2S_TXCON,
+	SET_REG(*i2sController + I2S_TXCON,
 			(1 << 24) |  /* undocumented */
 			(1 << 20) |  /* undocumented */
 			(0 << 16) |  /* burst length */
@@ -150,14 +149,39 @@ void audiohw_play_pcm(const void* addr_in, uint32_t size, int use_speaker)
 			(0 << 5) |   /* 0 = 16-bit */
 			(0 << 3) |   /* bit clock per frame */
 			(1 << 0));    /* channel index */
+}
+
+static void iis_start(uint32_t i2sController)
+{
+	SET_REG(i2sController + I2S_CLKCON, (1 << 0)); /* 1 = power on */
+	SET_REG(i2sController + I2S_TXCOM, 
+			(0 << 3) |   /* 1 = transmit mode on */
+			(1 << 2) |   /* 1 = I2S interface enable */
+			(1 << 1) |   /* 1 = DMA request enable */
+			(0 << 0));    /* 0 = LRCK on */
+}
+
+void audiohw_play_pcm(const void* addr_in, uint32_t size, int use_speaker)
+{
+	pcm_buffer = addr_in;
+	pcm_buffer_size = size;
+
+	uint32_t i2sController;
+	uint32_t dma;
+
+	iis_prepare(use_speaker, &i2sController, &dma);
 
 	int controller = 0;
 	int channel = 0;
 
 	transfersDone = 0;
 	stopTransfers = 0;
-	
-	CleanCPUDataCache();
+
+	// Only the samples need to reach RAM; the descriptors are coherent
+	CleanDataCacheRange(pcm_buffer, pcm_buffer_size);
+
+	// the codec has to be set up before the samples start
+	i2c_flush(WMCODEC_I2C);
 
 	dma_request(DMA_MEMORY, 2, 1, dma, 2, 1, &controller, &channel, iis_transfer_done);
 
@@ -166,15 +190,52 @@ void audiohw_play_pcm(const void* addr_in, uint32_t size, int use_speaker)
 	dma_controller = controller;
 	dma_channel = channel;
 
-	SET_REG(i2sController + I2S_CLKCON, (1 << 0)); /* 1 = power on */
-	SET_REG(i2sController + I2S_TXCOM, 
-			(0 << 3) |   /* 1 = transmit mode on */
-			(1 << 2) |   /* 1 = I2S interface enable */
-			(1 << 1) |   /* 1 = DMA request enable */
-			(0 << 0));    /* 0 = LRCK on */
+	iis_start(i2sController);
+}
 
-	CleanAndInvalidateCPUDataCache();
+int audiohw_play_periods(const DMASegment* periods, int count, int use_speaker, DMAHandler handler)
+{
+	uint32_t i2sController;
+	uint32_t dma;
+	int controller = 0;
+	int channel = 0;
+	int i;
+
+	iis_prepare(use_speaker, &i2sController, &dma);
+
+	pcm_buffer = (const void*) periods[0].address;
+	pcm_buffer_size = 0;
+	for(i = 0; i < count; i++)
+		pcm_buffer_size += periods[i].size;
+
+	transfersDone = 0;
+	stopTransfers = 0;
+
+	i2c_flush(WMCODEC_I2C);
+
+	dma_request(DMA_MEMORY, 2, 1, dma, 2, 1, &controller, &channel, handler);
+
+	if(dma_perform_cyclic(DMA_MEMORY, dma, periods, count, &controller, &channel) != 0)
+	{
+		dma_cancel(controller, channel);
+		return -1;
+	}
+
+	dma_controller = controller;
+	dma_channel = channel;
 
+	iis_start(i2sController);
+	return 0;
+}
+
+void audiohw_stop()
+{
+	if(dma_controller == -1)
+		return;
+
+	dma_cancel(dma_controller, dma_channel);
+	dma_controller = -1;
+	dma_channel = -1;
 }
 
 const struct sound_settings_info audiohw_settings[] = {
@@ -250,7 +311,7 @@ const struct sound_settings_info audiohw_settings[] = {
 #define PLL2		0x3D
 #define PLL3		0x3E
 
-void wm8991_int(uint32_t token)
+static void wm8991_jack_work(void* opaque)
 {
 	if(gpio_pin_state(WMCODEC_INT_GPIO) == 1)
 	{
@@ -276,6 +337,14 @@ void wm8991_int(uint32_t token)
 			wmcodec_write(GPIOCTRL1, status);
 		}
 	}
+
+	gpio_interrupt_enable(WMCODEC_INT);
+}
+
+void wm8991_int(uint32_t token)
+{
+	gpio_interrupt_disable(WMCODEC_INT);
+	work_post(&JackWork);
 }
 
 /* Silently enable / disable audio output */
@@ -423,7 +492,8 @@ void audiohw_preinit(void)
 	// R = 7.523376465
 
 	gpio_pin_use_as_input(WMCODEC_INT_GPIO);
-	gpio_register_interrupt(WMCODEC_INT, TRUE, TRUE, FALSE, wm8991_int, 0);
+	work_init(&JackWork, wm8991_jack_work, NULL);
+	gpio_register_interrupt(WMCODEC_INT, TRUE, TRUE, TRUE, wm8991_int, 0);
 	gpio_interrupt_enable(WMCODEC_INT);
 
 	bufferPrintf("wm8991: init complete.\r\n");
@@ -588,3 +658,77 @@ void audiohw_switch_normal_call(int in_call)
 		wmcodec_write(MICBIAS, 0x0);
 
 }
+
+// The ADCs, their input mixers and the LIN12 PGA the microphone is on. The
+// rest of PWRMGMT2 is left as the call routing has it.
+#define PWRMGMT2_CAPTURE ((1 << 9) | (1 << 8) | (1 << 6) | (1 << 1) | (1 << 0))
+
+static void capture_power(int on)
+{
+	i2c_flush(WMCODEC_I2C);
+	int value = wmcodec_read(PWRMGMT2);
+	wmcodec_write(PWRMGMT2, on ? (value | PWRMGMT2_CAPTURE) : (value & ~PWRMGMT2_CAPTURE));
+}
+
+// The receive side of the codec's interface, for capture. It runs alongside
+// playback on its own DMA channel.
+static int capture_dma_controller = -1;
+static int capture_dma_channel = -1;
+
+static void iis_rx_start(uint32_t i2sController)
+{
+	SET_REG(i2sController + I2S_RXCON,
+			(1 << 24) |  /* undocumented */
+			(1 << 20) |  /* undocumented */
+			(0 << 16) |  /* burst length */
+			(0 << 15) |  /* 0 = falling edge */
+			(0 << 13) |  /* 0 = basic I2S format */
+			(0 << 12) |  /* 0 = MSB first */
+			(0 << 11) |  /* 0 = left channel for low polarity */
+			(3 << 8) |   /* MCLK divider */
+			(0 << 5) |   /* 0 = 16-bit */
+			(0 << 3) |   /* bit clock per frame */
+			(1 << 0));    /* channel index */
+
+	SET_REG(i2sController + I2S_CLKCON, (1 << 0)); /* 1 = power on */
+	SET_REG(i2sController + I2S_RXCOM,
+			(1 << 2) |   /* 1 = I2S interface enable */
+			(1 << 1));   /* 1 = DMA request enable */
+}
+
+int audiohw_capture_periods(const DMASegment* periods, int count, DMAHandler handler)
+{
+	int controller = 0;
+	int channel = 0;
+
+	audiohw_capture_stop();
+	capture_power(TRUE);
+	i2c_flush(WMCODEC_I2C);
+
+	dma_request(DMA_WM_I2S_RX, 2, 1, DMA_MEMORY, 2, 1, &controller, &channel, handler);
+
+	if(dma_perform_cyclic(DMA_WM_I2S_RX, DMA_MEMORY, periods, count, &controller, &channel) != 0)
+	{
+		dma_cancel(controller, channel);
+		capture_power(FALSE);
+		return -1;
+	}
+
+	capture_dma_controller = controller;
+	capture_dma_channel = channel;
+
+	iis_rx_start(WM_I2S);
+	return 0;
+}
+
+void audiohw_capture_stop()
+{
+	if(capture_dma_controller == -1)
+		return;
+
+	SET_REG(WM_I2S + I2S_RXCOM, 0);
+	dma_cancel(capture_dma_controller, capture_dma_channel);
+	capture_dma_controller = -1;
+	capture_dma_channel = -1;
+	capture_power(FALSE);
+}
@@ -0,0 +1,271 @@
+#include "openiboot.h"
+#include "openiboot-asmhelpers.h"
+#include "wmcodec.h"
+#include "dma.h"
+#include "tasks.h"
+#include "util.h"
+
+static AudioRefillHandler StreamRefill = NULL;
+static void* StreamOpaque;
+static uint8_t* StreamBuffer = NULL;
+static DMASegment StreamPeriods[AUDIO_STREAM_PERIODS];
+static Semaphore StreamSignal;
+static int StreamTaskStarted = FALSE;
+
+// Periods are numbered from the start of the stream; period n plays from
+// buffer n % AUDIO_STREAM_PERIODS. The DMA interrupt counts them played and
+// the task counts them filled. Once the refill comes up short, StreamEnd is
+// the number of periods holding samples and the rest are filled with silence.
+static volatile uint32_t StreamPlayed;
+static uint32_t StreamFilled;
+static uint32_t StreamEnd;
+static volatile int StreamEnding;
+static uint32_t StreamUnderruns = 0;
+
+static void stream_period_done(int status, int controller, int channel)
+{
+	StreamPlayed++;
+
+	if(StreamEnding)
+	{
+		// stop before the silence after the last samples goes on for long
+		if(StreamPlayed >= StreamEnd)
+			dma_pause(controller, channel);
+	} else if(StreamPlayed >= StreamFilled)
+	{
+		StreamUnderruns++;
+	}
+
+	semaphore_signal(&StreamSignal);
+}
+
+static void stream_fill()
+{
+	uint8_t* buffer = StreamBuffer + ((StreamFilled % AUDIO_STREAM_PERIODS) * AUDIO_STREAM_PERIOD);
+	uint32_t filled = 0;
+
+	if(!StreamEnding)
+	{
+		filled = StreamRefill(buffer, AUDIO_STREAM_PERIOD, StreamOpaque);
+		if(filled > AUDIO_STREAM_PERIOD)
+			filled = AUDIO_STREAM_PERIOD;
+
+		if(filled < AUDIO_STREAM_PERIOD)
+		{
+			StreamEnd = (filled > 0) ? (StreamFilled + 1) : StreamFilled;
+			StreamEnding = TRUE;
+		}
+	}
+
+	memset(buffer + filled, 0, AUDIO_STREAM_PERIOD - filled);
+	StreamFilled++;
+}
+
+static void stream_task(void* opaque)
+{
+	while(TRUE)
+	{
+		semaphore_wait(&StreamSignal);
+
+		if(StreamRefill == NULL)
+			continue;
+
+		// the period playing now is lost already, carry on with the next
+		if(!StreamEnding && StreamFilled <= StreamPlayed)
+			StreamFilled = StreamPlayed + 1;
+
+		while(StreamFilled < (StreamPlayed + AUDIO_STREAM_PERIODS))
+			stream_fill();
+
+		if(StreamEnding && StreamPlayed >= StreamEnd)
+		{
+			audiohw_stop();
+			StreamRefill = NULL;
+			bufferPrintf("audio: playback complete\r\n");
+		}
+	}
+}
+
+int audiohw_play_stream(AudioRefillHandler refill, void* opaque, int use_speaker)
+{
+	int i;
+
+	audiohw_stop();
+	StreamRefill = NULL;
+
+	if(StreamBuffer == NULL)
+	{
+		StreamBuffer = (uint8_t*) dma_coherent_alloc(AUDIO_STREAM_PERIOD * AUDIO_STREAM_PERIODS);
+		if(StreamBuffer == NULL)
+		{
+			bufferPrintf("audio: out of coherent memory\r\n");
+			return -1;
+		}
+
+		for(i = 0; i < AUDIO_STREAM_PERIODS; i++)
+		{
+			StreamPeriods[i].address = (uint32_t)(StreamBuffer + (i * AUDIO_STREAM_PERIOD));
+			StreamPeriods[i].size = AUDIO_STREAM_PERIOD;
+		}
+	}
+
+	if(!StreamTaskStarted)
+	{
+		semaphore_init(&StreamSignal, 0);
+		if(task_create("audio", stream_task, NULL, 0) == NULL)
+		{
+			bufferPrintf("audio: could not start the stream task\r\n");
+			return -1;
+		}
+		StreamTaskStarted = TRUE;
+	}
+
+	StreamOpaque = opaque;
+	StreamPlayed = 0;
+	StreamFilled = 0;
+	StreamEnd = 0;
+	StreamEnding = FALSE;
+	StreamUnderruns = 0;
+
+	// every period has samples, or silence, before the DMA starts
+	StreamRefill = refill;
+	while(StreamFilled < AUDIO_STREAM_PERIODS)
+		stream_fill();
+
+	if(StreamEnding && StreamEnd == 0)
+	{
+		StreamRefill = NULL;
+		return -1;
+	}
+
+	if(audiohw_play_periods(StreamPeriods, AUDIO_STREAM_PERIODS, use_speaker, stream_period_done) != 0)
+	{
+		StreamRefill = NULL;
+		return -1;
+	}
+
+	return 0;
+}
+
+int audiohw_stream_active()
+{
+	return StreamRefill != NULL;
+}
+
+uint32_t audiohw_stream_underruns()
+{
+	return StreamUnderruns;
+}
+
+static AudioCaptureHandler CaptureHandler = NULL;
+static void* CaptureOpaque;
+static uint8_t* CaptureBuffer = NULL;
+static DMASegment CapturePeriods[AUDIO_CAPTURE_PERIODS];
+static Semaphore CaptureSignal;
+static int CaptureTaskStarted = FALSE;
+
+// As for playback, periods are numbered from the start of the capture and
+// period n is received into buffer n % AUDIO_CAPTURE_PERIODS. The DMA
+// interrupt counts them filled and the task counts them taken.
+static volatile uint32_t CaptureFilled;
+static uint32_t CaptureTaken;
+static uint32_t CaptureOverruns = 0;
+
+static void capture_period_done(int status, int controller, int channel)
+{
+	CaptureFilled++;
+	semaphore_signal(&CaptureSignal);
+}
+
+static void capture_task(void* opaque)
+{
+	while(TRUE)
+	{
+		semaphore_wait(&CaptureSignal);
+
+		while(CaptureHandler != NULL && CaptureTaken < CaptureFilled)
+		{
+			uint32_t filled = CaptureFilled;
+
+			// the buffer of the oldest is being received into again
+			if((filled - CaptureTaken) >= AUDIO_CAPTURE_PERIODS)
+			{
+				CaptureOverruns += filled - CaptureTaken - (AUDIO_CAPTURE_PERIODS - 1);
+				CaptureTaken = filled - (AUDIO_CAPTURE_PERIODS - 1);
+			}
+
+			uint8_t* buffer = CaptureBuffer + ((CaptureTaken % AUDIO_CAPTURE_PERIODS) * AUDIO_CAPTURE_PERIOD);
+			CaptureHandler(buffer, AUDIO_CAPTURE_PERIOD, CaptureOpaque);
+
+			// and whether it was while the handler had it
+			if((CaptureFilled - CaptureTaken) >= AUDIO_CAPTURE_PERIODS)
+				CaptureOverruns++;
+
+			CaptureTaken++;
+		}
+	}
+}
+
+int audiohw_capture_stream(AudioCaptureHandler handler, void* opaque)
+{
+	int i;
+
+	audiohw_capture_end();
+
+	if(CaptureBuffer == NULL)
+	{
+		CaptureBuffer = (uint8_t*) dma_coherent_alloc(AUDIO_CAPTURE_PERIOD * AUDIO_CAPTURE_PERIODS);
+		if(CaptureBuffer == NULL)
+		{
+			bufferPrintf("audio: out of coherent memory\r\n");
+			return -1;
+		}
+
+		for(i = 0; i < AUDIO_CAPTURE_PERIODS; i++)
+		{
+			CapturePeriods[i].address = (uint32_t)(CaptureBuffer + (i * AUDIO_CAPTURE_PERIOD));
+			CapturePeriods[i].size = AUDIO_CAPTURE_PERIOD;
+		}
+	}
+
+	if(!CaptureTaskStarted)
+	{
+		semaphore_init(&CaptureSignal, 0);
+		if(task_create("capture", capture_task, NULL, 0) == NULL)
+		{
+			bufferPrintf("audio: could not start the capture task\r\n");
+			return -1;
+		}
+		CaptureTaskStarted = TRUE;
+	}
+
+	CaptureOpaque = opaque;
+	CaptureFilled = 0;
+	CaptureTaken = 0;
+	CaptureOverruns = 0;
+	CaptureHandler = handler;
+
+	if(audiohw_capture_periods(CapturePeriods, AUDIO_CAPTURE_PERIODS, capture_period_done) != 0)
+	{
+		CaptureHandler = NULL;
+		return -1;
+	}
+
+	return 0;
+}
+
+void audiohw_capture_end()
+{
+	audiohw_capture_stop();
+	CaptureHandler = NULL;
+}
+
+int audiohw_capture_active()
+{
+	return CaptureHandler != NULL;
+}
+
+uint32_t audiohw_capture_overruns()
+{
+	return CaptureOverruns;
+}
@@ -0,0 +1,94 @@
+#include "openiboot.h"
+#include "openiboot-asmhelpers.h"
+#include "workqueue.h"
+#include "tasks.h"
+#include "util.h"
+
+static Work* WorkHead = NULL;
+static Work* WorkTail = NULL;
+static Semaphore WorkSignal;
+static int WorkQueueHasInit = FALSE;
+
+static Work* work_take() {
+	EnterCriticalSection();
+	Work* work = WorkHead;
+	if(work != NULL) {
+		WorkHead = work->next;
+		if(WorkHead == NULL)
+			WorkTail = NULL;
+
+		// from here on, posting it again runs it again
+		work->next = NULL;
+		work->queued = FALSE;
+	}
+	LeaveCriticalSection();
+
+	return work;
+}
+
+int work_run_pending() {
+	int count = 0;
+	Work* work;
+
+	while((work = work_take()) != NULL) {
+		work->routine(work->opaque);
+		count++;
+	}
+
+	return count;
+}
+
+static void workqueue_task(void* opaque) {
+	while(TRUE) {
+		semaphore_wait(&WorkSignal);
+		work_run_pending();
+	}
+}
+
+int workqueue_setup() {
+	if(WorkQueueHasInit)
+		return 0;
+
+	semaphore_init(&WorkSignal, 0);
+	if(task_create("work", workqueue_task, NULL, WORKQUEUE_STACK) == NULL) {
+		bufferPrintf("workqueue: could not start the work task\r\n");
+		return -1;
+	}
+
+	WorkQueueHasInit = TRUE;
+
+	// anything posted before there was a task to wake
+	if(WorkHead != NULL)
+		semaphore_signal(&WorkSignal);
+
+	return 0;
+}
+
+void work_init(Work* work, WorkRoutine routine, void* opaque) {
+	work->routine = routine;
+	work->opaque = opaque;
+	work->queued = FALSE;
+	work->next = NULL;
+}
+
+int work_post(Work* work) {
+	EnterCriticalSection();
+	if(work->queued) {
+		LeaveCriticalSection();
+		return FALSE;
+	}
+
+	work->queued = TRUE;
+	work->next = NULL;
+	if(WorkTail != NULL)
+		WorkTail->next = work;
+	else
+		WorkHead = work;
+	WorkTail = work;
+	LeaveCriticalSection();
+
+	if(WorkQueueHasInit)
+		semaphore_signal(&WorkSignal);
+
+	return TRUE;
+}
@@ -0,0 +1,222 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "sim.h"
+
+// Replays a trace of FTL requests against a NAND image and reports what the
+// FTL did to the flash underneath. A trace has one request per line:
+//
+//	R <logical page> <pages>	FTL_Read
+//	W <logical page> <pages>	FTL_Write
+//	S				ftl_sync
+//
+// Blank lines and lines starting with # are skipped.
+
+static int Verbose = 0;
+
+void bufferPrintf(const char* format, ...) {
+	va_list args;
+	if(!Verbose)
+		return;
+
+	va_start(args, format);
+	vprintf(format, args);
+	va_end(args);
+}
+
+// Fills in the next request from either kind of trace. Returns 0 at the end.
+// lineNumber counts lines, or entries of a binary trace, for the messages.
+static int next_request(FILE* trace, int binary, int* lineNumber, char* op, unsigned int* page, unsigned int* pages) {
+	char line[256];
+
+	if(binary) {
+		SimTraceEntry entry;
+		while(fread(&entry, sizeof(entry), 1, trace) == 1) {
+			(*lineNumber)++;
+			if(entry.operation != SIM_TRACE_FTL_READ && entry.operation != SIM_TRACE_FTL_WRITE)
+				continue;
+
+			*op = (entry.operation == SIM_TRACE_FTL_READ) ? 'R' : 'W';
+			*page = entry.address;
+			*pages = entry.count;
+			return 1;
+		}
+
+		return 0;
+	}
+
+	while(fgets(line, sizeof(line), trace)) {
+		(*lineNumber)++;
+		*page = 0;
+		*pages = 0;
+		if(sscanf(line, " %c %u %u", op, page, pages) < 1 || *op == '#')
+			continue;
+
+		return 1;
+	}
+
+	return 0;
+}
+
+static void usage(const char* name) {
+	fprintf(stderr, "Usage: %s [-v] [-w] [-b] [-g banks,blocks,pages,sectors,spare,userSuBlks] [-c read,program,erase,transfer] <nand image> <trace>\n", name);
+	fprintf(stderr, "\t-v\tshow the FTL's own messages\n");
+	fprintf(stderr, "\t-w\twrite the changes back into the image\n");
+	fprintf(stderr, "\t-b\tthe trace is a binary I/O trace fetched from the device\n");
+	fprintf(stderr, "\t-g\tgeometry of the image (default 8,4096,128,4,64,3872)\n");
+	fprintf(stderr, "\t-c\tsimulated cost of each NAND operation in us (default %u,%u,%u,%u)\n",
+			SimCost.read, SimCost.program, SimCost.erase, SimCost.transferPerPage);
+}
+
+int main(int argc, char* argv[]) {
+	SimGeometry geometry = {8, 4096, 128, 4, 64, 3872};
+	int writeBack = 0;
+	int binary = 0;
+	int opt;
+
+	while((opt = getopt(argc, argv, "vwbg:c:")) != -1) {
+		switch(opt) {
+			case 'v':
+				Verbose = 1;
+				break;
+			case 'w':
+				writeBack = 1;
+				break;
+			case 'b':
+				binary = 1;
+				break;
+			case 'g':
+				if(sscanf(optarg, "%u,%u,%u,%u,%u,%u", &geometry.banks, &geometry.blocksPerBank, &geometry.pagesPerBlock,
+							&geometry.sectorsPerPage, &geometry.bytesPerSpare, &geometry.userSuBlksTotal) != 6) {
+					usage(argv[0]);
+					return 1;
+				}
+				break;
+			case 'c':
+				if(sscanf(optarg, "%u,%u,%u,%u", &SimCost.read, &SimCost.program, &SimCost.erase, &SimCost.transferPerPage) != 4) {
+					usage(argv[0]);
+					return 1;
+				}
+				break;
+			default:
+				usage(argv[0]);
+				return 1;
+		}
+	}
+
+	if((argc - optind) < 2) {
+		usage(argv[0]);
+		return 1;
+	}
+
+	int fd = open(argv[optind], writeBack ? O_RDWR : O_RDONLY);
+	if(fd < 0) {
+		perror(argv[optind]);
+		return 1;
+	}
+
+	struct stat st;
+	unsigned long long size = sim_image_size(&geometry);
+	if(fstat(fd, &st) != 0 || (unsigned long long) st.st_size != size) {
+		fprintf(stderr, "%s: expected an image of %llu bytes for this geometry\n", argv[optind], size);
+		return 1;
+	}
+
+	// without -w the dump stays untouched, changes only live in memory
+	unsigned char* image = mmap(NULL, size, PROT_READ | PROT_WRITE, writeBack ? MAP_SHARED : MAP_PRIVATE, fd, 0);
+	if(image == MAP_FAILED) {
+		perror("mmap");
+		return 1;
+	}
+
+	FILE* trace = fopen(argv[optind + 1], binary ? "rb" : "r");
+	if(!trace) {
+		perror(argv[optind + 1]);
+		return 1;
+	}
+
+	if(sim_nand_setup(&geometry, image) != 0 || ftl_setup() != 0) {
+		fprintf(stderr, "could not open the FTL on this image\n");
+		return 1;
+	}
+
+	unsigned int bytesPerPage = geometry.sectorsPerPage * 512;
+	unsigned char* buffer = NULL;
+	unsigned int bufferPages = 0;
+
+	// only the requests count, not what it took to open the FTL
+	SimCounters atOpen = SimCount;
+	unsigned long long clockAtOpen = SimClock;
+
+	unsigned long long requests = 0;
+	unsigned long long failed = 0;
+	unsigned long long hostRead = 0;
+	unsigned long long hostWritten = 0;
+	int lineNumber = 0;
+	char op;
+	unsigned int page;
+	unsigned int pages;
+
+	while(next_request(trace, binary, &lineNumber, &op, &page, &pages)) {
+		if(pages > bufferPages) {
+			free(buffer);
+			buffer = malloc(pages * bytesPerPage);
+			bufferPages = pages;
+		}
+
+		int ret;
+		switch(op) {
+			case 'R':
+				ret = FTL_Read(page, pages, buffer);
+				hostRead += pages;
+				break;
+			case 'W':
+				// something recognisable, in case the image is inspected afterwards
+				memset(buffer, (page + lineNumber) & 0xFF, pages * bytesPerPage);
+				ret = FTL_Write(page, pages, buffer);
+				hostWritten += pages;
+				break;
+			case 'S':
+				ret = ftl_sync() ? 0 : -1;
+				break;
+			default:
+				fprintf(stderr, "%s:%d: unknown request '%c'\n", argv[optind + 1], lineNumber, op);
+				continue;
+		}
+
+		requests++;
+		if(ret != 0) {
+			failed++;
+			if(Verbose)
+				fprintf(stderr, "%s:%d: request failed with 0x%x\n", argv[optind + 1], lineNumber, ret);
+		}
+	}
+
+	unsigned long long nandRead = SimCount.pagesRead - atOpen.pagesRead;
+	unsigned long long nandWritten = SimCount.pagesWritten - atOpen.pagesWritten;
+	unsigned long long erased = SimCount.blocksErased - atOpen.blocksErased;
+	unsigned long long elapsed = SimClock - clockAtOpen;
+
+	printf("requests: %llu (%llu failed)\n", requests, failed);
+	printf("host pages: %llu read, %llu written\n", hostRead, hostWritten);
+	printf("nand pages: %llu read, %llu programmed, %llu blocks erased\n", nandRead, nandWritten, erased);
+	if(hostWritten)
+		printf("write amplification: %.2f\n", (double) nandWritten / hostWritten);
+	printf("simulated time: %.3f s (opening the FTL took %.3f s)\n", elapsed / 1000000.0, clockAtOpen / 1000000.0);
+	if(elapsed)
+		printf("throughput: %.2f MB/s\n", ((hostRead + hostWritten) * bytesPerPage) / (elapsed / 1000000.0) / (1024 * 1024));
+
+	Verbose = 1;
+	latency_print();
+
+	fclose(trace);
+	munmap(image, size);
+	close(fd);
+	free(buffer);
+	return 0;
+}
@@ -0,0 +1,29 @@
+#ifndef TASKS_H
+#define TASKS_H
+
+// The simulator is single threaded: locks are no-ops and task_create never
+// starts anything, so the FTL runs without background merging.
+
+#include "openiboot.h"
+
+typedef struct Mutex {
+	uint32_t count;
+} Mutex;
+
+typedef struct Semaphore {
+	int32_t value;
+} Semaphore;
+
+typedef struct Completion {
+	volatile int done;
+} Completion;
+
+TaskDescriptor* task_create(const char* name, TaskRoutineFunction routine, void* opaque, uint32_t stackSize);
+void task_yield();
+void task_sleep(uint32_t microseconds);
+
+void mutex_init(Mutex* mutex);
+void mutex_lock(Mutex* mutex);
+void mutex_unlock(Mutex* mutex);
+
+#endif
@@ -0,0 +1,12 @@
+#ifndef TIMER_H
+#define TIMER_H
+
+// The simulator's clock. It only moves when the simulated NAND does work,
+// so times reflect the device rather than the host.
+
+#include "openiboot.h"
+
+uint64_t timer_get_system_microtime();
+int has_elapsed(uint64_t startTime, uint64_t elapsedTime);
+
+#endif
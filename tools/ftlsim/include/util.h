@@ -0,0 +1,34 @@
+#ifndef UTIL_H
+#define UTIL_H
+
+// Stands in for openiboot's util.h when ftl.c is built on the host. Only
+// what the FTL uses, backed by the host C library.
+
+#include "openiboot.h"
+
+#ifdef DEBUG
+#define DebugPrintf bufferPrintf
+#else
+#define DebugPrintf(...)
+#endif
+
+// Leveled logging goes to bufferPrintf like everything else, less the traces
+#define LogFTL 0
+#define LogNAND 1
+#define LogDebug(subsystem, ...) bufferPrintf(__VA_ARGS__)
+#define LogTrace(subsystem, ...) do { } while(0)
+
+void* malloc(size_t size);
+void* memalign(size_t boundary, size_t size);
+#define malloc_dma(size) memalign(64, size)
+void free(void* ptr);
+void* memset(void* x, int fill, size_t size);
+void* memcpy(void* dest, const void* src, size_t size);
+void* memmove(void* dest, const void* src, size_t size);
+int memcmp(const void* s1, const void* s2, size_t size);
+int strcmp(const char* s1, const char* s2);
+size_t strlen(const char* str);
+
+void bufferPrintf(const char* format, ...);
+
+#endif
@@ -0,0 +1,324 @@
+#include "openiboot.h"
+#include "nand.h"
+#include "hardware/nand.h"
+#include "util.h"
+#include "timer.h"
+#include "tasks.h"
+#include "sim.h"
+
+// nand.c's interface, on top of a NAND image in memory.
+
+int HasNANDInit = FALSE;
+
+SimCosts SimCost = {50, 250, 2000, 40};
+SimCounters SimCount;
+unsigned long long SimClock = 0;
+
+static NANDData Geometry;
+static NANDFTLData FTLData;
+static int banksTable[NAND_NUM_BANKS];
+static uint8_t* Image;
+
+unsigned long long sim_image_size(const SimGeometry* geometry) {
+	unsigned long long pageSize = (geometry->sectorsPerPage * 512) + geometry->bytesPerSpare;
+	return (unsigned long long) geometry->banks * geometry->blocksPerBank * geometry->pagesPerBlock * pageSize;
+}
+
+// The same derived values nand_setup works out from the device table.
+int sim_nand_setup(const SimGeometry* geometry, unsigned char* image) {
+	int i;
+
+	if(geometry->banks == 0 || geometry->banks > NAND_NUM_BANKS)
+		return ERROR_ARG;
+
+	for(i = 0; i < geometry->banks; i++)
+		banksTable[i] = i;
+
+	memset(&Geometry, 0, sizeof(Geometry));
+	Geometry.banksTable = banksTable;
+	Geometry.blocksPerBank = geometry->blocksPerBank;
+	Geometry.banksTotal = geometry->banks;
+	Geometry.sectorsPerPage = geometry->sectorsPerPage;
+	Geometry.userSuBlksTotal = geometry->userSuBlksTotal;
+	Geometry.bytesPerSpare = geometry->bytesPerSpare;
+	Geometry.field_2E = 4;
+	Geometry.field_2F = 3;
+	Geometry.pagesPerBlock = geometry->pagesPerBlock;
+	Geometry.field_4 = 5;
+	Geometry.bytesPerPage = 512 * Geometry.sectorsPerPage;
+	Geometry.pagesPerBank = Geometry.pagesPerBlock * Geometry.blocksPerBank;
+	Geometry.pagesTotal = Geometry.pagesPerBank * Geometry.banksTotal;
+	Geometry.pagesPerSuBlk = Geometry.pagesPerBlock * Geometry.banksTotal;
+	Geometry.userPagesTotal = Geometry.userSuBlksTotal * Geometry.pagesPerSuBlk;
+	Geometry.suBlksTotal = Geometry.blocksPerBank;
+
+	FTLData.field_2 = Geometry.suBlksTotal - Geometry.userSuBlksTotal - 28;
+	FTLData.sysSuBlks = FTLData.field_2 + 4;
+	FTLData.field_4 = FTLData.field_2 + 5;
+	FTLData.field_6 = 3;
+	FTLData.field_8 = 23;
+
+	int bits = 0;
+	i = FTLData.field_8;
+	while((i <<= 1) != 0) {
+		bits++;
+	}
+
+	Geometry.field_22 = bits;
+
+	Image = image;
+	HasNANDInit = TRUE;
+	return 0;
+}
+
+int nand_setup() {
+	return HasNANDInit ? 0 : ERROR_ARG;
+}
+
+NANDData* nand_get_geometry() {
+	return &Geometry;
+}
+
+NANDFTLData* nand_get_ftl_data() {
+	return &FTLData;
+}
+
+static uint8_t* sim_page(int bank, int page) {
+	uint32_t pageSize = Geometry.bytesPerPage + Geometry.bytesPerSpare;
+	return Image + (((unsigned long long) bank * Geometry.pagesPerBank) + page) * pageSize;
+}
+
+static int sim_is_erased(uint8_t* data, int size) {
+	int i;
+	for(i = 0; i < size; i++) {
+		if(data[i] != 0xFF)
+			return FALSE;
+	}
+
+	return TRUE;
+}
+
+int nand_read(int bank, int page, uint8_t* buffer, uint8_t* spare, int doECC, int checkBlank) {
+	if(bank >= Geometry.banksTotal || page >= Geometry.pagesPerBank)
+		return ERROR_ARG;
+
+	if(buffer == NULL && spare == NULL)
+		return ERROR_ARG;
+
+	uint8_t* data = sim_page(bank, page);
+	uint8_t* rawSpare = data + Geometry.bytesPerPage;
+
+	SimCount.pagesRead++;
+	SimClock += SimCost.read + (buffer ? SimCost.transferPerPage : 0);
+
+	if(buffer)
+		memcpy(buffer, data, Geometry.bytesPerPage);
+
+	if(spare)
+		memcpy(spare, rawSpare, doECC ? sizeof(SpareData) : Geometry.bytesPerSpare);
+
+	if(checkBlank && sim_is_erased(rawSpare, Geometry.bytesPerSpare))
+		return ERROR_EMPTYBLOCK;
+
+	return 0;
+}
+
+int nand_read_spare(int bank, int page, uint8_t* spare, int doECC) {
+	return nand_read(bank, page, NULL, spare, doECC, TRUE);
+}
+
+int nand_read_multiple(uint16_t* bank, uint32_t* pages, uint8_t* main, SpareData* spare, int pagesCount) {
+	int i;
+	for(i = 0; i < pagesCount; i++) {
+		int ret = nand_read(bank[i], pages[i], main + (i * Geometry.bytesPerPage), (uint8_t*) &spare[i], TRUE, TRUE);
+		if(ret > 1)
+			return ret;
+	}
+
+	return 0;
+}
+
+void nand_read_spare_multiple(uint16_t* bank, uint32_t* pages, SpareData* spare, int* status, int pagesCount) {
+	int i;
+	for(i = 0; i < pagesCount; i++) {
+		status[i] = nand_read(bank[i], pages[i], NULL, (uint8_t*) &spare[i], TRUE, TRUE);
+		if(status[i] == ERROR_EMPTYBLOCK)
+			memset(&spare[i], 0xFF, sizeof(SpareData));
+	}
+}
+
+// The image carries corrected data only, so there is no second ECC to check.
+int nand_read_alternate_ecc(int bank, int page, uint8_t* buffer) {
+	return nand_read(bank, page, buffer, NULL, FALSE, FALSE);
+}
+
+int nand_write(int bank, int page, uint8_t* buffer, uint8_t* spare, int doECC) {
+	if(bank >= Geometry.banksTotal || page >= Geometry.pagesPerBank)
+		return ERROR_ARG;
+
+	if(buffer == NULL && spare == NULL)
+		return ERROR_ARG;
+
+	uint8_t* data = sim_page(bank, page);
+
+	SimCount.pagesWritten++;
+	SimClock += SimCost.program + SimCost.transferPerPage;
+
+	// programming can only clear bits
+	int i;
+	if(buffer) {
+		for(i = 0; i < Geometry.bytesPerPage; i++)
+			data[i] &= buffer[i];
+	}
+
+	if(spare) {
+		uint8_t* rawSpare = data + Geometry.bytesPerPage;
+		int size = doECC ? sizeof(SpareData) : Geometry.bytesPerSpare;
+		for(i = 0; i < size; i++)
+			rawSpare[i] &= spare[i];
+	}
+
+	return 0;
+}
+
+int nand_write_multiple(uint16_t* bank, uint32_t* pages, uint8_t* main, SpareData* spare, int* status, int pagesCount) {
+	int ret = 0;
+	int i;
+	for(i = 0; i < pagesCount; i++) {
+		status[i] = nand_write(bank[i], pages[i], main + (i * Geometry.bytesPerPage), (uint8_t*) &spare[i], TRUE);
+		if(status[i] != 0)
+			ret = -1;
+	}
+
+	return ret;
+}
+
+int nand_erase(int bank, int block) {
+	if(bank >= Geometry.banksTotal || block >= Geometry.blocksPerBank)
+		return ERROR_ARG;
+
+	SimCount.blocksErased++;
+	SimClock += SimCost.erase;
+
+	memset(sim_page(bank, block * Geometry.pagesPerBlock), 0xFF, Geometry.pagesPerBlock * (Geometry.bytesPerPage + Geometry.bytesPerSpare));
+	return 0;
+}
+
+#define SIM_DUMP_SPARE (sizeof(SpareData) + sizeof(uint32_t))
+
+void sim_image_from_dump(const SimGeometry* geometry, unsigned char* image, const unsigned char* dumpMain, const unsigned char* dumpSpares) {
+	uint32_t bytesPerPage = geometry->sectorsPerPage * 512;
+	uint32_t pageSize = bytesPerPage + geometry->bytesPerSpare;
+	uint32_t pagesPerBank = geometry->blocksPerBank * geometry->pagesPerBlock;
+	uint32_t count = pagesPerBank * geometry->banks;
+	uint32_t i;
+
+	for(i = 0; i < count; i++) {
+		uint32_t bank = i % geometry->banks;
+		uint32_t page = i / geometry->banks;
+		uint8_t* data = image + (((unsigned long long) bank * pagesPerBank) + page) * pageSize;
+		SpareData* spare = (SpareData*)(data + bytesPerPage);
+		const uint8_t* record = dumpSpares + ((unsigned long long) i * SIM_DUMP_SPARE);
+		uint32_t status;
+
+		memcpy(&status, record + sizeof(SpareData), sizeof(status));
+		memset(spare, 0xFF, geometry->bytesPerSpare);
+
+		if(status == ERROR_EMPTYBLOCK) {
+			memset(data, 0xFF, bytesPerPage);
+			continue;
+		}
+
+		memcpy(data, dumpMain + ((unsigned long long) i * bytesPerPage), bytesPerPage);
+		memcpy(spare, record, sizeof(SpareData));
+		if(status != 0)
+			spare->eccMark = 0x55;
+	}
+}
+
+unsigned int sim_scan_spares(unsigned int first, unsigned int last, SimSpareHandler found, void* opaque) {
+	unsigned int count = 0;
+	unsigned int i;
+
+	for(i = first; i < last; i++) {
+		int bank = i / Geometry.pagesPerBank;
+		int page = i % Geometry.pagesPerBank;
+		SpareData* spare = (SpareData*)(sim_page(bank, page) + Geometry.bytesPerPage);
+
+		// the FTL's own metadata and the VFL's are 0x43 - 0x4F and 0x80
+		if(spare->type1 != 0x40 && spare->type1 != 0x41)
+			continue;
+
+		if(spare->user.logicalPageNumber >= Geometry.userPagesTotal)
+			continue;
+
+		found(opaque, spare->user.logicalPageNumber, spare->user.usn,
+				((page % Geometry.pagesPerBlock) * Geometry.banksTotal) + bank, i, spare->eccMark == 0x55);
+		count++;
+	}
+
+	return count;
+}
+
+const unsigned char* sim_page_data(unsigned int index) {
+	return sim_page(index / Geometry.pagesPerBank, index % Geometry.pagesPerBank);
+}
+
+// Queued requests run as soon as they are submitted, there is only the one task.
+void nand_submit(NANDRequest* request) {
+	switch(request->operation) {
+		case NANDOperationRead:
+			request->status = nand_read(request->bank, request->page, request->buffer, request->spare, request->doECC, TRUE);
+			break;
+		case NANDOperationWrite:
+			request->status = nand_write(request->bank, request->page, request->buffer, request->spare, request->doECC);
+			break;
+		default:
+			request->status = nand_erase(request->bank, request->page);
+			break;
+	}
+
+	if(request->callback)
+		request->callback(request, request->opaque);
+
+	request->completion.done = TRUE;
+}
+
+int nand_wait(NANDRequest* request) {
+	return request->status;
+}
+
+int nand_bank_reset(int bank, int timeout) {
+	return 0;
+}
+
+uint64_t timer_get_system_microtime() {
+	return SimClock;
+}
+
+int has_elapsed(uint64_t startTime, uint64_t elapsedTime) {
+	return (SimClock - startTime) >= elapsedTime;
+}
+
+TaskDescriptor* task_create(const char* name, TaskRoutineFunction routine, void* opaque, uint32_t stackSize) {
+	return NULL;
+}
+
+void task_yield() {
+}
+
+void task_sleep(uint32_t microseconds) {
+	SimClock += microseconds;
+}
+
+void mutex_init(Mutex* mutex) {
+	mutex->count = 0;
+}
+
+void mutex_lock(Mutex* mutex) {
+	mutex->count++;
+}
+
+void mutex_unlock(Mutex* mutex) {
+	mutex->count--;
+}
@@ -0,0 +1,367 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "sim.h"
+
+// Rebuilds the logical disk behind a NAND image. By default it is pieced
+// together from the spares: every page of user data names its logical page
+// and carries a USN, and the newest copy of each logical page wins. That
+// works without the FTL or VFL contexts, so it also gets something back from
+// flash the FTL can no longer open. With -f the FTL is opened on the image
+// the way the device does it instead, and everything is read through it.
+//
+// Pages that are all zeroes are left out of the output, which is sparse.
+
+#define REBUILD_LOCKS 256
+#define REBUILD_FTL_CHUNK 64
+#define REBUILD_NONE 0xFFFFFFFF
+
+typedef struct RebuildEntry {
+	unsigned int usn;
+	unsigned int order;
+	unsigned int index;
+} RebuildEntry;
+
+typedef struct RebuildJob {
+	unsigned int first;
+	unsigned int last;
+	unsigned int found;
+	unsigned int eccFailed;
+	unsigned int written;
+	int failed;
+} RebuildJob;
+
+static int Verbose = 0;
+
+static RebuildEntry* Map;
+static pthread_mutex_t MapLocks[REBUILD_LOCKS];
+static unsigned int BytesPerPage;
+static int Output;
+
+void bufferPrintf(const char* format, ...) {
+	va_list args;
+	if(!Verbose)
+		return;
+
+	va_start(args, format);
+	vprintf(format, args);
+	va_end(args);
+}
+
+static int is_zero(const unsigned char* data, unsigned int size) {
+	unsigned int i;
+	for(i = 0; i < size; i++) {
+		if(data[i] != 0)
+			return 0;
+	}
+
+	return 1;
+}
+
+static int write_page(unsigned int logicalPage, const unsigned char* data) {
+	if(is_zero(data, BytesPerPage))
+		return 0;
+
+	if(pwrite(Output, data, BytesPerPage, (off_t) logicalPage * BytesPerPage) != BytesPerPage) {
+		perror("pwrite");
+		return -1;
+	}
+
+	return 1;
+}
+
+static void found_page(void* opaque, unsigned int logicalPage, unsigned int usn, unsigned int order,
+		unsigned int index, int eccFailed) {
+	RebuildJob* job = opaque;
+	RebuildEntry* entry = &Map[logicalPage];
+	pthread_mutex_t* lock = &MapLocks[logicalPage % REBUILD_LOCKS];
+
+	job->found++;
+	if(eccFailed)
+		job->eccFailed++;
+
+	pthread_mutex_lock(lock);
+	if(entry->index == REBUILD_NONE || usn > entry->usn || (usn == entry->usn && order > entry->order)) {
+		entry->usn = usn;
+		entry->order = order;
+		entry->index = index;
+	}
+	pthread_mutex_unlock(lock);
+}
+
+static void* scan_thread(void* opaque) {
+	RebuildJob* job = opaque;
+	sim_scan_spares(job->first, job->last, found_page, job);
+	return NULL;
+}
+
+static void* write_thread(void* opaque) {
+	RebuildJob* job = opaque;
+	unsigned int i;
+
+	for(i = job->first; i < job->last; i++) {
+		if(Map[i].index == REBUILD_NONE)
+			continue;
+
+		int ret = write_page(i, sim_page_data(Map[i].index));
+		if(ret < 0) {
+			job->failed = 1;
+			break;
+		}
+
+		job->written += ret;
+	}
+
+	return NULL;
+}
+
+// Splits [0, count) into one range per job and runs routine on each.
+static int run_jobs(RebuildJob* jobs, int threads, unsigned int count, void* (*routine)(void*)) {
+	pthread_t* ids = malloc(threads * sizeof(pthread_t));
+	unsigned int each = (count + threads - 1) / threads;
+	int i;
+
+	for(i = 0; i < threads; i++) {
+		memset(&jobs[i], 0, sizeof(RebuildJob));
+		jobs[i].first = (i * each < count) ? (i * each) : count;
+		jobs[i].last = (jobs[i].first + each < count) ? (jobs[i].first + each) : count;
+		if(pthread_create(&ids[i], NULL, routine, &jobs[i]) != 0) {
+			perror("pthread_create");
+			exit(1);
+		}
+	}
+
+	for(i = 0; i < threads; i++)
+		pthread_join(ids[i], NULL);
+
+	free(ids);
+
+	for(i = 0; i < threads; i++) {
+		if(jobs[i].failed)
+			return -1;
+	}
+
+	return 0;
+}
+
+static int rebuild_from_spares(unsigned int imagePages, unsigned int userPages, int threads) {
+	RebuildJob* jobs = calloc(threads, sizeof(RebuildJob));
+	unsigned long long found = 0;
+	unsigned long long eccFailed = 0;
+	unsigned long long written = 0;
+	unsigned int mapped = 0;
+	unsigned int i;
+
+	Map = malloc((size_t) userPages * sizeof(RebuildEntry));
+	if(!Map || !jobs) {
+		fprintf(stderr, "out of memory for %u logical pages\n", userPages);
+		return -1;
+	}
+
+	for(i = 0; i < userPages; i++)
+		Map[i].index = REBUILD_NONE;
+
+	for(i = 0; i < REBUILD_LOCKS; i++)
+		pthread_mutex_init(&MapLocks[i], NULL);
+
+	run_jobs(jobs, threads, imagePages, scan_thread);
+	for(i = 0; i < threads; i++) {
+		found += jobs[i].found;
+		eccFailed += jobs[i].eccFailed;
+	}
+
+	for(i = 0; i < userPages; i++) {
+		if(Map[i].index != REBUILD_NONE)
+			mapped++;
+	}
+
+	printf("spares: %llu pages of user data (%llu copied with ECC errors), %u of %u logical pages found\n",
+			found, eccFailed, mapped, userPages);
+
+	int ret = run_jobs(jobs, threads, userPages, write_thread);
+	for(i = 0; i < threads; i++)
+		written += jobs[i].written;
+
+	printf("wrote %llu pages\n", written);
+
+	free(jobs);
+	free(Map);
+	return ret;
+}
+
+// ftl.c keeps all of its state in globals, so this one is single threaded.
+static int rebuild_from_ftl(unsigned int userPages) {
+	unsigned char* buffer = malloc(REBUILD_FTL_CHUNK * BytesPerPage);
+	unsigned long long written = 0;
+	unsigned int failed = 0;
+	unsigned int page;
+	unsigned int i;
+
+	if(ftl_setup() != 0) {
+		fprintf(stderr, "could not open the FTL on this image, try without -f\n");
+		return -1;
+	}
+
+	for(page = 0; page < userPages; page += REBUILD_FTL_CHUNK) {
+		unsigned int pages = ((userPages - page) > REBUILD_FTL_CHUNK) ? REBUILD_FTL_CHUNK : (userPages - page);
+
+		if(FTL_Read(page, pages, buffer) != 0) {
+			// go through them one at a time to find the bad ones
+			for(i = 0; i < pages; i++) {
+				if(FTL_Read(page + i, 1, buffer + (i * BytesPerPage)) != 0) {
+					memset(buffer + (i * BytesPerPage), 0, BytesPerPage);
+					failed++;
+				}
+			}
+		}
+
+		for(i = 0; i < pages; i++) {
+			int ret = write_page(page + i, buffer + (i * BytesPerPage));
+			if(ret < 0) {
+				free(buffer);
+				return -1;
+			}
+
+			written += ret;
+		}
+	}
+
+	printf("ftl: wrote %llu of %u pages, %u could not be read\n", written, userPages, failed);
+
+	free(buffer);
+	return 0;
+}
+
+static unsigned char* map_file(const char* path, unsigned long long size, int private) {
+	int fd = open(path, O_RDONLY);
+	if(fd < 0) {
+		perror(path);
+		return NULL;
+	}
+
+	struct stat st;
+	if(fstat(fd, &st) != 0 || (unsigned long long) st.st_size != size) {
+		fprintf(stderr, "%s: expected %llu bytes for this geometry\n", path, size);
+		close(fd);
+		return NULL;
+	}
+
+	// the FTL may write to the image while opening it, which only stays in memory
+	unsigned char* data = mmap(NULL, size, PROT_READ | (private ? PROT_WRITE : 0), MAP_PRIVATE, fd, 0);
+	close(fd);
+	if(data == MAP_FAILED) {
+		perror("mmap");
+		return NULL;
+	}
+
+	return data;
+}
+
+static void usage(const char* name) {
+	fprintf(stderr, "Usage: %s [-v] [-f] [-d] [-j threads] [-g banks,blocks,pages,sectors,spare,userSuBlks] <nand image> <disk image>\n", name);
+	fprintf(stderr, "\t-v\tshow the FTL's own messages\n");
+	fprintf(stderr, "\t-f\tread the disk through the FTL instead of rebuilding it from the spares\n");
+	fprintf(stderr, "\t-d\tthe NAND image is a dump written by oibc's %% command, with its .spare file beside it\n");
+	fprintf(stderr, "\t-j\tthreads for the spare scan (default: one per core)\n");
+	fprintf(stderr, "\t-g\tgeometry of the image (default 8,4096,128,4,64,3872)\n");
+}
+
+int main(int argc, char* argv[]) {
+	SimGeometry geometry = {8, 4096, 128, 4, 64, 3872};
+	int useFTL = 0;
+	int fromDump = 0;
+	int threads = sysconf(_SC_NPROCESSORS_ONLN);
+	int opt;
+
+	while((opt = getopt(argc, argv, "vfdj:g:")) != -1) {
+		switch(opt) {
+			case 'v':
+				Verbose = 1;
+				break;
+			case 'f':
+				useFTL = 1;
+				break;
+			case 'd':
+				fromDump = 1;
+				break;
+			case 'j':
+				threads = atoi(optarg);
+				break;
+			case 'g':
+				if(sscanf(optarg, "%u,%u,%u,%u,%u,%u", &geometry.banks, &geometry.blocksPerBank, &geometry.pagesPerBlock,
+							&geometry.sectorsPerPage, &geometry.bytesPerSpare, &geometry.userSuBlksTotal) != 6) {
+					usage(argv[0]);
+					return 1;
+				}
+				break;
+			default:
+				usage(argv[0]);
+				return 1;
+		}
+	}
+
+	if((argc - optind) < 2 || threads < 1) {
+		usage(argv[0]);
+		return 1;
+	}
+
+	BytesPerPage = geometry.sectorsPerPage * 512;
+	unsigned int imagePages = geometry.banks * geometry.blocksPerBank * geometry.pagesPerBlock;
+	unsigned int userPages = geometry.userSuBlksTotal * geometry.pagesPerBlock * geometry.banks;
+	unsigned long long size = sim_image_size(&geometry);
+	unsigned char* image;
+
+	if(fromDump) {
+		char sparePath[1024];
+		snprintf(sparePath, sizeof(sparePath), "%s.spare", argv[optind]);
+
+		// a SpareData and the read status for each page
+		unsigned char* dumpMain = map_file(argv[optind], (unsigned long long) imagePages * BytesPerPage, 0);
+		unsigned char* dumpSpares = map_file(sparePath, (unsigned long long) imagePages * 16, 0);
+		if(!dumpMain || !dumpSpares)
+			return 1;
+
+		image = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		if(image == MAP_FAILED) {
+			perror("mmap");
+			return 1;
+		}
+
+		sim_image_from_dump(&geometry, image, dumpMain, dumpSpares);
+		munmap(dumpMain, (unsigned long long) imagePages * BytesPerPage);
+		munmap(dumpSpares, (unsigned long long) imagePages * 16);
+	} else {
+		image = map_file(argv[optind], size, 1);
+		if(!image)
+			return 1;
+	}
+
+	if(sim_nand_setup(&geometry, image) != 0) {
+		fprintf(stderr, "unsupported geometry\n");
+		return 1;
+	}
+
+	Output = open(argv[optind + 1], O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	if(Output < 0) {
+		perror(argv[optind + 1]);
+		return 1;
+	}
+
+	// whatever is never written stays a hole
+	if(ftruncate(Output, (off_t) userPages * BytesPerPage) != 0) {
+		perror("ftruncate");
+		return 1;
+	}
+
+	int ret = useFTL ? rebuild_from_ftl(userPages) : rebuild_from_spares(imagePages, userPages, threads);
+
+	close(Output);
+	munmap(image, size);
+	return (ret == 0) ? 0 : 1;
+}
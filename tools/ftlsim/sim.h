@@ -0,0 +1,85 @@
+#ifndef SIM_H
+#define SIM_H
+
+// Shared between the host side (host.c, built against the C library) and the
+// side built against openiboot's headers (nandsim.c and the FTL itself), so
+// only plain C types are used here.
+
+typedef struct SimGeometry {
+	unsigned int banks;
+	unsigned int blocksPerBank;
+	unsigned int pagesPerBlock;
+	unsigned int sectorsPerPage;
+	unsigned int bytesPerSpare;
+	unsigned int userSuBlksTotal;
+} SimGeometry;
+
+// Simulated cost of each NAND operation, in microseconds.
+typedef struct SimCosts {
+	unsigned int read;
+	unsigned int program;
+	unsigned int erase;
+	unsigned int transferPerPage;
+} SimCosts;
+
+typedef struct SimCounters {
+	unsigned long long pagesRead;
+	unsigned long long pagesWritten;
+	unsigned long long blocksErased;
+	unsigned long long readErrors;
+	unsigned long long programErrors;
+} SimCounters;
+
+extern SimCosts SimCost;
+extern SimCounters SimCount;
+extern unsigned long long SimClock;
+
+// The image holds every page of bank 0, then bank 1 and so on. Each page is
+// its data followed by bytesPerSpare bytes of spare, as read with ECC
+// already applied.
+unsigned long long sim_image_size(const SimGeometry* geometry);
+int sim_nand_setup(const SimGeometry* geometry, unsigned char* image);
+
+// Builds an image from a dump written by oibc's %<file> command, which
+// holds main areas in dumpMain and a SpareData and read status for each page
+// in dumpSpares, page by page across the banks. Pages that read back empty
+// are left erased and ones that failed ECC get the FTL's 0x55 eccMark. The
+// dump has to cover every page of every bank.
+void sim_image_from_dump(const SimGeometry* geometry, unsigned char* image, const unsigned char* dumpMain, const unsigned char* dumpSpares);
+
+// Called with every page of user data sim_scan_spares finds. index is the
+// page in the image, order where it was written in its superblock: of two
+// copies of a logical page with the same USN, the higher order is newer.
+typedef void (*SimSpareHandler)(void* opaque, unsigned int logicalPage, unsigned int usn, unsigned int order,
+		unsigned int index, int eccFailed);
+
+// Looks through the spares of image pages [first, last) for user data,
+// straight from the image without counting NAND reads, so several ranges
+// can be scanned at once. Returns how many pages were handed to found.
+unsigned int sim_scan_spares(unsigned int first, unsigned int last, SimSpareHandler found, void* opaque);
+const unsigned char* sim_page_data(unsigned int index);
+
+// From ftl.c
+int ftl_setup();
+int ftl_sync();
+int FTL_Read(int logicalPageNumber, int totalPagesToRead, unsigned char* pBuf);
+int FTL_Write(int logicalPageNumber, int totalPagesToWrite, unsigned char* pBuf);
+void ftl_printdata();
+
+// From latency.c
+void latency_print();
+
+// Mirrors IOTraceEntry in latency.h, as fetched with RPCIOTrace. Only the
+// FTL entries are replayed.
+typedef struct SimTraceEntry {
+	unsigned int timestamp;
+	unsigned short operation;
+	unsigned short count;
+	unsigned int address;
+	unsigned int latency;
+} __attribute__ ((__packed__)) SimTraceEntry;
+
+#define SIM_TRACE_FTL_READ 6	// LatencyFTLRead
+#define SIM_TRACE_FTL_WRITE 7	// LatencyFTLWrite
+
+#endif
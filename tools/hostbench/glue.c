@@ -0,0 +1,216 @@
+#include "openiboot.h"
+#include "openiboot-asmhelpers.h"
+#include "util.h"
+#include "uart.h"
+#include "framebuffer.h"
+#include "sha1.h"
+#include "hfs/common.h"
+#include "hfs/hfsplus.h"
+#include "hfs/hfscompress.h"
+#include "hostbench.h"
+
+// Files are read back in pieces of this size
+#define HOST_HFS_CHUNK 0x100000
+
+// What the modules expect from the rest of openiboot. Output only goes to
+// the "UART", which is stdout.
+int UartHasInit = TRUE;
+int FramebufferHasInit = FALSE;
+
+static Volume* HostVolume = NULL;
+static io_func HostImage;
+
+void EnterCriticalSection() {
+}
+
+void LeaveCriticalSection() {
+}
+
+int uart_write(int ureg, const char* buffer, uint32_t length) {
+	host_write(buffer, length);
+	return 0;
+}
+
+void uart_flush(int ureg) {
+}
+
+void framebuffer_print(const char* str) {
+}
+
+void host_sha1(const void* data, unsigned int len, unsigned char digest[20]) {
+	SHA1_CTX context;
+
+	SHA1Init(&context);
+	SHA1Update(&context, data, len);
+	SHA1Final(digest, &context);
+}
+
+static int image_read(io_func* io, off_t location, size_t size, void* buffer) {
+	return host_image_read(location, size, buffer);
+}
+
+// The image is only ever read
+static int image_write(io_func* io, off_t location, size_t size, void* buffer) {
+	bufferPrintf("hostbench: the volume tried to write 0x%x bytes at 0x%Lx\r\n", size, location);
+	return FALSE;
+}
+
+static void image_close(io_func* io) {
+}
+
+int host_hfs_open() {
+	HostImage.data = NULL;
+	HostImage.read = image_read;
+	HostImage.write = image_write;
+	HostImage.close = image_close;
+	HostImage.discard = NULL;
+
+	HostVolume = openVolume(&HostImage);
+	return HostVolume != NULL;
+}
+
+void host_hfs_close() {
+	if(HostVolume)
+		closeVolume(HostVolume);
+
+	HostVolume = NULL;
+}
+
+static int is_ascii(HFSUniStr255* name) {
+	int i;
+
+	if(name->length == 0)
+		return FALSE;
+
+	for(i = 0; i < name->length; i++) {
+		if(name->unicode[i] == 0 || name->unicode[i] >= 0x80)
+			return FALSE;
+	}
+
+	return TRUE;
+}
+
+static int read_compressed(HFSPlusCatalogFile* file, uint8_t* buffer, HostHFSTotals* totals) {
+	HFSPlusCompressed* data;
+	uint32_t chunk;
+	int ret = TRUE;
+
+	data = openHFSPlusCompressed(HostVolume, file);
+	if(data == NULL)
+		return FALSE;
+
+	if(data->chunkSize > HOST_HFS_CHUNK)
+		ret = FALSE;
+
+	for(chunk = 0; ret && chunk < data->numChunks; chunk++) {
+		int size = readHFSPlusCompressedChunk(data, chunk, buffer);
+		if(size < 0) {
+			ret = FALSE;
+			break;
+		}
+
+		crc32(&totals->crc, buffer, size);
+		totals->bytes += size;
+	}
+
+	totals->compressed++;
+	closeHFSPlusCompressed(data);
+	return ret;
+}
+
+static int read_file(HFSPlusCatalogFile* file, uint8_t* buffer, HostHFSTotals* totals) {
+	io_func* io;
+	uint64_t offset;
+
+	if(isHFSPlusCompressed(file))
+		return read_compressed(file, buffer, totals);
+
+	io = openRawFile(file->fileID, &file->dataFork, (HFSPlusCatalogRecord*)file, HostVolume);
+	if(io == NULL)
+		return FALSE;
+
+	for(offset = 0; offset < file->dataFork.logicalSize; offset += HOST_HFS_CHUNK) {
+		uint64_t left = file->dataFork.logicalSize - offset;
+		size_t size = (left > HOST_HFS_CHUNK) ? HOST_HFS_CHUNK : left;
+
+		if(!READ(io, offset, size, buffer)) {
+			CLOSE(io);
+			return FALSE;
+		}
+
+		crc32(&totals->crc, buffer, size);
+		totals->bytes += size;
+	}
+
+	CLOSE(io);
+	return TRUE;
+}
+
+// Whether path leads back to the same file or folder, without following links
+static int lookup_matches(const char* path, HFSPlusCatalogRecord* record) {
+	HFSPlusCatalogRecord* found;
+	int ret;
+
+	found = getRecordFromPath3(path, HostVolume, NULL, NULL, FALSE, FALSE, kHFSRootFolderID);
+	if(found == NULL)
+		return FALSE;
+
+	if(found->recordType != record->recordType)
+		ret = FALSE;
+	else if(record->recordType == kHFSPlusFolderRecord)
+		ret = ((HFSPlusCatalogFolder*)found)->folderID == ((HFSPlusCatalogFolder*)record)->folderID;
+	else
+		ret = ((HFSPlusCatalogFile*)found)->fileID == ((HFSPlusCatalogFile*)record)->fileID;
+
+	free(found);
+	return ret;
+}
+
+static void walk_folder(HFSCatalogNodeID folderID, const char* path, uint8_t* buffer, HostHFSTotals* totals) {
+	CatalogRecordList* list;
+	CatalogRecordList* theList;
+
+	theList = list = getFolderContents(folderID, HostVolume);
+
+	while(list != NULL) {
+		HFSPlusCatalogRecord* record = list->record;
+		char* name = unicodeToAscii(&list->name);
+		char* childPath = malloc(strlen(path) + strlen(name) + 2);
+
+		strcpy(childPath, path);
+		strcpy(childPath + strlen(path), "/");
+		strcpy(childPath + strlen(path) + 1, name);
+
+		// names that don't survive unicodeToAscii can't be looked up
+		if(is_ascii(&list->name) && !lookup_matches(childPath, record)) {
+			bufferPrintf("hostbench: %s is not found again by its path\r\n", childPath);
+			totals->failed++;
+		}
+
+		if(record->recordType == kHFSPlusFolderRecord) {
+			totals->folders++;
+			walk_folder(((HFSPlusCatalogFolder*)record)->folderID, childPath, buffer, totals);
+		} else if(record->recordType == kHFSPlusFileRecord) {
+			totals->files++;
+			if(!read_file((HFSPlusCatalogFile*)record, buffer, totals)) {
+				bufferPrintf("hostbench: could not read %s\r\n", childPath);
+				totals->failed++;
+			}
+		}
+
+		free(childPath);
+		free(name);
+		list = list->next;
+	}
+
+	releaseCatalogRecordList(theList);
+}
+
+void host_hfs_walk(HostHFSTotals* totals) {
+	uint8_t* buffer = malloc(HOST_HFS_CHUNK);
+
+	memset(totals, 0, sizeof(HostHFSTotals));
+	walk_folder(kHFSRootFolderID, "", buffer, totals);
+
+	free(buffer);
+}
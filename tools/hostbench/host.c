@@ -0,0 +1,915 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <time.h>
+#include <sys/stat.h>
+#include "hostbench.h"
+
+// Runs known-answer checks on openiboot's portable modules, then times them.
+// The C library's versions are timed alongside where there is one, to have
+// something to compare against.
+
+// Each benchmark is repeated until it has run for at least this long
+#define BENCH_MIN_NS 200000000LL
+#define BENCH_SIZE 0x100000
+
+#define IMAGE_WIDTH 61
+#define IMAGE_HEIGHT 37
+#define BENCH_IMAGE_WIDTH 320
+#define BENCH_IMAGE_HEIGHT 480
+
+typedef void (*BenchFunc)(void* opaque);
+
+static int Failed = 0;
+static int ImageFD = -1;
+static unsigned int Seed = 1;
+static volatile unsigned int Sink;
+
+void host_write(const char* buffer, unsigned int length) {
+	fwrite(buffer, 1, length, stdout);
+}
+
+int host_image_read(unsigned long long offset, unsigned int size, void* buffer) {
+	return pread(ImageFD, buffer, size, offset) == size;
+}
+
+static void check(int ok, const char* format, ...) {
+	va_list args;
+
+	if(ok)
+		return;
+
+	printf("FAIL: ");
+	va_start(args, format);
+	vprintf(format, args);
+	va_end(args);
+	printf("\n");
+	Failed++;
+}
+
+static unsigned int next_random() {
+	Seed = Seed * 1103515245 + 12345;
+	return Seed >> 8;
+}
+
+static void fill_random(unsigned char* buffer, unsigned int size) {
+	unsigned int i;
+	for(i = 0; i < size; i++)
+		buffer[i] = next_random();
+}
+
+static long long now_ns() {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+// Nanoseconds per call of func
+static double bench(BenchFunc func, void* opaque) {
+	long long iterations = 1;
+
+	while(1) {
+		long long start = now_ns();
+		long long i;
+
+		for(i = 0; i < iterations; i++)
+			func(opaque);
+
+		long long elapsed = now_ns() - start;
+		if(elapsed >= BENCH_MIN_NS)
+			return (double) elapsed / iterations;
+
+		iterations *= 2;
+	}
+}
+
+static void report_rate(const char* name, double ns, unsigned int bytes) {
+	printf("%-32s %10.1f MB/s\n", name, (bytes * 1000.0) / ns);
+}
+
+static void report_time(const char* name, double ns) {
+	printf("%-32s %10.3f us\n", name, ns / 1000.0);
+}
+
+// Bit at a time, the way the tables in util.c were made
+static unsigned int reference_crc32(const unsigned char* buffer, unsigned int len) {
+	unsigned int crc = 0xFFFFFFFF;
+	unsigned int i;
+	int bit;
+
+	for(i = 0; i < len; i++) {
+		crc ^= buffer[i];
+		for(bit = 0; bit < 8; bit++)
+			crc = (crc >> 1) ^ ((crc & 1) ? 0xEDB88320 : 0);
+	}
+
+	return crc ^ 0xFFFFFFFF;
+}
+
+static unsigned int reference_adler32(const unsigned char* buffer, unsigned int len) {
+	unsigned int s1 = 1;
+	unsigned int s2 = 0;
+	unsigned int i;
+
+	for(i = 0; i < len; i++) {
+		s1 = (s1 + buffer[i]) % 65521;
+		s2 = (s2 + s1) % 65521;
+	}
+
+	return (s2 << 16) | s1;
+}
+
+static int sign(int x) {
+	return (x > 0) - (x < 0);
+}
+
+static void check_strings() {
+	unsigned char src[320 + 8];
+	unsigned char dst[320 + 16];
+	unsigned char ref[320 + 16];
+	unsigned int size;
+	int sa;
+	int da;
+
+	fill_random(src, sizeof(src));
+
+	for(size = 0; size <= 320; size++) {
+		for(sa = 0; sa < 8; sa++) {
+			for(da = 0; da < 8; da++) {
+				// whatever is around the destination must not be touched either
+				memset(dst, 0xA5, sizeof(dst));
+				memset(ref, 0xA5, sizeof(ref));
+				oib_memcpy(dst + da, src + sa, size);
+				memcpy(ref + da, src + sa, size);
+				check(memcmp(dst, ref, sizeof(dst)) == 0, "memcpy of %u bytes, source +%d, destination +%d", size, sa, da);
+
+				memcpy(dst, src, sizeof(src));
+				memcpy(ref, src, sizeof(src));
+				oib_memmove(dst + da, dst + sa, size);
+				memmove(ref + da, ref + sa, size);
+				check(memcmp(dst, ref, sizeof(dst)) == 0, "memmove of %u bytes, from +%d to +%d", size, sa, da);
+			}
+
+			memset(dst, 0xA5, sizeof(dst));
+			memset(ref, 0xA5, sizeof(ref));
+			oib_memset(dst + sa, src[size], size);
+			memset(ref + sa, src[size], size);
+			check(memcmp(dst, ref, sizeof(dst)) == 0, "memset of %u bytes at +%d", size, sa);
+
+			memcpy(dst, src + sa, size);
+			check(oib_memcmp(dst, src + sa, size) == 0, "memcmp of %u equal bytes at +%d", size, sa);
+			if(size > 0) {
+				unsigned int at = next_random() % size;
+				dst[at] = next_random();
+				check(sign(oib_memcmp(dst, src + sa, size)) == sign(memcmp(dst, src + sa, size)),
+						"memcmp of %u bytes at +%d differing at %u", size, sa, at);
+			}
+
+			memset(dst, 'x', size);
+			dst[size] = '\0';
+			check(oib_strlen((char*) dst) == size, "strlen of %u characters", size);
+		}
+	}
+}
+
+static void check_number(const char* str, int base, unsigned long expected, int length) {
+	char* end;
+	unsigned long value = oib_strtoul(str, &end, base);
+	check(value == expected && (end - str) == length, "strtoul(\"%s\", %d) gave 0x%lx after %d characters", str, base, value, (int)(end - str));
+}
+
+static void check_numbers() {
+	char buffer[32];
+	int i;
+
+	check_number("0x9000000", 16, 0x9000000, 9);
+	check_number("DEADbeef ", 16, 0xDEADBEEF, 8);
+	check_number("4294967295", 10, 4294967295UL, 10);
+	check_number("777", 8, 0777, 3);
+	check_number("1011z", 2, 11, 4);
+	check_number("", 16, 0, 0);
+	check_number("g", 16, 0, 0);
+
+	check(parseNumber("0x09000000") == 0x09000000, "parseNumber of hex");
+	check(parseNumber("0b101") == 5, "parseNumber of binary");
+	check(parseNumber("0o17") == 017 && parseNumber("017") == 017, "parseNumber of octal");
+	check(parseNumber("0d99") == 99 && parseNumber("12345") == 12345, "parseNumber of decimal");
+	check(parseNumber("0") == 0, "parseNumber of 0");
+
+	for(i = 0; i < 1000; i++) {
+		unsigned int value = next_random() ^ (next_random() << 16);
+		sprintf(buffer, "%x", value);
+		check(oib_strtoul(buffer, NULL, 16) == value, "strtoul of %s", buffer);
+		sprintf(buffer, "%u", value);
+		check(oib_strtoul(buffer, NULL, 10) == value, "strtoul of %s", buffer);
+	}
+}
+
+static void check_checksums() {
+	static const char* numbers = "123456789";
+	unsigned char* buffer = malloc(BENCH_SIZE);
+	unsigned int crc;
+	unsigned int len;
+	int align;
+
+	fill_random(buffer, BENCH_SIZE);
+
+	check(crc32(NULL, numbers, 9) == 0xCBF43926, "crc32 of \"123456789\" is %08x", crc32(NULL, numbers, 9));
+	check(adler32((unsigned char*) "Wikipedia", 9) == 0x11E60398, "adler32 of \"Wikipedia\" is %08x",
+			adler32((unsigned char*) "Wikipedia", 9));
+
+	for(align = 0; align < 8; align++) {
+		for(len = 0; len < 100; len++) {
+			check(crc32(NULL, buffer + align, len) == reference_crc32(buffer + align, len),
+					"crc32 of %u bytes at +%d", len, align);
+			check(adler32(buffer + align, len) == reference_adler32(buffer + align, len),
+					"adler32 of %u bytes at +%d", len, align);
+		}
+	}
+
+	// more than NMAX, so the sums have to be reduced on the way
+	len = BENCH_SIZE - 13;
+	check(adler32(buffer + 5, len) == reference_adler32(buffer + 5, len), "adler32 of %u bytes", len);
+	check(crc32(NULL, buffer + 5, len) == reference_crc32(buffer + 5, len), "crc32 of %u bytes", len);
+
+	// and in pieces, carried over through ckSum
+	crc = 0;
+	crc32(&crc, buffer, 1001);
+	crc32(&crc, buffer + 1001, 3);
+	crc32(&crc, buffer + 1004, 20000);
+	check(crc == reference_crc32(buffer, 21004), "crc32 in pieces");
+
+	free(buffer);
+}
+
+static void check_sha1_of(const char* name, const unsigned char* data, unsigned int len, const char* expected) {
+	unsigned char digest[20];
+	char hex[41];
+	int i;
+
+	host_sha1(data, len, digest);
+	for(i = 0; i < 20; i++)
+		sprintf(hex + (i * 2), "%02x", digest[i]);
+
+	check(strcmp(hex, expected) == 0, "sha1 of %s is %s", name, hex);
+}
+
+static void check_sha1() {
+	static const char* twoBlocks = "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq";
+	unsigned char* million = malloc(1000000);
+
+	check_sha1_of("\"\"", (unsigned char*) "", 0, "da39a3ee5e6b4b0d3255bfef95601890afd80709");
+	check_sha1_of("\"abc\"", (unsigned char*) "abc", 3, "a9993e364706816aba3e25717850c26c9cd0d89d");
+	check_sha1_of(twoBlocks, (unsigned char*) twoBlocks, strlen(twoBlocks), "84983e441c3bd26ebaae4aa1f95129e5e54670f1");
+
+	memset(million, 'a', 1000000);
+	check_sha1_of("a million a's", million, 1000000, "34aa973cd4c4daa4f61eeb2bdbad27316534016f");
+
+	free(million);
+}
+
+#define CHECK_FORMAT(expected, ...) \
+	do { \
+		int ret = oib_snprintf(buffer, sizeof(buffer), __VA_ARGS__); \
+		check(strcmp(buffer, expected) == 0 && ret == strlen(expected), \
+				"snprintf(%s) gave \"%s\" (%d)", #__VA_ARGS__, buffer, ret); \
+	} while(0)
+
+static void check_printf() {
+	char buffer[64];
+	int ret;
+
+	CHECK_FORMAT("hello", "hello");
+	CHECK_FORMAT("100%", "100%%");
+	CHECK_FORMAT("42 -42 0", "%d %i %d", 42, -42, 0);
+	CHECK_FORMAT("-2147483648", "%d", (int) 0x80000000);
+	CHECK_FORMAT("4294967295", "%u", 0xFFFFFFFF);
+	CHECK_FORMAT("deadbeef DEADBEEF", "%x %X", 0xDEADBEEF, 0xDEADBEEF);
+	CHECK_FORMAT("0000abcd", "%08x", 0xABCD);
+	CHECK_FORMAT("       -12|", "%10d|", -12);
+	CHECK_FORMAT("-000012", "%07d", -12);
+	CHECK_FORMAT("7     |", "%-6d|", 7);
+	CHECK_FORMAT("777", "%o", 0777);
+	CHECK_FORMAT("[c]", "[%c]", 'c');
+	CHECK_FORMAT("  abc|abc  |", "%5s|%-5s|", "abc", "abc");
+	CHECK_FORMAT("(null)", "%s", (char*) NULL);
+	CHECK_FORMAT("123456789012", "%Ld", 123456789012LL);
+	CHECK_FORMAT("-123456789012", "%Ld", -123456789012LL);
+	CHECK_FORMAT("1234567890abcdef", "%Lx", 0x1234567890ABCDEFULL);
+	CHECK_FORMAT("12345678", "%lx", 0x12345678);
+
+	// cut short, but the whole length is still returned
+	ret = oib_snprintf(buffer, 5, "%s", "abcdefgh");
+	check(strcmp(buffer, "abcd") == 0 && ret == 8, "snprintf into 5 bytes gave \"%s\" (%d)", buffer, ret);
+
+	memset(buffer, 'z', sizeof(buffer));
+	ret = oib_snprintf(buffer, 0, "%d", 1234);
+	check(buffer[0] == 'z' && ret == 4, "snprintf into nothing wrote to the buffer (%d)", ret);
+}
+
+static void check_tokenize_of(const char* line, int expectedArgc, const char** expected) {
+	char* arguments[16];
+	char* copy = strdup(line);
+	int argc = tokenize_into(copy, arguments, 16);
+	int i;
+
+	check(argc == expectedArgc, "tokenize of [%s] gave %d arguments", line, argc);
+	for(i = 0; i < argc && i < expectedArgc; i++)
+		check(strcmp(arguments[i], expected[i]) == 0, "tokenize of [%s]: argument %d is [%s]", line, i, arguments[i]);
+
+	free(copy);
+}
+
+static void check_tokenize() {
+	static const char* simple[] = {"go", "kernel", "0x09000000"};
+	static const char* quoted[] = {"setenv", "bootargs", "rd=md0 -v", "x"};
+	static const char* escaped[] = {"echo", "a b", "\"q\""};
+	static const char* ended[] = {"help"};
+	char* arguments[2];
+	char line[] = "a b c d";
+
+	check_tokenize_of("go kernel 0x09000000", 3, simple);
+	check_tokenize_of("setenv bootargs \"rd=md0 -v\" x", 4, quoted);
+	check_tokenize_of("echo a\\ b \\\"q\\\"", 3, escaped);
+	check_tokenize_of("help\r\nignored", 1, ended);
+
+	// the last argument gets the rest of the line
+	check(tokenize_into(line, arguments, 2) == 2 && strcmp(arguments[1], "b c d") == 0,
+			"tokenize with room for 2 gave [%s]", arguments[1]);
+}
+
+static unsigned char pixel(int x, int y, int c) {
+	return ((x * 7) + (y * 13) + (c * 50)) ^ (x * y);
+}
+
+static void put16(unsigned char* p, unsigned int v) {
+	p[0] = v;
+	p[1] = v >> 8;
+}
+
+static void put32(unsigned char* p, unsigned int v) {
+	put16(p, v);
+	put16(p + 2, v >> 16);
+}
+
+static void put32be(unsigned char* p, unsigned int v) {
+	p[0] = v >> 24;
+	p[1] = v >> 16;
+	p[2] = v >> 8;
+	p[3] = v;
+}
+
+// 24-bit, bottom up, with the rows padded out to 4 bytes
+static unsigned char* make_bmp(int width, int height, int* len) {
+	int stride = ((width * 3) + 3) & ~3;
+	unsigned char* bmp = calloc(1, 54 + (stride * height));
+	int x;
+	int y;
+
+	*len = 54 + (stride * height);
+	bmp[0] = 'B';
+	bmp[1] = 'M';
+	put32(bmp + 2, *len);
+	put32(bmp + 10, 54);
+	put32(bmp + 14, 40);
+	put32(bmp + 18, width);
+	put32(bmp + 22, height);
+	put16(bmp + 26, 1);
+	put16(bmp + 28, 24);
+	put32(bmp + 34, stride * height);
+
+	for(y = 0; y < height; y++) {
+		unsigned char* row = bmp + 54 + ((height - 1 - y) * stride);
+		for(x = 0; x < width; x++) {
+			row[(x * 3) + 0] = pixel(x, y, 2);
+			row[(x * 3) + 1] = pixel(x, y, 1);
+			row[(x * 3) + 2] = pixel(x, y, 0);
+		}
+	}
+
+	return bmp;
+}
+
+static unsigned char paeth(int a, int b, int c) {
+	int p = a + b - c;
+	int pa = abs(p - a);
+	int pb = abs(p - b);
+	int pc = abs(p - c);
+
+	if(pa <= pb && pa <= pc)
+		return a;
+	else if(pb <= pc)
+		return b;
+	else
+		return c;
+}
+
+static unsigned char* png_chunk(unsigned char* p, const char* type, const unsigned char* data, unsigned int len) {
+	put32be(p, len);
+	memcpy(p + 4, type, 4);
+	memcpy(p + 8, data, len);
+	put32be(p + 8 + len, reference_crc32(p + 4, len + 4));
+	return p + 12 + len;
+}
+
+// RGB, with the rows going through all five filters in turn and the image
+// data in stored deflate blocks, so all of it is in the unfiltering and the
+// zlib framing rather than the huffman decoder
+static unsigned char* make_png(int width, int height, int* len) {
+	static const unsigned char signature[] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+	int stride = (width * 3) + 1;
+	int rawLen = stride * height;
+	int blocks = (rawLen + 0xFFFE) / 0xFFFF;
+	unsigned char* raw = malloc(rawLen);
+	int zlibLen = 2 + (blocks * 5) + rawLen + 4;
+	unsigned char* zlib = malloc(zlibLen);
+	unsigned char* png = malloc(8 + 25 + (12 + zlibLen) + 12);
+	unsigned char header[13];
+	unsigned char* p;
+	int x;
+	int y;
+	int i;
+
+	for(y = 0; y < height; y++) {
+		unsigned char* row = raw + (y * stride);
+		int filter = y % 5;
+
+		row[0] = filter;
+		for(x = 0; x < width * 3; x++) {
+			int value = pixel(x / 3, y, x % 3);
+			int left = (x >= 3) ? pixel((x / 3) - 1, y, x % 3) : 0;
+			int up = (y > 0) ? pixel(x / 3, y - 1, x % 3) : 0;
+			int upLeft = (x >= 3 && y > 0) ? pixel((x / 3) - 1, y - 1, x % 3) : 0;
+
+			switch(filter) {
+				case 1:
+					value -= left;
+					break;
+				case 2:
+					value -= up;
+					break;
+				case 3:
+					value -= (left + up) / 2;
+					break;
+				case 4:
+					value -= paeth(left, up, upLeft);
+					break;
+			}
+
+			row[x + 1] = value;
+		}
+	}
+
+	p = zlib;
+	*p++ = 0x78;
+	*p++ = 0x01;
+	for(i = 0; i < rawLen; i += 0xFFFF) {
+		int size = ((rawLen - i) > 0xFFFF) ? 0xFFFF : (rawLen - i);
+		*p++ = ((i + size) == rawLen) ? 1 : 0;
+		put16(p, size);
+		put16(p + 2, ~size);
+		memcpy(p + 4, raw + i, size);
+		p += 4 + size;
+	}
+	put32be(p, reference_adler32(raw, rawLen));
+
+	put32be(header, width);
+	put32be(header + 4, height);
+	header[8] = 8;
+	header[9] = 2;
+	header[10] = 0;
+	header[11] = 0;
+	header[12] = 0;
+
+	memcpy(png, signature, sizeof(signature));
+	p = png_chunk(png + sizeof(signature), "IHDR", header, sizeof(header));
+	p = png_chunk(p, "IDAT", zlib, zlibLen);
+	p = png_chunk(p, "IEND", NULL, 0);
+	*len = p - png;
+
+	free(raw);
+	free(zlib);
+	return png;
+}
+
+static void check_image(const char* name, const unsigned char* data, int len, int width, int height) {
+	unsigned char* image;
+	int x;
+	int y;
+	int c;
+	int w;
+	int h;
+	int comp;
+
+	image = stbi_load_from_memory(data, len, &w, &h, &comp, 3);
+	check(image != NULL, "stb_image could not decode the %s", name);
+	if(!image)
+		return;
+
+	check(w == width && h == height, "the %s came out %dx%d", name, w, h);
+	if(w == width && h == height) {
+		for(y = 0; y < height; y++) {
+			for(x = 0; x < width; x++) {
+				for(c = 0; c < 3; c++) {
+					if(image[(((y * width) + x) * 3) + c] != pixel(x, y, c)) {
+						check(0, "the %s is wrong at %d,%d", name, x, y);
+						y = height;
+						x = width;
+						break;
+					}
+				}
+			}
+		}
+	}
+
+	stbi_image_free(image);
+}
+
+static void check_images() {
+	unsigned char* bmp;
+	unsigned char* png;
+	int bmpLen;
+	int pngLen;
+
+	bmp = make_bmp(IMAGE_WIDTH, IMAGE_HEIGHT, &bmpLen);
+	png = make_png(IMAGE_WIDTH, IMAGE_HEIGHT, &pngLen);
+
+	check_image("BMP", bmp, bmpLen, IMAGE_WIDTH, IMAGE_HEIGHT);
+	check_image("PNG", png, pngLen, IMAGE_WIDTH, IMAGE_HEIGHT);
+
+	free(bmp);
+	free(png);
+}
+
+#define ECC_SECTOR_SIZE 512
+
+#define ECC_DATA_SYMBOLS (((ECC_SECTOR_SIZE * 8) + 9) / 10)
+
+// Symbols are ten bits, packed little endian through the sector, the last one
+// only six bits of it, and then through the parity on their own.
+static void flip_symbol(unsigned char* sector, unsigned char* ecc, int symbol) {
+	int bit;
+
+	if(symbol < ECC_DATA_SYMBOLS) {
+		bit = (symbol * 10) + (next_random() % 10);
+		if(bit >= (ECC_SECTOR_SIZE * 8))
+			bit -= 4;
+		sector[bit / 8] ^= 1 << (bit % 8);
+	} else {
+		bit = ((symbol - ECC_DATA_SYMBOLS) * 10) + (next_random() % 10);
+		ecc[bit / 8] ^= 1 << (bit % 8);
+	}
+}
+
+static void check_nandecc() {
+	int strengths[] = {4, 6, 8};
+	unsigned char sector[ECC_SECTOR_SIZE];
+	unsigned char original[ECC_SECTOR_SIZE];
+	unsigned char ecc[20];
+	unsigned char originalEcc[20];
+	int i;
+
+	for(i = 0; i < 3; i++) {
+		int strength = strengths[i];
+		int bytes = nandecc_bytes(strength);
+		int symbols = ECC_DATA_SYMBOLS + (strength * 2);
+		int round;
+
+		check(bytes == (strength * 10 * 2) / 8, "nandecc: strength %d has %d parity bytes", strength, bytes);
+
+		for(round = 0; round < 200; round++) {
+			int errors = round % (strength + 1);
+			int used[20];
+			int n = 0;
+			int j;
+
+			fill_random(original, sizeof(original));
+			nandecc_encode(strength, original, originalEcc);
+			memcpy(sector, original, sizeof(sector));
+			memcpy(ecc, originalEcc, bytes);
+
+			while(n < errors) {
+				int symbol = next_random() % symbols;
+				for(j = 0; j < n; j++) {
+					if(used[j] == symbol)
+						break;
+				}
+
+				if(j < n)
+					continue;
+
+				used[n++] = symbol;
+				flip_symbol(sector, ecc, symbol);
+			}
+
+			j = nandecc_correct(strength, sector, ecc);
+			check(j == errors, "nandecc: strength %d corrected %d symbols of %d", strength, j, errors);
+			check(memcmp(sector, original, sizeof(sector)) == 0 && memcmp(ecc, originalEcc, bytes) == 0,
+				"nandecc: strength %d with %d errors did not get the sector back", strength, errors);
+		}
+	}
+}
+
+typedef struct CopyBench {
+	unsigned char* dest;
+	unsigned char* src;
+	unsigned int size;
+} CopyBench;
+
+static void bench_oib_memcpy(void* opaque) {
+	CopyBench* b = opaque;
+	oib_memcpy(b->dest, b->src, b->size);
+}
+
+static void bench_libc_memcpy(void* opaque) {
+	CopyBench* b = opaque;
+	memcpy(b->dest, b->src, b->size);
+}
+
+static void bench_oib_memset(void* opaque) {
+	CopyBench* b = opaque;
+	oib_memset(b->dest, b->size, b->size);
+}
+
+static void bench_libc_memset(void* opaque) {
+	CopyBench* b = opaque;
+	memset(b->dest, b->size, b->size);
+}
+
+static void bench_crc32(void* opaque) {
+	CopyBench* b = opaque;
+	Sink = crc32(NULL, b->src, b->size);
+}
+
+static void bench_adler32(void* opaque) {
+	CopyBench* b = opaque;
+	Sink = adler32(b->src, b->size);
+}
+
+static void bench_sha1(void* opaque) {
+	CopyBench* b = opaque;
+	host_sha1(b->src, b->size, b->dest);
+}
+
+static void bench_snprintf(void* opaque) {
+	char buffer[128];
+	Sink = oib_snprintf(buffer, sizeof(buffer), "%s: 0x%08x %d bytes at %Lx\r\n", "nand", 0x1234ABCD, -12345, 0x123456789ULL);
+}
+
+static void bench_tokenize(void* opaque) {
+	char line[] = "setenv bootargs \"rd=md0 -v serial=1\" go kernel 0x09000000 a\\ b c d e";
+	char* arguments[16];
+	Sink = tokenize_into(line, arguments, 16);
+}
+
+static void bench_parse_number(void* opaque) {
+	Sink = parseNumber("0x09000000") + parseNumber("4096");
+}
+
+typedef struct ImageBench {
+	const unsigned char* data;
+	int len;
+} ImageBench;
+
+typedef struct ECCBench {
+	unsigned char sector[ECC_SECTOR_SIZE];
+	unsigned char ecc[20];
+	int strength;
+} ECCBench;
+
+static void bench_nandecc_encode(void* opaque) {
+	ECCBench* b = opaque;
+	nandecc_encode(b->strength, b->sector, b->ecc);
+}
+
+static void bench_nandecc_correct(void* opaque) {
+	ECCBench* b = opaque;
+	Sink = nandecc_correct(b->strength, b->sector, b->ecc);
+}
+
+static void bench_image(void* opaque) {
+	ImageBench* b = opaque;
+	int x;
+	int y;
+	int comp;
+	unsigned char* image = stbi_load_from_memory(b->data, b->len, &x, &y, &comp, 0);
+
+	if(image)
+		stbi_image_free(image);
+}
+
+static void bench_memory() {
+	CopyBench b;
+	char name[64];
+	unsigned int sizes[] = {0x1000, BENCH_SIZE};
+	int i;
+
+	b.dest = malloc(BENCH_SIZE + 64);
+	b.src = malloc(BENCH_SIZE + 64);
+	fill_random(b.src, BENCH_SIZE + 64);
+	memset(b.dest, 0, BENCH_SIZE + 64);
+
+	for(i = 0; i < 2; i++) {
+		b.size = sizes[i];
+		sprintf(name, "memcpy %uKB", sizes[i] / 1024);
+		report_rate(name, bench(bench_oib_memcpy, &b), b.size);
+		sprintf(name, "memcpy %uKB (libc)", sizes[i] / 1024);
+		report_rate(name, bench(bench_libc_memcpy, &b), b.size);
+	}
+
+	// one side off by a byte, where openiboot's memcpy can't go a word at a time
+	b.src++;
+	sprintf(name, "memcpy %uKB unaligned", BENCH_SIZE / 1024);
+	report_rate(name, bench(bench_oib_memcpy, &b), b.size);
+	sprintf(name, "memcpy %uKB unaligned (libc)", BENCH_SIZE / 1024);
+	report_rate(name, bench(bench_libc_memcpy, &b), b.size);
+	b.src--;
+
+	report_rate("memset 1MB", bench(bench_oib_memset, &b), b.size);
+	report_rate("memset 1MB (libc)", bench(bench_libc_memset, &b), b.size);
+	report_rate("crc32", bench(bench_crc32, &b), b.size);
+	report_rate("adler32", bench(bench_adler32, &b), b.size);
+	report_rate("sha1", bench(bench_sha1, &b), b.size);
+	report_time("snprintf", bench(bench_snprintf, NULL));
+	report_time("tokenize", bench(bench_tokenize, NULL));
+	report_time("parseNumber", bench(bench_parse_number, NULL));
+
+	free(b.dest);
+	free(b.src);
+}
+
+static void bench_nandecc() {
+	ECCBench b;
+	char name[64];
+	int strengths[] = {4, 8};
+	int i;
+
+	fill_random(b.sector, sizeof(b.sector));
+	for(i = 0; i < 2; i++) {
+		b.strength = strengths[i];
+		sprintf(name, "nandecc encode t=%d", b.strength);
+		report_rate(name, bench(bench_nandecc_encode, &b), sizeof(b.sector));
+
+		// a clean sector, the common case: the remainder is all it takes
+		nandecc_encode(b.strength, b.sector, b.ecc);
+		sprintf(name, "nandecc check t=%d", b.strength);
+		report_rate(name, bench(bench_nandecc_correct, &b), sizeof(b.sector));
+	}
+}
+
+static void bench_images(const char* picture) {
+	ImageBench b;
+	unsigned char* bmp;
+	unsigned char* png;
+	int bmpLen;
+	int pngLen;
+
+	bmp = make_bmp(BENCH_IMAGE_WIDTH, BENCH_IMAGE_HEIGHT, &bmpLen);
+	png = make_png(BENCH_IMAGE_WIDTH, BENCH_IMAGE_HEIGHT, &pngLen);
+
+	b.data = bmp;
+	b.len = bmpLen;
+	report_time("decode 320x480 BMP", bench(bench_image, &b));
+	b.data = png;
+	b.len = pngLen;
+	report_time("decode 320x480 PNG", bench(bench_image, &b));
+
+	free(bmp);
+	free(png);
+
+	if(picture) {
+		struct stat st;
+		int fd = open(picture, O_RDONLY);
+		if(fd < 0 || fstat(fd, &st) != 0) {
+			perror(picture);
+			Failed++;
+			return;
+		}
+
+		unsigned char* data = malloc(st.st_size);
+		if(read(fd, data, st.st_size) != st.st_size) {
+			perror(picture);
+			Failed++;
+			close(fd);
+			return;
+		}
+		close(fd);
+
+		int x;
+		int y;
+		int comp;
+		unsigned char* image = stbi_load_from_memory(data, st.st_size, &x, &y, &comp, 0);
+		check(image != NULL, "stb_image could not decode %s", picture);
+		if(image) {
+			char name[64];
+			stbi_image_free(image);
+
+			b.data = data;
+			b.len = st.st_size;
+			snprintf(name, sizeof(name), "decode %dx%d picture", x, y);
+			report_time(name, bench(bench_image, &b));
+		}
+
+		free(data);
+	}
+}
+
+// Reading the volume is timed once, the second pass is what the HFS code
+// costs with the image already in the page cache
+static void run_hfs(const char* path, int benchmark) {
+	HostHFSTotals first;
+	HostHFSTotals second;
+
+	ImageFD = open(path, O_RDONLY);
+	if(ImageFD < 0) {
+		perror(path);
+		Failed++;
+		return;
+	}
+
+	if(!host_hfs_open()) {
+		check(0, "%s does not open as an HFS+ volume", path);
+		close(ImageFD);
+		return;
+	}
+
+	host_hfs_walk(&first);
+	check(first.failed == 0, "%u of the files and folders on %s could not be read or found", first.failed, path);
+
+	long long start = now_ns();
+	host_hfs_walk(&second);
+	long long elapsed = now_ns() - start;
+
+	check(second.files == first.files && second.bytes == first.bytes && second.crc == first.crc,
+			"the second pass over %s read something else", path);
+
+	printf("hfs: %u folders, %u files (%u compressed), %llu bytes, crc32 %08x\n", first.folders, first.files, first.compressed,
+			first.bytes, first.crc);
+	if(benchmark && elapsed > 0) {
+		printf("%-32s %10.1f MB/s\n", "hfs read everything", (first.bytes * 1000.0) / elapsed);
+		printf("%-32s %10.3f us\n", "hfs per file and folder", (elapsed / 1000.0) / (first.files + first.folders + 1));
+	}
+
+	host_hfs_close();
+	close(ImageFD);
+}
+
+static void usage(const char* name) {
+	fprintf(stderr, "Usage: %s [-c] [-i hfs image] [-p picture]\n", name);
+	fprintf(stderr, "\t-c\tonly run the checks\n");
+	fprintf(stderr, "\t-i\talso read every file on an HFS+ image, and time it\n");
+	fprintf(stderr, "\t-p\talso time decoding a picture, such as one of the boot menu's\n");
+}
+
+int main(int argc, char* argv[]) {
+	const char* hfsImage = NULL;
+	const char* picture = NULL;
+	int benchmark = 1;
+	int opt;
+
+	while((opt = getopt(argc, argv, "ci:p:")) != -1) {
+		switch(opt) {
+			case 'c':
+				benchmark = 0;
+				break;
+			case 'i':
+				hfsImage = optarg;
+				break;
+			case 'p':
+				picture = optarg;
+				break;
+			default:
+				usage(argv[0]);
+				return 1;
+		}
+	}
+
+	check_strings();
+	check_numbers();
+	check_checksums();
+	check_sha1();
+	check_printf();
+	check_tokenize();
+	check_images();
+	check_nandecc();
+
+	if(hfsImage)
+		run_hfs(hfsImage, benchmark);
+
+	if(benchmark) {
+		bench_memory();
+		bench_nandecc();
+		bench_images(picture);
+	}
+
+	if(Failed > 0) {
+		printf("%d checks failed\n", Failed);
+		return 1;
+	}
+
+	printf("all checks passed\n");
+	return 0;
+}
@@ -0,0 +1,52 @@
+#ifndef HOSTBENCH_H
+#define HOSTBENCH_H
+
+// Shared between host.c, built against the C library, and the side built
+// against openiboot's headers (glue.c and the modules themselves), so only
+// plain C types are used here.
+
+// openiboot's own, renamed by names.h
+void* oib_memset(void* x, int fill, unsigned int size);
+void* oib_memcpy(void* dest, const void* src, unsigned int size);
+void* oib_memmove(void* dest, const void* src, unsigned long length);
+int oib_memcmp(const void* s1, const void* s2, unsigned int size);
+unsigned long oib_strlen(const char* str);
+unsigned long oib_strtoul(const char* str, char** endptr, int base);
+unsigned long parseNumber(const char* str);
+int oib_snprintf(char* buf, unsigned long size, const char* fmt, ...);
+
+int tokenize_into(char* commandline, char** arguments, int maxArgs);
+unsigned int crc32(unsigned int* ckSum, const void* buffer, unsigned long len);
+unsigned int adler32(unsigned char* buf, int len);
+
+unsigned char* stbi_load_from_memory(const unsigned char* buffer, int len, int* x, int* y, int* comp, int req_comp);
+void stbi_image_free(void* data);
+
+int nandecc_bytes(int strength);
+void nandecc_encode(int strength, const unsigned char* sector, unsigned char* ecc);
+int nandecc_correct(int strength, unsigned char* sector, unsigned char* ecc);
+
+typedef struct HostHFSTotals {
+	unsigned int folders;
+	unsigned int files;
+	unsigned int compressed;	// of the files, how many were decmpfs ones
+	unsigned long long bytes;
+	unsigned int failed;		// files that could not be looked up or read back
+	unsigned int crc;		// over the contents of every file, in catalog order
+} HostHFSTotals;
+
+// glue.c
+void host_sha1(const void* data, unsigned int len, unsigned char digest[20]);
+
+// Opens the HFS+ volume on the image host_image_read reads from.
+int host_hfs_open();
+void host_hfs_close();
+
+// Reads every file on the volume, looking each one up again by its path.
+void host_hfs_walk(HostHFSTotals* totals);
+
+// host.c
+void host_write(const char* buffer, unsigned int length);
+int host_image_read(unsigned long long offset, unsigned int size, void* buffer);
+
+#endif
@@ -0,0 +1,31 @@
+#ifndef NAMES_H
+#define NAMES_H
+
+// Forced into everything built against openiboot's headers. openiboot has its
+// own versions of these C library functions, which are what is under test, so
+// they get an oib_ prefix to keep them apart from the host's.
+
+#define abort oib_abort
+#define __assert oib___assert
+#define memset oib_memset
+#define memcpy oib_memcpy
+#define memmove oib_memmove
+#define memcmp oib_memcmp
+#define strcmp oib_strcmp
+#define strchr oib_strchr
+#define strstr oib_strstr
+#define strdup oib_strdup
+#define strcpy oib_strcpy
+#define strlen oib_strlen
+#define strtoul oib_strtoul
+#define tolower oib_tolower
+#define putchar oib_putchar
+#define puts oib_puts
+#define printf oib_printf
+#define vprintf oib_vprintf
+#define sprintf oib_sprintf
+#define vsprintf oib_vsprintf
+#define snprintf oib_snprintf
+#define vsnprintf oib_vsnprintf
+
+#endif
@@ -0,0 +1,58 @@
+#!/bin/sh
+# Symbolizes a profile taken on the device with
+#	profile dump 0x09000000
+# and fetched with oibc's ~profile.bin@0x09000000:<length>, against the
+# openiboot ELF that was running. Prints the functions samples landed in,
+# then the call sites that led there.
+#
+#	profsym.sh <openiboot ELF> <profile.bin> [lines]
+#
+# ADDR2LINE picks the addr2line to use.
+
+ADDR2LINE=${ADDR2LINE:-arm-elf-addr2line}
+
+if [ $# -lt 2 ]; then
+	echo "Usage: $0 <openiboot ELF> <profile.bin> [lines]" >&2
+	exit 1
+fi
+
+ELF=$1
+DUMP=$2
+LINES=${3:-30}
+
+set -- `od -An -v -tu4 -N20 "$DUMP"`
+if [ "$1" != "1179603536" ]; then
+	echo "$DUMP: not a profile dump" >&2
+	exit 1
+fi
+echo "$3 samples at $2 Hz, $5 pc/lr pairs, $4 samples dropped"
+
+TMP=${TMPDIR:-/tmp}/profsym.$$
+trap 'rm -f "$TMP".*' EXIT
+
+# pc lr count, one entry per line
+od -An -v -tx4 -j20 -w12 "$DUMP" | awk 'NF == 3 { printf "0x%s 0x%s %d\n", $1, $2, ("0x" $3) + 0 }' > "$TMP.entries"
+
+# every address once, and the function it is in
+awk '{ print $1; print $2 }' "$TMP.entries" | sort -u > "$TMP.addrs"
+"$ADDR2LINE" -f -e "$ELF" < "$TMP.addrs" | awk 'NR % 2 == 1' | paste -d ' ' "$TMP.addrs" - > "$TMP.syms"
+
+awk -v total="$3" -v out="$TMP" '
+	FNR == NR { sym[$1] = $2; next }
+	{
+		flat[sym[$1]] += $3
+		edge[sym[$1] " <- " sym[$2]] += $3
+	}
+	END {
+		for(f in flat)
+			printf "%7d %5.1f%%  %s\n", flat[f], flat[f] * 100 / total, f > (out ".flat")
+		for(e in edge)
+			printf "%7d %5.1f%%  %s\n", edge[e], edge[e] * 100 / total, e > (out ".edges")
+	}' "$TMP.syms" "$TMP.entries"
+
+echo
+echo "samples  share  function"
+sort -nr "$TMP.flat" | head -n "$LINES"
+echo
+echo "samples  share  function <- caller"
+sort -nr "$TMP.edges" | head -n "$LINES"